@@ -97,5 +97,9 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
 
+/* The serial driver moves data with the PDC and provides usSerialWrite() and
+usSerialRead(), which the comtest tasks then use. */
+#define serUSE_BLOCK_TRANSFERS		1
+
 
 #endif /* FREERTOS_CONFIG_H */
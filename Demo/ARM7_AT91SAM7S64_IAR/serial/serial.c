@@ -52,15 +52,32 @@
 */
 
 /* 
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0. 
+	PDC (DMA) DRIVEN SERIAL PORT DRIVER FOR UART0.
+
+	Characters to transmit are held in a stream buffer.  Whenever the PDC
+	transmit channel is idle the next block of up to serTX_DMA_BLOCK_SIZE
+	characters is taken from the stream buffer and handed to the PDC, so there
+	is one interrupt per block rather than one per character.
+
+	The PDC receive channel alternates between two buffers.  Received
+	characters are copied into the receive stream buffer when a buffer fills
+	(ENDRX), and when the line has been idle for serRX_TIMEOUT_BITS bit periods
+	(TIMEOUT), so the tail of a burst is not held back.
+
+	If serUSE_RX_FRAMES is set to 1 the received data is instead left in the
+	PDC buffers, which are adjacent so form one circular buffer, and the
+	receiver time-out marks the end of a frame.  A task blocked in
+	xSerialGetFrame() wakes once per frame and reads the frame in place.  The
+	gap that ends a frame is serRX_FRAME_GAP_BITS bit periods - 3.5 characters
+	for Modbus RTU by default.  xSerialGetChar() and usSerialRead() are not
+	available in this mode.
 */
 
-/* Standard includes. */ 
-#include <stdlib.h>
-
 /* Scheduler includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "queue.h"
+#include "stream_buffer.h"
 
 /* Demo application includes. */
 #include "serial.h"
@@ -72,21 +89,84 @@
 
 /* Interrupt control macros. */
 #define serINTERRUPT_LEVEL				( 5 )
-#define vInterruptOn()					AT91F_US_EnableIt( serCOM0, AT91C_US_TXRDY | AT91C_US_RXRDY )
-#define vInterruptOff()					AT91F_US_DisableIt( serCOM0, AT91C_US_TXRDY )
 
 /* Misc constants. */
-#define serINVALID_QUEUE				( ( xQueueHandle ) 0 )
+#define serINVALID_STREAM				( ( xStreamBufferHandle ) 0 )
 #define serHANDLE						( ( xComPortHandle ) 1 )
 #define serNO_BLOCK						( ( portTickType ) 0 )
 #define serNO_TIMEGUARD					( ( unsigned long ) 0 )
 #define serNO_PERIPHERAL_B_SETUP		( ( unsigned long ) 0 )
 
+/* Wake a blocked reader as soon as a single character is available. */
+#define serTRIGGER_LEVEL				( 1 )
+
+#ifndef serUSE_RX_FRAMES
+	#define serUSE_RX_FRAMES			0
+#endif
+
+/* The largest block sent by one PDC transfer, the size of each of the two
+receive buffers, and how many idle bit periods end a received burst.  In frame
+mode the buffers hold the frames until they have been read, so together must
+be a power of two large enough for at least two frames. */
+#define serTX_DMA_BLOCK_SIZE			( 64 )
+
+#if serUSE_RX_FRAMES == 1
+	#define serRX_DMA_BLOCK_SIZE		( 256 )
+	#define serRX_FRAME_QUEUE_LENGTH	( 8 )
+	#ifndef serRX_FRAME_GAP_BITS
+		#define serRX_FRAME_GAP_BITS	( 39 )
+	#endif
+	#define serRX_TIMEOUT_BITS			serRX_FRAME_GAP_BITS
+	#define serRX_BUFFER_SIZE			( 2UL * serRX_DMA_BLOCK_SIZE )
+#else
+	#define serRX_DMA_BLOCK_SIZE		( 32 )
+	#define serRX_TIMEOUT_BITS			( 20 )
+#endif
+
+/* Stream buffer used to hold characters waiting to be transmitted. */
+static xStreamBufferHandle xCharsForTx; 
+
+#if serUSE_RX_FRAMES == 0
+
+	/* Stream buffer used to hold received characters. */
+	static xStreamBufferHandle xRxedChars; 
+	#define serRX_CREATED()		( xRxedChars != serINVALID_STREAM )
+
+#else
+
+	/* A frame posted to xRxFrames by the time-out interrupt.  ulStart counts
+	bytes received since the port was opened, so it also locates the frame in
+	the receive buffers. */
+	typedef struct SERIAL_FRAME_DESCRIPTOR
+	{
+		unsigned long ulStart;
+		unsigned short usLength;
+	} xFrameDescriptor;
+
+	static xQueueHandle xRxFrames;
+	#define serRX_CREATED()		( xRxFrames != ( xQueueHandle ) 0 )
+
+	/* The number of receive buffers the PDC has filled, and the count at
+	which the frame being received started. */
+	static volatile unsigned long ulRxBlocks = 0;
+	static unsigned long ulRxFrameStart = 0;
 
-/* Queues used to hold received characters, and characters waiting to be
-transmitted. */
-static xQueueHandle xRxedChars; 
-static xQueueHandle xCharsForTx; 
+#endif
+
+/* The block being transmitted by the PDC, and whether a transfer is in
+progress.  xTxDMABusy is only accessed with interrupts masked. */
+static unsigned char ucTxDMABlock[ serTX_DMA_BLOCK_SIZE ];
+static volatile portBASE_TYPE xTxDMABusy = pdFALSE;
+
+/* The two receive buffers, and the one the PDC is currently filling. */
+static unsigned char ucRxDMABuffers[ 2 ][ serRX_DMA_BLOCK_SIZE ];
+static unsigned portBASE_TYPE uxRxActive = 0;
+
+#if serUSE_RX_FRAMES == 0
+	/* How many characters of the active buffer have already been copied to
+	xRxedChars. */
+	static unsigned portBASE_TYPE uxRxCopied = 0;
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -96,6 +176,36 @@ extern void vSerialISREntry( void );
 /* The interrupt service routine - called from the assembly entry point. */
 __arm void vSerialISR( void );
 
+/*
+ * Hand the next block from xCharsForTx to the PDC, if there is one.  Must be
+ * called with interrupts masked.
+ */
+static void prvStartNextTxBlock( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#if serUSE_RX_FRAMES == 1
+
+	/*
+	 * The number of bytes received since the port was opened.  Must be called
+	 * with interrupts masked.
+	 */
+	static unsigned long prvRxCount( void );
+
+	/*
+	 * Post the frame received since the last call to xRxFrames.  Called from
+	 * the ISR.
+	 */
+	static void prvEndRxFrame( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#else
+
+	/*
+	 * Copy the characters received into the active Rx buffer since the last
+	 * call into xRxedChars.  Called from the ISR.
+	 */
+	static void prvCopyRxData( unsigned portBASE_TYPE uxReceived, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -106,13 +216,19 @@ xComPortHandle xSerialPortInitMinimal( unsigned long ulWantedBaud, unsigned port
 xComPortHandle xReturn = serHANDLE;
 extern void ( vUART_ISR )( void );
 
-	/* Create the queues used to hold Rx and Tx characters. */
-	xRxedChars = xQueueCreate( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
-	xCharsForTx = xQueueCreate( uxQueueLength + 1, ( unsigned portBASE_TYPE ) sizeof( signed char ) );
-
-	/* If the queues were created correctly then setup the serial port 
+	/* Create the stream buffers used to hold Rx and Tx characters.  In frame
+	mode received characters stay in the PDC buffers, and only the location
+	of each frame is queued. */
+	#if serUSE_RX_FRAMES == 1
+		xRxFrames = xQueueCreate( serRX_FRAME_QUEUE_LENGTH, ( unsigned portBASE_TYPE ) sizeof( xFrameDescriptor ) );
+	#else
+		xRxedChars = xStreamBufferCreate( ( size_t ) uxQueueLength, serTRIGGER_LEVEL );
+	#endif
+	xCharsForTx = xStreamBufferCreate( ( size_t ) uxQueueLength + 1, serTRIGGER_LEVEL );
+
+	/* If the stream buffers were created correctly then setup the serial port 
 	hardware. */
-	if( ( xRxedChars != serINVALID_QUEUE ) && ( xCharsForTx != serINVALID_QUEUE ) )
+	if( ( serRX_CREATED() ) && ( xCharsForTx != serINVALID_STREAM ) )
 	{
 		portENTER_CRITICAL();
 		{
@@ -124,12 +240,25 @@ extern void ( vUART_ISR )( void );
 			/* Set the required protocol. */
 			AT91F_US_Configure( serCOM0, configCPU_CLOCK_HZ, AT91C_US_ASYNC_MODE, ulWantedBaud, serNO_TIMEGUARD );
 
+			/* Give the PDC both Rx buffers.  The Tx channel is given a block
+			each time there are characters to send. */
+			serCOM0->US_RPR = ( unsigned long ) ucRxDMABuffers[ 0 ];
+			serCOM0->US_RCR = serRX_DMA_BLOCK_SIZE;
+			serCOM0->US_RNPR = ( unsigned long ) ucRxDMABuffers[ 1 ];
+			serCOM0->US_RNCR = serRX_DMA_BLOCK_SIZE;
+			serCOM0->US_TCR = 0;
+			serCOM0->US_PTCR = AT91C_PDC_RXTEN | AT91C_PDC_TXTEN;
+
+			/* The receiver time-out starts counting once a character has been
+			received after STTTO. */
+			serCOM0->US_RTOR = serRX_TIMEOUT_BITS;
+
 			/* Enable Rx and Tx. */
-			serCOM0->US_CR = AT91C_US_RXEN | AT91C_US_TXEN;
+			serCOM0->US_CR = AT91C_US_RXEN | AT91C_US_TXEN | AT91C_US_STTTO;
 
-			/* Enable the Rx interrupts.  The Tx interrupts are not enabled
+			/* Enable the Rx interrupts.  The Tx interrupt is not enabled
 			until there are characters to be transmitted. */
-    		AT91F_US_EnableIt( serCOM0, AT91C_US_RXRDY );
+    		AT91F_US_EnableIt( serCOM0, AT91C_US_ENDRX | AT91C_US_TIMEOUT );
 
 			/* Enable the interrupts in the AIC. */
 			AT91F_AIC_ConfigureIt( AT91C_BASE_AIC, AT91C_ID_US0, serINTERRUPT_LEVEL, AT91C_AIC_SRCTYPE_INT_LEVEL_SENSITIVE, ( void (*)( void ) ) vSerialISREntry );
@@ -148,6 +277,8 @@ extern void ( vUART_ISR )( void );
 }
 /*-----------------------------------------------------------*/
 
+#if serUSE_RX_FRAMES == 0
+
 signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedChar, portTickType xBlockTime )
 {
 	/* The port handle is not required as this driver only supports one port. */
@@ -155,7 +286,7 @@ signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedC
 
 	/* Get the next character from the buffer.  Return false if no characters
 	are available, or arrive before xBlockTime expires. */
-	if( xQueueReceive( xRxedChars, pcRxedChar, xBlockTime ) )
+	if( xStreamBufferReceive( xRxedChars, pcRxedChar, sizeof( signed char ), xBlockTime ) != ( size_t ) 0 )
 	{
 		return pdTRUE;
 	}
@@ -166,44 +297,124 @@ signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed char *pcRxedC
 }
 /*-----------------------------------------------------------*/
 
-void vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength )
+unsigned short usSerialRead( xComPortHandle pxPort, signed char *pcBuffer, unsigned short usMaxLength, portTickType xBlockTime )
+{
+	/* The port handle is not required as this driver only supports one port. */
+	( void ) pxPort;
+
+	/* Return whatever has arrived, up to usMaxLength characters, as soon as
+	anything is available. */
+	return ( unsigned short ) xStreamBufferReceive( xRxedChars, pcBuffer, ( size_t ) usMaxLength, xBlockTime );
+}
+/*-----------------------------------------------------------*/
+
+#else /* serUSE_RX_FRAMES */
+
+portBASE_TYPE xSerialGetFrame( xComPortHandle pxPort, xSerialFrame *pxFrame, portTickType xBlockTime )
+{
+xFrameDescriptor xDescriptor;
+unsigned long ulOffset, ulFirst;
+unsigned char * const pucBuffer = &( ucRxDMABuffers[ 0 ][ 0 ] );
+
+	/* The port handle is not required as this driver only supports one port. */
+	( void ) pxPort;
+
+	if( xQueueReceive( xRxFrames, &xDescriptor, xBlockTime ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	/* Point at the frame in the receive buffers, in two parts if it wraps
+	from the end of the second buffer to the start of the first. */
+	ulOffset = xDescriptor.ulStart & ( serRX_BUFFER_SIZE - 1UL );
+	ulFirst = serRX_BUFFER_SIZE - ulOffset;
+	if( ulFirst > xDescriptor.usLength )
+	{
+		ulFirst = xDescriptor.usLength;
+	}
+
+	pxFrame->pucData[ 0 ] = &( pucBuffer[ ulOffset ] );
+	pxFrame->usLength[ 0 ] = ( unsigned short ) ulFirst;
+	pxFrame->pucData[ 1 ] = pucBuffer;
+	pxFrame->usLength[ 1 ] = ( unsigned short ) ( xDescriptor.usLength - ulFirst );
+	pxFrame->ulEnd = xDescriptor.ulStart + xDescriptor.usLength;
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSerialFrameIsIntact( xComPortHandle pxPort, const xSerialFrame *pxFrame )
 {
-signed char *pxNext;
+unsigned long ulStart, ulReceived;
 
-	/* A couple of parameters that this port does not use. */
-	( void ) usStringLength;
+	/* The port handle is not required as this driver only supports one port. */
 	( void ) pxPort;
 
-	/* NOTE: This implementation does not handle the queue being full as no
+	ulStart = pxFrame->ulEnd - ( unsigned long ) ( pxFrame->usLength[ 0 ] + pxFrame->usLength[ 1 ] );
+
+	portENTER_CRITICAL();
+	{
+		ulReceived = prvRxCount();
+	}
+	portEXIT_CRITICAL();
+
+	/* The frame has not been overwritten as long as the PDC has not yet come
+	round to its first byte again. */
+	return ( ( ulReceived - ulStart ) <= serRX_BUFFER_SIZE ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* serUSE_RX_FRAMES */
+
+void vSerialPutString( xComPortHandle pxPort, const signed char * const pcString, unsigned short usStringLength )
+{
+	/* NOTE: This implementation does not handle the buffer being full as no
 	block time is used! */
+	( void ) usSerialWrite( pxPort, pcString, usStringLength, serNO_BLOCK );
+}
+/*-----------------------------------------------------------*/
+
+unsigned short usSerialWrite( xComPortHandle pxPort, const signed char * const pcBuffer, unsigned short usLength, portTickType xBlockTime )
+{
+size_t xBytesSent;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
 	/* The port handle is not required as this driver only supports UART0. */
 	( void ) pxPort;
 
-	/* Send each character in the string, one at a time. */
-	pxNext = ( signed char * ) pcString;
-	while( *pxNext )
+	/* Copy the whole buffer into the Tx stream buffer in one operation. */
+	xBytesSent = xStreamBufferSend( xCharsForTx, pcBuffer, ( size_t ) usLength, xBlockTime );
+
+	if( xBytesSent != ( size_t ) 0 )
 	{
-		xSerialPutChar( pxPort, *pxNext, serNO_BLOCK );
-		pxNext++;
+		/* Start the PDC if it is idle.  Interrupts are masked so the current
+		transfer cannot end between the test and the start. */
+		portENTER_CRITICAL();
+		{
+			if( xTxDMABusy == pdFALSE )
+			{
+				prvStartNextTxBlock( &xHigherPriorityTaskWoken );
+			}
+		}
+		portEXIT_CRITICAL();
+
+		if( xHigherPriorityTaskWoken != pdFALSE )
+		{
+			taskYIELD();
+		}
 	}
+
+	return ( unsigned short ) xBytesSent;
 }
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed char cOutChar, portTickType xBlockTime )
 {
-	/* Place the character in the queue of characters to be transmitted. */
-	if( xQueueSend( xCharsForTx, &cOutChar, xBlockTime ) != pdPASS )
+	if( usSerialWrite( pxPort, &cOutChar, sizeof( signed char ), xBlockTime ) == 0 )
 	{
 		return pdFAIL;
 	}
 
-	/* Turn on the Tx interrupt so the ISR will remove the character from the
-	queue and send it.   This does not need to be in a critical section as
-	if the interrupt has already removed the character the next interrupt
-	will simply turn off the Tx interrupt again. */
-	vInterruptOn();
-
 	return pdPASS;
 }
 /*-----------------------------------------------------------*/
@@ -214,6 +425,93 @@ void vSerialClose( xComPortHandle xPort )
 }
 /*-----------------------------------------------------------*/
 
+static void prvStartNextTxBlock( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+size_t xBytes;
+
+	xBytes = xStreamBufferReceiveFromISR( xCharsForTx, ucTxDMABlock, sizeof( ucTxDMABlock ), pxHigherPriorityTaskWoken );
+
+	if( xBytes != ( size_t ) 0 )
+	{
+		serCOM0->US_TPR = ( unsigned long ) ucTxDMABlock;
+		serCOM0->US_TCR = ( unsigned long ) xBytes;
+		xTxDMABusy = pdTRUE;
+		AT91F_US_EnableIt( serCOM0, AT91C_US_ENDTX );
+	}
+	else
+	{
+		/* ENDTX stays set while TCR is zero, so the interrupt must be turned
+		off until there is another block. */
+		xTxDMABusy = pdFALSE;
+		AT91F_US_DisableIt( serCOM0, AT91C_US_ENDTX );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if serUSE_RX_FRAMES == 1
+
+static unsigned long prvRxCount( void )
+{
+unsigned long ulBlocks, ulRemaining;
+
+	/* A buffer that has been filled but not yet counted by the ISR shows as
+	a pending ENDRX, in which case RCR already counts down the next buffer.
+	Reading the flag on both sides of RCR shows which buffer RCR belongs
+	to. */
+	ulBlocks = ulRxBlocks;
+	if( ( serCOM0->US_CSR & AT91C_US_ENDRX ) != 0UL )
+	{
+		ulBlocks++;
+		ulRemaining = serCOM0->US_RCR;
+	}
+	else
+	{
+		ulRemaining = serCOM0->US_RCR;
+		if( ( serCOM0->US_CSR & AT91C_US_ENDRX ) != 0UL )
+		{
+			/* The buffer filled while RCR was being read. */
+			ulBlocks++;
+			ulRemaining = serCOM0->US_RCR;
+		}
+	}
+
+	return ( ulBlocks * serRX_DMA_BLOCK_SIZE ) + ( serRX_DMA_BLOCK_SIZE - ulRemaining );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndRxFrame( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned long ulEnd;
+xFrameDescriptor xDescriptor;
+
+	ulEnd = prvRxCount();
+	xDescriptor.ulStart = ulRxFrameStart;
+	ulRxFrameStart = ulEnd;
+
+	/* A frame longer than the buffers has already overwritten itself, so is
+	dropped, as is a frame that arrives while the queue is full. */
+	if( ( ulEnd != xDescriptor.ulStart ) && ( ( ulEnd - xDescriptor.ulStart ) <= serRX_BUFFER_SIZE ) )
+	{
+		xDescriptor.usLength = ( unsigned short ) ( ulEnd - xDescriptor.ulStart );
+		xQueueSendFromISR( xRxFrames, &xDescriptor, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* serUSE_RX_FRAMES */
+
+static void prvCopyRxData( unsigned portBASE_TYPE uxReceived, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+	if( uxReceived > uxRxCopied )
+	{
+		xStreamBufferSendFromISR( xRxedChars, &( ucRxDMABuffers[ uxRxActive ][ uxRxCopied ] ), ( size_t ) ( uxReceived - uxRxCopied ), pxHigherPriorityTaskWoken );
+		uxRxCopied = uxReceived;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* serUSE_RX_FRAMES */
+
 /* Serial port ISR.  This can cause a context switch so is not defined as a
 standard ISR using the __irq keyword.  Instead a wrapper function is defined
 within serialISR.s79 which in turn calls this function.  See the port
@@ -221,36 +519,45 @@ documentation on the FreeRTOS.org website for more information. */
 __arm void vSerialISR( void )
 {
 unsigned long ulStatus;
-signed char cChar;
 portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
 	/* What caused the interrupt? */
-	ulStatus = serCOM0->US_CSR &= serCOM0->US_IMR;
+	ulStatus = serCOM0->US_CSR & serCOM0->US_IMR;
 
-	if( ulStatus & AT91C_US_TXRDY )
+	if( ulStatus & AT91C_US_ENDTX )
 	{
-		/* The interrupt was caused by the THR becoming empty.  Are there any
-		more characters to transmit? */
-		if( xQueueReceiveFromISR( xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
-		{
-			/* A character was retrieved from the queue so can be sent to the
-			THR now. */
-			serCOM0->US_THR = cChar;
-		}
-		else
-		{
-			/* Queue empty, nothing to send so turn off the Tx interrupt. */
-			vInterruptOff();
-		}		
+		/* The block has been sent.  Start the next one, if any. */
+		prvStartNextTxBlock( &xHigherPriorityTaskWoken );
 	}
 
-	if( ulStatus & AT91C_US_RXRDY )
+	if( ulStatus & AT91C_US_ENDRX )
 	{
-		/* The interrupt was caused by a character being received.  Grab the
-		character from the RHR and place it in the queue or received 
-		characters. */
-		cChar = serCOM0->US_RHR;
-		xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
+		/* The active buffer is full and the PDC has moved on to the other
+		one.  Pass on the rest of the full buffer, then queue it again as
+		the next buffer, which also clears ENDRX. */
+		#if serUSE_RX_FRAMES == 1
+			ulRxBlocks++;
+		#else
+			prvCopyRxData( serRX_DMA_BLOCK_SIZE, &xHigherPriorityTaskWoken );
+			uxRxCopied = 0;
+		#endif
+
+		serCOM0->US_RNPR = ( unsigned long ) ucRxDMABuffers[ uxRxActive ];
+		serCOM0->US_RNCR = serRX_DMA_BLOCK_SIZE;
+		uxRxActive ^= 1;
+	}
+
+	if( ulStatus & AT91C_US_TIMEOUT )
+	{
+		/* The line has gone idle.  Pass on what has arrived, and restart
+		the time-out for the next burst. */
+		#if serUSE_RX_FRAMES == 1
+			prvEndRxFrame( &xHigherPriorityTaskWoken );
+		#else
+			prvCopyRxData( serRX_DMA_BLOCK_SIZE - serCOM0->US_RCR, &xHigherPriorityTaskWoken );
+		#endif
+
+		serCOM0->US_CR = AT91C_US_STTTO;
 	}
 
 	/* If a task was woken by either a character being received or a character 
@@ -260,8 +567,3 @@ portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 	/* End the interrupt in the AIC. */
 	AT91C_BASE_AIC->AIC_EOICR = 0;
 }
-
-
-
-
-	
@@ -55,6 +55,9 @@
 #include "semphr.h"
 #include "task.h"
 
+/* Demo application includes. */
+#include "SAM7_EMAC.h"
+
 /* Wrapper for the EMAC interrupt. */
 void vEMACISR_Wrapper( void ) __attribute__((naked));
 
@@ -64,6 +67,9 @@ void vEMACISR_Handler( void ) __attribute__((noinline));
 
 static xSemaphoreHandle xEMACSemaphore;
 
+/* The number of Rx interrupts, read by vEMACGetRxStats(). */
+volatile unsigned long ulEMACRxInterrupts = 0UL;
+
 /*-----------------------------------------------------------*/
 
 void vPassEMACSemaphore( xSemaphoreHandle xSemaphore )
@@ -86,6 +92,16 @@ portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 		the Rx descriptors. */
 		xSemaphoreGiveFromISR( xEMACSemaphore, &xHigherPriorityTaskWoken );
 		AT91C_BASE_EMAC->EMAC_RSR = AT91C_EMAC_REC;
+		ulEMACRxInterrupts++;
+
+		#if emacUSE_RX_POLLING == 1
+		{
+			/* The uIP task will now poll the Rx descriptors until they are
+			empty, so further interrupts are not needed until then.
+			xEMACRxPollComplete() enables the interrupt again. */
+			AT91C_BASE_EMAC->EMAC_IDR = AT91C_EMAC_RCOMP;
+		}
+		#endif
 	}
 
 	/* Clear the interrupt. */
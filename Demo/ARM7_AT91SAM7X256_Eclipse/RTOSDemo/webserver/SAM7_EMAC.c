@@ -181,6 +181,18 @@ const unsigned char ucIPAddress[ 4 ]  = { uipIP_ADDR0, uipIP_ADDR1, uipIP_ADDR2,
 /* The semaphore used by the EMAC ISR to wake the EMAC task. */
 static xSemaphoreHandle xSemaphore = NULL;
 
+/* The next Rx descriptor to be inspected by ulEMACPoll(). */
+static unsigned portBASE_TYPE ulNextRxBuffer = 0;
+
+/* Coalescing statistics.  The count of interrupts is kept by the ISR. */
+extern volatile unsigned long ulEMACRxInterrupts;
+static xEMACRxStats xRxStats = { 0UL, 0UL, 0UL, 0UL };
+static unsigned long ulFramesSinceInterrupt = 0UL;
+
+/* The number of frames polled since the uIP task last paused or found the
+Rx descriptors empty. */
+static unsigned long ulFramesInBudget = 0UL;
+
 /*-----------------------------------------------------------*/
 
 xSemaphoreHandle xEMACInit( void )
@@ -344,7 +356,6 @@ char *pcBuffer;
 
 unsigned long ulEMACPoll( void )
 {
-static unsigned portBASE_TYPE ulNextRxBuffer = 0;
 unsigned long ulSectionLength = 0, ulLengthSoFar = 0, ulEOF = pdFALSE;
 char *pcSource;
 
@@ -416,10 +427,67 @@ char *pcSource;
 		ulSectionLength = 0;
 	}
 
+	if( ulSectionLength != 0 )
+	{
+		xRxStats.ulFrames++;
+		ulFramesSinceInterrupt++;
+		ulFramesInBudget++;
+	}
+
 	return ulSectionLength;
 }
 /*-----------------------------------------------------------*/
 
+portBASE_TYPE xEMACRxPollComplete( void )
+{
+	if( ulFramesSinceInterrupt > xRxStats.ulMaxFramesPerInterrupt )
+	{
+		xRxStats.ulMaxFramesPerInterrupt = ulFramesSinceInterrupt;
+	}
+	ulFramesSinceInterrupt = 0UL;
+	ulFramesInBudget = 0UL;
+
+	#if emacUSE_RX_POLLING == 1
+	{
+		/* Unmask the Rx interrupt.  This does nothing if the interrupt is
+		already enabled. */
+		AT91C_BASE_EMAC->EMAC_IER = AT91C_EMAC_RCOMP;
+	}
+	#endif
+
+	/* A frame that completed after ulEMACPoll() looked at the descriptors,
+	but before the interrupt was unmasked, might not generate an interrupt,
+	so look again. */
+	return ( xRxDescriptors[ ulNextRxBuffer ].addr & AT91C_OWNERSHIP_BIT ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xEMACRxBudgetExhausted( void )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	#if emacUSE_RX_POLLING == 1
+	{
+		if( ulFramesInBudget >= emacRX_POLL_BUDGET )
+		{
+			ulFramesInBudget = 0UL;
+			xRxStats.ulBudgetsExhausted++;
+			xReturn = pdTRUE;
+		}
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEMACGetRxStats( xEMACRxStats *pxStats )
+{
+	*pxStats = xRxStats;
+	pxStats->ulInterrupts = ulEMACRxInterrupts;
+}
+/*-----------------------------------------------------------*/
+
 static void prvSetupDescriptors(void)
 {
 unsigned portBASE_TYPE xIndex;
@@ -54,6 +54,37 @@
 #ifndef SAM_7_EMAC_H
 #define SAM_7_EMAC_H
 
+/* When emacUSE_RX_POLLING is 1 the EMAC ISR masks the Rx interrupt after the
+first frame, and the uIP task then polls the Rx descriptors until they are
+empty before re-enabling it.  A flood of frames therefore generates one
+interrupt rather than one per frame.  While polling the uIP task processes
+at most emacRX_POLL_BUDGET frames before blocking for emacRX_POLL_DELAY
+ticks, so a flood cannot starve the lower priority tasks - frames that
+arrive meanwhile wait in the Rx descriptors (or are dropped by the EMAC if
+the descriptors fill).  Set emacUSE_RX_POLLING to 0 to give the semaphore
+for every frame instead. */
+#ifndef emacUSE_RX_POLLING
+	#define emacUSE_RX_POLLING		1
+#endif
+
+#ifndef emacRX_POLL_BUDGET
+	#define emacRX_POLL_BUDGET		16
+#endif
+
+#ifndef emacRX_POLL_DELAY
+	#define emacRX_POLL_DELAY		( ( portTickType ) 1 )
+#endif
+
+/* Used with vEMACGetRxStats() to see how well received frames are being
+coalesced. */
+typedef struct xEMAC_RX_STATS
+{
+	unsigned long ulInterrupts;				/*< The number of Rx interrupts. */
+	unsigned long ulFrames;					/*< The number of frames passed to uIP. */
+	unsigned long ulMaxFramesPerInterrupt;	/*< The most frames processed between an Rx interrupt and the Rx descriptors next being empty. */
+	unsigned long ulBudgetsExhausted;		/*< The number of times the uIP task stopped polling because it had used its budget. */
+} xEMACRxStats;
+
 
 /*
  * Initialise the EMAC driver.  If successful a semaphore is returned that
@@ -74,4 +105,28 @@ long lEMACSend( void );
  */
 unsigned long ulEMACPoll( void );
 
+/*
+ * Called by the uIP task when ulEMACPoll() returns 0 because the Rx
+ * descriptors are empty.  Re-enables the Rx interrupt masked by the ISR
+ * (when emacUSE_RX_POLLING is 1).  A frame can arrive between ulEMACPoll()
+ * finding the descriptors empty and the interrupt being re-enabled, so
+ * pdTRUE is returned if the descriptors are no longer empty, in which case
+ * the uIP task must poll again rather than block.
+ */
+portBASE_TYPE xEMACRxPollComplete( void );
+
+/*
+ * Called by the uIP task after processing each frame.  Returns pdTRUE each
+ * time emacRX_POLL_BUDGET frames have been polled without the Rx descriptors
+ * becoming empty, in which case the uIP task should block for
+ * emacRX_POLL_DELAY ticks before polling again.  The Rx interrupt remains
+ * masked meanwhile.  Always returns pdFALSE if emacUSE_RX_POLLING is 0.
+ */
+portBASE_TYPE xEMACRxBudgetExhausted( void );
+
+/*
+ * Obtain a copy of the Rx interrupt coalescing statistics.
+ */
+void vEMACGetRxStats( xEMACRxStats *pxStats );
+
 #endif
@@ -119,8 +119,15 @@ struct timer periodic_timer, arp_timer;
 					lEMACSend();
 				}
 			}
+
+			/* Give the other tasks a chance to run if frames are arriving
+			faster than they can be processed. */
+			if( xEMACRxBudgetExhausted() != pdFALSE )
+			{
+				vTaskDelay( emacRX_POLL_DELAY );
+			}
 		}
-		else
+		else if( xEMACRxPollComplete() == pdFALSE )
 		{
 			if( timer_expired( &periodic_timer ) )
 			{
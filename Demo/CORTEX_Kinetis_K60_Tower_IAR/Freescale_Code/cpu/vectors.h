@@ -23,6 +23,7 @@ extern void vPort_E_ISRHandler( void );
 void vEMAC_TxISRHandler( void );
 void vEMAC_RxISRHandler( void );
 void vEMAC_ErrorISRHandler( void );
+void vEMAC_1588ISRHandler( void );
 
 // function prototype for default_isr in vectors.c
 void default_isr(void);
@@ -129,7 +130,7 @@ extern void __iar_program_start(void);
 #define VECTOR_088      default_isr     // 0x0000_0160 88    72     PDB
 #define VECTOR_089      default_isr     // 0x0000_0164 89    73     USB OTG
 #define VECTOR_090      default_isr     // 0x0000_0168 90    74     USB Charger Detect
-#define VECTOR_091      default_isr     // 0x0000_016C 91    75		ENET			 IEEE 1588 Timer interrupt			
+#define VECTOR_091      vEMAC_1588ISRHandler     // 0x0000_016C 91    75		ENET			 IEEE 1588 Timer interrupt			
 #define VECTOR_092      vEMAC_TxISRHandler     // 0x0000_0170 92    76		ENET			 Transmit interrupt
 #define VECTOR_093      vEMAC_RxISRHandler     // 0x0000_0174 93    77		ENET			 Receive interrupt
 #define VECTOR_094      vEMAC_ErrorISRHandler  // 0x0000_0178 94    78		ENET			 Error and miscellaneous interrupt
@@ -64,6 +64,7 @@
 #include "net/uip.h"
 #include "net/uip_arp.h"
 #include "apps/httpd/httpd.h"
+#include "apps/ptp/ptpd.h"
 #include "sys/timer.h"
 #include "net/clock-arch.h"
 #include "emac.h"
@@ -77,11 +78,12 @@ variable is just a pointer to an Ethernet buffer, and not a buffer in its own
 right. */
 extern unsigned char *uip_buf;
 
-/* The ARP timer and the periodic timer share a callback function, so the
-respective timer IDs are used to determine which timer actually expired.  These
-constants are assigned to the timer IDs. */
+/* The ARP timer, the periodic timer and the PTP timer share a callback
+function, so the respective timer IDs are used to determine which timer actually
+expired.  These constants are assigned to the timer IDs. */
 #define uipARP_TIMER				0
 #define uipPERIODIC_TIMER			1
+#define uipPTP_TIMER				2
 
 /* The length of the queue used to send events from timers or the Ethernet
 driver to the uIP stack. */
@@ -107,8 +109,8 @@ static void prvSetMACAddress( void );
 static void prvInitialise_uIP( void );
 
 /*
- * The callback function that is assigned to both the periodic timer and the
- * ARP timer.
+ * The callback function that is assigned to the periodic timer, the ARP timer
+ * and the PTP timer.
  */
 static void prvUIPTimerCallback( xTimerHandle xTimer );
 
@@ -145,6 +147,9 @@ unsigned short usPacketLength;
 	/* Initialise the MAC and PHY. */
 	vEMACInit();
 
+	/* The MAC clock follows any PTP master on the network. */
+	vPTPInit( ptpROLE_SLAVE );
+
 	for( ;; )
 	{
 		/* Is there received data ready to be processed? */
@@ -181,6 +186,11 @@ unsigned short usPacketLength;
 					vEMACWrite();
 				}
 			}
+			else if( xHeader->type == htons( ptpETHTYPE ) )
+			{
+				/* Any reply is sent from within vPTPInput(). */
+				vPTPInput();
+			}
 		}
 		else
 		{
@@ -218,6 +228,17 @@ unsigned short usPacketLength;
 			uip_arp_timer();
 		}
 
+		/* Statements to be executed if the PTP timer has expired. */
+		if( ( ulUIP_Events & uipPTP_TIMER_EVENT ) != 0 )
+		{
+			ulUIP_Events &= ~uipPTP_TIMER_EVENT;
+
+			if( uip_buf != NULL )
+			{
+				vPTPTimer();
+			}
+		}
+
 		/* If all latched events have been cleared - block until another event
 		occurs. */
 		if( ulUIP_Events == pdFALSE )
@@ -247,7 +268,7 @@ struct uip_eth_addr xAddr;
 static void prvInitialise_uIP( void )
 {
 uip_ipaddr_t xIPAddr;
-xTimerHandle xARPTimer, xPeriodicTimer;
+xTimerHandle xARPTimer, xPeriodicTimer, xPTPTimer;
 
 	uip_init();
 	uip_ipaddr( &xIPAddr, configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 );
@@ -275,15 +296,24 @@ xTimerHandle xARPTimer, xPeriodicTimer;
 									prvUIPTimerCallback
 								);
 
+	xPTPTimer = xTimerCreate( 	( signed char * ) "PTPTimer",
+								( ptpTIMER_PERIOD_MS / portTICK_RATE_MS ),
+								pdTRUE, /* Autor-reload. */
+								( void * ) uipPTP_TIMER,
+								prvUIPTimerCallback
+							);
+
 	/* Sanity check that the timers were indeed created. */
 	configASSERT( xARPTimer );
 	configASSERT( xPeriodicTimer );
+	configASSERT( xPTPTimer );
 	configASSERT( xEMACEventQueue );
 
 	/* These commands will block indefinitely until they succeed, so there is
 	no point in checking their return values. */
 	xTimerStart( xARPTimer, portMAX_DELAY );
 	xTimerStart( xPeriodicTimer, portMAX_DELAY );
+	xTimerStart( xPTPTimer, portMAX_DELAY );
 }
 /*-----------------------------------------------------------*/
 
@@ -291,9 +321,10 @@ static void prvUIPTimerCallback( xTimerHandle xTimer )
 {
 static const unsigned long ulARPTimerExpired = uipARP_TIMER_EVENT;
 static const unsigned long ulPeriodicTimerExpired = uipPERIODIC_TIMER_EVENT;
+static const unsigned long ulPTPTimerExpired = uipPTP_TIMER_EVENT;
 
 	/* This is a time callback, so calls to xQueueSend() must not attempt to
-	block.  As this callback is assigned to both the ARP and Periodic timers, the
+	block.  As this callback is assigned to the ARP, Periodic and PTP timers, the
 	first thing to do is ascertain which timer it was that actually expired. */
 	switch( ( int ) pvTimerGetTimerID( xTimer ) )
 	{
@@ -303,6 +334,9 @@ static const unsigned long ulPeriodicTimerExpired = uipPERIODIC_TIMER_EVENT;
 		case uipPERIODIC_TIMER	:	xQueueSend( xEMACEventQueue, &ulPeriodicTimerExpired, uipDONT_BLOCK );
 									break;
 
+		case uipPTP_TIMER		:	xQueueSend( xEMACEventQueue, &ulPTPTimerExpired, uipDONT_BLOCK );
+									break;
+
 		default					:  	/* Should not get here. */
 									break;
 	}
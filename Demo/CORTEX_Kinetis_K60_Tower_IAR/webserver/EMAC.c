@@ -64,6 +64,7 @@
 
 /* uIP includes. */
 #include "net/uip.h"
+#include "apps/ptp/ptpd.h"
 
 /* The time to wait between attempts to obtain a free buffer. */
 #define emacBUFFER_WAIT_DELAY_ms		( 3 / portTICK_RATE_MS )
@@ -93,11 +94,21 @@ become free. */
 #define emacTX_INTERRUPT_NO			( 76 )
 #define emacRX_INTERRUPT_NO			( 77 )
 #define emacERROR_INTERRUPT_NO		( 78 )
+#define emac1588_INTERRUPT_NO		( 75 )
 #define emacLINK_DELAY				( 500 / portTICK_RATE_MS )
 #define emacPHY_STATUS				( 0x1F )
 #define emacPHY_DUPLEX_STATUS		( 4 << 2 )
 #define emacPHY_SPEED_STATUS		( 1 << 2 )
 
+/* The 1588 timer counts nanoseconds and wraps each second.  The seconds are
+counted by the interrupt generated when it wraps. */
+#define emacNS_PER_SECOND			( 1000000000UL )
+
+/* The time to wait between checks that a frame has been sent when the time
+at which it was sent is required, and the number of times to check. */
+#define emacTX_TIMESTAMP_WAIT_DELAY	( 1 )
+#define emacTX_TIMESTAMP_WAIT_ATTEMPTS	( 10 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -126,6 +137,22 @@ static unsigned short prvCheckRxStatus( void );
  */
 static void prvResetEverything( void );
 
+/*
+ * Configure the 1588 timer to count nanoseconds from the system clock.
+ */
+static void prvInitialisePTPTimer( void );
+
+/*
+ * Read the 1588 timer and the count of seconds.  Must be called from a
+ * critical section.
+ */
+static void prvReadPTPTimer( xPTPTime *pxTime );
+
+/*
+ * Convert a 1588 timer value taken within the last second into a time.
+ */
+static void prvTimestampToTime( unsigned long ulTimestamp, xPTPTime *pxTime );
+
 /*-----------------------------------------------------------*/
 
 /* The buffers and descriptors themselves.  */
@@ -154,11 +181,27 @@ static unsigned long ulRxDescriptorIndex = 0UL;
 one of the Ethernet buffers when its actually in use. */
 unsigned char *uip_buf = NULL;
 
+/* The seconds part of the 1588 time, the nanoseconds being held by the timer
+itself. */
+static volatile unsigned long ulPTPSeconds = 0UL;
+
+/* The number of nanoseconds the 1588 timer advances each clock. */
+static unsigned long ulPTPIncrement;
+
+/* The 1588 timer value at which the frame most recently returned by
+usEMACRead() was received. */
+static unsigned long ulRxTimestamp = 0UL;
+
+/* The multicast address used by PTP, which has to be let through the group
+address filter. */
+static const unsigned char ucPTPMulticastAddress[] = { 0x01, 0x1b, 0x19, 0x00, 0x00, 0x00 };
+
 /*-----------------------------------------------------------*/
 
 void vEMACInit( void )
 {
 int iData;
+unsigned char ucHash;
 extern int periph_clk_khz;
 const unsigned portCHAR ucMACAddress[] =
 {
@@ -194,6 +237,10 @@ const unsigned portCHAR ucMACAddress[] =
 	set_irq_priority( emacERROR_INTERRUPT_NO, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
 	enable_irq( emacERROR_INTERRUPT_NO );
 
+	/* Configure the interrupt that counts the seconds of the 1588 timer. */
+	set_irq_priority( emac1588_INTERRUPT_NO, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
+	enable_irq( emac1588_INTERRUPT_NO );
+
 	/* Configure the pins to the PHY - RMII mode used. */
 	PORTB_PCR0  = PORT_PCR_MUX( 4 ); /* RMII0_MDIO / MII0_MDIO. */
 	PORTB_PCR1  = PORT_PCR_MUX( 4 ); /* RMII0_MDC / MII0_MDC */
@@ -234,6 +281,17 @@ const unsigned portCHAR ucMACAddress[] =
 	ENET_GALR = 0;
 	ENET_GAUR = 0;
 
+	/* Let PTP messages through the group address filter. */
+	ucHash = enet_hash_address( ucPTPMulticastAddress );
+	if( ucHash >= 32 )
+	{
+		ENET_GAUR |= ( 1UL << ( ucHash - 32 ) );
+	}
+	else
+	{
+		ENET_GALR |= ( 1UL << ucHash );
+	}
+
 	/* Set the Physical Address for the selected ENET */
 	enet_set_address( 0, ucMACAddress );
 
@@ -261,11 +319,25 @@ const unsigned portCHAR ucMACAddress[] =
 		ENET_RCR |= ENET_RCR_RMII_10T_MASK;
 	}
 
+	/* Use the enhanced descriptors, which hold the 1588 timer value at which
+	each frame was sent or received. */
     ENET_ECR = ENET_ECR_EN1588_MASK;
+	prvInitialisePTPTimer();
 
 	/* Store and forward checksum. */
 	ENET_TFWR = ENET_TFWR_STRFWD_MASK;
 
+	#if UIP_CHECKSUM_OFFLOAD
+	{
+		/* Have the ENET insert the IP header and protocol checksums into
+		outgoing frames, which requires the store and forward mode set above,
+		and discard incoming frames in which either checksum is wrong.  uIP
+		then does not calculate or check checksums itself. */
+		ENET_TACC = ENET_TACC_IPCHK_MASK | ENET_TACC_PROCHK_MASK;
+		ENET_RACC = ENET_RACC_IPDIS_MASK | ENET_RACC_PRODIS_MASK;
+	}
+	#endif
+
 	/* Set Rx Buffer Size */
 	ENET_MRBR = ( unsigned short ) UIP_BUFSIZE;
 	
@@ -286,6 +358,8 @@ const unsigned portCHAR ucMACAddress[] =
 			| ENET_EIMR_TXF_MASK/* only for complete frame, not partial buffer descriptor | ENET_EIMR_TXB_MASK*/
 			/*enet irqs*/
 			| ENET_EIMR_UN_MASK | ENET_EIMR_RL_MASK | ENET_EIMR_LC_MASK | ENET_EIMR_BABT_MASK | ENET_EIMR_BABR_MASK | ENET_EIMR_EBERR_MASK
+			/*1588 timer wrap*/
+			| ENET_EIMR_TS_TIMER_MASK
 			;
 	
 	/* Enable the MAC itself. */
@@ -340,6 +414,10 @@ long x;
 
 	/* The last descriptor points back to the start. */
 	pxDescriptor->status |= TX_BD_W;
+
+	/* Each frame is sent by both descriptors.  Have the first record the time
+	at which the frame was sent, for use by PTP. */
+	xTxDescriptors[ 0 ].ebd_status |= TX_BD_TS;
 	
 	/* Use the first Rx descriptor to start with. */
 	ulRxDescriptorIndex = 0UL;
@@ -452,8 +530,10 @@ unsigned short usBytesReceived;
 		the buffer that contains the received data. */
 		prvReturnBuffer( uip_buf );
 
-		/* Point uip_buf to the data about to be processed. */
+		/* Point uip_buf to the data about to be processed, and note when it
+		was received. */
 		uip_buf = ( void * ) pxCurrentRxDesc->data;
+		ulRxTimestamp = __REV( pxCurrentRxDesc->timestamp );
 		uip_buf = ( void * ) __REV( ( unsigned long ) uip_buf );
 		
 		/* Allocate a new buffer to the descriptor, as uip_buf is now using it's
@@ -556,8 +636,9 @@ extern xQueueHandle xEMACEventQueue;
 
 void vEMAC_ErrorISRHandler( void )
 {
-	/* Clear the interrupt. */
-	ENET_EIR = ENET_EIR & ENET_EIMR;
+	/* Clear the interrupt.  The 1588 timer wrap is left for its own handler
+	to count. */
+	ENET_EIR = ENET_EIR & ENET_EIMR & ~ENET_EIR_TS_TIMER_MASK;
 
 	/* Attempt recovery.  Not very sophisticated. */
 	prvInitialiseDescriptors();
@@ -565,4 +646,172 @@ void vEMAC_ErrorISRHandler( void )
 }
 /*-----------------------------------------------------------*/
 
+void vEMAC_1588ISRHandler( void )
+{
+	/* Clear the interrupt. */
+	ENET_EIR = ENET_EIR_TS_TIMER_MASK;
+
+	/* The nanoseconds have wrapped. */
+	ulPTPSeconds++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialisePTPTimer( void )
+{
+extern int core_clk_khz;
 
+	/* The timer is clocked by the system clock, which must be a whole number
+	of nanoseconds - 10ns at 100MHz. */
+	ulPTPIncrement = 1000000UL / ( unsigned long ) core_clk_khz;
+	
+	ENET_ATCR = ENET_ATCR_RESTART_MASK;
+	ENET_ATINC = ENET_ATINC_INC( ulPTPIncrement );
+	ENET_ATCOR = 0;
+	ENET_ATPER = emacNS_PER_SECOND;
+	ENET_ATCR = ENET_ATCR_PEREN_MASK | ENET_ATCR_EN_MASK;
+	ulPTPSeconds = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadPTPTimer( xPTPTime *pxTime )
+{
+	/* Capture the timer, reading ATCR back to ensure the capture is complete
+	before ATVR is read. */
+	ENET_ATCR |= ENET_ATCR_CAPTURE_MASK;
+	( void ) ENET_ATCR;
+	pxTime->ulNanoseconds = ENET_ATVR;
+	pxTime->ulSeconds = ulPTPSeconds;
+
+	/* If the timer has wrapped but the interrupt has not been serviced yet
+	then the seconds count is one behind. */
+	if( ( ( ENET_EIR & ENET_EIR_TS_TIMER_MASK ) != 0 ) && ( pxTime->ulNanoseconds < ( emacNS_PER_SECOND / 2UL ) ) )
+	{
+		( pxTime->ulSeconds )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimestampToTime( unsigned long ulTimestamp, xPTPTime *pxTime )
+{
+	vEMACPTPGetTime( pxTime );
+
+	/* The timestamp was taken less than a second ago, so if it is greater
+	than the current nanoseconds then it was taken in the previous second. */
+	if( ulTimestamp > pxTime->ulNanoseconds )
+	{
+		( pxTime->ulSeconds )--;
+	}
+	pxTime->ulNanoseconds = ulTimestamp;
+}
+/*-----------------------------------------------------------*/
+
+void vEMACPTPGetTime( xPTPTime *pxTime )
+{
+	taskENTER_CRITICAL();
+	{
+		prvReadPTPTimer( pxTime );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vEMACPTPStepTime( long lSeconds, long lNanoseconds )
+{
+xPTPTime xNow;
+
+	/* Bring the nanoseconds into range before adding them to the current
+	time, so the sum cannot overflow. */
+	while( lNanoseconds >= ( long ) emacNS_PER_SECOND )
+	{
+		lNanoseconds -= ( long ) emacNS_PER_SECOND;
+		lSeconds++;
+	}
+	while( lNanoseconds < 0L )
+	{
+		lNanoseconds += ( long ) emacNS_PER_SECOND;
+		lSeconds--;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		prvReadPTPTimer( &xNow );
+		xNow.ulNanoseconds += ( unsigned long ) lNanoseconds;
+		xNow.ulSeconds += ( unsigned long ) lSeconds;
+		if( xNow.ulNanoseconds >= emacNS_PER_SECOND )
+		{
+			xNow.ulNanoseconds -= emacNS_PER_SECOND;
+			( xNow.ulSeconds )++;
+		}
+
+		/* Any wrap that is pending has already been accounted for. */
+		ENET_ATVR = xNow.ulNanoseconds;
+		ENET_EIR = ENET_EIR_TS_TIMER_MASK;
+		ulPTPSeconds = xNow.ulSeconds;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vEMACPTPAdjustFrequency( long lPartsPerBillion )
+{
+unsigned long ulPeriod, ulCorrectedIncrement;
+
+	if( lPartsPerBillion == 0L )
+	{
+		ENET_ATCOR = 0;
+		ENET_ATINC = ENET_ATINC_INC( ulPTPIncrement );
+	}
+	else
+	{
+		/* Once every ulPeriod clocks the timer advances by one nanosecond more
+		(or less) than ulPTPIncrement, changing its rate by one part in
+		( ulPeriod * ulPTPIncrement ). */
+		if( lPartsPerBillion > 0L )
+		{
+			ulCorrectedIncrement = ulPTPIncrement + 1UL;
+		}
+		else
+		{
+			ulCorrectedIncrement = ulPTPIncrement - 1UL;
+			lPartsPerBillion = -lPartsPerBillion;
+		}
+
+		ulPeriod = emacNS_PER_SECOND / ( ( unsigned long ) lPartsPerBillion * ulPTPIncrement );
+		if( ulPeriod == 0UL )
+		{
+			ulPeriod = 1UL;
+		}
+
+		ENET_ATINC = ENET_ATINC_INC( ulPTPIncrement ) | ENET_ATINC_INC_CORR( ulCorrectedIncrement );
+		ENET_ATCOR = ulPeriod;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vEMACPTPGetRxTime( xPTPTime *pxTime )
+{
+	prvTimestampToTime( ulRxTimestamp, pxTime );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xEMACPTPGetTxTime( xPTPTime *pxTime )
+{
+long x;
+portBASE_TYPE xReturn = pdFAIL;
+
+	/* The first descriptor holds the time once it has sent the frame. */
+	for( x = 0; x < emacTX_TIMESTAMP_WAIT_ATTEMPTS; x++ )
+	{
+		if( ( xTxDescriptors[ 0 ].status & TX_BD_R ) == 0 )
+		{
+			prvTimestampToTime( __REV( xTxDescriptors[ 0 ].timestamp ), pxTime );
+			xReturn = pdPASS;
+			break;
+		}
+
+		vTaskDelay( emacTX_TIMESTAMP_WAIT_DELAY );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
@@ -141,6 +141,13 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_UDP_CHECKSUMS   1
 
+/**
+ * The ENET calculates and checks the IP, TCP, UDP and ICMP checksums
+ *
+ * \hideinitializer
+ */
+#define UIP_CONF_CHECKSUM_OFFLOAD 1
+
 /**
  * uIP statistics on or off
  *
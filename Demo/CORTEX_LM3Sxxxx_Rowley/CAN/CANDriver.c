@@ -0,0 +1,349 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Interrupt driven CAN driver for the Stellaris CAN0 controller - see
+ * CANDriver.h.
+ *
+ * Message objects are numbered from 1.  Receive filters are given objects
+ * from 1 upwards, the transmit mailboxes are the top canTX_MAILBOXES
+ * objects.  The status interrupt is not enabled as it would fire on every
+ * frame seen on the bus; only the error interrupt is, to catch bus off.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Library includes. */
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_can.h"
+#include "interrupt.h"
+#include "sysctl.h"
+#include "gpio.h"
+
+#include "CANDriver.h"
+
+#define canMESSAGE_OBJECTS			32UL
+#define canFIRST_TX_OBJECT			( canMESSAGE_OBJECTS - canTX_MAILBOXES + 1UL )
+#define canRX_OBJECTS				( canFIRST_TX_OBJECT - 1UL )
+
+#if ( canTX_MAILBOXES < 1 ) || ( canTX_MAILBOXES > 16 )
+	#error canTX_MAILBOXES must be between 1 and 16.
+#endif
+
+/* CAN0 Rx and Tx are on PD0 and PD1 of the LM3S8962. */
+#define canGPIO_PERIPH				SYSCTL_PERIPH_GPIOD
+#define canGPIO_BASE				GPIO_PORTD_BASE
+#define canGPIO_PINS				( GPIO_PIN_0 | GPIO_PIN_1 )
+
+/* The queue each receive object posts to, indexed by object number - 1. */
+static xQueueHandle xRxQueues[ canRX_OBJECTS ];
+static unsigned long ulRxObjectsUsed = 0UL;
+
+/* Frames waiting for a mailbox. */
+static xQueueHandle xTxQueue = NULL;
+
+/* The number of mailboxes loaded in the batch being sent, 0 when the
+mailboxes are idle. */
+static volatile unsigned long ulTxBatch = 0UL;
+
+static xCANStats xStats;
+
+/*
+ * Load up to canTX_MAILBOXES queued frames into the mailboxes, enabling the
+ * transmit interrupt on the last only.  Called from the interrupt, or from
+ * a task within a critical section.
+ */
+static void prvLoadTxBatch( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Copy the frame out of receive object ulObject and post it to the queue of
+ * that object.
+ */
+static void prvReceive( unsigned long ulObject, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xCANInit( tCANBitClkParms *pxBitTiming )
+{
+	xTxQueue = xQueueCreate( canTX_QUEUE_LENGTH, ( unsigned portBASE_TYPE ) sizeof( xCANFrame ) );
+	if( xTxQueue == NULL )
+	{
+		return pdFAIL;
+	}
+
+	SysCtlPeripheralEnable( canGPIO_PERIPH );
+	SysCtlPeripheralEnable( SYSCTL_PERIPH_CAN0 );
+	GPIOPinTypeCAN( canGPIO_BASE, canGPIO_PINS );
+
+	/* CANInit() leaves the controller in init mode with every message object
+	cleared. */
+	CANInit( CAN0_BASE );
+	CANSetBitTiming( CAN0_BASE, pxBitTiming );
+	CANIntEnable( CAN0_BASE, CAN_INT_MASTER | CAN_INT_ERROR );
+
+	/* The handler uses the FreeRTOS API so must not be above 
+	configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+	IntPrioritySet( INT_CAN0, configKERNEL_INTERRUPT_PRIORITY );
+	IntEnable( INT_CAN0 );
+
+	CANEnable( CAN0_BASE );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xCANFilterAdd( xQueueHandle xQueue, unsigned long ulID, unsigned long ulIDMask, unsigned long ulFlags )
+{
+tCANMsgObject xMsgObject;
+unsigned long ulObject;
+
+	taskENTER_CRITICAL();
+	{
+		ulObject = ulRxObjectsUsed;
+		if( ulObject < canRX_OBJECTS )
+		{
+			ulRxObjectsUsed++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( ulObject >= canRX_OBJECTS )
+	{
+		return pdFAIL;
+	}
+
+	/* Set the queue before the object is enabled, the interrupt reads it as
+	soon as a frame matches. */
+	xRxQueues[ ulObject ] = xQueue;
+
+	xMsgObject.ulMsgID = ulID;
+	xMsgObject.ulMsgIDMask = ulIDMask;
+	xMsgObject.ulFlags = MSG_OBJ_RX_INT_ENABLE | MSG_OBJ_USE_ID_FILTER;
+	if( ulFlags & canFILTER_EXTENDED )
+	{
+		/* Also filter on the IDE bit so standard frames do not match. */
+		xMsgObject.ulFlags |= MSG_OBJ_EXTENDED_ID | MSG_OBJ_USE_EXT_FILTER;
+	}
+	xMsgObject.ulMsgLen = 8UL;
+	xMsgObject.pucMsgData = NULL;
+
+	/* The message object interface registers are shared with the interrupt,
+	which reads the receive objects and loads the mailboxes. */
+	taskENTER_CRITICAL();
+	{
+		CANMessageSet( CAN0_BASE, ulObject + 1UL, &xMsgObject, MSG_OBJ_TYPE_RX );
+	}
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xCANSend( const xCANFrame *pxFrame, portTickType xTicksToWait )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if( xQueueSend( xTxQueue, pxFrame, xTicksToWait ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	/* If no batch is in progress the interrupt will not run to load this
+	frame, so start a batch here. */
+	taskENTER_CRITICAL();
+	{
+		if( ulTxBatch == 0UL )
+		{
+			prvLoadTxBatch( &xHigherPriorityTaskWoken );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* Taking frames from the queue can unblock a task waiting to send. */
+	if( xHigherPriorityTaskWoken != pdFALSE )
+	{
+		taskYIELD();
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vCANGetStats( xCANStats *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTxBatch( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+tCANMsgObject xMsgObject;
+xCANFrame xFrame;
+unsigned long ulFrames, ulFrame;
+
+	ulFrames = ( unsigned long ) uxQueueMessagesWaitingFromISR( xTxQueue );
+	if( ulFrames > canTX_MAILBOXES )
+	{
+		ulFrames = canTX_MAILBOXES;
+	}
+
+	for( ulFrame = 0UL; ulFrame < ulFrames; ulFrame++ )
+	{
+		xQueueReceiveFromISR( xTxQueue, &xFrame, pxHigherPriorityTaskWoken );
+
+		xMsgObject.ulMsgID = xFrame.ulID;
+		xMsgObject.ulMsgIDMask = 0UL;
+		xMsgObject.ulFlags = MSG_OBJ_NO_FLAGS;
+		if( xFrame.ucFlags & canFRAME_EXTENDED )
+		{
+			xMsgObject.ulFlags |= MSG_OBJ_EXTENDED_ID;
+		}
+
+		/* The mailboxes are sent in object number order, so the last one
+		loaded completes the batch. */
+		if( ulFrame == ( ulFrames - 1UL ) )
+		{
+			xMsgObject.ulFlags |= MSG_OBJ_TX_INT_ENABLE;
+		}
+
+		xMsgObject.ulMsgLen = xFrame.ucLength;
+		xMsgObject.pucMsgData = xFrame.ucData;
+
+		/* Sets the transmit request - the first frame is on its way while
+		the rest are loaded. */
+		CANMessageSet( CAN0_BASE, canFIRST_TX_OBJECT + ulFrame, &xMsgObject, MSG_OBJ_TYPE_TX );
+	}
+
+	ulTxBatch = ulFrames;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceive( unsigned long ulObject, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+tCANMsgObject xMsgObject;
+xCANFrame xFrame;
+
+	xMsgObject.pucMsgData = xFrame.ucData;
+	CANMessageGet( CAN0_BASE, ulObject, &xMsgObject, true );
+
+	xFrame.ulID = xMsgObject.ulMsgID;
+	xFrame.ucLength = ( unsigned char ) xMsgObject.ulMsgLen;
+	xFrame.ucFlags = 0;
+	if( xMsgObject.ulFlags & MSG_OBJ_EXTENDED_ID )
+	{
+		xFrame.ucFlags |= canFRAME_EXTENDED;
+	}
+
+	if( xMsgObject.ulFlags & MSG_OBJ_DATA_LOST )
+	{
+		xFrame.ucFlags |= canFRAME_DATA_LOST;
+	}
+
+	if( xQueueSendFromISR( xRxQueues[ ulObject - 1UL ], &xFrame, pxHigherPriorityTaskWoken ) == pdPASS )
+	{
+		xStats.ulFramesReceived++;
+	}
+	else
+	{
+		xStats.ulFramesDropped++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vCANInterruptHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulCause;
+
+	/* INT holds the highest priority pending cause, so keep reading it until
+	everything has been serviced. */
+	while( ( ulCause = CANIntStatus( CAN0_BASE, CAN_INT_STS_CAUSE ) ) != CAN_INT_INTID_NONE )
+	{
+		if( ulCause == CAN_INT_INTID_STATUS )
+		{
+			/* Reading the status register clears the interrupt. */
+			if( CANStatusGet( CAN0_BASE, CAN_STS_CONTROL ) & CAN_STATUS_BUS_OFF )
+			{
+				/* The controller enters init mode on bus off.  Leaving it
+				starts the bus off recovery sequence, after which the loaded
+				mailboxes are sent. */
+				xStats.ulBusOffCount++;
+				CANEnable( CAN0_BASE );
+			}
+		}
+		else if( ulCause < canFIRST_TX_OBJECT )
+		{
+			prvReceive( ulCause, &xHigherPriorityTaskWoken );
+		}
+		else
+		{
+			/* The last mailbox of the batch has been sent, so all of them
+			have. */
+			CANIntClear( CAN0_BASE, ulCause );
+			xStats.ulFramesSent += ulTxBatch;
+			prvLoadTxBatch( &xHigherPriorityTaskWoken );
+		}
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,143 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Interrupt driven CAN driver for the Stellaris CAN0 controller.
+ *
+ * Receive filtering is done by the controller.  Each call to xCANFilterAdd()
+ * programs one message object with an identifier and mask, so only frames
+ * that match a filter interrupt the processor - all other traffic is dropped
+ * by the hardware without any processing time being used.  The interrupt
+ * copies a matching frame out of its message object and posts it to the
+ * queue given with the filter.  Several filters can share a queue, which lets
+ * a task receive a whole group of identifiers.
+ *
+ * Frames passed to xCANSend() are queued, then loaded into the transmit
+ * message objects (mailboxes) canTX_MAILBOXES at a time.  The controller
+ * sends the loaded objects back to back, lowest object number first, so the
+ * frames go out in the order they were queued and only the last mailbox of
+ * each batch interrupts the processor.
+ *
+ * vCANInterruptHandler() must be installed as the CAN0 interrupt handler
+ * (CAN0_ISR in LM3S_Startup.s).
+ */
+
+#ifndef CAN_DRIVER_H
+#define CAN_DRIVER_H
+
+#include "hw_types.h"
+#include "can.h"
+
+/* Number of the 32 message objects used for transmitting.  The rest are
+available to xCANFilterAdd(). */
+#ifndef canTX_MAILBOXES
+	#define canTX_MAILBOXES			4
+#endif
+
+/* Number of frames xCANSend() can queue ahead of the mailboxes. */
+#ifndef canTX_QUEUE_LENGTH
+	#define canTX_QUEUE_LENGTH		16
+#endif
+
+/* Bits in the ucFlags member of xCANFrame. */
+#define canFRAME_EXTENDED			( ( unsigned char ) 0x01 )	/* 29 bit identifier. */
+#define canFRAME_DATA_LOST			( ( unsigned char ) 0x02 )	/* Received only - the message object was overwritten before this frame was read. */
+
+/* Passed as the ulFlags parameter of xCANFilterAdd(). */
+#define canFILTER_STANDARD			( ( unsigned long ) 0x00 )
+#define canFILTER_EXTENDED			( ( unsigned long ) 0x01 )
+
+/* Item type of the receive queues and the frame passed to xCANSend(). */
+typedef struct xCAN_FRAME
+{
+	unsigned long ulID;
+	unsigned char ucLength;				/* 0 to 8. */
+	unsigned char ucFlags;				/* canFRAME_ bits. */
+	unsigned char ucData[ 8 ];
+} xCANFrame;
+
+typedef struct xCAN_STATS
+{
+	unsigned long ulFramesReceived;		/* Frames posted to a receive queue. */
+	unsigned long ulFramesDropped;		/* Frames that matched a filter but found the queue full. */
+	unsigned long ulFramesSent;
+	unsigned long ulBusOffCount;		/* Times the controller went bus off and was restarted. */
+} xCANStats;
+
+/*
+ * Configure CAN0 and its pins with the given bit timing and start the
+ * controller.  No frames are received until filters are added.  Returns
+ * pdFAIL if the transmit queue could not be created.
+ */
+portBASE_TYPE xCANInit( tCANBitClkParms *pxBitTiming );
+
+/*
+ * Receive frames whose identifier matches ulID in the bits set in ulIDMask,
+ * posting them to xQueue, which must have been created with an item size of
+ * sizeof( xCANFrame ).  ulFlags is canFILTER_STANDARD or canFILTER_EXTENDED.
+ * Returns pdFAIL when all the receive message objects are in use.
+ */
+portBASE_TYPE xCANFilterAdd( xQueueHandle xQueue, unsigned long ulID, unsigned long ulIDMask, unsigned long ulFlags );
+
+/*
+ * Queue a frame for transmission, waiting up to xTicksToWait for space in
+ * the transmit queue.  Set canFRAME_EXTENDED in pxFrame->ucFlags for a 29
+ * bit identifier.
+ */
+portBASE_TYPE xCANSend( const xCANFrame *pxFrame, portTickType xTicksToWait );
+
+void vCANGetStats( xCANStats *pxStats );
+
+void vCANInterruptHandler( void );
+
+#endif /* CAN_DRIVER_H */
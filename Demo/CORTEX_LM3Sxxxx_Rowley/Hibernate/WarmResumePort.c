@@ -0,0 +1,162 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The warm resume port layer for the hibernation module of the LM3Sxxxx
+ * parts.  In hibernation the processor and its RAM are powered down, and only
+ * the module itself, with its real time clock and 64 words of battery backed
+ * memory, keeps running.  The processor wakes either on a match of the real
+ * time clock or on the WAKE pin, and boots from reset.  See WarmResume.h.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+
+/* Library include files. */
+#include "hw_types.h"
+#include "sysctl.h"
+#include "hibernate.h"
+
+/* Demo program include files. */
+#include "WarmResume.h"
+
+/* The clock input of the hibernation module.  The default divides a
+4.194304MHz crystal down to the 32.768KHz the module needs, as on the LM3S8962
+evaluation kit.  Use HIBERNATE_CLOCK_SEL_RAW for a 32.768KHz crystal. */
+#ifndef wrHIBERNATE_CLOCK_SELECT
+	#define wrHIBERNATE_CLOCK_SELECT	HIBERNATE_CLOCK_SEL_DIV128
+#endif
+
+/* The words of battery backed memory in the hibernation module. */
+#define wrHIBERNATE_WORDS				( 64UL )
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xWarmResumePortInit( void )
+{
+unsigned long ulStatus;
+portBASE_TYPE xReturn = pdFALSE;
+
+	SysCtlPeripheralEnable( SYSCTL_PERIPH_HIBERNATE );
+
+	/* If the module is already active then it has been kept running by the
+	battery, and the wake interrupt status shows whether the processor has just
+	come out of hibernation, rather than been reset. */
+	if( HibernateIsActive() )
+	{
+		ulStatus = HibernateIntStatus( false );
+		HibernateIntClear( ulStatus );
+
+		if( ( ulStatus & ( HIBERNATE_INT_PIN_WAKE | HIBERNATE_INT_RTC_MATCH_0 ) ) != 0UL )
+		{
+			xReturn = pdTRUE;
+		}
+	}
+
+	/* The register writes are timed from the system clock, so this is needed
+	after every reset.  The real time clock is left counting if it already
+	is, as the time kept through hibernation is measured by it. */
+	HibernateEnableExpClk( SysCtlClockGet() );
+	HibernateClockSelect( wrHIBERNATE_CLOCK_SELECT );
+	HibernateRTCEnable();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulWarmResumePortWords( void )
+{
+	return wrHIBERNATE_WORDS;
+}
+/*-----------------------------------------------------------*/
+
+void vWarmResumePortRead( unsigned long *pulData, unsigned long ulWords )
+{
+	HibernateDataGet( pulData, ulWords );
+}
+/*-----------------------------------------------------------*/
+
+void vWarmResumePortWrite( const unsigned long *pulData, unsigned long ulWords )
+{
+	/* The driver does not change the data, but does not declare it const. */
+	HibernateDataSet( ( unsigned long * ) pulData, ulWords );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulWarmResumePortSeconds( void )
+{
+	return HibernateRTCGet();
+}
+/*-----------------------------------------------------------*/
+
+void vWarmResumePortHibernate( unsigned long ulSeconds )
+{
+unsigned long ulWake = HIBERNATE_WAKE_PIN;
+
+	if( ulSeconds != 0UL )
+	{
+		HibernateRTCMatch0Set( HibernateRTCGet() + ulSeconds );
+		ulWake |= HIBERNATE_WAKE_RTC;
+	}
+
+	HibernateWakeSet( ulWake );
+	HibernateRequest();
+
+	/* Power is removed a short time after the request, so execution stops
+	here. */
+	for( ;; )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -71,7 +71,11 @@
  * is permitted to access the display directly.  Other tasks wishing to write a
  * message to the OLED send the message on a queue to the OLED task instead of
  * accessing the OLED themselves.  The OLED task just blocks on the queue waiting
- * for messages - waking and displaying the messages as they arrive.
+ * for messages - waking and displaying the messages as they arrive.  On the
+ * kits fitted with the RIT display the messages are drawn into a frame buffer
+ * in RAM, and the OLED task sends only the area that has changed to the display,
+ * at most once every mainOLED_FRAME_PERIOD, so a burst of messages results in a
+ * single update.
  *
  * "Check" hook -  This only executes every five seconds from the tick hook.
  * Its main function is to check that all the standard demo tasks are still
@@ -157,6 +161,10 @@ tick hook. */
 time. */
 #define mainOLED_QUEUE_SIZE					( 3 )
 
+/* The shortest time between updates of a display that is drawn through a frame
+buffer. */
+#define mainOLED_FRAME_PERIOD				( ( portTickType ) 40 / portTICK_RATE_MS )
+
 /* Dimensions the buffer into which the jitter time is written. */
 #define mainMAX_MSG_LEN						25
 
@@ -368,6 +376,8 @@ static char cMessage[ mainMAX_MSG_LEN ];
 extern volatile unsigned long ulMaxJitter;
 unsigned portBASE_TYPE uxUnusedStackOnEntry, uxUnusedStackNow;
 const unsigned char *pucImage;
+portTickType xLastFlushTime = 0, xTicksToWait, xTimeSinceFlush;
+portBASE_TYPE xFramePending;
 
 /* Functions to access the OLED.  The one used depends on the dev kit
 being used. */
@@ -376,6 +386,10 @@ void ( *vOLEDStringDraw )( const char *, unsigned long, unsigned long, unsigned
 void ( *vOLEDImageDraw )( const unsigned char *, unsigned long, unsigned long, unsigned long, unsigned long ) = NULL;
 void ( *vOLEDClear )( void ) = NULL;
 
+/* Sends the changed part of the frame buffer to the display, or NULL if the
+driver draws directly to the display. */
+void ( *vOLEDFlush )( void ) = NULL;
+
 	/* Just for demo purposes. */
 	uxUnusedStackOnEntry = uxTaskGetStackHighWaterMark( NULL );
 
@@ -397,6 +411,7 @@ void ( *vOLEDClear )( void ) = NULL;
 										vOLEDStringDraw = RIT128x96x4StringDraw;
 										vOLEDImageDraw = RIT128x96x4ImageDraw;
 										vOLEDClear = RIT128x96x4Clear;
+										vOLEDFlush = RIT128x96x4Flush;
 										ulMaxY = mainMAX_ROWS_96;
 										pucImage = pucBasicBitmap;
 										break;
@@ -414,27 +429,57 @@ void ( *vOLEDClear )( void ) = NULL;
 
 	/* Initialise the OLED and display a startup message. */
 	vOLEDInit( ulSSI_FREQUENCY );
+
+	if( vOLEDFlush != NULL )
+	{
+		RIT128x96x4FrameBufferEnable();
+	}
+
 	vOLEDStringDraw( "POWERED BY FreeRTOS", 0, 0, mainFULL_SCALE );
 	vOLEDImageDraw( pucImage, 0, mainCHARACTER_HEIGHT + 1, bmpBITMAP_WIDTH, bmpBITMAP_HEIGHT );
+	xFramePending = pdTRUE;
 
 	for( ;; )
 	{
-		/* Wait for a message to arrive that requires displaying. */
-		xQueueReceive( xOLEDQueue, &xMessage, portMAX_DELAY );
+		/* Wait for a message to arrive that requires displaying.  If the frame
+		buffer holds changes that have not yet been sent to the display then
+		only wait until the next update is due. */
+		xTicksToWait = portMAX_DELAY;
+		if( ( vOLEDFlush != NULL ) && ( xFramePending != pdFALSE ) )
+		{
+			xTimeSinceFlush = xTaskGetTickCount() - xLastFlushTime;
+			xTicksToWait = ( xTimeSinceFlush >= mainOLED_FRAME_PERIOD ) ? 0 : ( mainOLED_FRAME_PERIOD - xTimeSinceFlush );
+		}
 
-		/* Write the message on the next available row. */
-		ulY += mainCHARACTER_HEIGHT;
-		if( ulY >= ulMaxY )
+		if( xQueueReceive( xOLEDQueue, &xMessage, xTicksToWait ) == pdPASS )
 		{
-			ulY = mainCHARACTER_HEIGHT;
-			vOLEDClear();
-			vOLEDStringDraw( pcWelcomeMessage, 0, 0, mainFULL_SCALE );
+			/* Write the message on the next available row. */
+			ulY += mainCHARACTER_HEIGHT;
+			if( ulY >= ulMaxY )
+			{
+				ulY = mainCHARACTER_HEIGHT;
+				vOLEDClear();
+				vOLEDStringDraw( pcWelcomeMessage, 0, 0, mainFULL_SCALE );
+			}
+
+			/* Display the message along with the maximum jitter time from the
+			high priority time test. */
+			sprintf( cMessage, "%s [%uns]", xMessage.pcMessage, ulMaxJitter * mainNS_PER_CLOCK );
+			vOLEDStringDraw( cMessage, 0, ulY, mainFULL_SCALE );
+			xFramePending = pdTRUE;
 		}
 
-		/* Display the message along with the maximum jitter time from the
-		high priority time test. */
-		sprintf( cMessage, "%s [%uns]", xMessage.pcMessage, ulMaxJitter * mainNS_PER_CLOCK );
-		vOLEDStringDraw( cMessage, 0, ulY, mainFULL_SCALE );
+		/* Send everything drawn since the last update to the display once the
+		frame period has passed. */
+		if( ( vOLEDFlush != NULL ) && ( xFramePending != pdFALSE ) )
+		{
+			if( ( xTaskGetTickCount() - xLastFlushTime ) >= mainOLED_FRAME_PERIOD )
+			{
+				vOLEDFlush();
+				xLastFlushTime = xTaskGetTickCount();
+				xFramePending = pdFALSE;
+			}
+		}
 	}
 }
 /*-----------------------------------------------------------*/
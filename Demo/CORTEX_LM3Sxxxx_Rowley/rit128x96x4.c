@@ -76,6 +76,24 @@ static volatile tBoolean g_bSSIEnabled = false;
 //*****************************************************************************
 static unsigned char g_pucBuffer[8];
 
+//*****************************************************************************
+//
+// RAM copy of the display, used once RIT128x96x4FrameBufferEnable() has been
+// called.  Each row holds 64 bytes of two pixels each, laid out as in the
+// display RAM.  The drawing functions then only update the frame buffer and
+// the dirty rectangle, the smallest rectangle (in byte columns and rows)
+// enclosing everything changed since the last RIT128x96x4Flush().  The
+// rectangle is empty when the left edge is greater than the right edge.
+//
+//*****************************************************************************
+#define RIT_ROWS            96
+#define RIT_ROW_BYTES       64
+
+static tBoolean g_bFrameBuffered = false;
+static unsigned char g_pucFrame[RIT_ROWS][RIT_ROW_BYTES];
+static unsigned long g_ulDirtyLeft = RIT_ROW_BYTES, g_ulDirtyRight = 0;
+static unsigned long g_ulDirtyTop = RIT_ROWS, g_ulDirtyBottom = 0;
+
 //*****************************************************************************
 //
 // Define the SSD1329 128x96x4 Remap Setting(s).  This will be used in
@@ -427,6 +445,109 @@ RITWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
     }
 }
 
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Write a sequence of data bytes to the SSD1329 controller, keeping the SSI
+//! transmit FIFO full.
+//!
+//! Bytes are queued without waiting for each one to be clocked out, and the
+//! receive FIFO is drained as the transfer progresses.  As each byte sent
+//! returns one byte into the receive FIFO, the function only returns once
+//! every byte has been received back, so the D/Cn signal is never changed
+//! while a transfer is still in progress.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITWriteDataStream(const unsigned char *pucBuffer, unsigned long ulCount)
+{
+    unsigned long ulTemp, ulPending = 0;
+
+    //
+    // Return if SSI port is not enabled for RIT display.
+    //
+    if(!g_bSSIEnabled)
+    {
+        return;
+    }
+
+    //
+    // Set the command/control bit to enable data mode.
+    //
+    GPIOPinWrite(ulGPIOBase, ulOLEDDC_PIN, ulOLEDDC_PIN);
+
+    while(ulCount != 0)
+    {
+        //
+        // Never have more bytes in flight than the receive FIFO can hold.
+        //
+        if(ulPending == 8)
+        {
+            SSIDataGet(SSI0_BASE, &ulTemp);
+            ulPending--;
+        }
+
+        //
+        // Queue the next byte, waiting only if the transmit FIFO is full.
+        //
+        SSIDataPut(SSI0_BASE, *pucBuffer++);
+        ulPending++;
+        ulCount--;
+
+        //
+        // Drain whatever has already been received.
+        //
+        while((ulPending != 0) &&
+              (SSIDataNonBlockingGet(SSI0_BASE, &ulTemp) != 0))
+        {
+            ulPending--;
+        }
+    }
+
+    //
+    // Wait for the last bytes to complete.
+    //
+    while(ulPending != 0)
+    {
+        SSIDataGet(SSI0_BASE, &ulTemp);
+        ulPending--;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Grow the dirty rectangle to include the given byte columns and rows.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+RITFrameDirty(unsigned long ulLeft, unsigned long ulRight,
+              unsigned long ulTop, unsigned long ulBottom)
+{
+    if(ulLeft < g_ulDirtyLeft)
+    {
+        g_ulDirtyLeft = ulLeft;
+    }
+    if(ulRight > g_ulDirtyRight)
+    {
+        g_ulDirtyRight = ulRight;
+    }
+    if(ulTop < g_ulDirtyTop)
+    {
+        g_ulDirtyTop = ulTop;
+    }
+    if(ulBottom > g_ulDirtyBottom)
+    {
+        g_ulDirtyBottom = ulBottom;
+    }
+}
+
 //*****************************************************************************
 //
 //! Clears the OLED display.
@@ -448,6 +569,22 @@ RIT128x96x4Clear(void)
     static const unsigned char pucCommand2[] = { 0x75, 0, 127 };
     unsigned long ulRow, ulColumn;
 
+    //
+    // With a frame buffer, clear it and mark the whole display as changed.
+    //
+    if(g_bFrameBuffered)
+    {
+        for(ulRow = 0; ulRow < RIT_ROWS; ulRow++)
+        {
+            for(ulColumn = 0; ulColumn < RIT_ROW_BYTES; ulColumn++)
+            {
+                g_pucFrame[ulRow][ulColumn] = 0;
+            }
+        }
+        RITFrameDirty(0, RIT_ROW_BYTES - 1, 0, RIT_ROWS - 1);
+        return;
+    }
+
     //
     // Clear out the buffer used for sending bytes to the display.
     *(unsigned long *)&g_pucBuffer[0] = 0;
@@ -518,7 +655,7 @@ void
 RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
                       unsigned long ulY, unsigned char ucLevel)
 {
-    unsigned long ulIdx1, ulIdx2;
+    unsigned long ulIdx1, ulIdx2, ulRows = 0, ulLeft = 0;
     unsigned char ucTemp;
 
     //
@@ -532,17 +669,27 @@ RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
     //
     // Setup a window starting at the specified column and row, ending
     // at the right edge of the display and 8 rows down (single character row).
+    // With a frame buffer the columns are instead written to RAM, where only
+    // the rows that are on the display are kept.
     //
-    g_pucBuffer[0] = 0x15;
-    g_pucBuffer[1] = ulX / 2;
-    g_pucBuffer[2] = 63;
-    RITWriteCommand(g_pucBuffer, 3);
-    g_pucBuffer[0] = 0x75;
-    g_pucBuffer[1] = ulY;
-    g_pucBuffer[2] = ulY + 7;
-    RITWriteCommand(g_pucBuffer, 3);
-    RITWriteCommand(g_pucRIT128x96x4VerticalInc,
-                    sizeof(g_pucRIT128x96x4VerticalInc));
+    if(g_bFrameBuffered)
+    {
+        ulRows = ((ulY + 8) <= RIT_ROWS) ? 8 : (RIT_ROWS - ulY);
+        ulLeft = ulX / 2;
+    }
+    else
+    {
+        g_pucBuffer[0] = 0x15;
+        g_pucBuffer[1] = ulX / 2;
+        g_pucBuffer[2] = 63;
+        RITWriteCommand(g_pucBuffer, 3);
+        g_pucBuffer[0] = 0x75;
+        g_pucBuffer[1] = ulY;
+        g_pucBuffer[2] = ulY + 7;
+        RITWriteCommand(g_pucBuffer, 3);
+        RITWriteCommand(g_pucRIT128x96x4VerticalInc,
+                        sizeof(g_pucRIT128x96x4VerticalInc));
+    }
 
     //
     // Loop while there are more characters in the string.
@@ -593,7 +740,18 @@ RIT128x96x4StringDraw(const char *pcStr, unsigned long ulX,
             //
             if(ulX < 126)
             {
-                RITWriteData(g_pucBuffer, 8);
+                if(g_bFrameBuffered)
+                {
+                    for(ulIdx2 = 0; ulIdx2 < ulRows; ulIdx2++)
+                    {
+                        g_pucFrame[ulY + ulIdx2][ulX / 2] = g_pucBuffer[ulIdx2];
+                    }
+                    RITFrameDirty(ulLeft, ulX / 2, ulY, ulY + ulRows - 1);
+                }
+                else
+                {
+                    RITWriteData(g_pucBuffer, 8);
+                }
                 ulX += 2;
             }
             else
@@ -679,6 +837,8 @@ RIT128x96x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
                      unsigned long ulY, unsigned long ulWidth,
                      unsigned long ulHeight)
 {
+    unsigned long ulIdx;
+
     //
     // Check the arguments.
     //
@@ -689,6 +849,30 @@ RIT128x96x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
     ASSERT((ulY + ulHeight) <= 96);
     ASSERT((ulWidth & 1) == 0);
 
+    //
+    // With a frame buffer, copy the image into it and mark its area as
+    // changed.
+    //
+    if(g_bFrameBuffered)
+    {
+        if(ulHeight != 0)
+        {
+            RITFrameDirty(ulX / 2, (ulX + ulWidth - 2) / 2, ulY,
+                          ulY + ulHeight - 1);
+        }
+
+        while(ulHeight--)
+        {
+            for(ulIdx = 0; ulIdx < (ulWidth / 2); ulIdx++)
+            {
+                g_pucFrame[ulY][(ulX / 2) + ulIdx] = pucImage[ulIdx];
+            }
+            pucImage += (ulWidth / 2);
+            ulY++;
+        }
+        return;
+    }
+
     //
     // Setup a window starting at the specified column and row, and ending
     // at the column + width and row+height.
@@ -721,6 +905,95 @@ RIT128x96x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
     }
 }
 
+//*****************************************************************************
+//
+//! Draw into a RAM frame buffer instead of directly to the OLED display.
+//!
+//! After this function is called RIT128x96x4Clear(), RIT128x96x4StringDraw()
+//! and RIT128x96x4ImageDraw() no longer write to the display.  They update a
+//! copy of the display held in RAM and record the area that has changed, and
+//! return without waiting for the SSI port.  The changes are sent to the
+//! display by RIT128x96x4Flush(), so any number of drawing calls can be
+//! combined into a single update.  The frame buffer starts off clear, so the
+//! first flush clears the whole display.
+//!
+//! This function is contained in <tt>rit128x96x4.c</tt>, with
+//! <tt>rit128x96x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4FrameBufferEnable(void)
+{
+    g_bFrameBuffered = true;
+    RIT128x96x4Clear();
+}
+
+//*****************************************************************************
+//
+//! Send the changed area of the frame buffer to the OLED display.
+//!
+//! This function writes the rectangle enclosing everything drawn since the
+//! last flush, one row at a time with the SSI transmit FIFO kept full, and
+//! then marks the frame buffer as unchanged.  Nothing is written if nothing
+//! has changed, or if the SSI port is not enabled for the display, in which
+//! case the changes are kept for a later flush.
+//!
+//! This function is contained in <tt>rit128x96x4.c</tt>, with
+//! <tt>rit128x96x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+RIT128x96x4Flush(void)
+{
+    unsigned long ulRow;
+
+    //
+    // Return if nothing has changed, or the display cannot be written.
+    //
+    if((g_ulDirtyLeft > g_ulDirtyRight) || !g_bFrameBuffered ||
+       !g_bSSIEnabled)
+    {
+        return;
+    }
+
+    //
+    // Setup a window covering the dirty rectangle.
+    //
+    g_pucBuffer[0] = 0x15;
+    g_pucBuffer[1] = g_ulDirtyLeft;
+    g_pucBuffer[2] = g_ulDirtyRight;
+    RITWriteCommand(g_pucBuffer, 3);
+    g_pucBuffer[0] = 0x75;
+    g_pucBuffer[1] = g_ulDirtyTop;
+    g_pucBuffer[2] = g_ulDirtyBottom;
+    RITWriteCommand(g_pucBuffer, 3);
+    RITWriteCommand(g_pucRIT128x96x4HorizontalInc,
+                    sizeof(g_pucRIT128x96x4HorizontalInc));
+
+    //
+    // Write the changed part of each row.
+    //
+    for(ulRow = g_ulDirtyTop; ulRow <= g_ulDirtyBottom; ulRow++)
+    {
+        RITWriteDataStream(&g_pucFrame[ulRow][g_ulDirtyLeft],
+                           g_ulDirtyRight - g_ulDirtyLeft + 1);
+    }
+
+    //
+    // Mark the frame buffer as unchanged.
+    //
+    g_ulDirtyLeft = RIT_ROW_BYTES;
+    g_ulDirtyRight = 0;
+    g_ulDirtyTop = RIT_ROWS;
+    g_ulDirtyBottom = 0;
+}
+
 //*****************************************************************************
 //
 //! Enable the SSI component of the OLED display driver.
@@ -34,6 +34,8 @@ IF EXIST src\FreeRTOS Goto END
 	copy ..\..\Source\portable\MemMang\*.* src\FreeRTOS\portable\MemMang
 
 	REM Copy the files that define the common demo tasks.
+	copy ..\Common\minimal\AllocBench.c "src\Common Demo Tasks"
+	copy ..\Common\minimal\Benchmark.c "src\Common Demo Tasks"
 	copy ..\Common\minimal\BlockQ.c "src\Common Demo Tasks"
 	copy ..\Common\minimal\blocktim.c "src\Common Demo Tasks"
 	copy ..\Common\minimal\flash.c "src\Common Demo Tasks"
@@ -155,5 +155,15 @@ extern void vConfigureTimerForRunTimeStats( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureTimerForRunTimeStats()
 #define portGET_RUN_TIME_COUNTER_VALUE() LPC_TIM0->TC
 
+/* Time base used by the benchmark tasks when they are included in the demo.
+The cycle counter gives figures in CPU cycles that can be compared directly
+between the CORTEX_LPC1768_GCC_RedSuite (ARM_CM3 port) and
+CORTEX_MPU_LPC1768_GCC_RedSuite (ARM_CM3_MPU port) demos. */
+#define benchGET_TIME( x )	( x ) = *( ( volatile unsigned long * ) 0xe0001004 )
+
+/* The allocator benchmark uses the same time base, so its figures are also in
+CPU cycles. */
+#define allocbenchGET_TIME( x )	( x ) = *( ( volatile unsigned long * ) 0xe0001004 )
+
 
 #endif /* FREERTOS_CONFIG_H */
@@ -97,6 +97,8 @@
 #include "GenQTest.h"
 #include "QPeek.h"
 #include "recmutex.h"
+#include "Benchmark.h"
+#include "AllocBench.h"
 
 /* Red Suite includes. */
 #include "lcd_driver.h"
@@ -116,6 +118,26 @@ tick hook. */
 #define mainINTEGER_TASK_PRIORITY           ( tskIDLE_PRIORITY )
 #define mainGEN_QUEUE_TASK_PRIORITY			( tskIDLE_PRIORITY )
 #define mainFLASH_TASK_PRIORITY				( tskIDLE_PRIORITY + 2 )
+#define mainBENCHMARK_PRIORITY				( tskIDLE_PRIORITY + 1 )
+#define mainALLOC_BENCHMARK_PRIORITY		( tskIDLE_PRIORITY )
+
+/* Set to 1 to include the benchmark tasks, which time the kernel in CPU
+cycles.  The table of results is written by vBenchmarkGetResults().  The
+figures can be compared with those from the CORTEX_MPU_LPC1768_GCC_RedSuite
+demo to see the cost of the MPU port. */
+#define mainINCLUDE_BENCHMARK				0
+
+/* Set to 1 to include the allocator benchmark, which times pvPortMalloc() and
+vPortFree() in CPU cycles and measures fragmentation.  The table of results is
+written by vAllocBenchGetResults().  The figures for each heap implementation
+are obtained by building the demo with each heap_n.c file in turn. */
+#define mainINCLUDE_ALLOC_BENCHMARK			0
+
+/* Cortex-M3 debug registers used to start the cycle counter. */
+#define mainDEMCR							( *( ( volatile unsigned long * ) 0xe000edfc ) )
+#define mainDEMCR_TRCENA					( 1UL << 24UL )
+#define mainDWT_CTRL						( *( ( volatile unsigned long * ) 0xe0001000 ) )
+#define mainDWT_CTRL_CYCCNTENA				( 1UL )
 
 /* The WEB server has a larger stack as it utilises stack hungry string
 handling library calls. */
@@ -178,6 +200,26 @@ char cIPAddress[ 16 ]; /* Enough space for "xxx.xxx.xxx.xxx\0". */
     vStartRecursiveMutexTasks();
 	vStartLEDFlashTasks( mainFLASH_TASK_PRIORITY );
 
+	#if ( mainINCLUDE_BENCHMARK == 1 ) || ( mainINCLUDE_ALLOC_BENCHMARK == 1 )
+	{
+		/* The benchmark tasks use the cycle counter as their time base. */
+		mainDEMCR |= mainDEMCR_TRCENA;
+		mainDWT_CTRL |= mainDWT_CTRL_CYCCNTENA;
+	}
+	#endif
+
+	#if mainINCLUDE_BENCHMARK == 1
+	{
+		vStartBenchmarkTasks( mainBENCHMARK_PRIORITY );
+	}
+	#endif
+
+	#if mainINCLUDE_ALLOC_BENCHMARK == 1
+	{
+		vStartAllocBenchTasks( mainALLOC_BENCHMARK_PRIORITY );
+	}
+	#endif
+
     /* Create the USB task. */
     xTaskCreate( vUSBTask, ( signed char * ) "USB", configMINIMAL_STACK_SIZE, ( void * ) NULL, tskIDLE_PRIORITY, NULL );
 	
@@ -247,6 +289,18 @@ static unsigned long ulTicksSinceLastDisplay = 0;
 	    {
 	    	pcStatusMessage = "An error has been detected in the Mutex test/demo.";
 	    }
+		#if mainINCLUDE_BENCHMARK == 1
+			else if( xAreBenchmarkTasksStillRunning() != pdTRUE )
+			{
+				pcStatusMessage = "An error has been detected in the Benchmark tasks.";
+			}
+		#endif
+		#if mainINCLUDE_ALLOC_BENCHMARK == 1
+			else if( xAreAllocBenchTasksStillRunning() != pdTRUE )
+			{
+				pcStatusMessage = "An error has been detected in the allocator benchmark.";
+			}
+		#endif
 	}
 }
 /*-----------------------------------------------------------*/
@@ -0,0 +1,309 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The LPC17xx port layer of the DMA service in Demo/Common/Minimal/DMAService.c.
+ * A chain of descriptors is turned into GPDMA linked list items, held in the
+ * ulPort member of each descriptor, so the controller moves every block of
+ * the chain without an interrupt between them.  The terminal count interrupt
+ * is only enabled on the last block.
+ *
+ * The ulRequest member of xDMAChannelConfig is the GPDMA request line:
+ *
+ *   0 SSP0 Tx, 1 SSP0 Rx, 2 SSP1 Tx, 3 SSP1 Rx, 4 ADC, 5 I2S channel 0,
+ *   6 I2S channel 1, 7 DAC, 8 UART0 Tx, 9 UART0 Rx, 10 UART1 Tx, 11 UART1 Rx,
+ *   12 UART2 Tx, 13 UART2 Rx, 14 UART3 Tx, 15 UART3 Rx.
+ *
+ * Lines 8 to 15 are connected to the timer match outputs instead if the
+ * application sets the matching bit of DMAREQSEL.  Any channel can serve any
+ * request.  Channel 0 has the highest priority and is allocated first, so
+ * drivers that need the lowest latency should allocate their channels first.
+ * ucPriority is not used.
+ *
+ * The GPDMA cannot reach the local SRAM at 0x10000000, so the descriptors and
+ * the buffers must be in the AHB SRAM at 0x2007c000, as the EMAC buffers are.
+ *
+ * SPIBus/SPIBusPort.c drives GPDMA channels 4 to 7 and the GPDMA interrupt
+ * itself, so it cannot be linked into the same program as this file.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "DMAService.h"
+
+#if dmaDESCRIPTOR_PORT_WORDS < 4
+	#error The LPC17xx DMA port needs dmaDESCRIPTOR_PORT_WORDS to be at least 4 to hold a linked list item.
+#endif
+
+/* The interrupt calls the kernel, so must be numerically equal to or greater
+than configMAX_SYSCALL_INTERRUPT_PRIORITY ( 5 ). */
+#ifndef configDMA_INTERRUPT_PRIORITY
+	#define configDMA_INTERRUPT_PRIORITY	( 7 )
+#endif
+
+#define dmaNUM_CHANNELS					( 8 )
+#define dmaNUM_REQUESTS					( 16UL )
+#define dmaALL_CHANNELS					( 0xffUL )
+
+/* The words of a linked list item, in the order the GPDMA reads them. */
+#define dmaLLI_SOURCE					( 0 )
+#define dmaLLI_DESTINATION				( 1 )
+#define dmaLLI_NEXT						( 2 )
+#define dmaLLI_CONTROL					( 3 )
+
+/* GPDMA bits. */
+#define dmaDMAC_ENABLE					( 0x01UL )
+#define dmaMAX_TRANSFER					( 0xfffU )
+#define dmaCONTROL_SB_SHIFT				( 12UL )
+#define dmaCONTROL_DB_SHIFT				( 15UL )
+#define dmaCONTROL_SWIDTH_SHIFT			( 18UL )
+#define dmaCONTROL_DWIDTH_SHIFT			( 21UL )
+#define dmaCONTROL_SI					( 1UL << 26UL )
+#define dmaCONTROL_DI					( 1UL << 27UL )
+#define dmaCONTROL_I					( 1UL << 31UL )
+#define dmaBURST_4						( 1UL )
+#define dmaCONFIG_E						( 0x01UL )
+#define dmaCONFIG_SRC_SHIFT				( 1UL )
+#define dmaCONFIG_DEST_SHIFT			( 6UL )
+#define dmaCONFIG_TYPE_SHIFT			( 11UL )
+#define dmaCONFIG_IE					( 1UL << 14UL )
+#define dmaCONFIG_ITC					( 1UL << 15UL )
+
+#define dmaCHANNEL( x )					( ( GPDMACH_TypeDef * ) ( GPDMACH0_BASE + ( ( x ) * 0x20UL ) ) )
+
+/* Returns the GPDMA width code of a transfer of ucWidth bytes, or a value
+above 2 if the width is not supported. */
+static unsigned long prvWidthCode( unsigned char ucWidth );
+
+/* The GPDMA interrupt handler, installed in the vector table by
+LPC1700_Startup.s. */
+void GPDMA_IRQHandler( void );
+
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxDMAPortInit( void )
+{
+unsigned portBASE_TYPE uxChannel;
+
+	SC->PCONP |= PCONP_PCGPDMA;
+	GPDMA->DMACConfig = dmaDMAC_ENABLE;
+
+	for( uxChannel = 0; uxChannel < ( unsigned portBASE_TYPE ) dmaNUM_CHANNELS; uxChannel++ )
+	{
+		vDMAPortAbort( uxChannel );
+	}
+
+	NVIC_SetPriority( DMA_IRQn, configDMA_INTERRUPT_PRIORITY );
+	NVIC_EnableIRQ( DMA_IRQn );
+
+	return ( unsigned portBASE_TYPE ) dmaNUM_CHANNELS;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulDMAPortChannelsFor( const xDMAChannelConfig *pxConfig )
+{
+unsigned long ulReturn = dmaALL_CHANNELS;
+
+	if( ( pxConfig->ucDirection != dmaMEMORY_TO_MEMORY ) && ( pxConfig->ulRequest >= dmaNUM_REQUESTS ) )
+	{
+		ulReturn = 0UL;
+	}
+
+	if( prvWidthCode( pxConfig->ucWidth ) > 2UL )
+	{
+		ulReturn = 0UL;
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDMAPortStart( unsigned portBASE_TYPE uxChannel, const xDMAChannelConfig *pxConfig, xDMADescriptor *pxChain )
+{
+GPDMACH_TypeDef *pxRegisters = dmaCHANNEL( uxChannel );
+xDMADescriptor *pxDescriptor;
+unsigned long ulControl, ulConfig, ulBurst, ulWidth;
+
+	/* Check the whole chain before touching the hardware. */
+	for( pxDescriptor = pxChain; pxDescriptor != NULL; pxDescriptor = pxDescriptor->pxNext )
+	{
+		if( ( pxDescriptor->usCount == 0U ) || ( pxDescriptor->usCount > dmaMAX_TRANSFER ) )
+		{
+			return pdFAIL;
+		}
+	}
+
+	/* A peripheral is moved one transfer per request, memory in bursts. */
+	ulBurst = ( pxConfig->ucDirection == dmaMEMORY_TO_MEMORY ) ? dmaBURST_4 : 0UL;
+	ulWidth = prvWidthCode( pxConfig->ucWidth );
+
+	ulControl = ( ulBurst << dmaCONTROL_SB_SHIFT ) | ( ulBurst << dmaCONTROL_DB_SHIFT ) | ( ulWidth << dmaCONTROL_SWIDTH_SHIFT ) | ( ulWidth << dmaCONTROL_DWIDTH_SHIFT );
+	if( ( pxConfig->ucIncrement & dmaINCREMENT_SOURCE ) != 0U )
+	{
+		ulControl |= dmaCONTROL_SI;
+	}
+	if( ( pxConfig->ucIncrement & dmaINCREMENT_DESTINATION ) != 0U )
+	{
+		ulControl |= dmaCONTROL_DI;
+	}
+
+	for( pxDescriptor = pxChain; pxDescriptor != NULL; pxDescriptor = pxDescriptor->pxNext )
+	{
+		pxDescriptor->ulPort[ dmaLLI_SOURCE ] = ( unsigned long ) pxDescriptor->pvSource;
+		pxDescriptor->ulPort[ dmaLLI_DESTINATION ] = ( unsigned long ) pxDescriptor->pvDestination;
+
+		if( pxDescriptor->pxNext != NULL )
+		{
+			pxDescriptor->ulPort[ dmaLLI_NEXT ] = ( unsigned long ) &( pxDescriptor->pxNext->ulPort[ 0 ] );
+			pxDescriptor->ulPort[ dmaLLI_CONTROL ] = ulControl | ( unsigned long ) pxDescriptor->usCount;
+		}
+		else
+		{
+			pxDescriptor->ulPort[ dmaLLI_NEXT ] = 0UL;
+			pxDescriptor->ulPort[ dmaLLI_CONTROL ] = ulControl | ( unsigned long ) pxDescriptor->usCount | dmaCONTROL_I;
+		}
+	}
+
+	ulConfig = dmaCONFIG_E | ( ( unsigned long ) pxConfig->ucDirection << dmaCONFIG_TYPE_SHIFT ) | dmaCONFIG_IE | dmaCONFIG_ITC;
+	if( pxConfig->ucDirection == dmaMEMORY_TO_PERIPHERAL )
+	{
+		ulConfig |= pxConfig->ulRequest << dmaCONFIG_DEST_SHIFT;
+	}
+	else if( pxConfig->ucDirection == dmaPERIPHERAL_TO_MEMORY )
+	{
+		ulConfig |= pxConfig->ulRequest << dmaCONFIG_SRC_SHIFT;
+	}
+
+	/* The channel registers take the first item, then the GPDMA follows the
+	list from its next pointer. */
+	GPDMA->DMACIntTCClear = 1UL << uxChannel;
+	GPDMA->DMACIntErrClr = 1UL << uxChannel;
+	pxRegisters->DMACCSrcAddr = pxChain->ulPort[ dmaLLI_SOURCE ];
+	pxRegisters->DMACCDestAddr = pxChain->ulPort[ dmaLLI_DESTINATION ];
+	pxRegisters->DMACCLLI = pxChain->ulPort[ dmaLLI_NEXT ];
+	pxRegisters->DMACCControl = pxChain->ulPort[ dmaLLI_CONTROL ];
+	pxRegisters->DMACCConfig = ulConfig;
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vDMAPortAbort( unsigned portBASE_TYPE uxChannel )
+{
+	dmaCHANNEL( uxChannel )->DMACCConfig = 0UL;
+	GPDMA->DMACIntTCClear = 1UL << uxChannel;
+	GPDMA->DMACIntErrClr = 1UL << uxChannel;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvWidthCode( unsigned char ucWidth )
+{
+unsigned long ulReturn;
+
+	switch( ucWidth )
+	{
+		case 1U	:	ulReturn = 0UL;
+					break;
+
+		case 2U	:	ulReturn = 1UL;
+					break;
+
+		case 4U	:	ulReturn = 2UL;
+					break;
+
+		default	:	ulReturn = 3UL;
+					break;
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void GPDMA_IRQHandler( void )
+{
+unsigned portBASE_TYPE uxChannel;
+unsigned long ulErrors, ulCompleted, ulBit;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	ulErrors = GPDMA->DMACIntErrStat;
+	ulCompleted = GPDMA->DMACIntTCStat;
+	GPDMA->DMACIntErrClr = ulErrors;
+	GPDMA->DMACIntTCClear = ulCompleted;
+
+	for( uxChannel = 0; uxChannel < ( unsigned portBASE_TYPE ) dmaNUM_CHANNELS; uxChannel++ )
+	{
+		ulBit = 1UL << uxChannel;
+
+		if( ( ulErrors & ulBit ) != 0UL )
+		{
+			/* The channel is disabled by the error, but clear the enable in
+			case it is mid way through the list. */
+			dmaCHANNEL( uxChannel )->DMACCConfig = 0UL;
+			vDMAChannelDoneFromISR( uxChannel, pdFAIL, &xHigherPriorityTaskWoken );
+		}
+		else if( ( ulCompleted & ulBit ) != 0UL )
+		{
+			/* Only the last item of a chain raises the terminal count
+			interrupt, and the channel disables itself at the end of the
+			list. */
+			vDMAChannelDoneFromISR( uxChannel, pdPASS, &xHigherPriorityTaskWoken );
+		}
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,387 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The LPC17xx port layer of the SPI bus manager in Demo/Common/Minimal/SPIBus.c.
+ * Each transfer runs on two GPDMA channels, one feeding the SSP transmit FIFO
+ * and the other emptying the receive FIFO.  The receive channel finishes
+ * last, so only its terminal count interrupt is used.  A GPDMA channel moves
+ * at most spiMAX_DMA_TRANSFER bytes, so longer transfers are restarted from
+ * the interrupt until they are complete.
+ *
+ *   Bus 0 - SSP0: SCK P0.15, MISO P0.17, MOSI P0.18.
+ *   Bus 1 - SSP1: SCK P0.7, MISO P0.8, MOSI P0.9.
+ *
+ * Chip selects are driven by the vChipSelect() function of each device.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "SPIBus.h"
+
+/* The DMA channels used by each bus.  Channel 0 has the highest priority, so
+the lower channel is used for receive. */
+#ifndef spiSSP0_RX_CHANNEL
+	#define spiSSP0_RX_CHANNEL		( 4 )
+	#define spiSSP0_TX_CHANNEL		( 5 )
+#endif
+
+#ifndef spiSSP1_RX_CHANNEL
+	#define spiSSP1_RX_CHANNEL		( 6 )
+	#define spiSSP1_TX_CHANNEL		( 7 )
+#endif
+
+/* The peripheral clock of both SSPs, CCLK / 4 after reset. */
+#ifndef spiPCLK_HZ
+	#define spiPCLK_HZ				( configCPU_CLOCK_HZ / 4UL )
+#endif
+
+/* The interrupt calls the kernel, so must be numerically equal to or greater
+than configMAX_SYSCALL_INTERRUPT_PRIORITY ( 5 ). */
+#ifndef configSPI_INTERRUPT_PRIORITY
+	#define configSPI_INTERRUPT_PRIORITY	( 7 )
+#endif
+
+#define spiNUM_BUSES				( 2 )
+
+/* GPDMA bits. */
+#define spiDMAC_ENABLE				( 0x01UL )
+#define spiMAX_DMA_TRANSFER			( 0xfffU )
+#define spiCONTROL_SI				( 1UL << 26UL )
+#define spiCONTROL_DI				( 1UL << 27UL )
+#define spiCONTROL_I				( 1UL << 31UL )
+#define spiCONFIG_E					( 0x01UL )
+#define spiCONFIG_SRC_SHIFT			( 1UL )
+#define spiCONFIG_DEST_SHIFT		( 6UL )
+#define spiCONFIG_M2P				( 1UL << 11UL )
+#define spiCONFIG_P2M				( 2UL << 11UL )
+#define spiCONFIG_IE				( 1UL << 14UL )
+#define spiCONFIG_ITC				( 1UL << 15UL )
+
+/* SSP bits. */
+#define spiCR0_8_BIT				( 0x07UL )
+#define spiCR0_CPOL					( 1UL << 6UL )
+#define spiCR0_CPHA					( 1UL << 7UL )
+#define spiCR0_SCR_SHIFT			( 8UL )
+#define spiCR1_SSE					( 0x02UL )
+#define spiSR_RNE					( 0x04UL )
+#define spiDMACR_RXDMAE				( 0x01UL )
+#define spiDMACR_TXDMAE				( 0x02UL )
+#define spiMIN_CPSR					( 2UL )
+#define spiMAX_CPSR					( 254UL )
+#define spiMAX_SCR					( 255UL )
+
+/* The hardware used by each bus. */
+typedef struct SPI_PORT
+{
+	SSP_TypeDef *pxSSP;
+	GPDMACH_TypeDef *pxRxChannel;
+	GPDMACH_TypeDef *pxTxChannel;
+	unsigned long ulRxChannelBit;
+	unsigned long ulTxChannelBit;
+	unsigned long ulRxRequest;
+	unsigned long ulTxRequest;
+} xSPIPort;
+
+#define spiCHANNEL( x )				( ( GPDMACH_TypeDef * ) ( GPDMACH0_BASE + ( ( x ) * 0x20UL ) ) )
+
+static const xSPIPort xPorts[ spiNUM_BUSES ] =
+{
+	{ SSP0, spiCHANNEL( spiSSP0_RX_CHANNEL ), spiCHANNEL( spiSSP0_TX_CHANNEL ), 1UL << spiSSP0_RX_CHANNEL, 1UL << spiSSP0_TX_CHANNEL, 1UL, 0UL },
+	{ SSP1, spiCHANNEL( spiSSP1_RX_CHANNEL ), spiCHANNEL( spiSSP1_TX_CHANNEL ), 1UL << spiSSP1_RX_CHANNEL, 1UL << spiSSP1_TX_CHANNEL, 3UL, 2UL }
+};
+
+/* The part of the current transfer of each bus that has not yet been handed
+to the DMA. */
+typedef struct SPI_PORT_STATE
+{
+	const unsigned char *pucTxData;
+	unsigned char *pucRxData;
+	unsigned short usRemaining;
+} xSPIPortState;
+
+static xSPIPortState xStates[ spiNUM_BUSES ];
+
+/* The source of transfers that have no transmit data, and the destination of
+those that have no receive buffer.  The DMA address is not incremented for
+either. */
+static const unsigned char ucFillByte = spiFILL_BYTE;
+static unsigned char ucDiscard;
+
+/* Hand the next part of the current transfer of uxBus to the DMA. */
+static void prvStartChunk( unsigned portBASE_TYPE uxBus );
+
+/* Stop the DMA of a bus and clear its interrupts. */
+static void prvStopTransfer( const xSPIPort *pxPort );
+
+/* The GPDMA interrupt handler, installed in the vector table by
+LPC1700_Startup.s. */
+void GPDMA_IRQHandler( void );
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSPIPortInit( unsigned portBASE_TYPE uxBus )
+{
+	if( uxBus >= ( unsigned portBASE_TYPE ) spiNUM_BUSES )
+	{
+		return pdFAIL;
+	}
+
+	SC->PCONP |= PCONP_PCGPDMA;
+	GPDMA->DMACConfig = spiDMAC_ENABLE;
+
+	if( uxBus == 0 )
+	{
+		SC->PCONP |= PCONP_PCSSP0;
+		PINCON->PINSEL0 = ( PINCON->PINSEL0 & ~0xC0000000UL ) | 0x80000000UL;
+		PINCON->PINSEL1 = ( PINCON->PINSEL1 & ~0x0000003CUL ) | 0x00000028UL;
+	}
+	else
+	{
+		SC->PCONP |= PCONP_PCSSP1;
+		PINCON->PINSEL0 = ( PINCON->PINSEL0 & ~0x000FC000UL ) | 0x000A8000UL;
+	}
+
+	prvStopTransfer( &( xPorts[ uxBus ] ) );
+	xPorts[ uxBus ].pxSSP->DMACR = spiDMACR_RXDMAE | spiDMACR_TXDMAE;
+
+	NVIC_SetPriority( DMA_IRQn, configSPI_INTERRUPT_PRIORITY );
+	NVIC_EnableIRQ( DMA_IRQn );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vSPIPortConfigure( unsigned portBASE_TYPE uxBus, const xSPIDevice *pxDevice )
+{
+SSP_TypeDef *pxSSP = xPorts[ uxBus ].pxSSP;
+unsigned long ulCPSR, ulSCR, ulCR0;
+
+	/* SCK is PCLK / ( CPSR * ( SCR + 1 ) ).  Use the smallest prescaler that
+	lets the serial clock rate get to or below the rate of the device. */
+	for( ulCPSR = spiMIN_CPSR; ulCPSR < spiMAX_CPSR; ulCPSR += 2UL )
+	{
+		if( ( ( unsigned long ) spiPCLK_HZ / ulCPSR ) <= ( pxDevice->ulClockHz * ( spiMAX_SCR + 1UL ) ) )
+		{
+			break;
+		}
+	}
+
+	for( ulSCR = 0UL; ulSCR < spiMAX_SCR; ulSCR++ )
+	{
+		if( ( ( unsigned long ) spiPCLK_HZ / ( ulCPSR * ( ulSCR + 1UL ) ) ) <= pxDevice->ulClockHz )
+		{
+			break;
+		}
+	}
+
+	ulCR0 = spiCR0_8_BIT | ( ulSCR << spiCR0_SCR_SHIFT );
+	if( ( pxDevice->ucMode & 0x02U ) != 0U )
+	{
+		ulCR0 |= spiCR0_CPOL;
+	}
+	if( ( pxDevice->ucMode & 0x01U ) != 0U )
+	{
+		ulCR0 |= spiCR0_CPHA;
+	}
+
+	pxSSP->CR1 = 0UL;
+	pxSSP->CR0 = ulCR0;
+	pxSSP->CPSR = ulCPSR;
+	pxSSP->CR1 = spiCR1_SSE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSPIPortStart( unsigned portBASE_TYPE uxBus, const unsigned char *pucTxData, unsigned char *pucRxData, unsigned short usLength )
+{
+SSP_TypeDef *pxSSP = xPorts[ uxBus ].pxSSP;
+volatile unsigned long ulDummy;
+
+	/* Discard anything left in the receive FIFO by an aborted transfer, so the
+	first byte received is the reply to the first byte sent. */
+	while( ( pxSSP->SR & spiSR_RNE ) != 0UL )
+	{
+		ulDummy = pxSSP->DR;
+	}
+	( void ) ulDummy;
+
+	xStates[ uxBus ].pucTxData = pucTxData;
+	xStates[ uxBus ].pucRxData = pucRxData;
+	xStates[ uxBus ].usRemaining = usLength;
+
+	portENTER_CRITICAL();
+	{
+		prvStartChunk( uxBus );
+	}
+	portEXIT_CRITICAL();
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vSPIPortAbort( unsigned portBASE_TYPE uxBus )
+{
+	portENTER_CRITICAL();
+	{
+		prvStopTransfer( &( xPorts[ uxBus ] ) );
+		xStates[ uxBus ].usRemaining = 0U;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartChunk( unsigned portBASE_TYPE uxBus )
+{
+const xSPIPort *pxPort = &( xPorts[ uxBus ] );
+xSPIPortState *pxState = &( xStates[ uxBus ] );
+unsigned long ulLength, ulControl;
+
+	ulLength = pxState->usRemaining;
+	if( ulLength > spiMAX_DMA_TRANSFER )
+	{
+		ulLength = spiMAX_DMA_TRANSFER;
+	}
+
+	GPDMA->DMACIntTCClear = pxPort->ulRxChannelBit | pxPort->ulTxChannelBit;
+	GPDMA->DMACIntErrClr = pxPort->ulRxChannelBit | pxPort->ulTxChannelBit;
+
+	/* Receive.  Byte wide, single transfers, so the widths and burst sizes
+	are all zero. */
+	ulControl = ulLength | spiCONTROL_I;
+	if( pxState->pucRxData != NULL )
+	{
+		pxPort->pxRxChannel->DMACCDestAddr = ( unsigned long ) pxState->pucRxData;
+		pxState->pucRxData += ulLength;
+		ulControl |= spiCONTROL_DI;
+	}
+	else
+	{
+		pxPort->pxRxChannel->DMACCDestAddr = ( unsigned long ) &ucDiscard;
+	}
+	pxPort->pxRxChannel->DMACCSrcAddr = ( unsigned long ) &( pxPort->pxSSP->DR );
+	pxPort->pxRxChannel->DMACCLLI = 0UL;
+	pxPort->pxRxChannel->DMACCControl = ulControl;
+
+	/* Transmit. */
+	ulControl = ulLength;
+	if( pxState->pucTxData != NULL )
+	{
+		pxPort->pxTxChannel->DMACCSrcAddr = ( unsigned long ) pxState->pucTxData;
+		pxState->pucTxData += ulLength;
+		ulControl |= spiCONTROL_SI;
+	}
+	else
+	{
+		pxPort->pxTxChannel->DMACCSrcAddr = ( unsigned long ) &ucFillByte;
+	}
+	pxPort->pxTxChannel->DMACCDestAddr = ( unsigned long ) &( pxPort->pxSSP->DR );
+	pxPort->pxTxChannel->DMACCLLI = 0UL;
+	pxPort->pxTxChannel->DMACCControl = ulControl;
+
+	pxState->usRemaining -= ( unsigned short ) ulLength;
+
+	/* The receive channel must be ready before the first byte is sent. */
+	pxPort->pxRxChannel->DMACCConfig = spiCONFIG_E | ( pxPort->ulRxRequest << spiCONFIG_SRC_SHIFT ) | spiCONFIG_P2M | spiCONFIG_IE | spiCONFIG_ITC;
+	pxPort->pxTxChannel->DMACCConfig = spiCONFIG_E | ( pxPort->ulTxRequest << spiCONFIG_DEST_SHIFT ) | spiCONFIG_M2P;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTransfer( const xSPIPort *pxPort )
+{
+	pxPort->pxRxChannel->DMACCConfig = 0UL;
+	pxPort->pxTxChannel->DMACCConfig = 0UL;
+	GPDMA->DMACIntTCClear = pxPort->ulRxChannelBit | pxPort->ulTxChannelBit;
+	GPDMA->DMACIntErrClr = pxPort->ulRxChannelBit | pxPort->ulTxChannelBit;
+}
+/*-----------------------------------------------------------*/
+
+void GPDMA_IRQHandler( void )
+{
+unsigned portBASE_TYPE uxBus;
+const xSPIPort *pxPort;
+unsigned long ulChannels;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	for( uxBus = 0; uxBus < ( unsigned portBASE_TYPE ) spiNUM_BUSES; uxBus++ )
+	{
+		pxPort = &( xPorts[ uxBus ] );
+		ulChannels = pxPort->ulRxChannelBit | pxPort->ulTxChannelBit;
+
+		if( ( GPDMA->DMACIntErrStat & ulChannels ) != 0UL )
+		{
+			prvStopTransfer( pxPort );
+			xStates[ uxBus ].usRemaining = 0U;
+			vSPIBusTransferDoneFromISR( uxBus, pdFAIL, &xHigherPriorityTaskWoken );
+		}
+		else if( ( GPDMA->DMACIntTCStat & pxPort->ulRxChannelBit ) != 0UL )
+		{
+			/* The last byte of this part has been received, so the FIFOs are
+			empty and the next part can be started straight away. */
+			if( xStates[ uxBus ].usRemaining > 0U )
+			{
+				prvStartChunk( uxBus );
+			}
+			else
+			{
+				prvStopTransfer( pxPort );
+				vSPIBusTransferDoneFromISR( uxBus, pdPASS, &xHigherPriorityTaskWoken );
+			}
+		}
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -91,6 +91,65 @@ typedef struct {
 } EthDev_IOB;
 
 
+/* When emacUSE_RX_POLLING is 1 the EMAC ISR masks the Rx interrupt after the
+first frame, and the uIP task then polls the Rx descriptors until they are
+empty before re-enabling it.  A flood of frames therefore generates one
+interrupt rather than one per frame.  While polling the uIP task processes
+at most emacRX_POLL_BUDGET frames before blocking for emacRX_POLL_DELAY
+ticks, so a flood cannot starve the lower priority tasks - frames that
+arrive meanwhile wait in the Rx descriptors (or are dropped by the EMAC if
+the descriptors fill).  Set emacUSE_RX_POLLING to 0 to give the semaphore
+for every frame instead. */
+#ifndef emacUSE_RX_POLLING
+	#define emacUSE_RX_POLLING		1
+#endif
+
+#ifndef emacRX_POLL_BUDGET
+	#define emacRX_POLL_BUDGET		16
+#endif
+
+#ifndef emacRX_POLL_DELAY
+	#define emacRX_POLL_DELAY		( ( portTickType ) 1 )
+#endif
+
+/* When emacUSE_ASYNC_LINK is 1 lEMACInit() starts auto negotiation and returns
+without waiting for the link to come up, which can otherwise hold up the uIP
+task for several seconds.  The uIP task then calls xEMACCheckLink() every
+emacLINK_CHECK_PERIOD ticks, and sooner if vEMACLinkChangeFromISR() has been
+called, to follow the link going up and down and to set the MAC speed and
+duplex to match the PHY.  Frames sent while the link is down are dropped.
+
+If emacUSE_PHY_INTERRUPT is also 1 the PHY is set to assert its interrupt
+output when the link status changes or auto negotiation completes.  The
+application must then route that pin to an interrupt that calls
+vEMACLinkChangeFromISR(), so link changes are seen without waiting for the
+next check. */
+#ifndef emacUSE_ASYNC_LINK
+	#define emacUSE_ASYNC_LINK		0
+#endif
+
+#ifndef emacUSE_PHY_INTERRUPT
+	#define emacUSE_PHY_INTERRUPT	0
+#endif
+
+#ifndef emacLINK_CHECK_PERIOD
+	#define emacLINK_CHECK_PERIOD	( ( portTickType ) configTICK_RATE_HZ )
+#endif
+
+#if ( emacUSE_PHY_INTERRUPT == 1 ) && ( emacUSE_ASYNC_LINK != 1 )
+	#error emacUSE_PHY_INTERRUPT requires emacUSE_ASYNC_LINK to be set to 1.
+#endif
+
+/* Used with vEMACGetRxStats() to see how well received frames are being
+coalesced. */
+typedef struct xEMAC_RX_STATS
+{
+	unsigned long ulInterrupts;				/*< The number of Rx interrupts. */
+	unsigned long ulFrames;					/*< The number of frames passed to uIP. */
+	unsigned long ulMaxFramesPerInterrupt;	/*< The most frames processed between an Rx interrupt and the Rx descriptors next being empty. */
+	unsigned long ulBudgetsExhausted;		/*< The number of times the uIP task stopped polling because it had used its budget. */
+} xEMACRxStats;
+
 /*
  * Look for received data.  If data is found then uip_buf is assigned to the
  * new data and the length of the data is returned.  If no data is found then
@@ -99,13 +158,79 @@ typedef struct {
 unsigned long 	ulGetEMACRxData( void );
 
 /*
- * Send usTxDataLen bytes from uip_buf.
+ * Called by the uIP task when ulGetEMACRxData() returns 0 because the Rx
+ * descriptors are empty.  Re-enables the Rx interrupt masked by the ISR
+ * (when emacUSE_RX_POLLING is 1).  A frame can arrive between
+ * ulGetEMACRxData() finding the descriptors empty and the interrupt being
+ * re-enabled, so pdTRUE is returned if the descriptors are no longer empty,
+ * in which case the uIP task must poll again rather than block.
+ */
+portBASE_TYPE xEMACRxPollComplete( void );
+
+/*
+ * Called by the uIP task after processing each frame.  Returns pdTRUE each
+ * time emacRX_POLL_BUDGET frames have been polled without the Rx descriptors
+ * becoming empty, in which case the uIP task should block for
+ * emacRX_POLL_DELAY ticks before polling again.  The Rx interrupt remains
+ * masked meanwhile.  Always returns pdFALSE if emacUSE_RX_POLLING is 0.
+ */
+portBASE_TYPE xEMACRxBudgetExhausted( void );
+
+/*
+ * Obtain a copy of the Rx interrupt coalescing statistics.
+ */
+void vEMACGetRxStats( xEMACRxStats *pxStats );
+
+/*
+ * Read the link status from the PHY and, if it has changed since the last
+ * call, set the MAC speed and duplex to match.  Returns pdTRUE if the link is
+ * up.  Only available when emacUSE_ASYNC_LINK is 1.
+ */
+portBASE_TYPE xEMACCheckLink( void );
+
+/*
+ * Returns pdTRUE if vEMACLinkChangeFromISR() has been called since the last
+ * call to xEMACCheckLink(), so the link should be checked straight away.
+ */
+portBASE_TYPE xEMACLinkChangePending( void );
+
+/*
+ * Called from the interrupt raised by the PHY interrupt output when
+ * emacUSE_PHY_INTERRUPT is 1.  Wakes the uIP task to check the link.
+ */
+void vEMACLinkChangeFromISR( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Send usTxDataLen bytes from uip_buf.  When emacUSE_ASYNC_LINK is 1 the data
+ * is discarded if the link is down.
  */
 void vSendEMACTxData( unsigned short usTxDataLen );
 
 /*
- * Prepare the Ethernet hardware ready for TCP/IP comms.
+ * Prepare the Ethernet hardware ready for TCP/IP comms.  Unless
+ * emacUSE_ASYNC_LINK is 1 this waits for the link to be established, and
+ * fails if it is not.
  */
 long lEMACInit(void);
 
+/*
+ * Add (xAdd == pdTRUE) or remove (xAdd == pdFALSE) a multicast MAC address in
+ * the hash filter, so that only multicast frames sent to joined groups are
+ * received.  Frames of other groups that share a hash bin with a joined group
+ * still get through and are dropped by the TCP/IP stack.  Each bin counts the
+ * addresses using it, so an address must be removed as often as it was added.
+ * Returns pdFAIL when removing an address that was never added.
+ */
+long lEMACSetMulticastFilter( const unsigned char *pucMACAddress, portBASE_TYPE xAdd );
+
+/*
+ * As lEMACSetMulticastFilter(), but taking an IPv4 group address (4 bytes in
+ * network order) and using the 01:00:5E MAC address it maps to.  An lwIP
+ * netif would call it from its igmp_mac_filter function:
+ *
+ *   return lEMACSetMulticastGroup( ( unsigned char * ) &( pxGroup->addr ),
+ *          ( xAction == IGMP_ADD_MAC_FILTER ) ) == pdPASS ? ERR_OK : ERR_VAL;
+ */
+long lEMACSetMulticastGroup( const unsigned char *pucGroupAddress, portBASE_TYPE xAdd );
+
 #endif
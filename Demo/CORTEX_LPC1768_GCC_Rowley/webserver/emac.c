@@ -57,9 +57,11 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "memory_pool.h"
 
 /* Hardware specific includes. */
 #include "EthDev_LPC17xx.h"
+#include "EthDev.h"
 
 /* Time to wait between each inspection of the link status. */
 #define emacWAIT_FOR_LINK_TO_ESTABLISH ( 500 / portTICK_RATE_MS )
@@ -71,8 +73,16 @@
 #define emacLINK_ESTABLISHED		( 0x0001 )
 #define emacFULL_DUPLEX_ENABLED		( 0x0004 )
 #define emac10BASE_T_MODE			( 0x0002 )
+#define emacLINK_STATUS_MASK		( emacLINK_ESTABLISHED | emacFULL_DUPLEX_ENABLED | emac10BASE_T_MODE )
 #define emacPINSEL2_VALUE			( 0x50150105 )
 
+/* DP83848C interrupt control (MICR) and status (MISR) bits used to have the
+PHY signal link changes.  Reading MISR clears the interrupt. */
+#define emacMICR_INT_OE				( 0x0001 )
+#define emacMICR_INTEN				( 0x0002 )
+#define emacMISR_ANC_INT_EN			( 0x0004 )
+#define emacMISR_LINK_INT_EN		( 0x0020 )
+
 /* If no buffers are available, then wait this long before looking again.... */
 #define emacBUFFER_WAIT_DELAY	( 3 / portTICK_RATE_MS )
 
@@ -83,6 +93,11 @@
 descriptor is then used to re-send in order to speed up the uIP Tx process. */
 #define emacTX_DESC_INDEX			( 0 )
 
+/* The multicast hash filter has one bit per bin in HashFilterL/H.  The bin is
+bits 28:23 of the Ethernet CRC of the destination address. */
+#define emacHASH_BINS				( 64 )
+#define emacCRC_POLYNOMIAL			( 0x04C11DB7UL )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -96,7 +111,8 @@ static void prvInitDescriptors( void );
 static void prvSetupEMACHardware( void );
 
 /*
- * Control the auto negotiate process.
+ * Control the auto negotiate process.  When emacUSE_ASYNC_LINK is 1 auto
+ * negotiation is started but not waited for.
  */
 static void prvConfigurePHY( void );
 
@@ -104,19 +120,38 @@ static void prvConfigurePHY( void );
  * Wait for a link to be established, then setup the PHY according to the link
  * parameters.
  */
-static long prvSetupLinkStatus( void );
+#if emacUSE_ASYNC_LINK == 0
+	static long prvSetupLinkStatus( void );
+#endif
 
 /*
- * Search the pool of buffers to find one that is free.  If a buffer is found
- * mark it as in use before returning its address.
+ * Set the MAC speed and duplex from the value of the PHY status register.
+ */
+static void prvApplyLinkStatus( unsigned short usLinkStatus );
+
+/*
+ * Obtain a free buffer from the pool of buffers, waiting a short time for one
+ * to be returned if the pool is empty.
  */
 static unsigned char *prvGetNextBuffer( void );
 
 /*
- * Return an allocated buffer to the pool of free buffers.
+ * Return an allocated buffer to the pool of free buffers.  Must not be called
+ * from an interrupt - the ISR uses vMemoryPoolFreeFromISR() directly.
  */
 static void prvReturnBuffer( unsigned char *pucBuffer );
 
+/*
+ * Return the hash filter bin that frames sent to pucMACAddress fall into.
+ */
+static unsigned long prvHashIndex( const unsigned char *pucMACAddress );
+
+/*
+ * Write the hash filter registers from ucHashBinUsers[], and only accept
+ * multicast frames through the hash filter while a bin is open.
+ */
+static void prvUpdateHashFilter( void );
+
 /*
  * Send lValue to the lPhyReg within the PHY.
  */
@@ -133,10 +168,11 @@ static unsigned short prvReadPHY( unsigned char ucPhyReg, long *plStatus );
 /* The semaphore used to wake the uIP task when data arrives. */
 extern xSemaphoreHandle xEMACSemaphore;
 
-/* Each ucBufferInUse index corresponds to a position in the pool of buffers.
-If the index contains a 1 then the buffer within pool is in use, if it
-contains a 0 then the buffer is free. */
-static unsigned char ucBufferInUse[ ETH_NUM_BUFFERS ] = { pdFALSE };
+/* The Ethernet buffers are allocated from a memory pool that is created over
+the area of the Ethernet RAM that follows the descriptors.  The pool keeps the
+free buffers in a list so a buffer can be obtained or returned without
+searching, and buffers can be returned from the EMAC interrupt. */
+static xMemoryPoolHandle xEMACBufferPool = NULL;
 
 /* The uip_buffer is not a fixed array, but instead gets pointed to the buffers
 allocated within this file. */
@@ -146,6 +182,25 @@ unsigned char * uip_buf;
 value will be set back to 0 once the data has been sent twice. */
 static unsigned short usSendLen = 0;
 
+/* Coalescing statistics. */
+static xEMACRxStats xRxStats = { 0UL, 0UL, 0UL, 0UL };
+static unsigned long ulFramesSinceInterrupt = 0UL;
+
+/* The number of frames polled since the uIP task last paused or found the
+Rx descriptors empty. */
+static unsigned long ulFramesInBudget = 0UL;
+
+/* The number of joined multicast addresses that fall into each hash filter
+bin.  A bin is open while its count is not zero. */
+static unsigned char ucHashBinUsers[ emacHASH_BINS ] = { 0 };
+
+#if emacUSE_ASYNC_LINK == 1
+	/* The link status bits last applied to the MAC, and whether the PHY has
+	signalled a change that xEMACCheckLink() has not yet looked at. */
+	static unsigned short usLastLinkStatus = 0U;
+	static volatile portBASE_TYPE xLinkChangePending = pdFALSE;
+#endif
+
 /*-----------------------------------------------------------*/
 
 long lEMACInit( void )
@@ -159,7 +214,23 @@ unsigned long ulID1, ulID2;
 	/* Check the PHY part number is as expected. */
 	ulID1 = prvReadPHY( PHY_REG_IDR1, &lReturn );
 	ulID2 = prvReadPHY( PHY_REG_IDR2, &lReturn );
-	if( ( (ulID1 << 16UL ) | ( ulID2 & 0xFFF0UL ) ) == DP83848C_ID )
+
+	/* Divide the Ethernet RAM that follows the descriptors into buffers.
+	lEMACInit() is called repeatedly until it passes, and no buffers are in use
+	until it does, so the pool is created afresh each time to ensure every
+	attempt starts with all the buffers free. */
+	if( xEMACBufferPool != NULL )
+	{
+		vMemoryPoolDelete( xEMACBufferPool );
+	}
+
+	xEMACBufferPool = xMemoryPoolCreate( ( void * ) ETH_BUF_BASE, ETH_NUM_BUFFERS * ETH_FRAG_SIZE, ETH_FRAG_SIZE );
+
+	if( xEMACBufferPool == NULL )
+	{
+		lReturn = pdFAIL;
+	}
+	else if( ( (ulID1 << 16UL ) | ( ulID2 & 0xFFF0UL ) ) == DP83848C_ID )
 	{
 		/* Set the Ethernet MAC Address registers */
 		EMAC->SA0 = ( configMAC_ADDR0 << 8 ) | configMAC_ADDR1;
@@ -169,8 +240,10 @@ unsigned long ulID1, ulID2;
 		/* Initialize Tx and Rx DMA Descriptors */
 		prvInitDescriptors();
 
-		/* Receive broadcast and perfect match packets */
+		/* Receive broadcast and perfect match packets, plus multicast packets
+		for any groups that were joined before a re-initialisation. */
 		EMAC->RxFilterCtrl = RFC_UCAST_EN | RFC_BCAST_EN | RFC_PERFECT_EN;
+		prvUpdateHashFilter();
 
 		/* Setup the PHY. */
 		prvConfigurePHY();
@@ -181,10 +254,21 @@ unsigned long ulID1, ulID2;
 	}
 
 	/* Check the link status. */
-	if( lReturn == pdPASS )
+	#if emacUSE_ASYNC_LINK == 1
+	{
+		/* The link is brought up by xEMACCheckLink() once auto negotiation
+		completes, so the MAC can be enabled straight away. */
+		usLastLinkStatus = 0U;
+		xLinkChangePending = pdTRUE;
+	}
+	#else
 	{
-		lReturn = prvSetupLinkStatus();
+		if( lReturn == pdPASS )
+		{
+			lReturn = prvSetupLinkStatus();
+		}
 	}
+	#endif
 
 	if( lReturn == pdPASS )
 	{
@@ -205,23 +289,13 @@ unsigned long ulID1, ulID2;
 
 static unsigned char *prvGetNextBuffer( void )
 {
-long x;
 unsigned char *pucReturn = NULL;
 unsigned long ulAttempts = 0;
 
 	while( pucReturn == NULL )
 	{
-		/* Look through the buffers to find one that is not in use by
-		anything else. */
-		for( x = 0; x < ETH_NUM_BUFFERS; x++ )
-		{
-			if( ucBufferInUse[ x ] == pdFALSE )
-			{
-				ucBufferInUse[ x ] = pdTRUE;
-				pucReturn = ( unsigned char * ) ETH_BUF( x );
-				break;
-			}
-		}
+		/* Take a buffer that is not in use by anything else. */
+		pucReturn = ( unsigned char * ) pvMemoryPoolAlloc( xEMACBufferPool );
 
 		/* Was a buffer found? */
 		if( pucReturn == NULL )
@@ -244,19 +318,16 @@ unsigned long ulAttempts = 0;
 
 static void prvInitDescriptors( void )
 {
-long x, lNextBuffer = 0;
+long x;
 
 	for( x = 0; x < NUM_RX_FRAG; x++ )
 	{
-		/* Allocate the next Ethernet buffer to this descriptor. */
-		RX_DESC_PACKET( x ) = ETH_BUF( lNextBuffer );
+		/* Allocate the next Ethernet buffer to this descriptor.  The pool
+		holds more buffers than there are descriptors so this cannot fail. */
+		RX_DESC_PACKET( x ) = ( unsigned long ) pvMemoryPoolAlloc( xEMACBufferPool );
 		RX_DESC_CTRL( x ) = RCTRL_INT | ( ETH_FRAG_SIZE - 1 );
 		RX_STAT_INFO( x ) = 0;
 		RX_STAT_HASHCRC( x ) = 0;
-
-		/* The Ethernet buffer is now in use. */
-		ucBufferInUse[ lNextBuffer ] = pdTRUE;
-		lNextBuffer++;
 	}
 
 	/* Set EMAC Receive Descriptor Registers. */
@@ -344,7 +415,25 @@ static void prvConfigurePHY( void )
 unsigned short us;
 long x, lDummy;
 
+	#if emacUSE_PHY_INTERRUPT == 1
+	{
+		/* Have the PHY interrupt output follow the link.  Reading MISR clears
+		anything already latched. */
+		prvWritePHY( PHY_REG_MISR, emacMISR_LINK_INT_EN | emacMISR_ANC_INT_EN );
+		prvWritePHY( PHY_REG_MICR, emacMICR_INTEN | emacMICR_INT_OE );
+		( void ) prvReadPHY( PHY_REG_MISR, &lDummy );
+	}
+	#endif
+
 	/* Auto negotiate the configuration. */
+	#if emacUSE_ASYNC_LINK == 1
+	{
+		( void ) us;
+		( void ) x;
+		( void ) lDummy;
+		prvWritePHY( PHY_REG_BMCR, PHY_AUTO_NEG );
+	}
+	#else
 	if( prvWritePHY( PHY_REG_BMCR, PHY_AUTO_NEG ) )
 	{
 		vTaskDelay( emacSHORT_DELAY * 5 );
@@ -361,9 +450,12 @@ long x, lDummy;
 			vTaskDelay( emacWAIT_FOR_LINK_TO_ESTABLISH );
 		}
 	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
+#if emacUSE_ASYNC_LINK == 0
+
 static long prvSetupLinkStatus( void )
 {
 long lReturn = pdFAIL, x;
@@ -385,50 +477,102 @@ unsigned short usLinkStatus;
 
 	if( lReturn == pdPASS )
 	{
-		/* Configure Full/Half Duplex mode. */
-		if( usLinkStatus & emacFULL_DUPLEX_ENABLED )
-		{
-			/* Full duplex is enabled. */
-			EMAC->MAC2 |= MAC2_FULL_DUP;
-			EMAC->Command |= CR_FULL_DUP;
-			EMAC->IPGT = IPGT_FULL_DUP;
-		}
-		else
-		{
-			/* Half duplex mode. */
-			EMAC->IPGT = IPGT_HALF_DUP;
-		}
-
-		/* Configure 100MBit/10MBit mode. */
-		if( usLinkStatus & emac10BASE_T_MODE )
-		{
-			/* 10MBit mode. */
-			EMAC->SUPP = 0;
-		}
-		else
-		{
-			/* 100MBit mode. */
-			EMAC->SUPP = SUPP_SPEED;
-		}
+		prvApplyLinkStatus( usLinkStatus );
 	}
 
 	return lReturn;
 }
+
+#endif /* emacUSE_ASYNC_LINK */
 /*-----------------------------------------------------------*/
 
-static void prvReturnBuffer( unsigned char *pucBuffer )
+static void prvApplyLinkStatus( unsigned short usLinkStatus )
 {
-unsigned long ul;
+	/* Configure Full/Half Duplex mode.  The link may previously have been
+	full duplex, so the full duplex bits are cleared for half duplex. */
+	if( usLinkStatus & emacFULL_DUPLEX_ENABLED )
+	{
+		/* Full duplex is enabled. */
+		EMAC->MAC2 |= MAC2_FULL_DUP;
+		EMAC->Command |= CR_FULL_DUP;
+		EMAC->IPGT = IPGT_FULL_DUP;
+	}
+	else
+	{
+		/* Half duplex mode. */
+		EMAC->MAC2 &= ~MAC2_FULL_DUP;
+		EMAC->Command &= ~CR_FULL_DUP;
+		EMAC->IPGT = IPGT_HALF_DUP;
+	}
 
-	/* Return a buffer to the pool of free buffers. */
-	for( ul = 0; ul < ETH_NUM_BUFFERS; ul++ )
+	/* Configure 100MBit/10MBit mode. */
+	if( usLinkStatus & emac10BASE_T_MODE )
+	{
+		/* 10MBit mode. */
+		EMAC->SUPP = 0;
+	}
+	else
 	{
-		if( ETH_BUF( ul ) == ( unsigned long ) pucBuffer )
+		/* 100MBit mode. */
+		EMAC->SUPP = SUPP_SPEED;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if emacUSE_ASYNC_LINK == 1
+
+	portBASE_TYPE xEMACCheckLink( void )
+	{
+	unsigned short usLinkStatus;
+	long lStatus = pdPASS;
+
+		xLinkChangePending = pdFALSE;
+
+		#if emacUSE_PHY_INTERRUPT == 1
 		{
-			ucBufferInUse[ ul ] = pdFALSE;
-			break;
+			/* Clear the interrupt before reading the status, so a change that
+			happens after the status is read raises the interrupt again. */
+			( void ) prvReadPHY( PHY_REG_MISR, &lStatus );
 		}
+		#endif
+
+		usLinkStatus = prvReadPHY( PHY_REG_STS, &lStatus ) & emacLINK_STATUS_MASK;
+
+		/* A failed read leaves the MAC as it was, and is retried at the next
+		check. */
+		if( ( lStatus == pdPASS ) && ( usLinkStatus != usLastLinkStatus ) )
+		{
+			if( ( usLinkStatus & emacLINK_ESTABLISHED ) != 0U )
+			{
+				prvApplyLinkStatus( usLinkStatus );
+			}
+
+			usLastLinkStatus = usLinkStatus;
+		}
+
+		return ( ( usLastLinkStatus & emacLINK_ESTABLISHED ) != 0U ) ? pdTRUE : pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	portBASE_TYPE xEMACLinkChangePending( void )
+	{
+		return xLinkChangePending;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vEMACLinkChangeFromISR( portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		xLinkChangePending = pdTRUE;
+		xSemaphoreGiveFromISR( xEMACSemaphore, pxHigherPriorityTaskWoken );
 	}
+
+#endif /* emacUSE_ASYNC_LINK */
+/*-----------------------------------------------------------*/
+
+static void prvReturnBuffer( unsigned char *pucBuffer )
+{
+	/* Return a buffer to the pool of free buffers.  NULL is ignored. */
+	vMemoryPoolFree( xEMACBufferPool, pucBuffer );
 }
 /*-----------------------------------------------------------*/
 
@@ -460,16 +604,205 @@ long lIndex;
 		}
 
 		EMAC->RxConsumeIndex = lIndex;
+
+		xRxStats.ulFrames++;
+		ulFramesSinceInterrupt++;
+		ulFramesInBudget++;
 	}
 
 	return ulLen;
 }
 /*-----------------------------------------------------------*/
 
+portBASE_TYPE xEMACRxPollComplete( void )
+{
+	if( ulFramesSinceInterrupt > xRxStats.ulMaxFramesPerInterrupt )
+	{
+		xRxStats.ulMaxFramesPerInterrupt = ulFramesSinceInterrupt;
+	}
+	ulFramesSinceInterrupt = 0UL;
+	ulFramesInBudget = 0UL;
+
+	#if emacUSE_RX_POLLING == 1
+	{
+		/* Unmask the Rx interrupt.  IntEnable is also written by the ISR so
+		the read-modify-write must not be interrupted. */
+		portENTER_CRITICAL();
+		{
+			EMAC->IntEnable |= INT_RX_DONE;
+		}
+		portEXIT_CRITICAL();
+	}
+	#endif
+
+	/* A frame that completed after ulGetEMACRxData() looked at the
+	descriptors, but before the interrupt was unmasked, will not generate an
+	interrupt if a Tx interrupt has since cleared the Rx status bit, so look
+	again. */
+	return ( EMAC->RxProduceIndex != EMAC->RxConsumeIndex ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xEMACRxBudgetExhausted( void )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	#if emacUSE_RX_POLLING == 1
+	{
+		if( ulFramesInBudget >= emacRX_POLL_BUDGET )
+		{
+			ulFramesInBudget = 0UL;
+			xRxStats.ulBudgetsExhausted++;
+			xReturn = pdTRUE;
+		}
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEMACGetRxStats( xEMACRxStats *pxStats )
+{
+	portENTER_CRITICAL();
+	{
+		*pxStats = xRxStats;
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvHashIndex( const unsigned char *pucMACAddress )
+{
+unsigned long ulCRC = 0xffffffffUL, ulByte, ulBit;
+unsigned char ucData;
+
+	/* The CRC is calculated as for the frame check sequence, with each byte
+	fed in least significant bit first. */
+	for( ulByte = 0UL; ulByte < 6UL; ulByte++ )
+	{
+		ucData = pucMACAddress[ ulByte ];
+
+		for( ulBit = 0UL; ulBit < 8UL; ulBit++ )
+		{
+			if( ( ( ulCRC >> 31UL ) ^ ( ucData & 0x01U ) ) != 0UL )
+			{
+				ulCRC = ( ulCRC << 1UL ) ^ emacCRC_POLYNOMIAL;
+			}
+			else
+			{
+				ulCRC <<= 1UL;
+			}
+
+			ucData >>= 1U;
+		}
+	}
+
+	return ( ulCRC >> 23UL ) & ( emacHASH_BINS - 1UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateHashFilter( void )
+{
+unsigned long ulLow = 0UL, ulHigh = 0UL, ulBin;
+
+	for( ulBin = 0UL; ulBin < emacHASH_BINS; ulBin++ )
+	{
+		if( ucHashBinUsers[ ulBin ] != 0U )
+		{
+			if( ulBin < 32UL )
+			{
+				ulLow |= 1UL << ulBin;
+			}
+			else
+			{
+				ulHigh |= 1UL << ( ulBin - 32UL );
+			}
+		}
+	}
+
+	EMAC->HashFilterL = ulLow;
+	EMAC->HashFilterH = ulHigh;
+
+	if( ( ulLow | ulHigh ) != 0UL )
+	{
+		EMAC->RxFilterCtrl |= RFC_MCAST_HASH_EN;
+	}
+	else
+	{
+		EMAC->RxFilterCtrl &= ~RFC_MCAST_HASH_EN;
+	}
+}
+/*-----------------------------------------------------------*/
+
+long lEMACSetMulticastFilter( const unsigned char *pucMACAddress, portBASE_TYPE xAdd )
+{
+unsigned long ulBin = prvHashIndex( pucMACAddress );
+long lReturn = pdPASS;
+
+	if( xAdd != pdFALSE )
+	{
+		if( ucHashBinUsers[ ulBin ] == 0xffU )
+		{
+			lReturn = pdFAIL;
+		}
+		else
+		{
+			ucHashBinUsers[ ulBin ]++;
+		}
+	}
+	else
+	{
+		if( ucHashBinUsers[ ulBin ] == 0U )
+		{
+			lReturn = pdFAIL;
+		}
+		else
+		{
+			ucHashBinUsers[ ulBin ]--;
+		}
+	}
+
+	if( lReturn == pdPASS )
+	{
+		prvUpdateHashFilter();
+	}
+
+	return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+long lEMACSetMulticastGroup( const unsigned char *pucGroupAddress, portBASE_TYPE xAdd )
+{
+unsigned char ucMACAddress[ 6 ];
+
+	/* RFC 1112: the low 23 bits of the group address follow 01:00:5E. */
+	ucMACAddress[ 0 ] = 0x01U;
+	ucMACAddress[ 1 ] = 0x00U;
+	ucMACAddress[ 2 ] = 0x5eU;
+	ucMACAddress[ 3 ] = pucGroupAddress[ 1 ] & 0x7fU;
+	ucMACAddress[ 4 ] = pucGroupAddress[ 2 ];
+	ucMACAddress[ 5 ] = pucGroupAddress[ 3 ];
+
+	return lEMACSetMulticastFilter( ucMACAddress, xAdd );
+}
+/*-----------------------------------------------------------*/
+
 void vSendEMACTxData( unsigned short usTxDataLen )
 {
 unsigned long ulAttempts = 0UL;
 
+	#if emacUSE_ASYNC_LINK == 1
+	{
+		/* There is nowhere to send the data while the link is down.  uip_buf
+		is left as it is to be used again. */
+		if( ( usLastLinkStatus & emacLINK_ESTABLISHED ) == 0U )
+		{
+			return;
+		}
+	}
+	#endif
+
 	/* Check to see if the Tx descriptor is free, indicated by its buffer being
 	NULL. */
 	while( TX_DESC_PACKET( emacTX_DESC_INDEX ) != ( unsigned long ) NULL )
@@ -576,6 +909,16 @@ long lHigherPriorityTaskWoken = pdFALSE;
 	{
 		/* Ensure the uIP task is not blocked as data has arrived. */
 		xSemaphoreGiveFromISR( xEMACSemaphore, &lHigherPriorityTaskWoken );
+		xRxStats.ulInterrupts++;
+
+		#if emacUSE_RX_POLLING == 1
+		{
+			/* The uIP task will now poll the Rx descriptors until they are
+			empty, so further Rx interrupts are not needed until then.
+			xEMACRxPollComplete() enables the interrupt again. */
+			EMAC->IntEnable &= ~INT_RX_DONE;
+		}
+		#endif
 	}
 
 	if( ulStatus & INT_TX_DONE )
@@ -595,7 +938,7 @@ long lHigherPriorityTaskWoken = pdFALSE;
 		else
 		{
 			/* The Tx buffer is no longer required. */
-			prvReturnBuffer( ( unsigned char * ) TX_DESC_PACKET( emacTX_DESC_INDEX ) );
+			vMemoryPoolFreeFromISR( xEMACBufferPool, ( void * ) TX_DESC_PACKET( emacTX_DESC_INDEX ) );
             TX_DESC_PACKET( emacTX_DESC_INDEX ) = ( unsigned long ) NULL;
 		}
 	}
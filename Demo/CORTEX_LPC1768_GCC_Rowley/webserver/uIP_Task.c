@@ -119,6 +119,9 @@ void vuIP_Task( void *pvParameters )
 portBASE_TYPE i;
 uip_ipaddr_t xIPAddr;
 struct timer periodic_timer, arp_timer;
+#if emacUSE_ASYNC_LINK == 1
+	struct timer link_timer;
+#endif
 extern void ( vEMAC_ISR_Wrapper )( void );
 
 	( void ) pvParameters;
@@ -126,6 +129,11 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 	/* Initialise the uIP stack. */
 	timer_set( &periodic_timer, configTICK_RATE_HZ / 2 );
 	timer_set( &arp_timer, configTICK_RATE_HZ * 10 );
+	#if emacUSE_ASYNC_LINK == 1
+	{
+		timer_set( &link_timer, emacLINK_CHECK_PERIOD );
+	}
+	#endif
 	uip_init();
 	uip_ipaddr( xIPAddr, configIP_ADDR0, configIP_ADDR1, configIP_ADDR2, configIP_ADDR3 );
 	uip_sethostaddr( xIPAddr );
@@ -191,9 +199,27 @@ extern void ( vEMAC_ISR_Wrapper )( void );
 					vSendEMACTxData( uip_len );
 				}
 			}
+
+			/* Give the other tasks a chance to run if frames are arriving
+			faster than they can be processed. */
+			if( xEMACRxBudgetExhausted() != pdFALSE )
+			{
+				vTaskDelay( emacRX_POLL_DELAY );
+			}
 		}
-		else
+		else if( xEMACRxPollComplete() == pdFALSE )
 		{
+			#if emacUSE_ASYNC_LINK == 1
+			{
+				/* Follow the link, which lEMACInit() did not wait for. */
+				if( ( xEMACLinkChangePending() != pdFALSE ) || timer_expired( &link_timer ) )
+				{
+					timer_reset( &link_timer );
+					( void ) xEMACCheckLink();
+				}
+			}
+			#endif
+
 			if( timer_expired( &periodic_timer ) && ( uip_buf != NULL ) )
 			{
 				timer_reset( &periodic_timer );
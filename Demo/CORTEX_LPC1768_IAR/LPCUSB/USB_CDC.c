@@ -30,6 +30,11 @@
 	This example application simply echoes everything it receives right back
 	to the host.
 
+	The bulk endpoints are served by the DMA engine through the endpoint
+	queues of usbqueue.c, so the task is handed whole buffers and the USB
+	interrupt does no per byte work. A task that streams data to the host
+	fills the buffers of the bulk IN queue in place in the same way.
+
 	Windows:
 	Extract the usbser.sys file from .cab file in C:\WINDOWS\Driver Cache\i386
 	and store it somewhere (C:\temp is a good place) along with the usbser.inf
@@ -47,7 +52,6 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -55,12 +59,10 @@
 #include "usbapi.h"
 #include "usbdebug.h"
 #include "usbstruct.h"
+#include "usbqueue.h"
 
 #include "LPC17xx.h"
 
-#define usbMAX_SEND_BLOCK		( 20 / portTICK_RATE_MS )
-#define usbBUFFER_LEN			( 20 )
-
 #define INCREMENT_ECHO_BY 1
 #define BAUD_RATE	115200
 
@@ -89,10 +91,9 @@ typedef struct {
 } TLineCoding;
 
 static TLineCoding LineCoding = {115200, 0, 0, 8};
-static unsigned char abBulkBuf[64];
 static unsigned char abClassReqData[8];
 
-static xQueueHandle xRxedChars = NULL, xCharsForTx = NULL;
+static xUSBQueueHandle xBulkOut = NULL, xBulkIn = NULL;
 
 // forward declaration of interrupt handler
 void USBIntHandler(void);
@@ -210,67 +211,6 @@ static const unsigned char abDescriptors[] = {
 };
 
 
-/**
-	Local function to handle incoming bulk data
-		
-	@param [in] bEP
-	@param [in] bEPStatus
- */
-static void BulkOut(unsigned char bEP, unsigned char bEPStatus)
-{
-	int i, iLen;
-	long lHigherPriorityTaskWoken = pdFALSE;
-
-	( void ) bEPStatus;
-	
-	// get data from USB into intermediate buffer
-	iLen = USBHwEPRead(bEP, abBulkBuf, sizeof(abBulkBuf));
-	for (i = 0; i < iLen; i++) {
-		// put into queue
-		xQueueSendFromISR( xRxedChars, &( abBulkBuf[ i ] ), &lHigherPriorityTaskWoken );
-	}
-	
-	portEND_SWITCHING_ISR( lHigherPriorityTaskWoken );
-}
-
-
-/**
-	Local function to handle outgoing bulk data
-		
-	@param [in] bEP
-	@param [in] bEPStatus
- */
-static void BulkIn(unsigned char bEP, unsigned char bEPStatus)
-{
-	int i, iLen;
-	long lHigherPriorityTaskWoken = pdFALSE;
-
-	( void ) bEPStatus;
-	
-	if (uxQueueMessagesWaitingFromISR( xCharsForTx ) == 0) {
-		// no more data, disable further NAK interrupts until next USB frame
-		USBHwNakIntEnable(0);
-		return;
-	}
-
-	// get bytes from transmit FIFO into intermediate buffer
-	for (i = 0; i < MAX_PACKET_SIZE; i++) {
-		if( xQueueReceiveFromISR( xCharsForTx, ( &abBulkBuf[i] ), &lHigherPriorityTaskWoken ) != pdPASS )
-		{
-			break;
-		}
-	}
-	iLen = i;
-	
-	// send over USB
-	if (iLen > 0) {
-		USBHwEPWrite(bEP, abBulkBuf, iLen);
-	}
-	
-	portEND_SWITCHING_ISR( lHigherPriorityTaskWoken );
-}
-
-
 /**
 	Local function to handle the USB-CDC class requests
 		
@@ -314,42 +254,6 @@ DBG("SET_CONTROL_LINE_STATE %X\n", pSetup->wValue);
 }
 
 
-/**
-	Writes one character to VCOM port
-	
-	@param [in] c character to write
-	@returns character written, or EOF if character could not be written
- */
-int VCOM_putchar(int c)
-{
-char cc = ( char ) c;
-
-	if( xQueueSend( xCharsForTx, &cc, usbMAX_SEND_BLOCK ) == pdPASS )
-	{
-		return c;
-	}
-	else
-	{
-		return EOF;
-	}
-}
-
-
-/**
-	Reads one character from VCOM port
-	
-	@returns character read, or EOF if character could not be read
- */
-int VCOM_getchar(void)
-{
-	unsigned char c;
-	
-	/* Block the task until a character is available. */
-	xQueueReceive( xRxedChars, &c, portMAX_DELAY );
-	return c;
-}
-
-
 /**
 	Interrupt handler
 	
@@ -362,38 +266,29 @@ void USB_IRQHandler(void)
 }
 
 
-static void USBFrameHandler(unsigned short wFrame)
-{
-	( void ) wFrame;
-	
-	if( uxQueueMessagesWaitingFromISR( xCharsForTx ) > 0 )
-	{
-		// data available, enable NAK interrupt on bulk in
-		USBHwNakIntEnable(INACK_BI);
-	}
-}
-
 void vUSBTask( void *pvParameters )
 {
-	int c;
+	unsigned char *pucRx, *pucTx;
+	unsigned short usRxLength, usTxLength, us;
 	
 	/* Just to prevent compiler warnings about the unused parameter. */
 	( void ) pvParameters;
 	DBG("Initialising USB stack\n");
 
-	xRxedChars = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
-	xCharsForTx = xQueueCreate( usbBUFFER_LEN, sizeof( char ) );
+	// initialise stack
+	USBInit();
+
+	/* The host does not end its OUT transfers with a short packet, so each
+	OUT buffer holds one packet.  The IN buffers take many packets each. */
+	xBulkOut = xUSBQueueCreate( BULK_OUT_EP, MAX_PACKET_SIZE, MAX_PACKET_SIZE );
+	xBulkIn = xUSBQueueCreate( BULK_IN_EP, MAX_PACKET_SIZE, usbqBUFFER_SIZE );
 
-	if( ( xRxedChars == NULL ) || ( xCharsForTx == NULL ) )
+	if( ( xBulkOut == NULL ) || ( xBulkIn == NULL ) )
 	{
-		/* Not enough heap available to create the buffer queues, can't do
+		/* Not enough heap available to create the endpoint queues, can't do
 		anything so just delete ourselves. */
 		vTaskDelete( NULL );
 	}
-	
-	
-	// initialise stack
-	USBInit();
 
 	// register descriptors
 	USBRegisterDescriptors(abDescriptors);
@@ -401,16 +296,8 @@ void vUSBTask( void *pvParameters )
 	// register class request handler
 	USBRegisterRequestHandler(REQTYPE_TYPE_CLASS, HandleClassRequest, abClassReqData);
 
-	// register endpoint handlers
+	// register endpoint handlers, the bulk endpoints are served by DMA
 	USBHwRegisterEPIntHandler(INT_IN_EP, NULL);
-	USBHwRegisterEPIntHandler(BULK_IN_EP, BulkIn);
-	USBHwRegisterEPIntHandler(BULK_OUT_EP, BulkOut);
-	
-	// register frame handler
-	USBHwRegisterFrameHandler(USBFrameHandler);
-
-	// enable bulk-in interrupts on NAKs
-	USBHwNakIntEnable(INACK_BI);
 
 	DBG("Starting USB communication\n");
 
@@ -422,15 +309,26 @@ void vUSBTask( void *pvParameters )
 	DBG("Connecting to USB bus\n");
 	USBHwConnect(TRUE);
 
-	// echo any character received (do USB stuff in interrupt)
+	// echo any character received
 	for( ;; )
 	{
-		c = VCOM_getchar();
-		if (c != EOF)
+		pucRx = pucUSBQueueGet( xBulkOut, &usRxLength, portMAX_DELAY );
+		if( ( pucRx != NULL ) && ( usRxLength > 0 ) )
 		{
-			// Echo character back with INCREMENT_ECHO_BY offset, so for example if
+			pucTx = pucUSBQueueGet( xBulkIn, &usTxLength, portMAX_DELAY );
+
+			// Echo characters back with INCREMENT_ECHO_BY offset, so for example if
 			// INCREMENT_ECHO_BY is 1 and 'A' is received, 'B' will be echoed back.
-			VCOM_putchar(c + INCREMENT_ECHO_BY );
+			for( us = 0; us < usRxLength; us++ )
+			{
+				pucTx[ us ] = pucRx[ us ] + INCREMENT_ECHO_BY;
+			}
+			vUSBQueuePut( xBulkIn, usRxLength );
+		}
+
+		if( pucRx != NULL )
+		{
+			vUSBQueuePut( xBulkOut, 0 );
 		}
 	}
 }
@@ -92,6 +92,36 @@ typedef void (TFnFrameHandler)(unsigned short wFrame);
 void USBHwRegisterFrameHandler(TFnFrameHandler *pfnHandler);
 
 
+/*************************************************************************
+	USB DMA interface
+**************************************************************************/
+
+/**
+	DMA descriptor. A descriptor and its buffer belong to the DMA engine
+	from USBHwDMAStart until the DMA handler reports it done, and must be
+	located in memory the engine can reach (the AHB SRAM on the LPC176x).
+ */
+typedef struct {
+	unsigned long	dwNext;
+	unsigned long	dwControl;
+	unsigned long	dwBuffer;
+	unsigned long	dwStatus;
+} TDMADescriptor;
+
+// DMA status sent through callback
+#define DMA_STATUS_DONE		(1<<0)		/**< descriptor retired */
+#define DMA_STATUS_ERROR	(1<<1)		/**< AHB error, DMA disabled for the EP */
+
+void USBHwDMAInit		(unsigned long *pdwUDCA);
+void USBHwDMAStart		(unsigned char bEP, TDMADescriptor *pDD, unsigned char *pbBuf, int iLen, unsigned short wMaxPacketSize);
+void USBHwDMAStop		(unsigned char bEP);
+int  USBHwDMAGetLength	(TDMADescriptor *pDD);
+
+/** DMA event handler callback */
+typedef void (TFnDMAHandler)(unsigned char bEP, unsigned char bDMAStatus);
+void USBHwRegisterDMAHandler(TFnDMAHandler *pfnHandler);
+
+
 /*************************************************************************
 	USB application interface
 **************************************************************************/
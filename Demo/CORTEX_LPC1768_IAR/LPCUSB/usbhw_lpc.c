@@ -41,6 +41,10 @@ static TFnDevIntHandler *_pfnDevIntHandler = NULL;
 static TFnEPIntHandler	*_apfnEPIntHandlers[16];
 /** Installed frame interrupt handlers */
 static TFnFrameHandler	*_pfnFrameHandler = NULL;
+/** Installed DMA interrupt handler */
+static TFnDMAHandler	*_pfnDMAHandler = NULL;
+/** DMA descriptor head pointers, one per endpoint index */
+static volatile unsigned long *_pdwUDCA = NULL;
 
 /** convert from endpoint address to endpoint index */
 #define EP2IDX(bEP)	((((bEP)&0xF)<<1)|(((bEP)&0x80)>>7))
@@ -383,6 +387,116 @@ int USBHwEPRead(unsigned char bEP, unsigned char *pbBuf, int iMaxLen)
 }
 
 
+/**
+	Sets up the DMA engine
+
+	@param [in]	pdwUDCA		Table of 32 descriptor pointers, aligned on
+							128 bytes and located in AHB SRAM
+ */
+void USBHwDMAInit(unsigned long *pdwUDCA)
+{
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		pdwUDCA[i] = 0;
+	}
+	_pdwUDCA = pdwUDCA;
+
+	USB->USBEpDMADis = 0xFFFFFFFF;
+	USB->USBDMARClr = 0xFFFFFFFF;
+	USB->USBEoTIntClr = 0xFFFFFFFF;
+	USB->USBNDDRIntClr = 0xFFFFFFFF;
+	USB->USBSysErrIntClr = 0xFFFFFFFF;
+	USB->USBUDCAH = (unsigned long)pdwUDCA;
+}
+
+
+/**
+	Hands one buffer to the DMA engine of an endpoint
+
+	The slave mode interrupt of the endpoint is disabled, as the engine
+	only serves endpoints that do not interrupt the processor. For an OUT
+	endpoint the transfer ends when the buffer is full or a short packet
+	arrives, for an IN endpoint when iLen bytes have been sent as packets
+	of wMaxPacketSize bytes.
+
+	@param [in]	bEP				Endpoint number
+	@param [in]	pDD				Descriptor for this transfer
+	@param [in]	pbBuf			Buffer, in AHB SRAM
+	@param [in]	iLen			Buffer length (OUT) or bytes to send (IN)
+	@param [in]	wMaxPacketSize	Maximum packet size of the endpoint
+ */
+void USBHwDMAStart(unsigned char bEP, TDMADescriptor *pDD, unsigned char *pbBuf, int iLen, unsigned short wMaxPacketSize)
+{
+	int idx = EP2IDX(bEP);
+
+	pDD->dwNext = 0;
+	pDD->dwControl = ((unsigned long)iLen << DD_BUF_LEN_SHIFT) |
+					 ((unsigned long)wMaxPacketSize << DD_MAX_PSIZE_SHIFT);
+	pDD->dwBuffer = (unsigned long)pbBuf;
+	pDD->dwStatus = 0;
+
+	USB->USBEpIntEn &= ~(1 << idx);
+	_pdwUDCA[idx] = (unsigned long)pDD;
+	USB->USBEpDMAEn = (1 << idx);
+}
+
+
+/**
+	Stops DMA on an endpoint
+
+	@param [in]	bEP		Endpoint number
+ */
+void USBHwDMAStop(unsigned char bEP)
+{
+	int idx = EP2IDX(bEP);
+
+	USB->USBEpDMADis = (1 << idx);
+	_pdwUDCA[idx] = 0;
+}
+
+
+/**
+	Gets the result of a retired descriptor
+
+	@param [in]	pDD		Descriptor
+
+	@return the number of bytes transferred, or <0 in case of error.
+ */
+int USBHwDMAGetLength(TDMADescriptor *pDD)
+{
+	unsigned long dwStatus = pDD->dwStatus;
+
+	switch (dwStatus & DD_STATUS_MASK) {
+	case DD_STATUS_NORMAL:
+	case DD_STATUS_UNDERRUN:
+		// an underrun is the normal end of an OUT transfer on a short packet
+		return (int)(dwStatus >> DD_COUNT_SHIFT);
+	default:
+		return -1;
+	}
+}
+
+
+/**
+	Registers the DMA callback
+
+	The callback is called from the USB interrupt each time a descriptor
+	is retired.
+
+	@param [in]	pfnHandler	Callback function
+ */
+void USBHwRegisterDMAHandler(TFnDMAHandler *pfnHandler)
+{
+	_pfnDMAHandler = pfnHandler;
+
+	// end of transfer and system error interrupts
+	USB->USBDMAIntEn = DMA_EOT | DMA_ERR;
+
+	DBG("Registered handler for DMA\n");
+}
+
+
 /**
 	Sets the 'configured' state.
 
@@ -409,6 +523,7 @@ void USBHwISR(void)
 {
 	unsigned long	dwStatus;
 	unsigned long dwIntBit;
+	unsigned long	dwEoT, dwErr;
 	unsigned char	bEPStat, bDevStat, bStat;
 	int i;
 	unsigned short	wFrame;
@@ -472,6 +587,25 @@ void USBHwISR(void)
 			}
 		}
 	}
+
+	// DMA interrupt
+	if (SC->USBIntSt & USB_INT_REQ_DMA) {
+		dwEoT = USB->USBEoTIntSt;
+		USB->USBEoTIntClr = dwEoT;
+		dwErr = USB->USBSysErrIntSt;
+		USB->USBSysErrIntClr = dwErr;
+		// endpoints 0x00 and 0x80 are never served by DMA
+		for (i = 2; i < 32; i++) {
+			dwIntBit = (1 << i);
+			if ((dwEoT | dwErr) & dwIntBit) {
+				bStat = ((dwEoT & dwIntBit) ? DMA_STATUS_DONE : 0) |
+						((dwErr & dwIntBit) ? DMA_STATUS_ERROR : 0);
+				if (_pfnDMAHandler != NULL) {
+					_pfnDMAHandler(IDX2EP(i), bStat);
+				}
+			}
+		}
+	}
 }
 
 
@@ -140,6 +140,25 @@
 #define BTSTF						(1<<6)
 #define TGL_ERR						(1<<7)
 
+/* DMA interrupt enable bits */
+#define DMA_EOT						(1<<0)
+#define DMA_NDDR					(1<<1)
+#define DMA_ERR						(1<<2)
+
+/* DMA descriptor control word */
+#define DD_NEXT_VALID				(1<<2)
+#define DD_MAX_PSIZE_SHIFT			5
+#define DD_BUF_LEN_SHIFT			16
+
+/* DMA descriptor status word */
+#define DD_RETIRED					(1<<0)
+#define DD_STATUS_MASK				(0xF<<1)
+#define DD_STATUS_NORMAL			(0x2<<1)
+#define DD_STATUS_UNDERRUN			(0x3<<1)
+#define DD_STATUS_OVERRUN			(0x8<<1)
+#define DD_STATUS_SYSERR			(0x9<<1)
+#define DD_COUNT_SHIFT				16
+
 
 
 
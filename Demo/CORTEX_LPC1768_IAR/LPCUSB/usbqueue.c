@@ -0,0 +1,324 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Zero copy endpoint queues for the LPC176x USB controller - see usbqueue.h.
+ *
+ * The slots of a ring are used in order.  At any time the slots from
+ * ucDMASlot on (ucDMACount of them) belong to the DMA engine, of which only
+ * the first is being transferred; the slots after them are either ready for
+ * the task (counted by xReady) or held by the task, which returns them from
+ * ucPutSlot on.  An OUT ring starts with every slot given to the engine, an
+ * IN ring with every slot ready for the task.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "usbapi.h"
+#include "usbqueue.h"
+
+/* The DMA engine cannot reach the local SRAM, so the USB DMA memory is
+placed in the second 16K block of AHB SRAM.  The first block is used by the
+Ethernet driver. */
+#define usbqDMA_RAM_BASE			0x20080000UL
+#define usbqDMA_RAM_SIZE			0x4000UL
+
+#define usbqUDCA_ENTRIES			32
+
+#if ( ( usbqUDCA_ENTRIES * 4 ) + ( usbqMAX_QUEUES * usbqBUFFERS_PER_QUEUE * ( 16 + usbqBUFFER_SIZE ) ) ) > usbqDMA_RAM_SIZE
+	#error The USB queue buffers do not fit in the AHB SRAM block.
+#endif
+
+#if ( usbqBUFFER_SIZE % 4 ) != 0
+	#error usbqBUFFER_SIZE must be a multiple of 4.
+#endif
+
+#define usbqIS_IN( ucEP )			( ( ( ucEP ) & 0x80 ) != 0 )
+#define usbqNEXT_SLOT( ucSlot )		( ( unsigned char ) ( ( ( ucSlot ) + 1 ) % usbqBUFFERS_PER_QUEUE ) )
+
+/* The memory the DMA engine reads and writes.  The descriptor table has to
+be aligned on 128 bytes, so comes first. */
+typedef struct xUSB_DMA_MEMORY
+{
+	unsigned long ulUDCA[ usbqUDCA_ENTRIES ];
+	TDMADescriptor xDescriptors[ usbqMAX_QUEUES ][ usbqBUFFERS_PER_QUEUE ];
+	unsigned long ulBuffers[ usbqMAX_QUEUES ][ usbqBUFFERS_PER_QUEUE ][ usbqBUFFER_SIZE / sizeof( unsigned long ) ];
+} xUSBDMAMemory;
+
+#define usbqDMA_MEMORY				( ( xUSBDMAMemory * ) usbqDMA_RAM_BASE )
+
+typedef struct xUSB_QUEUE
+{
+	unsigned char ucEP;
+	unsigned short usMaxPacketSize;
+	unsigned short usBufferSize;
+	TDMADescriptor *pxDescriptors;					/* The descriptor of each slot. */
+	unsigned char *pucBuffers[ usbqBUFFERS_PER_QUEUE ];
+	volatile unsigned short usLength[ usbqBUFFERS_PER_QUEUE ];	/* Bytes received or to send. */
+	volatile unsigned char ucDMASlot;				/* First slot owned by the DMA engine. */
+	volatile unsigned char ucDMACount;				/* Number of slots owned by the DMA engine. */
+	unsigned char ucGetSlot;						/* Next slot handed to the task. */
+	unsigned char ucPutSlot;						/* Oldest slot held by the task. */
+	xSemaphoreHandle xReady;						/* Counts the slots ready for the task. */
+} xUSBQueue;
+
+static xUSBQueue xQueues[ usbqMAX_QUEUES ];
+static unsigned portBASE_TYPE uxQueuesCreated = 0;
+
+/*
+ * Hand slot ucSlot of pxQueue to the DMA engine.  Called with the USB
+ * interrupt masked.
+ */
+static void prvStartSlot( xUSBQueue *pxQueue, unsigned char ucSlot );
+
+/*
+ * Called from the USB interrupt when a descriptor has been retired.
+ */
+static void prvDMAHandler( unsigned char ucEP, unsigned char ucDMAStatus );
+
+/*-----------------------------------------------------------*/
+
+xUSBQueueHandle xUSBQueueCreate( unsigned char ucEP, unsigned short usMaxPacketSize, unsigned short usBufferSize )
+{
+xUSBQueue *pxQueue;
+unsigned portBASE_TYPE uxSlot, uxReady;
+
+	if( ( uxQueuesCreated >= usbqMAX_QUEUES ) || ( usBufferSize > usbqBUFFER_SIZE ) || ( usBufferSize < usMaxPacketSize ) )
+	{
+		return NULL;
+	}
+
+	if( uxQueuesCreated == 0 )
+	{
+		USBHwDMAInit( usbqDMA_MEMORY->ulUDCA );
+		USBHwRegisterDMAHandler( prvDMAHandler );
+	}
+
+	/* An IN ring starts with every buffer ready to be filled, an OUT ring
+	with none ready as they are all waiting to be received into. */
+	uxReady = usbqIS_IN( ucEP ) ? usbqBUFFERS_PER_QUEUE : 0;
+
+	pxQueue = &( xQueues[ uxQueuesCreated ] );
+	pxQueue->xReady = xSemaphoreCreateCounting( usbqBUFFERS_PER_QUEUE, uxReady );
+	if( pxQueue->xReady == NULL )
+	{
+		return NULL;
+	}
+
+	pxQueue->ucEP = ucEP;
+	pxQueue->usMaxPacketSize = usMaxPacketSize;
+	pxQueue->usBufferSize = usBufferSize;
+	pxQueue->pxDescriptors = usbqDMA_MEMORY->xDescriptors[ uxQueuesCreated ];
+	for( uxSlot = 0; uxSlot < usbqBUFFERS_PER_QUEUE; uxSlot++ )
+	{
+		pxQueue->pucBuffers[ uxSlot ] = ( unsigned char * ) usbqDMA_MEMORY->ulBuffers[ uxQueuesCreated ][ uxSlot ];
+		pxQueue->usLength[ uxSlot ] = 0;
+	}
+	pxQueue->ucDMASlot = 0;
+	pxQueue->ucGetSlot = 0;
+	pxQueue->ucPutSlot = 0;
+
+	taskENTER_CRITICAL();
+	{
+		if( usbqIS_IN( ucEP ) )
+		{
+			pxQueue->ucDMACount = 0;
+		}
+		else
+		{
+			pxQueue->ucDMACount = usbqBUFFERS_PER_QUEUE;
+			prvStartSlot( pxQueue, 0 );
+		}
+
+		uxQueuesCreated++;
+	}
+	taskEXIT_CRITICAL();
+
+	return ( xUSBQueueHandle ) pxQueue;
+}
+/*-----------------------------------------------------------*/
+
+unsigned char *pucUSBQueueGet( xUSBQueueHandle xQueue, unsigned short *pusLength, portTickType xTicksToWait )
+{
+xUSBQueue *pxQueue = ( xUSBQueue * ) xQueue;
+unsigned char ucSlot;
+
+	if( xSemaphoreTake( pxQueue->xReady, xTicksToWait ) != pdPASS )
+	{
+		return NULL;
+	}
+
+	ucSlot = pxQueue->ucGetSlot;
+	pxQueue->ucGetSlot = usbqNEXT_SLOT( ucSlot );
+
+	if( usbqIS_IN( pxQueue->ucEP ) )
+	{
+		*pusLength = pxQueue->usBufferSize;
+	}
+	else
+	{
+		*pusLength = pxQueue->usLength[ ucSlot ];
+	}
+
+	return pxQueue->pucBuffers[ ucSlot ];
+}
+/*-----------------------------------------------------------*/
+
+void vUSBQueuePut( xUSBQueueHandle xQueue, unsigned short usLength )
+{
+xUSBQueue *pxQueue = ( xUSBQueue * ) xQueue;
+unsigned char ucSlot;
+
+	ucSlot = pxQueue->ucPutSlot;
+	pxQueue->ucPutSlot = usbqNEXT_SLOT( ucSlot );
+
+	if( usbqIS_IN( pxQueue->ucEP ) )
+	{
+		configASSERT( ( usLength > 0 ) && ( usLength <= pxQueue->usBufferSize ) );
+		pxQueue->usLength[ ucSlot ] = usLength;
+	}
+
+	/* The slot directly follows those the engine already owns.  If the
+	engine was idle it is started on this slot, otherwise the interrupt will
+	start it on this slot when it gets to it. */
+	taskENTER_CRITICAL();
+	{
+		pxQueue->ucDMACount++;
+		if( pxQueue->ucDMACount == 1 )
+		{
+			prvStartSlot( pxQueue, ucSlot );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartSlot( xUSBQueue *pxQueue, unsigned char ucSlot )
+{
+int iLength;
+
+	if( usbqIS_IN( pxQueue->ucEP ) )
+	{
+		iLength = pxQueue->usLength[ ucSlot ];
+	}
+	else
+	{
+		iLength = pxQueue->usBufferSize;
+	}
+
+	USBHwDMAStart( pxQueue->ucEP, &( pxQueue->pxDescriptors[ ucSlot ] ), pxQueue->pucBuffers[ ucSlot ], iLength, pxQueue->usMaxPacketSize );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDMAHandler( unsigned char ucEP, unsigned char ucDMAStatus )
+{
+xUSBQueue *pxQueue = NULL;
+unsigned portBASE_TYPE ux;
+unsigned char ucSlot;
+int iLength;
+long lHigherPriorityTaskWoken = pdFALSE;
+
+	for( ux = 0; ux < uxQueuesCreated; ux++ )
+	{
+		if( xQueues[ ux ].ucEP == ucEP )
+		{
+			pxQueue = &( xQueues[ ux ] );
+			break;
+		}
+	}
+
+	if( ( pxQueue == NULL ) || ( pxQueue->ucDMACount == 0 ) )
+	{
+		return;
+	}
+
+	ucSlot = pxQueue->ucDMASlot;
+
+	/* On an AHB error the engine has disabled DMA for the endpoint and the
+	transfer is abandoned.  It is started again below on the next slot. */
+	if( ( ucDMAStatus & DMA_STATUS_ERROR ) != 0 )
+	{
+		iLength = -1;
+	}
+	else
+	{
+		iLength = USBHwDMAGetLength( &( pxQueue->pxDescriptors[ ucSlot ] ) );
+	}
+
+	if( !usbqIS_IN( pxQueue->ucEP ) )
+	{
+		pxQueue->usLength[ ucSlot ] = ( iLength < 0 ) ? 0 : ( unsigned short ) iLength;
+	}
+
+	/* The slot goes to the task, and the engine moves on to the next slot
+	if it owns one. */
+	ucSlot = usbqNEXT_SLOT( ucSlot );
+	pxQueue->ucDMASlot = ucSlot;
+	pxQueue->ucDMACount--;
+	if( pxQueue->ucDMACount > 0 )
+	{
+		prvStartSlot( pxQueue, ucSlot );
+	}
+	else
+	{
+		USBHwDMAStop( pxQueue->ucEP );
+	}
+
+	xSemaphoreGiveFromISR( pxQueue->xReady, &lHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( lHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,129 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Zero copy endpoint queues for the LPC176x USB controller.
+ *
+ * Each queue serves one bulk endpoint through a ring of
+ * usbqBUFFERS_PER_QUEUE buffers in AHB SRAM.  Every buffer has its own DMA
+ * descriptor, so the DMA engine moves a whole buffer - many packets - between
+ * the endpoint and memory without the processor.  The USB interrupt only
+ * retires the descriptor, starts the next one and gives a semaphore; the
+ * data itself is handled by tasks, which are given pointers into the ring and
+ * never copy through the stack.
+ *
+ * The same two calls serve both directions:
+ *
+ * OUT endpoint: pucUSBQueueGet() returns the oldest filled buffer and its
+ * length.  vUSBQueuePut() hands it back to the DMA engine to be filled again.
+ *
+ * IN endpoint: pucUSBQueueGet() returns an empty buffer and its size.
+ * vUSBQueuePut() queues it to be sent with the given length, which must not
+ * be zero.
+ *
+ * Several buffers can be held at once; they go back with vUSBQueuePut() in
+ * the order they were obtained.  A queue is used by one task.
+ *
+ * An OUT transfer only completes when its buffer is full or a short packet
+ * arrives.  Where the host does not end its transfers with a short packet,
+ * as with a CDC serial port, give the queue a buffer size of one packet.  An
+ * IN buffer whose length is a multiple of the packet size is not followed by
+ * a zero length packet.
+ */
+
+#ifndef USBQUEUE_H
+#define USBQUEUE_H
+
+/* Largest buffer size, in bytes, and the number of buffers in each ring.
+Four 1024 byte buffers keep a bulk-IN endpoint sending for several
+milliseconds while the producing task fills the next one. */
+#ifndef usbqBUFFER_SIZE
+	#define usbqBUFFER_SIZE			1024
+#endif
+
+#ifndef usbqBUFFERS_PER_QUEUE
+	#define usbqBUFFERS_PER_QUEUE	4
+#endif
+
+/* Number of queues that can be created. */
+#ifndef usbqMAX_QUEUES
+	#define usbqMAX_QUEUES			2
+#endif
+
+typedef void * xUSBQueueHandle;
+
+/*
+ * Create the queue for endpoint ucEP (0x80 set for IN) with its packet size
+ * and the size of its buffers, up to usbqBUFFER_SIZE.  An OUT queue is ready
+ * to receive at once.  Create the queues before connecting to the bus, and do
+ * not register an endpoint interrupt handler for the endpoint.  Returns NULL
+ * if usbqMAX_QUEUES queues already exist.
+ */
+xUSBQueueHandle xUSBQueueCreate( unsigned char ucEP, unsigned short usMaxPacketSize, unsigned short usBufferSize );
+
+/*
+ * Take the next buffer from the queue, waiting up to xTicksToWait.  On
+ * return *pusLength holds the number of bytes received (OUT) or the buffer
+ * size (IN).  A failed OUT transfer is returned with a length of 0.  Returns
+ * NULL on timeout.
+ */
+unsigned char *pucUSBQueueGet( xUSBQueueHandle xQueue, unsigned short *pusLength, portTickType xTicksToWait );
+
+/*
+ * Return the oldest buffer taken with pucUSBQueueGet() to the DMA engine,
+ * to be received into again (OUT) or sent with usLength bytes (IN).
+ */
+void vUSBQueuePut( xUSBQueueHandle xQueue, unsigned short usLength );
+
+#endif /* USBQUEUE_H */
+
@@ -94,6 +94,10 @@
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
 
+/* Uncomment to run the context switch, tick and queue code from SRAM rather
+than flash.  config/stm32f4xx_flash.icf copies the section into SRAM. */
+/* #define configKERNEL_FAST_CODE_SECTION	".kernel_fast" */
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
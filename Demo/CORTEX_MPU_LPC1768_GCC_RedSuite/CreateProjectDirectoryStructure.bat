@@ -31,4 +31,9 @@ IF EXIST src\FreeRTOS Goto END
 	REM Copy the basic memory allocation files
 	copy ..\..\Source\portable\MemMang\heap_2.c src\FreeRTOS\portable\MemMang
 
+	REM Copy the benchmark tasks, used to compare the cost of the MPU port
+	REM with the standard ARM_CM3 port.
+	copy ..\Common\minimal\Benchmark.c src
+	copy ..\Common\include\Benchmark.h src
+
 : END
\ No newline at end of file
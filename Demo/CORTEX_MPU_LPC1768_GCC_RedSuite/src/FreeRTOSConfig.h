@@ -100,7 +100,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskCleanUpResources		0
 #define INCLUDE_vTaskSuspend				0
 #define INCLUDE_vTaskDelayUntil				0
-#define INCLUDE_vTaskDelay					0
+#define INCLUDE_vTaskDelay					1
 #define INCLUDE_uxTaskGetStackHighWaterMark	0
 
 /* Use the system definition, if there is one */
@@ -115,6 +115,11 @@ to exclude the API function. */
 /* Priority 5, or 160 as only the top three bits are implemented. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY 	( 5 << (8 - configPRIO_BITS) )
 
+/* Time base used by the benchmark tasks when they are included in the demo.
+The cycle counter gives figures in CPU cycles that can be compared directly
+between the CORTEX_LPC1768_GCC_RedSuite (ARM_CM3 port) and
+CORTEX_MPU_LPC1768_GCC_RedSuite (ARM_CM3_MPU port) demos. */
+#define benchGET_TIME( x )	( x ) = *( ( volatile unsigned long * ) 0xe0001004 )
 
 
 #endif /* FREERTOS_CONFIG_H */
@@ -75,6 +75,7 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "Benchmark.h"
 
 /* Red Suite includes. */
 #include "lcd_driver.h"
@@ -94,6 +95,20 @@
 /* GCC specifics. */
 #define mainALIGN_TO( x )				__attribute__((aligned(x)))
 
+/* Set to 1 to include the benchmark tasks, which time the kernel in CPU
+cycles so the figures can be compared with those from the
+CORTEX_LPC1768_GCC_RedSuite demo, which uses the ARM_CM3 port without the MPU.
+The tasks are privileged as they read the cycle counter.  The table of results
+is written by vBenchmarkGetResults(). */
+#define mainINCLUDE_BENCHMARK			0
+#define mainBENCHMARK_PRIORITY			( ( tskIDLE_PRIORITY + 1 ) | portPRIVILEGE_BIT )
+
+/* Cortex-M3 debug registers used to start the cycle counter. */
+#define mainDEMCR						( *( ( volatile unsigned long * ) 0xe000edfc ) )
+#define mainDEMCR_TRCENA				( 1UL << 24UL )
+#define mainDWT_CTRL					( *( ( volatile unsigned long * ) 0xe0001000 ) )
+#define mainDWT_CTRL_CYCCNTENA			( 1UL )
+
 /* Hardware specifics.  The start and end address are chosen to ensure the
 required GPIO are covered while also ensuring the necessary alignment is
 achieved. */
@@ -360,6 +375,15 @@ int main( void )
 					NULL							/* Handle. */
 				);
 
+	#if mainINCLUDE_BENCHMARK == 1
+	{
+		/* The benchmark tasks use the cycle counter as their time base. */
+		mainDEMCR |= mainDEMCR_TRCENA;
+		mainDWT_CTRL |= mainDWT_CTRL_CYCCNTENA;
+		vStartBenchmarkTasks( mainBENCHMARK_PRIORITY );
+	}
+	#endif
+
 	/* Start the scheduler. */
 	vTaskStartScheduler();
 
@@ -0,0 +1,283 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+	TIMER TRIGGERED ADC SAMPLING INTO PING-PONG DMA BUFFERS - see ADCSampler.h.
+
+	Block n of the sampling run is held in half ( n & 1 ) of the DMA buffer.
+	Its data stays valid until block n + 2 starts to be written, which is as
+	soon as block n + 1 is full.  So block n can be used only while
+	ulBlocksFilled is n + 1; the task compares the two to detect overruns.
+*/
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Library includes. */
+#include "stm32f10x_lib.h"
+#include "stm32f10x_tim.h"
+
+/* Demo application includes. */
+#include "ADCSampler.h"
+/*-----------------------------------------------------------*/
+
+#define adcNO_BLOCK_HELD		( ( unsigned portLONG ) 0xffffffffUL )
+
+/* The DMA buffer - both blocks back to back. */
+static volatile unsigned portSHORT usSamples[ 2 * adcBLOCK_SAMPLES ];
+
+/* The number of blocks the DMA has filled, and the tick count at which each
+half of the buffer was last filled.  Written by the DMA interrupt. */
+static volatile unsigned portLONG ulBlocksFilled = 0;
+static volatile portTickType xHalfTimeStamps[ 2 ];
+
+/* The task notified as each block fills. */
+static xTaskHandle xProcessingTask = NULL;
+
+/* Accessed by the processing task only. */
+static unsigned portLONG ulNextBlock = 0;
+static unsigned portLONG ulHeldBlock = adcNO_BLOCK_HELD;
+static unsigned portLONG ulOverruns = 0;
+
+/*-----------------------------------------------------------*/
+
+void vADCSamplerStart( unsigned portLONG ulSampleRate, unsigned portCHAR ucChannel )
+{
+ADC_InitTypeDef ADC_InitStructure;
+DMA_InitTypeDef DMA_InitStructure;
+TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+TIM_OCInitTypeDef TIM_OCInitStructure;
+NVIC_InitTypeDef NVIC_InitStructure;
+unsigned portLONG ulPrescaler, ulPeriod;
+
+	xProcessingTask = xTaskGetCurrentTaskHandle();
+
+	RCC_AHBPeriphClockCmd( RCC_AHBPeriph_DMA, ENABLE );
+	RCC_APB2PeriphClockCmd( RCC_APB2Periph_ADC1, ENABLE );
+	RCC_APB1PeriphClockCmd( RCC_APB1Periph_TIM4, ENABLE );
+
+	/* 72MHz / 6 gives the maximum ADC clock of 12MHz.  Each conversion then
+	takes ( 28.5 + 12.5 ) / 12MHz = 3.4us. */
+	RCC_ADCCLKConfig( RCC_PCLK2_Div6 );
+
+	/* DMA channel 1 is the ADC1 channel.  It runs forever in circular mode
+	over both blocks, interrupting as each becomes full. */
+	DMA_DeInit( DMA_Channel1 );
+	DMA_InitStructure.DMA_PeripheralBaseAddr = ( u32 ) &( ADC1->DR );
+	DMA_InitStructure.DMA_MemoryBaseAddr = ( u32 ) usSamples;
+	DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+	DMA_InitStructure.DMA_BufferSize = 2 * adcBLOCK_SAMPLES;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+	DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+	DMA_Init( DMA_Channel1, &DMA_InitStructure );
+	DMA_ITConfig( DMA_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE );
+	DMA_Cmd( DMA_Channel1, ENABLE );
+
+	NVIC_InitStructure.NVIC_IRQChannel = DMAChannel1_IRQChannel;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init( &NVIC_InitStructure );
+
+	/* One channel, one conversion per trigger. */
+	ADC_DeInit( ADC1 );
+	ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
+	ADC_InitStructure.ADC_ScanConvMode = DISABLE;
+	ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
+	ADC_InitStructure.ADC_ExternalTrigConv = ADC_ExternalTrigConv_T4_CC4;
+	ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
+	ADC_InitStructure.ADC_NbrOfChannel = 1;
+	ADC_Init( ADC1, &ADC_InitStructure );
+	ADC_RegularChannelConfig( ADC1, ucChannel, 1, ADC_SampleTime_28Cycles5 );
+	ADC_DMACmd( ADC1, ENABLE );
+	ADC_Cmd( ADC1, ENABLE );
+
+	ADC_ResetCalibration( ADC1 );
+	while( ADC_GetResetCalibrationStatus( ADC1 ) )
+	{
+	}
+
+	ADC_StartCalibration( ADC1 );
+	while( ADC_GetCalibrationStatus( ADC1 ) )
+	{
+	}
+
+	ADC_ExternalTrigConvCmd( ADC1, ENABLE );
+
+	/* TIM4 is clocked at the CPU frequency.  Use the smallest prescaler that
+	lets the period fit in 16 bits. */
+	ulPeriod = configCPU_CLOCK_HZ / ulSampleRate;
+	ulPrescaler = ( ulPeriod - 1UL ) / 0x10000UL;
+	ulPeriod /= ( ulPrescaler + 1UL );
+
+	TIM_DeInit( TIM4 );
+	TIM_TimeBaseStructInit( &TIM_TimeBaseStructure );
+	TIM_TimeBaseStructure.TIM_Period = ( unsigned portSHORT ) ( ulPeriod - 1UL );
+	TIM_TimeBaseStructure.TIM_Prescaler = ( unsigned portSHORT ) ulPrescaler;
+	TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseInit( TIM4, &TIM_TimeBaseStructure );
+
+	/* Each compare match on channel 4 starts one conversion. */
+	TIM_OCStructInit( &TIM_OCInitStructure );
+	TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_PWM1;
+	TIM_OCInitStructure.TIM_Channel = TIM_Channel_4;
+	TIM_OCInitStructure.TIM_Pulse = ( unsigned portSHORT ) ( ulPeriod / 2UL );
+	TIM_OCInitStructure.TIM_OCPolarity = TIM_OCPolarity_High;
+	TIM_OCInit( TIM4, &TIM_OCInitStructure );
+
+	TIM_Cmd( TIM4, ENABLE );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xADCSamplerGetBlock( xADCBlock *pxBlock, portTickType xTicksToWait )
+{
+unsigned portLONG ulNewest, ulHalf;
+
+	/* Blocks that fill while the task is busy leave the notification count
+	above one.  Clear it - only the newest block is still intact. */
+	if( ulTaskNotifyTake( pdTRUE, xTicksToWait ) == 0UL )
+	{
+		return pdFAIL;
+	}
+
+	/* The interrupt cannot change the time stamp of the newest block until
+	another block has filled, which would have to be well after this. */
+	taskENTER_CRITICAL();
+	{
+		ulNewest = ulBlocksFilled - 1UL;
+		ulHalf = ulNewest & 1UL;
+		pxBlock->xTimeStamp = xHalfTimeStamps[ ulHalf ];
+	}
+	taskEXIT_CRITICAL();
+
+	pxBlock->pusSamples = ( const unsigned portSHORT * ) &( usSamples[ ulHalf * adcBLOCK_SAMPLES ] );
+	pxBlock->ulSequence = ulNewest;
+
+	if( ulNewest != ulNextBlock )
+	{
+		pxBlock->xOverrun = pdTRUE;
+		ulOverruns += ulNewest - ulNextBlock;
+	}
+	else
+	{
+		pxBlock->xOverrun = pdFALSE;
+	}
+
+	ulHeldBlock = ulNewest;
+	ulNextBlock = ulNewest + 1UL;
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xADCSamplerReleaseBlock( void )
+{
+portBASE_TYPE xReturn = pdPASS;
+
+	/* Once the block after the held one is full, the DMA is writing over the
+	held block. */
+	if( ( ulHeldBlock != adcNO_BLOCK_HELD ) && ( ( ulBlocksFilled - ulHeldBlock ) > 1UL ) )
+	{
+		ulOverruns++;
+		xReturn = pdFAIL;
+	}
+
+	ulHeldBlock = adcNO_BLOCK_HELD;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portLONG ulADCSamplerOverruns( void )
+{
+	return ulOverruns;
+}
+/*-----------------------------------------------------------*/
+
+void vADCDMAInterruptHandler( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+portTickType xNow;
+
+	xNow = xTaskGetTickCountFromISR();
+
+	/* If the interrupt was held off for a whole block both flags can be set.
+	The first half completes first. */
+	if( DMA_GetITStatus( DMA_IT_HT1 ) != RESET )
+	{
+		DMA_ClearITPendingBit( DMA_IT_HT1 );
+		xHalfTimeStamps[ 0 ] = xNow;
+		ulBlocksFilled++;
+		vTaskNotifyGiveFromISR( xProcessingTask, &xHigherPriorityTaskWoken );
+	}
+
+	if( DMA_GetITStatus( DMA_IT_TC1 ) != RESET )
+	{
+		DMA_ClearITPendingBit( DMA_IT_TC1 );
+		xHalfTimeStamps[ 1 ] = xNow;
+		ulBlocksFilled++;
+		vTaskNotifyGiveFromISR( xProcessingTask, &xHigherPriorityTaskWoken );
+	}
+
+	DMA_ClearITPendingBit( DMA_IT_GL1 );
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,122 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+	TIMER TRIGGERED ADC SAMPLING INTO PING-PONG DMA BUFFERS.
+
+	TIM4 compare channel 4 triggers a conversion of a single ADC1 channel at
+	the requested rate.  DMA channel 1 moves each result into one circular
+	buffer of two blocks of adcBLOCK_SAMPLES samples.  The half transfer and
+	transfer complete interrupts each mark one block as full and notify the
+	processing task, so there is one interrupt per block rather than one per
+	sample, and the samples are read in place rather than copied.
+
+	While the task works on one block the DMA fills the other, so a block
+	has to be released before the next one is full.  A task that falls
+	further behind loses blocks: xADCSamplerGetBlock() always returns the
+	newest full block and sets xOverrun when blocks were skipped, and
+	xADCSamplerReleaseBlock() returns pdFAIL if the DMA started overwriting
+	the block while it was held.
+
+	vADCDMAInterruptHandler() must be installed as the DMA channel 1 handler
+	in stm32f10x_vector.c.
+*/
+
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+/* Samples in each of the two blocks.  At 100 kSa/s a block of 256 samples
+is full every 2.56ms. */
+#ifndef adcBLOCK_SAMPLES
+	#define adcBLOCK_SAMPLES		256
+#endif
+
+typedef struct ADC_BLOCK
+{
+	const unsigned portSHORT *pusSamples;	/* adcBLOCK_SAMPLES right aligned 12 bit results. */
+	unsigned portLONG ulSequence;			/* Blocks filled before this one, so the first sample is sample number ulSequence * adcBLOCK_SAMPLES. */
+	portTickType xTimeStamp;				/* Tick count when the last sample of the block was transferred. */
+	portBASE_TYPE xOverrun;					/* pdTRUE if blocks were lost between the previous block and this one. */
+} xADCBlock;
+
+/*
+ * Start sampling ADC1 channel ucChannel (0 to 15) ulSampleRate times a
+ * second.  The calling task becomes the processing task - it is the task
+ * notified as each block fills, and the only one that can call the other
+ * functions.  It must not use its task notification for anything else.  The
+ * pin is not configured here.
+ */
+void vADCSamplerStart( unsigned portLONG ulSampleRate, unsigned portCHAR ucChannel );
+
+/*
+ * Wait up to xTicksToWait for a full block.  Returns pdFAIL on timeout.  A
+ * block obtained must be handed back with xADCSamplerReleaseBlock() before
+ * the next is taken.
+ */
+portBASE_TYPE xADCSamplerGetBlock( xADCBlock *pxBlock, portTickType xTicksToWait );
+
+/*
+ * Release the block obtained by xADCSamplerGetBlock().  Returns pdFAIL if
+ * the block was being overwritten before it was released, in which case
+ * its later samples may be from the next pass of the buffer.
+ */
+portBASE_TYPE xADCSamplerReleaseBlock( void );
+
+/*
+ * The number of blocks lost or overwritten since sampling started.
+ */
+unsigned portLONG ulADCSamplerOverruns( void );
+
+void vADCDMAInterruptHandler( void );
+
+#endif /* ADC_SAMPLER_H */
@@ -106,5 +106,9 @@ configKERNEL_INTERRUPT_PRIORITY setting.  Here 15 corresponds to the lowest
 NVIC value of 255. */
 #define configLIBRARY_KERNEL_INTERRUPT_PRIORITY	15
 
+/* The serial driver moves data by DMA and provides usSerialWrite() and
+usSerialRead(), which the comtest tasks then use. */
+#define serUSE_BLOCK_TRANSFERS		1
+
 #endif /* FREERTOS_CONFIG_H */
 
@@ -52,13 +52,33 @@
 */
 
 /*
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0.
+	DMA DRIVEN SERIAL PORT DRIVER FOR USART1.
+
+	Characters to transmit are held in a stream buffer.  Whenever the
+	transmit DMA channel (DMA channel 4) is idle the next block of up to
+	serTX_DMA_BLOCK_SIZE characters is taken from the stream buffer and sent
+	by DMA, so there is one interrupt per block rather than one per character.
+
+	The receive DMA channel (DMA channel 5) runs continuously in circular mode
+	into a small buffer.  The half transfer, transfer complete and USART idle
+	line interrupts each copy whatever has arrived since the last copy into the
+	receive stream buffer, so a burst of characters is passed on in one
+	operation and the tail of a burst is not held back waiting for the DMA
+	buffer to fill.
+
+	If serUSE_RX_FRAMES is set to 1 the received data is instead left in the
+	DMA buffer and the idle line interrupt marks the end of a frame, so a
+	task blocked in xSerialGetFrame() wakes once per frame and reads the frame
+	in place.  The USART goes idle after one character time without a start
+	bit, which also catches the 1.5 character inter-character limit of Modbus
+	RTU.  xSerialGetChar() and usSerialRead() are not available in this mode.
 */
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 #include "queue.h"
-#include "semphr.h"
+#include "stream_buffer.h"
 
 /* Library includes. */
 #include "stm32f10x_lib.h"
@@ -68,20 +88,120 @@
 /*-----------------------------------------------------------*/
 
 /* Misc defines. */
-#define serINVALID_QUEUE				( ( xQueueHandle ) 0 )
+#define serINVALID_STREAM				( ( xStreamBufferHandle ) 0 )
 #define serNO_BLOCK						( ( portTickType ) 0 )
 #define serTX_BLOCK_TIME				( 40 / portTICK_RATE_MS )
 
+/* Wake a blocked reader as soon as a single character is available. */
+#define serTRIGGER_LEVEL				( 1 )
+
+#ifndef serUSE_RX_FRAMES
+	#define serUSE_RX_FRAMES			0
+#endif
+
+/* The largest block sent by one DMA transfer, and the size of the circular
+buffer the receive DMA channel writes to.  At 921600 baud a character takes
+about 11us, so the receive buffer is emptied every 32 characters at most.  In
+frame mode the buffer holds the frames until they have been read, so must be
+a power of two large enough for at least two frames. */
+#define serTX_DMA_BLOCK_SIZE			( 64 )
+
+#if serUSE_RX_FRAMES == 1
+	#define serRX_DMA_BUFFER_SIZE		( 512 )
+	#define serRX_FRAME_QUEUE_LENGTH	( 8 )
+#else
+	#define serRX_DMA_BUFFER_SIZE		( 64 )
+#endif
+
 /*-----------------------------------------------------------*/
 
-/* The queue used to hold received characters. */
-static xQueueHandle xRxedChars;
-static xQueueHandle xCharsForTx;
+/* The stream buffers used to hold received characters and characters waiting
+to be transmitted.  Strings are copied into the Tx buffer in one operation
+rather than one character at a time. */
+static xStreamBufferHandle xCharsForTx;
+
+#if serUSE_RX_FRAMES == 0
+	static xStreamBufferHandle xRxedChars;
+	#define serRX_CREATED()		( xRxedChars != serINVALID_STREAM )
+#else
+	#define serRX_CREATED()		( xRxFrames != ( xQueueHandle ) 0 )
+#endif
+
+/* The block being transmitted by DMA, and whether a transfer is in progress.
+xTxDMABusy is only accessed with the DMA interrupt masked. */
+static unsigned portCHAR ucTxDMABlock[ serTX_DMA_BLOCK_SIZE ];
+static volatile portBASE_TYPE xTxDMABusy = pdFALSE;
+
+/* The circular buffer written by the receive DMA channel. */
+static unsigned portCHAR ucRxDMABuffer[ serRX_DMA_BUFFER_SIZE ];
+
+#if serUSE_RX_FRAMES == 0
+
+	/* The index of the first character not yet copied to xRxedChars. */
+	static unsigned portBASE_TYPE uxRxDMATail = 0;
+
+#else
+
+	/* A frame posted to xRxFrames by the idle line interrupt.  ulStart counts
+	bytes received since the port was opened, so it also locates the frame in
+	the DMA buffer. */
+	typedef struct SERIAL_FRAME_DESCRIPTOR
+	{
+		unsigned portLONG ulStart;
+		unsigned portSHORT usLength;
+	} xFrameDescriptor;
+
+	static xQueueHandle xRxFrames;
+
+	/* How many times the receive DMA channel has wrapped, and the count at
+	which the frame being received started. */
+	static volatile unsigned portLONG ulRxWraps = 0;
+	static unsigned portLONG ulRxFrameStart = 0;
+
+#endif
 
 /*-----------------------------------------------------------*/
 
-/* UART interrupt handler. */
+/* UART idle line interrupt handler, and the Tx and Rx DMA interrupt handlers. */
 void vUARTInterruptHandler( void );
+void vUARTTxDMAInterruptHandler( void );
+void vUARTRxDMAInterruptHandler( void );
+
+/*
+ * Start a DMA transfer of the next block from xCharsForTx, if there is one.
+ * Must be called with the DMA interrupt masked.
+ */
+static void prvStartNextTxBlock( signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Start transmitting, if the Tx DMA channel is idle.  Called from tasks.
+ */
+static void prvKickTx( void );
+
+#if serUSE_RX_FRAMES == 1
+
+	/*
+	 * The number of bytes received since the port was opened.  Must be called
+	 * with the DMA interrupt masked.
+	 */
+	static unsigned portLONG prvRxCount( void );
+
+	/*
+	 * Post the frame received since the last call to xRxFrames.  Called from
+	 * the UART interrupt.
+	 */
+	static void prvEndRxFrame( signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#else
+
+	/*
+	 * Copy the characters received since the last call into xRxedChars.
+	 * Called from the Rx DMA and UART interrupts, which have the same
+	 * priority.
+	 */
+	static void prvCopyRxDMAData( signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -94,17 +214,25 @@ xComPortHandle xReturn;
 USART_InitTypeDef USART_InitStructure;
 NVIC_InitTypeDef NVIC_InitStructure;
 GPIO_InitTypeDef GPIO_InitStructure;
-
-	/* Create the queues used to hold Rx/Tx characters. */
-	xRxedChars = xQueueCreate( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( signed portCHAR ) );
-	xCharsForTx = xQueueCreate( uxQueueLength + 1, ( unsigned portBASE_TYPE ) sizeof( signed portCHAR ) );
+DMA_InitTypeDef DMA_InitStructure;
+
+	/* Create the stream buffers used to hold Rx/Tx characters.  In frame
+	mode received characters stay in the DMA buffer, and only the location of
+	each frame is queued. */
+	#if serUSE_RX_FRAMES == 1
+		xRxFrames = xQueueCreate( serRX_FRAME_QUEUE_LENGTH, ( unsigned portBASE_TYPE ) sizeof( xFrameDescriptor ) );
+	#else
+		xRxedChars = xStreamBufferCreate( ( size_t ) uxQueueLength, serTRIGGER_LEVEL );
+	#endif
+	xCharsForTx = xStreamBufferCreate( ( size_t ) uxQueueLength + 1, serTRIGGER_LEVEL );
 	
-	/* If the queue/semaphore was created correctly then setup the serial port
+	/* If the stream buffers were created correctly then setup the serial port
 	hardware. */
-	if( ( xRxedChars != serINVALID_QUEUE ) && ( xCharsForTx != serINVALID_QUEUE ) )
+	if( ( serRX_CREATED() ) && ( xCharsForTx != serINVALID_STREAM ) )
 	{
-		/* Enable USART1 clock */
+		/* Enable USART1 and DMA clocks */
 		RCC_APB2PeriphClockCmd( RCC_APB2Periph_USART1 | RCC_APB2Periph_GPIOA, ENABLE );	
+		RCC_AHBPeriphClockCmd( RCC_AHBPeriph_DMA, ENABLE );
 
 		/* Configure USART1 Rx (PA10) as input floating */
 		GPIO_InitStructure.GPIO_Pin = GPIO_Pin_10;
@@ -129,14 +257,54 @@ GPIO_InitTypeDef GPIO_InitStructure;
 		USART_InitStructure.USART_LastBit = USART_LastBit_Disable;
 		
 		USART_Init( USART1, &USART_InitStructure );
-		
-		USART_ITConfig( USART1, USART_IT_RXNE, ENABLE );
+
+		/* Tx DMA channel: memory to USART1 DR, started one block at a time. */
+		DMA_DeInit( DMA_Channel4 );
+		DMA_InitStructure.DMA_PeripheralBaseAddr = ( u32 ) &( USART1->DR );
+		DMA_InitStructure.DMA_MemoryBaseAddr = ( u32 ) ucTxDMABlock;
+		DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+		DMA_InitStructure.DMA_BufferSize = serTX_DMA_BLOCK_SIZE;
+		DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+		DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+		DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+		DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+		DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+		DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+		DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+		DMA_Init( DMA_Channel4, &DMA_InitStructure );
+		DMA_ITConfig( DMA_Channel4, DMA_IT_TC, ENABLE );
+
+		/* Rx DMA channel: USART1 DR to the circular buffer, runs forever. */
+		DMA_DeInit( DMA_Channel5 );
+		DMA_InitStructure.DMA_MemoryBaseAddr = ( u32 ) ucRxDMABuffer;
+		DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+		DMA_InitStructure.DMA_BufferSize = serRX_DMA_BUFFER_SIZE;
+		DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+		DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+		DMA_Init( DMA_Channel5, &DMA_InitStructure );
+
+		#if serUSE_RX_FRAMES == 1
+			/* Only the wrap is needed, to keep count of the bytes received. */
+			DMA_ITConfig( DMA_Channel5, DMA_IT_TC, ENABLE );
+		#else
+			DMA_ITConfig( DMA_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE );
+		#endif
+		DMA_Cmd( DMA_Channel5, ENABLE );
+
+		USART_DMACmd( USART1, USART_DMAReq_Tx | USART_DMAReq_Rx, ENABLE );
+		USART_ITConfig( USART1, USART_IT_IDLE, ENABLE );
 		
 		NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQChannel;
 		NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
 		NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
 		NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
 		NVIC_Init( &NVIC_InitStructure );
+
+		NVIC_InitStructure.NVIC_IRQChannel = DMAChannel4_IRQChannel;
+		NVIC_Init( &NVIC_InitStructure );
+
+		NVIC_InitStructure.NVIC_IRQChannel = DMAChannel5_IRQChannel;
+		NVIC_Init( &NVIC_InitStructure );
 		
 		USART_Cmd( USART1, ENABLE );		
 	}
@@ -151,6 +319,8 @@ GPIO_InitTypeDef GPIO_InitStructure;
 }
 /*-----------------------------------------------------------*/
 
+#if serUSE_RX_FRAMES == 0
+
 signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed portCHAR *pcRxedChar, portTickType xBlockTime )
 {
 	/* The port handle is not required as this driver only supports one port. */
@@ -158,7 +328,7 @@ signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed portCHAR *pcR
 
 	/* Get the next character from the buffer.  Return false if no characters
 	are available, or arrive before xBlockTime expires. */
-	if( xQueueReceive( xRxedChars, pcRxedChar, xBlockTime ) )
+	if( xStreamBufferReceive( xRxedChars, pcRxedChar, sizeof( signed portCHAR ), xBlockTime ) != ( size_t ) 0 )
 	{
 		return pdTRUE;
 	}
@@ -169,27 +339,97 @@ signed portBASE_TYPE xSerialGetChar( xComPortHandle pxPort, signed portCHAR *pcR
 }
 /*-----------------------------------------------------------*/
 
-void vSerialPutString( xComPortHandle pxPort, const signed portCHAR * const pcString, unsigned portSHORT usStringLength )
+unsigned portSHORT usSerialRead( xComPortHandle pxPort, signed portCHAR *pcBuffer, unsigned portSHORT usMaxLength, portTickType xBlockTime )
 {
-signed portCHAR *pxNext;
+	/* The port handle is not required as this driver only supports one port. */
+	( void ) pxPort;
+
+	/* Return whatever has arrived, up to usMaxLength characters, as soon as
+	anything is available. */
+	return ( unsigned portSHORT ) xStreamBufferReceive( xRxedChars, pcBuffer, ( size_t ) usMaxLength, xBlockTime );
+}
+/*-----------------------------------------------------------*/
+
+#else /* serUSE_RX_FRAMES */
+
+portBASE_TYPE xSerialGetFrame( xComPortHandle pxPort, xSerialFrame *pxFrame, portTickType xBlockTime )
+{
+xFrameDescriptor xDescriptor;
+unsigned portBASE_TYPE uxOffset, uxFirst;
+
+	/* The port handle is not required as this driver only supports one port. */
+	( void ) pxPort;
+
+	if( xQueueReceive( xRxFrames, &xDescriptor, xBlockTime ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	/* Point at the frame in the DMA buffer, in two parts if it wraps. */
+	uxOffset = ( unsigned portBASE_TYPE ) ( xDescriptor.ulStart & ( serRX_DMA_BUFFER_SIZE - 1UL ) );
+	uxFirst = serRX_DMA_BUFFER_SIZE - uxOffset;
+	if( uxFirst > xDescriptor.usLength )
+	{
+		uxFirst = xDescriptor.usLength;
+	}
+
+	pxFrame->pucData[ 0 ] = &( ucRxDMABuffer[ uxOffset ] );
+	pxFrame->usLength[ 0 ] = ( unsigned portSHORT ) uxFirst;
+	pxFrame->pucData[ 1 ] = ucRxDMABuffer;
+	pxFrame->usLength[ 1 ] = ( unsigned portSHORT ) ( xDescriptor.usLength - uxFirst );
+	pxFrame->ulEnd = xDescriptor.ulStart + xDescriptor.usLength;
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
 
-	/* A couple of parameters that this port does not use. */
-	( void ) usStringLength;
+portBASE_TYPE xSerialFrameIsIntact( xComPortHandle pxPort, const xSerialFrame *pxFrame )
+{
+unsigned portLONG ulStart, ulReceived;
+
+	/* The port handle is not required as this driver only supports one port. */
 	( void ) pxPort;
 
-	/* NOTE: This implementation does not handle the queue being full as no
+	ulStart = pxFrame->ulEnd - ( unsigned portLONG ) ( pxFrame->usLength[ 0 ] + pxFrame->usLength[ 1 ] );
+
+	taskENTER_CRITICAL();
+	{
+		ulReceived = prvRxCount();
+	}
+	taskEXIT_CRITICAL();
+
+	/* The frame has not been overwritten as long as the DMA channel has not
+	yet come round to its first byte again. */
+	return ( ( ulReceived - ulStart ) <= serRX_DMA_BUFFER_SIZE ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* serUSE_RX_FRAMES */
+
+void vSerialPutString( xComPortHandle pxPort, const signed portCHAR * const pcString, unsigned portSHORT usStringLength )
+{
+	/* NOTE: This implementation does not handle the buffer being full as no
 	block time is used! */
+	( void ) usSerialWrite( pxPort, pcString, usStringLength, serNO_BLOCK );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portSHORT usSerialWrite( xComPortHandle pxPort, const signed portCHAR * const pcBuffer, unsigned portSHORT usLength, portTickType xBlockTime )
+{
+size_t xBytesSent;
 
 	/* The port handle is not required as this driver only supports UART1. */
 	( void ) pxPort;
 
-	/* Send each character in the string, one at a time. */
-	pxNext = ( signed portCHAR * ) pcString;
-	while( *pxNext )
+	/* Copy the whole buffer into the Tx stream buffer in one operation, then
+	start the transmission. */
+	xBytesSent = xStreamBufferSend( xCharsForTx, pcBuffer, ( size_t ) usLength, xBlockTime );
+	if( xBytesSent != ( size_t ) 0 )
 	{
-		xSerialPutChar( pxPort, *pxNext, serNO_BLOCK );
-		pxNext++;
+		prvKickTx();
 	}
+
+	return ( unsigned portSHORT ) xBytesSent;
 }
 /*-----------------------------------------------------------*/
 
@@ -197,10 +437,9 @@ signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed portCHAR cOut
 {
 signed portBASE_TYPE xReturn;
 
-	if( xQueueSend( xCharsForTx, &cOutChar, xBlockTime ) == pdPASS )
+	if( usSerialWrite( pxPort, &cOutChar, sizeof( signed portCHAR ), xBlockTime ) != 0 )
 	{
 		xReturn = pdPASS;
-		USART_ITConfig( USART1, USART_IT_TXE, ENABLE );
 	}
 	else
 	{
@@ -217,38 +456,179 @@ void vSerialClose( xComPortHandle xPort )
 }
 /*-----------------------------------------------------------*/
 
-void vUARTInterruptHandler( void )
+static void prvStartNextTxBlock( signed portBASE_TYPE *pxHigherPriorityTaskWoken )
 {
-portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
-portCHAR cChar;
+size_t xBytes;
 
-	if( USART_GetITStatus( USART1, USART_IT_TXE ) == SET )
+	xBytes = xStreamBufferReceiveFromISR( xCharsForTx, ucTxDMABlock, sizeof( ucTxDMABlock ), pxHigherPriorityTaskWoken );
+
+	if( xBytes != ( size_t ) 0 )
+	{
+		/* The transfer count can only be written while the channel is
+		disabled. */
+		DMA_Cmd( DMA_Channel4, DISABLE );
+		DMA_Channel4->CNDTR = ( u32 ) xBytes;
+		DMA_Cmd( DMA_Channel4, ENABLE );
+		xTxDMABusy = pdTRUE;
+	}
+	else
 	{
-		/* The interrupt was caused by the THR becoming empty.  Are there any
-		more characters to transmit? */
-		if( xQueueReceiveFromISR( xCharsForTx, &cChar, &xHigherPriorityTaskWoken ) == pdTRUE )
+		xTxDMABusy = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvKickTx( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	/* The critical section masks the DMA interrupt, so the transfer cannot
+	end between testing xTxDMABusy and starting the next block. */
+	taskENTER_CRITICAL();
+	{
+		if( xTxDMABusy == pdFALSE )
 		{
-			/* A character was retrieved from the queue so can be sent to the
-			THR now. */
-			USART_SendData( USART1, cChar );
+			prvStartNextTxBlock( &xHigherPriorityTaskWoken );
 		}
-		else
+	}
+	taskEXIT_CRITICAL();
+
+	if( xHigherPriorityTaskWoken != pdFALSE )
+	{
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if serUSE_RX_FRAMES == 1
+
+static unsigned portLONG prvRxCount( void )
+{
+unsigned portLONG ulWraps;
+unsigned portBASE_TYPE uxRemaining;
+
+	/* A wrap that has happened but has not yet been counted by the DMA
+	interrupt shows as a pending transfer complete flag.  Reading the flag on
+	both sides of the counter shows which side of the wrap the counter was
+	read. */
+	ulWraps = ulRxWraps;
+	if( DMA_GetFlagStatus( DMA_FLAG_TC5 ) == SET )
+	{
+		ulWraps++;
+		uxRemaining = ( unsigned portBASE_TYPE ) DMA_GetCurrDataCounter( DMA_Channel5 );
+	}
+	else
+	{
+		uxRemaining = ( unsigned portBASE_TYPE ) DMA_GetCurrDataCounter( DMA_Channel5 );
+		if( DMA_GetFlagStatus( DMA_FLAG_TC5 ) == SET )
 		{
-			USART_ITConfig( USART1, USART_IT_TXE, DISABLE );		
-		}		
+			/* Wrapped while the counter was being read. */
+			ulWraps++;
+			uxRemaining = ( unsigned portBASE_TYPE ) DMA_GetCurrDataCounter( DMA_Channel5 );
+		}
 	}
-	
-	if( USART_GetITStatus( USART1, USART_IT_RXNE ) == SET )
+
+	return ( ulWraps * serRX_DMA_BUFFER_SIZE ) + ( serRX_DMA_BUFFER_SIZE - uxRemaining );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndRxFrame( signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portLONG ulEnd;
+xFrameDescriptor xDescriptor;
+
+	ulEnd = prvRxCount();
+	xDescriptor.ulStart = ulRxFrameStart;
+	ulRxFrameStart = ulEnd;
+
+	/* A frame longer than the buffer has already overwritten itself, so is
+	dropped, as is a frame that arrives while the queue is full. */
+	if( ( ulEnd != xDescriptor.ulStart ) && ( ( ulEnd - xDescriptor.ulStart ) <= serRX_DMA_BUFFER_SIZE ) )
 	{
-		cChar = USART_ReceiveData( USART1 );
-		xQueueSendFromISR( xRxedChars, &cChar, &xHigherPriorityTaskWoken );
-	}	
+		xDescriptor.usLength = ( unsigned portSHORT ) ( ulEnd - xDescriptor.ulStart );
+		xQueueSendFromISR( xRxFrames, &xDescriptor, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* serUSE_RX_FRAMES */
+
+static void prvCopyRxDMAData( signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxHead;
+
+	/* The DMA counter counts down from the buffer size. */
+	uxHead = serRX_DMA_BUFFER_SIZE - ( unsigned portBASE_TYPE ) DMA_GetCurrDataCounter( DMA_Channel5 );
+	if( uxHead == serRX_DMA_BUFFER_SIZE )
+	{
+		uxHead = 0;
+	}
+
+	if( uxHead < uxRxDMATail )
+	{
+		/* The data wraps around the end of the buffer. */
+		xStreamBufferSendFromISR( xRxedChars, &( ucRxDMABuffer[ uxRxDMATail ] ), ( size_t ) ( serRX_DMA_BUFFER_SIZE - uxRxDMATail ), pxHigherPriorityTaskWoken );
+		uxRxDMATail = 0;
+	}
+
+	if( uxHead > uxRxDMATail )
+	{
+		xStreamBufferSendFromISR( xRxedChars, &( ucRxDMABuffer[ uxRxDMATail ] ), ( size_t ) ( uxHead - uxRxDMATail ), pxHigherPriorityTaskWoken );
+	}
+
+	uxRxDMATail = uxHead;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* serUSE_RX_FRAMES */
+
+void vUARTInterruptHandler( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if( USART_GetITStatus( USART1, USART_IT_IDLE ) == SET )
+	{
+		/* The line has gone idle after a burst.  Reading SR then DR clears
+		the idle flag. */
+		( void ) USART1->SR;
+		( void ) USART1->DR;
+
+		#if serUSE_RX_FRAMES == 1
+			prvEndRxFrame( &xHigherPriorityTaskWoken );
+		#else
+			prvCopyRxDMAData( &xHigherPriorityTaskWoken );
+		#endif
+	}
 	
 	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
+/*-----------------------------------------------------------*/
+
+void vUARTTxDMAInterruptHandler( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
+	DMA_ClearITPendingBit( DMA_IT_GL4 );
 
+	/* The block has been sent.  Start the next one, if any. */
+	prvStartNextTxBlock( &xHigherPriorityTaskWoken );
 
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
 
+void vUARTRxDMAInterruptHandler( void )
+{
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-	
+	/* Half or all of the circular buffer has been filled. */
+	DMA_ClearITPendingBit( DMA_IT_GL5 );
+
+	#if serUSE_RX_FRAMES == 1
+		ulRxWraps++;
+	#else
+		prvCopyRxDMAData( &xHigherPriorityTaskWoken );
+	#endif
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
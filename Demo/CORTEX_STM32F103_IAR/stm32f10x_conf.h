@@ -30,20 +30,20 @@
 
 /* Comment the line below to disable the specific peripheral inclusion */
 /************************************* ADC ************************************/
-//#define _ADC
-//#define _ADC1
+#define _ADC
+#define _ADC1
 //#define _ADC2
 
 /************************************* CAN ************************************/
 //#define _CAN
 
 /************************************* DMA ************************************/
-//#define _DMA
-//#define _DMA_Channel1
+#define _DMA
+#define _DMA_Channel1
 //#define _DMA_Channel2
 //#define _DMA_Channel3
-//#define _DMA_Channel4
-//#define _DMA_Channel5
+#define _DMA_Channel4
+#define _DMA_Channel5
 //#define _DMA_Channel6
 //#define _DMA_Channel7
 
@@ -95,7 +95,7 @@
 //#define _TIM
 #define _TIM2
 #define _TIM3
-//#define _TIM4
+#define _TIM4
 
 /************************************* USART **********************************/
 #define _USART
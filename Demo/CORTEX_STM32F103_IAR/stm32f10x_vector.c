@@ -26,6 +26,8 @@ extern void xPortPendSVHandler( void );
 extern void xPortSysTickHandler( void );
 extern void vTimer2IntHandler( void );
 extern void vUARTInterruptHandler( void );
+extern void vUARTTxDMAInterruptHandler( void );
+extern void vUARTRxDMAInterruptHandler( void );
 extern void vPortSVCHandler( void );
 
 /* Private typedef -----------------------------------------------------------*/
@@ -75,8 +77,8 @@ const intvec_elem __vector_table[] =
   DMAChannel1_IRQHandler,
   DMAChannel2_IRQHandler,
   DMAChannel3_IRQHandler,
-  DMAChannel4_IRQHandler,
-  DMAChannel5_IRQHandler,
+  vUARTTxDMAInterruptHandler,
+  vUARTRxDMAInterruptHandler,
   DMAChannel6_IRQHandler,
   DMAChannel7_IRQHandler,
   ADC_IRQHandler,
@@ -0,0 +1,390 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The STM32F10x port layer of the DMA service in Demo/Common/Minimal/DMAService.c,
+ * written to the ST library in Demo/Common/drivers/ST.  The controller does
+ * not follow a linked list, so the next descriptor of a chain is loaded from
+ * the transfer complete interrupt.  Service channels 0 to 6 are DMA1 channels
+ * 1 to 7.  DMA2 is not included in this version of the library, so is not
+ * supported.
+ *
+ * Each peripheral request is wired to one DMA1 channel, so the ulRequest member
+ * of xDMAChannelConfig is the number, 1 to 7, of the DMA1 channel the request
+ * is wired to, as listed in the reference manual:
+ *
+ *   1 ADC1, TIM2_CH3, TIM4_CH1.
+ *   2 SPI1_RX, USART3_TX, TIM1_CH1, TIM2_UP, TIM3_CH3.
+ *   3 SPI1_TX, USART3_RX, TIM1_CH2, TIM3_CH4, TIM3_UP.
+ *   4 SPI2_RX, USART1_TX, I2C2_TX, TIM1_CH4, TIM1_TRIG, TIM1_COM, TIM4_CH2.
+ *   5 SPI2_TX, USART1_RX, I2C2_RX, TIM1_UP, TIM2_CH1, TIM4_CH3.
+ *   6 USART2_RX, I2C1_TX, TIM1_CH3, TIM3_CH1, TIM3_TRIG.
+ *   7 USART2_TX, I2C1_RX, TIM2_CH2, TIM2_CH4, TIM4_UP.
+ *
+ * so two drivers whose requests share a channel cannot both hold it at once.
+ * Memory to memory transfers can use any channel.  ucPriority sets the
+ * channel priority level.
+ *
+ * stm32f10x_conf.h must define _DMA and _DMA_Channel1 to _DMA_Channel7.
+ * SPIBus/SPIBusPort.c drives DMA channels 2 to 5 and their interrupts itself,
+ * so it cannot be linked into the same program as this file.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Library include files. */
+#include "stm32f10x_lib.h"
+
+/* Demo program include files. */
+#include "DMAService.h"
+
+#if !defined( _DMA ) || !defined( _DMA_Channel1 ) || !defined( _DMA_Channel2 ) || !defined( _DMA_Channel3 ) || !defined( _DMA_Channel4 ) || !defined( _DMA_Channel5 ) || !defined( _DMA_Channel6 ) || !defined( _DMA_Channel7 )
+	#error The DMA service port needs _DMA and _DMA_Channel1 to _DMA_Channel7 to be defined in stm32f10x_conf.h.
+#endif
+
+#define dmaNUM_CHANNELS					( 7 )
+#define dmaALL_CHANNELS					( 0x7fUL )
+
+/* CCR bits. */
+#define dmaCCR_EN						( 0x0001UL )
+#define dmaCCR_TCIE						( 0x0002UL )
+#define dmaCCR_TEIE						( 0x0008UL )
+#define dmaCCR_DIR						( 0x0010UL )
+#define dmaCCR_PINC						( 0x0040UL )
+#define dmaCCR_MINC						( 0x0080UL )
+#define dmaCCR_PSIZE_SHIFT				( 8UL )
+#define dmaCCR_MSIZE_SHIFT				( 10UL )
+#define dmaCCR_PL_SHIFT					( 12UL )
+#define dmaCCR_MEM2MEM					( 0x4000UL )
+
+/* The four ISR and IFCR bits of each channel, starting with the global flag of
+channel 1 at bit 0. */
+#define dmaFLAG_SHIFT( x )				( ( unsigned long ) ( x ) * 4UL )
+#define dmaFLAG_GIF						( 0x01UL )
+#define dmaFLAG_TCIF					( 0x02UL )
+#define dmaFLAG_TEIF					( 0x08UL )
+#define dmaFLAG_ALL						( 0x0fUL )
+
+static DMA_Channel_TypeDef * const pxChannels[ dmaNUM_CHANNELS ] =
+{
+	DMA_Channel1, DMA_Channel2, DMA_Channel3, DMA_Channel4, DMA_Channel5, DMA_Channel6, DMA_Channel7
+};
+
+/* The descriptor each channel is moving, and the CCR value it is moving it
+with, for loading the next descriptor from the interrupt. */
+static xDMADescriptor *pxCurrent[ dmaNUM_CHANNELS ];
+static unsigned long ulCCR[ dmaNUM_CHANNELS ];
+
+/* Returns the PSIZE/MSIZE code of a transfer of ucWidth bytes, or a value
+above 2 if the width is not supported. */
+static unsigned long prvWidthCode( unsigned char ucWidth );
+
+/* Program a channel to move one descriptor and enable it. */
+static void prvLoadDescriptor( unsigned portBASE_TYPE uxChannel, const xDMADescriptor *pxDescriptor );
+
+/* The interrupt handling common to every channel. */
+static void prvChannelInterrupt( unsigned portBASE_TYPE uxChannel );
+
+/* The DMA channel interrupt handlers, installed in the vector table by
+STM32F10x_Startup.s. */
+void DMAChannel1_IRQHandler( void );
+void DMAChannel2_IRQHandler( void );
+void DMAChannel3_IRQHandler( void );
+void DMAChannel4_IRQHandler( void );
+void DMAChannel5_IRQHandler( void );
+void DMAChannel6_IRQHandler( void );
+void DMAChannel7_IRQHandler( void );
+
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxDMAPortInit( void )
+{
+NVIC_InitTypeDef NVIC_InitStructure;
+unsigned portBASE_TYPE uxChannel;
+
+	RCC_AHBPeriphClockCmd( RCC_AHBPeriph_DMA, ENABLE );
+
+	/* The interrupts call the kernel, so must not be above the library
+	equivalent of configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+
+	for( uxChannel = 0; uxChannel < ( unsigned portBASE_TYPE ) dmaNUM_CHANNELS; uxChannel++ )
+	{
+		vDMAPortAbort( uxChannel );
+
+		NVIC_InitStructure.NVIC_IRQChannel = ( u8 ) ( DMAChannel1_IRQChannel + uxChannel );
+		NVIC_Init( &NVIC_InitStructure );
+	}
+
+	return ( unsigned portBASE_TYPE ) dmaNUM_CHANNELS;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulDMAPortChannelsFor( const xDMAChannelConfig *pxConfig )
+{
+unsigned long ulReturn;
+
+	if( pxConfig->ucDirection == dmaMEMORY_TO_MEMORY )
+	{
+		ulReturn = dmaALL_CHANNELS;
+	}
+	else if( ( pxConfig->ulRequest >= 1UL ) && ( pxConfig->ulRequest <= ( unsigned long ) dmaNUM_CHANNELS ) )
+	{
+		ulReturn = 1UL << ( pxConfig->ulRequest - 1UL );
+	}
+	else
+	{
+		ulReturn = 0UL;
+	}
+
+	if( prvWidthCode( pxConfig->ucWidth ) > 2UL )
+	{
+		ulReturn = 0UL;
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDMAPortStart( unsigned portBASE_TYPE uxChannel, const xDMAChannelConfig *pxConfig, xDMADescriptor *pxChain )
+{
+const xDMADescriptor *pxDescriptor;
+unsigned long ulConfig, ulWidth;
+unsigned char ucPeripheralIncrement, ucMemoryIncrement;
+
+	for( pxDescriptor = pxChain; pxDescriptor != NULL; pxDescriptor = pxDescriptor->pxNext )
+	{
+		if( pxDescriptor->usCount == 0U )
+		{
+			return pdFAIL;
+		}
+	}
+
+	/* The source is the peripheral side, except when moving from memory to a
+	peripheral.  A memory to memory transfer reads from the peripheral side,
+	so it is set up as a peripheral to memory transfer with MEM2MEM set. */
+	ulWidth = prvWidthCode( pxConfig->ucWidth );
+	ulConfig = dmaCCR_TCIE | dmaCCR_TEIE | ( ulWidth << dmaCCR_PSIZE_SHIFT ) | ( ulWidth << dmaCCR_MSIZE_SHIFT ) | ( ( ( unsigned long ) pxConfig->ucPriority & 0x03UL ) << dmaCCR_PL_SHIFT );
+
+	if( pxConfig->ucDirection == dmaMEMORY_TO_PERIPHERAL )
+	{
+		ulConfig |= dmaCCR_DIR;
+		ucPeripheralIncrement = dmaINCREMENT_DESTINATION;
+		ucMemoryIncrement = dmaINCREMENT_SOURCE;
+	}
+	else
+	{
+		if( pxConfig->ucDirection == dmaMEMORY_TO_MEMORY )
+		{
+			ulConfig |= dmaCCR_MEM2MEM;
+		}
+
+		ucPeripheralIncrement = dmaINCREMENT_SOURCE;
+		ucMemoryIncrement = dmaINCREMENT_DESTINATION;
+	}
+
+	if( ( pxConfig->ucIncrement & ucPeripheralIncrement ) != 0U )
+	{
+		ulConfig |= dmaCCR_PINC;
+	}
+	if( ( pxConfig->ucIncrement & ucMemoryIncrement ) != 0U )
+	{
+		ulConfig |= dmaCCR_MINC;
+	}
+
+	ulCCR[ uxChannel ] = ulConfig;
+	pxCurrent[ uxChannel ] = pxChain;
+	prvLoadDescriptor( uxChannel, pxChain );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vDMAPortAbort( unsigned portBASE_TYPE uxChannel )
+{
+	pxChannels[ uxChannel ]->CCR = 0UL;
+	DMA->IFCR = dmaFLAG_ALL << dmaFLAG_SHIFT( uxChannel );
+	pxCurrent[ uxChannel ] = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvWidthCode( unsigned char ucWidth )
+{
+unsigned long ulReturn;
+
+	switch( ucWidth )
+	{
+		case 1U	:	ulReturn = 0UL;
+					break;
+
+		case 2U	:	ulReturn = 1UL;
+					break;
+
+		case 4U	:	ulReturn = 2UL;
+					break;
+
+		default	:	ulReturn = 3UL;
+					break;
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadDescriptor( unsigned portBASE_TYPE uxChannel, const xDMADescriptor *pxDescriptor )
+{
+DMA_Channel_TypeDef *pxRegisters = pxChannels[ uxChannel ];
+
+	/* The addresses and count can only be written while the channel is
+	disabled. */
+	pxRegisters->CCR = 0UL;
+	DMA->IFCR = dmaFLAG_ALL << dmaFLAG_SHIFT( uxChannel );
+
+	if( ( ulCCR[ uxChannel ] & dmaCCR_DIR ) != 0UL )
+	{
+		pxRegisters->CPAR = ( u32 ) pxDescriptor->pvDestination;
+		pxRegisters->CMAR = ( u32 ) pxDescriptor->pvSource;
+	}
+	else
+	{
+		pxRegisters->CPAR = ( u32 ) pxDescriptor->pvSource;
+		pxRegisters->CMAR = ( u32 ) pxDescriptor->pvDestination;
+	}
+
+	pxRegisters->CNDTR = ( u32 ) pxDescriptor->usCount;
+	pxRegisters->CCR = ulCCR[ uxChannel ] | dmaCCR_EN;
+}
+/*-----------------------------------------------------------*/
+
+static void prvChannelInterrupt( unsigned portBASE_TYPE uxChannel )
+{
+unsigned long ulFlags;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	ulFlags = ( DMA->ISR >> dmaFLAG_SHIFT( uxChannel ) ) & dmaFLAG_ALL;
+	DMA->IFCR = ulFlags << dmaFLAG_SHIFT( uxChannel );
+
+	if( pxCurrent[ uxChannel ] != NULL )
+	{
+		if( ( ulFlags & dmaFLAG_TEIF ) != 0UL )
+		{
+			/* The channel is disabled by the error. */
+			vDMAPortAbort( uxChannel );
+			vDMAChannelDoneFromISR( uxChannel, pdFAIL, &xHigherPriorityTaskWoken );
+		}
+		else if( ( ulFlags & dmaFLAG_TCIF ) != 0UL )
+		{
+			pxCurrent[ uxChannel ] = pxCurrent[ uxChannel ]->pxNext;
+
+			if( pxCurrent[ uxChannel ] != NULL )
+			{
+				prvLoadDescriptor( uxChannel, pxCurrent[ uxChannel ] );
+			}
+			else
+			{
+				pxChannels[ uxChannel ]->CCR = 0UL;
+				vDMAChannelDoneFromISR( uxChannel, pdPASS, &xHigherPriorityTaskWoken );
+			}
+		}
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel1_IRQHandler( void )
+{
+	prvChannelInterrupt( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel2_IRQHandler( void )
+{
+	prvChannelInterrupt( 1 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel3_IRQHandler( void )
+{
+	prvChannelInterrupt( 2 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel4_IRQHandler( void )
+{
+	prvChannelInterrupt( 3 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel5_IRQHandler( void )
+{
+	prvChannelInterrupt( 4 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel6_IRQHandler( void )
+{
+	prvChannelInterrupt( 5 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel7_IRQHandler( void )
+{
+	prvChannelInterrupt( 6 );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,309 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The STM32F10x port layer of the SPI bus manager in Demo/Common/Minimal/SPIBus.c,
+ * written to the ST library in Demo/Common/drivers/ST.  Each transfer runs on
+ * two DMA channels, one feeding the transmit register and the other emptying
+ * the receive register.  The receive channel finishes last, so only its
+ * transfer complete and error interrupts are used.
+ *
+ *   Bus 0 - SPI1: SCK PA5, MISO PA6, MOSI PA7.  DMA channels 2 (Rx) and 3 (Tx).
+ *   Bus 1 - SPI2: SCK PB13, MISO PB14, MOSI PB15.  DMA channels 4 (Rx) and 5 (Tx).
+ *
+ * SPI3, used by the LCD on this board, is served by DMA2, which this version
+ * of the library does not include, so it is not supported.  Chip selects are
+ * driven by the vChipSelect() function of each device.
+ *
+ * stm32f10x_conf.h must define _DMA and _DMA_Channel2 to _DMA_Channel5, and
+ * stm32f10x_dma.c must be added to the build.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Library include files. */
+#include "stm32f10x_lib.h"
+
+/* Demo program include files. */
+#include "SPIBus.h"
+
+#if !defined( _DMA ) || !defined( _DMA_Channel2 ) || !defined( _DMA_Channel3 ) || !defined( _DMA_Channel4 ) || !defined( _DMA_Channel5 )
+	#error The SPI bus port needs _DMA and _DMA_Channel2 to _DMA_Channel5 to be defined in stm32f10x_conf.h.
+#endif
+
+#define spiNUM_BUSES			( 2 )
+
+/* The SPI_BaudRatePrescaler_x values are the divide ratio, as a power of two
+less one, in bits 5:3. */
+#define spiPRESCALER_SHIFT		( 3 )
+#define spiMAX_PRESCALER		( 7 )
+
+/* The hardware used by each bus. */
+typedef struct SPI_PORT
+{
+	SPI_TypeDef *pxSPI;
+	DMA_Channel_TypeDef *pxRxChannel;
+	DMA_Channel_TypeDef *pxTxChannel;
+	u32 ulRxErrorFlag;
+	u32 ulRxGlobalFlag;
+	u32 ulTxGlobalFlag;
+	u8 ucRxIRQChannel;
+} xSPIPort;
+
+static const xSPIPort xPorts[ spiNUM_BUSES ] =
+{
+	{ SPI1, DMA_Channel2, DMA_Channel3, DMA_IT_TE2, DMA_IT_GL2, DMA_IT_GL3, DMAChannel2_IRQChannel },
+	{ SPI2, DMA_Channel4, DMA_Channel5, DMA_IT_TE4, DMA_IT_GL4, DMA_IT_GL5, DMAChannel4_IRQChannel }
+};
+
+/* The source of transfers that have no transmit data, and the destination of
+those that have no receive buffer.  The DMA address is not incremented for
+either. */
+static const unsigned char ucFillByte = spiFILL_BYTE;
+static unsigned char ucDiscard;
+
+/* Stop the DMA of bus uxBus. */
+static void prvStopTransfer( const xSPIPort *pxPort );
+
+/* The DMA interrupt handling common to both buses. */
+static void prvDMAInterrupt( unsigned portBASE_TYPE uxBus );
+
+/* The receive DMA channel interrupt handlers, installed in the vector table by
+STM32F10x_Startup.s. */
+void DMAChannel2_IRQHandler( void );
+void DMAChannel4_IRQHandler( void );
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSPIPortInit( unsigned portBASE_TYPE uxBus )
+{
+GPIO_InitTypeDef GPIO_InitStructure;
+NVIC_InitTypeDef NVIC_InitStructure;
+GPIO_TypeDef *pxGPIO;
+
+	if( uxBus >= ( unsigned portBASE_TYPE ) spiNUM_BUSES )
+	{
+		return pdFAIL;
+	}
+
+	RCC_AHBPeriphClockCmd( RCC_AHBPeriph_DMA, ENABLE );
+
+	if( uxBus == 0 )
+	{
+		RCC_APB2PeriphClockCmd( RCC_APB2Periph_SPI1 | RCC_APB2Periph_GPIOA, ENABLE );
+		pxGPIO = GPIOA;
+		GPIO_InitStructure.GPIO_Pin = GPIO_Pin_5 | GPIO_Pin_7;
+	}
+	else
+	{
+		RCC_APB1PeriphClockCmd( RCC_APB1Periph_SPI2, ENABLE );
+		RCC_APB2PeriphClockCmd( RCC_APB2Periph_GPIOB, ENABLE );
+		pxGPIO = GPIOB;
+		GPIO_InitStructure.GPIO_Pin = GPIO_Pin_13 | GPIO_Pin_15;
+	}
+
+	/* SCK and MOSI are driven by the SPI, MISO is an input. */
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+	GPIO_Init( pxGPIO, &GPIO_InitStructure );
+
+	GPIO_InitStructure.GPIO_Pin = ( uxBus == 0 ) ? GPIO_Pin_6 : GPIO_Pin_14;
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+	GPIO_Init( pxGPIO, &GPIO_InitStructure );
+
+	prvStopTransfer( &( xPorts[ uxBus ] ) );
+
+	/* The interrupt calls the kernel, so must not be above the library
+	equivalent of configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+	NVIC_InitStructure.NVIC_IRQChannel = xPorts[ uxBus ].ucRxIRQChannel;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = configLIBRARY_KERNEL_INTERRUPT_PRIORITY;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init( &NVIC_InitStructure );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vSPIPortConfigure( unsigned portBASE_TYPE uxBus, const xSPIDevice *pxDevice )
+{
+SPI_InitTypeDef SPI_InitStructure;
+RCC_ClocksTypeDef xClocks;
+unsigned long ulPeripheralClock;
+unsigned short usPrescaler;
+SPI_TypeDef *pxSPI = xPorts[ uxBus ].pxSPI;
+
+	/* SPI1 is on APB2 and SPI2 on APB1.  Use the smallest divider that does
+	not take SCK above the rate of the device. */
+	RCC_GetClocksFreq( &xClocks );
+	ulPeripheralClock = ( uxBus == 0 ) ? xClocks.PCLK2_Frequency : xClocks.PCLK1_Frequency;
+
+	for( usPrescaler = 0; usPrescaler < spiMAX_PRESCALER; usPrescaler++ )
+	{
+		if( ( ulPeripheralClock >> ( usPrescaler + 1U ) ) <= pxDevice->ulClockHz )
+		{
+			break;
+		}
+	}
+
+	SPI_InitStructure.SPI_Direction = SPI_Direction_2Lines_FullDuplex;
+	SPI_InitStructure.SPI_Mode = SPI_Mode_Master;
+	SPI_InitStructure.SPI_DataSize = SPI_DataSize_8b;
+	SPI_InitStructure.SPI_CPOL = ( ( pxDevice->ucMode & 0x02U ) != 0U ) ? SPI_CPOL_High : SPI_CPOL_Low;
+	SPI_InitStructure.SPI_CPHA = ( ( pxDevice->ucMode & 0x01U ) != 0U ) ? SPI_CPHA_2Edge : SPI_CPHA_1Edge;
+	SPI_InitStructure.SPI_NSS = SPI_NSS_Soft;
+	SPI_InitStructure.SPI_BaudRatePrescaler = ( unsigned short ) ( usPrescaler << spiPRESCALER_SHIFT );
+	SPI_InitStructure.SPI_FirstBit = SPI_FirstBit_MSB;
+	SPI_InitStructure.SPI_CRCPolynomial = 7;
+
+	SPI_Cmd( pxSPI, DISABLE );
+	SPI_Init( pxSPI, &SPI_InitStructure );
+	SPI_Cmd( pxSPI, ENABLE );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSPIPortStart( unsigned portBASE_TYPE uxBus, const unsigned char *pucTxData, unsigned char *pucRxData, unsigned short usLength )
+{
+DMA_InitTypeDef DMA_InitStructure;
+const xSPIPort *pxPort = &( xPorts[ uxBus ] );
+
+	/* Discard anything left in the receive register by an aborted transfer,
+	so the first byte received is the reply to the first byte sent. */
+	( void ) SPI_I2S_ReceiveData( pxPort->pxSPI );
+
+	DMA_InitStructure.DMA_PeripheralBaseAddr = ( u32 ) &( pxPort->pxSPI->DR );
+	DMA_InitStructure.DMA_BufferSize = usLength;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+	DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+
+	/* Receive at a higher priority than transmit, so the receive register is
+	always emptied before the next byte arrives. */
+	DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+	DMA_InitStructure.DMA_MemoryBaseAddr = ( pucRxData != NULL ) ? ( u32 ) pucRxData : ( u32 ) &ucDiscard;
+	DMA_InitStructure.DMA_MemoryInc = ( pucRxData != NULL ) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
+	DMA_Init( pxPort->pxRxChannel, &DMA_InitStructure );
+
+	DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+	DMA_InitStructure.DMA_MemoryBaseAddr = ( pucTxData != NULL ) ? ( u32 ) pucTxData : ( u32 ) &ucFillByte;
+	DMA_InitStructure.DMA_MemoryInc = ( pucTxData != NULL ) ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+	DMA_Init( pxPort->pxTxChannel, &DMA_InitStructure );
+
+	DMA_ITConfig( pxPort->pxRxChannel, DMA_IT_TC | DMA_IT_TE, ENABLE );
+
+	/* The transfer starts when the SPI requests the first transmit byte. */
+	DMA_Cmd( pxPort->pxRxChannel, ENABLE );
+	DMA_Cmd( pxPort->pxTxChannel, ENABLE );
+	SPI_I2S_DMACmd( pxPort->pxSPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vSPIPortAbort( unsigned portBASE_TYPE uxBus )
+{
+const xSPIPort *pxPort = &( xPorts[ uxBus ] );
+
+	portENTER_CRITICAL();
+	{
+		prvStopTransfer( pxPort );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTransfer( const xSPIPort *pxPort )
+{
+	SPI_I2S_DMACmd( pxPort->pxSPI, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE );
+	DMA_Cmd( pxPort->pxRxChannel, DISABLE );
+	DMA_Cmd( pxPort->pxTxChannel, DISABLE );
+	DMA_ITConfig( pxPort->pxRxChannel, DMA_IT_TC | DMA_IT_TE, DISABLE );
+	DMA_ClearITPendingBit( pxPort->ulRxGlobalFlag );
+	DMA_ClearITPendingBit( pxPort->ulTxGlobalFlag );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDMAInterrupt( unsigned portBASE_TYPE uxBus )
+{
+const xSPIPort *pxPort = &( xPorts[ uxBus ] );
+portBASE_TYPE xResult;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	xResult = ( DMA_GetITStatus( pxPort->ulRxErrorFlag ) != RESET ) ? pdFAIL : pdPASS;
+
+	/* When the last byte has been received the SPI is idle, so the next
+	transfer can be started as soon as the bus task runs. */
+	prvStopTransfer( pxPort );
+	vSPIBusTransferDoneFromISR( uxBus, xResult, &xHigherPriorityTaskWoken );
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel2_IRQHandler( void )
+{
+	prvDMAInterrupt( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void DMAChannel4_IRQHandler( void )
+{
+	prvDMAInterrupt( 1 );
+}
+/*-----------------------------------------------------------*/
@@ -116,7 +116,7 @@ vector53:	.long	_asm_exception_handler
 vector54:	.long	_asm_exception_handler
 vector55:	.long	_asm_exception_handler
 vector56:	.long	_asm_exception_handler
-vector57:	.long	_asm_exception_handler
+vector57:	.long	_vFECISRHandler
 vector58:	.long	_asm_exception_handler
 vector59:	.long	_vFECISRHandler
 vector5A:	.long	_vFECISRHandler
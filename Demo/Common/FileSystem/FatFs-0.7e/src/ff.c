@@ -108,10 +108,39 @@
 	#define ENTER_FF( fs )
 	#define LEAVE_FF( fs, res ) return res
 #endif
+#if _FS_FILE_LOCK
+	#define ENTER_FP( fp )							\
+	{												\
+		if( !(fp)->fs )								\
+		{											\
+			return FR_INVALID_OBJECT;				\
+		}											\
+		if( !ff_req_grant((fp)->sobj) )				\
+		{											\
+			return FR_TIMEOUT;						\
+		}											\
+	}
+
+	#define LEAVE_FP( fp, res )						\
+	{												\
+		FRESULT rc_ = res;							\
+		unlock_fs( (fp)->fs, rc_ );					\
+		ff_rel_grant( (fp)->sobj );					\
+		return rc_;									\
+	}
+
+	#define READ_DATA( fp, buff, sect, cnt )	read_data( fp, buff, sect, cnt )
+	#define WRITE_DATA( fp, buff, sect, cnt )	write_data( fp, buff, sect, cnt )
+#else
+	#define ENTER_FP( fp )
+	#define LEAVE_FP( fp, res )	LEAVE_FF( (fp)->fs, res )
+	#define READ_DATA( fp, buff, sect, cnt )	disk_read( (fp)->fs->drive, buff, sect, cnt )
+	#define WRITE_DATA( fp, buff, sect, cnt )	disk_write( (fp)->fs->drive, buff, sect, cnt )
+#endif
 #define ABORT( fs, res )	   \
 	{						   \
 		fp->flag |= FA__ERROR; \
-		LEAVE_FF( fs, res );   \
+		LEAVE_FP( fp, res );   \
 	}
 
 #ifndef NULL
@@ -127,6 +156,9 @@
 #define NS_EXT	0x10				/* Lower case flag (ext) */
 #define NS_DOT	0x20				/* Dot entry */
 
+/* Entries a search has to pass before the directory is indexed */
+#define DIR_INDEX_MIN	64
+
 /*--------------------------------------------------------------------------
 
    Private Work Area
@@ -236,6 +268,73 @@ static void unlock_fs ( FATFS * fs, /* File system object */ FRESULT res /* Resu
 	}
 }
 
+#endif
+#if _FS_FILE_LOCK
+
+/*-----------------------------------------------------------------------*/
+
+/* Transfer file data with the volume unlocked                           */
+
+/*-----------------------------------------------------------------------*/
+static void relock_fs ( FIL *fp /* Pointer to the file object */ )
+{
+	/* The volume was locked on entry, so wait for it rather than fail */
+	while( !ff_req_grant(fp->fs->sobj) )
+	{
+	}
+}
+
+static DRESULT read_data ( FIL *fp, /* Pointer to the file object */ BYTE *buff, /* Data buffer */ DWORD sect, /* Start sector */ BYTE count /* Number of sectors */ )
+{
+	DRESULT res;
+
+	ff_rel_grant( fp->fs->sobj );	/* Other tasks may use the FAT and directories meanwhile */
+	res = disk_read( fp->fs->drive, buff, sect, count );
+	relock_fs( fp );
+	return res;
+}
+
+	#if !_FS_READONLY
+static DRESULT write_data ( FIL *fp, /* Pointer to the file object */ const BYTE *buff, /* Data to be written */ DWORD sect, /* Start sector */ BYTE count /* Number of sectors */ )
+{
+	DRESULT res;
+
+	ff_rel_grant( fp->fs->sobj );
+	res = disk_write( fp->fs->drive, buff, sect, count );
+	relock_fs( fp );
+	return res;
+}
+
+	#endif
+#endif
+
+#if !_FS_READONLY
+
+/*-----------------------------------------------------------------------*/
+
+/* Write back a FAT/Directory sector                                     */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT write_window ( FATFS * fs, /* File system object */ const BYTE * buf, /* Sector data */ DWORD wsect /* Sector number to write */ )
+{
+	if( disk_write(fs->drive, buf, wsect, 1) != RES_OK )
+	{
+		return FR_DISK_ERR;
+	}
+
+	if( wsect < (fs->fatbase + fs->sects_fat) )
+	{		/* In FAT area */
+		BYTE nf;
+		for( nf = fs->n_fats; nf > 1; nf-- )
+		{	/* Refrect the change to all FAT copies */
+			wsect += fs->sects_fat;
+			disk_write( fs->drive, buf, wsect, 1 );
+		}
+	}
+
+	return FR_OK;
+}
+
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -243,6 +342,7 @@ static void unlock_fs ( FATFS * fs, /* File system object */ FRESULT res /* Resu
 /* Change window offset                                                  */
 
 /*-----------------------------------------------------------------------*/
+#if !_FS_CACHE_SECTORS
 static FRESULT move_window ( FATFS * fs, /* File system object */ DWORD sector /* Sector number to make apperance in the fs->win[] */ ) /* Move to zero only writes back dirty window */
 {
 	DWORD wsect;
@@ -253,21 +353,12 @@ static FRESULT move_window ( FATFS * fs, /* File system object */ DWORD sector /
 		#if !_FS_READONLY
 		if( fs->wflag )
 		{			/* Write back dirty window if needed */
-			if( disk_write(fs->drive, fs->win, wsect, 1) != RES_OK )
+			if( write_window(fs, fs->win, wsect) != FR_OK )
 			{
 				return FR_DISK_ERR;
 			}
 
 			fs->wflag = 0;
-			if( wsect < (fs->fatbase + fs->sects_fat) )
-			{		/* In FAT area */
-				BYTE nf;
-				for( nf = fs->n_fats; nf > 1; nf-- )
-				{	/* Refrect the change to all FAT copies */
-					wsect += fs->sects_fat;
-					disk_write( fs->drive, fs->win, wsect, 1 );
-				}
-			}
 		}
 
 		#endif
@@ -285,6 +376,178 @@ static FRESULT move_window ( FATFS * fs, /* File system object */ DWORD sector /
 	return FR_OK;
 }
 
+#else
+static FRESULT move_window ( FATFS * fs, /* File system object */ DWORD sector /* Sector number to make apperance in the fs->win[] */ ) /* Move to zero only writes back dirty window */
+{
+	DWORD	wsect;
+	BYTE	n, e, b, wflag, *p1, *p2;
+	UINT	i;
+
+	wsect = fs->winsect;
+	if( wsect == sector )
+	{
+		return FR_OK;
+	}
+
+	if( !sector )
+	{				/* Only write back the window */
+		#if !_FS_READONLY
+		if( fs->wflag )
+		{
+			if( write_window(fs, fs->win, wsect) != FR_OK )
+			{
+				return FR_DISK_ERR;
+			}
+
+			fs->wflag = 0;
+		}
+
+		#endif
+		return FR_OK;
+	}
+
+	/* Search the cache from the most recently used entry, stopping at the
+	least recently used one */
+	for( n = 0; n < _FS_CACHE_SECTORS - 1 && fs->csect[fs->clru[n]] != sector; n++ )
+	{
+	}
+
+	e = fs->clru[n];
+	if( wsect )
+	{				/* The entry is going to receive the window, make it the most recently used */
+		for( ; n; n-- )
+		{
+			fs->clru[n] = fs->clru[n - 1];
+		}
+
+		fs->clru[0] = e;
+	}
+
+	if( fs->csect[e] == sector )
+	{				/* Cache hit: swap the entry with the window */
+		p1 = fs->win;
+		p2 = fs->cbuf[e];
+		for( i = 0; i < SS( fs ); i++ )
+		{
+			b = p1[i];
+			p1[i] = p2[i];
+			p2[i] = b;
+		}
+
+		wflag = fs->cflag[e];
+		fs->csect[e] = wsect;
+		fs->cflag[e] = fs->wflag;
+		fs->winsect = sector;
+		fs->wflag = wflag;
+	}
+	else
+	{				/* Cache miss: the window displaces the least recently used entry */
+		if( wsect )
+		{
+			#if !_FS_READONLY
+			if( fs->cflag[e] )
+			{		/* Write back the evicted entry if dirty */
+				if( write_window(fs, fs->cbuf[e], fs->csect[e]) != FR_OK )
+				{
+					return FR_DISK_ERR;
+				}
+			}
+
+			#endif
+			mem_cpy( fs->cbuf[e], fs->win, SS(fs) );
+			fs->csect[e] = wsect;
+			fs->cflag[e] = fs->wflag;
+		}
+
+		/* The window is no longer valid until the read succeeds */
+		fs->winsect = 0;
+		fs->wflag = 0;
+		if( disk_read(fs->drive, fs->win, sector, 1) != RES_OK )
+		{
+			return FR_DISK_ERR;
+		}
+
+		fs->winsect = sector;
+	}
+
+	return FR_OK;
+}
+
+/*-----------------------------------------------------------------------*/
+
+/* Discard the sector cache                                              */
+
+/*-----------------------------------------------------------------------*/
+static void init_cache ( FATFS * fs /* File system object */ )
+{
+	BYTE e;
+
+	for( e = 0; e < _FS_CACHE_SECTORS; e++ )
+	{
+		fs->clru[e] = e;
+		fs->cflag[e] = 0;
+		fs->csect[e] = 0;
+	}
+
+	fs->winsect = 0;
+	fs->wflag = 0;
+}
+
+#if !_FS_READONLY
+
+/*-----------------------------------------------------------------------*/
+
+/* Drop cached copies of sectors that have been rewritten through the     */
+/* window                                                                */
+
+/*-----------------------------------------------------------------------*/
+static void clear_cache ( FATFS * fs, /* File system object */ DWORD sect, /* First sector */ DWORD count /* Number of sectors */ )
+{
+	BYTE e;
+
+	for( e = 0; e < _FS_CACHE_SECTORS; e++ )
+	{
+		if( fs->csect[e] - sect < count )
+		{
+			fs->csect[e] = 0;
+			fs->cflag[e] = 0;
+		}
+	}
+}
+
+/*-----------------------------------------------------------------------*/
+
+/* Write back the window and all dirty cache entries                     */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT flush_cache ( FATFS * fs /* File system object */ )
+{
+	BYTE e;
+
+	if( move_window(fs, 0) != FR_OK )
+	{
+		return FR_DISK_ERR;
+	}
+
+	for( e = 0; e < _FS_CACHE_SECTORS; e++ )
+	{
+		if( fs->cflag[e] )
+		{
+			if( write_window(fs, fs->cbuf[e], fs->csect[e]) != FR_OK )
+			{
+				return FR_DISK_ERR;
+			}
+
+			fs->cflag[e] = 0;
+		}
+	}
+
+	return FR_OK;
+}
+
+#endif
+#endif
+
 /*-----------------------------------------------------------------------*/
 
 /* Clean-up cached data                                                  */
@@ -295,7 +558,11 @@ static FRESULT sync ( /* FR_OK: successful, FR_DISK_ERR: failed */ FATFS * fs /*
 {
 	FRESULT res;
 
+	#if _FS_CACHE_SECTORS
+	res = flush_cache( fs );
+	#else
 	res = move_window( fs, 0 );
+	#endif
 	if( res == FR_OK )
 	{
 		/* Update FSInfo sector if needed */
@@ -505,6 +772,14 @@ static FRESULT remove_chain ( FATFS * fs, /* File system object */ DWORD clst /*
 				break;
 			}
 
+	#if _FS_FREE_SCAN
+			if( clst < fs->fscan_clust )
+			{			/* Already passed by the free cluster count */
+				fs->fscan_free++;
+			}
+
+	#endif
+
 			if( fs->free_clust != 0xFFFFFFFF )
 			{			/* Update FSInfo */
 				fs->free_clust++;
@@ -608,9 +883,111 @@ static DWORD create_chain
 		fs->fsi_flag = 1;
 	}
 
+	#if _FS_FREE_SCAN
+	if( ncl < fs->fscan_clust )
+	{						/* Already passed by the free cluster count */
+		fs->fscan_free--;
+	}
+
+	#endif
 	return ncl;				/* Return new cluster number */
 }
 
+	#if _FS_FREE_SCAN
+
+/*-----------------------------------------------------------------------*/
+
+/* FAT handling - Advance the free cluster count                         */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT scan_free
+	(
+		FATFS * fs, /* File system object */ DWORD n /* Number of FAT entries to count */
+	)
+{
+	FRESULT res = FR_OK;
+	DWORD	clst, nfree, stat;
+	UINT	i, ne;
+	BYTE	*p;
+
+	clst = fs->fscan_clust;
+	nfree = fs->fscan_free;
+	ne = SS( fs ) / ( (fs->fs_type == FS_FAT32) ? 4 : 2 );	/* FAT entries per sector */
+	while( clst && clst < fs->max_clust && n )
+	{
+		if( fs->fs_type == FS_FAT12 )
+		{	/* FAT12 entries can span sectors, follow them one at a time */
+			stat = get_fat( fs, clst );
+			if( stat == 0xFFFFFFFF )
+			{
+				res = FR_DISK_ERR;
+				break;
+			}
+
+			if( stat == 1 )
+			{
+				res = FR_INT_ERR;
+				break;
+			}
+
+			if( stat == 0 )
+			{
+				if( fs->last_clust == 0 || fs->last_clust >= fs->max_clust )
+				{
+					fs->last_clust = clst - 1;	/* Start allocating at the first free cluster */
+				}
+
+				nfree++;
+			}
+
+			clst++;
+			n--;
+		}
+		else
+		{	/* Count the rest of the FAT sector holding the entry */
+			res = move_window( fs, fs->fatbase + clst / ne );
+			if( res != FR_OK )
+			{
+				break;
+			}
+
+			i = ( UINT ) ( clst % ne );
+			p = fs->win + i * ( SS(fs) / ne );
+			for( ; i < ne && clst < fs->max_clust && n; i++, clst++, n-- )
+			{
+				stat = ( fs->fs_type == FS_FAT32 ) ? ( LD_DWORD(p) & 0x0FFFFFFF ) : LD_WORD( p );
+				if( stat == 0 )
+				{
+					if( fs->last_clust == 0 || fs->last_clust >= fs->max_clust )
+					{
+						fs->last_clust = clst - 1;
+					}
+
+					nfree++;
+				}
+
+				p += SS( fs ) / ne;
+			}
+		}
+	}
+
+	fs->fscan_clust = clst;
+	fs->fscan_free = nfree;
+	if( clst >= fs->max_clust )
+	{	/* The count is complete */
+		fs->fscan_clust = 0;
+		fs->free_clust = nfree;
+		if( fs->fs_type == FS_FAT32 )
+		{
+			fs->fsi_flag = 1;
+		}
+	}
+
+	return res;
+}
+
+	#endif
+
 #endif /* !_FS_READONLY */
 
 /*-----------------------------------------------------------------------*/
@@ -785,6 +1162,9 @@ static FRESULT dir_next
 					}
 
 					dj->fs->winsect -= c;	/* Rewind window address */
+						#if _FS_CACHE_SECTORS
+					clear_cache( dj->fs, dj->fs->winsect, c );	/* Drop stale copies of the cluster */
+						#endif
 					#else
 					return FR_NO_FILE;		/* Report EOT */
 					#endif
@@ -1024,19 +1404,143 @@ static BYTE sum_sfn( const BYTE *dir /* Ptr to directory entry */ )
 
 #endif
 
+#if _FS_DIR_CACHE || _FS_DIR_INDEX
+
 /*-----------------------------------------------------------------------*/
 
-/* Directory handling - Find an object in the directory                  */
+/* Calculate hashes of a name for the directory cache and index          */
 
 /*-----------------------------------------------------------------------*/
-static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to the file name */ )
+static WORD hash_sfn( const BYTE *dir /* Ptr to the SFN */ )
+{
+	DWORD	h = 0;
+	int		n = 11;
+
+	do
+	{
+		h = h * 31 + *dir++;
+	} while( --n );
+	return( WORD ) ( h ^ (h >> 16) );
+}
+
+	#if _USE_LFN
+
+/* The characters are summed by their position in the name, so the LFN entries
+   of an object can be hashed in the order they are stored on the disk. */
+static DWORD hash_lfn_char( WCHAR wc, UINT i /* Position of the character in the LFN */ )
+{
+	return( (DWORD) ff_wtoupper(wc) + 1 ) * ( 0x9E3779B1UL * (i + 1) );
+}
+
+static WORD hash_lfn_fold( DWORD h )
+{
+	h ^= h >> 16;
+	return( (WORD) h ) ? ( WORD ) h : 1;	/* 0 is kept for "no LFN" */
+}
+
+static WORD hash_lfn( const WCHAR *lfn /* Ptr to the LFN */ )
+{
+	DWORD	h = 0;
+	UINT	i;
+
+	for( i = 0; lfn[i]; i++ )
+	{
+		h += hash_lfn_char( lfn[i], i );
+	}
+
+	return hash_lfn_fold( h );
+}
+
+	#endif
+
+/* The hash of the name in dj->fn and dj->lfn (LFN hash:SFN hash) */
+static DWORD hash_name( DIR *dj /* Directory object linked to the name */ )
+{
+	DWORD	hash = hash_sfn( dj->fn );
+
+	#if _USE_LFN
+	if( dj->lfn )
+	{
+		hash |= ( DWORD ) hash_lfn( dj->lfn ) << 16;
+	}
+
+	#endif
+	return hash;
+}
+
+/*-----------------------------------------------------------------------*/
+
+/* Discard the directory cache and index                                 */
+
+/*-----------------------------------------------------------------------*/
+static void init_dir_cache ( FATFS * fs /* File system object */ )
+{
+	#if _FS_DIR_CACHE
+	BYTE e;
+
+	for( e = 0; e < _FS_DIR_CACHE; e++ )
+	{
+		fs->dc_idx[e] = 0xFFFF;
+	}
+
+	fs->dc_next = 0;
+	#endif
+	#if _FS_DIR_INDEX
+	fs->di_valid = 0;
+	#endif
+}
+
+	#if !_FS_READONLY
+
+/*-----------------------------------------------------------------------*/
+
+/* Forget everything known about a directory that is removed or created  */
+
+/*-----------------------------------------------------------------------*/
+static void dir_forget ( FATFS * fs, /* File system object */ DWORD clust /* Cluster of the directory */ )
+{
+		#if _FS_DIR_CACHE
+	BYTE e;
+
+	for( e = 0; e < _FS_DIR_CACHE; e++ )
+	{
+		if( fs->dc_clust[e] == clust )
+		{
+			fs->dc_idx[e] = 0xFFFF;
+		}
+	}
+
+		#endif
+		#if _FS_DIR_INDEX
+	if( fs->di_clust == clust )
+	{
+		fs->di_valid = 0;
+	}
+
+		#endif
+}
+
+	#endif
+#endif
+
+/*-----------------------------------------------------------------------*/
+
+/* Directory handling - Match the name against the directory entries     */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT dir_match
+	(
+		DIR *dj,	/* Pointer to the directory object linked to the file name */
+		WORD idx,	/* Index of the first entry to compare */
+		BOOL one	/* TRUE:Compare only the object starting at idx */
+	)
 {
 	FRESULT res;
 	BYTE	c, *dir;
 	#if _USE_LFN
 	BYTE	a, ord, sum;
 	#endif
-	res = dir_seek( dj, 0 );			/* Rewind directory object */
+	res = dir_seek( dj, idx );
 	if( res != FR_OK )
 	{
 		return res;
@@ -1044,6 +1548,7 @@ static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to th
 
 	#if _USE_LFN
 	ord = sum = 0xFF;
+	dj->lfn_idx = 0xFFFF;
 	#endif
 	do
 	{
@@ -1065,6 +1570,12 @@ static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to th
 		a = dir[DIR_Attr] & AM_MASK;
 		if( c == 0xE5 || ((a & AM_VOL) && a != AM_LFN) )
 		{								/* An entry without valid data */
+			if( one )
+			{
+				res = FR_NO_FILE;
+				break;
+			}
+
 			ord = 0xFF;
 		}
 		else
@@ -1098,6 +1609,12 @@ static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to th
 				{
 					break;				/* SFN matched? */
 				}
+
+				if( one )
+				{
+					res = FR_NO_FILE;	/* End of the object */
+					break;
+				}
 			}
 		}
 
@@ -1107,10 +1624,242 @@ static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to th
 			break;
 		}
 
-		#endif
-		res = dir_next( dj, FALSE );	/* Next entry */
-	} while( res == FR_OK );
+		if( one )
+		{
+			res = FR_NO_FILE;
+			break;
+		}
+
+		#endif
+		res = dir_next( dj, FALSE );	/* Next entry */
+	} while( res == FR_OK );
+
+	return res;
+}
+
+#if _FS_DIR_INDEX
+
+/*-----------------------------------------------------------------------*/
+
+/* Build the in-RAM index of the directory                               */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT dir_index( DIR *dj /* Directory object of the directory to be indexed */ )
+{
+	FATFS	*fs = dj->fs;
+	FRESULT res;
+	DIR		sdj;
+	BYTE	c, *dir;
+	WORD	n = 0;
+	#if _USE_LFN
+	BYTE	a, ord = 0xFF, sum = 0xFF;
+	WORD	is = 0;
+	DWORD	h = 0;
+	UINT	i, s;
+	WCHAR	wc;
+	#endif
+	fs->di_valid = 0;
+	mem_cpy( &sdj, dj, sizeof(DIR) );	/* Leave the caller's object where it is */
+	res = dir_seek( &sdj, 0 );
+	while( res == FR_OK )
+	{
+		res = move_window( fs, sdj.sect );
+		if( res != FR_OK )
+		{
+			break;
+		}
+
+		dir = sdj.dir;
+		c = dir[DIR_Name];
+		if( c == 0 )
+		{
+			res = FR_NO_FILE;
+			break;
+		}								/* Reached to end of table */
+
+	#if _USE_LFN						/* LFN configuration */
+		a = dir[DIR_Attr] & AM_MASK;
+		if( c == 0xE5 || ((a & AM_VOL) && a != AM_LFN) )
+		{								/* An entry without valid data */
+			ord = 0xFF;
+		}
+		else if( a == AM_LFN )
+		{								/* An LFN entry is found */
+			if( c & 0x40 )
+			{							/* Is it start of LFN sequence? */
+				sum = dir[LDIR_Chksum];
+				c &= 0xBF;
+				ord = c;
+				is = sdj.index;
+				h = 0;
+			}
+
+			if( c == ord && sum == dir[LDIR_Chksum] )
+			{							/* Hash the part of the LFN in the entry */
+				i = ( (dir[LDIR_Ord] & 0xBF) - 1 ) * 13;
+				for( s = 0; s < 13; s++ )
+				{
+					wc = LD_WORD( dir + LfnOfs[s] );
+					if( !wc || wc == 0xFFFF )
+					{
+						break;
+					}
+
+					h += hash_lfn_char( wc, i + s );
+				}
+
+				ord--;
+			}
+			else
+			{
+				ord = 0xFF;
+			}
+		}
+		else
+		{								/* An SFN entry is found */
+			if( n == _FS_DIR_INDEX )
+			{
+				res = FR_DENIED;		/* Too many objects to be indexed */
+				break;
+			}
+
+			if( !ord && sum == sum_sfn(dir) )
+			{
+				fs->di_idx[n] = is;
+				fs->di_hlfn[n] = hash_lfn_fold( h );
+			}
+			else
+			{
+				fs->di_idx[n] = sdj.index;
+				fs->di_hlfn[n] = 0;
+			}
+
+			fs->di_hsfn[n++] = hash_sfn( dir );
+			ord = 0xFF;
+		}
+
+	#else /* Non LFN configuration */
+		if( !(dir[DIR_Attr] & AM_VOL) )
+		{
+			if( n == _FS_DIR_INDEX )
+			{
+				res = FR_DENIED;		/* Too many objects to be indexed */
+				break;
+			}
+
+			fs->di_idx[n] = sdj.index;
+			fs->di_hsfn[n++] = hash_sfn( dir );
+		}
+
+	#endif
+		res = dir_next( &sdj, FALSE );	/* Next entry */
+	}
+
+	if( res == FR_NO_FILE )
+	{									/* Whole directory has been indexed */
+		fs->di_clust = dj->sclust;
+		fs->di_count = n;
+		fs->di_valid = 1;
+		res = FR_OK;
+	}
+
+	if( res == FR_DENIED )
+	{									/* Do not try again for every search */
+		fs->di_clust = dj->sclust;
+		fs->di_valid = 2;
+		res = FR_OK;
+	}
+
+	return res;
+}
+
+#endif
+
+/*-----------------------------------------------------------------------*/
+
+/* Directory handling - Find an object in the directory                  */
+
+/*-----------------------------------------------------------------------*/
+static FRESULT dir_find( DIR *dj /* Pointer to the directory object linked to the file name */ )
+{
+	FRESULT res;
+#if _FS_DIR_CACHE || _FS_DIR_INDEX
+	FATFS	*fs = dj->fs;
+	DWORD	hash;
+	UINT	i;
+
+	hash = hash_name( dj );
+#endif
+#if _FS_DIR_CACHE
+	for( i = 0; i < _FS_DIR_CACHE; i++ )
+	{									/* Try where the name was found last time */
+		if( fs->dc_idx[i] != 0xFFFF && fs->dc_clust[i] == dj->sclust && fs->dc_hash[i] == hash )
+		{
+			res = dir_match( dj, fs->dc_idx[i], TRUE );
+			if( res != FR_NO_FILE )
+			{
+				return res;
+			}
+
+			fs->dc_idx[i] = 0xFFFF;		/* The object is no longer there */
+			break;
+		}
+	}
+
+#endif
+#if _FS_DIR_INDEX
+	if( fs->di_valid == 1 && fs->di_clust == dj->sclust )
+	{									/* Compare only the objects with a matching hash */
+		res = FR_NO_FILE;
+		for( i = 0; i < fs->di_count && res == FR_NO_FILE; i++ )
+		{
+	#if _USE_LFN
+			if( (dj->lfn && fs->di_hlfn[i] == (WORD) (hash >> 16))
+			   || (!(dj->fn[NS] & NS_LOSS) && fs->di_hsfn[i] == (WORD) hash) )
+	#else
+			if( fs->di_hsfn[i] == (WORD) hash )
+	#endif
+			{
+				res = dir_match( dj, fs->di_idx[i], TRUE );
+			}
+		}
+	}
+	else
+	{
+		res = dir_match( dj, 0, FALSE );
+		if( (res == FR_OK || res == FR_NO_FILE) && dj->index > DIR_INDEX_MIN
+		   && !(fs->di_valid == 2 && fs->di_clust == dj->sclust) )
+		{								/* A long search, index the directory for the next time */
+			if( dir_index(dj) != FR_OK )
+			{
+				return FR_DISK_ERR;
+			}
+
+			if( res == FR_OK && move_window(fs, dj->sect) != FR_OK )
+			{							/* Reload the entry found */
+				return FR_DISK_ERR;
+			}
+		}
+	}
+
+#else
+	res = dir_match( dj, 0, FALSE );
+#endif
+#if _FS_DIR_CACHE
+	if( res == FR_OK )
+	{									/* Remember where the name was found */
+		i = fs->dc_next;
+		fs->dc_next = ( BYTE ) ( (i + 1) % _FS_DIR_CACHE );
+		fs->dc_clust[i] = dj->sclust;
+		fs->dc_hash[i] = hash;
+	#if _USE_LFN
+		fs->dc_idx[i] = ( dj->lfn_idx != 0xFFFF ) ? dj->lfn_idx : dj->index;
+	#else
+		fs->dc_idx[i] = dj->index;
+	#endif
+	}
 
+#endif
 	return res;
 }
 
@@ -1360,6 +2109,26 @@ static FRESULT dir_register
 		}
 	}
 
+		#if _FS_DIR_INDEX
+	if( res == FR_OK && dj->fs->di_valid == 1 && dj->fs->di_clust == dj->sclust )
+	{	/* Add the object to the directory index */
+		if( dj->fs->di_count < _FS_DIR_INDEX )
+		{
+			#if _USE_LFN
+			dj->fs->di_hlfn[dj->fs->di_count] = ( is != dj->index ) ? hash_lfn( dj->lfn ) : 0;
+			dj->fs->di_idx[dj->fs->di_count] = is;
+			#else
+			dj->fs->di_idx[dj->fs->di_count] = dj->index;
+			#endif
+			dj->fs->di_hsfn[dj->fs->di_count++] = hash_sfn( dj->fn );
+		}
+		else
+		{
+			dj->fs->di_valid = 2;			/* Too many objects to be indexed */
+		}
+	}
+
+		#endif
 	return res;
 }
 
@@ -1377,6 +2146,11 @@ static FRESULT dir_remove
 	)
 {
 	FRESULT res;
+		#if _FS_DIR_CACHE || _FS_DIR_INDEX
+	FATFS	*fs = dj->fs;
+	WORD	start;
+	UINT	e;
+		#endif
 		#if _USE_LFN	/* LFN configuration */
 	WORD	i;
 
@@ -1419,6 +2193,46 @@ static FRESULT dir_remove
 		}
 	}
 
+		#endif
+		#if _FS_DIR_CACHE || _FS_DIR_INDEX
+	if( res == FR_OK )
+	{
+			#if _USE_LFN
+		start = ( dj->lfn_idx == 0xFFFF ) ? dj->index : dj->lfn_idx;
+			#else
+		start = dj->index;
+			#endif
+			#if _FS_DIR_CACHE
+		for( e = 0; e < _FS_DIR_CACHE; e++ )
+		{	/* Forget where the object was found */
+			if( fs->dc_idx[e] == start && fs->dc_clust[e] == dj->sclust )
+			{
+				fs->dc_idx[e] = 0xFFFF;
+			}
+		}
+
+			#endif
+			#if _FS_DIR_INDEX
+		if( fs->di_valid == 1 && fs->di_clust == dj->sclust )
+		{	/* Take the object out of the directory index */
+			for( e = 0; e < fs->di_count; e++ )
+			{
+				if( fs->di_idx[e] == start )
+				{
+					fs->di_count--;
+					fs->di_idx[e] = fs->di_idx[fs->di_count];
+					fs->di_hsfn[e] = fs->di_hsfn[fs->di_count];
+				#if _USE_LFN
+					fs->di_hlfn[e] = fs->di_hlfn[fs->di_count];
+				#endif
+					break;
+				}
+			}
+		}
+
+			#endif
+	}
+
 		#endif
 	return res;
 }
@@ -2103,6 +2917,12 @@ FRESULT chk_mounted
 
 	/* The logical drive must be mounted. Following code attempts to mount the volume */
 	fs->fs_type = 0;		/* Clear the file system object */
+	#if _FS_CACHE_SECTORS
+	init_cache( fs );		/* Discard the sector cache */
+	#endif
+	#if _FS_DIR_CACHE || _FS_DIR_INDEX
+	init_dir_cache( fs );	/* Discard the directory cache and index */
+	#endif
 	fs->drive = ( BYTE ) LD2PD( vol );		/* Bind the logical drive and a physical drive */
 	stat = disk_initialize( fs->drive );	/* Initialize low level disk I/O layer */
 	if( stat & STA_NOINIT )
@@ -2205,6 +3025,11 @@ FRESULT chk_mounted
 	/* Initialize allocation information */
 	fs->free_clust = 0xFFFFFFFF;
 	fs->wflag = 0;
+		#if _FS_FREE_SCAN
+	fs->last_clust = 0;
+	fs->fscan_clust = 2;	/* Start the free cluster count */
+	fs->fscan_free = 0;
+		#endif
 
 	/* Get fsinfo if needed */
 	if( fmt == FS_FAT32 )
@@ -2302,6 +3127,9 @@ FRESULT f_mount
 	if( fs )
 	{
 		fs->fs_type = 0;	/* Clear new fs object */
+		#if _FS_CACHE_SECTORS
+		init_cache( fs );
+		#endif
 		#if _FS_REENTRANT	/* Create sync object for the new volume */
 		if( !ff_cre_syncobj(vol, &fs->sobj) )
 		{
@@ -2454,6 +3282,16 @@ FRESULT f_open
 	fp->fptr = 0;
 	fp->csect = 255;	/* File pointer */
 	fp->dsect = 0;
+	#if _USE_FASTSEEK
+	fp->cltbl = 0;	/* No cluster link map until the application creates one */
+	#endif
+	#if _FS_FILE_LOCK
+	if( !ff_cre_syncobj(dj.fs->drive, &fp->sobj) )
+	{
+		LEAVE_FF( dj.fs, FR_INT_ERR );
+	}
+
+	#endif
 	fp->fs = dj.fs;
 	fp->id = dj.fs->id; /* Owner file system object of the file */
 
@@ -2462,6 +3300,56 @@ FRESULT f_open
 
 /*-----------------------------------------------------------------------*/
 
+/* Extend a direct transfer over contiguous clusters                     */
+
+/*-----------------------------------------------------------------------*/
+static UINT contig_sects
+	(				/* Number of sectors that can be transferred from the current sector */
+		FIL *fp,	/* Pointer to the file object, left at the last sector to be transferred */
+		UINT cc,	/* Number of whole sectors wanted */
+		BOOL streach	/* FALSE: Follow the cluster chain, TRUE: Streach the chain if needed */
+	)
+{
+	FATFS	*fs = fp->fs;
+	DWORD	clst, nclst;
+	UINT	n;
+
+	if( cc > 255 )
+	{				/* disk_read() and disk_write() take a BYTE count */
+		cc = 255;
+	}
+
+	n = fs->csize - fp->csect;	/* Sectors left in the current cluster */
+	clst = fp->curr_clust;
+	while( n < cc )
+	{				/* Take in following clusters while they are contiguous */
+		#if !_FS_READONLY
+		nclst = streach ? create_chain( fs, clst ) : get_fat( fs, clst );
+		#else
+		nclst = get_fat( fs, clst );
+		#endif
+		if( nclst != clst + 1 || nclst >= fs->max_clust )
+		{			/* Not contiguous, end of chain or error, which the caller finds on the next cluster */
+			break;
+		}
+
+		clst = nclst;
+		n += fs->csize;
+	}
+
+	if( cc > n )
+	{
+		cc = n;
+	}
+
+	fp->curr_clust = clst;
+	fp->csect = ( BYTE ) ( fs->csize - (n - cc) );	/* Next sector address in the last cluster */
+
+	return cc;
+}
+
+/*-----------------------------------------------------------------------*/
+
 /* Read File                                                             */
 
 /*-----------------------------------------------------------------------*/
@@ -2480,20 +3368,21 @@ FRESULT f_read
 
 	*br = 0;	/* Initialize bytes read */
 
+	ENTER_FP( fp );
 	res = validate( fp->fs, fp->id );	/* Check validity of the object */
 	if( res != FR_OK )
 	{
-		LEAVE_FF( fp->fs, res );
+		LEAVE_FP( fp, res );
 	}
 
 	if( fp->flag & FA__ERROR )
 	{	/* Check abort flag */
-		LEAVE_FF( fp->fs, FR_INT_ERR );
+		LEAVE_FP( fp, FR_INT_ERR );
 	}
 
 	if( !(fp->flag & FA_READ) )
 	{	/* Check access mode */
-		LEAVE_FF( fp->fs, FR_DENIED );
+		LEAVE_FP( fp, FR_DENIED );
 	}
 
 	remain = fp->fsize - fp->fptr;
@@ -2534,12 +3423,8 @@ FRESULT f_read
 			cc = btr / SS( fp->fs );						/* When remaining bytes >= sector size, */
 			if( cc )
 			{		/* Read maximum contiguous sectors directly */
-				if( fp->csect + cc > fp->fs->csize )
-				{	/* Clip at cluster boundary */
-					cc = fp->fs->csize - fp->csect;
-				}
-
-				if( disk_read(fp->fs->drive, rbuff, sect, (BYTE) cc) != RES_OK )
+				cc = contig_sects( fp, cc, FALSE );	/* Clip at the end of the contiguous clusters */
+				if( READ_DATA( fp, rbuff, sect, (BYTE) cc ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2559,7 +3444,6 @@ FRESULT f_read
 
 					#endif
 				#endif
-				fp->csect += ( BYTE ) cc;	/* Next sector address in the cluster */
 				rcnt = SS( fp->fs ) * cc;	/* Number of bytes transferred */
 				continue;
 			}
@@ -2568,7 +3452,7 @@ FRESULT f_read
 				#if !_FS_READONLY
 			if( fp->flag & FA__DIRTY )
 			{				/* Write sector I/O buffer if needed */
-				if( disk_write(fp->fs->drive, fp->buf, fp->dsect, 1) != RES_OK )
+				if( WRITE_DATA( fp, fp->buf, fp->dsect, 1 ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2579,7 +3463,7 @@ FRESULT f_read
 				#endif
 			if( fp->dsect != sect )
 			{				/* Fill sector buffer with file data */
-				if( disk_read(fp->fs->drive, fp->buf, sect, 1) != RES_OK )
+				if( READ_DATA( fp, fp->buf, sect, 1 ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2608,7 +3492,7 @@ FRESULT f_read
 		#endif
 	}
 
-	LEAVE_FF( fp->fs, FR_OK );
+	LEAVE_FP( fp, FR_OK );
 }
 
 #if !_FS_READONLY
@@ -2633,20 +3517,21 @@ FRESULT f_write
 
 	*bw = 0;	/* Initialize bytes written */
 
+	ENTER_FP( fp );
 	res = validate( fp->fs, fp->id );	/* Check validity of the object */
 	if( res != FR_OK )
 	{
-		LEAVE_FF( fp->fs, res );
+		LEAVE_FP( fp, res );
 	}
 
 	if( fp->flag & FA__ERROR )
 	{				/* Check abort flag */
-		LEAVE_FF( fp->fs, FR_INT_ERR );
+		LEAVE_FP( fp, FR_INT_ERR );
 	}
 
 	if( !(fp->flag & FA_WRITE) )
 	{				/* Check access mode */
-		LEAVE_FF( fp->fs, FR_DENIED );
+		LEAVE_FP( fp, FR_DENIED );
 	}
 
 	if( fp->fsize + btw < fp->fsize )
@@ -2701,7 +3586,7 @@ FRESULT f_write
 				#else
 			if( fp->flag & FA__DIRTY )
 			{	/* Write back data buffer prior to following direct transfer */
-				if( disk_write(fp->fs->drive, fp->buf, fp->dsect, 1) != RES_OK )
+				if( WRITE_DATA( fp, fp->buf, fp->dsect, 1 ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2720,12 +3605,8 @@ FRESULT f_write
 			cc = btw / SS( fp->fs );						/* When remaining bytes >= sector size, */
 			if( cc )
 			{		/* Write maximum contiguous sectors directly */
-				if( fp->csect + cc > fp->fs->csize )
-				{	/* Clip at cluster boundary */
-					cc = fp->fs->csize - fp->csect;
-				}
-
-				if( disk_write(fp->fs->drive, wbuff, sect, (BYTE) cc) != RES_OK )
+				cc = contig_sects( fp, cc, TRUE );	/* Clip at the end of the contiguous clusters */
+				if( WRITE_DATA( fp, wbuff, sect, (BYTE) cc ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2745,7 +3626,6 @@ FRESULT f_write
 				}
 
 					#endif
-				fp->csect += ( BYTE ) cc;	/* Next sector address in the cluster */
 				wcnt = SS( fp->fs ) * cc;	/* Number of bytes transferred */
 				continue;
 			}
@@ -2764,7 +3644,7 @@ FRESULT f_write
 				#else
 			if( fp->dsect != sect )
 			{				/* Fill sector buffer with file data */
-				if( fp->fptr < fp->fsize && disk_read(fp->fs->drive, fp->buf, sect, 1) != RES_OK )
+				if( fp->fptr < fp->fsize && READ_DATA( fp, fp->buf, sect, 1 ) != RES_OK )
 				{
 					ABORT( fp->fs, FR_DISK_ERR );
 				}
@@ -2802,7 +3682,7 @@ FRESULT f_write
 
 	fp->flag |= FA__WRITTEN;	/* Set file changed flag */
 
-	LEAVE_FF( fp->fs, FR_OK );
+	LEAVE_FP( fp, FR_OK );
 }
 
 /*-----------------------------------------------------------------------*/
@@ -2816,6 +3696,7 @@ FRESULT f_sync( FIL *fp /* Pointer to the file object */ )
 	DWORD	tim;
 	BYTE	*dir;
 
+	ENTER_FP( fp );
 	res = validate( fp->fs, fp->id );	/* Check validity of the object */
 	if( res == FR_OK )
 	{
@@ -2826,7 +3707,7 @@ FRESULT f_sync( FIL *fp /* Pointer to the file object */ )
 			{
 				if( disk_write(fp->fs->drive, fp->buf, fp->dsect, 1) != RES_OK )
 				{
-					LEAVE_FF( fp->fs, FR_DISK_ERR );
+					LEAVE_FP( fp, FR_DISK_ERR );
 				}
 
 				fp->flag &= ~FA__DIRTY;
@@ -2852,7 +3733,7 @@ FRESULT f_sync( FIL *fp /* Pointer to the file object */ )
 		}
 	}
 
-	LEAVE_FF( fp->fs, res );
+	LEAVE_FP( fp, res );
 }
 
 #endif /* !_FS_READONLY */
@@ -2870,6 +3751,9 @@ FRESULT f_close( FIL *fp /* Pointer to the file object to be closed */ )
 	res = validate( fp->fs, fp->id );
 	if( res == FR_OK )
 	{
+		#if _FS_FILE_LOCK
+		ff_del_syncobj( fp->sobj );
+		#endif
 		fp->fs = NULL;
 	}
 
@@ -2878,6 +3762,9 @@ FRESULT f_close( FIL *fp /* Pointer to the file object to be closed */ )
 	res = f_sync( fp );
 	if( res == FR_OK )
 	{
+		#if _FS_FILE_LOCK
+		ff_del_syncobj( fp->sobj );	/* Delete the file sync object */
+		#endif
 		fp->fs = NULL;
 	}
 
@@ -2952,23 +3839,115 @@ FRESULT f_chdir( const XCHAR *path /* Pointer to the directory path */ )
 
 /* Seek File R/W Pointer                                                 */
 
+/*-----------------------------------------------------------------------*/
+#if _USE_FASTSEEK
+static FRESULT create_linkmap ( FIL *fp /* Pointer to the file object */ )
+{
+	DWORD	clst, pclst, ncl, scl, *tbl, tlen, ulen;
+
+	tbl = fp->cltbl;
+	tlen = *tbl++;	/* Table size in items */
+	ulen = 2;		/* Number of items used (size and terminator) */
+	clst = fp->org_clust;
+	if( clst )
+	{
+		do
+		{			/* Store each run of consecutive clusters */
+			scl = clst;
+			ncl = 0;
+			do
+			{
+				pclst = clst;
+				ncl++;
+				clst = get_fat( fp->fs, clst );
+				if( clst == 0xFFFFFFFF )
+				{
+					return FR_DISK_ERR;
+				}
+
+				if( clst <= 1 )
+				{
+					return FR_INT_ERR;
+				}
+			} while( clst == pclst + 1 );
+
+			ulen += 2;
+			if( ulen <= tlen )
+			{
+				*tbl++ = ncl;
+				*tbl++ = scl;
+			}
+		} while( clst < fp->fs->max_clust );	/* Repeat until the end of the chain */
+	}
+
+	if( ulen > tlen )
+	{		/* Report the required table size */
+		*fp->cltbl = ulen;
+		return FR_NOT_ENOUGH_CORE;
+	}
+
+	*tbl = 0;	/* Terminate the table */
+	return FR_OK;
+}
+
+/*-----------------------------------------------------------------------*/
+static DWORD clmt_clust ( FIL *fp, /* Pointer to the file object */ DWORD cl /* Cluster index in the file */ ) /* 0:Not in the map, >=2:Cluster number */
+{
+	DWORD	ncl, *tbl;
+
+	tbl = fp->cltbl + 1;	/* Skip the table size */
+	while( (ncl = *tbl++) != 0 )
+	{
+		if( cl < ncl )
+		{
+			return cl + *tbl;
+		}
+
+		cl -= ncl;
+		tbl++;
+	}
+
+	return 0;
+}
+
+#endif
+
 /*-----------------------------------------------------------------------*/
 FRESULT f_lseek( FIL *fp, /* Pointer to the file object */ DWORD ofs /* File pointer from top of file */ )
 {
 	FRESULT res;
 	DWORD	clst, bcs, nsect, ifptr;
 
+	ENTER_FP( fp );
 	res = validate( fp->fs, fp->id );	/* Check validity of the object */
 	if( res != FR_OK )
 	{
-		LEAVE_FF( fp->fs, res );
+		LEAVE_FP( fp, res );
 	}
 
 	if( fp->flag & FA__ERROR )
 	{					/* Check abort flag */
-		LEAVE_FF( fp->fs, FR_INT_ERR );
+		LEAVE_FP( fp, FR_INT_ERR );
+	}
+
+	#if _USE_FASTSEEK
+	if( ofs == CREATE_LINKMAP )
+	{					/* Create the cluster link map, the file pointer is not moved */
+		if( !fp->cltbl )
+		{
+			LEAVE_FP( fp, FR_INVALID_OBJECT );
+		}
+
+		res = create_linkmap( fp );
+		if( res == FR_DISK_ERR || res == FR_INT_ERR )
+		{
+			ABORT( fp->fs, res );
+		}
+
+		LEAVE_FP( fp, res );
 	}
 
+	#endif
 	if( ofs > fp->fsize /* In read-only mode, clip offset with the file size */
 		#if !_FS_READONLY
 	&& !(fp->flag & FA_WRITE)
@@ -2984,6 +3963,15 @@ FRESULT f_lseek( FIL *fp, /* Pointer to the file object */ DWORD ofs /* File poi
 	if( ofs > 0 )
 	{
 		bcs = ( DWORD ) fp->fs->csize * SS( fp->fs );	/* Cluster size (byte) */
+		#if _USE_FASTSEEK
+		if( fp->cltbl && (clst = clmt_clust(fp, (ofs - 1) / bcs)) != 0 )
+		{	/* When the link map holds the target cluster, take it from there */
+			fp->fptr = ( ofs - 1 ) &~( bcs - 1 );
+			ofs -= fp->fptr;
+			fp->curr_clust = clst;
+		}
+		else
+		#endif
 		if( ifptr > 0 && (ofs - 1) / bcs >= (ifptr - 1) / bcs )
 		{	/* When seek to same or following cluster, */
 			fp->fptr = ( ifptr - 1 ) &~( bcs - 1 ); /* start from the current cluster */
@@ -3094,7 +4082,7 @@ FRESULT f_lseek( FIL *fp, /* Pointer to the file object */ DWORD ofs /* File poi
 	}
 
 		#endif
-	LEAVE_FF( fp->fs, res );
+	LEAVE_FP( fp, res );
 }
 
 	#if _FS_MINIMIZE <= 1
@@ -3331,11 +4319,43 @@ FRESULT f_getfree
 		( *fatfs )->fsi_flag = 1;
 	}
 
+				#if _FS_FREE_SCAN
+	( *fatfs )->fscan_clust = 0;	/* A background count is no longer needed */
+				#endif
 	*nclst = n;
 
 	LEAVE_FF( *fatfs, FR_OK );
 }
 
+				#if _FS_FREE_SCAN
+
+/*-----------------------------------------------------------------------*/
+
+/* Count Free Clusters a Slice at a Time                                 */
+
+/*-----------------------------------------------------------------------*/
+FRESULT f_scanfree
+		(
+			const XCHAR *path,	/* Pointer to the logical drive number (root dir) */
+			DWORD		nent,	/* Number of FAT entries to count in this call */
+			DWORD		*nleft	/* Pointer to the variable to return number of FAT entries left to count (0:completed) */
+		)
+{
+	FRESULT res;
+	FATFS	*fs;
+
+	res = chk_mounted( &path, &fs, 0 );
+	if( res == FR_OK )
+	{
+		res = scan_free( fs, nent );
+		*nleft = fs->fscan_clust ? fs->max_clust - fs->fscan_clust : 0;
+	}
+
+	LEAVE_FF( fs, res );
+}
+
+				#endif
+
 /*-----------------------------------------------------------------------*/
 
 /* Truncate File                                                         */
@@ -3346,26 +4366,30 @@ FRESULT f_truncate( FIL *fp /* Pointer to the file object */ )
 	FRESULT res;
 	DWORD	ncl;
 
+	ENTER_FP( fp );
 	res = validate( fp->fs, fp->id );	/* Check validity of the object */
 	if( res != FR_OK )
 	{
-		LEAVE_FF( fp->fs, res );
+		LEAVE_FP( fp, res );
 	}
 
 	if( fp->flag & FA__ERROR )
 	{	/* Check abort flag */
-		LEAVE_FF( fp->fs, FR_INT_ERR );
+		LEAVE_FP( fp, FR_INT_ERR );
 	}
 
 	if( !(fp->flag & FA_WRITE) )
 	{	/* Check access mode */
-		LEAVE_FF( fp->fs, FR_DENIED );
+		LEAVE_FP( fp, FR_DENIED );
 	}
 
 	if( fp->fsize > fp->fptr )
 	{
 		fp->fsize = fp->fptr;	/* Set file size to current R/W point */
 		fp->flag |= FA__WRITTEN;
+		#if _USE_FASTSEEK
+		fp->cltbl = 0;			/* The link map would hold removed clusters */
+		#endif
 		if( fp->fptr == 0 )
 		{						/* When set file size to zero, remove entire cluster chain */
 			res = remove_chain( fp->fs, fp->org_clust );
@@ -3401,9 +4425,143 @@ FRESULT f_truncate( FIL *fp /* Pointer to the file object */ )
 		fp->flag |= FA__ERROR;
 	}
 
-	LEAVE_FF( fp->fs, res );
+	LEAVE_FP( fp, res );
+}
+
+				#if _USE_EXPAND
+
+/*-----------------------------------------------------------------------*/
+
+/* Allocate a Contiguous Cluster Block to the File                       */
+
+/*-----------------------------------------------------------------------*/
+FRESULT f_expand( FIL *fp, /* Pointer to the file object */ DWORD fsz, /* File size to be expanded to */ BYTE opt /* 0:Find the block only, 1:Allocate it now */ )
+{
+	FRESULT res;
+	DWORD	bcs, tcl, scl, clst, stcl, ncl, val;
+
+	ENTER_FP( fp );
+	res = validate( fp->fs, fp->id );	/* Check validity of the object */
+	if( res != FR_OK )
+	{
+		LEAVE_FP( fp, res );
+	}
+
+	if( fp->flag & FA__ERROR )
+	{	/* Check abort flag */
+		LEAVE_FP( fp, FR_INT_ERR );
+	}
+
+	if( !(fp->flag & FA_WRITE) || fsz == 0 || fp->fsize != 0 || fp->org_clust != 0 )
+	{	/* Check access mode and that the file is empty */
+		LEAVE_FP( fp, FR_DENIED );
+	}
+
+	bcs = ( DWORD ) fp->fs->csize * SS( fp->fs );	/* Cluster size (byte) */
+	tcl = ( fsz - 1 ) / bcs + 1;					/* Number of clusters required */
+	if( tcl > fp->fs->max_clust - 2 )
+	{
+		LEAVE_FP( fp, FR_DENIED );
+	}
+
+	/* Search for a run of tcl free clusters, starting next to the last allocation */
+	stcl = fp->fs->last_clust + 1;
+	if( stcl < 2 || stcl >= fp->fs->max_clust )
+	{
+		stcl = 2;
+	}
+
+	scl = clst = stcl;
+	ncl = 0;
+	for( ;; )
+	{
+		val = get_fat( fp->fs, clst );
+		if( val == 0xFFFFFFFF )
+		{
+			ABORT( fp->fs, FR_DISK_ERR );
+		}
+
+		if( val == 1 )
+		{
+			ABORT( fp->fs, FR_INT_ERR );
+		}
+
+		if( ++clst >= fp->fs->max_clust )
+		{	/* Wrap around, a run cannot span the end of the volume */
+			clst = 2;
+			if( val == 0 && ncl + 1 == tcl )
+			{
+				break;
+			}
+
+			scl = 2;
+			ncl = 0;
+		}
+		else if( val == 0 )
+		{
+			if( ++ncl == tcl )
+			{
+				break;		/* Found a contiguous free block */
+			}
+		}
+		else
+		{
+			scl = clst;		/* The run restarts after this cluster */
+			ncl = 0;
+		}
+
+		if( clst == stcl )
+		{
+			LEAVE_FP( fp, FR_DENIED );	/* No contiguous block large enough */
+		}
+	}
+
+	if( opt )
+	{	/* Link the block into a chain and give it to the file */
+		for( clst = scl; clst < scl + tcl - 1; clst++ )
+		{
+			res = put_fat( fp->fs, clst, clst + 1 );
+			if( res != FR_OK )
+			{
+				ABORT( fp->fs, res );
+			}
+		}
+
+		res = put_fat( fp->fs, clst, 0x0FFFFFFF );
+		if( res != FR_OK )
+		{
+			ABORT( fp->fs, res );
+		}
+
+		fp->fs->last_clust = clst;
+		if( fp->fs->free_clust != 0xFFFFFFFF )
+		{
+			fp->fs->free_clust -= tcl;
+			fp->fs->fsi_flag = 1;
+		}
+
+					#if _FS_FREE_SCAN
+		if( scl < fp->fs->fscan_clust )
+		{	/* Uncount the part of the block already passed by the free cluster count */
+			fp->fs->fscan_free -= ( ( fp->fs->fscan_clust < scl + tcl ) ? fp->fs->fscan_clust : scl + tcl ) - scl;
+		}
+
+					#endif
+
+		fp->org_clust = scl;
+		fp->fsize = fsz;
+		fp->flag |= FA__WRITTEN;
+	}
+	else
+	{	/* Make the next allocation start at the block */
+		fp->fs->last_clust = scl - 1;
+	}
+
+	LEAVE_FP( fp, FR_OK );
 }
 
+				#endif /* _USE_EXPAND */
+
 /*-----------------------------------------------------------------------*/
 
 /* Delete a File or Directory                                            */
@@ -3481,6 +4639,9 @@ FRESULT f_unlink( const XCHAR *path /* Pointer to the file or directory path */
 	{
 		if( dclst )
 		{
+	#if _FS_DIR_CACHE || _FS_DIR_INDEX
+			dir_forget( dj.fs, dclst );			/* The cluster may be reused for another directory */
+	#endif
 			res = remove_chain( dj.fs, dclst ); /* Remove the cluster chain */
 		}
 
@@ -3591,6 +4752,13 @@ FRESULT f_mkdir( const XCHAR *path /* Pointer to the directory path */ )
 		mem_set( dir, 0, SS(dj.fs) );
 	}
 
+	#if _FS_CACHE_SECTORS
+	dj.fs->winsect = 0;					/* The window was cleared after its last write */
+	clear_cache( dj.fs, dsect - n, n );	/* Drop stale copies of the cluster */
+	#endif
+	#if _FS_DIR_CACHE || _FS_DIR_INDEX
+	dir_forget( dj.fs, dclst );			/* Forget the directory the cluster used to hold */
+	#endif
 	res = dir_register( &dj );
 	if( res != FR_OK )
 	{
@@ -3884,7 +5052,7 @@ FRESULT f_forward
 		rcnt = ( *func ) ( &fp->fs->win[(WORD) fp->fptr % SS(fp->fs)], rcnt );
 		if( !rcnt )
 		{
-			ABORT( fp->fs, FR_INT_ERR );
+			break;	/* The stream could not take the data after all, leave it for the next call */
 		}
 	}
 
@@ -3941,6 +5109,9 @@ FRESULT f_mkfs
 	}
 
 	fs->fs_type = 0;
+	#if _FS_CACHE_SECTORS
+	init_cache( fs );
+	#endif
 	drv = LD2PD( drv );
 
 	/* Get disk statics */
@@ -285,6 +285,127 @@ const PARTITION Drives[];			/* Logical drive# to physical location conversion ta
 
 
 
+/* Number of FAT and directory sectors kept in the file system object in
+/  addition to the window. 0 keeps the single sector window. The least recently
+/  used sector is evicted, and written back if dirty, when a sector that is not
+/  cached is moved into the window. Dirty sectors are otherwise written back
+/  when the volume is synchronized (f_sync(), f_close(), f_mkdir()...).
+/  Not available with _FS_TINY, which passes file data through the window. */
+
+#ifndef _FS_CACHE_SECTORS
+#define _FS_CACHE_SECTORS	0
+#endif
+
+#if _FS_CACHE_SECTORS && _FS_TINY
+#error The sector cache cannot be used with _FS_TINY.
+#endif
+
+#if _FS_CACHE_SECTORS > 255
+#error Number of cached sectors must be 0-255.
+#endif
+
+
+
+/* To enable fast seek, set _USE_FASTSEEK to 1. The application then points
+/  FIL.cltbl at a DWORD array whose first item holds the array size in items,
+/  and calls f_lseek(fp, CREATE_LINKMAP) after f_open(). The cluster chain of
+/  the file is stored in the array as (run length, first cluster) pairs ended
+/  with a zero, and later seeks are resolved from it without reading the FAT.
+/  When the array is too small, FR_NOT_ENOUGH_CORE is returned and the first
+/  item is set to the required size. Seeks beyond the mapped clusters, after
+/  the file has been extended, follow the FAT as usual. f_truncate() clears
+/  FIL.cltbl because the map no longer matches the chain. */
+
+#ifndef _USE_FASTSEEK
+#define _USE_FASTSEEK	0
+#endif
+
+
+
+/* To enable f_expand(), set _USE_EXPAND to 1. f_expand() gives an empty file
+/  a contiguous run of clusters large enough for the requested size, so later
+/  writes never search the FAT and the data can be read back sequentially. */
+
+#ifndef _USE_EXPAND
+#define _USE_EXPAND	0
+#endif
+
+
+
+/* To let tasks that work on different files overlap their data transfers,
+/  set _FS_FILE_LOCK to 1. Each open file gets a sync object of its own from
+/  ff_cre_syncobj(), which serialises the file functions on that file. The
+/  volume lock is then only held for FAT and directory access, and is released
+/  while file data moves between the disk and the file or application buffer,
+/  so the disk driver must accept calls from several tasks at a time. Every
+/  opened file must be closed to delete its sync object. */
+
+#ifndef _FS_FILE_LOCK
+#define _FS_FILE_LOCK	0
+#endif
+
+#if _FS_FILE_LOCK && (!_FS_REENTRANT || _FS_TINY)
+#error _FS_FILE_LOCK needs _FS_REENTRANT and cannot be used with _FS_TINY.
+#endif
+
+
+
+/* Number of recently found directory entries remembered by each file system
+/  object, keyed by the directory and a hash of the name. 0 disables the
+/  lookup cache. A remembered entry is checked against the name before it is
+/  used, and the directory is searched as usual when it no longer matches, so
+/  a lookup never reads more than the sectors holding the object. Entries are
+/  forgotten when the object is removed or its directory deleted or created. */
+
+#ifndef _FS_DIR_CACHE
+#define _FS_DIR_CACHE	0
+#endif
+
+#if _FS_DIR_CACHE > 255
+#error Number of directory cache entries must be 0-255.
+#endif
+
+
+
+/* Number of objects that can be held in the in-RAM directory index of each
+/  file system object. 0 disables the index. The first time a search has to
+/  pass more than DIR_INDEX_MIN entries of a directory, a hash of the name of
+/  every object in it is built into the index. Later searches of that
+/  directory, including the checks for an existing name when an object is
+/  created, read only the sectors of objects whose hash matches. The index
+/  holds one directory at a time, and is dropped when the directory grows
+/  beyond _FS_DIR_INDEX objects. Each object takes 6 bytes (4 bytes without
+/  LFN). */
+
+#ifndef _FS_DIR_INDEX
+#define _FS_DIR_INDEX	0
+#endif
+
+#if _FS_DIR_INDEX > 0xFFFF
+#error Number of directory index entries must be 0-65535.
+#endif
+
+
+
+/* To count the free clusters in the background, set _FS_FREE_SCAN to 1. Each
+/  mount starts a count that f_scanfree() advances by a given number of FAT
+/  entries per call, so a low priority task can count a large volume in slices
+/  without holding the volume lock for long. Clusters allocated or freed while
+/  the count is running are accounted for. When it completes, the count
+/  replaces the one read from the FSInfo sector, and f_getfree() returns it
+/  without reading the FAT. The first free cluster found also becomes the
+/  allocation start point if the FSInfo sector did not give one. */
+
+#ifndef _FS_FREE_SCAN
+#define _FS_FREE_SCAN	0
+#endif
+
+#if _FS_FREE_SCAN && _FS_READONLY
+#error _FS_FREE_SCAN cannot be used with _FS_READONLY.
+#endif
+
+
+
 /* Type of file name on FatFs API */
 
 #if _LFN_UNICODE && _USE_LFN
@@ -317,6 +438,10 @@ typedef struct _FATFS_ {
 	DWORD	free_clust;	/* Number of free clusters */
 	DWORD	fsi_sector;	/* fsinfo sector */
 #endif
+#if _FS_FREE_SCAN
+	DWORD	fscan_clust;	/* Next cluster to be counted by f_scanfree() (0:count completed) */
+	DWORD	fscan_free;	/* Number of free clusters below fscan_clust */
+#endif
 #if _FS_RPATH
 	DWORD	cdir;		/* Current directory (0:root)*/
 #endif
@@ -327,6 +452,28 @@ typedef struct _FATFS_ {
 	DWORD	database;	/* Data start sector */
 	DWORD	winsect;	/* Current sector appearing in the win[] */
 	BYTE	win[_MAX_SS];/* Disk access window for Directory/FAT */
+#if _FS_CACHE_SECTORS
+	BYTE	clru[_FS_CACHE_SECTORS];	/* Cache entry indexes, most recently used first */
+	BYTE	cflag[_FS_CACHE_SECTORS];	/* Cache entry dirty flags */
+	DWORD	csect[_FS_CACHE_SECTORS];	/* Sector held by each cache entry (0:empty) */
+	BYTE	cbuf[_FS_CACHE_SECTORS][_MAX_SS];	/* FAT/Directory sectors recently moved out of the win[] */
+#endif
+#if _FS_DIR_CACHE
+	BYTE	dc_next;	/* Directory cache entry to be replaced next */
+	WORD	dc_idx[_FS_DIR_CACHE];	/* Index of the first entry of the object (0xFFFF:unused) */
+	DWORD	dc_clust[_FS_DIR_CACHE];	/* Directory holding the object */
+	DWORD	dc_hash[_FS_DIR_CACHE];	/* Hash of the name found */
+#endif
+#if _FS_DIR_INDEX
+	BYTE	di_valid;	/* 1:di_clust is indexed, 2:di_clust has too many objects to be indexed */
+	WORD	di_count;	/* Number of objects in the index */
+	DWORD	di_clust;	/* Indexed directory */
+	WORD	di_idx[_FS_DIR_INDEX];	/* Index of the first entry of each object */
+	WORD	di_hsfn[_FS_DIR_INDEX];	/* Hash of the SFN of each object */
+#if _USE_LFN
+	WORD	di_hlfn[_FS_DIR_INDEX];	/* Hash of the LFN of each object (0:no LFN) */
+#endif
+#endif
 } FATFS;
 
 
@@ -366,6 +513,12 @@ typedef struct _FIL_ {
 	DWORD	dir_sect;	/* Sector containing the directory entry */
 	BYTE*	dir_ptr;	/* Ponter to the directory entry in the window */
 #endif
+#if _USE_FASTSEEK
+	DWORD*	cltbl;		/* Pointer to the cluster link map table (0:not used) */
+#endif
+#if _FS_FILE_LOCK
+	_SYNC_t	sobj;		/* Identifier of the file sync object */
+#endif
 #if !_FS_TINY
 	BYTE	buf[_MAX_SS];/* File R/W buffer */
 #endif
@@ -407,7 +560,8 @@ typedef enum {
 	FR_NOT_ENABLED,		/* 12 */
 	FR_NO_FILESYSTEM,	/* 13 */
 	FR_MKFS_ABORTED,	/* 14 */
-	FR_TIMEOUT			/* 15 */
+	FR_TIMEOUT,			/* 15 */
+	FR_NOT_ENOUGH_CORE	/* 16 */
 } FRESULT;
 
 
@@ -425,7 +579,9 @@ FRESULT f_opendir (DIR*, const XCHAR*);				/* Open an existing directory */
 FRESULT f_readdir (DIR*, FILINFO*);					/* Read a directory item */
 FRESULT f_stat (const XCHAR*, FILINFO*);			/* Get file status */
 FRESULT f_getfree (const XCHAR*, DWORD*, FATFS**);	/* Get number of free clusters on the drive */
+FRESULT f_scanfree (const XCHAR*, DWORD, DWORD*);	/* Count the free clusters a slice at a time */
 FRESULT f_truncate (FIL*);							/* Truncate file */
+FRESULT f_expand (FIL*, DWORD, BYTE);				/* Allocate a contiguous cluster block to the file */
 FRESULT f_sync (FIL*);								/* Flush cached data of a writing file */
 FRESULT f_unlink (const XCHAR*);					/* Delete an existing file or directory */
 FRESULT	f_mkdir (const XCHAR*);						/* Create a new directory */
@@ -495,6 +651,11 @@ void ff_rel_grant(_SYNC_t);
 #define FA__ERROR			0x80
 
 
+/* Offset given to f_lseek() to create the cluster link map (_USE_FASTSEEK) */
+
+#define CREATE_LINKMAP		0xFFFFFFFF
+
+
 /* FAT sub type (FATFS.fs_type) */
 
 #define FS_FAT12	1
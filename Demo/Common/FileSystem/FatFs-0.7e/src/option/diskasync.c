@@ -0,0 +1,335 @@
+/*------------------------------------------------------------------------*/
+/* Asynchronous block device layer and double buffered file writer        */
+/* for FatFs R0.07e on FreeRTOS                                           */
+/*------------------------------------------------------------------------*/
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+
+#include "diskasync.h"
+
+/* A buffer handed from xFileWriterCommit() to the writer task. */
+typedef struct xWRITER_JOB
+{
+	xFileWriter	*pxWriter;
+	BYTE		*pucData;
+	UINT		uxBytes;
+} xWriterJob;
+
+static xQueueHandle xIORequests = NULL;			/* xDiskRequest pointers for the I/O task */
+static xQueueHandle xWriterJobs = NULL;			/* xWriterJob items for the writer task */
+static xSemaphoreHandle xTransferDone = NULL;	/* Given by the driver interrupt */
+static volatile DRESULT xTransferResult;		/* Result reported with xTransferDone */
+static xSemaphoreHandle xSyncMutex = NULL;		/* Serialises the disk_read()/disk_write() callers */
+static xSemaphoreHandle xSyncDone = NULL;		/* Completion of a disk_read()/disk_write() request */
+
+static void prvIOTask( void *pvParameters );
+static void prvWriterTask( void *pvParameters );
+
+
+
+/*------------------------------------------------------------------------*/
+/* Start the tasks                                                        */
+/*------------------------------------------------------------------------*/
+
+portBASE_TYPE xDiskAsyncInit( unsigned portBASE_TYPE uxPriority )
+{
+	if( xIORequests != NULL )
+	{
+		return pdPASS;
+	}
+
+	xIORequests = xQueueCreate( diskasyncQUEUE_LENGTH, sizeof( xDiskRequest * ) );
+	xWriterJobs = xQueueCreate( diskasyncQUEUE_LENGTH, sizeof( xWriterJob ) );
+	vSemaphoreCreateBinary( xTransferDone );
+	vSemaphoreCreateBinary( xSyncDone );
+	xSyncMutex = xSemaphoreCreateMutex();
+
+	if( xIORequests == NULL || xWriterJobs == NULL || xTransferDone == NULL || xSyncDone == NULL || xSyncMutex == NULL )
+	{
+		return pdFAIL;
+	}
+
+	/* Both binary semaphores are created available, they must start empty. */
+	xSemaphoreTake( xTransferDone, 0 );
+	xSemaphoreTake( xSyncDone, 0 );
+
+	if( xTaskCreate( prvIOTask, ( signed char * ) "DiskIO", diskasyncIO_STACK_SIZE, NULL, uxPriority, NULL ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	/* The writer task calls f_write(), which waits on the I/O task, so it
+	runs one priority level below it. */
+	return xTaskCreate( prvWriterTask, ( signed char * ) "DiskWr", diskasyncWRITER_STACK_SIZE, NULL, ( uxPriority > tskIDLE_PRIORITY ) ? uxPriority - 1 : uxPriority, NULL );
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Queue a Request to the I/O Task                                        */
+/*------------------------------------------------------------------------*/
+
+portBASE_TYPE xDiskAsyncSubmit( xDiskRequest *pxRequest, portTickType xTicksToWait )
+{
+	return xQueueSend( xIORequests, &pxRequest, xTicksToWait );
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* End of Transfer, called from the Driver Interrupt                      */
+/*------------------------------------------------------------------------*/
+
+void vDiskAsyncTransferDoneFromISR( DRESULT xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+	xTransferResult = xResult;
+	xSemaphoreGiveFromISR( xTransferDone, pxHigherPriorityTaskWoken );
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* I/O Task                                                               */
+/*------------------------------------------------------------------------*/
+
+static void prvIOTask( void *pvParameters )
+{
+	xDiskRequest *pxRequest;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xIORequests, &pxRequest, portMAX_DELAY ) != pdPASS )
+		{
+			continue;
+		}
+
+		if( pxRequest->ucCount == 0 )
+		{
+			/* A barrier, everything queued before it has been completed. */
+			pxRequest->xResult = RES_OK;
+		}
+		else
+		{
+			/* Drop a completion left by a transfer that timed out. */
+			xSemaphoreTake( xTransferDone, 0 );
+
+			pxRequest->xResult = xDiskPortStart( pxRequest );
+			if( pxRequest->xResult == RES_OK )
+			{
+				if( xSemaphoreTake( xTransferDone, diskasyncTRANSFER_TIMEOUT ) == pdPASS )
+				{
+					pxRequest->xResult = xTransferResult;
+				}
+				else
+				{
+					pxRequest->xResult = RES_ERROR;
+				}
+			}
+		}
+
+		if( pxRequest->vCallback != NULL )
+		{
+			pxRequest->vCallback( pxRequest );
+		}
+	}
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Synchronous Disk I/O Functions for FatFs                               */
+/*------------------------------------------------------------------------*/
+
+static void prvSyncComplete( xDiskRequest *pxRequest )
+{
+	xSemaphoreGive( ( xSemaphoreHandle ) pxRequest->pvContext );
+}
+
+static DRESULT prvTransfer( BYTE drv, BYTE write, BYTE *buff, DWORD sector, BYTE count )
+{
+	xDiskRequest xRequest, *pxRequest = &xRequest;
+
+	xRequest.ucDrive = drv;
+	xRequest.ucWrite = write;
+	xRequest.ucCount = count;
+	xRequest.ulSector = sector;
+	xRequest.pucBuffer = buff;
+	xRequest.vCallback = prvSyncComplete;
+	xRequest.pvContext = ( void * ) xSyncDone;
+	xRequest.xResult = RES_ERROR;
+
+	/* The calling task blocks until the I/O task has completed the request,
+	other tasks keep running meanwhile. */
+	xSemaphoreTake( xSyncMutex, portMAX_DELAY );
+	if( xQueueSend( xIORequests, &pxRequest, portMAX_DELAY ) == pdPASS )
+	{
+		xSemaphoreTake( xSyncDone, portMAX_DELAY );
+	}
+	xSemaphoreGive( xSyncMutex );
+
+	return xRequest.xResult;
+}
+
+DSTATUS disk_initialize( BYTE drv )
+{
+	return xDiskPortInitialise( drv );
+}
+
+DSTATUS disk_status( BYTE drv )
+{
+	return xDiskPortStatus( drv );
+}
+
+DRESULT disk_read( BYTE drv, BYTE *buff, DWORD sector, BYTE count )
+{
+	if( count == 0 )
+	{
+		return RES_PARERR;
+	}
+
+	return prvTransfer( drv, 0, buff, sector, count );
+}
+
+#if _FS_READONLY == 0
+DRESULT disk_write( BYTE drv, const BYTE *buff, DWORD sector, BYTE count )
+{
+	if( count == 0 )
+	{
+		return RES_PARERR;
+	}
+
+	return prvTransfer( drv, 1, ( BYTE * ) buff, sector, count );
+}
+#endif
+
+DRESULT disk_ioctl( BYTE drv, BYTE ctrl, void *buff )
+{
+	DRESULT res;
+
+	if( ctrl == CTRL_SYNC )
+	{
+		/* Wait for the queued transfers before the driver flushes the card. */
+		res = prvTransfer( drv, 0, NULL, 0, 0 );
+		if( res != RES_OK )
+		{
+			return res;
+		}
+	}
+
+	return xDiskPortIoctl( drv, ctrl, buff );
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Double Buffered File Writer                                            */
+/*------------------------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+	xWriterJob xJob;
+	FRESULT res;
+	UINT bw;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xWriterJobs, &xJob, portMAX_DELAY ) != pdPASS )
+		{
+			continue;
+		}
+
+		res = f_write( xJob.pxWriter->pxFile, xJob.pucData, xJob.uxBytes, &bw );
+		if( res == FR_OK && bw != xJob.uxBytes )
+		{
+			res = FR_DENIED;	/* The volume is full */
+		}
+
+		if( xJob.pxWriter->xResult == FR_OK )
+		{
+			xJob.pxWriter->xResult = res;
+		}
+
+		/* The buffer belongs to the application again. */
+		xSemaphoreGive( xJob.pxWriter->xIdle );
+	}
+}
+
+FRESULT xFileWriterOpen( xFileWriter *pxWriter, FIL *pxFile, BYTE *pucBufferA, BYTE *pucBufferB, UINT uxSize )
+{
+	pxWriter->pxFile = pxFile;
+	pxWriter->pucBuffer[ 0 ] = pucBufferA;
+	pxWriter->pucBuffer[ 1 ] = pucBufferB;
+	pxWriter->uxSize = uxSize;
+	pxWriter->ucFill = 0;
+	pxWriter->xResult = FR_OK;
+
+	/* Created available: no buffer is with the writer task yet. */
+	vSemaphoreCreateBinary( pxWriter->xIdle );
+
+	return ( pxWriter->xIdle != NULL && xWriterJobs != NULL ) ? FR_OK : FR_INT_ERR;
+}
+
+FRESULT xFileWriterCommit( xFileWriter *pxWriter, UINT uxBytes )
+{
+	xWriterJob xJob;
+	FRESULT res;
+
+	if( uxBytes > pxWriter->uxSize )
+	{
+		return FR_INT_ERR;
+	}
+
+	/* Wait for the writer task to release the other buffer. */
+	xSemaphoreTake( pxWriter->xIdle, portMAX_DELAY );
+
+	res = pxWriter->xResult;
+	if( res != FR_OK || uxBytes == 0 )
+	{
+		xSemaphoreGive( pxWriter->xIdle );
+		return res;
+	}
+
+	xJob.pxWriter = pxWriter;
+	xJob.pucData = pxWriter->pucBuffer[ pxWriter->ucFill ];
+	xJob.uxBytes = uxBytes;
+	xQueueSend( xWriterJobs, &xJob, portMAX_DELAY );
+
+	pxWriter->ucFill ^= 1;
+
+	return FR_OK;
+}
+
+FRESULT xFileWriterFlush( xFileWriter *pxWriter )
+{
+	FRESULT res;
+
+	xSemaphoreTake( pxWriter->xIdle, portMAX_DELAY );
+
+	res = pxWriter->xResult;
+	if( res == FR_OK )
+	{
+		res = f_sync( pxWriter->pxFile );
+	}
+
+	xSemaphoreGive( pxWriter->xIdle );
+
+	return res;
+}
+
+FRESULT xFileWriterClose( xFileWriter *pxWriter )
+{
+	FRESULT res;
+
+	res = xFileWriterFlush( pxWriter );
+	vQueueDelete( pxWriter->xIdle );
+	pxWriter->xIdle = NULL;
+
+	return res;
+}
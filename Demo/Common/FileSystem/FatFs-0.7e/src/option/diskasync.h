@@ -0,0 +1,115 @@
+/*------------------------------------------------------------------------*/
+/* Asynchronous block device layer and double buffered file writer        */
+/* for FatFs R0.07e on FreeRTOS                                           */
+/*------------------------------------------------------------------------*/
+/* Sector transfers are queued to an I/O task that starts them on the
+/  storage driver (SPI or SDIO DMA) and blocks until the driver reports the
+/  end of the transfer from its interrupt. The disk_read/disk_write/
+/  disk_ioctl functions FatFs needs are built on that queue, so a task that
+/  calls into FatFs blocks on a semaphore instead of spinning on the card.
+/  Requests can also be submitted directly and completed with a callback.
+/
+/  The file writer on top of it lets an application fill one buffer while
+/  the other one is passed to f_write() by a writer task.
+*/
+
+#ifndef _DISKASYNC
+#define _DISKASYNC
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include "../ff.h"
+#include "../diskio.h"
+
+/* Depth of the I/O request queue and of the file writer job queue. */
+#ifndef diskasyncQUEUE_LENGTH
+#define diskasyncQUEUE_LENGTH			4
+#endif
+
+/* Stack sizes (in words) of the I/O task and the file writer task. */
+#ifndef diskasyncIO_STACK_SIZE
+#define diskasyncIO_STACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+#ifndef diskasyncWRITER_STACK_SIZE
+#define diskasyncWRITER_STACK_SIZE		( configMINIMAL_STACK_SIZE * 4 )
+#endif
+
+/* Ticks the I/O task waits for the driver to finish one transfer. */
+#ifndef diskasyncTRANSFER_TIMEOUT
+#define diskasyncTRANSFER_TIMEOUT		( 1000 / portTICK_RATE_MS )
+#endif
+
+
+
+/* Block transfer request. ucCount of 0 is a barrier that completes once
+/  every request queued before it has completed. */
+
+typedef struct xDISK_REQUEST
+{
+	BYTE	ucDrive;		/* Physical drive number */
+	BYTE	ucWrite;		/* 0:Read, 1:Write */
+	BYTE	ucCount;		/* Number of sectors */
+	DWORD	ulSector;		/* Start sector */
+	BYTE	*pucBuffer;		/* Data buffer */
+	void	( *vCallback )( struct xDISK_REQUEST *pxRequest );	/* Called by the I/O task on completion (can be NULL) */
+	void	*pvContext;		/* Free for use by the callback */
+	DRESULT	xResult;		/* Result of the transfer, valid on completion */
+} xDiskRequest;
+
+
+
+/* Double buffered file writer. */
+
+typedef struct xFILE_WRITER
+{
+	FIL				*pxFile;		/* File to write, opened by the application */
+	BYTE			*pucBuffer[ 2 ];/* The two data buffers */
+	UINT			uxSize;			/* Size of each buffer in bytes */
+	BYTE			ucFill;			/* Index of the buffer owned by the application */
+	FRESULT			xResult;		/* First error reported by f_write() */
+	xSemaphoreHandle xIdle;			/* Given when the writer task is done with the other buffer */
+} xFileWriter;
+
+
+
+/* Start the I/O task and the file writer task. */
+portBASE_TYPE xDiskAsyncInit( unsigned portBASE_TYPE uxPriority );
+
+/* Queue a request. Returns pdPASS when queued; the callback then runs in
+/  the I/O task when the transfer has ended. */
+portBASE_TYPE xDiskAsyncSubmit( xDiskRequest *pxRequest, portTickType xTicksToWait );
+
+/* Called by the driver from its DMA/transfer complete interrupt. */
+void vDiskAsyncTransferDoneFromISR( DRESULT xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/* Prepare a writer for an open file with two buffers of uxSize bytes. */
+FRESULT xFileWriterOpen( xFileWriter *pxWriter, FIL *pxFile, BYTE *pucBufferA, BYTE *pucBufferB, UINT uxSize );
+
+/* The buffer the application is to fill next. */
+#define pucFileWriterBuffer( pxWriter )	( ( pxWriter )->pucBuffer[ ( pxWriter )->ucFill ] )
+
+/* Hand uxBytes of the filled buffer to the writer task and switch buffers.
+/  Blocks only while the writer task still holds the other buffer. Returns
+/  the first error of earlier writes. */
+FRESULT xFileWriterCommit( xFileWriter *pxWriter, UINT uxBytes );
+
+/* Wait until everything committed has been written, then sync the file. */
+FRESULT xFileWriterFlush( xFileWriter *pxWriter );
+
+/* Flush the writer and delete its semaphore. The file stays open. */
+FRESULT xFileWriterClose( xFileWriter *pxWriter );
+
+
+
+/* Storage driver interface, supplied by the board. xDiskPortStart() starts
+/  the transfer of a request and returns at once; the end of the transfer is
+/  reported through vDiskAsyncTransferDoneFromISR(). It is only called from
+/  the I/O task, one request at a time. */
+DSTATUS xDiskPortInitialise( BYTE ucDrive );
+DSTATUS xDiskPortStatus( BYTE ucDrive );
+DRESULT xDiskPortIoctl( BYTE ucDrive, BYTE ucCtrl, void *pvBuffer );
+DRESULT xDiskPortStart( const xDiskRequest *pxRequest );
+
+#endif /* _DISKASYNC */
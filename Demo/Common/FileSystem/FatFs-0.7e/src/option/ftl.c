@@ -0,0 +1,687 @@
+/*------------------------------------------------------------------------*/
+/* Wear levelling flash translation layer for FatFs R0.07e on FreeRTOS    */
+/*------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+#include "ftl.h"
+
+#define ftlMAGIC				0x314C5446UL	/* "FTL1" */
+#define ftlNONE					0xFFFFFFFFUL	/* No block, unmapped sector, free block sequence */
+
+/* Flash addresses of the parts of a block. */
+#define ftlBLOCK_ADDR( b )		( ( unsigned long ) ( b ) * ftlBLOCK_SIZE )
+#define ftlTABLE_ADDR( b, s )	( ftlBLOCK_ADDR( b ) + ftlHEADER_SIZE + ( ( unsigned long ) ( s ) * 4UL ) )
+#define ftlDATA_ADDR( b, s )	( ftlBLOCK_ADDR( b ) + ftlBLOCK_SIZE - ( ( ftlSLOTS_PER_BLOCK - ( unsigned long ) ( s ) ) * ftlSECTOR_SIZE ) )
+
+/* Per block state. ulSequence is ftlNONE for a free (erased) block. */
+static unsigned long ulEraseCount[ ftlBLOCK_COUNT ];
+static unsigned long ulSequence[ ftlBLOCK_COUNT ];
+static unsigned short usValid[ ftlBLOCK_COUNT ];	/* Slots holding the newest copy of a sector */
+
+/* Logical sector to physical slot ( block * ftlSLOTS_PER_BLOCK + slot ). */
+static unsigned long ulMap[ ftlSECTOR_COUNT ];
+
+static unsigned long ulHead = ftlNONE;		/* Block receiving writes */
+static unsigned long ulHeadNext;			/* Next free slot in ulHead */
+static DWORD ulNextSequence;
+static unsigned long ulFreeBlocks;
+static portBASE_TYPE xReclaiming = pdFALSE;	/* Reclaim copies may use the last free block */
+static BYTE ucCopyBuffer[ ftlSECTOR_SIZE ];
+
+static xSemaphoreHandle xFTLMutex = NULL;
+
+#if ftlCACHE_SECTORS > 0
+static struct
+{
+	unsigned long	ulSector;	/* ftlNONE when empty */
+	unsigned long	ulUsed;		/* Access stamp for LRU eviction */
+	BYTE			ucDirty;
+	BYTE			ucData[ ftlSECTOR_SIZE ];
+} xCache[ ftlCACHE_SECTORS ];
+static unsigned long ulCacheClock;
+#endif
+
+static portBASE_TYPE prvReclaim( portBASE_TYPE xStatic );
+static void prvBackgroundTask( void *pvParameters );
+
+
+
+/*------------------------------------------------------------------------*/
+/* Block Management                                                       */
+/*------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvEraseBlock( unsigned long ulBlock, unsigned long ulCount )
+{
+	DWORD ulHeader[ 2 ];
+
+	ulSequence[ ulBlock ] = ftlNONE;
+	usValid[ ulBlock ] = 0;
+	if( xFTLFlashErase( ulBlock ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	ulHeader[ 0 ] = ftlMAGIC;
+	ulHeader[ 1 ] = ulCount;
+	if( xFTLFlashProgram( ftlBLOCK_ADDR( ulBlock ), ulHeader, sizeof( ulHeader ) ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	ulEraseCount[ ulBlock ] = ulCount;
+	ulFreeBlocks++;
+
+	return pdPASS;
+}
+
+static portBASE_TYPE prvOpenHead( void )
+{
+	unsigned long ulBlock, ulBest = ftlNONE;
+
+	/* Dynamic wear levelling: take the least worn free block. */
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		if( ulSequence[ ulBlock ] == ftlNONE && ( ulBest == ftlNONE || ulEraseCount[ ulBlock ] < ulEraseCount[ ulBest ] ) )
+		{
+			ulBest = ulBlock;
+		}
+	}
+
+	if( ulBest == ftlNONE )
+	{
+		return pdFAIL;
+	}
+
+	if( xFTLFlashProgram( ftlBLOCK_ADDR( ulBest ) + 8UL, &ulNextSequence, sizeof( ulNextSequence ) ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	ulSequence[ ulBest ] = ulNextSequence++;
+	ulFreeBlocks--;
+	ulHead = ulBest;
+	ulHeadNext = 0;
+
+	return pdPASS;
+}
+
+static portBASE_TYPE prvAppend( unsigned long ulSector, const BYTE *pucData )
+{
+	unsigned long ulSlot, ulOld;
+	DWORD ulEntry = ulSector;
+
+	if( xReclaiming == pdFALSE )
+	{
+		/* Keep two blocks free: copies made while reclaiming may need one,
+		and a reclaim cut short by a power failure still leaves the other. */
+		while( ulFreeBlocks < 2 && prvReclaim( pdFALSE ) == pdPASS )
+		{
+		}
+	}
+
+	if( ulHead == ftlNONE || ulHeadNext >= ftlSLOTS_PER_BLOCK )
+	{
+		if( prvOpenHead() != pdPASS )
+		{
+			return pdFAIL;
+		}
+	}
+
+	/* Data first, then the table entry that makes it visible on mount. */
+	ulSlot = ulHeadNext++;
+	if( xFTLFlashProgram( ftlDATA_ADDR( ulHead, ulSlot ), pucData, ftlSECTOR_SIZE ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	if( xFTLFlashProgram( ftlTABLE_ADDR( ulHead, ulSlot ), &ulEntry, sizeof( ulEntry ) ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	ulOld = ulMap[ ulSector ];
+	if( ulOld != ftlNONE )
+	{
+		usValid[ ulOld / ftlSLOTS_PER_BLOCK ]--;
+	}
+
+	ulMap[ ulSector ] = ( ulHead * ftlSLOTS_PER_BLOCK ) + ulSlot;
+	usValid[ ulHead ]++;
+
+	return pdPASS;
+}
+
+static portBASE_TYPE prvReclaim( portBASE_TYPE xStatic )
+{
+	unsigned long ulBlock, ulVictim = ftlNONE, ulMax = 0, ulSlot, ulRoom;
+	DWORD ulSector;
+	portBASE_TYPE xResult = pdPASS;
+
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		if( ulEraseCount[ ulBlock ] > ulMax )
+		{
+			ulMax = ulEraseCount[ ulBlock ];
+		}
+
+		if( ulSequence[ ulBlock ] == ftlNONE || ulBlock == ulHead )
+		{
+			continue;
+		}
+
+		if( ulVictim == ftlNONE )
+		{
+			ulVictim = ulBlock;
+		}
+		else if( xStatic != pdFALSE )
+		{
+			/* Static wear levelling: the least worn block, whatever it holds. */
+			if( ulEraseCount[ ulBlock ] < ulEraseCount[ ulVictim ] )
+			{
+				ulVictim = ulBlock;
+			}
+		}
+		else if( usValid[ ulBlock ] < usValid[ ulVictim ] || ( usValid[ ulBlock ] == usValid[ ulVictim ] && ulEraseCount[ ulBlock ] < ulEraseCount[ ulVictim ] ) )
+		{
+			/* Otherwise the block that costs the fewest copies. */
+			ulVictim = ulBlock;
+		}
+	}
+
+	if( ulVictim == ftlNONE )
+	{
+		return pdFAIL;
+	}
+
+	if( xStatic != pdFALSE ? ( ulMax - ulEraseCount[ ulVictim ] <= ftlWEAR_THRESHOLD ) : ( usValid[ ulVictim ] >= ftlSLOTS_PER_BLOCK ) )
+	{
+		return pdFAIL;	/* Nothing to gain */
+	}
+
+	ulRoom = ulFreeBlocks * ftlSLOTS_PER_BLOCK;
+	if( ulHead != ftlNONE )
+	{
+		ulRoom += ftlSLOTS_PER_BLOCK - ulHeadNext;
+	}
+
+	if( usValid[ ulVictim ] > ulRoom )
+	{
+		return pdFAIL;	/* No room for the copies */
+	}
+
+	/* Move the sectors still in use to the head, then erase the block. */
+	xReclaiming = pdTRUE;
+	for( ulSlot = 0; ulSlot < ftlSLOTS_PER_BLOCK && usValid[ ulVictim ] != 0; ulSlot++ )
+	{
+		if( xFTLFlashRead( ftlTABLE_ADDR( ulVictim, ulSlot ), &ulSector, sizeof( ulSector ) ) != pdPASS )
+		{
+			xResult = pdFAIL;
+			break;
+		}
+
+		if( ulSector < ftlSECTOR_COUNT && ulMap[ ulSector ] == ( ulVictim * ftlSLOTS_PER_BLOCK ) + ulSlot )
+		{
+			if( xFTLFlashRead( ftlDATA_ADDR( ulVictim, ulSlot ), ucCopyBuffer, ftlSECTOR_SIZE ) != pdPASS || prvAppend( ulSector, ucCopyBuffer ) != pdPASS )
+			{
+				xResult = pdFAIL;
+				break;
+			}
+		}
+	}
+	xReclaiming = pdFALSE;
+
+	if( xResult == pdPASS )
+	{
+		xResult = prvEraseBlock( ulVictim, ulEraseCount[ ulVictim ] + 1UL );
+	}
+
+	return xResult;
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Mount                                                                  */
+/*------------------------------------------------------------------------*/
+
+static portBASE_TYPE prvSlotIsBlank( unsigned long ulBlock, unsigned long ulSlot )
+{
+	DWORD ulData[ 16 ];
+	unsigned long ulOffset, i;
+
+	for( ulOffset = 0; ulOffset < ftlSECTOR_SIZE; ulOffset += sizeof( ulData ) )
+	{
+		if( xFTLFlashRead( ftlDATA_ADDR( ulBlock, ulSlot ) + ulOffset, ulData, sizeof( ulData ) ) != pdPASS )
+		{
+			return pdFALSE;
+		}
+
+		for( i = 0; i < 16; i++ )
+		{
+			if( ulData[ i ] != ftlNONE )
+			{
+				return pdFALSE;
+			}
+		}
+	}
+
+	return pdTRUE;
+}
+
+portBASE_TYPE xFTLInit( unsigned portBASE_TYPE uxPriority )
+{
+	unsigned long ulBlock, ulSlot, ulSector, ulPhys, ulOld, ulWornSum = 0, ulFormatted = 0;
+	DWORD ulHeader[ 3 ], ulEntries[ 16 ], ulEntry;
+
+	if( xFTLMutex != NULL )
+	{
+		return pdPASS;
+	}
+
+	for( ulSector = 0; ulSector < ftlSECTOR_COUNT; ulSector++ )
+	{
+		ulMap[ ulSector ] = ftlNONE;
+	}
+
+	ulHead = ftlNONE;
+	ulNextSequence = 0;
+	ulFreeBlocks = 0;
+	xReclaiming = pdFALSE;
+
+	/* Read the block headers. Unrecognised blocks get an erase count of
+	ftlNONE and are formatted below. */
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		usValid[ ulBlock ] = 0;
+		if( xFTLFlashRead( ftlBLOCK_ADDR( ulBlock ), ulHeader, sizeof( ulHeader ) ) != pdPASS || ulHeader[ 0 ] != ftlMAGIC || ulHeader[ 1 ] == ftlNONE )
+		{
+			ulEraseCount[ ulBlock ] = ftlNONE;
+			ulSequence[ ulBlock ] = ftlNONE;
+			continue;
+		}
+
+		ulEraseCount[ ulBlock ] = ulHeader[ 1 ];
+		ulSequence[ ulBlock ] = ulHeader[ 2 ];
+		ulWornSum += ulHeader[ 1 ];
+		ulFormatted++;
+
+		if( ulHeader[ 2 ] == ftlNONE )
+		{
+			ulFreeBlocks++;
+		}
+		else
+		{
+			if( ulHeader[ 2 ] >= ulNextSequence )
+			{
+				ulNextSequence = ulHeader[ 2 ] + 1UL;
+				ulHead = ulBlock;
+			}
+		}
+	}
+
+	/* Map each sector to its newest copy: the highest block sequence number,
+	then the highest slot within the block. */
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		if( ulSequence[ ulBlock ] == ftlNONE )
+		{
+			continue;
+		}
+
+		for( ulSlot = 0; ulSlot < ftlSLOTS_PER_BLOCK; ulSlot++ )
+		{
+			if( ( ulSlot % 16UL ) == 0 )
+			{
+				if( xFTLFlashRead( ftlTABLE_ADDR( ulBlock, ulSlot ), ulEntries, sizeof( ulEntries ) ) != pdPASS )
+				{
+					return pdFAIL;
+				}
+			}
+
+			ulSector = ulEntries[ ulSlot % 16UL ];
+			if( ulSector >= ftlSECTOR_COUNT )
+			{
+				continue;	/* Free slot, or one skipped after a power failure */
+			}
+
+			ulPhys = ( ulBlock * ftlSLOTS_PER_BLOCK ) + ulSlot;
+			ulOld = ulMap[ ulSector ];
+			if( ulOld == ftlNONE || ulSequence[ ulOld / ftlSLOTS_PER_BLOCK ] < ulSequence[ ulBlock ] || ( ulOld / ftlSLOTS_PER_BLOCK == ulBlock && ulOld < ulPhys ) )
+			{
+				ulMap[ ulSector ] = ulPhys;
+			}
+		}
+	}
+
+	for( ulSector = 0; ulSector < ftlSECTOR_COUNT; ulSector++ )
+	{
+		if( ulMap[ ulSector ] != ftlNONE )
+		{
+			usValid[ ulMap[ ulSector ] / ftlSLOTS_PER_BLOCK ]++;
+		}
+	}
+
+	/* Continue writing after the last entry of the head. A slot whose data
+	was programmed but whose entry was not is skipped. */
+	if( ulHead != ftlNONE )
+	{
+		for( ulHeadNext = ftlSLOTS_PER_BLOCK; ulHeadNext > 0; ulHeadNext-- )
+		{
+			if( xFTLFlashRead( ftlTABLE_ADDR( ulHead, ulHeadNext - 1UL ), &ulEntry, sizeof( ulEntry ) ) != pdPASS )
+			{
+				return pdFAIL;
+			}
+
+			if( ulEntry != ftlNONE )
+			{
+				break;
+			}
+		}
+
+		while( ulHeadNext < ftlSLOTS_PER_BLOCK && prvSlotIsBlank( ulHead, ulHeadNext ) == pdFALSE )
+		{
+			ulHeadNext++;
+		}
+	}
+
+	/* Format blank or damaged blocks with the mean erase count so that they
+	do not attract all the wear. */
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		if( ulEraseCount[ ulBlock ] == ftlNONE )
+		{
+			if( prvEraseBlock( ulBlock, ( ulFormatted != 0 ) ? ulWornSum / ulFormatted : 0UL ) != pdPASS )
+			{
+				return pdFAIL;
+			}
+		}
+	}
+
+	#if ftlCACHE_SECTORS > 0
+	for( ulSlot = 0; ulSlot < ftlCACHE_SECTORS; ulSlot++ )
+	{
+		xCache[ ulSlot ].ulSector = ftlNONE;
+		xCache[ ulSlot ].ucDirty = 0;
+	}
+	#endif
+
+	xFTLMutex = xSemaphoreCreateMutex();
+	if( xFTLMutex == NULL )
+	{
+		return pdFAIL;
+	}
+
+	return xTaskCreate( prvBackgroundTask, ( signed char * ) "FTL", ftlBACKGROUND_STACK_SIZE, NULL, uxPriority, NULL );
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Sector Access                                                          */
+/*------------------------------------------------------------------------*/
+
+DRESULT xFTLRead( BYTE *pucBuffer, DWORD ulSector, BYTE ucCount )
+{
+	DRESULT xResult = RES_OK;
+	unsigned long ulPhys;
+	#if ftlCACHE_SECTORS > 0
+	unsigned portBASE_TYPE x;
+	#endif
+
+	if( ulSector + ucCount > ftlSECTOR_COUNT || ulSector + ucCount < ulSector )
+	{
+		return RES_PARERR;
+	}
+
+	xSemaphoreTake( xFTLMutex, portMAX_DELAY );
+
+	for( ; ucCount > 0 && xResult == RES_OK; ucCount--, ulSector++, pucBuffer += ftlSECTOR_SIZE )
+	{
+		#if ftlCACHE_SECTORS > 0
+		for( x = 0; x < ftlCACHE_SECTORS && xCache[ x ].ulSector != ulSector; x++ )
+		{
+		}
+
+		if( x < ftlCACHE_SECTORS )
+		{
+			memcpy( pucBuffer, xCache[ x ].ucData, ftlSECTOR_SIZE );
+			xCache[ x ].ulUsed = ++ulCacheClock;
+			continue;
+		}
+		#endif
+
+		ulPhys = ulMap[ ulSector ];
+		if( ulPhys == ftlNONE )
+		{
+			memset( pucBuffer, 0xFF, ftlSECTOR_SIZE );	/* Never written */
+		}
+		else if( xFTLFlashRead( ftlDATA_ADDR( ulPhys / ftlSLOTS_PER_BLOCK, ulPhys % ftlSLOTS_PER_BLOCK ), pucBuffer, ftlSECTOR_SIZE ) != pdPASS )
+		{
+			xResult = RES_ERROR;
+		}
+	}
+
+	xSemaphoreGive( xFTLMutex );
+
+	return xResult;
+}
+
+DRESULT xFTLWrite( const BYTE *pucBuffer, DWORD ulSector, BYTE ucCount )
+{
+	DRESULT xResult = RES_OK;
+	#if ftlCACHE_SECTORS > 0
+	unsigned portBASE_TYPE x, xLRU;
+	#endif
+
+	if( ulSector + ucCount > ftlSECTOR_COUNT || ulSector + ucCount < ulSector )
+	{
+		return RES_PARERR;
+	}
+
+	xSemaphoreTake( xFTLMutex, portMAX_DELAY );
+
+	for( ; ucCount > 0 && xResult == RES_OK; ucCount--, ulSector++, pucBuffer += ftlSECTOR_SIZE )
+	{
+		#if ftlCACHE_SECTORS > 0
+		/* Rewrites of a cached sector stay in RAM until sync or eviction. */
+		xLRU = 0;
+		for( x = 0; x < ftlCACHE_SECTORS && xCache[ x ].ulSector != ulSector; x++ )
+		{
+			if( xCache[ x ].ulSector == ftlNONE || ( xCache[ xLRU ].ulSector != ftlNONE && xCache[ x ].ulUsed < xCache[ xLRU ].ulUsed ) )
+			{
+				xLRU = x;
+			}
+		}
+
+		if( x == ftlCACHE_SECTORS )
+		{
+			x = xLRU;
+			if( xCache[ x ].ucDirty != 0 && prvAppend( xCache[ x ].ulSector, xCache[ x ].ucData ) != pdPASS )
+			{
+				xResult = RES_ERROR;
+				break;
+			}
+
+			xCache[ x ].ulSector = ulSector;
+		}
+
+		memcpy( xCache[ x ].ucData, pucBuffer, ftlSECTOR_SIZE );
+		xCache[ x ].ucDirty = 1;
+		xCache[ x ].ulUsed = ++ulCacheClock;
+		#else
+		if( prvAppend( ulSector, pucBuffer ) != pdPASS )
+		{
+			xResult = RES_ERROR;
+		}
+		#endif
+	}
+
+	xSemaphoreGive( xFTLMutex );
+
+	return xResult;
+}
+
+DRESULT xFTLSync( void )
+{
+	DRESULT xResult = RES_OK;
+	#if ftlCACHE_SECTORS > 0
+	unsigned portBASE_TYPE x;
+
+	xSemaphoreTake( xFTLMutex, portMAX_DELAY );
+
+	for( x = 0; x < ftlCACHE_SECTORS; x++ )
+	{
+		if( xCache[ x ].ucDirty != 0 )
+		{
+			if( prvAppend( xCache[ x ].ulSector, xCache[ x ].ucData ) != pdPASS )
+			{
+				xResult = RES_ERROR;
+				break;
+			}
+
+			xCache[ x ].ucDirty = 0;
+		}
+	}
+
+	xSemaphoreGive( xFTLMutex );
+	#endif
+
+	return xResult;
+}
+
+void vFTLGetWear( unsigned long *pulMinErase, unsigned long *pulMaxErase )
+{
+	unsigned long ulBlock;
+
+	*pulMinErase = ftlNONE;
+	*pulMaxErase = 0;
+	for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+	{
+		if( ulEraseCount[ ulBlock ] < *pulMinErase )
+		{
+			*pulMinErase = ulEraseCount[ ulBlock ];
+		}
+
+		if( ulEraseCount[ ulBlock ] > *pulMaxErase )
+		{
+			*pulMaxErase = ulEraseCount[ ulBlock ];
+		}
+	}
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Background Reclaim Task                                                */
+/*------------------------------------------------------------------------*/
+
+static void prvBackgroundTask( void *pvParameters )
+{
+	unsigned long ulBlock;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( ftlBACKGROUND_PERIOD );
+
+		/* One erase per period, so that the mutex is never held for long. */
+		xSemaphoreTake( xFTLMutex, portMAX_DELAY );
+
+		for( ulBlock = 0; ulBlock < ftlBLOCK_COUNT; ulBlock++ )
+		{
+			if( ulSequence[ ulBlock ] != ftlNONE && ulBlock != ulHead && usValid[ ulBlock ] == 0 )
+			{
+				break;
+			}
+		}
+
+		if( ulBlock < ftlBLOCK_COUNT )
+		{
+			/* Everything in the block is stale, erase it without copying. */
+			prvEraseBlock( ulBlock, ulEraseCount[ ulBlock ] + 1UL );
+		}
+		else if( ulFreeBlocks < ftlBACKGROUND_FREE )
+		{
+			prvReclaim( pdFALSE );
+		}
+		else
+		{
+			prvReclaim( pdTRUE );
+		}
+
+		xSemaphoreGive( xFTLMutex );
+	}
+}
+
+
+
+/*------------------------------------------------------------------------*/
+/* Disk I/O Functions for FatFs                                           */
+/*------------------------------------------------------------------------*/
+
+DSTATUS disk_initialize( BYTE drv )
+{
+	return ( drv == ftlDRIVE && xFTLMutex != NULL ) ? 0 : STA_NOINIT;
+}
+
+DSTATUS disk_status( BYTE drv )
+{
+	return ( drv == ftlDRIVE && xFTLMutex != NULL ) ? 0 : STA_NOINIT;
+}
+
+DRESULT disk_read( BYTE drv, BYTE *buff, DWORD sector, BYTE count )
+{
+	if( drv != ftlDRIVE || count == 0 )
+	{
+		return RES_PARERR;
+	}
+
+	return xFTLRead( buff, sector, count );
+}
+
+#if _FS_READONLY == 0
+DRESULT disk_write( BYTE drv, const BYTE *buff, DWORD sector, BYTE count )
+{
+	if( drv != ftlDRIVE || count == 0 )
+	{
+		return RES_PARERR;
+	}
+
+	return xFTLWrite( buff, sector, count );
+}
+#endif
+
+DRESULT disk_ioctl( BYTE drv, BYTE ctrl, void *buff )
+{
+	if( drv != ftlDRIVE )
+	{
+		return RES_PARERR;
+	}
+
+	switch( ctrl )
+	{
+		case CTRL_SYNC:
+			return xFTLSync();
+
+		case GET_SECTOR_COUNT:
+			*( DWORD * ) buff = ftlSECTOR_COUNT;
+			return RES_OK;
+
+		case GET_SECTOR_SIZE:
+			*( WORD * ) buff = ( WORD ) ftlSECTOR_SIZE;
+			return RES_OK;
+
+		case GET_BLOCK_SIZE:
+			*( DWORD * ) buff = 1;	/* Erase blocks are not visible through the FTL */
+			return RES_OK;
+
+		default:
+			return RES_PARERR;
+	}
+}
@@ -0,0 +1,110 @@
+/*------------------------------------------------------------------------*/
+/* Wear levelling flash translation layer for FatFs R0.07e on FreeRTOS    */
+/*------------------------------------------------------------------------*/
+/* Presents a NOR flash region as a disk of 512 byte sectors. Sectors are
+/  never rewritten in place: every write is appended to the current erase
+/  block, and a RAM map points each logical sector at its newest copy. Each
+/  erase block holds a header, a table with the logical sector number of
+/  each slot, and the slot data:
+/
+/    | magic | erase count | sequence | - | table[ N ] | ... | data[ N ] |
+/
+/  On mount the tables are scanned and the copy in the block with the
+/  highest sequence number wins, so a write interrupted by a power failure
+/  leaves the previous copy in use. Free blocks are handed out least worn
+/  first. A low priority task erases blocks whose data is all stale and
+/  reclaims the emptiest blocks ahead of time, and also moves cold data out
+/  of blocks that have fallen behind in erase count. A small RAM cache
+/  absorbs repeated writes to the same sector (FAT and directory sectors)
+/  until disk_ioctl( CTRL_SYNC ) or eviction.
+/
+/  Every flash word is programmed once after an erase, as NOR flash needs.
+/  NAND would need the table moved into the spare area of each page.
+*/
+
+#ifndef _FTL
+#define _FTL
+
+#include <FreeRTOS.h>
+
+#include "../ff.h"
+#include "../diskio.h"
+
+/* Flash geometry: erase block size in bytes and number of blocks given to
+/  the FTL. Addresses passed to the flash functions start at 0. */
+#ifndef ftlBLOCK_SIZE
+#define ftlBLOCK_SIZE			4096UL
+#endif
+
+#ifndef ftlBLOCK_COUNT
+#define ftlBLOCK_COUNT			256UL
+#endif
+
+/* Blocks kept out of the disk capacity so that reclaiming always has room.
+/  At least 4. */
+#ifndef ftlSPARE_BLOCKS
+#define ftlSPARE_BLOCKS			4UL
+#endif
+
+/* Sectors held in the RAM write cache. */
+#ifndef ftlCACHE_SECTORS
+#define ftlCACHE_SECTORS		4
+#endif
+
+/* Free blocks the background task tries to keep ready. */
+#ifndef ftlBACKGROUND_FREE
+#define ftlBACKGROUND_FREE		3UL
+#endif
+
+/* Erase count spread above which cold data is moved out of the least worn block. */
+#ifndef ftlWEAR_THRESHOLD
+#define ftlWEAR_THRESHOLD		64UL
+#endif
+
+/* Period of the background task and its stack size in words. */
+#ifndef ftlBACKGROUND_PERIOD
+#define ftlBACKGROUND_PERIOD	( 50 / portTICK_RATE_MS )
+#endif
+
+#ifndef ftlBACKGROUND_STACK_SIZE
+#define ftlBACKGROUND_STACK_SIZE	( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+/* Physical drive number served by the disk_* functions in ftl.c. */
+#ifndef ftlDRIVE
+#define ftlDRIVE				0
+#endif
+
+#define ftlSECTOR_SIZE			512UL
+#define ftlHEADER_SIZE			16UL
+#define ftlSLOTS_PER_BLOCK		( ( ftlBLOCK_SIZE - ftlHEADER_SIZE ) / ( ftlSECTOR_SIZE + 4UL ) )
+#define ftlSECTOR_COUNT			( ( ftlBLOCK_COUNT - ftlSPARE_BLOCKS ) * ftlSLOTS_PER_BLOCK )
+
+#if ftlSPARE_BLOCKS < 4 || ftlBLOCK_COUNT <= ftlSPARE_BLOCKS || ftlSLOTS_PER_BLOCK < 2
+#error Invalid FTL geometry.
+#endif
+
+
+
+/* Scan the flash, build the sector map and start the background task with
+/  priority uxPriority. Blank or unrecognised blocks are erased. */
+portBASE_TYPE xFTLInit( unsigned portBASE_TYPE uxPriority );
+
+DRESULT xFTLRead( BYTE *pucBuffer, DWORD ulSector, BYTE ucCount );
+DRESULT xFTLWrite( const BYTE *pucBuffer, DWORD ulSector, BYTE ucCount );
+
+/* Write the cached sectors to flash. */
+DRESULT xFTLSync( void );
+
+/* Lowest and highest erase count over all blocks. */
+void vFTLGetWear( unsigned long *pulMinErase, unsigned long *pulMaxErase );
+
+
+
+/* Flash driver interface, supplied by the board. Each returns pdPASS on
+/  success. Programming only clears bits; erasing sets a whole block to 0xFF. */
+portBASE_TYPE xFTLFlashRead( unsigned long ulAddress, void *pvBuffer, unsigned long ulLength );
+portBASE_TYPE xFTLFlashProgram( unsigned long ulAddress, const void *pvData, unsigned long ulLength );
+portBASE_TYPE xFTLFlashErase( unsigned long ulBlock );
+
+#endif /* _FTL */
@@ -16,6 +16,8 @@
 /* This function is called in f_mount function to create a new
 /  synchronization object, such as semaphore and mutex. When a FALSE is
 /  returned, the f_mount function fails with FR_INT_ERR.
+/  With _FS_FILE_LOCK, it is also called in f_open function to create the
+/  sync object of the file, and f_open fails with FR_INT_ERR on FALSE.
 */
 
 BOOL ff_cre_syncobj (	/* TRUE:Function succeeded, FALSE:Could not create due to any error */
@@ -47,6 +49,8 @@ BOOL ff_cre_syncobj (	/* TRUE:Function succeeded, FALSE:Could not create due to
 /* This function is called in f_mount function to delete a synchronization
 /  object that created with ff_cre_syncobj function. When a FALSE is
 /  returned, the f_mount function fails with FR_INT_ERR.
+/  With _FS_FILE_LOCK, it is also called in f_close function to delete the
+/  sync object of the file.
 */
 
 BOOL ff_del_syncobj (	/* TRUE:Function succeeded, FALSE:Could not delete due to any error */
@@ -73,8 +77,11 @@ BOOL ff_del_syncobj (	/* TRUE:Function succeeded, FALSE:Could not delete due to
 /*------------------------------------------------------------------------*/
 /* Request Grant to Access the Volume                                     */
 /*------------------------------------------------------------------------*/
-/* This function is called on entering file functions to lock the volume.
-/  When a FALSE is returned, the file function fails with FR_TIMEOUT.
+/* This function is called on entering file functions to lock the volume,
+/  and with _FS_FILE_LOCK to lock the file. When a FALSE is returned, the
+/  file function fails with FR_TIMEOUT.
+/  The volume lock is also taken back after the volume was released for a
+/  data transfer; there a FALSE makes FatFs retry until the lock is granted.
 */
 
 BOOL ff_req_grant (	/* TRUE:Got a grant to access the volume, FALSE:Could not get a grant */
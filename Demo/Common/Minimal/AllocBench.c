@@ -0,0 +1,735 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A set of allocator benchmarks that replay the allocation patterns seen on
+ * real targets, so the heap implementations in Source/portable/MemMang can be
+ * compared on the same hardware (or in the Win32 or POSIX simulator) by
+ * building the same application with each in turn.  Three workloads are
+ * replayed:
+ *
+ * 1) "pbuf churn" - mimics a TCP/IP stack allocating packet buffers.  Most
+ *    requests are small (headers and acks), some medium and some full sized,
+ *    and buffers are mostly freed in the order they were allocated, as
+ *    received packets are consumed and transmitted packets acknowledged.
+ * 2) "task churn" - mimics tasks being created and deleted.  Each task is a
+ *    TCB sized block followed by a larger stack block, the stack is freed
+ *    before the TCB, and tasks are deleted in random order.
+ * 3) "random mix" - random sizes allocated and freed in random order, which
+ *    is the worst case for fragmentation.
+ *
+ * Each workload performs allocbenchOPERATIONS allocations or frees, driven by
+ * a pseudo random generator that is reseeded at the start of every pass, so
+ * every heap sees exactly the same sequence of requests.  The following are
+ * recorded for each workload:
+ *
+ * + The minimum, average and maximum time taken by pvPortMalloc() and
+ *   vPortFree(), with the cost of reading the time base subtracted, and a
+ *   histogram of each.  heap_2, heap_4 and heap_5 perform the whole of each
+ *   call with the scheduler suspended, so the maximum is also the worst case
+ *   time for which a call suspends the scheduler.  The task runs at a low
+ *   priority, so interrupts and higher priority tasks can add to the maximum;
+ *   the histogram shows whether that has happened.
+ * + The number of allocations that failed.
+ * + Fragmentation, as the percentage of the free heap that is not in the
+ *   largest free block.  The peak during the workload, the figure at
+ *   allocbenchFRAG_SAMPLES evenly spaced points during the workload, and the
+ *   figure once every block allocated by the workload has been freed are
+ *   recorded.  A heap that does not coalesce adjacent free blocks, such as
+ *   heap_2, is left fragmented after the workload.
+ * + Efficiency, as the peak number of bytes requested and not yet freed as a
+ *   percentage of the peak reduction in free heap.  The difference is the
+ *   space lost to block headers, alignment and rounding.
+ *
+ * Each block has its first and last byte set to a known value when it is
+ * allocated, and they are checked before the block is freed, so a heap
+ * implementation that hands out overlapping blocks is detected as an error.
+ *
+ * The fragmentation and efficiency figures need xPortGetFreeHeapSize() and
+ * xPortGetLargestFreeBlockSize(), which heap_3 does not provide - set
+ * allocbenchHEAP_STATS to 0 when building with heap_3.  heap_1 never frees, so
+ * cannot be measured.  Other tasks that allocate while the benchmark runs
+ * will distort the fragmentation and efficiency figures.
+ *
+ * The time base is the run time stats counter, unless FreeRTOSConfig.h
+ * defines allocbenchGET_TIME( x ) to read a different counter into x.  The
+ * results of the last complete pass are written as a table by
+ * vAllocBenchGetResults(), in counter units.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "AllocBench.h"
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) && !defined( allocbenchGET_TIME )
+	#error The allocator benchmark requires configGENERATE_RUN_TIME_STATS to be set to 1, or allocbenchGET_TIME() to be defined.
+#endif
+
+/* Sample the run time counter in whichever way the port provides, unless the
+application supplies its own time base. */
+#ifndef allocbenchGET_TIME
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define allocbenchGET_TIME( x )	portALT_GET_RUN_TIME_COUNTER_VALUE( ( x ) )
+	#else
+		#define allocbenchGET_TIME( x )	( x ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/* Set to 0 if the heap implementation does not provide xPortGetFreeHeapSize()
+and xPortGetLargestFreeBlockSize(). */
+#ifndef allocbenchHEAP_STATS
+	#define allocbenchHEAP_STATS			1
+#endif
+
+/* The maximum number of blocks each workload holds at once.  The task churn
+workload holds half as many tasks, each of two blocks. */
+#ifndef allocbenchSLOTS
+	#define allocbenchSLOTS					( 16 )
+#endif
+
+/* The largest block requested by the pbuf churn and random mix workloads. */
+#ifndef allocbenchMAX_BLOCK_SIZE
+	#define allocbenchMAX_BLOCK_SIZE		( 256 )
+#endif
+
+/* The smallest stack requested by the task churn workload.  Stacks of one and
+two times this size are requested. */
+#ifndef allocbenchTASK_STACK_BYTES
+	#define allocbenchTASK_STACK_BYTES		( configMINIMAL_STACK_SIZE * sizeof( portSTACK_TYPE ) )
+#endif
+
+/* The number of allocations and frees performed by each workload per pass. */
+#ifndef allocbenchOPERATIONS
+	#define allocbenchOPERATIONS			( 400 )
+#endif
+
+/* The histograms have allocbenchHISTOGRAM_BUCKETS buckets.  The first counts
+times below allocbenchHISTOGRAM_RESOLUTION counter units, each bucket after
+that ends at twice the limit of the one before, and the last counts the
+rest. */
+#ifndef allocbenchHISTOGRAM_BUCKETS
+	#define allocbenchHISTOGRAM_BUCKETS		( 10 )
+#endif
+
+#ifndef allocbenchHISTOGRAM_RESOLUTION
+	#define allocbenchHISTOGRAM_RESOLUTION	( 16UL )
+#endif
+
+/* The number of evenly spaced points during each workload at which the
+fragmentation is recorded. */
+#ifndef allocbenchFRAG_SAMPLES
+	#define allocbenchFRAG_SAMPLES			( 4 )
+#endif
+
+/* The delay between consecutive passes through the workloads. */
+#define allocbenchDELAY_BETWEEN_PASSES	( ( portTickType ) 1000 / portTICK_RATE_MS )
+
+#define allocbenchSTACK_SIZE			configMINIMAL_STACK_SIZE
+
+/* The value written to the first and last byte of every block. */
+#define allocbenchGUARD_BYTE			( ( unsigned char ) 0xa5 )
+
+/* The workloads. */
+#define allocbenchPBUF_CHURN			( 0 )
+#define allocbenchTASK_CHURN			( 1 )
+#define allocbenchRANDOM_MIX			( 2 )
+#define allocbenchNUM_WORKLOADS			( 3 )
+
+/* The timings recorded for each workload. */
+#define allocbenchMALLOC				( 0 )
+#define allocbenchFREE					( 1 )
+#define allocbenchNUM_TIMINGS			( 2 )
+
+/*-----------------------------------------------------------*/
+
+/* The figures recorded for one of pvPortMalloc() or vPortFree(). */
+typedef struct ALLOC_BENCH_TIMING
+{
+	portRUN_TIME_COUNTER_TYPE ulMin;
+	portRUN_TIME_COUNTER_TYPE ulMax;
+	portRUN_TIME_COUNTER_TYPE ulTotal;
+	unsigned long ulCalls;
+	unsigned long ulHistogram[ allocbenchHISTOGRAM_BUCKETS ];
+} xAllocBenchTiming;
+
+/* The figures recorded for a workload. */
+typedef struct ALLOC_BENCH_RESULT
+{
+	xAllocBenchTiming xTimings[ allocbenchNUM_TIMINGS ];
+	unsigned long ulFailures;
+	unsigned portBASE_TYPE uxPeakFragmentation;
+	unsigned portBASE_TYPE uxEndFragmentation;
+	unsigned portBASE_TYPE uxFragmentation[ allocbenchFRAG_SAMPLES ];
+	unsigned portBASE_TYPE uxEfficiency;
+} xAllocBenchResult;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that replays the workloads.
+ */
+static void prvAllocBenchTask( void *pvParameters );
+
+/*
+ * Replay each workload.  uxOperation is the number of the allocation or free
+ * being performed.
+ */
+static void prvPbufChurnStep( unsigned portBASE_TYPE uxOperation );
+static void prvTaskChurnStep( unsigned portBASE_TYPE uxOperation );
+static void prvRandomMixStep( unsigned portBASE_TYPE uxOperation );
+
+/*
+ * Allocate a block of xSize bytes into slot uxSlot, or free the block held in
+ * slot uxSlot, timing the call.  prvAllocate() returns pdFAIL if the heap
+ * could not satisfy the request.
+ */
+static portBASE_TYPE prvAllocate( unsigned portBASE_TYPE uxSlot, size_t xSize );
+static void prvFree( unsigned portBASE_TYPE uxSlot );
+
+/*
+ * Add a time to the figures for one of pvPortMalloc() or vPortFree().
+ */
+static void prvRecordTime( xAllocBenchTiming *pxTiming, portRUN_TIME_COUNTER_TYPE ulElapsed );
+
+/*
+ * Returns the percentage of the free heap that is not in the largest free
+ * block.
+ */
+static unsigned portBASE_TYPE prvFragmentation( void );
+
+/*
+ * Returns a pseudo random number between 0 and 0x7fff.
+ */
+static unsigned long prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+/* The names printed in the first column of the results table. */
+static const char * const pcWorkloadNames[ allocbenchNUM_WORKLOADS ] =
+{
+	"pbuf churn",
+	"task churn",
+	"random mix"
+};
+
+static const char * const pcTimingNames[ allocbenchNUM_TIMINGS ] =
+{
+	"malloc",
+	"free"
+};
+
+/* The figures for the workload in progress, and for the last complete pass. */
+static xAllocBenchResult xWorking;
+static xAllocBenchResult xResults[ allocbenchNUM_WORKLOADS ];
+
+/* The blocks held by the workload in progress, and the size requested for
+each. */
+static void *pvSlots[ allocbenchSLOTS ];
+static size_t xSlotSizes[ allocbenchSLOTS ];
+
+/* The FIFO of blocks held by the pbuf churn workload. */
+static unsigned portBASE_TYPE uxPbufHead = 0, uxPbufCount = 0;
+
+/* The number of bytes requested and not yet freed by the workload in
+progress, and the peak of that figure. */
+static size_t xLiveBytes = 0, xPeakLiveBytes = 0;
+
+/* The free heap when the workload started, and the peak reduction from that
+free heap during the workload. */
+static size_t xBaselineFree = 0, xPeakUsedBytes = 0;
+
+/* The cost of reading the time base, subtracted from every time measured. */
+static portRUN_TIME_COUNTER_TYPE ulCounterOverhead = 0;
+
+/* The state of the pseudo random generator. */
+static unsigned long ulNextRand = 0UL;
+
+/* Incremented each time a pass completes, and latched should an error be
+detected.  Both are inspected by xAreAllocBenchTasksStillRunning(). */
+static volatile unsigned long ulPassCounter = 0UL;
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartAllocBenchTasks( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvAllocBenchTask, ( signed char * ) "ABnch", allocbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRand( void )
+{
+	ulNextRand = ( ulNextRand * 1103515245UL ) + 12345UL;
+	return ( ulNextRand >> 16UL ) & 0x7fffUL;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvFragmentation( void )
+{
+unsigned portBASE_TYPE uxReturn = 0;
+
+	#if allocbenchHEAP_STATS == 1
+	{
+	size_t xFree, xLargest;
+
+		xFree = xPortGetFreeHeapSize();
+		xLargest = xPortGetLargestFreeBlockSize();
+
+		if( ( xFree > 0 ) && ( xLargest < xFree ) )
+		{
+			uxReturn = ( unsigned portBASE_TYPE ) ( 100UL - ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) xFree ) );
+		}
+
+		/* Note the peak usage at the same time. */
+		if( ( xBaselineFree > xFree ) && ( ( xBaselineFree - xFree ) > xPeakUsedBytes ) )
+		{
+			xPeakUsedBytes = xBaselineFree - xFree;
+		}
+	}
+	#endif
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordTime( xAllocBenchTiming *pxTiming, portRUN_TIME_COUNTER_TYPE ulElapsed )
+{
+unsigned long ulBucketLimit = allocbenchHISTOGRAM_RESOLUTION;
+unsigned portBASE_TYPE uxBucket;
+
+	if( ulElapsed > ulCounterOverhead )
+	{
+		ulElapsed -= ulCounterOverhead;
+	}
+	else
+	{
+		ulElapsed = 0;
+	}
+
+	if( ( pxTiming->ulCalls == 0UL ) || ( ulElapsed < pxTiming->ulMin ) )
+	{
+		pxTiming->ulMin = ulElapsed;
+	}
+
+	if( ulElapsed > pxTiming->ulMax )
+	{
+		pxTiming->ulMax = ulElapsed;
+	}
+
+	pxTiming->ulTotal += ulElapsed;
+	( pxTiming->ulCalls )++;
+
+	for( uxBucket = 0; uxBucket < ( allocbenchHISTOGRAM_BUCKETS - 1 ); uxBucket++ )
+	{
+		if( ulElapsed < ulBucketLimit )
+		{
+			break;
+		}
+		ulBucketLimit <<= 1;
+	}
+	( pxTiming->ulHistogram[ uxBucket ] )++;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvAllocate( unsigned portBASE_TYPE uxSlot, size_t xSize )
+{
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+unsigned char *pucBlock;
+
+	allocbenchGET_TIME( ulStart );
+	pucBlock = ( unsigned char * ) pvPortMalloc( xSize );
+	allocbenchGET_TIME( ulEnd );
+
+	prvRecordTime( &( xWorking.xTimings[ allocbenchMALLOC ] ), ulEnd - ulStart );
+
+	if( pucBlock == NULL )
+	{
+		( xWorking.ulFailures )++;
+		return pdFAIL;
+	}
+
+	pucBlock[ 0 ] = allocbenchGUARD_BYTE;
+	pucBlock[ xSize - 1 ] = allocbenchGUARD_BYTE;
+
+	pvSlots[ uxSlot ] = ( void * ) pucBlock;
+	xSlotSizes[ uxSlot ] = xSize;
+
+	xLiveBytes += xSize;
+	if( xLiveBytes > xPeakLiveBytes )
+	{
+		xPeakLiveBytes = xLiveBytes;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( unsigned portBASE_TYPE uxSlot )
+{
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+unsigned char *pucBlock = ( unsigned char * ) pvSlots[ uxSlot ];
+
+	/* If either byte has changed then the heap has handed out a block that
+	overlaps this one. */
+	if( ( pucBlock[ 0 ] != allocbenchGUARD_BYTE ) || ( pucBlock[ xSlotSizes[ uxSlot ] - 1 ] != allocbenchGUARD_BYTE ) )
+	{
+		xErrorDetected = pdTRUE;
+	}
+
+	allocbenchGET_TIME( ulStart );
+	vPortFree( ( void * ) pucBlock );
+	allocbenchGET_TIME( ulEnd );
+
+	prvRecordTime( &( xWorking.xTimings[ allocbenchFREE ] ), ulEnd - ulStart );
+
+	xLiveBytes -= xSlotSizes[ uxSlot ];
+	pvSlots[ uxSlot ] = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPbufChurnStep( unsigned portBASE_TYPE uxOperation )
+{
+unsigned long ulChoice = prvRand() % 10UL;
+size_t xSize;
+
+	( void ) uxOperation;
+
+	/* Consume the oldest buffer when the FIFO is full, and otherwise slightly
+	less often than new buffers arrive so the FIFO stays well used. */
+	if( ( uxPbufCount == allocbenchSLOTS ) || ( ( uxPbufCount > 0 ) && ( ( prvRand() % 8UL ) < 3UL ) ) )
+	{
+		prvFree( uxPbufHead );
+		uxPbufHead = ( uxPbufHead + 1 ) % allocbenchSLOTS;
+		uxPbufCount--;
+	}
+	else
+	{
+		/* Half of the buffers are small control packets, a third are medium
+		and the rest full sized. */
+		if( ulChoice < 5UL )
+		{
+			xSize = ( size_t ) ( 16UL + ( prvRand() % 48UL ) );
+		}
+		else if( ulChoice < 8UL )
+		{
+			xSize = ( size_t ) ( ( allocbenchMAX_BLOCK_SIZE / 2 ) + ( prvRand() % ( allocbenchMAX_BLOCK_SIZE / 4 ) ) );
+		}
+		else
+		{
+			xSize = ( size_t ) allocbenchMAX_BLOCK_SIZE;
+		}
+
+		/* A failed allocation is a dropped packet. */
+		if( prvAllocate( ( uxPbufHead + uxPbufCount ) % allocbenchSLOTS, xSize ) == pdPASS )
+		{
+			uxPbufCount++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskChurnStep( unsigned portBASE_TYPE uxOperation )
+{
+unsigned portBASE_TYPE uxTCB = ( unsigned portBASE_TYPE ) ( ( prvRand() % ( allocbenchSLOTS / 2 ) ) * 2 );
+
+	( void ) uxOperation;
+
+	if( pvSlots[ uxTCB ] == NULL )
+	{
+		/* Create - the TCB is allocated first, and freed again if the stack
+		cannot be allocated, as xTaskCreate() does. */
+		if( prvAllocate( uxTCB, sizeof( xStaticTask ) ) == pdPASS )
+		{
+			if( prvAllocate( uxTCB + 1, ( size_t ) ( allocbenchTASK_STACK_BYTES * ( 1UL + ( prvRand() % 2UL ) ) ) ) != pdPASS )
+			{
+				prvFree( uxTCB );
+			}
+		}
+	}
+	else
+	{
+		/* Delete - the stack is freed before the TCB. */
+		prvFree( uxTCB + 1 );
+		prvFree( uxTCB );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRandomMixStep( unsigned portBASE_TYPE uxOperation )
+{
+unsigned portBASE_TYPE uxSlot = ( unsigned portBASE_TYPE ) ( prvRand() % allocbenchSLOTS );
+
+	( void ) uxOperation;
+
+	if( pvSlots[ uxSlot ] == NULL )
+	{
+		prvAllocate( uxSlot, ( size_t ) ( 1UL + ( prvRand() % allocbenchMAX_BLOCK_SIZE ) ) );
+	}
+	else
+	{
+		prvFree( uxSlot );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocBenchTask( void *pvParameters )
+{
+unsigned portBASE_TYPE uxWorkload, uxOperation, uxSlot, uxFragmentation, uxSample;
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* The cost of reading the time base is the minimum of a few
+		back to back reads. */
+		for( uxOperation = 0; uxOperation < 16; uxOperation++ )
+		{
+			allocbenchGET_TIME( ulStart );
+			allocbenchGET_TIME( ulEnd );
+
+			if( ( uxOperation == 0 ) || ( ( ulEnd - ulStart ) < ulCounterOverhead ) )
+			{
+				ulCounterOverhead = ulEnd - ulStart;
+			}
+		}
+
+		for( uxWorkload = 0; uxWorkload < allocbenchNUM_WORKLOADS; uxWorkload++ )
+		{
+			memset( ( void * ) &xWorking, 0x00, sizeof( xWorking ) );
+			memset( ( void * ) pvSlots, 0x00, sizeof( pvSlots ) );
+			uxPbufHead = 0;
+			uxPbufCount = 0;
+			xLiveBytes = 0;
+			xPeakLiveBytes = 0;
+			xPeakUsedBytes = 0;
+			ulNextRand = ( unsigned long ) uxWorkload + 1UL;
+
+			#if allocbenchHEAP_STATS == 1
+			{
+				xBaselineFree = xPortGetFreeHeapSize();
+			}
+			#endif
+
+			uxSample = 0;
+			for( uxOperation = 0; uxOperation < allocbenchOPERATIONS; uxOperation++ )
+			{
+				switch( uxWorkload )
+				{
+					case allocbenchPBUF_CHURN	:	prvPbufChurnStep( uxOperation );
+													break;
+
+					case allocbenchTASK_CHURN	:	prvTaskChurnStep( uxOperation );
+													break;
+
+					default						:	prvRandomMixStep( uxOperation );
+													break;
+				}
+
+				uxFragmentation = prvFragmentation();
+				if( uxFragmentation > xWorking.uxPeakFragmentation )
+				{
+					xWorking.uxPeakFragmentation = uxFragmentation;
+				}
+
+				if( ( uxSample < allocbenchFRAG_SAMPLES ) && ( ( ( uxOperation + 1 ) * allocbenchFRAG_SAMPLES ) >= ( ( uxSample + 1 ) * allocbenchOPERATIONS ) ) )
+				{
+					xWorking.uxFragmentation[ uxSample ] = uxFragmentation;
+					uxSample++;
+				}
+			}
+
+			/* Free everything still held.  The stacks of any remaining tasks
+			are freed before their TCBs as the slots are walked backwards. */
+			for( uxSlot = allocbenchSLOTS; uxSlot > 0; uxSlot-- )
+			{
+				if( pvSlots[ uxSlot - 1 ] != NULL )
+				{
+					prvFree( uxSlot - 1 );
+				}
+			}
+
+			xWorking.uxEndFragmentation = prvFragmentation();
+
+			if( xPeakUsedBytes > 0 )
+			{
+				xWorking.uxEfficiency = ( unsigned portBASE_TYPE ) ( ( ( unsigned long ) xPeakLiveBytes * 100UL ) / ( unsigned long ) xPeakUsedBytes );
+			}
+
+			/* Publish the figures for this workload. */
+			taskENTER_CRITICAL();
+			{
+				xResults[ uxWorkload ] = xWorking;
+			}
+			taskEXIT_CRITICAL();
+
+			/* Let the rest of the system run between workloads. */
+			taskYIELD();
+		}
+
+		ulPassCounter++;
+
+		vTaskDelay( allocbenchDELAY_BETWEEN_PASSES );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vAllocBenchGetResults( signed char *pcWriteBuffer )
+{
+unsigned portBASE_TYPE uxWorkload, uxTiming, uxBucket, uxSample;
+xAllocBenchResult xResult;
+xAllocBenchTiming *pxTiming;
+unsigned long ulBucketLimit;
+
+	/* Each workload takes seven lines of under 80 characters, so the buffer
+	must be at least ( allocbenchNUM_WORKLOADS * 7 + 1 ) * 80 bytes long. */
+	sprintf( ( char * ) pcWriteBuffer, "%-20s%10s%10s%10s%10s\r\n", "Workload", "Min", "Avg", "Max", "Calls" );
+
+	for( uxWorkload = 0; uxWorkload < allocbenchNUM_WORKLOADS; uxWorkload++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			xResult = xResults[ uxWorkload ];
+		}
+		taskEXIT_CRITICAL();
+
+		for( uxTiming = 0; uxTiming < allocbenchNUM_TIMINGS; uxTiming++ )
+		{
+			pxTiming = &( xResult.xTimings[ uxTiming ] );
+			pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+			if( pxTiming->ulCalls == 0UL )
+			{
+				sprintf( ( char * ) pcWriteBuffer, "%-11s%-9s%10s%10s%10s%10lu\r\n", pcWorkloadNames[ uxWorkload ], pcTimingNames[ uxTiming ], "-", "-", "-", 0UL );
+				continue;
+			}
+
+			sprintf( ( char * ) pcWriteBuffer, "%-11s%-9s%10lu%10lu%10lu%10lu\r\n", pcWorkloadNames[ uxWorkload ], pcTimingNames[ uxTiming ], ( unsigned long ) pxTiming->ulMin, ( unsigned long ) ( pxTiming->ulTotal / pxTiming->ulCalls ), ( unsigned long ) pxTiming->ulMax, pxTiming->ulCalls );
+
+			/* The histogram, as the count in each bucket after the upper
+			limit of the bucket.  The last bucket has no upper limit. */
+			pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+			strcpy( ( char * ) pcWriteBuffer, "   " );
+			ulBucketLimit = allocbenchHISTOGRAM_RESOLUTION;
+			for( uxBucket = 0; uxBucket < allocbenchHISTOGRAM_BUCKETS; uxBucket++ )
+			{
+				pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+				if( uxBucket == ( allocbenchHISTOGRAM_BUCKETS - 1 ) )
+				{
+					sprintf( ( char * ) pcWriteBuffer, " >:%lu\r\n", pxTiming->ulHistogram[ uxBucket ] );
+				}
+				else
+				{
+					sprintf( ( char * ) pcWriteBuffer, " <%lu:%lu", ulBucketLimit, pxTiming->ulHistogram[ uxBucket ] );
+					ulBucketLimit <<= 1;
+
+					/* Keep the lines short. */
+					if( uxBucket == ( ( allocbenchHISTOGRAM_BUCKETS / 2 ) - 1 ) )
+					{
+						strcat( ( char * ) pcWriteBuffer, "\r\n   " );
+					}
+				}
+			}
+		}
+
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		#if allocbenchHEAP_STATS == 1
+		{
+			sprintf( ( char * ) pcWriteBuffer, "   failed %lu, efficiency %u%%, fragmentation peak %u%% end %u%%, at", xResult.ulFailures, ( unsigned int ) xResult.uxEfficiency, ( unsigned int ) xResult.uxPeakFragmentation, ( unsigned int ) xResult.uxEndFragmentation );
+
+			for( uxSample = 0; uxSample < allocbenchFRAG_SAMPLES; uxSample++ )
+			{
+				pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+				sprintf( ( char * ) pcWriteBuffer, " %u%%", ( unsigned int ) xResult.uxFragmentation[ uxSample ] );
+			}
+
+			strcat( ( char * ) pcWriteBuffer, "\r\n" );
+		}
+		#else
+		{
+			( void ) uxSample;
+			sprintf( ( char * ) pcWriteBuffer, "   failed %lu\r\n", xResult.ulFailures );
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreAllocBenchTasksStillRunning( void )
+{
+static unsigned long ulLastPassCounter = 0UL;
+portBASE_TYPE xReturn = pdPASS;
+
+	if( ulPassCounter == ulLastPassCounter )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastPassCounter = ulPassCounter;
+
+	return xReturn;
+}
+
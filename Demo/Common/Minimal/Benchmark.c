@@ -0,0 +1,667 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A set of tasks that measure the latency of the most commonly used kernel
+ * paths, using the run time stats counter as the time base so the same code
+ * produces comparable figures on every port.  The following are measured:
+ *
+ * 1) The overhead of reading the counter itself, so it can be subtracted from
+ *    the other figures.
+ * 2) The time from one task calling taskYIELD() to another task of equal
+ *    priority starting to run.
+ * 3) The time from one task giving a semaphore to a higher priority task that
+ *    was blocked on the semaphore returning from its take.
+ * 4) The round trip time of sending an item to a higher priority task on one
+ *    queue and receiving it back on another, for several item sizes.
+ * 5) The time from an interrupt giving a semaphore to the task blocked on the
+ *    semaphore running.  This test is only performed if the application calls
+ *    xBenchmarkTimerHandler() from a periodic interrupt, in the same way the
+ *    IntQueue tests use xFirstTimerHandler().
+ * 6) The time from a task that has inherited a priority giving a mutex to the
+ *    higher priority task that was blocked on the mutex running.
+ *
+ * Three tasks are created.  A controller task sequences the tests, an equal
+ * priority task is the partner for the yield test, and a higher priority task
+ * is the partner for the other tests.  Each test is performed
+ * benchITERATIONS times and the minimum, average and maximum are recorded.
+ * The figures from the last complete pass are written as a table by
+ * vBenchmarkGetResults(), in counter units.
+ *
+ * The run time counter must be configured (configGENERATE_RUN_TIME_STATS set
+ * to 1) and should run much faster than the tick for the figures to be
+ * meaningful.  Alternatively FreeRTOSConfig.h can define benchGET_TIME( x ) to
+ * read a different counter into x, such as a CPU cycle counter when the
+ * figures from two ports on the same hardware are to be compared.  The tests
+ * rely on preemption, as that is what they measure.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "Benchmark.h"
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) && !defined( benchGET_TIME )
+	#error The benchmark tasks require configGENERATE_RUN_TIME_STATS to be set to 1, or benchGET_TIME() to be defined.
+#endif
+
+#if configUSE_PREEMPTION != 1
+	#error The benchmark tasks measure preemption latency so require configUSE_PREEMPTION to be set to 1.
+#endif
+
+/* Sample the run time counter in whichever way the port provides, unless the
+application supplies its own time base. */
+#ifndef benchGET_TIME
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define benchGET_TIME( x )	portALT_GET_RUN_TIME_COUNTER_VALUE( ( x ) )
+	#else
+		#define benchGET_TIME( x )	( x ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/* The number of times each test is repeated per pass. */
+#ifndef benchITERATIONS
+	#define benchITERATIONS			( 100 )
+#endif
+
+/* The delay between consecutive passes through the tests. */
+#define benchDELAY_BETWEEN_PASSES	( ( portTickType ) 1000 / portTICK_RATE_MS )
+
+/* How long to wait for xBenchmarkTimerHandler() to be called before deciding
+the application does not call it. */
+#define benchISR_TIMEOUT			( ( portTickType ) 200 / portTICK_RATE_MS )
+
+#define benchSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+/* The item sizes used by the queue round trip tests. */
+#define benchNUM_QUEUE_SIZES		( 3 )
+#define benchMAX_ITEM_SIZE			( 128 )
+
+/* The rows of the results table. */
+#define benchCOUNTER_OVERHEAD		( 0 )
+#define benchYIELD					( 1 )
+#define benchSEMAPHORE				( 2 )
+#define benchQUEUE_FIRST			( 3 )
+#define benchISR					( benchQUEUE_FIRST + benchNUM_QUEUE_SIZES )
+#define benchMUTEX					( benchISR + 1 )
+#define benchNUM_TESTS				( benchMUTEX + 1 )
+
+/*-----------------------------------------------------------*/
+
+/* The figures recorded for a single test. */
+typedef struct BENCH_RESULT
+{
+	portRUN_TIME_COUNTER_TYPE ulMin;
+	portRUN_TIME_COUNTER_TYPE ulMax;
+	portRUN_TIME_COUNTER_TYPE ulTotal;
+	unsigned long ulSamples;
+} xBenchResult;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that sequences the tests and performs the controller side of each.
+ */
+static void prvControllerTask( void *pvParameters );
+
+/*
+ * The partner task for the yield test.  Runs at the controller's priority.
+ */
+static void prvYieldPartnerTask( void *pvParameters );
+
+/*
+ * The partner task for the remaining tests.  Runs one priority above the
+ * controller and is told which test to perform through xCommandQueue.
+ */
+static void prvWakePartnerTask( void *pvParameters );
+
+/*
+ * Add a sample to the figures for test uxTest.
+ */
+static void prvRecordSample( unsigned portBASE_TYPE uxTest, portRUN_TIME_COUNTER_TYPE ulElapsed );
+
+/*
+ * Controller side of each test.
+ */
+static void prvMeasureCounterOverhead( void );
+static void prvMeasureYield( void );
+static void prvMeasureSemaphore( void );
+static void prvMeasureQueue( unsigned portBASE_TYPE uxSizeIndex );
+static void prvMeasureISR( void );
+#if configUSE_MUTEXES == 1
+	static void prvMeasureMutex( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The item sizes used by the queue round trip tests. */
+static const unsigned portBASE_TYPE uxQueueItemSizes[ benchNUM_QUEUE_SIZES ] = { 4, 32, benchMAX_ITEM_SIZE };
+
+/* The names printed in the first column of the results table. */
+static const char * const pcTestNames[ benchNUM_TESTS ] =
+{
+	"Counter read",
+	"Yield switch",
+	"Semaphore give->take",
+	"Queue round trip 4B",
+	"Queue round trip 32B",
+	"Queue round trip 128B",
+	"ISR give->task",
+	"Mutex inherit handoff"
+};
+
+/* The figures for the pass in progress, and for the last complete pass. */
+static xBenchResult xWorkingResults[ benchNUM_TESTS ];
+static xBenchResult xResults[ benchNUM_TESTS ];
+
+/* The time at which the event being measured was started. */
+static volatile portRUN_TIME_COUNTER_TYPE ulStartTime = 0;
+
+/* Used to pass the test to perform to prvWakePartnerTask(). */
+static xQueueHandle xCommandQueue = NULL;
+
+/* Used by the yield, semaphore, ISR and mutex tests. */
+static xSemaphoreHandle xYieldStartSemaphore = NULL;
+static xSemaphoreHandle xWakeSemaphore = NULL;
+static xSemaphoreHandle xISRSemaphore = NULL;
+static xSemaphoreHandle xISRDoneSemaphore = NULL;
+#if configUSE_MUTEXES == 1
+	static xSemaphoreHandle xMutex = NULL;
+#endif
+
+/* Request and reply queues for each queue item size. */
+static xQueueHandle xRequestQueues[ benchNUM_QUEUE_SIZES ];
+static xQueueHandle xReplyQueues[ benchNUM_QUEUE_SIZES ];
+
+/* Set by prvWakePartnerTask() when it wants xBenchmarkTimerHandler() to give
+xISRSemaphore. */
+static volatile portBASE_TYPE xISRTestArmed = pdFALSE;
+
+/* Incremented each time a pass completes, and latched should an error be
+detected.  Both are inspected by xAreBenchmarkTasksStillRunning(). */
+static volatile unsigned long ulPassCounter = 0UL;
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartBenchmarkTasks( unsigned portBASE_TYPE uxPriority )
+{
+unsigned portBASE_TYPE ux;
+
+	xCommandQueue = xQueueCreate( 1, sizeof( unsigned portBASE_TYPE ) );
+	vSemaphoreCreateBinary( xYieldStartSemaphore );
+	vSemaphoreCreateBinary( xWakeSemaphore );
+	vSemaphoreCreateBinary( xISRSemaphore );
+	vSemaphoreCreateBinary( xISRDoneSemaphore );
+
+	#if configUSE_MUTEXES == 1
+	{
+		xMutex = xSemaphoreCreateMutex();
+		configASSERT( xMutex );
+	}
+	#endif
+
+	configASSERT( xCommandQueue );
+	configASSERT( xYieldStartSemaphore );
+	configASSERT( xWakeSemaphore );
+	configASSERT( xISRSemaphore );
+	configASSERT( xISRDoneSemaphore );
+
+	/* Binary semaphores are created in the 'given' state, but all the tests
+	need them to start empty. */
+	xSemaphoreTake( xYieldStartSemaphore, 0 );
+	xSemaphoreTake( xWakeSemaphore, 0 );
+	xSemaphoreTake( xISRSemaphore, 0 );
+	xSemaphoreTake( xISRDoneSemaphore, 0 );
+
+	for( ux = 0; ux < benchNUM_QUEUE_SIZES; ux++ )
+	{
+		xRequestQueues[ ux ] = xQueueCreate( 1, uxQueueItemSizes[ ux ] );
+		xReplyQueues[ ux ] = xQueueCreate( 1, uxQueueItemSizes[ ux ] );
+		configASSERT( xRequestQueues[ ux ] );
+		configASSERT( xReplyQueues[ ux ] );
+	}
+
+	xTaskCreate( prvControllerTask, ( signed char * ) "BnchC", benchSTACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvYieldPartnerTask, ( signed char * ) "BnchY", benchSTACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvWakePartnerTask, ( signed char * ) "BnchW", benchSTACK_SIZE, NULL, uxPriority + 1, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSample( unsigned portBASE_TYPE uxTest, portRUN_TIME_COUNTER_TYPE ulElapsed )
+{
+xBenchResult *pxResult = &( xWorkingResults[ uxTest ] );
+
+	if( ( pxResult->ulSamples == 0UL ) || ( ulElapsed < pxResult->ulMin ) )
+	{
+		pxResult->ulMin = ulElapsed;
+	}
+
+	if( ulElapsed > pxResult->ulMax )
+	{
+		pxResult->ulMax = ulElapsed;
+	}
+
+	pxResult->ulTotal += ulElapsed;
+	( pxResult->ulSamples )++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void *pvParameters )
+{
+unsigned portBASE_TYPE ux;
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		for( ux = 0; ux < benchNUM_TESTS; ux++ )
+		{
+			xWorkingResults[ ux ].ulMin = 0;
+			xWorkingResults[ ux ].ulMax = 0;
+			xWorkingResults[ ux ].ulTotal = 0;
+			xWorkingResults[ ux ].ulSamples = 0UL;
+		}
+
+		prvMeasureCounterOverhead();
+		prvMeasureYield();
+		prvMeasureSemaphore();
+
+		for( ux = 0; ux < benchNUM_QUEUE_SIZES; ux++ )
+		{
+			prvMeasureQueue( ux );
+		}
+
+		prvMeasureISR();
+
+		#if configUSE_MUTEXES == 1
+		{
+			prvMeasureMutex();
+		}
+		#endif
+
+		/* Publish the figures from this pass. */
+		taskENTER_CRITICAL();
+		{
+			for( ux = 0; ux < benchNUM_TESTS; ux++ )
+			{
+				xResults[ ux ] = xWorkingResults[ ux ];
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		ulPassCounter++;
+
+		/* Give the rest of the system some time before the next pass. */
+		vTaskDelay( benchDELAY_BETWEEN_PASSES );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureCounterOverhead( void )
+{
+unsigned portBASE_TYPE ux;
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+
+	for( ux = 0; ux < benchITERATIONS; ux++ )
+	{
+		benchGET_TIME( ulStart );
+		benchGET_TIME( ulEnd );
+		prvRecordSample( benchCOUNTER_OVERHEAD, ulEnd - ulStart );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureYield( void )
+{
+unsigned portBASE_TYPE ux;
+portRUN_TIME_COUNTER_TYPE ulNow;
+
+	/* Make the yield partner ready.  It has the same priority as this task so
+	does not run until this task yields. */
+	xSemaphoreGive( xYieldStartSemaphore );
+
+	for( ux = 0; ux < benchITERATIONS; ux++ )
+	{
+		/* The partner records the time from here to when it runs, then yields
+		straight back. */
+		benchGET_TIME( ulNow );
+		ulStartTime = ulNow;
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureSemaphore( void )
+{
+unsigned portBASE_TYPE ux, uxCommand = benchSEMAPHORE;
+portRUN_TIME_COUNTER_TYPE ulNow;
+
+	/* The partner has a higher priority so starts the test as soon as the
+	command is posted. */
+	xQueueSend( xCommandQueue, &uxCommand, portMAX_DELAY );
+
+	for( ux = 0; ux < benchITERATIONS; ux++ )
+	{
+		/* The give unblocks the partner, which preempts this task, records
+		the time, then blocks on the semaphore again. */
+		benchGET_TIME( ulNow );
+		ulStartTime = ulNow;
+		xSemaphoreGive( xWakeSemaphore );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureQueue( unsigned portBASE_TYPE uxSizeIndex )
+{
+unsigned portBASE_TYPE ux, uxByte, uxCommand = benchQUEUE_FIRST + uxSizeIndex;
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+static unsigned char ucTxBuffer[ benchMAX_ITEM_SIZE ], ucRxBuffer[ benchMAX_ITEM_SIZE ];
+
+	xQueueSend( xCommandQueue, &uxCommand, portMAX_DELAY );
+
+	for( ux = 0; ux < benchITERATIONS; ux++ )
+	{
+		for( uxByte = 0; uxByte < uxQueueItemSizes[ uxSizeIndex ]; uxByte++ )
+		{
+			ucTxBuffer[ uxByte ] = ( unsigned char ) ( ux + uxByte );
+		}
+
+		/* The send unblocks the partner, which preempts this task and posts
+		the item back before blocking again, so the receive does not block. */
+		benchGET_TIME( ulStart );
+		xQueueSend( xRequestQueues[ uxSizeIndex ], ucTxBuffer, portMAX_DELAY );
+		xQueueReceive( xReplyQueues[ uxSizeIndex ], ucRxBuffer, portMAX_DELAY );
+		benchGET_TIME( ulEnd );
+
+		prvRecordSample( uxCommand, ulEnd - ulStart );
+
+		for( uxByte = 0; uxByte < uxQueueItemSizes[ uxSizeIndex ]; uxByte++ )
+		{
+			if( ucRxBuffer[ uxByte ] != ucTxBuffer[ uxByte ] )
+			{
+				xErrorDetected = pdTRUE;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureISR( void )
+{
+unsigned portBASE_TYPE uxCommand = benchISR;
+
+	xQueueSend( xCommandQueue, &uxCommand, portMAX_DELAY );
+
+	/* The partner is now blocked waiting for xBenchmarkTimerHandler() to give
+	the semaphore.  Wait for it to collect its samples, or give up. */
+	if( xSemaphoreTake( xISRDoneSemaphore, portMAX_DELAY ) != pdPASS )
+	{
+		xErrorDetected = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if configUSE_MUTEXES == 1
+
+	static void prvMeasureMutex( void )
+	{
+	unsigned portBASE_TYPE ux, uxCommand = benchMUTEX;
+	portRUN_TIME_COUNTER_TYPE ulNow;
+
+		xQueueSend( xCommandQueue, &uxCommand, portMAX_DELAY );
+
+		for( ux = 0; ux < benchITERATIONS; ux++ )
+		{
+			if( xSemaphoreTake( xMutex, portMAX_DELAY ) != pdPASS )
+			{
+				xErrorDetected = pdTRUE;
+			}
+
+			/* The partner preempts this task and blocks on the mutex, so this
+			task inherits the partner's priority. */
+			xSemaphoreGive( xWakeSemaphore );
+
+			/* Giving the mutex drops this task back to its base priority and
+			unblocks the partner, which records the time and returns the
+			mutex. */
+			benchGET_TIME( ulNow );
+			ulStartTime = ulNow;
+			xSemaphoreGive( xMutex );
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static void prvYieldPartnerTask( void *pvParameters )
+{
+unsigned portBASE_TYPE ux;
+portRUN_TIME_COUNTER_TYPE ulNow;
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xSemaphoreTake( xYieldStartSemaphore, portMAX_DELAY );
+
+		for( ux = 0; ux < benchITERATIONS; ux++ )
+		{
+			/* The controller has just yielded to this task. */
+			benchGET_TIME( ulNow );
+			prvRecordSample( benchYIELD, ulNow - ulStartTime );
+			taskYIELD();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakePartnerTask( void *pvParameters )
+{
+unsigned portBASE_TYPE ux, uxCommand, uxSizeIndex;
+portRUN_TIME_COUNTER_TYPE ulNow;
+static unsigned char ucBuffer[ benchMAX_ITEM_SIZE ];
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xQueueReceive( xCommandQueue, &uxCommand, portMAX_DELAY );
+
+		if( uxCommand == benchSEMAPHORE )
+		{
+			for( ux = 0; ux < benchITERATIONS; ux++ )
+			{
+				xSemaphoreTake( xWakeSemaphore, portMAX_DELAY );
+				benchGET_TIME( ulNow );
+				prvRecordSample( benchSEMAPHORE, ulNow - ulStartTime );
+			}
+		}
+		else if( ( uxCommand >= benchQUEUE_FIRST ) && ( uxCommand < ( benchQUEUE_FIRST + benchNUM_QUEUE_SIZES ) ) )
+		{
+			uxSizeIndex = uxCommand - benchQUEUE_FIRST;
+
+			for( ux = 0; ux < benchITERATIONS; ux++ )
+			{
+				xQueueReceive( xRequestQueues[ uxSizeIndex ], ucBuffer, portMAX_DELAY );
+
+				/* The controller is not yet waiting on the reply queue so
+				there is always space. */
+				if( xQueueSend( xReplyQueues[ uxSizeIndex ], ucBuffer, 0 ) != pdPASS )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+		}
+		else if( uxCommand == benchISR )
+		{
+			for( ux = 0; ux < benchITERATIONS; ux++ )
+			{
+				xISRTestArmed = pdTRUE;
+
+				if( xSemaphoreTake( xISRSemaphore, benchISR_TIMEOUT ) != pdPASS )
+				{
+					/* xBenchmarkTimerHandler() is not being called, so the
+					test is skipped and no samples are recorded. */
+					xISRTestArmed = pdFALSE;
+					break;
+				}
+
+				benchGET_TIME( ulNow );
+				prvRecordSample( benchISR, ulNow - ulStartTime );
+			}
+
+			xSemaphoreGive( xISRDoneSemaphore );
+		}
+		#if configUSE_MUTEXES == 1
+		else if( uxCommand == benchMUTEX )
+		{
+			for( ux = 0; ux < benchITERATIONS; ux++ )
+			{
+				xSemaphoreTake( xWakeSemaphore, portMAX_DELAY );
+
+				/* The controller holds the mutex so this blocks until the
+				controller gives it. */
+				xSemaphoreTake( xMutex, portMAX_DELAY );
+				benchGET_TIME( ulNow );
+				prvRecordSample( benchMUTEX, ulNow - ulStartTime );
+				xSemaphoreGive( xMutex );
+			}
+		}
+		#endif
+		else
+		{
+			xErrorDetected = pdTRUE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xBenchmarkTimerHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+portRUN_TIME_COUNTER_TYPE ulNow;
+
+	if( xISRTestArmed != pdFALSE )
+	{
+		xISRTestArmed = pdFALSE;
+		benchGET_TIME( ulNow );
+		ulStartTime = ulNow;
+		xSemaphoreGiveFromISR( xISRSemaphore, &xHigherPriorityTaskWoken );
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkGetResults( signed char *pcWriteBuffer )
+{
+unsigned portBASE_TYPE ux;
+xBenchResult xResult;
+
+	/* Each row is under 64 characters so the buffer must be at least
+	( benchNUM_TESTS + 1 ) * 64 bytes long. */
+	sprintf( ( char * ) pcWriteBuffer, "%-24s%10s%10s%10s%10s\r\n", "Test", "Min", "Avg", "Max", "Samples" );
+
+	for( ux = 0; ux < benchNUM_TESTS; ux++ )
+	{
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			xResult = xResults[ ux ];
+		}
+		taskEXIT_CRITICAL();
+
+		if( xResult.ulSamples == 0UL )
+		{
+			sprintf( ( char * ) pcWriteBuffer, "%-24s%10s%10s%10s%10lu\r\n", pcTestNames[ ux ], "-", "-", "-", 0UL );
+		}
+		else
+		{
+			sprintf( ( char * ) pcWriteBuffer, "%-24s%10lu%10lu%10lu%10lu\r\n", pcTestNames[ ux ], ( unsigned long ) xResult.ulMin, ( unsigned long ) ( xResult.ulTotal / xResult.ulSamples ), ( unsigned long ) xResult.ulMax, xResult.ulSamples );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreBenchmarkTasksStillRunning( void )
+{
+static unsigned long ulLastPassCounter = 0UL;
+portBASE_TYPE xReturn = pdPASS;
+
+	if( ulPassCounter == ulLastPassCounter )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastPassCounter = ulPassCounter;
+
+	return xReturn;
+}
+
@@ -0,0 +1,332 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A DMA service shared by the drivers of a board, so channels are allocated
+ * at run time rather than each driver hard coding the channels it uses.  A
+ * driver allocates a channel for the way it moves data - the peripheral
+ * request, direction, width and address increments - then starts chains of
+ * descriptors on it.  Each chain completes with one callback, however many
+ * blocks it moves.  On controllers that follow a linked list themselves, such
+ * as the LPC17xx GPDMA, the port layer turns the chain into hardware linked
+ * list items so no interrupt is taken between blocks.  On others, such as the
+ * STM32F10x DMA, the port layer loads the next block from the interrupt.
+ *
+ * Completion callbacks are not run in the DMA interrupt.  The interrupt defers
+ * them to the timer service (daemon) task with xTimerPendFunctionCallFromISR(),
+ * so drivers can use the queue, semaphore and notification API freely in the
+ * callback, and time spent with interrupts masked is kept short.  The daemon
+ * task should have a priority above the tasks it serves.  A channel stays busy
+ * until its callback has run, so a callback can start the next chain on its
+ * own channel.
+ *
+ * Each channel counts the chains it has run, the errors, the bytes moved and
+ * the ticks for which it was busy, which shows how heavily each channel is
+ * used and whether a driver could share one.
+ *
+ * The port layer is in the demo directory of each board - for example
+ * Demo/CORTEX_STM32F107_GCC_Rowley/DMA for the STM32F10x DMA and
+ * Demo/CORTEX_LPC1768_GCC_Rowley/DMA for the LPC17xx GPDMA.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "DMAService.h"
+
+#if ( configUSE_TIMERS != 1 ) || ( INCLUDE_xTimerPendFunctionCall != 1 )
+	#error The DMA service needs configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1.
+#endif
+
+/* The states of a channel. */
+#define dmaIDLE						( 0 )
+#define dmaRUNNING					( 1 )
+#define dmaCALLBACK_PENDING			( 2 )
+
+/* The sequence number of a chain is incremented in steps of two, so bit 0 is
+free to carry the result through the deferred callback. */
+#define dmaSEQUENCE_INCREMENT		( 2UL )
+#define dmaRESULT_BIT				( 1UL )
+
+typedef struct DMA_CHANNEL
+{
+	const xDMAChannelConfig *pxConfig;	/* NULL while the channel is free. */
+	volatile portBASE_TYPE xState;
+	unsigned long ulSequence;			/* Changed whenever a chain is started or aborted, so a callback deferred for an earlier chain is recognised. */
+	xDMACallback vCallback;
+	void *pvContext;
+	unsigned long ulChainBytes;			/* The bytes moved by the chain in progress. */
+	portTickType xStartTime;
+	xDMAChannelStats xStats;
+} xDMAChannel;
+
+static xDMAChannel xChannels[ dmaMAX_CHANNELS ];
+
+/* The number of channels the port layer drives. */
+static unsigned portBASE_TYPE uxChannelCount = 0;
+
+/* Run by the daemon task to call the callback of a chain that has completed.
+pvParameter1 is the channel and ulParameter2 the sequence number of the chain
+with its result in dmaRESULT_BIT. */
+static void prvRunCallback( void *pvParameter1, unsigned long ulParameter2 );
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDMAServiceInit( void )
+{
+unsigned portBASE_TYPE uxChannel;
+
+	memset( ( void * ) xChannels, 0x00, sizeof( xChannels ) );
+	for( uxChannel = 0; uxChannel < ( unsigned portBASE_TYPE ) dmaMAX_CHANNELS; uxChannel++ )
+	{
+		xChannels[ uxChannel ].xState = dmaIDLE;
+	}
+
+	uxChannelCount = uxDMAPortInit();
+	configASSERT( uxChannelCount <= ( unsigned portBASE_TYPE ) dmaMAX_CHANNELS );
+
+	return ( uxChannelCount > 0 ) ? pdPASS : pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+xDMAChannelHandle xDMAChannelAllocate( const xDMAChannelConfig *pxConfig )
+{
+xDMAChannel *pxChannel = NULL;
+unsigned long ulCandidates;
+unsigned portBASE_TYPE uxChannel;
+
+	configASSERT( pxConfig );
+	ulCandidates = ulDMAPortChannelsFor( pxConfig );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxChannel = 0; uxChannel < uxChannelCount; uxChannel++ )
+		{
+			if( ( ( ulCandidates & ( 1UL << uxChannel ) ) != 0UL ) && ( xChannels[ uxChannel ].pxConfig == NULL ) )
+			{
+				pxChannel = &( xChannels[ uxChannel ] );
+				pxChannel->pxConfig = pxConfig;
+				pxChannel->xState = dmaIDLE;
+				memset( ( void * ) &( pxChannel->xStats ), 0x00, sizeof( pxChannel->xStats ) );
+				break;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ( xDMAChannelHandle ) pxChannel;
+}
+/*-----------------------------------------------------------*/
+
+void vDMAChannelFree( xDMAChannelHandle xChannel )
+{
+xDMAChannel *pxChannel = ( xDMAChannel * ) xChannel;
+
+	vDMAChannelAbort( xChannel );
+	pxChannel->pxConfig = NULL;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDMAChannelStart( xDMAChannelHandle xChannel, xDMADescriptor *pxChain, xDMACallback vCallback, void *pvContext )
+{
+xDMAChannel *pxChannel = ( xDMAChannel * ) xChannel;
+unsigned portBASE_TYPE uxChannel = ( unsigned portBASE_TYPE ) ( pxChannel - &( xChannels[ 0 ] ) );
+const xDMADescriptor *pxDescriptor;
+unsigned long ulBytes = 0UL;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxChannel->pxConfig );
+	configASSERT( pxChain );
+
+	for( pxDescriptor = pxChain; pxDescriptor != NULL; pxDescriptor = pxDescriptor->pxNext )
+	{
+		ulBytes += ( unsigned long ) pxDescriptor->usCount * ( unsigned long ) pxChannel->pxConfig->ucWidth;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		if( pxChannel->xState == dmaIDLE )
+		{
+			pxChannel->vCallback = vCallback;
+			pxChannel->pvContext = pvContext;
+			pxChannel->ulChainBytes = ulBytes;
+			pxChannel->ulSequence += dmaSEQUENCE_INCREMENT;
+			pxChannel->xStartTime = xTaskGetTickCount();
+
+			/* The state must be set first, in case the chain is so short that
+			it completes before xDMAPortStart() returns. */
+			pxChannel->xState = dmaRUNNING;
+			if( xDMAPortStart( uxChannel, pxChannel->pxConfig, pxChain ) == pdPASS )
+			{
+				pxChannel->xStats.ulChains++;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				pxChannel->xState = dmaIDLE;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vDMAChannelAbort( xDMAChannelHandle xChannel )
+{
+xDMAChannel *pxChannel = ( xDMAChannel * ) xChannel;
+
+	taskENTER_CRITICAL();
+	{
+		if( pxChannel->xState == dmaRUNNING )
+		{
+			vDMAPortAbort( ( unsigned portBASE_TYPE ) ( pxChannel - &( xChannels[ 0 ] ) ) );
+			pxChannel->xStats.ulBusyTicks += ( unsigned long ) ( xTaskGetTickCount() - pxChannel->xStartTime );
+		}
+
+		/* Changing the sequence number stops a callback that has already been
+		deferred from being run. */
+		pxChannel->ulSequence += dmaSEQUENCE_INCREMENT;
+		pxChannel->xState = dmaIDLE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xDMAChannelIsBusy( xDMAChannelHandle xChannel )
+{
+	return ( ( ( xDMAChannel * ) xChannel )->xState != dmaIDLE ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vDMAChannelGetStats( xDMAChannelHandle xChannel, xDMAChannelStats *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = ( ( xDMAChannel * ) xChannel )->xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vDMAChannelDoneFromISR( unsigned portBASE_TYPE uxChannel, portBASE_TYPE xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xDMAChannel *pxChannel = &( xChannels[ uxChannel ] );
+unsigned long ulParameter;
+
+	/* Ignore the end of a chain that has been aborted. */
+	if( pxChannel->xState == dmaRUNNING )
+	{
+		pxChannel->xStats.ulBusyTicks += ( unsigned long ) ( xTaskGetTickCountFromISR() - pxChannel->xStartTime );
+
+		if( xResult == pdPASS )
+		{
+			pxChannel->xStats.ulBytes += pxChannel->ulChainBytes;
+			ulParameter = pxChannel->ulSequence | dmaRESULT_BIT;
+		}
+		else
+		{
+			pxChannel->xStats.ulErrors++;
+			ulParameter = pxChannel->ulSequence;
+		}
+
+		pxChannel->xState = dmaIDLE;
+
+		if( pxChannel->vCallback != NULL )
+		{
+			if( xTimerPendFunctionCallFromISR( prvRunCallback, ( void * ) pxChannel, ulParameter, pxHigherPriorityTaskWoken ) == pdPASS )
+			{
+				pxChannel->xState = dmaCALLBACK_PENDING;
+			}
+			else
+			{
+				pxChannel->xStats.ulCallbacksLost++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunCallback( void *pvParameter1, unsigned long ulParameter2 )
+{
+xDMAChannel *pxChannel = ( xDMAChannel * ) pvParameter1;
+xDMACallback vCallback = NULL;
+void *pvContext = NULL;
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxChannel->xState == dmaCALLBACK_PENDING ) && ( pxChannel->ulSequence == ( ulParameter2 & ~dmaRESULT_BIT ) ) )
+		{
+			/* Idle before the callback, so the callback can start the next
+			chain. */
+			pxChannel->xState = dmaIDLE;
+			vCallback = pxChannel->vCallback;
+			pvContext = pxChannel->pvContext;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( vCallback != NULL )
+	{
+		vCallback( ( xDMAChannelHandle ) pxChannel, pvContext, ( ( ulParameter2 & dmaRESULT_BIT ) != 0UL ) ? pdPASS : pdFAIL );
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,261 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A logging facility that keeps formatting and output off the logging task.
+ * print.c passes pointers to strings the caller has already formatted and
+ * fileIO.c writes to the console with the scheduler suspended, so a busy
+ * logger either delays every other task or loses its messages.  Here a task
+ * or interrupt logs by copying a small binary record - the tick count, a
+ * pointer to the format string and up to logMAX_ARGUMENTS arguments - into
+ * a channel of its own.  A channel is a ring buffer with a single producer,
+ * so writing a record never suspends the scheduler, enters a critical
+ * section or blocks.  A low priority drain task empties each channel in turn,
+ * formats the records with sprintf() and passes the text to an output
+ * function supplied by the application.
+ *
+ * Arguments are stored as unsigned long values, so the format string should
+ * use %lu, %ld, %lx or %s conversions.  Records that arrive while a channel
+ * is full are counted, and the count is reported by the drain task in place
+ * of the lost records.
+ */
+
+#include <stdio.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ring_buffer.h"
+
+/* Demo program include files. */
+#include "DeferredLog.h"
+
+/* The period at which the drain task looks for new records. */
+#ifndef logDRAIN_PERIOD
+	#define logDRAIN_PERIOD			( ( portTickType ) 20 / portTICK_RATE_MS )
+#endif
+
+/* The size of the buffer into which each record is formatted, including the
+channel name and time stamp.  Formatted records must fit. */
+#ifndef logLINE_LENGTH
+	#define logLINE_LENGTH			( 128 )
+#endif
+
+#define logDRAIN_STACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+
+/* What is copied into a channel for each call to xLogWrite(). */
+typedef struct LOG_RECORD
+{
+	portTickType xTimeStamp;
+	const char *pcFormat;
+	unsigned long ulArguments[ logMAX_ARGUMENTS ];
+} xLogRecord;
+
+typedef struct LOG_CHANNEL
+{
+	xRingBufferHandle xRecords;
+	const char *pcName;
+	volatile unsigned long ulLost;		/* Only written by the producer. */
+	unsigned long ulLostReported;		/* Only written by the drain task. */
+	struct LOG_CHANNEL *pxNext;
+} xLogChannel;
+
+/* The channels, newest first.  A channel is never removed, so the drain task
+can walk the list while channels are being added. */
+static xLogChannel * volatile pxChannels = NULL;
+
+static pdLOG_OUTPUT_FUNCTION vLogOutput = NULL;
+
+/* The drain task.  Formats the records of every channel and calls
+vLogOutput() with each line. */
+static void vLogDrainTask( void *pvParameters );
+
+/* Fill in a record for xLogWrite() and xLogWriteFromISR(). */
+static void prvBuildRecord( xLogRecord *pxRecord, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+
+/*-----------------------------------------------------------*/
+
+xLogChannelHandle xLogCreateChannel( const char *pcName, unsigned portBASE_TYPE uxRecords )
+{
+xLogChannel *pxChannel;
+
+	pxChannel = ( xLogChannel * ) pvPortMalloc( sizeof( xLogChannel ) );
+
+	if( pxChannel != NULL )
+	{
+		pxChannel->xRecords = xRingBufferCreate( uxRecords, ( unsigned portBASE_TYPE ) sizeof( xLogRecord ) );
+
+		if( pxChannel->xRecords != NULL )
+		{
+			pxChannel->pcName = pcName;
+			pxChannel->ulLost = 0UL;
+			pxChannel->ulLostReported = 0UL;
+
+			/* The channel is complete before it becomes visible to the drain
+			task. */
+			taskENTER_CRITICAL();
+			{
+				pxChannel->pxNext = pxChannels;
+				pxChannels = pxChannel;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			vPortFree( pxChannel );
+			pxChannel = NULL;
+		}
+	}
+
+	return ( xLogChannelHandle ) pxChannel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBuildRecord( xLogRecord *pxRecord, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+	pxRecord->pcFormat = pcFormat;
+	pxRecord->ulArguments[ 0 ] = ulArg1;
+	pxRecord->ulArguments[ 1 ] = ulArg2;
+	pxRecord->ulArguments[ 2 ] = ulArg3;
+	pxRecord->ulArguments[ 3 ] = ulArg4;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xLogWrite( xLogChannelHandle xChannel, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+xLogChannel * const pxChannel = ( xLogChannel * ) xChannel;
+xLogRecord xRecord;
+portBASE_TYPE xReturn;
+
+	prvBuildRecord( &xRecord, pcFormat, ulArg1, ulArg2, ulArg3, ulArg4 );
+	xRecord.xTimeStamp = xTaskGetTickCount();
+
+	/* The drain task never blocks on the ring, so sending never has to
+	notify it. */
+	xReturn = xRingBufferSend( pxChannel->xRecords, &xRecord );
+
+	if( xReturn != pdPASS )
+	{
+		pxChannel->ulLost++;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xLogWriteFromISR( xLogChannelHandle xChannel, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 )
+{
+xLogChannel * const pxChannel = ( xLogChannel * ) xChannel;
+xLogRecord xRecord;
+signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+portBASE_TYPE xReturn;
+
+	prvBuildRecord( &xRecord, pcFormat, ulArg1, ulArg2, ulArg3, ulArg4 );
+	xRecord.xTimeStamp = xTaskGetTickCountFromISR();
+
+	xReturn = xRingBufferSendFromISR( pxChannel->xRecords, &xRecord, &xHigherPriorityTaskWoken );
+
+	if( xReturn != pdPASS )
+	{
+		pxChannel->ulLost++;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xLogStartDrainTask( unsigned portBASE_TYPE uxPriority, pdLOG_OUTPUT_FUNCTION vOutput )
+{
+	vLogOutput = vOutput;
+	return xTaskCreate( vLogDrainTask, ( signed char * ) "LogOut", logDRAIN_STACK_SIZE, NULL, uxPriority, ( xTaskHandle * ) NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vLogDrainTask( void *pvParameters )
+{
+static char cLine[ logLINE_LENGTH ];
+xLogChannel *pxChannel;
+xLogRecord xRecord;
+unsigned long ulLost;
+int iLength;
+
+	/* Just to stop compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		for( pxChannel = pxChannels; pxChannel != NULL; pxChannel = pxChannel->pxNext )
+		{
+			while( xRingBufferReceive( pxChannel->xRecords, &xRecord, ( portTickType ) 0 ) == pdPASS )
+			{
+				iLength = sprintf( cLine, "%lu %s: ", ( unsigned long ) xRecord.xTimeStamp, pxChannel->pcName );
+				iLength += sprintf( &( cLine[ iLength ] ), xRecord.pcFormat, xRecord.ulArguments[ 0 ], xRecord.ulArguments[ 1 ], xRecord.ulArguments[ 2 ], xRecord.ulArguments[ 3 ] );
+				sprintf( &( cLine[ iLength ] ), "\r\n" );
+				vLogOutput( cLine );
+			}
+
+			/* Report records lost since the last report.  The count is only
+			read here, so a record lost while this is running is reported on
+			the next pass. */
+			ulLost = pxChannel->ulLost;
+			if( ulLost != pxChannel->ulLostReported )
+			{
+				sprintf( cLine, "%s: %lu records lost\r\n", pxChannel->pcName, ulLost - pxChannel->ulLostReported );
+				pxChannel->ulLostReported = ulLost;
+				vLogOutput( cLine );
+			}
+		}
+
+		vTaskDelay( logDRAIN_PERIOD );
+	}
+}
@@ -0,0 +1,537 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The writer side of the firmware update service.  See FirmwareUpdate.h for
+ * how the image is received and written.
+ *
+ * The server owns the buffer it is filling.  Every other buffer is either in
+ * the free queue or has been sent to the writer in a message on the command
+ * queue, so the writer is the only task that touches the flash and the
+ * servers never wait for it except when every buffer is full.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "FirmwareUpdate.h"
+
+#if ( fwupdateSECTOR_SIZE % fwupdateBUFFER_SIZE ) != 0
+	#error fwupdateSECTOR_SIZE must be a multiple of fwupdateBUFFER_SIZE.
+#endif
+
+#if fwupdateBUFFER_COUNT < 2
+	#error At least two buffers are needed, one to receive into while the other is programmed.
+#endif
+
+#ifndef fwupdateWRITER_STACK_SIZE
+	#define fwupdateWRITER_STACK_SIZE		( configMINIMAL_STACK_SIZE )
+#endif
+
+/* The flash is read back and compared in pieces of this many bytes, held on
+the stack of the writer. */
+#ifndef fwupdateVERIFY_CHUNK
+	#define fwupdateVERIFY_CHUNK			( 32 )
+#endif
+
+/* What a message on the command queue asks the writer to do. */
+#define fwupdateCOMMAND_BEGIN				( 0 )
+#define fwupdateCOMMAND_DATA				( 1 )
+#define fwupdateCOMMAND_END					( 2 )
+#define fwupdateCOMMAND_ABORT				( 3 )
+
+/* A BEGIN, END or ABORT can be queued as well as a DATA message for every
+buffer, so sending to the command queue never has to wait. */
+#define fwupdateCOMMAND_QUEUE_LENGTH		( fwupdateBUFFER_COUNT + 2 )
+
+typedef struct FIRMWARE_UPDATE_BUFFER
+{
+	unsigned long ulLength;							/*< The number of bytes held. */
+	unsigned char ucData[ fwupdateBUFFER_SIZE ];
+} xUpdateBuffer;
+
+typedef struct FIRMWARE_UPDATE_MESSAGE
+{
+	portBASE_TYPE xCommand;							/*< One of the fwupdateCOMMAND_ values. */
+	xUpdateBuffer *pxBuffer;						/*< The data to program, for fwupdateCOMMAND_DATA. */
+} xUpdateMessage;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that erases and programs the flash.
+ */
+static void prvWriterTask( void *pvParameters );
+
+/*
+ * Erase the sector after the last one erased.
+ */
+static void prvEraseNextSector( void );
+
+/*
+ * Program, verify and add to the CRC the data in one buffer.
+ */
+static void prvProgramBuffer( xUpdateBuffer *pxBuffer );
+
+/*
+ * Complete the update with result xResult.
+ */
+static void prvFinish( portBASE_TYPE xResult );
+
+/*
+ * Add ulLength bytes to a CRC-32.
+ */
+static unsigned long prvCRC32( unsigned long ulCRC, const unsigned char *pucData, unsigned long ulLength );
+
+/*-----------------------------------------------------------*/
+
+static xUpdateBuffer xBuffers[ fwupdateBUFFER_COUNT ];
+
+static xQueueHandle xCommandQueue = NULL;
+static xQueueHandle xFreeBuffers = NULL;
+static xSemaphoreHandle xUpdateComplete = NULL;
+
+/* The result of the last update.  Set to fwupdateBUSY by
+xFirmwareUpdateBegin(), after which only the writer changes it. */
+static volatile portBASE_TYPE xUpdateResult = fwupdateOK;
+
+/* Set by the writer as soon as the update in progress has failed, so the
+server can stop receiving. */
+static volatile portBASE_TYPE xWriterError = fwupdateOK;
+
+/* Used only by the server: whether an update is open, and the buffer being
+filled. */
+static portBASE_TYPE xUpdateOpen = pdFALSE;
+static xUpdateBuffer *pxFillBuffer = NULL;
+
+/* Written by xFirmwareUpdateBegin() before it queues fwupdateCOMMAND_BEGIN,
+then only read by the writer. */
+static unsigned long ulImageLength = 0UL;
+static unsigned long ulImageCRC = 0UL;
+
+/* Used only by the writer. */
+static portBASE_TYPE xWriterActive = pdFALSE;
+static unsigned long ulSectorsNeeded = 0UL;
+static unsigned long ulSectorsErased = 0UL;
+static unsigned long ulBytesProgrammed = 0UL;
+static unsigned long ulRunningCRC = 0UL;
+
+/* The CRC-32 is worked out four bits at a time, which needs a table of only
+16 words. */
+static const unsigned long ulCRCTable[ 16 ] =
+{
+	0x00000000UL, 0x1db71064UL, 0x3b6e20c8UL, 0x26d930acUL,
+	0x76dc4190UL, 0x6b6b51f4UL, 0x4db26158UL, 0x5005713cUL,
+	0xedb88320UL, 0xf00f9344UL, 0xd6d6a3e8UL, 0xcb61b38cUL,
+	0x9b64c2b0UL, 0x86d3d2d4UL, 0xa00ae278UL, 0xbdbdf21cUL
+};
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFirmwareUpdateInit( unsigned portBASE_TYPE uxPriority )
+{
+portBASE_TYPE xReturn = pdFAIL;
+xUpdateBuffer *pxBuffer;
+unsigned portBASE_TYPE ux;
+
+	xCommandQueue = xQueueCreate( fwupdateCOMMAND_QUEUE_LENGTH, ( unsigned portBASE_TYPE ) sizeof( xUpdateMessage ) );
+	xFreeBuffers = xQueueCreate( fwupdateBUFFER_COUNT, ( unsigned portBASE_TYPE ) sizeof( xUpdateBuffer * ) );
+	vSemaphoreCreateBinary( xUpdateComplete );
+
+	if( ( xCommandQueue != NULL ) && ( xFreeBuffers != NULL ) && ( xUpdateComplete != NULL ) )
+	{
+		/* The semaphore is only given when an update completes. */
+		( void ) xSemaphoreTake( xUpdateComplete, 0 );
+
+		for( ux = 0; ux < ( unsigned portBASE_TYPE ) fwupdateBUFFER_COUNT; ux++ )
+		{
+			pxBuffer = &( xBuffers[ ux ] );
+			( void ) xQueueSend( xFreeBuffers, &pxBuffer, 0 );
+		}
+
+		xReturn = xTaskCreate( prvWriterTask, ( signed char * ) "FWUpd", fwupdateWRITER_STACK_SIZE, NULL, uxPriority, NULL );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFirmwareUpdateBegin( const unsigned char *pucHeader )
+{
+xUpdateMessage xMessage;
+unsigned long ulLength;
+
+	if( ( xUpdateOpen != pdFALSE ) || ( xUpdateResult == fwupdateBUSY ) )
+	{
+		return fwupdateBUSY;
+	}
+
+	ulLength = ( ( unsigned long ) pucHeader[ 4 ] << 24 ) | ( ( unsigned long ) pucHeader[ 5 ] << 16 ) | ( ( unsigned long ) pucHeader[ 6 ] << 8 ) | ( unsigned long ) pucHeader[ 7 ];
+
+	if( ( memcmp( pucHeader, "FWUP", 4 ) != 0 ) || ( ulLength == 0UL ) || ( ulLength > ( fwupdateSECTOR_SIZE * fwupdateSECTOR_COUNT ) ) )
+	{
+		return fwupdateERR_HEADER;
+	}
+
+	ulImageLength = ulLength;
+	ulImageCRC = ( ( unsigned long ) pucHeader[ 8 ] << 24 ) | ( ( unsigned long ) pucHeader[ 9 ] << 16 ) | ( ( unsigned long ) pucHeader[ 10 ] << 8 ) | ( unsigned long ) pucHeader[ 11 ];
+
+	/* Drop a completion the server of the last update did not wait for. */
+	( void ) xSemaphoreTake( xUpdateComplete, 0 );
+
+	xWriterError = fwupdateOK;
+	xUpdateResult = fwupdateBUSY;
+	xUpdateOpen = pdTRUE;
+
+	xMessage.xCommand = fwupdateCOMMAND_BEGIN;
+	xMessage.pxBuffer = NULL;
+	( void ) xQueueSend( xCommandQueue, &xMessage, 0 );
+
+	return fwupdateOK;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulFirmwareUpdateWrite( const void *pvData, unsigned long ulLength, portTickType xTicksToWait )
+{
+const unsigned char *pucData = ( const unsigned char * ) pvData;
+unsigned long ulTaken = 0UL, ulCopy;
+xUpdateMessage xMessage;
+
+	if( xUpdateOpen == pdFALSE )
+	{
+		return 0UL;
+	}
+
+	while( ( ulTaken < ulLength ) && ( xWriterError == fwupdateOK ) )
+	{
+		if( pxFillBuffer == NULL )
+		{
+			if( xQueueReceive( xFreeBuffers, &pxFillBuffer, xTicksToWait ) != pdPASS )
+			{
+				pxFillBuffer = NULL;
+				break;
+			}
+
+			pxFillBuffer->ulLength = 0UL;
+		}
+
+		ulCopy = fwupdateBUFFER_SIZE - pxFillBuffer->ulLength;
+		if( ulCopy > ( ulLength - ulTaken ) )
+		{
+			ulCopy = ulLength - ulTaken;
+		}
+
+		memcpy( &( pxFillBuffer->ucData[ pxFillBuffer->ulLength ] ), &( pucData[ ulTaken ] ), ( size_t ) ulCopy );
+		pxFillBuffer->ulLength += ulCopy;
+		ulTaken += ulCopy;
+
+		if( pxFillBuffer->ulLength == fwupdateBUFFER_SIZE )
+		{
+			xMessage.xCommand = fwupdateCOMMAND_DATA;
+			xMessage.pxBuffer = pxFillBuffer;
+			( void ) xQueueSend( xCommandQueue, &xMessage, 0 );
+			pxFillBuffer = NULL;
+		}
+	}
+
+	return ulTaken;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulFirmwareUpdateSpace( void )
+{
+unsigned long ulSpace;
+
+	/* The writer still frees the buffers after it has failed, so a server
+	that is waiting for space carries on and finds out from the next write. */
+	if( xUpdateOpen == pdFALSE )
+	{
+		return 0UL;
+	}
+
+	ulSpace = ( unsigned long ) uxQueueMessagesWaiting( xFreeBuffers ) * fwupdateBUFFER_SIZE;
+	if( pxFillBuffer != NULL )
+	{
+		ulSpace += fwupdateBUFFER_SIZE - pxFillBuffer->ulLength;
+	}
+
+	return ulSpace;
+}
+/*-----------------------------------------------------------*/
+
+void vFirmwareUpdateEnd( void )
+{
+xUpdateMessage xMessage;
+
+	if( xUpdateOpen != pdFALSE )
+	{
+		if( pxFillBuffer != NULL )
+		{
+			/* The last, part filled, buffer. */
+			xMessage.xCommand = fwupdateCOMMAND_DATA;
+			xMessage.pxBuffer = pxFillBuffer;
+			( void ) xQueueSend( xCommandQueue, &xMessage, 0 );
+			pxFillBuffer = NULL;
+		}
+
+		xMessage.xCommand = fwupdateCOMMAND_END;
+		xMessage.pxBuffer = NULL;
+		( void ) xQueueSend( xCommandQueue, &xMessage, 0 );
+		xUpdateOpen = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vFirmwareUpdateAbort( void )
+{
+xUpdateMessage xMessage;
+
+	if( xUpdateOpen != pdFALSE )
+	{
+		if( pxFillBuffer != NULL )
+		{
+			( void ) xQueueSend( xFreeBuffers, &pxFillBuffer, 0 );
+			pxFillBuffer = NULL;
+		}
+
+		xMessage.xCommand = fwupdateCOMMAND_ABORT;
+		xMessage.pxBuffer = NULL;
+		( void ) xQueueSend( xCommandQueue, &xMessage, 0 );
+		xUpdateOpen = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFirmwareUpdateGetResult( portTickType xTicksToWait )
+{
+	if( xUpdateResult == fwupdateBUSY )
+	{
+		( void ) xSemaphoreTake( xUpdateComplete, xTicksToWait );
+	}
+
+	return xUpdateResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+xUpdateMessage xMessage;
+portTickType xBlockTime;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* While sectors the image needs are still to be erased, only look
+		for data to program, and erase the next sector if there is none.  The
+		sectors are erased one at a time so data that arrives waits for one
+		erase at most. */
+		if( ( xWriterActive != pdFALSE ) && ( xWriterError == fwupdateOK ) && ( ulSectorsErased < ulSectorsNeeded ) )
+		{
+			xBlockTime = 0;
+		}
+		else
+		{
+			xBlockTime = portMAX_DELAY;
+		}
+
+		if( xQueueReceive( xCommandQueue, &xMessage, xBlockTime ) != pdPASS )
+		{
+			prvEraseNextSector();
+			continue;
+		}
+
+		switch( xMessage.xCommand )
+		{
+			case fwupdateCOMMAND_BEGIN:
+				ulSectorsNeeded = ( ulImageLength + fwupdateSECTOR_SIZE - 1UL ) / fwupdateSECTOR_SIZE;
+				ulSectorsErased = 0UL;
+				ulBytesProgrammed = 0UL;
+				ulRunningCRC = 0xffffffffUL;
+				xWriterActive = pdTRUE;
+				break;
+
+			case fwupdateCOMMAND_DATA:
+				/* After an error the data is dropped, but the buffer still has
+				to go back to the free queue. */
+				if( ( xWriterActive != pdFALSE ) && ( xWriterError == fwupdateOK ) )
+				{
+					prvProgramBuffer( xMessage.pxBuffer );
+				}
+
+				( void ) xQueueSend( xFreeBuffers, &( xMessage.pxBuffer ), 0 );
+				break;
+
+			case fwupdateCOMMAND_END:
+				if( xWriterError != fwupdateOK )
+				{
+					prvFinish( xWriterError );
+				}
+				else if( ulBytesProgrammed != ulImageLength )
+				{
+					prvFinish( fwupdateERR_LENGTH );
+				}
+				else if( ( ulRunningCRC ^ 0xffffffffUL ) != ulImageCRC )
+				{
+					prvFinish( fwupdateERR_CRC );
+				}
+				else
+				{
+					prvFinish( fwupdateOK );
+				}
+				break;
+
+			case fwupdateCOMMAND_ABORT:
+				prvFinish( fwupdateERR_ABORTED );
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvEraseNextSector( void )
+{
+	if( xFirmwareUpdateFlashErase( ulSectorsErased ) == pdPASS )
+	{
+		ulSectorsErased++;
+	}
+	else
+	{
+		xWriterError = fwupdateERR_ERASE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProgramBuffer( xUpdateBuffer *pxBuffer )
+{
+unsigned char ucReadBack[ fwupdateVERIFY_CHUNK ];
+unsigned long ulOffset, ulChunk;
+
+	if( pxBuffer->ulLength > ( ulImageLength - ulBytesProgrammed ) )
+	{
+		/* More data than the header gave. */
+		xWriterError = fwupdateERR_LENGTH;
+		return;
+	}
+
+	/* The buffer lies in one sector, which is only erased now if the data
+	arrived faster than the sectors could be erased ahead of it. */
+	while( ( ulSectorsErased <= ( ulBytesProgrammed / fwupdateSECTOR_SIZE ) ) && ( xWriterError == fwupdateOK ) )
+	{
+		prvEraseNextSector();
+	}
+
+	if( xWriterError != fwupdateOK )
+	{
+		return;
+	}
+
+	if( xFirmwareUpdateFlashProgram( ulBytesProgrammed, pxBuffer->ucData, pxBuffer->ulLength ) != pdPASS )
+	{
+		xWriterError = fwupdateERR_PROGRAM;
+		return;
+	}
+
+	for( ulOffset = 0UL; ulOffset < pxBuffer->ulLength; ulOffset += ulChunk )
+	{
+		ulChunk = pxBuffer->ulLength - ulOffset;
+		if( ulChunk > ( unsigned long ) fwupdateVERIFY_CHUNK )
+		{
+			ulChunk = ( unsigned long ) fwupdateVERIFY_CHUNK;
+		}
+
+		if( ( xFirmwareUpdateFlashRead( ulBytesProgrammed + ulOffset, ucReadBack, ulChunk ) != pdPASS ) ||
+			( memcmp( ucReadBack, &( pxBuffer->ucData[ ulOffset ] ), ( size_t ) ulChunk ) != 0 ) )
+		{
+			xWriterError = fwupdateERR_VERIFY;
+			return;
+		}
+	}
+
+	ulRunningCRC = prvCRC32( ulRunningCRC, pxBuffer->ucData, pxBuffer->ulLength );
+	ulBytesProgrammed += pxBuffer->ulLength;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinish( portBASE_TYPE xResult )
+{
+	xWriterActive = pdFALSE;
+	xUpdateResult = xResult;
+	( void ) xSemaphoreGive( xUpdateComplete );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCRC32( unsigned long ulCRC, const unsigned char *pucData, unsigned long ulLength )
+{
+	while( ulLength > 0UL )
+	{
+		ulCRC ^= ( unsigned long ) *pucData;
+		ulCRC = ( ulCRC >> 4 ) ^ ulCRCTable[ ulCRC & 0x0fUL ];
+		ulCRC = ( ulCRC >> 4 ) ^ ulCRCTable[ ulCRC & 0x0fUL ];
+		pucData++;
+		ulLength--;
+	}
+
+	return ulCRC;
+}
+/*-----------------------------------------------------------*/
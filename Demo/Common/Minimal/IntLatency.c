@@ -0,0 +1,424 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Measures the response of the port to a periodic timer interrupt, using the
+ * timer that generates the interrupt as the time base so the figures are in
+ * the same units however the run time counter is implemented.  The following
+ * are measured:
+ *
+ * 1) ISR entry latency - the time from the timer expiring to the interrupt
+ *    handler reading the timer.
+ * 2) ISR entry jitter - the change in the entry latency from one interrupt to
+ *    the next, which is the deviation of the time between the interrupts from
+ *    the timer period.
+ * 3) ISR to task latency - the time from the interrupt handler giving a
+ *    semaphore to the task blocked on the semaphore running.
+ * 4) Task wake jitter - the change from one wake up to the next in the time
+ *    from the timer expiring to the task running.
+ *
+ * Each figure is recorded as a minimum, mean and maximum, and in a histogram
+ * in which each bucket covers twice the range of the one before.  The figures
+ * accumulate until vIntLatencyResetResults() is called, and are written as a
+ * table by vIntLatencyGetResults().  The means are calculated from 32 bit
+ * totals, so the results should be reset at the start of each run - at 2KHz
+ * with a mean of 1000 counts the totals wrap after half an hour.
+ *
+ * The port specific part of the test configures a timer to interrupt
+ * periodically, at a priority at or below configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * and calls xIntLatencyTimerHandler() from the interrupt as early as
+ * possible, passing its return value to portEND_SWITCHING_ISR() or the port's
+ * equivalent.  It also provides ulIntLatencyTimerElapsed(), which returns the
+ * counts the timer has made since it last expired.  That is all that needs to
+ * be written for each port, so the figures measured on different ports are
+ * directly comparable - in timer counts, or in nanoseconds if
+ * intlatCOUNTS_PER_MICROSECOND is defined.  The interrupts should be at least
+ * a few hundred microseconds apart, as a wake up that is not complete before
+ * the next interrupt cannot be timed, and is counted as missed.
+ *
+ * The figures are only meaningful with the rest of the application running,
+ * as it is the interrupt masking and scheduling done by the other tasks that
+ * delays the response.  The standard demo BlockQ, GenQTest, recmutex and flop
+ * tasks make a good mix of background load that is available on every port.
+ * The task created here should have a priority above all of those.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "IntLatency.h"
+
+/* The number of buckets in each histogram. */
+#ifndef intlatHISTOGRAM_BUCKETS
+	#define intlatHISTOGRAM_BUCKETS		( 12 )
+#endif
+
+/* The upper limit of the first histogram bucket, in timer counts. */
+#ifndef intlatHISTOGRAM_RESOLUTION
+	#define intlatHISTOGRAM_RESOLUTION	( 4UL )
+#endif
+
+#define intlatSTACK_SIZE				configMINIMAL_STACK_SIZE
+
+/* Convert timer counts to the units the results are written in. */
+#ifdef intlatCOUNTS_PER_MICROSECOND
+	#define intlatSCALE( ulCounts )		( ( ( ulCounts ) * 1000UL ) / ( unsigned long ) ( intlatCOUNTS_PER_MICROSECOND ) )
+	#define intlatUNITS					"ns"
+#else
+	#define intlatSCALE( ulCounts )		( ulCounts )
+	#define intlatUNITS					"counts"
+#endif
+
+/* The rows of the results table. */
+#define intlatISR_ENTRY					( 0 )
+#define intlatISR_JITTER				( 1 )
+#define intlatISR_TO_TASK				( 2 )
+#define intlatTASK_JITTER				( 3 )
+#define intlatNUM_FIGURES				( 4 )
+
+/*-----------------------------------------------------------*/
+
+/* The figures recorded for one of the rows of the results table. */
+typedef struct INT_LATENCY_FIGURE
+{
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long ulTotal;
+	unsigned long ulSamples;
+	unsigned long ulHistogram[ intlatHISTOGRAM_BUCKETS ];
+} xIntLatencyFigure;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task woken by each timer interrupt.
+ */
+static void prvHandoffTask( void *pvParameters );
+
+/*
+ * Add a sample to the figures for uxFigure.  Called from the interrupt for the
+ * ISR figures, and from within a critical section for the task figures.
+ */
+static void prvRecordSample( unsigned portBASE_TYPE uxFigure, unsigned long ulSample );
+
+/*
+ * The absolute difference between two samples, used for the jitter figures.
+ */
+static unsigned long prvDifference( unsigned long ulA, unsigned long ulB );
+
+/*-----------------------------------------------------------*/
+
+/* The names printed in the first column of the results table. */
+static const char * const pcFigureNames[ intlatNUM_FIGURES ] =
+{
+	"ISR entry",
+	"ISR entry jitter",
+	"ISR->task",
+	"Task wake jitter"
+};
+
+static xIntLatencyFigure xFigures[ intlatNUM_FIGURES ];
+
+/* Given by xIntLatencyTimerHandler() to wake prvHandoffTask(). */
+static xSemaphoreHandle xHandoffSemaphore = NULL;
+
+/* The timer reading taken on entry to the most recent interrupt, and a count
+of the interrupts, used to detect a wake up that spans a timer period. */
+static volatile unsigned long ulISREntryCount = 0UL;
+static volatile unsigned long ulInterrupts = 0UL;
+
+/* Set by prvHandoffTask() when it is blocked on xHandoffSemaphore, so an
+interrupt that occurs while it is still handling the last one does not give the
+semaphore. */
+static volatile portBASE_TYPE xTaskWaiting = pdFALSE;
+
+/* The wake ups that were not timed because the task did not run before the
+next interrupt. */
+static volatile unsigned long ulMissedWakeUps = 0UL;
+
+/* Incremented each time a wake up is timed. */
+static volatile unsigned long ulWakeUps = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vStartIntLatencyTasks( unsigned portBASE_TYPE uxPriority )
+{
+	vSemaphoreCreateBinary( xHandoffSemaphore );
+	configASSERT( xHandoffSemaphore );
+
+	/* Binary semaphores are created in the 'given' state. */
+	xSemaphoreTake( xHandoffSemaphore, 0 );
+
+	vIntLatencyResetResults();
+
+	xTaskCreate( prvHandoffTask, ( signed char * ) "IntLat", intlatSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvDifference( unsigned long ulA, unsigned long ulB )
+{
+	return ( ulA > ulB ) ? ( ulA - ulB ) : ( ulB - ulA );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSample( unsigned portBASE_TYPE uxFigure, unsigned long ulSample )
+{
+xIntLatencyFigure *pxFigure = &( xFigures[ uxFigure ] );
+unsigned long ulBucketLimit = intlatHISTOGRAM_RESOLUTION;
+unsigned portBASE_TYPE uxBucket;
+
+	if( ( pxFigure->ulSamples == 0UL ) || ( ulSample < pxFigure->ulMin ) )
+	{
+		pxFigure->ulMin = ulSample;
+	}
+
+	if( ulSample > pxFigure->ulMax )
+	{
+		pxFigure->ulMax = ulSample;
+	}
+
+	pxFigure->ulTotal += ulSample;
+	( pxFigure->ulSamples )++;
+
+	/* Each bucket ends at twice the limit of the one before, and the last
+	bucket counts the rest. */
+	for( uxBucket = 0; uxBucket < ( intlatHISTOGRAM_BUCKETS - 1 ); uxBucket++ )
+	{
+		if( ulSample < ulBucketLimit )
+		{
+			break;
+		}
+		ulBucketLimit <<= 1;
+	}
+	( pxFigure->ulHistogram[ uxBucket ] )++;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xIntLatencyTimerHandler( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulEntryCount;
+static unsigned long ulLastEntryCount = 0UL;
+static portBASE_TYPE xFirstInterrupt = pdTRUE;
+
+	/* Read the timer before anything else. */
+	ulEntryCount = ulIntLatencyTimerElapsed();
+
+	if( xHandoffSemaphore != NULL )
+	{
+		/* The ISR figures are only written from here, and this interrupt does
+		not nest with itself. */
+		prvRecordSample( intlatISR_ENTRY, ulEntryCount );
+
+		if( xFirstInterrupt == pdFALSE )
+		{
+			prvRecordSample( intlatISR_JITTER, prvDifference( ulEntryCount, ulLastEntryCount ) );
+		}
+		xFirstInterrupt = pdFALSE;
+		ulLastEntryCount = ulEntryCount;
+
+		ulISREntryCount = ulEntryCount;
+		ulInterrupts++;
+
+		if( xTaskWaiting != pdFALSE )
+		{
+			xTaskWaiting = pdFALSE;
+			xSemaphoreGiveFromISR( xHandoffSemaphore, &xHigherPriorityTaskWoken );
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandoffTask( void *pvParameters )
+{
+unsigned long ulTaskCount, ulInterruptsAtWake, ulLastWakeCount = 0UL;
+portBASE_TYPE xHaveLastWake = pdFALSE;
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xTaskWaiting = pdTRUE;
+		xSemaphoreTake( xHandoffSemaphore, portMAX_DELAY );
+
+		taskENTER_CRITICAL();
+		{
+			/* Both readings are counts since the same expiry of the timer,
+			unless another interrupt has occurred since the one that gave the
+			semaphore. */
+			ulTaskCount = ulIntLatencyTimerElapsed();
+			ulInterruptsAtWake = ulInterrupts;
+
+			if( ( ulTaskCount >= ulISREntryCount ) && ( ulInterruptsAtWake == ( ulWakeUps + ulMissedWakeUps + 1UL ) ) )
+			{
+				prvRecordSample( intlatISR_TO_TASK, ulTaskCount - ulISREntryCount );
+
+				if( xHaveLastWake != pdFALSE )
+				{
+					prvRecordSample( intlatTASK_JITTER, prvDifference( ulTaskCount, ulLastWakeCount ) );
+				}
+				ulLastWakeCount = ulTaskCount;
+				xHaveLastWake = pdTRUE;
+				ulWakeUps++;
+			}
+			else
+			{
+				/* The interrupts the task did not wait for are counted as
+				missed along with this one. */
+				ulMissedWakeUps = ulInterruptsAtWake - ulWakeUps;
+				xHaveLastWake = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vIntLatencyResetResults( void )
+{
+	taskENTER_CRITICAL();
+	{
+		memset( ( void * ) xFigures, 0x00, sizeof( xFigures ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vIntLatencyGetResults( signed char *pcWriteBuffer )
+{
+unsigned portBASE_TYPE ux, uxBucket;
+xIntLatencyFigure xFigure;
+unsigned long ulBucketLimit;
+
+	/* Each figure takes three lines of under 80 characters, so the buffer must
+	be at least ( intlatNUM_FIGURES * 3 + 2 ) * 80 bytes long. */
+	sprintf( ( char * ) pcWriteBuffer, "%-20s%10s%10s%10s%10s  (%s)\r\n", "Figure", "Min", "Avg", "Max", "Samples", intlatUNITS );
+
+	for( ux = 0; ux < intlatNUM_FIGURES; ux++ )
+	{
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+		/* The ISR figures are written from the interrupt, so a copy is taken
+		with interrupts masked. */
+		taskENTER_CRITICAL();
+		{
+			xFigure = xFigures[ ux ];
+		}
+		taskEXIT_CRITICAL();
+
+		if( xFigure.ulSamples == 0UL )
+		{
+			sprintf( ( char * ) pcWriteBuffer, "%-20s%10s%10s%10s%10lu\r\n", pcFigureNames[ ux ], "-", "-", "-", 0UL );
+			continue;
+		}
+
+		sprintf( ( char * ) pcWriteBuffer, "%-20s%10lu%10lu%10lu%10lu\r\n", pcFigureNames[ ux ], intlatSCALE( xFigure.ulMin ), intlatSCALE( xFigure.ulTotal / xFigure.ulSamples ), intlatSCALE( xFigure.ulMax ), xFigure.ulSamples );
+
+		/* The histogram, as the count in each bucket after the upper limit of
+		the bucket.  The last bucket has no upper limit. */
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		strcpy( ( char * ) pcWriteBuffer, "   " );
+		ulBucketLimit = intlatHISTOGRAM_RESOLUTION;
+		for( uxBucket = 0; uxBucket < intlatHISTOGRAM_BUCKETS; uxBucket++ )
+		{
+			pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+			if( uxBucket == ( intlatHISTOGRAM_BUCKETS - 1 ) )
+			{
+				sprintf( ( char * ) pcWriteBuffer, " >:%lu\r\n", xFigure.ulHistogram[ uxBucket ] );
+			}
+			else
+			{
+				sprintf( ( char * ) pcWriteBuffer, " <%lu:%lu", intlatSCALE( ulBucketLimit ), xFigure.ulHistogram[ uxBucket ] );
+				ulBucketLimit <<= 1;
+
+				/* Keep the lines short. */
+				if( uxBucket == ( ( intlatHISTOGRAM_BUCKETS / 2 ) - 1 ) )
+				{
+					strcat( ( char * ) pcWriteBuffer, "\r\n   " );
+				}
+			}
+		}
+	}
+
+	pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+	sprintf( ( char * ) pcWriteBuffer, "Interrupts %lu, wake ups timed %lu, missed %lu\r\n", ulInterrupts, ulWakeUps, ulMissedWakeUps );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreIntLatencyTasksStillRunning( void )
+{
+static unsigned long ulLastWakeUps = 0UL, ulLastMissed = 0UL;
+portBASE_TYPE xReturn = pdPASS;
+
+	/* Either the task is being woken or the interrupt is not running, which
+	would also be an error. */
+	if( ( ulWakeUps == ulLastWakeUps ) && ( ulMissedWakeUps == ulLastMissed ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastWakeUps = ulWakeUps;
+	ulLastMissed = ulMissedWakeUps;
+
+	return xReturn;
+}
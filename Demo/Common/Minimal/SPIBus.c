@@ -0,0 +1,284 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A manager for an SPI bus shared by several devices, such as an SD card, a
+ * serial flash and a display.  Rather than each driver taking the bus and
+ * polling bytes through it, drivers describe each transfer with an
+ * xSPITransaction and queue it to the bus task.  The bus task selects the
+ * device, sets the clock rate and mode the device needs (only when it differs
+ * from the device last used), and passes the buffers to the port layer, which
+ * moves the bytes by DMA.  The bus task blocks on its task notification until
+ * the DMA interrupt reports the end of the transfer, then starts the next
+ * transaction of the chain or the queue straight away, so the bus is kept busy
+ * while the CPU runs other tasks.
+ *
+ * Completion is reported through a callback, run by the bus task, and/or a
+ * task notification.  xSPIBusTransfer() uses the notification to give drivers
+ * that were written around blocking transfers the same behaviour, without
+ * polling.
+ *
+ * The port layer is in the demo directory of each board - for example
+ * Demo/CORTEX_STM32F107_GCC_Rowley/SPIBus for the STM32F10x SPI and
+ * Demo/CORTEX_LPC1768_GCC_Rowley/SPIBus for the LPC17xx SSP.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "SPIBus.h"
+
+#if configUSE_TASK_NOTIFICATIONS != 1
+	#error The SPI bus manager needs configUSE_TASK_NOTIFICATIONS to be set to 1.
+#endif
+
+/* The longest a single transfer of up to 65535 bytes may take before the bus
+task gives up.  This must allow for the slowest device clock in use. */
+#ifndef spiTRANSFER_TIMEOUT
+	#define spiTRANSFER_TIMEOUT		( ( portTickType ) 1000 / portTICK_RATE_MS )
+#endif
+
+#define spiBUS_STACK_SIZE			( configMINIMAL_STACK_SIZE )
+
+typedef struct SPI_BUS
+{
+	unsigned portBASE_TYPE uxBus;
+	xQueueHandle xTransactions;			/* Pointers to the queued transactions. */
+	xTaskHandle xBusTask;
+	const xSPIDevice *pxConfigured;		/* The device the port is set up for, or NULL. */
+	volatile portBASE_TYPE xTransferResult;	/* Set by vSPIBusTransferDoneFromISR(). */
+} xSPIBus;
+
+/* The open buses, by bus number, so the port interrupts can find them. */
+static xSPIBus *pxBuses[ spiMAX_BUSES ] = { NULL };
+
+/* The task that runs the transactions queued to one bus. */
+static void prvSPIBusTask( void *pvParameters );
+
+/* Run every transaction of a chain, with the device selected throughout. */
+static portBASE_TYPE prvRunChain( xSPIBus *pxBus, xSPITransaction *pxTransaction );
+
+/*-----------------------------------------------------------*/
+
+xSPIBusHandle xSPIBusOpen( unsigned portBASE_TYPE uxBus, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxPriority )
+{
+xSPIBus *pxBus = NULL;
+
+	if( ( uxBus < ( unsigned portBASE_TYPE ) spiMAX_BUSES ) && ( pxBuses[ uxBus ] == NULL ) )
+	{
+		pxBus = ( xSPIBus * ) pvPortMalloc( sizeof( xSPIBus ) );
+	}
+
+	if( pxBus != NULL )
+	{
+		pxBus->uxBus = uxBus;
+		pxBus->pxConfigured = NULL;
+		pxBus->xTransferResult = pdFAIL;
+		pxBus->xBusTask = NULL;
+		pxBus->xTransactions = xQueueCreate( uxQueueLength, ( unsigned portBASE_TYPE ) sizeof( xSPITransaction * ) );
+
+		if( ( pxBus->xTransactions == NULL ) || ( xSPIPortInit( uxBus ) != pdPASS ) )
+		{
+			if( pxBus->xTransactions != NULL )
+			{
+				vQueueDelete( pxBus->xTransactions );
+			}
+
+			vPortFree( pxBus );
+			pxBus = NULL;
+		}
+	}
+
+	if( pxBus != NULL )
+	{
+		/* The bus must be registered before the task can start a transfer, as
+		the end of the transfer is reported by bus number. */
+		pxBuses[ uxBus ] = pxBus;
+
+		if( xTaskCreate( prvSPIBusTask, ( signed char * ) "SPIBus", spiBUS_STACK_SIZE, ( void * ) pxBus, uxPriority, &( pxBus->xBusTask ) ) != pdPASS )
+		{
+			pxBuses[ uxBus ] = NULL;
+			vQueueDelete( pxBus->xTransactions );
+			vPortFree( pxBus );
+			pxBus = NULL;
+		}
+	}
+
+	return ( xSPIBusHandle ) pxBus;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSPIBusSubmit( xSPIBusHandle xBus, xSPITransaction *pxTransaction, portTickType xTicksToWait )
+{
+xSPIBus *pxBus = ( xSPIBus * ) xBus;
+
+	return xQueueSend( pxBus->xTransactions, &pxTransaction, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+#if INCLUDE_xTaskGetCurrentTaskHandle == 1
+
+portBASE_TYPE xSPIBusTransfer( xSPIBusHandle xBus, xSPITransaction *pxTransaction, portTickType xTicksToWait )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	pxTransaction->vCallback = NULL;
+	pxTransaction->xNotifyTask = xTaskGetCurrentTaskHandle();
+
+	/* Drop a notification left over from an earlier use. */
+	( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+	if( xSPIBusSubmit( xBus, pxTransaction, xTicksToWait ) == pdPASS )
+	{
+		/* The bus task always completes a transaction once it has taken it,
+		timing out a transfer that does not end, so there is no need for a
+		time out here - and the transaction must not be reused before then. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xReturn = pxTransaction->xResult;
+	}
+
+	return xReturn;
+}
+
+#endif /* INCLUDE_xTaskGetCurrentTaskHandle */
+/*-----------------------------------------------------------*/
+
+void vSPIBusTransferDoneFromISR( unsigned portBASE_TYPE uxBus, portBASE_TYPE xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xSPIBus *pxBus = pxBuses[ uxBus ];
+
+	if( pxBus != NULL )
+	{
+		pxBus->xTransferResult = xResult;
+		vTaskNotifyGiveFromISR( pxBus->xBusTask, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSPIBusTask( void *pvParameters )
+{
+xSPIBus *pxBus = ( xSPIBus * ) pvParameters;
+xSPITransaction *pxTransaction;
+xTaskHandle xNotifyTask;
+
+	for( ;; )
+	{
+		if( xQueueReceive( pxBus->xTransactions, &pxTransaction, portMAX_DELAY ) != pdPASS )
+		{
+			continue;
+		}
+
+		/* Only reprogram the clock and mode when the device changes. */
+		if( pxBus->pxConfigured != pxTransaction->pxDevice )
+		{
+			vSPIPortConfigure( pxBus->uxBus, pxTransaction->pxDevice );
+			pxBus->pxConfigured = pxTransaction->pxDevice;
+		}
+
+		pxTransaction->pxDevice->vChipSelect( pdTRUE );
+		pxTransaction->xResult = prvRunChain( pxBus, pxTransaction );
+		pxTransaction->pxDevice->vChipSelect( pdFALSE );
+
+		/* Once the callback has been called the transaction belongs to the
+		submitter again, so must not be accessed afterwards. */
+		xNotifyTask = pxTransaction->xNotifyTask;
+
+		if( pxTransaction->vCallback != NULL )
+		{
+			pxTransaction->vCallback( pxTransaction );
+		}
+
+		if( xNotifyTask != NULL )
+		{
+			xTaskNotifyGive( xNotifyTask );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRunChain( xSPIBus *pxBus, xSPITransaction *pxTransaction )
+{
+portBASE_TYPE xResult = pdPASS;
+
+	while( ( pxTransaction != NULL ) && ( xResult == pdPASS ) )
+	{
+		if( pxTransaction->usLength > 0U )
+		{
+			/* Drop a completion left by a transfer that timed out. */
+			( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+			xResult = xSPIPortStart( pxBus->uxBus, pxTransaction->pucTxData, pxTransaction->pucRxData, pxTransaction->usLength );
+
+			if( xResult == pdPASS )
+			{
+				if( ulTaskNotifyTake( pdTRUE, spiTRANSFER_TIMEOUT ) != 0UL )
+				{
+					xResult = pxBus->xTransferResult;
+				}
+				else
+				{
+					vSPIPortAbort( pxBus->uxBus );
+					xResult = pdFAIL;
+				}
+			}
+		}
+
+		pxTransaction = pxTransaction->pxNext;
+	}
+
+	return xResult;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,650 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A benchmark that measures how the software timer implementation scales
+ * with the number of active timers, so changes to the timer service task's
+ * active list and command handling can be evaluated objectively.  The
+ * TimerDemo.c tests check the behaviour of a handful of timers - these tasks
+ * instead load the timer service with increasing numbers of auto-reload
+ * timers (10, 100, 1000 and 10000, up to tmrbenchMAX_TIMERS) with a mix of
+ * periods, and for each number record:
+ *
+ * + The time taken by xTimerStart() as every timer is started, and by
+ *   xTimerReset() as random timers are reset while the timers are running.
+ *   When the benchmark task runs below configTIMER_TASK_PRIORITY (which is
+ *   how it should be created) the timer service task preempts it to process
+ *   each command, so the times include inserting the timer into the active
+ *   list, not just posting the command.
+ * + The percentage of the CPU time used by the timer service task while the
+ *   timers are running.
+ * + The lateness of every expiry, in ticks, as the time at which the callback
+ *   runs less the time at which the timer was due to expire, as the minimum,
+ *   average and maximum and a histogram.  Expiries that happen early are
+ *   counted separately - there should be none.
+ * + The peak number of commands held in the timer command queue, and the
+ *   number of commands that could not be posted because it was full.  The
+ *   peak is the peak since the queue was created, so never falls from one
+ *   row to the next.
+ *
+ * The whole set of timers is created once, when the task starts, so the
+ * heap must be large enough to hold tmrbenchMAX_TIMERS timers.  The
+ * command times use the run time stats counter as their time base, unless
+ * FreeRTOSConfig.h defines tmrbenchGET_TIME( x ) to read a different counter
+ * into x.  The CPU figure needs configGENERATE_RUN_TIME_STATS and
+ * configUSE_TRACE_FACILITY set to 1 and INCLUDE_xTimerGetTimerDaemonTaskHandle
+ * set to 1.  The queue figures need configUSE_TRACE_FACILITY set to 1 and
+ * configQUEUE_REGISTRY_SIZE greater than 0, as the timer command queue is
+ * found through the queue registry.  Figures that cannot be measured are
+ * shown as '-'.
+ *
+ * The results of the last complete pass are written as a table by
+ * vTimerBenchGetResults().
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Demo program include files. */
+#include "TimerBench.h"
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) && !defined( tmrbenchGET_TIME )
+	#error The timer benchmark requires configGENERATE_RUN_TIME_STATS to be set to 1, or tmrbenchGET_TIME() to be defined.
+#endif
+
+/* Sample the run time counter in whichever way the port provides, unless the
+application supplies its own time base. */
+#ifndef tmrbenchGET_TIME
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define tmrbenchGET_TIME( x )	portALT_GET_RUN_TIME_COUNTER_VALUE( ( x ) )
+	#else
+		#define tmrbenchGET_TIME( x )	( x ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/* Which of the optional figures can be measured. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+	#define tmrbenchMEASURE_CPU				1
+#else
+	#define tmrbenchMEASURE_CPU				0
+#endif
+
+#if ( configUSE_TRACE_FACILITY == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 )
+	#define tmrbenchMEASURE_QUEUE			1
+#else
+	#define tmrbenchMEASURE_QUEUE			0
+#endif
+
+/* The largest number of timers used.  Numbers of timers in ulScales[] above
+this are skipped. */
+#ifndef tmrbenchMAX_TIMERS
+	#define tmrbenchMAX_TIMERS				( 100 )
+#endif
+
+/* The periods of the timers are multiples of this.  With the default the
+shortest period is a little over 100ms, and the timers expire around 24 times
+per second for each 100 timers. */
+#ifndef tmrbenchBASE_PERIOD
+	#define tmrbenchBASE_PERIOD				( ( ( portTickType ) 100 / portTICK_RATE_MS ) + ( portTickType ) 1 )
+#endif
+
+/* How long the timers are left running for each number of timers. */
+#ifndef tmrbenchRUN_TIME
+	#define tmrbenchRUN_TIME				( ( portTickType ) 1000 / portTICK_RATE_MS )
+#endif
+
+/* While the timers are running a random timer is reset once every
+tmrbenchRESET_INTERVAL ticks. */
+#ifndef tmrbenchRESET_INTERVAL
+	#define tmrbenchRESET_INTERVAL			( ( portTickType ) 10 / portTICK_RATE_MS )
+#endif
+
+/* The lateness histogram has tmrbenchHISTOGRAM_BUCKETS buckets.  The first
+counts expiries that were on time, the second those one tick late, and each
+bucket after that ends at twice the limit of the one before.  The last bucket
+counts the rest. */
+#ifndef tmrbenchHISTOGRAM_BUCKETS
+	#define tmrbenchHISTOGRAM_BUCKETS		( 8 )
+#endif
+
+/* The delay between consecutive passes. */
+#define tmrbenchDELAY_BETWEEN_PASSES	( ( portTickType ) 1000 / portTICK_RATE_MS )
+
+#define tmrbenchSTACK_SIZE				( configMINIMAL_STACK_SIZE * 2 )
+
+#define tmrbenchNUM_SCALES				( 4 )
+#define tmrbenchNUM_PERIODS				( 8 )
+
+/* The period of timer n. */
+#define tmrbenchPERIOD( n )				( tmrbenchBASE_PERIOD * xPeriods[ ( n ) % tmrbenchNUM_PERIODS ] )
+
+/* The command times recorded for each number of timers. */
+#define tmrbenchSTART					( 0 )
+#define tmrbenchRESET					( 1 )
+#define tmrbenchNUM_COMMANDS			( 2 )
+
+/*-----------------------------------------------------------*/
+
+/* The minimum, average and maximum of a set of samples. */
+typedef struct TIMER_BENCH_FIGURE
+{
+	portRUN_TIME_COUNTER_TYPE ulMin;
+	portRUN_TIME_COUNTER_TYPE ulMax;
+	portRUN_TIME_COUNTER_TYPE ulTotal;
+	unsigned long ulSamples;
+} xTimerBenchFigure;
+
+/* The figures recorded for one number of timers. */
+typedef struct TIMER_BENCH_RESULT
+{
+	xTimerBenchFigure xCommands[ tmrbenchNUM_COMMANDS ];
+	xTimerBenchFigure xLateness;
+	unsigned long ulHistogram[ tmrbenchHISTOGRAM_BUCKETS ];
+	unsigned long ulEarly;
+	unsigned long ulCommandFailures;
+	unsigned long ulCPUTenths;
+	unsigned portBASE_TYPE uxQueuePeak;
+	unsigned long ulQueueSendFailures;
+} xTimerBenchResult;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that runs the benchmark.
+ */
+static void prvTimerBenchTask( void *pvParameters );
+
+/*
+ * The callback used by every timer.  Records how late the expiry is.
+ */
+static void prvTimerBenchCallback( xTimerHandle xTimer );
+
+/*
+ * Start or reset timer uxTimer, timing the command.
+ */
+static void prvTimedCommand( unsigned portBASE_TYPE uxCommand, unsigned portBASE_TYPE uxTimer );
+
+/*
+ * Add a sample to a figure.
+ */
+static void prvRecordSample( xTimerBenchFigure *pxFigure, portRUN_TIME_COUNTER_TYPE ulSample );
+
+/*
+ * Returns the CPU time used by the timer service task so far, and sets
+ * *pulTotal to the total run time.
+ */
+#if tmrbenchMEASURE_CPU == 1
+	static portRUN_TIME_COUNTER_TYPE prvTimerTaskRunTime( portRUN_TIME_COUNTER_TYPE *pulTotal );
+#endif
+
+/*
+ * Write a row of the results table, with '-' in place of the figures if there
+ * are no samples.
+ */
+static void prvWriteFigure( signed char *pcWriteBuffer, const char *pcName, xTimerBenchFigure *pxFigure );
+
+/*-----------------------------------------------------------*/
+
+/* The number of timers used by each row of the results. */
+static const unsigned long ulScales[ tmrbenchNUM_SCALES ] = { 10UL, 100UL, 1000UL, 10000UL };
+
+/* The timer periods, as multiples of tmrbenchBASE_PERIOD.  Timer n has the
+period ( n % tmrbenchNUM_PERIODS ). */
+static const portTickType xPeriods[ tmrbenchNUM_PERIODS ] = { 1, 2, 5, 10, 20, 50, 100, 200 };
+
+/* The timers, and the time at which each is next due to expire. */
+static xTimerHandle xTimers[ tmrbenchMAX_TIMERS ];
+static portTickType xExpectedExpiry[ tmrbenchMAX_TIMERS ];
+
+/* The figures for the number of timers in progress, and for the last complete
+pass. */
+static xTimerBenchResult xWorking;
+static xTimerBenchResult xResults[ tmrbenchNUM_SCALES ];
+
+/* Expiries are only recorded while this is set, so an expiry processed after
+the timers should have been stopped is not counted. */
+static volatile portBASE_TYPE xRecording = pdFALSE;
+
+/* The number of timers that were created. */
+static unsigned portBASE_TYPE uxTimersCreated = 0;
+
+/* The timer command queue, found through the queue registry. */
+#if tmrbenchMEASURE_QUEUE == 1
+	static xQueueHandle xTimerQueueHandle = NULL;
+#endif
+
+/* The state of the pseudo random generator used to pick timers to reset. */
+static unsigned long ulNextRand = 0UL;
+
+/* Incremented each time a pass completes, and latched should an error be
+detected.  Both are inspected by xAreTimerBenchTasksStillRunning(). */
+static volatile unsigned long ulPassCounter = 0UL;
+static volatile portBASE_TYPE xErrorDetected = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vStartTimerBenchTasks( unsigned portBASE_TYPE uxPriority )
+{
+	xTaskCreate( prvTimerBenchTask, ( signed char * ) "TBnch", tmrbenchSTACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSample( xTimerBenchFigure *pxFigure, portRUN_TIME_COUNTER_TYPE ulSample )
+{
+	if( ( pxFigure->ulSamples == 0UL ) || ( ulSample < pxFigure->ulMin ) )
+	{
+		pxFigure->ulMin = ulSample;
+	}
+
+	if( ulSample > pxFigure->ulMax )
+	{
+		pxFigure->ulMax = ulSample;
+	}
+
+	pxFigure->ulTotal += ulSample;
+	( pxFigure->ulSamples )++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerBenchCallback( xTimerHandle xTimer )
+{
+unsigned portBASE_TYPE uxTimer = ( unsigned portBASE_TYPE ) pvTimerGetTimerID( xTimer ), uxBucket;
+portTickType xLateness, xBucketLimit = ( portTickType ) 1;
+
+	if( xRecording != pdFALSE )
+	{
+		xLateness = xTaskGetTickCount() - xExpectedExpiry[ uxTimer ];
+
+		/* The subtraction wraps for an early expiry. */
+		if( xLateness > ( portMAX_DELAY / ( portTickType ) 2 ) )
+		{
+			( xWorking.ulEarly )++;
+		}
+		else
+		{
+			prvRecordSample( &( xWorking.xLateness ), ( portRUN_TIME_COUNTER_TYPE ) xLateness );
+
+			for( uxBucket = 0; uxBucket < ( tmrbenchHISTOGRAM_BUCKETS - 1 ); uxBucket++ )
+			{
+				if( xLateness < xBucketLimit )
+				{
+					break;
+				}
+
+				if( uxBucket != 0 )
+				{
+					xBucketLimit <<= 1;
+				}
+				else
+				{
+					xBucketLimit = ( portTickType ) 2;
+				}
+			}
+			( xWorking.ulHistogram[ uxBucket ] )++;
+		}
+	}
+
+	/* An auto-reload timer is reloaded from the time it was due to expire,
+	not the time it was processed. */
+	xExpectedExpiry[ uxTimer ] += tmrbenchPERIOD( uxTimer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimedCommand( unsigned portBASE_TYPE uxCommand, unsigned portBASE_TYPE uxTimer )
+{
+portRUN_TIME_COUNTER_TYPE ulStart, ulEnd;
+portTickType xNow;
+portBASE_TYPE xResult;
+
+	/* This is what both xTimerStart() and xTimerReset() expand to, but with
+	the time the command is sent known to this task so the expected expiry
+	time matches the one the timer service task will use. */
+	xNow = xTaskGetTickCount();
+
+	tmrbenchGET_TIME( ulStart );
+	xResult = xTimerGenericCommand( xTimers[ uxTimer ], tmrCOMMAND_START, xNow, NULL, portMAX_DELAY );
+	tmrbenchGET_TIME( ulEnd );
+
+	if( xResult != pdPASS )
+	{
+		( xWorking.ulCommandFailures )++;
+		xErrorDetected = pdTRUE;
+	}
+	else
+	{
+		prvRecordSample( &( xWorking.xCommands[ uxCommand ] ), ulEnd - ulStart );
+		xExpectedExpiry[ uxTimer ] = xNow + tmrbenchPERIOD( uxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if tmrbenchMEASURE_CPU == 1
+
+	static portRUN_TIME_COUNTER_TYPE prvTimerTaskRunTime( portRUN_TIME_COUNTER_TYPE *pulTotal )
+	{
+	static xTaskStatusType xStatus;
+	unsigned portBASE_TYPE uxCursor = 0;
+	xTaskHandle xTimerTask = xTimerGetTimerDaemonTaskHandle();
+	portRUN_TIME_COUNTER_TYPE ulReturn = 0;
+
+		*pulTotal = 0;
+
+		while( xTaskGetNextTaskStatus( &uxCursor, &xStatus, pulTotal ) == pdTRUE )
+		{
+			if( xStatus.xHandle == xTimerTask )
+			{
+				ulReturn = xStatus.ulRunTimeCounter;
+				break;
+			}
+		}
+
+		return ulReturn;
+	}
+
+#endif /* tmrbenchMEASURE_CPU */
+/*-----------------------------------------------------------*/
+
+static void prvTimerBenchTask( void *pvParameters )
+{
+unsigned portBASE_TYPE uxScale, uxTimer, uxTimers;
+portTickType xLastWakeTime, xElapsed;
+
+	#if tmrbenchMEASURE_CPU == 1
+		portRUN_TIME_COUNTER_TYPE ulTimerTaskStart, ulTimerTaskEnd, ulTotalStart, ulTotalEnd;
+	#endif
+
+	#if tmrbenchMEASURE_QUEUE == 1
+	{
+	xQueueStatusType *pxQueues;
+	unsigned portBASE_TYPE uxQueues, ux;
+
+		/* Find the timer command queue in the registry. */
+		pxQueues = ( xQueueStatusType * ) pvPortMalloc( configQUEUE_REGISTRY_SIZE * sizeof( xQueueStatusType ) );
+		if( pxQueues != NULL )
+		{
+			uxQueues = uxQueueGetSystemState( pxQueues, configQUEUE_REGISTRY_SIZE );
+
+			for( ux = 0; ux < uxQueues; ux++ )
+			{
+				if( strcmp( ( const char * ) pxQueues[ ux ].pcQueueName, "TmrQ" ) == 0 )
+				{
+					xTimerQueueHandle = pxQueues[ ux ].xHandle;
+					break;
+				}
+			}
+
+			vPortFree( pxQueues );
+		}
+	}
+	#endif
+
+	/* Just to remove compiler warnings. */
+	( void ) pvParameters;
+
+	/* Create all the timers up front.  If the heap runs out the rows that need
+	more timers are left empty. */
+	for( uxTimer = 0; uxTimer < ( unsigned portBASE_TYPE ) tmrbenchMAX_TIMERS; uxTimer++ )
+	{
+		xTimers[ uxTimer ] = xTimerCreate( ( const signed char * ) "TBnch", tmrbenchPERIOD( uxTimer ), pdTRUE, ( void * ) uxTimer, prvTimerBenchCallback );
+
+		if( xTimers[ uxTimer ] == NULL )
+		{
+			xErrorDetected = pdTRUE;
+			break;
+		}
+	}
+	uxTimersCreated = uxTimer;
+
+	for( ;; )
+	{
+		for( uxScale = 0; uxScale < tmrbenchNUM_SCALES; uxScale++ )
+		{
+			memset( ( void * ) &xWorking, 0x00, sizeof( xWorking ) );
+
+			if( ulScales[ uxScale ] > ( unsigned long ) uxTimersCreated )
+			{
+				xResults[ uxScale ] = xWorking;
+				continue;
+			}
+
+			uxTimers = ( unsigned portBASE_TYPE ) ulScales[ uxScale ];
+			ulNextRand = 1UL;
+
+			/* Start the timers, recording the expiries of each as soon as it
+			has started. */
+			xRecording = pdTRUE;
+			for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+			{
+				prvTimedCommand( tmrbenchSTART, uxTimer );
+			}
+
+			#if tmrbenchMEASURE_CPU == 1
+			{
+				ulTimerTaskStart = prvTimerTaskRunTime( &ulTotalStart );
+			}
+			#endif
+
+			/* Leave the timers running, resetting one every
+			tmrbenchRESET_INTERVAL ticks. */
+			xLastWakeTime = xTaskGetTickCount();
+			for( xElapsed = 0; xElapsed < tmrbenchRUN_TIME; xElapsed += tmrbenchRESET_INTERVAL )
+			{
+				vTaskDelayUntil( &xLastWakeTime, tmrbenchRESET_INTERVAL );
+
+				ulNextRand = ( ulNextRand * 1103515245UL ) + 12345UL;
+				prvTimedCommand( tmrbenchRESET, ( unsigned portBASE_TYPE ) ( ( ( ulNextRand >> 16UL ) & 0x7fffUL ) % ( unsigned long ) uxTimers ) );
+			}
+
+			#if tmrbenchMEASURE_CPU == 1
+			{
+				ulTimerTaskEnd = prvTimerTaskRunTime( &ulTotalEnd );
+
+				if( ulTotalEnd != ulTotalStart )
+				{
+					xWorking.ulCPUTenths = ( unsigned long ) ( ( ( ulTimerTaskEnd - ulTimerTaskStart ) * 1000UL ) / ( ulTotalEnd - ulTotalStart ) );
+				}
+			}
+			#endif
+
+			xRecording = pdFALSE;
+			for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+			{
+				if( xTimerStop( xTimers[ uxTimer ], portMAX_DELAY ) != pdPASS )
+				{
+					xErrorDetected = pdTRUE;
+				}
+			}
+
+			#if tmrbenchMEASURE_QUEUE == 1
+			{
+			static xQueueStatusType xQueueStatus;
+
+				if( xTimerQueueHandle != NULL )
+				{
+					vQueueGetInfo( xTimerQueueHandle, &xQueueStatus );
+					xWorking.uxQueuePeak = xQueueStatus.uxPeakMessagesWaiting;
+					xWorking.ulQueueSendFailures = xQueueStatus.ulSendFailCount;
+				}
+			}
+			#endif
+
+			/* Publish the figures for this number of timers. */
+			taskENTER_CRITICAL();
+			{
+				xResults[ uxScale ] = xWorking;
+			}
+			taskEXIT_CRITICAL();
+
+			/* Let the timer service task empty its queue before the next
+			row. */
+			vTaskDelay( tmrbenchBASE_PERIOD );
+		}
+
+		ulPassCounter++;
+
+		vTaskDelay( tmrbenchDELAY_BETWEEN_PASSES );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteFigure( signed char *pcWriteBuffer, const char *pcName, xTimerBenchFigure *pxFigure )
+{
+	if( pxFigure->ulSamples == 0UL )
+	{
+		sprintf( ( char * ) pcWriteBuffer, "  %-18s%10s%10s%10s%10lu\r\n", pcName, "-", "-", "-", 0UL );
+	}
+	else
+	{
+		sprintf( ( char * ) pcWriteBuffer, "  %-18s%10lu%10lu%10lu%10lu\r\n", pcName, ( unsigned long ) pxFigure->ulMin, ( unsigned long ) ( pxFigure->ulTotal / pxFigure->ulSamples ), ( unsigned long ) pxFigure->ulMax, pxFigure->ulSamples );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTimerBenchGetResults( signed char *pcWriteBuffer )
+{
+unsigned portBASE_TYPE uxScale, uxBucket;
+xTimerBenchResult xResult;
+unsigned long ulBucketLimit;
+
+	/* Each number of timers takes six lines of under 80 characters, so the
+	buffer must be at least ( tmrbenchNUM_SCALES * 6 + 1 ) * 80 bytes long. */
+	sprintf( ( char * ) pcWriteBuffer, "%-20s%10s%10s%10s%10s\r\n", "Figure", "Min", "Avg", "Max", "Samples" );
+
+	for( uxScale = 0; uxScale < tmrbenchNUM_SCALES; uxScale++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			xResult = xResults[ uxScale ];
+		}
+		taskEXIT_CRITICAL();
+
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+		if( ulScales[ uxScale ] > ( unsigned long ) uxTimersCreated )
+		{
+			sprintf( ( char * ) pcWriteBuffer, "%lu timers: not run\r\n", ulScales[ uxScale ] );
+			continue;
+		}
+
+		sprintf( ( char * ) pcWriteBuffer, "%lu timers:", ulScales[ uxScale ] );
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+		#if tmrbenchMEASURE_CPU == 1
+			sprintf( ( char * ) pcWriteBuffer, " timer task CPU %lu.%lu%%,", xResult.ulCPUTenths / 10UL, xResult.ulCPUTenths % 10UL );
+		#else
+			strcpy( ( char * ) pcWriteBuffer, " timer task CPU -," );
+		#endif
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+		#if tmrbenchMEASURE_QUEUE == 1
+			sprintf( ( char * ) pcWriteBuffer, " queue peak %u/%u, send failures %lu\r\n", ( unsigned int ) xResult.uxQueuePeak, ( unsigned int ) configTIMER_QUEUE_LENGTH, xResult.ulQueueSendFailures );
+		#else
+			strcpy( ( char * ) pcWriteBuffer, " queue peak -, send failures -\r\n" );
+		#endif
+
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		prvWriteFigure( pcWriteBuffer, "xTimerStart()", &( xResult.xCommands[ tmrbenchSTART ] ) );
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		prvWriteFigure( pcWriteBuffer, "xTimerReset()", &( xResult.xCommands[ tmrbenchRESET ] ) );
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		prvWriteFigure( pcWriteBuffer, "lateness (ticks)", &( xResult.xLateness ) );
+
+		/* The histogram, as the count in each bucket after the upper limit of
+		the bucket.  The last bucket has no upper limit. */
+		pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+		strcpy( ( char * ) pcWriteBuffer, "   " );
+		ulBucketLimit = 1UL;
+		for( uxBucket = 0; uxBucket < tmrbenchHISTOGRAM_BUCKETS; uxBucket++ )
+		{
+			pcWriteBuffer += strlen( ( char * ) pcWriteBuffer );
+
+			if( uxBucket == ( tmrbenchHISTOGRAM_BUCKETS - 1 ) )
+			{
+				sprintf( ( char * ) pcWriteBuffer, " >:%lu early:%lu\r\n", xResult.ulHistogram[ uxBucket ], xResult.ulEarly );
+			}
+			else
+			{
+				sprintf( ( char * ) pcWriteBuffer, " <%lu:%lu", ulBucketLimit, xResult.ulHistogram[ uxBucket ] );
+				ulBucketLimit <<= 1;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAreTimerBenchTasksStillRunning( void )
+{
+static unsigned long ulLastPassCounter = 0UL;
+portBASE_TYPE xReturn = pdPASS;
+
+	if( ulPassCounter == ulLastPassCounter )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xErrorDetected != pdFALSE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastPassCounter = ulPassCounter;
+
+	return xReturn;
+}
+
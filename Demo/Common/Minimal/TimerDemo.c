@@ -300,7 +300,8 @@ unsigned portBASE_TYPE xTimer;
 
 	/* The timers queue should now be full, so it should be possible to create
 	another timer, but not possible to start it (the timer queue will not get
-	drained until the scheduler has been started. */
+	drained until the scheduler has been started - unless timer commands are
+	coalesced, in which case they are not held in the queue. */
 	xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ] = xTimerCreate( ( const signed char * ) "FR Timer",	/* Text name to facilitate debugging.  The kernel does not use this itself. */
 													( configTIMER_QUEUE_LENGTH * xBasePeriod ),			/* The period for the timer. */
 													pdTRUE,												/* Auto-reload is set to true. */
@@ -314,13 +315,27 @@ unsigned portBASE_TYPE xTimer;
 	}
 	else
 	{
-		if( xTimerStart( xAutoReloadTimers[ xTimer ], portMAX_DELAY ) == pdPASS )
+		#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
 		{
-			/* This time it would not be expected that the timer could be
-			started at this point. */
-			xTestStatus = pdFAIL;
-			configASSERT( xTestStatus );
+			/* Coalesced commands never fail because the queue is full, so the
+			timer can be started too. */
+			if( xTimerStart( xAutoReloadTimers[ xTimer ], portMAX_DELAY ) != pdPASS )
+			{
+				xTestStatus = pdFAIL;
+				configASSERT( xTestStatus );
+			}
 		}
+		#else
+		{
+			if( xTimerStart( xAutoReloadTimers[ xTimer ], portMAX_DELAY ) == pdPASS )
+			{
+				/* This time it would not be expected that the timer could be
+				started at this point. */
+				xTestStatus = pdFAIL;
+				configASSERT( xTestStatus );
+			}
+		}
+		#endif
 	}
 	
 	/* Create the timers that are used from the tick interrupt to test the timer
@@ -355,7 +370,7 @@ unsigned char ucTimer;
 	auto reload timers 0 to ( configTIMER_QUEUE_LENGTH - 1 ) should now be active,
 	and auto reload timer configTIMER_QUEUE_LENGTH should not yet be active (it
 	could not be started prior to the scheduler being started when it was
-	created). */
+	created) unless timer commands are coalesced. */
 	for( ucTimer = 0; ucTimer < ( unsigned char ) configTIMER_QUEUE_LENGTH; ucTimer++ )
 	{
 		if( xTimerIsTimerActive( xAutoReloadTimers[ ucTimer ] ) == pdFALSE )
@@ -365,11 +380,23 @@ unsigned char ucTimer;
 		}
 	}
 
-	if( xTimerIsTimerActive( xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ] ) != pdFALSE )
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
 	{
-		xTestStatus = pdFAIL;
-		configASSERT( xTestStatus );
+		if( xTimerIsTimerActive( xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ] ) == pdFALSE )
+		{
+			xTestStatus = pdFAIL;
+			configASSERT( xTestStatus );
+		}
 	}
+	#else
+	{
+		if( xTimerIsTimerActive( xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ] ) != pdFALSE )
+		{
+			xTestStatus = pdFAIL;
+			configASSERT( xTestStatus );
+		}
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -446,17 +473,36 @@ unsigned char ucTimer;
 		}
 	}
 
-	taskENTER_CRITICAL();
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
 	{
-		/* The timer in array position configTIMER_QUEUE_LENGTH should not
-		be active.  The critical section is used to ensure the timer does
-		not call its callback between the next line running and the array
-		being cleared back to zero, as that would mask an error condition. */
-		if( ucAutoReloadTimerCounters[ configTIMER_QUEUE_LENGTH ] != ( unsigned char ) 0 )
+		/* The timer in array position configTIMER_QUEUE_LENGTH was started as
+		well, so is stopped along with the others.  It may already have
+		expired, so its callback count is not checked. */
+		xTimerStop( xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ], tmrdemoDONT_BLOCK );
+
+		if( xTimerIsTimerActive( xAutoReloadTimers[ configTIMER_QUEUE_LENGTH ] ) != pdFALSE )
 		{
 			xTestStatus = pdFAIL;
 			configASSERT( xTestStatus );
 		}
+	}
+	#endif
+
+	taskENTER_CRITICAL();
+	{
+		#if ( configUSE_TIMER_COMMAND_COALESCING != 1 )
+		{
+			/* The timer in array position configTIMER_QUEUE_LENGTH should not
+			be active.  The critical section is used to ensure the timer does
+			not call its callback between the next line running and the array
+			being cleared back to zero, as that would mask an error condition. */
+			if( ucAutoReloadTimerCounters[ configTIMER_QUEUE_LENGTH ] != ( unsigned char ) 0 )
+			{
+				xTestStatus = pdFAIL;
+				configASSERT( xTestStatus );
+			}
+		}
+		#endif
 
 		/* Clear the timer callback count. */
 		memset( ( void * ) ucAutoReloadTimerCounters, 0, sizeof( ucAutoReloadTimerCounters ) );
@@ -0,0 +1,250 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Saves a snapshot of the tick count and of the application state in the
+ * memory that is retained while the processor is powered down, and restores it
+ * on the next boot.  See WarmResume.h.
+ *
+ * The retained memory holds a header of wrHEADER_WORDS words followed by the
+ * application state.  The header is written with the magic number zeroed
+ * first, and the magic number is written last, so a snapshot that was not
+ * completely written is never used.  The magic number is cleared again as
+ * soon as a snapshot has been read, so a snapshot is only used once.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "WarmResume.h"
+
+#if ( INCLUDE_vTaskSetInitialTickCount != 1 )
+	#error The warm resume needs INCLUDE_vTaskSetInitialTickCount to be set to 1.
+#endif
+
+/* The most retained memory, in words, that can be used.  Enough for the 64
+words of the LM3S hibernation module. */
+#ifndef wrMAX_RETAINED_WORDS
+	#define wrMAX_RETAINED_WORDS		( 64UL )
+#endif
+
+/* The header words. */
+#define wrMAGIC_WORD				( 0 )
+#define wrTICK_LOW_WORD				( 1 )
+#define wrTICK_HIGH_WORD			( 2 )
+#define wrSECONDS_WORD				( 3 )
+#define wrSIZE_WORD					( 4 )
+#define wrCHECK_WORD				( 5 )
+
+/* Identifies a complete snapshot. */
+#define wrMAGIC						( 0x57524d31UL )
+
+/* The number of words that hold xStateSize bytes of state. */
+#define wrSTATE_WORDS( xStateSize )	( ( ( unsigned long ) ( xStateSize ) + sizeof( unsigned long ) - 1UL ) / sizeof( unsigned long ) )
+
+/* The snapshot is assembled here, as the retained memory may only be
+accessible a word at a time. */
+static unsigned long ulSnapshot[ wrMAX_RETAINED_WORDS ];
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The check value of the header and the first ulStateWords words of the
+ * state in the snapshot, other than the magic number and the check value
+ * itself.
+ */
+static unsigned long prvCheckValue( unsigned long ulStateWords );
+
+/*
+ * The retained memory that can be used, in words.
+ */
+static unsigned long prvRetainedWords( void );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCheckValue( unsigned long ulStateWords )
+{
+unsigned long ulSum1 = 0x1234UL, ulSum2 = 0x5678UL, ulWord, ulIndex;
+const unsigned long ulWords = wrHEADER_WORDS + ulStateWords;
+
+	/* A Fletcher style sum, so words that are swapped or zeroed are caught as
+	well as words that are changed. */
+	for( ulIndex = 0UL; ulIndex < ulWords; ulIndex++ )
+	{
+		if( ( ulIndex != wrMAGIC_WORD ) && ( ulIndex != wrCHECK_WORD ) )
+		{
+			ulWord = ulSnapshot[ ulIndex ];
+			ulSum1 = ( ulSum1 + ( ulWord & 0xffffUL ) + ( ulWord >> 16UL ) ) % 0xffffUL;
+			ulSum2 = ( ulSum2 + ulSum1 ) % 0xffffUL;
+		}
+	}
+
+	return ( ulSum2 << 16UL ) | ulSum1;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRetainedWords( void )
+{
+unsigned long ulWords;
+
+	ulWords = ulWarmResumePortWords();
+	if( ulWords > wrMAX_RETAINED_WORDS )
+	{
+		ulWords = wrMAX_RETAINED_WORDS;
+	}
+
+	return ulWords;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xWarmResumeInit( void *pvState, size_t xStateSize )
+{
+unsigned long ulWords, ulElapsed, ulZero = 0UL;
+portTickType xTicks;
+portBASE_TYPE xReturn = pdFALSE;
+
+	ulWords = prvRetainedWords();
+
+	if( ( xWarmResumePortInit() != pdFALSE ) && ( ulWords > wrHEADER_WORDS ) )
+	{
+		vWarmResumePortRead( ulSnapshot, ulWords );
+
+		if( ( ulSnapshot[ wrMAGIC_WORD ] == wrMAGIC ) &&
+			( ulSnapshot[ wrSIZE_WORD ] == ( unsigned long ) xStateSize ) &&
+			( xStateSize <= wrMAX_STATE_SIZE( ulWords ) ) &&
+			( ulSnapshot[ wrCHECK_WORD ] == prvCheckValue( wrSTATE_WORDS( xStateSize ) ) ) )
+		{
+			memcpy( pvState, &( ulSnapshot[ wrHEADER_WORDS ] ), xStateSize );
+
+			/* The high word is shifted in two steps, so the shift is never as
+			wide as a 32 bit portTickType. */
+			xTicks = ( portTickType ) ulSnapshot[ wrTICK_LOW_WORD ];
+			if( sizeof( portTickType ) > sizeof( unsigned long ) )
+			{
+				xTicks |= ( ( portTickType ) ulSnapshot[ wrTICK_HIGH_WORD ] << 16U ) << 16U;
+			}
+
+			/* The real time clock counts on through the power down.  The
+			elapsed time wraps correctly if the clock has rolled over. */
+			ulElapsed = ulWarmResumePortSeconds() - ulSnapshot[ wrSECONDS_WORD ];
+			xTicks += ( portTickType ) ulElapsed * ( portTickType ) configTICK_RATE_HZ;
+			vTaskSetInitialTickCount( xTicks );
+
+			xReturn = pdTRUE;
+		}
+
+		/* Never resume from the same snapshot twice. */
+		vWarmResumePortWrite( &ulZero, 1UL );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xWarmResumeHibernate( const void *pvState, size_t xStateSize, unsigned long ulSeconds )
+{
+unsigned long ulWords, ulStateWords;
+portTickType xTicks;
+
+	ulWords = prvRetainedWords();
+
+	if( ( ulWords <= wrHEADER_WORDS ) || ( xStateSize > wrMAX_STATE_SIZE( ulWords ) ) )
+	{
+		return pdFAIL;
+	}
+
+	/* Nothing must change the state saved after the tick count is taken. */
+	vTaskSuspendAll();
+	{
+		xTicks = xTaskGetTickCount();
+
+		/* Only the words that hold the state are written.  They are zeroed
+		first so the bytes after the end of the state are known. */
+		ulStateWords = wrSTATE_WORDS( xStateSize );
+		memset( ulSnapshot, 0x00, sizeof( ulSnapshot ) );
+		memcpy( &( ulSnapshot[ wrHEADER_WORDS ] ), pvState, xStateSize );
+
+		ulSnapshot[ wrTICK_LOW_WORD ] = ( unsigned long ) xTicks;
+		if( sizeof( portTickType ) > sizeof( unsigned long ) )
+		{
+			ulSnapshot[ wrTICK_HIGH_WORD ] = ( unsigned long ) ( ( xTicks >> 16U ) >> 16U );
+		}
+		ulSnapshot[ wrSECONDS_WORD ] = ulWarmResumePortSeconds();
+		ulSnapshot[ wrSIZE_WORD ] = ( unsigned long ) xStateSize;
+		ulSnapshot[ wrCHECK_WORD ] = prvCheckValue( ulStateWords );
+
+		/* The magic number is still zero, so the snapshot is not valid until
+		the write below. */
+		vWarmResumePortWrite( ulSnapshot, wrHEADER_WORDS + ulStateWords );
+
+		ulSnapshot[ wrMAGIC_WORD ] = wrMAGIC;
+		vWarmResumePortWrite( ulSnapshot, 1UL );
+
+		vWarmResumePortHibernate( ulSeconds );
+
+		/* The power down could not be entered, so the snapshot must not be
+		resumed from. */
+		ulSnapshot[ wrMAGIC_WORD ] = 0UL;
+		vWarmResumePortWrite( ulSnapshot, 1UL );
+	}
+	xTaskResumeAll();
+
+	return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
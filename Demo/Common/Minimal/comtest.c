@@ -81,6 +81,12 @@
  * transmitted so neither the Tx or Rx queue should ever hold more than a few
  * characters.
  *
+ * If serUSE_BLOCK_TRANSFERS is set to 1 (in FreeRTOSConfig.h) the serial
+ * driver provides usSerialWrite() and usSerialRead().  The Tx task then posts
+ * the whole sequence in one call, and the Rx task reads whatever has arrived
+ * in one call and checks it a character at a time, so the driver can move the
+ * data by DMA.
+ *
  */
 
 /* Scheduler include files. */
@@ -118,6 +124,10 @@ don't have to block to send. */
 #define comBUFFER_LEN				( ( unsigned portBASE_TYPE ) ( comLAST_BYTE - comFIRST_BYTE ) + ( unsigned portBASE_TYPE ) 1 )
 #define comINITIAL_RX_COUNT_VALUE	( 0 )
 
+#ifndef serUSE_BLOCK_TRANSFERS
+	#define serUSE_BLOCK_TRANSFERS	0
+#endif
+
 /* Handle to the com port used by both tasks. */
 static xComPortHandle xPort = NULL;
 
@@ -127,6 +137,10 @@ static portTASK_FUNCTION_PROTO( vComTxTask, pvParameters );
 /* The receive task as described at the top of the file. */
 static portTASK_FUNCTION_PROTO( vComRxTask, pvParameters );
 
+/* Obtain the next received character, with the same semantics as
+xSerialGetChar(). */
+static signed portBASE_TYPE prvGetNextChar( signed char *pcRxedChar, portTickType xBlockTime );
+
 /* The LED that should be toggled by the Rx and Tx tasks.  The Rx task will
 toggle LED ( uxBaseLED + comRX_LED_OFFSET).  The Tx task will toggle LED
 ( uxBaseLED + comTX_LED_OFFSET ). */
@@ -155,21 +169,41 @@ static portTASK_FUNCTION( vComTxTask, pvParameters )
 {
 signed char cByteToSend;
 portTickType xTimeToWait;
+#if serUSE_BLOCK_TRANSFERS == 1
+	signed char cSequence[ comBUFFER_LEN ];
+
+	for( cByteToSend = comFIRST_BYTE; cByteToSend <= comLAST_BYTE; cByteToSend++ )
+	{
+		cSequence[ cByteToSend - comFIRST_BYTE ] = cByteToSend;
+	}
+#endif
 
 	/* Just to stop compiler warnings. */
 	( void ) pvParameters;
 
 	for( ;; )
 	{
-		/* Simply transmit a sequence of characters from comFIRST_BYTE to
-		comLAST_BYTE. */
-		for( cByteToSend = comFIRST_BYTE; cByteToSend <= comLAST_BYTE; cByteToSend++ )
+		#if serUSE_BLOCK_TRANSFERS == 1
 		{
-			if( xSerialPutChar( xPort, cByteToSend, comNO_BLOCK ) == pdPASS )
+			/* Post the whole sequence in one go. */
+			if( usSerialWrite( xPort, cSequence, ( unsigned short ) comBUFFER_LEN, comNO_BLOCK ) == ( unsigned short ) comBUFFER_LEN )
 			{
 				vParTestToggleLED( uxBaseLED + comTX_LED_OFFSET );
 			}
 		}
+		#else
+		{
+			/* Simply transmit a sequence of characters from comFIRST_BYTE to
+			comLAST_BYTE. */
+			for( cByteToSend = comFIRST_BYTE; cByteToSend <= comLAST_BYTE; cByteToSend++ )
+			{
+				if( xSerialPutChar( xPort, cByteToSend, comNO_BLOCK ) == pdPASS )
+				{
+					vParTestToggleLED( uxBaseLED + comTX_LED_OFFSET );
+				}
+			}
+		}
+		#endif
 
 		/* Turn the LED off while we are not doing anything. */
 		vParTestSetLED( uxBaseLED + comTX_LED_OFFSET, pdFALSE );
@@ -209,7 +243,7 @@ portBASE_TYPE xResyncRequired = pdFALSE, xErrorOccurred = pdFALSE;
 		{
 			/* Block on the queue that contains received bytes until a byte is
 			available. */
-			if( xSerialGetChar( xPort, &cByteRxed, comRX_BLOCK_TIME ) )
+			if( prvGetNextChar( &cByteRxed, comRX_BLOCK_TIME ) )
 			{
 				/* Was this the byte we were expecting?  If so, toggle the LED,
 				otherwise we are out on sync and should break out of the loop
@@ -237,7 +271,7 @@ portBASE_TYPE xResyncRequired = pdFALSE, xErrorOccurred = pdFALSE;
 			while( cByteRxed != comLAST_BYTE )
 			{
 				/* Block until the next char is available. */
-				xSerialGetChar( xPort, &cByteRxed, comRX_BLOCK_TIME );
+				prvGetNextChar( &cByteRxed, comRX_BLOCK_TIME );
 			}
 
 			/* Note that an error occurred which caused us to have to resync.
@@ -266,6 +300,35 @@ portBASE_TYPE xResyncRequired = pdFALSE, xErrorOccurred = pdFALSE;
 } /*lint !e715 !e818 pvParameters is required for a task function even if it is not referenced. */
 /*-----------------------------------------------------------*/
 
+static signed portBASE_TYPE prvGetNextChar( signed char *pcRxedChar, portTickType xBlockTime )
+{
+#if serUSE_BLOCK_TRANSFERS == 1
+	/* Characters read from the driver but not yet checked.  Only the Rx task
+	calls this function. */
+	static signed char cRxBuffer[ comBUFFER_LEN ];
+	static unsigned short usRxIndex = 0, usRxCount = 0;
+
+	if( usRxIndex >= usRxCount )
+	{
+		usRxIndex = 0;
+		usRxCount = usSerialRead( xPort, cRxBuffer, ( unsigned short ) sizeof( cRxBuffer ), xBlockTime );
+
+		if( usRxCount == 0 )
+		{
+			return pdFALSE;
+		}
+	}
+
+	*pcRxedChar = cRxBuffer[ usRxIndex ];
+	usRxIndex++;
+
+	return pdTRUE;
+#else
+	return xSerialGetChar( xPort, pcRxedChar, xBlockTime );
+#endif
+}
+/*-----------------------------------------------------------*/
+
 portBASE_TYPE xAreComTestTasksStillRunning( void )
 {
 portBASE_TYPE xReturn;
@@ -74,6 +74,11 @@
  * executes in the context of the timer service (daemon) task, and must 
  * therefore never attempt to block.
  *
+ * If serUSE_BLOCK_TRANSFERS is set to 1 (in FreeRTOSConfig.h) the serial
+ * driver provides usSerialWrite() and usSerialRead().  The string is then
+ * sent with usSerialWrite(), and the Rx task reads whatever has arrived in
+ * one call rather than one character per call.
+ *
  */
 
 /* Scheduler include files. */
@@ -128,6 +133,10 @@ baud rate being used. */
 /* A block time of 0 simply means "don't block". */
 #define comtstDONT_BLOCK			( portTickType ) 0
 
+#ifndef serUSE_BLOCK_TRANSFERS
+	#define serUSE_BLOCK_TRANSFERS	0
+#endif
+
 /* Handle to the com port used by both tasks. */
 static xComPortHandle xPort = NULL;
 
@@ -138,6 +147,10 @@ static void prvComTxTimerCallback( xTimerHandle xTimer );
 /* The receive task as described in the comments at the top of this file. */
 static void vComRxTask( void *pvParameters );
 
+/* Obtain the next received character, with the same semantics as
+xSerialGetChar(). */
+static signed portBASE_TYPE prvGetNextChar( signed char *pcRxedChar, portTickType xBlockTime );
+
 /* The Rx task will toggle LED ( uxBaseLED + comRX_LED_OFFSET).  The Tx task
 will toggle LED ( uxBaseLED + comTX_LED_OFFSET ). */
 static unsigned portBASE_TYPE uxBaseLED = 0;
@@ -193,7 +206,15 @@ portTickType xTimeToWait;
 	sample driver provided with this demo.  However - as this is a timer,
 	it executes in the context of the timer task and therefore must not
 	block. */
-	vSerialPutString( xPort, ( const signed char * const ) comTRANSACTED_STRING, xStringLength );
+	#if serUSE_BLOCK_TRANSFERS == 1
+	{
+		( void ) usSerialWrite( xPort, ( const signed char * const ) comTRANSACTED_STRING, ( unsigned short ) xStringLength, comtstDONT_BLOCK );
+	}
+	#else
+	{
+		vSerialPutString( xPort, ( const signed char * const ) comTRANSACTED_STRING, xStringLength );
+	}
+	#endif
 
 	/* Toggle an LED to give a visible indication that another transmission
 	has been performed. */
@@ -222,7 +243,6 @@ static void vComRxTask( void *pvParameters )
 {
 portBASE_TYPE xState = comtstWAITING_START_OF_STRING, xErrorOccurred = pdFALSE;
 signed char *pcExpectedByte, cRxedChar;
-const xComPortHandle xPort = NULL;
 
 	/* The parameter is not used in this example. */
 	( void ) pvParameters;
@@ -238,7 +258,7 @@ const xComPortHandle xPort = NULL;
 	for( ;; )
 	{
 		/* Wait for the next character. */
-		if( xSerialGetChar( xPort, &cRxedChar, ( comTX_MAX_BLOCK_TIME * 2 ) ) == pdFALSE )
+		if( prvGetNextChar( &cRxedChar, ( comTX_MAX_BLOCK_TIME * 2 ) ) == pdFALSE )
 		{
 			/* A character definitely should have been received by now.  As a
 			character was not received an error must have occurred (which might
@@ -312,6 +332,35 @@ const xComPortHandle xPort = NULL;
 }
 /*-----------------------------------------------------------*/
 
+static signed portBASE_TYPE prvGetNextChar( signed char *pcRxedChar, portTickType xBlockTime )
+{
+#if serUSE_BLOCK_TRANSFERS == 1
+	/* Characters read from the driver but not yet checked.  Only the Rx task
+	calls this function. */
+	static signed char cRxBuffer[ sizeof( comTRANSACTED_STRING ) ];
+	static unsigned short usRxIndex = 0, usRxCount = 0;
+
+	if( usRxIndex >= usRxCount )
+	{
+		usRxIndex = 0;
+		usRxCount = usSerialRead( xPort, cRxBuffer, ( unsigned short ) sizeof( cRxBuffer ), xBlockTime );
+
+		if( usRxCount == 0 )
+		{
+			return pdFALSE;
+		}
+	}
+
+	*pcRxedChar = cRxBuffer[ usRxIndex ];
+	usRxIndex++;
+
+	return pdTRUE;
+#else
+	return xSerialGetChar( xPort, pcRxedChar, xBlockTime );
+#endif
+}
+/*-----------------------------------------------------------*/
+
 portBASE_TYPE xAreComTestTasksStillRunning( void )
 {
 portBASE_TYPE xReturn;
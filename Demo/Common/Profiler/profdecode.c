@@ -0,0 +1,598 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * profdecode - turns a FreeRTOS profiler histogram into a list of functions.
+ *
+ * The profiler (Source/profiler.c) counts samples of the interrupted program
+ * counter in the xProfiler structure in the RAM of the target.  To decode the
+ * histogram, save a binary image of the structure to a file - for example
+ * using the GDB command:
+ *
+ *     dump binary value profile.bin xProfiler
+ *
+ * or by sending the memory returned by pvProfilerGetData() over a serial
+ * link - save the symbol table of the program that was running with nm:
+ *
+ *     arm-none-eabi-nm -n program.elf > program.sym
+ *
+ * then run:
+ *
+ *     profdecode [-b] [-n count] profile.bin program.sym
+ *
+ * The image may also be a larger memory image that contains the structure, as
+ * the structure is located by searching for its signature.  The structure
+ * describes its own layout, so the decoder does not need to be built with the
+ * configuration used by the target, and the target may have a different word
+ * size and byte order to the host.
+ *
+ * The samples counted against each task are printed first, followed by the
+ * functions that samples fell in, most sampled first, limited to count
+ * functions if -n is given.  Each bucket is charged to the function that
+ * contains the first address of the bucket, so a bucket that spans the end of
+ * one function and the start of the next is charged to the first of them -
+ * smaller buckets (a lower configPROFILER_BUCKET_SHIFT) make that less
+ * likely.  -b also lists every bucket that holds samples, in address order.
+ *
+ * Build with any host C compiler, for example:
+ *
+ *     gcc -o profdecode profdecode.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match profPROFILER_VERSION in Source/include/profiler.h. */
+#define profPROFILER_VERSION	1
+
+/* The index of each unsigned long in the header, which starts 8 bytes into
+the structure. */
+#define profHDR_ENDIANNESS		0
+#define profHDR_LOW_ADDRESS		1
+#define profHDR_HIGH_ADDRESS	2
+#define profHDR_TASK_OFFSET		3
+#define profHDR_TASK_COUNT		4
+#define profHDR_TASK_SIZE		5
+#define profHDR_NAME_LENGTH		6
+#define profHDR_BUCKET_OFFSET	7
+#define profHDR_BUCKET_COUNT	8
+#define profHDR_SAMPLES			9
+#define profHDR_OUT_OF_RANGE	10
+#define profHDR_NOT_RECORDED	11
+#define profHDR_FILTER_TASK		12
+#define profHDR_RUNNING			13
+#define profHDR_LONGS			14
+
+#define profMAX_NAME_LENGTH		64
+
+/* A code symbol read from the nm output. */
+typedef struct SYMBOL
+{
+	unsigned long ulAddress;
+	char *pcName;
+	unsigned long ulSamples;
+} xSymbol;
+
+/* The samples counted against one task. */
+typedef struct TASK
+{
+	char cName[ profMAX_NAME_LENGTH ];
+	unsigned long ulSamples;
+} xTask;
+
+/* The layout of the profiler structure, read from its header. */
+static const unsigned char *pucProfiler;
+static int iBigEndian;
+static unsigned long ulLongSize;
+static unsigned long ulPointerSize;
+static unsigned long ulHeader[ profHDR_LONGS ];
+
+static xSymbol *pxSymbols;
+static unsigned long ulSymbolCount;
+
+/*-----------------------------------------------------------*/
+
+/* Read an unsigned value of ulSize bytes, in the byte order of the target. */
+static unsigned long prvRead( unsigned long ulOffset, unsigned long ulSize )
+{
+unsigned long ulValue = 0UL, x;
+
+	for( x = 0; x < ulSize; x++ )
+	{
+		if( iBigEndian )
+		{
+			ulValue = ( ulValue << 8 ) | pucProfiler[ ulOffset + x ];
+		}
+		else
+		{
+			ulValue |= ( ( unsigned long ) pucProfiler[ ulOffset + x ] ) << ( 8 * x );
+		}
+	}
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+/* Round ulOffset up to a multiple of ulAlignment. */
+static unsigned long prvAlign( unsigned long ulOffset, unsigned long ulAlignment )
+{
+	return ( ( ulOffset + ulAlignment - 1UL ) / ulAlignment ) * ulAlignment;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareAddresses( const void *pv1, const void *pv2 )
+{
+const xSymbol *px1 = ( const xSymbol * ) pv1, *px2 = ( const xSymbol * ) pv2;
+
+	if( px1->ulAddress < px2->ulAddress )
+	{
+		return -1;
+	}
+
+	return ( px1->ulAddress > px2->ulAddress ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSymbolSamples( const void *pv1, const void *pv2 )
+{
+const xSymbol *px1 = ( const xSymbol * ) pv1, *px2 = ( const xSymbol * ) pv2;
+
+	if( px1->ulSamples > px2->ulSamples )
+	{
+		return -1;
+	}
+
+	return ( px1->ulSamples < px2->ulSamples ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareTaskSamples( const void *pv1, const void *pv2 )
+{
+const xTask *px1 = ( const xTask * ) pv1, *px2 = ( const xTask * ) pv2;
+
+	if( px1->ulSamples > px2->ulSamples )
+	{
+		return -1;
+	}
+
+	return ( px1->ulSamples < px2->ulSamples ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/* Read the code symbols from the output of nm, with or without -S.  Each
+line is an address, optionally a size, a type letter and a name. */
+static int prvReadSymbols( const char *pcFileName )
+{
+FILE *pxFile;
+char cLine[ 512 ], cType[ 8 ], cName[ 400 ], cSecond[ 32 ];
+unsigned long ulAddress, ulAllocated = 0UL;
+int iFields;
+
+	pxFile = fopen( pcFileName, "r" );
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return 0;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		iFields = sscanf( cLine, "%lx %31s %7s %399s", &ulAddress, cSecond, cType, cName );
+
+		if( iFields == 3 )
+		{
+			/* No size column - the fields are address, type and name. */
+			strcpy( cName, cType );
+			strcpy( cType, cSecond );
+		}
+		else if( iFields != 4 )
+		{
+			continue;
+		}
+
+		/* Only symbols in the text section are of interest, and not the ARM
+		mapping symbols ($a, $t and $d) that some versions of nm list. */
+		if( ( cType[ 1 ] != '\0' ) || ( strchr( "TtWw", cType[ 0 ] ) == NULL ) || ( cName[ 0 ] == '$' ) )
+		{
+			continue;
+		}
+
+		if( ulSymbolCount == ulAllocated )
+		{
+			ulAllocated = ( ulAllocated == 0UL ) ? 256UL : ( ulAllocated * 2UL );
+			pxSymbols = ( xSymbol * ) realloc( pxSymbols, ulAllocated * sizeof( xSymbol ) );
+			if( pxSymbols == NULL )
+			{
+				fprintf( stderr, "%s: out of memory\n", pcFileName );
+				fclose( pxFile );
+				return 0;
+			}
+		}
+
+		/* The address of a Thumb function has bit 0 set, but the PC stacked
+		by the processor does not. */
+		pxSymbols[ ulSymbolCount ].ulAddress = ulAddress & ~1UL;
+		pxSymbols[ ulSymbolCount ].pcName = ( char * ) malloc( strlen( cName ) + 1 );
+		pxSymbols[ ulSymbolCount ].ulSamples = 0UL;
+
+		if( pxSymbols[ ulSymbolCount ].pcName == NULL )
+		{
+			fprintf( stderr, "%s: out of memory\n", pcFileName );
+			fclose( pxFile );
+			return 0;
+		}
+
+		strcpy( pxSymbols[ ulSymbolCount ].pcName, cName );
+		ulSymbolCount++;
+	}
+
+	fclose( pxFile );
+
+	if( ulSymbolCount == 0UL )
+	{
+		fprintf( stderr, "%s: no code symbols found - expected the output of nm\n", pcFileName );
+		return 0;
+	}
+
+	qsort( pxSymbols, ( size_t ) ulSymbolCount, sizeof( xSymbol ), prvCompareAddresses );
+
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the symbol that contains ulAddress, or NULL if ulAddress is below
+the first symbol. */
+static xSymbol *prvFindSymbol( unsigned long ulAddress )
+{
+unsigned long ulLow = 0UL, ulHigh = ulSymbolCount, ulMiddle;
+
+	/* Find the first symbol above ulAddress. */
+	while( ulLow < ulHigh )
+	{
+		ulMiddle = ulLow + ( ( ulHigh - ulLow ) / 2UL );
+
+		if( pxSymbols[ ulMiddle ].ulAddress <= ulAddress )
+		{
+			ulLow = ulMiddle + 1UL;
+		}
+		else
+		{
+			ulHigh = ulMiddle;
+		}
+	}
+
+	return ( ulLow == 0UL ) ? NULL : &( pxSymbols[ ulLow - 1UL ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintPercent( unsigned long ulCount, unsigned long ulTotal )
+{
+	if( ulTotal == 0UL )
+	{
+		printf( "%7s", "-" );
+	}
+	else
+	{
+		printf( "%6.2f%%", ( 100.0 * ( double ) ulCount ) / ( double ) ulTotal );
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxFile;
+unsigned char *pucFile;
+long lFileSize;
+unsigned long ulProfilerSize, ulNeeded, x, ulEntry, ulSamples, ulBucketSize, ulAddress;
+unsigned long ulInBuckets = 0UL, ulUnknown = 0UL, ulCumulative = 0UL, ulTaskCount = 0UL, ulLimit = 0UL;
+unsigned long ulNameLength, ulSamplesOffset;
+xSymbol *pxSymbol;
+xTask *pxTasks;
+const char *pcFileName = NULL, *pcSymbolFileName = NULL;
+char cFilterName[ profMAX_NAME_LENGTH ];
+int iArg, iListBuckets = 0;
+
+	for( iArg = 1; iArg < argc; iArg++ )
+	{
+		if( strcmp( argv[ iArg ], "-b" ) == 0 )
+		{
+			iListBuckets = 1;
+		}
+		else if( ( strcmp( argv[ iArg ], "-n" ) == 0 ) && ( ( iArg + 1 ) < argc ) )
+		{
+			iArg++;
+			ulLimit = strtoul( argv[ iArg ], NULL, 0 );
+		}
+		else if( pcFileName == NULL )
+		{
+			pcFileName = argv[ iArg ];
+		}
+		else if( pcSymbolFileName == NULL )
+		{
+			pcSymbolFileName = argv[ iArg ];
+		}
+		else
+		{
+			pcSymbolFileName = NULL;
+			break;
+		}
+	}
+
+	if( pcSymbolFileName == NULL )
+	{
+		fprintf( stderr, "usage: %s [-b] [-n count] file symbols\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	/* Read the whole file. */
+	pxFile = fopen( pcFileName, "rb" );
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return EXIT_FAILURE;
+	}
+
+	fseek( pxFile, 0L, SEEK_END );
+	lFileSize = ftell( pxFile );
+	fseek( pxFile, 0L, SEEK_SET );
+
+	if( lFileSize <= 0L )
+	{
+		fprintf( stderr, "%s: file is empty\n", pcFileName );
+		fclose( pxFile );
+		return EXIT_FAILURE;
+	}
+
+	pucFile = ( unsigned char * ) malloc( ( size_t ) lFileSize );
+	if( ( pucFile == NULL ) || ( fread( pucFile, 1, ( size_t ) lFileSize, pxFile ) != ( size_t ) lFileSize ) )
+	{
+		fprintf( stderr, "%s: could not read file\n", pcFileName );
+		fclose( pxFile );
+		return EXIT_FAILURE;
+	}
+	fclose( pxFile );
+
+	/* Find the structure by its signature.  The signature is followed by the
+	version and the size of a long, which must be sensible. */
+	pucProfiler = NULL;
+	for( x = 0; ( x + 8UL ) <= ( unsigned long ) lFileSize; x++ )
+	{
+		if( ( memcmp( pucFile + x, "FRPF", 4 ) == 0 ) && ( pucFile[ x + 4 ] == profPROFILER_VERSION ) && ( ( pucFile[ x + 5 ] == 4 ) || ( pucFile[ x + 5 ] == 8 ) ) )
+		{
+			pucProfiler = pucFile + x;
+			break;
+		}
+	}
+
+	if( pucProfiler == NULL )
+	{
+		fprintf( stderr, "%s: no version %d profiler data found\n", pcFileName, profPROFILER_VERSION );
+		return EXIT_FAILURE;
+	}
+
+	ulProfilerSize = ( unsigned long ) lFileSize - ( unsigned long ) ( pucProfiler - pucFile );
+	ulLongSize = pucProfiler[ 5 ];
+	ulPointerSize = pucProfiler[ 6 ];
+
+	if( ( ulLongSize > sizeof( unsigned long ) ) || ( ulPointerSize > sizeof( unsigned long ) ) || ( ulPointerSize == 0UL ) )
+	{
+		fprintf( stderr, "%s: the target uses %lu byte longs and %lu byte pointers, which this host cannot decode\n", pcFileName, ulLongSize, ulPointerSize );
+		return EXIT_FAILURE;
+	}
+
+	if( ( 8UL + ( profHDR_LONGS * ulLongSize ) ) > ulProfilerSize )
+	{
+		fprintf( stderr, "%s: profiler data is truncated\n", pcFileName );
+		return EXIT_FAILURE;
+	}
+
+	/* The least significant byte of 0x01020304 is 0x04. */
+	iBigEndian = ( pucProfiler[ 8 ] != 0x04 );
+
+	for( x = 0; x < profHDR_LONGS; x++ )
+	{
+		ulHeader[ x ] = prvRead( 8UL + ( x * ulLongSize ), ulLongSize );
+	}
+
+	ulNeeded = ulHeader[ profHDR_BUCKET_OFFSET ] + ( ulHeader[ profHDR_BUCKET_COUNT ] * 2UL );
+	if( ( ulNeeded > ulProfilerSize ) || ( ( ulHeader[ profHDR_TASK_OFFSET ] + ( ulHeader[ profHDR_TASK_COUNT ] * ulHeader[ profHDR_TASK_SIZE ] ) ) > ulProfilerSize ) )
+	{
+		fprintf( stderr, "%s: profiler data is truncated - %lu bytes are needed but only %lu were found\n", pcFileName, ulNeeded, ulProfilerSize );
+		return EXIT_FAILURE;
+	}
+
+	if( prvReadSymbols( pcSymbolFileName ) == 0 )
+	{
+		return EXIT_FAILURE;
+	}
+
+	ulBucketSize = 1UL << pucProfiler[ 7 ];
+
+	printf( "Profiler version %u: %lu byte longs, %lu byte pointers, %s endian.\n", ( unsigned ) pucProfiler[ 4 ], ulLongSize, ulPointerSize, iBigEndian ? "big" : "little" );
+	printf( "Addresses 0x%08lx to 0x%08lx in %lu byte buckets.  Sampling was %s.\n", ulHeader[ profHDR_LOW_ADDRESS ], ulHeader[ profHDR_HIGH_ADDRESS ], ulBucketSize, ulHeader[ profHDR_RUNNING ] ? "running" : "stopped" );
+	printf( "%lu samples, %lu outside the address range, %lu from tasks missing from the task table.\n", ulHeader[ profHDR_SAMPLES ], ulHeader[ profHDR_OUT_OF_RANGE ], ulHeader[ profHDR_NOT_RECORDED ] );
+
+	/* The task table.  The members of an entry are naturally aligned - see
+	xProfilerTask. */
+	ulNameLength = ulHeader[ profHDR_NAME_LENGTH ];
+	if( ulNameLength >= profMAX_NAME_LENGTH )
+	{
+		ulNameLength = profMAX_NAME_LENGTH - 1;
+	}
+
+	ulSamplesOffset = prvAlign( ulPointerSize, ulLongSize );
+	cFilterName[ 0 ] = '\0';
+
+	pxTasks = ( xTask * ) malloc( ( size_t ) ( ulHeader[ profHDR_TASK_COUNT ] + 1UL ) * sizeof( xTask ) );
+	if( pxTasks == NULL )
+	{
+		fprintf( stderr, "out of memory\n" );
+		return EXIT_FAILURE;
+	}
+
+	for( x = 0; x < ulHeader[ profHDR_TASK_COUNT ]; x++ )
+	{
+		ulEntry = ulHeader[ profHDR_TASK_OFFSET ] + ( x * ulHeader[ profHDR_TASK_SIZE ] );
+
+		if( prvRead( ulEntry, ulPointerSize ) != 0UL )
+		{
+			memcpy( pxTasks[ ulTaskCount ].cName, pucProfiler + ulEntry + ulSamplesOffset + ulLongSize, ulNameLength );
+			pxTasks[ ulTaskCount ].cName[ ulNameLength ] = '\0';
+			pxTasks[ ulTaskCount ].ulSamples = prvRead( ulEntry + ulSamplesOffset, ulLongSize );
+
+			if( ulHeader[ profHDR_FILTER_TASK ] == ( x + 1UL ) )
+			{
+				strcpy( cFilterName, pxTasks[ ulTaskCount ].cName );
+			}
+
+			ulTaskCount++;
+		}
+	}
+
+	qsort( pxTasks, ( size_t ) ulTaskCount, sizeof( xTask ), prvCompareTaskSamples );
+
+	printf( "\n%-20s %10s %7s\n", "Task", "Samples", "" );
+	for( x = 0; x < ulTaskCount; x++ )
+	{
+		printf( "%-20s %10lu ", pxTasks[ x ].cName, pxTasks[ x ].ulSamples );
+		prvPrintPercent( pxTasks[ x ].ulSamples, ulHeader[ profHDR_SAMPLES ] );
+		printf( "\n" );
+	}
+
+	if( ulHeader[ profHDR_FILTER_TASK ] != 0UL )
+	{
+		printf( "\nOnly samples taken while %s was running are in the histogram.\n", cFilterName );
+	}
+
+	/* Charge each bucket to a function. */
+	if( iListBuckets )
+	{
+		printf( "\n%-10s %10s %7s  %s\n", "Bucket", "Samples", "", "Function" );
+	}
+
+	for( x = 0; x < ulHeader[ profHDR_BUCKET_COUNT ]; x++ )
+	{
+		ulSamples = prvRead( ulHeader[ profHDR_BUCKET_OFFSET ] + ( x * 2UL ), 2UL );
+		ulInBuckets += ulSamples;
+	}
+
+	for( x = 0; x < ulHeader[ profHDR_BUCKET_COUNT ]; x++ )
+	{
+		ulSamples = prvRead( ulHeader[ profHDR_BUCKET_OFFSET ] + ( x * 2UL ), 2UL );
+
+		if( ulSamples != 0UL )
+		{
+			ulAddress = ulHeader[ profHDR_LOW_ADDRESS ] + ( x * ulBucketSize );
+			pxSymbol = prvFindSymbol( ulAddress );
+
+			if( pxSymbol != NULL )
+			{
+				pxSymbol->ulSamples += ulSamples;
+			}
+			else
+			{
+				ulUnknown += ulSamples;
+			}
+
+			if( iListBuckets )
+			{
+				printf( "0x%08lx %10lu ", ulAddress, ulSamples );
+				prvPrintPercent( ulSamples, ulInBuckets );
+
+				if( pxSymbol != NULL )
+				{
+					printf( "  %s+0x%lx", pxSymbol->pcName, ulAddress - pxSymbol->ulAddress );
+				}
+
+				if( ulSamples == 0xffffUL )
+				{
+					printf( "   <<< full" );
+				}
+
+				printf( "\n" );
+			}
+		}
+	}
+
+	qsort( pxSymbols, ( size_t ) ulSymbolCount, sizeof( xSymbol ), prvCompareSymbolSamples );
+
+	printf( "\n%-40s %10s %7s %7s\n", "Function", "Samples", "", "Total" );
+	for( x = 0; ( x < ulSymbolCount ) && ( pxSymbols[ x ].ulSamples != 0UL ); x++ )
+	{
+		if( ( ulLimit != 0UL ) && ( x >= ulLimit ) )
+		{
+			break;
+		}
+
+		ulCumulative += pxSymbols[ x ].ulSamples;
+		printf( "%-40s %10lu ", pxSymbols[ x ].pcName, pxSymbols[ x ].ulSamples );
+		prvPrintPercent( pxSymbols[ x ].ulSamples, ulInBuckets );
+		printf( " " );
+		prvPrintPercent( ulCumulative, ulInBuckets );
+		printf( "\n" );
+	}
+
+	if( ulUnknown != 0UL )
+	{
+		printf( "%-40s %10lu ", "(below the first symbol)", ulUnknown );
+		prvPrintPercent( ulUnknown, ulInBuckets );
+		printf( "\n" );
+	}
+
+	free( pxTasks );
+	free( pucFile );
+
+	return EXIT_SUCCESS;
+}
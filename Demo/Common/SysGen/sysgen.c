@@ -0,0 +1,733 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * sysgen - builds the static kernel objects of an application from a
+ * description of the system, so the objects do not have to be created one
+ * at a time from the FreeRTOS heap at boot.
+ *
+ * The description is a text file with one object per line.  Everything
+ * following a '#' is a comment.  The lines are:
+ *
+ *     include   file
+ *     task      handle function stack-depth priority [parameter]
+ *     queue     handle length item-size
+ *     binary    handle
+ *     counting  handle max-count initial-count
+ *     mutex     handle
+ *     recursive handle
+ *     timer     handle callback period auto-reload [auto-start [id]]
+ *     idletask  stack-depth
+ *     timertask stack-depth
+ *
+ * handle is the name of the handle variable that is generated for the
+ * object, which is also used as the name of the task or timer and the name
+ * under which queues and semaphores are added to the queue registry.
+ * function and callback name the task function and the timer callback
+ * function.  The numeric fields, parameter and id are copied into the
+ * generated source unchanged, so they can be constants or macros from an
+ * included header - for example sizeof(xMessage) or (tskIDLE_PRIORITY+2) -
+ * but must not contain spaces.  auto-reload and auto-start are 0 or 1.
+ * include adds a #include of file (which is written with its quotes or angle
+ * brackets) to the generated source, for the definitions those fields use.
+ * idletask and timertask generate vApplicationGetIdleTaskMemory() and
+ * vApplicationGetTimerTaskMemory(), which supply the memory used by the
+ * tasks the kernel creates itself, with a stack of the given depth.
+ *
+ * For example:
+ *
+ *     include "app.h"
+ *     task    xRxTask  vRxTask  256 (tskIDLE_PRIORITY+2)
+ *     queue   xRxQueue 10 sizeof(xMessage)
+ *     mutex   xBusLock
+ *     timer   xLedTimer vLedTimer 500 1 1
+ *
+ * Running:
+ *
+ *     sysgen system.txt sysgen_objects
+ *
+ * writes sysgen_objects.c and sysgen_objects.h.  The source holds the stack,
+ * the TCB, the queue storage area and the timer structure of every object as
+ * file scope variables - so the RAM they use is fixed when the program is
+ * linked - and a const table of the parameters of each object, which is
+ * placed in read only memory.  The header declares the handles, the number
+ * of each type of object and:
+ *
+ *     portBASE_TYPE xSysGenCreateObjects( void );
+ *
+ * which the application calls once before vTaskStartScheduler().  It walks
+ * the tables passing each entry to xTaskCreateStatic(), the static queue
+ * and semaphore create functions and xTimerCreateStatic(), then starts the
+ * timers that are marked auto-start.  As the memory is already allocated
+ * nothing can fail through lack of heap space, and the whole system is built
+ * by one loop over read only tables rather than by hundreds of individual
+ * calls in the application's start up code.  pdPASS is returned if every
+ * object was created.
+ *
+ * The generated source needs configSUPPORT_STATIC_ALLOCATION set to 1, and
+ * configUSE_TIMERS set to 1 if the description includes timers.  Timers are
+ * started by sending a command to the timer service task, which does not run
+ * until the scheduler starts, so configTIMER_QUEUE_LENGTH must be at least
+ * the number of auto-start timers - the generated source checks this at
+ * compile time.
+ *
+ * Build with any host C compiler, for example:
+ *
+ *     gcc -o sysgen sysgen.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define sgMAX_LINE_LENGTH		512
+#define sgMAX_TOKENS			8
+#define sgMAX_FIELD_LENGTH		128
+
+/* The types of object that can be described. */
+#define sgTASK					0
+#define sgQUEUE					1
+#define sgBINARY				2
+#define sgCOUNTING				3
+#define sgMUTEX					4
+#define sgRECURSIVE				5
+#define sgTIMER					6
+#define sgINCLUDE				7
+#define sgIDLE_TASK				8
+#define sgTIMER_TASK			9
+
+/* One line of the description. */
+typedef struct OBJECT
+{
+	int iType;
+	unsigned long ulLine;
+	char cField[ sgMAX_TOKENS ][ sgMAX_FIELD_LENGTH ];
+	int iFields;
+} xObject;
+
+/* The keyword, the minimum and maximum number of fields (including the
+keyword) of each type of line, in sg type order. */
+static const struct
+{
+	const char *pcKeyword;
+	int iMinimumFields;
+	int iMaximumFields;
+} xLineTypes[] =
+{
+	{ "task", 5, 6 },
+	{ "queue", 4, 4 },
+	{ "binary", 2, 2 },
+	{ "counting", 4, 4 },
+	{ "mutex", 2, 2 },
+	{ "recursive", 2, 2 },
+	{ "timer", 5, 7 },
+	{ "include", 2, 2 },
+	{ "idletask", 2, 2 },
+	{ "timertask", 2, 2 }
+};
+
+#define sgLINE_TYPES	( ( int ) ( sizeof( xLineTypes ) / sizeof( xLineTypes[ 0 ] ) ) )
+
+static xObject *pxObjects;
+static unsigned long ulObjectCount;
+
+/*-----------------------------------------------------------*/
+
+static int prvIsIdentifier( const char *pc )
+{
+	if( !( isalpha( ( unsigned char ) *pc ) || ( *pc == '_' ) ) )
+	{
+		return 0;
+	}
+
+	while( *pc != '\0' )
+	{
+		if( !( isalnum( ( unsigned char ) *pc ) || ( *pc == '_' ) ) )
+		{
+			return 0;
+		}
+		pc++;
+	}
+
+	return 1;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCount( int iType )
+{
+unsigned long x, ulCount = 0UL;
+
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		if( pxObjects[ x ].iType == iType )
+		{
+			ulCount++;
+		}
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+/* The queues and the four types of semaphore share one table. */
+static int prvIsQueueType( int iType )
+{
+	return ( iType >= sgQUEUE ) && ( iType <= sgRECURSIVE );
+}
+/*-----------------------------------------------------------*/
+
+/* Auto-start is the optional fifth field of a timer line. */
+static int prvIsAutoStart( const xObject *pxObject )
+{
+	return ( pxObject->iType == sgTIMER ) && ( pxObject->iFields > 5 ) && ( strcmp( pxObject->cField[ 5 ], "0" ) != 0 );
+}
+/*-----------------------------------------------------------*/
+
+static int prvReadDescription( const char *pcFileName )
+{
+FILE *pxFile;
+char cLine[ sgMAX_LINE_LENGTH ], *pcToken, *pcComment;
+unsigned long ulLine = 0UL, ulAllocated = 0UL, x;
+xObject xLine;
+int iType, iErrors = 0;
+
+	pxFile = fopen( pcFileName, "r" );
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return 0;
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		ulLine++;
+
+		pcComment = strchr( cLine, '#' );
+		if( pcComment != NULL )
+		{
+			*pcComment = '\0';
+		}
+
+		memset( &xLine, 0x00, sizeof( xLine ) );
+		xLine.ulLine = ulLine;
+
+		for( pcToken = strtok( cLine, " \t\r\n" ); pcToken != NULL; pcToken = strtok( NULL, " \t\r\n" ) )
+		{
+			if( ( xLine.iFields == sgMAX_TOKENS ) || ( strlen( pcToken ) >= sgMAX_FIELD_LENGTH ) )
+			{
+				xLine.iFields = sgMAX_TOKENS + 1;
+				break;
+			}
+
+			strcpy( xLine.cField[ xLine.iFields ], pcToken );
+			xLine.iFields++;
+		}
+
+		if( xLine.iFields == 0 )
+		{
+			continue;
+		}
+
+		for( iType = 0; iType < sgLINE_TYPES; iType++ )
+		{
+			if( strcmp( xLine.cField[ 0 ], xLineTypes[ iType ].pcKeyword ) == 0 )
+			{
+				break;
+			}
+		}
+
+		if( iType == sgLINE_TYPES )
+		{
+			fprintf( stderr, "%s:%lu: unknown object type '%s'\n", pcFileName, ulLine, xLine.cField[ 0 ] );
+			iErrors++;
+			continue;
+		}
+
+		if( ( xLine.iFields < xLineTypes[ iType ].iMinimumFields ) || ( xLine.iFields > xLineTypes[ iType ].iMaximumFields ) )
+		{
+			fprintf( stderr, "%s:%lu: wrong number of fields for %s\n", pcFileName, ulLine, xLineTypes[ iType ].pcKeyword );
+			iErrors++;
+			continue;
+		}
+
+		xLine.iType = iType;
+
+		if( iType < sgINCLUDE )
+		{
+			if( !prvIsIdentifier( xLine.cField[ 1 ] ) )
+			{
+				fprintf( stderr, "%s:%lu: '%s' is not a valid handle name\n", pcFileName, ulLine, xLine.cField[ 1 ] );
+				iErrors++;
+				continue;
+			}
+
+			if( ( ( iType == sgTASK ) || ( iType == sgTIMER ) ) && !prvIsIdentifier( xLine.cField[ 2 ] ) )
+			{
+				fprintf( stderr, "%s:%lu: '%s' is not a valid function name\n", pcFileName, ulLine, xLine.cField[ 2 ] );
+				iErrors++;
+				continue;
+			}
+
+			for( x = 0; x < ulObjectCount; x++ )
+			{
+				if( ( pxObjects[ x ].iType < sgINCLUDE ) && ( strcmp( pxObjects[ x ].cField[ 1 ], xLine.cField[ 1 ] ) == 0 ) )
+				{
+					fprintf( stderr, "%s:%lu: '%s' was already defined on line %lu\n", pcFileName, ulLine, xLine.cField[ 1 ], pxObjects[ x ].ulLine );
+					iErrors++;
+					break;
+				}
+			}
+
+			if( x != ulObjectCount )
+			{
+				continue;
+			}
+		}
+		else if( ( iType != sgINCLUDE ) && ( prvCount( iType ) != 0UL ) )
+		{
+			fprintf( stderr, "%s:%lu: %s can only be given once\n", pcFileName, ulLine, xLineTypes[ iType ].pcKeyword );
+			iErrors++;
+			continue;
+		}
+
+		if( ulObjectCount == ulAllocated )
+		{
+			ulAllocated = ( ulAllocated == 0UL ) ? 64UL : ( ulAllocated * 2UL );
+			pxObjects = ( xObject * ) realloc( pxObjects, ulAllocated * sizeof( xObject ) );
+			if( pxObjects == NULL )
+			{
+				fprintf( stderr, "%s: out of memory\n", pcFileName );
+				fclose( pxFile );
+				return 0;
+			}
+		}
+
+		pxObjects[ ulObjectCount ] = xLine;
+		ulObjectCount++;
+	}
+
+	fclose( pxFile );
+
+	return ( iErrors == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteHeader( FILE *pxFile, const char *pcDescription, const char *pcGuard )
+{
+unsigned long x;
+const xObject *pxObject;
+
+	fprintf( pxFile, "/* Generated by sysgen from %s - do not edit. */\n\n", pcDescription );
+	fprintf( pxFile, "#ifndef %s\n#define %s\n\n", pcGuard, pcGuard );
+	fprintf( pxFile, "#define sysgenNUMBER_OF_TASKS\t\t%lu\n", prvCount( sgTASK ) );
+	fprintf( pxFile, "#define sysgenNUMBER_OF_QUEUES\t\t%lu\n", prvCount( sgQUEUE ) );
+	fprintf( pxFile, "#define sysgenNUMBER_OF_SEMAPHORES\t%lu\n", prvCount( sgBINARY ) + prvCount( sgCOUNTING ) + prvCount( sgMUTEX ) + prvCount( sgRECURSIVE ) );
+	fprintf( pxFile, "#define sysgenNUMBER_OF_TIMERS\t\t%lu\n\n", prvCount( sgTIMER ) );
+
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		pxObject = &( pxObjects[ x ] );
+
+		switch( pxObject->iType )
+		{
+			case sgTASK		:	fprintf( pxFile, "extern xTaskHandle %s;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgQUEUE	:	fprintf( pxFile, "extern xQueueHandle %s;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgTIMER	:	fprintf( pxFile, "extern xTimerHandle %s;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgINCLUDE	:
+			case sgIDLE_TASK	:
+			case sgTIMER_TASK	:	break;
+			default			:	fprintf( pxFile, "extern xSemaphoreHandle %s;\n", pxObject->cField[ 1 ] );
+								break;
+		}
+	}
+
+	fprintf( pxFile, "\n/* Create every object in the system description.  Must be called once,\n" );
+	fprintf( pxFile, "before vTaskStartScheduler().  Returns pdPASS if every object was created. */\n" );
+	fprintf( pxFile, "portBASE_TYPE xSysGenCreateObjects( void );\n\n" );
+	fprintf( pxFile, "#endif /* %s */\n", pcGuard );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSource( FILE *pxFile, const char *pcDescription, const char *pcHeaderName )
+{
+unsigned long x, ulTasks, ulQueues, ulTimers, ulAutoStart = 0UL;
+const xObject *pxObject;
+static const char * const pcQueueTypes[] = { "", "sysgenTYPE_QUEUE", "sysgenTYPE_BINARY", "sysgenTYPE_COUNTING", "sysgenTYPE_MUTEX", "sysgenTYPE_RECURSIVE" };
+
+	ulTasks = prvCount( sgTASK );
+	ulTimers = prvCount( sgTIMER );
+	ulQueues = prvCount( sgQUEUE ) + prvCount( sgBINARY ) + prvCount( sgCOUNTING ) + prvCount( sgMUTEX ) + prvCount( sgRECURSIVE );
+
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		if( prvIsAutoStart( &( pxObjects[ x ] ) ) )
+		{
+			ulAutoStart++;
+		}
+	}
+
+	fprintf( pxFile, "/* Generated by sysgen from %s - do not edit. */\n\n", pcDescription );
+	fprintf( pxFile, "#include \"FreeRTOS.h\"\n#include \"task.h\"\n#include \"queue.h\"\n#include \"semphr.h\"\n" );
+	if( ulTimers > 0UL )
+	{
+		fprintf( pxFile, "#include \"timers.h\"\n" );
+	}
+
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		if( pxObjects[ x ].iType == sgINCLUDE )
+		{
+			fprintf( pxFile, "#include %s\n", pxObjects[ x ].cField[ 1 ] );
+		}
+	}
+	fprintf( pxFile, "#include \"%s\"\n\n", pcHeaderName );
+
+	fprintf( pxFile, "#if ( configSUPPORT_STATIC_ALLOCATION != 1 )\n" );
+	fprintf( pxFile, "\t#error configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use the objects generated by sysgen.\n" );
+	fprintf( pxFile, "#endif\n\n" );
+	if( ulAutoStart > 0UL )
+	{
+		fprintf( pxFile, "#if ( configTIMER_QUEUE_LENGTH < %lu )\n", ulAutoStart );
+		fprintf( pxFile, "\t#error configTIMER_QUEUE_LENGTH must be at least %lu to hold the start commands of the auto-start timers.\n", ulAutoStart );
+		fprintf( pxFile, "#endif\n\n" );
+	}
+
+	fprintf( pxFile, "#define sysgenTYPE_QUEUE\t\t( 0U )\n#define sysgenTYPE_BINARY\t\t( 1U )\n#define sysgenTYPE_COUNTING\t\t( 2U )\n#define sysgenTYPE_MUTEX\t\t( 3U )\n#define sysgenTYPE_RECURSIVE\t( 4U )\n\n" );
+
+	/* The functions referenced by the tables. */
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		pxObject = &( pxObjects[ x ] );
+
+		if( pxObject->iType == sgTASK )
+		{
+			fprintf( pxFile, "void %s( void *pvParameters );\n", pxObject->cField[ 2 ] );
+		}
+		else if( pxObject->iType == sgTIMER )
+		{
+			fprintf( pxFile, "void %s( xTimerHandle xTimer );\n", pxObject->cField[ 2 ] );
+		}
+	}
+	fprintf( pxFile, "\n" );
+
+	/* The handles. */
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		pxObject = &( pxObjects[ x ] );
+
+		switch( pxObject->iType )
+		{
+			case sgTASK		:	fprintf( pxFile, "xTaskHandle %s = NULL;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgQUEUE	:	fprintf( pxFile, "xQueueHandle %s = NULL;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgTIMER	:	fprintf( pxFile, "xTimerHandle %s = NULL;\n", pxObject->cField[ 1 ] );
+								break;
+			case sgINCLUDE	:
+			case sgIDLE_TASK	:
+			case sgTIMER_TASK	:	break;
+			default			:	fprintf( pxFile, "xSemaphoreHandle %s = NULL;\n", pxObject->cField[ 1 ] );
+								break;
+		}
+	}
+	fprintf( pxFile, "\n" );
+
+	/* The memory used by the objects. */
+	if( ulTasks > 0UL )
+	{
+		fprintf( pxFile, "static xStaticTask xSysGenTCBs[ %luU ];\n", ulTasks );
+		for( x = 0; x < ulObjectCount; x++ )
+		{
+			if( pxObjects[ x ].iType == sgTASK )
+			{
+				fprintf( pxFile, "static portSTACK_TYPE xSysGenStack_%s[ %s ];\n", pxObjects[ x ].cField[ 1 ], pxObjects[ x ].cField[ 3 ] );
+			}
+		}
+		fprintf( pxFile, "\n" );
+	}
+
+	if( ulQueues > 0UL )
+	{
+		fprintf( pxFile, "static xStaticQueue xSysGenQueues[ %luU ];\n", ulQueues );
+		for( x = 0; x < ulObjectCount; x++ )
+		{
+			if( pxObjects[ x ].iType == sgQUEUE )
+			{
+				fprintf( pxFile, "static unsigned char ucSysGenStorage_%s[ ( %s ) * ( %s ) ];\n", pxObjects[ x ].cField[ 1 ], pxObjects[ x ].cField[ 2 ], pxObjects[ x ].cField[ 3 ] );
+			}
+		}
+		fprintf( pxFile, "\n" );
+	}
+
+	if( ulTimers > 0UL )
+	{
+		fprintf( pxFile, "static xStaticTimer xSysGenTimers[ %luU ];\n\n", ulTimers );
+	}
+
+	/* The tables. */
+	if( ulTasks > 0UL )
+	{
+		fprintf( pxFile, "typedef struct SYSGEN_TASK\n{\n\tpdTASK_CODE pxTaskCode;\n\tconst signed char *pcName;\n\tunsigned short usStackDepth;\n" );
+		fprintf( pxFile, "\tvoid *pvParameters;\n\tunsigned portBASE_TYPE uxPriority;\n\txTaskHandle *pxHandle;\n\tportSTACK_TYPE *puxStack;\n} xSysGenTask;\n\n" );
+		fprintf( pxFile, "static const xSysGenTask xSysGenTaskTable[ %luU ] =\n{\n", ulTasks );
+		for( x = 0; x < ulObjectCount; x++ )
+		{
+			pxObject = &( pxObjects[ x ] );
+			if( pxObject->iType == sgTASK )
+			{
+				fprintf( pxFile, "\t{ %s, ( const signed char * ) \"%s\", ( unsigned short ) ( %s ), ( void * ) ( %s ), ( unsigned portBASE_TYPE ) ( %s ), &%s, xSysGenStack_%s },\n",
+						pxObject->cField[ 2 ], pxObject->cField[ 1 ], pxObject->cField[ 3 ], ( pxObject->iFields > 5 ) ? pxObject->cField[ 5 ] : "NULL",
+						pxObject->cField[ 4 ], pxObject->cField[ 1 ], pxObject->cField[ 1 ] );
+			}
+		}
+		fprintf( pxFile, "};\n\n" );
+	}
+
+	if( ulQueues > 0UL )
+	{
+		fprintf( pxFile, "typedef struct SYSGEN_QUEUE\n{\n\tunsigned char ucType;\n\tconst signed char *pcName;\n\tunsigned portBASE_TYPE uxLength;\n" );
+		fprintf( pxFile, "\tunsigned portBASE_TYPE uxItemSize;\n\tunsigned char *pucStorage;\n\txQueueHandle *pxHandle;\n} xSysGenQueue;\n\n" );
+		fprintf( pxFile, "static const xSysGenQueue xSysGenQueueTable[ %luU ] =\n{\n", ulQueues );
+		for( x = 0; x < ulObjectCount; x++ )
+		{
+			pxObject = &( pxObjects[ x ] );
+			if( pxObject->iType == sgQUEUE )
+			{
+				fprintf( pxFile, "\t{ sysgenTYPE_QUEUE, ( const signed char * ) \"%s\", ( unsigned portBASE_TYPE ) ( %s ), ( unsigned portBASE_TYPE ) ( %s ), ucSysGenStorage_%s, &%s },\n",
+						pxObject->cField[ 1 ], pxObject->cField[ 2 ], pxObject->cField[ 3 ], pxObject->cField[ 1 ], pxObject->cField[ 1 ] );
+			}
+			else if( pxObject->iType == sgCOUNTING )
+			{
+				/* A counting semaphore holds its maximum count in uxLength and
+				its initial count in uxItemSize. */
+				fprintf( pxFile, "\t{ sysgenTYPE_COUNTING, ( const signed char * ) \"%s\", ( unsigned portBASE_TYPE ) ( %s ), ( unsigned portBASE_TYPE ) ( %s ), NULL, &%s },\n",
+						pxObject->cField[ 1 ], pxObject->cField[ 2 ], pxObject->cField[ 3 ], pxObject->cField[ 1 ] );
+			}
+			else if( prvIsQueueType( pxObject->iType ) )
+			{
+				fprintf( pxFile, "\t{ %s, ( const signed char * ) \"%s\", 0U, 0U, NULL, &%s },\n",
+						pcQueueTypes[ pxObject->iType ], pxObject->cField[ 1 ], pxObject->cField[ 1 ] );
+			}
+		}
+		fprintf( pxFile, "};\n\n" );
+	}
+
+	if( ulTimers > 0UL )
+	{
+		fprintf( pxFile, "typedef struct SYSGEN_TIMER\n{\n\tconst signed char *pcName;\n\tportTickType xPeriod;\n\tunsigned portBASE_TYPE uxAutoReload;\n" );
+		fprintf( pxFile, "\tportBASE_TYPE xAutoStart;\n\tvoid *pvTimerID;\n\ttmrTIMER_CALLBACK pxCallback;\n\txTimerHandle *pxHandle;\n} xSysGenTimer;\n\n" );
+		fprintf( pxFile, "static const xSysGenTimer xSysGenTimerTable[ %luU ] =\n{\n", ulTimers );
+		for( x = 0; x < ulObjectCount; x++ )
+		{
+			pxObject = &( pxObjects[ x ] );
+			if( pxObject->iType == sgTIMER )
+			{
+				fprintf( pxFile, "\t{ ( const signed char * ) \"%s\", ( portTickType ) ( %s ), ( unsigned portBASE_TYPE ) ( %s ), %s, ( void * ) ( %s ), %s, &%s },\n",
+						pxObject->cField[ 1 ], pxObject->cField[ 3 ], pxObject->cField[ 4 ], prvIsAutoStart( pxObject ) ? "pdTRUE" : "pdFALSE",
+						( pxObject->iFields > 6 ) ? pxObject->cField[ 6 ] : "NULL", pxObject->cField[ 2 ], pxObject->cField[ 1 ] );
+			}
+		}
+		fprintf( pxFile, "};\n\n" );
+	}
+
+	/* The function that walks the tables. */
+	fprintf( pxFile, "portBASE_TYPE xSysGenCreateObjects( void )\n{\n" );
+	fprintf( pxFile, "portBASE_TYPE xReturn = pdPASS;\n" );
+	if( ( ulTasks + ulQueues + ulTimers ) > 0UL )
+	{
+		fprintf( pxFile, "unsigned portBASE_TYPE ux;\n" );
+	}
+	fprintf( pxFile, "\n" );
+
+	if( ulTasks > 0UL )
+	{
+		fprintf( pxFile, "\tfor( ux = 0U; ux < ( unsigned portBASE_TYPE ) sysgenNUMBER_OF_TASKS; ux++ )\n\t{\n" );
+		fprintf( pxFile, "\t\tif( xTaskCreateStatic( xSysGenTaskTable[ ux ].pxTaskCode, xSysGenTaskTable[ ux ].pcName, xSysGenTaskTable[ ux ].usStackDepth, xSysGenTaskTable[ ux ].pvParameters,\n" );
+		fprintf( pxFile, "\t\t\t\t\t\t\t\txSysGenTaskTable[ ux ].uxPriority, xSysGenTaskTable[ ux ].pxHandle, xSysGenTaskTable[ ux ].puxStack, &( xSysGenTCBs[ ux ] ) ) != pdPASS )\n" );
+		fprintf( pxFile, "\t\t{\n\t\t\txReturn = pdFAIL;\n\t\t}\n\t}\n\n" );
+	}
+
+	if( ulQueues > 0UL )
+	{
+		fprintf( pxFile, "\tfor( ux = 0U; ux < %luU; ux++ )\n\t{\n", ulQueues );
+		fprintf( pxFile, "\t\tswitch( xSysGenQueueTable[ ux ].ucType )\n\t\t{\n" );
+		if( prvCount( sgQUEUE ) > 0UL )
+		{
+			fprintf( pxFile, "\t\t\tcase sysgenTYPE_QUEUE\t\t:\t*( xSysGenQueueTable[ ux ].pxHandle ) = xQueueCreateStatic( xSysGenQueueTable[ ux ].uxLength, xSysGenQueueTable[ ux ].uxItemSize, xSysGenQueueTable[ ux ].pucStorage, &( xSysGenQueues[ ux ] ) );\n\t\t\t\t\t\t\t\t\tbreak;\n" );
+		}
+		if( prvCount( sgBINARY ) > 0UL )
+		{
+			fprintf( pxFile, "\t\t\tcase sysgenTYPE_BINARY\t\t:\tvSemaphoreCreateBinaryStatic( *( xSysGenQueueTable[ ux ].pxHandle ), &( xSysGenQueues[ ux ] ) );\n\t\t\t\t\t\t\t\t\tbreak;\n" );
+		}
+		if( prvCount( sgCOUNTING ) > 0UL )
+		{
+			fprintf( pxFile, "\t\t\tcase sysgenTYPE_COUNTING\t:\t*( xSysGenQueueTable[ ux ].pxHandle ) = xSemaphoreCreateCountingStatic( xSysGenQueueTable[ ux ].uxLength, xSysGenQueueTable[ ux ].uxItemSize, &( xSysGenQueues[ ux ] ) );\n\t\t\t\t\t\t\t\t\tbreak;\n" );
+		}
+		if( prvCount( sgMUTEX ) > 0UL )
+		{
+			fprintf( pxFile, "\t\t\tcase sysgenTYPE_MUTEX\t\t:\t*( xSysGenQueueTable[ ux ].pxHandle ) = xSemaphoreCreateMutexStatic( &( xSysGenQueues[ ux ] ) );\n\t\t\t\t\t\t\t\t\tbreak;\n" );
+		}
+		if( prvCount( sgRECURSIVE ) > 0UL )
+		{
+			fprintf( pxFile, "\t\t\tcase sysgenTYPE_RECURSIVE\t:\t*( xSysGenQueueTable[ ux ].pxHandle ) = xSemaphoreCreateRecursiveMutexStatic( &( xSysGenQueues[ ux ] ) );\n\t\t\t\t\t\t\t\t\tbreak;\n" );
+		}
+		fprintf( pxFile, "\t\t\tdefault\t\t\t\t:\tbreak;\n\t\t}\n\n" );
+		fprintf( pxFile, "\t\tif( *( xSysGenQueueTable[ ux ].pxHandle ) == NULL )\n\t\t{\n\t\t\txReturn = pdFAIL;\n\t\t}\n" );
+		fprintf( pxFile, "\t\t#if ( configQUEUE_REGISTRY_SIZE > 0 )\n\t\telse\n\t\t{\n" );
+		fprintf( pxFile, "\t\t\tvQueueAddToRegistry( *( xSysGenQueueTable[ ux ].pxHandle ), ( signed char * ) xSysGenQueueTable[ ux ].pcName );\n\t\t}\n\t\t#endif\n\t}\n\n" );
+	}
+
+	if( ulTimers > 0UL )
+	{
+		fprintf( pxFile, "\tfor( ux = 0U; ux < ( unsigned portBASE_TYPE ) sysgenNUMBER_OF_TIMERS; ux++ )\n\t{\n" );
+		fprintf( pxFile, "\t\t*( xSysGenTimerTable[ ux ].pxHandle ) = xTimerCreateStatic( xSysGenTimerTable[ ux ].pcName, xSysGenTimerTable[ ux ].xPeriod, xSysGenTimerTable[ ux ].uxAutoReload,\n" );
+		fprintf( pxFile, "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\txSysGenTimerTable[ ux ].pvTimerID, xSysGenTimerTable[ ux ].pxCallback, &( xSysGenTimers[ ux ] ) );\n\n" );
+		fprintf( pxFile, "\t\tif( *( xSysGenTimerTable[ ux ].pxHandle ) == NULL )\n\t\t{\n\t\t\txReturn = pdFAIL;\n\t\t}\n" );
+		fprintf( pxFile, "\t\telse if( xSysGenTimerTable[ ux ].xAutoStart != pdFALSE )\n\t\t{\n" );
+		fprintf( pxFile, "\t\t\tif( xTimerStart( *( xSysGenTimerTable[ ux ].pxHandle ), 0 ) != pdPASS )\n\t\t\t{\n\t\t\t\txReturn = pdFAIL;\n\t\t\t}\n\t\t}\n\t}\n\n" );
+	}
+
+	fprintf( pxFile, "\tconfigASSERT( xReturn == pdPASS );\n\n\treturn xReturn;\n}\n" );
+
+	/* The memory used by the tasks the kernel creates. */
+	for( x = 0; x < ulObjectCount; x++ )
+	{
+		pxObject = &( pxObjects[ x ] );
+
+		if( pxObject->iType == sgIDLE_TASK )
+		{
+			fprintf( pxFile, "/*-----------------------------------------------------------*/\n\n" );
+			fprintf( pxFile, "static xStaticTask xSysGenIdleTCB;\nstatic portSTACK_TYPE xSysGenIdleStack[ %s ];\n\n", pxObject->cField[ 1 ] );
+			fprintf( pxFile, "void vApplicationGetIdleTaskMemory( xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize )\n{\n" );
+			fprintf( pxFile, "\t*ppxIdleTaskTCBBuffer = &xSysGenIdleTCB;\n\t*ppxIdleTaskStackBuffer = xSysGenIdleStack;\n\t*pusIdleTaskStackSize = ( unsigned short ) ( %s );\n}\n", pxObject->cField[ 1 ] );
+		}
+		else if( pxObject->iType == sgTIMER_TASK )
+		{
+			fprintf( pxFile, "/*-----------------------------------------------------------*/\n\n#if ( configUSE_TIMERS == 1 )\n\n" );
+			fprintf( pxFile, "static xStaticTask xSysGenTimerTaskTCB;\nstatic portSTACK_TYPE xSysGenTimerTaskStack[ %s ];\n\n", pxObject->cField[ 1 ] );
+			fprintf( pxFile, "void vApplicationGetTimerTaskMemory( xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize )\n{\n" );
+			fprintf( pxFile, "\t*ppxTimerTaskTCBBuffer = &xSysGenTimerTaskTCB;\n\t*ppxTimerTaskStackBuffer = xSysGenTimerTaskStack;\n\t*pusTimerTaskStackSize = ( unsigned short ) ( %s );\n}\n\n#endif\n", pxObject->cField[ 1 ] );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxFile;
+char *pcSourceName, *pcHeaderName, *pcGuard;
+const char *pcBaseName, *pcHeaderBaseName;
+size_t xLength, x;
+
+	if( argc != 3 )
+	{
+		fprintf( stderr, "usage: %s description output\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	if( !prvReadDescription( argv[ 1 ] ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	pcBaseName = argv[ 2 ];
+	xLength = strlen( pcBaseName );
+	pcSourceName = ( char * ) malloc( xLength + 3 );
+	pcHeaderName = ( char * ) malloc( xLength + 3 );
+	pcGuard = ( char * ) malloc( xLength + 3 );
+	if( ( pcSourceName == NULL ) || ( pcHeaderName == NULL ) || ( pcGuard == NULL ) )
+	{
+		fprintf( stderr, "%s: out of memory\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	sprintf( pcSourceName, "%s.c", pcBaseName );
+	sprintf( pcHeaderName, "%s.h", pcBaseName );
+
+	/* The source includes the header by its name without any directory, and
+	the include guard is made from the same name. */
+	pcHeaderBaseName = strrchr( pcHeaderName, '/' );
+	pcHeaderBaseName = ( pcHeaderBaseName == NULL ) ? pcHeaderName : ( pcHeaderBaseName + 1 );
+	for( x = 0; pcHeaderBaseName[ x ] != '\0'; x++ )
+	{
+		pcGuard[ x ] = isalnum( ( unsigned char ) pcHeaderBaseName[ x ] ) ? ( char ) toupper( ( unsigned char ) pcHeaderBaseName[ x ] ) : '_';
+	}
+	pcGuard[ x ] = '\0';
+
+	pxFile = fopen( pcHeaderName, "w" );
+	if( pxFile == NULL )
+	{
+		perror( pcHeaderName );
+		return EXIT_FAILURE;
+	}
+	prvWriteHeader( pxFile, argv[ 1 ], pcGuard );
+	fclose( pxFile );
+
+	pxFile = fopen( pcSourceName, "w" );
+	if( pxFile == NULL )
+	{
+		perror( pcSourceName );
+		return EXIT_FAILURE;
+	}
+	prvWriteSource( pxFile, argv[ 1 ], pcHeaderBaseName );
+	fclose( pxFile );
+
+	printf( "%s: %lu tasks, %lu queues, %lu semaphores and %lu timers\n", pcSourceName, prvCount( sgTASK ), prvCount( sgQUEUE ),
+			prvCount( sgBINARY ) + prvCount( sgCOUNTING ) + prvCount( sgMUTEX ) + prvCount( sgRECURSIVE ), prvCount( sgTIMER ) );
+
+	return EXIT_SUCCESS;
+}
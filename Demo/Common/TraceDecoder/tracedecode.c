@@ -0,0 +1,524 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * tracedecode - prints the contents of a FreeRTOS trace recorder buffer.
+ *
+ * The trace recorder (Source/trace_recorder.c) writes events into the
+ * xTraceRecorder structure in the RAM of the target.  To decode the events,
+ * save a binary image of the structure to a file - for example using the GDB
+ * command:
+ *
+ *     dump binary value trace.bin xTraceRecorder
+ *
+ * or by sending the memory returned by pvTraceRecorderGetData() over a serial
+ * link - then run:
+ *
+ *     tracedecode [-t threshold] trace.bin
+ *
+ * The file may also be a larger memory image that contains the structure, as
+ * the structure is located by searching for its signature.  The structure
+ * describes its own layout, so the decoder does not need to be built with the
+ * configuration used by the target, and the target may have a different word
+ * size and byte order to the host.
+ *
+ * Each event is printed on its own line with its timestamp, the time since
+ * the previous event on the same core, the core number, the event name, the
+ * object the event relates to (by name where the name is known) and the event
+ * parameter.  If a threshold is given then any event that follows the
+ * previous event on the same core by more than the threshold is marked,
+ * making it easy to find latency spikes in a long trace.
+ *
+ * Build with any host C compiler, for example:
+ *
+ *     gcc -o tracedecode tracedecode.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match trcRECORDER_VERSION in Source/include/trace_recorder.h. */
+#define trcRECORDER_VERSION		1
+
+/* The index of each unsigned long in the header, which starts 8 bytes into
+the structure. */
+#define trcHDR_ENDIANNESS		0
+#define trcHDR_TIMESTAMP_SOURCE	1
+#define trcHDR_NAME_OFFSET		2
+#define trcHDR_NAME_COUNT		3
+#define trcHDR_NAME_SIZE		4
+#define trcHDR_NAME_LENGTH		5
+#define trcHDR_EVENT_OFFSET		6
+#define trcHDR_EVENT_COUNT		7
+#define trcHDR_EVENT_SIZE		8
+#define trcHDR_NEXT_NAME		9
+#define trcHDR_NEXT_EVENT		10
+#define trcHDR_EVENTS_WRITTEN	11
+#define trcHDR_RECORDING		12
+#define trcHDR_LONGS			13
+
+#define trcMAX_CORES			32
+#define trcUSER_EVENT_BASE		0xf0
+
+typedef struct EVENT_NAME
+{
+	unsigned char ucCode;
+	const char *pcName;
+} xEventName;
+
+/* THESE CODES MUST BE KEPT IN STEP WITH THE trcEVENT_ DEFINITIONS IN
+Source/include/trace_recorder.h. */
+static const xEventName xEventNames[] =
+{
+	{ 0x01, "TASK_SWITCHED_IN" },
+	{ 0x02, "TASK_SWITCHED_OUT" },
+	{ 0x03, "TASK_MOVED_TO_READY" },
+	{ 0x04, "TASK_CREATE" },
+	{ 0x05, "TASK_CREATE_FAILED" },
+	{ 0x06, "TASK_DELETE" },
+	{ 0x07, "TASK_DELAY" },
+	{ 0x08, "TASK_DELAY_UNTIL" },
+	{ 0x09, "TASK_PRIORITY_SET" },
+	{ 0x0a, "TASK_PRIORITY_INHERIT" },
+	{ 0x0b, "TASK_PRIORITY_DISINHERIT" },
+	{ 0x0c, "TASK_SUSPEND" },
+	{ 0x0d, "TASK_RESUME" },
+	{ 0x0e, "TASK_RESUME_FROM_ISR" },
+	{ 0x0f, "TASK_INCREMENT_TICK" },
+	{ 0x10, "TASK_INCREASE_TICK_COUNT" },
+	{ 0x11, "LOW_POWER_IDLE_BEGIN" },
+	{ 0x12, "LOW_POWER_IDLE_END" },
+	{ 0x13, "TASK_NOTIFY" },
+	{ 0x14, "TASK_NOTIFY_FROM_ISR" },
+	{ 0x15, "TASK_NOTIFY_GIVE_FROM_ISR" },
+	{ 0x16, "TASK_NOTIFY_TAKE" },
+	{ 0x17, "TASK_NOTIFY_TAKE_BLOCK" },
+	{ 0x18, "TASK_NOTIFY_WAIT" },
+	{ 0x19, "TASK_NOTIFY_WAIT_BLOCK" },
+
+	{ 0x20, "QUEUE_CREATE" },
+	{ 0x21, "QUEUE_CREATE_FAILED" },
+	{ 0x22, "QUEUE_DELETE" },
+	{ 0x23, "QUEUE_SEND" },
+	{ 0x24, "QUEUE_SEND_FAILED" },
+	{ 0x25, "QUEUE_SEND_FROM_ISR" },
+	{ 0x26, "QUEUE_SEND_FROM_ISR_FAILED" },
+	{ 0x27, "QUEUE_RECEIVE" },
+	{ 0x28, "QUEUE_RECEIVE_FAILED" },
+	{ 0x29, "QUEUE_RECEIVE_FROM_ISR" },
+	{ 0x2a, "QUEUE_RECEIVE_FROM_ISR_FAILED" },
+	{ 0x2b, "QUEUE_PEEK" },
+	{ 0x2c, "BLOCKING_ON_QUEUE_SEND" },
+	{ 0x2d, "BLOCKING_ON_QUEUE_RECEIVE" },
+	{ 0x2e, "CREATE_MUTEX" },
+	{ 0x2f, "CREATE_MUTEX_FAILED" },
+	{ 0x30, "GIVE_MUTEX_RECURSIVE" },
+	{ 0x31, "GIVE_MUTEX_RECURSIVE_FAILED" },
+	{ 0x32, "TAKE_MUTEX_RECURSIVE" },
+	{ 0x33, "TAKE_MUTEX_RECURSIVE_FAILED" },
+	{ 0x34, "CREATE_COUNTING_SEMAPHORE" },
+	{ 0x35, "CREATE_COUNTING_SEMAPHORE_FAILED" },
+
+	{ 0x40, "TIMER_CREATE" },
+	{ 0x41, "TIMER_CREATE_FAILED" },
+	{ 0x42, "TIMER_COMMAND_SEND" },
+	{ 0x43, "TIMER_COMMAND_SEND_FAILED" },
+	{ 0x44, "TIMER_COMMAND_RECEIVED" },
+	{ 0x45, "TIMER_EXPIRED" },
+	{ 0x46, "PEND_FUNC_CALL" },
+	{ 0x47, "PEND_FUNC_CALL_FAILED" },
+	{ 0x48, "PEND_FUNC_CALL_FROM_ISR" },
+	{ 0x49, "PEND_FUNC_CALL_FROM_ISR_FAILED" },
+
+	{ 0x50, "EVENT_GROUP_CREATE" },
+	{ 0x51, "EVENT_GROUP_CREATE_FAILED" },
+	{ 0x52, "EVENT_GROUP_DELETE" },
+	{ 0x53, "EVENT_GROUP_WAIT_BITS_BLOCK" },
+	{ 0x54, "EVENT_GROUP_WAIT_BITS_END" },
+	{ 0x55, "EVENT_GROUP_WAIT_BITS_TIMEOUT" },
+	{ 0x56, "EVENT_GROUP_CLEAR_BITS" },
+	{ 0x57, "EVENT_GROUP_CLEAR_BITS_FROM_ISR" },
+	{ 0x58, "EVENT_GROUP_SET_BITS" },
+	{ 0x59, "EVENT_GROUP_SET_BITS_FROM_ISR" },
+
+	{ 0x60, "STREAM_BUFFER_CREATE" },
+	{ 0x61, "STREAM_BUFFER_CREATE_FAILED" },
+	{ 0x62, "STREAM_BUFFER_DELETE" },
+	{ 0x63, "STREAM_BUFFER_RESET" },
+	{ 0x64, "STREAM_BUFFER_SEND" },
+	{ 0x65, "STREAM_BUFFER_SEND_FROM_ISR" },
+	{ 0x66, "BLOCKING_ON_STREAM_BUFFER_SEND" },
+	{ 0x67, "STREAM_BUFFER_RECEIVE" },
+	{ 0x68, "STREAM_BUFFER_RECEIVE_FROM_ISR" },
+	{ 0x69, "BLOCKING_ON_STREAM_BUFFER_RECEIVE" },
+
+	{ 0x70, "MEMORY_POOL_CREATE" },
+	{ 0x71, "MEMORY_POOL_CREATE_FAILED" },
+	{ 0x72, "MEMORY_POOL_DELETE" },
+	{ 0x73, "MEMORY_POOL_ALLOC" },
+	{ 0x74, "MEMORY_POOL_ALLOC_FAILED" },
+	{ 0x75, "MEMORY_POOL_FREE" },
+
+	{ 0x80, "MALLOC" },
+	{ 0x81, "MALLOC_FAILED" },
+	{ 0x82, "FREE" }
+};
+
+/* The layout of the recorder structure, read from its header. */
+static const unsigned char *pucRecorder;
+static int iBigEndian;
+static unsigned long ulLongSize;
+static unsigned long ulPointerSize;
+static unsigned long ulHeader[ trcHDR_LONGS ];
+
+/*-----------------------------------------------------------*/
+
+static const char *prvEventName( unsigned char ucCode )
+{
+static char cBuffer[ 16 ];
+size_t x;
+
+	for( x = 0; x < sizeof( xEventNames ) / sizeof( xEventNames[ 0 ] ); x++ )
+	{
+		if( xEventNames[ x ].ucCode == ucCode )
+		{
+			return xEventNames[ x ].pcName;
+		}
+	}
+
+	if( ucCode >= trcUSER_EVENT_BASE )
+	{
+		sprintf( cBuffer, "USER_%u", ( unsigned ) ( ucCode - trcUSER_EVENT_BASE ) );
+	}
+	else
+	{
+		sprintf( cBuffer, "UNKNOWN_0x%02x", ( unsigned ) ucCode );
+	}
+
+	return cBuffer;
+}
+/*-----------------------------------------------------------*/
+
+/* Read an unsigned value of ulSize bytes, in the byte order of the target. */
+static unsigned long prvRead( unsigned long ulOffset, unsigned long ulSize )
+{
+unsigned long ulValue = 0UL, x;
+
+	for( x = 0; x < ulSize; x++ )
+	{
+		if( iBigEndian )
+		{
+			ulValue = ( ulValue << 8 ) | pucRecorder[ ulOffset + x ];
+		}
+		else
+		{
+			ulValue |= ( ( unsigned long ) pucRecorder[ ulOffset + x ] ) << ( 8 * x );
+		}
+	}
+
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+/* Round ulOffset up to a multiple of ulAlignment. */
+static unsigned long prvAlign( unsigned long ulOffset, unsigned long ulAlignment )
+{
+	return ( ( ulOffset + ulAlignment - 1UL ) / ulAlignment ) * ulAlignment;
+}
+/*-----------------------------------------------------------*/
+
+/* Print the name of an object if it is in the name table, otherwise its
+address. */
+static void prvPrintObject( unsigned long ulObject )
+{
+unsigned long x, ulEntry, ulNameLength;
+char cName[ 64 ];
+
+	if( ulObject == 0UL )
+	{
+		printf( "%-20s", "-" );
+		return;
+	}
+
+	ulNameLength = ulHeader[ trcHDR_NAME_LENGTH ];
+	if( ulNameLength >= sizeof( cName ) )
+	{
+		ulNameLength = sizeof( cName ) - 1;
+	}
+
+	for( x = 0; x < ulHeader[ trcHDR_NAME_COUNT ]; x++ )
+	{
+		ulEntry = ulHeader[ trcHDR_NAME_OFFSET ] + ( x * ulHeader[ trcHDR_NAME_SIZE ] );
+
+		if( prvRead( ulEntry, ulPointerSize ) == ulObject )
+		{
+			memcpy( cName, pucRecorder + ulEntry + ulPointerSize, ulNameLength );
+			cName[ ulNameLength ] = '\0';
+			printf( "%-20s", cName );
+			return;
+		}
+	}
+
+	printf( "0x%0*lx%*s", ( int ) ( ulPointerSize * 2 ), ulObject, ( int ) ( 18 - ( ulPointerSize * 2 ) ), "" );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxFile;
+unsigned char *pucFile;
+long lFileSize;
+unsigned long ulRecorderSize, ulFirst, ulCount, x, ulIndex, ulEntry, ulNeeded;
+unsigned long ulTimestamp, ulParameter, ulObject, ulDelta, ulMask, ulThreshold = 0UL;
+unsigned long ulObjectOffset;
+unsigned long ulLastTimestamp[ trcMAX_CORES ];
+int iHaveLast[ trcMAX_CORES ];
+unsigned char ucCode, ucCore;
+const char *pcFileName = NULL;
+const char *pcUnits;
+int iArg;
+
+	for( iArg = 1; iArg < argc; iArg++ )
+	{
+		if( ( strcmp( argv[ iArg ], "-t" ) == 0 ) && ( ( iArg + 1 ) < argc ) )
+		{
+			iArg++;
+			ulThreshold = strtoul( argv[ iArg ], NULL, 0 );
+		}
+		else if( pcFileName == NULL )
+		{
+			pcFileName = argv[ iArg ];
+		}
+		else
+		{
+			pcFileName = NULL;
+			break;
+		}
+	}
+
+	if( pcFileName == NULL )
+	{
+		fprintf( stderr, "usage: %s [-t threshold] file\n", argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	/* Read the whole file. */
+	pxFile = fopen( pcFileName, "rb" );
+	if( pxFile == NULL )
+	{
+		perror( pcFileName );
+		return EXIT_FAILURE;
+	}
+
+	fseek( pxFile, 0L, SEEK_END );
+	lFileSize = ftell( pxFile );
+	fseek( pxFile, 0L, SEEK_SET );
+
+	if( lFileSize <= 0L )
+	{
+		fprintf( stderr, "%s: file is empty\n", pcFileName );
+		fclose( pxFile );
+		return EXIT_FAILURE;
+	}
+
+	pucFile = ( unsigned char * ) malloc( ( size_t ) lFileSize );
+	if( ( pucFile == NULL ) || ( fread( pucFile, 1, ( size_t ) lFileSize, pxFile ) != ( size_t ) lFileSize ) )
+	{
+		fprintf( stderr, "%s: could not read file\n", pcFileName );
+		fclose( pxFile );
+		return EXIT_FAILURE;
+	}
+	fclose( pxFile );
+
+	/* Find the structure by its signature.  The signature is followed by the
+	version and the size of a long, which must be sensible. */
+	pucRecorder = NULL;
+	for( x = 0; ( x + 8UL ) <= ( unsigned long ) lFileSize; x++ )
+	{
+		if( ( memcmp( pucFile + x, "FRTR", 4 ) == 0 ) && ( pucFile[ x + 4 ] == trcRECORDER_VERSION ) && ( ( pucFile[ x + 5 ] == 4 ) || ( pucFile[ x + 5 ] == 8 ) ) )
+		{
+			pucRecorder = pucFile + x;
+			break;
+		}
+	}
+
+	if( pucRecorder == NULL )
+	{
+		fprintf( stderr, "%s: no version %d trace recorder data found\n", pcFileName, trcRECORDER_VERSION );
+		return EXIT_FAILURE;
+	}
+
+	ulRecorderSize = ( unsigned long ) lFileSize - ( unsigned long ) ( pucRecorder - pucFile );
+	ulLongSize = pucRecorder[ 5 ];
+	ulPointerSize = pucRecorder[ 6 ];
+
+	if( ( ulLongSize > sizeof( unsigned long ) ) || ( ulPointerSize > sizeof( unsigned long ) ) || ( ulPointerSize == 0UL ) )
+	{
+		fprintf( stderr, "%s: the target uses %lu byte longs and %lu byte pointers, which this host cannot decode\n", pcFileName, ulLongSize, ulPointerSize );
+		return EXIT_FAILURE;
+	}
+
+	if( ( 8UL + ( trcHDR_LONGS * ulLongSize ) ) > ulRecorderSize )
+	{
+		fprintf( stderr, "%s: trace recorder data is truncated\n", pcFileName );
+		return EXIT_FAILURE;
+	}
+
+	/* The least significant byte of 0x01020304 is 0x04. */
+	iBigEndian = ( pucRecorder[ 8 ] != 0x04 );
+
+	for( x = 0; x < trcHDR_LONGS; x++ )
+	{
+		ulHeader[ x ] = prvRead( 8UL + ( x * ulLongSize ), ulLongSize );
+	}
+
+	ulNeeded = ulHeader[ trcHDR_EVENT_OFFSET ] + ( ulHeader[ trcHDR_EVENT_COUNT ] * ulHeader[ trcHDR_EVENT_SIZE ] );
+	if( ( ulNeeded > ulRecorderSize ) || ( ( ulHeader[ trcHDR_NAME_OFFSET ] + ( ulHeader[ trcHDR_NAME_COUNT ] * ulHeader[ trcHDR_NAME_SIZE ] ) ) > ulRecorderSize ) )
+	{
+		fprintf( stderr, "%s: trace recorder data is truncated - %lu bytes are needed but only %lu were found\n", pcFileName, ulNeeded, ulRecorderSize );
+		return EXIT_FAILURE;
+	}
+
+	switch( ulHeader[ trcHDR_TIMESTAMP_SOURCE ] )
+	{
+		case 0	:	pcUnits = "ticks";						break;
+		case 1	:	pcUnits = "run time counter counts";	break;
+		default	:	pcUnits = "application defined units";	break;
+	}
+
+	printf( "Trace recorder version %u: %lu byte longs, %lu byte pointers, %s endian, %u core(s).\n", ( unsigned ) pucRecorder[ 4 ], ulLongSize, ulPointerSize, iBigEndian ? "big" : "little", ( unsigned ) pucRecorder[ 7 ] );
+	printf( "Times are in %s.  Recording was %s.\n", pcUnits, ulHeader[ trcHDR_RECORDING ] ? "running" : "stopped" );
+
+	/* Work out where the oldest event is.  Once the buffer has wrapped the
+	oldest event is the one that would have been overwritten next. */
+	if( ulHeader[ trcHDR_EVENTS_WRITTEN ] > ulHeader[ trcHDR_EVENT_COUNT ] )
+	{
+		ulFirst = ulHeader[ trcHDR_NEXT_EVENT ];
+		ulCount = ulHeader[ trcHDR_EVENT_COUNT ];
+		printf( "%lu events were recorded, the oldest %lu were overwritten.\n\n", ulHeader[ trcHDR_EVENTS_WRITTEN ], ulHeader[ trcHDR_EVENTS_WRITTEN ] - ulCount );
+	}
+	else
+	{
+		ulFirst = 0UL;
+		ulCount = ulHeader[ trcHDR_EVENTS_WRITTEN ];
+		printf( "%lu events were recorded.\n\n", ulCount );
+	}
+
+	/* The members of an event are naturally aligned - see xTraceEvent. */
+	ulObjectOffset = prvAlign( 2UL * ulLongSize, ulPointerSize );
+
+	/* Timestamps wrap at the size of a long on the target. */
+	if( ulLongSize < sizeof( unsigned long ) )
+	{
+		ulMask = ( 1UL << ( 8UL * ulLongSize ) ) - 1UL;
+	}
+	else
+	{
+		ulMask = ~0UL;
+	}
+
+	for( x = 0; x < trcMAX_CORES; x++ )
+	{
+		iHaveLast[ x ] = 0;
+		ulLastTimestamp[ x ] = 0UL;
+	}
+
+	printf( "%12s %12s %4s %-34s %-20s %s\n", "Time", "Delta", "Core", "Event", "Object", "Parameter" );
+
+	for( x = 0; x < ulCount; x++ )
+	{
+		ulIndex = ( ulFirst + x ) % ulHeader[ trcHDR_EVENT_COUNT ];
+		ulEntry = ulHeader[ trcHDR_EVENT_OFFSET ] + ( ulIndex * ulHeader[ trcHDR_EVENT_SIZE ] );
+
+		ulTimestamp = prvRead( ulEntry, ulLongSize );
+		ulParameter = prvRead( ulEntry + ulLongSize, ulLongSize );
+		ulObject = prvRead( ulEntry + ulObjectOffset, ulPointerSize );
+		ucCode = pucRecorder[ ulEntry + ulObjectOffset + ulPointerSize ];
+		ucCore = pucRecorder[ ulEntry + ulObjectOffset + ulPointerSize + 1UL ];
+
+		if( ucCore >= trcMAX_CORES )
+		{
+			ucCore = trcMAX_CORES - 1;
+		}
+
+		if( iHaveLast[ ucCore ] )
+		{
+			ulDelta = ( ulTimestamp - ulLastTimestamp[ ucCore ] ) & ulMask;
+		}
+		else
+		{
+			ulDelta = 0UL;
+		}
+
+		iHaveLast[ ucCore ] = 1;
+		ulLastTimestamp[ ucCore ] = ulTimestamp;
+
+		printf( "%12lu %12lu %4u %-34s ", ulTimestamp, ulDelta, ( unsigned ) ucCore, prvEventName( ucCode ) );
+		prvPrintObject( ulObject );
+		printf( " %lu", ulParameter );
+
+		if( ( ulThreshold != 0UL ) && ( ulDelta > ulThreshold ) )
+		{
+			printf( "   <<< delta exceeds %lu", ulThreshold );
+		}
+
+		printf( "\n" );
+	}
+
+	free( pucFile );
+
+	return EXIT_SUCCESS;
+}
+
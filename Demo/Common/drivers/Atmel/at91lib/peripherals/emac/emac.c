@@ -159,11 +159,32 @@ static volatile unsigned char pTxBuffer[TX_BUFFERS * EMAC_TX_UNITSIZE] __attribu
 static volatile unsigned char pRxBuffer[RX_BUFFERS * EMAC_RX_UNITSIZE] __attribute__((aligned(8)));
 /// Statistics
 static volatile EmacStats EmacStatistics;
+/// Number of joined multicast addresses mapped to each bin of the hash filter
+static unsigned char hashBinUsers[EMAC_HASH_BINS];
 
 //-----------------------------------------------------------------------------
 //         Internal functions
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+/// Return the bin of the 64 bit hash filter that a destination address falls
+/// into: bit n of the index is the XOR of address bits n, n+6, ... n+42, where
+/// bit 0 is the first bit on the wire (bit 0 of the first byte).
+/// \param pMacAddress  Destination MAC address
+//-----------------------------------------------------------------------------
+static unsigned char EMAC_HashIndex(const unsigned char *pMacAddress)
+{
+    unsigned char index = 0;
+    unsigned int bit;
+
+    for (bit = 0; bit < 48; bit++) {
+        if (pMacAddress[bit / 8] & (1 << (bit % 8))) {
+            index ^= 1 << (bit % 6);
+        }
+    }
+    return index;
+}
+
 //-----------------------------------------------------------------------------
 /// Wait PHY operation complete.
 /// Return 1 if the operation completed successfully.
@@ -533,6 +554,12 @@ void EMAC_Init( unsigned char id, const unsigned char *pMacAddress,
     // Clear interrupts
     AT91C_BASE_EMAC->EMAC_ISR;
 
+    // No multicast group joined yet
+    memset(hashBinUsers, 0x00, sizeof(hashBinUsers));
+    AT91C_BASE_EMAC->EMAC_HRB = 0;
+    AT91C_BASE_EMAC->EMAC_HRT = 0;
+    AT91C_BASE_EMAC->EMAC_NCFGR &= ~AT91C_EMAC_MTI;
+
     // Enable the copy of data into the buffers
     // ignore broadcasts, and don't copy FCS.
     AT91C_BASE_EMAC->EMAC_NCFGR |= (AT91C_EMAC_DRFCS | AT91C_EMAC_PAE);
@@ -558,6 +585,83 @@ void EMAC_Init( unsigned char id, const unsigned char *pMacAddress,
 
 }
 
+//-----------------------------------------------------------------------------
+/// Add a multicast address to the hash filter, or remove it, so that only
+/// frames sent to joined groups are received rather than all multicast
+/// frames. Each hash bin counts the addresses falling into it and is only
+/// closed when the last of them is removed. Frames of other groups sharing
+/// an open bin still get through and are dropped by the IP stack.
+/// \param pMacAddress  Multicast MAC address
+/// \param add          EMAC_MCAST_ADD or EMAC_MCAST_DEL
+/// \return             1 on success, 0 if the address was not added before
+//-----------------------------------------------------------------------------
+unsigned char EMAC_SetMulticastFilter(const unsigned char *pMacAddress,
+                                      unsigned char add)
+{
+    unsigned char index = EMAC_HashIndex(pMacAddress);
+    unsigned int mask = 1 << (index % 32);
+    AT91_REG *pHash = (index < 32) ? &AT91C_BASE_EMAC->EMAC_HRB
+                                   : &AT91C_BASE_EMAC->EMAC_HRT;
+
+    trace_LOG(trace_DEBUG, "EMAC_SetMulticastFilter %d %d\n\r", index, add);
+
+    if (add == EMAC_MCAST_ADD) {
+        if (hashBinUsers[index] == 0xFF) {
+            return 0;
+        }
+        if (hashBinUsers[index]++ == 0) {
+            *pHash |= mask;
+        }
+    }
+    else {
+        if (hashBinUsers[index] == 0) {
+            return 0;
+        }
+        if (--hashBinUsers[index] == 0) {
+            *pHash &= ~mask;
+        }
+    }
+
+    // Only look at the hash filter while a group is joined
+    if ((AT91C_BASE_EMAC->EMAC_HRB | AT91C_BASE_EMAC->EMAC_HRT) != 0) {
+        AT91C_BASE_EMAC->EMAC_NCFGR |= AT91C_EMAC_MTI;
+    }
+    else {
+        AT91C_BASE_EMAC->EMAC_NCFGR &= ~AT91C_EMAC_MTI;
+    }
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+/// Add an IPv4 multicast group to the hash filter, or remove it, using the
+/// 01:00:5E MAC address the group maps to (RFC 1112). This is what an lwIP
+/// netif igmp_mac_filter function needs:
+///
+///     static err_t igmp_mac_filter(struct netif *netif, ip_addr_t *group,
+///                                  u8_t action)
+///     {
+///         return EMAC_SetMulticastGroup((unsigned char *)&group->addr,
+///                    action == IGMP_ADD_MAC_FILTER) ? ERR_OK : ERR_VAL;
+///     }
+///
+/// \param pGroupAddress  Group address, 4 bytes in network order
+/// \param add            EMAC_MCAST_ADD or EMAC_MCAST_DEL
+/// \return               1 on success, 0 if the group was not added before
+//-----------------------------------------------------------------------------
+unsigned char EMAC_SetMulticastGroup(const unsigned char *pGroupAddress,
+                                     unsigned char add)
+{
+    unsigned char macAddress[6];
+
+    macAddress[0] = 0x01;
+    macAddress[1] = 0x00;
+    macAddress[2] = 0x5E;
+    macAddress[3] = pGroupAddress[1] & 0x7F;
+    macAddress[4] = pGroupAddress[2];
+    macAddress[5] = pGroupAddress[3];
+    return EMAC_SetMulticastFilter(macAddress, add);
+}
+
 //-----------------------------------------------------------------------------
 /// Get the statstic information & reset it
 /// \param pStats   Pointer to EmacStats structure to copy the informations
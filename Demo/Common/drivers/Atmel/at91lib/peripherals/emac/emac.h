@@ -70,6 +70,9 @@
 // The MAC can support frame lengths up to 1536 bytes.
 #define EMAC_FRAME_LENTGH_MAX       1536
 
+/// Number of bins of the multicast hash filter
+#define EMAC_HASH_BINS              64
+
 
 //-----------------------------------------------------------------------------
 //         Types
@@ -157,5 +160,14 @@ extern unsigned char EMAC_Poll(unsigned char *pFrame,
 
 extern void EMAC_GetStatistics(EmacStats *pStats, unsigned char reset);
 
+extern unsigned char EMAC_SetMulticastFilter(const unsigned char *pMacAddress,
+                                             unsigned char add);
+
+extern unsigned char EMAC_SetMulticastGroup(const unsigned char *pGroupAddress,
+                                            unsigned char add);
+/// Action for EMAC_SetMulticastFilter and EMAC_SetMulticastGroup
+#define EMAC_MCAST_DEL               0
+#define EMAC_MCAST_ADD               1
+
 #endif // #ifndef EMAC_H
 
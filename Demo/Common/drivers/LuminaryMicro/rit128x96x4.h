@@ -49,5 +49,7 @@ extern void RIT128x96x4Enable(unsigned long ulFrequency);
 extern void RIT128x96x4Disable(void);
 extern void RIT128x96x4DisplayOn(void);
 extern void RIT128x96x4DisplayOff(void);
+extern void RIT128x96x4FrameBufferEnable(void);
+extern void RIT128x96x4Flush(void);
 
 #endif // __RIT128X96X4_H__
@@ -0,0 +1,317 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * The uIP firmware update server.  See fwupdated.h.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* uip includes. */
+#include "net/uip.h"
+
+/* Demo includes. */
+#include "FirmwareUpdate.h"
+#include "fwupdated.h"
+
+#if ( fwupdateBUFFER_SIZE * fwupdateBUFFER_COUNT ) < UIP_RECEIVE_WINDOW
+	#error The firmware update buffers must hold at least UIP_RECEIVE_WINDOW bytes.
+#endif
+
+/* What the connection is doing. */
+#define fwupdateSTATE_RECEIVE			( 0 )	/* Receiving the header or the image. */
+#define fwupdateSTATE_WRITING			( 1 )	/* Waiting for the writer to finish. */
+#define fwupdateSTATE_REPLY				( 2 )	/* Waiting for the reply to be acknowledged. */
+#define fwupdateSTATE_CLOSING			( 3 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Pass the data in the uIP buffer on to the writer.
+ */
+static void prvReceiveData( void );
+
+/*
+ * Wait for the writer without blocking, and restart the connection once
+ * there is room for another window of data.
+ */
+static void prvPoll( void );
+
+/*
+ * Send the reply for xResult, which is kept in place for retransmissions.
+ */
+static void prvSendReply( void );
+
+/*
+ * The connection has gone, stop the update if it was still going.
+ */
+static void prvConnectionLost( void );
+
+/*-----------------------------------------------------------*/
+
+static pdFIRMWARE_UPDATE_CALLBACK pxUpdateComplete = NULL;
+
+/* The connection an update is being received over, or NULL. */
+static struct uip_conn *pxUpdateConnection = NULL;
+
+static portBASE_TYPE xState;
+static portBASE_TYPE xResult;
+static unsigned char ucHeader[ fwupdateHEADER_LENGTH ];
+static unsigned long ulHeaderBytes, ulImageLength, ulReceived;
+
+/* The reply is sent from here so it does not move before it is acknowledged. */
+static char cReply[] = "ERROR n\r\n";
+
+/*-----------------------------------------------------------*/
+
+void vFirmwareUpdateServerInit( pdFIRMWARE_UPDATE_CALLBACK pxComplete )
+{
+	pxUpdateComplete = pxComplete;
+	uip_listen( HTONS( fwupdatePORT ) );
+}
+/*-----------------------------------------------------------*/
+
+void vFirmwareUpdateAppcall( void )
+{
+	if( uip_connected() )
+	{
+		if( pxUpdateConnection != NULL )
+		{
+			/* An update is already being received. */
+			uip_abort();
+			return;
+		}
+
+		pxUpdateConnection = uip_conn;
+		xState = fwupdateSTATE_RECEIVE;
+		xResult = fwupdateOK;
+		ulHeaderBytes = 0UL;
+		ulImageLength = 0UL;
+		ulReceived = 0UL;
+	}
+
+	if( uip_conn != pxUpdateConnection )
+	{
+		return;
+	}
+
+	if( uip_aborted() || uip_timedout() )
+	{
+		prvConnectionLost();
+		return;
+	}
+
+	/* The final segment can carry both data and the FIN. */
+	if( uip_newdata() && ( xState == fwupdateSTATE_RECEIVE ) )
+	{
+		prvReceiveData();
+	}
+
+	if( uip_closed() )
+	{
+		prvConnectionLost();
+		return;
+	}
+
+	if( uip_acked() && ( xState == fwupdateSTATE_REPLY ) )
+	{
+		xState = fwupdateSTATE_CLOSING;
+		uip_close();
+	}
+	else if( uip_rexmit() && ( xState == fwupdateSTATE_REPLY ) )
+	{
+		prvSendReply();
+	}
+	else if( uip_poll() )
+	{
+		prvPoll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveData( void )
+{
+const unsigned char *pucData = ( const unsigned char * ) uip_appdata;
+unsigned long ulLength = ( unsigned long ) uip_datalen(), ulCopy;
+
+	if( ulHeaderBytes < ( unsigned long ) fwupdateHEADER_LENGTH )
+	{
+		ulCopy = ( unsigned long ) fwupdateHEADER_LENGTH - ulHeaderBytes;
+		if( ulCopy > ulLength )
+		{
+			ulCopy = ulLength;
+		}
+
+		memcpy( &( ucHeader[ ulHeaderBytes ] ), pucData, ( size_t ) ulCopy );
+		ulHeaderBytes += ulCopy;
+		pucData += ulCopy;
+		ulLength -= ulCopy;
+
+		if( ulHeaderBytes == ( unsigned long ) fwupdateHEADER_LENGTH )
+		{
+			xResult = xFirmwareUpdateBegin( ucHeader );
+			if( xResult != fwupdateOK )
+			{
+				/* Nothing was started, so the reply can go straight away. */
+				xState = fwupdateSTATE_REPLY;
+				prvSendReply();
+				return;
+			}
+
+			ulImageLength = ( ( unsigned long ) ucHeader[ 4 ] << 24 ) | ( ( unsigned long ) ucHeader[ 5 ] << 16 ) | ( ( unsigned long ) ucHeader[ 6 ] << 8 ) | ( unsigned long ) ucHeader[ 7 ];
+		}
+	}
+
+	if( ulLength > 0UL )
+	{
+		/* The connection is stopped before the buffers can run out, so the
+		whole segment is only not taken if the writer has failed.
+		vFirmwareUpdateEnd() then collects the reason. */
+		if( ulFirmwareUpdateWrite( pucData, ulLength, 0 ) != ulLength )
+		{
+			ulReceived = ulImageLength;
+		}
+		else
+		{
+			ulReceived += ulLength;
+		}
+	}
+
+	if( ulHeaderBytes == ( unsigned long ) fwupdateHEADER_LENGTH )
+	{
+		if( ulReceived >= ulImageLength )
+		{
+			/* Anything after the image is reported as a length error by the
+			writer if it arrived in the same segment, and ignored otherwise. */
+			vFirmwareUpdateEnd();
+			xState = fwupdateSTATE_WRITING;
+		}
+		else if( ulFirmwareUpdateSpace() < ( unsigned long ) UIP_RECEIVE_WINDOW )
+		{
+			uip_stop();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPoll( void )
+{
+	if( xState == fwupdateSTATE_WRITING )
+	{
+		xResult = xFirmwareUpdateGetResult( 0 );
+		if( xResult != fwupdateBUSY )
+		{
+			xState = fwupdateSTATE_REPLY;
+			prvSendReply();
+		}
+	}
+	else if( ( xState == fwupdateSTATE_RECEIVE ) && ( uip_stopped( uip_conn ) != 0 ) )
+	{
+		if( ulFirmwareUpdateSpace() >= ( unsigned long ) UIP_RECEIVE_WINDOW )
+		{
+			/* Sends a window update. */
+			uip_restart();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendReply( void )
+{
+	if( xResult == fwupdateOK )
+	{
+		uip_send_static( "OK\r\n", 4 );
+	}
+	else
+	{
+		/* The codes are all one digit. */
+		cReply[ 6 ] = ( char ) ( '0' + xResult );
+		uip_send_static( cReply, ( int ) ( sizeof( cReply ) - 1 ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvConnectionLost( void )
+{
+	pxUpdateConnection = NULL;
+
+	if( xState == fwupdateSTATE_RECEIVE )
+	{
+		if( ulHeaderBytes < ( unsigned long ) fwupdateHEADER_LENGTH )
+		{
+			xResult = fwupdateERR_HEADER;
+		}
+		else
+		{
+			vFirmwareUpdateAbort();
+			xResult = xFirmwareUpdateGetResult( portMAX_DELAY );
+		}
+	}
+	else if( xState == fwupdateSTATE_WRITING )
+	{
+		/* The sender closed without waiting for the reply.  The writer has
+		at most the last few buffers left to program. */
+		xResult = xFirmwareUpdateGetResult( portMAX_DELAY );
+	}
+
+	if( pxUpdateComplete != NULL )
+	{
+		pxUpdateComplete( xResult );
+	}
+}
+/*-----------------------------------------------------------*/
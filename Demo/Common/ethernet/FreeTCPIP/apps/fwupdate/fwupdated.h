@@ -0,0 +1,95 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef FWUPDATED_H
+#define FWUPDATED_H
+
+/*
+ * A firmware update server for uIP.  It listens on fwupdatePORT and passes
+ * the image it receives to the writer in Demo/Common/Minimal/FirmwareUpdate.c
+ * - see Demo/Common/include/FirmwareUpdate.h for the transfer format and for
+ * how the image is written.
+ *
+ * The uIP task never waits for the writer.  Each segment is copied straight
+ * into the buffers, and once less than UIP_RECEIVE_WINDOW bytes of buffer are
+ * left the connection is stopped with uip_stop(), which closes the TCP
+ * window.  It is restarted from the periodic poll once the writer has freed
+ * a buffer, so the buffers should hold several segments or the transfer runs
+ * at one window per poll.  The reply is sent from the poll too, once the
+ * writer has finished.  One update is received at a time, other connections
+ * are aborted.
+ *
+ * uIP cannot send once the sender has closed its side of the connection,
+ * so the sender has to keep the connection open until the reply arrives -
+ * which nc does when given -q.  The result still goes to the callback if it
+ * does not.
+ *
+ * xFirmwareUpdateInit() must have been called first.  As with the iperf
+ * server, the uIP task must:
+ *  + call vFirmwareUpdateServerInit() once uIP has been initialised.
+ *  + call vFirmwareUpdateAppcall() from the UIP_APPCALL function for
+ *    connections with a local port of fwupdatePORT.
+ */
+
+/*
+ * Listen on fwupdatePORT.  pxComplete, which can be NULL, is called from the
+ * uIP task with the result of each update.
+ */
+void vFirmwareUpdateServerInit( pdFIRMWARE_UPDATE_CALLBACK pxComplete );
+
+/*
+ * Handle a uIP event on a connection to fwupdatePORT.
+ */
+void vFirmwareUpdateAppcall( void );
+
+#endif /* FWUPDATED_H */
@@ -30,9 +30,9 @@ const char	http_crnl[3] = /* "\r\n" */ { 0xd, 0xa, };
 const char	http_index_html[12] = /* "/index.html" */ { 0x2f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x68, 0x74, 0x6d, 0x6c, };
 const char	http_404_html[10] = /* "/404.html" */ { 0x2f, 0x34, 0x30, 0x34, 0x2e, 0x68, 0x74, 0x6d, 0x6c, };
 const char	http_referer[9] = /* "Referer:" */ { 0x52, 0x65, 0x66, 0x65, 0x72, 0x65, 0x72, 0x3a, };
-const char	http_header_200[84] =
+const char	http_header_200[65] =
 
-/* "HTTP/1.0 200 OK\r\nServer: uIP/1.0 http://www.sics.se/~adam/uip/\r\nConnection: close\r\n" */
+/* "HTTP/1.1 200 OK\r\nServer: uIP/1.0 http://www.sics.se/~adam/uip/\r\n" */
 { 0x48,
 	0x54,
 	0x54,
@@ -40,7 +40,7 @@ const char	http_header_200[84] =
 	0x2f,
 	0x31,
 	0x2e,
-	0x30,
+	0x31,
 	0x20,
 	0x32,
 	0x30,
@@ -97,29 +97,10 @@ const char	http_header_200[84] =
 	0x2f,
 	0xd,
 	0xa,
-	0x43,
-	0x6f,
-	0x6e,
-	0x6e,
-	0x65,
-	0x63,
-	0x74,
-	0x69,
-	0x6f,
-	0x6e,
-	0x3a,
-	0x20,
-	0x63,
-	0x6c,
-	0x6f,
-	0x73,
-	0x65,
-	0xd,
-	0xa,
 };
-const char	http_header_404[91] =
+const char	http_header_404[72] =
 
-/* "HTTP/1.0 404 Not found\r\nServer: uIP/1.0 http://www.sics.se/~adam/uip/\r\nConnection: close\r\n" */
+/* "HTTP/1.1 404 Not found\r\nServer: uIP/1.0 http://www.sics.se/~adam/uip/\r\n" */
 { 0x48,
 	0x54,
 	0x54,
@@ -127,7 +108,7 @@ const char	http_header_404[91] =
 	0x2f,
 	0x31,
 	0x2e,
-	0x30,
+	0x31,
 	0x20,
 	0x34,
 	0x30,
@@ -191,7 +172,11 @@ const char	http_header_404[91] =
 	0x2f,
 	0xd,
 	0xa,
-	0x43,
+};
+const char	http_connection_close[20] =
+
+/* "Connection: close\r\n" */
+{ 0x43,
 	0x6f,
 	0x6e,
 	0x6e,
@@ -211,6 +196,54 @@ const char	http_header_404[91] =
 	0xd,
 	0xa,
 };
+const char	http_connection_keepalive[25] =
+
+/* "Connection: keep-alive\r\n" */
+{ 0x43,
+	0x6f,
+	0x6e,
+	0x6e,
+	0x65,
+	0x63,
+	0x74,
+	0x69,
+	0x6f,
+	0x6e,
+	0x3a,
+	0x20,
+	0x6b,
+	0x65,
+	0x65,
+	0x70,
+	0x2d,
+	0x61,
+	0x6c,
+	0x69,
+	0x76,
+	0x65,
+	0xd,
+	0xa,
+};
+const char	http_content_length[17] =
+
+/* "Content-Length: " */
+{ 0x43,
+	0x6f,
+	0x6e,
+	0x74,
+	0x65,
+	0x6e,
+	0x74,
+	0x2d,
+	0x4c,
+	0x65,
+	0x6e,
+	0x67,
+	0x74,
+	0x68,
+	0x3a,
+	0x20,
+};
 const char	http_content_type_plain[29] =
 
 /* "Content-type: text/plain\r\n\r\n" */
@@ -475,6 +508,34 @@ const char	http_content_type_binary[43] =
 	0xd,
 	0xa,
 };
+const char	http_content_encoding_gzip[25] =
+
+/* "Content-Encoding: gzip\r\n" */
+{ 0x43,
+	0x6f,
+	0x6e,
+	0x74,
+	0x65,
+	0x6e,
+	0x74,
+	0x2d,
+	0x45,
+	0x6e,
+	0x63,
+	0x6f,
+	0x64,
+	0x69,
+	0x6e,
+	0x67,
+	0x3a,
+	0x20,
+	0x67,
+	0x7a,
+	0x69,
+	0x70,
+	0xd,
+	0xa,
+};
 const char	http_html[6] = /* ".html" */ { 0x2e, 0x68, 0x74, 0x6d, 0x6c, };
 const char	http_shtml[7] = /* ".shtml" */ { 0x2e, 0x73, 0x68, 0x74, 0x6d, 0x6c, };
 const char	http_htm[5] = /* ".htm" */ { 0x2e, 0x68, 0x74, 0x6d, };
@@ -13,8 +13,11 @@ extern const char	http_crnl[3];
 extern const char	http_index_html[12];
 extern const char	http_404_html[10];
 extern const char	http_referer[9];
-extern const char	http_header_200[84];
-extern const char	http_header_404[91];
+extern const char	http_header_200[65];
+extern const char	http_header_404[72];
+extern const char	http_connection_close[20];
+extern const char	http_connection_keepalive[25];
+extern const char	http_content_length[17];
 extern const char	http_content_type_plain[29];
 extern const char	http_content_type_html[28];
 extern const char	http_content_type_css[27];
@@ -23,6 +26,7 @@ extern const char	http_content_type_png[28];
 extern const char	http_content_type_gif[28];
 extern const char	http_content_type_jpg[29];
 extern const char	http_content_type_binary[43];
+extern const char	http_content_encoding_gzip[25];
 extern const char	http_html[6];
 extern const char	http_shtml[7];
 extern const char	http_htm[5];
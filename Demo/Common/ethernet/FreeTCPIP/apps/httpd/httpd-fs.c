@@ -46,6 +46,71 @@
 static u16_t	count[HTTPD_FS_NUMFILES];
 #endif /* HTTPD_FS_STATISTICS */
 
+#ifdef HTTPD_FS_INDEX
+
+/*-----------------------------------------------------------------------------------*/
+/* Compare a requested name with the name of a file, returning less than, equal
+to or greater than zero in the manner of strcmp().  The requested name ends at
+the end of the string, at the end of the line, or where a query string or the
+HTTP version starts. */
+static int httpd_fs_namecmp( const char *str1, const char *str2 )
+{
+	const unsigned char	*s1 = ( const unsigned char * ) str1;
+	const unsigned char	*s2 = ( const unsigned char * ) str2;
+	unsigned char		c1;
+
+	for( ;; )
+	{
+		c1 = *s1;
+		if( c1 == '\r' || c1 == '\n' || c1 == '?' || c1 == ' ' )
+		{
+			c1 = 0;
+		}
+
+		if( c1 != *s2 || c1 == 0 )
+		{
+			return ( int ) c1 - ( int ) *s2;
+		}
+
+		++s1;
+		++s2;
+	}
+}
+
+/*-----------------------------------------------------------------------------------*/
+/* makefsdata lists the files in HTTPD_FS_INDEX sorted by name, so they can be
+found with a binary search. */
+static struct httpd_fsdata_file_noconst *httpd_fs_find( const char *name, u16_t *index )
+{
+	u16_t	low, high, mid;
+	int		cmp;
+
+	low = 0;
+	high = HTTPD_FS_NUMFILES;
+	while( low < high )
+	{
+		mid = ( u16_t ) ( ( low + high ) / 2 );
+		cmp = httpd_fs_namecmp( name, HTTPD_FS_INDEX[mid]->name );
+		if( cmp == 0 )
+		{
+			*index = mid;
+			return ( struct httpd_fsdata_file_noconst * ) HTTPD_FS_INDEX[mid];
+		}
+		else if( cmp < 0 )
+		{
+			high = mid;
+		}
+		else
+		{
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+#else /* HTTPD_FS_INDEX */
+
 /*-----------------------------------------------------------------------------------*/
 static u8_t httpd_fs_strcmp( const char *str1, const char *str2 )
 {
@@ -67,31 +132,49 @@ loop:
 }
 
 /*-----------------------------------------------------------------------------------*/
-int httpd_fs_open( const char *name, struct httpd_fs_file *file )
+/* File systems generated without an index are searched along the list. */
+static struct httpd_fsdata_file_noconst *httpd_fs_find( const char *name, u16_t *index )
 {
-#if HTTPD_FS_STATISTICS
-	u16_t								i = 0;
-#endif /* HTTPD_FS_STATISTICS */
 	struct httpd_fsdata_file_noconst	*f;
+	u16_t								i = 0;
 
 	for( f = ( struct httpd_fsdata_file_noconst * ) HTTPD_FS_ROOT; f != NULL; f = ( struct httpd_fsdata_file_noconst * ) f->next )
 	{
 		if( httpd_fs_strcmp(name, f->name) == 0 )
 		{
-			file->data = f->data;
-			file->len = f->len;
-#if HTTPD_FS_STATISTICS
-			++count[i];
-#endif /* HTTPD_FS_STATISTICS */
-			return 1;
+			*index = i;
+			return f;
 		}
 
-#if HTTPD_FS_STATISTICS
 		++i;
-#endif /* HTTPD_FS_STATISTICS */
 	}
 
-	return 0;
+	return NULL;
+}
+
+#endif /* HTTPD_FS_INDEX */
+
+/*-----------------------------------------------------------------------------------*/
+int httpd_fs_open( const char *name, struct httpd_fs_file *file )
+{
+	u16_t								i;
+	struct httpd_fsdata_file_noconst	*f;
+
+	f = httpd_fs_find( name, &i );
+	if( f == NULL )
+	{
+		return 0;
+	}
+
+	file->data = f->data;
+	file->len = f->len;
+	file->flags = f->flags;
+#if HTTPD_FS_STATISTICS
+	++count[i];
+#else
+	( void ) i;
+#endif /* HTTPD_FS_STATISTICS */
+	return 1;
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -111,18 +194,11 @@ void httpd_fs_init( void )
 #if HTTPD_FS_STATISTICS
 u16_t httpd_fs_count( char *name )
 {
-	struct httpd_fsdata_file_noconst	*f;
-	u16_t								i;
+	u16_t	i;
 
-	i = 0;
-	for( f = ( struct httpd_fsdata_file_noconst * ) HTTPD_FS_ROOT; f != NULL; f = ( struct httpd_fsdata_file_noconst * ) f->next )
+	if( httpd_fs_find(name, &i) != NULL )
 	{
-		if( httpd_fs_strcmp(name, f->name) == 0 )
-		{
-			return count[i];
-		}
-
-		++i;
+		return count[i];
 	}
 
 	return 0;
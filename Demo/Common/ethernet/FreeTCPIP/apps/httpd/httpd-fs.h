@@ -37,10 +37,19 @@
 
 #define HTTPD_FS_STATISTICS 1
 
+/* Set in the flags of a file that makefsdata stored gzip compressed.  The
+file has to be sent with a "Content-Encoding: gzip" header. */
+#define HTTPD_FS_FLAG_GZIP	0x01
+
+/* Set by httpd in a file it opened from a FatFs volume rather than the
+constant file system.  The data is then read from httpd_state.fil. */
+#define HTTPD_FS_FLAG_FATFS	0x02
+
 struct httpd_fs_file
 {
 	char	*data;
 	int		len;
+	u8_t	flags;
 };
 
 /* file must be allocated by caller and will be filled in
@@ -40,6 +40,7 @@ struct httpd_fsdata_file {
   const char *name;
   const char *data;
   const int len;
+  const u8_t flags;
 #ifdef HTTPD_FS_STATISTICS
 #if HTTPD_FS_STATISTICS == 1
   u16_t count;
@@ -52,6 +53,7 @@ struct httpd_fsdata_file_noconst {
   char *name;
   char *data;
   int len;
+  u8_t flags;
 #ifdef HTTPD_FS_STATISTICS
 #if HTTPD_FS_STATISTICS == 1
   u16_t count;
@@ -59,10 +59,12 @@
 #include "apps/httpd/httpd-cgi.h"
 #include "apps/httpd/http-strings.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #define STATE_WAITING	0
 #define STATE_OUTPUT	1
+#define STATE_HEADERS	2
 
 #define ISO_nl			0x0a
 #define ISO_space		0x20
@@ -73,48 +75,142 @@
 #define ISO_colon		0x3a
 
 /*---------------------------------------------------------------------------*/
-static unsigned short generate_part_of_file( void *state )
+static PT_THREAD( send_file ( struct httpd_state *s ) )
 {
-	struct httpd_state	*s = ( struct httpd_state * ) state;
+	PSOCK_BEGIN( &s->sout );
+
+	( void ) PT_YIELD_FLAG;
 
-	if( s->file.len > uip_mss() )
+	/* The file system is constant, so the data is sent straight from it
+	rather than being copied anywhere first.  A protosocket can only send
+	up to 0xffff bytes at a time. */
+	while( s->file.len > 0 )
 	{
-		s->len = uip_mss();
+		if( s->file.len > 0xffff )
+		{
+			s->len = 0xffff;
+		}
+		else
+		{
+			s->len = s->file.len;
+		}
+
+		PSOCK_SEND_STATIC( &s->sout, s->file.data, s->len );
+		s->file.len -= s->len;
+		s->file.data += s->len;
 	}
-	else
+
+	PSOCK_END( &s->sout );
+}
+
+/*---------------------------------------------------------------------------*/
+#if HTTPD_FATFS
+
+/* Where forward_to_appdata() places the next part of a FatFs file. */
+static char *httpd_forward_ptr;
+
+/* The streaming function given to f_forward().  The generator never asks for
+more than fits in uip_appdata, so the stream is never busy. */
+static UINT forward_to_appdata( const BYTE *data, UINT len )
+{
+	if( len == 0 )
+	{
+		return 1;
+	}
+
+	memcpy( httpd_forward_ptr, data, len );
+	httpd_forward_ptr += len;
+	return len;
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned short generate_fatfs_part( void *state )
+{
+	struct httpd_state	*s = ( struct httpd_state * ) state;
+	UINT				n;
+
+	/* This is also called to retransmit the block, so the file is moved back
+	to the start of the block if it has already been forwarded. */
+	n = ( UINT ) s->len;
+	if( n > uip_mss() )
 	{
-		s->len = s->file.len;
+		n = uip_mss();
 	}
 
-	memcpy( uip_appdata, s->file.data, s->len );
+	httpd_forward_ptr = ( char * ) uip_appdata;
+	if( (s->fil.fptr != s->fpos && f_lseek( &s->fil, s->fpos ) != FR_OK) ||
+		f_forward( &s->fil, forward_to_appdata, n, &n ) != FR_OK )
+	{
+		n = 0;
+	}
 
-	return s->len;
+	s->len = ( int ) n;
+	return ( unsigned short ) n;
 }
 
 /*---------------------------------------------------------------------------*/
-static PT_THREAD( send_file ( struct httpd_state *s ) )
+static PT_THREAD( send_fatfs_file ( struct httpd_state *s ) )
 {
 	PSOCK_BEGIN( &s->sout );
-
 	( void ) PT_YIELD_FLAG;
-	
-	do
+
+	while( s->file.len > 0 )
 	{
-		PSOCK_GENERATOR_SEND( &s->sout, generate_part_of_file, s );
+		s->len = ( s->file.len > uip_conn->mss ) ? uip_conn->mss : s->file.len;
+		PSOCK_GENERATOR_SEND( &s->sout, generate_fatfs_part, s );
+		if( s->len == 0 )
+		{
+			/* The file could not be read.  The client can only tell the page
+			is short if the connection is closed. */
+			s->keepalive = 0;
+			break;
+		}
+
+		s->fpos += ( DWORD ) s->len;
 		s->file.len -= s->len;
-		s->file.data += s->len;
-	} while( s->file.len > 0 );
+	}
 
 	PSOCK_END( &s->sout );
 }
 
+/*---------------------------------------------------------------------------*/
+static char open_fatfs_file( struct httpd_state *s )
+{
+	char	path[sizeof( HTTPD_FATFS_ROOT ) + sizeof( s->filename )];
+
+	strcpy( path, HTTPD_FATFS_ROOT );
+	strncat( path, s->filename, sizeof( path ) - sizeof( HTTPD_FATFS_ROOT ) );
+	if( f_open( &s->fil, path, FA_READ | FA_OPEN_EXISTING ) != FR_OK )
+	{
+		return 0;
+	}
+
+	s->file.data = NULL;
+	s->file.len = ( int ) s->fil.fsize;
+	s->file.flags = HTTPD_FS_FLAG_FATFS;
+	s->fpos = 0;
+	return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static void close_fatfs_file( struct httpd_state *s )
+{
+	if( s->file.flags & HTTPD_FS_FLAG_FATFS )
+	{
+		f_close( &s->fil );
+		s->file.flags &= ~HTTPD_FS_FLAG_FATFS;
+	}
+}
+
+#endif /* HTTPD_FATFS */
+
 /*---------------------------------------------------------------------------*/
 static PT_THREAD( send_part_of_file ( struct httpd_state *s ) )
 {
 	PSOCK_BEGIN( &s->sout );
 	( void ) PT_YIELD_FLAG;
 	
-	PSOCK_SEND( &s->sout, s->file.data, s->len );
+	PSOCK_SEND_STATIC( &s->sout, s->file.data, s->len );
 
 	PSOCK_END( &s->sout );
 }
@@ -162,10 +258,11 @@ static PT_THREAD( handle_script ( struct httpd_state *s ) )
 		else
 		{
 			/* See if we find the start of script marker in the block of HTML
-	 to be sent. */
-			if( s->file.len > uip_mss() )
+	 to be sent.  The block is limited to the connection's MSS rather than
+	 uip_mss(), which can be zero while the transmit window is full. */
+			if( s->file.len > uip_conn->mss )
 			{
-				s->len = uip_mss();
+				s->len = uip_conn->mss;
 			}
 			else
 			{
@@ -184,9 +281,9 @@ static PT_THREAD( handle_script ( struct httpd_state *s ) )
 			if( ptr != NULL && ptr != s->file.data )
 			{
 				s->len = ( int ) ( ptr - s->file.data );
-				if( s->len >= uip_mss() )
+				if( s->len >= uip_conn->mss )
 				{
-					s->len = uip_mss();
+					s->len = uip_conn->mss;
 				}
 			}
 
@@ -200,77 +297,165 @@ static PT_THREAD( handle_script ( struct httpd_state *s ) )
 }
 
 /*---------------------------------------------------------------------------*/
-static PT_THREAD( send_headers ( struct httpd_state *s, const char *statushdr ) )
+static char is_script( const char *filename )
 {
 	char	*ptr;
 
-	PSOCK_BEGIN( &s->sout );
-	( void ) PT_YIELD_FLAG;
-	PSOCK_SEND_STR( &s->sout, statushdr );
+	ptr = strchr( filename, ISO_period );
+	return ( char ) ( ptr != NULL && strncmp(ptr, http_shtml, 6) == 0 );
+}
+
+/*---------------------------------------------------------------------------*/
+static const char *content_type( const char *filename )
+{
+	char	*ptr;
 
-	ptr = strrchr( s->filename, ISO_period );
+	ptr = strrchr( filename, ISO_period );
 	if( ptr == NULL )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_binary );
+		return http_content_type_binary;
 	}
 	else if( strncmp(http_html, ptr, 5) == 0 || strncmp(http_shtml, ptr, 6) == 0 )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_html );
+		return http_content_type_html;
 	}
 	else if( strncmp(http_css, ptr, 4) == 0 )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_css );
+		return http_content_type_css;
 	}
 	else if( strncmp(http_png, ptr, 4) == 0 )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_png );
+		return http_content_type_png;
 	}
 	else if( strncmp(http_gif, ptr, 4) == 0 )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_gif );
+		return http_content_type_gif;
 	}
 	else if( strncmp(http_jpg, ptr, 4) == 0 )
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_jpg );
+		return http_content_type_jpg;
+	}
+	else
+	{
+		return http_content_type_plain;
+	}
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned short generate_headers( void *state )
+{
+	struct httpd_state	*s = ( struct httpd_state * ) state;
+	char				*ptr = ( char * ) uip_appdata;
+
+	/* All the headers go in one segment. */
+	strcpy( ptr, s->statushdr );
+	ptr += strlen( ptr );
+
+	if( s->file.flags & HTTPD_FS_FLAG_GZIP )
+	{
+		strcpy( ptr, http_content_encoding_gzip );
+		ptr += strlen( ptr );
+	}
+
+	if( s->keepalive )
+	{
+		strcpy( ptr, http_connection_keepalive );
 	}
 	else
 	{
-		PSOCK_SEND_STR( &s->sout, http_content_type_plain );
+		strcpy( ptr, http_connection_close );
 	}
 
+	ptr += strlen( ptr );
+
+	/* The length of a scripted page is not known until it has been sent. */
+	if( !is_script(s->filename) || (s->file.flags & HTTPD_FS_FLAG_FATFS) )
+	{
+		ptr += sprintf( ptr, "%s%d\r\n", http_content_length, s->file.len );
+	}
+
+	strcpy( ptr, content_type(s->filename) );
+	ptr += strlen( ptr );
+
+	return ( unsigned short ) ( ptr - ( char * ) uip_appdata );
+}
+
+/*---------------------------------------------------------------------------*/
+static PT_THREAD( send_headers ( struct httpd_state *s, const char *statushdr ) )
+{
+	PSOCK_BEGIN( &s->sout );
+	( void ) PT_YIELD_FLAG;
+
+	s->statushdr = statushdr;
+	PSOCK_GENERATOR_SEND( &s->sout, generate_headers, s );
+
 	PSOCK_END( &s->sout );
 }
 
 /*---------------------------------------------------------------------------*/
-static PT_THREAD( handle_output ( struct httpd_state *s ) )
+static PT_THREAD( send_headers_and_file ( struct httpd_state *s, const char *statushdr ) )
 {
-	char	*ptr;
+	PSOCK_BEGIN( &s->sout );
+	( void ) PT_YIELD_FLAG;
 
+	/* The start of the file goes in the same segment as the headers, so a
+	small file is sent in one segment.  Anything past the first 0xffff bytes
+	is left for send_file(). */
+	s->statushdr = statushdr;
+	s->len = ( s->file.len > 0xffff ) ? 0xffff : s->file.len;
+	PSOCK_GENERATOR_SEND_STATIC( &s->sout, generate_headers, s, s->file.data, s->len );
+	s->file.data += s->len;
+	s->file.len -= s->len;
+
+	PSOCK_END( &s->sout );
+}
+
+/*---------------------------------------------------------------------------*/
+static PT_THREAD( handle_output ( struct httpd_state *s ) )
+{
 	PT_BEGIN( &s->outputpt );
 	( void ) PT_YIELD_FLAG;
 	if( !httpd_fs_open(s->filename, &s->file) )
 	{
-		httpd_fs_open( http_404_html, &s->file );
-		strcpy( s->filename, http_404_html );
-		PT_WAIT_THREAD( &s->outputpt, send_headers(s, http_header_404) );
-		PT_WAIT_THREAD( &s->outputpt, send_file(s) );
+		#if HTTPD_FATFS
+		if( open_fatfs_file(s) )
+		{
+			PT_WAIT_THREAD( &s->outputpt, send_headers(s, http_header_200) );
+			PT_WAIT_THREAD( &s->outputpt, send_fatfs_file(s) );
+			close_fatfs_file( s );
+		}
+		else
+		#endif
+		{
+			httpd_fs_open( http_404_html, &s->file );
+			strcpy( s->filename, http_404_html );
+			PT_WAIT_THREAD( &s->outputpt, send_headers_and_file(s, http_header_404) );
+			PT_WAIT_THREAD( &s->outputpt, send_file(s) );
+		}
 	}
 	else
 	{
-		PT_WAIT_THREAD( &s->outputpt, send_headers(s, http_header_200) );
-		ptr = strchr( s->filename, ISO_period );
-		if( ptr != NULL && strncmp(ptr, http_shtml, 6) == 0 )
+		if( is_script(s->filename) )
 		{
+			/* The connection is closed to end a scripted page, as the client
+			cannot be told its length. */
+			s->keepalive = 0;
+			PT_WAIT_THREAD( &s->outputpt, send_headers(s, http_header_200) );
 			PT_INIT( &s->scriptpt );
 			PT_WAIT_THREAD( &s->outputpt, handle_script(s) );
 		}
 		else
 		{
+			PT_WAIT_THREAD( &s->outputpt, send_headers_and_file(s, http_header_200) );
 			PT_WAIT_THREAD( &s->outputpt, send_file(s) );
 		}
 	}
 
-	PSOCK_CLOSE( &s->sout );
+	if( !s->keepalive )
+	{
+		PSOCK_CLOSE( &s->sout );
+	}
+
 	PT_END( &s->outputpt );
 }
 
@@ -279,64 +464,113 @@ static PT_THREAD( handle_input ( struct httpd_state *s ) )
 {
 	PSOCK_BEGIN( &s->sin );
 	( void ) PT_YIELD_FLAG;
-	PSOCK_READTO( &s->sin, ISO_space );
 
-	if( strncmp(s->inputbuf, http_get, 4) != 0 )
+	/* The request is parsed where it is in uip_appdata whenever a line is
+	not split across segments. */
+	PSOCK_READTO_REF( &s->sin, ISO_space );
+
+	if( strncmp(PSOCK_DATAPTR( &s->sin ), http_get, 4) != 0 )
 	{
 		PSOCK_CLOSE_EXIT( &s->sin );
 	}
 
-	PSOCK_READTO( &s->sin, ISO_space );
+	PSOCK_READTO_REF( &s->sin, ISO_space );
 
-	if( s->inputbuf[0] != ISO_slash )
+	if( PSOCK_DATAPTR( &s->sin )[0] != ISO_slash )
 	{
 		PSOCK_CLOSE_EXIT( &s->sin );
 	}
 
-	if( s->inputbuf[1] == ISO_space )
+	if( PSOCK_DATAPTR( &s->sin )[1] == ISO_space )
 	{
 		strncpy( s->filename, http_index_html, sizeof(s->filename) );
 	}
 	else
 	{
-		s->inputbuf[PSOCK_DATALEN( &s->sin ) - 1] = 0;
+		PSOCK_DATAPTR( &s->sin )[PSOCK_DATALEN( &s->sin ) - 1] = 0;
 		
 		/* Process any form input being sent to the server. */
 		#if UIP_CONF_PROCESS_HTTPD_FORMS == 1
 		{
 			extern void vApplicationProcessFormInput( char *pcInputString );
-			vApplicationProcessFormInput( s->inputbuf );
+			vApplicationProcessFormInput( PSOCK_DATAPTR( &s->sin ) );
 		}
 		#endif
 		
-		strncpy( s->filename, &s->inputbuf[0], sizeof(s->filename) );
+		strncpy( s->filename, PSOCK_DATAPTR( &s->sin ), sizeof(s->filename) );
 	}
 
 	/*  httpd_log_file(uip_conn->ripaddr, s->filename);*/
-	s->state = STATE_OUTPUT;
+	s->state = STATE_HEADERS;
+
+	/* HTTP/1.1 connections persist unless the client asks otherwise. */
+	PSOCK_READTO_REF( &s->sin, ISO_nl );
+	s->keepalive = ( strncmp(PSOCK_DATAPTR( &s->sin ), http_11, 8) == 0 );
 
-	while( 1 )
+	/* Read the header lines up to the empty line that ends the request. */
+	do
 	{
-		PSOCK_READTO( &s->sin, ISO_nl );
+		PSOCK_READTO_REF( &s->sin, ISO_nl );
 
-		if( strncmp(s->inputbuf, http_referer, 8) == 0 )
+		if( strncmp(PSOCK_DATAPTR( &s->sin ), http_referer, 8) == 0 )
 		{
-			s->inputbuf[PSOCK_DATALEN( &s->sin ) - 2] = 0;
+			PSOCK_DATAPTR( &s->sin )[PSOCK_DATALEN( &s->sin ) - 2] = 0;
 
-			/*      httpd_log(&s->inputbuf[9]);*/
+			/*      httpd_log(&PSOCK_DATAPTR( &s->sin )[9]);*/
+		}
+		else if( strncmp(PSOCK_DATAPTR( &s->sin ), http_connection_close, 17) == 0 )
+		{
+			s->keepalive = 0;
 		}
+		else if( strncmp(PSOCK_DATAPTR( &s->sin ), http_connection_keepalive, 22) == 0 )
+		{
+			s->keepalive = 1;
+		}
+	} while( PSOCK_DATALEN( &s->sin ) > 2 );
+
+	/* Data that follows the request in the same segment cannot be kept until
+	the response has been sent, so the connection is closed after it and the
+	client sends any such request again.  Otherwise the client is held off
+	until the response has been sent. */
+	if( s->sin.readlen > 0 )
+	{
+		s->keepalive = 0;
+	}
+	else if( s->keepalive )
+	{
+		uip_stop();
 	}
 
+	s->state = STATE_OUTPUT;
+	PSOCK_WAIT_UNTIL( &s->sin, s->state != STATE_OUTPUT );
+
 	PSOCK_END( &s->sin );
 }
 
+/*---------------------------------------------------------------------------*/
+static void handle_restart( struct httpd_state *s )
+{
+	PSOCK_INIT( &s->sin, s->inputbuf, sizeof(s->inputbuf) - 1 );
+	PSOCK_INIT( &s->sout, s->inputbuf, sizeof(s->inputbuf) - 1 );
+	PT_INIT( &s->outputpt );
+	s->state = STATE_WAITING;
+	s->keepalive = 0;
+	s->timer = 0;
+	s->file.flags = 0;
+}
+
 /*---------------------------------------------------------------------------*/
 static void handle_connection( struct httpd_state *s )
 {
 	handle_input( s );
 	if( s->state == STATE_OUTPUT )
 	{
-		handle_output( s );
+		if( handle_output(s) == PT_ENDED && s->keepalive )
+		{
+			/* The response has been sent, so wait for the next request. */
+			handle_restart( s );
+			uip_restart();
+		}
 	}
 }
 
@@ -347,16 +581,14 @@ void httpd_appcall( void )
 
 	if( uip_closed() || uip_aborted() || uip_timedout() )
 	{
+		#if HTTPD_FATFS
+		close_fatfs_file( s );
+		#endif
 	}
 	else if( uip_connected() )
 	{
-		PSOCK_INIT( &s->sin, s->inputbuf, sizeof(s->inputbuf) - 1 );
-		PSOCK_INIT( &s->sout, s->inputbuf, sizeof(s->inputbuf) - 1 );
-		PT_INIT( &s->outputpt );
-		s->state = STATE_WAITING;
-
 		/*    timer_set(&s->timer, CLOCK_SECOND * 100);*/
-		s->timer = 0;
+		handle_restart( s );
 		handle_connection( s );
 	}
 	else if( s != NULL )
@@ -364,8 +596,18 @@ void httpd_appcall( void )
 		if( uip_poll() )
 		{
 			++s->timer;
-			if( s->timer >= 20 )
+			if( s->state == STATE_WAITING && s->timer >= HTTPD_KEEPALIVE_TIMEOUT )
+			{
+				/* No request has arrived on the connection, so close it to
+				free the connection for other clients. */
+				uip_close();
+				return;
+			}
+			else if( s->timer >= 20 )
 			{
+				#if HTTPD_FATFS
+				close_fatfs_file( s );
+				#endif
 				uip_abort();
 			}
 		}
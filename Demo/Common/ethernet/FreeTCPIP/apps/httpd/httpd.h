@@ -37,6 +37,37 @@
 #include "net/psock.h"
 #include "httpd-fs.h"
 
+/* The number of periodic polls a persistent connection is kept open for while
+it waits for another request.  A connection on which a request is in progress
+is aborted after 20 polls without activity. */
+#ifdef HTTPD_CONF_KEEPALIVE_TIMEOUT
+	#define HTTPD_KEEPALIVE_TIMEOUT HTTPD_CONF_KEEPALIVE_TIMEOUT
+#else
+	#define HTTPD_KEEPALIVE_TIMEOUT 10
+#endif
+
+/* Set HTTPD_CONF_FATFS to 1 to serve the files that are not in the constant
+file system from a FatFs volume, looked up as HTTPD_CONF_FATFS_ROOT followed by
+the requested name.  FatFs must be built with _FS_TINY and _USE_FORWARD set to
+1.  f_forward() passes the file data from the FatFs sector window straight into
+uip_appdata, so it is only copied once on its way to the network.  Scripts are
+not run from FatFs files. */
+#ifdef HTTPD_CONF_FATFS
+	#define HTTPD_FATFS HTTPD_CONF_FATFS
+#else
+	#define HTTPD_FATFS 0
+#endif
+
+#ifdef HTTPD_CONF_FATFS_ROOT
+	#define HTTPD_FATFS_ROOT HTTPD_CONF_FATFS_ROOT
+#else
+	#define HTTPD_FATFS_ROOT ""
+#endif
+
+#if HTTPD_FATFS
+	#include "ff.h"
+#endif
+
 struct httpd_state
 {
 	unsigned char			timer;
@@ -45,12 +76,19 @@ struct httpd_state
 	char					inputbuf[50];
 	char					filename[20];
 	char					state;
+	char					keepalive;
+	const char				*statushdr;
 	struct httpd_fs_file	file;
 	int						len;
 	char					*scriptptr;
 	int						scriptlen;
 
 	unsigned short			count;
+
+#if HTTPD_FATFS
+	FIL						fil;	/* Open while file.flags has HTTPD_FS_FLAG_FATFS set. */
+	DWORD					fpos;	/* The offset in fil of the block being sent. */
+#endif
 };
 
 void	httpd_init( void );
@@ -0,0 +1,224 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * An iperf 2 compatible TCP server for uIP.  See iperfd.h for how it is used.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* uip includes. */
+#include "net/uip.h"
+
+#include "iperfd.h"
+
+/* The CPU load is derived from the time the idle task ran, measured with the
+same counter as the run time stats. */
+#if configGENERATE_RUN_TIME_STATS == 1
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define iperfGET_RUN_TIME( ulTime )		portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulTime ) )
+	#else
+		#define iperfGET_RUN_TIME( ulTime )		( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/*
+ * Pass the result of the test on uip_conn to the report callback.
+ */
+static void prvFinish( portBASE_TYPE xAborted );
+
+/*-----------------------------------------------------------*/
+
+static pdIPERF_REPORT_CALLBACK pxIperfReport = NULL;
+
+/* The connection being measured, or NULL. */
+static struct uip_conn *pxTestConnection = NULL;
+
+/* What was recorded when the connection was made. */
+static portTickType xStartTime;
+static unsigned long ulBytes;
+
+#if configGENERATE_RUN_TIME_STATS == 1
+	static portRUN_TIME_COUNTER_TYPE ulIdleStart, ulTotalStart;
+#endif
+
+#if UIP_STATISTICS == 1
+	static struct uip_stats xStatsStart;
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vIperfInit( pdIPERF_REPORT_CALLBACK pxReport )
+{
+	pxIperfReport = pxReport;
+	uip_listen( HTONS( iperfPORT ) );
+}
+/*-----------------------------------------------------------*/
+
+void vIperfAppcall( void )
+{
+	if( uip_connected() )
+	{
+		if( pxTestConnection != NULL )
+		{
+			/* A test is already running. */
+			uip_abort();
+			return;
+		}
+
+		pxTestConnection = uip_conn;
+		xStartTime = xTaskGetTickCount();
+		ulBytes = 0UL;
+
+		#if configGENERATE_RUN_TIME_STATS == 1
+		{
+			ulIdleStart = ulTaskGetIdleRunTimeCounter();
+			iperfGET_RUN_TIME( ulTotalStart );
+		}
+		#endif
+
+		#if UIP_STATISTICS == 1
+		{
+			xStatsStart = uip_stat;
+		}
+		#endif
+	}
+
+	if( uip_conn != pxTestConnection )
+	{
+		return;
+	}
+
+	/* The final segment can carry both data and the FIN. */
+	if( uip_newdata() )
+	{
+		ulBytes += uip_datalen();
+	}
+
+	if( uip_closed() )
+	{
+		prvFinish( pdFALSE );
+	}
+	else if( uip_aborted() || uip_timedout() )
+	{
+		prvFinish( pdTRUE );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinish( portBASE_TYPE xAborted )
+{
+xIperfReport xReport;
+unsigned long ulMilliseconds;
+
+	pxTestConnection = NULL;
+
+	memset( &xReport, 0x00, sizeof( xReport ) );
+	xReport.pcTest = "TCP server";
+	xReport.xAborted = xAborted;
+	xReport.ulBytes = ulBytes;
+
+	ulMilliseconds = ( unsigned long ) ( xTaskGetTickCount() - xStartTime ) * portTICK_RATE_MS;
+	xReport.ulMilliseconds = ulMilliseconds;
+	if( ulMilliseconds != 0UL )
+	{
+		/* Bytes per millisecond times eight is kbit/s.  Split to stay within
+		32 bits. */
+		xReport.ulKbitsPerSecond = ( ( ulBytes / ulMilliseconds ) * 8UL ) + ( ( ( ulBytes % ulMilliseconds ) * 8UL ) / ulMilliseconds );
+	}
+
+	xReport.usCpuLoad = iperfCPU_LOAD_UNKNOWN;
+	#if configGENERATE_RUN_TIME_STATS == 1
+	{
+	portRUN_TIME_COUNTER_TYPE ulIdle, ulTotal;
+
+		ulIdle = ulTaskGetIdleRunTimeCounter() - ulIdleStart;
+		iperfGET_RUN_TIME( ulTotal );
+		ulTotal -= ulTotalStart;
+
+		/* The idle time is summed over all the cores.  Scale the total to
+		tenths of a percent first so the division cannot overflow. */
+		ulTotal = ( ulTotal / 1000UL ) * configNUMBER_OF_CORES;
+		if( ulTotal != 0UL )
+		{
+			ulIdle /= ulTotal;
+			xReport.usCpuLoad = ( unsigned short ) ( ( ulIdle < 1000UL ) ? ( 1000UL - ulIdle ) : 0UL );
+		}
+	}
+	#endif
+
+	#if UIP_STATISTICS == 1
+	{
+		/* The casts keep the result right when a counter wraps. */
+		xReport.xIP.ulXmit = ( uip_stats_t ) ( uip_stat.ip.sent - xStatsStart.ip.sent );
+		xReport.xIP.ulRecv = ( uip_stats_t ) ( uip_stat.ip.recv - xStatsStart.ip.recv );
+		xReport.xIP.ulDrop = ( uip_stats_t ) ( uip_stat.ip.drop - xStatsStart.ip.drop );
+		xReport.xTCP.ulXmit = ( uip_stats_t ) ( uip_stat.tcp.sent - xStatsStart.tcp.sent );
+		xReport.xTCP.ulRecv = ( uip_stats_t ) ( uip_stat.tcp.recv - xStatsStart.tcp.recv );
+		xReport.xTCP.ulDrop = ( uip_stats_t ) ( uip_stat.tcp.drop - xStatsStart.tcp.drop );
+	}
+	#endif
+
+	if( pxIperfReport != NULL )
+	{
+		pxIperfReport( &xReport );
+	}
+}
+/*-----------------------------------------------------------*/
+
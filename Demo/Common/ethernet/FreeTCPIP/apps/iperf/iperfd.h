@@ -0,0 +1,129 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef IPERFD_H
+#define IPERFD_H
+
+/*
+ * An iperf 2 compatible TCP server for uIP, so the throughput of a uIP board
+ * can be measured with "iperf -c <board IP> -t 10" from a PC and compared
+ * with the lwIP boards, which use the server in lwip-1.4.0/apps/iperf.
+ *
+ * The data received is counted and thrown away.  When the client closes the
+ * connection the result is passed to the callback given to vIperfInit(),
+ * together with the CPU load over the test, taken from the idle task run time
+ * when configGENERATE_RUN_TIME_STATS is 1, and how much the uIP statistics
+ * changed when UIP_STATISTICS is 1.  Only one test runs at a time.
+ *
+ * uIP only has one application callback, so the uIP task must:
+ *  + call vIperfInit() once uIP has been initialised.
+ *  + call vIperfAppcall() from the UIP_APPCALL function for connections with
+ *    a local port of iperfPORT, for example:
+ *
+ *      if( uip_conn->lport == HTONS( iperfPORT ) )
+ *      {
+ *          vIperfAppcall();
+ *      }
+ *      else
+ *      {
+ *          httpd_appcall();
+ *      }
+ *
+ * As uIP only has one segment in flight, the result mostly shows how quickly
+ * the uIP task turns a segment around.
+ */
+
+/* The port used by iperf when -p is not given. */
+#define iperfPORT					5001
+
+/* The value of usCpuLoad when configGENERATE_RUN_TIME_STATS is not 1. */
+#define iperfCPU_LOAD_UNKNOWN		0xffffU
+
+/* How much a group of uIP counters changed during a test. */
+typedef struct xIPERF_COUNTERS
+{
+	unsigned long ulXmit;
+	unsigned long ulRecv;
+	unsigned long ulDrop;
+} xIperfCounters;
+
+typedef struct xIPERF_REPORT
+{
+	const char *pcTest;					/* Always "TCP server". */
+	portBASE_TYPE xAborted;				/* pdTRUE if the connection failed before the test ended. */
+	unsigned long ulBytes;				/* Payload bytes received, including the iperf header. */
+	unsigned long ulMilliseconds;		/* Time from the connection to the close. */
+	unsigned long ulKbitsPerSecond;		/* ulBytes over ulMilliseconds. */
+	unsigned short usCpuLoad;			/* Tenths of a percent, or iperfCPU_LOAD_UNKNOWN. */
+
+	/* Left at zero unless UIP_STATISTICS is 1. */
+	xIperfCounters xIP;
+	xIperfCounters xTCP;
+} xIperfReport;
+
+typedef void ( * pdIPERF_REPORT_CALLBACK )( const xIperfReport *pxReport );
+
+/*
+ * Listen on iperfPORT.  pxReport is called from the uIP task, and can be NULL
+ * if the results are only wanted on the PC.
+ */
+void vIperfInit( pdIPERF_REPORT_CALLBACK pxReport );
+
+/*
+ * Handle a uIP event on a connection to iperfPORT.
+ */
+void vIperfAppcall( void );
+
+#endif /* IPERFD_H */
+
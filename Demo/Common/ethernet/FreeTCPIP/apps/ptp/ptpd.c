@@ -0,0 +1,812 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A minimal IEEE 1588-2008 ordinary clock.  See ptpd.h for a description of
+ * what is and is not implemented, and how it is used.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* uip includes. */
+#include "net/uip.h"
+#include "net/uip_arp.h"
+#include "emac.h"
+
+#include "ptpd.h"
+
+/* PTP message types. */
+#define ptpMSG_SYNC					0x00
+#define ptpMSG_DELAY_REQ			0x01
+#define ptpMSG_FOLLOW_UP			0x08
+#define ptpMSG_DELAY_RESP			0x09
+#define ptpMSG_ANNOUNCE				0x0b
+
+/* Values of the control field, which is only there for version 1 nodes. */
+#define ptpCONTROL_SYNC				0x00
+#define ptpCONTROL_DELAY_REQ		0x01
+#define ptpCONTROL_FOLLOW_UP		0x02
+#define ptpCONTROL_DELAY_RESP		0x03
+#define ptpCONTROL_OTHER			0x05
+
+/* Offsets of the fields within a message, counted from the end of the
+Ethernet header. */
+#define ptpOFFSET_TYPE				0
+#define ptpOFFSET_VERSION			1
+#define ptpOFFSET_LENGTH			2
+#define ptpOFFSET_DOMAIN			4
+#define ptpOFFSET_FLAGS				6
+#define ptpOFFSET_CORRECTION		8
+#define ptpOFFSET_SOURCE_PORT		20
+#define ptpOFFSET_SEQUENCE			30
+#define ptpOFFSET_CONTROL			32
+#define ptpOFFSET_LOG_INTERVAL		33
+#define ptpOFFSET_TIMESTAMP			34
+#define ptpOFFSET_REQUESTING_PORT	44
+#define ptpOFFSET_UTC_OFFSET		44
+#define ptpOFFSET_GM_PRIORITY1		47
+#define ptpOFFSET_GM_CLOCK_CLASS	48
+#define ptpOFFSET_GM_ACCURACY		49
+#define ptpOFFSET_GM_VARIANCE		50
+#define ptpOFFSET_GM_PRIORITY2		52
+#define ptpOFFSET_GM_IDENTITY		53
+#define ptpOFFSET_STEPS_REMOVED		61
+#define ptpOFFSET_TIME_SOURCE		63
+
+/* Message lengths. */
+#define ptpHEADER_LENGTH			34
+#define ptpSYNC_LENGTH				44
+#define ptpDELAY_RESP_LENGTH		54
+#define ptpANNOUNCE_LENGTH			64
+
+#define ptpVERSION					2
+#define ptpCLOCK_IDENTITY_LENGTH	8
+#define ptpPORT_IDENTITY_LENGTH		10
+#define ptpCORRECTION_LENGTH		8
+
+/* The Announce fields from grandmasterPriority1 to grandmasterIdentity.  As
+they are all unsigned and big endian, a memcmp() of them compares two
+grandmasters in the order required by the best master clock algorithm. */
+#define ptpGM_DATASET_LENGTH		14
+
+/* The two step flag is in the first octet of the flag field. */
+#define ptpFLAG_TWO_STEP			0x02
+
+/* Message intervals, as log2 of the interval in seconds. */
+#define ptpLOG_SYNC_INTERVAL		0
+#define ptpLOG_ANNOUNCE_INTERVAL	1
+#define ptpLOG_MIN_DELAY_REQ		0
+#define ptpLOG_UNUSED_INTERVAL		0x7f
+
+/* The same intervals, and the announce receipt timeout, as calls to
+vPTPTimer(). */
+#define ptpANNOUNCE_INTERVAL_TICKS	2UL
+#define ptpANNOUNCE_TIMEOUT_TICKS	( 3UL * ptpANNOUNCE_INTERVAL_TICKS )
+
+/* The dataset sent in Announce messages by a master.  248 is the default
+clock class, and 0xfe, 0xffff and 0xa0 mean an internal oscillator of unknown
+accuracy and variance. */
+#define ptpPRIORITY1				128
+#define ptpPRIORITY2				128
+#define ptpCLOCK_CLASS				248
+#define ptpCLOCK_ACCURACY			0xfe
+#define ptpCLOCK_VARIANCE			0xffff
+#define ptpTIME_SOURCE				0xa0
+
+/* Offsets larger than this are corrected by stepping the clock rather than by
+adjusting its frequency. */
+#define ptpSTEP_THRESHOLD_NS		1000000L
+
+/* The offset below which a slave reports itself as synchronised. */
+#define ptpLOCKED_THRESHOLD_NS		1000L
+
+/* Limit on the frequency adjustment made by the servo. */
+#define ptpMAX_ADJUST_PPB			500000L
+
+/* Proportional and integral gains of the servo, in tenths.  The integral term
+is the frequency error of the local clock, in parts per billion. */
+#define ptpKP_TENTHS				7L
+#define ptpKI_TENTHS				3L
+
+/* Each new path delay measurement moves the filtered delay this fraction of
+the way towards the measurement. */
+#define ptpDELAY_FILTER_DIVISOR		8L
+
+#define ptpNS_PER_SECOND			1000000000L
+
+/* Shortcuts to the Ethernet header and the PTP message within uip_buf. */
+#define xHeader ( ( struct uip_eth_hdr * ) &uip_buf[ 0 ] )
+#define pucMessage ( &uip_buf[ UIP_LLH_LEN ] )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write the Ethernet header and the PTP header of a message to uip_buf, clear
+ * the body, and set uip_len to the length of the frame.
+ */
+static void prvPrepareMessage( unsigned char ucType, unsigned short usLength, unsigned short usSequence, unsigned char ucControl, unsigned char ucLogInterval );
+
+/*
+ * Send the frame in uip_buf.  If pxTxTime is not NULL then the time it was
+ * sent is returned in *pxTxTime, and pdFAIL is returned if that could not be
+ * obtained.
+ */
+static portBASE_TYPE prvSendMessage( xPTPTime *pxTxTime );
+
+/*
+ * Message handlers, called with the message in uip_buf.
+ */
+static void prvProcessAnnounce( void );
+static void prvProcessSync( const xPTPTime *pxRxTime );
+static void prvProcessFollowUp( void );
+static void prvProcessDelayResp( void );
+static void prvProcessDelayReq( const xPTPTime *pxRxTime );
+
+/*
+ * Messages sent periodically.
+ */
+static void prvSendAnnounce( void );
+static void prvSendSync( void );
+static void prvSendDelayReq( void );
+
+/*
+ * Calculate the offset from the master once both the Sync receive time and
+ * the precise origin time are known.
+ */
+static void prvSyncComplete( void );
+
+/*
+ * Adjust the local clock to remove lOffset nanoseconds of offset from the
+ * master.
+ */
+static void prvUpdateServo( long lOffset );
+
+/*
+ * Forget everything measured from the current master.
+ */
+static void prvResetMaster( void );
+
+/*
+ * Access to big endian and unaligned message fields.
+ */
+static unsigned short prvRead16( const unsigned char *pucField );
+static unsigned long prvRead32( const unsigned char *pucField );
+static void prvWrite16( unsigned char *pucField, unsigned short usValue );
+static void prvWrite32( unsigned char *pucField, unsigned long ulValue );
+static void prvReadTimestamp( const unsigned char *pucField, xPTPTime *pxTime );
+static void prvWriteTimestamp( unsigned char *pucField, const xPTPTime *pxTime );
+static long prvReadCorrection( void );
+
+/*-----------------------------------------------------------*/
+
+/* The 01-1B-19-00-00-00 address that all PTP messages other than peer delay
+messages are sent to. */
+static const struct uip_eth_addr xPTPMulticastAddress = { { 0x01, 0x1b, 0x19, 0x00, 0x00, 0x00 } };
+
+/* ptpROLE_SLAVE or ptpROLE_MASTER. */
+static unsigned char ucRole = ptpROLE_SLAVE;
+
+/* The port identity of this clock - a clock identity formed from the MAC
+address, followed by port number 1. */
+static unsigned char ucPortIdentity[ ptpPORT_IDENTITY_LENGTH ];
+
+/* Sequence numbers of the messages sent. */
+static unsigned short usAnnounceSequence = 0, usSyncSequence = 0, usDelayReqSequence = 0;
+
+/* Counts calls to vPTPTimer(). */
+static unsigned long ulTicks = 0UL;
+
+/* The port identity and grandmaster dataset of the master being followed by
+a slave, and the number of vPTPTimer() calls since it last sent an Announce
+message. */
+static portBASE_TYPE xHaveMaster = pdFALSE;
+static unsigned char ucMasterPort[ ptpPORT_IDENTITY_LENGTH ];
+static unsigned char ucMasterDataset[ ptpGM_DATASET_LENGTH ];
+static unsigned short usMasterStepsRemoved;
+static unsigned long ulAnnounceAge;
+
+/* The origin (t1) and receive (t2) times of the last Sync message, and the
+correction applied to them.  xWaitingForFollowUp is set while t1 is still to
+come from a Follow_Up message with the sequence number usSyncSequenceRx. */
+static xPTPTime xSyncOriginTime, xSyncRxTime;
+static long lSyncCorrection;
+static unsigned short usSyncSequenceRx;
+static portBASE_TYPE xWaitingForFollowUp = pdFALSE;
+
+/* The master to slave delay (t2 - t1) of the last complete Sync, which is
+only valid while xHaveSync is set. */
+static long lMasterToSlaveDelay;
+static portBASE_TYPE xHaveSync = pdFALSE;
+
+/* The time (t3) the outstanding Delay_Req message was sent. */
+static xPTPTime xDelayReqTxTime;
+static portBASE_TYPE xDelayReqPending = pdFALSE;
+
+/* The filtered one way path delay, valid once at least one Delay_Resp has
+been received. */
+static long lMeanPathDelay = 0L;
+static portBASE_TYPE xHaveDelay = pdFALSE;
+
+/* Servo state. */
+static long lOffsetFromMaster = 0L, lFrequencyError = 0L;
+static portBASE_TYPE xLocked = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vPTPInit( unsigned char ucNewRole )
+{
+	ucRole = ucNewRole;
+
+	/* Form the EUI-64 clock identity from the EUI-48 MAC address. */
+	ucPortIdentity[ 0 ] = uip_ethaddr.addr[ 0 ];
+	ucPortIdentity[ 1 ] = uip_ethaddr.addr[ 1 ];
+	ucPortIdentity[ 2 ] = uip_ethaddr.addr[ 2 ];
+	ucPortIdentity[ 3 ] = 0xff;
+	ucPortIdentity[ 4 ] = 0xfe;
+	ucPortIdentity[ 5 ] = uip_ethaddr.addr[ 3 ];
+	ucPortIdentity[ 6 ] = uip_ethaddr.addr[ 4 ];
+	ucPortIdentity[ 7 ] = uip_ethaddr.addr[ 5 ];
+	prvWrite16( &ucPortIdentity[ ptpCLOCK_IDENTITY_LENGTH ], 1 );
+
+	prvResetMaster();
+	lFrequencyError = 0L;
+	vEMACPTPAdjustFrequency( 0L );
+}
+/*-----------------------------------------------------------*/
+
+void vPTPInput( void )
+{
+xPTPTime xRxTime;
+unsigned short usLength;
+
+	/* Read the receive time straight away, as it is only held for the frame
+	most recently received. */
+	vEMACPTPGetRxTime( &xRxTime );
+
+	if( ( uip_len >= ( UIP_LLH_LEN + ptpHEADER_LENGTH ) ) &&
+		( ( pucMessage[ ptpOFFSET_VERSION ] & 0x0f ) == ptpVERSION ) &&
+		( pucMessage[ ptpOFFSET_DOMAIN ] == ptpDOMAIN ) &&
+		( memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucPortIdentity, ptpCLOCK_IDENTITY_LENGTH ) != 0 ) )
+	{
+		usLength = prvRead16( &pucMessage[ ptpOFFSET_LENGTH ] );
+
+		if( usLength <= ( uip_len - UIP_LLH_LEN ) )
+		{
+			switch( pucMessage[ ptpOFFSET_TYPE ] & 0x0f )
+			{
+				case ptpMSG_ANNOUNCE	:	if( ( ucRole == ptpROLE_SLAVE ) && ( usLength >= ptpANNOUNCE_LENGTH ) )
+											{
+												prvProcessAnnounce();
+											}
+											break;
+
+				case ptpMSG_SYNC		:	if( ( ucRole == ptpROLE_SLAVE ) && ( usLength >= ptpSYNC_LENGTH ) )
+											{
+												prvProcessSync( &xRxTime );
+											}
+											break;
+
+				case ptpMSG_FOLLOW_UP	:	if( ( ucRole == ptpROLE_SLAVE ) && ( usLength >= ptpSYNC_LENGTH ) )
+											{
+												prvProcessFollowUp();
+											}
+											break;
+
+				case ptpMSG_DELAY_RESP	:	if( ( ucRole == ptpROLE_SLAVE ) && ( usLength >= ptpDELAY_RESP_LENGTH ) )
+											{
+												prvProcessDelayResp();
+											}
+											break;
+
+				case ptpMSG_DELAY_REQ	:	if( ( ucRole == ptpROLE_MASTER ) && ( usLength >= ptpSYNC_LENGTH ) )
+											{
+												prvProcessDelayReq( &xRxTime );
+											}
+											break;
+
+				default					:	/* Management, signalling and peer
+											delay messages are not supported. */
+											break;
+			}
+		}
+	}
+
+	uip_len = 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPTPTimer( void )
+{
+	ulTicks++;
+
+	if( ucRole == ptpROLE_MASTER )
+	{
+		if( ( ulTicks % ptpANNOUNCE_INTERVAL_TICKS ) == 0UL )
+		{
+			prvSendAnnounce();
+		}
+
+		prvSendSync();
+	}
+	else if( xHaveMaster != pdFALSE )
+	{
+		ulAnnounceAge++;
+		if( ulAnnounceAge > ptpANNOUNCE_TIMEOUT_TICKS )
+		{
+			/* The master has gone quiet.  Wait for another to announce
+			itself. */
+			prvResetMaster();
+		}
+		else if( xHaveSync != pdFALSE )
+		{
+			/* The delay can only be calculated once there is a Sync to pair
+			the Delay_Req with. */
+			prvSendDelayReq();
+		}
+	}
+
+	uip_len = 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPTPGetSyncedTime( xPTPTime *pxTime )
+{
+	vEMACPTPGetTime( pxTime );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPTPIsSynchronised( void )
+{
+portBASE_TYPE xReturn;
+
+	if( ucRole == ptpROLE_MASTER )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = xLocked;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+long lPTPGetOffsetFromMaster( void )
+{
+	return lOffsetFromMaster;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessAnnounce( void )
+{
+const unsigned char *pucDataset = &pucMessage[ ptpOFFSET_GM_PRIORITY1 ];
+unsigned short usStepsRemoved = prvRead16( &pucMessage[ ptpOFFSET_STEPS_REMOVED ] );
+portBASE_TYPE xSwitch = pdFALSE;
+int iCompare;
+
+	if( ( xHaveMaster != pdFALSE ) && ( memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucMasterPort, ptpPORT_IDENTITY_LENGTH ) == 0 ) )
+	{
+		/* From the current master, which is still alive. */
+		memcpy( ucMasterDataset, pucDataset, ptpGM_DATASET_LENGTH );
+		usMasterStepsRemoved = usStepsRemoved;
+		ulAnnounceAge = 0UL;
+	}
+	else if( xHaveMaster == pdFALSE )
+	{
+		xSwitch = pdTRUE;
+	}
+	else
+	{
+		/* Is the new master better?  Ties between masters that lead to the
+		same grandmaster are broken by the distance to the grandmaster, then by
+		port identity. */
+		iCompare = memcmp( pucDataset, ucMasterDataset, ptpGM_DATASET_LENGTH );
+		if( iCompare == 0 )
+		{
+			if( usStepsRemoved == usMasterStepsRemoved )
+			{
+				iCompare = memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucMasterPort, ptpPORT_IDENTITY_LENGTH );
+			}
+			else
+			{
+				iCompare = ( usStepsRemoved < usMasterStepsRemoved ) ? -1 : 1;
+			}
+		}
+
+		if( iCompare < 0 )
+		{
+			xSwitch = pdTRUE;
+		}
+	}
+
+	if( xSwitch != pdFALSE )
+	{
+		prvResetMaster();
+		memcpy( ucMasterPort, &pucMessage[ ptpOFFSET_SOURCE_PORT ], ptpPORT_IDENTITY_LENGTH );
+		memcpy( ucMasterDataset, pucDataset, ptpGM_DATASET_LENGTH );
+		usMasterStepsRemoved = usStepsRemoved;
+		xHaveMaster = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSync( const xPTPTime *pxRxTime )
+{
+	if( ( xHaveMaster != pdFALSE ) && ( memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucMasterPort, ptpPORT_IDENTITY_LENGTH ) == 0 ) )
+	{
+		xSyncRxTime = *pxRxTime;
+		lSyncCorrection = prvReadCorrection();
+		usSyncSequenceRx = prvRead16( &pucMessage[ ptpOFFSET_SEQUENCE ] );
+
+		if( ( pucMessage[ ptpOFFSET_FLAGS ] & ptpFLAG_TWO_STEP ) != 0 )
+		{
+			/* The precise origin time follows in a Follow_Up message. */
+			xWaitingForFollowUp = pdTRUE;
+		}
+		else
+		{
+			xWaitingForFollowUp = pdFALSE;
+			prvReadTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xSyncOriginTime );
+			prvSyncComplete();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessFollowUp( void )
+{
+	if( ( xWaitingForFollowUp != pdFALSE ) &&
+		( prvRead16( &pucMessage[ ptpOFFSET_SEQUENCE ] ) == usSyncSequenceRx ) &&
+		( memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucMasterPort, ptpPORT_IDENTITY_LENGTH ) == 0 ) )
+	{
+		xWaitingForFollowUp = pdFALSE;
+		lSyncCorrection += prvReadCorrection();
+		prvReadTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xSyncOriginTime );
+		prvSyncComplete();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSyncComplete( void )
+{
+long lSeconds, lNanoseconds;
+
+	lSeconds = ( long ) ( xSyncRxTime.ulSeconds - xSyncOriginTime.ulSeconds );
+	lNanoseconds = ( long ) xSyncRxTime.ulNanoseconds - ( long ) xSyncOriginTime.ulNanoseconds;
+
+	if( ( lSeconds > 1L ) || ( lSeconds < -1L ) )
+	{
+		/* Too far out for the difference to be held in nanoseconds.  Step
+		straight to the master time. */
+		vEMACPTPStepTime( -lSeconds, -lNanoseconds + lSyncCorrection + lMeanPathDelay );
+		xHaveSync = pdFALSE;
+		xDelayReqPending = pdFALSE;
+		xLocked = pdFALSE;
+		lOffsetFromMaster = 0L;
+	}
+	else
+	{
+		lMasterToSlaveDelay = ( lSeconds * ptpNS_PER_SECOND ) + lNanoseconds - lSyncCorrection;
+		xHaveSync = pdTRUE;
+		prvUpdateServo( lMasterToSlaveDelay - lMeanPathDelay );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateServo( long lOffset )
+{
+long lAdjust;
+
+	lOffsetFromMaster = lOffset;
+
+	if( ( lOffset > ptpSTEP_THRESHOLD_NS ) || ( lOffset < -ptpSTEP_THRESHOLD_NS ) )
+	{
+		/* Step the clock, but keep the frequency error that has been learnt
+		so far.  The Sync and Delay_Req times measured before the step are
+		no longer valid. */
+		vEMACPTPStepTime( 0L, -lOffset );
+		xHaveSync = pdFALSE;
+		xDelayReqPending = pdFALSE;
+		xLocked = pdFALSE;
+	}
+	else
+	{
+		/* A PI controller.  As the Sync interval is one second, the offset in
+		nanoseconds is also the frequency error over the interval in parts per
+		billion. */
+		lFrequencyError += ( lOffset * ptpKI_TENTHS ) / 10L;
+		if( lFrequencyError > ptpMAX_ADJUST_PPB )
+		{
+			lFrequencyError = ptpMAX_ADJUST_PPB;
+		}
+		else if( lFrequencyError < -ptpMAX_ADJUST_PPB )
+		{
+			lFrequencyError = -ptpMAX_ADJUST_PPB;
+		}
+
+		lAdjust = lFrequencyError + ( ( lOffset * ptpKP_TENTHS ) / 10L );
+		if( lAdjust > ptpMAX_ADJUST_PPB )
+		{
+			lAdjust = ptpMAX_ADJUST_PPB;
+		}
+		else if( lAdjust < -ptpMAX_ADJUST_PPB )
+		{
+			lAdjust = -ptpMAX_ADJUST_PPB;
+		}
+
+		/* A positive offset means the local clock is ahead, so has to run
+		slower. */
+		vEMACPTPAdjustFrequency( -lAdjust );
+
+		/* Don't claim to be synchronised before the path delay is known. */
+		xLocked = ( ( xHaveDelay != pdFALSE ) && ( lOffset < ptpLOCKED_THRESHOLD_NS ) && ( lOffset > -ptpLOCKED_THRESHOLD_NS ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessDelayResp( void )
+{
+xPTPTime xDelayReqRxTime;
+long lSeconds, lSlaveToMasterDelay, lDelay;
+
+	if( ( xDelayReqPending != pdFALSE ) &&
+		( xHaveSync != pdFALSE ) &&
+		( prvRead16( &pucMessage[ ptpOFFSET_SEQUENCE ] ) == ( unsigned short ) ( usDelayReqSequence - 1U ) ) &&
+		( memcmp( &pucMessage[ ptpOFFSET_REQUESTING_PORT ], ucPortIdentity, ptpPORT_IDENTITY_LENGTH ) == 0 ) &&
+		( memcmp( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucMasterPort, ptpPORT_IDENTITY_LENGTH ) == 0 ) )
+	{
+		xDelayReqPending = pdFALSE;
+
+		/* t4 - t3. */
+		prvReadTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xDelayReqRxTime );
+		lSeconds = ( long ) ( xDelayReqRxTime.ulSeconds - xDelayReqTxTime.ulSeconds );
+
+		if( ( lSeconds <= 1L ) && ( lSeconds >= -1L ) )
+		{
+			lSlaveToMasterDelay = ( lSeconds * ptpNS_PER_SECOND ) + ( ( long ) xDelayReqRxTime.ulNanoseconds - ( long ) xDelayReqTxTime.ulNanoseconds ) - prvReadCorrection();
+
+			/* Halve each delay before adding them to prevent an overflow. */
+			lDelay = ( lMasterToSlaveDelay / 2L ) + ( lSlaveToMasterDelay / 2L );
+
+			if( xHaveDelay == pdFALSE )
+			{
+				lMeanPathDelay = lDelay;
+				xHaveDelay = pdTRUE;
+			}
+			else
+			{
+				lMeanPathDelay += ( lDelay - lMeanPathDelay ) / ptpDELAY_FILTER_DIVISOR;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessDelayReq( const xPTPTime *pxRxTime )
+{
+unsigned char ucRequestingPort[ ptpPORT_IDENTITY_LENGTH ];
+unsigned char ucCorrection[ ptpCORRECTION_LENGTH ];
+unsigned short usSequence;
+
+	/* Save the fields of the request that are needed in the response, which
+	is built in the same buffer. */
+	memcpy( ucRequestingPort, &pucMessage[ ptpOFFSET_SOURCE_PORT ], ptpPORT_IDENTITY_LENGTH );
+	memcpy( ucCorrection, &pucMessage[ ptpOFFSET_CORRECTION ], ptpCORRECTION_LENGTH );
+	usSequence = prvRead16( &pucMessage[ ptpOFFSET_SEQUENCE ] );
+
+	prvPrepareMessage( ptpMSG_DELAY_RESP, ptpDELAY_RESP_LENGTH, usSequence, ptpCONTROL_DELAY_RESP, ptpLOG_MIN_DELAY_REQ );
+	memcpy( &pucMessage[ ptpOFFSET_CORRECTION ], ucCorrection, ptpCORRECTION_LENGTH );
+	prvWriteTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], pxRxTime );
+	memcpy( &pucMessage[ ptpOFFSET_REQUESTING_PORT ], ucRequestingPort, ptpPORT_IDENTITY_LENGTH );
+	prvSendMessage( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendAnnounce( void )
+{
+xPTPTime xNow;
+
+	prvPrepareMessage( ptpMSG_ANNOUNCE, ptpANNOUNCE_LENGTH, usAnnounceSequence++, ptpCONTROL_OTHER, ptpLOG_ANNOUNCE_INTERVAL );
+	vEMACPTPGetTime( &xNow );
+	prvWriteTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xNow );
+	pucMessage[ ptpOFFSET_GM_PRIORITY1 ] = ptpPRIORITY1;
+	pucMessage[ ptpOFFSET_GM_CLOCK_CLASS ] = ptpCLOCK_CLASS;
+	pucMessage[ ptpOFFSET_GM_ACCURACY ] = ptpCLOCK_ACCURACY;
+	prvWrite16( &pucMessage[ ptpOFFSET_GM_VARIANCE ], ptpCLOCK_VARIANCE );
+	pucMessage[ ptpOFFSET_GM_PRIORITY2 ] = ptpPRIORITY2;
+	memcpy( &pucMessage[ ptpOFFSET_GM_IDENTITY ], ucPortIdentity, ptpCLOCK_IDENTITY_LENGTH );
+	pucMessage[ ptpOFFSET_TIME_SOURCE ] = ptpTIME_SOURCE;
+	prvSendMessage( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendSync( void )
+{
+xPTPTime xTime;
+unsigned short usSequence = usSyncSequence++;
+
+	/* Two step - the origin time in the Sync is only approximate, the time
+	the Sync actually left is sent in the Follow_Up. */
+	prvPrepareMessage( ptpMSG_SYNC, ptpSYNC_LENGTH, usSequence, ptpCONTROL_SYNC, ptpLOG_SYNC_INTERVAL );
+	pucMessage[ ptpOFFSET_FLAGS ] |= ptpFLAG_TWO_STEP;
+	vEMACPTPGetTime( &xTime );
+	prvWriteTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xTime );
+
+	if( prvSendMessage( &xTime ) == pdPASS )
+	{
+		prvPrepareMessage( ptpMSG_FOLLOW_UP, ptpSYNC_LENGTH, usSequence, ptpCONTROL_FOLLOW_UP, ptpLOG_SYNC_INTERVAL );
+		prvWriteTimestamp( &pucMessage[ ptpOFFSET_TIMESTAMP ], &xTime );
+		prvSendMessage( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendDelayReq( void )
+{
+	/* The origin time is left as zero, as the time that matters is the time
+	the message actually leaves. */
+	prvPrepareMessage( ptpMSG_DELAY_REQ, ptpSYNC_LENGTH, usDelayReqSequence++, ptpCONTROL_DELAY_REQ, ptpLOG_UNUSED_INTERVAL );
+	xDelayReqPending = prvSendMessage( &xDelayReqTxTime );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetMaster( void )
+{
+	xHaveMaster = pdFALSE;
+	xWaitingForFollowUp = pdFALSE;
+	xHaveSync = pdFALSE;
+	xDelayReqPending = pdFALSE;
+	xHaveDelay = pdFALSE;
+	xLocked = pdFALSE;
+	lMeanPathDelay = 0L;
+	lOffsetFromMaster = 0L;
+	ulAnnounceAge = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrepareMessage( unsigned char ucType, unsigned short usLength, unsigned short usSequence, unsigned char ucControl, unsigned char ucLogInterval )
+{
+	memcpy( xHeader->dest.addr, xPTPMulticastAddress.addr, sizeof( xHeader->dest.addr ) );
+	memcpy( xHeader->src.addr, uip_ethaddr.addr, sizeof( xHeader->src.addr ) );
+	xHeader->type = HTONS( ptpETHTYPE );
+
+	memset( pucMessage, 0x00, usLength );
+	pucMessage[ ptpOFFSET_TYPE ] = ucType;
+	pucMessage[ ptpOFFSET_VERSION ] = ptpVERSION;
+	prvWrite16( &pucMessage[ ptpOFFSET_LENGTH ], usLength );
+	pucMessage[ ptpOFFSET_DOMAIN ] = ptpDOMAIN;
+	memcpy( &pucMessage[ ptpOFFSET_SOURCE_PORT ], ucPortIdentity, ptpPORT_IDENTITY_LENGTH );
+	prvWrite16( &pucMessage[ ptpOFFSET_SEQUENCE ], usSequence );
+	pucMessage[ ptpOFFSET_CONTROL ] = ucControl;
+	pucMessage[ ptpOFFSET_LOG_INTERVAL ] = ucLogInterval;
+
+	uip_len = UIP_LLH_LEN + usLength;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSendMessage( xPTPTime *pxTxTime )
+{
+portBASE_TYPE xReturn = pdPASS;
+
+	ptpSEND_FRAME();
+	uip_len = 0;
+
+	if( pxTxTime != NULL )
+	{
+		xReturn = xEMACPTPGetTxTime( pxTxTime );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned short prvRead16( const unsigned char *pucField )
+{
+	return ( unsigned short ) ( ( ( unsigned short ) pucField[ 0 ] << 8 ) | pucField[ 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvRead32( const unsigned char *pucField )
+{
+	return ( ( unsigned long ) pucField[ 0 ] << 24 ) | ( ( unsigned long ) pucField[ 1 ] << 16 ) | ( ( unsigned long ) pucField[ 2 ] << 8 ) | pucField[ 3 ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvWrite16( unsigned char *pucField, unsigned short usValue )
+{
+	pucField[ 0 ] = ( unsigned char ) ( usValue >> 8 );
+	pucField[ 1 ] = ( unsigned char ) usValue;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWrite32( unsigned char *pucField, unsigned long ulValue )
+{
+	pucField[ 0 ] = ( unsigned char ) ( ulValue >> 24 );
+	pucField[ 1 ] = ( unsigned char ) ( ulValue >> 16 );
+	pucField[ 2 ] = ( unsigned char ) ( ulValue >> 8 );
+	pucField[ 3 ] = ( unsigned char ) ulValue;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadTimestamp( const unsigned char *pucField, xPTPTime *pxTime )
+{
+	/* The seconds field is 48 bits, of which only the lower 32 are used. */
+	pxTime->ulSeconds = prvRead32( &pucField[ 2 ] );
+	pxTime->ulNanoseconds = prvRead32( &pucField[ 6 ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteTimestamp( unsigned char *pucField, const xPTPTime *pxTime )
+{
+	prvWrite16( &pucField[ 0 ], 0 );
+	prvWrite32( &pucField[ 2 ], pxTime->ulSeconds );
+	prvWrite32( &pucField[ 6 ], pxTime->ulNanoseconds );
+}
+/*-----------------------------------------------------------*/
+
+static long prvReadCorrection( void )
+{
+	/* The correction field holds nanoseconds multiplied by 2^16 in 64 bits.
+	Bits 16 to 47 are the whole nanoseconds, which is enough for any
+	correction a transparent clock will make. */
+	return ( long ) prvRead32( &pucMessage[ ptpOFFSET_CORRECTION + 2 ] );
+}
+/*-----------------------------------------------------------*/
+
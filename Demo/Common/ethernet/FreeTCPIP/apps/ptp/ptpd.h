@@ -0,0 +1,168 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef PTPD_H
+#define PTPD_H
+
+/*
+ * A minimal IEEE 1588-2008 (PTP version 2) ordinary clock for use with uIP.
+ * Messages are carried directly over Ethernet (annex F of the standard) so no
+ * UDP or multicast IP support is needed, and the end to end delay mechanism is
+ * used with two step Sync messages.  The time of the clock itself is kept by
+ * the 1588 timer of the MAC, which timestamps PTP frames as they are sent and
+ * received, so the accuracy does not depend on how quickly the uIP task runs.
+ *
+ * As a slave the clock listens to Announce messages, follows the best master
+ * in the domain, and disciplines the MAC clock to it.  As a master it sends
+ * Announce and Sync messages and answers Delay_Req messages.  The role is
+ * fixed when vPTPInit() is called - the full best master clock algorithm is
+ * not implemented, so a master does not give way to a better one.
+ *
+ * The uIP task must:
+ *  + call vPTPInit() once the MAC has been initialised.
+ *  + pass received frames with the ptpETHTYPE Ethernet type to vPTPInput().
+ *  + call vPTPTimer() every ptpTIMER_PERIOD_MS milliseconds, at a point when
+ *    uip_buf is free.
+ */
+
+/* Time as seconds and nanoseconds.  When synchronised to a master that has a
+time source the seconds count from the PTP epoch, 1st January 1970 TAI. */
+typedef struct xPTP_TIME
+{
+	unsigned long ulSeconds;
+	unsigned long ulNanoseconds;
+} xPTPTime;
+
+/* The Ethernet type used by PTP frames. */
+#define ptpETHTYPE				0x88F7
+
+/* The roles that can be passed to vPTPInit(). */
+#define ptpROLE_SLAVE			0
+#define ptpROLE_MASTER			1
+
+/* How often vPTPTimer() must be called.  It is also the Sync and Delay_Req
+interval. */
+#define ptpTIMER_PERIOD_MS		1000UL
+
+/* The PTP domain the clock takes part in. */
+#ifndef ptpDOMAIN
+	#define ptpDOMAIN			0
+#endif
+
+/* How vPTPInput() and vPTPTimer() send the frame in uip_buf, which is uip_len
+bytes long. */
+#ifndef ptpSEND_FRAME
+	#define ptpSEND_FRAME()		vEMACWrite()
+#endif
+
+/*
+ * Start the PTP service in the role ucRole, which is either ptpROLE_SLAVE or
+ * ptpROLE_MASTER.
+ */
+void vPTPInit( unsigned char ucRole );
+
+/*
+ * Process the PTP frame held in uip_buf.  Any reply is sent from within the
+ * function, and uip_len is zero on return.
+ */
+void vPTPInput( void );
+
+/*
+ * Send the periodic PTP messages and time out a master that has gone silent.
+ */
+void vPTPTimer( void );
+
+/*
+ * Return the current time of the synchronised clock.  Can be called from any
+ * task, so samples taken on different nodes can be correlated.
+ */
+void vPTPGetSyncedTime( xPTPTime *pxTime );
+
+/*
+ * Returns pdTRUE if the clock is a master, or is a slave that is tracking a
+ * master to within ptpLOCKED_THRESHOLD_NS, otherwise pdFALSE.
+ */
+portBASE_TYPE xPTPIsSynchronised( void );
+
+/*
+ * Returns the offset from the master, in nanoseconds, measured from the last
+ * Sync message.  A positive value means the local clock is ahead.
+ */
+long lPTPGetOffsetFromMaster( void );
+
+/*
+ * The functions below are implemented by the MAC driver.
+ */
+
+/* Read the time of the MAC clock. */
+void vEMACPTPGetTime( xPTPTime *pxTime );
+
+/* Step the MAC clock by lSeconds and lNanoseconds, either of which might be
+negative. */
+void vEMACPTPStepTime( long lSeconds, long lNanoseconds );
+
+/* Make the MAC clock run lPartsPerBillion faster (or slower, if negative) than
+its nominal rate. */
+void vEMACPTPAdjustFrequency( long lPartsPerBillion );
+
+/* Return the time at which the frame most recently returned by the Rx function
+of the driver was received. */
+void vEMACPTPGetRxTime( xPTPTime *pxTime );
+
+/* Wait for the frame most recently passed to the driver to be sent, then
+return the time at which it was sent.  Returns pdFAIL if the frame was not sent
+within a reasonable time. */
+portBASE_TYPE xEMACPTPGetTxTime( xPTPTime *pxTime );
+
+#endif /* PTPD_H */
@@ -116,11 +116,19 @@ struct psock {
   u16_t sendlen;         /* The number of bytes left to be sent. */
   u16_t readlen;         /* The number of bytes left to be read. */
 
+  char *dataptr;         /* The data read last, in the input buffer
+			    or in uip_appdata. */
+  u16_t datalen;         /* The length of the data read last. */
+  u16_t headlen;         /* The static data sent with a generated
+			    head. */
+
   struct psock_buf buf;  /* The structure holding the state of the
 			    input buffer. */
   unsigned int bufsize;  /* The size of the input buffer. */
   
   unsigned char state;   /* The state of the protosocket. */
+  unsigned char sendstatic; /* Non-zero while sending data that stays
+			       in place until acknowledged. */
 };
 
 void psock_init(struct psock *psock, char *buffer, unsigned int buffersize);
@@ -178,6 +186,30 @@ PT_THREAD(psock_send(struct psock *psock, const char *buf, unsigned int len));
 #define PSOCK_SEND(psock, data, datalen)		\
     PT_WAIT_THREAD(&((psock)->pt), psock_send(psock, data, datalen))
 
+PT_THREAD(psock_send_static(struct psock *psock, const char *buf,
+			    unsigned int len));
+/**
+ * Send data that stays in place until it has been acknowledged.
+ *
+ * This macro works like PSOCK_SEND(), but the data must not change
+ * or move until the remote end has acknowledged it, as is the case
+ * for constant data held in flash.  uIP can then retransmit the data
+ * from where it is instead of keeping its own copy (see
+ * uip_send_static()).
+ *
+ * \param psock (struct psock *) A pointer to the protosocket over which
+ * data is to be sent.
+ *
+ * \param data (char *) A pointer to the data that is to be sent.
+ *
+ * \param datalen (unsigned int) The length of the data that is to be
+ * sent.
+ *
+ * \hideinitializer
+ */
+#define PSOCK_SEND_STATIC(psock, data, datalen)		\
+    PT_WAIT_THREAD(&((psock)->pt), psock_send_static(psock, data, datalen))
+
 /**
  * \brief      Send a null-terminated string.
  * \param psock Pointer to the protosocket.
@@ -220,6 +252,34 @@ PT_THREAD(psock_generator_send(struct psock *psock,
     PT_WAIT_THREAD(&((psock)->pt),					\
 		   psock_generator_send(psock, generator, arg))
 
+PT_THREAD(psock_generator_send_static(struct psock *psock,
+				      unsigned short (*f)(void *), void *arg,
+				      const char *buf, unsigned int len));
+
+/**
+ * \brief      Send a generated head followed by static data
+ * \param psock Pointer to the protosocket.
+ * \param generator Pointer to the generator function
+ * \param arg   Argument to the generator function
+ * \param data  The data to send after the head.
+ * \param datalen The length of the data, at most 0xffff bytes.
+ *
+ *             This works like PSOCK_GENERATOR_SEND() followed by
+ *             PSOCK_SEND_STATIC(), except that the space left in the
+ *             segment after the generated head is filled from the
+ *             start of the data.  A response header and a short
+ *             page then go in one segment instead of two, and a
+ *             longer page is sent in full segments.  The generator
+ *             must produce the same head each time it is called, as
+ *             it is also called for retransmissions.
+ *
+ * \hideinitializer
+ */
+#define PSOCK_GENERATOR_SEND_STATIC(psock, generator, arg, data, datalen) \
+    PT_WAIT_THREAD(&((psock)->pt),					\
+		   psock_generator_send_static(psock, generator, arg,	\
+					       data, datalen))
+
 
 /**
  * Close a protosocket.
@@ -268,11 +328,33 @@ PT_THREAD(psock_readto(struct psock *psock, unsigned char c));
 #define PSOCK_READTO(psock, c)				\
   PT_WAIT_THREAD(&((psock)->pt), psock_readto(psock, c))
 
+PT_THREAD(psock_readto_ref(struct psock *psock, unsigned char c));
+/**
+ * Read data up to a specified character, without copying it if
+ * possible.
+ *
+ * This macro works like PSOCK_READTO(), but when the data up to and
+ * including the character is all in the segment being read it is
+ * left where it is in uip_appdata instead of being copied into the
+ * input buffer.  The data must be found with PSOCK_DATAPTR(), and is
+ * only valid until the protothread next blocks.  It can be changed in
+ * place, for example to terminate it.
+ *
+ * \param psock (struct psock *) A pointer to the protosocket from which
+ * data should be read.
+ *
+ * \param c (char) The character at which to stop reading.
+ *
+ * \hideinitializer
+ */
+#define PSOCK_READTO_REF(psock, c)				\
+  PT_WAIT_THREAD(&((psock)->pt), psock_readto_ref(psock, c))
+
 /**
  * The length of the data that was previously read.
  *
  * This macro returns the length of the data that was previously read
- * using PSOCK_READTO() or PSOCK_READ().
+ * using PSOCK_READTO(), PSOCK_READTO_REF() or PSOCK_READBUF().
  *
  * \param psock (struct psock *) A pointer to the protosocket holding the data.
  *
@@ -280,6 +362,19 @@ PT_THREAD(psock_readto(struct psock *psock, unsigned char c));
  */
 #define PSOCK_DATALEN(psock) psock_datalen(psock)
 
+/**
+ * The data that was previously read.
+ *
+ * This macro returns a (char *) pointer to the data that was
+ * previously read, which is in the input buffer unless it was read
+ * with PSOCK_READTO_REF().
+ *
+ * \param psock (struct psock *) A pointer to the protosocket holding the data.
+ *
+ * \hideinitializer
+ */
+#define PSOCK_DATAPTR(psock) ((psock)->dataptr)
+
 u16_t psock_datalen(struct psock *psock);
 
 /**
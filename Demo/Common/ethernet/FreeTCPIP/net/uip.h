@@ -414,6 +414,29 @@ void	uip_setipid( u16_t id );
 		uip_conn = conn;				 \
 		uip_process( UIP_POLL_REQUEST ); \
 	} while( 0 )
+
+#if UIP_TCP_TX_WINDOW > 1
+
+/**
+ * Let connections with data in flight send further segments.
+ *
+ * When UIP_TCP_TX_WINDOW is greater than 1 each call to uip_input()
+ * or uip_periodic() still produces at most one segment.  This
+ * function polls the connections that have data in flight and room
+ * left in their transmit window, and returns as soon as one of them
+ * has produced a segment.  It should be called repeatedly after
+ * uip_input() and uip_periodic() until uip_len is 0:
+ \code
+ uip_txq_poll();
+ while(uip_len > 0) {
+   uip_arp_out();
+   devicedriver_send();
+   uip_txq_poll();
+ }
+ \endcode
+ */
+void uip_txq_poll( void );
+#endif /* UIP_TCP_TX_WINDOW > 1 */
 #endif /* UIP_TCP */
 
 #ifdef UIP_UDP
@@ -629,6 +652,27 @@ struct uip_conn				*uip_connect( uip_ipaddr_t *ripaddr, u16_t port );
  */
 CCIF void	uip_send( const void *data, int len );
 
+/**
+ * Send data that stays in place until it has been acknowledged.
+ *
+ * This works like uip_send(), but tells uIP that the data will not
+ * change or move until the remote end has acknowledged it, as is the
+ * case for constant data held in flash.  When several segments can be
+ * in flight (UIP_TCP_TX_WINDOW > 1) uIP then retransmits the segment
+ * from the data itself instead of keeping a copy of it.
+ *
+ * \param data A pointer to the data which is to be sent.
+ *
+ * \param len The maximum amount of data bytes to be sent.
+ *
+ * \hideinitializer
+ */
+#if UIP_TCP_TX_WINDOW > 1
+	void	uip_send_static( const void *data, int len );
+#else
+	#define uip_send_static( data, len )	uip_send( data, len )
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 /**
  * The length of any incoming data that is currently available (if available)
  * in the uip_appdata buffer.
@@ -827,9 +871,17 @@ CCIF void	uip_send( const void *data, int len );
  * the connection (which also is available by calling
  * uip_initialmss()).
  *
+ * When UIP_TCP_TX_WINDOW is greater than 1 this is the amount of data
+ * that can be queued behind the segments already in flight, and is 0
+ * while the transmit window is full.
+ *
  * \hideinitializer
  */
-#define uip_mss()	( uip_conn->mss )
+#if UIP_TCP_TX_WINDOW > 1
+	#define uip_mss()	uip_txq_room( uip_conn )
+#else
+	#define uip_mss()	( uip_conn->mss )
+#endif
 	/**
  * Set up a new UDP connection.
  *
@@ -1315,6 +1367,16 @@ extern u8_t			uip_ext_len;
 extern u16_t		uip_urglen, uip_surglen;
 #endif /* UIP_URGDATA > 0 */
 
+#if UIP_TCP_TX_WINDOW > 1
+/**
+ * \internal
+ *
+ * The length of the data the application has sent from the current
+ * callback, which psock uses to send at most one segment per callback.
+ */
+extern u16_t		uip_slen;
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 /**
  * Representation of a uIP TCP connection.
  *
@@ -1351,6 +1413,14 @@ struct uip_conn
 	u8_t				timer;			/**< The retransmission timer. */
 	u8_t				nrtx;			/**< The number of retransmissions for the last
 			 segment sent. */
+#if UIP_TCP_TX_WINDOW > 1
+	u16_t				snd_wnd;		/**< The window last advertised by the peer. */
+	u8_t				txq_num;		/**< The number of segments in flight. */
+	u8_t				txq_fin;		/**< Set when the application has closed the
+			 connection with data still in flight. */
+	u8_t				txq_seg[UIP_TCP_TX_WINDOW];	/**< The transmit buffers holding
+			 the segments in flight, oldest first. */
+#endif /* UIP_TCP_TX_WINDOW > 1 */
 
 	/** The application state. */
 	uip_tcp_appstate_t	appstate;
@@ -1369,6 +1439,17 @@ CCIF extern struct uip_conn *uip_conn;
 CCIF extern struct uip_conn uip_conns[UIP_CONNS];
 #endif
 
+#if UIP_TCP_TX_WINDOW > 1
+/**
+ * \internal
+ *
+ * The number of bytes that can be queued on a connection right now,
+ * limited by the MSS, the peer's window, the UIP_TCP_TX_WINDOW
+ * segment limit and the free transmit buffers.
+ */
+u16_t uip_txq_room( struct uip_conn *conn );
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 /**
  * \addtogroup uiparch
  * @{
@@ -2177,6 +2258,7 @@ originating from the Ethernet interface or from a timer. */
 #define uipARP_TIMER_EVENT			0x04UL
 #define uipPERIODIC_TIMER_EVENT		0x08UL
 #define uipAPPLICATION_SEND_EVENT	0x10UL
+#define uipPTP_TIMER_EVENT			0x20UL
 
 
 #endif /* __UIP_H__ */
@@ -0,0 +1,140 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/**
+ * \addtogroup uip
+ * @{
+ */
+
+/**
+ * \defgroup uipbufpool uIP frame buffer pool
+ * @{
+ *
+ * With UIP_CONF_EXTERNAL_BUFFER defined the driver owns uip_buf, and a
+ * MAC that uses DMA descriptors can pass whole frame buffers to and
+ * from uIP by pointer instead of copying frames in and out of a single
+ * buffer.  This module keeps track of which of the driver's buffers
+ * are free.
+ *
+ * When a frame has been received into the buffer of an Rx descriptor
+ * the driver calls uip_bufpool_rx() to make that buffer uip_buf, and
+ * gives the descriptor the free buffer returned in exchange.  To send
+ * the frame uIP has built the driver calls uip_bufpool_tx(), which
+ * returns the buffer to hand to the Tx descriptor and gives uIP a
+ * fresh one, and frees the Tx buffer with uip_bufpool_free() when the
+ * MAC has finished with it.  The MAC can therefore be receiving into
+ * some buffers and transmitting from others while uIP works on a
+ * third.
+ */
+
+#ifndef __UIP_BUFPOOL_H__
+#define __UIP_BUFPOOL_H__
+
+#include "net/uip.h"
+
+/**
+ * Hand the pool the driver's frame buffers.
+ *
+ * \param buffers The first of num buffers of size bytes each, laid out
+ * one after the other.  num must not be more than UIP_BUFPOOL_BUFFERS.
+ */
+void	uip_bufpool_init( u8_t *buffers, u8_t num, u16_t size );
+
+/**
+ * Take a free buffer from the pool.
+ *
+ * \return The buffer, or NULL if none became free within
+ * UIP_BUFPOOL_ATTEMPTS attempts.
+ */
+u8_t	*uip_bufpool_alloc( void );
+
+/**
+ * Return a buffer to the pool.
+ *
+ * Pointers that are not one of the pool's buffers, including NULL, are
+ * ignored.  This function may be called from an interrupt.
+ */
+void	uip_bufpool_free( u8_t *buf );
+
+/**
+ * Make a received frame the one uIP works on.
+ *
+ * The buffer previously used as uip_buf is returned to the pool and
+ * uip_buf is set to frame.
+ *
+ * \return A free buffer to re-arm the Rx descriptor with, or NULL.
+ */
+u8_t	*uip_bufpool_rx( u8_t *frame );
+
+/**
+ * Take the frame uIP has built so that it can be transmitted.
+ *
+ * uip_buf is given a free buffer from the pool.  The returned buffer
+ * belongs to the driver until it frees it with uip_bufpool_free().
+ *
+ * \return The buffer containing the uip_len bytes to send.
+ */
+u8_t	*uip_bufpool_tx( void );
+
+#if UIP_BUFPOOL_ATTEMPTS > 1
+/**
+ * Wait for a while before uip_bufpool_alloc() looks for a free buffer
+ * again.  This function must be implemented by the driver.
+ */
+void	uip_bufpool_wait( void );
+#endif /* UIP_BUFPOOL_ATTEMPTS > 1 */
+
+#endif /* __UIP_BUFPOOL_H__ */
+
+/** @} */
+/** @} */
@@ -178,6 +178,25 @@
 #define UIP_REASSEMBLY	0
 #endif /* UIP_CONF_REASSEMBLY */
 
+/**
+ * Turn on if the network interface computes and checks the IPv4,
+ * TCP, UDP and ICMP checksums in hardware.
+ *
+ * The checksum fields of outgoing packets are then left at zero for
+ * the interface to fill in, and incoming packets are not checked in
+ * software, so the interface must drop any frame with a bad checksum.
+ * Such interfaces cannot check the TCP or UDP checksum of a packet
+ * that arrives in fragments, so this should not be used together with
+ * UIP_REASSEMBLY.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CHECKSUM_OFFLOAD
+#define UIP_CHECKSUM_OFFLOAD	UIP_CONF_CHECKSUM_OFFLOAD
+#else /* UIP_CONF_CHECKSUM_OFFLOAD */
+#define UIP_CHECKSUM_OFFLOAD	0
+#endif /* UIP_CONF_CHECKSUM_OFFLOAD */
+
 /** @} */
 
 /*------------------------------------------------------------------------------*/
@@ -414,6 +433,50 @@
 #define UIP_RECEIVE_WINDOW	UIP_CONF_RECEIVE_WINDOW
 #endif
 
+/**
+ * The number of segments a connection may have in flight at once.
+ *
+ * With the default of 1 uIP sends a segment and then waits for it to
+ * be acknowledged before the application is allowed to send the
+ * next, and retransmissions are regenerated by the application when
+ * it is called with the UIP_REXMIT flag.
+ *
+ * Setting this to a larger value makes uIP keep a copy of every
+ * unacknowledged segment so that up to this many segments (limited
+ * further by the window advertised by the peer) can be in flight on
+ * one connection.  uIP then retransmits the oldest unacknowledged
+ * segment itself, so applications running in this mode are never
+ * called with the UIP_REXMIT flag, and uip_mss() returns the number of
+ * bytes that can be queued right now (which may be 0).  A uip_close()
+ * issued with data still in flight sends the FIN once that data has
+ * been acknowledged.  Applications that use protosockets work
+ * unchanged.  The driver should call
+ * uip_txq_poll() after uip_input() and uip_periodic() to let
+ * connections fill their windows.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_TCP_TX_WINDOW
+#define UIP_TCP_TX_WINDOW UIP_CONF_TCP_TX_WINDOW
+#else
+#define UIP_TCP_TX_WINDOW 1
+#endif
+
+/**
+ * The number of UIP_TCP_MSS sized buffers used to hold unacknowledged
+ * segments when UIP_TCP_TX_WINDOW is greater than 1.
+ *
+ * The buffers are shared by all connections, so the RAM used is
+ * UIP_TCP_TX_BUFFERS * UIP_TCP_MSS bytes however large UIP_CONNS is.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_TCP_TX_BUFFERS
+#define UIP_TCP_TX_BUFFERS UIP_CONF_TCP_TX_BUFFERS
+#else
+#define UIP_TCP_TX_BUFFERS ( 2 * UIP_TCP_TX_WINDOW )
+#endif
+
 /**
  * How long a connection should stay in the TIME_WAIT state.
  *
@@ -445,6 +508,23 @@
 #define UIP_ARPTAB_SIZE 8
 #endif
 
+/**
+ * The number of hash chains used to find an IP address in the ARP
+ * table.
+ *
+ * Must be 0 or a power of 2.  With 0 a lookup that misses the most
+ * recently used entry searches the whole table, which is fine for
+ * small tables.  Around half of UIP_ARPTAB_SIZE keeps the cost of a
+ * lookup flat as the table grows.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_ARP_HASH_SIZE
+#define UIP_ARP_HASH_SIZE UIP_CONF_ARP_HASH_SIZE
+#else
+#define UIP_ARP_HASH_SIZE 0
+#endif
+
 /**
  * The maximum age of ARP table entries measured in 10ths of seconds.
  *
@@ -527,6 +607,36 @@
 #define UIP_BUFSIZE UIP_CONF_BUFFER_SIZE
 #endif /* UIP_CONF_BUFFER_SIZE */
 
+/**
+ * The maximum number of frame buffers the uip_bufpool module manages.
+ *
+ * Only used by drivers that exchange their DMA buffers with uIP
+ * through the functions in net/uip_bufpool.h, which requires
+ * UIP_CONF_EXTERNAL_BUFFER.
+ *
+ * \hideinitializer
+ */
+#ifndef UIP_CONF_BUFPOOL_BUFFERS
+#define UIP_BUFPOOL_BUFFERS	8
+#else /* UIP_CONF_BUFPOOL_BUFFERS */
+#define UIP_BUFPOOL_BUFFERS	UIP_CONF_BUFPOOL_BUFFERS
+#endif /* UIP_CONF_BUFPOOL_BUFFERS */
+
+/**
+ * The number of times uip_bufpool_alloc() looks for a free buffer
+ * before giving up.
+ *
+ * If this is larger than 1 the driver must implement
+ * uip_bufpool_wait(), which is called between the attempts.
+ *
+ * \hideinitializer
+ */
+#ifndef UIP_CONF_BUFPOOL_ATTEMPTS
+#define UIP_BUFPOOL_ATTEMPTS	1
+#else /* UIP_CONF_BUFPOOL_ATTEMPTS */
+#define UIP_BUFPOOL_ATTEMPTS	UIP_CONF_BUFPOOL_ATTEMPTS
+#endif /* UIP_CONF_BUFPOOL_ATTEMPTS */
+
 /**
  * Determines if statistics support should be compiled in.
  *
@@ -83,67 +83,80 @@ static u8_t
 buf_bufdata(struct psock_buf *buf, u16_t len,
 	    u8_t **dataptr, u16_t *datalen)
 {
+  u16_t copy;
+
   ( void ) len;
-  if(*datalen < buf->left) {
-    memcpy(buf->ptr, *dataptr, *datalen);
-    buf->ptr += *datalen;
-    buf->left -= *datalen;
-    *dataptr += *datalen;
-    *datalen = 0;
-    return BUF_NOT_FULL;
-  } else if(*datalen == buf->left) {
-    memcpy(buf->ptr, *dataptr, *datalen);
-    buf->ptr += *datalen;
-    buf->left = 0;
-    *dataptr += *datalen;
-    *datalen = 0;
-    return BUF_FULL;
-  } else {
-    memcpy(buf->ptr, *dataptr, buf->left);
-    buf->ptr += buf->left;
-    *datalen -= buf->left;
-    *dataptr += buf->left;
-    buf->left = 0;
-    return BUF_FULL;
-  }
+  copy = (*datalen < buf->left) ? *datalen : buf->left;
+  memcpy(buf->ptr, *dataptr, copy);
+  buf->ptr += copy;
+  buf->left -= copy;
+  *dataptr += copy;
+  *datalen -= copy;
+  return (buf->left == 0) ? BUF_FULL : BUF_NOT_FULL;
 }
 /*---------------------------------------------------------------------------*/
 static u8_t
 buf_bufto(register struct psock_buf *buf, u8_t endmarker,
 	  register u8_t **dataptr, register u16_t *datalen)
 {
-  u8_t c;
-  while(buf->left > 0 && *datalen > 0) {
-    c = *buf->ptr = **dataptr;
-    ++*dataptr;
-    ++buf->ptr;
-    --*datalen;
-    --buf->left;
-
-    if(c == endmarker) {
-      return BUF_FOUND;
-    }
-  }
+  u8_t *end;
+  u16_t len, copy;
 
-  if(*datalen == 0) {
-    return BUF_NOT_FOUND;
-  }
+  /* Look for the end-marker in the whole segment at once, then copy
+     as much of the data up to it as fits in the buffer.  The rest is
+     thrown away, as it would not fit. */
+  end = (u8_t *)memchr(*dataptr, endmarker, *datalen);
+  len = (end != NULL) ? (u16_t)(end - *dataptr) + 1 : *datalen;
+  copy = (len < buf->left) ? len : buf->left;
 
-  while(*datalen > 0) {
-    c = **dataptr;
-    --*datalen;
-    ++*dataptr;
+  memcpy(buf->ptr, *dataptr, copy);
+  buf->ptr += copy;
+  buf->left -= copy;
+  *dataptr += len;
+  *datalen -= len;
 
-    if(c == endmarker) {
-      return BUF_FOUND | BUF_FULL;
-    }
+  if(end != NULL) {
+    return (copy < len) ? (BUF_FOUND | BUF_FULL) : BUF_FOUND;
   }
-
-  return BUF_FULL;
+  return (copy < len) ? BUF_FULL : BUF_NOT_FOUND;
 }
 /*---------------------------------------------------------------------------*/
+#if UIP_TCP_TX_WINDOW > 1
+/*
+ * With a transmit window uIP retransmits everything in flight
+ * itself, so data is queued as soon as there is room for it instead
+ * of once the previous segment has been acknowledged.
+ */
+static char
+queue_data(register struct psock *s)
+{
+  u16_t len = uip_mss();
+
+  /* Only one segment can be sent from each callback. */
+  if(uip_slen > 0 || len == 0) {
+    return 0;
+  }
+  if(len > s->sendlen) {
+    len = s->sendlen;
+  }
+  if(s->sendstatic) {
+    uip_send_static(s->sendptr, len);
+  } else {
+    uip_send(s->sendptr, len);
+  }
+  s->sendptr += len;
+  s->sendlen -= len;
+  return 1;
+}
+#else /* UIP_TCP_TX_WINDOW > 1 */
+/*
+ * Send the next segment, or resend the last one, and return 1 once
+ * it has been acknowledged.  Sending and acknowledging are handled in
+ * one function so that the acknowledgement that lets the next segment
+ * out cannot also be taken as acknowledging that segment.
+ */
 static char
-send_data(register struct psock *s)
+data_is_sent_and_acked(register struct psock *s)
 {
   if(s->state != STATE_DATA_SENT || uip_rexmit()) {
     if(s->sendlen > uip_mss()) {
@@ -152,15 +165,8 @@ send_data(register struct psock *s)
       uip_send(s->sendptr, s->sendlen);
     }
     s->state = STATE_DATA_SENT;
-    return 1;
-  }
-  return 0;
-}
-/*---------------------------------------------------------------------------*/
-static char
-data_acked(register struct psock *s)
-{
-  if(s->state == STATE_DATA_SENT && uip_acked()) {
+    return 0;
+  } else if(uip_acked()) {
     if(s->sendlen > uip_mss()) {
       s->sendlen -= uip_mss();
       s->sendptr += uip_mss();
@@ -173,6 +179,7 @@ data_acked(register struct psock *s)
   }
   return 0;
 }
+#endif /* UIP_TCP_TX_WINDOW > 1 */
 /*---------------------------------------------------------------------------*/
 PT_THREAD(psock_send(register struct psock *s, const char *buf,
 		     unsigned int len))
@@ -191,28 +198,36 @@ PT_THREAD(psock_send(register struct psock *s, const char *buf,
 
   s->state = STATE_NONE;
 
-  /* We loop here until all data is sent. The s->sendlen variable is
-     updated by the data_sent() function. */
+#if UIP_TCP_TX_WINDOW > 1
+  /* We loop here until all data has been queued. It does not have to
+     be acknowledged before we return as uIP retransmits it itself. */
   while(s->sendlen > 0) {
-
-    /*
-     * The condition for this PT_WAIT_UNTIL is a little tricky: the
-     * protothread will wait here until all data has been acknowledged
-     * (data_acked() returns true) and until all data has been sent
-     * (send_data() returns true). The two functions data_acked() and
-     * send_data() must be called in succession to ensure that all
-     * data is sent. Therefore the & operator is used instead of the
-     * && operator, which would cause only the data_acked() function
-     * to be called when it returns false.
-     */
-    PT_WAIT_UNTIL(&s->psockpt, data_acked(s) & send_data(s));
+    PT_WAIT_UNTIL(&s->psockpt, queue_data(s));
   }
+#else /* UIP_TCP_TX_WINDOW > 1 */
+  /* We loop here until all data is sent and acknowledged. The
+     s->sendlen variable is updated by data_is_sent_and_acked(). */
+  while(s->sendlen > 0) {
+    PT_WAIT_UNTIL(&s->psockpt, data_is_sent_and_acked(s));
+  }
+#endif /* UIP_TCP_TX_WINDOW > 1 */
 
   s->state = STATE_NONE;
 
   PT_END(&s->psockpt);
 }
 /*---------------------------------------------------------------------------*/
+PT_THREAD(psock_send_static(register struct psock *s, const char *buf,
+			    unsigned int len))
+{
+  char ret;
+
+  s->sendstatic = 1;
+  ret = psock_send(s, buf, len);
+  s->sendstatic = 0;
+  return ret;
+}
+/*---------------------------------------------------------------------------*/
 PT_THREAD(psock_generator_send(register struct psock *s,
 			       unsigned short (*generate)(void *), void *arg))
 {
@@ -223,11 +238,33 @@ PT_THREAD(psock_generator_send(register struct psock *s,
     PT_EXIT(&s->psockpt);
   }
 
+#if UIP_TCP_TX_WINDOW > 1
+  /* uip_mss() is the room left in the transmit window. The output of
+     the generator is only valid in this callback, so wait until it
+     can all be queued at once: until there is room for a full
+     segment, or nothing is in flight and the room is all the peer
+     allows. */
+  PT_WAIT_UNTIL(&s->psockpt, uip_slen == 0 && uip_mss() > 0 &&
+		(uip_mss() >= uip_conn->mss || uip_conn->txq_num == 0));
+  s->sendlen = generate(arg);
+  s->sendptr = uip_appdata;
+
+  s->state = STATE_NONE;
+  while(s->sendlen > 0) {
+    PT_WAIT_UNTIL(&s->psockpt, queue_data(s));
+  }
+#else /* UIP_TCP_TX_WINDOW > 1 */
   /* Call the generator function to generate the data in the
      uip_appdata buffer. */
   s->sendlen = generate(arg);
   s->sendptr = uip_appdata;
 
+  /* As for psock_send(), there is nothing to wait for if the generator
+     had nothing to say. */
+  if(s->sendlen == 0) {
+    PT_EXIT(&s->psockpt);
+  }
+
   s->state = STATE_NONE;
   do {
     /* Call the generator function again if we are called to perform a
@@ -236,18 +273,120 @@ PT_THREAD(psock_generator_send(register struct psock *s,
       generate(arg);
     }
     /* Wait until all data is sent and acknowledged. */
-    PT_WAIT_UNTIL(&s->psockpt, data_acked(s) & send_data(s));
+    PT_WAIT_UNTIL(&s->psockpt, data_is_sent_and_acked(s));
   } while(s->sendlen > 0);
+#endif /* UIP_TCP_TX_WINDOW > 1 */
 
   s->state = STATE_NONE;
 
   PT_END(&s->psockpt);
 }
 /*---------------------------------------------------------------------------*/
+/*
+ * Generate the head of the first segment, then fill the rest of the
+ * segment from the start of the static data.  The amount of static
+ * data is only decided the first time, as uip_mss() can be smaller
+ * when the segment has to be retransmitted.
+ */
+static u16_t
+build_head(register struct psock *s, unsigned short (*generate)(void *),
+	   void *arg, const char *buf, unsigned int len, char first)
+{
+  u16_t headlen;
+
+  headlen = generate(arg);
+  if(first) {
+    s->headlen = 0;
+    if(uip_mss() > headlen) {
+      s->headlen = uip_mss() - headlen;
+      if(s->headlen > len) {
+	s->headlen = (u16_t)len;
+      }
+    }
+  }
+  memcpy((char *)uip_appdata + headlen, buf, s->headlen);
+  return headlen + s->headlen;
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_TCP_TX_WINDOW <= 1
+static char
+head_is_sent_and_acked(register struct psock *s,
+		       unsigned short (*generate)(void *), void *arg,
+		       const char *buf, unsigned int len)
+{
+  /* The head is generated again for a retransmission, or to send
+     what is left of it if uip_mss() has shrunk, as uip_appdata has
+     been used for other segments since. */
+  if(s->state == STATE_NONE) {
+    s->sendlen = build_head(s, generate, arg, buf, len, 1);
+    s->sendptr = uip_appdata;
+    if(s->sendlen == 0) {
+      return 1;
+    }
+  } else if(s->state == STATE_ACKED || uip_rexmit()) {
+    build_head(s, generate, arg, buf, len, 0);
+  }
+  return data_is_sent_and_acked(s);
+}
+#endif /* UIP_TCP_TX_WINDOW <= 1 */
+/*---------------------------------------------------------------------------*/
+PT_THREAD(psock_generator_send_static(register struct psock *s,
+				      unsigned short (*generate)(void *),
+				      void *arg, const char *buf,
+				      unsigned int len))
+{
+  PT_BEGIN(&s->psockpt);
+  ( void ) PT_YIELD_FLAG;
+  if(generate == NULL) {
+    PT_EXIT(&s->psockpt);
+  }
+
+#if UIP_TCP_TX_WINDOW > 1
+  /* As for psock_generator_send(), the head has to be queued in the
+     callback it is generated in. */
+  PT_WAIT_UNTIL(&s->psockpt, uip_slen == 0 && uip_mss() > 0 &&
+		(uip_mss() >= uip_conn->mss || uip_conn->txq_num == 0));
+  s->sendlen = build_head(s, generate, arg, buf, len, 1);
+  s->sendptr = uip_appdata;
+
+  s->state = STATE_NONE;
+  while(s->sendlen > 0) {
+    PT_WAIT_UNTIL(&s->psockpt, queue_data(s));
+  }
+#else /* UIP_TCP_TX_WINDOW > 1 */
+  s->state = STATE_NONE;
+  do {
+    PT_WAIT_UNTIL(&s->psockpt,
+		  head_is_sent_and_acked(s, generate, arg, buf, len));
+  } while(s->sendlen > 0);
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
+  /* The rest of the static data follows in full segments. */
+  s->sendptr = (const u8_t *)buf + s->headlen;
+  s->sendlen = (u16_t)(len - s->headlen);
+  s->sendstatic = 1;
+
+  s->state = STATE_NONE;
+#if UIP_TCP_TX_WINDOW > 1
+  while(s->sendlen > 0) {
+    PT_WAIT_UNTIL(&s->psockpt, queue_data(s));
+  }
+#else /* UIP_TCP_TX_WINDOW > 1 */
+  while(s->sendlen > 0) {
+    PT_WAIT_UNTIL(&s->psockpt, data_is_sent_and_acked(s));
+  }
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
+  s->sendstatic = 0;
+  s->state = STATE_NONE;
+
+  PT_END(&s->psockpt);
+}
+/*---------------------------------------------------------------------------*/
 u16_t
 psock_datalen(struct psock *psock)
 {
-  return psock->bufsize - psock->buf.left;
+  return psock->datalen;
 }
 /*---------------------------------------------------------------------------*/
 char
@@ -290,13 +429,60 @@ PT_THREAD(psock_readto(register struct psock *psock, unsigned char c))
 		     &psock->readptr,
 		     &psock->readlen) & BUF_FOUND) == 0);
 
-  if(psock_datalen(psock) == 0) {
+  psock->dataptr = psock->bufptr;
+  psock->datalen = psock->bufsize - psock->buf.left;
+  if(psock->datalen == 0) {
     psock->state = STATE_NONE;
     PT_RESTART(&psock->psockpt);
   }
   PT_END(&psock->psockpt);
 }
 /*---------------------------------------------------------------------------*/
+PT_THREAD(psock_readto_ref(register struct psock *psock, unsigned char c))
+{
+  u8_t *end;
+
+  PT_BEGIN(&psock->psockpt);
+  ( void ) PT_YIELD_FLAG;
+
+  if(psock->readlen == 0) {
+    PT_WAIT_UNTIL(&psock->psockpt, psock_newdata(psock));
+    psock->state = STATE_READ;
+    psock->readptr = (u8_t *)uip_appdata;
+    psock->readlen = uip_datalen();
+  }
+
+  end = (u8_t *)memchr(psock->readptr, c, psock->readlen);
+  if(end != NULL) {
+    /* All of it is in this segment, so it is used where it is.  It is
+       cut to the length of the buffer, as PSOCK_READTO() would. */
+    psock->dataptr = (char *)psock->readptr;
+    psock->datalen = (u16_t)(end - psock->readptr) + 1;
+    psock->readptr += psock->datalen;
+    psock->readlen -= psock->datalen;
+    if(psock->datalen > psock->bufsize) {
+      psock->datalen = (u16_t)psock->bufsize;
+    }
+    PT_EXIT(&psock->psockpt);
+  }
+
+  /* It continues in a later segment, which will overwrite this one,
+     so it has to be copied into the buffer. */
+  buf_setup(&psock->buf, (unsigned char*)psock->bufptr, psock->bufsize);
+  while((buf_bufto(&psock->buf, c,
+		   &psock->readptr,
+		   &psock->readlen) & BUF_FOUND) == 0) {
+    PT_WAIT_UNTIL(&psock->psockpt, psock_newdata(psock));
+    psock->state = STATE_READ;
+    psock->readptr = (u8_t *)uip_appdata;
+    psock->readlen = uip_datalen();
+  }
+
+  psock->dataptr = psock->bufptr;
+  psock->datalen = psock->bufsize - psock->buf.left;
+  PT_END(&psock->psockpt);
+}
+/*---------------------------------------------------------------------------*/
 PT_THREAD(psock_readbuf(register struct psock *psock))
 {
   PT_BEGIN(&psock->psockpt);
@@ -317,7 +503,9 @@ PT_THREAD(psock_readbuf(register struct psock *psock))
 			 &psock->readptr,
 			 &psock->readlen) != BUF_FULL);
 
-  if(psock_datalen(psock) == 0) {
+  psock->dataptr = psock->bufptr;
+  psock->datalen = psock->bufsize - psock->buf.left;
+  if(psock->datalen == 0) {
     psock->state = STATE_NONE;
     PT_RESTART(&psock->psockpt);
   }
@@ -328,9 +516,12 @@ void
 psock_init(register struct psock *psock, char *buffer, unsigned int buffersize)
 {
   psock->state = STATE_NONE;
+  psock->sendstatic = 0;
   psock->readlen = 0;
   psock->bufptr = buffer;
   psock->bufsize = buffersize;
+  psock->dataptr = buffer;
+  psock->datalen = 0;
   buf_setup(&psock->buf, (unsigned char*) buffer, buffersize);
   PT_INIT(&psock->pt);
   PT_INIT(&psock->psockpt);
@@ -173,6 +173,23 @@ u8_t uip_acc32[ 4 ];
 static u8_t	c, opt;
 static u16_t tmp16;
 
+#if UIP_TCP_TX_WINDOW > 1
+	/* Copies of the segments in flight, shared by all connections.  Each
+	buffer records the connection that owns it (index + 1, 0 if free). */
+	static u8_t		uip_txq_buf[ UIP_TCP_TX_BUFFERS ][ UIP_TCP_MSS ];
+	static u16_t	uip_txq_len[ UIP_TCP_TX_BUFFERS ];
+	static u8_t		uip_txq_owner[ UIP_TCP_TX_BUFFERS ];
+
+	/* Segments sent with uip_send_static() are retransmitted from the
+	application's data rather than from a copy in uip_txq_buf. */
+	static const u8_t	*uip_txq_ref[ UIP_TCP_TX_BUFFERS ];
+	static const u8_t	*uip_sref;
+
+	/* The offset of the segment being sent from the oldest unacknowledged
+	byte of its connection. */
+	static u16_t	uip_txq_offset;
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 /* Structures and definitions. */
 #define TCP_FIN								0x01
 #define TCP_SYN								0x02
@@ -261,38 +278,46 @@ static u16_t tmp16;
 
 	static u16_t chksum( u16_t sum, const u8_t *data, u16_t len )
 	{
-		u16_t		t;
+		u32_t		acc;
 		const u8_t	*dataptr;
-		const u8_t	*last_byte;
 
+		/* The 16 bit words are added into a 32 bit accumulator and the
+		carries folded back in at the end, rather than after every word.
+		A packet cannot be long enough to overflow the accumulator. */
+		acc = sum;
 		dataptr = data;
-		last_byte = data + len - 1;
 
-		while( dataptr < last_byte )
+		/* Eight bytes at a time. */
+		while( len >= 8 )
 		{
-			/* At least two more bytes */
-			t = ( dataptr[ 0 ] << 8 ) + dataptr[ 1 ];
-			sum += t;
-			if( sum < t )
-			{
-				sum++;	/* carry */
-			}
+			acc += ( ( u16_t ) dataptr[ 0 ] << 8 ) + dataptr[ 1 ];
+			acc += ( ( u16_t ) dataptr[ 2 ] << 8 ) + dataptr[ 3 ];
+			acc += ( ( u16_t ) dataptr[ 4 ] << 8 ) + dataptr[ 5 ];
+			acc += ( ( u16_t ) dataptr[ 6 ] << 8 ) + dataptr[ 7 ];
+			dataptr += 8;
+			len -= 8;
+		}
 
+		/* Then any remaining whole words. */
+		while( len >= 2 )
+		{
+			acc += ( ( u16_t ) dataptr[ 0 ] << 8 ) + dataptr[ 1 ];
 			dataptr += 2;
+			len -= 2;
 		}
 
-		if( dataptr == last_byte )
+		if( len != 0 )
 		{
-			t = ( dataptr[ 0 ] << 8 ) + 0;
-			sum += t;
-			if( sum < t )
-			{
-				sum++;	/* carry */
-			}
+			acc += ( u16_t ) dataptr[ 0 ] << 8;
 		}
 
+		/* Fold the carries back in.  The second fold picks up any carry out
+		of the first. */
+		acc = ( acc >> 16 ) + ( acc & 0xffffUL );
+		acc = ( acc >> 16 ) + ( acc & 0xffffUL );
+
 		/* Return sum in host byte order. */
-		return sum;
+		return ( u16_t ) acc;
 	}
 	/*---------------------------------------------------------------------------*/
 
@@ -365,6 +390,145 @@ static u16_t tmp16;
 #endif /* UIP_ARCH_CHKSUM */
 /*---------------------------------------------------------------------------*/
 
+#if UIP_TCP_TX_WINDOW > 1
+	/* Release every transmit buffer held by a connection. */
+	static void uip_txq_flush( struct uip_conn *conn )
+	{
+		u8_t	b, owner = ( u8_t ) ( conn - uip_conns ) + 1;
+
+		for( b = 0; b < UIP_TCP_TX_BUFFERS; ++b )
+		{
+			if( uip_txq_owner[ b ] == owner )
+			{
+				uip_txq_owner[ b ] = 0;
+			}
+		}
+
+		conn->txq_num = 0;
+		conn->txq_fin = 0;
+	}
+	/*---------------------------------------------------------------------------*/
+
+	/* Find a free transmit buffer, reclaiming any left behind by a connection
+	that has since been closed or reset.  Returns UIP_TCP_TX_BUFFERS if all
+	the buffers are in use. */
+	static u8_t uip_txq_alloc( void )
+	{
+		u8_t	b;
+
+		for( b = 0; b < UIP_TCP_TX_BUFFERS; ++b )
+		{
+			if( uip_txq_owner[ b ] == 0 || uip_conns[ uip_txq_owner[ b ] - 1 ].tcpstateflags == UIP_CLOSED )
+			{
+				break;
+			}
+		}
+
+		return b;
+	}
+	/*---------------------------------------------------------------------------*/
+
+	/* Check whether the incoming segment acknowledges data in flight.  Queued
+	segments are only acknowledged whole, oldest first; with nothing queued
+	the outstanding byte is a SYN or FIN.  If anything is acknowledged the
+	new snd_nxt is left in uip_acc32, the segments are released and 1 is
+	returned. */
+	static u8_t uip_txq_acked( struct uip_conn *conn )
+	{
+		u8_t	i = 0, n;
+		u16_t	acked = 0;
+
+		do
+		{
+			acked += ( conn->txq_num == 0 ) ? conn->len : uip_txq_len[ conn->txq_seg[ i ] ];
+			uip_add32( conn->snd_nxt, acked );
+
+			if
+			(
+				BUF->ackno[ 0 ] == uip_acc32[ 0 ] &&
+				BUF->ackno[ 1 ] == uip_acc32[ 1 ] &&
+				BUF->ackno[ 2 ] == uip_acc32[ 2 ] &&
+				BUF->ackno[ 3 ] == uip_acc32[ 3 ]
+			)
+			{
+				if( conn->txq_num > 0 )
+				{
+					for( n = 0; n <= i; ++n )
+					{
+						uip_txq_owner[ conn->txq_seg[ n ] ] = 0;
+					}
+
+					conn->txq_num -= i + 1;
+					for( n = 0; n < conn->txq_num; ++n )
+					{
+						conn->txq_seg[ n ] = conn->txq_seg[ n + i + 1 ];
+					}
+				}
+
+				conn->len -= acked;
+				return 1;
+			}
+		} while( ++i < conn->txq_num );
+
+		return 0;
+	}
+	/*---------------------------------------------------------------------------*/
+
+	u16_t uip_txq_room( struct uip_conn *conn )
+	{
+		u16_t	room;
+
+		if( conn->txq_fin || conn->txq_num >= UIP_TCP_TX_WINDOW || uip_txq_alloc() == UIP_TCP_TX_BUFFERS )
+		{
+			room = 0;
+		}
+		else if( conn->len == 0 )
+		{
+			/* Nothing is in flight, so the classic uIP MSS applies - including
+			sending a full segment into a zero window to probe it. */
+			room = conn->mss;
+		}
+		else if( conn->snd_wnd > conn->len )
+		{
+			room = conn->snd_wnd - conn->len;
+			if( room > conn->initialmss )
+			{
+				room = conn->initialmss;
+			}
+		}
+		else
+		{
+			room = 0;
+		}
+
+		return room;
+	}
+	/*---------------------------------------------------------------------------*/
+
+	void uip_txq_poll( void )
+	{
+		u8_t	i;
+
+		uip_len = 0;
+		for( i = 0; i < UIP_CONNS; ++i )
+		{
+			uip_conn = &uip_conns[ i ];
+
+			/* Only connections that are already streaming are polled, the
+			others send their first segment from their own callbacks. */
+			if( (uip_conn->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && uip_conn->txq_num > 0 && uip_txq_room( uip_conn ) > 0 )
+			{
+				uip_process( UIP_POLL_REQUEST );
+				if( uip_len > 0 )
+				{
+					break;
+				}
+			}
+		}
+	}
+	/*---------------------------------------------------------------------------*/
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 void uip_init( void )
 {
 	for( c = 0; c < UIP_LISTENPORTS; ++c )
@@ -454,6 +618,9 @@ void uip_init( void )
 		conn->initialmss = conn->mss = UIP_TCP_MSS;
 
 		conn->len = 1;		/* TCP length of the SYN is one. */
+		#if UIP_TCP_TX_WINDOW > 1
+			uip_txq_flush( conn );
+		#endif /* UIP_TCP_TX_WINDOW > 1 */
 		conn->nrtx = 0;
 		conn->timer = 1;	/* Send the SYN next time around. */
 		conn->rto = UIP_RTO;
@@ -715,8 +882,13 @@ void uip_process( u8_t flag )
 	 particular connection. */
 	if( flag == UIP_POLL_REQUEST )
 	{
-		if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && !uip_outstanding(uip_connr) )
+		#if UIP_TCP_TX_WINDOW > 1
+			if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && (!uip_outstanding(uip_connr) || uip_txq_room(uip_connr) > 0) )
+		#else
+			if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && !uip_outstanding(uip_connr) )
+		#endif
 		{
+			uip_slen = 0;
 			uip_flags = UIP_POLL;
 			UIP_APPCALL();
 			goto appsend;
@@ -820,6 +992,27 @@ void uip_process( u8_t flag )
 						#endif /* UIP_ACTIVE_OPEN */
 
 						case UIP_ESTABLISHED:
+							#if UIP_TCP_TX_WINDOW > 1
+								/* The oldest segment in flight is resent from its
+								transmit buffer without involving the
+								application. */
+								if( uip_connr->txq_num > 0 )
+								{
+									c = uip_connr->txq_seg[ 0 ];
+									uip_slen = uip_txq_len[ c ];
+									if( uip_txq_ref[ c ] != NULL )
+									{
+										memcpy( uip_sappdata, uip_txq_ref[ c ], uip_slen );
+									}
+									else
+									{
+										memcpy( uip_sappdata, uip_txq_buf[ c ], uip_slen );
+									}
+									uip_txq_offset = 0;
+									goto apprexmit;
+								}
+							#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 							/* In the ESTABLISHED state, we call upon the application
 							to do the actual retransmit after which we jump into
 							the code for sending out the packet (the apprexmit
@@ -835,6 +1028,17 @@ void uip_process( u8_t flag )
 							goto tcp_send_finack;
 					}
 				}
+				#if UIP_TCP_TX_WINDOW > 1
+					else if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && uip_txq_room(uip_connr) > 0 )
+					{
+						/* There is still room in the transmit window, so the
+						application may queue more data behind what is in
+						flight. */
+						uip_flags = UIP_POLL;
+						UIP_APPCALL();
+						goto appsend;
+					}
+				#endif /* UIP_TCP_TX_WINDOW > 1 */
 			}
 			else if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED )
 			{
@@ -992,7 +1196,7 @@ void uip_process( u8_t flag )
 		#endif /* UIP_CONF_IPV6 */
 	}
 
-	#if !UIP_CONF_IPV6
+	#if !UIP_CONF_IPV6 && !UIP_CHECKSUM_OFFLOAD
 		if( uip_ipchksum() != 0xffff )
 		{
 			/* Compute and check the IP header checksum. */
@@ -1001,7 +1205,7 @@ void uip_process( u8_t flag )
 			UIP_LOG( "ip: bad checksum." );
 			goto drop;
 		}
-	#endif /* UIP_CONF_IPV6 */
+	#endif /* !UIP_CONF_IPV6 && !UIP_CHECKSUM_OFFLOAD */
 
 	if( BUF->proto == UIP_PROTO_TCP )
 	{
@@ -1056,14 +1260,23 @@ void uip_process( u8_t flag )
 
 		ICMPBUF->type = ICMP_ECHO_REPLY;
 
-		if( ICMPBUF->icmpchksum >= HTONS(0xffff - (ICMP_ECHO << 8)) )
+		#if UIP_CHECKSUM_OFFLOAD
 		{
-			ICMPBUF->icmpchksum += HTONS( ICMP_ECHO << 8 ) + 1;
+			/* The interface calculates the checksum of the reply. */
+			ICMPBUF->icmpchksum = 0;
 		}
-		else
+		#else
 		{
-			ICMPBUF->icmpchksum += HTONS( ICMP_ECHO << 8 );
+			if( ICMPBUF->icmpchksum >= HTONS(0xffff - (ICMP_ECHO << 8)) )
+			{
+				ICMPBUF->icmpchksum += HTONS( ICMP_ECHO << 8 ) + 1;
+			}
+			else
+			{
+				ICMPBUF->icmpchksum += HTONS( ICMP_ECHO << 8 );
+			}
 		}
+		#endif /* UIP_CHECKSUM_OFFLOAD */
 
 		/* Swap IP addresses. */
 		uip_ipaddr_copy( &BUF->destipaddr, &BUF->srcipaddr );
@@ -1160,7 +1373,7 @@ void uip_process( u8_t flag )
 		#if UIP_UDP_CHECKSUMS
 			uip_len = uip_len - UIP_IPUDPH_LEN;
 			uip_appdata = &uip_buf[ UIP_LLH_LEN + UIP_IPUDPH_LEN ];
-			if( UDPBUF->udpchksum != 0 && uip_udpchksum() != 0xffff )
+			if( !UIP_CHECKSUM_OFFLOAD && UDPBUF->udpchksum != 0 && uip_udpchksum() != 0xffff )
 			{
 				UIP_STAT( ++uip_stat.udp.drop );
 				UIP_STAT( ++uip_stat.udp.chkerr );
@@ -1209,9 +1422,11 @@ void uip_process( u8_t flag )
 		ICMPBUF->type = ICMP_DEST_UNREACHABLE;
 		ICMPBUF->icode = ICMP_PORT_UNREACHABLE;
 
-		/* Calculate the ICMP checksum. */
+		/* Calculate the ICMP checksum, unless the interface will. */
 		ICMPBUF->icmpchksum = 0;
-		ICMPBUF->icmpchksum = ~uip_chksum( ( u16_t * ) &(ICMPBUF->type), 36 );
+		#if !UIP_CHECKSUM_OFFLOAD
+			ICMPBUF->icmpchksum = ~uip_chksum( ( u16_t * ) &(ICMPBUF->type), 36 );
+		#endif
 
 		/* Set the IP destination address to be the source address of the
 		 original packet. */
@@ -1271,14 +1486,14 @@ udp_send:
 
 	uip_appdata = &uip_buf[UIP_LLH_LEN + UIP_IPTCPH_LEN];
 
-	#if UIP_UDP_CHECKSUMS
+	#if UIP_UDP_CHECKSUMS && !UIP_CHECKSUM_OFFLOAD
 		/* Calculate UDP checksum. */
 		UDPBUF->udpchksum = ~( uip_udpchksum() );
 		if( UDPBUF->udpchksum == 0 )
 		{
 			UDPBUF->udpchksum = 0xffff;
 		}
-	#endif /* UIP_UDP_CHECKSUMS */
+	#endif /* UIP_UDP_CHECKSUMS && !UIP_CHECKSUM_OFFLOAD */
 		goto ip_send_nolen;
 	#endif /* UIP_UDP */
 
@@ -1286,7 +1501,7 @@ udp_send:
 	tcp_input : UIP_STAT( ++uip_stat.tcp.recv );
 
 	/* Start of TCP input header processing code. */
-	if( uip_tcpchksum() != 0xffff )
+	if( !UIP_CHECKSUM_OFFLOAD && uip_tcpchksum() != 0xffff )
 	{
 		/* Compute and check the TCP checksum. */
 		UIP_STAT( ++uip_stat.tcp.drop );
@@ -1446,6 +1661,9 @@ found_listen:
 	uip_connr->snd_nxt[ 2 ] = iss[ 2 ];
 	uip_connr->snd_nxt[ 3 ] = iss[ 3 ];
 	uip_connr->len = 1;
+	#if UIP_TCP_TX_WINDOW > 1
+		uip_txq_flush( uip_connr );
+	#endif /* UIP_TCP_TX_WINDOW > 1 */
 
 	/* rcv_nxt should be the seqno from the incoming packet + 1. */
 	uip_connr->rcv_nxt[ 3 ] = BUF->seqno[ 3 ];
@@ -1568,6 +1786,12 @@ found:
 	retransmission timer. */
 	if( (BUF->flags & TCP_ACK) && uip_outstanding(uip_connr) )
 	{
+		#if UIP_TCP_TX_WINDOW > 1
+			/* Any number of the segments in flight may be acknowledged at
+			once, in which case uip_txq_acked() also reduces the length of
+			the outstanding data. */
+			if( uip_txq_acked(uip_connr) )
+		#else
 		uip_add32( uip_connr->snd_nxt, uip_connr->len );
 
 		if
@@ -1577,6 +1801,7 @@ found:
 			BUF->ackno[ 2 ] == uip_acc32[ 2 ] &&
 			BUF->ackno[ 3 ] == uip_acc32[ 3 ]
 		)
+		#endif /* UIP_TCP_TX_WINDOW > 1 */
 		{
 			/* Update sequence number. */
 			uip_connr->snd_nxt[ 0 ] = uip_acc32[ 0 ];
@@ -1609,11 +1834,26 @@ found:
 			/* Reset the retransmission timer. */
 			uip_connr->timer = uip_connr->rto;
 
-			/* Reset length of outstanding data. */
-			uip_connr->len = 0;
+			#if UIP_TCP_TX_WINDOW > 1
+				/* The retransmission count belongs to the oldest segment in
+				flight, which has now changed. */
+				uip_connr->nrtx = 0;
+			#else
+				/* Reset length of outstanding data. */
+				uip_connr->len = 0;
+			#endif /* UIP_TCP_TX_WINDOW > 1 */
 		}
 	}
 
+	#if UIP_TCP_TX_WINDOW > 1
+		/* Remember the window advertised by the peer, which limits how much
+		data may be in flight. */
+		if( BUF->flags & TCP_ACK )
+		{
+			uip_connr->snd_wnd = ( (u16_t) BUF->wnd[ 0 ] << 8 ) + ( u16_t ) BUF->wnd[ 1 ];
+		}
+	#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 	/* Do different things depending on in what state the connection is. */
 	switch( uip_connr->tcpstateflags & UIP_TS_MASK )
 	{
@@ -1728,6 +1968,32 @@ found:
 			this side as well, and we send out a FIN and enter the LAST_ACK
 			state. We require that there is no outstanding data; otherwise the
 			sequence numbers will be screwed up. */
+			#if UIP_TCP_TX_WINDOW > 1
+				/* If the application has closed the connection while it still
+				had data in flight, the application is not called again. The
+				FIN is sent once the last segment has been acknowledged. */
+				if( uip_connr->txq_fin )
+				{
+					if( uip_connr->len == 0 )
+					{
+						uip_connr->txq_fin = 0;
+						uip_connr->len = 1;
+						uip_connr->tcpstateflags = UIP_FIN_WAIT_1;
+						uip_connr->nrtx = 0;
+						BUF->flags = TCP_FIN | TCP_ACK;
+						goto tcp_send_nodata;
+					}
+
+					if( uip_len > 0 )
+					{
+						uip_add_rcv_nxt( uip_len );
+						goto tcp_send_ack;
+					}
+
+					goto drop;
+				}
+			#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 			if( BUF->flags & TCP_FIN && !(uip_connr->tcpstateflags & UIP_STOPPED) )
 			{
 				if( uip_outstanding(uip_connr) )
@@ -1838,8 +2104,50 @@ appsend:
 					goto tcp_send_nodata;
 				}
 
+				#if UIP_TCP_TX_WINDOW > 1
+					/* If uip_slen > 0, the application has data to be sent. A
+					copy is queued behind the segments already in flight so
+					that it can be retransmitted without the application. */
+					if( uip_slen > 0 )
+					{
+						tmp16 = uip_txq_room( uip_connr );
+						if( uip_slen > tmp16 )
+						{
+							uip_slen = tmp16;
+						}
+
+						if( uip_slen > 0 )
+						{
+							c = uip_txq_alloc();
+							uip_txq_owner[ c ] = ( u8_t ) ( uip_connr - uip_conns ) + 1;
+							uip_txq_len[ c ] = uip_slen;
+							uip_txq_ref[ c ] = uip_sref;
+							if( uip_sref == NULL )
+							{
+								memcpy( uip_txq_buf[ c ], uip_sappdata, uip_slen );
+							}
+							uip_sref = NULL;
+							uip_connr->txq_seg[ uip_connr->txq_num++ ] = c;
+
+							uip_txq_offset = uip_connr->len;
+							uip_connr->len += uip_slen;
+						}
+					}
+				#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 				if( uip_flags & UIP_CLOSE )
 				{
+					#if UIP_TCP_TX_WINDOW > 1
+						/* The FIN has to follow the data in flight, including
+						any queued from this callback, so it is held back
+						until that has been acknowledged. */
+						if( uip_connr->txq_num > 0 )
+						{
+							uip_connr->txq_fin = 1;
+							goto apprexmit;
+						}
+					#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 					uip_slen = 0;
 					uip_connr->len = 1;
 					uip_connr->tcpstateflags = UIP_FIN_WAIT_1;
@@ -1848,6 +2156,7 @@ appsend:
 					goto tcp_send_nodata;
 				}
 
+				#if UIP_TCP_TX_WINDOW <= 1
 				/* If uip_slen > 0, the application has data to be sent. */
 				if( uip_slen > 0 )
 				{
@@ -1885,6 +2194,7 @@ appsend:
 				}
 
 				uip_connr->nrtx = 0;
+				#endif /* UIP_TCP_TX_WINDOW <= 1 */
 apprexmit:
 				uip_appdata = uip_sappdata;
 
@@ -1893,7 +2203,11 @@ apprexmit:
 				if( uip_slen > 0 && uip_connr->len > 0 )
 				{
 					/* Add the length of the IP and TCP headers. */
-					uip_len = uip_connr->len + UIP_TCPIP_HLEN;
+					#if UIP_TCP_TX_WINDOW > 1
+						uip_len = uip_slen + UIP_TCPIP_HLEN;
+					#else
+						uip_len = uip_connr->len + UIP_TCPIP_HLEN;
+					#endif
 
 					/* We always set the ACK flag in response packets. */
 					BUF->flags = TCP_ACK | TCP_PSH;
@@ -2024,10 +2338,26 @@ tcp_send:
 	BUF->ackno[ 2 ] = uip_connr->rcv_nxt[ 2 ];
 	BUF->ackno[ 3 ] = uip_connr->rcv_nxt[ 3 ];
 
-	BUF->seqno[ 0 ] = uip_connr->snd_nxt[ 0 ];
-	BUF->seqno[ 1 ] = uip_connr->snd_nxt[ 1 ];
-	BUF->seqno[ 2 ] = uip_connr->snd_nxt[ 2 ];
-	BUF->seqno[ 3 ] = uip_connr->snd_nxt[ 3 ];
+	#if UIP_TCP_TX_WINDOW > 1
+		/* snd_nxt is the oldest unacknowledged byte, so while data is in
+		flight a segment carrying data starts at its offset into the window
+		and any other segment at the end of it. */
+		if( (uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED && uip_connr->txq_num > 0 )
+		{
+			uip_add32( uip_connr->snd_nxt, (uip_len > UIP_TCPIP_HLEN) ? uip_txq_offset : uip_connr->len );
+			BUF->seqno[ 0 ] = uip_acc32[ 0 ];
+			BUF->seqno[ 1 ] = uip_acc32[ 1 ];
+			BUF->seqno[ 2 ] = uip_acc32[ 2 ];
+			BUF->seqno[ 3 ] = uip_acc32[ 3 ];
+		}
+		else
+	#endif /* UIP_TCP_TX_WINDOW > 1 */
+	{
+		BUF->seqno[ 0 ] = uip_connr->snd_nxt[ 0 ];
+		BUF->seqno[ 1 ] = uip_connr->snd_nxt[ 1 ];
+		BUF->seqno[ 2 ] = uip_connr->snd_nxt[ 2 ];
+		BUF->seqno[ 3 ] = uip_connr->snd_nxt[ 3 ];
+	}
 
 	BUF->proto = UIP_PROTO_TCP;
 
@@ -2065,9 +2395,11 @@ tcp_send_noconn:
 
 	BUF->urgp[ 0 ] = BUF->urgp[ 1 ] = 0;
 
-	/* Calculate TCP checksum. */
+	/* Calculate TCP checksum, unless the interface will. */
 	BUF->tcpchksum = 0;
-	BUF->tcpchksum = ~( uip_tcpchksum() );
+	#if !UIP_CHECKSUM_OFFLOAD
+		BUF->tcpchksum = ~( uip_tcpchksum() );
+	#endif
 
 ip_send_nolen:
 	#if UIP_CONF_IPV6
@@ -2082,9 +2414,11 @@ ip_send_nolen:
 		BUF->ipid[ 0 ] = ipid >> 8;
 		BUF->ipid[ 1 ] = ipid & 0xff;
 
-		/* Calculate IP checksum. */
+		/* Calculate IP checksum, unless the interface will. */
 		BUF->ipchksum = 0;
-		BUF->ipchksum = ~( uip_ipchksum() );
+		#if !UIP_CHECKSUM_OFFLOAD
+			BUF->ipchksum = ~( uip_ipchksum() );
+		#endif
 
 		//DEBUG_PRINTF( "uip ip_send_nolen: chkecum 0x%04x\n", uip_ipchksum() );
 	#endif /* UIP_CONF_IPV6 */
@@ -2136,8 +2470,24 @@ void uip_send( const void *data, int len )
 			memcpy( uip_sappdata, (data), uip_slen );
 		}
 	}
+
+	#if UIP_TCP_TX_WINDOW > 1
+		uip_sref = NULL;
+	#endif /* UIP_TCP_TX_WINDOW > 1 */
 }
 /*---------------------------------------------------------------------------*/
 
+#if UIP_TCP_TX_WINDOW > 1
+	void uip_send_static( const void *data, int len )
+	{
+		uip_send( data, len );
+		if( uip_slen > 0 )
+		{
+			uip_sref = ( const u8_t * ) data;
+		}
+	}
+	/*---------------------------------------------------------------------------*/
+#endif /* UIP_TCP_TX_WINDOW > 1 */
+
 /** @} */
 #endif /* UIP_CONF_IPV6 */
@@ -97,11 +97,22 @@ struct ethip_hdr
 
 #define ARP_HWTYPE_ETH	1
 
+#if UIP_ARPTAB_SIZE > 254
+	#error UIP_ARPTAB_SIZE must be less than 255.
+#endif
+
+#if ( UIP_ARP_HASH_SIZE & ( UIP_ARP_HASH_SIZE - 1 ) ) != 0
+	#error UIP_ARP_HASH_SIZE must be 0 or a power of 2.
+#endif
+
 struct arp_entry
 {
 	uip_ipaddr_t		ipaddr;
 	struct uip_eth_addr ethaddr;
 	u8_t				time;
+#if UIP_ARP_HASH_SIZE > 0
+	u8_t				next;	/* Next entry on the same hash chain, as index + 1, 0 at the end. */
+#endif
 };
 
 static const struct uip_eth_addr	broadcast_ethaddr = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
@@ -110,6 +121,18 @@ static struct arp_entry				arp_table[UIP_ARPTAB_SIZE];
 static uip_ipaddr_t					ipaddr;
 static u8_t							i, c;
 
+/* The entry last found by uip_arp_find(), tried first by the next lookup. */
+static u8_t							lasthit;
+
+#if UIP_ARP_HASH_SIZE > 0
+/* First entry of each hash chain, as index + 1, 0 if the chain is empty.
+Every entry in use is on the chain of its IP address. */
+static u8_t							arp_hash[UIP_ARP_HASH_SIZE];
+
+/* The low bytes of the address differ most between hosts on one network. */
+#define ARP_HASH( addr )	( ( ( addr )->u8[2] ^ ( addr )->u8[3] ) & ( UIP_ARP_HASH_SIZE - 1 ) )
+#endif
+
 static u8_t							arptime;
 static u8_t							tmpage;
 
@@ -142,6 +165,73 @@ void uip_arp_init( void )
 	{
 		memset( &arp_table[i].ipaddr, 0, 4 );
 	}
+
+#if UIP_ARP_HASH_SIZE > 0
+	memset( arp_hash, 0, sizeof( arp_hash ) );
+#endif
+	lasthit = 0;
+}
+
+/*-----------------------------------------------------------------------------------*/
+#if UIP_ARP_HASH_SIZE > 0
+static void uip_arp_unlink( u8_t entry )
+{
+	u8_t	*link = &arp_hash[ARP_HASH( &arp_table[entry].ipaddr )];
+
+	/* Remove an entry that is in use from its hash chain. */
+	while( *link != entry + 1 )
+	{
+		link = &arp_table[*link - 1].next;
+	}
+
+	*link = arp_table[entry].next;
+}
+#endif
+
+/*-----------------------------------------------------------------------------------*/
+
+/**
+ * Find the ARP table entry in use for an IP address.
+ *
+ * \return The entry, or NULL if there is none.
+ */
+
+/*-----------------------------------------------------------------------------------*/
+static struct arp_entry *uip_arp_find( uip_ipaddr_t *addr )
+{
+	/* Unused entries hold the all zeroes address. */
+	if( uip_ipaddr_cmp(addr, &uip_all_zeroes_addr) )
+	{
+		return NULL;
+	}
+
+	/* Consecutive packets usually go to the same host. */
+	if( uip_ipaddr_cmp(addr, &arp_table[lasthit].ipaddr) )
+	{
+		return &arp_table[lasthit];
+	}
+
+#if UIP_ARP_HASH_SIZE > 0
+	for( c = arp_hash[ARP_HASH( addr )]; c != 0; c = arp_table[c - 1].next )
+	{
+		if( uip_ipaddr_cmp(addr, &arp_table[c - 1].ipaddr) )
+		{
+			lasthit = c - 1;
+			return &arp_table[lasthit];
+		}
+	}
+#else
+	for( c = 0; c < UIP_ARPTAB_SIZE; ++c )
+	{
+		if( uip_ipaddr_cmp(addr, &arp_table[c].ipaddr) )
+		{
+			lasthit = c;
+			return &arp_table[lasthit];
+		}
+	}
+#endif
+
+	return NULL;
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -164,8 +254,11 @@ void uip_arp_timer( void )
 	for( i = 0; i < UIP_ARPTAB_SIZE; ++i )
 	{
 		tabptr = &arp_table[i];
-		if( uip_ipaddr_cmp(&tabptr->ipaddr, &uip_all_zeroes_addr) && arptime - tabptr->time >= UIP_ARP_MAXAGE )
+		if( !uip_ipaddr_cmp(&tabptr->ipaddr, &uip_all_zeroes_addr) && arptime - tabptr->time >= UIP_ARP_MAXAGE )
 		{
+#if UIP_ARP_HASH_SIZE > 0
+			uip_arp_unlink( i );
+#endif
 			memset( &tabptr->ipaddr, 0, 4 );
 		}
 	}
@@ -176,27 +269,22 @@ static void uip_arp_update( uip_ipaddr_t *ipaddr, struct uip_eth_addr *ethaddr )
 {
 	register struct arp_entry	*tabptr;
 
-	/* Walk through the ARP mapping table and try to find an entry to
-     update. If none is found, the IP -> MAC address mapping is
-     inserted in the ARP table. */
-	for( i = 0; i < UIP_ARPTAB_SIZE; ++i )
+	/* Try to find an entry to update. If none is found, the IP -> MAC
+     address mapping is inserted in the ARP table. */
+	tabptr = uip_arp_find( ipaddr );
+	if( tabptr != NULL )
 	{
-		tabptr = &arp_table[i];
+		/* An old entry found, update this and return. */
+		memcpy( tabptr->ethaddr.addr, ethaddr->addr, 6 );
+		tabptr->time = arptime;
 
-		/* Only check those entries that are actually in use. */
-		if( !uip_ipaddr_cmp(&tabptr->ipaddr, &uip_all_zeroes_addr) )
-		{
-			/* Check if the source IP address of the incoming packet matches
-         the IP address in this ARP table entry. */
-			if( uip_ipaddr_cmp(ipaddr, &tabptr->ipaddr) )
-			{
-				/* An old entry found, update this and return. */
-				memcpy( tabptr->ethaddr.addr, ethaddr->addr, 6 );
-				tabptr->time = arptime;
+		return;
+	}
 
-				return;
-			}
-		}
+	/* An all zeroes address (from an ARP probe) would look unused. */
+	if( uip_ipaddr_cmp(ipaddr, &uip_all_zeroes_addr) )
+	{
+		return;
 	}
 
 	/* If we get here, no existing ARP table entry was found, so we
@@ -230,6 +318,10 @@ static void uip_arp_update( uip_ipaddr_t *ipaddr, struct uip_eth_addr *ethaddr )
 
 		i = c;
 		tabptr = &arp_table[i];
+
+#if UIP_ARP_HASH_SIZE > 0
+		uip_arp_unlink( i );
+#endif
 	}
 
 	/* Now, i is the ARP table entry which we will fill with the new
@@ -237,6 +329,12 @@ static void uip_arp_update( uip_ipaddr_t *ipaddr, struct uip_eth_addr *ethaddr )
 	uip_ipaddr_copy( &tabptr->ipaddr, ipaddr );
 	memcpy( tabptr->ethaddr.addr, ethaddr->addr, 6 );
 	tabptr->time = arptime;
+
+#if UIP_ARP_HASH_SIZE > 0
+	tabptr->next = arp_hash[ARP_HASH( ipaddr )];
+	arp_hash[ARP_HASH( ipaddr )] = i + 1;
+#endif
+	lasthit = i;
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -424,16 +522,8 @@ void uip_arp_out( void )
 			uip_ipaddr_copy( &ipaddr, &IPBUF->destipaddr );
 		}
 
-		for( i = 0; i < UIP_ARPTAB_SIZE; ++i )
-		{
-			tabptr = &arp_table[i];
-			if( uip_ipaddr_cmp(&ipaddr, &tabptr->ipaddr) )
-			{
-				break;
-			}
-		}
-
-		if( i == UIP_ARPTAB_SIZE )
+		tabptr = uip_arp_find( &ipaddr );
+		if( tabptr == NULL )
 		{
 			/* The destination address was not in our ARP table, so we
 	 overwrite the IP packet with an ARP request. */
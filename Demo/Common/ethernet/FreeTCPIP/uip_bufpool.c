@@ -0,0 +1,165 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+	
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/**
+ * \addtogroup uipbufpool
+ * @{
+ */
+
+/**
+ * \file
+ * Book keeping for the frame buffers a driver exchanges with uIP.
+ */
+
+#include <stddef.h>
+
+#include "net/uip_bufpool.h"
+
+#ifndef UIP_CONF_EXTERNAL_BUFFER
+	#error The uIP buffer pool requires UIP_CONF_EXTERNAL_BUFFER to be defined.
+#endif
+
+/* The buffers handed over by the driver. */
+static u8_t		*pucPoolBuffers = NULL;
+static u16_t	usPoolBufferSize = 0;
+static u8_t		ucPoolBuffers = 0;
+
+/* Non-zero for each buffer that is in use.  Buffers are freed from the MAC
+interrupt by a single write, so the flags need no further protection. */
+static volatile u8_t	ucBufferInUse[ UIP_BUFPOOL_BUFFERS ];
+
+/*---------------------------------------------------------------------------*/
+
+void uip_bufpool_init( u8_t *buffers, u8_t num, u16_t size )
+{
+	u8_t	b;
+
+	if( num > UIP_BUFPOOL_BUFFERS )
+	{
+		num = UIP_BUFPOOL_BUFFERS;
+	}
+
+	pucPoolBuffers = buffers;
+	usPoolBufferSize = size;
+	ucPoolBuffers = num;
+
+	for( b = 0; b < UIP_BUFPOOL_BUFFERS; ++b )
+	{
+		ucBufferInUse[ b ] = 0;
+	}
+}
+/*---------------------------------------------------------------------------*/
+
+u8_t *uip_bufpool_alloc( void )
+{
+	u8_t	b, ucAttempts;
+
+	for( ucAttempts = 0; ucAttempts < UIP_BUFPOOL_ATTEMPTS; ++ucAttempts )
+	{
+		#if UIP_BUFPOOL_ATTEMPTS > 1
+			if( ucAttempts > 0 )
+			{
+				/* Give the MAC a chance to finish with a buffer. */
+				uip_bufpool_wait();
+			}
+		#endif /* UIP_BUFPOOL_ATTEMPTS > 1 */
+
+		for( b = 0; b < ucPoolBuffers; ++b )
+		{
+			if( ucBufferInUse[ b ] == 0 )
+			{
+				ucBufferInUse[ b ] = 1;
+				return pucPoolBuffers + ( ( unsigned long ) b * usPoolBufferSize );
+			}
+		}
+	}
+
+	return NULL;
+}
+/*---------------------------------------------------------------------------*/
+
+void uip_bufpool_free( u8_t *buf )
+{
+	unsigned long	ulBuffer;
+
+	if( buf != NULL && buf >= pucPoolBuffers )
+	{
+		ulBuffer = ( unsigned long ) ( buf - pucPoolBuffers ) / usPoolBufferSize;
+		if( ulBuffer < ucPoolBuffers )
+		{
+			ucBufferInUse[ ulBuffer ] = 0;
+		}
+	}
+}
+/*---------------------------------------------------------------------------*/
+
+u8_t *uip_bufpool_rx( u8_t *frame )
+{
+	uip_bufpool_free( uip_buf );
+	uip_buf = frame;
+
+	return uip_bufpool_alloc();
+}
+/*---------------------------------------------------------------------------*/
+
+u8_t *uip_bufpool_tx( void )
+{
+	u8_t	*pucFrame = uip_buf;
+
+	uip_buf = uip_bufpool_alloc();
+
+	return pucFrame;
+}
+/*---------------------------------------------------------------------------*/
+
+/** @} */
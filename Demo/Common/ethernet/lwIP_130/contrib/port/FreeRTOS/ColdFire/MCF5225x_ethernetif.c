@@ -71,6 +71,13 @@ infinite. */
 /* Hardware specific. */
 #define netifFIRST_FEC_VECTOR						23
 
+/* When netifSCATTER_GATHER_TX is 1 each pbuf in a chain being sent is given
+its own Tx descriptor, so the frame is sent without first being copied into a
+single buffer.  The pbufs are freed once the FEC has sent the frame. */
+#ifndef netifSCATTER_GATHER_TX
+	#define netifSCATTER_GATHER_TX					1
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The DMA descriptors.  This is a char array to allow us to align it correctly. */
@@ -84,6 +91,16 @@ static unsigned char ucFECTxBuffers[ ( configNUM_FEC_TX_BUFFERS * configFEC_BUFF
 static unsigned char ucFECRxBuffers[ ( configNUM_FEC_RX_BUFFERS * configFEC_BUFFER_SIZE ) + 16 ];
 static unsigned portBASE_TYPE uxNextRxBuffer = 0, uxNextTxBuffer = 0;
 
+/* The aligned start of ucFECTxBuffers. */
+static unsigned char *pucTxBuffers;
+
+#if netifSCATTER_GATHER_TX == 1
+	/* The pbuf chain to free once the frame ending at each Tx descriptor has
+	been sent, or NULL if the descriptor does not end a chain that is being
+	sent directly from its pbufs. */
+	static struct pbuf *pxTxPbufs[ configNUM_FEC_TX_BUFFERS ] = { NULL };
+#endif
+
 /* Semaphore used by the FEC interrupt handler to wake the handler task. */
 static xSemaphoreHandle xFecSemaphore;
 
@@ -98,6 +115,18 @@ struct ethernetif
 
 /* Standard lwIP netif handlers. */
 static void prvInitialiseFECBuffers( void );
+static portBASE_TYPE prvTxDescriptorIsFree( unsigned portBASE_TYPE uxDescriptor );
+
+#if netifSCATTER_GATHER_TX == 1
+	/* Point one Tx descriptor at each segment of the chain p, and start the
+	transmission.  Returns pdFAIL without sending anything if there are not
+	uxSegments free descriptors. */
+	static portBASE_TYPE prvSendChain( struct pbuf *p, unsigned portBASE_TYPE uxSegments );
+
+	/* Free the pbufs of any frames that have been sent, so their descriptors
+	can be reused. */
+	static void prvReclaimTxDescriptors( void );
+#endif
 static void low_level_init( struct netif *netif );
 static err_t low_level_output(struct netif *netif, struct pbuf *p);
 static struct pbuf *low_level_input(struct netif *netif);
@@ -323,6 +352,9 @@ int fec_vbase;
 	 * Setup each ICR with a unique interrupt level combination */
 	fec_vbase -= 64;
 
+	/* FEC Tx Frame */
+	MCF_INTC0_ICR(fec_vbase+0)  = MCF_INTC_ICR_IL(INTC_LVL_FEC);
+
 	/* FEC Rx Frame */
 	MCF_INTC0_ICR(fec_vbase+4)  = MCF_INTC_ICR_IL(INTC_LVL_FEC);
 
@@ -352,7 +384,7 @@ int fec_vbase;
                                  
 	/* Enable the FEC interrupts in the mask register */    
 	MCF_INTC0_IMRH &= ~( MCF_INTC_IMRH_INT_MASK33 | MCF_INTC_IMRH_INT_MASK34 | MCF_INTC_IMRH_INT_MASK35 );
-	MCF_INTC0_IMRL &= ~( MCF_INTC_IMRL_INT_MASK25 | MCF_INTC_IMRL_INT_MASK26 | MCF_INTC_IMRL_INT_MASK27 | MCF_INTC_IMRL_INT_MASK28 | MCF_INTC_IMRL_INT_MASK29 | MCF_INTC_IMRL_INT_MASK30 | MCF_INTC_IMRL_INT_MASK31 | MCF_INTC_IMRL_MASKALL );
+	MCF_INTC0_IMRL &= ~( MCF_INTC_IMRL_INT_MASK23 | MCF_INTC_IMRL_INT_MASK25 | MCF_INTC_IMRL_INT_MASK26 | MCF_INTC_IMRL_INT_MASK27 | MCF_INTC_IMRL_INT_MASK28 | MCF_INTC_IMRL_INT_MASK29 | MCF_INTC_IMRL_INT_MASK30 | MCF_INTC_IMRL_INT_MASK31 | MCF_INTC_IMRL_MASKALL );
 
     /* Clear any pending FEC interrupt events */
     MCF_FEC_EIR = MCF_FEC_EIR_CLEAR_ALL;
@@ -529,6 +561,9 @@ struct pbuf *q;
 u32_t l = 0;
 unsigned char *pcTxData = NULL;
 portBASE_TYPE i;
+#if netifSCATTER_GATHER_TX == 1
+	unsigned portBASE_TYPE uxSegments = 0;
+#endif
 
 	( void ) netif;
 
@@ -536,16 +571,67 @@ portBASE_TYPE i;
 	  pbuf_header(p, -ETH_PAD_SIZE);			/* drop the padding word */
 	#endif
 
+	#if netifSCATTER_GATHER_TX == 1
+	{
+		for( q = p; q != NULL; q = q->next )
+		{
+			if( q->len != 0 )
+			{
+				uxSegments++;
+			}
+		}
+
+		/* A chain with more segments than there are descriptors is copied
+		into a single descriptor's buffer below. */
+		if( ( uxSegments > 0 ) && ( uxSegments <= configNUM_FEC_TX_BUFFERS ) )
+		{
+			for( i = 0; i < netifBUFFER_WAIT_ATTEMPTS; i++ )
+			{
+				prvReclaimTxDescriptors();
+
+				if( prvSendChain( p, uxSegments ) == pdPASS )
+				{
+					break;
+				}
+
+				/* Wait for descriptors to become available. */
+				vTaskDelay( netifBUFFER_WAIT_DELAY );
+			}
+
+			#if ETH_PAD_SIZE
+				pbuf_header(p, ETH_PAD_SIZE);			/* reclaim the padding word */
+			#endif
+
+			if( i >= netifBUFFER_WAIT_ATTEMPTS )
+			{
+				return ERR_BUF;
+			}
+
+			LINK_STATS_INC(link.xmit);
+
+			return ERR_OK;
+		}
+	}
+	#endif
+
 	/* Get a DMA buffer into which we can write the data to send. */
 	for( i = 0; i < netifBUFFER_WAIT_ATTEMPTS; i++ )
 	{
-		if( xFECTxDescriptors[ uxNextTxBuffer ].status & TX_BD_R )
+		#if netifSCATTER_GATHER_TX == 1
+		{
+			prvReclaimTxDescriptors();
+		}
+		#endif
+
+		if( prvTxDescriptorIsFree( uxNextTxBuffer ) == pdFALSE )
 		{
 			/* Wait for the buffer to become available. */
 			vTaskDelay( netifBUFFER_WAIT_DELAY );
 		}
 		else
 		{
+			/* The descriptor might last have pointed into a pbuf. */
+			xFECTxDescriptors[ uxNextTxBuffer ].data = &( pucTxBuffers[ uxNextTxBuffer * configFEC_BUFFER_SIZE ] );
 			pcTxData = xFECTxDescriptors[ uxNextTxBuffer ].data;
 			break;
 		}
@@ -696,6 +782,13 @@ struct pbuf *p;
 	{
 		do
 		{
+			#if netifSCATTER_GATHER_TX == 1
+			{
+				/* The Tx interrupt also wakes this task, to free the pbufs of
+				frames that have been sent. */
+				prvReclaimTxDescriptors();
+			}
+			#endif
 
 			/* move received packet into a new pbuf */
 			p = low_level_input( netif );
@@ -832,6 +925,10 @@ unsigned char *pcBufPointer;
 		pcBufPointer++;
 	}
 
+	/* Any pbufs still referenced from pxTxPbufs are left in place, and freed
+	the next time the descriptors are reclaimed. */
+	pucTxBuffers = pcBufPointer;
+
 	for( ux = 0; ux < configNUM_FEC_TX_BUFFERS; ux++ )
 	{
 		xFECTxDescriptors[ ux ].status = TX_BD_TC;
@@ -877,6 +974,17 @@ portBASE_TYPE xHighPriorityTaskWoken = pdFALSE;
 		xSemaphoreGiveFromISR( xFecSemaphore, &xHighPriorityTaskWoken );
 	}
 
+	#if netifSCATTER_GATHER_TX == 1
+	{
+		if( ulEvent & MCF_FEC_EIR_TXF )
+		{
+			/* A frame has been sent.  Wake the handler task so it can free
+			the pbufs the frame was sent from. */
+			xSemaphoreGiveFromISR( xFecSemaphore, &xHighPriorityTaskWoken );
+		}
+	}
+	#endif
+
 	if (ulEvent & ( MCF_FEC_EIR_UN | MCF_FEC_EIR_RL | MCF_FEC_EIR_LC | MCF_FEC_EIR_EBERR | MCF_FEC_EIR_BABT | MCF_FEC_EIR_BABR | MCF_FEC_EIR_HBERR ) )
 	{
 		/* Sledge hammer error handling. */
@@ -886,3 +994,137 @@ portBASE_TYPE xHighPriorityTaskWoken = pdFALSE;
 
 	portEND_SWITCHING_ISR( xHighPriorityTaskWoken );
 }
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTxDescriptorIsFree( unsigned portBASE_TYPE uxDescriptor )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( ( xFECTxDescriptors[ uxDescriptor ].status & TX_BD_R ) == 0 )
+	{
+		xReturn = pdTRUE;
+
+		#if netifSCATTER_GATHER_TX == 1
+		{
+			/* The descriptor cannot be reused until the pbufs of the frame it
+			ended have been freed. */
+			if( pxTxPbufs[ uxDescriptor ] != NULL )
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		#endif
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if netifSCATTER_GATHER_TX == 1
+
+	static portBASE_TYPE prvSendChain( struct pbuf *p, unsigned portBASE_TYPE uxSegments )
+	{
+	struct pbuf *q;
+	unsigned portBASE_TYPE ux, uxDescriptor, uxFirst, uxLast;
+	portBASE_TYPE xReturn = pdPASS;
+
+		/* The FEC interrupt can reinitialise the descriptors if an error
+		occurs, so it must not run while they are being set up. */
+		taskENTER_CRITICAL();
+		{
+			uxDescriptor = uxNextTxBuffer;
+			for( ux = 0; ux < uxSegments; ux++ )
+			{
+				if( prvTxDescriptorIsFree( uxDescriptor ) == pdFALSE )
+				{
+					xReturn = pdFAIL;
+					break;
+				}
+
+				uxDescriptor++;
+				if( uxDescriptor >= configNUM_FEC_TX_BUFFERS )
+				{
+					uxDescriptor = 0;
+				}
+			}
+
+			if( xReturn == pdPASS )
+			{
+				uxFirst = uxNextTxBuffer;
+				uxLast = uxFirst;
+				uxDescriptor = uxFirst;
+
+				for( q = p; q != NULL; q = q->next )
+				{
+					if( q->len != 0 )
+					{
+						xFECTxDescriptors[ uxDescriptor ].data = ( uint8 * ) q->payload;
+						xFECTxDescriptors[ uxDescriptor ].length = q->len;
+						xFECTxDescriptors[ uxDescriptor ].status = ( xFECTxDescriptors[ uxDescriptor ].status & TX_BD_W ) | TX_BD_TC;
+
+						/* The first descriptor is given to the FEC last, so
+						it cannot start on a partly built frame. */
+						if( uxDescriptor != uxFirst )
+						{
+							xFECTxDescriptors[ uxDescriptor ].status |= TX_BD_R;
+						}
+
+						uxLast = uxDescriptor;
+						uxDescriptor++;
+						if( uxDescriptor >= configNUM_FEC_TX_BUFFERS )
+						{
+							uxDescriptor = 0;
+						}
+					}
+				}
+
+				/* The stack frees its own reference to the chain when this
+				function returns, so take another that is held until the frame
+				has been sent. */
+				pbuf_ref( p );
+				pxTxPbufs[ uxLast ] = p;
+
+				xFECTxDescriptors[ uxLast ].status |= TX_BD_L;
+				xFECTxDescriptors[ uxFirst ].status |= TX_BD_R;
+
+				/* Continue the Tx DMA task (in case it was waiting for a new TxBD) */
+				MCF_FEC_TDAR = MCF_FEC_TDAR_X_DES_ACTIVE;
+
+				uxNextTxBuffer = uxDescriptor;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReclaimTxDescriptors( void )
+	{
+	unsigned portBASE_TYPE ux;
+	struct pbuf *p;
+
+		for( ux = 0; ux < configNUM_FEC_TX_BUFFERS; ux++ )
+		{
+			p = NULL;
+
+			taskENTER_CRITICAL();
+			{
+				if( ( pxTxPbufs[ ux ] != NULL ) && ( ( xFECTxDescriptors[ ux ].status & TX_BD_R ) == 0 ) )
+				{
+					p = pxTxPbufs[ ux ];
+					pxTxPbufs[ ux ] = NULL;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* The FEC has finished with the frame, so release the reference
+			taken when it was sent. */
+			if( p != NULL )
+			{
+				pbuf_free( p );
+			}
+		}
+	}
+
+#endif /* netifSCATTER_GATHER_TX */
@@ -0,0 +1,273 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The lwIP firmware update server.  See fwupdate.h.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/api.h"
+
+/* Demo includes. */
+#include "FirmwareUpdate.h"
+#include "fwupdate.h"
+
+#if NO_SYS || !LWIP_TCP || !LWIP_NETCONN
+	#error fwupdate needs NO_SYS 0, and LWIP_TCP and LWIP_NETCONN 1.
+#endif
+
+#ifndef fwupdateSERVER_STACK_SIZE
+	#define fwupdateSERVER_STACK_SIZE		( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Accept connections and receive one update from each.
+ */
+static void prvUpdateServerTask( void *pvParameters );
+
+/*
+ * Receive an update over pxConnection, and return its result.
+ */
+static portBASE_TYPE prvReceiveUpdate( struct netconn *pxConnection );
+
+/*
+ * Send the reply for xResult.
+ */
+static void prvSendReply( struct netconn *pxConnection, portBASE_TYPE xResult );
+
+/*-----------------------------------------------------------*/
+
+static pdFIRMWARE_UPDATE_CALLBACK pxUpdateComplete = NULL;
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xFirmwareUpdateServerStart( unsigned portBASE_TYPE uxPriority, pdFIRMWARE_UPDATE_CALLBACK pxComplete )
+{
+	pxUpdateComplete = pxComplete;
+	return xTaskCreate( prvUpdateServerTask, ( signed char * ) "FWSrv", fwupdateSERVER_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUpdateServerTask( void *pvParameters )
+{
+struct netconn *pxListener, *pxConnection;
+portBASE_TYPE xResult;
+
+	( void ) pvParameters;
+
+	pxListener = netconn_new( NETCONN_TCP );
+	if( pxListener != NULL )
+	{
+		if( ( netconn_bind( pxListener, NULL, fwupdatePORT ) != ERR_OK ) || ( netconn_listen( pxListener ) != ERR_OK ) )
+		{
+			netconn_delete( pxListener );
+			pxListener = NULL;
+		}
+	}
+
+	if( pxListener == NULL )
+	{
+		vTaskDelete( NULL );
+	}
+
+	for( ;; )
+	{
+		if( netconn_accept( pxListener, &pxConnection ) != ERR_OK )
+		{
+			continue;
+		}
+
+		#if LWIP_SO_RCVTIMEO == 1
+		{
+			netconn_set_recvtimeout( pxConnection, fwupdateRECEIVE_TIMEOUT_MS );
+		}
+		#endif
+
+		xResult = prvReceiveUpdate( pxConnection );
+		prvSendReply( pxConnection, xResult );
+
+		netconn_close( pxConnection );
+		netconn_delete( pxConnection );
+
+		if( pxUpdateComplete != NULL )
+		{
+			pxUpdateComplete( xResult );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReceiveUpdate( struct netconn *pxConnection )
+{
+struct netbuf *pxNetbuf;
+unsigned char ucHeader[ fwupdateHEADER_LENGTH ];
+unsigned long ulHeaderBytes = 0UL, ulImageLength = 0UL, ulReceived = 0UL, ulCopy;
+const unsigned char *pucData;
+void *pvData;
+u16_t usLength;
+portBASE_TYPE xResult = fwupdateOK;
+portBASE_TYPE xStarted = pdFALSE, xFinished = pdFALSE;
+
+	while( xFinished == pdFALSE )
+	{
+		if( netconn_recv( pxConnection, &pxNetbuf ) != ERR_OK )
+		{
+			/* Closed, reset or timed out before the whole image arrived. */
+			xResult = ( xStarted != pdFALSE ) ? fwupdateERR_ABORTED : fwupdateERR_HEADER;
+			xFinished = pdTRUE;
+			break;
+		}
+
+		do
+		{
+			netbuf_data( pxNetbuf, &pvData, &usLength );
+			pucData = ( const unsigned char * ) pvData;
+
+			if( ulHeaderBytes < ( unsigned long ) fwupdateHEADER_LENGTH )
+			{
+				ulCopy = ( unsigned long ) fwupdateHEADER_LENGTH - ulHeaderBytes;
+				if( ulCopy > ( unsigned long ) usLength )
+				{
+					ulCopy = ( unsigned long ) usLength;
+				}
+
+				memcpy( &( ucHeader[ ulHeaderBytes ] ), pucData, ( size_t ) ulCopy );
+				ulHeaderBytes += ulCopy;
+				pucData += ulCopy;
+				usLength -= ( u16_t ) ulCopy;
+
+				if( ulHeaderBytes == ( unsigned long ) fwupdateHEADER_LENGTH )
+				{
+					xResult = xFirmwareUpdateBegin( ucHeader );
+					if( xResult != fwupdateOK )
+					{
+						xFinished = pdTRUE;
+						break;
+					}
+
+					xStarted = pdTRUE;
+					ulImageLength = ( ( unsigned long ) ucHeader[ 4 ] << 24 ) | ( ( unsigned long ) ucHeader[ 5 ] << 16 ) | ( ( unsigned long ) ucHeader[ 6 ] << 8 ) | ( unsigned long ) ucHeader[ 7 ];
+				}
+			}
+
+			if( usLength > 0U )
+			{
+				/* Only blocks if every buffer is full, which leaves the rest
+				of the data in the mailbox of the connection. */
+				if( ulFirmwareUpdateWrite( pucData, ( unsigned long ) usLength, portMAX_DELAY ) != ( unsigned long ) usLength )
+				{
+					/* The writer has failed, vFirmwareUpdateEnd() collects
+					the reason. */
+					ulReceived = ulImageLength;
+				}
+				else
+				{
+					ulReceived += ( unsigned long ) usLength;
+				}
+			}
+
+			if( ( xStarted != pdFALSE ) && ( ulReceived >= ulImageLength ) )
+			{
+				/* Anything after the image is left unread, and reported as
+				a length error by the writer if it arrived with it. */
+				vFirmwareUpdateEnd();
+				xResult = xFirmwareUpdateGetResult( portMAX_DELAY );
+				xStarted = pdFALSE;
+				xFinished = pdTRUE;
+				break;
+			}
+
+		} while( netbuf_next( pxNetbuf ) >= 0 );
+
+		netbuf_delete( pxNetbuf );
+	}
+
+	if( xStarted != pdFALSE )
+	{
+		/* The connection failed part way through the image. */
+		vFirmwareUpdateAbort();
+		xResult = xFirmwareUpdateGetResult( portMAX_DELAY );
+	}
+
+	return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendReply( struct netconn *pxConnection, portBASE_TYPE xResult )
+{
+static const char cOK[] = "OK\r\n";
+char cError[] = "ERROR n\r\n";
+
+	if( xResult == fwupdateOK )
+	{
+		( void ) netconn_write( pxConnection, cOK, sizeof( cOK ) - 1, NETCONN_NOCOPY );
+	}
+	else
+	{
+		/* The codes are all one digit. */
+		cError[ 6 ] = ( char ) ( '0' + xResult );
+		( void ) netconn_write( pxConnection, cError, sizeof( cError ) - 1, NETCONN_COPY );
+	}
+}
+/*-----------------------------------------------------------*/
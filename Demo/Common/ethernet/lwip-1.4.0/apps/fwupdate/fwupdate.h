@@ -0,0 +1,86 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef FWUPDATE_H
+#define FWUPDATE_H
+
+/*
+ * A firmware update server for lwIP.  It listens on fwupdatePORT and passes
+ * the image it receives to the writer in Demo/Common/Minimal/FirmwareUpdate.c
+ * - see Demo/Common/include/FirmwareUpdate.h for the transfer format and for
+ * how the image is written.
+ *
+ * The server is a task of its own, built on the netconn API, so it blocks
+ * rather than the tcpip thread when the writer falls behind.  Data is then
+ * left in the receive mailbox of the connection, which closes the TCP window
+ * until the writer frees a buffer.  One update is received at a time, a
+ * second connection waits to be accepted until the first has been replied
+ * to.
+ *
+ * xFirmwareUpdateInit() must have been called first.
+ */
+
+/* How long the server waits for more data before it gives up on an update,
+in milliseconds.  Only used when LWIP_SO_RCVTIMEO is 1. */
+#ifndef fwupdateRECEIVE_TIMEOUT_MS
+	#define fwupdateRECEIVE_TIMEOUT_MS		10000
+#endif
+
+/*
+ * Create the server task at priority uxPriority.  pxComplete, which can be
+ * NULL, is called from the server task with the result of each update.
+ */
+portBASE_TYPE xFirmwareUpdateServerStart( unsigned portBASE_TYPE uxPriority, pdFIRMWARE_UPDATE_CALLBACK pxComplete );
+
+#endif /* FWUPDATE_H */
@@ -0,0 +1,651 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * iperf 2 compatible TCP and UDP servers and a TCP client for lwIP.  See
+ * iperf.h for how they are used from a PC.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/tcp.h"
+#include "lwip/udp.h"
+#include "lwip/api.h"
+#include "lwip/stats.h"
+
+#include "iperf.h"
+
+#if NO_SYS || !LWIP_TCP || !LWIP_UDP || !LWIP_NETCONN
+	#error iperf needs NO_SYS 0, and LWIP_TCP, LWIP_UDP and LWIP_NETCONN 1.
+#endif
+
+/* The size of the buffer passed to each netconn_write() made by the client.
+The buffer is sent without being copied, so it can be larger than the send
+buffer. */
+#ifndef iperfCLIENT_BUFFER_SIZE
+	#define iperfCLIENT_BUFFER_SIZE		( 4 * TCP_MSS )
+#endif
+
+#ifndef iperfCLIENT_STACK_SIZE
+	#define iperfCLIENT_STACK_SIZE		( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+/* An iperf TCP stream starts with a client header: flags, thread count, port,
+buffer length, bandwidth and amount, each 32 bits.  A zero flags word means a
+plain test, so the client leaves the header at zero, and the server does not
+need to look at it because the dual and trade off tests are not supported. */
+#define iperfCLIENT_HEADER_LENGTH		24
+
+/* Each UDP datagram starts with a 32 bit sequence number, which is negated in
+the datagrams that end the test, and the send time as 32 bit seconds and
+microseconds, all big endian. */
+#define iperfUDP_HEADER_WORDS			3
+
+/* The server report returned to the client in reply to the final datagram:
+flags, two length words, stop time in seconds and microseconds, error count,
+out of order count, datagram count and jitter in seconds and microseconds. */
+#define iperfSERVER_HEADER_WORDS		10
+#define iperfHEADER_VERSION1			0x80000000UL
+
+/* The CPU load is derived from the time the idle task ran, measured with the
+same counter as the run time stats. */
+#if configGENERATE_RUN_TIME_STATS == 1
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define iperfGET_RUN_TIME( ulTime )		portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulTime ) )
+	#else
+		#define iperfGET_RUN_TIME( ulTime )		( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/* What is recorded when a test starts, so the end of the test can work out
+the change. */
+typedef struct xIPERF_MEASUREMENT
+{
+	portTickType xStartTime;
+	unsigned long ulBytes;
+
+	#if configGENERATE_RUN_TIME_STATS == 1
+		portRUN_TIME_COUNTER_TYPE ulIdleStart;
+		portRUN_TIME_COUNTER_TYPE ulTotalStart;
+	#endif
+
+	#if LWIP_STATS
+		#if LINK_STATS
+			struct stats_proto xLink;
+		#endif
+		#if IP_STATS
+			struct stats_proto xIP;
+		#endif
+		#if TCP_STATS
+			struct stats_proto xTCP;
+		#endif
+		#if UDP_STATS
+			struct stats_proto xUDP;
+		#endif
+	#endif
+} xIperfMeasurement;
+
+/*
+ * Record the state at the start of a test.
+ */
+static void prvMeasureStart( xIperfMeasurement *pxMeasurement );
+
+/*
+ * Fill pxReport with the change since prvMeasureStart() was called.  The UDP
+ * fields are left at zero.
+ */
+static void prvMeasureEnd( const xIperfMeasurement *pxMeasurement, xIperfReport *pxReport, const char *pcTest );
+
+/*
+ * The raw API callbacks of the TCP server.
+ */
+static err_t prvTCPAccept( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr );
+static err_t prvTCPReceive( void *pvArg, struct tcp_pcb *pxPCB, struct pbuf *pxBuffer, err_t xErr );
+static void prvTCPError( void *pvArg, err_t xErr );
+static void prvTCPFinish( portBASE_TYPE xAborted );
+
+/*
+ * The raw API callback of the UDP server, and the function that sends the
+ * server report.
+ */
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *pxBuffer, ip_addr_t *pxAddress, u16_t usPort );
+static void prvUDPSendReport( struct udp_pcb *pxPCB, const u32_t *pulHeader, ip_addr_t *pxAddress, u16_t usPort );
+
+/*
+ * The task created by xIperfClientStart().
+ */
+static void prvIperfClientTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* Where the servers send their results. */
+static pdIPERF_REPORT_CALLBACK pxServerReport = NULL;
+
+/* The connection being measured by the TCP server, or NULL. */
+static struct tcp_pcb *pxTCPTest = NULL;
+static xIperfMeasurement xTCPMeasurement;
+
+/* The state of the UDP test.  The report is kept after the test ends because
+the client sends its final datagram again until a report arrives. */
+static portBASE_TYPE xUDPRunning = pdFALSE, xUDPReportValid = pdFALSE;
+static xIperfMeasurement xUDPMeasurement;
+static xIperfReport xUDPReport;
+static long lUDPNextSequence;
+static unsigned long ulUDPLastTransit, ulUDPJitter16;
+
+/* The parameters of the client task.  Only one client runs at a time. */
+static volatile portBASE_TYPE xClientRunning = pdFALSE;
+static ip_addr_t xClientServer;
+static unsigned long ulClientSeconds;
+static pdIPERF_REPORT_CALLBACK pxClientReport;
+static unsigned char ucClientBuffer[ iperfCLIENT_BUFFER_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+void vIperfServerInit( pdIPERF_REPORT_CALLBACK pxReport )
+{
+struct tcp_pcb *pxListen;
+struct udp_pcb *pxUDP;
+
+	pxServerReport = pxReport;
+
+	pxListen = tcp_new();
+	LWIP_ASSERT( "iperf: tcp_new failed", pxListen != NULL );
+	if( tcp_bind( pxListen, IP_ADDR_ANY, iperfPORT ) == ERR_OK )
+	{
+		pxListen = tcp_listen( pxListen );
+		LWIP_ASSERT( "iperf: tcp_listen failed", pxListen != NULL );
+		tcp_arg( pxListen, pxListen );
+		tcp_accept( pxListen, prvTCPAccept );
+	}
+	else
+	{
+		tcp_close( pxListen );
+	}
+
+	pxUDP = udp_new();
+	LWIP_ASSERT( "iperf: udp_new failed", pxUDP != NULL );
+	if( udp_bind( pxUDP, IP_ADDR_ANY, iperfPORT ) == ERR_OK )
+	{
+		udp_recv( pxUDP, prvUDPReceive, NULL );
+	}
+	else
+	{
+		udp_remove( pxUDP );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvTCPAccept( void *pvArg, struct tcp_pcb *pxPCB, err_t xErr )
+{
+struct tcp_pcb *pxListen = ( struct tcp_pcb * ) pvArg;
+
+	( void ) xErr;
+
+	tcp_accepted( pxListen );
+
+	if( pxTCPTest != NULL )
+	{
+		/* A test is already running.  Returning an error makes lwIP reset
+		the connection. */
+		return ERR_MEM;
+	}
+
+	pxTCPTest = pxPCB;
+	tcp_arg( pxPCB, NULL );
+	tcp_recv( pxPCB, prvTCPReceive );
+	tcp_err( pxPCB, prvTCPError );
+	prvMeasureStart( &xTCPMeasurement );
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static err_t prvTCPReceive( void *pvArg, struct tcp_pcb *pxPCB, struct pbuf *pxBuffer, err_t xErr )
+{
+	( void ) pvArg;
+	( void ) xErr;
+
+	if( pxBuffer == NULL )
+	{
+		/* The client has finished sending. */
+		prvTCPFinish( pdFALSE );
+		tcp_recv( pxPCB, NULL );
+		tcp_err( pxPCB, NULL );
+
+		if( tcp_close( pxPCB ) != ERR_OK )
+		{
+			tcp_abort( pxPCB );
+			return ERR_ABRT;
+		}
+	}
+	else
+	{
+		xTCPMeasurement.ulBytes += pxBuffer->tot_len;
+		tcp_recved( pxPCB, pxBuffer->tot_len );
+		pbuf_free( pxBuffer );
+	}
+
+	return ERR_OK;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTCPError( void *pvArg, err_t xErr )
+{
+	( void ) pvArg;
+	( void ) xErr;
+
+	/* The pcb has already been freed. */
+	prvTCPFinish( pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTCPFinish( portBASE_TYPE xAborted )
+{
+xIperfReport xReport;
+
+	prvMeasureEnd( &xTCPMeasurement, &xReport, "TCP server" );
+	xReport.xAborted = xAborted;
+	pxTCPTest = NULL;
+
+	if( pxServerReport != NULL )
+	{
+		pxServerReport( &xReport );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvUDPReceive( void *pvArg, struct udp_pcb *pxPCB, struct pbuf *pxBuffer, ip_addr_t *pxAddress, u16_t usPort )
+{
+u32_t ulHeader[ iperfUDP_HEADER_WORDS ];
+long lSequence, lDifference;
+portBASE_TYPE xFinal = pdFALSE;
+unsigned long ulArrival, ulTransit, ulLost, ulOutOfOrder;
+
+	( void ) pvArg;
+
+	if( pbuf_copy_partial( pxBuffer, ulHeader, sizeof( ulHeader ), 0 ) != sizeof( ulHeader ) )
+	{
+		pbuf_free( pxBuffer );
+		return;
+	}
+
+	lSequence = ( long ) ( s32_t ) ntohl( ulHeader[ 0 ] );
+	if( lSequence < 0 )
+	{
+		lSequence = -lSequence;
+		xFinal = pdTRUE;
+	}
+
+	if( ( xUDPRunning == pdFALSE ) && ( xFinal == pdFALSE ) )
+	{
+		/* The first datagram of a new test. */
+		prvMeasureStart( &xUDPMeasurement );
+		memset( &xUDPReport, 0x00, sizeof( xUDPReport ) );
+		lUDPNextSequence = 0;
+		ulUDPJitter16 = 0;
+		xUDPRunning = pdTRUE;
+		xUDPReportValid = pdFALSE;
+		ulUDPLastTransit = 0;
+	}
+
+	if( xUDPRunning != pdFALSE )
+	{
+		xUDPMeasurement.ulBytes += pxBuffer->tot_len;
+
+		/* A gap in the sequence numbers counts as lost datagrams, which are
+		taken back off if they arrive later. */
+		if( lSequence >= lUDPNextSequence )
+		{
+			xUDPReport.ulLost += ( unsigned long ) ( lSequence - lUDPNextSequence );
+			lUDPNextSequence = lSequence + 1;
+		}
+		else
+		{
+			xUDPReport.ulOutOfOrder++;
+			if( xUDPReport.ulLost > 0UL )
+			{
+				xUDPReport.ulLost--;
+			}
+		}
+
+		/* The jitter is worked out as in RFC 1889, from the difference between
+		the transit times of consecutive datagrams.  The clocks do not need to
+		be synchronised, but the result is only as fine as the tick period.
+		It is held multiplied by 16 to keep the fractional part. */
+		ulArrival = ( unsigned long ) ( xTaskGetTickCount() * portTICK_RATE_MS ) * 1000UL;
+		ulTransit = ulArrival - ( ( ntohl( ulHeader[ 1 ] ) * 1000000UL ) + ntohl( ulHeader[ 2 ] ) );
+		if( xUDPReport.ulDatagrams != 0UL )
+		{
+			lDifference = ( long ) ( ulTransit - ulUDPLastTransit );
+			if( lDifference < 0L )
+			{
+				lDifference = -lDifference;
+			}
+			ulUDPJitter16 += ( unsigned long ) lDifference - ( ( ulUDPJitter16 + 8UL ) >> 4 );
+		}
+		ulUDPLastTransit = ulTransit;
+
+		/* Counts the datagrams received until the end of the test, when it is
+		replaced by the number the client sent. */
+		xUDPReport.ulDatagrams++;
+
+		if( xFinal != pdFALSE )
+		{
+			xUDPRunning = pdFALSE;
+
+			/* prvMeasureEnd() zeroes the report, so save the UDP fields. */
+			ulLost = xUDPReport.ulLost;
+			ulOutOfOrder = xUDPReport.ulOutOfOrder;
+
+			prvMeasureEnd( &xUDPMeasurement, &xUDPReport, "UDP server" );
+			xUDPReport.ulDatagrams = ( unsigned long ) lUDPNextSequence;
+			xUDPReport.ulLost = ulLost;
+			xUDPReport.ulOutOfOrder = ulOutOfOrder;
+			xUDPReport.ulJitterMicroseconds = ulUDPJitter16 >> 4;
+			xUDPReportValid = pdTRUE;
+
+			if( pxServerReport != NULL )
+			{
+				pxServerReport( &xUDPReport );
+			}
+		}
+	}
+
+	if( ( xFinal != pdFALSE ) && ( xUDPReportValid != pdFALSE ) )
+	{
+		prvUDPSendReport( pxPCB, ulHeader, pxAddress, usPort );
+	}
+
+	pbuf_free( pxBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvUDPSendReport( struct udp_pcb *pxPCB, const u32_t *pulHeader, ip_addr_t *pxAddress, u16_t usPort )
+{
+struct pbuf *pxReply;
+u32_t *pulReply;
+
+	pxReply = pbuf_alloc( PBUF_TRANSPORT, ( iperfUDP_HEADER_WORDS + iperfSERVER_HEADER_WORDS ) * sizeof( u32_t ), PBUF_RAM );
+	if( pxReply != NULL )
+	{
+		/* The payload of a PBUF_RAM pbuf is aligned to MEM_ALIGNMENT. */
+		pulReply = ( u32_t * ) pxReply->payload;
+
+		/* Echo the datagram header, then the report. */
+		memcpy( pulReply, pulHeader, iperfUDP_HEADER_WORDS * sizeof( u32_t ) );
+		pulReply += iperfUDP_HEADER_WORDS;
+		pulReply[ 0 ] = htonl( iperfHEADER_VERSION1 );
+		pulReply[ 1 ] = 0;
+		pulReply[ 2 ] = htonl( xUDPReport.ulBytes );
+		pulReply[ 3 ] = htonl( xUDPReport.ulMilliseconds / 1000UL );
+		pulReply[ 4 ] = htonl( ( xUDPReport.ulMilliseconds % 1000UL ) * 1000UL );
+		pulReply[ 5 ] = htonl( xUDPReport.ulLost );
+		pulReply[ 6 ] = htonl( xUDPReport.ulOutOfOrder );
+		pulReply[ 7 ] = htonl( xUDPReport.ulDatagrams );
+		pulReply[ 8 ] = htonl( xUDPReport.ulJitterMicroseconds / 1000000UL );
+		pulReply[ 9 ] = htonl( xUDPReport.ulJitterMicroseconds % 1000000UL );
+
+		udp_sendto( pxPCB, pxReply, pxAddress, usPort );
+		pbuf_free( pxReply );
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xIperfClientStart( ip_addr_t *pxServer, unsigned long ulSeconds, unsigned portBASE_TYPE uxPriority, pdIPERF_REPORT_CALLBACK pxReport )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	taskENTER_CRITICAL();
+	{
+		if( xClientRunning == pdFALSE )
+		{
+			xClientRunning = pdTRUE;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xReturn == pdPASS )
+	{
+		ip_addr_copy( xClientServer, *pxServer );
+		ulClientSeconds = ulSeconds;
+		pxClientReport = pxReport;
+
+		if( xTaskCreate( prvIperfClientTask, ( signed char * ) "iperf", iperfCLIENT_STACK_SIZE, NULL, uxPriority, NULL ) != pdPASS )
+		{
+			xClientRunning = pdFALSE;
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIperfClientTask( void *pvParameters )
+{
+struct netconn *pxConnection;
+xIperfMeasurement xMeasurement;
+xIperfReport xReport;
+portTickType xDuration;
+portBASE_TYPE xAborted = pdTRUE;
+unsigned long ul;
+
+	( void ) pvParameters;
+
+	/* Leave the client header at zero and fill the rest with the pattern
+	iperf itself sends.  Every write sends the same buffer, which does not
+	change while lwIP holds references to it. */
+	for( ul = iperfCLIENT_HEADER_LENGTH; ul < sizeof( ucClientBuffer ); ul++ )
+	{
+		ucClientBuffer[ ul ] = ( unsigned char ) ( '0' + ( ul % 10UL ) );
+	}
+
+	xDuration = ( portTickType ) ( ( ulClientSeconds * 1000UL ) / portTICK_RATE_MS );
+
+	pxConnection = netconn_new( NETCONN_TCP );
+	if( pxConnection != NULL )
+	{
+		if( netconn_connect( pxConnection, &xClientServer, iperfPORT ) == ERR_OK )
+		{
+			prvMeasureStart( &xMeasurement );
+			xAborted = pdFALSE;
+
+			while( ( xTaskGetTickCount() - xMeasurement.xStartTime ) < xDuration )
+			{
+				if( netconn_write( pxConnection, ucClientBuffer, sizeof( ucClientBuffer ), NETCONN_NOCOPY ) != ERR_OK )
+				{
+					xAborted = pdTRUE;
+					break;
+				}
+
+				xMeasurement.ulBytes += sizeof( ucClientBuffer );
+			}
+
+			netconn_close( pxConnection );
+		}
+
+		netconn_delete( pxConnection );
+	}
+
+	if( xAborted == pdFALSE )
+	{
+		prvMeasureEnd( &xMeasurement, &xReport, "TCP client" );
+	}
+	else
+	{
+		memset( &xReport, 0x00, sizeof( xReport ) );
+		xReport.pcTest = "TCP client";
+		xReport.usCpuLoad = iperfCPU_LOAD_UNKNOWN;
+	}
+	xReport.xAborted = xAborted;
+
+	if( pxClientReport != NULL )
+	{
+		pxClientReport( &xReport );
+	}
+
+	xClientRunning = pdFALSE;
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureStart( xIperfMeasurement *pxMeasurement )
+{
+	pxMeasurement->xStartTime = xTaskGetTickCount();
+	pxMeasurement->ulBytes = 0UL;
+
+	#if configGENERATE_RUN_TIME_STATS == 1
+	{
+		pxMeasurement->ulIdleStart = ulTaskGetIdleRunTimeCounter();
+		iperfGET_RUN_TIME( pxMeasurement->ulTotalStart );
+	}
+	#endif
+
+	#if LWIP_STATS
+	{
+		#if LINK_STATS
+			pxMeasurement->xLink = lwip_stats.link;
+		#endif
+		#if IP_STATS
+			pxMeasurement->xIP = lwip_stats.ip;
+		#endif
+		#if TCP_STATS
+			pxMeasurement->xTCP = lwip_stats.tcp;
+		#endif
+		#if UDP_STATS
+			pxMeasurement->xUDP = lwip_stats.udp;
+		#endif
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if LWIP_STATS
+
+	static void prvCounterChange( xIperfCounters *pxCounters, const struct stats_proto *pxStart, const struct stats_proto *pxNow )
+	{
+		/* The casts keep the result right when a counter wraps. */
+		pxCounters->ulXmit = ( STAT_COUNTER ) ( pxNow->xmit - pxStart->xmit );
+		pxCounters->ulRecv = ( STAT_COUNTER ) ( pxNow->recv - pxStart->recv );
+		pxCounters->ulDrop = ( STAT_COUNTER ) ( pxNow->drop - pxStart->drop );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvMeasureEnd( const xIperfMeasurement *pxMeasurement, xIperfReport *pxReport, const char *pcTest )
+{
+unsigned long ulMilliseconds;
+
+	memset( pxReport, 0x00, sizeof( xIperfReport ) );
+	pxReport->pcTest = pcTest;
+	pxReport->ulBytes = pxMeasurement->ulBytes;
+
+	ulMilliseconds = ( unsigned long ) ( xTaskGetTickCount() - pxMeasurement->xStartTime ) * portTICK_RATE_MS;
+	pxReport->ulMilliseconds = ulMilliseconds;
+	if( ulMilliseconds != 0UL )
+	{
+		/* Bytes per millisecond times eight is kbit/s.  Split to stay within
+		32 bits. */
+		pxReport->ulKbitsPerSecond = ( ( pxMeasurement->ulBytes / ulMilliseconds ) * 8UL ) + ( ( ( pxMeasurement->ulBytes % ulMilliseconds ) * 8UL ) / ulMilliseconds );
+	}
+
+	pxReport->usCpuLoad = iperfCPU_LOAD_UNKNOWN;
+	#if configGENERATE_RUN_TIME_STATS == 1
+	{
+	portRUN_TIME_COUNTER_TYPE ulIdle, ulTotal;
+
+		ulIdle = ulTaskGetIdleRunTimeCounter() - pxMeasurement->ulIdleStart;
+		iperfGET_RUN_TIME( ulTotal );
+		ulTotal -= pxMeasurement->ulTotalStart;
+
+		/* The idle time is summed over all the cores.  Scale the total to
+		tenths of a percent first so the division cannot overflow. */
+		ulTotal = ( ulTotal / 1000UL ) * configNUMBER_OF_CORES;
+		if( ulTotal != 0UL )
+		{
+			ulIdle /= ulTotal;
+			pxReport->usCpuLoad = ( unsigned short ) ( ( ulIdle < 1000UL ) ? ( 1000UL - ulIdle ) : 0UL );
+		}
+	}
+	#endif
+
+	#if LWIP_STATS
+	{
+		#if LINK_STATS
+			prvCounterChange( &( pxReport->xLink ), &( pxMeasurement->xLink ), &( lwip_stats.link ) );
+		#endif
+		#if IP_STATS
+			prvCounterChange( &( pxReport->xIP ), &( pxMeasurement->xIP ), &( lwip_stats.ip ) );
+		#endif
+		#if TCP_STATS
+			prvCounterChange( &( pxReport->xTCP ), &( pxMeasurement->xTCP ), &( lwip_stats.tcp ) );
+		#endif
+		#if UDP_STATS
+			prvCounterChange( &( pxReport->xUDP ), &( pxMeasurement->xUDP ), &( lwip_stats.udp ) );
+		#endif
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,146 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef IPERF_H
+#define IPERF_H
+
+/*
+ * A throughput benchmark for lwIP that can be driven by a standard iperf 2
+ * installation on a PC, so the numbers can be compared between boards, NICs
+ * and stack configurations without writing any host software.
+ *
+ * vIperfServerInit() starts a TCP server and a UDP server on iperfPORT,
+ * both written to the raw API so they measure the stack and driver rather
+ * than the cost of passing data between tasks:
+ *
+ *   iperf -c <board IP> -t 10                  for TCP.
+ *   iperf -c <board IP> -u -b 20M -t 10        for UDP.  The loss, out of
+ *                                              order and jitter figures are
+ *                                              returned to the PC in the
+ *                                              iperf server report.
+ *
+ * xIperfClientStart() creates a task that uses the netconn API to send TCP
+ * data to "iperf -s" running on a PC for a given number of seconds.
+ *
+ * Each test that completes is described by an xIperfReport, which is passed
+ * to the callback given to the start function.  As well as the throughput it
+ * holds the CPU load over the test, taken from the idle task run time when
+ * configGENERATE_RUN_TIME_STATS is 1, and how much the lwIP stats.c counters
+ * changed over the test.  The servers call the callback from the tcpip
+ * thread, so it must not block for long.
+ *
+ * NO_SYS must be 0, and LWIP_TCP and LWIP_UDP must be 1.  Only one test of
+ * each kind runs at a time - for example "iperf -P 2" gets the second
+ * connection refused.
+ */
+
+#include "FreeRTOS.h"
+#include "lwip/ip_addr.h"
+
+/* The port used by iperf when -p is not given. */
+#define iperfPORT					5001
+
+/* The value of usCpuLoad when configGENERATE_RUN_TIME_STATS is not 1. */
+#define iperfCPU_LOAD_UNKNOWN		0xffffU
+
+/* How much a group of lwIP counters changed during a test. */
+typedef struct xIPERF_COUNTERS
+{
+	unsigned long ulXmit;
+	unsigned long ulRecv;
+	unsigned long ulDrop;
+} xIperfCounters;
+
+typedef struct xIPERF_REPORT
+{
+	const char *pcTest;					/* "TCP server", "UDP server" or "TCP client". */
+	portBASE_TYPE xAborted;				/* pdTRUE if the connection failed before the test ended. */
+	unsigned long ulBytes;				/* Payload bytes transferred, including the iperf headers. */
+	unsigned long ulMilliseconds;		/* Time from the first to the last byte. */
+	unsigned long ulKbitsPerSecond;		/* ulBytes over ulMilliseconds. */
+	unsigned short usCpuLoad;			/* Tenths of a percent, or iperfCPU_LOAD_UNKNOWN. */
+
+	/* UDP tests only. */
+	unsigned long ulDatagrams;			/* Datagrams sent by the client. */
+	unsigned long ulLost;				/* Datagrams that did not arrive. */
+	unsigned long ulOutOfOrder;			/* Datagrams that arrived late. */
+	unsigned long ulJitterMicroseconds;	/* RFC 1889 inter-arrival jitter. */
+
+	/* Left at zero unless LWIP_STATS and the statistics of the layer are
+	enabled in lwipopts.h.  Counted over the whole stack, not just the test. */
+	xIperfCounters xLink;
+	xIperfCounters xIP;
+	xIperfCounters xTCP;
+	xIperfCounters xUDP;
+} xIperfReport;
+
+typedef void ( * pdIPERF_REPORT_CALLBACK )( const xIperfReport *pxReport );
+
+/*
+ * Start the TCP and UDP servers.  Must be called from the tcpip thread, for
+ * example from the tcpip_init() done callback.  pxReport can be NULL if the
+ * results are only wanted on the PC.
+ */
+void vIperfServerInit( pdIPERF_REPORT_CALLBACK pxReport );
+
+/*
+ * Create a task that connects to iperfPORT on pxServer, sends data for
+ * ulSeconds seconds, passes the result to pxReport, then deletes itself.
+ * Returns pdFAIL if a client test is already running or the task could not
+ * be created.
+ */
+portBASE_TYPE xIperfClientStart( ip_addr_t *pxServer, unsigned long ulSeconds, unsigned portBASE_TYPE uxPriority, pdIPERF_REPORT_CALLBACK pxReport );
+
+#endif /* IPERF_H */
+
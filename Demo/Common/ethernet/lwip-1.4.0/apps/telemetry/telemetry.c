@@ -0,0 +1,536 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Sends the kernel and lwIP counters to a collector as binary UDP datagrams.
+ * See telemetry.h for the datagram layout.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/api.h"
+#include "lwip/stats.h"
+
+#include "telemetry.h"
+
+#if NO_SYS || !LWIP_UDP || !LWIP_NETCONN
+	#error telemetry needs NO_SYS 0, and LWIP_UDP and LWIP_NETCONN 1.
+#endif
+
+#if configUSE_TRACE_FACILITY != 1
+	#error telemetry needs configUSE_TRACE_FACILITY to be set to 1 in FreeRTOSConfig.h.
+#endif
+
+/* The size of the datagram buffer, which is the largest datagram sent.  It
+should fit in one frame, so datagrams are not fragmented by IP. */
+#ifndef telemetryDATAGRAM_SIZE
+	#define telemetryDATAGRAM_SIZE		512
+#endif
+
+/* The longest task or queue name sent.  Longer names are truncated. */
+#ifndef telemetryMAX_NAME_LENGTH
+	#define telemetryMAX_NAME_LENGTH	configMAX_TASK_NAME_LEN
+#endif
+
+#ifndef telemetrySTACK_SIZE
+	#define telemetrySTACK_SIZE			( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+/* Only heap_4 and heap_5 keep the low water mark of the heap, so by default
+it is reported as zero.  Define this as xPortGetMinimumEverFreeHeapSize() in
+lwipopts.h when one of those is used. */
+#ifndef telemetryMINIMUM_EVER_FREE_HEAP_SIZE
+	#define telemetryMINIMUM_EVER_FREE_HEAP_SIZE()	( 0UL )
+#endif
+
+/* The total run time is read the same way as the run time stats. */
+#if configGENERATE_RUN_TIME_STATS == 1
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define telemetryGET_RUN_TIME( ulTime )		portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulTime ) )
+	#else
+		#define telemetryGET_RUN_TIME( ulTime )		( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+#endif
+
+/* Sizes of the parts of a datagram, see telemetry.h. */
+#define telemetryHEADER_LENGTH			12
+#define telemetryRECORD_HEADER_LENGTH	2
+#define telemetrySYSTEM_LENGTH			22
+#define telemetryTASK_LENGTH			19
+#define telemetryQUEUE_LENGTH			20
+#define telemetryPROTOCOL_LENGTH		45
+#define telemetryMEMORY_LENGTH			17
+
+#if ( telemetryDATAGRAM_SIZE < ( telemetryHEADER_LENGTH + telemetryRECORD_HEADER_LENGTH + telemetryPROTOCOL_LENGTH ) ) || ( telemetryDATAGRAM_SIZE < ( telemetryHEADER_LENGTH + telemetryRECORD_HEADER_LENGTH + telemetryQUEUE_LENGTH + telemetryMAX_NAME_LENGTH ) )
+	#error telemetryDATAGRAM_SIZE is too small to hold the largest record.
+#endif
+
+#if ( telemetryQUEUE_LENGTH + telemetryMAX_NAME_LENGTH ) > 255
+	#error telemetryMAX_NAME_LENGTH is too long for the one byte record length.
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that takes and sends the samples.
+ */
+static void prvTelemetryTask( void *pvParameters );
+
+/*
+ * Add the records of each kind to the datagram.
+ */
+static void prvAddSystemRecord( void );
+static void prvAddTaskRecords( void );
+#if configQUEUE_REGISTRY_SIZE > 0
+	static void prvAddQueueRecords( void );
+#endif
+#if LWIP_STATS
+	static void prvAddProtocolRecord( unsigned char ucLayer, const struct stats_proto *pxStats );
+	static void prvAddMemoryRecord( unsigned char ucPool, const struct stats_mem *pxStats );
+#endif
+
+/*
+ * Reserve space for a record with a body of uxLength bytes, first sending the
+ * datagram if it is too full to hold it, and return a pointer to the body.
+ */
+static unsigned char *prvStartRecord( unsigned char ucType, size_t uxLength );
+
+/*
+ * Send what has been added to the datagram, then start the next one.
+ */
+static void prvSendDatagram( unsigned char ucFlags );
+
+/*
+ * Write a big endian value to pucTo, and return the byte after it.
+ */
+static unsigned char *prvPut16( unsigned char *pucTo, unsigned long ulValue );
+static unsigned char *prvPut32( unsigned char *pucTo, unsigned long ulValue );
+
+/*
+ * Copy up to telemetryMAX_NAME_LENGTH characters of pcName to pucTo, without
+ * the terminating null, and return the number copied.  pucTo may be NULL to
+ * obtain the length only.
+ */
+static size_t prvPutName( unsigned char *pucTo, const signed char *pcName );
+
+/*-----------------------------------------------------------*/
+
+/* The datagram being built. */
+static unsigned char ucDatagram[ telemetryDATAGRAM_SIZE ];
+static size_t uxDatagramLength = 0;
+static unsigned short usDatagramNumber = 0;
+static unsigned long ulSequence = 0UL;
+
+/* The snapshots are large when the jitter, latency or contention statistics
+are enabled, so are kept off the stack of the task. */
+static xTaskStatusType xTaskStatus;
+#if configQUEUE_REGISTRY_SIZE > 0
+	static xQueueStatusType xQueueStatus[ configQUEUE_REGISTRY_SIZE ];
+#endif
+
+/* Where and how often the samples are sent. */
+static struct netconn *pxTelemetryConnection = NULL;
+static struct netbuf *pxTelemetryBuffer = NULL;
+static ip_addr_t xTelemetryCollector;
+static unsigned short usTelemetryPort = 0;
+static portTickType xTelemetryPeriod = 0;
+static portBASE_TYPE xTelemetryRunning = pdFALSE;
+
+static volatile unsigned long ulSendFailures = 0UL;
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTelemetryStart( ip_addr_t *pxCollector, unsigned short usPort, portTickType xPeriod, unsigned portBASE_TYPE uxPriority )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	taskENTER_CRITICAL();
+	{
+		if( xTelemetryRunning == pdFALSE )
+		{
+			xTelemetryRunning = pdTRUE;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xReturn == pdPASS )
+	{
+		ip_addr_copy( xTelemetryCollector, *pxCollector );
+		usTelemetryPort = usPort;
+		xTelemetryPeriod = ( xPeriod != ( portTickType ) 0 ) ? xPeriod : ( portTickType ) 1;
+
+		if( xTaskCreate( prvTelemetryTask, ( signed char * ) "Telem", telemetrySTACK_SIZE, NULL, uxPriority, NULL ) != pdPASS )
+		{
+			xTelemetryRunning = pdFALSE;
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulTelemetryGetSendFailures( void )
+{
+	return ulSendFailures;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTelemetryTask( void *pvParameters )
+{
+portTickType xLastSample;
+#if LWIP_STATS && MEMP_STATS
+	unsigned portBASE_TYPE uxPool;
+#endif
+
+	( void ) pvParameters;
+
+	/* The connection and netbuf are created once and used for every sample.
+	If either cannot be created there is nothing the task can do. */
+	pxTelemetryConnection = netconn_new( NETCONN_UDP );
+	pxTelemetryBuffer = netbuf_new();
+	if( ( pxTelemetryConnection == NULL ) || ( pxTelemetryBuffer == NULL ) )
+	{
+		if( pxTelemetryConnection != NULL )
+		{
+			netconn_delete( pxTelemetryConnection );
+		}
+
+		if( pxTelemetryBuffer != NULL )
+		{
+			netbuf_delete( pxTelemetryBuffer );
+		}
+
+		xTelemetryRunning = pdFALSE;
+		vTaskDelete( NULL );
+		return;
+	}
+
+	uxDatagramLength = telemetryHEADER_LENGTH;
+	xLastSample = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastSample, xTelemetryPeriod );
+
+		prvAddSystemRecord();
+		prvAddTaskRecords();
+
+		#if configQUEUE_REGISTRY_SIZE > 0
+		{
+			prvAddQueueRecords();
+		}
+		#endif
+
+		/* The lwIP counters are read without locking the stack.  A counter
+		that is part way through being updated by the tcpip thread is at worst
+		one count out, which the next sample corrects. */
+		#if LWIP_STATS
+		{
+			#if LINK_STATS
+				prvAddProtocolRecord( telemetryLAYER_LINK, &( lwip_stats.link ) );
+			#endif
+			#if ETHARP_STATS
+				prvAddProtocolRecord( telemetryLAYER_ETHARP, &( lwip_stats.etharp ) );
+			#endif
+			#if IPFRAG_STATS
+				prvAddProtocolRecord( telemetryLAYER_IP_FRAG, &( lwip_stats.ip_frag ) );
+			#endif
+			#if IP_STATS
+				prvAddProtocolRecord( telemetryLAYER_IP, &( lwip_stats.ip ) );
+			#endif
+			#if ICMP_STATS
+				prvAddProtocolRecord( telemetryLAYER_ICMP, &( lwip_stats.icmp ) );
+			#endif
+			#if UDP_STATS
+				prvAddProtocolRecord( telemetryLAYER_UDP, &( lwip_stats.udp ) );
+			#endif
+			#if TCP_STATS
+				prvAddProtocolRecord( telemetryLAYER_TCP, &( lwip_stats.tcp ) );
+			#endif
+			#if MEM_STATS
+				prvAddMemoryRecord( ( unsigned char ) telemetryLWIP_HEAP, &( lwip_stats.mem ) );
+			#endif
+			#if MEMP_STATS
+				for( uxPool = 0; uxPool < ( unsigned portBASE_TYPE ) MEMP_MAX; uxPool++ )
+				{
+					prvAddMemoryRecord( ( unsigned char ) uxPool, &( lwip_stats.memp[ uxPool ] ) );
+				}
+			#endif
+		}
+		#endif
+
+		prvSendDatagram( telemetryFLAG_LAST_DATAGRAM );
+
+		usDatagramNumber = 0;
+		ulSequence++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddSystemRecord( void )
+{
+unsigned char *pucBody;
+portRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0;
+
+	#if configGENERATE_RUN_TIME_STATS == 1
+	{
+		telemetryGET_RUN_TIME( ulTotalRunTime );
+	}
+	#endif
+
+	pucBody = prvStartRecord( telemetryRECORD_SYSTEM, telemetrySYSTEM_LENGTH );
+	pucBody = prvPut32( pucBody, ( unsigned long ) xTaskGetTickCount() );
+	pucBody = prvPut32( pucBody, ( unsigned long ) configTICK_RATE_HZ );
+	pucBody = prvPut32( pucBody, ( unsigned long ) ulTotalRunTime );
+	pucBody = prvPut32( pucBody, ( unsigned long ) xPortGetFreeHeapSize() );
+	pucBody = prvPut32( pucBody, ( unsigned long ) telemetryMINIMUM_EVER_FREE_HEAP_SIZE() );
+	( void ) prvPut16( pucBody, ( unsigned long ) uxTaskGetNumberOfTasks() );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddTaskRecords( void )
+{
+unsigned portBASE_TYPE uxCursor = 0;
+unsigned char *pucBody;
+size_t uxNameLength;
+
+	/* Each call suspends the scheduler for one pass over the task lists, so
+	the walk does not hold up the application for the whole sample. */
+	while( xTaskGetNextTaskStatus( &uxCursor, &xTaskStatus, NULL ) == pdTRUE )
+	{
+		uxNameLength = prvPutName( NULL, xTaskStatus.pcTaskName );
+
+		pucBody = prvStartRecord( telemetryRECORD_TASK, telemetryTASK_LENGTH + uxNameLength );
+		pucBody = prvPut16( pucBody, ( unsigned long ) xTaskStatus.uxTaskNumber );
+		*pucBody++ = ( unsigned char ) xTaskStatus.eCurrentState;
+		*pucBody++ = ( unsigned char ) xTaskStatus.uxCurrentPriority;
+		*pucBody++ = ( unsigned char ) xTaskStatus.uxBasePriority;
+		pucBody = prvPut16( pucBody, ( unsigned long ) xTaskStatus.usStackHighWaterMark );
+		pucBody = prvPut32( pucBody, ( unsigned long ) xTaskStatus.ulRunTimeCounter );
+		pucBody = prvPut32( pucBody, xTaskStatus.ulSwitchInCount );
+		pucBody = prvPut32( pucBody, ( unsigned long ) xTaskStatus.xMaxBlockTime );
+		( void ) prvPutName( pucBody, xTaskStatus.pcTaskName );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if configQUEUE_REGISTRY_SIZE > 0
+
+	static void prvAddQueueRecords( void )
+	{
+	unsigned portBASE_TYPE uxQueues, uxQueue;
+	xQueueStatusType *pxStatus;
+	unsigned char *pucBody;
+	size_t uxNameLength;
+
+		uxQueues = uxQueueGetSystemState( xQueueStatus, ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE );
+
+		for( uxQueue = 0; uxQueue < uxQueues; uxQueue++ )
+		{
+			pxStatus = &( xQueueStatus[ uxQueue ] );
+			uxNameLength = prvPutName( NULL, pxStatus->pcQueueName );
+
+			pucBody = prvStartRecord( telemetryRECORD_QUEUE, telemetryQUEUE_LENGTH + uxNameLength );
+			*pucBody++ = pxStatus->ucQueueNumber;
+			*pucBody++ = pxStatus->ucQueueType;
+			pucBody = prvPut16( pucBody, ( unsigned long ) pxStatus->uxLength );
+			pucBody = prvPut16( pucBody, ( unsigned long ) pxStatus->uxMessagesWaiting );
+			pucBody = prvPut16( pucBody, ( unsigned long ) pxStatus->uxPeakMessagesWaiting );
+			pucBody = prvPut32( pucBody, pxStatus->ulSendCount );
+			pucBody = prvPut32( pucBody, pxStatus->ulReceiveCount );
+			pucBody = prvPut32( pucBody, pxStatus->ulSendFailCount );
+			( void ) prvPutName( pucBody, pxStatus->pcQueueName );
+		}
+	}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if LWIP_STATS
+
+	static void prvAddProtocolRecord( unsigned char ucLayer, const struct stats_proto *pxStats )
+	{
+	unsigned char *pucBody;
+
+		pucBody = prvStartRecord( telemetryRECORD_PROTOCOL, telemetryPROTOCOL_LENGTH );
+		*pucBody++ = ucLayer;
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->xmit );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->recv );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->fw );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->drop );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->chkerr );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->lenerr );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->memerr );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->rterr );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->proterr );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->opterr );
+		( void ) prvPut32( pucBody, ( unsigned long ) pxStats->err );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvAddMemoryRecord( unsigned char ucPool, const struct stats_mem *pxStats )
+	{
+	unsigned char *pucBody;
+
+		pucBody = prvStartRecord( telemetryRECORD_MEMORY, telemetryMEMORY_LENGTH );
+		*pucBody++ = ucPool;
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->avail );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->used );
+		pucBody = prvPut32( pucBody, ( unsigned long ) pxStats->max );
+		( void ) prvPut32( pucBody, ( unsigned long ) pxStats->err );
+	}
+
+#endif /* LWIP_STATS */
+/*-----------------------------------------------------------*/
+
+static unsigned char *prvStartRecord( unsigned char ucType, size_t uxLength )
+{
+unsigned char *pucRecord;
+
+	if( ( uxDatagramLength + telemetryRECORD_HEADER_LENGTH + uxLength ) > sizeof( ucDatagram ) )
+	{
+		prvSendDatagram( 0U );
+	}
+
+	pucRecord = &( ucDatagram[ uxDatagramLength ] );
+	pucRecord[ 0 ] = ucType;
+	pucRecord[ 1 ] = ( unsigned char ) uxLength;
+	uxDatagramLength += telemetryRECORD_HEADER_LENGTH + uxLength;
+
+	return &( pucRecord[ telemetryRECORD_HEADER_LENGTH ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendDatagram( unsigned char ucFlags )
+{
+unsigned char *pucHeader = ucDatagram;
+
+	*pucHeader++ = ( unsigned char ) 'F';
+	*pucHeader++ = ( unsigned char ) 'R';
+	*pucHeader++ = ( unsigned char ) 'T';
+	*pucHeader++ = ( unsigned char ) 'M';
+	*pucHeader++ = ( unsigned char ) telemetryVERSION;
+	*pucHeader++ = ucFlags;
+	pucHeader = prvPut16( pucHeader, ( unsigned long ) usDatagramNumber );
+	( void ) prvPut32( pucHeader, ulSequence );
+
+	/* netconn_sendto() does not return until the tcpip thread has passed the
+	datagram to the driver, so the buffer can be refilled straight away. */
+	if( netbuf_ref( pxTelemetryBuffer, ucDatagram, ( u16_t ) uxDatagramLength ) == ERR_OK )
+	{
+		if( netconn_sendto( pxTelemetryConnection, pxTelemetryBuffer, &xTelemetryCollector, usTelemetryPort ) != ERR_OK )
+		{
+			ulSendFailures++;
+		}
+	}
+	else
+	{
+		ulSendFailures++;
+	}
+
+	usDatagramNumber++;
+	uxDatagramLength = telemetryHEADER_LENGTH;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char *prvPut16( unsigned char *pucTo, unsigned long ulValue )
+{
+	pucTo[ 0 ] = ( unsigned char ) ( ulValue >> 8 );
+	pucTo[ 1 ] = ( unsigned char ) ulValue;
+
+	return pucTo + 2;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char *prvPut32( unsigned char *pucTo, unsigned long ulValue )
+{
+	pucTo[ 0 ] = ( unsigned char ) ( ulValue >> 24 );
+	pucTo[ 1 ] = ( unsigned char ) ( ulValue >> 16 );
+	pucTo[ 2 ] = ( unsigned char ) ( ulValue >> 8 );
+	pucTo[ 3 ] = ( unsigned char ) ulValue;
+
+	return pucTo + 4;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvPutName( unsigned char *pucTo, const signed char *pcName )
+{
+size_t uxLength = 0;
+
+	if( pcName != NULL )
+	{
+		while( ( uxLength < ( size_t ) telemetryMAX_NAME_LENGTH ) && ( pcName[ uxLength ] != ( signed char ) '\0' ) )
+		{
+			if( pucTo != NULL )
+			{
+				pucTo[ uxLength ] = ( unsigned char ) pcName[ uxLength ];
+			}
+
+			uxLength++;
+		}
+	}
+
+	return uxLength;
+}
+/*-----------------------------------------------------------*/
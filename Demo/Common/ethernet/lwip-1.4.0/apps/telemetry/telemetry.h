@@ -0,0 +1,197 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/*
+ * A telemetry service that sends the structured kernel and stack counters to
+ * a collector as compact binary UDP datagrams, as a cheaper alternative to
+ * scraping the text produced by vTaskList() and vTaskGetRunTimeStats() from
+ * the web server.  Nothing is formatted as text on the target.
+ *
+ * xTelemetryStart() creates a task that wakes every xPeriod ticks, takes a
+ * sample and sends it to the collector.  The sample is built in one static
+ * datagram buffer of telemetryDATAGRAM_SIZE bytes, and the only memory lwIP
+ * allocates to send it is the reference pbuf that points at the buffer.  A
+ * sample that does not fit in one datagram is sent as several, all with the
+ * same sequence number.
+ *
+ * Every field is an unsigned big endian integer.  Each datagram starts with
+ * this header:
+ *
+ *   offset  size
+ *        0     4   "FRTM"
+ *        4     1   telemetryVERSION
+ *        5     1   Flags - telemetryFLAG_LAST_DATAGRAM is set in the last
+ *                  datagram of a sample.
+ *        6     2   The number of the datagram within the sample, from 0.
+ *        8     4   The sequence number of the sample, from 0.
+ *
+ * The header is followed by records.  Each record is a one byte type, a one
+ * byte length of the body that follows, then the body, so a collector can
+ * skip over records it does not know.  Fields may be added to the end of a
+ * record body without changing telemetryVERSION.
+ *
+ * telemetryRECORD_SYSTEM, the first record of every sample:
+ *        0     4   xTaskGetTickCount().
+ *        4     4   configTICK_RATE_HZ.
+ *        8     4   The total run time counter, or 0 if
+ *                  configGENERATE_RUN_TIME_STATS is 0.
+ *       12     4   xPortGetFreeHeapSize().
+ *       16     4   telemetryMINIMUM_EVER_FREE_HEAP_SIZE(), see below.
+ *       20     2   uxTaskGetNumberOfTasks().
+ *
+ * telemetryRECORD_TASK, one per task, from xTaskGetNextTaskStatus():
+ *        0     2   uxTaskNumber.
+ *        2     1   eCurrentState.
+ *        3     1   uxCurrentPriority.
+ *        4     1   uxBasePriority.
+ *        5     2   usStackHighWaterMark, in words.
+ *        7     4   ulRunTimeCounter.
+ *       11     4   ulSwitchInCount.
+ *       15     4   xMaxBlockTime.
+ *       19     n   The task name, without the terminating null.  n is the
+ *                  record length less 19.
+ *
+ * telemetryRECORD_QUEUE, one per queue in the queue registry, from
+ * uxQueueGetSystemState():
+ *        0     1   ucQueueNumber.
+ *        1     1   ucQueueType.
+ *        2     2   uxLength.
+ *        4     2   uxMessagesWaiting.
+ *        6     2   uxPeakMessagesWaiting.
+ *        8     4   ulSendCount.
+ *       12     4   ulReceiveCount.
+ *       16     4   ulSendFailCount.
+ *       20     n   The registry name, without the terminating null.
+ *
+ * telemetryRECORD_PROTOCOL, one per lwIP protocol layer that has statistics
+ * enabled in lwipopts.h:
+ *        0     1   The layer, telemetryLAYER_LINK to telemetryLAYER_TCP.
+ *        1    44   The xmit, recv, fw, drop, chkerr, lenerr, memerr, rterr,
+ *                  proterr, opterr and err members of struct stats_proto,
+ *                  four bytes each.
+ *
+ * telemetryRECORD_MEMORY, one for the lwIP heap if MEM_STATS is 1 and one per
+ * memp pool if MEMP_STATS is 1:
+ *        0     1   telemetryLWIP_HEAP, or the memp_t of the pool.
+ *        1     4   avail.
+ *        5     4   used.
+ *        9     4   max.
+ *       13     4   err.
+ *
+ * Counters are sent as the kernel and stack hold them, so they wrap as they
+ * do on the target and the collector works out rates from the difference
+ * between samples.
+ *
+ * configUSE_TRACE_FACILITY must be 1 in FreeRTOSConfig.h.  Queue records are
+ * only sent when configQUEUE_REGISTRY_SIZE is greater than 0, and only for
+ * queues that have been added to the registry.  NO_SYS must be 0 and
+ * LWIP_UDP and LWIP_NETCONN must be 1 in lwipopts.h.
+ *
+ * The datagrams are passed to lwIP by reference, so the netif driver must
+ * copy each frame out before its linkoutput function returns, which the
+ * drivers in this distribution all do.
+ */
+
+#include "FreeRTOS.h"
+#include "lwip/ip_addr.h"
+
+/* The version of the datagram layout described above. */
+#define telemetryVERSION				1
+
+/* The flags byte of the datagram header. */
+#define telemetryFLAG_LAST_DATAGRAM		0x01U
+
+/* Record types. */
+#define telemetryRECORD_SYSTEM			1
+#define telemetryRECORD_TASK			2
+#define telemetryRECORD_QUEUE			3
+#define telemetryRECORD_PROTOCOL		4
+#define telemetryRECORD_MEMORY			5
+
+/* The layers reported in telemetryRECORD_PROTOCOL records. */
+#define telemetryLAYER_LINK				1
+#define telemetryLAYER_ETHARP			2
+#define telemetryLAYER_IP_FRAG			3
+#define telemetryLAYER_IP				4
+#define telemetryLAYER_ICMP				5
+#define telemetryLAYER_UDP				6
+#define telemetryLAYER_TCP				7
+
+/* The pool number of the lwIP heap in telemetryRECORD_MEMORY records. */
+#define telemetryLWIP_HEAP				0xff
+
+/* The port the collector is normally listening on. */
+#define telemetryPORT					5140
+
+/*
+ * Create the telemetry task, which sends a sample to usPort on pxCollector
+ * every xPeriod ticks and runs at priority uxPriority.  The task should
+ * normally run at a low priority so that taking the samples does not delay
+ * the application - the counters it reads are updated without its help.
+ * Returns pdFAIL if the service is already running or the task could not be
+ * created.
+ */
+portBASE_TYPE xTelemetryStart( ip_addr_t *pxCollector, unsigned short usPort, portTickType xPeriod, unsigned portBASE_TYPE uxPriority );
+
+/*
+ * The number of datagrams that lwIP failed to send, for example because no
+ * netbuf or pbuf was free.  A failed datagram is not retried, and the rest of
+ * the sample is still sent.
+ */
+unsigned long ulTelemetryGetSendFailures( void );
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,204 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The lwIP serial IO interface (lwip/sio.h), as used by PPP over serial and
+ * SLIP, implemented on top of the block transfer functions declared in
+ * Demo/Common/include/serial.h.  usSerialWrite() and usSerialRead() move
+ * whole buffers to and from the stream buffers of the DMA serial drivers, so
+ * a PPP frame is handed to the driver in one call, and the PPP receive
+ * thread gets everything that arrived since it last ran instead of one
+ * character per queue operation.
+ *
+ * The drivers only provide one port, so sio_open() only accepts device
+ * number 0.  The baud rate and the size of the driver buffers are set by
+ * sioBAUD_RATE and sioBUFFER_LENGTH, which can be defined in lwipopts.h.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "serial.h"
+
+/* lwIP includes. */
+#include "lwip/opt.h"
+#include "lwip/sio.h"
+
+#ifndef sioBAUD_RATE
+	#define sioBAUD_RATE			115200UL
+#endif
+
+#ifndef sioBUFFER_LENGTH
+	#define sioBUFFER_LENGTH		( 2 * 1500 )
+#endif
+
+/* sio_read() wakes this often to see if sio_read_abort() has been called. */
+#define sioABORT_POLL_TIME			( 100 / portTICK_RATE_MS )
+
+/* usSerialWrite() and usSerialRead() take an unsigned short length. */
+#define sioMAX_TRANSFER				0xffffUL
+
+typedef struct xSIO_PORT
+{
+	xComPortHandle xPort;
+	volatile portBASE_TYPE xAbortRead;
+} xSioPort;
+
+static xSioPort xSioPort0 = { NULL, pdFALSE };
+static portBASE_TYPE xSioOpen = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+sio_fd_t sio_open( u8_t ucDevice )
+{
+	if( ucDevice != 0 )
+	{
+		return NULL;
+	}
+
+	if( xSioOpen == pdFALSE )
+	{
+		xSioPort0.xPort = xSerialPortInitMinimal( sioBAUD_RATE, sioBUFFER_LENGTH );
+		xSioOpen = pdTRUE;
+	}
+
+	return ( sio_fd_t ) &xSioPort0;
+}
+/*-----------------------------------------------------------*/
+
+u32_t sio_write( sio_fd_t xFd, u8_t *pucData, u32_t ulLength )
+{
+xSioPort *pxSio = ( xSioPort * ) xFd;
+u32_t ulSent = 0;
+unsigned short usChunk;
+
+	/* Block until everything has been queued, as sio.h requires. */
+	while( ulSent < ulLength )
+	{
+		usChunk = ( unsigned short ) ( ( ( ulLength - ulSent ) > sioMAX_TRANSFER ) ? sioMAX_TRANSFER : ( ulLength - ulSent ) );
+		ulSent += usSerialWrite( pxSio->xPort, ( const signed char * ) ( pucData + ulSent ), usChunk, portMAX_DELAY );
+	}
+
+	return ulSent;
+}
+/*-----------------------------------------------------------*/
+
+u32_t sio_read( sio_fd_t xFd, u8_t *pucData, u32_t ulLength )
+{
+xSioPort *pxSio = ( xSioPort * ) xFd;
+unsigned short usReceived;
+
+	if( ulLength > sioMAX_TRANSFER )
+	{
+		ulLength = sioMAX_TRANSFER;
+	}
+
+	for( ;; )
+	{
+		usReceived = usSerialRead( pxSio->xPort, ( signed char * ) pucData, ( unsigned short ) ulLength, sioABORT_POLL_TIME );
+
+		if( usReceived != 0 )
+		{
+			return usReceived;
+		}
+
+		if( pxSio->xAbortRead != pdFALSE )
+		{
+			pxSio->xAbortRead = pdFALSE;
+			return 0;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+u32_t sio_tryread( sio_fd_t xFd, u8_t *pucData, u32_t ulLength )
+{
+xSioPort *pxSio = ( xSioPort * ) xFd;
+
+	if( ulLength > sioMAX_TRANSFER )
+	{
+		ulLength = sioMAX_TRANSFER;
+	}
+
+	return usSerialRead( pxSio->xPort, ( signed char * ) pucData, ( unsigned short ) ulLength, 0 );
+}
+/*-----------------------------------------------------------*/
+
+void sio_read_abort( sio_fd_t xFd )
+{
+	( ( xSioPort * ) xFd )->xAbortRead = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void sio_send( u8_t ucChar, sio_fd_t xFd )
+{
+	sio_write( xFd, &ucChar, 1 );
+}
+/*-----------------------------------------------------------*/
+
+u8_t sio_recv( sio_fd_t xFd )
+{
+u8_t ucChar;
+
+	while( sio_read( xFd, &ucChar, 1 ) == 0 )
+	{
+		/* Only an abort returns nothing - keep waiting. */
+	}
+
+	return ucChar;
+}
+/*-----------------------------------------------------------*/
+
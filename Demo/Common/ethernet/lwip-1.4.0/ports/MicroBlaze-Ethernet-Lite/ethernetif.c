@@ -69,6 +69,7 @@
 #include <lwip/stats.h>
 #include <lwip/snmp.h>
 #include "netif/etharp.h"
+#include "netif/pcapring.h"
 
 /* Define those to better describe your network interface. */
 #define IFNAME0 'e'
@@ -84,12 +85,47 @@
 
 #define netifMAX_MTU 1500
 
+/* The size of the buffers frames are received into. */
+#define netifRX_BUFFER_SIZE			( 1520 )
+
+/* The number of receive buffers that can be passed to the stack without their
+ * contents being copied.  The buffer is returned to the driver when the stack
+ * frees the pbuf that references it.  While all the buffers are held by the
+ * stack received frames are copied into pbufs from the pool, as they are when
+ * netifZERO_COPY_RX_BUFFERS is 0.
+ */
+#ifndef netifZERO_COPY_RX_BUFFERS
+	#if LWIP_SUPPORT_CUSTOM_PBUF
+		#define netifZERO_COPY_RX_BUFFERS	( 4 )
+	#else
+		#define netifZERO_COPY_RX_BUFFERS	( 0 )
+	#endif
+#endif
+
+#if ( netifZERO_COPY_RX_BUFFERS > 0 ) && !LWIP_SUPPORT_CUSTOM_PBUF
+	#error LWIP_SUPPORT_CUSTOM_PBUF must be set to 1 in lwipopts.h when netifZERO_COPY_RX_BUFFERS is not 0
+#endif
+
 struct xEthernetIf
 {
 	struct eth_addr *ethaddr;
 	/* Add whatever per-interface state that is needed here. */
 };
 
+#if netifZERO_COPY_RX_BUFFERS > 0
+
+	/* A receive buffer along with the custom pbuf used to pass it to the
+	stack.  xPbuf must be the first member so the pbuf passed to
+	prvRxBufferFree() can be converted back into the buffer. */
+	typedef struct xRX_BUFFER
+	{
+		struct pbuf_custom xPbuf;
+		struct xRX_BUFFER *pxNext;
+		unsigned char ucData[ netifRX_BUFFER_SIZE ] __attribute__((aligned(32)));
+	} xRxBuffer;
+
+#endif
+
 /*
  * Copy the received data into a pbuf.
  */
@@ -112,12 +148,48 @@ static void prvLowLevelInit( struct netif *pxNetIf );
 static void prvRxHandler( void *pvNetIf );
 static void prvTxHandler( void *pvUnused );
 
+#if netifZERO_COPY_RX_BUFFERS > 0
+
+	/*
+	 * Place all the receive buffers in the list of free buffers.
+	 */
+	static void prvInitialiseRxBuffers( void );
+
+	/*
+	 * Remove a buffer from the list of free receive buffers.  Returns NULL if
+	 * all the buffers are held by the stack.
+	 */
+	static xRxBuffer *prvTakeRxBuffer( void );
+
+	/*
+	 * Wrap a receive buffer that holds usDataLength bytes of a received frame
+	 * in a pbuf that references the buffer, rather than a copy of its contents.
+	 * If there is no data the buffer is returned to the free list and NULL is
+	 * returned.
+	 */
+	static struct pbuf *prvZeroCopyInput( xRxBuffer *pxRxBuffer, unsigned short usDataLength );
+
+	/*
+	 * Called by the stack when it frees a pbuf created by prvZeroCopyInput(),
+	 * returning the buffer to the list of free receive buffers.
+	 */
+	static void prvRxBufferFree( struct pbuf *p );
+
+#endif
 
 /*-----------------------------------------------------------*/
 
 /* The instance of the xEmacLite IP being used in this driver. */
 static XEmacLite xEMACInstance;
 
+#if netifZERO_COPY_RX_BUFFERS > 0
+
+	/* The receive buffers, and the list of those not held by the stack. */
+	static xRxBuffer xRxBuffers[ netifZERO_COPY_RX_BUFFERS ];
+	static xRxBuffer *pxFreeRxBuffers = NULL;
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -159,6 +231,12 @@ unsigned portBASE_TYPE uxOriginalPriority;
 	/* Broadcast capability */
 	pxNetIf->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
 
+	#if netifZERO_COPY_RX_BUFFERS > 0
+	{
+		prvInitialiseRxBuffers();
+	}
+	#endif
+
 	/* Initialize the mac */
 	xStatus = XEmacLite_Initialize( &xEMACInstance, XPAR_EMACLITE_0_DEVICE_ID );
 
@@ -299,6 +377,11 @@ long x;
 		else
 		{
 			LINK_STATS_INC( link.xmit );
+			#if LWIP_PCAPRING
+			{
+				pcapring_record( p );
+			}
+			#endif
 			snmp_add_ifoutoctets( pxNetIf, usTotalLength );
 			pxHeader = ( struct eth_hdr * )p->payload;
 
@@ -337,7 +420,13 @@ struct pbuf *p = NULL, *q;
 		#endif
 
 		/* We allocate a pbuf chain of pbufs from the pool. */
-		p = pbuf_alloc( PBUF_RAW, usDataLength, PBUF_POOL );
+		#if PBUF_POOL_CLASSES
+			/* Classify the frame before it is copied, so bulk traffic cannot
+			take the buffers reserved for ARP, ICMP and high priority flows. */
+			p = pbuf_alloc_class( PBUF_RAW, ( u16_t ) usDataLength, pbuf_rx_class( pucInputData, ( u16_t ) usDataLength ) );
+		#else
+			p = pbuf_alloc( PBUF_RAW, usDataLength, PBUF_POOL );
+		#endif
   
 		if( p != NULL ) 
 		{
@@ -443,9 +532,12 @@ static void prvRxHandler( void *pvNetIf )
 struct eth_hdr *pxHeader;
 struct pbuf *p;
 unsigned short usInputLength;
-static unsigned char ucBuffer[ 1520 ] __attribute__((aligned(32)));
+static unsigned char ucBuffer[ netifRX_BUFFER_SIZE ] __attribute__((aligned(32)));
 extern portBASE_TYPE xInsideISR;
 struct netif *pxNetIf = ( struct netif * ) pvNetIf;
+#if netifZERO_COPY_RX_BUFFERS > 0
+	xRxBuffer *pxRxBuffer;
+#endif
 
 	XIntc_AckIntr( XPAR_ETHERNET_LITE_BASEADDR, XPAR_ETHERNET_LITE_IP2INTC_IRPT_MASK );
 
@@ -453,14 +545,44 @@ struct netif *pxNetIf = ( struct netif * ) pvNetIf;
 	sections. */
 	xInsideISR++;
 
-	usInputLength = ( long ) XEmacLite_Recv( &xEMACInstance, ucBuffer );
+	#if netifZERO_COPY_RX_BUFFERS > 0
+	{
+		/* Receive directly into a buffer that can be passed to the stack, if
+		one is free. */
+		pxRxBuffer = prvTakeRxBuffer();
+		if( pxRxBuffer != NULL )
+		{
+			usInputLength = ( unsigned short ) XEmacLite_Recv( &xEMACInstance, &( pxRxBuffer->ucData[ ETH_PAD_SIZE ] ) );
+			p = prvZeroCopyInput( pxRxBuffer, usInputLength );
+		}
+		else
+		{
+			usInputLength = ( long ) XEmacLite_Recv( &xEMACInstance, ucBuffer );
+			p = prvLowLevelInput( ucBuffer, usInputLength );
+		}
+	}
+	#else
+	{
+		usInputLength = ( long ) XEmacLite_Recv( &xEMACInstance, ucBuffer );
 
-	/* move received packet into a new pbuf */
-	p = prvLowLevelInput( ucBuffer, usInputLength );
+		/* move received packet into a new pbuf */
+		p = prvLowLevelInput( ucBuffer, usInputLength );
+	}
+	#endif
 
 	/* no packet could be read, silently ignore this */
 	if( p != NULL )
 	{
+		#if LWIP_PCAPRING
+		{
+			/* SYS_ARCH_PROTECT does nothing while xInsideISR is set.  That is
+			safe because tasks record frames from inside a critical section,
+			so cannot be part way through a record when this interrupt runs.
+			PCAPRING_TIME_MS() is defined in lwipopts.h to be interrupt safe. */
+			pcapring_record( p );
+		}
+		#endif
+
 		/* points to packet payload, which starts with an Ethernet header */
 		pxHeader = p->payload;
 
@@ -494,6 +616,88 @@ static void prvTxHandler( void *pvUnused )
 	( void ) pvUnused;
 	XIntc_AckIntr( XPAR_ETHERNET_LITE_BASEADDR, XPAR_ETHERNET_LITE_IP2INTC_IRPT_MASK );
 }
+/*-----------------------------------------------------------*/
+
+#if netifZERO_COPY_RX_BUFFERS > 0
+
+	static void prvInitialiseRxBuffers( void )
+	{
+	unsigned portBASE_TYPE ux;
+
+		pxFreeRxBuffers = NULL;
+
+		for( ux = 0; ux < ( unsigned portBASE_TYPE ) netifZERO_COPY_RX_BUFFERS; ux++ )
+		{
+			xRxBuffers[ ux ].xPbuf.custom_free_function = prvRxBufferFree;
+			xRxBuffers[ ux ].pxNext = pxFreeRxBuffers;
+			pxFreeRxBuffers = &( xRxBuffers[ ux ] );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static xRxBuffer *prvTakeRxBuffer( void )
+	{
+	xRxBuffer *pxRxBuffer;
+	SYS_ARCH_DECL_PROTECT( xProtection );
+
+		/* SYS_ARCH_PROTECT() does nothing when called from the Rx interrupt,
+		but is needed if this is ever called from a task. */
+		SYS_ARCH_PROTECT( xProtection );
+		{
+			pxRxBuffer = pxFreeRxBuffers;
+			if( pxRxBuffer != NULL )
+			{
+				pxFreeRxBuffers = pxRxBuffer->pxNext;
+			}
+		}
+		SYS_ARCH_UNPROTECT( xProtection );
+
+		return pxRxBuffer;
+	}
+	/*-----------------------------------------------------------*/
+
+	static struct pbuf *prvZeroCopyInput( xRxBuffer *pxRxBuffer, unsigned short usDataLength )
+	{
+	struct pbuf *p = NULL;
+
+		if( usDataLength > 0U )
+		{
+			/* The frame was received after the padding word, so the padding
+			is included in the pbuf in the same way as it is in a pbuf
+			allocated from the pool. */
+			p = pbuf_alloced_custom( PBUF_RAW, usDataLength + ETH_PAD_SIZE, PBUF_REF, &( pxRxBuffer->xPbuf ), pxRxBuffer->ucData, sizeof( pxRxBuffer->ucData ) );
+		}
+
+		if( p != NULL )
+		{
+			/* The stack now owns the buffer until it frees the pbuf. */
+			LINK_STATS_INC(link.recv);
+		}
+		else
+		{
+			prvRxBufferFree( &( pxRxBuffer->xPbuf.pbuf ) );
+		}
+
+		return p;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRxBufferFree( struct pbuf *p )
+	{
+	xRxBuffer *pxRxBuffer = ( xRxBuffer * ) p;
+	SYS_ARCH_DECL_PROTECT( xProtection );
+
+		/* This can be called from the Rx interrupt, if the stack rejects the
+		frame, as well as from the tcpip task. */
+		SYS_ARCH_PROTECT( xProtection );
+		{
+			pxRxBuffer->pxNext = pxFreeRxBuffers;
+			pxFreeRxBuffers = pxRxBuffer;
+		}
+		SYS_ARCH_UNPROTECT( xProtection );
+	}
+
+#endif /* netifZERO_COPY_RX_BUFFERS */
 
 
 
@@ -69,6 +69,7 @@
 #include <lwip/stats.h>
 #include <lwip/snmp.h>
 #include "netif/etharp.h"
+#include "netif/pcapring.h"
 
 /* Define those to better describe your network interface. */
 #define IFNAME0 'w'
@@ -76,6 +77,36 @@
 
 #define netifMAX_MTU 1500
 
+/* When configMAC_USE_CAPTURE_THREAD is 1 frames are captured by a native
+Windows thread that raises a simulated interrupt when it has frames for the
+stack, much as a real MAC would.  Otherwise the interrupt simulator task polls
+the interface. */
+#ifndef configMAC_USE_CAPTURE_THREAD
+	#define configMAC_USE_CAPTURE_THREAD 0
+#endif
+
+#if configMAC_USE_CAPTURE_THREAD == 1
+
+	/* The simulated interrupt raised by the capture thread.  Interrupts 0 to 2
+	are used by the kernel. */
+	#ifndef configMAC_INTERRUPT_NUMBER
+		#define configMAC_INTERRUPT_NUMBER 3UL
+	#endif
+
+	/* The number of frames the capture thread can hold before the stack has
+	processed them.  Frames that arrive while the ring is full are dropped. */
+	#ifndef configMAC_CAPTURE_RING_LENGTH
+		#define configMAC_CAPTURE_RING_LENGTH 32
+	#endif
+
+	typedef struct xCAPTURED_FRAME
+	{
+		long lLength;
+		unsigned char ucData[ netifMAX_MTU ];
+	} xCapturedFrame;
+
+#endif /* configMAC_USE_CAPTURE_THREAD */
+
 struct xEthernetIf
 {
 	struct eth_addr *ethaddr;
@@ -117,7 +148,9 @@ static void prvOpenSelectedNetworkInterface( pcap_if_t *pxAllNetworkInterfaces )
 
 /*
  * Interrupts cannot truely be simulated using WinPCap.  In reality this task
- * just polls the interface. 
+ * just polls the interface - unless configMAC_USE_CAPTURE_THREAD is 1, in which
+ * case it is the deferred handler of the simulated interrupt raised by the
+ * capture thread.
  */
 static void prvInterruptSimulator( void *pvParameters );
 
@@ -127,6 +160,28 @@ static void prvInterruptSimulator( void *pvParameters );
  */
 static void prvConfigureCaptureBehaviour( void );
 
+#if configMAC_USE_CAPTURE_THREAD == 1
+
+	/*
+	 * The native Windows thread that blocks in pcap_dispatch(), copying each
+	 * batch of frames into the capture ring.  It must not call any FreeRTOS API
+	 * function other than vPortGenerateSimulatedInterrupt().
+	 */
+	static DWORD WINAPI prvCaptureThread( void *pvParameters );
+
+	/*
+	 * Called by pcap_dispatch() for each captured frame.
+	 */
+	static void prvCaptureFrame( unsigned char *pucUser, const struct pcap_pkthdr *pxHeader, const unsigned char *pucPacketData );
+
+	/*
+	 * The simulated interrupt handler.  Unblocks the interrupt simulator task,
+	 * which passes the frames in the ring to the stack.
+	 */
+	static unsigned long prvMACInterruptHandler( void );
+
+#endif /* configMAC_USE_CAPTURE_THREAD */
+
 /*-----------------------------------------------------------*/
 
 /* The WinPCap interface being used. */
@@ -138,6 +193,28 @@ static char cErrorBuffer[ PCAP_ERRBUF_SIZE ];
 /* The network interface that was opened. */
 static struct netif *pxlwIPNetIf = NULL;
 
+#if configMAC_USE_CAPTURE_THREAD == 1
+
+	/* Frames captured but not yet passed to the stack.  The capture thread is
+	the only writer of xCaptureHead and the interrupt simulator task the only
+	writer of xCaptureTail, so the ring needs no lock.  lFramesPending is only
+	changed with interlocked operations, which also order the accesses to the
+	frames themselves.  The capture thread raises the interrupt when it moves
+	lFramesPending from 0 to 1, and the task only stops reading frames when it
+	moves it back to 0, so a frame can never be left in the ring unnoticed. */
+	static xCapturedFrame xCaptureRing[ configMAC_CAPTURE_RING_LENGTH ];
+	static unsigned long ulCaptureHead = 0UL, ulCaptureTail = 0UL;
+	static volatile LONG lFramesPending = 0L;
+
+	/* Frames dropped because the ring was full.  Only written by the capture
+	thread. */
+	static volatile unsigned long ulCaptureRingOverflows = 0UL;
+
+	/* The interrupt simulator task, notified by the simulated interrupt. */
+	static xTaskHandle xMACInterruptTask = NULL;
+
+#endif /* configMAC_USE_CAPTURE_THREAD */
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -275,6 +352,11 @@ err_t xReturn = ERR_OK;
 		else
 		{
 			LINK_STATS_INC( link.xmit );
+			#if LWIP_PCAPRING
+			{
+				pcapring_record( p );
+			}
+			#endif
 			snmp_add_ifoutoctets( pxNetIf, usTotalLength );
 			pxHeader = ( struct eth_hdr * )p->payload;
 
@@ -313,7 +395,13 @@ struct pbuf *p = NULL, *q;
 		#endif
 
 		/* We allocate a pbuf chain of pbufs from the pool. */
-		p = pbuf_alloc( PBUF_RAW, lDataLength, PBUF_POOL );
+		#if PBUF_POOL_CLASSES
+			/* Classify the frame before it is copied, so bulk traffic cannot
+			take the buffers reserved for ARP, ICMP and high priority flows. */
+			p = pbuf_alloc_class( PBUF_RAW, ( u16_t ) lDataLength, pbuf_rx_class( pucInputData, ( u16_t ) lDataLength ) );
+		#else
+			p = pbuf_alloc( PBUF_RAW, lDataLength, PBUF_POOL );
+		#endif
   
 		if( p != NULL ) 
 		{
@@ -372,6 +460,12 @@ struct pbuf *p;
 	/* no packet could be read, silently ignore this */
 	if( p != NULL ) 
 	{
+		#if LWIP_PCAPRING
+		{
+			pcapring_record( p );
+		}
+		#endif
+
 		/* points to packet payload, which starts with an Ethernet header */
 		pxHeader = p->payload;
 
@@ -573,32 +667,82 @@ long x;
 
 static void prvInterruptSimulator( void *pvParameters )
 {
-static struct pcap_pkthdr *pxHeader;
-const unsigned char *pucPacketData;
+#if configMAC_USE_CAPTURE_THREAD == 0
+	static struct pcap_pkthdr *pxHeader;
+	const unsigned char *pucPacketData;
+	long lResult;
+#endif
 extern xQueueHandle xEMACEventQueue;
-long lResult;
 
 	/* Just to kill the compiler warning. */
 	( void ) pvParameters;
 
-	for( ;; )
+	#if configMAC_USE_CAPTURE_THREAD == 1
 	{
-		/* Get the next packet. */
-		lResult = pcap_next_ex( pxOpenedInterfaceHandle, &pxHeader, &pucPacketData );
-		if( lResult == 1 )
+	void *pvHandle;
+	xCapturedFrame *pxFrame;
+
+		/* The capture thread is not created until the scheduler is running, as
+		simulated interrupts cannot be generated before then. */
+		vPortSetInterruptHandler( configMAC_INTERRUPT_NUMBER, prvMACInterruptHandler );
+
+		pvHandle = CreateThread( NULL, 0, prvCaptureThread, NULL, 0, NULL );
+		configASSERT( pvHandle );
+		if( pvHandle != NULL )
+		{
+			/* Run alongside the tick thread, like a peripheral. */
+			SetThreadPriority( pvHandle, THREAD_PRIORITY_BELOW_NORMAL );
+			SetThreadPriorityBoost( pvHandle, TRUE );
+			SetThreadAffinityMask( pvHandle, 0x01 );
+			CloseHandle( pvHandle );
+		}
+
+		for( ;; )
 		{
-			if( pxlwIPNetIf != NULL )
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+			/* Pass every frame in the ring to the stack, including any that
+			arrive while doing so. */
+			do
 			{
-				prvEthernetInput( pucPacketData, pxHeader->len );
-			}
+				pxFrame = &( xCaptureRing[ ulCaptureTail ] );
+
+				if( pxlwIPNetIf != NULL )
+				{
+					prvEthernetInput( pxFrame->ucData, pxFrame->lLength );
+				}
+
+				ulCaptureTail++;
+				if( ulCaptureTail >= ( unsigned long ) configMAC_CAPTURE_RING_LENGTH )
+				{
+					ulCaptureTail = 0UL;
+				}
+
+			} while( InterlockedDecrement( &lFramesPending ) != 0L );
 		}
-		else
+	}
+	#else
+	{
+		for( ;; )
 		{
-			/* There is no real way of simulating an interrupt.  
-			Make sure other tasks can run. */
-			vTaskDelay( 5 );
+			/* Get the next packet. */
+			lResult = pcap_next_ex( pxOpenedInterfaceHandle, &pxHeader, &pucPacketData );
+			if( lResult == 1 )
+			{
+				if( pxlwIPNetIf != NULL )
+				{
+					prvEthernetInput( pucPacketData, pxHeader->len );
+				}
+			}
+			else
+			{
+				/* There is no real way of simulating an interrupt.  
+				Make sure other tasks can run. */
+				vTaskDelay( 5 );
+			}
 		}
 	}
+	#endif /* configMAC_USE_CAPTURE_THREAD */
 }
 /*-----------------------------------------------------------*/
 
@@ -612,7 +756,18 @@ unsigned long ulNetMask;
 	pcap_setmintocopy( pxOpenedInterfaceHandle, lMinBytesToCopy );
 
 	/* Allow blocking. */
-	pcap_setnonblock( pxOpenedInterfaceHandle, lBlocking, cErrorBuffer );
+	#if configMAC_USE_CAPTURE_THREAD == 1
+	{
+		/* The capture thread is not a task, so can block in pcap_dispatch()
+		until frames arrive. */
+		( void ) lBlocking;
+		pcap_setnonblock( pxOpenedInterfaceHandle, 0, cErrorBuffer );
+	}
+	#else
+	{
+		pcap_setnonblock( pxOpenedInterfaceHandle, lBlocking, cErrorBuffer );
+	}
+	#endif
 
 	/* Set up a filter so only the packets of interest are passed to the lwIP
 	stack.  cErrorBuffer is used for convenience to create the string.  Don't
@@ -636,6 +791,88 @@ unsigned long ulNetMask;
 	/* Create a task that simulates an interrupt in a real system.  This will
 	block waiting for packets, then send a message to the uIP task when data
 	is available. */
-	xTaskCreate( prvInterruptSimulator, ( signed char * ) "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, NULL );
+	#if configMAC_USE_CAPTURE_THREAD == 1
+	{
+		xTaskCreate( prvInterruptSimulator, ( signed char * ) "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, &xMACInterruptTask );
+	}
+	#else
+	{
+		xTaskCreate( prvInterruptSimulator, ( signed char * ) "MAC_ISR", configMINIMAL_STACK_SIZE, NULL, configMAC_ISR_SIMULATOR_PRIORITY, NULL );
+	}
+	#endif
 }
+/*-----------------------------------------------------------*/
+
+#if configMAC_USE_CAPTURE_THREAD == 1
+
+	static DWORD WINAPI prvCaptureThread( void *pvParameters )
+	{
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			/* Blocks until frames arrive, then calls prvCaptureFrame() for
+			every frame in the buffer filled by the driver. */
+			if( pcap_dispatch( pxOpenedInterfaceHandle, -1, prvCaptureFrame, NULL ) < 0 )
+			{
+				/* Don't spin if the interface has failed. */
+				Sleep( 100 );
+			}
+		}
+
+		return 0;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCaptureFrame( unsigned char *pucUser, const struct pcap_pkthdr *pxHeader, const unsigned char *pucPacketData )
+	{
+	xCapturedFrame *pxFrame;
+	long lLength;
+
+		( void ) pucUser;
+
+		/* Only the task makes room in the ring, so if it is not full now it
+		will not be full when the frame is added. */
+		if( lFramesPending >= ( LONG ) configMAC_CAPTURE_RING_LENGTH )
+		{
+			ulCaptureRingOverflows++;
+		}
+		else
+		{
+			lLength = ( long ) pxHeader->caplen;
+			if( lLength > netifMAX_MTU )
+			{
+				lLength = netifMAX_MTU;
+			}
+
+			pxFrame = &( xCaptureRing[ ulCaptureHead ] );
+			memcpy( pxFrame->ucData, pucPacketData, ( size_t ) lLength );
+			pxFrame->lLength = lLength;
+
+			ulCaptureHead++;
+			if( ulCaptureHead >= ( unsigned long ) configMAC_CAPTURE_RING_LENGTH )
+			{
+				ulCaptureHead = 0UL;
+			}
+
+			/* Only interrupt when the ring was empty.  Otherwise the task is
+			still reading frames and will read this one too. */
+			if( InterlockedIncrement( &lFramesPending ) == 1L )
+			{
+				vPortGenerateSimulatedInterrupt( configMAC_INTERRUPT_NUMBER );
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvMACInterruptHandler( void )
+	{
+	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+		vTaskNotifyGiveFromISR( xMACInterruptTask, &xHigherPriorityTaskWoken );
+
+		return ( unsigned long ) xHigherPriorityTaskWoken;
+	}
+
+#endif /* configMAC_USE_CAPTURE_THREAD */
 
@@ -36,6 +36,7 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "memory_pool.h"
 
 #define SYS_MBOX_NULL					( ( xQueueHandle ) NULL )
 #define SYS_SEM_NULL					( ( xSemaphoreHandle ) NULL )
@@ -45,12 +46,33 @@ typedef xSemaphoreHandle sys_sem_t;
 typedef xSemaphoreHandle sys_mutex_t;
 typedef xQueueHandle sys_mbox_t;
 typedef xTaskHandle sys_thread_t;
+typedef xMemoryPoolHandle sys_mempool_t;
 
 #define sys_mbox_valid( x ) ( ( ( *x ) == NULL) ? pdFALSE : pdTRUE )
 #define sys_mbox_set_invalid( x ) ( ( *x ) = NULL )
 #define sys_sem_valid( x ) ( ( ( *x ) == NULL) ? pdFALSE : pdTRUE )
 #define sys_sem_set_invalid( x ) ( ( *x ) = NULL )
 
+/* The number of freed semaphores and mailboxes that sys_sem_free() and
+sys_mbox_free() keep for reuse, rather than deleting them.  Every netconn
+creates and frees at least one of each, so reusing them saves a heap
+allocation and free per connection.  Set to 0 to delete them straight away. */
+#ifndef sysarchSEMAPHORE_CACHE_SIZE
+	#define sysarchSEMAPHORE_CACHE_SIZE		4
+#endif
+
+#ifndef sysarchMAILBOX_CACHE_SIZE
+	#define sysarchMAILBOX_CACHE_SIZE		4
+#endif
+
+/* The millisecond time returned by sys_now() and used to measure how long the
+blocking calls waited.  By default it comes from the tick count, so it only
+has tick resolution.  A free running hardware timer can be used instead by
+defining sysarchGET_TIME_MS() in lwipopts.h. */
+#ifndef sysarchGET_TIME_MS
+	#define sysarchGET_TIME_MS()	( ( u32_t ) ( xTaskGetTickCount() * portTICK_RATE_MS ) )
+#endif
+
 
 #endif /* __ARCH_SYS_ARCH_H__ */
 
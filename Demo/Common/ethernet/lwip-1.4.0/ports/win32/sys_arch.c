@@ -48,6 +48,23 @@
 #include "lwip/mem.h"
 #include "lwip/stats.h"
 
+/* Convert a timeout in milliseconds to ticks, rounding up so a timeout that is
+shorter than a tick still blocks instead of becoming a poll. */
+#define sysarchMS_TO_TICKS( ulMs )	( ( portTickType ) ( ( ( ulMs ) + portTICK_RATE_MS - 1UL ) / portTICK_RATE_MS ) )
+
+#if sysarchSEMAPHORE_CACHE_SIZE > 0
+	/* Freed semaphores waiting to be reused by sys_sem_new().  They are all
+	empty (taken). */
+	static xSemaphoreHandle xSemaphoreCache[ sysarchSEMAPHORE_CACHE_SIZE ];
+	static unsigned portBASE_TYPE uxCachedSemaphores = 0U;
+#endif
+
+#if sysarchMAILBOX_CACHE_SIZE > 0
+	/* Freed, empty, mailboxes waiting to be reused by sys_mbox_new(). */
+	static xQueueHandle xMailBoxCache[ sysarchMAILBOX_CACHE_SIZE ];
+	static unsigned portBASE_TYPE uxCachedMailBoxes = 0U;
+#endif
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
@@ -62,7 +79,34 @@ err_t sys_mbox_new( sys_mbox_t *pxMailBox, int iSize )
 {
 err_t xReturn = ERR_MEM;
 
-	*pxMailBox = xQueueCreate( iSize, sizeof( void * ) );
+	*pxMailBox = NULL;
+
+	#if sysarchMAILBOX_CACHE_SIZE > 0
+	{
+	unsigned portBASE_TYPE ux;
+
+		/* Reuse a freed mailbox of the same size if there is one. */
+		taskENTER_CRITICAL();
+		{
+			for( ux = 0U; ux < uxCachedMailBoxes; ux++ )
+			{
+				if( uxQueueSpacesAvailable( xMailBoxCache[ ux ] ) == ( unsigned portBASE_TYPE ) iSize )
+				{
+					*pxMailBox = xMailBoxCache[ ux ];
+					uxCachedMailBoxes--;
+					xMailBoxCache[ ux ] = xMailBoxCache[ uxCachedMailBoxes ];
+					break;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	#endif /* sysarchMAILBOX_CACHE_SIZE */
+
+	if( *pxMailBox == NULL )
+	{
+		*pxMailBox = xQueueCreate( iSize, sizeof( void * ) );
+	}
 
 	if( *pxMailBox != NULL )
 	{
@@ -89,6 +133,7 @@ err_t xReturn = ERR_MEM;
 void sys_mbox_free( sys_mbox_t *pxMailBox )
 {
 unsigned long ulMessagesWaiting;
+xQueueHandle xMailBox = *pxMailBox;
 
 	ulMessagesWaiting = uxQueueMessagesWaiting( *pxMailBox );
 	configASSERT( ( ulMessagesWaiting == 0 ) );
@@ -104,7 +149,28 @@ unsigned long ulMessagesWaiting;
 	}
 	#endif /* SYS_STATS */
 
-	vQueueDelete( *pxMailBox );
+	#if sysarchMAILBOX_CACHE_SIZE > 0
+	{
+		if( ulMessagesWaiting == 0UL )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( uxCachedMailBoxes < sysarchMAILBOX_CACHE_SIZE )
+				{
+					xMailBoxCache[ uxCachedMailBoxes ] = *pxMailBox;
+					uxCachedMailBoxes++;
+					xMailBox = NULL;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	#endif /* sysarchMAILBOX_CACHE_SIZE */
+
+	if( xMailBox != NULL )
+	{
+		vQueueDelete( xMailBox );
+	}
 }
 
 /*---------------------------------------------------------------------------*
@@ -180,10 +246,10 @@ err_t xReturn;
 u32_t sys_arch_mbox_fetch( sys_mbox_t *pxMailBox, void **ppvBuffer, u32_t ulTimeOut )
 {
 void *pvDummy;
-portTickType xStartTime, xEndTime, xElapsed;
+u32_t ulStartTime, ulElapsed;
 unsigned long ulReturn;
 
-	xStartTime = xTaskGetTickCount();
+	ulStartTime = sysarchGET_TIME_MS();
 
 	if( NULL == ppvBuffer )
 	{
@@ -192,12 +258,11 @@ unsigned long ulReturn;
 
 	if( ulTimeOut != 0UL )
 	{
-		if( pdTRUE == xQueueReceive( *pxMailBox, &( *ppvBuffer ), ulTimeOut/ portTICK_RATE_MS ) )
+		if( pdTRUE == xQueueReceive( *pxMailBox, &( *ppvBuffer ), sysarchMS_TO_TICKS( ulTimeOut ) ) )
 		{
-			xEndTime = xTaskGetTickCount();
-			xElapsed = ( xEndTime - xStartTime ) * portTICK_RATE_MS;
+			ulElapsed = sysarchGET_TIME_MS() - ulStartTime;
 
-			ulReturn = xElapsed;
+			ulReturn = ulElapsed;
 		}
 		else 
 		{
@@ -209,15 +274,14 @@ unsigned long ulReturn;
 	else
 	{
 		while( pdTRUE != xQueueReceive( *pxMailBox, &( *ppvBuffer ), portMAX_DELAY ) );
-		xEndTime = xTaskGetTickCount();
-		xElapsed = ( xEndTime - xStartTime ) * portTICK_RATE_MS;
+		ulElapsed = sysarchGET_TIME_MS() - ulStartTime;
 
-		if( xElapsed == 0UL )
+		if( ulElapsed == 0UL )
 		{
-			xElapsed = 1UL;
+			ulElapsed = 1UL;
 		}
 
-		ulReturn = xElapsed;
+		ulReturn = ulElapsed;
 	}
 
 	return ulReturn;
@@ -276,14 +340,40 @@ err_t sys_sem_new( sys_sem_t *pxSemaphore, u8_t ucCount )
 {
 err_t xReturn = ERR_MEM;
 
-	vSemaphoreCreateBinary( ( *pxSemaphore ) );
+	*pxSemaphore = NULL;
 
-	if( *pxSemaphore != NULL )
+	#if sysarchSEMAPHORE_CACHE_SIZE > 0
+	{
+		taskENTER_CRITICAL();
+		{
+			if( uxCachedSemaphores > 0U )
+			{
+				uxCachedSemaphores--;
+				*pxSemaphore = xSemaphoreCache[ uxCachedSemaphores ];
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Cached semaphores are empty. */
+		if( ( *pxSemaphore != NULL ) && ( ucCount != 0U ) )
+		{
+			xSemaphoreGive( *pxSemaphore );
+		}
+	}
+	#endif /* sysarchSEMAPHORE_CACHE_SIZE */
+
+	if( *pxSemaphore == NULL )
 	{
-		if( ucCount == 0U )
+		vSemaphoreCreateBinary( ( *pxSemaphore ) );
+
+		if( ( *pxSemaphore != NULL ) && ( ucCount == 0U ) )
 		{
 			xSemaphoreTake( *pxSemaphore, 1UL );
 		}
+	}
+
+	if( *pxSemaphore != NULL )
+	{
 
 		xReturn = ERR_OK;
 		SYS_STATS_INC_USED( sem );
@@ -321,18 +411,17 @@ err_t xReturn = ERR_MEM;
  *---------------------------------------------------------------------------*/
 u32_t sys_arch_sem_wait( sys_sem_t *pxSemaphore, u32_t ulTimeout )
 {
-portTickType xStartTime, xEndTime, xElapsed;
+u32_t ulStartTime, ulElapsed;
 unsigned long ulReturn;
 
-	xStartTime = xTaskGetTickCount();
+	ulStartTime = sysarchGET_TIME_MS();
 
 	if( ulTimeout != 0UL )
 	{
-		if( xSemaphoreTake( *pxSemaphore, ulTimeout / portTICK_RATE_MS ) == pdTRUE )
+		if( xSemaphoreTake( *pxSemaphore, sysarchMS_TO_TICKS( ulTimeout ) ) == pdTRUE )
 		{
-			xEndTime = xTaskGetTickCount();
-			xElapsed = (xEndTime - xStartTime) * portTICK_RATE_MS;
-			ulReturn = xElapsed;
+			ulElapsed = sysarchGET_TIME_MS() - ulStartTime;
+			ulReturn = ulElapsed;
 		}
 		else
 		{
@@ -342,21 +431,23 @@ unsigned long ulReturn;
 	else
 	{
 		while( xSemaphoreTake( *pxSemaphore, portMAX_DELAY ) != pdTRUE );
-		xEndTime = xTaskGetTickCount();
-		xElapsed = ( xEndTime - xStartTime ) * portTICK_RATE_MS;
+		ulElapsed = sysarchGET_TIME_MS() - ulStartTime;
 
-		if( xElapsed == 0UL )
+		if( ulElapsed == 0UL )
 		{
-			xElapsed = 1UL;
+			ulElapsed = 1UL;
 		}
 
-		ulReturn = xElapsed;
+		ulReturn = ulElapsed;
 	}
 
 	return ulReturn;
 }
 
 /** Create a new mutex
+ * A FreeRTOS mutex is used, rather than a binary semaphore, so that a task
+ * holding the lwIP core lock (LWIP_TCPIP_CORE_LOCKING) inherits the priority
+ * of any higher priority task that is waiting for it.
  * @param mutex pointer to the mutex to create
  * @return a new mutex */
 err_t sys_mutex_new( sys_mutex_t *pxMutex ) 
@@ -425,8 +516,32 @@ void sys_sem_signal( sys_sem_t *pxSemaphore )
  *---------------------------------------------------------------------------*/
 void sys_sem_free( sys_sem_t *pxSemaphore )
 {
+xSemaphoreHandle xSemaphore = *pxSemaphore;
+
 	SYS_STATS_DEC(sem.used);
-	vQueueDelete( *pxSemaphore );
+
+	#if sysarchSEMAPHORE_CACHE_SIZE > 0
+	{
+		/* Leave the semaphore empty, ready for reuse. */
+		xSemaphoreTake( xSemaphore, 0UL );
+
+		taskENTER_CRITICAL();
+		{
+			if( uxCachedSemaphores < sysarchSEMAPHORE_CACHE_SIZE )
+			{
+				xSemaphoreCache[ uxCachedSemaphores ] = xSemaphore;
+				uxCachedSemaphores++;
+				xSemaphore = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	#endif /* sysarchSEMAPHORE_CACHE_SIZE */
+
+	if( xSemaphore != NULL )
+	{
+		vQueueDelete( xSemaphore );
+	}
 }
 
 /*---------------------------------------------------------------------------*
@@ -441,7 +556,7 @@ void sys_init(void)
 
 u32_t sys_now(void)
 {
-	return xTaskGetTickCount();
+	return sysarchGET_TIME_MS();
 }
 
 /*---------------------------------------------------------------------------*
@@ -524,6 +639,119 @@ void sys_arch_unprotect( sys_prot_t xValue )
 	taskEXIT_CRITICAL();
 }
 
+#if MEMP_SYS_POOLS
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mempool_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates the pool that holds one type of lwIP memp element.  The
+ *      elements are managed by a kernel memory pool, so memp_malloc() and
+ *      memp_free() only lock the pool they use, and only for as long as it
+ *      takes to unlink or link a single block, rather than taking
+ *      SYS_ARCH_PROTECT.
+ * Inputs:
+ *      sys_mempool_t *pool     -- Pool to create
+ *      void *base              -- Region the elements are carved from
+ *      u16_t num               -- Number of elements
+ *      u16_t size              -- Size of each element in bytes
+ * Outputs:
+ *      err_t                   -- ERR_OK if all the elements are available
+ *---------------------------------------------------------------------------*/
+err_t sys_mempool_new( sys_mempool_t *pxPool, void *pvBase, u16_t usNum, u16_t usSize )
+{
+xMemoryPoolStats xStats;
+err_t xReturn = ERR_OK;
+
+	*pxPool = NULL;
+
+	if( usNum > 0 )
+	{
+		*pxPool = xMemoryPoolCreate( pvBase, ( size_t ) usNum * ( size_t ) usSize, ( size_t ) usSize );
+
+		if( *pxPool != NULL )
+		{
+			/* The kernel rounds the block size up to portBYTE_ALIGNMENT, and
+			skips unaligned bytes at the start of the region, so check the
+			region lwIP reserved still holds every element. */
+			vMemoryPoolGetStats( *pxPool, &xStats );
+
+			if( xStats.uxNumberOfBlocks < ( unsigned portBASE_TYPE ) usNum )
+			{
+				vMemoryPoolDelete( *pxPool );
+				*pxPool = NULL;
+				xReturn = ERR_MEM;
+			}
+		}
+		else
+		{
+			xReturn = ERR_MEM;
+		}
+	}
+
+	return xReturn;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mempool_alloc
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Takes an element from a pool created by sys_mempool_new().
+ * Inputs:
+ *      sys_mempool_t *pool     -- Pool to take the element from
+ * Outputs:
+ *      void *                  -- The element, or NULL if the pool is empty
+ *---------------------------------------------------------------------------*/
+void *sys_mempool_alloc( sys_mempool_t *pxPool )
+{
+void *pvReturn = NULL;
+
+	if( *pxPool != NULL )
+	{
+		pvReturn = pvMemoryPoolAlloc( *pxPool );
+	}
+
+	return pvReturn;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mempool_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Returns an element to the pool it was taken from.
+ * Inputs:
+ *      sys_mempool_t *pool     -- Pool the element belongs to
+ *      void *mem               -- The element
+ *---------------------------------------------------------------------------*/
+void sys_mempool_free( sys_mempool_t *pxPool, void *pvElement )
+{
+	vMemoryPoolFree( *pxPool, pvElement );
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mempool_num_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Returns the number of free elements in a pool.
+ * Inputs:
+ *      sys_mempool_t *pool     -- Pool to count
+ * Outputs:
+ *      u16_t                   -- Number of free elements
+ *---------------------------------------------------------------------------*/
+u16_t sys_mempool_num_free( sys_mempool_t *pxPool )
+{
+xMemoryPoolStats xStats;
+u16_t usReturn = 0;
+
+	if( *pxPool != NULL )
+	{
+		vMemoryPoolGetStats( *pxPool, &xStats );
+		usReturn = ( u16_t ) xStats.uxNumberOfFreeBlocks;
+	}
+
+	return usReturn;
+}
+#endif /* MEMP_SYS_POOLS */
+
 /*
  * Prints an assertion messages and aborts execution.
  */
@@ -439,6 +439,26 @@ netconn_recv_tcp_pbuf(struct netconn *conn, struct pbuf **new_buf)
   return netconn_recv_data(conn, (void **)new_buf);
 }
 
+/**
+ * Give back a pbuf chain received with netconn_recv_tcp_pbuf(). Together
+ * they lend the received pbufs to the application without copying. With
+ * netconn_set_noautorecved(conn, 1), the receive window is only opened
+ * again here, so the peer cannot send more than the application has freed.
+ *
+ * @param conn the netconn the pbuf was received from
+ * @param p the pbuf chain to free
+ */
+void
+netconn_free_tcp_pbuf(struct netconn *conn, struct pbuf *p)
+{
+  u32_t len;
+
+  LWIP_ERROR("netconn_free_tcp_pbuf: invalid pbuf", (p != NULL), return;);
+  len = p->tot_len;
+  pbuf_free(p);
+  netconn_recved(conn, len);
+}
+
 /**
  * Receive data (in form of a netbuf containing a packet buffer) from a netconn
  *
@@ -603,6 +623,9 @@ netconn_write(struct netconn *conn, const void *dataptr, size_t size, u8_t apifl
   msg.msg.msg.w.dataptr = dataptr;
   msg.msg.msg.w.apiflags = apiflags;
   msg.msg.msg.w.len = size;
+#if LWIP_TCP_WRITE_REF
+  msg.msg.msg.w.done = NULL;
+#endif /* LWIP_TCP_WRITE_REF */
   /* For locking the core: this _can_ be delayed on low memory/low send buffer,
      but if it is, this is done inside api_msg.c:do_write(), so we can use the
      non-blocking version here. */
@@ -612,6 +635,48 @@ netconn_write(struct netconn *conn, const void *dataptr, size_t size, u8_t apifl
   return err;
 }
 
+#if LWIP_TCP_WRITE_REF
+/**
+ * Send data over a TCP netconn without copying it. The buffer is lent to
+ * the stack: it must not be changed until 'done' has been called, which
+ * happens in tcpip_thread once all the data has been acknowledged or the
+ * connection has been closed or aborted. 'done' is not called if an error
+ * is returned; the data already queued is then freed with the connection.
+ *
+ * @param conn the TCP netconn over which to send data
+ * @param dataptr pointer to the application buffer that contains the data to send
+ * @param size size of the application data to send
+ * @param apiflags NETCONN_MORE and/or NETCONN_DONTBLOCK (NETCONN_COPY is ignored)
+ * @param done function called when the buffer may be reused
+ * @param done_arg argument passed to 'done'
+ * @return ERR_OK if data was sent, any other err_t on error
+ */
+err_t
+netconn_write_ref(struct netconn *conn, const void *dataptr, size_t size,
+                  u8_t apiflags, netconn_write_done_fn done, void *done_arg)
+{
+  struct api_msg msg;
+  err_t err;
+
+  LWIP_ERROR("netconn_write_ref: invalid conn",  (conn != NULL), return ERR_ARG;);
+  LWIP_ERROR("netconn_write_ref: invalid conn->type",  (conn->type == NETCONN_TCP), return ERR_VAL;);
+  LWIP_ERROR("netconn_write_ref: invalid done",  (done != NULL), return ERR_ARG;);
+  LWIP_ERROR("netconn_write_ref: invalid size",  (size != 0), return ERR_ARG;);
+
+  msg.function = do_write;
+  msg.msg.conn = conn;
+  msg.msg.msg.w.dataptr = dataptr;
+  msg.msg.msg.w.apiflags = (u8_t)(apiflags & ~NETCONN_COPY);
+  msg.msg.msg.w.len = size;
+  msg.msg.msg.w.done = done;
+  msg.msg.msg.w.done_arg = done_arg;
+  err = TCPIP_APIMSG(&msg);
+
+  NETCONN_SET_SAFE_ERR(conn, err);
+  return err;
+}
+#endif /* LWIP_TCP_WRITE_REF */
+
 /**
  * Close ot shutdown a TCP netconn (doesn't delete it).
  *
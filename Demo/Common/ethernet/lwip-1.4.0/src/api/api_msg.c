@@ -1235,7 +1235,17 @@ do_writemore(struct netconn *conn)
   }
   if (err == ERR_OK) {
     LWIP_ASSERT("do_writemore: invalid length!", ((conn->write_offset + len) <= conn->current_msg->msg.w.len));
-    err = tcp_write(conn->pcb.tcp, dataptr, len, apiflags);
+#if LWIP_TCP_WRITE_REF
+    if ((conn->current_msg->msg.w.done != NULL) &&
+        ((conn->write_offset + len) == conn->current_msg->msg.w.len)) {
+      /* the last part of a netconn_write_ref() carries its callback */
+      err = tcp_write_ref(conn->pcb.tcp, dataptr, len, apiflags,
+        conn->current_msg->msg.w.done, conn->current_msg->msg.w.done_arg);
+    } else
+#endif /* LWIP_TCP_WRITE_REF */
+    {
+      err = tcp_write(conn->pcb.tcp, dataptr, len, apiflags);
+    }
   }
   if (dontblock && (err == ERR_MEM)) {
     /* nonblocking write failed */
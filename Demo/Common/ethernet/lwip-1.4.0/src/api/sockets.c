@@ -80,6 +80,16 @@ struct lwip_sock {
   int err;
   /** counter of how many threads are waiting for this socket using select */
   int select_waiting;
+#if LWIP_SOCKET_EVENTS
+  /** mbox that events are posted to, set by lwip_evwatch() */
+  sys_mbox_t *evmbox;
+  /** LWIP_EVT_ flags watched by lwip_evwatch() */
+  u8_t evmask;
+  /** LWIP_EVT_ flags that happened since the last lwip_evwait() */
+  u8_t evpending;
+  /** 1 while the socket is in evmbox, so it is never queued twice */
+  u8_t evposted;
+#endif /* LWIP_SOCKET_EVENTS */
 };
 
 /** Description for a task waiting in select */
@@ -263,6 +273,12 @@ alloc_socket(struct netconn *newconn, int accepted)
       sockets[i].errevent   = 0;
       sockets[i].err        = 0;
       sockets[i].select_waiting = 0;
+#if LWIP_SOCKET_EVENTS
+      sockets[i].evmbox     = NULL;
+      sockets[i].evmask     = 0;
+      sockets[i].evpending  = 0;
+      sockets[i].evposted   = 0;
+#endif /* LWIP_SOCKET_EVENTS */
       return i;
     }
     SYS_ARCH_UNPROTECT(lev);
@@ -290,6 +306,12 @@ free_socket(struct lwip_sock *sock, int is_tcp)
   /* Protect socket array */
   SYS_ARCH_PROTECT(lev);
   sock->conn       = NULL;
+#if LWIP_SOCKET_EVENTS
+  /* An entry still in the mbox is skipped by lwip_evwait() */
+  sock->evmbox     = NULL;
+  sock->evmask     = 0;
+  sock->evposted   = 0;
+#endif /* LWIP_SOCKET_EVENTS */
   SYS_ARCH_UNPROTECT(lev);
   /* don't use 'sock' after this line, as another task might have allocated it */
 
@@ -1226,6 +1248,135 @@ return_copy_fdsets:
   return nready;
 }
 
+#if LWIP_SOCKET_EVENTS
+/**
+ * Record events for a socket watched by lwip_evwatch() and queue the socket
+ * on its mbox if it is not already there.
+ * Must be called with SYS_ARCH protected.
+ *
+ * @param sock the socket
+ * @param events LWIP_EVT_ flags that just happened
+ */
+static void
+evnotify(struct lwip_sock *sock, u8_t events)
+{
+  events &= sock->evmask;
+  if (events == 0) {
+    return;
+  }
+  sock->evpending |= events;
+  if (!sock->evposted) {
+    /* Like sys_sem_signal() in event_callback(), this is called while
+       protected: trypost never blocks. If the mbox is full the events stay
+       pending and the post is retried on the next event. */
+    if (sys_mbox_trypost(sock->evmbox, sock) == ERR_OK) {
+      sock->evposted = 1;
+    }
+  }
+}
+
+/**
+ * Watch a socket for events: each time data arrives (LWIP_EVT_READ), send
+ * buffer space is freed (LWIP_EVT_WRITE) or an error occurs (LWIP_EVT_ERROR)
+ * the socket is posted to mbox, from where lwip_evwait() returns it.
+ * Events are edge triggered: after LWIP_EVT_READ, read until the socket
+ * would block or the next event may not come. LWIP_EVT_WRITE is posted for
+ * every acknowledgement that frees send buffer, so watch it only while there
+ * is data waiting to be sent.
+ *
+ * A socket is in the mbox at most once, so an mbox with room for every
+ * watched socket never overflows. The socket stops being watched when it is
+ * closed.
+ *
+ * @param s the socket
+ * @param mbox the mbox to post to, created with sys_mbox_new()
+ * @param events the LWIP_EVT_ flags to watch, 0 to stop watching
+ * @return 0 on success, -1 on error
+ */
+int
+lwip_evwatch(int s, sys_mbox_t *mbox, u8_t events)
+{
+  struct lwip_sock *sock;
+  u8_t ready = 0;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+  if ((events != 0) && ((mbox == NULL) || !sys_mbox_valid(mbox))) {
+    sock_set_errno(sock, EINVAL);
+    return -1;
+  }
+
+  SYS_ARCH_PROTECT(lev);
+  if (sock->evmbox != mbox) {
+    /* An entry left in the old mbox is skipped by lwip_evwait() */
+    sock->evposted = 0;
+  }
+  sock->evmbox = (events != 0) ? mbox : NULL;
+  sock->evmask = events;
+  sock->evpending = 0;
+  /* Report what is already true, or it would never be reported */
+  if (sock->lastdata || sock->rcvevent > 0) {
+    ready |= LWIP_EVT_READ;
+  }
+  if (sock->sendevent) {
+    ready |= LWIP_EVT_WRITE;
+  }
+  if (sock->errevent) {
+    ready |= LWIP_EVT_ERROR;
+  }
+  evnotify(sock, ready);
+  SYS_ARCH_UNPROTECT(lev);
+
+  sock_set_errno(sock, 0);
+  return 0;
+}
+
+/**
+ * Wait for the next socket posted by lwip_evwatch().
+ *
+ * @param mbox the mbox passed to lwip_evwatch()
+ * @param timeout time to wait in milliseconds, 0 to wait forever
+ * @param events set to the LWIP_EVT_ flags that happened since the socket
+ *        was last returned
+ * @return the socket, or -1 if the timeout expired
+ */
+int
+lwip_evwait(sys_mbox_t *mbox, u32_t timeout, u8_t *events)
+{
+  struct lwip_sock *sock;
+  void *msg;
+  int s = -1;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  LWIP_ASSERT("events != NULL", events != NULL);
+
+  while (s < 0) {
+    if (sys_arch_mbox_fetch(mbox, &msg, timeout) == SYS_ARCH_TIMEOUT) {
+      set_errno(EWOULDBLOCK);
+      return -1;
+    }
+    sock = (struct lwip_sock *)msg;
+
+    SYS_ARCH_PROTECT(lev);
+    /* Skip entries for sockets that were closed or moved to another mbox
+       after being posted */
+    if (sock->evposted && (sock->evmbox == mbox)) {
+      sock->evposted = 0;
+      *events = sock->evpending;
+      sock->evpending = 0;
+      s = (int)(sock - sockets);
+    }
+    SYS_ARCH_UNPROTECT(lev);
+  }
+
+  set_errno(0);
+  return s;
+}
+#endif /* LWIP_SOCKET_EVENTS */
+
 /**
  * Callback registered in the netconn layer for each socket-netconn.
  * Processes recvevent (data available) and wakes up tasks waiting for select.
@@ -1293,6 +1444,24 @@ event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len)
       break;
   }
 
+#if LWIP_SOCKET_EVENTS
+  if (sock->evmask != 0) {
+    switch (evt) {
+      case NETCONN_EVT_RCVPLUS:
+        evnotify(sock, LWIP_EVT_READ);
+        break;
+      case NETCONN_EVT_SENDPLUS:
+        evnotify(sock, LWIP_EVT_WRITE);
+        break;
+      case NETCONN_EVT_ERROR:
+        evnotify(sock, LWIP_EVT_ERROR);
+        break;
+      default:
+        break;
+    }
+  }
+#endif /* LWIP_SOCKET_EVENTS */
+
   if (sock->select_waiting == 0) {
     /* noone is waiting for this socket, no need to check select_cb_list */
     SYS_ARCH_UNPROTECT(lev);
@@ -46,6 +46,7 @@
 #include "lwip/pbuf.h"
 #include "lwip/tcpip.h"
 #include "lwip/init.h"
+#include "lwip/tcp.h"
 #include "netif/etharp.h"
 #include "netif/ppp_oe.h"
 
@@ -59,6 +60,21 @@ static sys_mbox_t mbox;
 sys_mutex_t lock_tcpip_core;
 #endif /* LWIP_TCPIP_CORE_LOCKING */
 
+/**
+ * Pass a received packet to the input function for its netif. The caller
+ * must have exclusive access to the core (tcpip_thread, or the core lock).
+ */
+static err_t
+tcpip_netif_input(struct pbuf *p, struct netif *inp)
+{
+#if LWIP_ETHERNET
+  if (inp->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
+    return ethernet_input(p, inp);
+  }
+#endif /* LWIP_ETHERNET */
+  return ip_input(p, inp);
+}
+
 
 /**
  * The main lwIP thread. This thread has exclusive access to lwIP core functions
@@ -74,6 +90,9 @@ static void
 tcpip_thread(void *arg)
 {
   struct tcpip_msg *msg;
+#if LWIP_TCP && TCP_RX_COALESCE
+  u8_t batched = 0;
+#endif /* LWIP_TCP && TCP_RX_COALESCE */
   LWIP_UNUSED_ARG(arg);
 
   if (tcpip_init_done != NULL) {
@@ -84,8 +103,30 @@ tcpip_thread(void *arg)
   while (1) {                          /* MAIN Loop */
     UNLOCK_TCPIP_CORE();
     LWIP_TCPIP_THREAD_ALIVE();
+#if LWIP_TCP && TCP_RX_COALESCE
+    /* While received TCP data is held, take further messages without
+       waiting; the data is passed up once the mailbox has run dry. */
+    msg = NULL;
+    if (tcp_rx_pending()) {
+      if ((batched < TCP_RX_COALESCE_BATCH) &&
+          (sys_mbox_tryfetch(&mbox, (void **)&msg) != SYS_MBOX_EMPTY)) {
+        batched++;
+      } else {
+        msg = NULL;
+        LOCK_TCPIP_CORE();
+        tcp_rx_flush();
+        UNLOCK_TCPIP_CORE();
+      }
+    }
+    if (msg == NULL) {
+      batched = 0;
+      /* wait for a message, timeouts are processed while waiting */
+      sys_timeouts_mbox_fetch(&mbox, (void **)&msg);
+    }
+#else /* LWIP_TCP && TCP_RX_COALESCE */
     /* wait for a message, timeouts are processed while waiting */
     sys_timeouts_mbox_fetch(&mbox, (void **)&msg);
+#endif /* LWIP_TCP && TCP_RX_COALESCE */
     LOCK_TCPIP_CORE();
     switch (msg->type) {
 #if LWIP_NETCONN
@@ -98,14 +139,7 @@ tcpip_thread(void *arg)
 #if !LWIP_TCPIP_CORE_LOCKING_INPUT
     case TCPIP_MSG_INPKT:
       LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_thread: PACKET %p\n", (void *)msg));
-#if LWIP_ETHERNET
-      if (msg->msg.inp.netif->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
-        ethernet_input(msg->msg.inp.p, msg->msg.inp.netif);
-      } else
-#endif /* LWIP_ETHERNET */
-      {
-        ip_input(msg->msg.inp.p, msg->msg.inp.netif);
-      }
+      tcpip_netif_input(msg->msg.inp.p, msg->msg.inp.netif);
       memp_free(MEMP_TCPIP_MSG_INPKT, msg);
       break;
 #endif /* LWIP_TCPIP_CORE_LOCKING_INPUT */
@@ -159,14 +193,7 @@ tcpip_input(struct pbuf *p, struct netif *inp)
   err_t ret;
   LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_input: PACKET %p/%p\n", (void *)p, (void *)inp));
   LOCK_TCPIP_CORE();
-#if LWIP_ETHERNET
-  if (inp->flags & (NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET)) {
-    ret = ethernet_input(p, inp);
-  } else
-#endif /* LWIP_ETHERNET */
-  {
-    ret = ip_input(p, inp);
-  }
+  ret = tcpip_netif_input(p, inp);
   UNLOCK_TCPIP_CORE();
   return ret;
 #else /* LWIP_TCPIP_CORE_LOCKING_INPUT */
@@ -191,6 +218,117 @@ tcpip_input(struct pbuf *p, struct netif *inp)
 #endif /* LWIP_TCPIP_CORE_LOCKING_INPUT */
 }
 
+#if LWIP_TCPIP_CORE_LOCKING
+/**
+ * Process a received packet in the calling thread while holding the core
+ * lock, instead of queueing it to tcpip_thread. Pass this to netif_add() for
+ * a netif whose driver receives in a task of its own (not an interrupt), so
+ * the priority of that task decides how soon the netif's frames are handled.
+ * Data held by TCP_RX_COALESCE is passed up before returning.
+ *
+ * @param p the received packet, p->payload pointing to the Ethernet header or
+ *          to an IP header (if inp doesn't have NETIF_FLAG_ETHARP or
+ *          NETIF_FLAG_ETHERNET flags)
+ * @param inp the network interface on which the packet was received
+ */
+err_t
+tcpip_input_direct(struct pbuf *p, struct netif *inp)
+{
+  err_t ret;
+  LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_input_direct: PACKET %p/%p\n", (void *)p, (void *)inp));
+  LOCK_TCPIP_CORE();
+  ret = tcpip_netif_input(p, inp);
+#if LWIP_TCP && TCP_RX_COALESCE
+  tcp_rx_flush();
+#endif /* LWIP_TCP && TCP_RX_COALESCE */
+  UNLOCK_TCPIP_CORE();
+  return ret;
+}
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+
+#if LWIP_NETIF_RX_TASK
+/**
+ * The receive thread of a netif started by tcpip_rx_start(). It waits for
+ * frames posted by tcpip_rx_input(), then takes the core lock and passes up
+ * to NETIF_RX_BATCH of them to the stack.
+ *
+ * @param arg the netif
+ */
+static void
+tcpip_rx_thread(void *arg)
+{
+  struct netif *netif = (struct netif *)arg;
+  struct pbuf *p;
+  u16_t batched;
+
+  while (1) {
+    sys_arch_mbox_fetch(&netif->rx_mbox, (void **)&p, 0);
+    LOCK_TCPIP_CORE();
+    batched = 0;
+    do {
+      LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_rx_thread: PACKET %p/%p\n", (void *)p, (void *)netif));
+      tcpip_netif_input(p, netif);
+    } while ((++batched < NETIF_RX_BATCH) &&
+             (sys_arch_mbox_tryfetch(&netif->rx_mbox, (void **)&p) != SYS_MBOX_EMPTY));
+#if LWIP_TCP && TCP_RX_COALESCE
+    tcp_rx_flush();
+#endif /* LWIP_TCP && TCP_RX_COALESCE */
+    UNLOCK_TCPIP_CORE();
+  }
+}
+
+/**
+ * Give a netif its own receive thread, to which tcpip_rx_input() posts the
+ * netif's frames. Call this after netif_add() with tcpip_rx_input as the
+ * input function; frames received before it has been called are dropped.
+ * The thread is never stopped, so the netif must not be removed afterwards.
+ *
+ * @param netif the netif
+ * @param name the name of the thread
+ * @param prio the priority of the thread. It should be above that of the
+ *        threads using the netif's connections, and can be above
+ *        TCPIP_THREAD_PRIO. With a sys_mutex that inherits priority, a
+ *        lower priority thread holding the core lock is raised to it.
+ * @return ERR_OK, or ERR_MEM if the mailbox could not be created
+ */
+err_t
+tcpip_rx_start(struct netif *netif, const char *name, int prio)
+{
+  LWIP_ERROR("tcpip_rx_start: invalid netif", (netif != NULL), return ERR_ARG;);
+  LWIP_ASSERT("tcpip_rx_start: already started", !sys_mbox_valid(&netif->rx_mbox));
+
+  if (sys_mbox_new(&netif->rx_mbox, NETIF_RX_MBOX_SIZE) != ERR_OK) {
+    return ERR_MEM;
+  }
+  sys_thread_new(name, tcpip_rx_thread, netif, NETIF_RX_THREAD_STACKSIZE, prio);
+  return ERR_OK;
+}
+
+/**
+ * Queue a received packet to the receive thread of its netif. Pass this to
+ * netif_add() as the input function of a netif started by tcpip_rx_start().
+ * Like tcpip_input() it can be called from an interrupt where the port's
+ * sys_mbox_trypost() allows it.
+ *
+ * @param p the received packet, p->payload pointing to the Ethernet header or
+ *          to an IP header (if inp doesn't have NETIF_FLAG_ETHARP or
+ *          NETIF_FLAG_ETHERNET flags)
+ * @param inp the network interface on which the packet was received
+ * @return ERR_OK if queued; otherwise the caller still owns p
+ */
+err_t
+tcpip_rx_input(struct pbuf *p, struct netif *inp)
+{
+  if (!sys_mbox_valid(&inp->rx_mbox)) {
+    return ERR_VAL;
+  }
+  if (sys_mbox_trypost(&inp->rx_mbox, p) != ERR_OK) {
+    return ERR_MEM;
+  }
+  return ERR_OK;
+}
+#endif /* LWIP_NETIF_RX_TASK */
+
 /**
  * Call a specific function in the thread context of
  * tcpip_thread for easy access synchronization.
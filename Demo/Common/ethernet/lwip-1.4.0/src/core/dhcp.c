@@ -115,7 +115,8 @@
 #define DHCP_OPTION_IDX_T2          5
 #define DHCP_OPTION_IDX_SUBNET_MASK 6
 #define DHCP_OPTION_IDX_ROUTER      7
-#define DHCP_OPTION_IDX_DNS_SERVER	8
+#define DHCP_OPTION_IDX_RAPID_COMMIT 8
+#define DHCP_OPTION_IDX_DNS_SERVER	9
 #define DHCP_OPTION_IDX_MAX         (DHCP_OPTION_IDX_DNS_SERVER + DNS_MAX_SERVERS)
 
 /** Holds the decoded option values, only valid while in dhcp_recv.
@@ -133,11 +134,17 @@ u8_t  dhcp_rx_options_given[DHCP_OPTION_IDX_MAX];
 #define dhcp_get_option_value(dhcp, idx)      (dhcp_rx_options_val[idx])
 #define dhcp_set_option_value(dhcp, idx, val) (dhcp_rx_options_val[idx] = (val))
 
+#if LWIP_DHCP_LEASE_CACHE
+/** Called with every bound lease so that it can be stored */
+static dhcp_lease_fn dhcp_lease_callback;
+#endif /* LWIP_DHCP_LEASE_CACHE */
+
 
 /* DHCP client state machine functions */
 static err_t dhcp_discover(struct netif *netif);
 static err_t dhcp_select(struct netif *netif);
 static void dhcp_bind(struct netif *netif);
+static err_t dhcp_init_client(struct netif *netif);
 #if DHCP_DOES_ARP_CHECK
 static err_t dhcp_decline(struct netif *netif);
 #endif /* DHCP_DOES_ARP_CHECK */
@@ -191,6 +198,12 @@ dhcp_handle_nak(struct netif *netif)
   netif_set_ipaddr(netif, IP_ADDR_ANY);
   netif_set_gw(netif, IP_ADDR_ANY);
   netif_set_netmask(netif, IP_ADDR_ANY); 
+#if LWIP_DHCP_LEASE_CACHE
+  /* the stored lease is no good any more */
+  if (dhcp_lease_callback != NULL) {
+    dhcp_lease_callback(netif, NULL);
+  }
+#endif /* LWIP_DHCP_LEASE_CACHE */
   /* Change to a defined state */
   dhcp_set_state(dhcp, DHCP_BACKING_OFF);
   /* We can immediately restart discovery */
@@ -320,7 +333,7 @@ dhcp_select(struct netif *netif)
     LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_LEVEL_WARNING, ("dhcp_select: could not allocate DHCP request\n"));
   }
   dhcp->tries++;
-  msecs = (dhcp->tries < 6 ? 1 << dhcp->tries : 60) * 1000;
+  msecs = (dhcp->tries < 6 ? 1 << dhcp->tries : 60) * DHCP_RETRY_MSECS;
   dhcp->request_timeout = (msecs + DHCP_FINE_TIMER_MSECS - 1) / DHCP_FINE_TIMER_MSECS;
   LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_STATE, ("dhcp_select(): set request timeout %"U16_F" msecs\n", msecs));
   return result;
@@ -623,13 +636,103 @@ void dhcp_cleanup(struct netif *netif)
  */
 err_t
 dhcp_start(struct netif *netif)
+{
+  err_t result;
+
+  LWIP_ERROR("netif != NULL", (netif != NULL), return ERR_ARG;);
+  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE, ("dhcp_start(netif=%p) %c%c%"U16_F"\n", (void*)netif, netif->name[0], netif->name[1], (u16_t)netif->num));
+  result = dhcp_init_client(netif);
+  if (result != ERR_OK) {
+    return result;
+  }
+  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE, ("dhcp_start(): starting DHCP configuration\n"));
+  /* (re)start the DHCP negotiation */
+  result = dhcp_discover(netif);
+  if (result != ERR_OK) {
+    /* free resources allocated above */
+    dhcp_stop(netif);
+    return ERR_MEM;
+  }
+  /* Set the flag that says this netif is handled by DHCP. */
+  netif->flags |= NETIF_FLAG_DHCP;
+  return result;
+}
+
+#if LWIP_DHCP_LEASE_CACHE
+/**
+ * Start DHCP negotiation for a network interface from a lease that was
+ * bound before, e.g. one kept in non-volatile memory by the lease callback.
+ *
+ * The client enters INIT-REBOOT and asks for the leased address again,
+ * which needs a single REQUEST/ACK exchange. If the server refuses the
+ * lease or does not answer, it falls back to discovery like dhcp_start().
+ *
+ * @param netif The lwIP network interface
+ * @param lease The lease to reboot with
+ * @return lwIP error code
+ * - ERR_OK - No error
+ * - ERR_MEM - Out of memory
+ */
+err_t
+dhcp_start_lease(struct netif *netif, const struct dhcp_lease *lease)
 {
   struct dhcp *dhcp;
-  err_t result = ERR_OK;
+  err_t result;
 
   LWIP_ERROR("netif != NULL", (netif != NULL), return ERR_ARG;);
+  LWIP_ERROR("lease != NULL", (lease != NULL), return ERR_ARG;);
+  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE, ("dhcp_start_lease(netif=%p) %c%c%"U16_F"\n", (void*)netif, netif->name[0], netif->name[1], (u16_t)netif->num));
+  result = dhcp_init_client(netif);
+  if (result != ERR_OK) {
+    return result;
+  }
   dhcp = netif->dhcp;
-  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE, ("dhcp_start(netif=%p) %c%c%"U16_F"\n", (void*)netif, netif->name[0], netif->name[1], (u16_t)netif->num));
+  ip_addr_copy(dhcp->offered_ip_addr, lease->ip_addr);
+  ip_addr_copy(dhcp->offered_sn_mask, lease->sn_mask);
+  ip_addr_copy(dhcp->offered_gw_addr, lease->gw_addr);
+  ip_addr_copy(dhcp->server_ip_addr, lease->server_ip_addr);
+  dhcp->offered_t0_lease = lease->t0_lease;
+  dhcp->offered_t1_renew = lease->t1_renew;
+  dhcp->offered_t2_rebind = lease->t2_rebind;
+  dhcp->subnet_mask_given = lease->subnet_mask_given;
+  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_STATE, ("dhcp_start_lease(): rebooting with 0x%08"X32_F"\n",
+    ip4_addr_get_u32(&dhcp->offered_ip_addr)));
+  result = dhcp_reboot(netif);
+  if (result != ERR_OK) {
+    /* free resources allocated above */
+    dhcp_stop(netif);
+    return ERR_MEM;
+  }
+  /* Set the flag that says this netif is handled by DHCP. */
+  netif->flags |= NETIF_FLAG_DHCP;
+  return result;
+}
+
+/**
+ * Set the callback that is given each bound lease, to keep it across
+ * restarts for dhcp_start_lease(). It is shared by all netifs.
+ *
+ * @param lease_callback function to call, NULL to stop storing leases
+ */
+void
+dhcp_set_lease_callback(dhcp_lease_fn lease_callback)
+{
+  dhcp_lease_callback = lease_callback;
+}
+#endif /* LWIP_DHCP_LEASE_CACHE */
+
+/**
+ * Attach a fresh DHCP client to a network interface, or reset the one
+ * it has, up to the point where the first message is to be sent.
+ *
+ * @param netif The lwIP network interface
+ * @return lwIP error code
+ */
+static err_t
+dhcp_init_client(struct netif *netif)
+{
+  struct dhcp *dhcp = netif->dhcp;
+
   /* Remove the flag that says this netif is handled by DHCP,
      it is set when we succeeded starting. */
   netif->flags &= ~NETIF_FLAG_DHCP;
@@ -682,17 +785,7 @@ dhcp_start(struct netif *netif)
   udp_connect(dhcp->pcb, IP_ADDR_ANY, DHCP_SERVER_PORT);
   /* set up the recv callback and argument */
   udp_recv(dhcp->pcb, dhcp_recv, netif);
-  LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE, ("dhcp_start(): starting DHCP configuration\n"));
-  /* (re)start the DHCP negotiation */
-  result = dhcp_discover(netif);
-  if (result != ERR_OK) {
-    /* free resources allocated above */
-    dhcp_stop(netif);
-    return ERR_MEM;
-  }
-  /* Set the flag that says this netif is handled by DHCP. */
-  netif->flags |= NETIF_FLAG_DHCP;
-  return result;
+  return ERR_OK;
 }
 
 /**
@@ -887,6 +980,11 @@ dhcp_discover(struct netif *netif)
     dhcp_option_byte(dhcp, DHCP_OPTION_BROADCAST);
     dhcp_option_byte(dhcp, DHCP_OPTION_DNS_SERVER);
 
+#if LWIP_DHCP_RAPID_COMMIT
+    /* let the server answer with an ACK right away */
+    dhcp_option(dhcp, DHCP_OPTION_RAPID_COMMIT, 0);
+#endif /* LWIP_DHCP_RAPID_COMMIT */
+
     dhcp_option_trailer(dhcp);
 
     LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE, ("dhcp_discover: realloc()ing\n"));
@@ -907,7 +1005,7 @@ dhcp_discover(struct netif *netif)
     autoip_start(netif);
   }
 #endif /* LWIP_DHCP_AUTOIP_COOP */
-  msecs = (dhcp->tries < 6 ? 1 << dhcp->tries : 60) * 1000;
+  msecs = (dhcp->tries < 6 ? 1 << dhcp->tries : 60) * DHCP_RETRY_MSECS;
   dhcp->request_timeout = (msecs + DHCP_FINE_TIMER_MSECS - 1) / DHCP_FINE_TIMER_MSECS;
   LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE, ("dhcp_discover(): set request timeout %"U16_F" msecs\n", msecs));
   return result;
@@ -1002,6 +1100,21 @@ dhcp_bind(struct netif *netif)
   netif_set_up(netif);
   /* netif is now bound to DHCP leased address */
   dhcp_set_state(dhcp, DHCP_BOUND);
+
+#if LWIP_DHCP_LEASE_CACHE
+  if (dhcp_lease_callback != NULL) {
+    struct dhcp_lease lease;
+    ip_addr_copy(lease.ip_addr, dhcp->offered_ip_addr);
+    ip_addr_copy(lease.sn_mask, dhcp->offered_sn_mask);
+    ip_addr_copy(lease.gw_addr, dhcp->offered_gw_addr);
+    ip_addr_copy(lease.server_ip_addr, dhcp->server_ip_addr);
+    lease.t0_lease = dhcp->offered_t0_lease;
+    lease.t1_renew = dhcp->offered_t1_renew;
+    lease.t2_rebind = dhcp->offered_t2_rebind;
+    lease.subnet_mask_given = dhcp->subnet_mask_given;
+    dhcp_lease_callback(netif, &lease);
+  }
+#endif /* LWIP_DHCP_LEASE_CACHE */
 }
 
 /**
@@ -1162,7 +1275,7 @@ dhcp_reboot(struct netif *netif)
     LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_LEVEL_SERIOUS, ("dhcp_reboot: could not allocate DHCP request\n"));
   }
   dhcp->tries++;
-  msecs = dhcp->tries < 10 ? dhcp->tries * 1000 : 10 * 1000;
+  msecs = dhcp->tries < 10 ? dhcp->tries * DHCP_RETRY_MSECS : 10 * DHCP_RETRY_MSECS;
   dhcp->request_timeout = (msecs + DHCP_FINE_TIMER_MSECS - 1) / DHCP_FINE_TIMER_MSECS;
   LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE | LWIP_DBG_STATE, ("dhcp_reboot(): set request timeout %"U16_F" msecs\n", msecs));
   return result;
@@ -1193,6 +1306,11 @@ dhcp_release(struct netif *netif)
   ip_addr_set_zero(&dhcp->offered_si_addr);
 #endif /* LWIP_DHCP_BOOTP_FILE */
   dhcp->offered_t0_lease = dhcp->offered_t1_renew = dhcp->offered_t2_rebind = 0;
+#if LWIP_DHCP_LEASE_CACHE
+  if (dhcp_lease_callback != NULL) {
+    dhcp_lease_callback(netif, NULL);
+  }
+#endif /* LWIP_DHCP_LEASE_CACHE */
   
   /* create and initialize the DHCP message header */
   result = dhcp_create_msg(netif, dhcp, DHCP_RELEASE);
@@ -1427,6 +1545,13 @@ again:
         LWIP_ASSERT("len == 4", len == 4);
         decode_idx = DHCP_OPTION_IDX_T2;
         break;
+#if LWIP_DHCP_RAPID_COMMIT
+      case(DHCP_OPTION_RAPID_COMMIT):
+        /* no data, only note that it is present */
+        dhcp_got_option(dhcp, DHCP_OPTION_IDX_RAPID_COMMIT);
+        decode_len = 0;
+        break;
+#endif /* LWIP_DHCP_RAPID_COMMIT */
       default:
         decode_len = 0;
         LWIP_DEBUGF(DHCP_DEBUG, ("skipping option %"U16_F" in options\n", op));
@@ -1576,7 +1701,21 @@ dhcp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
   if (msg_type == DHCP_ACK) {
     LWIP_DEBUGF(DHCP_DEBUG | LWIP_DBG_TRACE, ("DHCP_ACK received\n"));
     /* in requesting state? */
-    if (dhcp->state == DHCP_REQUESTING) {
+    if ((dhcp->state == DHCP_REQUESTING)
+#if LWIP_DHCP_RAPID_COMMIT
+      /* or a rapid commit ACK answering our DISCOVER? */
+      || ((dhcp->state == DHCP_SELECTING) &&
+          dhcp_option_given(dhcp, DHCP_OPTION_IDX_RAPID_COMMIT) &&
+          dhcp_option_given(dhcp, DHCP_OPTION_IDX_SERVER_ID))
+#endif /* LWIP_DHCP_RAPID_COMMIT */
+      ) {
+#if LWIP_DHCP_RAPID_COMMIT
+      if (dhcp->state == DHCP_SELECTING) {
+        /* there was no OFFER to take the server from */
+        dhcp->request_timeout = 0;
+        ip4_addr_set_u32(&dhcp->server_ip_addr, htonl(dhcp_get_option_value(dhcp, DHCP_OPTION_IDX_SERVER_ID)));
+      }
+#endif /* LWIP_DHCP_RAPID_COMMIT */
       dhcp_handle_ack(netif);
 #if DHCP_DOES_ARP_CHECK
       /* check if the acknowledged lease address is already in use */
@@ -1588,6 +1727,8 @@ dhcp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
     }
     /* already bound to the given lease address? */
     else if ((dhcp->state == DHCP_REBOOTING) || (dhcp->state == DHCP_REBINDING) || (dhcp->state == DHCP_RENEWING)) {
+      /* take the lease times from this ACK, the old ones may be stale */
+      dhcp_handle_ack(netif);
       dhcp_bind(netif);
     }
   }
@@ -57,6 +57,11 @@
  * Once a hostname has been resolved (or found to be non-existent),
  * the resolver code calls a specified callback function (which 
  * must be implemented by the module that uses the resolver).
+ *
+ * The table is hashed by name. Answers are kept for their TTL, names
+ * found not to exist for up to DNS_NEGATIVE_TTL, and names still in use
+ * are asked for again DNS_PREFETCH_SECS before they expire. Callers asking
+ * for a name that is being queried wait for the same answer.
  */
 
 /*-----------------------------------------------------------------------------
@@ -121,6 +126,12 @@
 #define DNS_STATE_NEW             1
 #define DNS_STATE_ASKING          2
 #define DNS_STATE_DONE            3
+/** answered, with a query out to renew the answer before it expires */
+#define DNS_STATE_REFRESH         4
+
+#if DNS_TABLE_SIZE > 255
+#error "DNS_TABLE_SIZE is limited to 255 entries"
+#endif
 
 #ifdef PACK_STRUCT_USE_INCLUDES
 #  include "arch/bpstruct.h"
@@ -171,13 +182,26 @@ struct dns_table_entry {
   u8_t  tmr;
   u8_t  retries;
   u8_t  seqno;
+  /* nonzero for a cached name error (negative answer) */
   u8_t  err;
+  /* looked up since it was resolved, so worth prefetching */
+  u8_t  used;
+  /* index + 1 of the next entry on the same hash chain, 0 ends the chain */
+  u8_t  next;
+  u16_t hash;
   u32_t ttl;
   char name[DNS_MAX_NAME_LENGTH];
   ip_addr_t ipaddr;
-  /* pointer to callback on DNS query done */
+};
+
+/** DNS request: a caller waiting for an entry of the dns_table */
+struct dns_req_entry {
+  /* pointer to callback on DNS query done, NULL if this slot is free */
   dns_found_callback found;
   void *arg;
+  /* index and sequence number of the dns_table entry being waited for */
+  u8_t dns_table_idx;
+  u8_t seqno;
 };
 
 #if DNS_LOCAL_HOSTLIST
@@ -219,6 +243,9 @@ static void dns_check_entries(void);
 static struct udp_pcb        *dns_pcb;
 static u8_t                   dns_seqno;
 static struct dns_table_entry dns_table[DNS_TABLE_SIZE];
+static struct dns_req_entry   dns_requests[DNS_MAX_REQUESTS];
+/** Heads of the hash chains over dns_table: index + 1, 0 for an empty chain */
+static u8_t                   dns_hash_heads[DNS_TABLE_SIZE];
 static ip_addr_t              dns_servers[DNS_MAX_SERVERS];
 /** Contiguous buffer for processing responses */
 static u8_t                   dns_payload_buffer[LWIP_MEM_ALIGN_BUFFER(DNS_MSG_SIZE)];
@@ -433,6 +460,90 @@ dns_local_addhost(const char *hostname, const ip_addr_t *addr)
 #endif /* DNS_LOCAL_HOSTLIST_IS_DYNAMIC*/
 #endif /* DNS_LOCAL_HOSTLIST */
 
+/**
+ * Hash a hostname to choose its chain in dns_hash_heads.
+ *
+ * @param name the hostname
+ * @return hash value of the name
+ */
+static u16_t
+dns_hash(const char *name)
+{
+  u16_t hash = 0;
+
+  while (*name != 0) {
+    hash = (u16_t)((hash << 5) + hash + (u8_t)*name++);
+  }
+  return hash;
+}
+
+/**
+ * Find the dns_table entry holding a hostname, whatever its state.
+ *
+ * @param name the hostname to look for
+ * @param hash dns_hash() of the name
+ * @return index of the entry in dns_table or DNS_TABLE_SIZE if not found
+ */
+static u8_t
+dns_find(const char *name, u16_t hash)
+{
+  u8_t i = dns_hash_heads[hash % DNS_TABLE_SIZE];
+
+  while (i != 0) {
+    struct dns_table_entry *pEntry = &dns_table[i - 1];
+    if ((pEntry->hash == hash) && (strcmp(name, pEntry->name) == 0)) {
+      return i - 1;
+    }
+    i = pEntry->next;
+  }
+  return DNS_TABLE_SIZE;
+}
+
+/**
+ * Take an entry out of the dns_table: unlink it from its hash chain and mark
+ * it unused. Callers still waiting for it must be called by the caller.
+ *
+ * @param i index of the dns_table entry to flush
+ */
+static void
+dns_flush_entry(u8_t i)
+{
+  struct dns_table_entry *pEntry = &dns_table[i];
+  u8_t *link = &dns_hash_heads[pEntry->hash % DNS_TABLE_SIZE];
+
+  while (*link != 0) {
+    if (*link == i + 1) {
+      *link = pEntry->next;
+      break;
+    }
+    link = &dns_table[*link - 1].next;
+  }
+  pEntry->state = DNS_STATE_UNUSED;
+}
+
+/**
+ * Call and free the requests waiting for a dns_table entry.
+ *
+ * @param i index of the dns_table entry that was resolved
+ * @param addr the address found or NULL if the name was not found
+ */
+static void
+dns_call_found(u8_t i, ip_addr_t *addr)
+{
+  u8_t r;
+  /* callbacks may reuse the entry: only call those waiting for this answer */
+  u8_t seqno = dns_table[i].seqno;
+
+  for (r = 0; r < DNS_MAX_REQUESTS; r++) {
+    struct dns_req_entry *req = &dns_requests[r];
+    if ((req->found != NULL) && (req->dns_table_idx == i) && (req->seqno == seqno)) {
+      dns_found_callback found = req->found;
+      req->found = NULL;
+      (*found)(dns_table[i].name, addr, req->arg);
+    }
+  }
+}
+
 /**
  * Look up a hostname in the array of known hostnames.
  *
@@ -450,6 +561,7 @@ static u32_t
 dns_lookup(const char *name)
 {
   u8_t i;
+  struct dns_table_entry *pEntry;
 #if DNS_LOCAL_HOSTLIST || defined(DNS_LOOKUP_LOCAL_EXTERN)
   u32_t addr;
 #endif /* DNS_LOCAL_HOSTLIST || defined(DNS_LOOKUP_LOCAL_EXTERN) */
@@ -464,14 +576,19 @@ dns_lookup(const char *name)
   }
 #endif /* DNS_LOOKUP_LOCAL_EXTERN */
 
-  /* Walk through name list, return entry if found. If not, return NULL. */
-  for (i = 0; i < DNS_TABLE_SIZE; ++i) {
-    if ((dns_table[i].state == DNS_STATE_DONE) &&
-        (strcmp(name, dns_table[i].name) == 0)) {
+  /* Look the name up in its hash chain, return the address if answered. */
+  i = dns_find(name, dns_hash(name));
+  if (i < DNS_TABLE_SIZE) {
+    pEntry = &dns_table[i];
+    if (((pEntry->state == DNS_STATE_DONE) || (pEntry->state == DNS_STATE_REFRESH)) &&
+        (pEntry->err == 0)) {
       LWIP_DEBUGF(DNS_DEBUG, ("dns_lookup: \"%s\": found = ", name));
-      ip_addr_debug_print(DNS_DEBUG, &(dns_table[i].ipaddr));
+      ip_addr_debug_print(DNS_DEBUG, &(pEntry->ipaddr));
       LWIP_DEBUGF(DNS_DEBUG, ("\n"));
-      return ip4_addr_get_u32(&dns_table[i].ipaddr);
+      /* keep recently used names the longest, and prefetch them */
+      pEntry->seqno = dns_seqno++;
+      pEntry->used  = 1;
+      return ip4_addr_get_u32(&pEntry->ipaddr);
     }
   }
 
@@ -629,6 +746,7 @@ dns_send(u8_t numdns, const char* name, u8_t id)
  * - send out query for new entries
  * - retry old pending entries on timeout (also with different servers)
  * - remove completed entries from the table if their TTL has expired
+ * - ask again for entries in use whose TTL is about to expire
  *
  * @param i index of the dns_table entry to check
  */
@@ -658,6 +776,14 @@ dns_check_entry(u8_t i)
       break;
     }
 
+    case DNS_STATE_REFRESH:
+      /* the old answer stays valid until the new one arrives or it expires */
+      if (--pEntry->ttl == 0) {
+        LWIP_DEBUGF(DNS_DEBUG, ("dns_check_entry: \"%s\": flush\n", pEntry->name));
+        dns_flush_entry(i);
+        break;
+      }
+      /* fall through */
     case DNS_STATE_ASKING: {
       if (--pEntry->tmr == 0) {
         if (++pEntry->retries == DNS_MAX_RETRIES) {
@@ -667,14 +793,16 @@ dns_check_entry(u8_t i)
             pEntry->tmr     = 1;
             pEntry->retries = 0;
             break;
+          } else if (pEntry->state == DNS_STATE_REFRESH) {
+            LWIP_DEBUGF(DNS_DEBUG, ("dns_check_entry: \"%s\": refresh timeout\n", pEntry->name));
+            /* keep the old answer until its TTL runs out */
+            pEntry->state = DNS_STATE_DONE;
+            break;
           } else {
             LWIP_DEBUGF(DNS_DEBUG, ("dns_check_entry: \"%s\": timeout\n", pEntry->name));
-            /* call specified callback function if provided */
-            if (pEntry->found)
-              (*pEntry->found)(pEntry->name, NULL, pEntry->arg);
-            /* flush this entry */
-            pEntry->state   = DNS_STATE_UNUSED;
-            pEntry->found   = NULL;
+            /* flush this entry and tell everyone waiting for it */
+            dns_flush_entry(i);
+            dns_call_found(i, NULL);
             break;
           }
         }
@@ -697,9 +825,24 @@ dns_check_entry(u8_t i)
       if (--pEntry->ttl == 0) {
         LWIP_DEBUGF(DNS_DEBUG, ("dns_check_entry: \"%s\": flush\n", pEntry->name));
         /* flush this entry */
-        pEntry->state = DNS_STATE_UNUSED;
-        pEntry->found = NULL;
+        dns_flush_entry(i);
+      }
+#if DNS_PREFETCH_SECS
+      else if (pEntry->used && (pEntry->err == 0) && (pEntry->ttl <= DNS_PREFETCH_SECS)) {
+        LWIP_DEBUGF(DNS_DEBUG, ("dns_check_entry: \"%s\": prefetch\n", pEntry->name));
+        /* still in use: renew the answer before it expires */
+        pEntry->state   = DNS_STATE_REFRESH;
+        pEntry->used    = 0;
+        pEntry->numdns  = 0;
+        pEntry->tmr     = 1;
+        pEntry->retries = 0;
+        err = dns_send(pEntry->numdns, pEntry->name, i);
+        if (err != ERR_OK) {
+          LWIP_DEBUGF(DNS_DEBUG | LWIP_DBG_LEVEL_WARNING,
+                      ("dns_send returned error: %s\n", lwip_strerr(err)));
+        }
       }
+#endif /* DNS_PREFETCH_SECS */
       break;
     }
     case DNS_STATE_UNUSED:
@@ -738,6 +881,11 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
   struct dns_answer ans;
   struct dns_table_entry *pEntry;
   u16_t nquestions, nanswers;
+#if DNS_NEGATIVE_TTL
+  u16_t nauthrr;
+  u32_t ttl;
+  char *pEnd;
+#endif /* DNS_NEGATIVE_TTL */
 
   LWIP_UNUSED_ARG(arg);
   LWIP_UNUSED_ARG(pcb);
@@ -765,18 +913,17 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
     i = htons(hdr->id);
     if (i < DNS_TABLE_SIZE) {
       pEntry = &dns_table[i];
-      if(pEntry->state == DNS_STATE_ASKING) {
-        /* This entry is now completed. */
-        pEntry->state = DNS_STATE_DONE;
+      if ((pEntry->state == DNS_STATE_ASKING) || (pEntry->state == DNS_STATE_REFRESH)) {
         pEntry->err   = hdr->flags2 & DNS_FLAG2_ERR_MASK;
 
-        /* We only care about the question(s) and the answers. The authrr
-           and the extrarr are simply discarded. */
+        /* We only care about the question(s) and the answers. The extrarr
+           are simply discarded, the authrr only used for negative answers. */
         nquestions = htons(hdr->numquestions);
         nanswers   = htons(hdr->numanswers);
 
         /* Check for error. If so, call callback to inform. */
-        if (((hdr->flags1 & DNS_FLAG1_RESPONSE) == 0) || (pEntry->err != 0) || (nquestions != 1)) {
+        if (((hdr->flags1 & DNS_FLAG1_RESPONSE) == 0) || (nquestions != 1) ||
+            ((pEntry->err != DNS_FLAG2_ERR_NONE) && (pEntry->err != DNS_FLAG2_ERR_NAME))) {
           LWIP_DEBUGF(DNS_DEBUG, ("dns_recv: \"%s\": error in flags\n", pEntry->name));
           /* call callback to indicate error, clean up memory and return */
           goto responseerr;
@@ -794,7 +941,7 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
         /* Skip the name in the "question" part */
         pHostname = (char *) dns_parse_name((unsigned char *)dns_payload + SIZEOF_DNS_HDR) + SIZEOF_DNS_QUERY;
 
-        while (nanswers > 0) {
+        while ((pEntry->err == DNS_FLAG2_ERR_NONE) && (nanswers > 0)) {
           /* skip answer resource record's host name */
           pHostname = (char *) dns_parse_name((unsigned char *)pHostname);
 
@@ -802,6 +949,9 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
           SMEMCPY(&ans, pHostname, SIZEOF_DNS_ANSWER);
           if((ans.type == PP_HTONS(DNS_RRTYPE_A)) && (ans.cls == PP_HTONS(DNS_RRCLASS_IN)) &&
              (ans.len == PP_HTONS(sizeof(ip_addr_t))) ) {
+            /* This entry is now completed. */
+            pEntry->state = DNS_STATE_DONE;
+            pEntry->used  = 0;
             /* read the answer resource record's TTL, and maximize it if needed */
             pEntry->ttl = ntohl(ans.ttl);
             if (pEntry->ttl > DNS_MAX_TTL) {
@@ -812,10 +962,12 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
             LWIP_DEBUGF(DNS_DEBUG, ("dns_recv: \"%s\": response = ", pEntry->name));
             ip_addr_debug_print(DNS_DEBUG, (&(pEntry->ipaddr)));
             LWIP_DEBUGF(DNS_DEBUG, ("\n"));
-            /* call specified callback function if provided */
-            if (pEntry->found) {
-              (*pEntry->found)(pEntry->name, &pEntry->ipaddr, pEntry->arg);
+            /* a TTL of 0 answers this query only and must not be cached */
+            if (pEntry->ttl == 0) {
+              dns_flush_entry((u8_t)i);
             }
+            /* call the callback functions waiting for this entry */
+            dns_call_found((u8_t)i, &pEntry->ipaddr);
             /* deallocate memory and return */
             goto memerr;
           } else {
@@ -823,6 +975,51 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
           }
           --nanswers;
         }
+#if DNS_NEGATIVE_TTL
+        /* The name does not exist or has no address: remember that for the
+           SOA minimum TTL of the authority section (RFC 2308, 5), bounded by
+           DNS_NEGATIVE_TTL. Without an SOA the answer is not cached. */
+        pEnd = (char *)dns_payload + p->tot_len;
+        nauthrr = htons(hdr->numauthrr);
+        while ((nanswers > 0) && (pHostname < pEnd)) {
+          /* skip any answer records left after a name error */
+          pHostname = (char *) dns_parse_name((unsigned char *)pHostname);
+          SMEMCPY(&ans, pHostname, SIZEOF_DNS_ANSWER);
+          pHostname = pHostname + SIZEOF_DNS_ANSWER + htons(ans.len);
+          --nanswers;
+        }
+        while ((nauthrr > 0) && (pHostname < pEnd)) {
+          pHostname = (char *) dns_parse_name((unsigned char *)pHostname);
+          if (pHostname + SIZEOF_DNS_ANSWER > pEnd) {
+            break;
+          }
+          SMEMCPY(&ans, pHostname, SIZEOF_DNS_ANSWER);
+          pHostname = pHostname + SIZEOF_DNS_ANSWER;
+          if ((ans.type == PP_HTONS(DNS_RRTYPE_SOA)) && (ans.cls == PP_HTONS(DNS_RRCLASS_IN))) {
+            /* skip MNAME and RNAME, MINIMUM is the last of 5 32 bit fields */
+            char *pSoa = (char *) dns_parse_name((unsigned char *)pHostname);
+            pSoa = (char *) dns_parse_name((unsigned char *)pSoa);
+            if (pSoa + 20 > pEnd) {
+              break;
+            }
+            SMEMCPY(&ttl, pSoa + 16, sizeof(ttl));
+            ttl = LWIP_MIN(ntohl(ttl), ntohl(ans.ttl));
+            ttl = LWIP_MIN(ttl, DNS_NEGATIVE_TTL);
+            LWIP_DEBUGF(DNS_DEBUG, ("dns_recv: \"%s\": no address, cached for %"U32_F" s\n", pEntry->name, ttl));
+            if (ttl == 0) {
+              break;
+            }
+            pEntry->state = DNS_STATE_DONE;
+            pEntry->err   = DNS_FLAG2_ERR_NAME;
+            pEntry->ttl   = ttl;
+            /* call the callback functions waiting for this entry */
+            dns_call_found((u8_t)i, NULL);
+            goto memerr;
+          }
+          pHostname = pHostname + htons(ans.len);
+          --nauthrr;
+        }
+#endif /* DNS_NEGATIVE_TTL */
         LWIP_DEBUGF(DNS_DEBUG, ("dns_recv: \"%s\": error in response\n", pEntry->name));
         /* call callback to indicate error, clean up memory and return */
         goto responseerr;
@@ -834,13 +1031,16 @@ dns_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
   goto memerr;
 
 responseerr:
-  /* ERROR: call specified callback function with NULL as name to indicate an error */
-  if (pEntry->found) {
-    (*pEntry->found)(pEntry->name, NULL, pEntry->arg);
+  if (pEntry->state == DNS_STATE_REFRESH) {
+    /* keep the old answer until its TTL runs out */
+    pEntry->state = DNS_STATE_DONE;
+    pEntry->err   = 0;
+  } else {
+    /* ERROR: flush this entry and call the callback functions with NULL as
+       address to indicate an error */
+    dns_flush_entry((u8_t)i);
+    dns_call_found((u8_t)i, NULL);
   }
-  /* flush this entry */
-  pEntry->state = DNS_STATE_UNUSED;
-  pEntry->found = NULL;
 
 memerr:
   /* free pbuf */
@@ -849,20 +1049,57 @@ memerr:
 }
 
 /**
- * Queues a new hostname to resolve and sends out a DNS query for that hostname
+ * Queues a new hostname to resolve and sends out a DNS query for that hostname.
+ * If a query for that hostname is already out, the caller waits for its answer.
  *
  * @param name the hostname that is to be queried
  * @param found a callback founction to be called on success, failure or timeout
  * @param callback_arg argument to pass to the callback function
- * @return @return a err_t return code.
+ * @return a err_t return code: ERR_VAL if the name is cached as not existing.
  */
 static err_t
 dns_enqueue(const char *name, dns_found_callback found, void *callback_arg)
 {
-  u8_t i;
+  u8_t i, r;
   u8_t lseq, lseqi;
   struct dns_table_entry *pEntry = NULL;
+  struct dns_req_entry *req = NULL;
   size_t namelen;
+  u16_t hash = dns_hash(name);
+
+  /* search a free request slot, unless there is nobody to call back */
+  if (found != NULL) {
+    for (r = 0; r < DNS_MAX_REQUESTS; ++r) {
+      if (dns_requests[r].found == NULL) {
+        req = &dns_requests[r];
+        break;
+      }
+    }
+    if (req == NULL) {
+      LWIP_DEBUGF(DNS_DEBUG, ("dns_enqueue: \"%s\": DNS requests table is full\n", name));
+      return ERR_MEM;
+    }
+  }
+
+  i = dns_find(name, hash);
+  if (i < DNS_TABLE_SIZE) {
+    pEntry = &dns_table[i];
+    if ((pEntry->state == DNS_STATE_NEW) || (pEntry->state == DNS_STATE_ASKING)) {
+      /* already being asked for: share that query */
+      LWIP_DEBUGF(DNS_DEBUG, ("dns_enqueue: \"%s\": waiting for DNS entry %"U16_F"\n", name, (u16_t)(i)));
+      if (req != NULL) {
+        req->found         = found;
+        req->arg           = callback_arg;
+        req->dns_table_idx = i;
+        req->seqno         = pEntry->seqno;
+      }
+      return ERR_INPROGRESS;
+    }
+    /* dns_lookup() answers the other states, except a cached name error */
+    LWIP_ASSERT("dns_enqueue: negative entry expected", pEntry->err != 0);
+    LWIP_DEBUGF(DNS_DEBUG, ("dns_enqueue: \"%s\": cached as not found\n", name));
+    return ERR_VAL;
+  }
 
   /* search an unused entry, or the oldest one */
   lseq = lseqi = 0;
@@ -874,8 +1111,8 @@ dns_enqueue(const char *name, dns_found_callback found, void *callback_arg)
 
     /* check if this is the oldest completed entry */
     if (pEntry->state == DNS_STATE_DONE) {
-      if ((dns_seqno - pEntry->seqno) > lseq) {
-        lseq = dns_seqno - pEntry->seqno;
+      if ((u8_t)(dns_seqno - pEntry->seqno) > lseq) {
+        lseq = (u8_t)(dns_seqno - pEntry->seqno);
         lseqi = i;
       }
     }
@@ -891,6 +1128,7 @@ dns_enqueue(const char *name, dns_found_callback found, void *callback_arg)
       /* use the oldest completed one */
       i = lseqi;
       pEntry = &dns_table[i];
+      dns_flush_entry(i);
     }
   }
 
@@ -900,11 +1138,21 @@ dns_enqueue(const char *name, dns_found_callback found, void *callback_arg)
   /* fill the entry */
   pEntry->state = DNS_STATE_NEW;
   pEntry->seqno = dns_seqno++;
-  pEntry->found = found;
-  pEntry->arg   = callback_arg;
+  pEntry->err   = 0;
+  pEntry->hash  = hash;
   namelen = LWIP_MIN(strlen(name), DNS_MAX_NAME_LENGTH-1);
   MEMCPY(pEntry->name, name, namelen);
   pEntry->name[namelen] = 0;
+  /* link it into its hash chain */
+  pEntry->next = dns_hash_heads[hash % DNS_TABLE_SIZE];
+  dns_hash_heads[hash % DNS_TABLE_SIZE] = i + 1;
+
+  if (req != NULL) {
+    req->found         = found;
+    req->arg           = callback_arg;
+    req->dns_table_idx = i;
+    req->seqno         = pEntry->seqno;
+  }
 
   /* force to send query without waiting timer */
   dns_check_entry(i);
@@ -921,7 +1169,10 @@ dns_enqueue(const char *name, dns_found_callback found, void *callback_arg)
  * - ERR_OK if hostname is a valid IP address string or the host
  *   name is already in the local names table.
  * - ERR_INPROGRESS enqueue a request to be sent to the DNS server
- *   for resolution if no errors are present.
+ *   for resolution if no errors are present, or wait for the answer to
+ *   a request for the same name that is already out.
+ * - ERR_VAL: the name is known not to exist (DNS_NEGATIVE_TTL)
+ * - ERR_MEM: no room in the name table or for another waiting caller
  * - ERR_ARG: dns client not initialized or invalid hostname
  *
  * @param hostname the hostname that is to be queried
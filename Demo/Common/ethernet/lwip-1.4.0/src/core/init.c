@@ -56,6 +56,7 @@
 #include "lwip/dns.h"
 #include "lwip/timers.h"
 #include "netif/etharp.h"
+#include "netif/dmabuf.h"
 
 /* Compile-time sanity checks for configuration errors.
  * These can be done independently of LWIP_DEBUG, without penalty.
@@ -87,6 +88,9 @@
 #if (!LWIP_UDP && LWIP_DNS)
   #error "If you want to use DNS, you have to define LWIP_UDP=1 in your lwipopts.h"
 #endif
+#if ((!LWIP_UDP || !LWIP_ARP) && LWIP_UDP_FLOW)
+  #error "If you want to use UDP flows, you have to define LWIP_UDP=1 and LWIP_ARP=1 in your lwipopts.h"
+#endif
 #if (LWIP_ARP && ARP_QUEUEING && (MEMP_NUM_ARP_QUEUE<=0))
   #error "If you want to use ARP Queueing, you have to define MEMP_NUM_ARP_QUEUE>=1 in your lwipopts.h"
 #endif
@@ -99,8 +103,20 @@
 #if (LWIP_TCP && (MEMP_NUM_TCP_PCB<=0))
   #error "If you want to use TCP, you have to define MEMP_NUM_TCP_PCB>=1 in your lwipopts.h"
 #endif
-#if (LWIP_TCP && (TCP_WND > 0xffff))
-  #error "If you want to use TCP, TCP_WND must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
+#if (LWIP_TCP && !LWIP_WND_SCALE && (TCP_WND > 0xffff))
+  #error "If you want to use TCP, TCP_WND must fit in an u16_t, so, you have to reduce it in your lwipopts.h (or enable LWIP_WND_SCALE)"
+#endif
+#if (LWIP_TCP && LWIP_WND_SCALE && (TCP_RCV_SCALE > 14))
+  #error "TCP_RCV_SCALE must not be larger than 14 (RFC 1323)"
+#endif
+#if (LWIP_TCP && LWIP_WND_SCALE && (TCP_WND > (0xffffUL << TCP_RCV_SCALE)))
+  #error "TCP_WND is too big to be announced with TCP_RCV_SCALE, increase TCP_RCV_SCALE or reduce TCP_WND in your lwipopts.h"
+#endif
+#if (LWIP_TCP && LWIP_TCP_SACK && ((LWIP_TCP_MAX_SACK_NUM < 1) || (LWIP_TCP_MAX_SACK_NUM > 4)))
+  #error "LWIP_TCP_MAX_SACK_NUM must be in the range of 1 to 4"
+#endif
+#if (LWIP_TCP && TCP_WND_AUTOTUNE && (TCP_WND_AUTOTUNE_MIN > TCP_WND))
+  #error "TCP_WND_AUTOTUNE_MIN must not be larger than TCP_WND"
 #endif
 #if (LWIP_TCP && (TCP_SND_QUEUELEN > 0xffff))
   #error "If you want to use TCP, TCP_SND_QUEUELEN must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
@@ -111,12 +127,33 @@
 #if (LWIP_TCP && ((TCP_MAXRTX > 12) || (TCP_SYNMAXRTX > 12)))
   #error "If you want to use TCP, TCP_MAXRTX and TCP_SYNMAXRTX must less or equal to 12 (due to tcp_backoff table), so, you have to reduce them in your lwipopts.h"
 #endif
+#if (LWIP_TCP && ((TCP_PCB_HASH_SIZE & (TCP_PCB_HASH_SIZE - 1)) != 0))
+  #error "TCP_PCB_HASH_SIZE must be 0 or a power of 2, change it in your lwipopts.h"
+#endif
+#if (LWIP_TCP && LWIP_TCP_TIMER_SLEEP && !LWIP_TIMERS)
+  #error "LWIP_TCP_TIMER_SLEEP needs LWIP_TIMERS"
+#endif
+#if (LWIP_TCP && TCP_RX_COALESCE && ((TCP_RX_COALESCE_MAX) >= 0xffff))
+  #error "TCP_RX_COALESCE_MAX must be below 0xffff, change it in your lwipopts.h"
+#endif
 #if (LWIP_TCP && TCP_LISTEN_BACKLOG && (TCP_DEFAULT_LISTEN_BACKLOG < 0) || (TCP_DEFAULT_LISTEN_BACKLOG > 0xff))
   #error "If you want to use TCP backlog, TCP_DEFAULT_LISTEN_BACKLOG must fit into an u8_t"
 #endif
 #if (LWIP_IGMP && (MEMP_NUM_IGMP_GROUP<=1))
   #error "If you want to use IGMP, you have to define MEMP_NUM_IGMP_GROUP>1 in your lwipopts.h"
 #endif
+#if (LWIP_DMABUF && !LWIP_SUPPORT_CUSTOM_PBUF)
+  #error "If you want to use DMA buffers, you have to define LWIP_SUPPORT_CUSTOM_PBUF=1 in your lwipopts.h"
+#endif
+#if (LWIP_DMABUF && ((DMABUF_CACHE_LINE_SIZE & (DMABUF_CACHE_LINE_SIZE - 1)) != 0))
+  #error "DMABUF_CACHE_LINE_SIZE must be a power of two"
+#endif
+#if (LWIP_TXQUEUE && ((TXQUEUE_CLASSES < 1) || (TXQUEUE_CLASSES > 8) || (TXQUEUE_LEN < 1) || (TXQUEUE_LEN > 255)))
+  #error "TXQUEUE_CLASSES must be 1 to 8 and TXQUEUE_LEN 1 to 255"
+#endif
+#if (MEMP_SYS_POOLS && (NO_SYS || MEMP_MEM_MALLOC || MEMP_OVERFLOW_CHECK || MEMP_SANITY_CHECK))
+  #error "MEMP_SYS_POOLS needs NO_SYS==0 and cannot be used with MEMP_MEM_MALLOC, MEMP_OVERFLOW_CHECK or MEMP_SANITY_CHECK"
+#endif
 #if (LWIP_NETIF_API && (NO_SYS==1))
   #error "If you want to use NETIF API, you have to define NO_SYS=0 in your lwipopts.h"
 #endif
@@ -187,6 +224,18 @@
 #if IP_FRAG && IP_FRAG_USES_STATIC_BUF && LWIP_NETIF_TX_SINGLE_PBUF
   #error "LWIP_NETIF_TX_SINGLE_PBUF does not work with IP_FRAG_USES_STATIC_BUF==1 as that creates pbuf queues"
 #endif
+#if LWIP_NETIF_RX_TASK && (NO_SYS || !LWIP_TCPIP_CORE_LOCKING)
+  #error "LWIP_NETIF_RX_TASK needs LWIP_TCPIP_CORE_LOCKING (and NO_SYS==0)"
+#endif
+#if LWIP_NETIF_RX_TASK && (NETIF_RX_BATCH < 1)
+  #error "NETIF_RX_BATCH must be at least 1"
+#endif
+#if PBUF_POOL_CLASSES && MEMP_MEM_MALLOC
+  #error "PBUF_POOL_CLASSES needs the pbuf pool to be a real pool, so MEMP_MEM_MALLOC must be 0"
+#endif
+#if PBUF_POOL_CLASSES && ((PBUF_POOL_RESERVE_HIGH + PBUF_POOL_RESERVE_CONTROL) >= PBUF_POOL_SIZE)
+  #error "PBUF_POOL_RESERVE_HIGH + PBUF_POOL_RESERVE_CONTROL must be less than PBUF_POOL_SIZE or bulk traffic cannot be received"
+#endif
 
 
 /* Compile-time checks for deprecated options.
@@ -278,6 +327,9 @@ lwip_init(void)
 #if LWIP_ARP
   etharp_init();
 #endif /* LWIP_ARP */
+#if LWIP_DMABUF
+  dmabuf_init();
+#endif /* LWIP_DMABUF */
 #if LWIP_RAW
   raw_init();
 #endif /* LWIP_RAW */
@@ -52,7 +52,7 @@
  * #define LWIP_CHKSUM <your_checksum_routine> 
  *
  * Or you can select from the implementations below by defining
- * LWIP_CHKSUM_ALGORITHM to 1, 2 or 3.
+ * LWIP_CHKSUM_ALGORITHM to 1, 2, 3 or 4.
  */
 
 #ifndef LWIP_CHKSUM
@@ -256,6 +256,135 @@ lwip_standard_chksum(void *dataptr, int len)
 }
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+/*
+ * Add four 32-bit words to the 32-bit one's complement sum 'sum'.  This uses
+ * the add-with-carry instructions on ARM (ARM or Thumb-2 state) and PowerPC,
+ * and falls back to detecting each carry in C on other architectures.  A port
+ * can supply its own LWIP_CHKSUM_ADD_4_WORDS in cc.h.  Used by checksum
+ * version #4 and by copy version #2.
+ */
+#ifndef LWIP_CHKSUM_ADD_4_WORDS
+#if defined(__GNUC__) && defined(__arm__) && (!defined(__thumb__) || defined(__thumb2__))
+#define LWIP_CHKSUM_ADD_4_WORDS(sum, w0, w1, w2, w3)          \
+  __asm__("adds  %0, %0, %1\n\t"                              \
+          "adcs  %0, %0, %2\n\t"                              \
+          "adcs  %0, %0, %3\n\t"                              \
+          "adcs  %0, %0, %4\n\t"                              \
+          "adc   %0, %0, #0"                                  \
+          : "+r" (sum)                                        \
+          : "r" (w0), "r" (w1), "r" (w2), "r" (w3)            \
+          : "cc")
+#elif defined(__GNUC__) && (defined(__PPC__) || defined(__powerpc__))
+#define LWIP_CHKSUM_ADD_4_WORDS(sum, w0, w1, w2, w3)          \
+  __asm__("addc  %0, %0, %1\n\t"                              \
+          "adde  %0, %0, %2\n\t"                              \
+          "adde  %0, %0, %3\n\t"                              \
+          "adde  %0, %0, %4\n\t"                              \
+          "addze %0, %0"                                      \
+          : "+r" (sum)                                        \
+          : "r" (w0), "r" (w1), "r" (w2), "r" (w3)            \
+          : "xer")
+#else
+#define LWIP_CHKSUM_ADD_WORD(sum, w) do {                     \
+  u32_t chksum_w_ = (w);                                      \
+  (sum) += chksum_w_;                                         \
+  if ((sum) < chksum_w_) {                                    \
+    (sum)++;                    /* add back carry */          \
+  } } while(0)
+#define LWIP_CHKSUM_ADD_4_WORDS(sum, w0, w1, w2, w3) do {     \
+  LWIP_CHKSUM_ADD_WORD(sum, w0);                              \
+  LWIP_CHKSUM_ADD_WORD(sum, w1);                              \
+  LWIP_CHKSUM_ADD_WORD(sum, w2);                              \
+  LWIP_CHKSUM_ADD_WORD(sum, w3); } while(0)
+#endif
+#endif /* LWIP_CHKSUM_ADD_4_WORDS */
+#endif /* (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
+
+#if (LWIP_CHKSUM_ALGORITHM == 4) /* Alternative version #4 */
+/**
+ * An optimized checksum routine that sums 32 bits at a time.  Like version
+ * #3 the head and tail bytes are treated specially, but the inner loop is
+ * unrolled to sum 32 bytes per iteration, and on ARM and PowerPC the words
+ * are summed by a chain of add-with-carry instructions rather than by
+ * testing for a carry after every addition.
+ *
+ * @arg start of buffer to be checksummed. May be an odd byte address.
+ * @len number of bytes in the buffer to be checksummed.
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+
+static u16_t
+lwip_standard_chksum(void *dataptr, int len)
+{
+  u8_t *pb = (u8_t *)dataptr;
+  u16_t *ps, t = 0;
+  u32_t *pl;
+  u32_t sum = 0;
+  /* starts at odd byte address? */
+  int odd = ((mem_ptr_t)pb & 1);
+
+  if (odd && len > 0) {
+    ((u8_t *)&t)[1] = *pb++;
+    len--;
+  }
+
+  ps = (u16_t *)(void *)pb;
+
+  if (((mem_ptr_t)ps & 3) && len > 1) {
+    sum += *ps++;
+    len -= 2;
+  }
+
+  pl = (u32_t *)(void *)ps;
+
+  while (len > 31) {
+    LWIP_CHKSUM_ADD_4_WORDS(sum, pl[0], pl[1], pl[2], pl[3]);
+    LWIP_CHKSUM_ADD_4_WORDS(sum, pl[4], pl[5], pl[6], pl[7]);
+    pl += 8;
+    len -= 32;
+  }
+
+  /* remaining whole 32-bit words */
+  while (len > 3) {
+    u32_t w = *pl++;
+    sum += w;
+    if (sum < w) {
+      sum++;                    /* add back carry */
+    }
+    len -= 4;
+  }
+
+  /* make room in upper bits */
+  sum = FOLD_U32T(sum);
+
+  ps = (u16_t *)(void *)pl;
+
+  /* 16-bit aligned word remaining? */
+  if (len > 1) {
+    sum += *ps++;
+    len -= 2;
+  }
+
+  /* dangling tail byte remaining? */
+  if (len > 0) {                /* include odd byte */
+    ((u8_t *)&t)[0] = *(u8_t *)ps;
+  }
+
+  sum += t;                     /* add end bytes */
+
+  /* Fold 32-bit sum to 16 bits */
+  sum = FOLD_U32T(sum);
+  sum = FOLD_U32T(sum);
+
+  if (odd) {
+    sum = SWAP_BYTES_IN_WORD(sum);
+  }
+
+  return (u16_t)sum;
+}
+#endif
+
 /* inet_chksum_pseudo:
  *
  * Calculates the pseudo Internet checksum used by TCP and UDP for a pbuf chain.
@@ -448,3 +577,118 @@ lwip_chksum_copy(void *dst, const void *src, u16_t len)
   return LWIP_CHKSUM(dst, len);
 }
 #endif /* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2) /* Version #2 */
+/** Copy and checksum in a single pass, so every byte is only read once.
+ * This is the one to use on cache-less parts, where version #1 reads all
+ * the data a second time from RAM.
+ *
+ * When source and destination have the same alignment the data is moved
+ * 32 bits at a time (16 bytes per loop iteration), otherwise it falls back
+ * to 16 bits or single bytes. As with the checksum functions above, the sum
+ * is built over the 16-bit words of the destination and swapped at the end
+ * if the destination started at an odd address.
+ *
+ * @param dst destination buffer
+ * @param src source buffer, may have any alignment
+ * @param len number of bytes to copy
+ * @return host order (!) lwip checksum (non-inverted Internet sum) of the
+ *         copied data, i.e. the same as LWIP_CHKSUM(dst, len)
+ */
+u16_t
+lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+  u8_t *pd = (u8_t *)dst;
+  const u8_t *ps = (const u8_t *)src;
+  u32_t sum = 0;
+  u16_t t = 0;
+  /* starts at odd byte address? */
+  int odd = ((mem_ptr_t)pd & 1);
+
+  if (odd && len > 0) {
+    ((u8_t *)&t)[1] = *pd++ = *ps++;
+    sum += t;
+    len--;
+  }
+
+  if (((mem_ptr_t)ps & 1) == 0) {
+    /* both pointers are now 16-bit aligned */
+    if ((((mem_ptr_t)pd ^ (mem_ptr_t)ps) & 3) == 0) {
+      u32_t *pld;
+      const u32_t *pls;
+
+      if (((mem_ptr_t)pd & 3) && len > 1) {
+        t = *(const u16_t *)(const void *)ps;
+        *(u16_t *)(void *)pd = t;
+        sum += t;
+        pd += 2;
+        ps += 2;
+        len -= 2;
+      }
+
+      pld = (u32_t *)(void *)pd;
+      pls = (const u32_t *)(const void *)ps;
+      while (len > 15) {
+        u32_t w0 = pls[0], w1 = pls[1], w2 = pls[2], w3 = pls[3];
+        pld[0] = w0;
+        pld[1] = w1;
+        pld[2] = w2;
+        pld[3] = w3;
+        LWIP_CHKSUM_ADD_4_WORDS(sum, w0, w1, w2, w3);
+        pld += 4;
+        pls += 4;
+        len -= 16;
+      }
+      while (len > 3) {
+        u32_t w = *pls++;
+        *pld++ = w;
+        sum += w;
+        if (sum < w) {
+          sum++;                /* add back carry */
+        }
+        len -= 4;
+      }
+      pd = (u8_t *)pld;
+      ps = (const u8_t *)pls;
+
+      /* make room in upper bits */
+      sum = FOLD_U32T(sum);
+    }
+
+    while (len > 1) {
+      t = *(const u16_t *)(const void *)ps;
+      *(u16_t *)(void *)pd = t;
+      sum += t;
+      pd += 2;
+      ps += 2;
+      len -= 2;
+    }
+  } else {
+    /* source and destination can't both be aligned: build each 16-bit
+       word from two bytes */
+    while (len > 1) {
+      ((u8_t *)&t)[0] = *pd++ = *ps++;
+      ((u8_t *)&t)[1] = *pd++ = *ps++;
+      sum += t;
+      len -= 2;
+    }
+  }
+
+  /* dangling tail byte remaining? */
+  if (len > 0) {
+    t = 0;
+    ((u8_t *)&t)[0] = *pd = *ps;
+    sum += t;
+  }
+
+  /* Fold 32-bit sum to 16 bits */
+  sum = FOLD_U32T(sum);
+  sum = FOLD_U32T(sum);
+
+  if (odd) {
+    sum = SWAP_BYTES_IN_WORD(sum);
+  }
+
+  return (u16_t)sum;
+}
+#endif /* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
@@ -525,6 +525,14 @@ ip_reass(struct pbuf *p)
       LWIP_DEBUGF(IP_REASS_DEBUG, ("ip_reass: matching previous fragment ID=%"X16_F"\n",
         ntohs(IPH_ID(fraghdr))));
       IPFRAG_STATS_INC(ip_frag.cachehit);
+      if (ipr_prev != NULL) {
+        /* move it to the front of the queue: the rest of its fragments
+         * usually follow straight away and are then found first */
+        ipr_prev->next = ipr->next;
+        ipr->next = reassdatagrams;
+        reassdatagrams = ipr;
+        ipr_prev = NULL;
+      }
       break;
     }
     ipr_prev = ipr;
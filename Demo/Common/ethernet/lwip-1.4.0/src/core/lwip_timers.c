@@ -67,6 +67,12 @@ static u32_t timeouts_last_time;
 #if LWIP_TCP
 /** global variable that shows if the tcp timer is currently scheduled or not */
 static int tcpip_tcp_timer_active;
+#if LWIP_TCP_TIMER_SLEEP
+/** Number of slow timer ticks the tcp timer is sleeping for, 0: not sleeping */
+static u32_t tcpip_tcp_timer_sleep;
+/** sys_now() when the tcp timer went to sleep */
+static u32_t tcpip_tcp_timer_sleep_start;
+#endif /* LWIP_TCP_TIMER_SLEEP */
 
 /**
  * Timer callback function that calls tcp_tmr() and reschedules itself.
@@ -78,10 +84,28 @@ tcpip_tcp_timer(void *arg)
 {
   LWIP_UNUSED_ARG(arg);
 
+#if LWIP_TCP_TIMER_SLEEP
+  if (tcpip_tcp_timer_sleep != 0) {
+    /* this is the one slow timer tick out of those slept through that acts */
+    tcp_tmr_skip(tcpip_tcp_timer_sleep - 1);
+    tcpip_tcp_timer_sleep = 0;
+  }
+#endif /* LWIP_TCP_TIMER_SLEEP */
   /* call TCP timer handler */
   tcp_tmr();
   /* timer still needed? */
-  if (tcp_active_pcbs || tcp_tw_pcbs) {
+  if (tcp_active_pcbs || tcp_tw_pcbs || TCP_TW_RECORDS_PENDING()) {
+#if LWIP_TCP_TIMER_SLEEP
+    u32_t ticks = tcp_idle_ticks(TCP_TMR_MAX_SLEEP / TCP_SLOW_INTERVAL);
+    if (ticks > 1) {
+      /* nothing to do for a while: sleep until the first pcb timer is due */
+      LWIP_DEBUGF(TIMERS_DEBUG, ("tcpip: tcp timer sleeping for %"U32_F" ticks\n", ticks));
+      tcpip_tcp_timer_sleep = ticks;
+      tcpip_tcp_timer_sleep_start = sys_now();
+      sys_timeout(ticks * TCP_SLOW_INTERVAL, tcpip_tcp_timer, NULL);
+      return;
+    }
+#endif /* LWIP_TCP_TIMER_SLEEP */
     /* restart timer */
     sys_timeout(TCP_TMR_INTERVAL, tcpip_tcp_timer, NULL);
   } else {
@@ -94,12 +118,26 @@ tcpip_tcp_timer(void *arg)
  * Called from TCP_REG when registering a new PCB:
  * the reason is to have the TCP timer only running when
  * there are active (or time-wait) PCBs.
+ * With LWIP_TCP_TIMER_SLEEP, also called on TCP input and output to wake
+ * up a sleeping timer.
  */
 void
 tcp_timer_needed(void)
 {
+#if LWIP_TCP_TIMER_SLEEP
+  if (tcpip_tcp_timer_sleep != 0) {
+    /* count the slow timer ticks slept through so far and run at the
+       normal rate again until the pcbs are idle */
+    u32_t ticks = (u32_t)(sys_now() - tcpip_tcp_timer_sleep_start) / TCP_SLOW_INTERVAL;
+    sys_untimeout(tcpip_tcp_timer, NULL);
+    tcp_tmr_skip(LWIP_MIN(ticks, tcpip_tcp_timer_sleep - 1));
+    tcpip_tcp_timer_sleep = 0;
+    sys_timeout(TCP_TMR_INTERVAL, tcpip_tcp_timer, NULL);
+    return;
+  }
+#endif /* LWIP_TCP_TIMER_SLEEP */
   /* timer is off but needed again? */
-  if (!tcpip_tcp_timer_active && (tcp_active_pcbs || tcp_tw_pcbs)) {
+  if (!tcpip_tcp_timer_active && (tcp_active_pcbs || tcp_tw_pcbs || TCP_TW_RECORDS_PENDING())) {
     /* enable and start timer */
     tcpip_tcp_timer_active = 1;
     sys_timeout(TCP_TMR_INTERVAL, tcpip_tcp_timer, NULL);
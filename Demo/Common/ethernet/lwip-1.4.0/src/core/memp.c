@@ -112,9 +112,16 @@ struct memp {
 
 #endif /* MEMP_OVERFLOW_CHECK */
 
+#if MEMP_SYS_POOLS
+/** This array holds the port's pool for each pool-type. */
+static sys_mempool_t memp_pools[MEMP_MAX];
+#else /* MEMP_SYS_POOLS */
 /** This array holds the first free element of each pool.
  *  Elements form a linked list. */
 static struct memp *memp_tab[MEMP_MAX];
+/** This array holds the number of elements in each free list. */
+static u16_t memp_tab_free[MEMP_MAX];
+#endif /* MEMP_SYS_POOLS */
 
 #else /* MEMP_MEM_MALLOC */
 
@@ -337,7 +344,10 @@ void
 memp_init(void)
 {
   struct memp *memp;
-  u16_t i, j;
+  u16_t i;
+#if !MEMP_SYS_POOLS
+  u16_t j;
+#endif /* !MEMP_SYS_POOLS */
 
   for (i = 0; i < MEMP_MAX; ++i) {
     MEMP_STATS_AVAIL(used, i, 0);
@@ -351,10 +361,18 @@ memp_init(void)
 #endif /* !MEMP_SEPARATE_POOLS */
   /* for every pool: */
   for (i = 0; i < MEMP_MAX; ++i) {
-    memp_tab[i] = NULL;
 #if MEMP_SEPARATE_POOLS
     memp = (struct memp*)memp_bases[i];
 #endif /* MEMP_SEPARATE_POOLS */
+#if MEMP_SYS_POOLS
+    /* hand the region of this pool to the port */
+    if (sys_mempool_new(&memp_pools[i], memp, memp_num[i], memp_sizes[i]) != ERR_OK) {
+      LWIP_ASSERT("memp_init: failed to create pool", 0);
+    }
+    memp = (struct memp *)(void *)((u8_t *)memp + memp_num[i] * (MEMP_SIZE + memp_sizes[i]));
+#else /* MEMP_SYS_POOLS */
+    memp_tab[i] = NULL;
+    memp_tab_free[i] = memp_num[i];
     /* create a linked list of memp elements */
     for (j = 0; j < memp_num[i]; ++j) {
       memp->next = memp_tab[i];
@@ -365,6 +383,7 @@ memp_init(void)
 #endif
       );
     }
+#endif /* MEMP_SYS_POOLS */
   }
 #if MEMP_OVERFLOW_CHECK
   memp_overflow_init();
@@ -392,10 +411,24 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
 #endif
 {
   struct memp *memp;
+#if !MEMP_SYS_POOLS
   SYS_ARCH_DECL_PROTECT(old_level);
+#endif /* !MEMP_SYS_POOLS */
  
   LWIP_ERROR("memp_malloc: type < MEMP_MAX", (type < MEMP_MAX), return NULL;);
 
+#if MEMP_SYS_POOLS
+  memp = (struct memp *)sys_mempool_alloc(&memp_pools[type]);
+  if (memp != NULL) {
+    MEMP_STATS_INC_USED(used, type);
+    LWIP_ASSERT("memp_malloc: memp properly aligned",
+                ((mem_ptr_t)memp % MEM_ALIGNMENT) == 0);
+  } else {
+    LWIP_DEBUGF(MEMP_DEBUG | LWIP_DBG_LEVEL_SERIOUS, ("memp_malloc: out of memory in pool %s\n", memp_desc[type]));
+    MEMP_STATS_INC(err, type);
+  }
+  return memp;
+#else /* MEMP_SYS_POOLS */
   SYS_ARCH_PROTECT(old_level);
 #if MEMP_OVERFLOW_CHECK >= 2
   memp_overflow_check_all();
@@ -405,6 +438,7 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
   
   if (memp != NULL) {
     memp_tab[type] = memp->next;
+    memp_tab_free[type]--;
 #if MEMP_OVERFLOW_CHECK
     memp->next = NULL;
     memp->file = file;
@@ -422,6 +456,7 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
   SYS_ARCH_UNPROTECT(old_level);
 
   return memp;
+#endif /* MEMP_SYS_POOLS */
 }
 
 /**
@@ -433,8 +468,10 @@ memp_malloc_fn(memp_t type, const char* file, const int line)
 void
 memp_free(memp_t type, void *mem)
 {
+#if !MEMP_SYS_POOLS
   struct memp *memp;
   SYS_ARCH_DECL_PROTECT(old_level);
+#endif /* !MEMP_SYS_POOLS */
 
   if (mem == NULL) {
     return;
@@ -442,6 +479,10 @@ memp_free(memp_t type, void *mem)
   LWIP_ASSERT("memp_free: mem properly aligned",
                 ((mem_ptr_t)mem % MEM_ALIGNMENT) == 0);
 
+#if MEMP_SYS_POOLS
+  MEMP_STATS_DEC(used, type);
+  sys_mempool_free(&memp_pools[type], mem);
+#else /* MEMP_SYS_POOLS */
   memp = (struct memp *)(void *)((u8_t*)mem - MEMP_SIZE);
 
   SYS_ARCH_PROTECT(old_level);
@@ -458,12 +499,44 @@ memp_free(memp_t type, void *mem)
   
   memp->next = memp_tab[type]; 
   memp_tab[type] = memp;
+  memp_tab_free[type]++;
 
 #if MEMP_SANITY_CHECK
   LWIP_ASSERT("memp sanity", memp_sanity());
 #endif /* MEMP_SANITY_CHECK */
 
   SYS_ARCH_UNPROTECT(old_level);
+#endif /* MEMP_SYS_POOLS */
+}
+
+/**
+ * Count the elements currently free in a pool. The count is kept as
+ * elements are taken and returned (or by the port with MEMP_SYS_POOLS), so
+ * this is cheap enough to call for every received frame (e.g. by
+ * pbuf_alloc_class()).
+ *
+ * @param type the pool to count
+ * @return number of free elements in the pool
+ */
+u16_t
+memp_num_free(memp_t type)
+{
+#if MEMP_SYS_POOLS
+  LWIP_ERROR("memp_num_free: type < MEMP_MAX", (type < MEMP_MAX), return 0;);
+
+  return sys_mempool_num_free(&memp_pools[type]);
+#else /* MEMP_SYS_POOLS */
+  u16_t num;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  LWIP_ERROR("memp_num_free: type < MEMP_MAX", (type < MEMP_MAX), return 0;);
+
+  SYS_ARCH_PROTECT(old_level);
+  num = memp_tab_free[type];
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return num;
+#endif /* MEMP_SYS_POOLS */
 }
 
 #endif /* MEMP_MEM_MALLOC */
@@ -146,6 +146,7 @@ netif_add(struct netif *netif, ip_addr_t *ipaddr, ip_addr_t *netmask,
   ip_addr_set_zero(&netif->netmask);
   ip_addr_set_zero(&netif->gw);
   netif->flags = 0;
+  NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL);
 #if LWIP_DHCP
   /* netif not under DHCP control by default */
   netif->dhcp = NULL;
@@ -167,6 +168,12 @@ netif_add(struct netif *netif, ip_addr_t *ipaddr, ip_addr_t *netmask,
   netif->loop_first = NULL;
   netif->loop_last = NULL;
 #endif /* ENABLE_LOOPBACK */
+#if LWIP_TCP && TCP_STRETCH_ACK
+  netif->tcp_ack_segs = 2;
+#endif /* LWIP_TCP && TCP_STRETCH_ACK */
+#if LWIP_NETIF_RX_TASK
+  sys_mbox_set_invalid(&netif->rx_mbox);
+#endif /* LWIP_NETIF_RX_TASK */
 
   /* remember netif specific state information data */
   netif->state = state;
@@ -76,6 +76,10 @@
 #if LWIP_CHECKSUM_ON_COPY
 #include "lwip/inet_chksum.h"
 #endif
+#if PBUF_POOL_CLASSES
+#include "lwip/ip.h"
+#include "netif/etharp.h"
+#endif
 
 #include <string.h>
 
@@ -326,6 +330,145 @@ pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
   return p;
 }
 
+#if PBUF_POOL_CLASSES
+u32_t pbuf_class_drops[PBUF_NUM_CLASSES];
+
+/** The number of PBUF_POOL buffers each class has to leave free. */
+static const u16_t pbuf_class_reserve[PBUF_NUM_CLASSES] = {
+  PBUF_POOL_RESERVE_HIGH + PBUF_POOL_RESERVE_CONTROL, /* PBUF_CLASS_BULK */
+  PBUF_POOL_RESERVE_CONTROL,                          /* PBUF_CLASS_HIGH */
+  0                                                   /* PBUF_CLASS_CONTROL */
+};
+
+/**
+ * Classify a received Ethernet frame for pbuf_alloc_class(), looking only at
+ * its headers so it can be done before the frame is copied out of the
+ * driver's receive buffer.
+ *
+ * ARP, ICMP and IGMP are PBUF_CLASS_CONTROL. IPv4 packets with a DSCP of at
+ * least PBUF_CLASS_HIGH_DSCP, TCP and UDP to or from a port for which
+ * PBUF_CLASS_HIGH_PORT() is true, and TCP segments without data are
+ * PBUF_CLASS_HIGH. Everything else is PBUF_CLASS_BULK.
+ *
+ * @param frame the frame, starting at the destination MAC address (i.e.
+ *        without ETH_PAD_SIZE)
+ * @param len the number of bytes of the frame at frame
+ * @return the class of the frame
+ */
+u8_t
+pbuf_rx_class(const void *frame, u16_t len)
+{
+  const u8_t *f = (const u8_t *)frame;
+  const u8_t *iph, *l4;
+  u16_t off, type, iphlen, iplen;
+  u8_t proto;
+
+  off = 2 * ETHARP_HWADDR_LEN;
+  if (len < off + 2) {
+    return PBUF_CLASS_BULK;
+  }
+  type = ((u16_t)f[off] << 8) | f[off + 1];
+  off += 2;
+  if ((type == ETHTYPE_VLAN) && (len >= off + 4)) {
+    type = ((u16_t)f[off + 2] << 8) | f[off + 3];
+    off += 4;
+  }
+  if (type == ETHTYPE_ARP) {
+    return PBUF_CLASS_CONTROL;
+  }
+  if ((type != ETHTYPE_IP) || (len < off + IP_HLEN)) {
+    return PBUF_CLASS_BULK;
+  }
+
+  iph = f + off;
+  proto = iph[9];
+  if ((proto == IP_PROTO_ICMP) || (proto == IP_PROTO_IGMP)) {
+    return PBUF_CLASS_CONTROL;
+  }
+  if ((iph[1] >> 2) >= PBUF_CLASS_HIGH_DSCP) {
+    return PBUF_CLASS_HIGH;
+  }
+  /* only the first fragment has the ports */
+  iphlen = (u16_t)(iph[0] & 0x0f) * 4;
+  if (((iph[6] & 0x1f) != 0) || (iph[7] != 0) || (len < off + iphlen + 4)) {
+    return PBUF_CLASS_BULK;
+  }
+
+  l4 = iph + iphlen;
+  if ((proto == IP_PROTO_TCP) || (proto == IP_PROTO_UDP)) {
+    if (PBUF_CLASS_HIGH_PORT(((u16_t)l4[0] << 8) | l4[1]) ||
+        PBUF_CLASS_HIGH_PORT(((u16_t)l4[2] << 8) | l4[3])) {
+      return PBUF_CLASS_HIGH;
+    }
+  }
+  if ((proto == IP_PROTO_TCP) && (len >= off + iphlen + 13)) {
+    /* the IP total length rather than the frame length, as short frames
+       are padded */
+    iplen = ((u16_t)iph[2] << 8) | iph[3];
+    if (iplen <= iphlen + (u16_t)(l4[12] >> 4) * 4) {
+      return PBUF_CLASS_HIGH;
+    }
+  }
+  return PBUF_CLASS_BULK;
+}
+
+/**
+ * Allocate a PBUF_POOL pbuf (chain) for a received frame of the given class,
+ * as pbuf_alloc(l, length, PBUF_POOL) would, but only if doing so leaves the
+ * reserve the class has to leave free. A frame that is refused is counted
+ * in pbuf_class_drops[pclass].
+ *
+ * @param l flag to define header size
+ * @param length size of the pbuf's payload
+ * @param pclass the class of the frame, usually from pbuf_rx_class()
+ * @return the allocated pbuf, or NULL
+ */
+struct pbuf *
+pbuf_alloc_class(pbuf_layer l, u16_t length, u8_t pclass)
+{
+  struct pbuf *p = NULL;
+  u16_t offset, needed;
+
+  LWIP_ASSERT("pbuf_alloc_class: bad class", pclass < PBUF_NUM_CLASSES);
+  if (pclass >= PBUF_NUM_CLASSES) {
+    pclass = PBUF_CLASS_BULK;
+  }
+
+  /* the number of pool buffers pbuf_alloc() will use for this length */
+  switch (l) {
+  case PBUF_TRANSPORT:
+    offset = PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN;
+    break;
+  case PBUF_IP:
+    offset = PBUF_LINK_HLEN + PBUF_IP_HLEN;
+    break;
+  case PBUF_LINK:
+    offset = PBUF_LINK_HLEN;
+    break;
+  default:
+    offset = 0;
+    break;
+  }
+  offset = LWIP_MEM_ALIGN_SIZE(offset);
+  needed = (u16_t)(((u32_t)length + offset + PBUF_POOL_BUFSIZE_ALIGNED - 1) / PBUF_POOL_BUFSIZE_ALIGNED);
+  if (needed == 0) {
+    needed = 1;
+  }
+
+  if (memp_num_free(MEMP_PBUF_POOL) >= needed + pbuf_class_reserve[pclass]) {
+    p = pbuf_alloc(l, length, PBUF_POOL);
+  } else {
+    /* as far as this class is concerned the pool is empty */
+    PBUF_POOL_IS_EMPTY();
+  }
+  if (p == NULL) {
+    pbuf_class_drops[pclass]++;
+    LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_TRACE, ("pbuf_alloc_class: class %"U16_F" frame of %"U16_F" bytes dropped\n", (u16_t)pclass, length));
+  }
+  return p;
+}
+#endif /* PBUF_POOL_CLASSES */
+
 #if LWIP_SUPPORT_CUSTOM_PBUF
 /** Initialize a custom pbuf (already allocated).
  *
@@ -369,7 +512,7 @@ pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_cust
     return NULL;
   }
 
-  if (LWIP_MEM_ALIGN_SIZE(offset) + length < payload_mem_len) {
+  if (LWIP_MEM_ALIGN_SIZE(offset) + length > payload_mem_len) {
     LWIP_DEBUGF(PBUF_DEBUG | LWIP_DBG_LEVEL_WARNING, ("pbuf_alloced_custom(length=%"U16_F") buffer too short\n", length));
     return NULL;
   }
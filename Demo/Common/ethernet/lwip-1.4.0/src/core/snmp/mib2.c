@@ -174,7 +174,8 @@ struct mib_list_rootnode udp_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t udpentry_ids[2] = { 1, 2 };
 struct mib_node* const udpentry_nodes[2] = {
@@ -242,7 +243,8 @@ struct mib_list_rootnode tcpconntree_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t tcpconnentry_ids[5] = { 1, 2, 3, 4, 5 };
 struct mib_node* const tcpconnentry_nodes[5] = {
@@ -353,7 +355,8 @@ struct mib_list_rootnode ipntomtree_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t ipntomentry_ids[4] = { 1, 2, 3, 4 };
 struct mib_node* const ipntomentry_nodes[4] = {
@@ -394,7 +397,8 @@ struct mib_list_rootnode iprtetree_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t iprteentry_ids[13] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
 struct mib_node* const iprteentry_nodes[13] = {
@@ -440,7 +444,8 @@ struct mib_list_rootnode ipaddrtree_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t ipaddrentry_ids[5] = { 1, 2, 3, 4, 5 };
 struct mib_node* const ipaddrentry_nodes[5] = {
@@ -519,7 +524,8 @@ struct mib_list_rootnode arptree_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t atentry_ids[3] = { 1, 2, 3 };
 struct mib_node* const atentry_nodes[3] = {
@@ -580,7 +586,8 @@ struct mib_list_rootnode iflist_root = {
   0,
   NULL,
   NULL,
-  0
+  0,
+  NULL
 };
 const s32_t ifentry_ids[22] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22 };
 struct mib_node* const ifentry_nodes[22] = {
@@ -86,6 +86,67 @@ pop_node(struct nse* node)
   LWIP_DEBUGF(SNMP_MIB_DEBUG,("pop_node() node=%p id=%"S32_F"\n",(void *)(node->r_ptr),node->r_id));
 }
 
+/**
+ * Finds the first entry of a sorted array node that is not below id.
+ * The objid[] arrays are in ascending order, so this is a binary search.
+ *
+ * @param an points to the array node
+ * @param id is the object sub identifier
+ * @return the index of the entry, or an->maxlength if all are below id
+ */
+static u16_t
+snmp_mib_an_lower_bound(struct mib_array_node *an, s32_t id)
+{
+  u16_t lo, hi, mid;
+
+  lo = 0;
+  hi = an->maxlength;
+  while (lo < hi)
+  {
+    mid = lo + ((hi - lo) >> 1);
+    if (an->objid[mid] < id)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Finds the first node of a sorted list that is not below id.
+ * The search starts from the node found last time if that is not past id,
+ * so walking a table in order (as GETNEXT and GETBULK do) touches only a
+ * node or two per step instead of scanning from the head each time.
+ *
+ * @param lrn points to the list root node
+ * @param id is the object sub identifier
+ * @return the node, or NULL if all are below id
+ */
+static struct mib_list_node *
+snmp_mib_ln_lower_bound(struct mib_list_rootnode *lrn, s32_t id)
+{
+  struct mib_list_node *ln;
+
+  ln = lrn->cursor;
+  if ((ln == NULL) || (ln->objid > id))
+  {
+    ln = lrn->head;
+  }
+  while ((ln != NULL) && (ln->objid < id))
+  {
+    ln = ln->next;
+  }
+  if (ln != NULL)
+  {
+    lrn->cursor = ln;
+  }
+  return ln;
+}
+
 /**
  * Conversion from ifIndex to lwIP netif
  * @param ifindex is a s32_t object sub-identifier
@@ -191,6 +252,7 @@ snmp_mib_lrn_alloc(void)
     lrn->head = NULL;
     lrn->tail = NULL;
     lrn->count = 0;
+    lrn->cursor = NULL;
   }
   return lrn;
 }
@@ -341,10 +403,10 @@ snmp_mib_node_find(struct mib_list_rootnode *rn, s32_t objid, struct mib_list_no
   struct mib_list_node *n;
 
   LWIP_ASSERT("rn != NULL",rn != NULL);
-  n = rn->head;
-  while ((n != NULL) && (n->objid != objid))
+  n = snmp_mib_ln_lower_bound(rn, objid);
+  if ((n != NULL) && (n->objid != objid))
   {
-    n = n->next;
+    n = NULL;
   }
   if (n == NULL)
   {
@@ -402,6 +464,10 @@ snmp_mib_node_delete(struct mib_list_rootnode *rn, struct mib_list_node *n)
   /* caller must remove this sub-tree */
   next = (struct mib_list_rootnode*)(n->nptr);
   rn->count -= 1;
+  if (rn->cursor == n)
+  {
+    rn->cursor = n->prev;
+  }
 
   if (n == rn->head)
   {
@@ -467,12 +533,8 @@ snmp_search_tree(struct mib_node *node, u8_t ident_len, s32_t *ident, struct snm
       {
         /* array node (internal ROM or RAM, fixed length) */
         an = (struct mib_array_node *)node;
-        i = 0;
-        while ((i < an->maxlength) && (an->objid[i] != *ident))
-        {
-          i++;
-        }
-        if (i < an->maxlength)
+        i = snmp_mib_an_lower_bound(an, *ident);
+        if ((i < an->maxlength) && (an->objid[i] == *ident))
         {
           /* found it, if available proceed to child, otherwise inspect leaf */
           LWIP_DEBUGF(SNMP_MIB_DEBUG,("an->objid[%"U16_F"]==%"S32_F" *ident==%"S32_F"\n",i,an->objid[i],*ident));
@@ -515,13 +577,8 @@ snmp_search_tree(struct mib_node *node, u8_t ident_len, s32_t *ident, struct snm
       {
         /* list root node (internal 'RAM', variable length) */
         lrn = (struct mib_list_rootnode *)node;
-        ln = lrn->head;
-        /* iterate over list, head to tail */
-        while ((ln != NULL) && (ln->objid != *ident))
-        {
-          ln = ln->next;
-        }
-        if (ln != NULL)
+        ln = snmp_mib_ln_lower_bound(lrn, *ident);
+        if ((ln != NULL) && (ln->objid == *ident))
         {
           /* found it, proceed to child */;
           LWIP_DEBUGF(SNMP_MIB_DEBUG,("ln->objid==%"S32_F" *ident==%"S32_F"\n",ln->objid,*ident));
@@ -700,11 +757,7 @@ snmp_expand_tree(struct mib_node *node, u8_t ident_len, s32_t *ident, struct snm
       an = (struct mib_array_node *)node;
       if (ident_len > 0)
       {
-        i = 0;
-        while ((i < an->maxlength) && (an->objid[i] < *ident))
-        {
-          i++;
-        }
+        i = snmp_mib_an_lower_bound(an, *ident);
         if (i < an->maxlength)
         {
           LWIP_DEBUGF(SNMP_MIB_DEBUG,("an->objid[%"U16_F"]==%"S32_F" *ident==%"S32_F"\n",i,an->objid[i],*ident));
@@ -820,12 +873,7 @@ snmp_expand_tree(struct mib_node *node, u8_t ident_len, s32_t *ident, struct snm
       lrn = (struct mib_list_rootnode *)node;
       if (ident_len > 0)
       {
-        ln = lrn->head;
-        /* iterate over list, head to tail */
-        while ((ln != NULL) && (ln->objid < *ident))
-        {
-          ln = ln->next;
-        }
+        ln = snmp_mib_ln_lower_bound(lrn, *ident);
         if (ln != NULL)
         {
           LWIP_DEBUGF(SNMP_MIB_DEBUG,("ln->objid==%"S32_F" *ident==%"S32_F"\n",ln->objid,*ident));
@@ -61,6 +61,9 @@ struct udp_pcb *snmp1_pcb;
 static void snmp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t port);
 static err_t snmp_pdu_header_check(struct pbuf *p, u16_t ofs, u16_t pdu_len, u16_t *ofs_ret, struct snmp_msg_pstat *m_stat);
 static err_t snmp_pdu_dec_varbindlist(struct pbuf *p, u16_t ofs, u16_t *ofs_ret, struct snmp_msg_pstat *m_stat);
+#if SNMP_GETBULK
+static struct snmp_varbind* snmp_end_of_mib_view_alloc(u8_t ident_len, s32_t *ident);
+#endif /* SNMP_GETBULK */
 
 
 /**
@@ -504,8 +507,30 @@ snmp_msg_getnext_event(u8_t request_id, struct snmp_msg_pstat *msg_ps)
     }
     if (mn == NULL)
     {
-      /* mn == NULL, noSuchName */
-      snmp_error_response(msg_ps,SNMP_ES_NOSUCHNAME);
+#if SNMP_GETBULK
+      if (msg_ps->version == SNMP_VERSION_2c)
+      {
+        struct snmp_varbind *vb;
+
+        /* v2c reports the end of the MIB in the varbind, not as an error */
+        vb = snmp_end_of_mib_view_alloc(msg_ps->vb_ptr->ident_len, msg_ps->vb_ptr->ident);
+        if (vb != NULL)
+        {
+          snmp_varbind_tail_add(&msg_ps->outvb, vb);
+          msg_ps->vb_idx += 1;
+        }
+        else
+        {
+          LWIP_DEBUGF(SNMP_MSG_DEBUG, ("snmp_recv couldn't allocate outvb space\n"));
+          snmp_error_response(msg_ps,SNMP_ES_TOOBIG);
+        }
+      }
+      else
+#endif /* SNMP_GETBULK */
+      {
+        /* mn == NULL, noSuchName */
+        snmp_error_response(msg_ps,SNMP_ES_NOSUCHNAME);
+      }
     }
   }
   if ((msg_ps->state == SNMP_MSG_SEARCH_OBJ) &&
@@ -515,6 +540,169 @@ snmp_msg_getnext_event(u8_t request_id, struct snmp_msg_pstat *msg_ps)
   }
 }
 
+#if SNMP_GETBULK
+/**
+ * Appends the object that follows ident to the response of a GetBulk
+ * request, or endOfMibView if ident is past the last object.
+ *
+ * @param msg_ps points to the assosicated message process state
+ * @param ident_len the length of the object identifier to step on from
+ * @param ident points to the array of sub identifiers
+ * @param end is set to 1 when endOfMibView was appended, 0 otherwise
+ * @return ERR_OK when a varbind was appended, ERR_BUF when the response holds
+ *   SNMP_GETBULK_MAX_VARBINDS already, ERR_VAL when the next object is in an
+ *   external MIB node (not walked by GetBulk), ERR_MEM if out of varbinds
+ */
+static err_t
+snmp_msg_getbulk_next(struct snmp_msg_pstat *msg_ps, u8_t ident_len, s32_t *ident, u8_t *end)
+{
+  struct mib_node *mn;
+  struct snmp_obj_id oid;
+  struct snmp_varbind *vb;
+
+  *end = 0;
+  if (msg_ps->outvb.count >= SNMP_GETBULK_MAX_VARBINDS)
+  {
+    return ERR_BUF;
+  }
+  if (snmp_iso_prefix_expand(ident_len, ident, &oid))
+  {
+    if (ident_len > 3)
+    {
+      /* can offset ident_len and ident */
+      mn = snmp_expand_tree((struct mib_node*)&internet, ident_len - 4, ident + 4, &oid);
+    }
+    else
+    {
+      /* can't offset ident_len -4, ident + 4 */
+      mn = snmp_expand_tree((struct mib_node*)&internet, 0, NULL, &oid);
+    }
+  }
+  else
+  {
+    mn = NULL;
+  }
+  if (mn == NULL)
+  {
+    *end = 1;
+    vb = snmp_end_of_mib_view_alloc(ident_len, ident);
+  }
+  else if (mn->node_type == MIB_NODE_EX)
+  {
+    /* external objects are only reached through the asynchronous
+       GetNext state machine */
+    return ERR_VAL;
+  }
+  else
+  {
+    struct obj_def object_def;
+
+    mn->get_object_def(1, &oid.id[oid.len - 1], &object_def);
+    LWIP_ASSERT("invalid length", object_def.v_len <= 0xff);
+    vb = snmp_varbind_alloc(&oid, object_def.asn_type, (u8_t)object_def.v_len);
+    if (vb != NULL)
+    {
+      mn->get_value(&object_def, object_def.v_len, vb->value);
+    }
+  }
+  if (vb == NULL)
+  {
+    LWIP_DEBUGF(SNMP_MSG_DEBUG, ("snmp_msg_getbulk_next: couldn't allocate outvb space\n"));
+    return ERR_MEM;
+  }
+  snmp_varbind_tail_add(&msg_ps->outvb, vb);
+  return ERR_OK;
+}
+
+/**
+ * Service a GetBulk request (RFC 3416).
+ * The first non-repeaters varbinds get one GetNext each. The others are
+ * repeated up to max-repetitions times, each repetition stepping on from
+ * the names the previous one returned in outvb, so the table is walked
+ * once rather than once per varbind. The response is built in one go and
+ * ends early when every repeater has reached the end of the MIB, when it
+ * holds SNMP_GETBULK_MAX_VARBINDS, or at an external MIB node.
+ *
+ * @param request_id identifies requests from 0 to (SNMP_CONCURRENT_REQUESTS-1)
+ * @param msg_ps points to the assosicated message process state
+ */
+static void
+snmp_msg_getbulk_event(u8_t request_id, struct snmp_msg_pstat *msg_ps)
+{
+  struct snmp_varbind *vb, *prev, *last;
+  s32_t non_rep, r;
+  u8_t repeaters, i, end, end_cnt;
+  err_t err;
+
+  LWIP_UNUSED_ARG(request_id);
+  LWIP_DEBUGF(SNMP_MSG_DEBUG, ("snmp_msg_getbulk_event: non-repeaters==%"S32_F" max-repetitions==%"S32_F"\n",
+                               msg_ps->non_repeaters, msg_ps->max_repetitions));
+
+  non_rep = msg_ps->non_repeaters;
+  if (non_rep < 0)
+  {
+    non_rep = 0;
+  }
+  else if (non_rep > msg_ps->invb.count)
+  {
+    non_rep = msg_ps->invb.count;
+  }
+  repeaters = msg_ps->invb.count - (u8_t)non_rep;
+
+  err = ERR_OK;
+  vb = msg_ps->invb.head;
+  msg_ps->vb_idx = 0;
+  while ((err == ERR_OK) && (msg_ps->vb_idx < non_rep))
+  {
+    err = snmp_msg_getbulk_next(msg_ps, vb->ident_len, vb->ident, &end);
+    if (err == ERR_OK)
+    {
+      vb = vb->next;
+      msg_ps->vb_idx += 1;
+    }
+  }
+
+  /* prev is the first of the names the next repetition steps on from:
+     the request's own for the first, the last repetition's after that */
+  prev = vb;
+  r = 0;
+  while ((err == ERR_OK) && (r < msg_ps->max_repetitions) && (repeaters > 0))
+  {
+    last = msg_ps->outvb.tail;
+    end_cnt = 0;
+    vb = prev;
+    for (i = 0; (err == ERR_OK) && (i < repeaters); i++)
+    {
+      msg_ps->vb_idx = (u8_t)non_rep + i;
+      err = snmp_msg_getbulk_next(msg_ps, vb->ident_len, vb->ident, &end);
+      end_cnt += end;
+      vb = vb->next;
+    }
+    prev = (last == NULL) ? msg_ps->outvb.head : last->next;
+    r++;
+    if (end_cnt == repeaters)
+    {
+      /* all repeaters are at the end of the MIB, the rest would repeat it */
+      break;
+    }
+  }
+
+  if ((err == ERR_OK) || (msg_ps->outvb.count > 0))
+  {
+    /* a response may be cut short anywhere */
+    snmp_ok_response(msg_ps);
+  }
+  else if (err == ERR_VAL)
+  {
+    snmp_error_response(msg_ps,SNMP_ES_GENERROR);
+  }
+  else
+  {
+    snmp_error_response(msg_ps,SNMP_ES_TOOBIG);
+  }
+}
+#endif /* SNMP_GETBULK */
+
 /**
  * Service an internal or external event for SNMP SET.
  *
@@ -800,6 +988,12 @@ snmp_msg_event(u8_t request_id)
     {
       snmp_msg_set_event(request_id, msg_ps);
     }
+#if SNMP_GETBULK
+    else if (msg_ps->rt == SNMP_ASN1_PDU_GET_BULK_REQ)
+    {
+      snmp_msg_getbulk_event(request_id, msg_ps);
+    }
+#endif /* SNMP_GETBULK */
   }
 }
 
@@ -849,6 +1043,9 @@ snmp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *addr, u16_t
   if ((err_ret != ERR_OK) ||
       ((msg_ps->rt != SNMP_ASN1_PDU_GET_REQ) &&
        (msg_ps->rt != SNMP_ASN1_PDU_GET_NEXT_REQ) &&
+#if SNMP_GETBULK
+       (msg_ps->rt != SNMP_ASN1_PDU_GET_BULK_REQ) &&
+#endif /* SNMP_GETBULK */
        (msg_ps->rt != SNMP_ASN1_PDU_SET_REQ)) ||
       ((msg_ps->error_status != SNMP_ES_NOERROR) ||
        (msg_ps->error_index != 0)) )
@@ -934,12 +1131,22 @@ snmp_pdu_header_check(struct pbuf *p, u16_t ofs, u16_t pdu_len, u16_t *ofs_ret,
     snmp_inc_snmpinasnparseerrs();
     return ERR_ARG;
   }
-  if (version != 0)
+#if SNMP_GETBULK
+  if ((version != SNMP_VERSION_1) && (version != SNMP_VERSION_2c))
+  {
+    /* neither version 1 nor version 2c */
+    snmp_inc_snmpinbadversions();
+    return ERR_ARG;
+  }
+#else /* SNMP_GETBULK */
+  if (version != SNMP_VERSION_1)
   {
     /* not version 1 */
     snmp_inc_snmpinbadversions();
     return ERR_ARG;
   }
+#endif /* SNMP_GETBULK */
+  m_stat->version = version;
   ofs += (1 + len_octets + len);
   snmp_asn1_dec_type(p, ofs, &type);
   derr = snmp_asn1_dec_length(p, ofs+1, &len_octets, &len);
@@ -1001,6 +1208,20 @@ snmp_pdu_header_check(struct pbuf *p, u16_t ofs, u16_t pdu_len, u16_t *ofs_ret,
       snmp_inc_snmpintraps();
       derr = ERR_ARG;
       break;
+#if SNMP_GETBULK
+    case (SNMP_ASN1_CONTXT | SNMP_ASN1_CONSTR | SNMP_ASN1_PDU_GET_BULK_REQ):
+      /* GetBulkRequest PDU, only defined for v2c */
+      if (version == SNMP_VERSION_2c)
+      {
+        derr = ERR_OK;
+      }
+      else
+      {
+        snmp_inc_snmpinasnparseerrs();
+        derr = ERR_ARG;
+      }
+      break;
+#endif /* SNMP_GETBULK */
     default:
       snmp_inc_snmpinasnparseerrs();
       derr = ERR_ARG;
@@ -1052,6 +1273,14 @@ snmp_pdu_header_check(struct pbuf *p, u16_t ofs, u16_t pdu_len, u16_t *ofs_ret,
     snmp_inc_snmpinasnparseerrs();
     return ERR_ARG;
   }
+#if SNMP_GETBULK
+  /* GetBulk carries non-repeaters here, not an error-status */
+  if (m_stat->rt == SNMP_ASN1_PDU_GET_BULK_REQ)
+  {
+    m_stat->non_repeaters = m_stat->error_status;
+    m_stat->error_status = SNMP_ES_NOERROR;
+  }
+#endif /* SNMP_GETBULK */
   switch (m_stat->error_status)
   {
     case SNMP_ES_TOOBIG:
@@ -1088,6 +1317,14 @@ snmp_pdu_header_check(struct pbuf *p, u16_t ofs, u16_t pdu_len, u16_t *ofs_ret,
     snmp_inc_snmpinasnparseerrs();
     return ERR_ARG;
   }
+#if SNMP_GETBULK
+  /* GetBulk carries max-repetitions here, not an error-index */
+  if (m_stat->rt == SNMP_ASN1_PDU_GET_BULK_REQ)
+  {
+    m_stat->max_repetitions = m_stat->error_index;
+    m_stat->error_index = 0;
+  }
+#endif /* SNMP_GETBULK */
   ofs += (1 + len_octets + len);
   *ofs_ret = ofs;
   return ERR_OK;
@@ -1434,4 +1671,25 @@ snmp_varbind_tail_remove(struct snmp_varbind_root *root)
   return vb;
 }
 
+#if SNMP_GETBULK
+/**
+ * Allocates an endOfMibView varbind for ident, the name it was
+ * requested with.
+ */
+static struct snmp_varbind*
+snmp_end_of_mib_view_alloc(u8_t ident_len, s32_t *ident)
+{
+  struct snmp_obj_id oid;
+  u8_t i;
+
+  LWIP_ASSERT("ident_len <= LWIP_SNMP_OBJ_ID_LEN", ident_len <= LWIP_SNMP_OBJ_ID_LEN);
+  oid.len = ident_len;
+  for (i = 0; i < ident_len; i++)
+  {
+    oid.id[i] = ident[i];
+  }
+  return snmp_varbind_alloc(&oid, (SNMP_ASN1_CONTXT | SNMP_ASN1_PRIMIT | SNMP_ASN1_END_OF_MIB_VIEW), 0);
+}
+#endif /* SNMP_GETBULK */
+
 #endif /* LWIP_SNMP */
@@ -120,6 +120,23 @@ snmp_send_response(struct snmp_msg_pstat *m_stat)
   /* pass 0, calculate length fields */
   tot_len = snmp_varbind_list_sum(&m_stat->outvb);
   tot_len = snmp_resp_header_sum(m_stat, tot_len);
+#if SNMP_GETBULK
+  if (m_stat->rt == SNMP_ASN1_PDU_GET_BULK_REQ)
+  {
+    /* a GetBulk response is shortened rather than answered with tooBig,
+       the lengths of the remaining varbinds stay valid */
+    while ((tot_len > SNMP_GETBULK_MAX_RESPONSE) && (m_stat->outvb.count > 1))
+    {
+      struct snmp_varbind *vb;
+
+      vb = snmp_varbind_tail_remove(&m_stat->outvb);
+      m_stat->outvb.seqlen -= 1 + vb->seqlenlen + vb->seqlen;
+      snmp_varbind_free(vb);
+      snmp_asn1_enc_length_cnt(m_stat->outvb.seqlen, &m_stat->outvb.seqlenlen);
+      tot_len = snmp_resp_header_sum(m_stat, 1 + m_stat->outvb.seqlenlen + m_stat->outvb.seqlen);
+    }
+  }
+#endif /* SNMP_GETBULK */
 
   /* try allocating pbuf(s) for complete response */
   p = pbuf_alloc(PBUF_TRANSPORT, tot_len, PBUF_POOL);
@@ -343,7 +360,7 @@ snmp_resp_header_sum(struct snmp_msg_pstat *m_stat, u16_t vb_len)
   snmp_asn1_enc_length_cnt(rhl->comlen, &rhl->comlenlen);
   tot_len += 1 + rhl->comlenlen + rhl->comlen;
 
-  snmp_asn1_enc_s32t_cnt(snmp_version, &rhl->verlen);
+  snmp_asn1_enc_s32t_cnt(m_stat->version, &rhl->verlen);
   snmp_asn1_enc_length_cnt(rhl->verlen, &rhl->verlenlen);
   tot_len += 1 + rhl->verlen + rhl->verlenlen;
 
@@ -498,7 +515,7 @@ snmp_resp_header_enc(struct snmp_msg_pstat *m_stat, struct pbuf *p)
   ofs += 1;
   snmp_asn1_enc_length(p, ofs, m_stat->rhl.verlen);
   ofs += m_stat->rhl.verlenlen;
-  snmp_asn1_enc_s32t(p, ofs, m_stat->rhl.verlen, snmp_version);
+  snmp_asn1_enc_s32t(p, ofs, m_stat->rhl.verlen, m_stat->version);
   ofs += m_stat->rhl.verlen;
 
   snmp_asn1_enc_type(p, ofs, (SNMP_ASN1_UNIV | SNMP_ASN1_PRIMIT | SNMP_ASN1_OC_STR));
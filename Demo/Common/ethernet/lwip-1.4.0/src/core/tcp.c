@@ -87,6 +87,10 @@ union tcp_listen_pcbs_t tcp_listen_pcbs;
 struct tcp_pcb *tcp_active_pcbs;
 /** List of all TCP PCBs in TIME-WAIT state */
 struct tcp_pcb *tcp_tw_pcbs;
+#if TCP_COMPACT_TIME_WAIT
+/** List of the connections in TIME-WAIT whose pcb has been freed */
+struct tcp_tw *tcp_tw_records;
+#endif /* TCP_COMPACT_TIME_WAIT */
 
 #define NUM_TCP_PCB_LISTS               4
 #define NUM_TCP_PCB_LISTS_NO_TIME_WAIT  3
@@ -97,6 +101,13 @@ struct tcp_pcb ** const tcp_pcb_lists[] = {&tcp_listen_pcbs.pcbs, &tcp_bound_pcb
 /** Only used for temporary storage. */
 struct tcp_pcb *tcp_tmp_pcb;
 
+#if TCP_PCB_HASH_SIZE
+/** Hash chains of all pcbs in tcp_active_pcbs and tcp_tw_pcbs */
+struct tcp_pcb *tcp_conn_hash[TCP_PCB_HASH_SIZE];
+/** Hash chains of all pcbs in tcp_listen_pcbs */
+struct tcp_pcb_listen *tcp_listen_hash[TCP_PCB_HASH_SIZE];
+#endif /* TCP_PCB_HASH_SIZE */
+
 /** Timer counter to handle calling slow-timer from tcp_tmr() */ 
 static u8_t tcp_timer;
 static u16_t tcp_new_port(void);
@@ -140,7 +151,7 @@ tcp_close_shutdown(struct tcp_pcb *pcb, u8_t rst_on_unacked_data)
   err_t err;
 
   if (rst_on_unacked_data && (pcb->state != LISTEN)) {
-    if ((pcb->refused_data != NULL) || (pcb->rcv_wnd != TCP_WND)) {
+    if ((pcb->refused_data != NULL) || (pcb->rcv_wnd != TCP_WND_MAX(pcb))) {
       /* Not all data received by application, send RST to tell the remote
          side about this. */
       LWIP_ASSERT("pcb->flags & TF_RXCLOSED", pcb->flags & TF_RXCLOSED);
@@ -251,6 +262,9 @@ tcp_close_shutdown(struct tcp_pcb *pcb, u8_t rst_on_unacked_data)
 err_t
 tcp_close(struct tcp_pcb *pcb)
 {
+#if TCP_COMPACT_TIME_WAIT
+  err_t err;
+#endif /* TCP_COMPACT_TIME_WAIT */
 #if TCP_DEBUG
   LWIP_DEBUGF(TCP_DEBUG, ("tcp_close: closing in "));
   tcp_debug_print_state(pcb->state);
@@ -259,9 +273,22 @@ tcp_close(struct tcp_pcb *pcb)
   if (pcb->state != LISTEN) {
     /* Set a flag not to receive any more data... */
     pcb->flags |= TF_RXCLOSED;
+#if TCP_COMPACT_TIME_WAIT
+    /* ... and one that the pcb may be freed in TIME-WAIT */
+    pcb->app_closed = 1;
+#endif /* TCP_COMPACT_TIME_WAIT */
   }
   /* ... and close */
+#if TCP_COMPACT_TIME_WAIT
+  err = tcp_close_shutdown(pcb, 1);
+  if (err != ERR_OK) {
+    /* the pcb has not been freed and still belongs to the application */
+    pcb->app_closed = 0;
+  }
+  return err;
+#else /* TCP_COMPACT_TIME_WAIT */
   return tcp_close_shutdown(pcb, 1);
+#endif /* TCP_COMPACT_TIME_WAIT */
 }
 
 /**
@@ -286,6 +313,9 @@ tcp_shutdown(struct tcp_pcb *pcb, int shut_rx, int shut_tx)
       pbuf_free(pcb->refused_data);
       pcb->refused_data = NULL;
     }
+#if TCP_RX_COALESCE
+    tcp_rx_discard(pcb);
+#endif /* TCP_RX_COALESCE */
     /* ... and set a flag not to receive any more data */
     pcb->flags |= TF_RXCLOSED;
   }
@@ -441,6 +471,20 @@ tcp_bind(struct tcp_pcb *pcb, ip_addr_t *ipaddr, u16_t port)
       }
     }
   }
+#if TCP_COMPACT_TIME_WAIT
+  /* TIME-WAIT records are checked like the pcbs in TIME-WAIT */
+  if (max_pcb_list == NUM_TCP_PCB_LISTS) {
+    struct tcp_tw *tw;
+    for (tw = tcp_tw_records; tw != NULL; tw = tw->next) {
+      if ((tw->local_port == port) &&
+          (ip_addr_isany(&(tw->local_ip)) ||
+           ip_addr_isany(ipaddr) ||
+           ip_addr_cmp(&(tw->local_ip), ipaddr))) {
+        return ERR_USE;
+      }
+    }
+  }
+#endif /* TCP_COMPACT_TIME_WAIT */
 
   if (!ip_addr_isany(ipaddr)) {
     pcb->local_ip = *ipaddr;
@@ -556,8 +600,8 @@ u32_t tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb)
     } else {
       /* keep the right edge of window constant */
       u32_t new_rcv_ann_wnd = pcb->rcv_ann_right_edge - pcb->rcv_nxt;
-      LWIP_ASSERT("new_rcv_ann_wnd <= 0xffff", new_rcv_ann_wnd <= 0xffff);
-      pcb->rcv_ann_wnd = (u16_t)new_rcv_ann_wnd;
+      LWIP_ASSERT("new_rcv_ann_wnd <= TCP_WND", new_rcv_ann_wnd <= TCP_WND);
+      pcb->rcv_ann_wnd = (tcpwnd_size_t)new_rcv_ann_wnd;
     }
     return 0;
   }
@@ -574,15 +618,16 @@ u32_t tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb)
 void
 tcp_recved(struct tcp_pcb *pcb, u16_t len)
 {
-  int wnd_inflation;
+  u32_t wnd_inflation;
+  tcpwnd_size_t rcv_wnd;
 
-  LWIP_ASSERT("tcp_recved: len would wrap rcv_wnd\n",
-              len <= 0xffff - pcb->rcv_wnd );
+  rcv_wnd = (tcpwnd_size_t)(pcb->rcv_wnd + len);
+  LWIP_ASSERT("tcp_recved: len would wrap rcv_wnd\n", rcv_wnd >= pcb->rcv_wnd);
 
-  pcb->rcv_wnd += len;
-  if (pcb->rcv_wnd > TCP_WND) {
-    pcb->rcv_wnd = TCP_WND;
+  if (rcv_wnd > TCP_WND_MAX(pcb)) {
+    rcv_wnd = TCP_WND_MAX(pcb);
   }
+  pcb->rcv_wnd = rcv_wnd;
 
   wnd_inflation = tcp_update_rcv_ann_wnd(pcb);
 
@@ -590,13 +635,20 @@ tcp_recved(struct tcp_pcb *pcb, u16_t len)
    * watermark is TCP_WND/4), then send an explicit update now.
    * Otherwise wait for a packet to be sent in the normal course of
    * events (or more window to be available later) */
+#if LWIP_WND_SCALE || TCP_WND_AUTOTUNE
+  /* The window in use may be much smaller than TCP_WND (no scaling agreed,
+     or auto-tuning has not grown it yet): scale the watermark down with it
+     or a closed window might never be reopened explicitly. */
+  if (wnd_inflation >= LWIP_MIN(TCP_WND_UPDATE_THRESHOLD, TCP_WND_MAX(pcb) / 4)) {
+#else /* LWIP_WND_SCALE || TCP_WND_AUTOTUNE */
   if (wnd_inflation >= TCP_WND_UPDATE_THRESHOLD) {
+#endif /* LWIP_WND_SCALE || TCP_WND_AUTOTUNE */
     tcp_ack_now(pcb);
     tcp_output(pcb);
   }
 
-  LWIP_DEBUGF(TCP_DEBUG, ("tcp_recved: recveived %"U16_F" bytes, wnd %"U16_F" (%"U16_F").\n",
-         len, pcb->rcv_wnd, TCP_WND - pcb->rcv_wnd));
+  LWIP_DEBUGF(TCP_DEBUG, ("tcp_recved: recveived %"U16_F" bytes, wnd %"TCPWNDSIZE_F" (%"TCPWNDSIZE_F").\n",
+         len, pcb->rcv_wnd, TCP_WND_MAX(pcb) - pcb->rcv_wnd));
 }
 
 /**
@@ -617,6 +669,9 @@ tcp_new_port(void)
 #define TCP_LOCAL_PORT_RANGE_END    0xffff
 #endif
   static u16_t port = TCP_LOCAL_PORT_RANGE_START;
+#if TCP_COMPACT_TIME_WAIT
+  struct tcp_tw *tw;
+#endif /* TCP_COMPACT_TIME_WAIT */
   
  again:
   if (port++ >= TCP_LOCAL_PORT_RANGE_END) {
@@ -630,6 +685,13 @@ tcp_new_port(void)
       }
     }
   }
+#if TCP_COMPACT_TIME_WAIT
+  for (tw = tcp_tw_records; tw != NULL; tw = tw->next) {
+    if (tw->local_port == port) {
+      goto again;
+    }
+  }
+#endif /* TCP_COMPACT_TIME_WAIT */
   return port;
 }
 
@@ -698,6 +760,19 @@ tcp_connect(struct tcp_pcb *pcb, ip_addr_t *ipaddr, u16_t port,
         }
       }
     }
+#if TCP_COMPACT_TIME_WAIT
+    {
+      struct tcp_tw *tw;
+      for (tw = tcp_tw_records; tw != NULL; tw = tw->next) {
+        if ((tw->local_port == pcb->local_port) &&
+            (tw->remote_port == port) &&
+            ip_addr_cmp(&tw->local_ip, &pcb->local_ip) &&
+            ip_addr_cmp(&tw->remote_ip, ipaddr)) {
+          return ERR_USE;
+        }
+      }
+    }
+#endif /* TCP_COMPACT_TIME_WAIT */
   }
 #endif /* SO_REUSE */
   iss = tcp_next_iss();
@@ -705,8 +780,13 @@ tcp_connect(struct tcp_pcb *pcb, ip_addr_t *ipaddr, u16_t port,
   pcb->snd_nxt = iss;
   pcb->lastack = iss - 1;
   pcb->snd_lbb = iss - 1;
-  pcb->rcv_wnd = TCP_WND;
-  pcb->rcv_ann_wnd = TCP_WND;
+#if LWIP_TCP_NEWRENO
+  pcb->recover = iss;
+#endif /* LWIP_TCP_NEWRENO */
+  pcb->rcv_wnd = pcb->rcv_ann_wnd = TCP_WND_INIT;
+#if TCP_WND_AUTOTUNE
+  pcb->rcv_wnd_max = TCP_WND_INIT;
+#endif /* TCP_WND_AUTOTUNE */
   pcb->rcv_ann_right_edge = pcb->rcv_nxt;
   pcb->snd_wnd = TCP_WND;
   /* As initial send MSS, we use TCP_MSS but limit it to 536.
@@ -750,7 +830,7 @@ void
 tcp_slowtmr(void)
 {
   struct tcp_pcb *pcb, *prev;
-  u16_t eff_wnd;
+  tcpwnd_size_t eff_wnd;
   u8_t pcb_remove;      /* flag if a PCB should be removed */
   u8_t pcb_reset;       /* flag if a RST should be sent when removing */
   err_t err;
@@ -816,12 +896,12 @@ tcp_slowtmr(void)
           /* Reduce congestion window and ssthresh. */
           eff_wnd = LWIP_MIN(pcb->cwnd, pcb->snd_wnd);
           pcb->ssthresh = eff_wnd >> 1;
-          if (pcb->ssthresh < (pcb->mss << 1)) {
+          if (pcb->ssthresh < (tcpwnd_size_t)(pcb->mss << 1)) {
             pcb->ssthresh = (pcb->mss << 1);
           }
           pcb->cwnd = pcb->mss;
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_slowtmr: cwnd %"U16_F
-                                       " ssthresh %"U16_F"\n",
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_slowtmr: cwnd %"TCPWNDSIZE_F
+                                       " ssthresh %"TCPWNDSIZE_F"\n",
                                        pcb->cwnd, pcb->ssthresh));
  
           /* The following needs to be called AFTER cwnd is set to one
@@ -923,6 +1003,8 @@ tcp_slowtmr(void)
           pcb->local_port, pcb->remote_port);
       }
 
+      TCP_HASH_RMV(&tcp_active_pcbs, pcb);
+
       pcb2 = pcb;
       pcb = pcb->next;
       memp_free(MEMP_TCP_PCB, pcb2);
@@ -973,6 +1055,7 @@ tcp_slowtmr(void)
         LWIP_ASSERT("tcp_slowtmr: first pcb == tcp_tw_pcbs", tcp_tw_pcbs == pcb);
         tcp_tw_pcbs = pcb->next;
       }
+      TCP_HASH_RMV(&tcp_tw_pcbs, pcb);
       pcb2 = pcb;
       pcb = pcb->next;
       memp_free(MEMP_TCP_PCB, pcb2);
@@ -981,6 +1064,31 @@ tcp_slowtmr(void)
       pcb = pcb->next;
     }
   }
+
+#if TCP_COMPACT_TIME_WAIT
+  /* Free the TIME-WAIT pcbs that entered TIME-WAIT from tcp_close() or were
+     closed by the application only after entering it. */
+  pcb = tcp_tw_pcbs;
+  while (pcb != NULL) {
+    struct tcp_pcb *next = pcb->next;
+    tcp_tw_compact(pcb);
+    pcb = next;
+  }
+
+  /* Steps through all of the TIME-WAIT records. */
+  {
+    struct tcp_tw *tw, **ptw = &tcp_tw_records;
+    while (*ptw != NULL) {
+      tw = *ptw;
+      if ((u32_t)(tcp_ticks - tw->tmr) > 2 * TCP_MSL / TCP_SLOW_INTERVAL) {
+        *ptw = tw->next;
+        memp_free(MEMP_TCP_TW, tw);
+      } else {
+        ptw = &(tw->next);
+      }
+    }
+  }
+#endif /* TCP_COMPACT_TIME_WAIT */
 }
 
 /**
@@ -1004,6 +1112,9 @@ tcp_fasttmr(void)
       TCP_EVENT_RECV(pcb, pcb->refused_data, ERR_OK, err);
       if (err == ERR_OK) {
         pcb->refused_data = NULL;
+#if TCP_RX_COALESCE
+        tcp_rx_queue(pcb);
+#endif /* TCP_RX_COALESCE */
       } else if (err == ERR_ABRT) {
         /* if err == ERR_ABRT, 'pcb' is already deallocated */
         pcb = NULL;
@@ -1020,8 +1131,136 @@ tcp_fasttmr(void)
 
     pcb = next;
   }
+
+#if TCP_RX_COALESCE
+  /* in case the driver does not end its input batches */
+  tcp_rx_flush();
+#endif /* TCP_RX_COALESCE */
+}
+
+#if LWIP_TCP_TIMER_SLEEP
+/**
+ * Calculates after how many further calls of tcp_slowtmr() the check
+ * 'tcp_ticks - pcb->tmr > limit' it does for a pcb becomes true.
+ */
+static u32_t
+tcp_ticks_until(struct tcp_pcb *pcb, u32_t limit)
+{
+  u32_t elapsed = (u32_t)(tcp_ticks - pcb->tmr);
+  return (elapsed > limit) ? 1 : (limit - elapsed + 1);
 }
 
+/**
+ * Finds out how long the TCP timers have nothing to do but count. Called by
+ * the TCP timeout (LWIP_TCP_TIMER_SLEEP) to decide whether it can sleep.
+ *
+ * @param max_ticks upper limit for the result
+ * @return number of tcp_slowtmr() calls up to and including the first one
+ *         that would act on a pcb, or 0 if a pcb has a short timer pending
+ *         (retransmission, persist, delayed ACK, refused data, ooseq data)
+ */
+u32_t
+tcp_idle_ticks(u32_t max_ticks)
+{
+  struct tcp_pcb *pcb;
+  u32_t ticks = max_ticks;
+  u32_t t;
+
+  for (pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
+    if ((pcb->refused_data != NULL) || (pcb->unsent != NULL) ||
+        (pcb->unacked != NULL) || (pcb->persist_backoff > 0) ||
+#if TCP_RX_COALESCE
+        (pcb->rx_held != NULL) ||
+#endif /* TCP_RX_COALESCE */
+#if TCP_QUEUE_OOSEQ
+        (pcb->ooseq != NULL) ||
+#endif /* TCP_QUEUE_OOSEQ */
+        (pcb->flags & (TF_ACK_DELAY | TF_ACK_NOW))) {
+      return 0;
+    }
+    switch (pcb->state) {
+    case FIN_WAIT_2:
+      t = tcp_ticks_until(pcb, TCP_FIN_WAIT_TIMEOUT / TCP_SLOW_INTERVAL);
+      break;
+    case SYN_RCVD:
+      t = tcp_ticks_until(pcb, TCP_SYN_RCVD_TIMEOUT / TCP_SLOW_INTERVAL);
+      break;
+    case LAST_ACK:
+      t = tcp_ticks_until(pcb, 2 * TCP_MSL / TCP_SLOW_INTERVAL);
+      break;
+    default:
+      t = max_ticks;
+      break;
+    }
+    ticks = LWIP_MIN(ticks, t);
+
+    /* the next keepalive comes before the keepalive abort */
+    if((pcb->so_options & SOF_KEEPALIVE) &&
+       ((pcb->state == ESTABLISHED) ||
+        (pcb->state == CLOSE_WAIT))) {
+#if LWIP_TCP_KEEPALIVE
+      t = tcp_ticks_until(pcb, (pcb->keep_idle + pcb->keep_cnt_sent * pcb->keep_intvl)
+                               / TCP_SLOW_INTERVAL);
+#else
+      t = tcp_ticks_until(pcb, (pcb->keep_idle + pcb->keep_cnt_sent * TCP_KEEPINTVL_DEFAULT)
+                               / TCP_SLOW_INTERVAL);
+#endif /* LWIP_TCP_KEEPALIVE */
+      ticks = LWIP_MIN(ticks, t);
+    }
+
+#if LWIP_CALLBACK_API
+    if (pcb->poll != NULL)
+#endif /* LWIP_CALLBACK_API */
+    {
+      t = (pcb->polltmr < pcb->pollinterval) ? (u32_t)(pcb->pollinterval - pcb->polltmr) : 1;
+      ticks = LWIP_MIN(ticks, t);
+    }
+  }
+
+  for (pcb = tcp_tw_pcbs; pcb != NULL; pcb = pcb->next) {
+#if TCP_COMPACT_TIME_WAIT
+    if (TCP_TW_CAN_COMPACT(pcb)) {
+      /* the next tcp_slowtmr() swaps it for a record */
+      return 1;
+    }
+#endif /* TCP_COMPACT_TIME_WAIT */
+    t = tcp_ticks_until(pcb, 2 * TCP_MSL / TCP_SLOW_INTERVAL);
+    ticks = LWIP_MIN(ticks, t);
+  }
+#if TCP_COMPACT_TIME_WAIT
+  {
+    struct tcp_tw *tw;
+    for (tw = tcp_tw_records; tw != NULL; tw = tw->next) {
+      u32_t elapsed = (u32_t)(tcp_ticks - tw->tmr);
+      t = (elapsed > 2 * TCP_MSL / TCP_SLOW_INTERVAL) ? 1 :
+          (2 * TCP_MSL / TCP_SLOW_INTERVAL - elapsed + 1);
+      ticks = LWIP_MIN(ticks, t);
+    }
+  }
+#endif /* TCP_COMPACT_TIME_WAIT */
+  return ticks;
+}
+
+/**
+ * Accounts for calls of tcp_slowtmr() that were left out while the TCP
+ * timeout slept. Must only skip fewer ticks than tcp_idle_ticks() returned.
+ * The next call of tcp_tmr() runs tcp_slowtmr().
+ *
+ * @param ticks number of tcp_slowtmr() calls left out
+ */
+void
+tcp_tmr_skip(u32_t ticks)
+{
+  struct tcp_pcb *pcb;
+
+  tcp_ticks += ticks;
+  for (pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next) {
+    pcb->polltmr = (u8_t)LWIP_MIN(pcb->polltmr + ticks, pcb->pollinterval);
+  }
+  tcp_timer &= (u8_t)~1;
+}
+#endif /* LWIP_TCP_TIMER_SLEEP */
+
 /**
  * Deallocates a list of TCP segments (tcp_seg structures).
  *
@@ -1046,6 +1285,10 @@ void
 tcp_seg_free(struct tcp_seg *seg)
 {
   if (seg != NULL) {
+#if LWIP_TCP_WRITE_REF
+    tcp_write_done_fn done = seg->done;
+    void *done_arg = seg->done_arg;
+#endif /* LWIP_TCP_WRITE_REF */
     if (seg->p != NULL) {
       pbuf_free(seg->p);
 #if TCP_DEBUG
@@ -1053,6 +1296,12 @@ tcp_seg_free(struct tcp_seg *seg)
 #endif /* TCP_DEBUG */
     }
     memp_free(MEMP_TCP_SEG, seg);
+#if LWIP_TCP_WRITE_REF
+    if (done != NULL) {
+      /* the application buffer of a tcp_write_ref() is no longer used */
+      done(done_arg);
+    }
+#endif /* LWIP_TCP_WRITE_REF */
   }
 }
 
@@ -1087,6 +1336,10 @@ tcp_seg_copy(struct tcp_seg *seg)
   }
   SMEMCPY((u8_t *)cseg, (const u8_t *)seg, sizeof(struct tcp_seg)); 
   pbuf_ref(cseg->p);
+#if LWIP_TCP_WRITE_REF
+  /* received segments never carry a callback */
+  cseg->done = NULL;
+#endif /* LWIP_TCP_WRITE_REF */
   return cseg;
 }
 #endif /* TCP_QUEUE_OOSEQ */
@@ -1170,6 +1423,68 @@ tcp_kill_timewait(void)
   }
 }
 
+#if TCP_COMPACT_TIME_WAIT
+/**
+ * Frees a pcb in TIME-WAIT and keeps only a struct tcp_tw for it, if the
+ * application has closed it. If the MEMP_TCP_TW pool is empty, the oldest
+ * record is reused. Called where no callback of the pcb can be running:
+ * at the end of tcp_input() and from tcp_slowtmr().
+ *
+ * @param pcb the tcp_pcb in TIME-WAIT
+ */
+void
+tcp_tw_compact(struct tcp_pcb *pcb)
+{
+  struct tcp_tw *tw, **ptw, **oldest;
+  u32_t inactivity;
+
+  LWIP_ASSERT("tcp_tw_compact: pcb->state == TIME_WAIT", pcb->state == TIME_WAIT);
+  if (!TCP_TW_CAN_COMPACT(pcb)) {
+    return;
+  }
+
+  tw = (struct tcp_tw *)memp_malloc(MEMP_TCP_TW);
+  if (tw == NULL) {
+    /* Reuse the oldest record, as tcp_kill_timewait() would have killed
+       the oldest pcb. */
+    inactivity = 0;
+    oldest = NULL;
+    for (ptw = &tcp_tw_records; *ptw != NULL; ptw = &((*ptw)->next)) {
+      if ((u32_t)(tcp_ticks - (*ptw)->tmr) >= inactivity) {
+        inactivity = tcp_ticks - (*ptw)->tmr;
+        oldest = ptw;
+      }
+    }
+    if (oldest == NULL) {
+      /* MEMP_NUM_TCP_TW is 0: keep the pcb */
+      return;
+    }
+    tw = *oldest;
+    *oldest = tw->next;
+    LWIP_DEBUGF(TCP_DEBUG, ("tcp_tw_compact: reusing oldest TIME-WAIT record (%"U32_F")\n",
+           inactivity));
+  }
+
+  ip_addr_copy(tw->local_ip, pcb->local_ip);
+  ip_addr_copy(tw->remote_ip, pcb->remote_ip);
+  tw->local_port = pcb->local_port;
+  tw->remote_port = pcb->remote_port;
+  tw->rcv_nxt = pcb->rcv_nxt;
+  tw->snd_nxt = pcb->snd_nxt;
+  tw->rcv_wnd = pcb->rcv_wnd;
+  tw->ann_wnd = TCPWND16(RCV_WND_SCALE(pcb, pcb->rcv_ann_wnd));
+  tw->ttl = pcb->ttl;
+  tw->tos = pcb->tos;
+  tw->tmr = pcb->tmr;
+  tw->next = tcp_tw_records;
+  tcp_tw_records = tw;
+
+  TCP_RMV(&tcp_tw_pcbs, pcb);
+  tcp_pcb_purge(pcb);
+  memp_free(MEMP_TCP_PCB, pcb);
+}
+#endif /* TCP_COMPACT_TIME_WAIT */
+
 /**
  * Allocate a new tcp_pcb structure.
  *
@@ -1210,8 +1525,11 @@ tcp_alloc(u8_t prio)
     pcb->prio = prio;
     pcb->snd_buf = TCP_SND_BUF;
     pcb->snd_queuelen = 0;
-    pcb->rcv_wnd = TCP_WND;
-    pcb->rcv_ann_wnd = TCP_WND;
+    pcb->rcv_wnd = pcb->rcv_ann_wnd = TCP_WND_INIT;
+#if TCP_WND_AUTOTUNE
+    pcb->rcv_wnd_max = TCP_WND_INIT;
+    pcb->rcv_tune_time = tcp_ticks;
+#endif /* TCP_WND_AUTOTUNE */
     pcb->tos = 0;
     pcb->ttl = TCP_TTL;
     /* As initial send MSS, we use TCP_MSS but limit it to 536.
@@ -1227,6 +1545,9 @@ tcp_alloc(u8_t prio)
     pcb->snd_nxt = iss;
     pcb->lastack = iss;
     pcb->snd_lbb = iss;   
+#if LWIP_TCP_NEWRENO
+    pcb->recover = iss;
+#endif /* LWIP_TCP_NEWRENO */
     pcb->tmr = tcp_ticks;
 
     pcb->polltmr = 0;
@@ -1351,6 +1672,10 @@ tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval)
   LWIP_UNUSED_ARG(poll);
 #endif /* LWIP_CALLBACK_API */  
   pcb->pollinterval = interval;
+#if LWIP_TCP_TIMER_SLEEP
+  /* wake the timer so that the new interval is used */
+  tcp_timer_needed();
+#endif /* LWIP_TCP_TIMER_SLEEP */
 }
 
 /**
@@ -1394,6 +1719,9 @@ tcp_pcb_purge(struct tcp_pcb *pcb)
       pbuf_free(pcb->refused_data);
       pcb->refused_data = NULL;
     }
+#if TCP_RX_COALESCE
+    tcp_rx_discard(pcb);
+#endif /* TCP_RX_COALESCE */
     if (pcb->unsent != NULL) {
       LWIP_DEBUGF(TCP_DEBUG, ("tcp_pcb_purge: not all data sent\n"));
     }
@@ -1412,8 +1740,9 @@ tcp_pcb_purge(struct tcp_pcb *pcb)
        queue if it fires */
     pcb->rtime = -1;
 
-    tcp_segs_free(pcb->unsent);
+    /* unacked first, so tcp_write_ref() callbacks run in order */
     tcp_segs_free(pcb->unacked);
+    tcp_segs_free(pcb->unsent);
     pcb->unacked = pcb->unsent = NULL;
 #if TCP_OVERSIZE
     pcb->unsent_oversize = 0;
@@ -1421,6 +1750,80 @@ tcp_pcb_purge(struct tcp_pcb *pcb)
   }
 }
 
+#if TCP_PCB_HASH_SIZE
+/**
+ * Calculates the hash chain of a connection from its four-tuple.
+ * Both addresses are in network byte order, so fold all of their bytes.
+ *
+ * @return index into tcp_conn_hash
+ */
+u16_t
+tcp_conn_hash_index(ip_addr_t *local_ip, u16_t local_port,
+                    ip_addr_t *remote_ip, u16_t remote_port)
+{
+  u32_t h;
+
+  h = ip4_addr_get_u32(local_ip) ^ ip4_addr_get_u32(remote_ip);
+  h ^= ((u32_t)local_port << 16) | remote_port;
+  h ^= h >> 16;
+  h ^= h >> 8;
+  return (u16_t)(h & (TCP_PCB_HASH_SIZE - 1));
+}
+
+/**
+ * Links a pcb into the hash chain of the list it has just been added to.
+ * Bound pcbs are not hashed as no segment is demultiplexed to them.
+ *
+ * @param pcbs PCB list the pcb was registered with
+ * @param pcb the pcb to hash
+ */
+void
+tcp_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  if (pcbs == &tcp_listen_pcbs.pcbs) {
+    struct tcp_pcb_listen *lpcb = (struct tcp_pcb_listen *)pcb;
+    struct tcp_pcb_listen **chain = &tcp_listen_hash[TCP_LISTEN_HASH(lpcb->local_port)];
+    lpcb->hash_next = *chain;
+    *chain = lpcb;
+  } else if ((pcbs == &tcp_active_pcbs) || (pcbs == &tcp_tw_pcbs)) {
+    struct tcp_pcb **chain = &tcp_conn_hash[tcp_conn_hash_index(&pcb->local_ip,
+      pcb->local_port, &pcb->remote_ip, pcb->remote_port)];
+    pcb->hash_next = *chain;
+    *chain = pcb;
+  }
+}
+
+/**
+ * Unlinks a pcb from its hash chain when it leaves a PCB list.
+ *
+ * @param pcbs PCB list the pcb was removed from
+ * @param pcb the pcb to unhash
+ */
+void
+tcp_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *pcb)
+{
+  if (pcbs == &tcp_listen_pcbs.pcbs) {
+    struct tcp_pcb_listen *lpcb = (struct tcp_pcb_listen *)pcb;
+    struct tcp_pcb_listen **link = &tcp_listen_hash[TCP_LISTEN_HASH(lpcb->local_port)];
+    while (*link != lpcb) {
+      LWIP_ASSERT("tcp_hash_remove: pcb is on its hash chain", *link != NULL);
+      link = &(*link)->hash_next;
+    }
+    *link = lpcb->hash_next;
+    lpcb->hash_next = NULL;
+  } else if ((pcbs == &tcp_active_pcbs) || (pcbs == &tcp_tw_pcbs)) {
+    struct tcp_pcb **link = &tcp_conn_hash[tcp_conn_hash_index(&pcb->local_ip,
+      pcb->local_port, &pcb->remote_ip, pcb->remote_port)];
+    while (*link != pcb) {
+      LWIP_ASSERT("tcp_hash_remove: pcb is on its hash chain", *link != NULL);
+      link = &(*link)->hash_next;
+    }
+    *link = pcb->hash_next;
+    pcb->hash_next = NULL;
+  }
+}
+#endif /* TCP_PCB_HASH_SIZE */
+
 /**
  * Purges the PCB and removes it from a PCB list. Any delayed ACKs are sent first.
  *
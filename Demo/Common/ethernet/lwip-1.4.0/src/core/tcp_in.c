@@ -69,15 +69,113 @@ static u16_t tcplen;
 static u8_t recv_flags;
 static struct pbuf *recv_data;
 
+#if LWIP_TCP_SACK
+/* SACK blocks of the segment being processed, in host byte order.
+   Set by tcp_parseopt(). */
+static u32_t sack_left[4], sack_right[4];
+static u8_t sack_num;
+#endif /* LWIP_TCP_SACK */
+
 struct tcp_pcb *tcp_input_pcb;
 
+#if TCP_RX_COALESCE
+struct tcp_pcb *tcp_rx_held_pcbs;
+#endif /* TCP_RX_COALESCE */
+
 /* Forward declarations. */
 static err_t tcp_process(struct tcp_pcb *pcb);
 static void tcp_receive(struct tcp_pcb *pcb);
 static void tcp_parseopt(struct tcp_pcb *pcb);
+#if TCP_WND_AUTOTUNE
+static void tcp_rcv_wnd_autotune(struct tcp_pcb *pcb);
+#endif /* TCP_WND_AUTOTUNE */
+#if LWIP_TCP_SACK
+static void tcp_sack_mark(struct tcp_pcb *pcb);
+#endif /* LWIP_TCP_SACK */
 
 static err_t tcp_listen_input(struct tcp_pcb_listen *pcb);
+#if TCP_RX_COALESCE
+static void tcp_rx_hold(struct tcp_pcb *pcb, struct pbuf *p);
+static err_t tcp_rx_deliver(struct tcp_pcb *pcb);
+#endif /* TCP_RX_COALESCE */
 static err_t tcp_timewait_input(struct tcp_pcb *pcb);
+#if TCP_COMPACT_TIME_WAIT
+static u8_t tcp_tw_record_input(void);
+#endif /* TCP_COMPACT_TIME_WAIT */
+
+#if TCP_PCB_HASH_SIZE
+/**
+ * Finds the connected or TIME-WAIT pcb of the segment in tcphdr. A hit is
+ * moved to the front of its hash chain since the next segment is likely to
+ * belong to the same connection.
+ *
+ * @return the matching pcb or NULL
+ */
+static struct tcp_pcb *
+tcp_hash_lookup(void)
+{
+  struct tcp_pcb **chain, **link, *pcb;
+
+  chain = &tcp_conn_hash[tcp_conn_hash_index(&current_iphdr_dest, tcphdr->dest,
+    &current_iphdr_src, tcphdr->src)];
+  for (link = chain; (pcb = *link) != NULL; link = &pcb->hash_next) {
+    LWIP_ASSERT("tcp_input: hashed pcb->state != CLOSED", pcb->state != CLOSED);
+    LWIP_ASSERT("tcp_input: hashed pcb->state != LISTEN", pcb->state != LISTEN);
+    if (pcb->remote_port == tcphdr->src &&
+       pcb->local_port == tcphdr->dest &&
+       ip_addr_cmp(&(pcb->remote_ip), &current_iphdr_src) &&
+       ip_addr_cmp(&(pcb->local_ip), &current_iphdr_dest)) {
+      if (link != chain) {
+        *link = pcb->hash_next;
+        pcb->hash_next = *chain;
+        *chain = pcb;
+      }
+      return pcb;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Finds the listening pcb for the segment in tcphdr, preferring one bound
+ * to the destination address over one bound to IP_ADDR_ANY.
+ *
+ * @return the matching listening pcb or NULL
+ */
+static struct tcp_pcb_listen *
+tcp_hash_lookup_listen(void)
+{
+  struct tcp_pcb_listen **chain, **link, **link_any, *lpcb;
+
+  chain = &tcp_listen_hash[TCP_LISTEN_HASH(tcphdr->dest)];
+  link_any = NULL;
+  for (link = chain; (lpcb = *link) != NULL; link = &lpcb->hash_next) {
+    if (lpcb->local_port == tcphdr->dest) {
+      if (ip_addr_cmp(&(lpcb->local_ip), &current_iphdr_dest)) {
+        /* found an exact match */
+        break;
+      } else if (ip_addr_isany(&(lpcb->local_ip)) && (link_any == NULL)) {
+        /* found an ANY-match, keep looking for an exact one */
+        link_any = link;
+#if !SO_REUSE
+        /* without SO_REUSE there can only be one pcb per local port */
+        break;
+#endif /* !SO_REUSE */
+      }
+    }
+  }
+  if ((lpcb == NULL) && (link_any != NULL)) {
+    link = link_any;
+    lpcb = *link;
+  }
+  if ((lpcb != NULL) && (link != chain)) {
+    *link = lpcb->hash_next;
+    lpcb->hash_next = *chain;
+    *chain = lpcb;
+  }
+  return lpcb;
+}
+#endif /* TCP_PCB_HASH_SIZE */
 
 /**
  * The initial input processing of TCP. It verifies the TCP header, demultiplexes
@@ -91,12 +189,15 @@ static err_t tcp_timewait_input(struct tcp_pcb *pcb);
 void
 tcp_input(struct pbuf *p, struct netif *inp)
 {
-  struct tcp_pcb *pcb, *prev;
+  struct tcp_pcb *pcb;
   struct tcp_pcb_listen *lpcb;
+#if !TCP_PCB_HASH_SIZE
+  struct tcp_pcb *prev;
 #if SO_REUSE
   struct tcp_pcb *lpcb_prev = NULL;
   struct tcp_pcb_listen *lpcb_any = NULL;
 #endif /* SO_REUSE */
+#endif /* !TCP_PCB_HASH_SIZE */
   u8_t hdrlen;
   err_t err;
 
@@ -105,6 +206,11 @@ tcp_input(struct pbuf *p, struct netif *inp)
   TCP_STATS_INC(tcp.recv);
   snmp_inc_tcpinsegs();
 
+#if LWIP_TCP_TIMER_SLEEP
+  /* Bring tcp_ticks up to date before pcb->tmr is set from it */
+  tcp_timer_needed();
+#endif /* LWIP_TCP_TIMER_SLEEP */
+
   iphdr = (struct ip_hdr *)p->payload;
   tcphdr = (struct tcp_hdr *)((u8_t *)p->payload + IPH_HL(iphdr) * 4);
 
@@ -135,8 +241,9 @@ tcp_input(struct pbuf *p, struct netif *inp)
 
 #if CHECKSUM_CHECK_TCP
   /* Verify TCP checksum. */
-  if (inet_chksum_pseudo(p, ip_current_src_addr(), ip_current_dest_addr(),
-      IP_PROTO_TCP, p->tot_len) != 0) {
+  if (NETIF_CHECKSUM_ENABLED(inp, NETIF_CHECKSUM_CHECK_TCP) &&
+      (inet_chksum_pseudo(p, ip_current_src_addr(), ip_current_dest_addr(),
+      IP_PROTO_TCP, p->tot_len) != 0)) {
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packet discarded due to failing checksum 0x%04"X16_F"\n",
         inet_chksum_pseudo(p, ip_current_src_addr(), ip_current_dest_addr(),
       IP_PROTO_TCP, p->tot_len)));
@@ -174,6 +281,32 @@ tcp_input(struct pbuf *p, struct netif *inp)
   flags = TCPH_FLAGS(tcphdr);
   tcplen = p->tot_len + ((flags & (TCP_FIN | TCP_SYN)) ? 1 : 0);
 
+#if TCP_PCB_HASH_SIZE
+  /* Demultiplex an incoming segment. Active and TIME-WAIT connections share
+     one hash table, listening pcbs are only searched if neither matched. */
+  pcb = tcp_hash_lookup();
+  if (pcb != NULL && pcb->state == TIME_WAIT) {
+    LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packed for TIME_WAITing connection.\n"));
+    tcp_timewait_input(pcb);
+    pbuf_free(p);
+    return;
+  }
+#if TCP_COMPACT_TIME_WAIT
+  if ((pcb == NULL) && tcp_tw_record_input()) {
+    pbuf_free(p);
+    return;
+  }
+#endif /* TCP_COMPACT_TIME_WAIT */
+  if (pcb == NULL) {
+    lpcb = tcp_hash_lookup_listen();
+    if (lpcb != NULL) {
+      LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packed for LISTENing connection.\n"));
+      tcp_listen_input(lpcb);
+      pbuf_free(p);
+      return;
+    }
+  }
+#else /* TCP_PCB_HASH_SIZE */
   /* Demultiplex an incoming segment. First, we check if it is destined
      for an active connection. */
   prev = NULL;
@@ -222,6 +355,14 @@ tcp_input(struct pbuf *p, struct netif *inp)
       }
     }
 
+#if TCP_COMPACT_TIME_WAIT
+    /* Then the connections in TIME-WAIT whose pcb has been freed. */
+    if (tcp_tw_record_input()) {
+      pbuf_free(p);
+      return;
+    }
+#endif /* TCP_COMPACT_TIME_WAIT */
+
     /* Finally, if we still did not get a match, we check all PCBs that
        are LISTENing for incoming connections. */
     prev = NULL;
@@ -272,6 +413,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
       return;
     }
   }
+#endif /* TCP_PCB_HASH_SIZE */
 
 #if TCP_INPUT_DEBUG
   LWIP_DEBUGF(TCP_INPUT_DEBUG, ("+-+-+-+-+-+-+-+-+-+-+-+-+-+- tcp_input: flags "));
@@ -304,6 +446,10 @@ tcp_input(struct pbuf *p, struct netif *inp)
       TCP_EVENT_RECV(pcb, pcb->refused_data, ERR_OK, err);
       if (err == ERR_OK) {
         pcb->refused_data = NULL;
+#if TCP_RX_COALESCE
+        /* data held behind it can go up with this batch */
+        tcp_rx_queue(pcb);
+#endif /* TCP_RX_COALESCE */
       } else if ((err == ERR_ABRT) || (tcplen > 0)) {
         /* if err == ERR_ABRT, 'pcb' is already deallocated */
         /* Drop incoming packets because pcb is "full" (only if the incoming
@@ -358,6 +504,24 @@ tcp_input(struct pbuf *p, struct netif *inp)
             recv_data->flags |= PBUF_FLAG_PUSH;
           }
 
+#if TCP_RX_COALESCE
+          if ((pcb->rx_held != NULL) &&
+              ((u32_t)pcb->rx_held->tot_len + recv_data->tot_len > 0xffff)) {
+            /* the chain's tot_len would overflow, pass up what is held first */
+            if (tcp_rx_deliver(pcb) == ERR_ABRT) {
+              pbuf_free(recv_data);
+              goto aborted;
+            }
+          }
+          /* Hold the data back until the end of the input batch, unless the
+             batch has to end here */
+          tcp_rx_hold(pcb, recv_data);
+          if ((recv_flags & TF_GOT_FIN) || (pcb->rx_held->tot_len >= TCP_RX_COALESCE_MAX)) {
+            if (tcp_rx_deliver(pcb) == ERR_ABRT) {
+              goto aborted;
+            }
+          }
+#else /* TCP_RX_COALESCE */
           /* Notify application that data has been received. */
           TCP_EVENT_RECV(pcb, recv_data, ERR_OK, err);
           if (err == ERR_ABRT) {
@@ -369,6 +533,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
             pcb->refused_data = recv_data;
             LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: keep incoming packet, because pcb is \"full\"\n"));
           }
+#endif /* TCP_RX_COALESCE */
         }
 
         /* If a FIN segment was received, we call the callback
@@ -376,7 +541,7 @@ tcp_input(struct pbuf *p, struct netif *inp)
         if (recv_flags & TF_GOT_FIN) {
           /* correct rcv_wnd as the application won't call tcp_recved()
              for the FIN's seqno */
-          if (pcb->rcv_wnd != TCP_WND) {
+          if (pcb->rcv_wnd != TCP_WND_MAX(pcb)) {
             pcb->rcv_wnd++;
           }
           TCP_EVENT_CLOSED(pcb, err);
@@ -386,13 +551,25 @@ tcp_input(struct pbuf *p, struct netif *inp)
         }
 
         tcp_input_pcb = NULL;
-        /* Try to send something out. */
-        tcp_output(pcb);
+#if TCP_RX_COALESCE
+        /* Held data gets its ACK when tcp_rx_flush() passes it up */
+        if (!pcb->rx_queued || (pcb->rx_held == NULL))
+#endif /* TCP_RX_COALESCE */
+        {
+          /* Try to send something out. */
+          tcp_output(pcb);
+        }
 #if TCP_INPUT_DEBUG
 #if TCP_DEBUG
         tcp_debug_print_state(pcb->state);
 #endif /* TCP_DEBUG */
 #endif /* TCP_INPUT_DEBUG */
+#if TCP_COMPACT_TIME_WAIT
+        if (pcb->state == TIME_WAIT) {
+          /* all callbacks for the pcb are done, it may be freed now */
+          tcp_tw_compact(pcb);
+        }
+#endif /* TCP_COMPACT_TIME_WAIT */
       }
     }
     /* Jump target if pcb has been aborted in a callback (by calling tcp_abort()).
@@ -481,6 +658,10 @@ tcp_listen_input(struct tcp_pcb_listen *pcb)
     npcb->state = SYN_RCVD;
     npcb->rcv_nxt = seqno + 1;
     npcb->rcv_ann_right_edge = npcb->rcv_nxt;
+#if TCP_WND_AUTOTUNE
+    npcb->rcv_tune_seq = npcb->rcv_nxt;
+#endif /* TCP_WND_AUTOTUNE */
+    /* the window in a SYN is never scaled */
     npcb->snd_wnd = tcphdr->wnd;
     npcb->ssthresh = npcb->snd_wnd;
     npcb->snd_wl1 = seqno - 1;/* initialise to seqno-1 to force window update */
@@ -557,6 +738,47 @@ tcp_timewait_input(struct tcp_pcb *pcb)
   return ERR_OK;
 }
 
+#if TCP_COMPACT_TIME_WAIT
+/**
+ * Called by tcp_input() to look for a TIME-WAIT record matching the segment
+ * that arrived. A matching segment is answered as tcp_timewait_input()
+ * answers it for a pcb.
+ *
+ * @return 1 if a record matched (the segment is processed), 0 if not
+ */
+static u8_t
+tcp_tw_record_input(void)
+{
+  struct tcp_tw *tw;
+
+  for (tw = tcp_tw_records; tw != NULL; tw = tw->next) {
+    if (tw->remote_port == tcphdr->src &&
+       tw->local_port == tcphdr->dest &&
+       ip_addr_cmp(&(tw->remote_ip), &current_iphdr_src) &&
+       ip_addr_cmp(&(tw->local_ip), &current_iphdr_dest)) {
+      LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_input: packed for TIME_WAIT record.\n"));
+      if (flags & TCP_RST)  {
+        return 1;
+      }
+      if (flags & TCP_SYN) {
+        if (TCP_SEQ_BETWEEN(seqno, tw->rcv_nxt, tw->rcv_nxt+tw->rcv_wnd)) {
+          tcp_rst(ackno, seqno + tcplen, ip_current_dest_addr(), ip_current_src_addr(),
+            tcphdr->dest, tcphdr->src);
+          return 1;
+        }
+      } else if (flags & TCP_FIN) {
+        tw->tmr = tcp_ticks;
+      }
+      if (tcplen > 0) {
+        tcp_tw_ack(tw);
+      }
+      return 1;
+    }
+  }
+  return 0;
+}
+#endif /* TCP_COMPACT_TIME_WAIT */
+
 /**
  * Implements the TCP state machine. Called by tcp_input. In some
  * states tcp_receive() is called to receive data. The tcp_seg
@@ -631,7 +853,12 @@ tcp_process(struct tcp_pcb *pcb)
       pcb->snd_buf++;
       pcb->rcv_nxt = seqno + 1;
       pcb->rcv_ann_right_edge = pcb->rcv_nxt;
+#if TCP_WND_AUTOTUNE
+      pcb->rcv_tune_seq = pcb->rcv_nxt;
+      pcb->rcv_tune_time = tcp_ticks;
+#endif /* TCP_WND_AUTOTUNE */
       pcb->lastack = ackno;
+      /* the window in a SYN is never scaled */
       pcb->snd_wnd = tcphdr->wnd;
       pcb->snd_wl1 = seqno - 1; /* initialise to seqno - 1 to force window update */
       pcb->state = ESTABLISHED;
@@ -681,7 +908,7 @@ tcp_process(struct tcp_pcb *pcb)
     if (flags & TCP_ACK) {
       /* expected ACK number? */
       if (TCP_SEQ_BETWEEN(ackno, pcb->lastack+1, pcb->snd_nxt)) {
-        u16_t old_cwnd;
+        tcpwnd_size_t old_cwnd;
         pcb->state = ESTABLISHED;
         LWIP_DEBUGF(TCP_DEBUG, ("TCP connection established %"U16_F" -> %"U16_F".\n", inseg.tcphdr->src, inseg.tcphdr->dest));
 #if LWIP_CALLBACK_API
@@ -855,22 +1082,33 @@ tcp_receive(struct tcp_pcb *pcb)
   int found_dupack = 0;
 
   if (flags & TCP_ACK) {
+    tcpwnd_size_t snd_wnd = SND_WND_SCALE(pcb, tcphdr->wnd);
+#if LWIP_TCP_NEWRENO
+    u8_t partial_ack = 0;
+#endif /* LWIP_TCP_NEWRENO */
+
+#if LWIP_TCP_SACK
+    if (sack_num > 0) {
+      tcp_sack_mark(pcb);
+    }
+#endif /* LWIP_TCP_SACK */
+
     right_wnd_edge = pcb->snd_wnd + pcb->snd_wl2;
 
     /* Update window. */
     if (TCP_SEQ_LT(pcb->snd_wl1, seqno) ||
        (pcb->snd_wl1 == seqno && TCP_SEQ_LT(pcb->snd_wl2, ackno)) ||
-       (pcb->snd_wl2 == ackno && tcphdr->wnd > pcb->snd_wnd)) {
-      pcb->snd_wnd = tcphdr->wnd;
+       (pcb->snd_wl2 == ackno && snd_wnd > pcb->snd_wnd)) {
+      pcb->snd_wnd = snd_wnd;
       pcb->snd_wl1 = seqno;
       pcb->snd_wl2 = ackno;
       if (pcb->snd_wnd > 0 && pcb->persist_backoff > 0) {
           pcb->persist_backoff = 0;
       }
-      LWIP_DEBUGF(TCP_WND_DEBUG, ("tcp_receive: window update %"U16_F"\n", pcb->snd_wnd));
+      LWIP_DEBUGF(TCP_WND_DEBUG, ("tcp_receive: window update %"TCPWNDSIZE_F"\n", pcb->snd_wnd));
 #if TCP_WND_DEBUG
     } else {
-      if (pcb->snd_wnd != tcphdr->wnd) {
+      if (pcb->snd_wnd != snd_wnd) {
         LWIP_DEBUGF(TCP_WND_DEBUG, 
                     ("tcp_receive: no window update lastack %"U32_F" ackno %"
                      U32_F" wl1 %"U32_F" seqno %"U32_F" wl2 %"U32_F"\n",
@@ -916,9 +1154,16 @@ tcp_receive(struct tcp_pcb *pcb)
               if (pcb->dupacks > 3) {
                 /* Inflate the congestion window, but not if it means that
                    the value overflows. */
-                if ((u16_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
+                if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
                   pcb->cwnd += pcb->mss;
                 }
+#if LWIP_TCP_SACK
+                /* Each further dupack means a segment has left the network:
+                   use it to resend the next hole the SACK blocks show. */
+                if (pcb->flags & TF_INFR) {
+                  tcp_rexmit_sack(pcb);
+                }
+#endif /* LWIP_TCP_SACK */
               } else if (pcb->dupacks == 3) {
                 /* Do fast retransmit */
                 tcp_rexmit_fast(pcb);
@@ -939,8 +1184,17 @@ tcp_receive(struct tcp_pcb *pcb)
          in fast retransmit. Also reset the congestion window to the
          slow start threshold. */
       if (pcb->flags & TF_INFR) {
-        pcb->flags &= ~TF_INFR;
-        pcb->cwnd = pcb->ssthresh;
+#if LWIP_TCP_NEWRENO
+        if (TCP_SEQ_LT(ackno, pcb->recover)) {
+          /* Partial ACK: more of the window was lost, stay in fast
+             recovery (RFC 6582) */
+          partial_ack = 1;
+        } else
+#endif /* LWIP_TCP_NEWRENO */
+        {
+          pcb->flags &= ~TF_INFR;
+          pcb->cwnd = pcb->ssthresh;
+        }
       }
 
       /* Reset the number of retransmissions. */
@@ -960,18 +1214,37 @@ tcp_receive(struct tcp_pcb *pcb)
 
       /* Update the congestion control variables (cwnd and
          ssthresh). */
+#if LWIP_TCP_NEWRENO
+      if (partial_ack) {
+        /* Deflate the congestion window by the amount of new data
+           acknowledged, then add back one MSS for the resent segment */
+        if (pcb->cwnd > pcb->acked) {
+          pcb->cwnd -= pcb->acked;
+        } else {
+          pcb->cwnd = 0;
+        }
+        if (pcb->acked >= pcb->mss) {
+          pcb->cwnd += pcb->mss;
+        }
+        if (pcb->cwnd < pcb->mss) {
+          pcb->cwnd = pcb->mss;
+        }
+        LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_receive: partial ACK %"U32_F", cwnd %"TCPWNDSIZE_F"\n",
+                                   ackno, pcb->cwnd));
+      } else
+#endif /* LWIP_TCP_NEWRENO */
       if (pcb->state >= ESTABLISHED) {
         if (pcb->cwnd < pcb->ssthresh) {
-          if ((u16_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
+          if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
             pcb->cwnd += pcb->mss;
           }
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: slow start cwnd %"U16_F"\n", pcb->cwnd));
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: slow start cwnd %"TCPWNDSIZE_F"\n", pcb->cwnd));
         } else {
-          u16_t new_cwnd = (pcb->cwnd + pcb->mss * pcb->mss / pcb->cwnd);
+          tcpwnd_size_t new_cwnd = (tcpwnd_size_t)(pcb->cwnd + pcb->mss * pcb->mss / pcb->cwnd);
           if (new_cwnd > pcb->cwnd) {
             pcb->cwnd = new_cwnd;
           }
-          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: congestion avoidance cwnd %"U16_F"\n", pcb->cwnd));
+          LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_receive: congestion avoidance cwnd %"TCPWNDSIZE_F"\n", pcb->cwnd));
         }
       }
       LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_receive: ACK for %"U32_F", unacked->seqno %"U32_F":%"U32_F"\n",
@@ -1011,6 +1284,32 @@ tcp_receive(struct tcp_pcb *pcb)
         }
       }
 
+#if LWIP_TCP_SACK
+      if ((pcb->unacked != NULL) && (pcb->unacked->flags & TF_SEG_SACKED)) {
+        /* The remote end acknowledged up to a segment it had SACKed before,
+           so it has dropped its out-of-sequence data: forget all SACKs */
+        for (next = pcb->unacked; next != NULL; next = next->next) {
+          next->flags &= ~TF_SEG_SACKED;
+        }
+      }
+#endif /* LWIP_TCP_SACK */
+
+#if LWIP_TCP_NEWRENO
+      if (partial_ack) {
+        /* The segment following the partial ACK was lost too: resend it
+           now instead of waiting for the retransmission timer */
+#if LWIP_TCP_SACK
+        if ((pcb->unacked != NULL) && (pcb->unacked->flags & TF_SEG_REXMITTED)) {
+          /* already resent in this recovery, look for the next hole */
+          tcp_rexmit_sack(pcb);
+        } else
+#endif /* LWIP_TCP_SACK */
+        {
+          tcp_rexmit(pcb);
+        }
+      }
+#endif /* LWIP_TCP_NEWRENO */
+
       /* If there's nothing left to acknowledge, stop the retransmit
          timer, otherwise reset it to start again */
       if(pcb->unacked == NULL)
@@ -1201,7 +1500,7 @@ tcp_receive(struct tcp_pcb *pcb)
             TCPH_FLAGS_SET(inseg.tcphdr, TCPH_FLAGS(inseg.tcphdr) &~ TCP_FIN);
           }
           /* Adjust length of segment to fit in the window. */
-          inseg.len = pcb->rcv_wnd;
+          inseg.len = (u16_t)pcb->rcv_wnd;
           if (TCPH_FLAGS(inseg.tcphdr) & TCP_SYN) {
             inseg.len -= 1;
           }
@@ -1215,6 +1514,9 @@ tcp_receive(struct tcp_pcb *pcb)
            - FIN has been received or
            - inseq overlaps with ooseq */
         if (pcb->ooseq != NULL) {
+          /* The segment fills (the start of) a hole: acknowledge it at once
+             so a sender in fast recovery learns about it (RFC 5681) */
+          tcp_ack_now(pcb);
           if (TCPH_FLAGS(inseg.tcphdr) & TCP_FIN) {
             LWIP_DEBUGF(TCP_INPUT_DEBUG, 
                         ("tcp_receive: received in-order FIN, binning ooseq queue\n"));
@@ -1270,6 +1572,10 @@ tcp_receive(struct tcp_pcb *pcb)
         LWIP_ASSERT("tcp_receive: tcplen > rcv_wnd\n", pcb->rcv_wnd >= tcplen);
         pcb->rcv_wnd -= tcplen;
 
+#if TCP_WND_AUTOTUNE
+        tcp_rcv_wnd_autotune(pcb);
+#endif /* TCP_WND_AUTOTUNE */
+
         tcp_update_rcv_ann_wnd(pcb);
 
         /* If there is data in the segment, we make preparations to
@@ -1304,7 +1610,7 @@ tcp_receive(struct tcp_pcb *pcb)
 
           pcb->rcv_nxt += TCP_TCPLEN(cseg);
           LWIP_ASSERT("tcp_receive: ooseq tcplen > rcv_wnd\n",
-                      pcb->rcv_wnd >= TCP_TCPLEN(cseg));
+                      pcb->rcv_wnd >= (tcpwnd_size_t)TCP_TCPLEN(cseg));
           pcb->rcv_wnd -= TCP_TCPLEN(cseg);
 
           tcp_update_rcv_ann_wnd(pcb);
@@ -1338,8 +1644,11 @@ tcp_receive(struct tcp_pcb *pcb)
 
       } else {
         /* We get here if the incoming segment is out-of-sequence. */
-        tcp_send_empty_ack(pcb);
 #if TCP_QUEUE_OOSEQ
+#if LWIP_TCP_SACK
+        /* Report the block holding this segment first (RFC 2018) */
+        pcb->rcv_sack_seq = seqno;
+#endif /* LWIP_TCP_SACK */
         /* We queue the segment on the ->ooseq queue. */
         if (pcb->ooseq == NULL) {
           pcb->ooseq = tcp_seg_copy(&inseg);
@@ -1461,6 +1770,8 @@ tcp_receive(struct tcp_pcb *pcb)
           }
         }
 #endif /* TCP_QUEUE_OOSEQ */
+        /* Sent after queueing so that the ACK can SACK this segment */
+        tcp_send_empty_ack(pcb);
 
       }
     } else {
@@ -1482,7 +1793,8 @@ tcp_receive(struct tcp_pcb *pcb)
  * Parses the options contained in the incoming segment. 
  *
  * Called from tcp_listen_input() and tcp_process().
- * Currently, only the MSS option is supported!
+ * Currently, only the MSS, window scale, SACK and timestamp options are
+ * supported!
  *
  * @param pcb the tcp_pcb for which a segment arrived
  */
@@ -1497,6 +1809,9 @@ tcp_parseopt(struct tcp_pcb *pcb)
 #endif
 
   opts = (u8_t *)tcphdr + TCP_HLEN;
+#if LWIP_TCP_SACK
+  sack_num = 0;
+#endif /* LWIP_TCP_SACK */
 
   /* Parse the TCP MSS option, if present. */
   if(TCPH_HDRLEN(tcphdr) > 0x5) {
@@ -1527,6 +1842,67 @@ tcp_parseopt(struct tcp_pcb *pcb)
         /* Advance to next option */
         c += 0x04;
         break;
+#if LWIP_WND_SCALE
+      case 0x03:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: WND_SCALE\n"));
+        if (opts[c + 1] != 0x03 || c + 0x03 > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        /* The option is only valid in SYN segments (RFC 1323) */
+        if ((flags & TCP_SYN) &&
+            ((pcb->state == SYN_SENT) || (pcb->state == SYN_RCVD))) {
+          /* Both ends now scale: use the full TCP_WND */
+          pcb->snd_scale = LWIP_MIN(opts[c + 2], 14);
+          pcb->rcv_scale = TCP_RCV_SCALE;
+          pcb->flags |= TF_WND_SCALE;
+#if !TCP_WND_AUTOTUNE
+          pcb->rcv_wnd = pcb->rcv_ann_wnd = TCP_WND;
+#endif /* !TCP_WND_AUTOTUNE */
+        }
+        /* Advance to next option */
+        c += 0x03;
+        break;
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+      case 0x04:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK_PERM\n"));
+        if (opts[c + 1] != 0x02 || c + 0x02 > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        /* The option is only valid in SYN segments (RFC 2018) */
+        if ((flags & TCP_SYN) &&
+            ((pcb->state == SYN_SENT) || (pcb->state == SYN_RCVD))) {
+          pcb->flags |= TF_SACK;
+        }
+        /* Advance to next option */
+        c += 0x02;
+        break;
+      case 0x05:
+        LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK\n"));
+        if (opts[c + 1] < 0x0A || ((opts[c + 1] - 2) & 7) != 0 ||
+            c + opts[c + 1] > max_c) {
+          /* Bad length */
+          LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+          return;
+        }
+        if ((pcb->flags & TF_SACK) && !(flags & TCP_SYN)) {
+          u16_t b;
+          for (b = c + 2; (b < c + opts[c + 1]) && (sack_num < 4); b += 8) {
+            sack_left[sack_num] = ((u32_t)opts[b] << 24) | ((u32_t)opts[b + 1] << 16) |
+                                  ((u32_t)opts[b + 2] << 8) | opts[b + 3];
+            sack_right[sack_num] = ((u32_t)opts[b + 4] << 24) | ((u32_t)opts[b + 5] << 16) |
+                                   ((u32_t)opts[b + 6] << 8) | opts[b + 7];
+            sack_num++;
+          }
+        }
+        /* Advance to next option */
+        c += opts[c + 1];
+        break;
+#endif /* LWIP_TCP_SACK */
 #if LWIP_TCP_TIMESTAMPS
       case 0x08:
         LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: TS\n"));
@@ -1564,4 +1940,209 @@ tcp_parseopt(struct tcp_pcb *pcb)
   }
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Marks the segments on the unacked list that are covered by the SACK
+ * blocks of the incoming segment. Marked segments are skipped when
+ * retransmitting.
+ *
+ * Called from tcp_receive() when the segment carried SACK blocks.
+ *
+ * @param pcb the tcp_pcb that received the SACK blocks
+ */
+static void
+tcp_sack_mark(struct tcp_pcb *pcb)
+{
+  struct tcp_seg *seg;
+  u32_t left, right;
+  u8_t i;
+
+  for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+    if (seg->flags & TF_SEG_SACKED) {
+      continue;
+    }
+    left = ntohl(seg->tcphdr->seqno);
+    right = left + TCP_TCPLEN(seg);
+    for (i = 0; i < sack_num; i++) {
+      if (TCP_SEQ_GEQ(left, sack_left[i]) && TCP_SEQ_LEQ(right, sack_right[i])) {
+        seg->flags |= TF_SEG_SACKED;
+        LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_sack_mark: %"U32_F":%"U32_F" SACKed\n",
+                                   left, right));
+        break;
+      }
+    }
+  }
+}
+#endif /* LWIP_TCP_SACK */
+
+#if TCP_WND_AUTOTUNE
+/**
+ * Grows the receive window of a connection when the remote end is limited
+ * by it: if, within one round trip, as much data arrived as the window
+ * allows, the window is doubled (up to TCP_WND_LIMIT), provided PBUF_POOL
+ * still has enough free buffers to hold the additional data.
+ *
+ * Called from tcp_receive() after in-sequence data reduced rcv_wnd.
+ *
+ * @param pcb the tcp_pcb that received data
+ */
+static void
+tcp_rcv_wnd_autotune(struct tcp_pcb *pcb)
+{
+  u32_t interval, elapsed, received;
+  tcpwnd_size_t limit, grow;
+
+  /* The smoothed RTT (pcb->sa is scaled by 8) in slow timer ticks; use at
+     least one tick before any RTT has been measured. */
+  interval = (u32_t)(pcb->sa >> 3);
+  if (interval == 0) {
+    interval = 1;
+  }
+  elapsed = tcp_ticks - pcb->rcv_tune_time;
+  if (elapsed < interval) {
+    return;
+  }
+
+  received = pcb->rcv_nxt - pcb->rcv_tune_seq;
+  limit = TCP_WND_LIMIT(pcb);
+  /* Only trust samples that did not span an idle period. */
+  if ((elapsed <= (interval << 1)) && (received >= pcb->rcv_wnd_max) &&
+      (pcb->rcv_wnd_max < limit)) {
+    grow = LWIP_MIN(pcb->rcv_wnd_max, limit - pcb->rcv_wnd_max);
+#if !MEMP_MEM_MALLOC
+    if ((u32_t)memp_num_free(MEMP_PBUF_POOL) * PBUF_POOL_BUFSIZE < grow) {
+      grow = 0;
+    }
+#endif /* !MEMP_MEM_MALLOC */
+    if (grow > 0) {
+      pcb->rcv_wnd_max += grow;
+      pcb->rcv_wnd += grow;
+      LWIP_DEBUGF(TCP_WND_DEBUG, ("tcp_rcv_wnd_autotune: window %"TCPWNDSIZE_F"\n",
+                                  pcb->rcv_wnd_max));
+    }
+  }
+
+  pcb->rcv_tune_seq = pcb->rcv_nxt;
+  pcb->rcv_tune_time = tcp_ticks;
+}
+#endif /* TCP_WND_AUTOTUNE */
+
+#if TCP_RX_COALESCE
+/**
+ * Appends in-order data to what is held for a pcb and queues the pcb for
+ * tcp_rx_flush().
+ *
+ * @param pcb the tcp_pcb the data was received for
+ * @param p the data, as it would be passed to the recv callback
+ */
+static void
+tcp_rx_hold(struct tcp_pcb *pcb, struct pbuf *p)
+{
+  if (pcb->rx_held == NULL) {
+    pcb->rx_held = p;
+  } else {
+    /* the chain is pushed if any of its segments was */
+    pcb->rx_held->flags |= (p->flags & PBUF_FLAG_PUSH);
+    pbuf_cat(pcb->rx_held, p);
+  }
+  tcp_rx_queue(pcb);
+}
+
+/**
+ * Passes the data held for a pcb to the application. If the upper layer
+ * refuses it, it is kept on ->refused_data like directly received data.
+ *
+ * @param pcb the tcp_pcb to pass the data up for
+ * @return ERR_ABRT if the pcb has been aborted in the callback, ERR_OK otherwise
+ */
+static err_t
+tcp_rx_deliver(struct tcp_pcb *pcb)
+{
+  struct pbuf *p = pcb->rx_held;
+  err_t err;
+
+  LWIP_ASSERT("pcb->refused_data == NULL", pcb->refused_data == NULL);
+  pcb->rx_held = NULL;
+  TCP_EVENT_RECV(pcb, p, ERR_OK, err);
+  if (err == ERR_ABRT) {
+    return ERR_ABRT;
+  }
+  if (err != ERR_OK) {
+    pcb->refused_data = p;
+    LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_rx_deliver: keep held data, because pcb is \"full\"\n"));
+  }
+  return ERR_OK;
+}
+
+/**
+ * Puts a pcb that holds data on tcp_rx_held_pcbs unless it is there already.
+ *
+ * @param pcb the tcp_pcb to queue
+ */
+void
+tcp_rx_queue(struct tcp_pcb *pcb)
+{
+  if ((pcb->rx_held != NULL) && !pcb->rx_queued) {
+    pcb->rx_queued = 1;
+    pcb->rx_next = tcp_rx_held_pcbs;
+    tcp_rx_held_pcbs = pcb;
+  }
+}
+
+/**
+ * Frees the data held for a pcb and takes the pcb off tcp_rx_held_pcbs.
+ * Called when the pcb is purged or its receive side is shut down.
+ *
+ * @param pcb the tcp_pcb to discard the data of
+ */
+void
+tcp_rx_discard(struct tcp_pcb *pcb)
+{
+  struct tcp_pcb **pp;
+
+  if (pcb->rx_queued) {
+    for (pp = &tcp_rx_held_pcbs; *pp != NULL; pp = &(*pp)->rx_next) {
+      if (*pp == pcb) {
+        *pp = pcb->rx_next;
+        break;
+      }
+    }
+    pcb->rx_queued = 0;
+  }
+  if (pcb->rx_held != NULL) {
+    pbuf_free(pcb->rx_held);
+    pcb->rx_held = NULL;
+  }
+}
+
+/**
+ * Ends an input batch: passes the data held for each queued pcb to the
+ * application with one recv callback and sends the ACK (and anything else)
+ * that became due while it was held. Called by tcpip_thread when its mailbox
+ * has run dry; with NO_SYS==1 (or LWIP_TCPIP_CORE_LOCKING_INPUT) the driver
+ * calls it after it has passed a batch of received packets to the stack.
+ */
+void
+tcp_rx_flush(void)
+{
+  struct tcp_pcb *pcb;
+
+  /* Callbacks may abort other pcbs, which takes them off the list, so
+     only ever take the head. */
+  while (tcp_rx_held_pcbs != NULL) {
+    pcb = tcp_rx_held_pcbs;
+    tcp_rx_held_pcbs = pcb->rx_next;
+    pcb->rx_queued = 0;
+    if ((pcb->rx_held == NULL) || (pcb->refused_data != NULL)) {
+      /* Passed up already, or waiting behind refused data: the pcb is
+         queued again once refused_data has been taken. */
+      continue;
+    }
+    if (tcp_rx_deliver(pcb) == ERR_OK) {
+      tcp_output(pcb);
+    }
+  }
+}
+#endif /* TCP_RX_COALESCE */
+
 #endif /* LWIP_TCP */
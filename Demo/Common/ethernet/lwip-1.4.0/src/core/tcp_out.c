@@ -75,9 +75,26 @@
 #define TCP_CHECKSUM_ON_COPY_SANITY_CHECK   0
 #endif
 
+/** Is the TCP checksum of a segment sent to dst generated in software, or by
+ * the hardware of the netif the segment will be sent on? */
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+#define TCP_CHECKSUM_GEN_ENABLED(dst) tcp_chksum_gen_enabled(dst)
+#else /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+#define TCP_CHECKSUM_GEN_ENABLED(dst) 1
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 /* Forward declarations.*/
 static void tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb);
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+static u8_t
+tcp_chksum_gen_enabled(ip_addr_t *dst)
+{
+  struct netif *netif = ip_route(dst);
+  return (u8_t)NETIF_CHECKSUM_ENABLED(netif, NETIF_CHECKSUM_GEN_TCP);
+}
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 /** Allocate a pbuf and create a tcphdr at p->payload, used for output
  * functions other than the default tcp_output -> tcp_output_segment
  * (e.g. tcp_send_empty_ack, etc.)
@@ -103,7 +120,7 @@ tcp_output_alloc_header(struct tcp_pcb *pcb, u16_t optlen, u16_t datalen,
     tcphdr->seqno = seqno_be;
     tcphdr->ackno = htonl(pcb->rcv_nxt);
     TCPH_HDRLEN_FLAGS_SET(tcphdr, (5 + optlen / 4), TCP_ACK);
-    tcphdr->wnd = htons(pcb->rcv_ann_wnd);
+    tcphdr->wnd = htons(TCPWND16(RCV_WND_SCALE(pcb, pcb->rcv_ann_wnd)));
     tcphdr->chksum = 0;
     tcphdr->urgp = 0;
 
@@ -167,6 +184,9 @@ tcp_create_segment(struct tcp_pcb *pcb, struct pbuf *p, u8_t flags, u32_t seqno,
   seg->next = NULL;
   seg->p = p;
   seg->len = p->tot_len - optlen;
+#if LWIP_TCP_WRITE_REF
+  seg->done = NULL;
+#endif /* LWIP_TCP_WRITE_REF */
 #if TCP_OVERSIZE_DBGCHECK
   seg->oversize_left = 0;
 #endif /* TCP_OVERSIZE_DBGCHECK */
@@ -456,10 +476,14 @@ tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
      * Phase 2: Chain a new pbuf to the end of pcb->unsent.
      *
      * We don't extend segments containing SYN/FIN flags or options
-     * (len==0). The new pbuf is kept in concat_p and pbuf_cat'ed at
-     * the end.
+     * (len==0), nor ones that end a tcp_write_ref(). The new pbuf is
+     * kept in concat_p and pbuf_cat'ed at the end.
      */
-    if ((pos < len) && (space > 0) && (last_unsent->len > 0)) {
+    if ((pos < len) && (space > 0) && (last_unsent->len > 0)
+#if LWIP_TCP_WRITE_REF
+        && (last_unsent->done == NULL)
+#endif /* LWIP_TCP_WRITE_REF */
+        ) {
       u16_t seglen = space < len - pos ? space : len - pos;
       seg = last_unsent;
 
@@ -701,6 +725,52 @@ memerr:
   return ERR_MEM;
 }
 
+#if LWIP_TCP_WRITE_REF
+/**
+ * Write data for sending without copying it, like tcp_write() without
+ * TCP_WRITE_FLAG_COPY, and call 'done' once the stack no longer references
+ * the data: when all of it has been acknowledged or the connection has been
+ * closed or aborted. 'done' is not called if an error is returned.
+ *
+ * @param pcb Protocol control block for the TCP connection to enqueue data for.
+ * @param arg Pointer to the data to be enqueued for sending.
+ * @param len Data length in bytes (> 0)
+ * @param apiflags TCP_WRITE_FLAG_MORE or 0 (TCP_WRITE_FLAG_COPY is ignored)
+ * @param done function called when the buffer may be reused
+ * @param done_arg argument passed to 'done'
+ * @return ERR_OK if enqueued, another err_t on error
+ */
+err_t
+tcp_write_ref(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags,
+              tcp_write_done_fn done, void *done_arg)
+{
+  struct tcp_seg *seg;
+  err_t err;
+
+  LWIP_ERROR("tcp_write_ref: done == NULL (programmer violates API)",
+             done != NULL, return ERR_ARG;);
+  LWIP_ERROR("tcp_write_ref: len == 0 (programmer violates API)",
+             len > 0, return ERR_ARG;);
+
+  err = tcp_write(pcb, arg, len, (u8_t)(apiflags & ~TCP_WRITE_FLAG_COPY));
+  if (err == ERR_OK) {
+    /* the last byte written is in the last unsent segment */
+    for (seg = pcb->unsent; seg->next != NULL; seg = seg->next);
+    LWIP_ASSERT("tcp_write_ref: segment already has a callback", seg->done == NULL);
+    seg->done = done;
+    seg->done_arg = done_arg;
+#if TCP_OVERSIZE
+    /* no more data may be added to this segment */
+    pcb->unsent_oversize = 0;
+#if TCP_OVERSIZE_DBGCHECK
+    seg->oversize_left = 0;
+#endif /* TCP_OVERSIZE_DBGCHECK */
+#endif /* TCP_OVERSIZE */
+  }
+  return err;
+}
+#endif /* LWIP_TCP_WRITE_REF */
+
 /**
  * Enqueue TCP options for transmission.
  *
@@ -735,6 +805,19 @@ tcp_enqueue_flags(struct tcp_pcb *pcb, u8_t flags)
 
   if (flags & TCP_SYN) {
     optflags = TF_SEG_OPTS_MSS;
+#if LWIP_WND_SCALE
+    /* Offer window scaling in a SYN, but only answer with it in a SYN-ACK
+       if the remote end offered it first (RFC 1323) */
+    if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_WND_SCALE)) {
+      optflags |= TF_SEG_OPTS_WND_SCALE;
+    }
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+    /* Same for SACK permitted (RFC 2018) */
+    if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_SACK)) {
+      optflags |= TF_SEG_OPTS_SACK_PERM;
+    }
+#endif /* LWIP_TCP_SACK */
   }
 #if LWIP_TCP_TIMESTAMPS
   if ((pcb->flags & TF_TIMESTAMP)) {
@@ -828,6 +911,54 @@ tcp_build_timestamp_option(struct tcp_pcb *pcb, u32_t *opts)
 }
 #endif
 
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+/**
+ * Collect the blocks of contiguous data on the ooseq queue for the SACK
+ * option of an ACK. The block holding the most recently received segment
+ * is reported first, the others follow in sequence order (RFC 2018).
+ *
+ * @param pcb tcp_pcb with a non-empty ooseq queue
+ * @param left left edges of the blocks (host byte order)
+ * @param right right edges of the blocks (host byte order)
+ * @param max maximum number of blocks to return
+ * @return number of blocks stored
+ */
+static u8_t
+tcp_sack_collect(struct tcp_pcb *pcb, u32_t *left, u32_t *right, u8_t max)
+{
+  struct tcp_seg *seg;
+  u32_t l, r;
+  u8_t num = 0, i;
+
+  /* ooseq segments carry their header in host byte order */
+  seg = pcb->ooseq;
+  while (seg != NULL) {
+    l = seg->tcphdr->seqno;
+    r = l + TCP_TCPLEN(seg);
+    for (seg = seg->next; (seg != NULL) && TCP_SEQ_LEQ(seg->tcphdr->seqno, r); seg = seg->next) {
+      if (TCP_SEQ_GT(seg->tcphdr->seqno + TCP_TCPLEN(seg), r)) {
+        r = seg->tcphdr->seqno + TCP_TCPLEN(seg);
+      }
+    }
+    if (TCP_SEQ_BETWEEN(pcb->rcv_sack_seq, l, r - 1)) {
+      /* most recent block goes first, possibly pushing out the last one */
+      i = (num < max) ? num++ : (u8_t)(num - 1);
+      for (; i > 0; i--) {
+        left[i] = left[i - 1];
+        right[i] = right[i - 1];
+      }
+      left[0] = l;
+      right[0] = r;
+    } else if (num < max) {
+      left[num] = l;
+      right[num] = r;
+      num++;
+    }
+  }
+  return num;
+}
+#endif /* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
+
 /** Send an ACK without data.
  *
  * @param pcb Protocol control block for the TCP connection to send the ACK
@@ -838,12 +969,25 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
   struct pbuf *p;
   struct tcp_hdr *tcphdr;
   u8_t optlen = 0;
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+  u32_t sack_left[LWIP_TCP_MAX_SACK_NUM], sack_right[LWIP_TCP_MAX_SACK_NUM];
+  u8_t sack_num = 0, i;
+  u32_t *opts;
+#endif /* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 #if LWIP_TCP_TIMESTAMPS
   if (pcb->flags & TF_TIMESTAMP) {
     optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
   }
 #endif
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+  if ((pcb->flags & TF_SACK) && (pcb->ooseq != NULL)) {
+    /* only 3 blocks fit into the option space next to a timestamp */
+    sack_num = tcp_sack_collect(pcb, sack_left, sack_right,
+      (u8_t)((optlen > 0) ? LWIP_MIN(LWIP_TCP_MAX_SACK_NUM, 3) : LWIP_TCP_MAX_SACK_NUM));
+    optlen += LWIP_TCP_SACK_OPT_LENGTH(sack_num);
+  }
+#endif /* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
   p = tcp_output_alloc_header(pcb, optlen, 0, htonl(pcb->snd_nxt));
   if (p == NULL) {
@@ -864,10 +1008,23 @@ tcp_send_empty_ack(struct tcp_pcb *pcb)
     tcp_build_timestamp_option(pcb, (u32_t *)(tcphdr + 1));
   }
 #endif 
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+  if (sack_num > 0) {
+    /* the SACK option follows the timestamp, if any */
+    opts = (u32_t *)(void *)((u8_t *)(tcphdr + 1) + optlen - LWIP_TCP_SACK_OPT_LENGTH(sack_num));
+    *opts++ = htonl(0x01010500UL | (2 + 8 * sack_num));
+    for (i = 0; i < sack_num; i++) {
+      *opts++ = htonl(sack_left[i]);
+      *opts++ = htonl(sack_right[i]);
+    }
+  }
+#endif /* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 #if CHECKSUM_GEN_TCP
-  tcphdr->chksum = inet_chksum_pseudo(p, &(pcb->local_ip), &(pcb->remote_ip),
-        IP_PROTO_TCP, p->tot_len);
+  if (TCP_CHECKSUM_GEN_ENABLED(&(pcb->remote_ip))) {
+    tcphdr->chksum = inet_chksum_pseudo(p, &(pcb->local_ip), &(pcb->remote_ip),
+          IP_PROTO_TCP, p->tot_len);
+  }
 #endif
 #if LWIP_NETIF_HWADDRHINT
   ip_output_hinted(p, &(pcb->local_ip), &(pcb->remote_ip), pcb->ttl, pcb->tos,
@@ -905,6 +1062,11 @@ tcp_output(struct tcp_pcb *pcb)
     return ERR_OK;
   }
 
+#if LWIP_TCP_TIMER_SLEEP
+  /* Segments sent now need the retransmission timer */
+  tcp_timer_needed();
+#endif /* LWIP_TCP_TIMER_SLEEP */
+
   wnd = LWIP_MIN(pcb->snd_wnd, pcb->cwnd);
 
   seg = pcb->unsent;
@@ -935,13 +1097,13 @@ tcp_output(struct tcp_pcb *pcb)
 #endif /* TCP_OUTPUT_DEBUG */
 #if TCP_CWND_DEBUG
   if (seg == NULL) {
-    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"U16_F
-                                 ", cwnd %"U16_F", wnd %"U32_F
+    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"TCPWNDSIZE_F
+                                 ", cwnd %"TCPWNDSIZE_F", wnd %"U32_F
                                  ", seg == NULL, ack %"U32_F"\n",
                                  pcb->snd_wnd, pcb->cwnd, wnd, pcb->lastack));
   } else {
     LWIP_DEBUGF(TCP_CWND_DEBUG, 
-                ("tcp_output: snd_wnd %"U16_F", cwnd %"U16_F", wnd %"U32_F
+                ("tcp_output: snd_wnd %"TCPWNDSIZE_F", cwnd %"TCPWNDSIZE_F", wnd %"U32_F
                  ", effwnd %"U32_F", seq %"U32_F", ack %"U32_F"\n",
                  pcb->snd_wnd, pcb->cwnd, wnd,
                  ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len,
@@ -965,7 +1127,7 @@ tcp_output(struct tcp_pcb *pcb)
       break;
     }
 #if TCP_CWND_DEBUG
-    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"U16_F", cwnd %"U16_F", wnd %"U32_F", effwnd %"U32_F", seq %"U32_F", ack %"U32_F", i %"S16_F"\n",
+    LWIP_DEBUGF(TCP_CWND_DEBUG, ("tcp_output: snd_wnd %"TCPWNDSIZE_F", cwnd %"TCPWNDSIZE_F", wnd %"U32_F", effwnd %"U32_F", seq %"U32_F", ack %"U32_F", i %"S16_F"\n",
                             pcb->snd_wnd, pcb->cwnd, wnd,
                             ntohl(seg->tcphdr->seqno) + seg->len -
                             pcb->lastack,
@@ -1025,7 +1187,10 @@ tcp_output(struct tcp_pcb *pcb)
   }
 #endif /* TCP_OVERSIZE */
 
-  if (seg != NULL && pcb->persist_backoff == 0 && 
+  /* Only probe the window when nothing is in flight: the persist timer
+     stops the retransmission timer, and lost unacked data would then never
+     be resent if the window is merely too small for the next segment. */
+  if (seg != NULL && pcb->persist_backoff == 0 && pcb->unacked == NULL &&
       ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len > pcb->snd_wnd) {
     /* prepare for persist timer */
     pcb->persist_cnt = 0;
@@ -1049,6 +1214,15 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
   struct netif *netif;
   u32_t *opts;
 
+#if LWIP_TXQUEUE
+  if (seg->p->ref != 1) {
+    /* The last transmission of this segment is still waiting in a transmit
+       queue of the netif.  Rewriting the headers would change that frame,
+       which will be sent anyway. */
+    return;
+  }
+#endif /* LWIP_TXQUEUE */
+
   /** @bug Exclude retransmitted segments from this count. */
   snmp_inc_tcpoutsegs();
 
@@ -1057,7 +1231,15 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
   seg->tcphdr->ackno = htonl(pcb->rcv_nxt);
 
   /* advertise our receive window size in this TCP segment */
-  seg->tcphdr->wnd = htons(pcb->rcv_ann_wnd);
+#if LWIP_WND_SCALE
+  if (TCPH_FLAGS(seg->tcphdr) & TCP_SYN) {
+    /* the window in a SYN is never scaled */
+    seg->tcphdr->wnd = htons(TCPWND16(pcb->rcv_ann_wnd));
+  } else
+#endif /* LWIP_WND_SCALE */
+  {
+    seg->tcphdr->wnd = htons(TCPWND16(RCV_WND_SCALE(pcb, pcb->rcv_ann_wnd)));
+  }
 
   pcb->rcv_ann_right_edge = pcb->rcv_nxt + pcb->rcv_ann_wnd;
 
@@ -1069,6 +1251,18 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
     TCP_BUILD_MSS_OPTION(*opts);
     opts += 1;
   }
+#if LWIP_WND_SCALE
+  if (seg->flags & TF_SEG_OPTS_WND_SCALE) {
+    TCP_BUILD_WND_SCALE_OPTION(*opts);
+    opts += 1;
+  }
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+  if (seg->flags & TF_SEG_OPTS_SACK_PERM) {
+    TCP_BUILD_SACK_PERM_OPTION(*opts);
+    opts += 1;
+  }
+#endif /* LWIP_TCP_SACK */
 #if LWIP_TCP_TIMESTAMPS
   pcb->ts_lastacksent = pcb->rcv_nxt;
 
@@ -1114,7 +1308,7 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
   seg->tcphdr->chksum = 0;
 #if CHECKSUM_GEN_TCP
 #if TCP_CHECKSUM_ON_COPY
-  {
+  if (TCP_CHECKSUM_GEN_ENABLED(&(pcb->remote_ip))) {
     u32_t acc;
 #if TCP_CHECKSUM_ON_COPY_SANITY_CHECK
     u16_t chksum_slow = inet_chksum_pseudo(seg->p, &(pcb->local_ip),
@@ -1147,9 +1341,11 @@ tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb)
 #endif /* TCP_CHECKSUM_ON_COPY_SANITY_CHECK */
   }
 #else /* TCP_CHECKSUM_ON_COPY */
-  seg->tcphdr->chksum = inet_chksum_pseudo(seg->p, &(pcb->local_ip),
-         &(pcb->remote_ip),
-         IP_PROTO_TCP, seg->p->tot_len);
+  if (TCP_CHECKSUM_GEN_ENABLED(&(pcb->remote_ip))) {
+    seg->tcphdr->chksum = inet_chksum_pseudo(seg->p, &(pcb->local_ip),
+           &(pcb->remote_ip),
+           IP_PROTO_TCP, seg->p->tot_len);
+  }
 #endif /* TCP_CHECKSUM_ON_COPY */
 #endif /* CHECKSUM_GEN_TCP */
   TCP_STATS_INC(tcp.xmit);
@@ -1204,13 +1400,15 @@ tcp_rst(u32_t seqno, u32_t ackno,
   tcphdr->seqno = htonl(seqno);
   tcphdr->ackno = htonl(ackno);
   TCPH_HDRLEN_FLAGS_SET(tcphdr, TCP_HLEN/4, TCP_RST | TCP_ACK);
-  tcphdr->wnd = PP_HTONS(TCP_WND);
+  tcphdr->wnd = PP_HTONS(TCPWND16(TCP_WND));
   tcphdr->chksum = 0;
   tcphdr->urgp = 0;
 
 #if CHECKSUM_GEN_TCP
-  tcphdr->chksum = inet_chksum_pseudo(p, local_ip, remote_ip,
-              IP_PROTO_TCP, p->tot_len);
+  if (TCP_CHECKSUM_GEN_ENABLED(remote_ip)) {
+    tcphdr->chksum = inet_chksum_pseudo(p, local_ip, remote_ip,
+                IP_PROTO_TCP, p->tot_len);
+  }
 #endif
   TCP_STATS_INC(tcp.xmit);
   snmp_inc_tcpoutrsts();
@@ -1220,6 +1418,49 @@ tcp_rst(u32_t seqno, u32_t ackno,
   LWIP_DEBUGF(TCP_RST_DEBUG, ("tcp_rst: seqno %"U32_F" ackno %"U32_F".\n", seqno, ackno));
 }
 
+#if TCP_COMPACT_TIME_WAIT
+/**
+ * Send an ACK for a connection in TIME-WAIT that is only kept as a
+ * struct tcp_tw, as tcp_send_empty_ack() would for its pcb.
+ *
+ * @param tw the TIME-WAIT record to acknowledge for
+ */
+void
+tcp_tw_ack(struct tcp_tw *tw)
+{
+  struct pbuf *p;
+  struct tcp_hdr *tcphdr;
+  p = pbuf_alloc(PBUF_IP, TCP_HLEN, PBUF_RAM);
+  if (p == NULL) {
+      LWIP_DEBUGF(TCP_DEBUG, ("tcp_tw_ack: could not allocate memory for pbuf\n"));
+      return;
+  }
+  LWIP_ASSERT("check that first pbuf can hold struct tcp_hdr",
+              (p->len >= sizeof(struct tcp_hdr)));
+
+  tcphdr = (struct tcp_hdr *)p->payload;
+  tcphdr->src = htons(tw->local_port);
+  tcphdr->dest = htons(tw->remote_port);
+  tcphdr->seqno = htonl(tw->snd_nxt);
+  tcphdr->ackno = htonl(tw->rcv_nxt);
+  TCPH_HDRLEN_FLAGS_SET(tcphdr, TCP_HLEN/4, TCP_ACK);
+  tcphdr->wnd = htons(tw->ann_wnd);
+  tcphdr->chksum = 0;
+  tcphdr->urgp = 0;
+
+#if CHECKSUM_GEN_TCP
+  if (TCP_CHECKSUM_GEN_ENABLED(&(tw->remote_ip))) {
+    tcphdr->chksum = inet_chksum_pseudo(p, &(tw->local_ip), &(tw->remote_ip),
+                IP_PROTO_TCP, p->tot_len);
+  }
+#endif
+  TCP_STATS_INC(tcp.xmit);
+  ip_output(p, &(tw->local_ip), &(tw->remote_ip), tw->ttl, tw->tos, IP_PROTO_TCP);
+  pbuf_free(p);
+  LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_tw_ack: sending ACK for %"U32_F"\n", tw->rcv_nxt));
+}
+#endif /* TCP_COMPACT_TIME_WAIT */
+
 /**
  * Requeue all unacked segments for retransmission
  *
@@ -1236,14 +1477,62 @@ tcp_rexmit_rto(struct tcp_pcb *pcb)
     return;
   }
 
-  /* Move all unacked segments to the head of the unsent queue */
-  for (seg = pcb->unacked; seg->next != NULL; seg = seg->next);
-  /* concatenate unsent queue after unacked queue */
-  seg->next = pcb->unsent;
-  /* unsent queue is the concatenated queue (of unacked, unsent) */
-  pcb->unsent = pcb->unacked;
-  /* unacked queue is now empty */
-  pcb->unacked = NULL;
+#if LWIP_TCP_NEWRENO
+  /* A timeout ends fast recovery; dupacks for what was sent before it must
+     not start a new one (RFC 6582) */
+  pcb->flags &= ~TF_INFR;
+  pcb->recover = pcb->snd_nxt;
+#endif /* LWIP_TCP_NEWRENO */
+
+#if LWIP_TCP_SACK
+  if ((pcb->flags & TF_SACK) && (pcb->nrtx <= 1)) {
+    /* First timeout (possibly after a fast retransmit): resend the first
+       unacked segment and every segment not SACKed by the remote end;
+       SACKed ones stay on the unacked list. Repeated timeouts do not trust
+       the SACKs any more and resend everything. */
+    struct tcp_seg *resend = pcb->unacked;
+    struct tcp_seg **resend_tail = &(resend->next);
+    struct tcp_seg *keep = NULL;
+    struct tcp_seg **keep_tail = &keep;
+    struct tcp_seg *next;
+
+    resend->flags &= ~(TF_SEG_SACKED | TF_SEG_REXMITTED);
+    for (seg = resend->next; seg != NULL; seg = next) {
+      next = seg->next;
+      if (seg->flags & TF_SEG_SACKED) {
+        *keep_tail = seg;
+        keep_tail = &(seg->next);
+      } else {
+        seg->flags &= ~TF_SEG_REXMITTED;
+        *resend_tail = seg;
+        resend_tail = &(seg->next);
+      }
+    }
+    *keep_tail = NULL;
+    /* resent segments go in front of the unsent queue, still sorted */
+    *resend_tail = pcb->unsent;
+    pcb->unsent = resend;
+    /* tcp_output() puts them back between the SACKed ones */
+    pcb->unacked = keep;
+  } else
+#endif /* LWIP_TCP_SACK */
+  {
+    /* Move all unacked segments to the head of the unsent queue */
+    for (seg = pcb->unacked; seg->next != NULL; seg = seg->next) {
+#if LWIP_TCP_SACK
+      seg->flags &= ~(TF_SEG_SACKED | TF_SEG_REXMITTED);
+#endif /* LWIP_TCP_SACK */
+    }
+#if LWIP_TCP_SACK
+    seg->flags &= ~(TF_SEG_SACKED | TF_SEG_REXMITTED);
+#endif /* LWIP_TCP_SACK */
+    /* concatenate unsent queue after unacked queue */
+    seg->next = pcb->unsent;
+    /* unsent queue is the concatenated queue (of unacked, unsent) */
+    pcb->unsent = pcb->unacked;
+    /* unacked queue is now empty */
+    pcb->unacked = NULL;
+  }
 
   /* increment number of retransmissions */
   ++pcb->nrtx;
@@ -1284,6 +1573,9 @@ tcp_rexmit(struct tcp_pcb *pcb)
   }
   seg->next = *cur_seg;
   *cur_seg = seg;
+#if LWIP_TCP_SACK
+  seg->flags |= TF_SEG_REXMITTED;
+#endif /* LWIP_TCP_SACK */
 
   ++pcb->nrtx;
 
@@ -1305,13 +1597,31 @@ tcp_rexmit(struct tcp_pcb *pcb)
 void 
 tcp_rexmit_fast(struct tcp_pcb *pcb)
 {
-  if (pcb->unacked != NULL && !(pcb->flags & TF_INFR)) {
+#if LWIP_TCP_SACK
+  struct tcp_seg *seg;
+#endif /* LWIP_TCP_SACK */
+
+  if (pcb->unacked != NULL && !(pcb->flags & TF_INFR)
+#if LWIP_TCP_NEWRENO
+      /* no new recovery for dupacks of data sent before the last one
+         ended (RFC 6582 "careful" variant) */
+      && TCP_SEQ_GEQ(pcb->lastack, pcb->recover)
+#endif /* LWIP_TCP_NEWRENO */
+      ) {
     /* This is fast retransmit. Retransmit the first unacked segment. */
     LWIP_DEBUGF(TCP_FR_DEBUG, 
                 ("tcp_receive: dupacks %"U16_F" (%"U32_F
                  "), fast retransmit %"U32_F"\n",
                  (u16_t)pcb->dupacks, pcb->lastack,
                  ntohl(pcb->unacked->tcphdr->seqno)));
+#if LWIP_TCP_SACK
+    for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+      seg->flags &= ~TF_SEG_REXMITTED;
+    }
+#endif /* LWIP_TCP_SACK */
+#if LWIP_TCP_NEWRENO
+    pcb->recover = pcb->snd_nxt;
+#endif /* LWIP_TCP_NEWRENO */
     tcp_rexmit(pcb);
 
     /* Set ssthresh to half of the minimum of the current
@@ -1325,7 +1635,7 @@ tcp_rexmit_fast(struct tcp_pcb *pcb)
     /* The minimum value for ssthresh should be 2 MSS */
     if (pcb->ssthresh < 2*pcb->mss) {
       LWIP_DEBUGF(TCP_FR_DEBUG, 
-                  ("tcp_receive: The minimum value for ssthresh %"U16_F
+                  ("tcp_receive: The minimum value for ssthresh %"TCPWNDSIZE_F
                    " should be min 2 mss %"U16_F"...\n",
                    pcb->ssthresh, 2*pcb->mss));
       pcb->ssthresh = 2*pcb->mss;
@@ -1336,6 +1646,64 @@ tcp_rexmit_fast(struct tcp_pcb *pcb)
   } 
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Requeue the next hole reported by the remote end for retransmission:
+ * the first unacked segment that has neither been SACKed nor resent in
+ * the current fast recovery and has a SACKed segment after it.
+ *
+ * Called by tcp_receive() while in fast recovery.
+ *
+ * @param pcb the tcp_pcb for which to retransmit a lost segment
+ */
+void
+tcp_rexmit_sack(struct tcp_pcb *pcb)
+{
+  struct tcp_seg **hole = NULL;
+  struct tcp_seg **cur_seg;
+  struct tcp_seg *seg;
+
+  if (!(pcb->flags & TF_SACK)) {
+    return;
+  }
+
+  for (cur_seg = &(pcb->unacked); *cur_seg != NULL; cur_seg = &((*cur_seg)->next)) {
+    if ((*cur_seg)->flags & TF_SEG_SACKED) {
+      if (hole != NULL) {
+        break;
+      }
+    } else if ((hole == NULL) && !((*cur_seg)->flags & TF_SEG_REXMITTED)) {
+      hole = cur_seg;
+    }
+  }
+  if ((hole == NULL) || (*cur_seg == NULL)) {
+    /* no SACKed data above a segment still to be resent */
+    return;
+  }
+
+  /* Move the segment to the unsent queue, keeping it sorted */
+  seg = *hole;
+  *hole = seg->next;
+  LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_rexmit_sack: resending %"U32_F"\n",
+                             ntohl(seg->tcphdr->seqno)));
+
+  cur_seg = &(pcb->unsent);
+  while (*cur_seg &&
+    TCP_SEQ_LT(ntohl((*cur_seg)->tcphdr->seqno), ntohl(seg->tcphdr->seqno))) {
+      cur_seg = &((*cur_seg)->next );
+  }
+  seg->next = *cur_seg;
+  *cur_seg = seg;
+  seg->flags |= TF_SEG_REXMITTED;
+
+  /* Don't take any rtt measurements after retransmitting. */
+  pcb->rttest = 0;
+
+  snmp_inc_tcpretranssegs();
+  /* tcp_input() calls tcp_output() for us */
+}
+#endif /* LWIP_TCP_SACK */
+
 
 /**
  * Send keepalive packets to keep a connection active although
@@ -1367,8 +1735,10 @@ tcp_keepalive(struct tcp_pcb *pcb)
   tcphdr = (struct tcp_hdr *)p->payload;
 
 #if CHECKSUM_GEN_TCP
-  tcphdr->chksum = inet_chksum_pseudo(p, &pcb->local_ip, &pcb->remote_ip,
-                                      IP_PROTO_TCP, p->tot_len);
+  if (TCP_CHECKSUM_GEN_ENABLED(&pcb->remote_ip)) {
+    tcphdr->chksum = inet_chksum_pseudo(p, &pcb->local_ip, &pcb->remote_ip,
+                                        IP_PROTO_TCP, p->tot_len);
+  }
 #endif
   TCP_STATS_INC(tcp.xmit);
 
@@ -1440,14 +1810,18 @@ tcp_zero_window_probe(struct tcp_pcb *pcb)
     TCPH_FLAGS_SET(tcphdr, TCP_ACK | TCP_FIN);
   } else {
     /* Data segment, copy in one byte from the head of the unacked queue */
-    struct tcp_hdr *thdr = (struct tcp_hdr *)seg->p->payload;
     char *d = ((char *)p->payload + TCP_HLEN);
-    pbuf_copy_partial(seg->p, d, 1, TCPH_HDRLEN(thdr) * 4);
+    /* Once a segment has been sent, seg->p->payload points to the IP
+       header rather than the TCP header: locate the first data byte from
+       the end of the pbuf instead. */
+    pbuf_copy_partial(seg->p, d, 1, seg->p->tot_len - seg->len);
   }
 
 #if CHECKSUM_GEN_TCP
-  tcphdr->chksum = inet_chksum_pseudo(p, &pcb->local_ip, &pcb->remote_ip,
-                                      IP_PROTO_TCP, p->tot_len);
+  if (TCP_CHECKSUM_GEN_ENABLED(&pcb->remote_ip)) {
+    tcphdr->chksum = inet_chksum_pseudo(p, &pcb->local_ip, &pcb->remote_ip,
+                                        IP_PROTO_TCP, p->tot_len);
+  }
 #endif
   TCP_STATS_INC(tcp.xmit);
 
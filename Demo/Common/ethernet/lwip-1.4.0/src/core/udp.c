@@ -61,6 +61,9 @@
 #include "lwip/snmp.h"
 #include "arch/perf.h"
 #include "lwip/dhcp.h"
+#if LWIP_UDP_FLOW
+#include "netif/etharp.h"
+#endif /* LWIP_UDP_FLOW */
 
 #include <string.h>
 
@@ -252,7 +255,7 @@ udp_input(struct pbuf *p, struct netif *inp)
 #endif /* LWIP_UDPLITE */
     {
 #if CHECKSUM_CHECK_UDP
-      if (udphdr->chksum != 0) {
+      if ((udphdr->chksum != 0) && NETIF_CHECKSUM_ENABLED(inp, NETIF_CHECKSUM_CHECK_UDP)) {
         if (inet_chksum_pseudo(p, ip_current_src_addr(), ip_current_dest_addr(),
                                IP_PROTO_UDP, p->tot_len) != 0) {
           LWIP_DEBUGF(UDP_DEBUG | LWIP_DBG_LEVEL_SERIOUS,
@@ -630,7 +633,8 @@ udp_sendto_if_chksum(struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *dst_ip,
     udphdr->len = htons(q->tot_len);
     /* calculate checksum */
 #if CHECKSUM_GEN_UDP
-    if ((pcb->flags & UDP_FLAGS_NOCHKSUM) == 0) {
+    if (((pcb->flags & UDP_FLAGS_NOCHKSUM) == 0) &&
+        NETIF_CHECKSUM_ENABLED(netif, NETIF_CHECKSUM_GEN_UDP)) {
       u16_t udpchksum;
 #if LWIP_CHECKSUM_ON_COPY
       if (have_chksum) {
@@ -678,6 +682,281 @@ udp_sendto_if_chksum(struct udp_pcb *pcb, struct pbuf *p, ip_addr_t *dst_ip,
   return err;
 }
 
+#if LWIP_UDP_FLOW
+/** Total length of the headers held in a flow template */
+#define UDP_FLOW_HLEN (SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN)
+
+/**
+ * Make sure the destination address in a flow template is that of the
+ * current ARP entry for the next hop.
+ *
+ * @param flow the flow to check
+ * @return 1 if the template can be used, 0 if the next hop is unresolved
+ */
+static u8_t
+udp_flow_resolve(struct udp_flow *flow)
+{
+  struct eth_hdr *ethhdr = (struct eth_hdr *)flow->hdr;
+  struct eth_addr *ethaddr;
+  ip_addr_t *ipaddr;
+
+  if (!flow->unicast) {
+    /* broadcast and multicast addresses are fixed */
+    return 1;
+  }
+  ethaddr = etharp_check_entry(flow->arp_index, &flow->nexthop);
+  if (ethaddr == NULL) {
+    /* the entry has timed out or been reused, look the next hop up again */
+    flow->arp_index = etharp_find_addr(flow->netif, &flow->nexthop, &ethaddr, &ipaddr);
+    if (flow->arp_index < 0) {
+      return 0;
+    }
+  }
+  /* the next hop may have changed its Ethernet address */
+  ETHADDR32_COPY(&ethhdr->dest, ethaddr);
+  return 1;
+}
+
+/**
+ * Prepare a flow for sending on a connected UDP PCB with udp_flow_send().
+ *
+ * The route, source address and next hop are resolved and the headers of
+ * every datagram are built into a template. If the next hop is not in the
+ * ARP cache yet, udp_flow_send() falls back to udp_send(), which sends the
+ * ARP request, until it is.
+ *
+ * @param flow the flow to prepare
+ * @param pcb the connected UDP PCB to send on
+ *
+ * @return lwIP error code.
+ * - ERR_OK. Successful. No error occured.
+ * - ERR_VAL. The PCB is not connected, is UDP Lite, may not broadcast or
+ *   has a local address that does not belong to the outgoing netif.
+ * - ERR_RTE. Could not find route to destination address.
+ * - ERR_IF. The outgoing netif is not an Ethernet netif.
+ * - More errors could be returned by udp_bind().
+ *
+ * @see udp_connect()
+ */
+err_t
+udp_flow_connect(struct udp_flow *flow, struct udp_pcb *pcb)
+{
+  struct eth_hdr *ethhdr;
+  struct ip_hdr *iphdr;
+  struct udp_hdr *udphdr;
+  struct netif *netif;
+  ip_addr_t *dst_ip, *src_ip;
+  u32_t acc;
+  err_t err;
+
+  flow->pcb = pcb;
+  /* udp_flow_send() uses udp_send() until the flow is complete */
+  flow->netif = NULL;
+
+  if (((pcb->flags & UDP_FLAGS_CONNECTED) == 0) ||
+      ((pcb->flags & UDP_FLAGS_UDPLITE) != 0)) {
+    return ERR_VAL;
+  }
+  dst_ip = &pcb->remote_ip;
+
+  /* find the outgoing network interface, as udp_sendto() does */
+#if LWIP_IGMP
+  netif = ip_route((ip_addr_ismulticast(dst_ip))?(&(pcb->multicast_ip)):(dst_ip));
+#else
+  netif = ip_route(dst_ip);
+#endif /* LWIP_IGMP */
+  if (netif == NULL) {
+    UDP_STATS_INC(udp.rterr);
+    return ERR_RTE;
+  }
+  if ((netif->flags & NETIF_FLAG_ETHARP) == 0) {
+    return ERR_IF;
+  }
+#if IP_SOF_BROADCAST
+  if (((pcb->so_options & SOF_BROADCAST) == 0) && ip_addr_isbroadcast(dst_ip, netif)) {
+    return ERR_VAL;
+  }
+#endif /* IP_SOF_BROADCAST */
+
+  if (pcb->local_port == 0) {
+    err = udp_bind(pcb, &pcb->local_ip, pcb->local_port);
+    if (err != ERR_OK) {
+      return err;
+    }
+  }
+  if (ip_addr_isany(&pcb->local_ip)) {
+    src_ip = &(netif->ip_addr);
+  } else if (ip_addr_cmp(&(pcb->local_ip), &(netif->ip_addr))) {
+    src_ip = &(pcb->local_ip);
+  } else {
+    return ERR_VAL;
+  }
+
+  /* Ethernet header, choosing the destination as etharp_output() does */
+  ethhdr = (struct eth_hdr *)flow->hdr;
+  memset(flow->hdr, 0, sizeof(flow->hdr));
+  ETHADDR16_COPY(&ethhdr->src, (struct eth_addr *)netif->hwaddr);
+  ethhdr->type = PP_HTONS(ETHTYPE_IP);
+  flow->unicast = 0;
+  if (ip_addr_isbroadcast(dst_ip, netif)) {
+    ETHADDR16_COPY(&ethhdr->dest, &ethbroadcast);
+  } else if (ip_addr_ismulticast(dst_ip)) {
+    ethhdr->dest.addr[0] = 0x01;
+    ethhdr->dest.addr[1] = 0x00;
+    ethhdr->dest.addr[2] = 0x5e;
+    ethhdr->dest.addr[3] = ip4_addr2(dst_ip) & 0x7f;
+    ethhdr->dest.addr[4] = ip4_addr3(dst_ip);
+    ethhdr->dest.addr[5] = ip4_addr4(dst_ip);
+  } else {
+    flow->unicast = 1;
+    flow->arp_index = -1;
+    ip_addr_copy(flow->nexthop, *dst_ip);
+    /* outside local network? */
+    if (!ip_addr_netcmp(dst_ip, &(netif->ip_addr), &(netif->netmask)) &&
+#if LWIP_AUTOIP
+        !ip_addr_islinklocal(src_ip) &&
+#endif /* LWIP_AUTOIP */
+        !ip_addr_islinklocal(dst_ip)) {
+      if (ip_addr_isany(&netif->gw)) {
+        return ERR_RTE;
+      }
+      ip_addr_copy(flow->nexthop, netif->gw);
+    }
+  }
+
+  /* IP header, the length, ID and checksum being filled in per datagram */
+  iphdr = (struct ip_hdr *)(flow->hdr + SIZEOF_ETH_HDR);
+  IPH_VHLTOS_SET(iphdr, 4, IP_HLEN / 4, pcb->tos);
+  IPH_OFFSET_SET(iphdr, 0);
+  IPH_TTL_SET(iphdr, pcb->ttl);
+  IPH_PROTO_SET(iphdr, IP_PROTO_UDP);
+  ip_addr_copy(iphdr->src, *src_ip);
+  ip_addr_copy(iphdr->dest, *dst_ip);
+  flow->ip_sum = (u16_t)~inet_chksum(iphdr, IP_HLEN);
+
+  /* UDP header, with the length and checksum filled in per datagram. The
+     pseudo header is the two addresses and the protocol, plus the length. */
+  udphdr = (struct udp_hdr *)(flow->hdr + SIZEOF_ETH_HDR + IP_HLEN);
+  udphdr->src = htons(pcb->local_port);
+  udphdr->dest = htons(pcb->remote_port);
+  acc = (u16_t)~inet_chksum(&(iphdr->src), 2 * sizeof(ip_addr_t));
+  acc += PP_HTONS(IP_PROTO_UDP);
+  acc += (u16_t)~inet_chksum(udphdr, UDP_HLEN);
+  acc = FOLD_U32T(acc);
+  acc = FOLD_U32T(acc);
+  flow->udp_sum = (u16_t)acc;
+
+  flow->netif = netif;
+  udp_flow_resolve(flow);
+  return ERR_OK;
+}
+
+/**
+ * Send a datagram on a flow prepared by udp_flow_connect().
+ *
+ * The frame is built from the template of the flow in the header space of
+ * p, and passed straight to netif->linkoutput. p should therefore be
+ * allocated with PBUF_TRANSPORT. If the address of the netif has changed
+ * the flow is prepared again first. Datagrams that cannot be sent that
+ * way (no room for the headers, larger than the MTU, next hop unresolved
+ * or netif down) are sent by udp_send() instead.
+ *
+ * @param flow the flow to send on
+ * @param p chain of pbuf's to be sent
+ *
+ * @return lwIP error code (@see udp_send for possible error codes)
+ *
+ * @see udp_flow_connect() udp_send()
+ */
+err_t
+udp_flow_send(struct udp_flow *flow, struct pbuf *p)
+{
+  struct netif *netif;
+  struct ip_hdr *iphdr;
+  struct udp_hdr *udphdr;
+  u16_t len, id;
+  u32_t acc;
+  err_t err;
+#if CHECKSUM_GEN_UDP
+  u8_t gen_udp_chksum;
+  u16_t payload_sum = 0;
+#endif /* CHECKSUM_GEN_UDP */
+
+  iphdr = (struct ip_hdr *)(flow->hdr + SIZEOF_ETH_HDR);
+  if ((flow->netif == NULL) || !ip_addr_cmp(&(iphdr->src), &(flow->netif->ip_addr))) {
+    /* the flow was never completed, or the netif has changed address */
+    udp_flow_connect(flow, flow->pcb);
+  }
+  netif = flow->netif;
+  if ((netif == NULL) || !netif_is_up(netif) ||
+      ((netif->mtu != 0) && ((u32_t)p->tot_len + IP_HLEN + UDP_HLEN > netif->mtu)) ||
+#if LWIP_IGMP
+      (ip_addr_ismulticast(&(flow->pcb->remote_ip)) &&
+       ((flow->pcb->flags & UDP_FLAGS_MULTICAST_LOOP) != 0)) ||
+#endif /* LWIP_IGMP */
+      (p->ref != 1) || !udp_flow_resolve(flow)) {
+    return udp_send(flow->pcb, p);
+  }
+
+#if CHECKSUM_GEN_UDP
+  gen_udp_chksum = ((flow->pcb->flags & UDP_FLAGS_NOCHKSUM) == 0) &&
+    NETIF_CHECKSUM_ENABLED(netif, NETIF_CHECKSUM_GEN_UDP);
+  if (gen_udp_chksum) {
+    /* sum the payload before the headers are put in front of it */
+    payload_sum = (u16_t)~inet_chksum_pbuf(p);
+  }
+#endif /* CHECKSUM_GEN_UDP */
+
+  if (pbuf_header(p, UDP_FLOW_HLEN)) {
+    return udp_send(flow->pcb, p);
+  }
+  LWIP_ASSERT("check that first pbuf can hold the flow headers",
+              (p->len >= UDP_FLOW_HLEN));
+  MEMCPY(p->payload, flow->hdr, UDP_FLOW_HLEN);
+  iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+  udphdr = (struct udp_hdr *)((u8_t *)iphdr + IP_HLEN);
+
+  len = p->tot_len - SIZEOF_ETH_HDR;
+  id = htons(ip_next_id());
+  IPH_LEN_SET(iphdr, htons(len));
+  IPH_ID_SET(iphdr, id);
+#if CHECKSUM_GEN_IP
+  if (NETIF_CHECKSUM_ENABLED(netif, NETIF_CHECKSUM_GEN_IP)) {
+    acc = (u32_t)flow->ip_sum + IPH_LEN(iphdr) + id;
+    acc = FOLD_U32T(acc);
+    acc = FOLD_U32T(acc);
+    IPH_CHKSUM_SET(iphdr, (u16_t)~acc);
+  }
+#endif /* CHECKSUM_GEN_IP */
+
+  udphdr->len = htons(len - IP_HLEN);
+#if CHECKSUM_GEN_UDP
+  if (gen_udp_chksum) {
+    /* the length is in both the pseudo header and the UDP header */
+    acc = (u32_t)flow->udp_sum + udphdr->len + udphdr->len + payload_sum;
+    acc = FOLD_U32T(acc);
+    acc = FOLD_U32T(acc);
+    udphdr->chksum = (u16_t)~acc;
+    /* chksum zero must become 0xffff, as zero means 'no checksum' */
+    if (udphdr->chksum == 0x0000) {
+      udphdr->chksum = 0xffff;
+    }
+  }
+#endif /* CHECKSUM_GEN_UDP */
+
+  LWIP_DEBUGF(UDP_DEBUG, ("udp_flow_send: sending datagram of length %"U16_F"\n", len - IP_HLEN));
+  snmp_inc_ipoutrequests();
+  IP_STATS_INC(ip.xmit);
+  err = netif->linkoutput(netif, p);
+  snmp_inc_udpoutdatagrams();
+  UDP_STATS_INC(udp.xmit);
+
+  /* hand p back to the caller as it was passed in */
+  pbuf_header(p, -(s16_t)UDP_FLOW_HLEN);
+  return err;
+}
+#endif /* LWIP_UDP_FLOW */
+
 /**
  * Bind an UDP PCB.
  *
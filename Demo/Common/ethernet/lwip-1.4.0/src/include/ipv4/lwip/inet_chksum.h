@@ -59,7 +59,8 @@
 #ifndef LWIP_CHKSUM_COPY
 #define LWIP_CHKSUM_COPY(dst, src, len) lwip_chksum_copy(dst, src, len)
 #ifndef LWIP_CHKSUM_COPY_ALGORITHM
-#define LWIP_CHKSUM_COPY_ALGORITHM 1
+/* 1: MEMCPY then LWIP_CHKSUM, 2: copy and sum in a single pass */
+#define LWIP_CHKSUM_COPY_ALGORITHM 2
 #endif /* LWIP_CHKSUM_COPY_ALGORITHM */
 #endif /* LWIP_CHKSUM_COPY */
 #else /* LWIP_CHECKSUM_ON_COPY */
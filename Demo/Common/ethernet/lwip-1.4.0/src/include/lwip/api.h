@@ -123,6 +123,12 @@ enum netconn_igmp {
 struct ip_pcb;
 struct tcp_pcb;
 struct udp_pcb;
+
+#if LWIP_TCP_WRITE_REF
+/** Completion callback of netconn_write_ref(), same as tcp_write_done_fn.
+ * Called from tcpip_thread once the written buffer may be reused. */
+typedef void (*netconn_write_done_fn)(void *arg);
+#endif /* LWIP_TCP_WRITE_REF */
 struct raw_pcb;
 struct netconn;
 struct api_msg_msg;
@@ -227,11 +233,16 @@ err_t   netconn_accept(struct netconn *conn, struct netconn **new_conn);
 err_t   netconn_recv(struct netconn *conn, struct netbuf **new_buf);
 err_t   netconn_recv_tcp_pbuf(struct netconn *conn, struct pbuf **new_buf);
 void    netconn_recved(struct netconn *conn, u32_t length);
+void    netconn_free_tcp_pbuf(struct netconn *conn, struct pbuf *p);
 err_t   netconn_sendto(struct netconn *conn, struct netbuf *buf,
                        ip_addr_t *addr, u16_t port);
 err_t   netconn_send(struct netconn *conn, struct netbuf *buf);
 err_t   netconn_write(struct netconn *conn, const void *dataptr, size_t size,
                       u8_t apiflags);
+#if LWIP_TCP_WRITE_REF
+err_t   netconn_write_ref(struct netconn *conn, const void *dataptr, size_t size,
+                          u8_t apiflags, netconn_write_done_fn done, void *done_arg);
+#endif /* LWIP_TCP_WRITE_REF */
 err_t   netconn_close(struct netconn *conn);
 err_t   netconn_shutdown(struct netconn *conn, u8_t shut_rx, u8_t shut_tx);
 
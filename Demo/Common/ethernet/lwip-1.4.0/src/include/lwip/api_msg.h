@@ -89,6 +89,10 @@ struct api_msg_msg {
       const void *dataptr;
       size_t len;
       u8_t apiflags;
+#if LWIP_TCP_WRITE_REF
+      netconn_write_done_fn done;
+      void *done_arg;
+#endif /* LWIP_TCP_WRITE_REF */
     } w;
     /** used for do_recv */
     struct {
@@ -20,7 +20,9 @@ extern "C" {
 /** period (in milliseconds) of the application calling dhcp_coarse_tmr() */
 #define DHCP_COARSE_TIMER_MSECS (DHCP_COARSE_TIMER_SECS * 1000UL)
 /** period (in milliseconds) of the application calling dhcp_fine_tmr() */
+#ifndef DHCP_FINE_TIMER_MSECS
 #define DHCP_FINE_TIMER_MSECS 500 
+#endif
 
 #define DHCP_CHADDR_LEN 16U
 #define DHCP_SNAME_LEN  64U
@@ -65,6 +67,27 @@ struct dhcp
 #endif /* LWIP_DHCP_BOOTPFILE */
 };
 
+#if LWIP_DHCP_LEASE_CACHE
+/** A bound lease, as passed to the lease callback and to dhcp_start_lease() */
+struct dhcp_lease
+{
+  ip_addr_t ip_addr;
+  ip_addr_t sn_mask;
+  ip_addr_t gw_addr;
+  ip_addr_t server_ip_addr;
+  u32_t t0_lease;  /* lease period (in seconds) */
+  u32_t t1_renew;  /* renew time (in seconds) */
+  u32_t t2_rebind; /* rebind time (in seconds) */
+  u8_t subnet_mask_given;
+};
+
+/** Function prototype for the lease callback. It is called in the lwIP
+ * thread each time a lease is bound, renewals included, and with lease ==
+ * NULL when the lease is refused by the server or released, so that a stored
+ * copy is forgotten. */
+typedef void (*dhcp_lease_fn)(struct netif *netif, const struct dhcp_lease *lease);
+#endif /* LWIP_DHCP_LEASE_CACHE */
+
 /* MUST be compiled with "pack structs" or equivalent! */
 #ifdef PACK_STRUCT_USE_INCLUDES
 #  include "arch/bpstruct.h"
@@ -111,6 +134,12 @@ void dhcp_set_struct(struct netif *netif, struct dhcp *dhcp);
 void dhcp_cleanup(struct netif *netif);
 /** start DHCP configuration */
 err_t dhcp_start(struct netif *netif);
+#if LWIP_DHCP_LEASE_CACHE
+/** start DHCP configuration by rebooting with a stored lease */
+err_t dhcp_start_lease(struct netif *netif, const struct dhcp_lease *lease);
+/** set the callback that stores bound leases */
+void dhcp_set_lease_callback(dhcp_lease_fn lease_callback);
+#endif /* LWIP_DHCP_LEASE_CACHE */
 /** enforce early lease renewal (not needed normally)*/
 err_t dhcp_renew(struct netif *netif);
 /** release the DHCP lease, usually called before dhcp_stop()*/
@@ -226,6 +255,7 @@ void dhcp_fine_tmr(void);
 #define DHCP_OPTION_CLIENT_ID 61
 #define DHCP_OPTION_TFTP_SERVERNAME 66
 #define DHCP_OPTION_BOOTFILE 67
+#define DHCP_OPTION_RAPID_COMMIT 80 /* RFC 4039, no data */
 
 /** possible combinations of overloading the file and sname fields with options */
 #define DHCP_OVERLOAD_NONE 0
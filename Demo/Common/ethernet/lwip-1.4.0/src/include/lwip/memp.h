@@ -106,6 +106,7 @@ void *memp_malloc_fn(memp_t type, const char* file, const int line);
 void *memp_malloc(memp_t type);
 #endif
 void  memp_free(memp_t type, void *mem);
+u16_t memp_num_free(memp_t type);
 
 #endif /* MEMP_MEM_MALLOC */
 
@@ -42,6 +42,9 @@
 
 #include "lwip/def.h"
 #include "lwip/pbuf.h"
+#if LWIP_NETIF_RX_TASK
+#include "lwip/sys.h"
+#endif /* LWIP_NETIF_RX_TASK */
 #if LWIP_DHCP
 struct dhcp;
 #endif
@@ -94,6 +97,20 @@ extern "C" {
  * Set by the netif driver in its init function. */
 #define NETIF_FLAG_IGMP         0x80U
 
+/** Flags for NETIF_SET_CHECKSUM_CTRL().  A set flag means that checksum is
+ * generated (or checked) in software for packets sent (or received) on the
+ * netif, a cleared flag means the netif's hardware does it instead. */
+#define NETIF_CHECKSUM_GEN_IP       0x0001U
+#define NETIF_CHECKSUM_GEN_UDP      0x0002U
+#define NETIF_CHECKSUM_GEN_TCP      0x0004U
+#define NETIF_CHECKSUM_GEN_ICMP     0x0008U
+#define NETIF_CHECKSUM_CHECK_IP     0x0100U
+#define NETIF_CHECKSUM_CHECK_UDP    0x0200U
+#define NETIF_CHECKSUM_CHECK_TCP    0x0400U
+#define NETIF_CHECKSUM_CHECK_ICMP   0x0800U
+#define NETIF_CHECKSUM_ENABLE_ALL   0xFFFFU
+#define NETIF_CHECKSUM_DISABLE_ALL  0x0000U
+
 /** Function prototype for netif init functions. Set up flags and output/linkoutput
  * callback functions in this function.
  *
@@ -186,6 +203,10 @@ struct netif {
   u8_t hwaddr[NETIF_MAX_HWADDR_LEN];
   /** flags (see NETIF_FLAG_ above) */
   u8_t flags;
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+  /** checksums done in software (see NETIF_CHECKSUM_ above) */
+  u16_t chksum_flags;
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
   /** descriptive abbreviation */
   char name[2];
   /** number of this interface */
@@ -215,6 +236,15 @@ struct netif {
 #if LWIP_NETIF_HWADDRHINT
   u8_t *addr_hint;
 #endif /* LWIP_NETIF_HWADDRHINT */
+#if LWIP_TCP && TCP_STRETCH_ACK
+  /** number of in-order TCP segments received on this netif per immediate
+      ACK (see TCP_STRETCH_ACK) */
+  u8_t tcp_ack_segs;
+#endif /* LWIP_TCP && TCP_STRETCH_ACK */
+#if LWIP_NETIF_RX_TASK
+  /** frames queued for this netif's receive thread by tcpip_rx_input() */
+  sys_mbox_t rx_mbox;
+#endif /* LWIP_NETIF_RX_TASK */
 #if ENABLE_LOOPBACK
   /* List of packets to be queued for ourselves. */
   struct pbuf *loop_first;
@@ -286,6 +316,20 @@ void netif_set_link_down(struct netif *netif);
 /** Ask if a link is up */ 
 #define netif_is_link_up(netif) (((netif)->flags & NETIF_FLAG_LINK_UP) ? (u8_t)1 : (u8_t)0)
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+/** Set which checksums are done in software for a netif, typically from its
+ * init function (NETIF_CHECKSUM_ENABLE_ALL is the default) */
+#define NETIF_SET_CHECKSUM_CTRL(netif, chksumflags) do { \
+  (netif)->chksum_flags = (chksumflags); } while(0)
+/** Is the checksum given by chksumflag done in software for netif?
+ * A NULL netif (no route) is treated as doing all checksums in software. */
+#define NETIF_CHECKSUM_ENABLED(netif, chksumflag) \
+  (((netif) == NULL) || (((netif)->chksum_flags & (chksumflag)) != 0))
+#else /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+#define NETIF_SET_CHECKSUM_CTRL(netif, chksumflags)
+#define NETIF_CHECKSUM_ENABLED(netif, chksumflag) 1
+#endif /* LWIP_CHECKSUM_CTRL_PER_NETIF */
+
 #if LWIP_NETIF_LINK_CALLBACK
 void netif_set_link_callback(struct netif *netif, netif_status_callback_fn link_callback);
 #endif /* LWIP_NETIF_LINK_CALLBACK */
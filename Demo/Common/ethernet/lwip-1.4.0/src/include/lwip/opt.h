@@ -141,6 +141,24 @@
 #define MEMP_SEPARATE_POOLS             0
 #endif
 
+/**
+ * MEMP_SYS_POOLS==1: Let the port manage the free list of each memp pool.
+ * memp_init() still reserves the memory for every pool, but hands the region
+ * of each pool to sys_mempool_new(), and memp_malloc()/memp_free() call
+ * sys_mempool_alloc()/sys_mempool_free() without taking SYS_ARCH_PROTECT.
+ * The port can then use its RTOS block allocator, a lock per pool or a
+ * lock-free stack (e.g. LDREX/STREX), so allocations from different pools,
+ * threads and interrupts no longer all serialize on the one lightweight
+ * protection. With MEM_USE_POOLS this applies to mem_malloc() too.
+ * The port defines sys_mempool_t in sys_arch.h. Requires NO_SYS==0, and
+ * cannot be combined with MEMP_MEM_MALLOC, MEMP_OVERFLOW_CHECK or
+ * MEMP_SANITY_CHECK. The MEMP_STATS counters are updated unprotected and
+ * so are only approximate.
+ */
+#ifndef MEMP_SYS_POOLS
+#define MEMP_SYS_POOLS                  0
+#endif
+
 /**
  * MEMP_OVERFLOW_CHECK: memp overflow protection reserves a configurable
  * amount of bytes before and after each memp element in every pool and fills
@@ -267,6 +285,15 @@
 #define MEMP_NUM_TCP_SEG                16
 #endif
 
+/**
+ * MEMP_NUM_TCP_TW: the number of connections in TIME-WAIT that are kept in
+ * a compact record instead of a tcp_pcb. Each record is about 40 bytes.
+ * (requires the TCP_COMPACT_TIME_WAIT option)
+ */
+#ifndef MEMP_NUM_TCP_TW
+#define MEMP_NUM_TCP_TW                 (2 * MEMP_NUM_TCP_PCB)
+#endif
+
 /**
  * MEMP_NUM_REASSDATA: the number of IP packets simultaneously queued for
  * reassembly (whole packets, not fragments!)
@@ -431,6 +458,17 @@
 #define ARP_TABLE_SIZE                  10
 #endif
 
+/**
+ * ARP_TABLE_HASH_SIZE: Number of hash chains used to find an IP address in
+ * the ARP cache, so that the cost of a lookup does not grow with
+ * ARP_TABLE_SIZE. Must be 0 or a power of 2; around ARP_TABLE_SIZE / 2 is a
+ * good choice. With 0 every lookup searches the whole table, which is fine
+ * for small tables.
+ */
+#ifndef ARP_TABLE_HASH_SIZE
+#define ARP_TABLE_HASH_SIZE             0
+#endif
+
 /**
  * ARP_QUEUEING==1: Multiple outgoing packets are queued during hardware address
  * resolution. By default, only the most recent packet is queued per IP address.
@@ -489,6 +527,136 @@
 #define ETHARP_SUPPORT_STATIC_ENTRIES   0
 #endif
 
+/** LWIP_PCAPRING==1: Enable the link layer capture ring (netif/pcapring.c).
+ * Drivers call pcapring_record() for each frame sent or received, which
+ * copies the start of the frame into a fixed ring in RAM.  The ring can be
+ * dumped in pcap format over TCP, see pcapring_server_init().
+ */
+#ifndef LWIP_PCAPRING
+#define LWIP_PCAPRING                   0
+#endif
+
+/** PCAPRING_RECORDS: Number of frames kept by the capture ring.
+ */
+#ifndef PCAPRING_RECORDS
+#define PCAPRING_RECORDS                64
+#endif
+
+/** PCAPRING_SNAPLEN: Number of bytes kept from the start of each frame.
+ * 54 bytes covers the ethernet, IP and TCP headers without options.
+ */
+#ifndef PCAPRING_SNAPLEN
+#define PCAPRING_SNAPLEN                64
+#endif
+
+/** PCAPRING_TIME_MS(): Timestamp of captured frames in milliseconds.  This is
+ * called from wherever the driver calls pcapring_record(), so has to be
+ * redefined if that is an interrupt and sys_now() cannot be used there.
+ */
+#ifndef PCAPRING_TIME_MS
+#define PCAPRING_TIME_MS()              sys_now()
+#endif
+
+/** LWIP_DMABUF==1: Enable the pool of DMA frame buffers (netif/dmabuf.c).
+ * Drivers for MACs that move frames by DMA take receive and transmit
+ * buffers from the pool as custom pbufs.  The buffers are aligned to and
+ * padded out to whole cache lines, and only the part of a buffer that holds
+ * a frame has its cache lines invalidated or flushed, so the data cache can
+ * stay enabled.  Needs LWIP_SUPPORT_CUSTOM_PBUF.
+ */
+#ifndef LWIP_DMABUF
+#define LWIP_DMABUF                     0
+#endif
+
+/** DMABUF_COUNT: Number of buffers in the DMA buffer pool.
+ */
+#ifndef DMABUF_COUNT
+#define DMABUF_COUNT                    8
+#endif
+
+/** DMABUF_SIZE: Size of each DMA buffer, rounded up to whole cache lines.
+ */
+#ifndef DMABUF_SIZE
+#define DMABUF_SIZE                     1536
+#endif
+
+/** DMABUF_CACHE_LINE_SIZE: Data cache line size in bytes, a power of two.
+ */
+#ifndef DMABUF_CACHE_LINE_SIZE
+#define DMABUF_CACHE_LINE_SIZE          32
+#endif
+
+/** DMABUF_CACHE_FLUSH(addr, len): Write the data cache lines covering len
+ * bytes at addr back to memory.  Can be called with a range that does not
+ * start or end on a cache line boundary.
+ */
+#ifndef DMABUF_CACHE_FLUSH
+#define DMABUF_CACHE_FLUSH(addr, len)
+#endif
+
+/** DMABUF_CACHE_INVALIDATE(addr, len): Discard the data cache lines covering
+ * len bytes at addr.  Only ever called with whole cache lines.
+ */
+#ifndef DMABUF_CACHE_INVALIDATE
+#define DMABUF_CACHE_INVALIDATE(addr, len)
+#endif
+
+/** DMABUF_DESC_POOL_SIZE: Bytes reserved for DMA descriptors, handed out by
+ * dmabuf_desc_alloc().  0 for no descriptor pool.
+ */
+#ifndef DMABUF_DESC_POOL_SIZE
+#define DMABUF_DESC_POOL_SIZE           0
+#endif
+
+/** DMABUF_DESC_NOCACHE==1: The descriptor pool is in memory that is not
+ * cached, placed there by DMABUF_DESC_SECTION, and dmabuf_desc_flush() and
+ * dmabuf_desc_invalidate() do nothing.
+ */
+#ifndef DMABUF_DESC_NOCACHE
+#define DMABUF_DESC_NOCACHE             0
+#endif
+
+/** DMABUF_DESC_SECTION: Attribute added to the descriptor pool, e.g.
+ * __attribute__((section(".nocache"))) to place it in a region the linker
+ * script maps to memory that is not cached.
+ */
+#ifndef DMABUF_DESC_SECTION
+#define DMABUF_DESC_SECTION
+#endif
+
+/** LWIP_TXQUEUE==1: Enable strict priority transmit queues (netif/txqueue.c).
+ * txqueue_attach() puts TXQUEUE_CLASSES queues in front of the linkoutput
+ * function of a netif.  Frames are classed by VLAN priority or DSCP, and
+ * wait in the queues while the driver returns ERR_WOULDBLOCK because its
+ * transmit ring is full, so control traffic overtakes queued bulk traffic.
+ * Drivers call txqueue_kick() when ring space is freed.
+ */
+#ifndef LWIP_TXQUEUE
+#define LWIP_TXQUEUE                    0
+#endif
+
+/** TXQUEUE_CLASSES: Number of traffic classes, 1 to 8.  The eight VLAN and
+ * IP precedence priorities are spread evenly over them.
+ */
+#ifndef TXQUEUE_CLASSES
+#define TXQUEUE_CLASSES                 4
+#endif
+
+/** TXQUEUE_LEN: Number of frames each class queue holds before frames of
+ * that class are dropped, at most 255.
+ */
+#ifndef TXQUEUE_LEN
+#define TXQUEUE_LEN                     8
+#endif
+
+/** TXQUEUE_DSCP_PRIO(dscp): Priority 0 to 7 of an untagged IP frame with the
+ * given DSCP.  The default uses the class selector (precedence) bits, which
+ * puts EF (46) at 5 and network control (CS6, CS7) at 6 and 7.
+ */
+#ifndef TXQUEUE_DSCP_PRIO
+#define TXQUEUE_DSCP_PRIO(dscp)         ((u8_t)((dscp) >> 3))
+#endif
+
 
 /*
    --------------------------------
@@ -665,6 +833,37 @@
 #define DHCP_DOES_ARP_CHECK             ((LWIP_DHCP) && (LWIP_ARP))
 #endif
 
+/**
+ * LWIP_DHCP_LEASE_CACHE==1: Hand every bound lease to the callback set with
+ * dhcp_set_lease_callback() so that the application can keep it in
+ * non-volatile memory, and add dhcp_start_lease() to start from such a
+ * stored lease. That goes straight to INIT-REBOOT: one broadcast REQUEST for
+ * the old address, bound on the ACK without an ARP check, instead of the
+ * DISCOVER/OFFER/REQUEST/ACK exchange. A NAK falls back to discovery.
+ */
+#ifndef LWIP_DHCP_LEASE_CACHE
+#define LWIP_DHCP_LEASE_CACHE           0
+#endif
+
+/**
+ * LWIP_DHCP_RAPID_COMMIT==1: Send the Rapid Commit option (RFC 4039) in
+ * DHCPDISCOVER and bind to an ACK carrying it, skipping OFFER and REQUEST
+ * with servers that support it. Servers that don't simply send an OFFER.
+ */
+#ifndef LWIP_DHCP_RAPID_COMMIT
+#define LWIP_DHCP_RAPID_COMMIT          0
+#endif
+
+/**
+ * DHCP_RETRY_MSECS: Base of the DHCP retransmission back-off. DISCOVER and
+ * REQUEST are repeated after 2, 4, 8, ... times this, INIT-REBOOT after 1,
+ * 2 times this. Keep it at most 1000; values below DHCP_FINE_TIMER_MSECS
+ * (500 by default, it may also be set in lwipopts.h) are rounded up to it.
+ */
+#ifndef DHCP_RETRY_MSECS
+#define DHCP_RETRY_MSECS                1000
+#endif
+
 /*
    ------------------------------------
    ---------- AUTOIP options ----------
@@ -744,6 +943,36 @@
 #define SNMP_SAFE_REQUESTS              1
 #endif
 
+/**
+ * SNMP_GETBULK==1: Also accept SNMPv2c messages and answer GetBulkRequest
+ * PDUs, walking the MIB once for all the repetitions a request asks for.
+ * v2c requests use the v1 error codes, except that GetNext and GetBulk
+ * report the end of the MIB with endOfMibView. GetBulk stops at an
+ * external MIB node. Each varbind of a response takes an element from
+ * MEMP_NUM_SNMP_VARBIND and one or two from MEMP_NUM_SNMP_VALUE, so size
+ * those pools for SNMP_GETBULK_MAX_VARBINDS.
+ */
+#ifndef SNMP_GETBULK
+#define SNMP_GETBULK                    0
+#endif
+
+/**
+ * SNMP_GETBULK_MAX_VARBINDS: The maximum number of varbinds returned in
+ * one GetBulk response, whatever max-repetitions asks for (at most 255).
+ */
+#ifndef SNMP_GETBULK_MAX_VARBINDS
+#define SNMP_GETBULK_MAX_VARBINDS       16
+#endif
+
+/**
+ * SNMP_GETBULK_MAX_RESPONSE: The maximum length of an encoded GetBulk
+ * response. Varbinds are dropped from the end of a response that would be
+ * longer, as RFC 3416 asks, instead of returning tooBig.
+ */
+#ifndef SNMP_GETBULK_MAX_RESPONSE
+#define SNMP_GETBULK_MAX_RESPONSE       1472
+#endif
+
 /**
  * The maximum length of strings used. This affects the size of
  * MEMP_SNMP_VALUE elements.
@@ -819,6 +1048,28 @@
 #define DNS_MSG_SIZE                    512
 #endif
 
+/** DNS maximum number of callers waiting for an answer at the same time.
+ *  Callers asking for a name that is already being queried share that query. */
+#ifndef DNS_MAX_REQUESTS
+#define DNS_MAX_REQUESTS                DNS_TABLE_SIZE
+#endif
+
+/** DNS_NEGATIVE_TTL: Maximum time (in seconds) a name that does not exist, or
+ *  has no address, is remembered (RFC 2308). The SOA record of the answer may
+ *  shorten it. While remembered, dns_gethostbyname() fails at once with
+ *  ERR_VAL instead of asking again. 0 disables negative caching. */
+#ifndef DNS_NEGATIVE_TTL
+#define DNS_NEGATIVE_TTL                0
+#endif
+
+/** DNS_PREFETCH_SECS: Ask again for a name that was looked up since it was
+ *  resolved when its TTL gets down to this many seconds, so that it is
+ *  renewed before it expires and callers keep getting the answer from the
+ *  table. 0 disables prefetching. */
+#ifndef DNS_PREFETCH_SECS
+#define DNS_PREFETCH_SECS               0
+#endif
+
 /** DNS_LOCAL_HOSTLIST: Implements a local host-to-address list. If enabled,
  *  you have to define
  *    #define DNS_LOCAL_HOSTLIST_INIT {{"host1", 0x123}, {"host2", 0x234}}
@@ -872,6 +1123,17 @@
 #define LWIP_NETBUF_RECVINFO            0
 #endif
 
+/**
+ * LWIP_UDP_FLOW==1: Enable udp_flow_connect() and udp_flow_send(). A flow
+ * caches the netif, next hop Ethernet address and headers of a connected
+ * pcb, so each datagram sent through it only needs its lengths, IP ID and
+ * checksums patching before it goes to netif->linkoutput. Only Ethernet
+ * netifs are supported. (Requires LWIP_UDP and LWIP_ARP)
+ */
+#ifndef LWIP_UDP_FLOW
+#define LWIP_UDP_FLOW                   0
+#endif
+
 /*
    ---------------------------------
    ---------- TCP options ----------
@@ -899,6 +1161,69 @@
 #define TCP_WND                         (4 * TCP_MSS)
 #endif 
 
+/**
+ * LWIP_WND_SCALE and TCP_RCV_SCALE:
+ * Set LWIP_WND_SCALE to 1 to enable window scaling (RFC 1323), so windows
+ * larger than 64KB can be used in both directions.
+ * Set TCP_RCV_SCALE to the scale factor announced for the receive window
+ * (shift count in the range of [0..14]). TCP_WND may then be up to
+ * (0xffff << TCP_RCV_SCALE). With TCP_RCV_SCALE 0 only the send window
+ * benefits.
+ */
+#ifndef LWIP_WND_SCALE
+#define LWIP_WND_SCALE                  0
+#endif
+
+#ifndef TCP_RCV_SCALE
+#define TCP_RCV_SCALE                   0
+#endif
+
+/**
+ * TCP_WND_AUTOTUNE==1: Start each connection with a receive window of
+ * TCP_WND_AUTOTUNE_MIN and double it, up to TCP_WND, each round trip in
+ * which the sender filled the whole window, as long as PBUF_POOL has free
+ * buffers for the extra data. TCP_WND then only sets the upper limit, so it
+ * can be large without every connection tying up that much memory.
+ */
+#ifndef TCP_WND_AUTOTUNE
+#define TCP_WND_AUTOTUNE                0
+#endif
+
+/**
+ * TCP_WND_AUTOTUNE_MIN: The receive window a connection starts with when
+ * TCP_WND_AUTOTUNE is enabled.
+ */
+#ifndef TCP_WND_AUTOTUNE_MIN
+#define TCP_WND_AUTOTUNE_MIN            (4 * TCP_MSS)
+#endif
+
+/**
+ * LWIP_TCP_SACK==1: Negotiate selective acknowledgements (RFC 2018).
+ * Out-of-sequence data held on the ooseq queue is reported to the remote
+ * end in SACK blocks, and SACK blocks that arrive are used to retransmit
+ * only the segments that were really lost instead of the whole window.
+ */
+#ifndef LWIP_TCP_SACK
+#define LWIP_TCP_SACK                   0
+#endif
+
+/**
+ * LWIP_TCP_MAX_SACK_NUM: The maximum number of SACK blocks sent in an ACK
+ * (1..4). Only 3 fit together with the timestamp option.
+ */
+#ifndef LWIP_TCP_MAX_SACK_NUM
+#define LWIP_TCP_MAX_SACK_NUM           4
+#endif
+
+/**
+ * LWIP_TCP_NEWRENO==1: Stay in fast recovery on partial ACKs and resend the
+ * next unacknowledged segment at once (RFC 6582), so several segments lost
+ * from one window do not each cost a retransmission timeout.
+ */
+#ifndef LWIP_TCP_NEWRENO
+#define LWIP_TCP_NEWRENO                1
+#endif
+
 /**
  * TCP_MAXRTX: Maximum number of retransmissions of data segments.
  */
@@ -1019,6 +1344,104 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * TCP_PCB_HASH_SIZE: Number of hash chains used to find the pcb an incoming
+ * segment belongs to. Connected and TIME-WAIT pcbs are hashed on their
+ * address/port four-tuple, listening pcbs on their local port, so that the
+ * cost of demultiplexing does not grow with the number of connections. Must
+ * be 0 or a power of 2; around MEMP_NUM_TCP_PCB / 2 is a good choice. With 0
+ * every segment searches the pcb lists, which is fine for a few connections.
+ */
+#ifndef TCP_PCB_HASH_SIZE
+#define TCP_PCB_HASH_SIZE               0
+#endif
+
+/**
+ * LWIP_TCP_TIMER_SLEEP==1: Stop calling tcp_tmr() every TCP_TMR_INTERVAL
+ * while no pcb has a retransmission, delayed ACK or other short timer
+ * pending. The TCP timeout is then rescheduled for the first keepalive,
+ * poll or state timeout that is due, capped at TCP_TMR_MAX_SLEEP, so idle
+ * connections do not keep waking up the stack. Needs LWIP_TIMERS.
+ */
+#ifndef LWIP_TCP_TIMER_SLEEP
+#define LWIP_TCP_TIMER_SLEEP            0
+#endif
+
+/**
+ * TCP_TMR_MAX_SLEEP: Longest time in milliseconds the TCP timer sleeps for
+ * when LWIP_TCP_TIMER_SLEEP is enabled. Options changed on an idle pcb
+ * (e.g. keepalive) take effect after at most this time.
+ */
+#ifndef TCP_TMR_MAX_SLEEP
+#define TCP_TMR_MAX_SLEEP               60000
+#endif
+
+/**
+ * LWIP_TCP_WRITE_REF==1: Enable tcp_write_ref() and netconn_write_ref(),
+ * which send from an application buffer without copying it and call back
+ * once the stack no longer references the buffer (all its data has been
+ * acknowledged, or the connection has been closed or aborted).
+ */
+#ifndef LWIP_TCP_WRITE_REF
+#define LWIP_TCP_WRITE_REF              0
+#endif
+
+/**
+ * TCP_RX_COALESCE==1: Hold back in-order data received for a connection and
+ * pass everything that arrived in one input batch to the application with a
+ * single recv callback (one mailbox post for netconn/sockets), then make one
+ * ACK decision for it. The tcpip thread ends a batch when its mailbox runs
+ * dry. With NO_SYS==1 or LWIP_TCPIP_CORE_LOCKING_INPUT, the driver calls
+ * tcp_rx_flush() after each poll loop (tcp_fasttmr() also flushes, as a
+ * fallback). FIN, RST and the TCP_RX_COALESCE_MAX limit end the batch early.
+ */
+#ifndef TCP_RX_COALESCE
+#define TCP_RX_COALESCE                 0
+#endif
+
+/**
+ * TCP_RX_COALESCE_MAX: Number of bytes held for a connection with
+ * TCP_RX_COALESCE, which are then passed up at once. Must be below 0xffff.
+ */
+#ifndef TCP_RX_COALESCE_MAX
+#define TCP_RX_COALESCE_MAX             (4 * TCP_MSS)
+#endif
+
+/**
+ * TCP_RX_COALESCE_BATCH: Number of messages the tcpip thread takes from its
+ * mailbox without waiting while TCP data is held, so that a steady stream of
+ * packets cannot keep held data and timeouts waiting.
+ */
+#ifndef TCP_RX_COALESCE_BATCH
+#define TCP_RX_COALESCE_BATCH           16
+#endif
+
+/**
+ * TCP_STRETCH_ACK==1: Send an ACK straight away only after every
+ * netif->tcp_ack_segs in-order segments received over that netif (2 by
+ * default, as without this option), or once the peer has used up half of
+ * the window offered to it; the delayed ACK timer acknowledges the rest.
+ * On narrow links (e.g. PPP over slow serial or radio, see PPP_TCP_ACK_SEGS)
+ * fewer ACKs leave more of the link to the data.
+ */
+#ifndef TCP_STRETCH_ACK
+#define TCP_STRETCH_ACK                 0
+#endif
+
+/**
+ * TCP_COMPACT_TIME_WAIT==1: Once the application has closed a connection
+ * that reaches TIME-WAIT, free its tcp_pcb and keep only the four-tuple,
+ * sequence numbers and timer in a record from the MEMP_NUM_TCP_TW pool.
+ * The records answer segments like a TIME-WAIT pcb does and keep the port
+ * in use for 2 * TCP_MSL, so a server closing many short connections does
+ * not run out of pcbs (or kill TIME-WAIT pcbs early) with a small
+ * MEMP_NUM_TCP_PCB. If the pool is empty, the oldest record is reused.
+ * Connections using LWIP_TCP_TIMESTAMPS keep their pcb.
+ */
+#ifndef TCP_COMPACT_TIME_WAIT
+#define TCP_COMPACT_TIME_WAIT           0
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
@@ -1066,6 +1489,58 @@
 #define PBUF_POOL_BUFSIZE               LWIP_MEM_ALIGN_SIZE(TCP_MSS+40+PBUF_LINK_HLEN)
 #endif
 
+/**
+ * PBUF_POOL_CLASSES==1: Hold back the last buffers of PBUF_POOL for the
+ * received frames that keep the system reachable, so a burst of bulk traffic
+ * cannot take every buffer and starve ARP, ping or a management connection.
+ * The network driver classifies each frame with pbuf_rx_class() before it is
+ * copied and allocates it with pbuf_alloc_class(), which fails (and counts a
+ * drop for the class in pbuf_class_drops[]) if taking the buffers would eat
+ * into a reserve the class may not use. Other users of PBUF_POOL are not
+ * restricted. Requires MEMP_MEM_MALLOC==0.
+ */
+#ifndef PBUF_POOL_CLASSES
+#define PBUF_POOL_CLASSES               0
+#endif
+
+/**
+ * PBUF_POOL_RESERVE_CONTROL: the number of PBUF_POOL buffers that only
+ * PBUF_CLASS_CONTROL frames (ARP, ICMP and IGMP) may use.
+ */
+#ifndef PBUF_POOL_RESERVE_CONTROL
+#define PBUF_POOL_RESERVE_CONTROL       2
+#endif
+
+/**
+ * PBUF_POOL_RESERVE_HIGH: the number of further PBUF_POOL buffers that
+ * PBUF_CLASS_HIGH frames may use but PBUF_CLASS_BULK frames may not. Bulk
+ * frames are refused while fewer than
+ * PBUF_POOL_RESERVE_HIGH + PBUF_POOL_RESERVE_CONTROL buffers would be left.
+ */
+#ifndef PBUF_POOL_RESERVE_HIGH
+#define PBUF_POOL_RESERVE_HIGH          2
+#endif
+
+/**
+ * PBUF_CLASS_HIGH_DSCP: IPv4 packets with a DSCP at or above this value are
+ * PBUF_CLASS_HIGH. The default of 46 takes Expedited Forwarding and the
+ * network control class selectors (48 and 56).
+ */
+#ifndef PBUF_CLASS_HIGH_DSCP
+#define PBUF_CLASS_HIGH_DSCP            46
+#endif
+
+/**
+ * PBUF_CLASS_HIGH_PORT(port): true for a TCP or UDP port (in host byte
+ * order) whose traffic is PBUF_CLASS_HIGH, whichever end of the connection
+ * it is on, e.g. a management or telemetry service. TCP segments that carry
+ * no data (connection setup and teardown, and acknowledgements) are
+ * PBUF_CLASS_HIGH regardless.
+ */
+#ifndef PBUF_CLASS_HIGH_PORT
+#define PBUF_CLASS_HIGH_PORT(port)      0
+#endif
+
 /*
    ------------------------------------------------
    ---------- Network Interfaces options ----------
@@ -1222,6 +1697,36 @@
 #define TCPIP_MBOX_SIZE                 0
 #endif
 
+/**
+ * NETIF_RX_THREAD_STACKSIZE: The stack size used by each netif receive
+ * thread (LWIP_NETIF_RX_TASK). It needs about the same as the tcpip thread,
+ * as it runs the same input code.
+ * The stack size value itself is platform-dependent, but is passed to
+ * sys_thread_new() when the thread is created.
+ */
+#ifndef NETIF_RX_THREAD_STACKSIZE
+#define NETIF_RX_THREAD_STACKSIZE       TCPIP_THREAD_STACKSIZE
+#endif
+
+/**
+ * NETIF_RX_MBOX_SIZE: The mailbox size for the frames queued to each netif
+ * receive thread. Frames received while it is full are dropped by the driver.
+ * The queue size value itself is platform-dependent, but is passed to
+ * sys_mbox_new() when tcpip_rx_start is called.
+ */
+#ifndef NETIF_RX_MBOX_SIZE
+#define NETIF_RX_MBOX_SIZE              TCPIP_MBOX_SIZE
+#endif
+
+/**
+ * NETIF_RX_BATCH: The number of queued frames a netif receive thread passes
+ * to the stack for each time it takes the core lock. More saves locking but
+ * keeps other threads out of the core for longer.
+ */
+#ifndef NETIF_RX_BATCH
+#define NETIF_RX_BATCH                  8
+#endif
+
 /**
  * SLIPIF_THREAD_NAME: The name assigned to the slipif_loop thread.
  */
@@ -1354,6 +1859,20 @@
 #define LWIP_TCPIP_CORE_LOCKING_INPUT   0
 #endif
 
+/**
+ * LWIP_NETIF_RX_TASK==1: Enable tcpip_rx_start() and tcpip_rx_input(),
+ * which give a netif its own receive task. Passing tcpip_rx_input to
+ * netif_add() instead of tcpip_input makes the driver post received frames
+ * to the netif's task, which runs ethernet_input()/ip_input() itself while
+ * holding the core lock, at the priority given for that netif. Frames then
+ * skip the tcpip_thread mailbox, and a busy link cannot hold up frames from
+ * another. Requires LWIP_TCPIP_CORE_LOCKING (which also provides
+ * tcpip_input_direct() for drivers that already receive in a task).
+ */
+#ifndef LWIP_NETIF_RX_TASK
+#define LWIP_NETIF_RX_TASK              0
+#endif
+
 /**
  * LWIP_NETCONN==1: Enable Netconn API (require to use api_lib.c)
  */
@@ -1397,6 +1916,16 @@
 #define LWIP_POSIX_SOCKETS_IO_NAMES     1
 #endif
 
+/**
+ * LWIP_SOCKET_EVENTS==1: Enable lwip_evwatch() and lwip_evwait(), which let
+ * one thread register interest in many sockets once and then receive their
+ * readiness events through a single mbox, instead of calling select() with
+ * a semaphore per call. (only used if you use sockets.c)
+ */
+#ifndef LWIP_SOCKET_EVENTS
+#define LWIP_SOCKET_EVENTS              0
+#endif
+
 /**
  * LWIP_TCP_KEEPALIVE==1: Enable TCP_KEEPIDLE, TCP_KEEPINTVL and TCP_KEEPCNT
  * options processing. Note that TCP_KEEPIDLE and TCP_KEEPINTVL have to be set
@@ -1637,6 +2166,24 @@
 #define VJ_SUPPORT                      0
 #endif
 
+/**
+ * PPPOS_FAST_HDLC==1: Escape, unescape and check the FCS of PPP over serial
+ * frames a run of octets at a time instead of one octet at a time. The runs
+ * between octets that the ACCM marks are found a word at a time, and the FCS
+ * is updated two octets per step using a second 512 byte table.
+ */
+#ifndef PPPOS_FAST_HDLC
+#define PPPOS_FAST_HDLC                 0
+#endif
+
+/**
+ * PPP_TCP_ACK_SEGS: netif->tcp_ack_segs of PPP interfaces when
+ * TCP_STRETCH_ACK is enabled.
+ */
+#ifndef PPP_TCP_ACK_SEGS
+#define PPP_TCP_ACK_SEGS                4
+#endif
+
 /**
  * MD5_SUPPORT==1: Support MD5 (see also CHAP).
  */
@@ -1779,6 +2326,17 @@
 #define LWIP_CHECKSUM_ON_COPY           0
 #endif
 
+/**
+ * LWIP_CHECKSUM_CTRL_PER_NETIF==1: Checksum generation and checking can be
+ * turned off for each netif (see NETIF_SET_CHECKSUM_CTRL()), so netifs whose
+ * hardware generates and checks checksums do not have them done in software
+ * as well.  The CHECKSUM_GEN_x and CHECKSUM_CHECK_x options still apply to
+ * all netifs.
+ */
+#ifndef LWIP_CHECKSUM_CTRL_PER_NETIF
+#define LWIP_CHECKSUM_CTRL_PER_NETIF    0
+#endif
+
 /*
    ---------------------------------------
    ---------- Debugging options ----------
@@ -40,9 +40,12 @@
 extern "C" {
 #endif
 
-/** Currently, the pbuf_custom code is only needed for one specific configuration
- * of IP_FRAG */
+/** The pbuf_custom code is needed for one specific configuration of IP_FRAG,
+ * and by netif drivers that pass their own receive buffers to the stack
+ * (define LWIP_SUPPORT_CUSTOM_PBUF to 1 in lwipopts.h for those) */
+#ifndef LWIP_SUPPORT_CUSTOM_PBUF
 #define LWIP_SUPPORT_CUSTOM_PBUF (IP_FRAG && !IP_FRAG_USES_STATIC_BUF && !LWIP_NETIF_TX_SINGLE_PBUF)
+#endif
 
 #define PBUF_TRANSPORT_HLEN 20
 #define PBUF_IP_HLEN        20
@@ -61,6 +64,16 @@ typedef enum {
   PBUF_POOL /* pbuf payload refers to RAM */
 } pbuf_type;
 
+#if PBUF_POOL_CLASSES
+/** Classes of received frames for pbuf_alloc_class(). A class may use the
+ * reserves of the classes below it (see PBUF_POOL_RESERVE_HIGH and
+ * PBUF_POOL_RESERVE_CONTROL). */
+#define PBUF_CLASS_BULK     0
+#define PBUF_CLASS_HIGH     1
+#define PBUF_CLASS_CONTROL  2
+#define PBUF_NUM_CLASSES    3
+#endif /* PBUF_POOL_CLASSES */
+
 
 /** indicates this packet's data should be immediately passed to the application */
 #define PBUF_FLAG_PUSH      0x01U
@@ -125,6 +138,12 @@ struct pbuf *pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type,
                                  struct pbuf_custom *p, void *payload_mem,
                                  u16_t payload_mem_len);
 #endif /* LWIP_SUPPORT_CUSTOM_PBUF */
+#if PBUF_POOL_CLASSES
+u8_t pbuf_rx_class(const void *frame, u16_t len);
+struct pbuf *pbuf_alloc_class(pbuf_layer l, u16_t length, u8_t pclass);
+/** The number of frames of each class refused by pbuf_alloc_class() */
+extern u32_t pbuf_class_drops[PBUF_NUM_CLASSES];
+#endif /* PBUF_POOL_CLASSES */
 void pbuf_realloc(struct pbuf *p, u16_t size); 
 u8_t pbuf_header(struct pbuf *p, s16_t header_size);
 void pbuf_ref(struct pbuf *p);
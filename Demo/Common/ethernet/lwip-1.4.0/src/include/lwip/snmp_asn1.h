@@ -73,6 +73,10 @@ extern "C" {
 #define SNMP_ASN1_PDU_GET_RESP 2
 #define SNMP_ASN1_PDU_SET_REQ 3
 #define SNMP_ASN1_PDU_TRAP 4
+#define SNMP_ASN1_PDU_GET_BULK_REQ 5
+
+/* context specific (SNMPv2) exception values */
+#define SNMP_ASN1_END_OF_MIB_VIEW 2
 
 err_t snmp_asn1_dec_type(struct pbuf *p, u16_t ofs, u8_t *type);
 err_t snmp_asn1_dec_length(struct pbuf *p, u16_t ofs, u8_t *octets_used, u16_t *length);
@@ -64,6 +64,9 @@ extern "C" {
 #define SNMP_TRAP_PORT 162
 #endif
 
+#define SNMP_VERSION_1 0
+#define SNMP_VERSION_2c 1
+
 #define SNMP_ES_NOERROR 0
 #define SNMP_ES_TOOBIG 1
 #define SNMP_ES_NOSUCHNAME 2
@@ -228,12 +231,20 @@ struct snmp_msg_pstat
   u16_t sp;
   /* request type */
   u8_t rt;
+  /* request message version, echoed in the response */
+  s32_t version;
   /* request ID */
   s32_t rid;
   /* error status */
   s32_t error_status;
   /* error index */
   s32_t error_index;
+#if SNMP_GETBULK
+  /* GetBulk non-repeaters (sent in the error-status field) */
+  s32_t non_repeaters;
+  /* GetBulk max-repetitions (sent in the error-index field) */
+  s32_t max_repetitions;
+#endif /* SNMP_GETBULK */
   /* community name (zero terminated) */
   u8_t community[SNMP_COMMUNITY_STR_LEN + 1];
   /* community string length (exclusive zero term) */
@@ -280,7 +291,7 @@ struct snmp_msg_trap
   struct snmp_trap_header_lengths thl;
 };
 
-/** Agent Version constant, 0 = v1 oddity */
+/** Agent Version constant, 0 = v1 oddity (used for traps) */
 extern const s32_t snmp_version;
 /** Agent default "public" community string */
 extern const char snmp_publiccommunity[7];
@@ -185,6 +185,8 @@ struct mib_list_rootnode
   struct mib_list_node *tail;
   /* counts list nodes in list  */
   u16_t count;
+  /* node found by the last lookup, where in-order walks resume */
+  struct mib_list_node *cursor;
 };
 
 /** derived node, has access functions for mib object in external memory or device
@@ -42,6 +42,9 @@
 
 #include "lwip/ip_addr.h"
 #include "lwip/inet.h"
+#if LWIP_SOCKET_EVENTS
+#include "lwip/sys.h"
+#endif /* LWIP_SOCKET_EVENTS */
 
 #ifdef __cplusplus
 extern "C" {
@@ -340,6 +343,16 @@ int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptse
 int lwip_ioctl(int s, long cmd, void *argp);
 int lwip_fcntl(int s, int cmd, int val);
 
+#if LWIP_SOCKET_EVENTS
+/* Events for lwip_evwatch() and lwip_evwait() */
+#define LWIP_EVT_READ   0x01
+#define LWIP_EVT_WRITE  0x02
+#define LWIP_EVT_ERROR  0x04
+
+int lwip_evwatch(int s, sys_mbox_t *mbox, u8_t events);
+int lwip_evwait(sys_mbox_t *mbox, u32_t timeout, u8_t *events);
+#endif /* LWIP_SOCKET_EVENTS */
+
 #if LWIP_COMPAT_SOCKETS
 #define accept(a,b,c)         lwip_accept(a,b,c)
 #define bind(a,b,c)           lwip_bind(a,b,c)
@@ -217,6 +217,28 @@ void sys_mbox_set_invalid(sys_mbox_t *mbox);
  * @param prio priority of the new thread (may be ignored by ports) */
 sys_thread_t sys_thread_new(const char *name, lwip_thread_fn thread, void *arg, int stacksize, int prio);
 
+#if MEMP_SYS_POOLS
+/** Create a pool for memp.c (see MEMP_SYS_POOLS)
+ * @param pool pointer to the pool to create
+ * @param base start of the region the elements are carved from, aligned to
+ *        MEM_ALIGNMENT and owned by the pool from now on
+ * @param num number of elements (may be 0)
+ * @param size size of each element in bytes, a multiple of MEM_ALIGNMENT
+ * @return ERR_OK if all num elements could be made available */
+err_t sys_mempool_new(sys_mempool_t *pool, void *base, u16_t num, u16_t size);
+/** Take an element from a pool. Must be callable from any thread (and from
+ * interrupts if the port lets lwIP free or allocate pbufs there).
+ * @param pool the pool to take an element from
+ * @return the element or NULL if the pool is empty */
+void *sys_mempool_alloc(sys_mempool_t *pool);
+/** Return an element to the pool it was taken from
+ * @param pool the pool the element belongs to
+ * @param mem the element */
+void sys_mempool_free(sys_mempool_t *pool, void *mem);
+/** Return the number of free elements in a pool */
+u16_t sys_mempool_num_free(sys_mempool_t *pool);
+#endif /* MEMP_SYS_POOLS */
+
 #endif /* NO_SYS */
 
 /* sys_init() must be called before anthing else. */
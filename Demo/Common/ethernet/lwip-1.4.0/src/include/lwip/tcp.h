@@ -124,6 +124,17 @@ typedef void  (*tcp_err_fn)(void *arg, err_t err);
  */
 typedef err_t (*tcp_connected_fn)(void *arg, struct tcp_pcb *tpcb, err_t err);
 
+#if LWIP_TCP_WRITE_REF
+/** Function prototype for the completion callback of tcp_write_ref(). Called
+ * from within the stack once the data is no longer referenced: it has been
+ * acknowledged, or the connection has been closed or aborted. Must not call
+ * any tcp function for the pcb the data was written to.
+ *
+ * @param arg Argument passed to tcp_write_ref()
+ */
+typedef void  (*tcp_write_done_fn)(void *arg);
+#endif /* LWIP_TCP_WRITE_REF */
+
 enum tcp_state {
   CLOSED      = 0,
   LISTEN      = 1,
@@ -151,11 +162,34 @@ enum tcp_state {
 #define DEF_ACCEPT_CALLBACK
 #endif /* LWIP_CALLBACK_API */
 
+#if LWIP_WND_SCALE
+/** Window sizes no longer fit in 16 bits once they can be scaled. */
+typedef u32_t tcpwnd_size_t;
+#define TCPWNDSIZE_F U32_F
+#else /* LWIP_WND_SCALE */
+typedef u16_t tcpwnd_size_t;
+#define TCPWNDSIZE_F U16_F
+#endif /* LWIP_WND_SCALE */
+
+#if LWIP_WND_SCALE || LWIP_TCP_SACK
+/** The optional TCP extensions need more than 8 flag bits. */
+typedef u16_t tcpflags_t;
+#else /* LWIP_WND_SCALE || LWIP_TCP_SACK */
+typedef u8_t tcpflags_t;
+#endif /* LWIP_WND_SCALE || LWIP_TCP_SACK */
+
+#if TCP_PCB_HASH_SIZE
+#define DEF_HASH_NEXT(type)  type *hash_next; /* next pcb on the same hash chain */
+#else /* TCP_PCB_HASH_SIZE */
+#define DEF_HASH_NEXT(type)
+#endif /* TCP_PCB_HASH_SIZE */
+
 /**
  * members common to struct tcp_pcb and struct tcp_listen_pcb
  */
 #define TCP_PCB_COMMON(type) \
   type *next; /* for the linked list */ \
+  DEF_HASH_NEXT(type) \
   enum tcp_state state; /* TCP state */ \
   u8_t prio; \
   void *callback_arg; \
@@ -175,7 +209,7 @@ struct tcp_pcb {
   /* ports are in host byte order */
   u16_t remote_port;
   
-  u8_t flags;
+  tcpflags_t flags;
 #define TF_ACK_DELAY   ((u8_t)0x01U)   /* Delayed ACK. */
 #define TF_ACK_NOW     ((u8_t)0x02U)   /* Immediate ACK. */
 #define TF_INFR        ((u8_t)0x04U)   /* In fast recovery. */
@@ -184,14 +218,28 @@ struct tcp_pcb {
 #define TF_FIN         ((u8_t)0x20U)   /* Connection was closed locally (FIN segment enqueued). */
 #define TF_NODELAY     ((u8_t)0x40U)   /* Disable Nagle algorithm */
 #define TF_NAGLEMEMERR ((u8_t)0x80U)   /* nagle enabled, memerr, try to output to prevent delayed ACK to happen */
+#if LWIP_WND_SCALE
+#define TF_WND_SCALE   ((tcpflags_t)0x0100U) /* Window Scale option enabled */
+#endif /* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+#define TF_SACK        ((tcpflags_t)0x0200U) /* Selective acknowledgements enabled */
+#endif /* LWIP_TCP_SACK */
 
   /* the rest of the fields are in host byte order
      as we have to do some math with them */
   /* receiver variables */
   u32_t rcv_nxt;   /* next seqno expected */
-  u16_t rcv_wnd;   /* receiver window available */
-  u16_t rcv_ann_wnd; /* receiver window to announce */
+  tcpwnd_size_t rcv_wnd;   /* receiver window available */
+  tcpwnd_size_t rcv_ann_wnd; /* receiver window to announce */
   u32_t rcv_ann_right_edge; /* announced right edge of window */
+#if TCP_STRETCH_ACK
+  u8_t rcv_unacked;  /* in-order segments received since the last ACK */
+#endif /* TCP_STRETCH_ACK */
+#if TCP_WND_AUTOTUNE
+  tcpwnd_size_t rcv_wnd_max; /* receive window the auto-tuning has grown to */
+  u32_t rcv_tune_seq;  /* rcv_nxt at the start of the measuring interval */
+  u32_t rcv_tune_time; /* tcp_ticks at the start of the measuring interval */
+#endif /* TCP_WND_AUTOTUNE */
 
   /* Timers */
   u32_t tmr;
@@ -213,14 +261,20 @@ struct tcp_pcb {
   /* fast retransmit/recovery */
   u32_t lastack; /* Highest acknowledged seqno. */
   u8_t dupacks;
+#if LWIP_TCP_NEWRENO
+  u32_t recover; /* snd_nxt when fast recovery was entered */
+#endif /* LWIP_TCP_NEWRENO */
+#if LWIP_TCP_SACK
+  u32_t rcv_sack_seq; /* seqno of the most recent out-of-sequence segment */
+#endif /* LWIP_TCP_SACK */
   
   /* congestion avoidance/control variables */
-  u16_t cwnd;  
-  u16_t ssthresh;
+  tcpwnd_size_t cwnd;
+  tcpwnd_size_t ssthresh;
 
   /* sender variables */
   u32_t snd_nxt;   /* next new seqno to be sent */
-  u16_t snd_wnd;   /* sender window */
+  tcpwnd_size_t snd_wnd;   /* sender window */
   u32_t snd_wl1, snd_wl2; /* Sequence and acknowledgement numbers of last
                              window update. */
   u32_t snd_lbb;       /* Sequence number of next byte to be buffered. */
@@ -244,6 +298,19 @@ struct tcp_pcb {
 #endif /* TCP_QUEUE_OOSEQ */
 
   struct pbuf *refused_data; /* Data previously received but not yet taken by upper layer */
+#if TCP_RX_COALESCE
+  struct pbuf *rx_held;     /* In-order data held until the end of the input batch */
+  struct tcp_pcb *rx_next;  /* next pcb on tcp_rx_held_pcbs */
+  u8_t rx_queued;           /* pcb is on tcp_rx_held_pcbs */
+#endif /* TCP_RX_COALESCE */
+#if TCP_COMPACT_TIME_WAIT
+  u8_t app_closed;          /* tcp_close() succeeded: the application has let go of the pcb */
+#endif /* TCP_COMPACT_TIME_WAIT */
+
+#if LWIP_WND_SCALE
+  u8_t snd_scale; /* shift applied to windows received from the remote end */
+  u8_t rcv_scale; /* shift applied to windows announced to the remote end */
+#endif /* LWIP_WND_SCALE */
 
 #if LWIP_CALLBACK_API
   /* Function to be called when more send buffer space is available. */
@@ -355,6 +422,10 @@ err_t            tcp_shutdown(struct tcp_pcb *pcb, int shut_rx, int shut_tx);
 
 err_t            tcp_write   (struct tcp_pcb *pcb, const void *dataptr, u16_t len,
                               u8_t apiflags);
+#if LWIP_TCP_WRITE_REF
+err_t            tcp_write_ref(struct tcp_pcb *pcb, const void *dataptr, u16_t len,
+                              u8_t apiflags, tcp_write_done_fn done, void *done_arg);
+#endif /* LWIP_TCP_WRITE_REF */
 
 void             tcp_setprio (struct tcp_pcb *pcb, u8_t prio);
 
@@ -364,6 +435,13 @@ void             tcp_setprio (struct tcp_pcb *pcb, u8_t prio);
 
 err_t            tcp_output  (struct tcp_pcb *pcb);
 
+#if TCP_RX_COALESCE
+/* pcbs with received data held for tcp_rx_flush() */
+extern struct tcp_pcb *tcp_rx_held_pcbs;
+#define          tcp_rx_pending() (tcp_rx_held_pcbs != NULL)
+void             tcp_rx_flush(void);
+#endif /* TCP_RX_COALESCE */
+
 
 const char* tcp_debug_state_str(enum tcp_state s);
 
@@ -70,6 +70,9 @@ err_t            tcp_send_empty_ack(struct tcp_pcb *pcb);
 void             tcp_rexmit  (struct tcp_pcb *pcb);
 void             tcp_rexmit_rto  (struct tcp_pcb *pcb);
 void             tcp_rexmit_fast (struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+void             tcp_rexmit_sack (struct tcp_pcb *pcb);
+#endif /* LWIP_TCP_SACK */
 u32_t            tcp_update_rcv_ann_wnd(struct tcp_pcb *pcb);
 
 /**
@@ -180,7 +183,7 @@ PACK_STRUCT_END
 #define TCPH_HDRLEN_FLAGS_SET(phdr, len, flags) (phdr)->_hdrlen_rsvd_flags = htons(((len) << 12) | (flags))
 
 #define TCPH_SET_FLAG(phdr, flags ) (phdr)->_hdrlen_rsvd_flags = ((phdr)->_hdrlen_rsvd_flags | htons(flags))
-#define TCPH_UNSET_FLAG(phdr, flags) (phdr)->_hdrlen_rsvd_flags = htons(ntohs((phdr)->_hdrlen_rsvd_flags) | (TCPH_FLAGS(phdr) & ~(flags)) )
+#define TCPH_UNSET_FLAG(phdr, flags) (phdr)->_hdrlen_rsvd_flags = ((phdr)->_hdrlen_rsvd_flags & ~htons(flags))
 
 #define TCP_TCPLEN(seg) ((seg)->len + ((TCPH_FLAGS((seg)->tcphdr) & (TCP_FIN | TCP_SYN)) != 0))
 
@@ -293,12 +296,28 @@ struct tcp_seg {
 #define TF_SEG_OPTS_TS          (u8_t)0x02U /* Include timestamp option. */
 #define TF_SEG_DATA_CHECKSUMMED (u8_t)0x04U /* ALL data (not the header) is
                                                checksummed into 'chksum' */
+#define TF_SEG_OPTS_WND_SCALE   (u8_t)0x08U /* Include window scale option. */
+#define TF_SEG_OPTS_SACK_PERM   (u8_t)0x10U /* Include SACK permitted option. */
+#define TF_SEG_SACKED           (u8_t)0x20U /* Remote end has selectively
+                                               acknowledged this segment */
+#define TF_SEG_REXMITTED        (u8_t)0x40U /* Resent in the current fast
+                                               recovery */
   struct tcp_hdr *tcphdr;  /* the TCP header */
+#if LWIP_TCP_WRITE_REF
+  tcp_write_done_fn done;  /* called when the segment is freed (set on the
+                              last segment of a tcp_write_ref() only) */
+  void *done_arg;
+#endif /* LWIP_TCP_WRITE_REF */
 };
 
 #define LWIP_TCP_OPT_LENGTH(flags)              \
   (flags & TF_SEG_OPTS_MSS ? 4  : 0) +          \
-  (flags & TF_SEG_OPTS_TS  ? 12 : 0)
+  (flags & TF_SEG_OPTS_TS  ? 12 : 0) +          \
+  (flags & TF_SEG_OPTS_WND_SCALE ? 4 : 0) +     \
+  (flags & TF_SEG_OPTS_SACK_PERM ? 4 : 0)
+
+/** Length of a SACK option carrying n blocks (including 2 NOPs for alignment) */
+#define LWIP_TCP_SACK_OPT_LENGTH(n)  (4 + 8 * (n))
 
 /** This returns a TCP header option for MSS in an u32_t */
 #define TCP_BUILD_MSS_OPTION(x) (x) = PP_HTONL(((u32_t)2 << 24) |          \
@@ -306,6 +325,43 @@ struct tcp_seg {
                                                (((u32_t)TCP_MSS / 256) << 8) | \
                                                (TCP_MSS & 255))
 
+/** This returns a TCP header option for window scaling (preceded by a NOP so
+    the options stay 32-bit aligned) in an u32_t */
+#define TCP_BUILD_WND_SCALE_OPTION(x) (x) = PP_HTONL(((u32_t)1 << 24) |    \
+                                                     ((u32_t)3 << 16) |    \
+                                                     ((u32_t)3 << 8) |     \
+                                                     ((u32_t)TCP_RCV_SCALE))
+
+/** This returns a TCP header option for SACK permitted (preceded by two NOPs)
+    in an u32_t */
+#define TCP_BUILD_SACK_PERM_OPTION(x) (x) = PP_HTONL(((u32_t)1 << 24) |    \
+                                                     ((u32_t)1 << 16) |    \
+                                                     ((u32_t)4 << 8) |     \
+                                                     ((u32_t)2))
+
+#if LWIP_WND_SCALE
+#define SND_WND_SCALE(pcb, wnd) ((tcpwnd_size_t)(wnd) << (pcb)->snd_scale)
+#define RCV_WND_SCALE(pcb, wnd) ((wnd) >> (pcb)->rcv_scale)
+#define TCPWND16(x)             ((u16_t)LWIP_MIN((x), 0xFFFF))
+/* Largest receive window usable on a pcb: windows above 64KB can only be
+   announced once the remote end has agreed to window scaling. */
+#define TCP_WND_LIMIT(pcb)      ((tcpwnd_size_t)(((pcb)->flags & TF_WND_SCALE) ? TCP_WND : TCPWND16(TCP_WND)))
+#else /* LWIP_WND_SCALE */
+#define SND_WND_SCALE(pcb, wnd) (wnd)
+#define RCV_WND_SCALE(pcb, wnd) (wnd)
+#define TCPWND16(x)             (x)
+#define TCP_WND_LIMIT(pcb)      TCP_WND
+#endif /* LWIP_WND_SCALE */
+
+#if TCP_WND_AUTOTUNE
+/* The receive window a pcb starts with and the one it may currently grow to */
+#define TCP_WND_INIT            TCPWND16(TCP_WND_AUTOTUNE_MIN)
+#define TCP_WND_MAX(pcb)        ((pcb)->rcv_wnd_max)
+#else /* TCP_WND_AUTOTUNE */
+#define TCP_WND_INIT            TCPWND16(TCP_WND)
+#define TCP_WND_MAX(pcb)        TCP_WND_LIMIT(pcb)
+#endif /* TCP_WND_AUTOTUNE */
+
 /* Global variables: */
 extern struct tcp_pcb *tcp_input_pcb;
 extern u32_t tcp_ticks;
@@ -322,6 +378,64 @@ extern struct tcp_pcb *tcp_active_pcbs;  /* List of all TCP PCBs that are in a
               data. */
 extern struct tcp_pcb *tcp_tw_pcbs;      /* List of all TCP PCBs in TIME-WAIT. */
 
+#if TCP_COMPACT_TIME_WAIT
+/** What is left of a connection in TIME-WAIT once tcp_tw_compact() has
+    freed its pcb: enough to answer segments for it and keep it unique. */
+struct tcp_tw {
+  struct tcp_tw *next;
+  ip_addr_t local_ip;
+  ip_addr_t remote_ip;
+  u16_t local_port;
+  u16_t remote_port;
+  u32_t rcv_nxt;
+  u32_t snd_nxt;
+  tcpwnd_size_t rcv_wnd;
+  u16_t ann_wnd;            /* window field of the ACKs sent, already scaled */
+  u8_t ttl;
+  u8_t tos;
+  u32_t tmr;
+};
+extern struct tcp_tw *tcp_tw_records;    /* List of all TIME-WAIT records. */
+#define TCP_TW_RECORDS_PENDING() (tcp_tw_records != NULL)
+
+/* Can tcp_tw_compact() swap this TIME-WAIT pcb for a record? Not while the
+   application may still use it, held data is queued for it or its ACKs
+   have to carry timestamps. */
+#if TCP_RX_COALESCE
+#define TCP_TW_RX_IDLE(pcb) (!(pcb)->rx_queued)
+#else /* TCP_RX_COALESCE */
+#define TCP_TW_RX_IDLE(pcb) 1
+#endif /* TCP_RX_COALESCE */
+#if LWIP_TCP_TIMESTAMPS
+#define TCP_TW_CAN_COMPACT(pcb) ((pcb)->app_closed && TCP_TW_RX_IDLE(pcb) && \
+                                 !((pcb)->flags & TF_TIMESTAMP))
+#else /* LWIP_TCP_TIMESTAMPS */
+#define TCP_TW_CAN_COMPACT(pcb) ((pcb)->app_closed && TCP_TW_RX_IDLE(pcb))
+#endif /* LWIP_TCP_TIMESTAMPS */
+#else /* TCP_COMPACT_TIME_WAIT */
+#define TCP_TW_RECORDS_PENDING() 0
+#endif /* TCP_COMPACT_TIME_WAIT */
+
+#if TCP_PCB_HASH_SIZE
+/* Hash chains over the pcbs in tcp_active_pcbs and tcp_tw_pcbs (keyed on
+   the four-tuple) and in tcp_listen_pcbs (keyed on the local port). They
+   are kept up to date by TCP_REG and TCP_RMV. */
+extern struct tcp_pcb *tcp_conn_hash[TCP_PCB_HASH_SIZE];
+extern struct tcp_pcb_listen *tcp_listen_hash[TCP_PCB_HASH_SIZE];
+
+#define TCP_LISTEN_HASH(port) (((port) ^ ((port) >> 8)) & (TCP_PCB_HASH_SIZE - 1))
+
+u16_t tcp_conn_hash_index(ip_addr_t *local_ip, u16_t local_port,
+                          ip_addr_t *remote_ip, u16_t remote_port);
+void tcp_hash_add(struct tcp_pcb **pcbs, struct tcp_pcb *pcb);
+void tcp_hash_remove(struct tcp_pcb **pcbs, struct tcp_pcb *pcb);
+#define TCP_HASH_ADD(pcbs, npcb) tcp_hash_add((pcbs), (npcb))
+#define TCP_HASH_RMV(pcbs, npcb) tcp_hash_remove((pcbs), (npcb))
+#else /* TCP_PCB_HASH_SIZE */
+#define TCP_HASH_ADD(pcbs, npcb)
+#define TCP_HASH_RMV(pcbs, npcb)
+#endif /* TCP_PCB_HASH_SIZE */
+
 extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
 
 /* Axioms about the above lists:   
@@ -347,6 +461,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                             (npcb)->next = *(pcbs); \
                             LWIP_ASSERT("TCP_REG: npcb->next != npcb", (npcb)->next != (npcb)); \
                             *(pcbs) = (npcb); \
+                            TCP_HASH_ADD(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
               tcp_timer_needed(); \
                             } while(0)
@@ -362,6 +477,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
                                } \
                             } \
                             (npcb)->next = NULL; \
+                            TCP_HASH_RMV(pcbs, npcb); \
                             LWIP_ASSERT("TCP_RMV: tcp_pcbs sane", tcp_pcbs_sane()); \
                             LWIP_DEBUGF(TCP_DEBUG, ("TCP_RMV: removed %p from %p\n", (npcb), *(pcbs))); \
                             } while(0)
@@ -372,6 +488,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
   do {                                             \
     (npcb)->next = *pcbs;                          \
     *(pcbs) = (npcb);                              \
+    TCP_HASH_ADD(pcbs, npcb);                      \
     tcp_timer_needed();                            \
   } while (0)
 
@@ -391,6 +508,7 @@ extern struct tcp_pcb *tcp_tmp_pcb;      /* Only used for temporary storage. */
       }                                            \
     }                                              \
     (npcb)->next = NULL;                           \
+    TCP_HASH_RMV(pcbs, npcb);                      \
   } while(0)
 
 #endif /* LWIP_DEBUG */
@@ -405,6 +523,25 @@ void tcp_segs_free(struct tcp_seg *seg);
 void tcp_seg_free(struct tcp_seg *seg);
 struct tcp_seg *tcp_seg_copy(struct tcp_seg *seg);
 
+#if TCP_STRETCH_ACK
+/* Called for in-order data from tcp_input(), so ip_current_netif() is the
+   netif the segment came in on */
+#define tcp_ack(pcb)                                                  \
+  do {                                                                \
+    if(!((pcb)->flags & TF_ACK_DELAY)) {                              \
+      (pcb)->rcv_unacked = 0;                                         \
+    }                                                                 \
+    if((++(pcb)->rcv_unacked >= ip_current_netif()->tcp_ack_segs) ||  \
+       ((u32_t)((pcb)->rcv_ann_right_edge - (pcb)->rcv_nxt) <         \
+        (u32_t)(TCP_WND_MAX(pcb) >> 1))) {                            \
+      (pcb)->flags &= ~TF_ACK_DELAY;                                  \
+      (pcb)->flags |= TF_ACK_NOW;                                     \
+    }                                                                 \
+    else {                                                            \
+      (pcb)->flags |= TF_ACK_DELAY;                                   \
+    }                                                                 \
+  } while (0)
+#else /* TCP_STRETCH_ACK */
 #define tcp_ack(pcb)                               \
   do {                                             \
     if((pcb)->flags & TF_ACK_DELAY) {              \
@@ -415,6 +552,7 @@ struct tcp_seg *tcp_seg_copy(struct tcp_seg *seg);
       (pcb)->flags |= TF_ACK_DELAY;                \
     }                                              \
   } while (0)
+#endif /* TCP_STRETCH_ACK */
 
 #define tcp_ack_now(pcb)                           \
   do {                                             \
@@ -461,6 +599,21 @@ s16_t tcp_pcbs_sane(void);
  * that a timer is needed (i.e. active- or time-wait-pcb found). */
 void tcp_timer_needed(void);
 
+#if LWIP_TCP_TIMER_SLEEP
+u32_t tcp_idle_ticks(u32_t max_ticks);
+void  tcp_tmr_skip(u32_t ticks);
+#endif /* LWIP_TCP_TIMER_SLEEP */
+
+#if TCP_RX_COALESCE
+void tcp_rx_queue(struct tcp_pcb *pcb);
+void tcp_rx_discard(struct tcp_pcb *pcb);
+#endif /* TCP_RX_COALESCE */
+
+#if TCP_COMPACT_TIME_WAIT
+void tcp_tw_compact(struct tcp_pcb *pcb);
+void tcp_tw_ack(struct tcp_tw *tw);
+#endif /* TCP_COMPACT_TIME_WAIT */
+
 
 #ifdef __cplusplus
 }
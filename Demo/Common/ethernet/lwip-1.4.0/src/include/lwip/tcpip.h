@@ -87,6 +87,13 @@ err_t tcpip_apimsg_lock(struct api_msg *apimsg);
 #endif /* LWIP_NETCONN */
 
 err_t tcpip_input(struct pbuf *p, struct netif *inp);
+#if LWIP_TCPIP_CORE_LOCKING
+err_t tcpip_input_direct(struct pbuf *p, struct netif *inp);
+#endif /* LWIP_TCPIP_CORE_LOCKING */
+#if LWIP_NETIF_RX_TASK
+err_t tcpip_rx_start(struct netif *netif, const char *name, int prio);
+err_t tcpip_rx_input(struct pbuf *p, struct netif *inp);
+#endif /* LWIP_NETIF_RX_TASK */
 
 #if LWIP_NETIF_API
 err_t tcpip_netifapi(struct netifapi_msg *netifapimsg);
@@ -40,6 +40,9 @@
 #include "lwip/netif.h"
 #include "lwip/ip_addr.h"
 #include "lwip/ip.h"
+#if LWIP_UDP_FLOW
+#include "netif/etharp.h"
+#endif /* LWIP_UDP_FLOW */
 
 #ifdef __cplusplus
 extern "C" {
@@ -148,6 +151,33 @@ err_t            udp_send_chksum(struct udp_pcb *pcb, struct pbuf *p,
                                  u8_t have_chksum, u16_t chksum);
 #endif /* LWIP_CHECKSUM_ON_COPY */
 
+#if LWIP_UDP_FLOW
+/** A connected UDP flow: the netif, next hop and headers of a connected pcb,
+ * resolved once by udp_flow_connect() so that udp_flow_send() can build each
+ * frame from a template. The flow is owned by the caller; call
+ * udp_flow_connect() again if the pcb is reconnected or rebound. */
+struct udp_flow {
+  /** Ethernet, IP and UDP header template, first so that it is laid out
+   * (and aligned) like the headers of a pbuf */
+  u8_t hdr[SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN];
+  struct udp_pcb *pcb;
+  struct netif *netif;
+  /** next hop IP address, looked up in the ARP table */
+  ip_addr_t nexthop;
+  /** ARP table index of the next hop, -1 while unresolved */
+  s8_t arp_index;
+  /** 1 if the destination is unicast and the next hop needs ARP */
+  u8_t unicast;
+  /** folded sum of the IP header with zero length, ID and checksum */
+  u16_t ip_sum;
+  /** folded sum of the pseudo and UDP headers with zero lengths */
+  u16_t udp_sum;
+};
+
+err_t            udp_flow_connect(struct udp_flow *flow, struct udp_pcb *pcb);
+err_t            udp_flow_send  (struct udp_flow *flow, struct pbuf *p);
+#endif /* LWIP_UDP_FLOW */
+
 #define          udp_flags(pcb) ((pcb)->flags)
 #define          udp_setflags(pcb, f)  ((pcb)->flags = (f))
 
@@ -0,0 +1,76 @@
+/**
+ * @file
+ * DMA frame buffer pool
+ *
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#ifndef __NETIF_DMABUF_H__
+#define __NETIF_DMABUF_H__
+
+#include "lwip/opt.h"
+
+#if LWIP_DMABUF /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+#include "lwip/mem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void dmabuf_init(void);
+struct pbuf *dmabuf_alloc(u16_t length);
+void dmabuf_rx_complete(struct pbuf *p, u16_t length);
+void dmabuf_tx_flush(struct pbuf *p);
+
+#if DMABUF_DESC_POOL_SIZE
+void *dmabuf_desc_alloc(mem_size_t size);
+#if DMABUF_DESC_NOCACHE
+#define dmabuf_desc_flush(desc, len)
+#define dmabuf_desc_invalidate(desc, len)
+#else /* DMABUF_DESC_NOCACHE */
+/** Write a descriptor back before the DMA engine reads it */
+#define dmabuf_desc_flush(desc, len)      DMABUF_CACHE_FLUSH(desc, len)
+/** Discard a cached descriptor before reading what the DMA engine wrote.
+ * Only the whole of a block returned by dmabuf_desc_alloc() can be invalidated. */
+#define dmabuf_desc_invalidate(desc, len) DMABUF_CACHE_INVALIDATE(desc, len)
+#endif /* DMABUF_DESC_NOCACHE */
+#endif /* DMABUF_DESC_POOL_SIZE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_DMABUF */
+
+#endif /* __NETIF_DMABUF_H__ */
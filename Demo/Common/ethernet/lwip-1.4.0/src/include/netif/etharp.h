@@ -185,6 +185,9 @@ s8_t etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
 err_t etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr);
 err_t etharp_query(struct netif *netif, ip_addr_t *ipaddr, struct pbuf *q);
 err_t etharp_request(struct netif *netif, ip_addr_t *ipaddr);
+#if LWIP_UDP_FLOW
+struct eth_addr *etharp_check_entry(s8_t i, ip_addr_t *ipaddr);
+#endif /* LWIP_UDP_FLOW */
 /** For Ethernet network interfaces, we might want to send "gratuitous ARP";
  *  this is an ARP packet sent by a node in order to spontaneously cause other
  *  nodes to update an entry in their ARP cache.
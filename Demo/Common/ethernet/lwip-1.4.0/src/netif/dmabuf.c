@@ -0,0 +1,242 @@
+/**
+ * @file
+ * DMA frame buffer pool
+ *
+ * Frame buffers for MACs that move frames by DMA, handed to the stack as
+ * custom pbufs so received frames are not copied.  Each buffer starts on a
+ * cache line and is padded out to whole lines, so no other data shares its
+ * cache lines and invalidating them cannot lose anything else.  Only the
+ * part of a buffer that holds a frame is invalidated or flushed:
+ *
+ * - a buffer returned by dmabuf_alloc() has no dirty lines, so it can be
+ *   handed to the DMA engine to receive into straight away;
+ * - once a frame has been received, dmabuf_rx_complete() invalidates the
+ *   lines of the frame, dropping anything the CPU read ahead meanwhile;
+ * - dmabuf_tx_flush() writes back the data of a frame to be sent, which can
+ *   be any pbuf chain, not only one allocated here;
+ * - when the stack frees the pbuf, the lines the frame covered are
+ *   invalidated, discarding whatever the stack wrote into it (an ICMP echo
+ *   reply is built in the request's buffer, for example).
+ *
+ * dmabuf_desc_alloc() hands out cache line aligned blocks for descriptors,
+ * optionally from memory that is not cached (DMABUF_DESC_NOCACHE).
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_DMABUF /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "lwip/debug.h"
+#include "lwip/stats.h"
+#include "netif/dmabuf.h"
+
+#define DMABUF_LINE_ALIGN(x) \
+  (((x) + DMABUF_CACHE_LINE_SIZE - 1) & ~((mem_ptr_t)DMABUF_CACHE_LINE_SIZE - 1))
+
+/** Size of each buffer, in whole cache lines */
+#define DMABUF_DATA_SIZE     DMABUF_LINE_ALIGN(DMABUF_SIZE)
+
+/** One buffer of the pool.  The data is held apart from this structure so
+ * that the fields the CPU writes never share a cache line with it. */
+struct dmabuf {
+  /** must be first so the pbuf passed to dmabuf_free() can be converted back */
+  struct pbuf_custom pc;
+  struct dmabuf *next;
+  u8_t *data;
+  /** bytes at the start of data whose lines may be held in the cache */
+  u16_t used;
+};
+
+static struct dmabuf dmabufs[DMABUF_COUNT];
+static u8_t dmabuf_mem[(DMABUF_COUNT * DMABUF_DATA_SIZE) + DMABUF_CACHE_LINE_SIZE - 1];
+static struct dmabuf *dmabuf_free_list;
+
+#if DMABUF_DESC_POOL_SIZE
+static u8_t dmabuf_desc_mem[DMABUF_LINE_ALIGN(DMABUF_DESC_POOL_SIZE) + DMABUF_CACHE_LINE_SIZE - 1] DMABUF_DESC_SECTION;
+/** next free byte of the descriptor pool, NULL until dmabuf_init() */
+static u8_t *dmabuf_desc_next;
+#endif /* DMABUF_DESC_POOL_SIZE */
+
+static void dmabuf_free(struct pbuf *p);
+
+/**
+ * Build the free list of the pool.  Called from lwip_init().
+ */
+void
+dmabuf_init(void)
+{
+  u8_t *data = (u8_t *)DMABUF_LINE_ALIGN((mem_ptr_t)dmabuf_mem);
+  u16_t i;
+
+  dmabuf_free_list = NULL;
+  for (i = 0; i < DMABUF_COUNT; i++) {
+    dmabufs[i].pc.custom_free_function = dmabuf_free;
+    dmabufs[i].data = data + (i * DMABUF_DATA_SIZE);
+    dmabufs[i].next = dmabuf_free_list;
+    dmabuf_free_list = &dmabufs[i];
+  }
+
+  /* Nothing is known about the lines of the pool yet. */
+  DMABUF_CACHE_INVALIDATE(data, DMABUF_COUNT * DMABUF_DATA_SIZE);
+
+#if DMABUF_DESC_POOL_SIZE
+  dmabuf_desc_next = (u8_t *)DMABUF_LINE_ALIGN((mem_ptr_t)dmabuf_desc_mem);
+#endif /* DMABUF_DESC_POOL_SIZE */
+}
+
+/**
+ * Take a buffer from the pool.  Can be called from an interrupt if
+ * SYS_ARCH_PROTECT can.
+ *
+ * @param length length of the pbuf, at most DMABUF_SIZE; a receive buffer
+ *        is allocated at its full size and trimmed by dmabuf_rx_complete()
+ * @return a PBUF_REF custom pbuf whose payload is cache line aligned, or
+ *         NULL if all the buffers are in use
+ */
+struct pbuf *
+dmabuf_alloc(u16_t length)
+{
+  struct dmabuf *b;
+  struct pbuf *p;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  if (length > DMABUF_DATA_SIZE) {
+    return NULL;
+  }
+
+  SYS_ARCH_PROTECT(lev);
+  b = dmabuf_free_list;
+  if (b != NULL) {
+    dmabuf_free_list = b->next;
+  }
+  SYS_ARCH_UNPROTECT(lev);
+
+  if (b == NULL) {
+    LINK_STATS_INC(link.memerr);
+    return NULL;
+  }
+
+  /* The lines were invalidated when the buffer was freed, only the part
+     the new owner uses can become cached. */
+  b->used = length;
+  p = pbuf_alloced_custom(PBUF_RAW, length, PBUF_REF, &b->pc, b->data, DMABUF_DATA_SIZE);
+  LWIP_ASSERT("dmabuf_alloc: pbuf_alloced_custom failed", p != NULL);
+  return p;
+}
+
+/**
+ * Called by the driver once the DMA engine has received a frame into a
+ * buffer from dmabuf_alloc(), before the frame is passed to the stack.
+ *
+ * @param p the buffer
+ * @param length number of bytes received, including ETH_PAD_SIZE if the
+ *        frame was received after the padding
+ */
+void
+dmabuf_rx_complete(struct pbuf *p, u16_t length)
+{
+  struct dmabuf *b = (struct dmabuf *)p;
+
+  LWIP_ASSERT("dmabuf_rx_complete: frame too long", length <= b->used);
+
+  DMABUF_CACHE_INVALIDATE(b->data, DMABUF_LINE_ALIGN(length));
+  b->used = length;
+  pbuf_realloc(p, length);
+}
+
+/**
+ * Write back the data of a frame before the DMA engine sends it.
+ *
+ * @param p the frame, any pbuf chain
+ */
+void
+dmabuf_tx_flush(struct pbuf *p)
+{
+  for (; p != NULL; p = p->next) {
+    DMABUF_CACHE_FLUSH(p->payload, p->len);
+  }
+}
+
+/**
+ * Return a buffer to the pool, called through pbuf_free().
+ */
+static void
+dmabuf_free(struct pbuf *p)
+{
+  struct dmabuf *b = (struct dmabuf *)p;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  /* The stack only writes within the frame, and a PBUF_REF pbuf cannot
+     grow at the front, so the lines past b->used are clean. */
+  DMABUF_CACHE_INVALIDATE(b->data, DMABUF_LINE_ALIGN(b->used));
+
+  SYS_ARCH_PROTECT(lev);
+  b->next = dmabuf_free_list;
+  dmabuf_free_list = b;
+  SYS_ARCH_UNPROTECT(lev);
+}
+
+#if DMABUF_DESC_POOL_SIZE
+/**
+ * Take a block for DMA descriptors from the descriptor pool.  Blocks are
+ * never freed, so this is meant to be called while the driver initialises.
+ *
+ * @param size size of the block in bytes
+ * @return a cache line aligned block padded out to whole lines, or NULL if
+ *         the pool is exhausted
+ */
+void *
+dmabuf_desc_alloc(mem_size_t size)
+{
+  u8_t *end = (u8_t *)DMABUF_LINE_ALIGN((mem_ptr_t)dmabuf_desc_mem) + DMABUF_LINE_ALIGN(DMABUF_DESC_POOL_SIZE);
+  u8_t *desc;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  size = (mem_size_t)DMABUF_LINE_ALIGN(size);
+
+  SYS_ARCH_PROTECT(lev);
+  desc = dmabuf_desc_next;
+  if ((desc == NULL) || (size > (mem_size_t)(end - desc))) {
+    desc = NULL;
+  } else {
+    dmabuf_desc_next += size;
+  }
+  SYS_ARCH_UNPROTECT(lev);
+
+  return desc;
+}
+#endif /* DMABUF_DESC_POOL_SIZE */
+
+#endif /* LWIP_DMABUF */
@@ -107,10 +107,24 @@ struct etharp_entry {
 #if ETHARP_SUPPORT_STATIC_ENTRIES
   u8_t static_entry;
 #endif /* ETHARP_SUPPORT_STATIC_ENTRIES */
+#if ARP_TABLE_HASH_SIZE
+  /** Next entry on the same hash chain, as index + 1 (0: end of chain) */
+  u8_t hash_next;
+#endif /* ARP_TABLE_HASH_SIZE */
 };
 
 static struct etharp_entry arp_table[ARP_TABLE_SIZE];
 
+#if ARP_TABLE_HASH_SIZE
+/** First entry of each hash chain, as index + 1 (0: empty chain). Every
+    pending or stable entry is on the chain of its IP address. */
+static u8_t arp_hash[ARP_TABLE_HASH_SIZE];
+
+/** The low bytes of the address differ most between hosts on one network */
+#define ETHARP_HASH(ipaddr) \
+  ((u8_t)(ip4_addr3(ipaddr) ^ ip4_addr4(ipaddr)) & (ARP_TABLE_HASH_SIZE - 1))
+#endif /* ARP_TABLE_HASH_SIZE */
+
 #if !LWIP_NETIF_HWADDRHINT
 static u8_t etharp_cached_entry;
 #endif /* !LWIP_NETIF_HWADDRHINT */
@@ -135,6 +149,9 @@ static err_t update_arp_entry(struct netif *netif, ip_addr_t *ipaddr, struct eth
 #if (LWIP_ARP && (ARP_TABLE_SIZE > 0x7f))
   #error "ARP_TABLE_SIZE must fit in an s8_t, you have to reduce it in your lwipopts.h"
 #endif
+#if (LWIP_ARP && ((ARP_TABLE_HASH_SIZE & (ARP_TABLE_HASH_SIZE - 1)) != 0))
+  #error "ARP_TABLE_HASH_SIZE must be 0 or a power of 2, change it in your lwipopts.h"
+#endif
 
 
 #if ARP_QUEUEING
@@ -168,6 +185,17 @@ free_etharp_q(struct etharp_q_entry *q)
 static void
 free_entry(int i)
 {
+#if ARP_TABLE_HASH_SIZE
+  if (arp_table[i].state != ETHARP_STATE_EMPTY) {
+    /* unlink from its hash chain */
+    u8_t *link = &arp_hash[ETHARP_HASH(&arp_table[i].ipaddr)];
+    while (*link != i + 1) {
+      LWIP_ASSERT("entry is on its hash chain", *link != 0);
+      link = &arp_table[*link - 1].hash_next;
+    }
+    *link = arp_table[i].hash_next;
+  }
+#endif /* ARP_TABLE_HASH_SIZE */
   /* remove from SNMP ARP index tree */
   snmp_delete_arpidx_tree(arp_table[i].netif, &arp_table[i].ipaddr);
   /* and empty packet queue */
@@ -280,6 +308,23 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
    *    until 5 matches, or all entries are searched for.
    */
 
+#if ARP_TABLE_HASH_SIZE
+  /* 5) is done on the hash chain before the sweep, which is then only
+   * needed when a new entry has to be created */
+  if (ipaddr) {
+    for (i = arp_hash[ETHARP_HASH(ipaddr)]; i != 0; i = arp_table[i - 1].hash_next) {
+      if (ip_addr_cmp(ipaddr, &arp_table[i - 1].ipaddr)) {
+        LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: found matching entry %"U16_F"\n", (u16_t)(i - 1)));
+        return (s8_t)(i - 1);
+      }
+    }
+  }
+  if ((flags & ETHARP_FLAG_FIND_ONLY) != 0) {
+    LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: no matching entry found\n"));
+    return (s8_t)ERR_MEM;
+  }
+#endif /* ARP_TABLE_HASH_SIZE */
+
   for (i = 0; i < ARP_TABLE_SIZE; ++i) {
     u8_t state = arp_table[i].state;
     /* no empty entry found yet and now we do find one? */
@@ -290,12 +335,14 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
     } else if (state != ETHARP_STATE_EMPTY) {
       LWIP_ASSERT("state == ETHARP_STATE_PENDING || state == ETHARP_STATE_STABLE",
         state == ETHARP_STATE_PENDING || state == ETHARP_STATE_STABLE);
+#if !ARP_TABLE_HASH_SIZE
       /* if given, does IP address match IP address in ARP entry? */
       if (ipaddr && ip_addr_cmp(ipaddr, &arp_table[i].ipaddr)) {
         LWIP_DEBUGF(ETHARP_DEBUG | LWIP_DBG_TRACE, ("find_entry: found matching entry %"U16_F"\n", (u16_t)i));
         /* found exact IP address match, simply bail out */
         return i;
       }
+#endif /* !ARP_TABLE_HASH_SIZE */
       /* pending entry? */
       if (state == ETHARP_STATE_PENDING) {
         /* pending with queued packets? */
@@ -388,6 +435,12 @@ find_entry(ip_addr_t *ipaddr, u8_t flags)
   if (ipaddr != NULL) {
     /* set IP address */
     ip_addr_copy(arp_table[i].ipaddr, *ipaddr);
+#if ARP_TABLE_HASH_SIZE
+    /* the caller makes the entry pending or stable straight away, so it
+       belongs on the hash chain from now on */
+    arp_table[i].hash_next = arp_hash[ETHARP_HASH(ipaddr)];
+    arp_hash[ETHARP_HASH(ipaddr)] = i + 1;
+#endif /* ARP_TABLE_HASH_SIZE */
   }
   arp_table[i].ctime = 0;
 #if ETHARP_SUPPORT_STATIC_ENTRIES
@@ -599,6 +652,28 @@ etharp_find_addr(struct netif *netif, ip_addr_t *ipaddr,
   return -1;
 }
 
+#if LWIP_UDP_FLOW
+/**
+ * Check that an ARP table index returned earlier by etharp_find_addr()
+ * still holds a stable entry for the same IP address. This lets a caller
+ * that caches the index confirm the mapping without searching the table.
+ *
+ * @param i the table index returned by etharp_find_addr()
+ * @param ipaddr the IP address the index was looked up for
+ * @return the Ethernet address of the entry, or NULL if it has changed
+ */
+struct eth_addr *
+etharp_check_entry(s8_t i, ip_addr_t *ipaddr)
+{
+  if ((i >= 0) && (i < ARP_TABLE_SIZE) &&
+      (arp_table[i].state == ETHARP_STATE_STABLE) &&
+      ip_addr_cmp(ipaddr, &arp_table[i].ipaddr)) {
+    return &arp_table[i].ethaddr;
+  }
+  return NULL;
+}
+#endif /* LWIP_UDP_FLOW */
+
 #if ETHARP_TRUST_IP_MAC
 /**
  * Updates the ARP table using the given IP packet.
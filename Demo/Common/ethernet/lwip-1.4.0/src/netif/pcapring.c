@@ -0,0 +1,314 @@
+/**
+ * @file
+ * Link layer capture ring
+ *
+ * Network interface drivers call pcapring_record() for each frame they
+ * receive or send.  The start of the frame is copied into a fixed ring of
+ * records, overwriting the oldest, so recording never blocks or allocates.
+ * Connecting to the port passed to pcapring_server_init() dumps the ring
+ * as a pcap file that can be opened with Wireshark or tcpdump, e.g. with
+ * "nc <address> <port> > capture.pcap".  Frames are not recorded while a
+ * dump is in progress so that the dump sees a consistent ring.
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_PCAPRING /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/sys.h"
+#include "lwip/tcp.h"
+#include "netif/pcapring.h"
+
+#include <string.h>
+
+/** One captured frame */
+struct pcapring_rec {
+  /** PCAPRING_TIME_MS() when the frame was recorded */
+  u32_t time;
+  /** length of the frame on the wire */
+  u16_t len;
+  /** number of bytes of the frame held in data */
+  u16_t caplen;
+  u8_t data[PCAPRING_SNAPLEN];
+};
+
+static struct pcapring_rec pcapring_recs[PCAPRING_RECORDS];
+/** index of the record that is written next */
+static u16_t pcapring_next;
+/** number of valid records, up to PCAPRING_RECORDS */
+static u16_t pcapring_count;
+/** set while the ring is being dumped */
+static volatile u8_t pcapring_frozen;
+
+/**
+ * Record the start of a frame.  Can be called from an interrupt if
+ * SYS_ARCH_PROTECT and PCAPRING_TIME_MS() can.
+ *
+ * @param p the frame, with the payload pointing at the ethernet header
+ *          (including ETH_PAD_SIZE padding)
+ */
+void
+pcapring_record(struct pbuf *p)
+{
+  struct pcapring_rec *rec;
+  u32_t now;
+  u16_t len;
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  if (p->tot_len <= ETH_PAD_SIZE) {
+    return;
+  }
+  len = p->tot_len - ETH_PAD_SIZE;
+  now = PCAPRING_TIME_MS();
+
+  SYS_ARCH_PROTECT(lev);
+  if (!pcapring_frozen) {
+    rec = &pcapring_recs[pcapring_next];
+    if (++pcapring_next == PCAPRING_RECORDS) {
+      pcapring_next = 0;
+    }
+    if (pcapring_count < PCAPRING_RECORDS) {
+      pcapring_count++;
+    }
+    rec->time = now;
+    rec->len = len;
+    rec->caplen = pbuf_copy_partial(p, rec->data, LWIP_MIN(len, PCAPRING_SNAPLEN), ETH_PAD_SIZE);
+  }
+  SYS_ARCH_UNPROTECT(lev);
+}
+
+#if LWIP_TCP
+
+#define PCAPRING_MAGIC              0xa1b2c3d4UL
+#define PCAPRING_VERSION_MAJOR      2
+#define PCAPRING_VERSION_MINOR      4
+#define PCAPRING_LINKTYPE_ETHERNET  1
+
+/** pcap file header, written in host byte order which readers detect from
+ * the magic number */
+struct pcapring_file_hdr {
+  u32_t magic;
+  u16_t version_major;
+  u16_t version_minor;
+  s32_t thiszone;
+  u32_t sigfigs;
+  u32_t snaplen;
+  u32_t network;
+};
+
+/** pcap record header, followed by incl_len bytes of the frame */
+struct pcapring_rec_hdr {
+  u32_t ts_sec;
+  u32_t ts_usec;
+  u32_t incl_len;
+  u32_t orig_len;
+};
+
+/** connection the ring is being dumped to, NULL if none */
+static struct tcp_pcb *pcapring_pcb;
+/** index of the oldest record of the dump */
+static u16_t pcapring_first;
+/** number of records of the dump queued so far */
+static u16_t pcapring_sent;
+/** set once the file header has been queued */
+static u8_t pcapring_hdr_sent;
+
+static void
+pcapring_dump_end(void)
+{
+  pcapring_pcb = NULL;
+  pcapring_frozen = 0;
+}
+
+/**
+ * Queue as much of the dump as fits in the send buffer, and close the
+ * connection once all of it has been queued.
+ */
+static err_t
+pcapring_dump(struct tcp_pcb *pcb)
+{
+  struct pcapring_file_hdr fhdr;
+  struct pcapring_rec_hdr rhdr;
+  struct pcapring_rec *rec;
+  u8_t buf[sizeof(struct pcapring_rec_hdr) + PCAPRING_SNAPLEN];
+  u16_t len;
+
+  /* a connection whose dump has ended only has to be closed */
+  if (pcb == pcapring_pcb) {
+    if (!pcapring_hdr_sent) {
+      fhdr.magic = PCAPRING_MAGIC;
+      fhdr.version_major = PCAPRING_VERSION_MAJOR;
+      fhdr.version_minor = PCAPRING_VERSION_MINOR;
+      fhdr.thiszone = 0;
+      fhdr.sigfigs = 0;
+      fhdr.snaplen = PCAPRING_SNAPLEN;
+      fhdr.network = PCAPRING_LINKTYPE_ETHERNET;
+      if (tcp_write(pcb, &fhdr, sizeof(fhdr), TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE) != ERR_OK) {
+        return ERR_OK;
+      }
+      pcapring_hdr_sent = 1;
+    }
+
+    while (pcapring_sent < pcapring_count) {
+      rec = &pcapring_recs[(pcapring_first + pcapring_sent) % PCAPRING_RECORDS];
+      rhdr.ts_sec = rec->time / 1000;
+      rhdr.ts_usec = (rec->time % 1000) * 1000;
+      rhdr.incl_len = rec->caplen;
+      rhdr.orig_len = rec->len;
+      /* write header and data together so that a full send buffer cannot
+         leave half a record queued */
+      MEMCPY(buf, &rhdr, sizeof(rhdr));
+      MEMCPY(buf + sizeof(rhdr), rec->data, rec->caplen);
+      len = (u16_t)(sizeof(rhdr) + rec->caplen);
+      if (tcp_write(pcb, buf, len, TCP_WRITE_FLAG_COPY | TCP_WRITE_FLAG_MORE) != ERR_OK) {
+        /* try again when some of the queued data has been acknowledged */
+        tcp_output(pcb);
+        return ERR_OK;
+      }
+      pcapring_sent++;
+    }
+
+    /* everything is queued, the ring can be written again */
+    tcp_err(pcb, NULL);
+    pcapring_dump_end();
+  }
+
+  if (tcp_close(pcb) != ERR_OK) {
+    /* out of memory, try closing again from the poll callback */
+    tcp_output(pcb);
+    return ERR_OK;
+  }
+  tcp_sent(pcb, NULL);
+  tcp_recv(pcb, NULL);
+  tcp_poll(pcb, NULL, 0);
+  return ERR_OK;
+}
+
+static err_t
+pcapring_sent_cb(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+  LWIP_UNUSED_ARG(arg);
+  LWIP_UNUSED_ARG(len);
+  return pcapring_dump(pcb);
+}
+
+static err_t
+pcapring_poll_cb(void *arg, struct tcp_pcb *pcb)
+{
+  LWIP_UNUSED_ARG(arg);
+  return pcapring_dump(pcb);
+}
+
+static err_t
+pcapring_recv_cb(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+  LWIP_UNUSED_ARG(arg);
+  LWIP_UNUSED_ARG(err);
+  if (p != NULL) {
+    /* nothing is expected from the client, discard what it sends */
+    tcp_recved(pcb, p->tot_len);
+    pbuf_free(p);
+  }
+  return ERR_OK;
+}
+
+static void
+pcapring_err_cb(void *arg, err_t err)
+{
+  LWIP_UNUSED_ARG(arg);
+  LWIP_UNUSED_ARG(err);
+  /* the pcb has already been freed */
+  pcapring_dump_end();
+}
+
+static err_t
+pcapring_accept(void *arg, struct tcp_pcb *pcb, err_t err)
+{
+  SYS_ARCH_DECL_PROTECT(lev);
+
+  LWIP_UNUSED_ARG(arg);
+  LWIP_UNUSED_ARG(err);
+
+  if (pcapring_pcb != NULL) {
+    /* only one dump at a time: returning an error aborts the connection */
+    return ERR_MEM;
+  }
+
+  /* freeze the ring so the records do not change under the dump */
+  SYS_ARCH_PROTECT(lev);
+  pcapring_frozen = 1;
+  pcapring_first = (pcapring_count < PCAPRING_RECORDS) ? 0 : pcapring_next;
+  SYS_ARCH_UNPROTECT(lev);
+  pcapring_pcb = pcb;
+  pcapring_sent = 0;
+  pcapring_hdr_sent = 0;
+
+  tcp_arg(pcb, NULL);
+  tcp_err(pcb, pcapring_err_cb);
+  tcp_recv(pcb, pcapring_recv_cb);
+  tcp_sent(pcb, pcapring_sent_cb);
+  tcp_poll(pcb, pcapring_poll_cb, 4);
+  return pcapring_dump(pcb);
+}
+
+/**
+ * Listen for connections on port and dump the ring to each.
+ * Must be called from the tcpip thread (or with NO_SYS=1 from the main loop).
+ */
+err_t
+pcapring_server_init(u16_t port)
+{
+  struct tcp_pcb *pcb, *lpcb;
+  err_t err;
+
+  pcb = tcp_new();
+  if (pcb == NULL) {
+    return ERR_MEM;
+  }
+  err = tcp_bind(pcb, IP_ADDR_ANY, port);
+  if (err != ERR_OK) {
+    tcp_close(pcb);
+    return err;
+  }
+  lpcb = tcp_listen(pcb);
+  if (lpcb == NULL) {
+    tcp_close(pcb);
+    return ERR_MEM;
+  }
+  tcp_accept(lpcb, pcapring_accept);
+  return ERR_OK;
+}
+
+#endif /* LWIP_TCP */
+
+#endif /* LWIP_PCAPRING */
@@ -196,7 +196,7 @@ ipcp_init(int unit)
 #endif /* VJ_SUPPORT */
   wo->vj_protocol   = IPCP_VJ_COMP;
   wo->maxslotindex  = MAX_SLOTS - 1;
-  wo->cflag         = 0;
+  wo->cflag         = 1;
   wo->default_route = 1;
 
   ao->neg_addr      = 1;
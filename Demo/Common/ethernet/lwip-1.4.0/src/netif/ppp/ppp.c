@@ -157,6 +157,21 @@ typedef enum {
 
 #define ESCAPE_P(accm, c) ((accm)[(c) >> 3] & pppACCMMask[c & 0x07])
 
+#if PPPOS_FAST_HDLC
+/* Update the FCS with two octets at once. */
+#define PPP_FCS2(fcs, c1, c2) (fcstab2[((fcs) ^ (c1)) & 0xff] ^ fcstab[(((fcs) >> 8) ^ (c2)) & 0xff])
+
+/* How pppRunLength() can test a word at a time for octets the ACCM marks:
+ * not at all, or because only PPP_FLAG and PPP_ESCAPE are marked above 0x1f
+ * and none or all of the control characters are marked. */
+#define PPP_ACCM_BYTEWISE 0
+#define PPP_ACCM_NOCTRL   1
+#define PPP_ACCM_ALLCTRL  2
+
+/* Non zero in the top bit of each octet of w that is zero. */
+#define PPP_HASZERO(w)    (((w) - 0x01010101UL) & ~(w))
+#endif /* PPPOS_FAST_HDLC */
+
 /************************/
 /*** LOCAL DATA TYPES ***/
 /************************/
@@ -326,6 +341,47 @@ static const u_short fcstab[256] = {
   0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78
 };
 
+#if PPPOS_FAST_HDLC
+/*
+ * fcstab2[i] is the FCS table applied twice: fcstab[fcstab[i] & 0xff] ^
+ * (fcstab[i] >> 8), which lets PPP_FCS2 add two octets per step.
+ */
+static const u_short fcstab2[256] = {
+  0x0000, 0x19d8, 0x33b0, 0x2a68, 0x6760, 0x7eb8, 0x54d0, 0x4d08,
+  0xcec0, 0xd718, 0xfd70, 0xe4a8, 0xa9a0, 0xb078, 0x9a10, 0x83c8,
+  0x9591, 0x8c49, 0xa621, 0xbff9, 0xf2f1, 0xeb29, 0xc141, 0xd899,
+  0x5b51, 0x4289, 0x68e1, 0x7139, 0x3c31, 0x25e9, 0x0f81, 0x1659,
+  0x2333, 0x3aeb, 0x1083, 0x095b, 0x4453, 0x5d8b, 0x77e3, 0x6e3b,
+  0xedf3, 0xf42b, 0xde43, 0xc79b, 0x8a93, 0x934b, 0xb923, 0xa0fb,
+  0xb6a2, 0xaf7a, 0x8512, 0x9cca, 0xd1c2, 0xc81a, 0xe272, 0xfbaa,
+  0x7862, 0x61ba, 0x4bd2, 0x520a, 0x1f02, 0x06da, 0x2cb2, 0x356a,
+  0x4666, 0x5fbe, 0x75d6, 0x6c0e, 0x2106, 0x38de, 0x12b6, 0x0b6e,
+  0x88a6, 0x917e, 0xbb16, 0xa2ce, 0xefc6, 0xf61e, 0xdc76, 0xc5ae,
+  0xd3f7, 0xca2f, 0xe047, 0xf99f, 0xb497, 0xad4f, 0x8727, 0x9eff,
+  0x1d37, 0x04ef, 0x2e87, 0x375f, 0x7a57, 0x638f, 0x49e7, 0x503f,
+  0x6555, 0x7c8d, 0x56e5, 0x4f3d, 0x0235, 0x1bed, 0x3185, 0x285d,
+  0xab95, 0xb24d, 0x9825, 0x81fd, 0xccf5, 0xd52d, 0xff45, 0xe69d,
+  0xf0c4, 0xe91c, 0xc374, 0xdaac, 0x97a4, 0x8e7c, 0xa414, 0xbdcc,
+  0x3e04, 0x27dc, 0x0db4, 0x146c, 0x5964, 0x40bc, 0x6ad4, 0x730c,
+  0x8ccc, 0x9514, 0xbf7c, 0xa6a4, 0xebac, 0xf274, 0xd81c, 0xc1c4,
+  0x420c, 0x5bd4, 0x71bc, 0x6864, 0x256c, 0x3cb4, 0x16dc, 0x0f04,
+  0x195d, 0x0085, 0x2aed, 0x3335, 0x7e3d, 0x67e5, 0x4d8d, 0x5455,
+  0xd79d, 0xce45, 0xe42d, 0xfdf5, 0xb0fd, 0xa925, 0x834d, 0x9a95,
+  0xafff, 0xb627, 0x9c4f, 0x8597, 0xc89f, 0xd147, 0xfb2f, 0xe2f7,
+  0x613f, 0x78e7, 0x528f, 0x4b57, 0x065f, 0x1f87, 0x35ef, 0x2c37,
+  0x3a6e, 0x23b6, 0x09de, 0x1006, 0x5d0e, 0x44d6, 0x6ebe, 0x7766,
+  0xf4ae, 0xed76, 0xc71e, 0xdec6, 0x93ce, 0x8a16, 0xa07e, 0xb9a6,
+  0xcaaa, 0xd372, 0xf91a, 0xe0c2, 0xadca, 0xb412, 0x9e7a, 0x87a2,
+  0x046a, 0x1db2, 0x37da, 0x2e02, 0x630a, 0x7ad2, 0x50ba, 0x4962,
+  0x5f3b, 0x46e3, 0x6c8b, 0x7553, 0x385b, 0x2183, 0x0beb, 0x1233,
+  0x91fb, 0x8823, 0xa24b, 0xbb93, 0xf69b, 0xef43, 0xc52b, 0xdcf3,
+  0xe999, 0xf041, 0xda29, 0xc3f1, 0x8ef9, 0x9721, 0xbd49, 0xa491,
+  0x2759, 0x3e81, 0x14e9, 0x0d31, 0x4039, 0x59e1, 0x7389, 0x6a51,
+  0x7c08, 0x65d0, 0x4fb8, 0x5660, 0x1b68, 0x02b0, 0x28d8, 0x3100,
+  0xb2c8, 0xab10, 0x8178, 0x98a0, 0xd5a8, 0xcc70, 0xe618, 0xffc0
+};
+#endif /* PPPOS_FAST_HDLC */
+
 /* PPP's Asynchronous-Control-Character-Map.  The mask array is used
  * to select the specific bit for a character. */
 static u_char pppACCMMask[] = {
@@ -554,7 +610,7 @@ pppOverSerialOpen(sio_fd_t fd, void (*linkStatusCB)(void *ctx, int errCode, void
     pc->fd = fd;
 
 #if VJ_SUPPORT
-    vj_compress_init(&pc->vjComp);
+    vj_compress_init(&pc->vjComp, MAX_SLOTS - 1, 0);
 #endif /* VJ_SUPPORT */
 
     /* 
@@ -747,6 +803,135 @@ pppAppend(u_char c, struct pbuf *nb, ext_accm *outACCM)
 
   return tb;
 }
+
+#if PPPOS_FAST_HDLC
+/*
+ * pppAccmMode - work out how pppRunLength() can scan for octets that accm
+ * marks.
+ */
+static int
+pppAccmMode(const u_char *accm)
+{
+  int i;
+
+  for (i = 4; i < (int)sizeof(ext_accm); i++) {
+    if (accm[i] != (i == (PPP_FLAG >> 3) ? 0x60 : 0x00)) {
+      return PPP_ACCM_BYTEWISE;
+    }
+  }
+  if (!accm[0] && !accm[1] && !accm[2] && !accm[3]) {
+    return PPP_ACCM_NOCTRL;
+  }
+  if (accm[0] == 0xff && accm[1] == 0xff && accm[2] == 0xff && accm[3] == 0xff) {
+    return PPP_ACCM_ALLCTRL;
+  }
+  return PPP_ACCM_BYTEWISE;
+}
+
+/*
+ * pppRunLength - return how many of the n octets at s can be copied before
+ * one that accm marks.
+ */
+static int
+pppRunLength(const u_char *s, int n, const u_char *accm, int mode)
+{
+  const u_char *p = s;
+  const u_char *end = s + n;
+  u32_t w, t;
+
+  if (mode != PPP_ACCM_BYTEWISE) {
+    while (p < end && ((mem_ptr_t)p & 3) != 0) {
+      if (ESCAPE_P(accm, *p)) {
+        return (int)(p - s);
+      }
+      p++;
+    }
+    /* Test four octets at a time for PPP_FLAG, PPP_ESCAPE and, if they
+     * are marked, control characters. */
+    for (; end - p >= 4; p += 4) {
+      w = *(const u32_t*)p;
+      t = PPP_HASZERO(w ^ 0x7e7e7e7eUL) | PPP_HASZERO(w ^ 0x7d7d7d7dUL);
+      if (mode == PPP_ACCM_ALLCTRL) {
+        t |= (w - 0x20202020UL) & ~w;
+      }
+      if ((t & 0x80808080UL) != 0) {
+        break;
+      }
+    }
+  }
+  while (p < end && !ESCAPE_P(accm, *p)) {
+    p++;
+  }
+  return (int)(p - s);
+}
+
+/*
+ * pppFcsCopy - copy n octets from s to d and return fcs updated with them.
+ */
+static u_int
+pppFcsCopy(u_int fcs, u_char *d, const u_char *s, int n)
+{
+  for (; n >= 2; n -= 2) {
+    fcs = PPP_FCS2(fcs, s[0], s[1]);
+    d[0] = s[0];
+    d[1] = s[1];
+    d += 2;
+    s += 2;
+  }
+  if (n > 0) {
+    fcs = PPP_FCS(fcs, *s);
+    *d = *s;
+  }
+  return fcs;
+}
+
+/*
+ * pppAppendBlock - append n octets to the end of the given pbuf, updating
+ * the FCS and escaping those that outACCM marks.  Otherwise the same as
+ * calling pppAppend() for each octet.
+ */
+static struct pbuf *
+pppAppendBlock(const u_char *s, int n, struct pbuf *nb, ext_accm *outACCM, u_int *fcs)
+{
+  struct pbuf *tb;
+  u_char *d;
+  u_char c;
+  int mode = pppAccmMode(*outACCM);
+  int run;
+
+  while (n > 0 && nb) {
+    /* Keep room for an escaped octet, as pppAppend() does. */
+    if ((PBUF_POOL_BUFSIZE - nb->len) < 2) {
+      tb = pbuf_alloc(PBUF_RAW, 0, PBUF_POOL);
+      if (tb) {
+        nb->next = tb;
+      } else {
+        LINK_STATS_INC(link.memerr);
+      }
+      nb = tb;
+      continue;
+    }
+
+    d = (u_char*)nb->payload + nb->len;
+    run = pppRunLength(s, LWIP_MIN(n, PBUF_POOL_BUFSIZE - nb->len), *outACCM, mode);
+    if (run > 0) {
+      *fcs = pppFcsCopy(*fcs, d, s, run);
+      nb->len += run;
+      s += run;
+      n -= run;
+    } else {
+      c = *s++;
+      n--;
+      *fcs = PPP_FCS(*fcs, c);
+      d[0] = PPP_ESCAPE;
+      d[1] = c ^ PPP_TRANS;
+      nb->len += 2;
+    }
+  }
+
+  return nb;
+}
+#endif /* PPPOS_FAST_HDLC */
 #endif /* PPPOS_SUPPORT */
 
 #if PPPOE_SUPPORT
@@ -804,6 +989,10 @@ pppifOutput(struct netif *netif, struct pbuf *pb, ip_addr_t *ipaddr)
   u_int fcsOut = PPP_INITFCS;
   struct pbuf *headMB = NULL, *tailMB = NULL, *p;
   u_char c;
+#if VJ_SUPPORT
+  u_char vjHdr[MAX_VJHDR];
+  u_int vjLen = 0, vjSkip = 0, i;
+#endif /* VJ_SUPPORT */
 #endif /* PPPOS_SUPPORT */
 
   LWIP_UNUSED_ARG(ipaddr);
@@ -852,7 +1041,7 @@ pppifOutput(struct netif *netif, struct pbuf *pb, ip_addr_t *ipaddr)
    * this is an IP packet. 
    */
   if (protocol == PPP_IP && pc->vjEnabled) {
-    switch (vj_compress_tcp(&pc->vjComp, pb)) {
+    switch (vj_compress_tcp(&pc->vjComp, pb, vjHdr, &vjLen, &vjSkip)) {
       case TYPE_IP:
         /* No change...
            protocol = PPP_IP_PROTOCOL; */
@@ -897,13 +1086,31 @@ pppifOutput(struct netif *netif, struct pbuf *pb, ip_addr_t *ipaddr)
   fcsOut = PPP_FCS(fcsOut, c);
   tailMB = pppAppend(c, tailMB, &pc->outACCM);
 
+#if VJ_SUPPORT
+  /* The VJ header goes out in place of the first vjSkip octets. */
+  for (i = 0; i < vjLen; i++) {
+    fcsOut = PPP_FCS(fcsOut, vjHdr[i]);
+    tailMB = pppAppend(vjHdr[i], tailMB, &pc->outACCM);
+  }
+#endif /* VJ_SUPPORT */
+
   /* Load packet. */
   for(p = pb; p; p = p->next) {
-    int n;
-    u_char *sPtr;
+    u_char *sPtr = (u_char*)p->payload;
+    int n = p->len;
 
-    sPtr = (u_char*)p->payload;
-    n = p->len;
+#if VJ_SUPPORT
+    if (vjSkip >= (u_int)n) {
+      vjSkip -= (u_int)n;
+      continue;
+    }
+    sPtr += vjSkip;
+    n -= (int)vjSkip;
+    vjSkip = 0;
+#endif /* VJ_SUPPORT */
+#if PPPOS_FAST_HDLC
+    tailMB = pppAppendBlock(sPtr, n, tailMB, &pc->outACCM, &fcsOut);
+#else /* PPPOS_FAST_HDLC */
     while (n-- > 0) {
       c = *sPtr++;
 
@@ -913,6 +1120,7 @@ pppifOutput(struct netif *netif, struct pbuf *pb, ip_addr_t *ipaddr)
       /* Copy to output buffer escaping special characters. */
       tailMB = pppAppend(c, tailMB, &pc->outACCM);
     }
+#endif /* PPPOS_FAST_HDLC */
   }
 
   /* Add FCS and trailing flag. */
@@ -1093,6 +1301,9 @@ pppWrite(int pd, const u_char *s, int n)
 
   fcsOut = PPP_INITFCS;
   /* Load output buffer. */
+#if PPPOS_FAST_HDLC
+  tailMB = pppAppendBlock(s, n, tailMB, &pc->outACCM, &fcsOut);
+#else /* PPPOS_FAST_HDLC */
   while (n-- > 0) {
     c = *s++;
 
@@ -1102,6 +1313,7 @@ pppWrite(int pd, const u_char *s, int n)
     /* Copy to output buffer escaping special characters. */
     tailMB = pppAppend(c, tailMB, &pc->outACCM);
   }
+#endif /* PPPOS_FAST_HDLC */
     
   /* Add FCS and trailing flag. */
   c = ~fcsOut & 0xFF;
@@ -1290,8 +1502,8 @@ sifvjcomp(int pd, int vjcomp, u8_t cidcomp, u8_t maxcid)
   PPPControl *pc = &pppControl[pd];
   
   pc->vjEnabled = vjcomp;
-  pc->vjComp.compressSlot = cidcomp;
-  pc->vjComp.maxSlotIndex = maxcid;
+  /* start from scratch: the peer has no state for this link yet */
+  vj_compress_init(&pc->vjComp, maxcid, cidcomp);
   PPPDEBUG(LOG_INFO, ("sifvjcomp: VJ compress enable=%d slot=%d max slot=%d\n",
             vjcomp, cidcomp, maxcid));
 #else /* PPPOS_SUPPORT && VJ_SUPPORT */
@@ -1315,6 +1527,9 @@ pppifNetifInit(struct netif *netif)
   netif->output = pppifOutput;
   netif->mtu = pppMTU((int)(size_t)netif->state);
   netif->flags = NETIF_FLAG_POINTTOPOINT | NETIF_FLAG_LINK_UP;
+#if LWIP_TCP && TCP_STRETCH_ACK
+  netif->tcp_ack_segs = PPP_TCP_ACK_SEGS;
+#endif /* LWIP_TCP && TCP_STRETCH_ACK */
 #if LWIP_NETIF_HOSTNAME
   /* @todo: Initialize interface hostname */
   /* netif_set_hostname(netif, "lwip"); */
@@ -1623,6 +1838,10 @@ pppInput(void *arg)
     case PPP_VJC_COMP:      /* VJ compressed TCP */
 #if PPPOS_SUPPORT && VJ_SUPPORT
       PPPDEBUG(LOG_INFO, ("pppInput[%d]: vj_comp in pbuf len=%d\n", pd, nb->len));
+      if (nb->len < MAX_HDR) {
+        /* the VJ header must not span buffers */
+        nb = pppSingleBuf(nb);
+      }
       /*
        * Clip off the VJ header and prepend the rebuilt TCP/IP header and
        * pass the result to IP.
@@ -1642,6 +1861,10 @@ pppInput(void *arg)
     case PPP_VJC_UNCOMP:    /* VJ uncompressed TCP */
 #if PPPOS_SUPPORT && VJ_SUPPORT
       PPPDEBUG(LOG_INFO, ("pppInput[%d]: vj_un in pbuf len=%d\n", pd, nb->len));
+      if (nb->len < MAX_HDR) {
+        /* the TCP/IP header must not span buffers */
+        nb = pppSingleBuf(nb);
+      }
       /*
        * Process the TCP/IP header for VJ header compression and then pass
        * the packet to IP.
@@ -1758,15 +1981,49 @@ pppInProc(PPPControlRx *pcrx, u_char *s, int l)
   struct pbuf *nextNBuf;
   u_char curChar;
   u_char escaped;
+#if PPPOS_FAST_HDLC
+  ext_accm accm;
+  int accmMode;
+  int run;
+#endif /* PPPOS_FAST_HDLC */
   SYS_ARCH_DECL_PROTECT(lev);
 
   PPPDEBUG(LOG_DEBUG, ("pppInProc[%d]: got %d bytes\n", pcrx->pd, l));
-  while (l-- > 0) {
+#if PPPOS_FAST_HDLC
+  /* Take one copy of the ACCM for the whole input string rather than
+   * locking for every octet. */
+  SYS_ARCH_PROTECT(lev);
+  MEMCPY(accm, pcrx->inACCM, sizeof(accm));
+  SYS_ARCH_UNPROTECT(lev);
+  accmMode = pppAccmMode(accm);
+#endif /* PPPOS_FAST_HDLC */
+  while (l > 0) {
+#if PPPOS_FAST_HDLC
+    /* Within the data field, copy everything up to the next octet that
+     * the ACCM marks straight into the packet. */
+    if (pcrx->inState == PDDATA && !pcrx->inEscaped &&
+        pcrx->inTail != NULL && pcrx->inTail->len < PBUF_POOL_BUFSIZE) {
+      run = pppRunLength(s, LWIP_MIN(l, PBUF_POOL_BUFSIZE - pcrx->inTail->len), accm, accmMode);
+      if (run > 0) {
+        pcrx->inFCS = (u16_t)pppFcsCopy(pcrx->inFCS, (u_char*)pcrx->inTail->payload + pcrx->inTail->len, s, run);
+        pcrx->inTail->len += run;
+        s += run;
+        l -= run;
+        continue;
+      }
+    }
+
+    curChar = *s++;
+    l--;
+    escaped = ESCAPE_P(accm, curChar);
+#else /* PPPOS_FAST_HDLC */
     curChar = *s++;
+    l--;
 
     SYS_ARCH_PROTECT(lev);
     escaped = ESCAPE_P(pcrx->inACCM, curChar);
     SYS_ARCH_UNPROTECT(lev);
+#endif /* PPPOS_FAST_HDLC */
     /* Handle special characters. */
     if (escaped) {
       /* Check for escape sequences. */
@@ -1944,7 +2201,7 @@ pppInProc(PPPControlRx *pcrx, u_char *s, int l)
       /* update the frame check sequence number. */
       pcrx->inFCS = PPP_FCS(pcrx->inFCS, curChar);
     }
-  } /* while (l-- > 0), all bytes processed */
+  } /* while (l > 0), all bytes processed */
 
   avRandomize();
 }
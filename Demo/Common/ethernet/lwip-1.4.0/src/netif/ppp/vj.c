@@ -47,22 +47,28 @@
 #define INCR(counter)
 #endif
 
+/*
+ * vj_compress_init - Reset the compression state for a new link, using
+ * connection ids 0 to maxSlotIndex for transmitted packets.  States left
+ * over from an earlier link would make the peer rebuild wrong headers.
+ */
 void
-vj_compress_init(struct vjcompress *comp)
+vj_compress_init(struct vjcompress *comp, u_char maxSlotIndex, u_char compressSlot)
 {
   register u_char i;
   register struct cstate *tstate = comp->tstate;
   
-#if MAX_SLOTS == 0
   memset((char *)comp, 0, sizeof(*comp));
-#endif
-  comp->maxSlotIndex = MAX_SLOTS - 1;
-  comp->compressSlot = 0;    /* Disable slot ID compression by default. */
-  for (i = MAX_SLOTS - 1; i > 0; --i) {
+  if (maxSlotIndex > MAX_SLOTS - 1) {
+    maxSlotIndex = MAX_SLOTS - 1;
+  }
+  comp->maxSlotIndex = maxSlotIndex;
+  comp->compressSlot = compressSlot;
+  for (i = maxSlotIndex; i > 0; --i) {
     tstate[i].cs_id = i;
     tstate[i].cs_next = &tstate[i - 1];
   }
-  tstate[0].cs_next = &tstate[MAX_SLOTS - 1];
+  tstate[0].cs_next = &tstate[maxSlotIndex];
   tstate[0].cs_id = 0;
   comp->last_cs = &tstate[0];
   comp->last_recv = 255;
@@ -131,11 +137,16 @@ vj_compress_init(struct vjcompress *comp)
  * vj_compress_tcp - Attempt to do Van Jacobson header compression on a
  * packet.  This assumes that nb and comp are not null and that the first
  * buffer of the chain contains a valid IP header.
+ * The packet itself is left alone, as TCP may still hold it for
+ * retransmission: the header to send (at most MAX_VJHDR octets) is stored
+ * in hdr and its length in hdrlen, and it replaces the first skip octets
+ * of the packet on the wire.  Both are 0 for TYPE_IP.
  * Return the VJ type code indicating whether or not the packet was
  * compressed.
  */
 u_int
-vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
+vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb,
+                u_char *hdr, u_int *hdrlen, u_int *skip)
 {
   register struct ip_hdr *ip = (struct ip_hdr *)pb->payload;
   register struct cstate *cs = comp->last_cs->cs_next;
@@ -148,6 +159,9 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
   u_char new_seq[16];
   register u_char *cp = new_seq;
 
+  *hdrlen = 0;
+  *skip = 0;
+
   /*  
    * Check that the packet is IP proto TCP.
    */
@@ -163,7 +177,7 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
   if ((IPH_OFFSET(ip) & PP_HTONS(0x3fff)) || pb->tot_len < 40) {
     return (TYPE_IP);
   }
-  th = (struct tcp_hdr *)&((long *)ip)[hlen];
+  th = (struct tcp_hdr *)&((u32_t *)ip)[hlen];
   if ((TCPH_FLAGS(th) & (TCP_SYN|TCP_FIN|TCP_RST|TCP_ACK)) != TCP_ACK) {
     return (TYPE_IP);
   }
@@ -177,7 +191,7 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
   INCR(vjs_packets);
   if (!ip_addr_cmp(&ip->src, &cs->cs_ip.src)
       || !ip_addr_cmp(&ip->dest, &cs->cs_ip.dest)
-      || *(long *)th != ((long *)&cs->cs_ip)[IPH_HL(&cs->cs_ip)]) {
+      || *(u32_t *)th != ((u32_t *)&cs->cs_ip)[IPH_HL(&cs->cs_ip)]) {
     /*
      * Wasn't the first -- search for it.
      *
@@ -198,7 +212,7 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
       INCR(vjs_searches);
       if (ip_addr_cmp(&ip->src, &cs->cs_ip.src)
           && ip_addr_cmp(&ip->dest, &cs->cs_ip.dest)
-          && *(long *)th == ((long *)&cs->cs_ip)[IPH_HL(&cs->cs_ip)]) {
+          && *(u32_t *)th == ((u32_t *)&cs->cs_ip)[IPH_HL(&cs->cs_ip)]) {
         goto found;
       }
     } while (cs != lastcs);
@@ -213,7 +227,7 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
      */
     INCR(vjs_misses);
     comp->last_cs = lcs;
-    hlen += TCPH_OFFSET(th);
+    hlen += TCPH_HDRLEN(th);
     hlen <<= 2;
     /* Check that the IP/TCP headers are contained in the first buffer. */
     if (hlen > pb->len) {
@@ -234,9 +248,9 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
     }
   }
 
-  oth = (struct tcp_hdr *)&((long *)&cs->cs_ip)[hlen];
+  oth = (struct tcp_hdr *)&((u32_t *)&cs->cs_ip)[hlen];
   deltaS = hlen;
-  hlen += TCPH_OFFSET(th);
+  hlen += TCPH_HDRLEN(th);
   hlen <<= 2;
   /* Check that the IP/TCP headers are contained in the first buffer. */
   if (hlen > pb->len) {
@@ -258,9 +272,9 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
   if (((u_short *)ip)[0] != ((u_short *)&cs->cs_ip)[0] 
       || ((u_short *)ip)[3] != ((u_short *)&cs->cs_ip)[3] 
       || ((u_short *)ip)[4] != ((u_short *)&cs->cs_ip)[4] 
-      || TCPH_OFFSET(th) != TCPH_OFFSET(oth) 
+      || TCPH_HDRLEN(th) != TCPH_HDRLEN(oth) 
       || (deltaS > 5 && BCMP(ip + 1, &cs->cs_ip + 1, (deltaS - 5) << 2)) 
-      || (TCPH_OFFSET(th) > 5 && BCMP(th + 1, oth + 1, (TCPH_OFFSET(th) - 5) << 2))) {
+      || (TCPH_HDRLEN(th) > 5 && BCMP(th + 1, oth + 1, (TCPH_HDRLEN(th) - 5) << 2))) {
     goto uncompressed;
   }
 
@@ -363,37 +377,26 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
   BCOPY(ip, &cs->cs_ip, hlen);
 
   /*
-   * We want to use the original packet as our compressed packet.
-   * (cp - new_seq) is the number of bytes we need for compressed
-   * sequence numbers.  In addition we need one byte for the change
-   * mask, one for the connection id and two for the tcp checksum.
-   * So, (cp - new_seq) + 4 bytes of header are needed.  hlen is how
-   * many bytes of the original packet to toss so subtract the two to
-   * get the new packet size.
+   * The compressed header stands in for the hlen octets of IP/TCP
+   * header.  (cp - new_seq) is the number of bytes we need for
+   * compressed sequence numbers.  In addition we need one byte for the
+   * change mask, one for the connection id (unless it is compressed)
+   * and two for the tcp checksum.
    */
   deltaS = (u_short)(cp - new_seq);
+  cp = hdr;
   if (!comp->compressSlot || comp->last_xmit != cs->cs_id) {
     comp->last_xmit = cs->cs_id;
-    hlen -= deltaS + 4;
-    if(pbuf_header(pb, -hlen)){
-      /* Can we cope with this failing?  Just assert for now */
-      LWIP_ASSERT("pbuf_header failed\n", 0);
-    }
-    cp = (u_char *)pb->payload;
     *cp++ = (u_char)(changes | NEW_C);
     *cp++ = cs->cs_id;
   } else {
-    hlen -= deltaS + 3;
-    if(pbuf_header(pb, -hlen)) {
-      /* Can we cope with this failing?  Just assert for now */
-      LWIP_ASSERT("pbuf_header failed\n", 0);
-    }
-    cp = (u_char *)pb->payload;
     *cp++ = (u_char)changes;
   }
   *cp++ = (u_char)(deltaA >> 8);
   *cp++ = (u_char)deltaA;
   BCOPY(new_seq, cp, deltaS);
+  *hdrlen = (u_int)(cp - hdr) + deltaS;
+  *skip = hlen;
   INCR(vjs_compressed);
   return (TYPE_COMPRESSED_TCP);
 
@@ -404,7 +407,12 @@ vj_compress_tcp(struct vjcompress *comp, struct pbuf *pb)
    */
 uncompressed:
   BCOPY(ip, &cs->cs_ip, hlen);
-  IPH_PROTO_SET(ip, cs->cs_id);
+  /* Send the IP header up to and including the protocol field (octet 9)
+     from hdr, with the connection id in place of the protocol. */
+  BCOPY(ip, hdr, 10);
+  hdr[9] = cs->cs_id;
+  *hdrlen = 10;
+  *skip = 10;
   comp->last_xmit = cs->cs_id;
   return (TYPE_UNCOMPRESSED_TCP);
 }
@@ -434,7 +442,7 @@ vj_uncompress_uncomp(struct pbuf *nb, struct vjcompress *comp)
   hlen = IPH_HL(ip) << 2;
   if (IPH_PROTO(ip) >= MAX_SLOTS
       || hlen + sizeof(struct tcp_hdr) > nb->len
-      || (hlen += TCPH_OFFSET(((struct tcp_hdr *)&((char *)ip)[hlen])) << 2)
+      || (hlen += TCPH_HDRLEN(((struct tcp_hdr *)&((char *)ip)[hlen])) << 2)
           > nb->len
       || hlen > MAX_HDR) {
     PPPDEBUG(LOG_INFO, ("vj_uncompress_uncomp: bad cid=%d, hlen=%d buflen=%d\n", 
@@ -499,6 +507,11 @@ vj_uncompress_tcp(struct pbuf **nb, struct vjcompress *comp)
     }
   }
   cs = &comp->rstate[comp->last_recv];
+  if (cs->cs_hlen == 0) {
+    /* no uncompressed packet has set up this connection id yet */
+    PPPDEBUG(LOG_INFO, ("vj_uncompress_tcp: cid=%d not set up\n", comp->last_recv));
+    goto bad;
+  }
   hlen = IPH_HL(&cs->cs_ip) << 2;
   th = (struct tcp_hdr *)&((u_char *)&cs->cs_ip)[hlen];
   th->chksum = htons((*cp << 8) | cp[1]);
@@ -620,6 +633,8 @@ vj_uncompress_tcp(struct pbuf **nb, struct vjcompress *comp)
     }
     pbuf_free(n0);
     n0 = np;
+    /* the caller frees the new chain if we fail from here on */
+    *nb = n0;
   }
 
   if(pbuf_header(n0, cs->cs_hlen)) {
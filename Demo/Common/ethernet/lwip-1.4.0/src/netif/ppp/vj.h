@@ -30,6 +30,7 @@
 
 #define MAX_SLOTS 16 /* must be > 2 and < 256 */
 #define MAX_HDR   128
+#define MAX_VJHDR 20  /* longest compressed header: changes, cid, checksum, deltas */
 
 /*
  * Compressed packet format:
@@ -147,8 +148,9 @@ struct vjcompress {
 /* flag values */
 #define VJF_TOSS 1U /* tossing rcvd frames because of input err */
 
-extern void  vj_compress_init    (struct vjcompress *comp);
-extern u_int vj_compress_tcp     (struct vjcompress *comp, struct pbuf *pb);
+extern void  vj_compress_init    (struct vjcompress *comp, u_char maxSlotIndex, u_char compressSlot);
+extern u_int vj_compress_tcp     (struct vjcompress *comp, struct pbuf *pb,
+                                  u_char *hdr, u_int *hdrlen, u_int *skip);
 extern void  vj_uncompress_err   (struct vjcompress *comp);
 extern int   vj_uncompress_uncomp(struct pbuf *nb, struct vjcompress *comp);
 extern int   vj_uncompress_tcp   (struct pbuf **nb, struct vjcompress *comp);
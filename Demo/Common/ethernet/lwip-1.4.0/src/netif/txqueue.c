@@ -0,0 +1,222 @@
+/**
+ * @file
+ * Strict priority transmit queues
+ *
+ * txqueue_attach() puts a set of TXQUEUE_CLASSES queues in front of the
+ * linkoutput function of a netif.  Each frame is given a traffic class from
+ * its VLAN priority (PCP) or, for untagged IP, the precedence bits of its
+ * DSCP - which sockets set with the IP_TOS option.  While the driver has
+ * room frames go straight through.  Once the driver's own transmit ring is
+ * full, linkoutput returns ERR_WOULDBLOCK and frames wait here, and each
+ * time the driver frees descriptors it calls txqueue_kick(), which sends
+ * the waiting frames highest class first.  A control frame then only waits
+ * for the frames already in the ring, not for every bulk frame queued
+ * before it.
+ *
+ * Keep the driver's ring short: frames in the ring can not be overtaken.
+ * Queued frames are held by reference, as etharp queues them, so a sender
+ * must not modify a pbuf after passing it to the stack.
+ */
+
+/*
+ * Copyright (c) 2001-2004 Swedish Institute of Computer Science.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include "lwip/opt.h"
+
+#if LWIP_TXQUEUE /* don't build if not configured for use in lwipopts.h */
+
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/snmp.h"
+#include "lwip/ip.h"
+#include "netif/etharp.h"
+#include "netif/txqueue.h"
+
+/** all attached queues, looked up by netif in txqueue_output() */
+static struct txqueue *txqueue_list;
+
+static err_t txqueue_output(struct netif *netif, struct pbuf *p);
+static void txqueue_run(struct txqueue *txq);
+
+/**
+ * Queue the frames sent on netif through txq.  Call after the driver has
+ * set netif->linkoutput, from the tcpip thread or before it is started.
+ */
+void
+txqueue_attach(struct netif *netif, struct txqueue *txq)
+{
+  u8_t c;
+
+  txq->netif = netif;
+  txq->linkoutput = netif->linkoutput;
+  for (c = 0; c < TXQUEUE_CLASSES; c++) {
+    txq->first[c] = 0;
+    txq->count[c] = 0;
+    txq->drops[c] = 0;
+  }
+  txq->next = txqueue_list;
+  txqueue_list = txq;
+
+  netif->linkoutput = txqueue_output;
+}
+
+/**
+ * Send queued frames until the driver is full again.  Called by the driver
+ * from the tcpip thread when transmit descriptors have been freed.
+ */
+void
+txqueue_kick(struct netif *netif)
+{
+  struct txqueue *txq;
+
+  for (txq = txqueue_list; txq != NULL; txq = txq->next) {
+    if (txq->netif == netif) {
+      txqueue_run(txq);
+      return;
+    }
+  }
+}
+
+/**
+ * The traffic class of an ethernet frame, 0 (lowest) to TXQUEUE_CLASSES - 1.
+ * ARP is given the highest class as control traffic waits on it.
+ */
+u8_t
+txqueue_classify(struct pbuf *p)
+{
+  struct eth_hdr *ethhdr;
+  struct ip_hdr *iphdr;
+  u16_t type;
+  u8_t prio;
+
+  if (p->len < SIZEOF_ETH_HDR) {
+    return 0;
+  }
+  ethhdr = (struct eth_hdr *)p->payload;
+  type = ethhdr->type;
+
+  if (type == PP_HTONS(ETHTYPE_VLAN)) {
+    /* the PCP is the top 3 bits of the tag; the tag follows the header like
+       a VLAN tagged frame received through etharp */
+    if (p->len < SIZEOF_ETH_HDR + 4) {
+      return 0;
+    }
+    prio = (u8_t)(((u8_t *)p->payload)[SIZEOF_ETH_HDR] >> 5);
+  } else if (type == PP_HTONS(ETHTYPE_ARP)) {
+    prio = 7;
+  } else if (type == PP_HTONS(ETHTYPE_IP)) {
+    if (p->len < SIZEOF_ETH_HDR + IP_HLEN) {
+      return 0;
+    }
+    iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+    prio = TXQUEUE_DSCP_PRIO(IPH_TOS(iphdr) >> 2);
+  } else {
+    prio = 0;
+  }
+
+  return (u8_t)((prio * TXQUEUE_CLASSES) / 8);
+}
+
+/**
+ * linkoutput function of an attached netif.
+ */
+static err_t
+txqueue_output(struct netif *netif, struct pbuf *p)
+{
+  struct txqueue *txq;
+  err_t err;
+  u8_t c, queued;
+
+  for (txq = txqueue_list; txq->netif != netif; txq = txq->next) {
+    LWIP_ASSERT("netif has no txqueue", txq->next != NULL);
+  }
+
+  queued = 0;
+  for (c = 0; c < TXQUEUE_CLASSES; c++) {
+    queued |= txq->count[c];
+  }
+
+  if (!queued) {
+    /* nothing to overtake, so try the driver first */
+    err = txq->linkoutput(netif, p);
+    if (err != ERR_WOULDBLOCK) {
+      return err;
+    }
+  }
+
+  c = txqueue_classify(p);
+  if (txq->count[c] == TXQUEUE_LEN) {
+    txq->drops[c]++;
+    LINK_STATS_INC(link.drop);
+    snmp_inc_ifoutdiscards(netif);
+    return ERR_MEM;
+  }
+
+  pbuf_ref(p);
+  txq->frames[c][(txq->first[c] + txq->count[c]) % TXQUEUE_LEN] = p;
+  txq->count[c]++;
+
+  /* the ring may have drained since the last kick */
+  if (queued) {
+    txqueue_run(txq);
+  }
+  return ERR_OK;
+}
+
+/**
+ * Send from the highest class with frames waiting until all are sent or the
+ * driver is full.  A frame the driver refuses for any other reason is
+ * dropped.
+ */
+static void
+txqueue_run(struct txqueue *txq)
+{
+  struct pbuf *p;
+  u8_t c;
+
+  c = TXQUEUE_CLASSES;
+  while (c > 0) {
+    if (txq->count[c - 1] == 0) {
+      c--;
+      continue;
+    }
+    p = txq->frames[c - 1][txq->first[c - 1]];
+    if (txq->linkoutput(txq->netif, p) == ERR_WOULDBLOCK) {
+      return;
+    }
+    txq->first[c - 1] = (u8_t)((txq->first[c - 1] + 1) % TXQUEUE_LEN);
+    txq->count[c - 1]--;
+    pbuf_free(p);
+    /* a higher class can not have been queued meanwhile, so carry on in
+       this one */
+  }
+}
+
+#endif /* LWIP_TXQUEUE */
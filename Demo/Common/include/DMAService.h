@@ -0,0 +1,165 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef DMA_SERVICE_H
+#define DMA_SERVICE_H
+
+/* The maximum number of channels, numbered from 0, the port layer can drive. */
+#ifndef dmaMAX_CHANNELS
+	#define dmaMAX_CHANNELS					( 8 )
+#endif
+
+/* The number of words at the start of each descriptor that belong to the port
+layer - enough for the linked list item of the LPC17xx GPDMA. */
+#ifndef dmaDESCRIPTOR_PORT_WORDS
+	#define dmaDESCRIPTOR_PORT_WORDS		( 4 )
+#endif
+
+/* Values for the ucDirection member of xDMAChannelConfig. */
+#define dmaMEMORY_TO_MEMORY					( 0U )
+#define dmaMEMORY_TO_PERIPHERAL				( 1U )
+#define dmaPERIPHERAL_TO_MEMORY				( 2U )
+
+/* Bits of the ucIncrement member of xDMAChannelConfig. */
+#define dmaINCREMENT_SOURCE					( 0x01U )
+#define dmaINCREMENT_DESTINATION			( 0x02U )
+
+typedef void * xDMAChannelHandle;
+
+/* How a channel is used.  Normally const, as it is referenced, not copied, by
+the channel it is allocated to. */
+typedef struct xDMA_CHANNEL_CONFIG
+{
+	unsigned long ulRequest;		/*< The peripheral request that paces the transfers, numbered as described by the port layer.  Not used for memory to memory transfers. */
+	unsigned char ucDirection;		/*< dmaMEMORY_TO_MEMORY, dmaMEMORY_TO_PERIPHERAL or dmaPERIPHERAL_TO_MEMORY. */
+	unsigned char ucWidth;			/*< The size of each transfer in bytes - 1, 2 or 4. */
+	unsigned char ucIncrement;		/*< dmaINCREMENT_SOURCE and/or dmaINCREMENT_DESTINATION, or 0 to move each transfer between the same two addresses. */
+	unsigned char ucPriority;		/*< 0 (lowest) to 3, for controllers that arbitrate by a programmed priority.  Other controllers ignore it. */
+} xDMAChannelConfig;
+
+/* One block of a transfer.  Descriptors can be chained through pxNext to move
+several blocks, for example a scatter list or the two halves of a ring buffer,
+with a single completion.  A chain belongs to the channel from being started
+until it has completed or been aborted, and must not be on the stack of a task
+that could return before then. */
+typedef struct xDMA_DESCRIPTOR
+{
+	unsigned long ulPort[ dmaDESCRIPTOR_PORT_WORDS ];	/*< Used by the port layer, for example as the hardware linked list item.  First, so it is word aligned. */
+	const volatile void *pvSource;			/*< Where the first transfer is read from. */
+	volatile void *pvDestination;			/*< Where the first transfer is written to. */
+	unsigned short usCount;					/*< The number of transfers of ucWidth bytes.  Must not be 0. */
+	struct xDMA_DESCRIPTOR *pxNext;			/*< The next block of the chain, or NULL. */
+} xDMADescriptor;
+
+/* Called when a chain has completed, with pdPASS or pdFAIL for a bus error.
+See xDMAChannelStart(). */
+typedef void ( *xDMACallback )( xDMAChannelHandle xChannel, void *pvContext, portBASE_TYPE xResult );
+
+/* The utilisation counters of a channel, cleared when it is allocated. */
+typedef struct xDMA_CHANNEL_STATS
+{
+	unsigned long ulChains;				/*< The number of chains started. */
+	unsigned long ulErrors;				/*< The number of chains that ended with a bus error. */
+	unsigned long ulBytes;				/*< The number of bytes moved by chains that completed without error. */
+	unsigned long ulBusyTicks;			/*< The number of ticks for which a chain was in progress. */
+	unsigned long ulCallbacksLost;		/*< Completions whose callback was dropped as the timer command queue was full. */
+} xDMAChannelStats;
+
+/* Initialise the port layer.  Must be called once, before any channel is
+allocated.  Returns pdFAIL if the port layer could not be initialised. */
+portBASE_TYPE xDMAServiceInit( void );
+
+/* Allocate the lowest numbered free channel that can serve pxConfig.  On some
+controllers a peripheral request is wired to a single channel, in which case
+only that channel is tried.  Returns NULL if no suitable channel is free. */
+xDMAChannelHandle xDMAChannelAllocate( const xDMAChannelConfig *pxConfig );
+
+/* Release a channel, aborting its chain if one is in progress. */
+void vDMAChannelFree( xDMAChannelHandle xChannel );
+
+/* Start a chain on a channel that is not busy.  vCallback, which can be NULL,
+is called with pvContext once the chain has completed - not from the DMA
+interrupt, but from the timer service (daemon) task through
+xTimerPendFunctionCallFromISR(), so it can use any API function that does not
+block, and can start the next chain straight away.  Returns pdFAIL if the
+channel is busy or the port layer cannot handle a descriptor of the chain, for
+example as it has more transfers than the controller can count. */
+portBASE_TYPE xDMAChannelStart( xDMAChannelHandle xChannel, xDMADescriptor *pxChain, xDMACallback vCallback, void *pvContext );
+
+/* Stop the chain in progress on a channel, if any.  Its callback is not
+called. */
+void vDMAChannelAbort( xDMAChannelHandle xChannel );
+
+/* Returns pdTRUE while a chain is in progress on the channel. */
+portBASE_TYPE xDMAChannelIsBusy( xDMAChannelHandle xChannel );
+
+/* Copy the utilisation counters of a channel into pxStats. */
+void vDMAChannelGetStats( xDMAChannelHandle xChannel, xDMAChannelStats *pxStats );
+
+/* Called by the port layer from its DMA interrupt when the chain started by
+xDMAPortStart() has completed, or stopped with a bus error. */
+void vDMAChannelDoneFromISR( unsigned portBASE_TYPE uxChannel, portBASE_TYPE xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/* The port layer, supplied by the board.  uxDMAPortInit() returns the number
+of channels, which must not be more than dmaMAX_CHANNELS, or 0 on failure.
+ulDMAPortChannelsFor() returns a bit mask of the channels that can serve
+pxConfig.  xDMAPortStart() starts a chain on a channel that is idle and returns
+at once, or returns pdFAIL without starting if it cannot handle the chain.
+vDMAPortAbort() stops a channel and clears its interrupts. */
+unsigned portBASE_TYPE uxDMAPortInit( void );
+unsigned long ulDMAPortChannelsFor( const xDMAChannelConfig *pxConfig );
+portBASE_TYPE xDMAPortStart( unsigned portBASE_TYPE uxChannel, const xDMAChannelConfig *pxConfig, xDMADescriptor *pxChain );
+void vDMAPortAbort( unsigned portBASE_TYPE uxChannel );
+
+#endif /* DMA_SERVICE_H */
+
@@ -0,0 +1,89 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include "ring_buffer.h"
+
+/* The number of arguments a log record can carry. */
+#define logMAX_ARGUMENTS	( 4 )
+
+typedef void * xLogChannelHandle;
+
+/* Called by the drain task with each formatted line, including the
+terminating "\r\n".  Writes the line to a UART, a file, a socket, etc. */
+typedef void ( *pdLOG_OUTPUT_FUNCTION )( const char *pcLine );
+
+/* Create a channel that can hold uxRecords unread records (a power of two).
+Each channel must only be written by one task, or by one interrupt. */
+xLogChannelHandle xLogCreateChannel( const char *pcName, unsigned portBASE_TYPE uxRecords );
+
+/* Store a record in a channel without formatting it.  pcFormat and any
+string arguments must remain valid until the drain task has formatted the
+record, so should normally be literals.  Returns pdFAIL, and counts the record
+as lost, if the channel is full. */
+portBASE_TYPE xLogWrite( xLogChannelHandle xChannel, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+portBASE_TYPE xLogWriteFromISR( xLogChannelHandle xChannel, const char *pcFormat, unsigned long ulArg1, unsigned long ulArg2, unsigned long ulArg3, unsigned long ulArg4 );
+
+#define xLogWrite0( xChannel, pcFormat )					xLogWrite( ( xChannel ), ( pcFormat ), 0UL, 0UL, 0UL, 0UL )
+#define xLogWrite1( xChannel, pcFormat, a )					xLogWrite( ( xChannel ), ( pcFormat ), ( unsigned long ) ( a ), 0UL, 0UL, 0UL )
+#define xLogWrite2( xChannel, pcFormat, a, b )				xLogWrite( ( xChannel ), ( pcFormat ), ( unsigned long ) ( a ), ( unsigned long ) ( b ), 0UL, 0UL )
+#define xLogWrite3( xChannel, pcFormat, a, b, c )			xLogWrite( ( xChannel ), ( pcFormat ), ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), 0UL )
+#define xLogWrite4( xChannel, pcFormat, a, b, c, d )		xLogWrite( ( xChannel ), ( pcFormat ), ( unsigned long ) ( a ), ( unsigned long ) ( b ), ( unsigned long ) ( c ), ( unsigned long ) ( d ) )
+
+/* Start the task that formats the records of all channels and passes them to
+vOutput.  It should run at a low priority. */
+portBASE_TYPE xLogStartDrainTask( unsigned portBASE_TYPE uxPriority, pdLOG_OUTPUT_FUNCTION vOutput );
+
+#endif /* DEFERRED_LOG_H */
@@ -0,0 +1,198 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef FIRMWARE_UPDATE_H
+#define FIRMWARE_UPDATE_H
+
+/*
+ * Writes a firmware image received over the network into an update region of
+ * flash without holding up the network task.  The TCP server that receives
+ * the image - lwip-1.4.0/apps/fwupdate for lwIP, FreeTCPIP/apps/fwupdate for
+ * uIP - copies the data into one of fwupdateBUFFER_COUNT buffers and hands
+ * each full buffer to a writer task, then carries on receiving into the next
+ * buffer while the writer programs the last.  Once the length of the image
+ * is known the writer erases the sectors it needs one at a time whenever it
+ * has nothing to program, so the erases are done while the data is still
+ * arriving instead of when it is to be written.  Each buffer is read back and
+ * compared after it has been programmed, and a CRC-32 of the whole image is
+ * checked against the one the sender gave.  When every buffer is in use the
+ * server stops reading from its connection, so TCP flow control slows the
+ * sender down to the rate the flash can be written.
+ *
+ * The image is sent to port fwupdatePORT as a 12 byte header followed by the
+ * image itself:
+ *
+ *   | 'F' 'W' 'U' 'P' | image length | CRC-32 of the image |
+ *
+ * Both numbers are 32 bits, big endian.  The CRC-32 is the one used by
+ * Ethernet and zip (reflected polynomial 0xEDB88320, initial value and final
+ * XOR 0xFFFFFFFF), as returned by Python's zlib.crc32().  Once the whole
+ * image has been written the server replies "OK\r\n", or "ERROR <n>\r\n"
+ * where n is one of the fwupdateERR_ codes below, and closes the connection.
+ * For example, from a PC:
+ *
+ *   python3 -c "import sys,struct,zlib;d=open(sys.argv[1],'rb').read();
+ *     sys.stdout.buffer.write(b'FWUP'+struct.pack('>II',len(d),zlib.crc32(d))+d)"
+ *     image.bin > image.fwu
+ *   nc -q 30 <board IP> 6970 < image.fwu
+ *
+ * The update region is only written to.  Switching over to the new image,
+ * normally by a boot loader that checks and copies the region, is left to
+ * the completion callback of the server.
+ *
+ * The board supplies the flash driver functions declared at the end of this
+ * file.  A sector erase on internal flash usually stops the CPU fetching from
+ * the same bank, so the erases only overlap with the reception when the
+ * update region is in a different bank, or in an external flash, from the
+ * code and interrupt vectors.
+ */
+
+/* The TCP port the update servers listen on. */
+#ifndef fwupdatePORT
+	#define fwupdatePORT					6970
+#endif
+
+/* The update region.  Addresses passed to the flash functions are offsets
+from the start of it. */
+#ifndef fwupdateSECTOR_SIZE
+	#define fwupdateSECTOR_SIZE				( 4096UL )
+#endif
+
+#ifndef fwupdateSECTOR_COUNT
+	#define fwupdateSECTOR_COUNT			( 64UL )
+#endif
+
+/* The size and number of the receive buffers.  A full buffer is programmed
+in one call, so the sector size must be a multiple of the buffer size.  Two
+buffers are enough for one to fill while the other is written, more absorb
+the time taken by the erases that could not be done in advance. */
+#ifndef fwupdateBUFFER_SIZE
+	#define fwupdateBUFFER_SIZE				( 1024UL )
+#endif
+
+#ifndef fwupdateBUFFER_COUNT
+	#define fwupdateBUFFER_COUNT			( 2 )
+#endif
+
+/* The length of the header that starts a transfer. */
+#define fwupdateHEADER_LENGTH				( 12 )
+
+/* The results of an update. */
+#define fwupdateOK							( 0 )
+#define fwupdateBUSY						( 1 )
+#define fwupdateERR_HEADER					( 2 )	/* The header was not valid, or the image does not fit in the update region. */
+#define fwupdateERR_LENGTH					( 3 )	/* More or less data was received than the header gave. */
+#define fwupdateERR_ERASE					( 4 )	/* xFirmwareUpdateFlashErase() failed. */
+#define fwupdateERR_PROGRAM					( 5 )	/* xFirmwareUpdateFlashProgram() failed. */
+#define fwupdateERR_VERIFY					( 6 )	/* The flash did not read back as it was programmed. */
+#define fwupdateERR_CRC						( 7 )	/* The data received did not match the CRC-32 in the header. */
+#define fwupdateERR_ABORTED					( 8 )	/* The connection failed before the whole image was received. */
+
+/* Called by a server with the result of each update, after the reply has
+been sent.  This is where a new image would be handed to the boot loader. */
+typedef void ( * pdFIRMWARE_UPDATE_CALLBACK )( portBASE_TYPE xResult );
+
+/*
+ * Create the writer task, at priority uxPriority, and the buffers.  The
+ * writer should run below the network task, so that it programs the flash
+ * in the time the network task leaves free.  Returns pdPASS, or pdFAIL if
+ * there was not enough heap.
+ */
+portBASE_TYPE xFirmwareUpdateInit( unsigned portBASE_TYPE uxPriority );
+
+/*
+ * The functions below are used by the servers.  Only one update can be in
+ * progress, and they must all be called from the same task.
+ *
+ * xFirmwareUpdateBegin() starts an update from the header of a transfer,
+ * returning fwupdateOK, fwupdateBUSY if the last update has not finished, or
+ * fwupdateERR_HEADER.
+ */
+portBASE_TYPE xFirmwareUpdateBegin( const unsigned char *pucHeader );
+
+/*
+ * Pass image data to the writer.  Up to xTicksToWait is spent waiting for
+ * each buffer to become free.  Returns the number of bytes taken, which is
+ * less than ulLength if a buffer did not become free in time or if the
+ * update has already failed.
+ */
+unsigned long ulFirmwareUpdateWrite( const void *pvData, unsigned long ulLength, portTickType xTicksToWait );
+
+/*
+ * The number of bytes ulFirmwareUpdateWrite() can take without waiting, or
+ * that it would have been able to take had the update not failed.
+ */
+unsigned long ulFirmwareUpdateSpace( void );
+
+/*
+ * Finish the update once the whole image has been passed to
+ * ulFirmwareUpdateWrite(), or stop it early after an error.  The writer
+ * completes the update in the background - see xFirmwareUpdateGetResult().
+ */
+void vFirmwareUpdateEnd( void );
+void vFirmwareUpdateAbort( void );
+
+/*
+ * Wait up to xTicksToWait for the writer to complete the update, then return
+ * its result - fwupdateBUSY if it is still in progress.
+ */
+portBASE_TYPE xFirmwareUpdateGetResult( portTickType xTicksToWait );
+
+/* Flash driver functions, supplied by the board.  They are only called from
+the writer task, and each returns pdPASS on success.  Programming only clears
+bits, erasing sets a whole sector to 0xff. */
+portBASE_TYPE xFirmwareUpdateFlashErase( unsigned long ulSector );
+portBASE_TYPE xFirmwareUpdateFlashProgram( unsigned long ulOffset, const void *pvData, unsigned long ulLength );
+portBASE_TYPE xFirmwareUpdateFlashRead( unsigned long ulOffset, void *pvBuffer, unsigned long ulLength );
+
+#endif /* FIRMWARE_UPDATE_H */
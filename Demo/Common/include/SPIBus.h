@@ -0,0 +1,125 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+/* The byte sent by a transaction that has no transmit data. */
+#define spiFILL_BYTE		( 0xffU )
+
+/* The maximum number of buses, numbered from 0, the port layer can drive. */
+#ifndef spiMAX_BUSES
+	#define spiMAX_BUSES	( 2 )
+#endif
+
+typedef void * xSPIBusHandle;
+
+/* How a device is driven.  Normally const, as the bus task only reads it. */
+typedef struct xSPI_DEVICE
+{
+	unsigned long ulClockHz;						/*< The fastest SCK frequency the device accepts.  The port uses the fastest rate it can generate that is not above it. */
+	unsigned char ucMode;							/*< SPI mode 0 to 3.  Bit 1 is the clock polarity (CPOL) and bit 0 the clock phase (CPHA). */
+	void ( *vChipSelect )( portBASE_TYPE xSelect );	/*< Drives the chip select of the device - asserted when xSelect is pdTRUE.  Called from the bus task. */
+} xSPIDevice;
+
+/* A transfer to or from one device.  Transactions can be chained through
+pxNext, for example a command followed by the data it reads, in which case the
+chip select is kept asserted from the start of the first to the end of the
+last, and only the pxDevice, vCallback, pvContext and xResult of the first are
+used.  A transaction, and the buffers it points to, belong to the bus task
+from being queued until it has completed. */
+typedef struct xSPI_TRANSACTION
+{
+	const xSPIDevice *pxDevice;			/*< The device to select. */
+	const unsigned char *pucTxData;		/*< The bytes to send, or NULL to send spiFILL_BYTE. */
+	unsigned char *pucRxData;			/*< Where the received bytes are stored, or NULL to discard them. */
+	unsigned short usLength;			/*< The number of bytes to transfer. */
+	struct xSPI_TRANSACTION *pxNext;	/*< The next transaction of the chain, or NULL. */
+	void ( *vCallback )( struct xSPI_TRANSACTION *pxTransaction );	/*< Called from the bus task when the chain has completed.  Can be NULL. */
+	void *pvContext;					/*< Free for use by the callback. */
+	xTaskHandle xNotifyTask;			/*< Given a task notification when the chain has completed, after any callback.  Can be NULL. */
+	portBASE_TYPE xResult;				/*< pdPASS if every transfer of the chain completed, valid on completion. */
+} xSPITransaction;
+
+/* Create the task that runs the transactions queued to bus uxBus, one after
+the other.  Up to uxQueueLength transactions can be waiting.  The bus task
+should have a higher priority than the tasks that use the bus, so the bus is
+never left idle while transactions are queued.  Returns NULL if the bus is
+already open, or there was not enough heap. */
+xSPIBusHandle xSPIBusOpen( unsigned portBASE_TYPE uxBus, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxPriority );
+
+/* Queue a transaction.  Returns pdPASS when queued, after which the transaction
+completes through its callback and task notification. */
+portBASE_TYPE xSPIBusSubmit( xSPIBusHandle xBus, xSPITransaction *pxTransaction, portTickType xTicksToWait );
+
+/* Queue a transaction and wait for it to complete, using the task notification
+of the calling task.  Other tasks run while the transfer is in progress.
+Returns the xResult of the transaction, or pdFAIL if it could not be queued
+within xTicksToWait.  Needs INCLUDE_xTaskGetCurrentTaskHandle to be 1. */
+portBASE_TYPE xSPIBusTransfer( xSPIBusHandle xBus, xSPITransaction *pxTransaction, portTickType xTicksToWait );
+
+/* Called by the port layer from its DMA interrupt when the transfer started by
+xSPIPortStart() has ended. */
+void vSPIBusTransferDoneFromISR( unsigned portBASE_TYPE uxBus, portBASE_TYPE xResult, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/* The port layer, supplied by the board.  These are only called from the bus
+task of uxBus, one transfer at a time.  xSPIPortStart() starts a full duplex
+DMA transfer of usLength bytes and returns at once - pucTxData and pucRxData
+can be NULL as for xSPITransaction.  vSPIPortAbort() stops a transfer that has
+not ended within spiTRANSFER_TIMEOUT. */
+portBASE_TYPE xSPIPortInit( unsigned portBASE_TYPE uxBus );
+void vSPIPortConfigure( unsigned portBASE_TYPE uxBus, const xSPIDevice *pxDevice );
+portBASE_TYPE xSPIPortStart( unsigned portBASE_TYPE uxBus, const unsigned char *pucTxData, unsigned char *pucRxData, unsigned short usLength );
+void vSPIPortAbort( unsigned portBASE_TYPE uxBus );
+
+#endif /* SPI_BUS_H */
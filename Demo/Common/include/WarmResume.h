@@ -0,0 +1,136 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Warm resume from a power down that does not retain RAM, such as the
+ * hibernation mode of the LM3S parts, in which only a few words of battery
+ * backed memory and the real time clock keep running.
+ *
+ * Nothing but those few words survives, so the tasks, queues and network
+ * stack are created again on every wake.  What is saved is what makes a cold
+ * boot slow: the state an application has to rediscover or renegotiate, such
+ * as the address and remaining time of a DHCP lease, the position in a
+ * reporting cycle, or calibration results.  The application collects that
+ * into a structure and passes it to xWarmResumeHibernate().  On the next
+ * boot xWarmResumeInit() gives the structure back, and sets the tick count
+ * the scheduler starts from to the tick count at the power down plus the time
+ * spent powered down, as measured by the real time clock.  Delays and time
+ * stamps that span the power down therefore stay correct to within the
+ * resolution of the clock, and the application can restart the network
+ * interface with the saved lease rather than waiting for a new one.
+ *
+ * A snapshot is only used once, and is only used after a wake from the power
+ * down - a reset or a power cycle always results in a cold boot.
+ *
+ * The port layer is in the demo directory of each board - for example
+ * Demo/CORTEX_LM3Sxxxx_Rowley/Hibernate for the LM3S hibernation module.
+ * INCLUDE_vTaskSetInitialTickCount must be set to 1 in FreeRTOSConfig.h.
+ */
+
+#ifndef WARM_RESUME_H
+#define WARM_RESUME_H
+
+#include <stddef.h>
+
+/* The number of words of retained memory used to describe the snapshot.  The
+rest of the retained memory holds the application state. */
+#define wrHEADER_WORDS					( 6UL )
+
+/* The largest application state, in bytes, that a part with ulRetainedWords
+words of retained memory can save - 232 bytes on the LM3S parts. */
+#define wrMAX_STATE_SIZE( ulRetainedWords )	( ( size_t ) ( ( ( ulRetainedWords ) - wrHEADER_WORDS ) * sizeof( unsigned long ) ) )
+
+/* Must be called from main(), before the scheduler is started, and before any
+other use of the retained memory or the real time clock.  Returns pdTRUE if
+the processor has woken from a power down entered by xWarmResumeHibernate()
+and the snapshot taken then is intact, in which case xStateSize bytes of the
+saved application state have been copied to pvState and the scheduler will
+start from the corrected tick count.  Returns pdFALSE for a cold boot, or if
+xStateSize does not match the size that was saved, in which case pvState is
+not written. */
+portBASE_TYPE xWarmResumeInit( void *pvState, size_t xStateSize );
+
+/* Saves the tick count, the time of the real time clock and xStateSize bytes
+of the application state from pvState, then powers down.  The processor
+wakes, and boots again, after ulSeconds seconds, or earlier on the wake pin
+where the port has one - with ulSeconds set to 0 only the pin wakes it.  Must be called from a task once
+the application has finished with its peripherals.  The scheduler is
+suspended from the time the tick count is taken, so the state saved is the
+state at that time.  Only returns, with pdFAIL, if xStateSize is larger than
+the retained memory can hold, or if the port could not power down. */
+portBASE_TYPE xWarmResumeHibernate( const void *pvState, size_t xStateSize, unsigned long ulSeconds );
+
+/*-----------------------------------------------------------*/
+
+/* The port layer.  Not called by the application. */
+
+/* Prepare the power down hardware and report whether this boot is a wake from
+a power down entered by vWarmResumePortHibernate(). */
+portBASE_TYPE xWarmResumePortInit( void );
+
+/* The number of words of retained memory. */
+unsigned long ulWarmResumePortWords( void );
+
+/* Copy ulWords words from or to the start of the retained memory. */
+void vWarmResumePortRead( unsigned long *pulData, unsigned long ulWords );
+void vWarmResumePortWrite( const unsigned long *pulData, unsigned long ulWords );
+
+/* The time of the real time clock, in seconds. */
+unsigned long ulWarmResumePortSeconds( void );
+
+/* Power down, waking after ulSeconds seconds (never if 0) or on the wake pin.
+Only returns if the power down could not be entered. */
+void vWarmResumePortHibernate( unsigned long ulSeconds );
+
+#endif /* WARM_RESUME_H */
+
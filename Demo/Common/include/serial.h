@@ -120,5 +120,27 @@ signed portBASE_TYPE xSerialPutChar( xComPortHandle pxPort, signed char cOutChar
 portBASE_TYPE xSerialWaitForSemaphore( xComPortHandle xPort );
 void vSerialClose( xComPortHandle xPort );
 
+/* Block transfer interface, implemented by drivers that move data with DMA.
+usSerialWrite() queues up to usLength bytes for transmission, waiting up to
+xBlockTime for buffer space, and returns the number queued.  usSerialRead()
+waits up to xBlockTime for data, then returns up to usMaxLength bytes. */
+unsigned short usSerialWrite( xComPortHandle pxPort, const signed char * const pcBuffer, unsigned short usLength, portTickType xBlockTime );
+unsigned short usSerialRead( xComPortHandle pxPort, signed char *pcBuffer, unsigned short usMaxLength, portTickType xBlockTime );
+
+/* Frame receive interface, implemented by DMA drivers built with
+serUSE_RX_FRAMES set to 1.  A frame ends when the line goes idle.  The data is
+left in the driver's DMA buffer, in two parts if it wraps around the end of
+the buffer, and stays there until the driver has received enough to come
+round to it again - xSerialFrameIsIntact() tells whether that has happened. */
+typedef struct xSERIAL_FRAME
+{
+	const unsigned char *pucData[ 2 ];
+	unsigned short usLength[ 2 ];
+	unsigned long ulEnd;		/* Driver count of bytes received at the end of the frame. */
+} xSerialFrame;
+
+portBASE_TYPE xSerialGetFrame( xComPortHandle pxPort, xSerialFrame *pxFrame, portTickType xBlockTime );
+portBASE_TYPE xSerialFrameIsIntact( xComPortHandle pxPort, const xSerialFrame *pxFrame );
+
 #endif
 
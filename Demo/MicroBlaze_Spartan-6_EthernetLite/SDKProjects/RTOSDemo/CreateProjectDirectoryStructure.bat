@@ -111,6 +111,7 @@ IF EXIST FreeRTOS_Source Goto END
     copy %LWIP_SOURCE%\src\include\lwip\*.h              lwIP\include\lwip
     copy %LWIP_SOURCE%\src\include\netif\*.h             lwIP\include\netif
     copy %LWIP_SOURCE%\src\netif\etharp.c                lwIP\netif
+    copy %LWIP_SOURCE%\src\netif\pcapring.c              lwIP\netif
     copy %LWIP_SOURCE%\ports\MicroBlaze-Ethernet-Lite    lwip\netif
     copy %LWIP_SOURCE%\ports\MicroBlaze-Ethernet-Lite\include\arch lwip\netif\include\arch
 
@@ -95,6 +95,40 @@ fs_free(struct fs_file *file)
   return;
 }
 
+#if HTTPD_USE_FATFS
+/*-----------------------------------------------------------------------------------*/
+/** Open a file that is not in fsdata.c from the FatFs volume. The data is
+ * left in the file, so file->data is NULL and httpd reads or forwards it. */
+static int
+fs_open_fatfs(struct fs_file *file, const char *name)
+{
+  char path[HTTPD_FATFS_MAX_PATH];
+
+  if (strlen(HTTPD_FATFS_ROOT) + strlen(name) >= sizeof(path)) {
+    return 0;
+  }
+  strcpy(path, HTTPD_FATFS_ROOT);
+  strcat(path, name);
+  if (f_open(&file->fil, path, FA_READ | FA_OPEN_EXISTING) != FR_OK) {
+    return 0;
+  }
+  file->is_fatfs_file = 1;
+  file->data = NULL;
+  file->len = (int)file->fil.fsize;
+  file->index = 0;
+  file->pextension = NULL;
+  file->http_header_included = 0;
+#if HTTPD_PRECALCULATED_CHECKSUM
+  file->chksum_count = 0;
+  file->chksum = NULL;
+#endif /* HTTPD_PRECALCULATED_CHECKSUM */
+#if LWIP_HTTPD_FILE_STATE
+  file->state = fs_state_init(file, name);
+#endif /* #if LWIP_HTTPD_FILE_STATE */
+  return 1;
+}
+#endif /* HTTPD_USE_FATFS */
+
 /*-----------------------------------------------------------------------------------*/
 struct fs_file *
 fs_open(const char *name)
@@ -115,6 +149,10 @@ fs_open(const char *name)
   file->is_custom_file = 0;
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 
+#if HTTPD_USE_FATFS
+  file->is_fatfs_file = 0;
+#endif /* HTTPD_USE_FATFS */
+
   for(f = FS_ROOT; f != NULL; f = f->next) {
     if (!strcmp(name, (char *)f->name)) {
       file->data = (const char *)f->data;
@@ -132,6 +170,13 @@ fs_open(const char *name)
       return file;
     }
   }
+
+#if HTTPD_USE_FATFS
+  if (fs_open_fatfs(file, name)) {
+    return file;
+  }
+#endif /* HTTPD_USE_FATFS */
+
   fs_free(file);
   return NULL;
 }
@@ -145,6 +190,11 @@ fs_close(struct fs_file *file)
     fs_close_custom(file);
   }
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
+#if HTTPD_USE_FATFS
+  if (file->is_fatfs_file) {
+    f_close(&file->fil);
+  }
+#endif /* HTTPD_USE_FATFS */
 #if LWIP_HTTPD_FILE_STATE
   fs_state_free(file, file->state);
 #endif /* #if LWIP_HTTPD_FILE_STATE */
@@ -165,6 +215,17 @@ fs_read(struct fs_file *file, char *buffer, int count)
     read = count;
   }
 
+#if HTTPD_USE_FATFS
+  if (file->is_fatfs_file) {
+    UINT br;
+    if ((f_read(&file->fil, buffer, (UINT)read, &br) != FR_OK) || (br == 0)) {
+      return -1;
+    }
+    file->index += (int)br;
+    return (int)br;
+  }
+#endif /* HTTPD_USE_FATFS */
+
   MEMCPY(buffer, (file->data + file->index), read);
   file->index += read;
 
@@ -52,6 +52,31 @@
 #define LWIP_HTTPD_FILE_STATE         0
 #endif
 
+/** Set this to 1 to serve files that are not in fsdata.c from a FatFs
+ * volume, looked up as HTTPD_FATFS_ROOT followed by the URI.  FatFs must be
+ * built with _FS_TINY and _USE_FORWARD set to 1, and LWIP_HTTPD_DYNAMIC_HEADERS
+ * is needed as the files carry no HTTP header.  The file data is passed from
+ * the FatFs sector window straight to tcp_write() by f_forward(), so it is
+ * only copied into the TCP send buffer.
+ */
+#ifndef HTTPD_USE_FATFS
+#define HTTPD_USE_FATFS               0
+#endif
+
+/** The FatFs directory holding the files served by HTTPD_USE_FATFS. */
+#ifndef HTTPD_FATFS_ROOT
+#define HTTPD_FATFS_ROOT              ""
+#endif
+
+/** The longest FatFs path, HTTPD_FATFS_ROOT included, that can be opened. */
+#ifndef HTTPD_FATFS_MAX_PATH
+#define HTTPD_FATFS_MAX_PATH          64
+#endif
+
+#if HTTPD_USE_FATFS
+#include "ff.h"
+#endif /* HTTPD_USE_FATFS */
+
 /** HTTPD_PRECALCULATED_CHECKSUM==1: include precompiled checksums for
  * predefined (MSS-sized) chunks of the files to prevent having to calculate
  * the checksums at runtime. */
@@ -83,6 +108,10 @@ struct fs_file {
 #if LWIP_HTTPD_FILE_STATE
   void *state;
 #endif /* LWIP_HTTPD_FILE_STATE */
+#if HTTPD_USE_FATFS
+  FIL fil;
+  u8_t is_fatfs_file;
+#endif /* HTTPD_USE_FATFS */
 };
 
 struct fs_file *fs_open(const char *name);
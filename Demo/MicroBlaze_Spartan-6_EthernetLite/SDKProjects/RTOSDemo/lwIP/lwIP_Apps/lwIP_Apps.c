@@ -65,6 +65,7 @@
 
 /* lwIP netif includes */
 #include "netif/etharp.h"
+#include "netif/pcapring.h"
 
 /* applications includes */
 #include "apps/httpserver_raw/httpd.h"
@@ -76,6 +77,10 @@ address are located at the bottom of FreeRTOSConfig.h. */
 #define LWIP_PORT_INIT_NETMASK(addr)  IP4_ADDR((addr), configNET_MASK0,configNET_MASK1,configNET_MASK2,configNET_MASK3)
 #define LWIP_MAC_ADDR_BASE            { configMAC_ADDR0, configMAC_ADDR1, configMAC_ADDR2, configMAC_ADDR3, configMAC_ADDR4, configMAC_ADDR5 }
 
+/* The TCP port from which the frames held by the capture ring can be fetched
+as a pcap file when LWIP_PCAPRING is set to 1 in lwipopts.h. */
+#define lwipappsPCAPRING_PORT	2002
+
 /* Definitions of the various SSI callback functions within the pccSSITags 
 array.  If pccSSITags is updated, then these definitions must also be updated. */
 #define ssiTASK_STATS_INDEX			0
@@ -123,6 +128,13 @@ static struct netif xNetIf;
 	/* Initialise the raw http server. */
 	httpd_init();
 
+	#if LWIP_PCAPRING
+	{
+		/* Serve the frames recorded by the capture ring. */
+		pcapring_server_init( lwipappsPCAPRING_PORT );
+	}
+	#endif
+
 	/* Install the server side include handler. */
 	http_set_ssi_handler( uslwIPAppsSSIHandler, pccSSITags, sizeof( pccSSITags ) / sizeof( char * ) );
 }
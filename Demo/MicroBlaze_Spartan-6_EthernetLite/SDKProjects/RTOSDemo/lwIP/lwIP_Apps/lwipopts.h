@@ -184,6 +184,23 @@ a lot of data that needs to be copied, this should be set high. */
    link level header. */
 #define PBUF_LINK_HLEN			16
 
+/* LWIP_SUPPORT_CUSTOM_PBUF: allows the Ethernet driver to pass its receive
+   buffers to the stack as custom pbufs rather than copying each frame into
+   pbufs from the pool. */
+#define LWIP_SUPPORT_CUSTOM_PBUF	1
+
+/* The DMA buffer pool (netif/dmabuf.c) is for MACs that move frames by DMA,
+   such as the AXI Ethernet with its DMA engine.  The Ethernet Lite MAC used
+   here is read and written by the CPU, so the pool is not used.  The cache
+   hooks are given so a DMA driver can run with the data cache enabled. */
+#define LWIP_DMABUF				0
+#if XPAR_MICROBLAZE_USE_DCACHE == 1
+	#include "mb_interface.h"
+	#define DMABUF_CACHE_LINE_SIZE	( XPAR_MICROBLAZE_DCACHE_LINE_LEN * 4 )
+	#define DMABUF_CACHE_FLUSH( addr, len )			microblaze_flush_dcache_range( ( unsigned ) ( addr ), ( unsigned ) ( len ) )
+	#define DMABUF_CACHE_INVALIDATE( addr, len )	microblaze_invalidate_dcache_range( ( unsigned ) ( addr ), ( unsigned ) ( len ) )
+#endif
+
 /** SYS_LIGHTWEIGHT_PROT
  * define SYS_LIGHTWEIGHT_PROT in lwipopts.h if you want inter-task protection
  * for certain critical regions during buffer allocation, deallocation and memory
@@ -230,6 +247,13 @@ a lot of data that needs to be copied, this should be set high. */
 #define ARP_TABLE_SIZE			10
 #define ARP_QUEUEING			1
 
+/* Set LWIP_PCAPRING to 1 to keep the start of recent frames in RAM, then
+connect to the port passed to pcapring_server_init() to fetch them as a pcap
+file.  Received frames are recorded from the Ethernet interrupt, so the
+timestamp must not come from sys_now(), which uses a critical section. */
+#define LWIP_PCAPRING			0
+#define PCAPRING_TIME_MS()		( ( u32_t ) ( xTaskGetTickCountFromISR() * portTICK_RATE_MS ) )
+
 
 /* ---------- IP options ---------- */
 /* Define IP_FORWARD to 1 if you wish to have the ability to forward
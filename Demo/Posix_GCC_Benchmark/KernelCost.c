@@ -0,0 +1,537 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Measures the cost of individual kernel functions, so a change to the kernel
+ * that makes one of them slower can be detected.  Each measured function is
+ * wrapped using the linker's --wrap option (see the makefile), so calls made
+ * to it from other source files pass through a wrapper that reads a counter
+ * before and after calling the real function.  Calls made from within the
+ * source file that defines the function are not measured.
+ *
+ * The counter is the number of instructions executed by the process if the
+ * host allows the hardware performance counters to be read.  With the
+ * simulator running in virtual time the execution of the whole application is
+ * deterministic, so the instruction counts are exactly repeatable and the
+ * smallest change to a kernel path shows.  If the performance counters cannot
+ * be used the processor's time stamp counter is used instead on x86 hosts, and
+ * the CPU time of the process in nanoseconds on other hosts.  These vary from
+ * run to run, so need a larger tolerance when results are compared.
+ *
+ * A call is only counted when the function completes without another task
+ * running, and without the tick or a context switch occurring part way
+ * through - otherwise the figure would include the cost of whatever ran in
+ * between.  The traceTASK_SWITCHED_IN() macro is used to detect context
+ * switches.  The calls that are not counted are still reported, as a change
+ * in their number shows that the behaviour of the application changed.  The
+ * cost of the wrapper itself is measured when the counter is selected and
+ * subtracted, including that of wrapped functions called by other wrapped
+ * functions (xTaskResumeAll() from within xQueueGenericSend() for example).
+ */
+
+/* Required for the system call and performance counter definitions. */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#ifdef __linux__
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "KernelCost.h"
+
+/* The counters that can be used. */
+#define kcostCOUNTER_INSTRUCTIONS	( 0 )
+#define kcostCOUNTER_CYCLES			( 1 )
+#define kcostCOUNTER_NANOSECONDS	( 2 )
+
+/* The number of measurements taken to find the cost of the wrapper. */
+#define kcostCALIBRATION_RUNS		( 64 )
+
+/* The longest function name that can be read from a baseline file. */
+#define kcostMAX_NAME_LEN			( 64 )
+
+/* The measured functions.  The order must match xFunctions[]. */
+#define kcostSWITCH_CONTEXT			( 0 )
+#define kcostINCREMENT_TICK			( 1 )
+#define kcostQUEUE_SEND				( 2 )
+#define kcostQUEUE_SEND_FROM_ISR	( 3 )
+#define kcostQUEUE_RECEIVE			( 4 )
+#define kcostRESUME_ALL				( 5 )
+#define kcostCALIBRATE				( 6 )
+#define kcostNUM_FUNCTIONS			( 6 )
+
+/* The figures kept for each measured function. */
+typedef struct KERNEL_COST_FUNCTION
+{
+	const char *pcName;
+	portBASE_TYPE xFromInterrupt;		/* pdTRUE if the function is only called from the tick or yield interrupt. */
+	unsigned long ulCalls;				/* Every call, whether counted or not. */
+	unsigned long ulSamples;			/* The calls that were counted. */
+	unsigned long ulMin;
+	unsigned long ulMax;
+	unsigned long long ullTotal;
+} xKernelCostFunction;
+
+/* The state saved by a wrapper before it calls the real function. */
+typedef struct KERNEL_COST_SAMPLE
+{
+	unsigned long ulInterrupts;
+	unsigned long long ullOverhead;
+	unsigned long ulStart;
+} xKernelCostSample;
+
+/* The real functions, provided by the linker. */
+void __real_vTaskSwitchContext( void );
+void __real_vTaskIncrementTick( void );
+signed portBASE_TYPE __real_xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE __real_xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE __real_xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking );
+signed portBASE_TYPE __real_xTaskResumeAll( void );
+
+/* The wrappers, called in place of the real functions. */
+void __wrap_vTaskSwitchContext( void );
+void __wrap_vTaskIncrementTick( void );
+signed portBASE_TYPE __wrap_xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE __wrap_xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE __wrap_xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking );
+signed portBASE_TYPE __wrap_xTaskResumeAll( void );
+
+/*
+ * Start and end the measurement of one call.
+ */
+static void prvBeginSample( unsigned long ulFunction, xKernelCostSample *pxSample );
+static void prvEndSample( unsigned long ulFunction, xKernelCostSample *pxSample );
+
+/*
+ * Measure the cost of the wrapper, so it can be subtracted from the figures.
+ */
+static void prvCalibrate( void );
+
+/*-----------------------------------------------------------*/
+
+/* The first kcostNUM_FUNCTIONS entries are reported.  The last is only used to
+measure the wrapper. */
+static xKernelCostFunction xFunctions[ kcostNUM_FUNCTIONS + 1 ] =
+{
+	{ "vTaskSwitchContext",			pdTRUE,		0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "vTaskIncrementTick",			pdTRUE,		0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "xQueueGenericSend",			pdFALSE,	0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "xQueueGenericSendFromISR",	pdFALSE,	0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "xQueueGenericReceive",		pdFALSE,	0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "xTaskResumeAll",				pdFALSE,	0UL, 0UL, 0UL, 0UL, 0ULL },
+	{ "calibrate",					pdFALSE,	0UL, 0UL, 0UL, 0UL, 0ULL }
+};
+
+static const char * const pcCounterUnits[] = { "instructions", "cycles", "nanoseconds" };
+
+static unsigned long ulCounterType = kcostCOUNTER_NANOSECONDS;
+static int iCounterFile = -1;
+
+/* Incremented by each context switch and by each measured call made from an
+interrupt.  A call made from a task is not counted if this changes while it is
+executing. */
+static unsigned long ulInterrupts = 0UL;
+
+/* The total cost of all the wrappers that have executed.  The increase during
+a call is subtracted from its cost, as it is the cost of measuring the wrapped
+functions it called. */
+static unsigned long long ullOverhead = 0ULL;
+
+/* The cost of reading the counter twice, which is included in every raw
+measurement, and the cost that a complete wrapper adds to the function that
+calls it. */
+static unsigned long ulReadCost = 0UL;
+static unsigned long ulWrapperCost = 0UL;
+
+/*-----------------------------------------------------------*/
+
+const char *pcKernelCostInit( void )
+{
+	#if defined( __linux__ ) && defined( PERF_COUNT_HW_INSTRUCTIONS )
+	{
+	struct perf_event_attr xAttributes;
+
+		memset( &xAttributes, 0x00, sizeof( xAttributes ) );
+		xAttributes.type = PERF_TYPE_HARDWARE;
+		xAttributes.size = sizeof( xAttributes );
+		xAttributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+		xAttributes.exclude_kernel = 1;
+		xAttributes.exclude_hv = 1;
+
+		iCounterFile = ( int ) syscall( SYS_perf_event_open, &xAttributes, 0, -1, -1, 0 );
+		if( iCounterFile >= 0 )
+		{
+			ulCounterType = kcostCOUNTER_INSTRUCTIONS;
+		}
+	}
+	#endif
+
+	#if defined( __i386__ ) || defined( __x86_64__ )
+	{
+		if( ulCounterType != kcostCOUNTER_INSTRUCTIONS )
+		{
+			ulCounterType = kcostCOUNTER_CYCLES;
+		}
+	}
+	#endif
+
+	prvCalibrate();
+
+	return pcCounterUnits[ ulCounterType ];
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulKernelCostGetCounter( void )
+{
+unsigned long ulCount = 0UL;
+
+	if( ulCounterType == kcostCOUNTER_INSTRUCTIONS )
+	{
+	unsigned long long ullCount;
+
+		if( read( iCounterFile, &ullCount, sizeof( ullCount ) ) == ( ssize_t ) sizeof( ullCount ) )
+		{
+			ulCount = ( unsigned long ) ullCount;
+		}
+	}
+	#if defined( __i386__ ) || defined( __x86_64__ )
+	else if( ulCounterType == kcostCOUNTER_CYCLES )
+	{
+		ulCount = ( unsigned long ) __builtin_ia32_rdtsc();
+	}
+	#endif
+	else
+	{
+	struct timespec xTime;
+
+		clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xTime );
+		ulCount = ( ( unsigned long ) xTime.tv_sec * 1000000000UL ) + ( unsigned long ) xTime.tv_nsec;
+	}
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+void vKernelCostTaskSwitchedIn( void )
+{
+	ulInterrupts++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBeginSample( unsigned long ulFunction, xKernelCostSample *pxSample )
+{
+	if( xFunctions[ ulFunction ].xFromInterrupt != pdFALSE )
+	{
+		ulInterrupts++;
+	}
+
+	pxSample->ulInterrupts = ulInterrupts;
+	pxSample->ullOverhead = ullOverhead;
+	pxSample->ulStart = ulKernelCostGetCounter();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEndSample( unsigned long ulFunction, xKernelCostSample *pxSample )
+{
+unsigned long ulCost, ulDeduction;
+xKernelCostFunction *pxFunction = &( xFunctions[ ulFunction ] );
+
+	ulCost = ulKernelCostGetCounter() - pxSample->ulStart;
+	pxFunction->ulCalls++;
+
+	/* A function called from an interrupt is never interrupted itself, but is
+	the cause of ulInterrupts changing. */
+	if( ( pxFunction->xFromInterrupt != pdFALSE ) || ( pxSample->ulInterrupts == ulInterrupts ) )
+	{
+		ulDeduction = ulReadCost + ( unsigned long ) ( ullOverhead - pxSample->ullOverhead );
+		if( ulCost > ulDeduction )
+		{
+			ulCost -= ulDeduction;
+		}
+		else
+		{
+			ulCost = 0UL;
+		}
+
+		if( ( pxFunction->ulSamples == 0UL ) || ( ulCost < pxFunction->ulMin ) )
+		{
+			pxFunction->ulMin = ulCost;
+		}
+
+		if( ulCost > pxFunction->ulMax )
+		{
+			pxFunction->ulMax = ulCost;
+		}
+
+		pxFunction->ullTotal += ( unsigned long long ) ulCost;
+		pxFunction->ulSamples++;
+	}
+
+	ullOverhead += ( unsigned long long ) ulWrapperCost;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCalibrate( void )
+{
+xKernelCostSample xOuter, xInner;
+unsigned long ul, ulRaw;
+xKernelCostFunction *pxCalibrate = &( xFunctions[ kcostCALIBRATE ] );
+
+	/* The cost of an empty measurement is the cost of reading the counter. */
+	for( ul = 0UL; ul < kcostCALIBRATION_RUNS; ul++ )
+	{
+		prvBeginSample( kcostCALIBRATE, &xOuter );
+		prvEndSample( kcostCALIBRATE, &xOuter );
+	}
+	ulReadCost = pxCalibrate->ulMin;
+
+	/* The cost of a measurement within a measurement, less the cost of reading
+	the counter in the outer measurement, is the cost of the wrapper.  The
+	inner measurement adds no overhead yet as ulWrapperCost is still zero. */
+	pxCalibrate->ulSamples = 0UL;
+	pxCalibrate->ulMax = 0UL;
+	for( ul = 0UL; ul < kcostCALIBRATION_RUNS; ul++ )
+	{
+		prvBeginSample( kcostCALIBRATE, &xOuter );
+		prvBeginSample( kcostCALIBRATE, &xInner );
+		prvEndSample( kcostCALIBRATE, &xInner );
+		ulRaw = ulKernelCostGetCounter() - xOuter.ulStart;
+
+		if( ( ul == 0UL ) || ( ulRaw < ulWrapperCost ) )
+		{
+			ulWrapperCost = ulRaw;
+		}
+	}
+
+	if( ulWrapperCost > ulReadCost )
+	{
+		ulWrapperCost -= ulReadCost;
+	}
+	else
+	{
+		ulWrapperCost = 0UL;
+	}
+
+	ullOverhead = 0ULL;
+}
+/*-----------------------------------------------------------*/
+
+void vKernelCostWriteResults( FILE *pxFile )
+{
+unsigned long ul;
+xKernelCostFunction *pxFunction;
+
+	fprintf( pxFile, "unit %s\n", pcCounterUnits[ ulCounterType ] );
+	fprintf( pxFile, "# function calls samples min mean max\n" );
+
+	for( ul = 0UL; ul < kcostNUM_FUNCTIONS; ul++ )
+	{
+		pxFunction = &( xFunctions[ ul ] );
+
+		if( pxFunction->ulSamples == 0UL )
+		{
+			fprintf( pxFile, "%s %lu 0 0 0 0\n", pxFunction->pcName, pxFunction->ulCalls );
+		}
+		else
+		{
+			fprintf( pxFile, "%s %lu %lu %lu %lu %lu\n", pxFunction->pcName, pxFunction->ulCalls, pxFunction->ulSamples, pxFunction->ulMin, ( unsigned long ) ( pxFunction->ullTotal / ( unsigned long long ) pxFunction->ulSamples ), pxFunction->ulMax );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xKernelCostCompare( FILE *pxBaseline, FILE *pxReport, unsigned long ulTolerancePercent )
+{
+char cLine[ 256 ], cName[ kcostMAX_NAME_LEN ];
+unsigned long ul, ulCalls, ulSamples, ulMin, ulMean, ulMax, ulNewMean;
+unsigned long ulBaselineMean[ kcostNUM_FUNCTIONS ];
+portBASE_TYPE xFound[ kcostNUM_FUNCTIONS ];
+portBASE_TYPE xReturn = pdPASS;
+xKernelCostFunction *pxFunction;
+
+	memset( xFound, 0x00, sizeof( xFound ) );
+
+	while( fgets( cLine, sizeof( cLine ), pxBaseline ) != NULL )
+	{
+		if( strncmp( cLine, "unit ", 5 ) == 0 )
+		{
+			/* Figures in different units cannot be compared. */
+			if( ( sscanf( cLine + 5, "%63s", cName ) != 1 ) || ( strcmp( cName, pcCounterUnits[ ulCounterType ] ) != 0 ) )
+			{
+				fprintf( pxReport, "The baseline was measured in %s, this run in %s.\n", cName, pcCounterUnits[ ulCounterType ] );
+				return pdFAIL;
+			}
+		}
+		else if( sscanf( cLine, "%63s %lu %lu %lu %lu %lu", cName, &ulCalls, &ulSamples, &ulMin, &ulMean, &ulMax ) == 6 )
+		{
+			for( ul = 0UL; ul < kcostNUM_FUNCTIONS; ul++ )
+			{
+				if( strcmp( cName, xFunctions[ ul ].pcName ) == 0 )
+				{
+					ulBaselineMean[ ul ] = ulMean;
+					xFound[ ul ] = ( ulSamples != 0UL );
+				}
+			}
+		}
+	}
+
+	for( ul = 0UL; ul < kcostNUM_FUNCTIONS; ul++ )
+	{
+		pxFunction = &( xFunctions[ ul ] );
+
+		if( ( xFound[ ul ] == pdFALSE ) || ( pxFunction->ulSamples == 0UL ) )
+		{
+			fprintf( pxReport, "%-26s not compared\n", pxFunction->pcName );
+			continue;
+		}
+
+		ulNewMean = ( unsigned long ) ( pxFunction->ullTotal / ( unsigned long long ) pxFunction->ulSamples );
+
+		fprintf( pxReport, "%-26s %10lu %10lu %+7.1f%%", pxFunction->pcName, ulBaselineMean[ ul ], ulNewMean, ( ulBaselineMean[ ul ] == 0UL ) ? 0.0 : ( ( ( double ) ulNewMean - ( double ) ulBaselineMean[ ul ] ) * 100.0 / ( double ) ulBaselineMean[ ul ] ) );
+
+		if( ( ( unsigned long long ) ulNewMean * 100ULL ) > ( ( unsigned long long ) ulBaselineMean[ ul ] * ( 100ULL + ( unsigned long long ) ulTolerancePercent ) ) )
+		{
+			fprintf( pxReport, "  REGRESSION\n" );
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			fprintf( pxReport, "\n" );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void __wrap_vTaskSwitchContext( void )
+{
+xKernelCostSample xSample;
+
+	prvBeginSample( kcostSWITCH_CONTEXT, &xSample );
+	__real_vTaskSwitchContext();
+	prvEndSample( kcostSWITCH_CONTEXT, &xSample );
+}
+/*-----------------------------------------------------------*/
+
+void __wrap_vTaskIncrementTick( void )
+{
+xKernelCostSample xSample;
+
+	prvBeginSample( kcostINCREMENT_TICK, &xSample );
+	__real_vTaskIncrementTick();
+	prvEndSample( kcostINCREMENT_TICK, &xSample );
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE __wrap_xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
+{
+xKernelCostSample xSample;
+signed portBASE_TYPE xReturn;
+
+	prvBeginSample( kcostQUEUE_SEND, &xSample );
+	xReturn = __real_xQueueGenericSend( pxQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+	prvEndSample( kcostQUEUE_SEND, &xSample );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE __wrap_xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition )
+{
+xKernelCostSample xSample;
+signed portBASE_TYPE xReturn;
+
+	prvBeginSample( kcostQUEUE_SEND_FROM_ISR, &xSample );
+	xReturn = __real_xQueueGenericSendFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition );
+	prvEndSample( kcostQUEUE_SEND_FROM_ISR, &xSample );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE __wrap_xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking )
+{
+xKernelCostSample xSample;
+signed portBASE_TYPE xReturn;
+
+	prvBeginSample( kcostQUEUE_RECEIVE, &xSample );
+	xReturn = __real_xQueueGenericReceive( pxQueue, pvBuffer, xTicksToWait, xJustPeeking );
+	prvEndSample( kcostQUEUE_RECEIVE, &xSample );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE __wrap_xTaskResumeAll( void )
+{
+xKernelCostSample xSample;
+signed portBASE_TYPE xReturn;
+
+	prvBeginSample( kcostRESUME_ALL, &xSample );
+	xReturn = __real_xTaskResumeAll();
+	prvEndSample( kcostRESUME_ALL, &xSample );
+
+	return xReturn;
+}
+
@@ -0,0 +1,89 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef KERNEL_COST_H
+#define KERNEL_COST_H
+
+/*
+ * Select the counter used to measure the kernel.  This must be called before
+ * any task is created.  Returns the name of the unit the counter counts in.
+ */
+const char *pcKernelCostInit( void );
+
+/*
+ * Read the counter selected by pcKernelCostInit().  Also used as the time base
+ * of the benchmark tasks, so their figures are in the same unit.
+ */
+unsigned long ulKernelCostGetCounter( void );
+
+/*
+ * Called from traceTASK_SWITCHED_IN() to note that the running task changed.
+ */
+void vKernelCostTaskSwitchedIn( void );
+
+/*
+ * Write the measurements to pxFile, one line per measured kernel function.
+ * See main.c for the format.
+ */
+void vKernelCostWriteResults( FILE *pxFile );
+
+/*
+ * Compare the measurements against those read from pxBaseline, a file
+ * previously written by vKernelCostWriteResults().  A line is written to
+ * pxReport for each function, and pdFAIL returned if the mean cost of any
+ * function has grown by more than ulTolerancePercent.
+ */
+portBASE_TYPE xKernelCostCompare( FILE *pxBaseline, FILE *pxReport, unsigned long ulTolerancePercent );
+
+#endif /* KERNEL_COST_H */
+
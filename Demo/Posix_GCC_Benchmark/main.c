@@ -0,0 +1,412 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A benchmark runner for the POSIX simulator, used to catch kernel changes that
+ * slow the kernel down before they reach a target.
+ *
+ * main() creates a selection of the standard demo tasks, to exercise the
+ * kernel in the same way as the demo applications for the real targets, along
+ * with the benchmark tasks (Benchmark.c, AllocBench.c and TimerBench.c).  The
+ * simulator is run in virtual time, so the application always executes in
+ * exactly the same way, and as fast as the host allows.  The standard demo
+ * tasks used are those that block regularly - tasks that never call the kernel
+ * would prevent virtual time from advancing.
+ *
+ * While the application runs the cost of a set of kernel functions, including
+ * vTaskSwitchContext(), vTaskIncrementTick() and xQueueGenericSend(), is
+ * measured as described in KernelCost.c.  Once the requested amount of virtual
+ * time has passed the "Runner" task writes the results and exits.  The results
+ * are plain text, one measured function per line:
+ *
+ *    <function> <calls> <samples> <min> <mean> <max>
+ *
+ * preceded by a "unit" line giving what the figures count, and a "status" line
+ * that is "status OK" if every demo task ran without error.  Lines starting
+ * with # are comments - the tables produced by the benchmark tasks are
+ * included as comments.
+ *
+ * The results can be stored, and are compared against a stored set if one is
+ * given.  The program exits with a non-zero status if a demo task reported an
+ * error, or if the mean cost of any measured function has grown by more than
+ * the tolerance.  Command line options:
+ *
+ *    -t <ticks>      The virtual time to run for, in ticks.  This is rounded
+ *                    up to a whole number of check periods (10 seconds).
+ *    -o <file>       Write the results to <file> rather than stdout.
+ *    -b <file>       Compare the results against those stored in <file>.
+ *    -p <percent>    The increase allowed before a regression is reported.
+ *
+ * "make check" builds and runs the benchmark against baseline.txt, and
+ * "make baseline" stores the results of a run as baseline.txt - see the
+ * makefile.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Standard demo includes. */
+#include "BlockQ.h"
+#include "semtest.h"
+#include "PollQ.h"
+#include "GenQTest.h"
+#include "QPeek.h"
+#include "recmutex.h"
+#include "countsem.h"
+#include "blocktim.h"
+#include "dynamic.h"
+#include "TimerDemo.h"
+#include "Benchmark.h"
+#include "AllocBench.h"
+#include "TimerBench.h"
+
+/* Measurement of the kernel. */
+#include "KernelCost.h"
+
+/* Priorities at which the tasks are created. */
+#define mainRUNNER_TASK_PRIORITY	( configMAX_PRIORITIES - 1 )
+#define mainQUEUE_POLL_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainSEM_TEST_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainBLOCK_Q_PRIORITY		( tskIDLE_PRIORITY + 2 )
+#define mainGEN_QUEUE_TASK_PRIORITY	( tskIDLE_PRIORITY )
+#define mainBENCHMARK_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define mainALLOC_BENCH_PRIORITY	( tskIDLE_PRIORITY )
+#define mainTIMER_BENCH_PRIORITY	( tskIDLE_PRIORITY + 1 )
+
+/* The base period used by the timer test tasks. */
+#define mainTIMER_TEST_PERIOD		( 50 )
+
+/* How often the demo tasks are checked.  This must be longer than one pass
+through the timer benchmark. */
+#define mainCHECK_PERIOD			( ( portTickType ) 10000 / portTICK_RATE_MS )
+
+/* The virtual time to run for if -t is not given. */
+#define mainDEFAULT_RUN_TIME		( ( portTickType ) 60000 / portTICK_RATE_MS )
+
+/* The increase in cost allowed if -p is not given. */
+#define mainDEFAULT_TOLERANCE		( 5UL )
+
+/* Large enough for the tables from any one of the benchmark tasks. */
+#define mainRESULTS_BUFFER_SIZE		( 8192 )
+
+/*
+ * The task that checks the demo tasks, and writes the results once the run
+ * is complete.
+ */
+static void prvRunnerTask( void *pvParameters );
+
+/*
+ * Checks every demo task, returning a message naming the first that has
+ * reported an error, or NULL if none has.
+ */
+static const char *prvCheckDemoTasks( void );
+
+/*
+ * Writes the table in pcTable to pxFile as comment lines.
+ */
+static void prvWriteAsComment( FILE *pxFile, const char *pcTitle, char *pcTable );
+
+/*-----------------------------------------------------------*/
+
+/* Set from the command line. */
+static portTickType xRunTime = mainDEFAULT_RUN_TIME;
+static const char *pcResultsFile = NULL;
+static const char *pcBaselineFile = NULL;
+static unsigned long ulTolerance = mainDEFAULT_TOLERANCE;
+
+static char cResults[ mainRESULTS_BUFFER_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+int iArgument;
+
+	for( iArgument = 1; iArgument < argc; iArgument++ )
+	{
+		if( ( strcmp( argv[ iArgument ], "-t" ) == 0 ) && ( iArgument + 1 < argc ) )
+		{
+			xRunTime = ( portTickType ) strtoul( argv[ ++iArgument ], NULL, 0 );
+		}
+		else if( ( strcmp( argv[ iArgument ], "-o" ) == 0 ) && ( iArgument + 1 < argc ) )
+		{
+			pcResultsFile = argv[ ++iArgument ];
+		}
+		else if( ( strcmp( argv[ iArgument ], "-b" ) == 0 ) && ( iArgument + 1 < argc ) )
+		{
+			pcBaselineFile = argv[ ++iArgument ];
+		}
+		else if( ( strcmp( argv[ iArgument ], "-p" ) == 0 ) && ( iArgument + 1 < argc ) )
+		{
+			ulTolerance = strtoul( argv[ ++iArgument ], NULL, 0 );
+		}
+		else
+		{
+			fprintf( stderr, "usage: %s [-t ticks] [-o results] [-b baseline] [-p percent]\n", argv[ 0 ] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* Select the counter before any kernel function is called. */
+	fprintf( stderr, "Measuring kernel cost in %s.\n", pcKernelCostInit() );
+
+	xTaskCreate( prvRunnerTask, ( signed char * ) "Runner", configMINIMAL_STACK_SIZE, NULL, mainRUNNER_TASK_PRIORITY, NULL );
+
+	/* Create the standard demo tasks. */
+	vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+	vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
+	vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
+	vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+	vStartQueuePeekTasks();
+	vStartRecursiveMutexTasks();
+	vStartCountingSemaphoreTasks();
+	vCreateBlockTimeTasks();
+	vStartDynamicPriorityTasks();
+	vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
+
+	/* Create the benchmark tasks. */
+	vStartBenchmarkTasks( mainBENCHMARK_PRIORITY );
+	vStartAllocBenchTasks( mainALLOC_BENCH_PRIORITY );
+	vStartTimerBenchTasks( mainTIMER_BENCH_PRIORITY );
+
+	/* Start the scheduler itself. */
+	vTaskStartScheduler();
+
+	/* Should never get here unless there was not enough heap space to create
+	the idle and other system tasks. */
+	return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunnerTask( void *pvParameters )
+{
+portTickType xNextWakeTime, xElapsed = ( portTickType ) 0;
+const char *pcStatusMessage = NULL, *pcError;
+FILE *pxResults = stdout, *pxBaseline;
+int iExitCode = EXIT_SUCCESS;
+
+	/* Just to remove compiler warning. */
+	( void ) pvParameters;
+
+	xNextWakeTime = xTaskGetTickCount();
+
+	while( xElapsed < xRunTime )
+	{
+		vTaskDelayUntil( &xNextWakeTime, mainCHECK_PERIOD );
+		xElapsed += mainCHECK_PERIOD;
+
+		/* Only the first error is reported. */
+		pcError = prvCheckDemoTasks();
+		if( ( pcError != NULL ) && ( pcStatusMessage == NULL ) )
+		{
+			pcStatusMessage = pcError;
+		}
+	}
+
+	/* Nothing else is allowed to run while the results are written, so they
+	are consistent. */
+	vTaskSuspendAll();
+
+	if( pcResultsFile != NULL )
+	{
+		pxResults = fopen( pcResultsFile, "w" );
+		if( pxResults == NULL )
+		{
+			fprintf( stderr, "Cannot create %s.\n", pcResultsFile );
+			exit( EXIT_FAILURE );
+		}
+	}
+
+	fprintf( pxResults, "# FreeRTOS kernel benchmark, %lu ticks of virtual time\n", ( unsigned long ) xElapsed );
+	fprintf( pxResults, "status %s\n", ( pcStatusMessage == NULL ) ? "OK" : pcStatusMessage );
+	vKernelCostWriteResults( pxResults );
+
+	vBenchmarkGetResults( ( signed char * ) cResults );
+	prvWriteAsComment( pxResults, "Benchmark", cResults );
+	vAllocBenchGetResults( ( signed char * ) cResults );
+	prvWriteAsComment( pxResults, "AllocBench", cResults );
+	vTimerBenchGetResults( ( signed char * ) cResults );
+	prvWriteAsComment( pxResults, "TimerBench", cResults );
+
+	if( pxResults != stdout )
+	{
+		fclose( pxResults );
+	}
+
+	if( pcStatusMessage != NULL )
+	{
+		fprintf( stderr, "%s\n", pcStatusMessage );
+		iExitCode = EXIT_FAILURE;
+	}
+
+	if( pcBaselineFile != NULL )
+	{
+		pxBaseline = fopen( pcBaselineFile, "r" );
+		if( pxBaseline == NULL )
+		{
+			fprintf( stderr, "Cannot open %s.\n", pcBaselineFile );
+			iExitCode = EXIT_FAILURE;
+		}
+		else
+		{
+			fprintf( stderr, "%-26s %10s %10s %8s  (tolerance %lu%%)\n", "Function", "Baseline", "Now", "Change", ulTolerance );
+
+			if( xKernelCostCompare( pxBaseline, stderr, ulTolerance ) != pdPASS )
+			{
+				iExitCode = EXIT_FAILURE;
+			}
+
+			fclose( pxBaseline );
+		}
+	}
+
+	exit( iExitCode );
+}
+/*-----------------------------------------------------------*/
+
+static const char *prvCheckDemoTasks( void )
+{
+const char *pcError = NULL;
+
+	if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: GenQueue";
+	}
+	else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: QueuePeek";
+	}
+	else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+	{
+		pcError = "Error: BlockQueue";
+	}
+	else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: SemTest";
+	}
+	else if( xArePollingQueuesStillRunning() != pdTRUE )
+	{
+		pcError = "Error: PollQueue";
+	}
+	else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: RecMutex";
+	}
+	else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: CountSem";
+	}
+	else if( xAreBlockTimeTestTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: BlockTime";
+	}
+	else if( xAreDynamicPriorityTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: DynamicPriority";
+	}
+	else if( xAreTimerDemoTasksStillRunning( mainCHECK_PERIOD ) != pdTRUE )
+	{
+		pcError = "Error: TimerDemo";
+	}
+	else if( xAreBenchmarkTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: Benchmark";
+	}
+	else if( xAreAllocBenchTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: AllocBench";
+	}
+	else if( xAreTimerBenchTasksStillRunning() != pdTRUE )
+	{
+		pcError = "Error: TimerBench";
+	}
+
+	return pcError;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteAsComment( FILE *pxFile, const char *pcTitle, char *pcTable )
+{
+char *pcLine;
+
+	fprintf( pxFile, "#\n# %s\n", pcTitle );
+
+	for( pcLine = strtok( pcTable, "\r\n" ); pcLine != NULL; pcLine = strtok( NULL, "\r\n" ) )
+	{
+		fprintf( pxFile, "# %s\n", pcLine );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* Exercise the timer API from an interrupt, and give the benchmark tasks
+	an interrupt to measure the latency of. */
+	vTimerPeriodicISRTests();
+	( void ) xBenchmarkTimerHandler();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	fprintf( stderr, "Error: pvPortMalloc() failed.\n" );
+	exit( EXIT_FAILURE );
+}
+
@@ -109,6 +109,14 @@ static void prvInitialise_uIP( void );
  */
 static void prvUIPTimerCallback( xTimerHandle xTimer );
 
+#if UIP_TCP_TX_WINDOW > 1
+	/*
+	 * Send the further segments that connections with data in flight can fit
+	 * into their transmit windows.
+	 */
+	static void prvFillTransmitWindows( void );
+#endif
+
 /*
  * Port functions required by the uIP stack.
  */
@@ -169,6 +177,10 @@ unsigned long ulUIP_Events = 0UL;
 						uip_arp_out();
 						vEMACWrite();
 					}
+
+					#if UIP_TCP_TX_WINDOW > 1
+						prvFillTransmitWindows();
+					#endif
 				}
 				else if( xHeader->type == htons( UIP_ETHTYPE_ARP ) )
 				{
@@ -206,6 +218,10 @@ unsigned long ulUIP_Events = 0UL;
 					vEMACWrite();
 				}
 			}
+
+			#if UIP_TCP_TX_WINDOW > 1
+				prvFillTransmitWindows();
+			#endif
 		}
 		
 		/* Call the ARP timer function every 10 seconds. */
@@ -224,6 +240,22 @@ unsigned long ulUIP_Events = 0UL;
 }
 /*-----------------------------------------------------------*/
 
+#if UIP_TCP_TX_WINDOW > 1
+
+	static void prvFillTransmitWindows( void )
+	{
+		/* Each call generates at most one segment, so keep going until no
+		connection has anything more to send. */
+		for( uip_txq_poll(); uip_len > 0; uip_txq_poll() )
+		{
+			uip_arp_out();
+			vEMACWrite();
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
 static void prvInitialise_uIP( void )
 {
 xTimerHandle xARPTimer, xPeriodicTimer;
@@ -64,14 +64,12 @@
 
 /* uIP includes. */
 #include "net/uip.h"
+#include "net/uip_bufpool.h"
 
-/* The time to wait between attempts to obtain a free buffer. */
+/* The time to wait between attempts to obtain a free buffer.  The number of
+attempts is set by UIP_CONF_BUFPOOL_ATTEMPTS in uip-conf.h. */
 #define emacBUFFER_WAIT_DELAY_ms		( 3 / portTICK_RATE_MS )
 
-/* The number of times emacBUFFER_WAIT_DELAY_ms should be waited before giving
-up on attempting to obtain a free buffer all together. */
-#define emacBUFFER_WAIT_ATTEMPTS	( 30 )
-
 /* The number of Rx descriptors. */
 #define emacNUM_RX_DESCRIPTORS	8
 
@@ -82,6 +80,10 @@ more than two. */
 /* The total number of EMAC buffers to allocate. */
 #define emacNUM_BUFFERS		( emacNUM_RX_DESCRIPTORS + emacNUM_TX_BUFFERS )
 
+#if emacNUM_BUFFERS > UIP_BUFPOOL_BUFFERS
+	#error UIP_CONF_BUFPOOL_BUFFERS in uip-conf.h must be at least emacNUM_BUFFERS.
+#endif
+
 /* The time to wait for the Tx descriptor to become free. */
 #define emacTX_WAIT_DELAY_ms ( 10 / portTICK_RATE_MS )
 
@@ -105,12 +107,6 @@ volatile ethfifo xTxDescriptors[ emacNUM_TX_BUFFERS ];
 #pragma data_alignment=32
 char xEthernetBuffers[ emacNUM_BUFFERS ][ UIP_BUFSIZE ];
 
-
-/* Used to indicate which buffers are free and which are in use.  If an index
-contains 0 then the corresponding buffer in xEthernetBuffers is free, otherwise
-the buffer is in use or about to be used. */
-static unsigned char ucBufferInUse[ emacNUM_BUFFERS ];
-
 /*-----------------------------------------------------------*/
 
 /*
@@ -118,16 +114,6 @@ static unsigned char ucBufferInUse[ emacNUM_BUFFERS ];
  */
 static void prvInitialiseDescriptors( void );
 
-/*
- * Return a pointer to a free buffer within xEthernetBuffers.
- */
-static unsigned char *prvGetNextBuffer( void );
-
-/*
- * Return a buffer to the list of free buffers.
- */
-static void prvReturnBuffer( unsigned char *pucBuffer );
-
 /*
  * Examine the status of the next Rx FIFO to see if it contains new data.
  */
@@ -191,6 +177,7 @@ void vInitEmac( void )
 void vEMACWrite( void )
 {
 long x;
+unsigned char *pucFrame;
 
 	/* Wait until the second transmission of the last packet has completed. */
 	for( x = 0; x < emacTX_WAIT_ATTEMPTS; x++ )
@@ -213,16 +200,16 @@ long x;
 		prvResetEverything();
 	}
 	
+	/* uip_buf is about to be sent by the Tx descriptors, so take it from the
+	stack and give the stack a new buffer to use. */
+	pucFrame = uip_bufpool_tx();
+
 	/* Setup both descriptors to transmit the frame. */
-	xTxDescriptors[ 0 ].buf_p = ( char * ) uip_buf;
+	xTxDescriptors[ 0 ].buf_p = ( char * ) pucFrame;
 	xTxDescriptors[ 0 ].bufsize = uip_len;	
-	xTxDescriptors[ 1 ].buf_p = ( char * ) uip_buf;
+	xTxDescriptors[ 1 ].buf_p = ( char * ) pucFrame;
 	xTxDescriptors[ 1 ].bufsize = uip_len;
 
-	/* uip_buf is being sent by the Tx descriptor.  Allocate a new buffer
-	for use by the stack. */
-	uip_buf = prvGetNextBuffer();
-
 	/* Clear previous settings and go. */
 	xTxDescriptors[0].status &= ~( FP1 | FP0 );
 	xTxDescriptors[0].status |= ( FP1 | FP0 | ACT );
@@ -241,16 +228,10 @@ unsigned long ulBytesReceived;
 
 	if( ulBytesReceived > 0 )
 	{
-		/* Mark the pxDescriptor buffer as free as uip_buf is going to be set to
-		the buffer that contains the received data. */
-		prvReturnBuffer( uip_buf );
-
-		/* Point uip_buf to the data about ot be processed. */
-		uip_buf = ( void * ) pxCurrentRxDesc->buf_p;
-		
-		/* Allocate a new buffer to the descriptor, as uip_buf is now using it's
-		old descriptor. */
-		pxCurrentRxDesc->buf_p = ( char * ) prvGetNextBuffer();
+		/* Point uip_buf to the data about to be processed, freeing the buffer
+		uip_buf used before, and give the descriptor a new buffer in place of
+		the one uip_buf is now using. */
+		pxCurrentRxDesc->buf_p = ( char * ) uip_bufpool_rx( ( unsigned char * ) pxCurrentRxDesc->buf_p );
 
 		/* Prepare the descriptor to go again. */
 		pxCurrentRxDesc->status &= ~( FP1 | FP0 );
@@ -328,25 +309,19 @@ static void prvInitialiseDescriptors( void )
 volatile ethfifo *pxDescriptor;
 long x;
 
-	for( x = 0; x < emacNUM_BUFFERS; x++ )
-	{
-		/* Ensure none of the buffers are shown as in use at the start. */
-		ucBufferInUse[ x ] = pdFALSE;
-	}
+	/* None of the buffers are in use at the start. */
+	uip_bufpool_init( ( unsigned char * ) xEthernetBuffers, emacNUM_BUFFERS, UIP_BUFSIZE );
 
 	/* Initialise the Rx descriptors. */
 	for( x = 0; x < emacNUM_RX_DESCRIPTORS; x++ )
 	{
 		pxDescriptor = &( xRxDescriptors[ x ] );
-		pxDescriptor->buf_p = &( xEthernetBuffers[ x ][ 0 ] );
+		pxDescriptor->buf_p = ( char * ) uip_bufpool_alloc();
 
 		pxDescriptor->bufsize = UIP_BUFSIZE;
 		pxDescriptor->size = 0;
 		pxDescriptor->status = ACT;
 		pxDescriptor->next = ( ethfifo * ) &xRxDescriptors[ x + 1 ];	
-		
-		/* Mark this buffer as in use. */
-		ucBufferInUse[ x ] = pdTRUE;
 	}
 
 	/* The last descriptor points back to the start. */
@@ -377,58 +352,10 @@ long x;
 }
 /*-----------------------------------------------------------*/
 
-static unsigned char *prvGetNextBuffer( void )
+void uip_bufpool_wait( void )
 {
-long x;
-unsigned char *pucReturn = NULL;
-unsigned long ulAttempts = 0;
-
-	while( pucReturn == NULL )
-	{
-		/* Look through the buffers to find one that is not in use by
-		anything else. */
-		for( x = 0; x < emacNUM_BUFFERS; x++ )
-		{
-			if( ucBufferInUse[ x ] == pdFALSE )
-			{
-				ucBufferInUse[ x ] = pdTRUE;
-				pucReturn = ( unsigned char * ) &( xEthernetBuffers[ x ][ 0 ] );
-				break;
-			}
-		}
-
-		/* Was a buffer found? */
-		if( pucReturn == NULL )
-		{
-			ulAttempts++;
-
-			if( ulAttempts >= emacBUFFER_WAIT_ATTEMPTS )
-			{
-				break;
-			}
-
-			/* Wait then look again. */
-			vTaskDelay( emacBUFFER_WAIT_DELAY_ms );
-		}
-	}
-
-	return pucReturn;
-}
-/*-----------------------------------------------------------*/
-
-static void prvReturnBuffer( unsigned char *pucBuffer )
-{
-unsigned long ul;
-
-	/* Return a buffer to the pool of free buffers. */
-	for( ul = 0; ul < emacNUM_BUFFERS; ul++ )
-	{
-		if( &( xEthernetBuffers[ ul ][ 0 ] ) == ( void * ) pucBuffer )
-		{
-			ucBufferInUse[ ul ] = pdFALSE;
-			break;
-		}
-	}
+	/* Give the EMAC time to finish with a buffer. */
+	vTaskDelay( emacBUFFER_WAIT_DELAY_ms );
 }
 /*-----------------------------------------------------------*/
 
@@ -543,7 +470,7 @@ const unsigned long ulRxEvent = uipETHERNET_RX_EVENT;
 	if( ul & emacTX_END_INTERRUPT )
 	{
 		/* Only return the buffer to the pool once both Txes have completed. */
-		prvReturnBuffer( ( void * ) xTxDescriptors[ 0 ].buf_p );
+		uip_bufpool_free( ( unsigned char * ) xTxDescriptors[ 0 ].buf_p );
 		EDMAC.EESR.LONG = emacTX_END_INTERRUPT;
 	}
 
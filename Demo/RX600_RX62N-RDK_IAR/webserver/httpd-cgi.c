@@ -177,19 +177,63 @@ static PT_THREAD( net_stats ( struct httpd_state *s, char *ptr ) )
 }
 
 /*---------------------------------------------------------------------------*/
-extern void vTaskList( signed char *pcWriteBuffer );
+/* The task tables are sent one task per segment.  s->count holds the number
+of the task being sent rather than a pointer to it, so the task is looked up
+again when the generator is called, including for a retransmission. */
+static int find_task( struct httpd_state *s, xTaskStatusType *pxStatus, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+{
+	unsigned portBASE_TYPE	uxCursor = ( unsigned portBASE_TYPE ) s->count;
+
+	if( xTaskGetNextTaskStatus( &uxCursor, pxStatus, pulTotalRunTime ) == pdFALSE )
+	{
+		return 0;
+	}
+
+	s->count = ( unsigned short ) pxStatus->uxTaskNumber;
+	return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+static int next_task( struct httpd_state *s )
+{
+	xTaskStatusType xStatus;
+
+	return find_task( s, &xStatus, NULL );
+}
+
+/*---------------------------------------------------------------------------*/
 extern char *pcGetTaskStatusMessage( void );
-static char cCountBuf[128];
 long		lRefreshCount = 0;
 static unsigned short generate_rtos_stats( void *arg )
+{
+	struct httpd_state	*s = ( struct httpd_state * ) arg;
+	xTaskStatusType		xStatus;
+	char				cStatus;
+
+	if( find_task( s, &xStatus, NULL ) == 0 )
+	{
+		return 0;
+	}
+
+	switch( xStatus.eCurrentState )
+	{
+		case eBlocked:		cStatus = 'B'; break;
+		case eSuspended:	cStatus = 'S'; break;
+		case eDeleted:		cStatus = 'D'; break;
+		default:			cStatus = 'R'; break;
+	}
+
+	/* The same format as vTaskList(). */
+	return sprintf( ( char * ) uip_appdata, "%s\t\t%c\t%u\t%u\t%u\r\n", ( const char * ) xStatus.pcTaskName, cStatus,
+					( unsigned int ) xStatus.uxCurrentPriority, ( unsigned int ) xStatus.usStackHighWaterMark, ( unsigned int ) xStatus.uxTaskNumber );
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned short generate_rtos_tail( void *arg )
 {
 	( void ) arg;
 	lRefreshCount++;
-	sprintf( cCountBuf, "<p><br>Refresh count = %d<p><br>%s", ( int ) lRefreshCount, pcGetTaskStatusMessage() );
-	vTaskList( uip_appdata );
-	strcat( uip_appdata, cCountBuf );
-
-	return strlen( uip_appdata );
+	return sprintf( ( char * ) uip_appdata, "<p><br>Refresh count = %d<p><br>%s", ( int ) lRefreshCount, pcGetTaskStatusMessage() );
 }
 
 /*---------------------------------------------------------------------------*/
@@ -198,7 +242,12 @@ static PT_THREAD( rtos_stats ( struct httpd_state *s, char *ptr ) )
 	PSOCK_BEGIN( &s->sout );
 	( void ) ptr;
 	( void ) PT_YIELD_FLAG;
-	PSOCK_GENERATOR_SEND( &s->sout, generate_rtos_stats, NULL );
+	for( s->count = 0; next_task(s); ++s->count )
+	{
+		PSOCK_GENERATOR_SEND( &s->sout, generate_rtos_stats, s );
+	}
+
+	PSOCK_GENERATOR_SEND( &s->sout, generate_rtos_tail, NULL );
 	PSOCK_END( &s->sout );
 }
 
@@ -227,31 +276,56 @@ static unsigned short generate_io_state( void *arg )
 }
 
 /*---------------------------------------------------------------------------*/
-extern void vTaskGetRunTimeStats( signed char *pcWriteBuffer );
 extern unsigned short usMaxJitter;
-static char cJitterBuffer[ 200 ];
+#ifdef INCLUDE_HIGH_FREQUENCY_TIMER_TEST
 static unsigned short generate_runtime_stats( void *arg )
 {
+	struct httpd_state			*s = ( struct httpd_state * ) arg;
+	xTaskStatusType				xStatus;
+	portRUN_TIME_COUNTER_TYPE	ulTotalRunTime;
+	unsigned long				ulPercentage;
+
+	if( find_task( s, &xStatus, &ulTotalRunTime ) == 0 )
+	{
+		return 0;
+	}
+
+	/* The same format as vTaskGetRunTimeStats(). */
+	ulTotalRunTime /= 100UL;
+	if( ulTotalRunTime == 0 )
+	{
+		return sprintf( ( char * ) uip_appdata, "%s\t\t0\t\t0%%\r\n", ( const char * ) xStatus.pcTaskName );
+	}
+
+	ulPercentage = ( unsigned long ) ( xStatus.ulRunTimeCounter / ulTotalRunTime );
+	if( ulPercentage > 0UL )
+	{
+		return sprintf( ( char * ) uip_appdata, "%s\t\t%lu\t\t%lu%%\r\n", ( const char * ) xStatus.pcTaskName, ( unsigned long ) xStatus.ulRunTimeCounter, ulPercentage );
+	}
+
+	return sprintf( ( char * ) uip_appdata, "%s\t\t%lu\t\t<1%%\r\n", ( const char * ) xStatus.pcTaskName, ( unsigned long ) xStatus.ulRunTimeCounter );
+}
+#endif /* INCLUDE_HIGH_FREQUENCY_TIMER_TEST */
+
+/*---------------------------------------------------------------------------*/
+static unsigned short generate_runtime_tail( void *arg )
+{
+	unsigned short	len;
+
 	( void ) arg;
 	lRefreshCount++;
-	sprintf( cCountBuf, "<p><br>Refresh count = %d", ( int ) lRefreshCount );
-	
+
 	#ifdef INCLUDE_HIGH_FREQUENCY_TIMER_TEST
 	{
-		sprintf( cJitterBuffer, "<p><br>Max high frequency timer jitter = %d peripheral clock periods.<p><br>", ( int ) usMaxJitter );
-		vTaskGetRunTimeStats( uip_appdata );
-		strcat( uip_appdata, cJitterBuffer );
+		len = sprintf( ( char * ) uip_appdata, "<p><br>Max high frequency timer jitter = %d peripheral clock periods.<p><br>", ( int ) usMaxJitter );
 	}
 	#else
 	{
-		( void ) cJitterBuffer;
-		strcpy( uip_appdata, "<p>Run time stats are only available in the debug_with_optimisation build configuration.<p>" );
+		len = sprintf( ( char * ) uip_appdata, "<p>Run time stats are only available in the debug_with_optimisation build configuration.<p>" );
 	}
-	#endif	
-
-	strcat( uip_appdata, cCountBuf );
+	#endif
 
-	return strlen( uip_appdata );
+	return len + sprintf( ( char * ) uip_appdata + len, "<p><br>Refresh count = %d", ( int ) lRefreshCount );
 }
 
 /*---------------------------------------------------------------------------*/
@@ -260,7 +334,16 @@ static PT_THREAD( run_time ( struct httpd_state *s, char *ptr ) )
 	PSOCK_BEGIN( &s->sout );
 	( void ) ptr;
 	( void ) PT_YIELD_FLAG;
-	PSOCK_GENERATOR_SEND( &s->sout, generate_runtime_stats, NULL );
+	#ifdef INCLUDE_HIGH_FREQUENCY_TIMER_TEST
+	{
+		for( s->count = 0; next_task(s); ++s->count )
+		{
+			PSOCK_GENERATOR_SEND( &s->sout, generate_runtime_stats, s );
+		}
+	}
+	#endif
+
+	PSOCK_GENERATOR_SEND( &s->sout, generate_runtime_tail, NULL );
 	PSOCK_END( &s->sout );
 }
 
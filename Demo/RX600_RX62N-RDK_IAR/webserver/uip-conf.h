@@ -109,6 +109,13 @@ typedef unsigned short uip_stats_t;
  */
 #define UIP_CONF_BUFFER_SIZE     1480
 
+/**
+ * The number of Ethernet buffers the EMAC driver exchanges with uIP, and the
+ * number of times it looks for a free one before giving up.
+ */
+#define UIP_CONF_BUFPOOL_BUFFERS	10
+#define UIP_CONF_BUFPOOL_ATTEMPTS	30
+
 /**
  * CPU byte order.
  *
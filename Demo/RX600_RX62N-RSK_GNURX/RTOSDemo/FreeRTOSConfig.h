@@ -134,6 +134,10 @@ required to ensure flase positive timing errors are not reported. */
 #define bktSECONDARY_PRIORITY	( configMAX_PRIORITIES - 4 )
 #define intqHIGHER_PRIORITY		( configMAX_PRIORITIES - 3 )
 
+/* The interrupt latency test uses TMR01, which counts PCLK/8, as its time
+base. */
+#define intlatCOUNTS_PER_MICROSECOND	( configPERIPHERAL_CLOCK_HZ / 8000000UL )
+
 
 /*-----------------------------------------------------------
  * Ethernet configuration.
@@ -64,6 +64,7 @@
 /* Demo includes. */
 #include "IntQueueTimer.h"
 #include "IntQueue.h"
+#include "IntLatency.h"
 
 /* Hardware specifics. */
 #include "iodefine.h"
@@ -131,14 +132,29 @@ void vInitialiseTimerForIntQueueTest( void )
 }
 /*-----------------------------------------------------------*/
 
+unsigned long ulIntLatencyTimerElapsed( void )
+{
+	/* TMR01 is cleared on compare match A, so its count is the number of PCLK/8
+	periods since the interrupt was requested. */
+	return ( unsigned long ) TMR01.TCNT;
+}
+/*-----------------------------------------------------------*/
+
 void vT0_1_ISR_Handler( void )
 {
+portBASE_TYPE xHigherPriorityTaskWoken;
+
+	/* The latency test reads the timer before anything else is done, so it
+	must be called before interrupts are re-enabled. */
+	xHigherPriorityTaskWoken = xIntLatencyTimerHandler();
+
 	/* Re-enabled interrupts. */
 	__asm volatile( "SETPSW	I" );
 
 	/* Call the handler that is part of the common code - this is where the
 	non-portable code ends and the actual test is performed. */
-	portYIELD_FROM_ISR( xFirstTimerHandler() );	
+	xHigherPriorityTaskWoken |= xFirstTimerHandler();
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );	
 }
 /*-----------------------------------------------------------*/
 
@@ -141,6 +141,7 @@
 #include "QPeek.h"
 #include "recmutex.h"
 #include "flop.h"
+#include "IntLatency.h"
 
 /* Values that are passed into the reg test tasks using the task parameter.  The
 tasks check that the values are passed in correctly. */
@@ -158,6 +159,7 @@ tasks check that the values are passed in correctly. */
 #define mainINTEGER_TASK_PRIORITY   ( tskIDLE_PRIORITY )
 #define mainGEN_QUEUE_TASK_PRIORITY	( tskIDLE_PRIORITY )
 #define mainFLOP_TASK_PRIORITY		( tskIDLE_PRIORITY )
+#define mainINT_LATENCY_PRIORITY	( configMAX_PRIORITIES - 2 )
 
 /* The WEB server uses string handling functions, which in turn use a bit more
 stack than most of the other tasks. */
@@ -281,6 +283,7 @@ extern void HardwareSetup( void );
 	vStartRecursiveMutexTasks();
 	vStartInterruptQueueTasks();
 	vStartMathTasks( mainFLOP_TASK_PRIORITY );
+	vStartIntLatencyTasks( mainINT_LATENCY_PRIORITY );
 
 	/* The suicide tasks must be created last as they need to know how many
 	tasks were running prior to their creation in order to ascertain whether
@@ -366,6 +369,10 @@ extern void vSetupHighFrequencyTimer( void );
 		{
 			pcStatusMessage = "Error: Flop\r\n";
 		}
+		else if( xAreIntLatencyTasksStillRunning() != pdPASS )
+		{
+			pcStatusMessage = "Error: IntLatency\r\n";
+		}
 
 		/* Check the reg test tasks are still cycling.  They will stop incrementing
 		their loop counters if they encounter an error. */
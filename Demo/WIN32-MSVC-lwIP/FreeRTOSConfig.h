@@ -85,6 +85,10 @@
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configUSE_ALTERNATIVE_API		1
 
+/* Have tasks that yield wait on an event rather than being suspended by the
+Win32 port.  Use the yield-cost command to compare the two methods. */
+#define configWIN32_USE_YIELD_EVENTS	1
+
 #define configUSE_TIMERS				1
 #define configTIMER_TASK_PRIORITY		2
 #define configTIMER_QUEUE_LENGTH		20
@@ -125,6 +129,12 @@ extern void vAssertCalled( void );
 #define configNETWORK_INTERFACE_TO_USE 2L
 
 #define configMAC_ISR_SIMULATOR_PRIORITY	( 6 )
+
+/* Capture frames in a Windows thread that raises a simulated interrupt,
+rather than polling from the MAC_ISR task. */
+#define configMAC_USE_CAPTURE_THREAD		1
+#define configMAC_INTERRUPT_NUMBER			3UL
+#define configMAC_CAPTURE_RING_LENGTH		32
 #define configLWIP_TASK_PRIORITY			( 5 )
 
 /* MAC address configuration. */
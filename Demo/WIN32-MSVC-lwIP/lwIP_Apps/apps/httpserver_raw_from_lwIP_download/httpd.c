@@ -753,6 +753,60 @@ get_http_headers(struct http_state *pState, char *pszURI)
 }
 #endif /* LWIP_HTTPD_DYNAMIC_HEADERS */
 
+#if HTTPD_USE_FATFS
+/** The connection http_forward_out() passes file data to */
+static struct tcp_pcb *http_forward_pcb;
+/** The number of bytes that still fit in its send buffer */
+static u16_t http_forward_room;
+
+/** The streaming function given to f_forward(). Each call passes part of a
+ * sector from the FatFs window, which tcp_write() copies into the send
+ * buffer. A call with no data asks whether more can be taken.
+ */
+static UINT
+http_forward_out(const BYTE *data, UINT len)
+{
+  if (len == 0) {
+    return (http_forward_room > 0) &&
+           (tcp_sndqueuelen(http_forward_pcb) < TCP_SND_QUEUELEN);
+  }
+  if (len > http_forward_room) {
+    len = http_forward_room;
+  }
+  if (tcp_write(http_forward_pcb, data, (u16_t)len, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+    /* Out of memory, the rest is sent from http_sent() or http_poll() */
+    http_forward_room = 0;
+    return 0;
+  }
+  http_forward_room -= (u16_t)len;
+  return len;
+}
+
+/**
+ * Send as much of a FatFs file as the send buffer takes.
+ *
+ * @param pcb the pcb to send data
+ * @param hs connection state
+ */
+static u8_t
+http_send_fatfs(struct tcp_pcb *pcb, struct http_state *hs)
+{
+  UINT sent;
+
+  http_forward_pcb = pcb;
+  http_forward_room = tcp_sndbuf(pcb);
+  if (f_forward(&hs->handle->fil, http_forward_out,
+                (UINT)fs_bytes_left(hs->handle), &sent) != FR_OK) {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("File read failed.\n"));
+    http_close_conn(pcb, hs);
+    return 0;
+  }
+  hs->handle->index += (int)sent;
+  LWIP_DEBUGF(HTTPD_DEBUG | LWIP_DBG_TRACE, ("Forwarded %d bytes\n", (int)sent));
+  return (sent > 0);
+}
+#endif /* HTTPD_USE_FATFS */
+
 /**
  * Try to send more data on this pcb.
  *
@@ -862,6 +916,16 @@ http_send_data(struct tcp_pcb *pcb, struct http_state *hs)
       http_close_conn(pcb, hs);
       return 0;
     }
+#if HTTPD_USE_FATFS
+    if (hs->handle->is_fatfs_file
+#if LWIP_HTTPD_SSI
+        && !hs->tag_check
+#endif /* LWIP_HTTPD_SSI */
+       ) {
+      /* No tags to replace, so the file goes straight to the send buffer */
+      return http_send_fatfs(pcb, hs);
+    }
+#endif /* HTTPD_USE_FATFS */
 #if LWIP_HTTPD_SSI || LWIP_HTTPD_DYNAMIC_HEADERS
     /* Do we already have a send buffer allocated? */
     if(hs->buf) {
@@ -1848,6 +1912,15 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
     hs->file = (char*)file->data;
     LWIP_ASSERT("File length must be positive!", (file->len >= 0));
     hs->left = file->len;
+#if HTTPD_USE_FATFS
+    if (file->is_fatfs_file) {
+      /* Nothing is in memory, http_send_data() reads the file */
+      hs->left = 0;
+#if LWIP_HTTPD_SSI
+      hs->parse_left = 0;
+#endif /* LWIP_HTTPD_SSI */
+    }
+#endif /* HTTPD_USE_FATFS */
     hs->retries = 0;
 #if LWIP_HTTPD_TIMING
     hs->time_started = sys_now();
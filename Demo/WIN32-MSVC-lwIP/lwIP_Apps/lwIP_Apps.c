@@ -59,8 +59,12 @@
 #include "lwip/opt.h"
 #include "lwip/tcpip.h"
 
+/* lwIP netif includes */
+#include "netif/pcapring.h"
+
 /* applications includes */
 #include "apps/httpserver_raw_from_lwIP_download/httpd.h"
+#include "iperf.h"
 
 /* include the port-dependent configuration */
 #include "lwipcfg_msvc.h"
@@ -74,6 +78,10 @@ xTxBufferMutex mutex. */
 available. */
 #define lwipappsMAX_TIME_TO_WAIT_FOR_TX_BUFFER_MS	( 100 / portTICK_RATE_MS )
 
+/* The TCP port from which the frames held by the capture ring can be fetched
+as a pcap file when LWIP_PCAPRING is set to 1 in lwipopts.h. */
+#define lwipappsPCAPRING_PORT	2002
+
 /* Definitions of the various SSI callback functions within the pccSSITags 
 array.  If pccSSITags is updated, then these definitions must also be updated. */
 #define ssiTASK_STATS_INDEX			0
@@ -92,6 +100,11 @@ extern void vBasicSocketsCommandInterpreterTask( void *pvParameters );
  */
 static unsigned short uslwIPAppsSSIHandler( int iIndex, char *pcBuffer, int iBufferLength );
 
+/*
+ * Print the result of each iperf test run against the target.
+ */
+static void prvIperfReport( const xIperfReport *pxReport );
+
 /*-----------------------------------------------------------*/
 
 /* The SSI strings that are embedded in the served html files.  If this array
@@ -152,12 +165,45 @@ static struct netif xNetIf;
 	use of the lwIP raw API. */
 	httpd_init();
 
+	/* Create the iperf servers, for example "iperf -c <target IP>" on the
+	host measures the TCP receive throughput.  These also use the raw API. */
+	vIperfServerInit( prvIperfReport );
+
+	#if LWIP_PCAPRING
+	{
+		/* Serve the frames recorded by the capture ring. */
+		pcapring_server_init( lwipappsPCAPRING_PORT );
+	}
+	#endif
+
 	/* Create the FreeRTOS defined basic command server.  This demonstrates use
 	of the lwIP sockets API. */
 	xTaskCreate( vBasicSocketsCommandInterpreterTask, ( signed char * ) "CmdInt", configMINIMAL_STACK_SIZE * 10, NULL, configMAX_PRIORITIES - 2, NULL );
 }
 /*-----------------------------------------------------------*/
 
+static void prvIperfReport( const xIperfReport *pxReport )
+{
+	printf( "iperf %s%s: %lu bytes in %lu ms, %lu kbit/s", pxReport->pcTest, pxReport->xAborted ? " (aborted)" : "", pxReport->ulBytes, pxReport->ulMilliseconds, pxReport->ulKbitsPerSecond );
+
+	if( pxReport->usCpuLoad != iperfCPU_LOAD_UNKNOWN )
+	{
+		printf( ", CPU load %u.%u%%", pxReport->usCpuLoad / 10U, pxReport->usCpuLoad % 10U );
+	}
+
+	if( pxReport->ulDatagrams != 0UL )
+	{
+		printf( ", %lu/%lu datagrams lost, %lu out of order, jitter %lu us", pxReport->ulLost, pxReport->ulDatagrams, pxReport->ulOutOfOrder, pxReport->ulJitterMicroseconds );
+	}
+
+	printf( "\n  link tx %lu rx %lu drop %lu, ip tx %lu rx %lu drop %lu, tcp tx %lu rx %lu drop %lu, udp tx %lu rx %lu drop %lu\n",
+			pxReport->xLink.ulXmit, pxReport->xLink.ulRecv, pxReport->xLink.ulDrop,
+			pxReport->xIP.ulXmit, pxReport->xIP.ulRecv, pxReport->xIP.ulDrop,
+			pxReport->xTCP.ulXmit, pxReport->xTCP.ulRecv, pxReport->xTCP.ulDrop,
+			pxReport->xUDP.ulXmit, pxReport->xUDP.ulRecv, pxReport->xUDP.ulDrop );
+}
+/*-----------------------------------------------------------*/
+
 static unsigned short uslwIPAppsSSIHandler( int iIndex, char *pcBuffer, int iBufferLength )
 {
 static unsigned int uiUpdateCount = 0;
@@ -53,6 +53,11 @@ void vLwipAppsReleaseTxBuffer( void );
 #define LWIP_SOCKET						(NO_SYS==0)
 #define LWIP_NETCONN              		1
 
+/* Sockets and netconn calls lock the stack with a mutex and call into it
+directly, rather than posting a message to the tcpip thread and waiting for
+the reply. */
+#define LWIP_TCPIP_CORE_LOCKING			1
+
 #define LWIP_SNMP						0
 #define LWIP_IGMP						0
 #define LWIP_ICMP						1
@@ -131,8 +136,9 @@ a lot of data that needs to be copied, this should be set high. */
 #define MEMP_NUM_TCP_PCB		30
 
 /* MEMP_NUM_TCP_PCB_LISTEN: the number of listening TCP
-   connections. */
-#define MEMP_NUM_TCP_PCB_LISTEN 2
+   connections.  The http, command, capture ring and iperf servers each
+   listen. */
+#define MEMP_NUM_TCP_PCB_LISTEN 4
 
 /* MEMP_NUM_TCP_SEG: the number of simultaneously queued TCP
    segments. */
@@ -215,6 +221,11 @@ a lot of data that needs to be copied, this should be set high. */
 #define ARP_TABLE_SIZE			10
 #define ARP_QUEUEING			1
 
+/* Keep the start of recent frames in RAM.  They can be fetched as a pcap file
+by connecting to lwipappsPCAPRING_PORT (defined in lwIP_Apps.c), for example with
+"nc <target IP> 2002 > capture.pcap". */
+#define LWIP_PCAPRING			1
+
 
 /* ---------- IP options ---------- */
 /* Define IP_FORWARD to 1 if you wish to have the ability to forward
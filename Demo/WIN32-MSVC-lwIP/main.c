@@ -74,7 +74,10 @@
  * run time stats.  Task stats give a snapshot of the state of each task in
  * the system.  Run time stats show how much processing time has been allocated
  * to each task.  A few of the standard demo tasks are created, just to ensure
- * there is some data to be viewed.
+ * there is some data to be viewed.  The command line interface also provides a
+ * yield-cost command that reports the average time taken by taskYIELD(), which
+ * can be used to compare the context switch methods selected by
+ * configWIN32_USE_YIELD_EVENTS in FreeRTOSConfig.h.
  *
  * Finally, a check timer is created.  The check timer is a software timer that
  * inspects the few standard demo tasks that are created to ensure they are
@@ -115,6 +118,9 @@ have been reported by any of the standard demo tasks.  ms are converted to the
 equivalent in ticks using the portTICK_RATE_MS constant. */
 #define mainCHECK_TIMER_PERIOD_MS			( 3000UL / portTICK_RATE_MS )
 
+/* The number of times taskYIELD() is called to measure its average cost. */
+#define mainYIELD_COST_ITERATIONS			( 1000UL )
+
 /* Check timer callback function. */
 static void prvCheckTimerCallback( xTimerHandle xTimer );
 
@@ -128,6 +134,10 @@ only one task at a time. */
 static portBASE_TYPE prvTaskStatsCommand( signed char *pcWriteBuffer, size_t xWriteBufferLen, const signed char * pcCommandString );
 static portBASE_TYPE prvRunTimeStatsCommand( signed char *pcWriteBuffer, size_t xWriteBufferLen, const signed char * pcCommandString );
 
+/* Callback to handle the command line command defined by the xYieldCost
+command definition. */
+static portBASE_TYPE prvYieldCostCommand( signed char *pcWriteBuffer, size_t xWriteBufferLen, const signed char * pcCommandString );
+
 /* The string that latches the current demo status. */
 static char *pcStatusMessage = "All tasks running without error";
 
@@ -157,6 +167,15 @@ static const xCommandLineInput xTaskStats =
 	0
 };
 
+/* Structure that defines the "yield-cost" command line command. */
+static const xCommandLineInput xYieldCost =
+{
+	"yield-cost",
+	"yield-cost: Displays the average time taken by a call to taskYIELD()\r\n",
+	prvYieldCostCommand,
+	0
+};
+
 /*-----------------------------------------------------------*/
 
 int main( void )
@@ -184,10 +203,11 @@ const unsigned long ulLongTime_ms = 1000UL;
 	view on the web server and via the command line command interpreter. */
 	vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
 
-	/* Register two command line commands to show task stats and run time stats
-	respectively. */
+	/* Register command line commands to show task stats, run time stats and
+	the cost of a yield respectively. */
 	xCmdIntRegisterCommand( &xTaskStats );
 	xCmdIntRegisterCommand( &xRunTimeStats );
+	xCmdIntRegisterCommand( &xYieldCost );
 
 	/* Start the scheduler itself. */
 	vTaskStartScheduler();
@@ -358,5 +378,47 @@ const char * const pcHeader = "Task            Abs Time      % Time\r\n*********
 	pdFALSE. */
 	return pdFALSE;
 }
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvYieldCostCommand( signed char *pcWriteBuffer, size_t xWriteBufferLen, const signed char * pcCommandString )
+{
+LARGE_INTEGER liFrequency, liStart, liEnd;
+unsigned long ul, ulAverageNanoseconds;
+
+	configASSERT( pcWriteBuffer );
+
+	/* This function assumes the buffer length is adequate and does not look
+	for parameters. */
+	( void ) xWriteBufferLen;
+	( void ) pcCommandString;
+
+	/* Time a number of yields using the performance counter, as the run time
+	stats counter does not have the resolution required.  The time includes
+	any other tasks of the same priority that run in between. */
+	QueryPerformanceFrequency( &liFrequency );
+	QueryPerformanceCounter( &liStart );
+
+	for( ul = 0; ul < mainYIELD_COST_ITERATIONS; ul++ )
+	{
+		taskYIELD();
+	}
+
+	QueryPerformanceCounter( &liEnd );
 
+	ulAverageNanoseconds = ( unsigned long ) ( ( ( liEnd.QuadPart - liStart.QuadPart ) * 1000000000LL ) / ( liFrequency.QuadPart * ( long long ) mainYIELD_COST_ITERATIONS ) );
+
+	#if( configWIN32_USE_YIELD_EVENTS == 1 )
+	{
+		sprintf( ( char * ) pcWriteBuffer, "Average taskYIELD() time using yield events: %lu ns\r\n", ulAverageNanoseconds );
+	}
+	#else
+	{
+		sprintf( ( char * ) pcWriteBuffer, "Average taskYIELD() time using SuspendThread()/ResumeThread(): %lu ns\r\n", ulAverageNanoseconds );
+	}
+	#endif
+
+	/* There is no more data to return after this single string, so return
+	pdFALSE. */
+	return pdFALSE;
+}
 
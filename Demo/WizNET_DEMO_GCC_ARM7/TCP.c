@@ -212,8 +212,8 @@ static void prvReadRegister( unsigned char *pucDestination, unsigned short usAdd
 /* Send the entire Tx buffer (the Tx buffer within the WIZnet device). */
 static void prvFlushBuffer( unsigned long ulTxAddress );
 
-/* Write a string to the WIZnet Tx buffer. */
-static void prvWriteString( const char * const pucTxBuffer, long lTxLen, unsigned long *pulTxAddress );
+/* Set up a message that writes a string to the WIZnet Tx buffer. */
+static void prvInitTxWrite( xI2CMessage *pxMessage, const char * const pucTxBuffer, long lTxLen, unsigned long *pulTxAddress );
 
 /* Convert a number to a string. */
 void ultoa( unsigned long ulVal, char *pcBuffer, long lIgnore );
@@ -258,18 +258,20 @@ long lIndex;
 static void prvReadRegister( unsigned char *pucDestination, unsigned short usAddress, unsigned long ulLength )
 {
 unsigned char ucRxBuffer[ tcpMAX_REGISTER_LEN ];
+xI2CMessage xRead[ 2 ];
 
 	/* Read a register value from the WIZnet device. */
 
-	/* First write out the address of the register we want to read. */
-	i2cMessage( ucRxBuffer, i2cNO_DATA_REQUIRED, tcpDEVICE_ADDRESS, usAddress, i2cWRITE, NULL, portMAX_DELAY );
-	
-	/* Then read back from that address. */
-	i2cMessage( ( unsigned char * ) pucDestination, ulLength, tcpDEVICE_ADDRESS, i2cNO_ADDR_REQUIRED, i2cREAD, xMessageComplete, portMAX_DELAY );
+	/* First write out the address of the register we want to read, then read
+	back from that address after a repeated start.  Both go out as one 
+	transaction so the bus is not released in between. */
+	i2cInitMessage( &( xRead[ 0 ] ), ucRxBuffer, i2cNO_DATA_REQUIRED, tcpDEVICE_ADDRESS, usAddress, i2cWRITE );
+	i2cInitMessage( &( xRead[ 1 ] ), pucDestination, ( long ) ulLength, tcpDEVICE_ADDRESS, i2cNO_ADDR_REQUIRED, i2cREAD );
+	i2cTransaction( xRead, 2, xMessageComplete, NULL, NULL, portMAX_DELAY );
 
 	/* I2C messages are queued so use the semaphore to wait for the read to 
 	complete - otherwise we will leave this function before the I2C 
-	transactions have completed. */
+	transactions have completed, and while xRead is still in use. */
 	xSemaphoreTake( xMessageComplete, tcpLONG_DELAY );
 }
 /*-----------------------------------------------------------*/
@@ -625,24 +627,17 @@ unsigned long ulWritePointer, ulAckPointer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvWriteString( const char * const pucTxBuffer, long lTxLen, unsigned long *pulTxAddress )
+static void prvInitTxWrite( xI2CMessage *pxMessage, const char * const pucTxBuffer, long lTxLen, unsigned long *pulTxAddress )
 {
 unsigned long ulSendAddress;
 
-	/* Send a string to the Tx buffer internal to the WIZnet device. */
+	/* Set up a message that sends a string to the Tx buffer internal to the
+	WIZnet device. */
 
 	/* Calculate the address to which we are going to write in the buffer. */
 	ulSendAddress = ( *pulTxAddress & tcpSINGLE_SOCKET_ADDR_MASK ) + tcpSINGLE_SOCKET_ADDR_OFFSET;
 
-	/* Send the buffer to the calculated address.  Use the semaphore so we
-	can wait until the entire message has been transferred. */
-	i2cMessage( ( unsigned char * ) pucTxBuffer, lTxLen, tcpDEVICE_ADDRESS, ( unsigned short ) ulSendAddress, i2cWRITE, xMessageComplete, portMAX_DELAY );
-
-	/* Wait until the semaphore indicates that the message has been transferred. */
-	if( !xSemaphoreTake( xMessageComplete, tcpLONG_DELAY ) )
-	{
-		return;
-	}
+	i2cInitMessage( pxMessage, ( unsigned char * ) pucTxBuffer, lTxLen, tcpDEVICE_ADDRESS, ( unsigned short ) ulSendAddress, i2cWRITE );
 
 	/* Return the new address of the end of the buffer (within the WIZnet 
 	device). */
@@ -700,6 +695,7 @@ unsigned char ucShadow;
 long lIndex;
 static unsigned long ulRefreshCount = 0x00;
 static char cPageBuffer[ tcpBUFFER_LEN ];
+static xI2CMessage xPageStart, xPageEnd[ 2 ];
 
 
 	/* This function just generates a sample page of HTML which gets
@@ -720,8 +716,10 @@ static char cPageBuffer[ tcpBUFFER_LEN ];
 	/* Make sure endieness is correct. */
 	ulTxAddress = htonl( ulTxAddress );
 
-	/* Send the start of the page. */
-	prvWriteString( cSamplePageFirstPart, strlen( cSamplePageFirstPart ), &ulTxAddress );
+	/* Send the start of the page.  This is not waited for - the fixed string
+	is clocked out while the dynamic part is generated below. */
+	prvInitTxWrite( &xPageStart, cSamplePageFirstPart, strlen( cSamplePageFirstPart ), &ulTxAddress );
+	i2cTransaction( &xPageStart, 1, NULL, NULL, NULL, portMAX_DELAY );
 
 	/* Generate a bit of dynamic data and place it in the buffer ready to be
 	transmitted. */
@@ -749,11 +747,17 @@ static char cPageBuffer[ tcpBUFFER_LEN ];
 
 	ulRefreshCount++;
 
-	/* Send the dynamically generated string. */
-	prvWriteString( cPageBuffer, strlen( cPageBuffer ), &ulTxAddress );
+	/* Send the dynamically generated string and finish the page in one
+	transaction.  Messages are transacted in order so once the semaphore
+	indicates this has completed the start of the page has also been sent. */
+	prvInitTxWrite( &( xPageEnd[ 0 ] ), cPageBuffer, strlen( cPageBuffer ), &ulTxAddress );
+	prvInitTxWrite( &( xPageEnd[ 1 ] ), cSamplePageSecondPart, strlen( cSamplePageSecondPart ), &ulTxAddress );
+	i2cTransaction( xPageEnd, 2, xMessageComplete, NULL, NULL, portMAX_DELAY );
 
-	/* Finish the page. */
-	prvWriteString( cSamplePageSecondPart, strlen( cSamplePageSecondPart ), &ulTxAddress );
+	if( !xSemaphoreTake( xMessageComplete, tcpLONG_DELAY ) )
+	{
+		return;
+	}
 
 	/* Tell the WIZnet to send the data we have just written to its Tx buffer. */
 	prvFlushBuffer( ulTxAddress );
@@ -107,12 +107,15 @@ static xQueueHandle xMessagesForTx;
 /* Flag to indicate the state of the I2C ISR state machine. */
 static unsigned long *pulBusFree;
 
+/* Start the ISR transacting pxMessage if the bus is free, otherwise queue it
+behind the messages already waiting.  Must be called from a critical 
+section. */
+static void prvStartOrQueueMessage( xI2CMessage *pxMessage, portTickType xBlockTime );
+
 /*-----------------------------------------------------------*/
 void i2cMessage( const unsigned char * const pucMessage, long lMessageLength, unsigned char ucSlaveAddress, unsigned short usBufferAddress, unsigned long ulDirection, xSemaphoreHandle xMessageCompleteSemaphore, portTickType xBlockTime )
 {
-extern volatile xI2CMessage *pxCurrentMessage;
 xI2CMessage *pxNextFreeMessage;
-signed portBASE_TYPE xReturn;
 
 	portENTER_CRITICAL();
 	{
@@ -150,6 +153,11 @@ signed portBASE_TYPE xReturn;
 		usBufferAddress >>= 8;
 		pxNextFreeMessage->ucBufferAddressHighByte = ( unsigned char ) ( usBufferAddress & 0xff );
 
+		/* A message sent through this function is a transaction on its own. */
+		pxNextFreeMessage->pxNextMessage = NULL;
+		pxNextFreeMessage->pxCompleteCallback = NULL;
+		pxNextFreeMessage->pvCallbackParameter = NULL;
+
 		/* Increment to the next message in the array - with a wrap around check. */
 		ulNextFreeMessage++;
 		if( ulNextFreeMessage >= ( i2cQUEUE_LENGTH + i2cEXTRA_MESSAGES ) )
@@ -157,44 +165,99 @@ signed portBASE_TYPE xReturn;
 			ulNextFreeMessage = ( unsigned long ) 0;
 		}
 
-		/* Is the I2C interrupt in the middle of transmitting a message? */
-		if( *pulBusFree == ( unsigned long ) pdTRUE )
+		prvStartOrQueueMessage( pxNextFreeMessage, xBlockTime );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void i2cInitMessage( xI2CMessage *pxMessage, unsigned char *pucBuffer, long lMessageLength, unsigned char ucSlaveAddress, unsigned short usBufferAddress, unsigned long ulDirection )
+{
+	pxMessage->pucBuffer = pucBuffer;
+	pxMessage->ucSlaveAddress = ucSlaveAddress | ( unsigned char ) ulDirection;
+	pxMessage->lMessageLength = lMessageLength;
+	pxMessage->ucBufferAddressLowByte = ( unsigned char ) ( usBufferAddress & 0xff );
+	usBufferAddress >>= 8;
+	pxMessage->ucBufferAddressHighByte = ( unsigned char ) ( usBufferAddress & 0xff );
+	pxMessage->xMessageCompleteSemaphore = NULL;
+	pxMessage->pxNextMessage = NULL;
+	pxMessage->pxCompleteCallback = NULL;
+	pxMessage->pvCallbackParameter = NULL;
+}
+/*-----------------------------------------------------------*/
+
+void i2cTransaction( xI2CMessage *pxMessages, unsigned long ulNumberOfMessages, xSemaphoreHandle xTransactionCompleteSemaphore, pdI2C_CALLBACK pxCallback, void *pvCallbackParameter, portTickType xBlockTime )
+{
+unsigned long ulMessage;
+
+	if( ulNumberOfMessages == ( unsigned long ) 0 )
+	{
+		return;
+	}
+
+	/* Link the messages so the ISR moves from one to the next with a repeated
+	start.  Only the last message signals completion - the ISR does not look at
+	the semaphore or callback of the others. */
+	for( ulMessage = ( unsigned long ) 0; ulMessage < ( ulNumberOfMessages - ( unsigned long ) 1 ); ulMessage++ )
+	{
+		pxMessages[ ulMessage ].pxNextMessage = &( pxMessages[ ulMessage + 1 ] );
+	}
+
+	pxMessages[ ulMessage ].pxNextMessage = NULL;
+	pxMessages[ ulMessage ].xMessageCompleteSemaphore = xTransactionCompleteSemaphore;
+	pxMessages[ ulMessage ].pxCompleteCallback = pxCallback;
+	pxMessages[ ulMessage ].pvCallbackParameter = pvCallbackParameter;
+
+	/* Only the first message is queued, the rest follow it on the bus. */
+	portENTER_CRITICAL();
+	{
+		prvStartOrQueueMessage( pxMessages, xBlockTime );
+	}
+	portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartOrQueueMessage( xI2CMessage *pxMessage, portTickType xBlockTime )
+{
+extern volatile xI2CMessage *pxCurrentMessage;
+signed portBASE_TYPE xReturn;
+
+	/* Is the I2C interrupt in the middle of transmitting a message? */
+	if( *pulBusFree == ( unsigned long ) pdTRUE )
+	{
+		/* No message is currently being sent or queued to be sent.  We
+		can start the ISR sending this message immediately. */
+		pxCurrentMessage = pxMessage;
+
+		I2C_I2CONCLR = i2cSI_BIT;	
+		I2C_I2CONSET = i2cSTA_BIT;
+		
+		*pulBusFree = ( unsigned long ) pdFALSE;
+	}
+	else
+	{
+		/* The I2C interrupt routine is mid sending a message.  Queue
+		this message ready to be sent. */
+		xReturn = xQueueSend( xMessagesForTx, &pxMessage, xBlockTime );
+
+		/* We may have blocked while trying to queue the message.  If this
+		was the case then the interrupt would have been enabled and we may
+		now find that the I2C interrupt routine is no longer sending a
+		message. */
+		if( ( *pulBusFree == ( unsigned long ) pdTRUE ) && ( xReturn == pdPASS ) )
 		{
-			/* No message is currently being sent or queued to be sent.  We
-			can start the ISR sending this message immediately. */
-			pxCurrentMessage = pxNextFreeMessage;
+			/* Get the next message in the queue (this should be the 
+			message we just posted) and start off the transmission
+			again. */
+			xQueueReceive( xMessagesForTx, &pxMessage, i2cNO_BLOCK );
+			pxCurrentMessage = pxMessage;
 
 			I2C_I2CONCLR = i2cSI_BIT;	
 			I2C_I2CONSET = i2cSTA_BIT;
 			
 			*pulBusFree = ( unsigned long ) pdFALSE;
 		}
-		else
-		{
-			/* The I2C interrupt routine is mid sending a message.  Queue
-			this message ready to be sent. */
-			xReturn = xQueueSend( xMessagesForTx, &pxNextFreeMessage, xBlockTime );
-
-			/* We may have blocked while trying to queue the message.  If this
-			was the case then the interrupt would have been enabled and we may
-			now find that the I2C interrupt routine is no longer sending a
-			message. */
-			if( ( *pulBusFree == ( unsigned long ) pdTRUE ) && ( xReturn == pdPASS ) )
-			{
-				/* Get the next message in the queue (this should be the 
-				message we just posted) and start off the transmission
-				again. */
-				xQueueReceive( xMessagesForTx, &pxNextFreeMessage, i2cNO_BLOCK );
-				pxCurrentMessage = pxNextFreeMessage;
-
-				I2C_I2CONCLR = i2cSI_BIT;	
-				I2C_I2CONSET = i2cSTA_BIT;
-				
-				*pulBusFree = ( unsigned long ) pdFALSE;
-			}
-		}
 	}
-	portEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
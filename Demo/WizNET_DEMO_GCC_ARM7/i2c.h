@@ -54,6 +54,12 @@
 #ifndef I2C_H
 #define I2C_H
 
+/* Function called by the I2C ISR when the last message of a transaction
+ * completes.  As it executes within the ISR it must only use the FromISR API
+ * functions, passing in pxHigherPriorityTaskWoken.
+ */
+typedef void ( *pdI2C_CALLBACK )( void *pvParameter, portBASE_TYPE *pxHigherPriorityTaskWoken );
+
 /* Structure used to capture the I2C message details.  The structure is then
  * queued for processing by the I2C ISR. 
  */
@@ -65,6 +71,9 @@ typedef struct AN_I2C_MESSAGE
 	unsigned char ucBufferAddressHighByte;	/*< As above, high byte. */
 	xSemaphoreHandle xMessageCompleteSemaphore;	/*< Contains a reference to a semaphore if the application tasks wants notifying when the message has been transacted. */
 	unsigned char *pucBuffer;				/*< Pointer to the buffer from where data will be read for transmission, or into which received data will be placed. */
+	struct AN_I2C_MESSAGE *pxNextMessage;	/*< The next message in the same transaction, started with a repeated start rather than a stop.  NULL for the last message. */
+	pdI2C_CALLBACK pxCompleteCallback;		/*< Called from the ISR when this message completes, or NULL. */
+	void *pvCallbackParameter;				/*< Passed into pxCompleteCallback. */
 } xI2CMessage;
 
 /* Constants to use as the ulDirection parameter of i2cMessage(). */
@@ -103,5 +112,40 @@ void i2cInit( void );
  */
 void i2cMessage( const unsigned char * const pucMessage, long lMessageLength, unsigned char ucSlaveAddress, unsigned short usBufferAddress, unsigned long ulDirection, xSemaphoreHandle xMessageCompleteSemaphore, portTickType xBlockTime );
 
+/**
+ * Fill in a message structure that is owned by the caller, ready to be passed
+ * to i2cTransaction().  The parameters have the same meaning as the equally
+ * named i2cMessage() parameters.
+ */
+void i2cInitMessage( xI2CMessage *pxMessage, unsigned char *pucBuffer, long lMessageLength, unsigned char ucSlaveAddress, unsigned short usBufferAddress, unsigned long ulDirection );
+
+/**
+ * Send or receive a scatter list of messages as a single bus transaction.
+ * The messages are transacted in array order, each after a repeated start, 
+ * and the bus is only released once the last has completed - so a register
+ * address write can be followed directly by the read of that register.
+ *
+ * Neither the messages nor the buffers they point to are copied so both must
+ * remain valid until the transaction has completed.
+ *
+ * @param pxMessages	 Array of messages set up by i2cInitMessage().
+ *
+ * @param ulNumberOfMessages The number of messages in the array.
+ *
+ * @param xTransactionCompleteSemaphore
+ *						 Given when the last message completes, or NULL.
+ *
+ * @param pxCallback	 Called from the I2C ISR when the last message 
+ *						 completes, or NULL.  Neither the callback nor the 
+ *						 semaphore are used if the transaction fails.
+ *
+ * @param pvCallbackParameter Passed into pxCallback.
+ *
+ * @param xBlockTime	 The time to wait for a space in the message queue to 
+ *						 become available should one not be available 
+ *						 immediately.
+ */
+void i2cTransaction( xI2CMessage *pxMessages, unsigned long ulNumberOfMessages, xSemaphoreHandle xTransactionCompleteSemaphore, pdI2C_CALLBACK pxCallback, void *pvCallbackParameter, portTickType xBlockTime );
+
 #endif
 
@@ -112,6 +112,9 @@ typedef enum
 /* Points to the message currently being sent. */
 volatile xI2CMessage *pxCurrentMessage = NULL;	
 
+/* Holds the current transmission state. */							
+static I2C_STATE eCurrentState = eSentStart;
+
 /* The queue of messages waiting to be transmitted. */
 static xQueueHandle xMessagesForTx;
 
@@ -144,6 +147,11 @@ void vI2C_ISR_Wrapper( void ) __attribute__ (( naked ));
 function from the wrapper to ensure the correct stack frame is set up. */
 void vI2C_ISR_Handler( void );
 
+/* Called when the last byte of the current message has been transacted.
+Moves on to the next message of the same transaction with a repeated start,
+or ends the transaction and starts the next one queued. */
+static void prvMessageComplete( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
 /*-----------------------------------------------------------*/
 
 void vI2C_ISR_Wrapper( void )
@@ -160,13 +168,62 @@ void vI2C_ISR_Wrapper( void )
 }
 /*-----------------------------------------------------------*/
 
+static void prvMessageComplete( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+	if( pxCurrentMessage->pxNextMessage != NULL )
+	{
+		/* More messages in this transaction.  Send a repeated start instead 
+		of a stop so the bus is not released between them. */
+		pxCurrentMessage = pxCurrentMessage->pxNextMessage;
+		I2C_I2CONCLR = i2cAA_BIT;
+		I2C_I2CONSET = i2cSTA_BIT;
+		eCurrentState = eSentStart;
+	}
+	else
+	{
+		/* Finished the transaction - send a stop bit. */
+		i2cEND_TRANSMISSION( pdPASS );
+
+		/* If xMessageCompleteSemaphore is not null then there is a task 
+		waiting for this message to complete and we must 'give' the semaphore
+		so the task is woken. */
+		if( pxCurrentMessage->xMessageCompleteSemaphore )
+		{
+			xSemaphoreGiveFromISR( pxCurrentMessage->xMessageCompleteSemaphore, pxHigherPriorityTaskWoken );
+		}
+
+		if( pxCurrentMessage->pxCompleteCallback )
+		{
+			pxCurrentMessage->pxCompleteCallback( pxCurrentMessage->pvCallbackParameter, pxHigherPriorityTaskWoken );
+		}
+
+		/* Are there any other messages to transact? */
+		if( xQueueReceiveFromISR( xMessagesForTx, &pxCurrentMessage, pxHigherPriorityTaskWoken ) == pdTRUE )
+		{
+			/* Start the next message - which was retrieved from the 
+			queue. */
+			I2C_I2CONSET = i2cSTA_BIT;
+		}
+		else
+		{
+			/* No more messages were found to be waiting for transaction so
+			the bus is free. */
+			ulBusFree = ( unsigned long ) pdTRUE;			
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
 void vI2C_ISR_Handler( void )
 {
-/* Holds the current transmission state. */							
-static I2C_STATE eCurrentState = eSentStart;
 static long lMessageIndex = -i2cBUFFER_ADDRESS_BYTES; /* There are two address bytes to send prior to the data. */
 portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 long lBytesLeft;
+unsigned long ulStatus;
+
+	/* Read the status once - each access to the peripheral goes over the
+	slower VPB bus. */
+	ulStatus = I2C_I2STAT;
 
 	/* The action taken for this interrupt depends on our current state. */
 	switch( eCurrentState )
@@ -175,7 +232,7 @@ long lBytesLeft;
 
 				/* We sent a start bit, if it was successful we can
 				go on to send the slave address. */
-				if( ( I2C_I2STAT == i2cSTATUS_START_TXED ) || ( I2C_I2STAT == i2cSTATUS_REP_START_TXED ) )
+				if( ( ulStatus == i2cSTATUS_START_TXED ) || ( ulStatus == i2cSTATUS_REP_START_TXED ) )
 				{
 					/* Send the slave address. */
 					I2C_I2DAT = pxCurrentMessage->ucSlaveAddress;
@@ -215,7 +272,7 @@ long lBytesLeft;
 
 				/* We sent the address of the slave we are going to write to.
 				If this was acknowledged we	can go on to send the data. */
-				if( I2C_I2STAT == i2cSTATUS_TX_ADDR_ACKED )
+				if( ulStatus == i2cSTATUS_TX_ADDR_ACKED )
 				{
 					/* Start the first byte transmitting which is the 
 					first byte of the buffer address to which the data will 
@@ -234,7 +291,7 @@ long lBytesLeft;
 
 				/* We sent the address of the slave we are going to read from.
 				If this was acknowledged we can go on to read the data. */
-				if( I2C_I2STAT == i2cSTATUS_RX_ADDR_ACKED )
+				if( ulStatus == i2cSTATUS_RX_ADDR_ACKED )
 				{
 					eCurrentState = eReceiveData;
 					if( pxCurrentMessage->lMessageLength > i2cJUST_ONE_BYTE_TO_RX )
@@ -253,7 +310,7 @@ long lBytesLeft;
 		case eReceiveData :
 				
 				/* We have just received a byte from the slave. */
-				if( ( I2C_I2STAT == i2cSTATUS_DATA_RXED ) || ( I2C_I2STAT == i2cSTATUS_LAST_BYTE_RXED ) )
+				if( ( ulStatus == i2cSTATUS_DATA_RXED ) || ( ulStatus == i2cSTATUS_LAST_BYTE_RXED ) )
 				{
 					/* Buffer the byte just received then increment the index 
 					so it points to the next free space. */
@@ -265,29 +322,7 @@ long lBytesLeft;
 					if( lBytesLeft == ( unsigned long ) 0 )
 					{
 						/* This was the last byte in the message. */
-						i2cEND_TRANSMISSION( pdPASS );
-
-						/* If xMessageCompleteSemaphore is not null then there
-						is a task waiting for this message to complete and we
-						must 'give' the semaphore so the task is woken.*/
-						if( pxCurrentMessage->xMessageCompleteSemaphore )
-						{
-							xSemaphoreGiveFromISR( pxCurrentMessage->xMessageCompleteSemaphore, &xHigherPriorityTaskWoken );
-						}
-
-						/* Are there any other messages to transact? */
-						if( xQueueReceiveFromISR( xMessagesForTx, &pxCurrentMessage, &xHigherPriorityTaskWoken ) == pdTRUE )
-						{
-							/* Start the next message - which was
-							retrieved from the queue. */
-							I2C_I2CONSET = i2cSTA_BIT;
-						}
-						else
-						{
-							/* No more messages were found to be waiting for
-							transaction so the bus is free. */
-							ulBusFree = ( unsigned long ) pdTRUE;			
-						}						
+						prvMessageComplete( &xHigherPriorityTaskWoken );
 					}
 					else
 					{
@@ -311,7 +346,7 @@ long lBytesLeft;
 
 				/* We sent a data byte, if successful send the	next byte in 
 				the message. */
-				if( I2C_I2STAT == i2cSTATUS_DATA_TXED )
+				if( ulStatus == i2cSTATUS_DATA_TXED )
 				{
 					/* Index to the next byte to send. */
 					lMessageIndex++;
@@ -331,30 +366,8 @@ long lBytesLeft;
 					}
 					else
 					{
-						/* No more bytes in this message to be send.  Finished 
-						sending message - send a stop bit. */
-						i2cEND_TRANSMISSION( pdPASS );
-
-						/* If xMessageCompleteSemaphore is not null then there
-						is a task waiting for this message to be sent and the
-						semaphore must be 'given' to wake the task. */
-						if( pxCurrentMessage->xMessageCompleteSemaphore )
-						{
-							xSemaphoreGiveFromISR( pxCurrentMessage->xMessageCompleteSemaphore, &xHigherPriorityTaskWoken );
-						}
-
-						/* Are there any other messages to transact? */
-						if( xQueueReceiveFromISR( xMessagesForTx, &pxCurrentMessage, &xHigherPriorityTaskWoken ) == pdTRUE )
-						{
-							/* Start the next message from the Tx queue. */
-							I2C_I2CONSET = i2cSTA_BIT;
-						}
-						else
-						{
-							/* No more message were queues for transaction so 
-							the bus is free. */
-							ulBusFree = ( unsigned long ) pdTRUE;			
-						}
+						/* No more bytes in this message to be sent. */
+						prvMessageComplete( &xHigherPriorityTaskWoken );
 					}
 				}
 				else
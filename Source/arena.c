@@ -0,0 +1,167 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The definition of an arena.  The structure is placed at the aligned start of
+the region it manages, and the memory available for allocation follows it.
+Offsets rather than pointers are kept so the free space check cannot wrap. */
+typedef struct ArenaDefinition
+{
+	unsigned char *pucStart;				/*< The first byte available for allocation. */
+	size_t xSize;							/*< The number of bytes available for allocation. */
+	size_t xBytesUsed;						/*< The offset from pucStart of the next allocation. */
+	size_t xMaxBytesUsed;					/*< The highest value xBytesUsed has had. */
+	unsigned long ulFailedAllocations;		/*< The number of allocations that did not fit. */
+} xARENA;
+
+/* The size of the structure rounded up so the first allocation is aligned. */
+#define arenaSTRUCT_SIZE	( ( sizeof( xARENA ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*-----------------------------------------------------------*/
+
+xArenaHandle xArenaCreate( void *pvBuffer, size_t xBufferSizeBytes )
+{
+xARENA *pxArena = NULL;
+size_t xAlignmentBytes;
+
+	configASSERT( pvBuffer );
+
+	/* Skip any bytes at the start of the region that are not aligned. */
+	xAlignmentBytes = ( size_t ) ( ( portBYTE_ALIGNMENT - ( ( ( portPOINTER_SIZE_TYPE ) pvBuffer ) & portBYTE_ALIGNMENT_MASK ) ) & portBYTE_ALIGNMENT_MASK );
+
+	if( xBufferSizeBytes >= ( xAlignmentBytes + arenaSTRUCT_SIZE ) )
+	{
+		pxArena = ( xARENA * ) ( ( ( unsigned char * ) pvBuffer ) + xAlignmentBytes );
+		pxArena->pucStart = ( ( unsigned char * ) pxArena ) + arenaSTRUCT_SIZE;
+
+		/* Only whole aligned units are usable, so every allocation can be
+		rounded up without running past the end of the region. */
+		pxArena->xSize = ( xBufferSizeBytes - xAlignmentBytes - arenaSTRUCT_SIZE ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pxArena->xBytesUsed = 0U;
+		pxArena->xMaxBytesUsed = 0U;
+		pxArena->ulFailedAllocations = 0UL;
+	}
+
+	return ( xArenaHandle ) pxArena;
+}
+/*-----------------------------------------------------------*/
+
+void *pvArenaAlloc( xArenaHandle xArena, size_t xWantedSize )
+{
+xARENA * const pxArena = ( xARENA * ) xArena;
+void *pvReturn = NULL;
+size_t xBytesFree;
+
+	configASSERT( pxArena );
+
+	xBytesFree = pxArena->xSize - pxArena->xBytesUsed;
+
+	/* xBytesFree is a multiple of the alignment, so a request that fits
+	before rounding still fits after it, and the rounding cannot overflow. */
+	if( xWantedSize <= xBytesFree )
+	{
+		if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+		{
+			xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+		}
+
+		pvReturn = ( void * ) ( pxArena->pucStart + pxArena->xBytesUsed );
+		pxArena->xBytesUsed += xWantedSize;
+
+		if( pxArena->xBytesUsed > pxArena->xMaxBytesUsed )
+		{
+			pxArena->xMaxBytesUsed = pxArena->xBytesUsed;
+		}
+	}
+	else
+	{
+		( pxArena->ulFailedAllocations )++;
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaReset( xArenaHandle xArena )
+{
+xARENA * const pxArena = ( xARENA * ) xArena;
+
+	configASSERT( pxArena );
+
+	pxArena->xBytesUsed = 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaGetStats( xArenaHandle xArena, xArenaStats *pxStats )
+{
+xARENA * const pxArena = ( xARENA * ) xArena;
+
+	configASSERT( pxArena );
+	configASSERT( pxStats );
+
+	pxStats->xSize = pxArena->xSize;
+	pxStats->xBytesUsed = pxArena->xBytesUsed;
+	pxStats->xMaxBytesUsed = pxArena->xMaxBytesUsed;
+	pxStats->ulFailedAllocations = pxArena->ulFailedAllocations;
+}
@@ -0,0 +1,265 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Ports that have load-linked/store-conditional instructions define both
+portLOAD_EXCLUSIVE() and portSTORE_EXCLUSIVE().  portCLEAR_EXCLUSIVE() releases
+a reservation that is not going to be stored to, where the architecture needs
+it. */
+#if defined( portLOAD_EXCLUSIVE ) && defined( portSTORE_EXCLUSIVE )
+	#define atomicUSE_EXCLUSIVE		1
+#else
+	#define atomicUSE_EXCLUSIVE		0
+#endif
+
+#ifndef portCLEAR_EXCLUSIVE
+	#define portCLEAR_EXCLUSIVE()
+#endif
+
+/* The critical section used by ports that do not have exclusive access
+instructions.  It must be usable from an interrupt as well as a task where the
+port allows. */
+#if ( portHAS_INTERRUPT_MASK_FROM_ISR == 1 )
+	#define atomicENTER_CRITICAL()	uxSavedInterruptStatus = ( unsigned portBASE_TYPE ) taskENTER_CRITICAL_FROM_ISR()
+	#define atomicEXIT_CRITICAL()	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+#else
+	#define atomicENTER_CRITICAL()	taskENTER_CRITICAL(); ( void ) uxSavedInterruptStatus
+	#define atomicEXIT_CRITICAL()	taskEXIT_CRITICAL()
+#endif
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xAtomicCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExchange, unsigned long ulComparand )
+{
+portBASE_TYPE xReturn;
+
+	#if ( atomicUSE_EXCLUSIVE == 1 )
+	{
+		for( ;; )
+		{
+			if( portLOAD_EXCLUSIVE( pulDestination ) != ulComparand )
+			{
+				portCLEAR_EXCLUSIVE();
+				xReturn = pdFALSE;
+				break;
+			}
+
+			if( portSTORE_EXCLUSIVE( pulDestination, ulExchange ) != pdFALSE )
+			{
+				xReturn = pdTRUE;
+				break;
+			}
+		}
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0;
+
+		atomicENTER_CRITICAL();
+		{
+			if( *pulDestination == ulComparand )
+			{
+				*pulDestination = ulExchange;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		atomicEXIT_CRITICAL();
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulAtomicAdd( volatile unsigned long *pulDestination, unsigned long ulValue )
+{
+unsigned long ulOriginal;
+
+	#if ( atomicUSE_EXCLUSIVE == 1 )
+	{
+		do
+		{
+			ulOriginal = portLOAD_EXCLUSIVE( pulDestination );
+		} while( portSTORE_EXCLUSIVE( pulDestination, ulOriginal + ulValue ) == pdFALSE );
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0;
+
+		atomicENTER_CRITICAL();
+		{
+			ulOriginal = *pulDestination;
+			*pulDestination = ulOriginal + ulValue;
+		}
+		atomicEXIT_CRITICAL();
+	}
+	#endif
+
+	return ulOriginal;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulAtomicSetBits( volatile unsigned long *pulDestination, unsigned long ulBits )
+{
+unsigned long ulOriginal;
+
+	#if ( atomicUSE_EXCLUSIVE == 1 )
+	{
+		do
+		{
+			ulOriginal = portLOAD_EXCLUSIVE( pulDestination );
+		} while( portSTORE_EXCLUSIVE( pulDestination, ulOriginal | ulBits ) == pdFALSE );
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0;
+
+		atomicENTER_CRITICAL();
+		{
+			ulOriginal = *pulDestination;
+			*pulDestination = ulOriginal | ulBits;
+		}
+		atomicEXIT_CRITICAL();
+	}
+	#endif
+
+	return ulOriginal;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulAtomicClearBits( volatile unsigned long *pulDestination, unsigned long ulBits )
+{
+unsigned long ulOriginal;
+
+	#if ( atomicUSE_EXCLUSIVE == 1 )
+	{
+		do
+		{
+			ulOriginal = portLOAD_EXCLUSIVE( pulDestination );
+		} while( portSTORE_EXCLUSIVE( pulDestination, ulOriginal & ~ulBits ) == pdFALSE );
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0;
+
+		atomicENTER_CRITICAL();
+		{
+			ulOriginal = *pulDestination;
+			*pulDestination = ulOriginal & ~ulBits;
+		}
+		atomicEXIT_CRITICAL();
+	}
+	#endif
+
+	return ulOriginal;
+}
+/*-----------------------------------------------------------*/
+
+void vAtomicSetBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit )
+{
+	configASSERT( uxBit < ( unsigned portBASE_TYPE ) 32U );
+
+	#ifdef portBIT_BAND_ALIAS
+	{
+	volatile unsigned long *pulAlias;
+
+		/* NULL if the variable is not in a bit-band region. */
+		pulAlias = portBIT_BAND_ALIAS( pulDestination, uxBit );
+		if( pulAlias != NULL )
+		{
+			*pulAlias = 1UL;
+			return;
+		}
+	}
+	#endif
+
+	( void ) ulAtomicSetBits( pulDestination, 1UL << uxBit );
+}
+/*-----------------------------------------------------------*/
+
+void vAtomicClearBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit )
+{
+	configASSERT( uxBit < ( unsigned portBASE_TYPE ) 32U );
+
+	#ifdef portBIT_BAND_ALIAS
+	{
+	volatile unsigned long *pulAlias;
+
+		pulAlias = portBIT_BAND_ALIAS( pulDestination, uxBit );
+		if( pulAlias != NULL )
+		{
+			*pulAlias = 0UL;
+			return;
+		}
+	}
+	#endif
+
+	( void ) ulAtomicClearBits( pulDestination, 1UL << uxBit );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,319 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "basic_task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if configUSE_TASK_NOTIFICATIONS != 1
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use basic tasks.
+#endif
+
+/* The largest number of activations a basic task can have pending. */
+#define basicMAX_ACTIVATIONS	( ~( ( unsigned portBASE_TYPE ) 0U ) )
+
+/* The definition of a level.  The members are only accessed from within a
+critical section (or with interrupts masked) so basic tasks can be activated
+from both tasks and interrupts.  A basic task is on the waiting list when it
+has pending activations and is not the one running, so each basic task is on
+the list at most once however many activations it has pending. */
+typedef struct BasicTaskLevelDefinition
+{
+	xBasicTask *pxHead;			/*< The basic task that runs next, or NULL if none are waiting. */
+	xBasicTask *pxTail;			/*< The basic task most recently added to the waiting list. */
+	xBasicTask *pxRunning;		/*< The basic task being run by the level, or NULL if none is. */
+	xTaskHandle xTask;			/*< The task that runs the basic tasks, and whose stack they share. */
+} xBASIC_TASK_LEVEL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task of a level.  Runs the basic task at the head of the waiting list
+ * until the list is empty, then waits to be notified that a basic task has
+ * been activated.
+ */
+static void prvBasicTaskLevel( void *pvParameters );
+
+/*
+ * Records an activation of pxBasicTask, adding it to the tail of the waiting
+ * list of its level if it was neither waiting nor running.  Returns pdFAIL if
+ * the activation count is already at its maximum, otherwise pdPASS.
+ * *pxNotifyLevel is set to pdTRUE if the level is idle, so has to be
+ * notified.  Must be called from a critical section.
+ */
+static portBASE_TYPE prvActivate( xBasicTask * const pxBasicTask, portBASE_TYPE * const pxNotifyLevel );
+
+/*
+ * Adds pxBasicTask to the tail of the waiting list of pxLevel.  Must be called
+ * from a critical section.
+ */
+static void prvAddToWaitingList( xBASIC_TASK_LEVEL * const pxLevel, xBasicTask * const pxBasicTask );
+
+/*-----------------------------------------------------------*/
+
+xBasicTaskLevelHandle xBasicTaskLevelCreate( const signed char * const pcName, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority )
+{
+xBASIC_TASK_LEVEL *pxLevel;
+
+	pxLevel = ( xBASIC_TASK_LEVEL * ) pvPortMalloc( sizeof( xBASIC_TASK_LEVEL ) );
+
+	if( pxLevel != NULL )
+	{
+		pxLevel->pxHead = NULL;
+		pxLevel->pxTail = NULL;
+		pxLevel->pxRunning = NULL;
+
+		if( xTaskCreate( prvBasicTaskLevel, pcName, usStackDepth, ( void * ) pxLevel, uxPriority, &( pxLevel->xTask ) ) != pdPASS )
+		{
+			vPortFree( pxLevel );
+			pxLevel = NULL;
+		}
+	}
+
+	if( pxLevel != NULL )
+	{
+		traceBASIC_TASK_LEVEL_CREATE( pxLevel );
+	}
+	else
+	{
+		traceBASIC_TASK_LEVEL_CREATE_FAILED();
+	}
+
+	return ( xBasicTaskLevelHandle ) pxLevel;
+}
+/*-----------------------------------------------------------*/
+
+void vBasicTaskInit( xBasicTask *pxBasicTask, xBasicTaskLevelHandle xLevel, pdBASIC_TASK_CODE pxTaskCode, void *pvParameters )
+{
+	configASSERT( pxBasicTask );
+	configASSERT( xLevel );
+	configASSERT( pxTaskCode );
+
+	pxBasicTask->pxTaskCode = pxTaskCode;
+	pxBasicTask->pvParameters = pvParameters;
+	pxBasicTask->pxNextBasicTask = NULL;
+	pxBasicTask->xLevel = xLevel;
+	pxBasicTask->uxActivations = 0U;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xBasicTaskActivate( xBasicTask *pxBasicTask )
+{
+xBASIC_TASK_LEVEL *pxLevel;
+portBASE_TYPE xReturn, xNotifyLevel = pdFALSE;
+
+	configASSERT( pxBasicTask );
+	pxLevel = ( xBASIC_TASK_LEVEL * ) pxBasicTask->xLevel;
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvActivate( pxBasicTask, &xNotifyLevel );
+	}
+	taskEXIT_CRITICAL();
+
+	if( xReturn == pdPASS )
+	{
+		traceBASIC_TASK_ACTIVATE( pxLevel, pxBasicTask );
+	}
+
+	if( xNotifyLevel != pdFALSE )
+	{
+		( void ) xTaskNotifyGive( pxLevel->xTask );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xBasicTaskActivateFromISR( xBasicTask *pxBasicTask, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xBASIC_TASK_LEVEL *pxLevel;
+portBASE_TYPE xReturn, xNotifyLevel = pdFALSE;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxBasicTask );
+	pxLevel = ( xBASIC_TASK_LEVEL * ) pxBasicTask->xLevel;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xReturn = prvActivate( pxBasicTask, &xNotifyLevel );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		traceBASIC_TASK_ACTIVATE( pxLevel, pxBasicTask );
+	}
+
+	if( xNotifyLevel != pdFALSE )
+	{
+		vTaskNotifyGiveFromISR( pxLevel->xTask, pxHigherPriorityTaskWoken );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxBasicTaskGetPendingActivations( xBasicTask *pxBasicTask )
+{
+	configASSERT( pxBasicTask );
+
+	/* A single read of a base type needs no critical section. */
+	return pxBasicTask->uxActivations;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBasicTaskLevel( void *pvParameters )
+{
+xBASIC_TASK_LEVEL * const pxLevel = ( xBASIC_TASK_LEVEL * ) pvParameters;
+xBasicTask *pxBasicTask;
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxBasicTask = pxLevel->pxHead;
+
+			if( pxBasicTask != NULL )
+			{
+				pxLevel->pxHead = pxBasicTask->pxNextBasicTask;
+				if( pxLevel->pxHead == NULL )
+				{
+					pxLevel->pxTail = NULL;
+				}
+
+				pxBasicTask->pxNextBasicTask = NULL;
+				( pxBasicTask->uxActivations )--;
+				pxLevel->pxRunning = pxBasicTask;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( pxBasicTask != NULL )
+		{
+			traceBASIC_TASK_START( pxLevel, pxBasicTask );
+			pxBasicTask->pxTaskCode( pxBasicTask->pvParameters );
+			traceBASIC_TASK_END( pxLevel, pxBasicTask );
+
+			/* Activations made while the basic task was running put it back
+			on the waiting list, behind those already waiting. */
+			taskENTER_CRITICAL();
+			{
+				pxLevel->pxRunning = NULL;
+
+				if( pxBasicTask->uxActivations != 0U )
+				{
+					prvAddToWaitingList( pxLevel, pxBasicTask );
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			/* A basic task activated after the list was found to be empty
+			leaves the notification pending, so is not missed. */
+			( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvActivate( xBasicTask * const pxBasicTask, portBASE_TYPE * const pxNotifyLevel )
+{
+xBASIC_TASK_LEVEL * const pxLevel = ( xBASIC_TASK_LEVEL * ) pxBasicTask->xLevel;
+portBASE_TYPE xReturn = pdFAIL;
+
+	if( pxBasicTask->uxActivations != basicMAX_ACTIVATIONS )
+	{
+		if( ( pxBasicTask->uxActivations == 0U ) && ( pxLevel->pxRunning != pxBasicTask ) )
+		{
+			/* The level only blocks once its waiting list is empty and it is
+			not running a basic task. */
+			if( ( pxLevel->pxHead == NULL ) && ( pxLevel->pxRunning == NULL ) )
+			{
+				*pxNotifyLevel = pdTRUE;
+			}
+
+			prvAddToWaitingList( pxLevel, pxBasicTask );
+		}
+
+		( pxBasicTask->uxActivations )++;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddToWaitingList( xBASIC_TASK_LEVEL * const pxLevel, xBasicTask * const pxBasicTask )
+{
+	pxBasicTask->pxNextBasicTask = NULL;
+
+	if( pxLevel->pxTail == NULL )
+	{
+		pxLevel->pxHead = pxBasicTask;
+	}
+	else
+	{
+		pxLevel->pxTail->pxNextBasicTask = pxBasicTask;
+	}
+	pxLevel->pxTail = pxBasicTask;
+}
@@ -0,0 +1,400 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "broadcast_channel.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The definition of a broadcast channel.  ulItemsWritten counts the items
+that have ever been written, and is allowed to wrap.  It is also the sequence
+number of the next item to be written, and as the length of the ring is a
+power of two the slot an item occupies is found by masking its sequence
+number.  The members are only accessed from within a critical section (or
+with interrupts masked), including when tasks are added to or removed from the
+event list, so items can be written from interrupts. */
+typedef struct BroadcastChannelDefinition
+{
+	unsigned long ulItemsWritten;			/*< The number of items written, and the sequence number of the next. */
+	unsigned portBASE_TYPE uxMask;			/*< The number of items the ring holds minus one. */
+	unsigned portBASE_TYPE uxItemSize;		/*< The size of each item in bytes. */
+	xList xTasksWaitingToReceive;			/*< List of subscribers waiting for an item.  Stored in priority order. */
+	unsigned char *pucItems;				/*< Points to the storage area, which follows the structure in memory unless the channel was created statically. */
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the structure and storage area were supplied by the application, so must not be freed when the channel is deleted. */
+	#endif
+} xBROADCAST_CHANNEL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy an item into the ring and unblock every waiting subscriber.  Must be
+ * called from a critical section.  Returns pdTRUE if a task with a priority
+ * above the calling task was unblocked.
+ */
+static portBASE_TYPE prvWriteItem( xBROADCAST_CHANNEL * const pxChannel, const void *pvItem );
+
+/*
+ * Called by both xBroadcastChannelCreate() and
+ * xBroadcastChannelCreateStatic() once the memory for the channel has been
+ * obtained.
+ */
+static void prvInitialiseNewChannel( xBROADCAST_CHANNEL * const pxChannel, unsigned char * const pucItems, unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize );
+
+/*
+ * Returns pdTRUE if uxLength is a non-zero power of two.
+ */
+static portBASE_TYPE prvIsValidLength( unsigned portBASE_TYPE uxLength );
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xBroadcastChannelHandle xBroadcastChannelCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize )
+	{
+	xBROADCAST_CHANNEL *pxChannel = NULL;
+
+		configASSERT( prvIsValidLength( uxLength ) );
+		configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0U );
+
+		if( prvIsValidLength( uxLength ) != pdFALSE )
+		{
+			/* Allocate the structure and the storage area in a single
+			block. */
+			pxChannel = ( xBROADCAST_CHANNEL * ) pvPortMalloc( sizeof( xBROADCAST_CHANNEL ) + ( ( size_t ) uxLength * ( size_t ) uxItemSize ) );
+		}
+
+		if( pxChannel != NULL )
+		{
+			prvInitialiseNewChannel( pxChannel, ( ( unsigned char * ) pxChannel ) + sizeof( xBROADCAST_CHANNEL ), uxLength, uxItemSize );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxChannel->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			traceBROADCAST_CHANNEL_CREATE( pxChannel );
+		}
+		else
+		{
+			traceBROADCAST_CHANNEL_CREATE_FAILED();
+		}
+
+		return ( xBroadcastChannelHandle ) pxChannel;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xBroadcastChannelHandle xBroadcastChannelCreateStatic( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucChannelStorageArea, xStaticBroadcastChannel *pxStaticChannel )
+	{
+	xBROADCAST_CHANNEL *pxChannel = NULL;
+
+		configASSERT( prvIsValidLength( uxLength ) );
+		configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pucChannelStorageArea );
+		configASSERT( pxStaticChannel );
+
+		/* The xStaticBroadcastChannel structure must be the same size as the
+		channel structure it is used in place of. */
+		configASSERT( sizeof( xStaticBroadcastChannel ) == sizeof( xBROADCAST_CHANNEL ) );
+
+		if( ( prvIsValidLength( uxLength ) != pdFALSE ) && ( pucChannelStorageArea != NULL ) && ( pxStaticChannel != NULL ) )
+		{
+			pxChannel = ( xBROADCAST_CHANNEL * ) pxStaticChannel;
+			prvInitialiseNewChannel( pxChannel, pucChannelStorageArea, uxLength, uxItemSize );
+
+			/* The memory was supplied by the application so must not be freed
+			if the channel is deleted. */
+			pxChannel->ucStaticallyAllocated = pdTRUE;
+
+			traceBROADCAST_CHANNEL_CREATE( pxChannel );
+		}
+		else
+		{
+			traceBROADCAST_CHANNEL_CREATE_FAILED();
+		}
+
+		return ( xBroadcastChannelHandle ) pxChannel;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vBroadcastChannelDelete( xBroadcastChannelHandle xChannel )
+{
+xBROADCAST_CHANNEL * const pxChannel = ( xBROADCAST_CHANNEL * ) xChannel;
+
+	configASSERT( pxChannel );
+	configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	traceBROADCAST_CHANNEL_DELETE( xChannel );
+
+	/* Memory supplied by the application to xBroadcastChannelCreateStatic()
+	is not freed. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		vPortFree( pxChannel );
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxChannel->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxChannel );
+		}
+	}
+	#else
+	{
+		/* Just to remove compiler warning when configASSERT() is not
+		defined. */
+		( void ) pxChannel;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vBroadcastChannelSubscribe( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber )
+{
+xBROADCAST_CHANNEL * const pxChannel = ( xBROADCAST_CHANNEL * ) xChannel;
+
+	configASSERT( pxChannel );
+	configASSERT( pxSubscriber );
+
+	taskENTER_CRITICAL();
+	{
+		pxSubscriber->ulNextItem = pxChannel->ulItemsWritten;
+	}
+	taskEXIT_CRITICAL();
+
+	pxSubscriber->ulOverruns = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+void vBroadcastChannelSend( xBroadcastChannelHandle xChannel, const void *pvItem )
+{
+xBROADCAST_CHANNEL * const pxChannel = ( xBROADCAST_CHANNEL * ) xChannel;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	taskENTER_CRITICAL();
+	{
+		traceBROADCAST_CHANNEL_SEND( xChannel );
+
+		if( prvWriteItem( pxChannel, pvItem ) != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vBroadcastChannelSendFromISR( xBroadcastChannelHandle xChannel, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xBROADCAST_CHANNEL * const pxChannel = ( xBROADCAST_CHANNEL * ) xChannel;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		traceBROADCAST_CHANNEL_SEND_FROM_ISR( xChannel );
+
+		/* Tasks only access the event list from within a critical section, so
+		it can be accessed here directly.  If the scheduler is suspended the
+		unblocked subscribers are placed in the pending ready list. */
+		if( prvWriteItem( pxChannel, pvItem ) != pdFALSE )
+		{
+			if( pxHigherPriorityTaskWoken != NULL )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xBroadcastChannelReceive( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber, void *pvBuffer, portTickType xTicksToWait )
+{
+xBROADCAST_CHANNEL * const pxChannel = ( xBROADCAST_CHANNEL * ) xChannel;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+unsigned long ulItemsBehind, ulItemsMissed;
+
+	configASSERT( pxChannel );
+	configASSERT( pxSubscriber );
+	configASSERT( pvBuffer );
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency.
+
+	Like the alternative queue API, all the work is done from within a
+	critical section, including placing the calling task in the event list,
+	so items can be written from interrupts. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulItemsBehind = pxChannel->ulItemsWritten - pxSubscriber->ulNextItem;
+
+			if( ulItemsBehind != 0UL )
+			{
+				/* Items the writer has overwritten are skipped, so the
+				subscriber receives the oldest item still in the ring. */
+				ulItemsMissed = 0UL;
+				if( ulItemsBehind > ( ( unsigned long ) pxChannel->uxMask + 1UL ) )
+				{
+					ulItemsMissed = ulItemsBehind - ( ( unsigned long ) pxChannel->uxMask + 1UL );
+					pxSubscriber->ulNextItem += ulItemsMissed;
+					pxSubscriber->ulOverruns += ulItemsMissed;
+				}
+
+				memcpy( pvBuffer, ( const void * ) &( pxChannel->pucItems[ ( ( unsigned portBASE_TYPE ) pxSubscriber->ulNextItem & pxChannel->uxMask ) * pxChannel->uxItemSize ] ), ( size_t ) pxChannel->uxItemSize );
+				( pxSubscriber->ulNextItem )++;
+
+				traceBROADCAST_CHANNEL_RECEIVE( xChannel, ulItemsMissed );
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The subscriber has received every item and no block time is
+				specified, so leave now. */
+				taskEXIT_CRITICAL();
+				traceBROADCAST_CHANNEL_RECEIVE_FAILED( xChannel );
+				return pdFAIL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* No item is available and a block time was specified, so
+				configure the timeout structure. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				taskEXIT_CRITICAL();
+				traceBROADCAST_CHANNEL_RECEIVE_FAILED( xChannel );
+				return pdFAIL;
+			}
+
+			traceBLOCKING_ON_BROADCAST_CHANNEL_RECEIVE( xChannel );
+			vTaskPlaceOnEventList( &( pxChannel->xTasksWaitingToReceive ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvWriteItem( xBROADCAST_CHANNEL * const pxChannel, const void *pvItem )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	memcpy( ( void * ) &( pxChannel->pucItems[ ( ( unsigned portBASE_TYPE ) pxChannel->ulItemsWritten & pxChannel->uxMask ) * pxChannel->uxItemSize ] ), pvItem, ( size_t ) pxChannel->uxItemSize );
+	( pxChannel->ulItemsWritten )++;
+
+	/* Every waiting subscriber has now got an item to receive, so unblock
+	them all. */
+	while( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewChannel( xBROADCAST_CHANNEL * const pxChannel, unsigned char * const pucItems, unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize )
+{
+	pxChannel->ulItemsWritten = 0UL;
+	pxChannel->uxMask = uxLength - ( unsigned portBASE_TYPE ) 1U;
+	pxChannel->uxItemSize = uxItemSize;
+	pxChannel->pucItems = pucItems;
+	vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsValidLength( unsigned portBASE_TYPE uxLength )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( ( uxLength != ( unsigned portBASE_TYPE ) 0U ) && ( ( uxLength & ( uxLength - ( unsigned portBASE_TYPE ) 1U ) ) == ( unsigned portBASE_TYPE ) 0U ) )
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,285 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "cpu_governor.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if configUSE_CPU_CLOCK_SCALING != 1
+	#error configUSE_CPU_CLOCK_SCALING must be set to 1 in FreeRTOSConfig.h to use the CPU governor.
+#endif
+
+#if configGENERATE_RUN_TIME_STATS != 1
+	#error configGENERATE_RUN_TIME_STATS must be set to 1 in FreeRTOSConfig.h to use the CPU governor.
+#endif
+
+#if configUSE_TIMERS != 1
+	#error configUSE_TIMERS must be set to 1 in FreeRTOSConfig.h to use the CPU governor.
+#endif
+
+#if ( configCPU_GOVERNOR_DOWN_THRESHOLD >= configCPU_GOVERNOR_UP_THRESHOLD ) || ( configCPU_GOVERNOR_UP_THRESHOLD > 100 )
+	#error configCPU_GOVERNOR_DOWN_THRESHOLD must be below configCPU_GOVERNOR_UP_THRESHOLD, which must not be above 100.
+#endif
+
+/* The operating points passed to xCpuGovernorStart(), slowest first. */
+static const xCpuOperatingPoint *pxOperatingPoints = NULL;
+static unsigned portBASE_TYPE uxNumberOfOperatingPoints = 0U;
+
+/* The operating point the board is running at, and the slowest one the
+governor may choose. */
+static volatile unsigned portBASE_TYPE uxCurrentOperatingPoint = 0U;
+static volatile unsigned portBASE_TYPE uxMinimumOperatingPoint = 0U;
+
+/* The load measured over the last complete window, in percent. */
+static volatile unsigned portBASE_TYPE uxLastLoad = 0U;
+
+/* The run time counter and the run time of the idle tasks at the start of
+the current window. */
+static portRUN_TIME_COUNTER_TYPE ulWindowStartTime = 0UL;
+static portRUN_TIME_COUNTER_TYPE ulWindowStartIdleTime = 0UL;
+
+/*
+ * The callback of the timer that closes each window.
+ */
+static void prvGovernorCallback( xTimerHandle xTimer );
+
+/*
+ * Start a new window from the current values of the run time counters.
+ */
+static void prvStartWindow( void );
+
+/*
+ * Move the board to operating point uxPoint.  Called from a critical section.
+ */
+static void prvSetOperatingPoint( unsigned portBASE_TYPE uxPoint, unsigned portBASE_TYPE uxLoad );
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xCpuGovernorStart( const xCpuOperatingPoint * const pxPoints, unsigned portBASE_TYPE uxNumberOfPoints, unsigned portBASE_TYPE uxCurrentPoint, portTickType xWindow )
+{
+xTimerHandle xTimer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxPoints );
+	configASSERT( uxNumberOfPoints > 0U );
+	configASSERT( uxCurrentPoint < uxNumberOfPoints );
+	configASSERT( xWindow > ( portTickType ) 0U );
+	configASSERT( pxOperatingPoints == NULL );
+
+	pxOperatingPoints = pxPoints;
+	uxNumberOfOperatingPoints = uxNumberOfPoints;
+	uxCurrentOperatingPoint = uxCurrentPoint;
+	uxMinimumOperatingPoint = 0U;
+
+	xTimer = xTimerCreate( ( const signed char * ) "Gov", xWindow, pdTRUE, NULL, prvGovernorCallback );
+	if( xTimer != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			prvStartWindow();
+		}
+		taskEXIT_CRITICAL();
+
+		xReturn = xTimerStart( xTimer, ( portTickType ) 0U );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vCpuGovernorSetMinimumPoint( unsigned portBASE_TYPE uxPoint )
+{
+	configASSERT( pxOperatingPoints );
+
+	if( uxPoint >= uxNumberOfOperatingPoints )
+	{
+		uxPoint = uxNumberOfOperatingPoints - 1U;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		uxMinimumOperatingPoint = uxPoint;
+
+		/* A driver that asks for a minimum clock needs it now, not at the end
+		of the window. */
+		if( uxCurrentOperatingPoint < uxPoint )
+		{
+			prvSetOperatingPoint( uxPoint, uxLastLoad );
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxCpuGovernorGetPoint( void )
+{
+	return uxCurrentOperatingPoint;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxCpuGovernorGetLoad( void )
+{
+	return uxLastLoad;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartWindow( void )
+{
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		portALT_GET_RUN_TIME_COUNTER_VALUE( ulWindowStartTime );
+	#else
+		ulWindowStartTime = portGET_RUN_TIME_COUNTER_VALUE();
+	#endif
+
+	ulWindowStartIdleTime = ulTaskGetIdleRunTimeCounter();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetOperatingPoint( unsigned portBASE_TYPE uxPoint, unsigned portBASE_TYPE uxLoad )
+{
+unsigned portBASE_TYPE uxOldPoint = uxCurrentOperatingPoint;
+
+	vApplicationSetCpuOperatingPoint( &( pxOperatingPoints[ uxPoint ] ) );
+	portCPU_CLOCK_CHANGED( pxOperatingPoints[ uxPoint ].ulCpuClockHz );
+	uxCurrentOperatingPoint = uxPoint;
+
+	traceCPU_OPERATING_POINT_CHANGE( uxOldPoint, uxPoint, uxLoad );
+
+	/* The run time counter may be clocked from the core clock, so a window
+	must not span a change of operating point. */
+	prvStartWindow();
+
+	( void ) uxOldPoint;
+	( void ) uxLoad;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGovernorCallback( xTimerHandle xTimer )
+{
+portRUN_TIME_COUNTER_TYPE ulTimeNow, ulElapsed, ulBusy;
+unsigned long ulRequiredClockHz;
+unsigned portBASE_TYPE uxLoad, uxPoint;
+
+	( void ) xTimer;
+
+	taskENTER_CRITICAL();
+	{
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+		#else
+			ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		/* Each core runs for the whole window, so the time available is the
+		length of the window on every core. */
+		ulElapsed = ( ulTimeNow - ulWindowStartTime ) * ( portRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+		ulBusy = ulTaskGetIdleRunTimeCounter() - ulWindowStartIdleTime;
+		ulBusy = ( ulBusy < ulElapsed ) ? ( ulElapsed - ulBusy ) : 0UL;
+
+		/* The counter may only have moved a few counts if it is coarse and the
+		window is short.  Such a window is not long enough to judge. */
+		if( ulElapsed >= 100UL )
+		{
+			uxLoad = ( unsigned portBASE_TYPE ) ( ulBusy / ( ulElapsed / 100UL ) );
+			if( uxLoad > 100U )
+			{
+				uxLoad = 100U;
+			}
+			uxLastLoad = uxLoad;
+
+			uxPoint = uxCurrentOperatingPoint;
+			if( uxLoad > configCPU_GOVERNOR_UP_THRESHOLD )
+			{
+				/* Meet a burst at full speed, then step down as the load falls. */
+				uxPoint = uxNumberOfOperatingPoints - 1U;
+			}
+			else if( uxLoad < configCPU_GOVERNOR_DOWN_THRESHOLD )
+			{
+				/* Choose the slowest point at which the same work would have
+				stayed below the up threshold.  The current point always
+				qualifies, so the search never moves faster. */
+				ulRequiredClockHz = ( pxOperatingPoints[ uxPoint ].ulCpuClockHz / configCPU_GOVERNOR_UP_THRESHOLD ) * uxLoad;
+				while( ( uxPoint > 0U ) && ( pxOperatingPoints[ uxPoint - 1U ].ulCpuClockHz >= ulRequiredClockHz ) )
+				{
+					uxPoint--;
+				}
+			}
+
+			if( uxPoint < uxMinimumOperatingPoint )
+			{
+				uxPoint = uxMinimumOperatingPoint;
+			}
+
+			if( uxPoint != uxCurrentOperatingPoint )
+			{
+				prvSetOperatingPoint( uxPoint, uxLoad );
+			}
+			else
+			{
+				prvStartWindow();
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
@@ -66,17 +66,25 @@
 
 /* Lists for ready and blocked co-routines. --------------------*/
 static xList pxReadyCoRoutineLists[ configMAX_CO_ROUTINE_PRIORITIES ];	/*< Prioritised ready co-routines. */
-static xList xDelayedCoRoutineList1;									/*< Delayed co-routines. */
-static xList xDelayedCoRoutineList2;									/*< Delayed co-routines (two lists are used - one for delays that have overflowed the current tick count. */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	/* Only referenced through the pointers below once they are set up by
+	prvInitialiseCoRoutineLists(). */
+	static xList xDelayedCoRoutineList1;									/*< Delayed co-routines. */
+	static xList xDelayedCoRoutineList2;									/*< Delayed co-routines (two lists are used - one for delays that have overflowed the current tick count. */
+#endif
 static xList * pxDelayedCoRoutineList;									/*< Points to the delayed co-routine list currently being used. */
 static xList * pxOverflowDelayedCoRoutineList;							/*< Points to the delayed co-routine list currently being used to hold co-routines that have overflowed the current tick count. */
 static xList xPendingReadyCoRoutineList;											/*< Holds co-routines that have been readied by an external event.  They cannot be added directly to the ready lists as the ready lists cannot be accessed by interrupts. */
 
 /* Other file private variables. --------------------------------*/
 corCRCB * pxCurrentCoRoutine = NULL;
-static unsigned portBASE_TYPE uxTopCoRoutineReadyPriority = 0;
+static unsigned portBASE_TYPE uxTopCoRoutineReadyPriority = 0;	/*< Either the highest ready priority, or a bitmap of ready priorities when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1. */
 static portTickType xCoRoutineTickCount = 0, xLastTickCount = 0, xPassedTicks = 0;
 
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+	static xTaskHandle xCoRoutineHostTask = NULL;	/*< The task running vCoRoutineHost(), notified whenever a co-routine is added to the pending ready list. */
+#endif
+
 /* The initial state of the co-routine when it is created. */
 #define corINITIAL_STATE	( 0 )
 
@@ -87,20 +95,44 @@ static portTickType xCoRoutineTickCount = 0, xLastTickCount = 0, xPassedTicks =
  * This macro accesses the co-routine ready lists and therefore must not be
  * used from within an ISR.
  */
-#define prvAddCoRoutineToReadyQueue( pxCRCB )																		\
-{																													\
-	if( pxCRCB->uxPriority > uxTopCoRoutineReadyPriority )															\
-	{																												\
-		uxTopCoRoutineReadyPriority = pxCRCB->uxPriority;															\
-	}																												\
-	vListInsertEnd( ( xList * ) &( pxReadyCoRoutineLists[ pxCRCB->uxPriority ] ), &( pxCRCB->xGenericListItem ) );	\
-}	
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+	#define prvAddCoRoutineToReadyQueue( pxCRCB )																		\
+	{																													\
+		if( pxCRCB->uxPriority > uxTopCoRoutineReadyPriority )															\
+		{																												\
+			uxTopCoRoutineReadyPriority = pxCRCB->uxPriority;															\
+		}																												\
+		vListInsertEnd( ( xList * ) &( pxReadyCoRoutineLists[ pxCRCB->uxPriority ] ), &( pxCRCB->xGenericListItem ) );	\
+	}
 
-/*
- * Utility to ready all the lists used by the scheduler.  This is called
- * automatically upon the creation of the first co-routine.
- */
-static void prvInitialiseCoRoutineLists( void );
+	/* uxTopCoRoutineReadyPriority is lowered lazily by prvRunNextCoRoutine(). */
+	#define prvResetCoRoutineReadyPriority( uxPriority )
+
+#else
+
+	/* uxTopCoRoutineReadyPriority is a bitmap in which bit n is set while the
+	ready list of priority n is not empty, so the port can find the highest
+	priority ready co-routine in constant time, as it does for tasks. */
+	#define prvAddCoRoutineToReadyQueue( pxCRCB )																		\
+	{																													\
+		portRECORD_READY_PRIORITY( pxCRCB->uxPriority, uxTopCoRoutineReadyPriority );									\
+		vListInsertEnd( ( xList * ) &( pxReadyCoRoutineLists[ pxCRCB->uxPriority ] ), &( pxCRCB->xGenericListItem ) );	\
+	}
+
+	#define prvResetCoRoutineReadyPriority( uxPriority )	portRESET_READY_PRIORITY( ( uxPriority ), uxTopCoRoutineReadyPriority )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	/*
+	 * Utility to ready all the lists used by the scheduler.  This is called
+	 * automatically upon the creation of the first co-routine.
+	 */
+	static void prvInitialiseCoRoutineLists( void );
+
+#endif
 
 /*
  * Co-routines that are readied by an interrupt cannot be placed directly into
@@ -120,63 +152,96 @@ static void prvCheckPendingReadyList( void );
  */
 static void prvCheckDelayedList( void );
 
+/*
+ * Call the highest priority ready co-routine.  Returns pdFALSE, without
+ * calling anything, if no co-routine is ready.
+ */
+static portBASE_TYPE prvRunNextCoRoutine( void );
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	/*
+	 * Called after a co-routine has been added to the pending ready list, to
+	 * make sure the host task runs to move it to a ready list.
+	 */
+	static void prvWakeHostTask( signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+	/*
+	 * The number of ticks until the next delayed co-routine is due to wake, or
+	 * portMAX_DELAY if none are delayed.
+	 */
+	static portTickType prvTicksToNextWake( void );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex )
-{
-signed portBASE_TYPE xReturn;
-corCRCB *pxCoRoutine;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	/* Allocate the memory that will store the co-routine control block. */
-	pxCoRoutine = ( corCRCB * ) pvPortMalloc( sizeof( corCRCB ) );
-	if( pxCoRoutine )
+	signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigned portBASE_TYPE uxPriority, unsigned portBASE_TYPE uxIndex )
 	{
-		/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
-		be created and the co-routine data structures need initialising. */
-		if( pxCurrentCoRoutine == NULL )
-		{
-			pxCurrentCoRoutine = pxCoRoutine;
-			prvInitialiseCoRoutineLists();
-		}
+	signed portBASE_TYPE xReturn;
+	corCRCB *pxCoRoutine;
 
-		/* Check the priority is within limits. */
-		if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
+		/* Allocate the memory that will store the co-routine control block. */
+		pxCoRoutine = ( corCRCB * ) pvPortMalloc( sizeof( corCRCB ) );
+		if( pxCoRoutine )
 		{
-			uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
+			/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
+			be created and the co-routine data structures need initialising. */
+			if( pxCurrentCoRoutine == NULL )
+			{
+				pxCurrentCoRoutine = pxCoRoutine;
+				prvInitialiseCoRoutineLists();
+			}
+
+			/* Check the priority is within limits. */
+			if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
+			{
+				uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
+			}
+
+			/* Fill out the co-routine control block from the function parameters. */
+			pxCoRoutine->uxState = corINITIAL_STATE;
+			pxCoRoutine->uxPriority = uxPriority;
+			pxCoRoutine->uxIndex = uxIndex;
+			pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
+
+			#if ( configUSE_CO_ROUTINE_HOST == 1 )
+			{
+				pxCoRoutine->ucNotified = pdFALSE;
+				pxCoRoutine->ucWaitingNotify = pdFALSE;
+			}
+			#endif
+
+			/* Initialise all the other co-routine control block parameters. */
+			vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
+			vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
+
+			/* Set the co-routine control block as a link back from the xListItem.
+			This is so we can get back to the containing CRCB from a generic item
+			in a list. */
+			listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
+			listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
+
+			/* Event lists are always in priority order. */
+			listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
+
+			/* Now the co-routine has been initialised it can be added to the ready
+			list at the correct priority. */
+			prvAddCoRoutineToReadyQueue( pxCoRoutine );
+
+			xReturn = pdPASS;
+		}
+		else
+		{		
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
 		}
 
-		/* Fill out the co-routine control block from the function parameters. */
-		pxCoRoutine->uxState = corINITIAL_STATE;
-		pxCoRoutine->uxPriority = uxPriority;
-		pxCoRoutine->uxIndex = uxIndex;
-		pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
-
-		/* Initialise all the other co-routine control block parameters. */
-		vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
-		vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
-
-		/* Set the co-routine control block as a link back from the xListItem.
-		This is so we can get back to the containing CRCB from a generic item
-		in a list. */
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
-	
-		/* Event lists are always in priority order. */
-		listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
-		
-		/* Now the co-routine has been initialised it can be added to the ready
-		list at the correct priority. */
-		prvAddCoRoutineToReadyQueue( pxCoRoutine );
-
-		xReturn = pdPASS;
+		return xReturn;	
 	}
-	else
-	{		
-		xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
-	}
-	
-	return xReturn;	
-}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
 void vCoRoutineAddToDelayedList( portTickType xTicksToDelay, xList *pxEventList )
@@ -190,7 +255,10 @@ portTickType xTimeToWake;
 	/* We must remove ourselves from the ready list before adding
 	ourselves to the blocked list as the same list item is used for
 	both lists. */
-	vListRemove( ( xListItem * ) &( pxCurrentCoRoutine->xGenericListItem ) );
+	if( uxListRemove( ( xListItem * ) &( pxCurrentCoRoutine->xGenericListItem ) ) == ( unsigned portBASE_TYPE ) 0 )
+	{
+		prvResetCoRoutineReadyPriority( pxCurrentCoRoutine->uxPriority );
+	}
 
 	/* The list item will be inserted in wake time order. */
 	listSET_LIST_ITEM_VALUE( &( pxCurrentCoRoutine->xGenericListItem ), xTimeToWake );
@@ -230,11 +298,11 @@ static void prvCheckPendingReadyList( void )
 		portDISABLE_INTERRUPTS();
 		{	
 			pxUnblockedCRCB = ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( (&xPendingReadyCoRoutineList) );			
-			vListRemove( &( pxUnblockedCRCB->xEventListItem ) );
+			( void ) uxListRemove( &( pxUnblockedCRCB->xEventListItem ) );
 		}
 		portENABLE_INTERRUPTS();
 
-		vListRemove( &( pxUnblockedCRCB->xGenericListItem ) );
+		( void ) uxListRemove( &( pxUnblockedCRCB->xGenericListItem ) );
 		prvAddCoRoutineToReadyQueue( pxUnblockedCRCB );	
 	}
 }
@@ -280,13 +348,21 @@ corCRCB *pxCRCB;
 				have been moved to the pending ready list and the following
 				line is still valid.  Also the pvContainer parameter will have
 				been set to NULL so the following lines are also valid. */
-				vListRemove( &( pxCRCB->xGenericListItem ) );											
+				( void ) uxListRemove( &( pxCRCB->xGenericListItem ) );											
 
 				/* Is the co-routine waiting on an event also? */												
 				if( pxCRCB->xEventListItem.pvContainer )													
 				{															
-					vListRemove( &( pxCRCB->xEventListItem ) );											
+					( void ) uxListRemove( &( pxCRCB->xEventListItem ) );											
 				}
+
+				#if ( configUSE_CO_ROUTINE_HOST == 1 )
+				{
+					/* A notification sent from now on is held rather than
+					readying the co-routine a second time. */
+					pxCRCB->ucWaitingNotify = pdFALSE;
+				}
+				#endif
 			}
 			portENABLE_INTERRUPTS();
 
@@ -306,46 +382,74 @@ void vCoRoutineSchedule( void )
 	/* See if any delayed co-routines have timed out. */
 	prvCheckDelayedList();
 
-	/* Find the highest priority queue that contains ready co-routines. */
-	while( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxTopCoRoutineReadyPriority ] ) ) )
+	( void ) prvRunNextCoRoutine();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRunNextCoRoutine( void )
+{
+unsigned portBASE_TYPE uxTopPriority;
+
+	#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+	{
+		/* Find the highest priority queue that contains ready co-routines. */
+		while( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxTopCoRoutineReadyPriority ] ) ) )
+		{
+			if( uxTopCoRoutineReadyPriority == 0 )
+			{
+				/* No more co-routines to check. */
+				return pdFALSE;
+			}
+			--uxTopCoRoutineReadyPriority;
+		}
+
+		uxTopPriority = uxTopCoRoutineReadyPriority;
+	}
+	#else
 	{
-		if( uxTopCoRoutineReadyPriority == 0 )
+		if( uxTopCoRoutineReadyPriority == ( unsigned portBASE_TYPE ) 0 )
 		{
-			/* No more co-routines to check. */
-			return;
+			/* No co-routines are ready. */
+			return pdFALSE;
 		}
-		--uxTopCoRoutineReadyPriority;
+
+		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopCoRoutineReadyPriority );
 	}
+	#endif
 
 	/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the co-routines
 	 of the	same priority get an equal share of the processor time. */
-	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentCoRoutine, &( pxReadyCoRoutineLists[ uxTopCoRoutineReadyPriority ] ) );
+	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentCoRoutine, &( pxReadyCoRoutineLists[ uxTopPriority ] ) );
 
 	/* Call the co-routine. */
 	( pxCurrentCoRoutine->pxCoRoutineFunction )( pxCurrentCoRoutine, pxCurrentCoRoutine->uxIndex );
 
-	return;
+	return pdTRUE;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseCoRoutineLists( void )
-{
-unsigned portBASE_TYPE uxPriority;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	for( uxPriority = 0; uxPriority < configMAX_CO_ROUTINE_PRIORITIES; uxPriority++ )
+	static void prvInitialiseCoRoutineLists( void )
 	{
-		vListInitialise( ( xList * ) &( pxReadyCoRoutineLists[ uxPriority ] ) );
-	}
+	unsigned portBASE_TYPE uxPriority;
+
+		for( uxPriority = 0; uxPriority < configMAX_CO_ROUTINE_PRIORITIES; uxPriority++ )
+		{
+			vListInitialise( ( xList * ) &( pxReadyCoRoutineLists[ uxPriority ] ) );
+		}
 
-	vListInitialise( ( xList * ) &xDelayedCoRoutineList1 );
-	vListInitialise( ( xList * ) &xDelayedCoRoutineList2 );
-	vListInitialise( ( xList * ) &xPendingReadyCoRoutineList );
+		vListInitialise( ( xList * ) &xDelayedCoRoutineList1 );
+		vListInitialise( ( xList * ) &xDelayedCoRoutineList2 );
+		vListInitialise( ( xList * ) &xPendingReadyCoRoutineList );
 
-	/* Start with pxDelayedCoRoutineList using list1 and the
-	pxOverflowDelayedCoRoutineList using list2. */
-	pxDelayedCoRoutineList = &xDelayedCoRoutineList1;
-	pxOverflowDelayedCoRoutineList = &xDelayedCoRoutineList2;
-}
+		/* Start with pxDelayedCoRoutineList using list1 and the
+		pxOverflowDelayedCoRoutineList using list2. */
+		pxDelayedCoRoutineList = &xDelayedCoRoutineList1;
+		pxOverflowDelayedCoRoutineList = &xDelayedCoRoutineList2;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xCoRoutineRemoveFromEventList( const xList *pxEventList )
@@ -357,9 +461,18 @@ signed portBASE_TYPE xReturn;
 	event lists and the pending ready list.  This function assumes that a
 	check has already been made to ensure pxEventList is not empty. */
 	pxUnblockedCRCB = ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
-	vListRemove( &( pxUnblockedCRCB->xEventListItem ) );
+	( void ) uxListRemove( &( pxUnblockedCRCB->xEventListItem ) );
 	vListInsertEnd( ( xList * ) &( xPendingReadyCoRoutineList ), &( pxUnblockedCRCB->xEventListItem ) );
 
+	#if ( configUSE_CO_ROUTINE_HOST == 1 )
+	{
+		/* The interrupt co-routine API has no way of returning a task context
+		switch request, so the host task runs when the interrupt is next
+		followed by a context switch, at the latest on the next tick. */
+		prvWakeHostTask( NULL );
+	}
+	#endif
+
 	if( pxUnblockedCRCB->uxPriority >= pxCurrentCoRoutine->uxPriority )
 	{
 		xReturn = pdTRUE;
@@ -371,4 +484,201 @@ signed portBASE_TYPE xReturn;
 
 	return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+
+	signed portBASE_TYPE xCoRoutineRemoveFromQueueEventList( const xList *pxEventList )
+	{
+	corCRCB *pxUnblockedCRCB;
+	signed portBASE_TYPE xReturn = pdFALSE;
+
+		/* Called by the task or interrupt queue API with interrupts masked.
+		The co-routine is readied through the pending ready list, as when it
+		is unblocked from an interrupt. */
+		pxUnblockedCRCB = ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+		( void ) uxListRemove( &( pxUnblockedCRCB->xEventListItem ) );
+		vListInsertEnd( ( xList * ) &( xPendingReadyCoRoutineList ), &( pxUnblockedCRCB->xEventListItem ) );
+
+		#if ( configUSE_CO_ROUTINE_HOST == 1 )
+		{
+			/* The caller can switch to the host task straight away. */
+			prvWakeHostTask( &xReturn );
+		}
+		#endif
+
+		/* Otherwise the co-routines run from the idle task, which is never
+		worth switching to. */
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_CO_ROUTINE_BRIDGE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	void vCoRoutineHost( void *pvParameters )
+	{
+		( void ) pvParameters;
+
+		configASSERT( xCoRoutineHostTask == NULL );
+		xCoRoutineHostTask = xTaskGetCurrentTaskHandle();
+
+		for( ;; )
+		{
+			if( pxCurrentCoRoutine == NULL )
+			{
+				/* No co-routines have been created, so there is nothing to
+				run and nothing can be notified. */
+				( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+				continue;
+			}
+
+			prvCheckPendingReadyList();
+			prvCheckDelayedList();
+
+			if( prvRunNextCoRoutine() == pdFALSE )
+			{
+				/* Every co-routine is blocked.  Anything that readies one
+				first adds it to the pending ready list then notifies this
+				task, so a co-routine readied since the pending ready list was
+				checked leaves a notification that stops this task blocking. */
+				( void ) ulTaskNotifyTake( pdTRUE, prvTicksToNextWake() );
+			}
+		}
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	static portTickType prvTicksToNextWake( void )
+	{
+	portTickType xReturn;
+
+		/* prvCheckDelayedList() has just brought xCoRoutineTickCount up to
+		date, and removed every co-routine that is due. */
+		if( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+		{
+			xReturn = listGET_LIST_ITEM_VALUE( &( ( ( corCRCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedCoRoutineList ) )->xGenericListItem ) ) - xCoRoutineTickCount;
+		}
+		else if( listLIST_IS_EMPTY( pxOverflowDelayedCoRoutineList ) == pdFALSE )
+		{
+			/* Wait until the tick count overflows, when the delayed lists are
+			swapped. */
+			xReturn = ( portTickType ) 0U - xCoRoutineTickCount;
+		}
+		else
+		{
+			xReturn = portMAX_DELAY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	static void prvWakeHostTask( signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		/* Co-routines can be readied before the host task has started. */
+		if( xCoRoutineHostTask != NULL )
+		{
+			vTaskNotifyGiveFromISR( xCoRoutineHostTask, pxHigherPriorityTaskWoken );
+		}
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	signed portBASE_TYPE xCoRoutineNotifyFromISR( xCoRoutineHandle xCoRoutine, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	corCRCB *pxCRCB = ( corCRCB * ) xCoRoutine;
+	signed portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( pxCRCB );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxCRCB->ucNotified = pdTRUE;
+
+			/* ucWaitingNotify is only set while the co-routine is blocked in
+			crWAIT_NOTIFY(), and has neither timed out nor been readied by an
+			earlier notification. */
+			if( pxCRCB->ucWaitingNotify != pdFALSE )
+			{
+				pxCRCB->ucWaitingNotify = pdFALSE;
+				vListInsertEnd( ( xList * ) &( xPendingReadyCoRoutineList ), &( pxCRCB->xEventListItem ) );
+				prvWakeHostTask( pxHigherPriorityTaskWoken );
+				xReturn = pdTRUE;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	signed portBASE_TYPE xCoRoutineNotify( xCoRoutineHandle xCoRoutine )
+	{
+	signed portBASE_TYPE xReturn, xHigherPriorityTaskWoken = pdFALSE;
+
+		xReturn = xCoRoutineNotifyFromISR( xCoRoutine, &xHigherPriorityTaskWoken );
+
+		if( xHigherPriorityTaskWoken != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+
+	signed portBASE_TYPE xCoRoutineWaitNotify( portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xReturn;
+
+		/* Called by the current co-routine, in the host task. */
+		portDISABLE_INTERRUPTS();
+		{
+			pxCurrentCoRoutine->ucWaitingNotify = pdFALSE;
+
+			if( pxCurrentCoRoutine->ucNotified != pdFALSE )
+			{
+				pxCurrentCoRoutine->ucNotified = pdFALSE;
+				xReturn = pdPASS;
+			}
+			else if( xTicksToWait > ( portTickType ) 0 )
+			{
+				/* Block until the notification arrives or the timeout
+				expires, whichever happens first. */
+				pxCurrentCoRoutine->ucWaitingNotify = pdTRUE;
+				vCoRoutineAddToDelayedList( xTicksToWait, NULL );
+				xReturn = errQUEUE_BLOCKED;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		portENABLE_INTERRUPTS();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CO_ROUTINE_HOST */
 
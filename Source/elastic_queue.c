@@ -0,0 +1,587 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "elastic_queue.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The header at the start of each segment.  The items held by the segment
+follow the header. */
+typedef struct ElasticQueueSegment
+{
+	struct ElasticQueueSegment *pxNextSegment;	/*< The segment that holds the items sent after the last item of this segment, or NULL if this is the last segment. */
+} xELASTIC_SEGMENT;
+
+/* The definition of an elastic queue.  While the queue holds items the items
+start at index uxReadIndex of pxFirstSegment and end just before index
+uxWriteIndex of pxLastSegment - uxWriteIndex equals uxItemsPerSegment if the
+last segment is full.  While the queue is empty it holds no segments.  The
+members are only accessed from within a critical section (or with interrupts
+masked), including when tasks are added to or removed from the event lists,
+so items can be sent and received from interrupts. */
+typedef struct ElasticQueueDefinition
+{
+	unsigned portBASE_TYPE uxMessagesWaiting;	/*< The number of items held. */
+	unsigned portBASE_TYPE uxMaxLength;			/*< The number of items the queue can hold. */
+	unsigned portBASE_TYPE uxItemSize;			/*< The size of each item in bytes. */
+	unsigned portBASE_TYPE uxItemsPerSegment;	/*< The number of items that fit in one segment. */
+	unsigned portBASE_TYPE uxSegmentsHeld;		/*< The number of segments in the list. */
+	unsigned portBASE_TYPE uxReadIndex;			/*< The index in pxFirstSegment of the next item to be received. */
+	unsigned portBASE_TYPE uxWriteIndex;		/*< The index in pxLastSegment at which the next item sent is written. */
+	xELASTIC_SEGMENT *pxFirstSegment;			/*< The segment holding the next item to be received, or NULL if the queue is empty. */
+	xELASTIC_SEGMENT *pxLastSegment;			/*< The segment holding the most recently sent item, or NULL if the queue is empty. */
+	xMemoryPoolHandle xSegmentPool;				/*< The pool the segments are taken from. */
+	xList xTasksWaitingToSend;					/*< List of tasks waiting for space.  Stored in priority order. */
+	xList xTasksWaitingToReceive;				/*< List of tasks waiting for an item.  Stored in priority order. */
+} xELASTIC_QUEUE;
+
+/* The tasks that are waiting for a segment to be returned to a pool, from
+any elastic queue.  Segments are only returned when a queue drains, so the
+list is normally empty and shared by every queue and every pool rather than
+adding a list to each. */
+PRIVILEGED_DATA static xList xTasksWaitingForSegment;
+PRIVILEGED_DATA static portBASE_TYPE xSegmentListInitialised = pdFALSE;
+
+/* The address of the item at index uxIndex of pxSegment. */
+#define eqITEM( pxQueue, pxSegment, uxIndex ) ( ( ( unsigned char * ) ( pxSegment ) ) + sizeof( xELASTIC_SEGMENT ) + ( ( size_t ) ( uxIndex ) * ( size_t ) ( pxQueue )->uxItemSize ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy an item to the back of the queue and unblock the highest priority task
+ * waiting to receive.  The queue must not be full, and the last segment must
+ * have space.  Must be called from a critical section.  Returns pdTRUE if a
+ * task with a priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvInsertItem( xELASTIC_QUEUE * const pxQueue, const void *pvItem );
+
+/*
+ * Copy out the item at the front of the queue, returning the first segment
+ * to the pool if it was the last item held by the segment, and unblock the
+ * highest priority task waiting to send.  The queue must not be empty.  Must
+ * be called from a critical section.  Returns pdTRUE if a task with a
+ * priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvRemoveItem( xELASTIC_QUEUE * const pxQueue, void *pvBuffer, portBASE_TYPE xFromISR );
+
+/*
+ * Link a segment taken from the pool onto the end of the queue.  Must be
+ * called from a critical section.
+ */
+static void prvAddSegment( xELASTIC_QUEUE * const pxQueue, void *pvSegment );
+
+/*
+ * Return the first segment of the queue to the pool and unblock every task
+ * waiting for a segment.  Must be called from a critical section.  Returns
+ * pdTRUE if a task with a priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvReleaseFirstSegment( xELASTIC_QUEUE * const pxQueue, portBASE_TYPE xFromISR );
+
+/*-----------------------------------------------------------*/
+
+xElasticQueueHandle xElasticQueueCreate( unsigned portBASE_TYPE uxMaxLength, unsigned portBASE_TYPE uxItemSize, xMemoryPoolHandle xSegmentPool )
+{
+xELASTIC_QUEUE *pxQueue = NULL;
+xMemoryPoolStats xPoolStats;
+unsigned portBASE_TYPE uxItemsPerSegment = ( unsigned portBASE_TYPE ) 0U;
+
+	configASSERT( uxMaxLength > ( unsigned portBASE_TYPE ) 0U );
+	configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0U );
+	configASSERT( xSegmentPool );
+
+	if( ( uxMaxLength > ( unsigned portBASE_TYPE ) 0U ) && ( uxItemSize > ( unsigned portBASE_TYPE ) 0U ) && ( xSegmentPool != NULL ) )
+	{
+		vMemoryPoolGetStats( xSegmentPool, &xPoolStats );
+		if( xPoolStats.xBlockSize > sizeof( xELASTIC_SEGMENT ) )
+		{
+			uxItemsPerSegment = ( unsigned portBASE_TYPE ) ( ( xPoolStats.xBlockSize - sizeof( xELASTIC_SEGMENT ) ) / ( size_t ) uxItemSize );
+		}
+	}
+
+	if( uxItemsPerSegment > ( unsigned portBASE_TYPE ) 0U )
+	{
+		pxQueue = ( xELASTIC_QUEUE * ) pvPortMalloc( sizeof( xELASTIC_QUEUE ) );
+	}
+
+	if( pxQueue != NULL )
+	{
+		pxQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxQueue->uxMaxLength = uxMaxLength;
+		pxQueue->uxItemSize = uxItemSize;
+		pxQueue->uxItemsPerSegment = uxItemsPerSegment;
+		pxQueue->uxSegmentsHeld = ( unsigned portBASE_TYPE ) 0U;
+		pxQueue->uxReadIndex = ( unsigned portBASE_TYPE ) 0U;
+		pxQueue->uxWriteIndex = ( unsigned portBASE_TYPE ) 0U;
+		pxQueue->pxFirstSegment = NULL;
+		pxQueue->pxLastSegment = NULL;
+		pxQueue->xSegmentPool = xSegmentPool;
+		vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+		vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+		taskENTER_CRITICAL();
+		{
+			if( xSegmentListInitialised == pdFALSE )
+			{
+				vListInitialise( &xTasksWaitingForSegment );
+				xSegmentListInitialised = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		traceELASTIC_QUEUE_CREATE( pxQueue );
+	}
+	else
+	{
+		traceELASTIC_QUEUE_CREATE_FAILED();
+	}
+
+	return ( xElasticQueueHandle ) pxQueue;
+}
+/*-----------------------------------------------------------*/
+
+void vElasticQueueDelete( xElasticQueueHandle xQueue )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	traceELASTIC_QUEUE_DELETE( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		while( pxQueue->pxFirstSegment != NULL )
+		{
+			( void ) prvReleaseFirstSegment( pxQueue, pdFALSE );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	vPortFree( pxQueue );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xElasticQueueSend( xElasticQueueHandle xQueue, const void *pvItem, portTickType xTicksToWait )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+xList *pxWaitList;
+void *pvSegment;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency.
+
+	As with the priority queue, all the work is done from within a critical
+	section, including placing the calling task in the event list, so items
+	can be received from interrupts. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting < pxQueue->uxMaxLength )
+			{
+				if( ( pxQueue->pxLastSegment == NULL ) || ( pxQueue->uxWriteIndex == pxQueue->uxItemsPerSegment ) )
+				{
+					pvSegment = pvMemoryPoolAlloc( pxQueue->xSegmentPool );
+					if( pvSegment != NULL )
+					{
+						prvAddSegment( pxQueue, pvSegment );
+					}
+				}
+
+				if( ( pxQueue->pxLastSegment != NULL ) && ( pxQueue->uxWriteIndex < pxQueue->uxItemsPerSegment ) )
+				{
+					traceELASTIC_QUEUE_SEND( xQueue );
+					if( prvInsertItem( pxQueue, pvItem ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+
+				/* There is room in the queue but the pool is empty, so wait
+				for any elastic queue to return a segment. */
+				pxWaitList = &xTasksWaitingForSegment;
+			}
+			else
+			{
+				pxWaitList = &( pxQueue->xTasksWaitingToSend );
+			}
+
+			if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The item cannot be sent and no block time is specified, so
+				leave now. */
+				taskEXIT_CRITICAL();
+				traceELASTIC_QUEUE_SEND_FAILED( xQueue );
+				return errQUEUE_FULL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* A block time was specified, so configure the timeout
+				structure. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				taskEXIT_CRITICAL();
+				traceELASTIC_QUEUE_SEND_FAILED( xQueue );
+				return errQUEUE_FULL;
+			}
+
+			traceBLOCKING_ON_ELASTIC_QUEUE_SEND( xQueue );
+			vTaskPlaceOnEventList( pxWaitList, xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xElasticQueueSendFromISR( xElasticQueueHandle xQueue, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn = errQUEUE_FULL;
+void *pvSegment;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting < pxQueue->uxMaxLength )
+		{
+			if( ( pxQueue->pxLastSegment == NULL ) || ( pxQueue->uxWriteIndex == pxQueue->uxItemsPerSegment ) )
+			{
+				pvSegment = pvMemoryPoolAllocFromISR( pxQueue->xSegmentPool );
+				if( pvSegment != NULL )
+				{
+					prvAddSegment( pxQueue, pvSegment );
+				}
+			}
+
+			if( ( pxQueue->pxLastSegment != NULL ) && ( pxQueue->uxWriteIndex < pxQueue->uxItemsPerSegment ) )
+			{
+				traceELASTIC_QUEUE_SEND_FROM_ISR( xQueue );
+
+				/* Tasks only access the event lists from within a critical
+				section, so they can be accessed here directly.  If the
+				scheduler is suspended the unblocked task is placed in the
+				pending ready list. */
+				if( prvInsertItem( pxQueue, pvItem ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+
+				xReturn = pdPASS;
+			}
+		}
+
+		if( xReturn != pdPASS )
+		{
+			traceELASTIC_QUEUE_SEND_FROM_ISR_FAILED( xQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xElasticQueueReceive( xElasticQueueHandle xQueue, void *pvBuffer, portTickType xTicksToWait )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* As for xElasticQueueSend(). */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+			{
+				traceELASTIC_QUEUE_RECEIVE( xQueue );
+				if( prvRemoveItem( pxQueue, pvBuffer, pdFALSE ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The queue is empty and no block time is specified, so leave
+				now. */
+				taskEXIT_CRITICAL();
+				traceELASTIC_QUEUE_RECEIVE_FAILED( xQueue );
+				return errQUEUE_EMPTY;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* The queue is empty and a block time was specified, so
+				configure the timeout structure. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				taskEXIT_CRITICAL();
+				traceELASTIC_QUEUE_RECEIVE_FAILED( xQueue );
+				return errQUEUE_EMPTY;
+			}
+
+			traceBLOCKING_ON_ELASTIC_QUEUE_RECEIVE( xQueue );
+			vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xElasticQueueReceiveFromISR( xElasticQueueHandle xQueue, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+		{
+			traceELASTIC_QUEUE_RECEIVE_FROM_ISR( xQueue );
+
+			if( prvRemoveItem( pxQueue, pvBuffer, pdTRUE ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceELASTIC_QUEUE_RECEIVE_FROM_ISR_FAILED( xQueue );
+			xReturn = errQUEUE_EMPTY;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxElasticQueueMessagesWaiting( xElasticQueueHandle xQueue )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	return pxQueue->uxMessagesWaiting;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxElasticQueueSegmentsHeld( xElasticQueueHandle xQueue )
+{
+xELASTIC_QUEUE * const pxQueue = ( xELASTIC_QUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	return pxQueue->uxSegmentsHeld;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvInsertItem( xELASTIC_QUEUE * const pxQueue, const void *pvItem )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	memcpy( ( void * ) eqITEM( pxQueue, pxQueue->pxLastSegment, pxQueue->uxWriteIndex ), pvItem, ( size_t ) pxQueue->uxItemSize );
+	( pxQueue->uxWriteIndex )++;
+	( pxQueue->uxMessagesWaiting )++;
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRemoveItem( xELASTIC_QUEUE * const pxQueue, void *pvBuffer, portBASE_TYPE xFromISR )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	memcpy( pvBuffer, ( const void * ) eqITEM( pxQueue, pxQueue->pxFirstSegment, pxQueue->uxReadIndex ), ( size_t ) pxQueue->uxItemSize );
+	( pxQueue->uxReadIndex )++;
+	( pxQueue->uxMessagesWaiting )--;
+
+	/* Give the first segment back once every item it holds has been read.  If
+	that was the last item in the queue the segment is also the last segment,
+	and is given back even though it is not full, so an empty queue holds no
+	storage. */
+	if( ( pxQueue->uxReadIndex == pxQueue->uxItemsPerSegment ) || ( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U ) )
+	{
+		xHigherPriorityTaskWoken = prvReleaseFirstSegment( pxQueue, xFromISR );
+	}
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddSegment( xELASTIC_QUEUE * const pxQueue, void *pvSegment )
+{
+xELASTIC_SEGMENT * const pxSegment = ( xELASTIC_SEGMENT * ) pvSegment;
+
+	pxSegment->pxNextSegment = NULL;
+
+	if( pxQueue->pxLastSegment == NULL )
+	{
+		pxQueue->pxFirstSegment = pxSegment;
+		pxQueue->uxReadIndex = ( unsigned portBASE_TYPE ) 0U;
+	}
+	else
+	{
+		pxQueue->pxLastSegment->pxNextSegment = pxSegment;
+	}
+
+	pxQueue->pxLastSegment = pxSegment;
+	pxQueue->uxWriteIndex = ( unsigned portBASE_TYPE ) 0U;
+	( pxQueue->uxSegmentsHeld )++;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReleaseFirstSegment( xELASTIC_QUEUE * const pxQueue, portBASE_TYPE xFromISR )
+{
+xELASTIC_SEGMENT * const pxSegment = pxQueue->pxFirstSegment;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	pxQueue->pxFirstSegment = pxSegment->pxNextSegment;
+	pxQueue->uxReadIndex = ( unsigned portBASE_TYPE ) 0U;
+	( pxQueue->uxSegmentsHeld )--;
+
+	if( pxQueue->pxFirstSegment == NULL )
+	{
+		pxQueue->pxLastSegment = NULL;
+		pxQueue->uxWriteIndex = ( unsigned portBASE_TYPE ) 0U;
+	}
+
+	if( xFromISR != pdFALSE )
+	{
+		vMemoryPoolFreeFromISR( pxQueue->xSegmentPool, ( void * ) pxSegment );
+	}
+	else
+	{
+		vMemoryPoolFree( pxQueue->xSegmentPool, ( void * ) pxSegment );
+	}
+
+	/* The waiting tasks may be waiting for a different pool, so they are all
+	unblocked to try again rather than just the first. */
+	while( listLIST_IS_EMPTY( &xTasksWaitingForSegment ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &xTasksWaitingForSegment ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
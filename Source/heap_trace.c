@@ -0,0 +1,243 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_trace.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include heap tracing.  This #if is closed at the very bottom of this file.
+If you want to include heap tracing then ensure configUSE_HEAP_TRACE is set to
+1 in FreeRTOSConfig.h. */
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/* The owner entries.  An entry other than entry 0 is free when its xTask
+member is NULL. */
+PRIVILEGED_DATA static xHeapOwnerStats xOwners[ heaptraceMAX_OWNERS ];
+
+PRIVILEGED_DATA static unsigned long ulSizeClassCount[ configHEAP_TRACE_SIZE_CLASSES ];
+PRIVILEGED_DATA static unsigned long ulFailedAllocations = 0UL;
+
+/*
+ * Returns the size class a block of xBlockSize bytes is counted in.
+ */
+static unsigned portBASE_TYPE prvSizeClass( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Marks an owner entry as free so it can be given to another task.
+ */
+static void prvResetOwner( xHeapOwnerStats *pxOwner ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxHeapTraceMalloc( size_t xBlockSize )
+{
+unsigned portBASE_TYPE uxOwner;
+xHeapOwnerStats *pxOwner;
+
+	uxOwner = uxTaskGetHeapOwner();
+	configASSERT( uxOwner < heaptraceMAX_OWNERS );
+	pxOwner = &( xOwners[ uxOwner ] );
+
+	pxOwner->xBytesInUse += xBlockSize;
+	if( pxOwner->xBytesInUse > pxOwner->xPeakBytesInUse )
+	{
+		pxOwner->xPeakBytesInUse = pxOwner->xBytesInUse;
+	}
+	( pxOwner->ulAllocations )++;
+
+	( ulSizeClassCount[ prvSizeClass( xBlockSize ) ] )++;
+
+	return uxOwner;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceMallocFailed( void )
+{
+	ulFailedAllocations++;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceFree( unsigned portBASE_TYPE uxOwner, size_t xBlockSize )
+{
+xHeapOwnerStats *pxOwner;
+
+	configASSERT( uxOwner < heaptraceMAX_OWNERS );
+	pxOwner = &( xOwners[ uxOwner ] );
+
+	configASSERT( pxOwner->xBytesInUse >= xBlockSize );
+	pxOwner->xBytesInUse -= xBlockSize;
+	( pxOwner->ulFrees )++;
+
+	/* The entry of a deleted task is only kept while the task still holds
+	some of the heap.  No block can be tagged with the entry once it is free,
+	so it can then be given to another task. */
+	if( ( pxOwner->xTaskDeleted != pdFALSE ) && ( pxOwner->xBytesInUse == ( size_t ) 0U ) )
+	{
+		prvResetOwner( pxOwner );
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxHeapTraceClaimOwner( xTaskHandle xTask )
+{
+unsigned portBASE_TYPE uxOwner;
+
+	for( uxOwner = ( unsigned portBASE_TYPE ) 1U; uxOwner < heaptraceMAX_OWNERS; uxOwner++ )
+	{
+		if( xOwners[ uxOwner ].xTask == NULL )
+		{
+			xOwners[ uxOwner ].xTask = xTask;
+			return uxOwner;
+		}
+	}
+
+	return heaptraceNO_OWNER;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceReleaseOwner( unsigned portBASE_TYPE uxOwner )
+{
+xHeapOwnerStats *pxOwner;
+
+	configASSERT( ( uxOwner != heaptraceNO_OWNER ) && ( uxOwner < heaptraceMAX_OWNERS ) );
+	pxOwner = &( xOwners[ uxOwner ] );
+
+	vTaskSuspendAll();
+	{
+		if( pxOwner->xBytesInUse == ( size_t ) 0U )
+		{
+			prvResetOwner( pxOwner );
+		}
+		else
+		{
+			pxOwner->xTaskDeleted = pdTRUE;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxHeapTraceGetOwnerStats( xHeapOwnerStats *pxStats, unsigned portBASE_TYPE uxMaxEntries )
+{
+unsigned portBASE_TYPE uxOwner, uxCopied = 0U;
+
+	vTaskSuspendAll();
+	{
+		for( uxOwner = ( unsigned portBASE_TYPE ) 0U; ( uxOwner < heaptraceMAX_OWNERS ) && ( uxCopied < uxMaxEntries ); uxOwner++ )
+		{
+			if( ( uxOwner == heaptraceNO_OWNER ) || ( xOwners[ uxOwner ].xTask != NULL ) )
+			{
+				pxStats[ uxCopied ] = xOwners[ uxOwner ];
+				pxStats[ uxCopied ].uxOwner = uxOwner;
+				uxCopied++;
+			}
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTraceGetStats( xHeapTraceStats *pxStats )
+{
+unsigned portBASE_TYPE uxClass;
+
+	vTaskSuspendAll();
+	{
+		for( uxClass = ( unsigned portBASE_TYPE ) 0U; uxClass < ( unsigned portBASE_TYPE ) configHEAP_TRACE_SIZE_CLASSES; uxClass++ )
+		{
+			pxStats->ulSizeClassCount[ uxClass ] = ulSizeClassCount[ uxClass ];
+		}
+
+		pxStats->ulFailedAllocations = ulFailedAllocations;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvSizeClass( size_t xBlockSize )
+{
+unsigned portBASE_TYPE uxClass = 0U;
+size_t xClassSize = heaptraceSMALLEST_SIZE_CLASS;
+
+	while( ( xBlockSize > xClassSize ) && ( uxClass < ( ( unsigned portBASE_TYPE ) configHEAP_TRACE_SIZE_CLASSES - 1U ) ) )
+	{
+		xClassSize <<= 1;
+		uxClass++;
+	}
+
+	return uxClass;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetOwner( xHeapOwnerStats *pxOwner )
+{
+	pxOwner->xTask = NULL;
+	pxOwner->xBytesInUse = ( size_t ) 0U;
+	pxOwner->xPeakBytesInUse = ( size_t ) 0U;
+	pxOwner->ulAllocations = 0UL;
+	pxOwner->ulFrees = 0UL;
+	pxOwner->xTaskDeleted = pdFALSE;
+}
+
+#endif /* configUSE_HEAP_TRACE */
+
@@ -0,0 +1,424 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "high_res_timer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#ifndef configHIGH_RES_TIMER_CLOCK_HZ
+	#error configHIGH_RES_TIMER_CLOCK_HZ must be defined to the frequency of the high resolution counter to use high resolution timers.
+#endif
+
+#if !defined( portHIGH_RES_TIMER_GET_COUNT ) || !defined( portHIGH_RES_TIMER_SET_COMPARE ) || !defined( portHIGH_RES_TIMER_DISABLE_COMPARE )
+	#error portHIGH_RES_TIMER_GET_COUNT(), portHIGH_RES_TIMER_SET_COMPARE() and portHIGH_RES_TIMER_DISABLE_COMPARE() must be defined to use high resolution timers.  See high_res_timer.h.
+#endif
+
+/* Whether deadline xA is later than deadline xB.  Deadlines are compared
+relative to each other, so the counter wrapping needs no special handling as
+long as they are less than 2^31 counts apart. */
+#define hrtimerIS_AFTER( ulA, ulB )		( ( signed long ) ( ( ulA ) - ( ulB ) ) > 0L )
+
+/* The active timers, in deadline order.  Only accessed from within a
+critical section (or with interrupts masked). */
+PRIVILEGED_DATA static xHighResTimer *pxActiveTimers = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Adds pxTimer to the queue of active timers, after any active timers with
+ * the same deadline, or moves it if it is already active.  Must be called
+ * with the queue protected from concurrent access.
+ */
+static void prvInsertTimer( xHighResTimer * const pxTimer, unsigned long ulDeadline );
+
+/*
+ * Removes pxTimer from the queue of active timers.  Returns pdFAIL if it was
+ * not active.  Must be called with the queue protected from concurrent access.
+ */
+static portBASE_TYPE prvRemoveTimer( xHighResTimer * const pxTimer );
+
+/*
+ * Sets the compare channel for the deadline at the head of the queue, or for
+ * as soon as possible if that deadline has already been reached, or disables
+ * the compare interrupt if no timer is active.  Must be called with the queue
+ * protected from concurrent access.
+ */
+static void prvSetCompare( void );
+
+#if ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	/*
+	 * Calls the callback of a deferred timer, from the timer service task.
+	 */
+	static void prvDeferredCallback( void *pvTimer, unsigned long ulUnused );
+
+#endif
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/*
+	 * The callback of the timer used by vHighResTimerDelayUs().  Wakes the
+	 * delayed task, the handle of which is the timer parameter.
+	 */
+	static void prvDelayExpired( xHighResTimer *pxTimer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vHighResTimerInit( void )
+{
+	portHIGH_RES_TIMER_INIT();
+}
+/*-----------------------------------------------------------*/
+
+void vHighResTimerInitTimer( xHighResTimer *pxTimer, pdHIGH_RES_TIMER_CALLBACK pxCallback, void *pvParameter, portBASE_TYPE xDeferred )
+{
+	configASSERT( pxTimer );
+	configASSERT( pxCallback );
+
+	#if ( configUSE_TIMERS == 0 ) || ( INCLUDE_xTimerPendFunctionCall == 0 )
+	{
+		/* Callbacks can only be deferred using xTimerPendFunctionCallFromISR(). */
+		configASSERT( xDeferred == pdFALSE );
+	}
+	#endif
+
+	pxTimer->pxCallback = pxCallback;
+	pxTimer->pvParameter = pvParameter;
+	pxTimer->xDeferred = xDeferred;
+	pxTimer->ulDeadline = 0UL;
+	pxTimer->pxNext = NULL;
+	pxTimer->xActive = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vHighResTimerStartAt( xHighResTimer *pxTimer, unsigned long ulDeadline )
+{
+	configASSERT( pxTimer );
+
+	taskENTER_CRITICAL();
+	{
+		prvInsertTimer( pxTimer, ulDeadline );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vHighResTimerStartAtFromISR( xHighResTimer *pxTimer, unsigned long ulDeadline )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxTimer );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		prvInsertTimer( pxTimer, ulDeadline );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xHighResTimerStop( xHighResTimer *pxTimer )
+{
+portBASE_TYPE xReturn;
+
+	configASSERT( pxTimer );
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvRemoveTimer( pxTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xHighResTimerStopFromISR( xHighResTimer *pxTimer )
+{
+portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxTimer );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xReturn = prvRemoveTimer( pxTimer );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vHighResTimerBusyWaitUs( unsigned long ulMicroseconds )
+{
+unsigned long ulStart = ulHighResTimerGetCount();
+unsigned long ulCounts = hrtimerUS_TO_COUNTS( ulMicroseconds );
+
+	while( ( unsigned long ) ( ulHighResTimerGetCount() - ulStart ) < ulCounts )
+	{
+		/* Nothing to do but wait. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vHighResTimerDelayUs( unsigned long ulMicroseconds )
+	{
+	xHighResTimer xTimer;
+	unsigned long ulStart = ulHighResTimerGetCount();
+	unsigned long ulCounts = hrtimerUS_TO_COUNTS( ulMicroseconds );
+
+		if( ulMicroseconds > ( unsigned long ) configHIGH_RES_TIMER_SPIN_LIMIT_US )
+		{
+			/* Block until the spin limit before the end of the delay, so the
+			time taken to switch back to this task is hidden in the spin. */
+			vHighResTimerInitTimer( &xTimer, prvDelayExpired, ( void * ) xTaskGetCurrentTaskHandle(), pdFALSE );
+
+			vHighResTimerStartAt( &xTimer, ulStart + ulCounts - hrtimerUS_TO_COUNTS( configHIGH_RES_TIMER_SPIN_LIMIT_US ) );
+
+			/* A notification left over from an earlier delay does not end
+			this one early, as the timer is then still active. */
+			while( xHighResTimerIsActive( &xTimer ) != pdFALSE )
+			{
+				( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			}
+		}
+
+		while( ( unsigned long ) ( ulHighResTimerGetCount() - ulStart ) < ulCounts )
+		{
+			/* Spin for the rest of the delay. */
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvDelayExpired( xHighResTimer *pxTimer, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+		vTaskNotifyGiveFromISR( ( xTaskHandle ) pxTimer->pvParameter, pxHigherPriorityTaskWoken );
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+void vHighResTimerCompareFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xHighResTimer *pxTimer;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+	while( pxActiveTimers != NULL )
+	{
+		pxTimer = pxActiveTimers;
+
+		if( hrtimerIS_AFTER( pxTimer->ulDeadline, ulHighResTimerGetCount() + ( unsigned long ) portHIGH_RES_TIMER_MIN_COMPARE_DELTA ) )
+		{
+			/* Not due yet, and far enough away for the compare channel to
+			catch it. */
+			break;
+		}
+
+		/* The deadline is too close to leave to the compare channel, so
+		wait for it here. */
+		while( hrtimerIS_AFTER( pxTimer->ulDeadline, ulHighResTimerGetCount() ) )
+		{
+			/* Nothing to do but wait. */
+		}
+
+		pxActiveTimers = pxTimer->pxNext;
+		pxTimer->pxNext = NULL;
+		pxTimer->xActive = pdFALSE;
+
+		traceHIGH_RES_TIMER_EXPIRED( pxTimer );
+
+		/* Interrupts are not kept masked while the callback runs.  The
+		callback can start or stop timers, including this one. */
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		{
+			#if ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 )
+				if( pxTimer->xDeferred != pdFALSE )
+				{
+				portBASE_TYPE xResult;
+
+					/* Fails if the timer command queue is full, in which case
+					configTIMER_QUEUE_LENGTH has to be increased. */
+					xResult = xTimerPendFunctionCallFromISR( prvDeferredCallback, ( void * ) pxTimer, 0UL, pxHigherPriorityTaskWoken );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+				else
+			#endif
+			{
+				pxTimer->pxCallback( pxTimer, pxHigherPriorityTaskWoken );
+			}
+		}
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	}
+
+	prvSetCompare();
+
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	static void prvDeferredCallback( void *pvTimer, unsigned long ulUnused )
+	{
+	xHighResTimer * const pxTimer = ( xHighResTimer * ) pvTimer;
+
+		( void ) ulUnused;
+		pxTimer->pxCallback( pxTimer, NULL );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvInsertTimer( xHighResTimer * const pxTimer, unsigned long ulDeadline )
+{
+xHighResTimer **ppxPosition;
+
+	( void ) prvRemoveTimer( pxTimer );
+
+	pxTimer->ulDeadline = ulDeadline;
+
+	/* Find the first timer with a later deadline.  Timers with the same
+	deadline expire in the order they were started. */
+	for( ppxPosition = &pxActiveTimers; *ppxPosition != NULL; ppxPosition = &( ( *ppxPosition )->pxNext ) )
+	{
+		if( hrtimerIS_AFTER( ( *ppxPosition )->ulDeadline, ulDeadline ) )
+		{
+			break;
+		}
+	}
+
+	pxTimer->pxNext = *ppxPosition;
+	*ppxPosition = pxTimer;
+	pxTimer->xActive = pdTRUE;
+
+	traceHIGH_RES_TIMER_START( pxTimer, ulDeadline );
+
+	if( pxActiveTimers == pxTimer )
+	{
+		/* The new timer is the next to expire. */
+		prvSetCompare();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRemoveTimer( xHighResTimer * const pxTimer )
+{
+xHighResTimer **ppxPosition;
+portBASE_TYPE xReturn = pdFAIL;
+
+	if( pxTimer->xActive != pdFALSE )
+	{
+		for( ppxPosition = &pxActiveTimers; *ppxPosition != NULL; ppxPosition = &( ( *ppxPosition )->pxNext ) )
+		{
+			if( *ppxPosition == pxTimer )
+			{
+				*ppxPosition = pxTimer->pxNext;
+				break;
+			}
+		}
+
+		pxTimer->pxNext = NULL;
+		pxTimer->xActive = pdFALSE;
+		xReturn = pdPASS;
+
+		traceHIGH_RES_TIMER_STOP( pxTimer );
+
+		/* The compare channel is left set if the head timer was removed.  The
+		compare interrupt then finds nothing due and sets it again. */
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetCompare( void )
+{
+unsigned long ulEarliest;
+
+	if( pxActiveTimers == NULL )
+	{
+		portHIGH_RES_TIMER_DISABLE_COMPARE();
+	}
+	else
+	{
+		ulEarliest = ulHighResTimerGetCount() + ( unsigned long ) portHIGH_RES_TIMER_MIN_COMPARE_DELTA;
+
+		if( hrtimerIS_AFTER( pxActiveTimers->ulDeadline, ulEarliest ) )
+		{
+			portHIGH_RES_TIMER_SET_COMPARE( pxActiveTimers->ulDeadline );
+		}
+		else
+		{
+			/* Due now or very soon, take the interrupt as soon as possible. */
+			portHIGH_RES_TIMER_SET_COMPARE( ulEarliest );
+		}
+	}
+}
@@ -74,6 +74,11 @@
 conform. */
 typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
+/* Defines the prototype to which functions called when a task that has a
+thread local storage pointer set is deleted must conform.  The parameters are
+the index of the pointer and its value. */
+typedef void (*pdTLS_DELETE_CALLBACK)( portBASE_TYPE, void * );
+
 
 
 
@@ -140,14 +145,124 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define INCLUDE_pcTaskGetTaskName 0
 #endif
 
+#ifndef INCLUDE_xTimerPendFunctionCall
+	#define INCLUDE_xTimerPendFunctionCall 0
+#endif
+
+#ifndef INCLUDE_vTaskSetInitialTickCount
+	#define INCLUDE_vTaskSetInitialTickCount 0
+#endif
+
 #ifndef configUSE_APPLICATION_TASK_TAG
 	#define configUSE_APPLICATION_TASK_TAG 0
 #endif
 
+#ifndef configNUM_THREAD_LOCAL_STORAGE_POINTERS
+	#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
+#endif
+
+#ifndef configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS
+	#define configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS 0
+#endif
+
+#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 ) && ( configNUM_THREAD_LOCAL_STORAGE_POINTERS == 0 )
+	#error configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS can only be set to 1 when configNUM_THREAD_LOCAL_STORAGE_POINTERS is greater than 0.
+#endif
+
 #ifndef INCLUDE_uxTaskGetStackHighWaterMark
 	#define INCLUDE_uxTaskGetStackHighWaterMark 0
 #endif
 
+#ifndef configSTACK_SAMPLE_WORDS
+	#define configSTACK_SAMPLE_WORDS 0
+#endif
+
+#ifndef configUSE_IDLE_WORK
+	#define configUSE_IDLE_WORK 0
+#endif
+
+#ifndef configDEFER_STACK_FILL
+	#define configDEFER_STACK_FILL 0
+#endif
+
+#ifndef configTASK_RECYCLE_CACHE_SIZE
+	#define configTASK_RECYCLE_CACHE_SIZE 0
+#endif
+
+#ifndef configJOB_POOL_PRIORITIES
+	#define configJOB_POOL_PRIORITIES 2
+#endif
+
+#ifndef configHIGH_RES_TIMER_SPIN_LIMIT_US
+	/* vHighResTimerDelayUs() spins for delays up to this long, and for this
+	long at the end of longer delays. */
+	#define configHIGH_RES_TIMER_SPIN_LIMIT_US 20
+#endif
+
+#ifndef portHIGH_RES_TIMER_INIT
+	#define portHIGH_RES_TIMER_INIT()
+#endif
+
+#ifndef portHIGH_RES_TIMER_MIN_COMPARE_DELTA
+	#define portHIGH_RES_TIMER_MIN_COMPARE_DELTA 2
+#endif
+
+#ifndef configCPU_GOVERNOR_UP_THRESHOLD
+	/* The CPU load, in percent, above which the CPU governor moves to the
+	fastest operating point. */
+	#define configCPU_GOVERNOR_UP_THRESHOLD 80
+#endif
+
+#ifndef configCPU_GOVERNOR_DOWN_THRESHOLD
+	/* The CPU load, in percent, below which the CPU governor moves to a
+	slower operating point. */
+	#define configCPU_GOVERNOR_DOWN_THRESHOLD 30
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#ifndef configEDF_PRIORITY
+		#error configEDF_PRIORITY must be defined in FreeRTOSConfig.h to the priority at which tasks are scheduled by deadline when configUSE_EDF_SCHEDULING is 1.
+	#endif
+
+	#if ( INCLUDE_vTaskDelayUntil != 1 )
+		#error INCLUDE_vTaskDelayUntil must be set to 1 when configUSE_EDF_SCHEDULING is 1 as deadlines are set by vTaskDelayUntil().
+	#endif
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+#ifndef configBUDGET_EXHAUSTED_PRIORITY
+	#define configBUDGET_EXHAUSTED_PRIORITY 0
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_MUTEXES != 1 )
+	#error configUSE_TASK_BUDGETS requires configUSE_MUTEXES to be 1 as a task that has used up its budget runs below its base priority.
+#endif
+
+#ifndef configUSE_TIME_TRIGGERED_SCHEDULE
+	#define configUSE_TIME_TRIGGERED_SCHEDULE 0
+#endif
+
+#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+	#if ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		#error configUSE_TIME_TRIGGERED_SCHEDULE requires configUSE_TICKLESS_IDLE and configUSE_DYNAMIC_TICK_RATE to be 0 as the schedule table is stepped on every tick.
+	#endif
+#endif
+
+#ifndef configUSE_PREEMPTION_THRESHOLD
+	#define configUSE_PREEMPTION_THRESHOLD 0
+#endif
+
+#if ( configDEFER_STACK_FILL == 1 ) && ( configSTACK_SAMPLE_WORDS == 0 )
+	#error configDEFER_STACK_FILL requires configSTACK_SAMPLE_WORDS to be greater than 0 as the stacks are filled by the stack sampler in the idle task.
+#endif
+
 #ifndef configUSE_RECURSIVE_MUTEXES
 	#define configUSE_RECURSIVE_MUTEXES 0
 #endif
@@ -172,14 +287,290 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portCRITICAL_NESTING_IN_TCB 0
 #endif
 
+#ifndef portHAS_STACK_GUARD
+	#define portHAS_STACK_GUARD 0
+#endif
+
+#ifndef portSET_STACK_GUARD
+	#define portSET_STACK_GUARD( pxStack )
+#endif
+
 #ifndef configMAX_TASK_NAME_LEN
 	#define configMAX_TASK_NAME_LEN 16
 #endif
 
+/* Setting configUSE_TASK_NAMES to 0 removes the name from the TCB, which can
+be a large part of the RAM used by each task on a small microcontroller.  The
+name passed to xTaskCreate() is then ignored, and every task reports an empty
+name. */
+#ifndef configUSE_TASK_NAMES
+	#define configUSE_TASK_NAMES 1
+#endif
+
 #ifndef configIDLE_SHOULD_YIELD
 	#define configIDLE_SHOULD_YIELD		1
 #endif
 
+#ifndef configDELAYED_TASK_WHEEL_SLOTS
+	/* Set to a power of 2 to hold delayed tasks in a wheel of lists rather
+	than in lists sorted by wake time. */
+	#define configDELAYED_TASK_WHEEL_SLOTS 0
+#endif
+
+#if ( ( configDELAYED_TASK_WHEEL_SLOTS & ( configDELAYED_TASK_WHEEL_SLOTS - 1 ) ) != 0 )
+	#error configDELAYED_TASK_WHEEL_SLOTS must be 0 or a power of 2.
+#endif
+
+#ifndef configUSE_64_BIT_TICKS
+	/* Set to 1 to count ticks in 64 bits inside the kernel.  Wake and expiry
+	times then never wrap, so blocked tasks and active timers are each held in
+	a single sorted list and nothing has to be done when the portTickType tick
+	count overflows.  The API still uses portTickType, which is the low part of
+	the count. */
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
+#if ( configUSE_64_BIT_TICKS == 1 )
+
+	#if ( configDELAYED_TASK_WHEEL_SLOTS != 0 )
+		#error configUSE_64_BIT_TICKS cannot be used with configDELAYED_TASK_WHEEL_SLOTS, the wheel already handles tick count overflows.
+	#endif
+
+	/* The type of the kernel's internal tick count, which is also the type of
+	list item values so times can be sorted without wrapping. */
+	typedef unsigned long long portTickCountType;
+	#define portMAX_TICK_COUNT	( ( portTickCountType ) 0xffffffffffffffffULL )
+
+#else
+
+	typedef portTickType portTickCountType;
+	#define portMAX_TICK_COUNT	portMAX_DELAY
+
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	#if !defined( portRECORD_READY_PRIORITY ) || !defined( portRESET_READY_PRIORITY ) || !defined( portGET_HIGHEST_PRIORITY )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION is set to 1 but the port being used does not provide portRECORD_READY_PRIORITY(), portRESET_READY_PRIORITY() and portGET_HIGHEST_PRIORITY().  Set configUSE_PORT_OPTIMISED_TASK_SELECTION to 0 to use the generic task selection code.
+	#endif
+#endif
+
+/* Items that are not a byte or an aligned word are copied into and out of
+queues with portQUEUE_COPY(), which is memcpy() unless
+configUSE_PORT_OPTIMISED_QUEUE_COPY is 1 and the port provides its own copy.
+The copy is made with interrupts masked, so a port copy is worthwhile where the
+library memcpy() moves a byte at a time. */
+#ifndef configUSE_PORT_OPTIMISED_QUEUE_COPY
+	#define configUSE_PORT_OPTIMISED_QUEUE_COPY 0
+#endif
+
+#if ( configUSE_PORT_OPTIMISED_QUEUE_COPY == 1 )
+	#ifndef portQUEUE_COPY
+		#error configUSE_PORT_OPTIMISED_QUEUE_COPY is set to 1 but the port being used does not provide portQUEUE_COPY().  Set configUSE_PORT_OPTIMISED_QUEUE_COPY to 0 to use memcpy().
+	#endif
+#else
+	#define portQUEUE_COPY( pvDestination, pvSource, xBytes ) memcpy( ( pvDestination ), ( pvSource ), ( size_t ) ( xBytes ) )
+#endif
+
+/* Priority event lists hold the tasks blocked on a queue, semaphore or mutex
+in a FIFO list per priority, so blocking and unblocking take the same time
+however many tasks are waiting.  The priorities that have waiting tasks are
+held in a bitmap when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1, and as the
+highest such priority otherwise - exactly as for the ready lists.  Each queue
+then holds 2 * configMAX_PRIORITIES lists in place of 2, so it is only worth it
+when many tasks wait on the same queue. */
+#ifndef configUSE_PRIORITY_EVENT_LISTS
+	#define configUSE_PRIORITY_EVENT_LISTS 0
+#endif
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 ) && ( configUSE_CO_ROUTINES == 1 )
+	#error configUSE_PRIORITY_EVENT_LISTS can only be set to 1 when configUSE_CO_ROUTINES is 0, as co-routines block on the same queue event lists as tasks.
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+	#define configUSE_QUEUE_SETS 0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 1
+#endif
+
+#ifndef configUSE_CO_ROUTINE_HOST
+	#define configUSE_CO_ROUTINE_HOST 0
+#endif
+
+#if ( configUSE_CO_ROUTINE_HOST == 1 )
+	#if ( configUSE_CO_ROUTINES == 0 ) || ( configUSE_TASK_NOTIFICATIONS == 0 )
+		#error configUSE_CO_ROUTINE_HOST can only be set to 1 when configUSE_CO_ROUTINES and configUSE_TASK_NOTIFICATIONS are also set to 1, as the host task waits for co-routine events on its task notification.
+	#endif
+#endif
+
+#ifndef configUSE_QUEUE_CO_ROUTINE_BRIDGE
+	#define configUSE_QUEUE_CO_ROUTINE_BRIDGE 0
+#endif
+
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 ) && ( configUSE_CO_ROUTINES == 0 )
+	#error configUSE_QUEUE_CO_ROUTINE_BRIDGE can only be set to 1 when configUSE_CO_ROUTINES is also set to 1.
+#endif
+
+#if ( configUSE_CO_ROUTINES == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	#if ( configMAX_CO_ROUTINE_PRIORITIES > 32 )
+		#error configMAX_CO_ROUTINE_PRIORITIES must be less than or equal to 32 when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1, as the ready co-routine priorities are then held in a bitmap.
+	#endif
+#endif
+
+#ifndef configUSE_ZERO_COPY_QUEUES
+	#define configUSE_ZERO_COPY_QUEUES 0
+#endif
+
+#ifndef configUSE_ABSOLUTE_TIMEOUTS
+	#define configUSE_ABSOLUTE_TIMEOUTS 0
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+	#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0 in FreeRTOSConfig.h as then no tasks could be created.
+#endif
+
+#ifndef configUSE_QUEUE_CACHE
+	#define configUSE_QUEUE_CACHE 0
+#endif
+
+#ifndef configQUEUE_CACHE_CLASSES
+	/* Size classes of storage area kept by the queue cache, the smallest
+	holding 16 bytes and each following class twice as many. */
+	#define configQUEUE_CACHE_CLASSES 4
+#endif
+
+#ifndef configQUEUE_CACHE_DEPTH
+	/* Deleted queues kept for reuse in each size class. */
+	#define configQUEUE_CACHE_DEPTH 4
+#endif
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+	#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+		#error configUSE_QUEUE_CACHE can only be set to 1 when configSUPPORT_DYNAMIC_ALLOCATION is also set to 1, as only dynamically allocated queues are cached.
+	#endif
+
+	#if ( configQUEUE_CACHE_CLASSES < 1 ) || ( configQUEUE_CACHE_DEPTH < 1 )
+		#error configQUEUE_CACHE_CLASSES and configQUEUE_CACHE_DEPTH must both be at least 1 when configUSE_QUEUE_CACHE is set to 1.
+	#endif
+#endif
+
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE 0
+#endif
+
+#ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+	#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+#endif
+
+#if configEXPECTED_IDLE_TIME_BEFORE_SLEEP < 2
+	#error configEXPECTED_IDLE_TIME_BEFORE_SLEEP must not be less than 2
+#endif
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+	#ifndef portSUPPRESS_TICKS_AND_SLEEP
+		#error configUSE_TICKLESS_IDLE is not 0 but the port being used does not provide portSUPPRESS_TICKS_AND_SLEEP().  Either set configUSE_TICKLESS_IDLE to 0 or define portSUPPRESS_TICKS_AND_SLEEP() in FreeRTOSConfig.h.
+	#endif
+#endif
+
+#ifndef configUSE_DYNAMIC_TICK_RATE
+	#define configUSE_DYNAMIC_TICK_RATE 0
+#endif
+
+#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+	#ifndef portSET_TICK_INTERRUPT_PERIOD
+		#error configUSE_DYNAMIC_TICK_RATE is 1 but the port being used does not provide portSET_TICK_INTERRUPT_PERIOD().  Either set configUSE_DYNAMIC_TICK_RATE to 0 or use a port that can change the tick interrupt period.
+	#endif
+#endif
+
+#ifndef configUSE_CPU_CLOCK_SCALING
+	#define configUSE_CPU_CLOCK_SCALING 0
+#endif
+
+#if ( configUSE_CPU_CLOCK_SCALING == 1 )
+	#ifndef portCPU_CLOCK_CHANGED
+		#error configUSE_CPU_CLOCK_SCALING is 1 but the port being used does not provide portCPU_CLOCK_CHANGED().  Either set configUSE_CPU_CLOCK_SCALING to 0 or define portCPU_CLOCK_CHANGED() in FreeRTOSConfig.h to correct the tick timer when the core clock changes.
+	#endif
+#endif
+
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES 1
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+	#define configUSE_CORE_AFFINITY 0
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+	#if !defined( portGET_CORE_ID ) || !defined( portYIELD_CORE )
+		#error configNUMBER_OF_CORES is greater than 1 but the port being used does not provide portGET_CORE_ID() and portYIELD_CORE().  Set configNUMBER_OF_CORES to 1 or use a port that supports symmetric multiprocessing.
+	#endif
+
+	#if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+		#error configNUMBER_OF_CORES is greater than 1 but the port being used does not provide the portGET_TASK_LOCK(), portRELEASE_TASK_LOCK(), portGET_ISR_LOCK() and portRELEASE_ISR_LOCK() spinlock macros.
+	#endif
+
+	#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configNUMBER_OF_CORES is greater than 1 as the SMP scheduler uses the generic task selection code.
+	#endif
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+		#error configUSE_TIME_TRIGGERED_SCHEDULE must be 0 when configNUMBER_OF_CORES is greater than 1.
+	#endif
+
+	#if ( configUSE_IDLE_WORK == 1 )
+		#error configUSE_IDLE_WORK must be 0 when configNUMBER_OF_CORES is greater than 1 as the idle work registry relies on one idle task.
+	#endif
+
+	#if ( configUSE_CO_ROUTINES != 0 )
+		#error configUSE_CO_ROUTINES must be 0 when configNUMBER_OF_CORES is greater than 1 as co-routines protect their lists by disabling interrupts on the calling core only.
+	#endif
+
+	#if ( configSTACK_SAMPLE_WORDS > 0 )
+		#error configSTACK_SAMPLE_WORDS must be 0 when configNUMBER_OF_CORES is greater than 1 as the stack sampler relies on one idle task.
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		#error configUSE_EDF_SCHEDULING must be 0 when configNUMBER_OF_CORES is greater than 1 as deadlines are only used by the single core scheduler.
+	#endif
+
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		#error configUSE_TASK_BUDGETS must be 0 when configNUMBER_OF_CORES is greater than 1 as budgets are only charged to the task running on the core that processes the tick.
+	#endif
+
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		#error configUSE_PREEMPTION_THRESHOLD must be 0 when configNUMBER_OF_CORES is greater than 1 as thresholds are only applied by the single core scheduler.
+	#endif
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		#error portCRITICAL_NESTING_IN_TCB must be 0 when configNUMBER_OF_CORES is greater than 1 as the kernel then keeps the critical nesting count of each core itself.
+	#endif
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+	#define configPRE_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+	#define configPOST_SLEEP_PROCESSING( x )
+#endif
+
 #if configMAX_TASK_NAME_LEN < 1
 	#error configMAX_TASK_NAME_LEN must be set to a minimum of 1 in FreeRTOSConfig.h
 #endif
@@ -211,6 +602,32 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 		#error If configUSE_TIMERS is set to 1 then configTIMER_TASK_STACK_DEPTH must also be defined.
 	#endif /* configTIMER_TASK_STACK_DEPTH */
 
+	#ifndef configTIMER_WHEEL_SLOTS
+		/* Set to a power of 2 to hold active timers in a timer wheel rather
+		than in sorted lists. */
+		#define configTIMER_WHEEL_SLOTS 0
+	#endif
+
+	#ifndef configUSE_TIMER_COMMAND_COALESCING
+		/* Set to 1 to record timer commands in the timer they are for, rather
+		than sending a message to the timer service task for each command. */
+		#define configUSE_TIMER_COMMAND_COALESCING 0
+	#endif
+
+	#ifndef configUSE_TIMER_TICK_CALLBACKS
+		/* Set to 1 to allow vTimerRunCallbackInTick() to make the callback of
+		a timer run directly in the tick interrupt. */
+		#define configUSE_TIMER_TICK_CALLBACKS 0
+	#endif
+
+	#if ( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configTIMER_WHEEL_SLOTS must be 0 or a power of 2.
+	#endif
+
+	#if ( configUSE_64_BIT_TICKS == 1 ) && ( configTIMER_WHEEL_SLOTS != 0 )
+		#error configUSE_64_BIT_TICKS cannot be used with configTIMER_WHEEL_SLOTS, the wheel already handles tick count overflows.
+	#endif
+
 #endif /* configUSE_TIMERS */
 
 #ifndef INCLUDE_xTaskGetSchedulerState
@@ -222,8 +639,14 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 #endif
 
 
+/* portHAS_INTERRUPT_MASK_FROM_ISR is 1 if the port really masks interrupts in
+portSET_INTERRUPT_MASK_FROM_ISR(), so code that can be called from both a task
+and an interrupt can protect itself with taskENTER_CRITICAL_FROM_ISR(). */
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
 	#define portSET_INTERRUPT_MASK_FROM_ISR() 0
+	#define portHAS_INTERRUPT_MASK_FROM_ISR 0
+#else
+	#define portHAS_INTERRUPT_MASK_FROM_ISR 1
 #endif
 
 #ifndef portCLEAR_INTERRUPT_MASK_FROM_ISR
@@ -238,11 +661,29 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portSETUP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+#ifndef portIDLE_TASK_HOOK
+	#define portIDLE_TASK_HOOK()
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
 	#define configQUEUE_REGISTRY_SIZE 0U
 #endif
 
-#if ( configQUEUE_REGISTRY_SIZE < 1 )
+#ifndef configUSE_NAME_REGISTRY
+	#define configUSE_NAME_REGISTRY 0
+#endif
+
+#ifndef configNAME_REGISTRY_SIZE
+	#define configNAME_REGISTRY_SIZE 32
+#endif
+
+#if ( configUSE_NAME_REGISTRY == 1 ) && ( ( configNAME_REGISTRY_SIZE < 2 ) || ( ( configNAME_REGISTRY_SIZE & ( configNAME_REGISTRY_SIZE - 1 ) ) != 0 ) )
+	#error configNAME_REGISTRY_SIZE must be a power of 2.
+#endif
+
+/* Queues are added to the name registry through vQueueAddToRegistry(), so
+the function is kept if either registry is used. */
+#if ( configQUEUE_REGISTRY_SIZE < 1 ) && ( configUSE_NAME_REGISTRY == 0 )
 	#define vQueueAddToRegistry( xQueue, pcName )
 	#define vQueueUnregisterQueue( xQueue )
 #endif
@@ -251,6 +692,96 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define portPOINTER_SIZE_TYPE unsigned long
 #endif
 
+#ifndef configUSE_HEAP_TRACE
+	#define configUSE_HEAP_TRACE 0
+#endif
+
+#ifndef configHEAP_TRACE_OWNER_BITS
+	#define configHEAP_TRACE_OWNER_BITS 4
+#endif
+
+#ifndef configHEAP_TRACE_SIZE_CLASSES
+	#define configHEAP_TRACE_SIZE_CLASSES 8
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 ) && ( ( configHEAP_TRACE_OWNER_BITS < 1 ) || ( configHEAP_TRACE_OWNER_BITS > 8 ) )
+	#error configHEAP_TRACE_OWNER_BITS must be between 1 and 8.
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 ) && ( configHEAP_TRACE_SIZE_CLASSES < 1 )
+	#error configHEAP_TRACE_SIZE_CLASSES must be at least 1.
+#endif
+
+#ifndef configUSE_HEAP_TASK_CACHES
+	#define configUSE_HEAP_TASK_CACHES 0
+#endif
+
+#ifndef configHEAP_TASK_CACHE_CLASSES
+	#define configHEAP_TASK_CACHE_CLASSES 4
+#endif
+
+#ifndef configHEAP_TASK_CACHE_DEPTH
+	#define configHEAP_TASK_CACHE_DEPTH 8
+#endif
+
+#if ( configUSE_HEAP_TASK_CACHES == 1 ) && ( ( configHEAP_TASK_CACHE_CLASSES < 1 ) || ( configHEAP_TASK_CACHE_DEPTH < 1 ) )
+	#error configHEAP_TASK_CACHE_CLASSES and configHEAP_TASK_CACHE_DEPTH must be at least 1.
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+	#ifndef configTRACE_RECORDER_BUFFER_LENGTH
+		#define configTRACE_RECORDER_BUFFER_LENGTH 256
+	#endif
+
+	#ifndef configTRACE_RECORDER_NAME_TABLE_LENGTH
+		#define configTRACE_RECORDER_NAME_TABLE_LENGTH 16
+	#endif
+
+	#ifndef configTRACE_RECORDER_INCLUDE_TICKS
+		#define configTRACE_RECORDER_INCLUDE_TICKS 0
+	#endif
+
+	/* The recorder defines the trace macros that have not been defined in
+	FreeRTOSConfig.h, so must be included before the defaults below. */
+	#include "trace_recorder.h"
+
+#endif
+
+#ifndef configUSE_PROFILER
+	#define configUSE_PROFILER 0
+#endif
+
+#if ( configUSE_PROFILER == 1 )
+
+	/* The range of addresses covered by the histogram, normally the code in
+	flash.  Both must be constants. */
+	#if !defined( configPROFILER_LOW_ADDRESS ) || !defined( configPROFILER_HIGH_ADDRESS )
+		#error configPROFILER_LOW_ADDRESS and configPROFILER_HIGH_ADDRESS must be defined in FreeRTOSConfig.h when configUSE_PROFILER is 1.
+	#endif
+
+	#ifndef configPROFILER_BUCKET_SHIFT
+		#define configPROFILER_BUCKET_SHIFT 4
+	#endif
+
+	#ifndef configPROFILER_TASK_TABLE_LENGTH
+		#define configPROFILER_TASK_TABLE_LENGTH 16
+	#endif
+
+	#ifndef configPROFILER_SAMPLE_FROM_TICK
+		#define configPROFILER_SAMPLE_FROM_TICK 1
+	#endif
+
+	/* Included after the trace recorder, which only uses
+	traceTASK_INCREMENT_TICK() when configTRACE_RECORDER_INCLUDE_TICKS is 1. */
+	#include "profiler.h"
+
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 	/* Used to perform any necessary initialisation - for example, open a file
@@ -395,6 +926,14 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_PEEK_FROM_ISR
+	#define traceQUEUE_PEEK_FROM_ISR( pxQueue )
+#endif
+
+#ifndef traceQUEUE_PEEK_FROM_ISR_FAILED
+	#define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
+#endif
+
 #ifndef traceQUEUE_DELETE
 	#define traceQUEUE_DELETE( pxQueue )
 #endif
@@ -415,6 +954,22 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_DELAY_UNTIL()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	#define traceTASK_DEADLINE_MISSED( pxTask )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+	#define traceTASK_BUDGET_EXHAUSTED( pxTask )
+#endif
+
+#ifndef traceTASK_BUDGET_REPLENISHED
+	#define traceTASK_BUDGET_REPLENISHED( pxTask )
+#endif
+
+#ifndef traceTASK_ACTIVATION_OVERRUN
+	#define traceTASK_ACTIVATION_OVERRUN( pxTask )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
@@ -439,6 +994,49 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_INCREMENT_TICK( xTickCount )
 #endif
 
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK()
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+	#define traceTASK_NOTIFY_WAIT()
+#endif
+
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY()
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR()
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
+#endif
+
+#ifndef traceLOW_POWER_IDLE_BEGIN
+	/* Called immediately before entering tickless idle. */
+	#define traceLOW_POWER_IDLE_BEGIN()
+#endif
+
+#ifndef traceLOW_POWER_IDLE_END
+	/* Called when returning to the Idle task after a tickless idle. */
+	#define traceLOW_POWER_IDLE_END()
+#endif
+
+#ifndef traceINCREASE_TICK_COUNT
+	/* Called when the tick count is stepped forward after a tickless idle. */
+	#define traceINCREASE_TICK_COUNT( xTicksToJump )
+#endif
+
 #ifndef traceTIMER_CREATE
 	#define traceTIMER_CREATE( pxNewTimer )
 #endif
@@ -459,6 +1057,432 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef tracePEND_FUNC_CALL
+	#define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, ret )
+#endif
+
+#ifndef tracePEND_FUNC_CALL_FROM_ISR
+	#define tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, ret )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+	#define traceEVENT_GROUP_CREATE( xEventGroup )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE_FAILED
+	#define traceEVENT_GROUP_CREATE_FAILED()
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_END
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS_FROM_ISR
+	#define traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+	#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )
+#endif
+
+#ifndef traceEVENT_GROUP_DELETE
+	#define traceEVENT_GROUP_DELETE( xEventGroup )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED()
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE
+	#define traceMEMORY_POOL_CREATE( xMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+	#define traceMEMORY_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+	#define traceMEMORY_POOL_DELETE( xMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOC
+	#define traceMEMORY_POOL_ALLOC( xMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+	#define traceMEMORY_POOL_FREE( xMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMALLOC
+	/* Called by pvPortMalloc() with the address returned, which is NULL if
+	the allocation failed, and the number of bytes taken from the heap. */
+	#define traceMALLOC( pvAddress, uiSize )
+#endif
+
+#ifndef traceFREE
+	/* Called by vPortFree() with the address of the block being freed and
+	the number of bytes returned to the heap. */
+	#define traceFREE( pvAddress, uiSize )
+#endif
+
+#ifndef traceJOB_POOL_CREATE
+	#define traceJOB_POOL_CREATE( xJobPool )
+#endif
+
+#ifndef traceJOB_POOL_CREATE_FAILED
+	#define traceJOB_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceJOB_POOL_SUBMIT
+	#define traceJOB_POOL_SUBMIT( xJobPool, pxJob )
+#endif
+
+#ifndef traceJOB_POOL_JOB_START
+	#define traceJOB_POOL_JOB_START( xJobPool, pxJob )
+#endif
+
+#ifndef traceJOB_POOL_JOB_END
+	#define traceJOB_POOL_JOB_END( xJobPool, pxJob )
+#endif
+
+#ifndef traceBASIC_TASK_LEVEL_CREATE
+	#define traceBASIC_TASK_LEVEL_CREATE( xLevel )
+#endif
+
+#ifndef traceBASIC_TASK_LEVEL_CREATE_FAILED
+	#define traceBASIC_TASK_LEVEL_CREATE_FAILED()
+#endif
+
+#ifndef traceBASIC_TASK_ACTIVATE
+	#define traceBASIC_TASK_ACTIVATE( xLevel, pxBasicTask )
+#endif
+
+#ifndef traceBASIC_TASK_START
+	#define traceBASIC_TASK_START( xLevel, pxBasicTask )
+#endif
+
+#ifndef traceBASIC_TASK_END
+	#define traceBASIC_TASK_END( xLevel, pxBasicTask )
+#endif
+
+#ifndef traceHIGH_RES_TIMER_START
+	#define traceHIGH_RES_TIMER_START( pxTimer, ulDeadline )
+#endif
+
+#ifndef traceHIGH_RES_TIMER_STOP
+	#define traceHIGH_RES_TIMER_STOP( pxTimer )
+#endif
+
+#ifndef traceHIGH_RES_TIMER_EXPIRED
+	#define traceHIGH_RES_TIMER_EXPIRED( pxTimer )
+#endif
+
+#ifndef traceCPU_OPERATING_POINT_CHANGE
+	#define traceCPU_OPERATING_POINT_CHANGE( uxOldPoint, uxNewPoint, uxLoad )
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_CREATE
+	#define traceREAD_WRITE_LOCK_CREATE( xLock )
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_CREATE_FAILED
+	#define traceREAD_WRITE_LOCK_CREATE_FAILED()
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_DELETE
+	#define traceREAD_WRITE_LOCK_DELETE( xLock )
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_TAKE
+	/* xForWriting is pdTRUE if the lock was taken for writing, or pdFALSE if
+	it was taken for reading.  The same applies to the following macros. */
+	#define traceREAD_WRITE_LOCK_TAKE( xLock, xForWriting )
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_TAKE_FAILED
+	#define traceREAD_WRITE_LOCK_TAKE_FAILED( xLock, xForWriting )
+#endif
+
+#ifndef traceBLOCKING_ON_READ_WRITE_LOCK
+	#define traceBLOCKING_ON_READ_WRITE_LOCK( xLock, xForWriting )
+#endif
+
+#ifndef traceREAD_WRITE_LOCK_GIVE
+	#define traceREAD_WRITE_LOCK_GIVE( xLock, xForWriting )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_CREATE
+	#define traceBROADCAST_CHANNEL_CREATE( xChannel )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_CREATE_FAILED
+	#define traceBROADCAST_CHANNEL_CREATE_FAILED()
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_DELETE
+	#define traceBROADCAST_CHANNEL_DELETE( xChannel )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_SEND
+	#define traceBROADCAST_CHANNEL_SEND( xChannel )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_SEND_FROM_ISR
+	#define traceBROADCAST_CHANNEL_SEND_FROM_ISR( xChannel )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_RECEIVE
+	/* ulOverruns is the number of items the subscriber skipped to reach the
+	item it received. */
+	#define traceBROADCAST_CHANNEL_RECEIVE( xChannel, ulOverruns )
+#endif
+
+#ifndef traceBROADCAST_CHANNEL_RECEIVE_FAILED
+	#define traceBROADCAST_CHANNEL_RECEIVE_FAILED( xChannel )
+#endif
+
+#ifndef traceBLOCKING_ON_BROADCAST_CHANNEL_RECEIVE
+	#define traceBLOCKING_ON_BROADCAST_CHANNEL_RECEIVE( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_CREATE
+	#define traceMESSAGE_CHANNEL_CREATE( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_CREATE_FAILED
+	#define traceMESSAGE_CHANNEL_CREATE_FAILED()
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_DELETE
+	#define traceMESSAGE_CHANNEL_DELETE( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_SEND
+	#define traceMESSAGE_CHANNEL_SEND( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_SEND_FAILED
+	#define traceMESSAGE_CHANNEL_SEND_FAILED( xChannel )
+#endif
+
+#ifndef traceBLOCKING_ON_MESSAGE_CHANNEL_SEND
+	#define traceBLOCKING_ON_MESSAGE_CHANNEL_SEND( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_RECEIVE
+	#define traceMESSAGE_CHANNEL_RECEIVE( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_RECEIVE_FAILED
+	#define traceMESSAGE_CHANNEL_RECEIVE_FAILED( xChannel )
+#endif
+
+#ifndef traceBLOCKING_ON_MESSAGE_CHANNEL_RECEIVE
+	#define traceBLOCKING_ON_MESSAGE_CHANNEL_RECEIVE( xChannel )
+#endif
+
+#ifndef traceMESSAGE_CHANNEL_REPLY
+	#define traceMESSAGE_CHANNEL_REPLY( xMessage )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_CREATE
+	#define tracePRIORITY_QUEUE_CREATE( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_CREATE_FAILED
+	#define tracePRIORITY_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef tracePRIORITY_QUEUE_DELETE
+	#define tracePRIORITY_QUEUE_DELETE( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND
+	#define tracePRIORITY_QUEUE_SEND( xQueue, uxPriority )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FAILED
+	#define tracePRIORITY_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FROM_ISR
+	#define tracePRIORITY_QUEUE_SEND_FROM_ISR( xQueue, uxPriority )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED
+	#define tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE
+	#define tracePRIORITY_QUEUE_RECEIVE( xQueue, uxPriority )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FAILED
+	#define tracePRIORITY_QUEUE_RECEIVE_FAILED( xQueue )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FROM_ISR
+	#define tracePRIORITY_QUEUE_RECEIVE_FROM_ISR( xQueue, uxPriority )
+#endif
+
+#ifndef tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED
+	#define tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_PRIORITY_QUEUE_SEND
+	#define traceBLOCKING_ON_PRIORITY_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE
+	#define traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_CREATE
+	#define traceELASTIC_QUEUE_CREATE( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_CREATE_FAILED
+	#define traceELASTIC_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceELASTIC_QUEUE_DELETE
+	#define traceELASTIC_QUEUE_DELETE( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND
+	#define traceELASTIC_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND_FAILED
+	#define traceELASTIC_QUEUE_SEND_FAILED( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND_FROM_ISR
+	#define traceELASTIC_QUEUE_SEND_FROM_ISR( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND_FROM_ISR_FAILED
+	#define traceELASTIC_QUEUE_SEND_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE
+	#define traceELASTIC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE_FAILED
+	#define traceELASTIC_QUEUE_RECEIVE_FAILED( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE_FROM_ISR
+	#define traceELASTIC_QUEUE_RECEIVE_FROM_ISR( xQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE_FROM_ISR_FAILED
+	#define traceELASTIC_QUEUE_RECEIVE_FROM_ISR_FAILED( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_ELASTIC_QUEUE_SEND
+	#define traceBLOCKING_ON_ELASTIC_QUEUE_SEND( xQueue )
+#endif
+
+#ifndef traceBLOCKING_ON_ELASTIC_QUEUE_RECEIVE
+	#define traceBLOCKING_ON_ELASTIC_QUEUE_RECEIVE( xQueue )
+#endif
+
+#ifndef traceRING_BUFFER_CREATE
+	#define traceRING_BUFFER_CREATE( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_CREATE_FAILED
+	#define traceRING_BUFFER_CREATE_FAILED()
+#endif
+
+#ifndef traceRING_BUFFER_DELETE
+	#define traceRING_BUFFER_DELETE( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_SEND
+	#define traceRING_BUFFER_SEND( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_SEND_FROM_ISR
+	#define traceRING_BUFFER_SEND_FROM_ISR( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_SEND_FAILED
+	#define traceRING_BUFFER_SEND_FAILED( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_RECEIVE
+	#define traceRING_BUFFER_RECEIVE( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_RECEIVE_FROM_ISR
+	#define traceRING_BUFFER_RECEIVE_FROM_ISR( xRingBuffer )
+#endif
+
+#ifndef traceRING_BUFFER_RECEIVE_FAILED
+	#define traceRING_BUFFER_RECEIVE_FAILED( xRingBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_RING_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_RING_BUFFER_RECEIVE( xRingBuffer )
+#endif
+
+#ifndef traceQUEUE_REGISTRY_ADD
+	/* Called when a queue is added to the queue registry.  pcQueueName is the
+	name the queue was registered with. */
+	#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -477,10 +1501,114 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configUSE_64_BIT_RUN_TIME_COUNTER
+	#define configUSE_64_BIT_RUN_TIME_COUNTER 0
+#endif
+
+/* The type used to hold run time counter values, including the time each
+task has accumulated.  With a 32 bit counter the accumulated times overflow
+after about an hour when the counter increments every microsecond.  Setting
+configUSE_64_BIT_RUN_TIME_COUNTER to 1 makes them 64 bits wide, in which case
+portGET_RUN_TIME_COUNTER_VALUE() (or portALT_GET_RUN_TIME_COUNTER_VALUE())
+must also return a 64 bit value that does not wrap - normally a 32 bit timer
+count extended with a count of the timer's overflows.  A port can define
+portRUN_TIME_COUNTER_TYPE itself if its compiler names the 64 bit type
+differently. */
+#ifndef portRUN_TIME_COUNTER_TYPE
+	#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+		#define portRUN_TIME_COUNTER_TYPE unsigned long long
+	#else
+		#define portRUN_TIME_COUNTER_TYPE unsigned long
+	#endif
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
 	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configRECORD_CRITICAL_SECTION_TIME
+	#define configRECORD_CRITICAL_SECTION_TIME 0
+#endif
+
+#if ( ( configRECORD_CRITICAL_SECTION_TIME == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+	#error configRECORD_CRITICAL_SECTION_TIME is set to 1 but configGENERATE_RUN_TIME_STATS is 0.  Critical sections are timed using the run time counter.
+#endif
+
+#ifndef configRECORD_RELEASE_JITTER
+	#define configRECORD_RELEASE_JITTER 0
+#endif
+
+#ifndef configRELEASE_JITTER_BUCKETS
+	#define configRELEASE_JITTER_BUCKETS 16
+#endif
+
+#ifndef configRELEASE_JITTER_RESOLUTION
+	#define configRELEASE_JITTER_RESOLUTION 1
+#endif
+
+#if ( configRECORD_RELEASE_JITTER == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS == 0 ) || ( configUSE_TRACE_FACILITY == 0 ) || ( INCLUDE_vTaskDelayUntil != 1 )
+		#error configRECORD_RELEASE_JITTER requires configGENERATE_RUN_TIME_STATS, configUSE_TRACE_FACILITY and INCLUDE_vTaskDelayUntil to be 1.  Releases by vTaskDelayUntil() are timed using the run time counter and reported by uxTaskGetSystemState().
+	#endif
+
+	#if ( configRELEASE_JITTER_BUCKETS < 2 )
+		#error configRELEASE_JITTER_BUCKETS must be at least 2.
+	#endif
+#endif
+
+#ifndef configRECORD_WAKE_LATENCY
+	#define configRECORD_WAKE_LATENCY 0
+#endif
+
+#ifndef configWAKE_LATENCY_BUCKETS
+	#define configWAKE_LATENCY_BUCKETS 16
+#endif
+
+#ifndef configWAKE_LATENCY_RESOLUTION
+	#define configWAKE_LATENCY_RESOLUTION 1
+#endif
+
+#if ( configRECORD_WAKE_LATENCY == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS == 0 ) || ( configUSE_TRACE_FACILITY == 0 )
+		#error configRECORD_WAKE_LATENCY requires configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY to be 1.  Wake ups are timed using the run time counter and reported by uxTaskGetSystemState().
+	#endif
+
+	#if ( configWAKE_LATENCY_BUCKETS < 2 )
+		#error configWAKE_LATENCY_BUCKETS must be at least 2.
+	#endif
+#endif
+
+#ifndef configRECORD_MUTEX_CONTENTION
+	#define configRECORD_MUTEX_CONTENTION 0
+#endif
+
+#ifndef configMUTEX_CONTENTION_BUCKETS
+	#define configMUTEX_CONTENTION_BUCKETS 16
+#endif
+
+#ifndef configMUTEX_CONTENTION_RESOLUTION
+	#define configMUTEX_CONTENTION_RESOLUTION 1
+#endif
+
+#if ( configRECORD_MUTEX_CONTENTION == 1 )
+	#if ( configGENERATE_RUN_TIME_STATS == 0 ) || ( configUSE_TRACE_FACILITY == 0 ) || ( configUSE_MUTEXES == 0 )
+		#error configRECORD_MUTEX_CONTENTION requires configGENERATE_RUN_TIME_STATS, configUSE_TRACE_FACILITY and configUSE_MUTEXES to be 1.  Mutexes are timed using the run time counter and reported by vQueueGetInfo().
+	#endif
+
+	#if ( configMUTEX_CONTENTION_BUCKETS < 2 )
+		#error configMUTEX_CONTENTION_BUCKETS must be at least 2.
+	#endif
+#endif
+
+/* The CPU load meter accumulates the time the idle task runs as it is
+switched in and out, and keeps averages of the load over 1, 10 and 60
+seconds.  It times the idle task with the run time counter when
+configGENERATE_RUN_TIME_STATS is 1, and with the tick count otherwise - which
+needs no extra timer but only resolves whole ticks. */
+#ifndef configUSE_CPU_LOAD_METER
+	#define configUSE_CPU_LOAD_METER 0
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -490,7 +1618,21 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 #endif
 
 #ifndef portYIELD_WITHIN_API
-	#define portYIELD_WITHIN_API portYIELD
+	#if ( configNUMBER_OF_CORES > 1 )
+		/* A yield requested from within a critical section is held pending
+		until the critical section is exited, as the kernel spinlocks must not
+		be held by a task that is switched out. */
+		#define portYIELD_WITHIN_API vTaskYieldWithinAPI
+	#else
+		#define portYIELD_WITHIN_API portYIELD
+	#endif
+#endif
+
+/* portMEMORY_BARRIER() must prevent the compiler from moving memory accesses
+across it.  It is used where data is shared without a critical section, for
+example by the stream buffer implementation. */
+#ifndef portMEMORY_BARRIER
+	#define portMEMORY_BARRIER()
 #endif
 
 #ifndef pvPortMallocAligned
@@ -501,5 +1643,275 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define vPortFreeAligned( pvBlockToFree ) vPortFree( pvBlockToFree )
 #endif
 
+/* The functions on the paths taken by every context switch, tick and queue
+operation are declared with KERNEL_FAST_FUNCTION.  Defining
+configKERNEL_FAST_CODE_SECTION in FreeRTOSConfig.h to the name of a section -
+for example ".ramfunc" - places them all in that section, so the linker
+script can locate them in RAM or tightly coupled memory that runs without
+flash wait states.  The linker script must also copy the section from flash
+at start up, which with GCC is most easily done by listing it inside the
+.data output section.  The port must provide portPLACE_IN_SECTION(), which
+the GCC, IAR and RVDS Cortex-M ports do.  Where the PendSV handler is written
+in assembly, as in the IAR and RVDS ports, the linker script has to place it
+too. */
+#ifdef configKERNEL_FAST_CODE_SECTION
+	#ifndef portPLACE_IN_SECTION
+		#error configKERNEL_FAST_CODE_SECTION is defined but this port does not provide portPLACE_IN_SECTION().
+	#endif
+
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		#error configKERNEL_FAST_CODE_SECTION cannot be used with the MPU ports, which place the kernel in the privileged_functions section.
+	#endif
+
+	#define KERNEL_FAST_FUNCTION portPLACE_IN_SECTION( configKERNEL_FAST_CODE_SECTION )
+#else
+	#define KERNEL_FAST_FUNCTION
+#endif
+
+/* Setting configTASK_MEMORY_HEAP_REGION to the index of one of the regions
+passed to vPortDefineHeapRegions() reserves that region for the TCBs and
+stacks of tasks created by xTaskCreate() - for example to keep them in the
+core coupled memory of an STM32F4, which is faster than the main SRAM but
+cannot be reached by DMA.  Nothing else is allocated from the region.  This
+requires heap_5.c. */
+#ifndef configTASK_MEMORY_HEAP_REGION
+	#define configTASK_MEMORY_HEAP_REGION ( -1 )
+#endif
+
+/*
+ * The following structures have the same size and alignment as the private
+ * structures used by the kernel for tasks, queues and software timers, but the
+ * members are deliberately given meaningless names as they must not be
+ * accessed by the application.  They allow the application to allocate the
+ * memory for those objects itself, for example as file scope variables, and
+ * pass it to xTaskCreateStatic(), xQueueCreateStatic(), xTimerCreateStatic() or
+ * xStreamBufferCreateStatic().
+ * The kernel asserts that the sizes match when each object is created.  If
+ * the private structures are changed then these must be changed to match.
+ */
+struct xSTATIC_LIST_ITEM
+{
+	portTickCountType xDummy1;
+	void *pvDummy2[ 4 ];
+};
+typedef struct xSTATIC_LIST_ITEM xStaticListItem;
+
+struct xSTATIC_MINI_LIST_ITEM
+{
+	portTickCountType xDummy1;
+	void *pvDummy2[ 2 ];
+};
+typedef struct xSTATIC_MINI_LIST_ITEM xStaticMiniListItem;
+
+typedef struct xSTATIC_LIST
+{
+	unsigned portBASE_TYPE uxDummy1;
+	void *pvDummy2;
+	xStaticMiniListItem xDummy3;
+} xStaticList;
+
+typedef struct xSTATIC_PRIORITY_LIST
+{
+	xStaticList xDummy1[ configMAX_PRIORITIES ];
+	unsigned portBASE_TYPE uxDummy2;
+} xStaticPriorityList;
+
+typedef struct xSTATIC_TCB
+{
+	void *pxDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS xDummy2;
+	#endif
+	xStaticListItem xDummy3[ 2 ];
+	unsigned portBASE_TYPE uxDummy4;
+	void *pxDummy5;
+	#if ( configUSE_TASK_NAMES == 1 )
+		signed char ucDummy6[ configMAX_TASK_NAME_LEN ];
+	#endif
+	#if ( portSTACK_GROWTH > 0 )
+		void *pxDummy7;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		unsigned portBASE_TYPE uxDummy8;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned portBASE_TYPE uxDummy9[ 2 ];
+		unsigned long ulDummy9a;
+		portTickType xDummy9b[ 2 ];
+		unsigned char ucDummy9c;
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxDummy10[ 2 ];
+		void *pvDummy10a;
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		pdTASK_HOOK_CODE pxDummy11;
+	#endif
+	#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+		void *pvDummy11a[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			pdTLS_DELETE_CALLBACK pxDummy11b[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+		#endif
+	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		portRUN_TIME_COUNTER_TYPE ulDummy12;
+	#endif
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		unsigned long ulDummy13;
+		unsigned char ucDummy14;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy15;
+	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		portBASE_TYPE xDummy16;
+		#if ( configUSE_CORE_AFFINITY == 1 )
+			unsigned portBASE_TYPE uxDummy17;
+		#endif
+	#endif
+	#if ( configSTACK_SAMPLE_WORDS > 0 )
+		void *pvDummy18;
+		unsigned short usDummy19;
+	#endif
+	#if ( configDEFER_STACK_FILL == 1 )
+		void *pvDummy20;
+	#endif
+	#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+		unsigned short usDummy21;
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		portTickType xDummy22[ 2 ];
+		unsigned char ucDummy23;
+	#endif
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		void *pvDummy24;
+		portTickType xDummy25[ 4 ];
+	#endif
+	#if ( configRECORD_RELEASE_JITTER == 1 )
+		portRUN_TIME_COUNTER_TYPE ulDummy26[ 3 ];
+		unsigned long ulDummy27[ 2 + configRELEASE_JITTER_BUCKETS ];
+		portTickType xDummy28;
+		unsigned char ucDummy29;
+	#endif
+	#if ( configUSE_HEAP_TRACE == 1 )
+		unsigned char ucDummy30;
+	#endif
+	#if ( configUSE_HEAP_TASK_CACHES == 1 )
+		void *pvDummy31;
+	#endif
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		unsigned portBASE_TYPE uxDummy35;
+		void *pvDummy36;
+	#endif
+	#if ( configRECORD_WAKE_LATENCY == 1 )
+		portRUN_TIME_COUNTER_TYPE ulDummy32[ 3 ];
+		unsigned long ulDummy33[ 1 + configWAKE_LATENCY_BUCKETS ];
+		unsigned char ucDummy34;
+	#endif
+	#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+		unsigned long ulDummy37;
+	#endif
+} xStaticTask;
+
+typedef struct xSTATIC_QUEUE
+{
+	void *pvDummy1[ 4 ];
+	#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+		xStaticPriorityList xDummy2[ 2 ];
+	#else
+		xStaticList xDummy2[ 2 ];
+	#endif
+	unsigned portBASE_TYPE uxDummy3[ 3 ];
+	signed portBASE_TYPE xDummy4[ 2 ];
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned char ucDummy5[ 2 ];
+	#endif
+	#if ( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy6;
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy7;
+	#endif
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		void *pvDummy8[ 2 ];
+	#endif
+	#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		xStaticList xDummy11[ 2 ];
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned long ulDummy9[ 3 ];
+		unsigned portBASE_TYPE uxDummy10;
+	#endif
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		void *pvDummy12;
+		portRUN_TIME_COUNTER_TYPE ulDummy13[ 4 ];
+		unsigned long ulDummy14[ 2 + ( 2 * configMUTEX_CONTENTION_BUCKETS ) ];
+	#endif
+} xStaticQueue;
+
+typedef struct xSTATIC_TIMER
+{
+	void *pvDummy1;
+	xStaticListItem xDummy2;
+	portTickType xDummy3;
+	unsigned portBASE_TYPE uxDummy4;
+	void *pvDummy5;
+	void ( *pvDummy6 )( void * );
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		void *pvDummy8;
+		portTickType xDummy9[ 2 ];
+		portBASE_TYPE xDummy10;
+		unsigned char ucDummy11;
+	#endif
+	#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+		void *pvDummy12;
+		portTickType xDummy13;
+		unsigned char ucDummy14[ 2 ];
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy7;
+	#endif
+} xStaticTimer;
+
+typedef struct xSTATIC_STREAM_BUFFER
+{
+	size_t xDummy1[ 4 ];
+	void *pvDummy2[ 3 ];
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy3;
+	#endif
+} xStaticStreamBuffer;
+
+typedef struct xSTATIC_RING_BUFFER
+{
+	unsigned portBASE_TYPE uxDummy1[ 4 ];
+	void *pvDummy2[ 2 ];
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy3;
+	#endif
+} xStaticRingBuffer;
+
+typedef struct xSTATIC_BROADCAST_CHANNEL
+{
+	unsigned long ulDummy1;
+	unsigned portBASE_TYPE uxDummy2[ 2 ];
+	xStaticList xDummy3;
+	void *pvDummy4;
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy5;
+	#endif
+} xStaticBroadcastChannel;
+
+typedef struct xSTATIC_PRIORITY_QUEUE
+{
+	unsigned long ulDummy1;
+	unsigned portBASE_TYPE uxDummy2[ 3 ];
+	xStaticList xDummy3[ 2 ];
+	void *pvDummy4[ 2 ];
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucDummy5;
+	#endif
+} xStaticPriorityQueue;
+
 #endif /* INC_FREERTOS_H */
 
@@ -66,6 +66,10 @@
  * to which the bytes were set when the task was created have not been
  * overwritten.  Note this second test does not guarantee that an overflowed
  * stack will always be recognised.
+ *
+ * Ports that set portHAS_STACK_GUARD to 1 protect the bottom of the stack of
+ * the running task with an MPU region instead.  The write that overflows the
+ * stack then faults at once, so the second test is not performed.
  */
 
 /*-----------------------------------------------------------*/
@@ -88,6 +92,15 @@
 #endif
 /*-----------------------------------------------------------*/
 
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portHAS_STACK_GUARD == 1 ) )
+
+	/* The port guards the end of the stack with the MPU, there is no need to
+	check the fill bytes on every switch. */
+	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) && ( portSTACK_GROWTH < 0 ) )
 
 	/* Only the current stack state is to be checked. */
@@ -96,7 +109,7 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack <= pxCurrentTCB->pxStack )										\
 		{																								\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, taskGET_TCB_NAME( pxCurrentTCB ) );	\
 		}																								\
 	}
 
@@ -112,14 +125,14 @@
 		/* Is the currently saved stack pointer within the stack limit? */								\
 		if( pxCurrentTCB->pxTopOfStack >= pxCurrentTCB->pxEndOfStack )									\
 		{																								\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );	\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, taskGET_TCB_NAME( pxCurrentTCB ) );	\
 		}																								\
 	}
 
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) && ( portHAS_STACK_GUARD == 0 ) )
 
 	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
 	{																																			\
@@ -133,14 +146,14 @@
 		/* Has the extremity of the task stack ever been written over? */																		\
 		if( memcmp( ( void * ) pxCurrentTCB->pxStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )					\
 		{																																		\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );											\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, taskGET_TCB_NAME( pxCurrentTCB ) );											\
 		}																																		\
 	}
 
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) )
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) && ( portHAS_STACK_GUARD == 0 ) )
 
 	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
 	{																																			\
@@ -157,7 +170,7 @@
 		/* Has the extremity of the task stack ever been written over? */																		\
 		if( memcmp( ( void * ) pcEndOfStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )							\
 		{																																		\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );											\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, taskGET_TCB_NAME( pxCurrentTCB ) );											\
 		}																																		\
 	}
 
@@ -0,0 +1,203 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * An arena is a region of memory from which objects are allocated by simply
+ * advancing a pointer, and which is freed as a whole by resetting the
+ * pointer.  Objects allocated from an arena carry no header and cannot be
+ * freed individually, so an arena suits memory that lives exactly as long as
+ * one unit of work - a request handled by a network server, for example -
+ * where every object allocated while handling the request can be discarded
+ * with one call once the response has been sent.
+ *
+ * The region is supplied by the application, and the small structure used to
+ * manage the arena is placed at its start, so creating an arena never touches
+ * the FreeRTOS heap.  A block taken from a memory pool makes a convenient
+ * region:
+ *
+ *     pvBlock = pvMemoryPoolAlloc( xPool );
+ *     xArena = xArenaCreate( pvBlock, xPoolBlockSize );
+ *     ... pvArenaAlloc( xArena, ... ) while handling the request ...
+ *     vMemoryPoolFree( xPool, pvBlock );
+ *
+ * Arenas are not protected against concurrent access.  An arena must only be
+ * used by one task at a time, and never from an interrupt.  Job pools can
+ * give each of their workers an arena that is reset before every job, see
+ * xJobPoolCreateArenas().
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include arena.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which arenas are referenced.  For example, a call to xArenaCreate()
+ * returns an xArenaHandle variable that can then be used as a parameter to
+ * pvArenaAlloc(), vArenaReset(), etc.
+ */
+typedef void * xArenaHandle;
+
+/**
+ * Used with vArenaGetStats() to obtain the usage of an arena.
+ */
+typedef struct xARENA_STATS
+{
+	size_t xSize;						/*< The number of bytes available for allocation, after the structure used to manage the arena. */
+	size_t xBytesUsed;					/*< The number of bytes allocated since the arena was last reset, including alignment padding. */
+	size_t xMaxBytesUsed;				/*< The highest value xBytesUsed has had since the arena was created - the high water mark of the arena. */
+	unsigned long ulFailedAllocations;	/*< The number of calls to pvArenaAlloc() that returned NULL because the arena was full. */
+} xArenaStats;
+
+/**
+ * arena.h
+ *
+ * <pre>
+ xArenaHandle xArenaCreate( void *pvBuffer, size_t xBufferSizeBytes );
+ </pre>
+ *
+ * Creates an arena in the region of memory pointed to by pvBuffer.  The
+ * structure used to manage the arena is placed at the start of the region and
+ * the rest of the region is available for allocation.
+ *
+ * @param pvBuffer The start of the region.  The region must remain valid for
+ * as long as the arena is in use.  If pvBuffer is not aligned to
+ * portBYTE_ALIGNMENT then the first few bytes of the region are not used.
+ *
+ * @param xBufferSizeBytes The size of the region pointed to by pvBuffer in
+ * bytes.
+ *
+ * @return If NULL is returned then the region is too small to hold the
+ * structure used to manage the arena.  Any other value is the handle of the
+ * created arena, which is also the aligned start of the region.
+ *
+ * \defgroup xArenaCreate xArenaCreate
+ * \ingroup ArenaManagement
+ */
+xArenaHandle xArenaCreate( void *pvBuffer, size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * <pre>
+ void *pvArenaAlloc( xArenaHandle xArena, size_t xWantedSize );
+ </pre>
+ *
+ * Allocates xWantedSize bytes from the arena.  The returned memory is aligned
+ * to portBYTE_ALIGNMENT.  The function takes constant time and never blocks -
+ * if the arena does not have xWantedSize bytes left it returns NULL
+ * immediately.
+ *
+ * @param xArena The handle of the arena from which the memory is allocated.
+ *
+ * @param xWantedSize The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL if the arena is full.
+ * The memory remains valid until the arena is next reset.
+ *
+ * \defgroup pvArenaAlloc pvArenaAlloc
+ * \ingroup ArenaManagement
+ */
+void *pvArenaAlloc( xArenaHandle xArena, size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * <pre>
+ void vArenaReset( xArenaHandle xArena );
+ </pre>
+ *
+ * Frees everything allocated from the arena at once.  The memory returned by
+ * earlier calls to pvArenaAlloc() must not be used after the arena has been
+ * reset.
+ *
+ * @param xArena The handle of the arena being reset.
+ *
+ * \defgroup vArenaReset vArenaReset
+ * \ingroup ArenaManagement
+ */
+void vArenaReset( xArenaHandle xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *
+ * <pre>
+ void vArenaGetStats( xArenaHandle xArena, xArenaStats *pxStats );
+ </pre>
+ *
+ * Obtains the size of the arena, the number of bytes in use, the most bytes
+ * that have ever been in use, and the number of allocations that failed.  The
+ * high water mark can be used to size the arena.
+ *
+ * @param xArena The handle of the arena being queried.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vArenaGetStats vArenaGetStats
+ * \ingroup ArenaManagement
+ */
+void vArenaGetStats( xArenaHandle xArena, xArenaStats *pxStats ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
@@ -0,0 +1,203 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * Atomic operations on unsigned long variables shared between tasks and
+ * interrupts, such as event flags and statistics counters, so they can be
+ * updated without a critical section or suspending the scheduler.  Each
+ * function performs a single read-modify-write that cannot be interrupted part
+ * way through, and can be called from a task or from an interrupt at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * How the operations are made atomic depends on the port:
+ *
+ * + Ports for processors that have load-linked/store-conditional
+ *   instructions - LDREX/STREX on the ARM Cortex-M3 and Cortex-M4F, LL/SC on
+ *   the PIC32 - define portLOAD_EXCLUSIVE() and portSTORE_EXCLUSIVE().  The
+ *   operation is retried if an interrupt or another bus master touched the
+ *   variable between the load and the store, and interrupts are never masked,
+ *   so the operations can also be used from interrupts above
+ *   configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * + On the Cortex-M3 and Cortex-M4F, vAtomicSetBit() and vAtomicClearBit()
+ *   write the bit-band alias of the bit instead when the variable is in a
+ *   bit-band region, which the port reports through portBIT_BAND_ALIAS().  That
+ *   is a single store with no retry.
+ *
+ * + Other ports use a short critical section.  If the port does not provide
+ *   portSET_INTERRUPT_MASK_FROM_ISR() then the operations can only be called
+ *   from tasks - but on such a port interrupts do not nest and are not
+ *   interrupted by a task, so an interrupt can update the variable directly.
+ *
+ * Source/atomic.c must be added to the project.
+ */
+
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include atomic.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * atomic.h
+ *
+ * <pre>
+ portBASE_TYPE xAtomicCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExchange, unsigned long ulComparand );
+ </pre>
+ *
+ * Writes ulExchange to *pulDestination, but only if *pulDestination holds
+ * ulComparand.
+ *
+ * @param pulDestination The variable to update.
+ *
+ * @param ulExchange The value to write.
+ *
+ * @param ulComparand The value the variable must hold for it to be updated.
+ *
+ * @return pdTRUE if the variable held ulComparand and was updated, otherwise
+ * pdFALSE.
+ *
+ * \defgroup xAtomicCompareAndSwap xAtomicCompareAndSwap
+ * \ingroup Atomics
+ */
+portBASE_TYPE xAtomicCompareAndSwap( volatile unsigned long *pulDestination, unsigned long ulExchange, unsigned long ulComparand ) PRIVILEGED_FUNCTION;
+
+/**
+ * atomic.h
+ *
+ * <pre>
+ unsigned long ulAtomicAdd( volatile unsigned long *pulDestination, unsigned long ulValue );
+ unsigned long ulAtomicSubtract( volatile unsigned long *pulDestination, unsigned long ulValue );
+ unsigned long ulAtomicIncrement( volatile unsigned long *pulDestination );
+ unsigned long ulAtomicDecrement( volatile unsigned long *pulDestination );
+ </pre>
+ *
+ * Adds ulValue to, or subtracts ulValue from, *pulDestination.  The result
+ * wraps.  ulAtomicIncrement() and ulAtomicDecrement() add and subtract one.
+ *
+ * @param pulDestination The variable to update.
+ *
+ * @param ulValue The amount to add or subtract.
+ *
+ * @return The value the variable held before it was updated.
+ *
+ * \defgroup ulAtomicAdd ulAtomicAdd
+ * \ingroup Atomics
+ */
+unsigned long ulAtomicAdd( volatile unsigned long *pulDestination, unsigned long ulValue ) PRIVILEGED_FUNCTION;
+#define ulAtomicSubtract( pulDestination, ulValue ) ulAtomicAdd( ( pulDestination ), 0UL - ( unsigned long ) ( ulValue ) )
+#define ulAtomicIncrement( pulDestination ) ulAtomicAdd( ( pulDestination ), 1UL )
+#define ulAtomicDecrement( pulDestination ) ulAtomicAdd( ( pulDestination ), 0UL - 1UL )
+
+/**
+ * atomic.h
+ *
+ * <pre>
+ unsigned long ulAtomicSetBits( volatile unsigned long *pulDestination, unsigned long ulBits );
+ unsigned long ulAtomicClearBits( volatile unsigned long *pulDestination, unsigned long ulBits );
+ portBASE_TYPE xAtomicTestBits( volatile unsigned long *pulDestination, unsigned long ulBits );
+ </pre>
+ *
+ * ulAtomicSetBits() sets, and ulAtomicClearBits() clears, the bits of
+ * *pulDestination that are set in ulBits, leaving the other bits unchanged.
+ * xAtomicTestBits() only reads the variable, so is a macro.
+ *
+ * @param pulDestination The variable to update or test.
+ *
+ * @param ulBits The bits to set, clear or test.
+ *
+ * @return ulAtomicSetBits() and ulAtomicClearBits() return the value the
+ * variable held before it was updated, so the caller can tell whether it was
+ * the one that changed a bit.  xAtomicTestBits() returns pdTRUE if any of the
+ * bits are set.
+ *
+ * \defgroup ulAtomicSetBits ulAtomicSetBits
+ * \ingroup Atomics
+ */
+unsigned long ulAtomicSetBits( volatile unsigned long *pulDestination, unsigned long ulBits ) PRIVILEGED_FUNCTION;
+unsigned long ulAtomicClearBits( volatile unsigned long *pulDestination, unsigned long ulBits ) PRIVILEGED_FUNCTION;
+#define xAtomicTestBits( pulDestination, ulBits ) ( ( ( *( pulDestination ) & ( ulBits ) ) != 0UL ) ? pdTRUE : pdFALSE )
+
+/**
+ * atomic.h
+ *
+ * <pre>
+ void vAtomicSetBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit );
+ void vAtomicClearBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit );
+ </pre>
+ *
+ * Set or clear a single bit of *pulDestination, using the bit-band alias of
+ * the bit where the port supports it, otherwise ulAtomicSetBits() or
+ * ulAtomicClearBits().
+ *
+ * @param pulDestination The variable to update.
+ *
+ * @param uxBit The number of the bit, 0 to 31.
+ *
+ * \defgroup vAtomicSetBit vAtomicSetBit
+ * \ingroup Atomics
+ */
+void vAtomicSetBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit ) PRIVILEGED_FUNCTION;
+void vAtomicClearBit( volatile unsigned long *pulDestination, unsigned portBASE_TYPE uxBit ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATOMIC_H */
+
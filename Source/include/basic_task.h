@@ -0,0 +1,241 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Basic tasks are run-to-completion tasks that share a stack.  Each
+ * activation of a basic task calls its function from the start, and the
+ * function must return before the next basic task of the same level can run.
+ * A basic task must therefore never block - it can use the API functions
+ * that do not block, and those that block with a block time of zero.
+ *
+ * Basic tasks are grouped into levels.  A level is a single task, created by
+ * xBasicTaskLevelCreate() with one stack and one priority, that runs the
+ * basic tasks assigned to it one after another, so the stack is only ever in
+ * use by one of them at a time.  The stack has to be as large as the largest
+ * stack needed by any one of the basic tasks, rather than the sum of them.  A
+ * basic task of a higher priority level preempts a basic task of a lower
+ * priority level in the same way a task does, but basic tasks of the same
+ * level never preempt each other, and are run in the order they were
+ * activated.  Normally one level is created for each priority at which basic
+ * tasks are needed.
+ *
+ * A basic task is held in an xBasicTask structure supplied by the application
+ * and initialised with vBasicTaskInit(), so a basic task takes no memory other
+ * than the structure.  Basic tasks are a middle ground between tasks, each of
+ * which has its own stack and can block, and co-routines, which share a stack
+ * and can block but only using the co-routine API, and at a few points within
+ * the co-routine function.
+ */
+
+#ifndef BASIC_TASK_H
+#define BASIC_TASK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include basic_task.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which basic task levels are referenced.  For example, a call to
+ * xBasicTaskLevelCreate() returns an xBasicTaskLevelHandle variable that can
+ * then be used as a parameter to vBasicTaskInit().
+ */
+typedef void * xBasicTaskLevelHandle;
+
+/**
+ * The function run by each activation of a basic task.
+ */
+typedef void ( *pdBASIC_TASK_CODE )( void *pvParameters );
+
+/**
+ * A basic task.  The members are set by vBasicTaskInit() and used by the
+ * level, and must not be accessed by the application.
+ */
+typedef struct xBASIC_TASK
+{
+	pdBASIC_TASK_CODE pxTaskCode;							/*< The function run for each activation. */
+	void *pvParameters;										/*< Passed to pxTaskCode. */
+	struct xBASIC_TASK *pxNextBasicTask;					/*< The next basic task waiting to run at the same level. */
+	xBasicTaskLevelHandle xLevel;							/*< The level that runs the basic task. */
+	volatile unsigned portBASE_TYPE uxActivations;			/*< The number of activations that have not yet started. */
+} xBasicTask;
+
+/**
+ * basic_task.h
+ *
+ * <pre>
+ xBasicTaskLevelHandle xBasicTaskLevelCreate( const signed char * const pcName, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority );
+ </pre>
+ *
+ * Creates a level - the task that runs the basic tasks assigned to it.  The
+ * task blocks while none of its basic tasks are activated.  A level cannot be
+ * deleted once it has been created.
+ *
+ * @param pcName The name given to the task of the level.
+ *
+ * @param usStackDepth The depth of the shared stack, in words, as for
+ * xTaskCreate().  This has to allow for the deepest stack used by any one of
+ * the basic tasks assigned to the level.
+ *
+ * @param uxPriority The priority at which the basic tasks assigned to the
+ * level run.
+ *
+ * @return The handle of the level, or NULL if the level could not be created
+ * because there was insufficient heap memory.
+ *
+ * \defgroup xBasicTaskLevelCreate xBasicTaskLevelCreate
+ * \ingroup BasicTasks
+ */
+xBasicTaskLevelHandle xBasicTaskLevelCreate( const signed char * const pcName, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * basic_task.h
+ *
+ * <pre>
+ void vBasicTaskInit( xBasicTask *pxBasicTask, xBasicTaskLevelHandle xLevel, pdBASIC_TASK_CODE pxTaskCode, void *pvParameters );
+ </pre>
+ *
+ * Initialises a basic task and assigns it to a level.  The basic task does
+ * not run until it is activated.  The structure must remain valid for as
+ * long as the basic task can be activated, so is normally a file scope or
+ * static variable, and must not be initialised again while an activation
+ * is pending or running.
+ *
+ * @param pxBasicTask The structure that holds the basic task.
+ *
+ * @param xLevel The level that runs the basic task.
+ *
+ * @param pxTaskCode The function run for each activation.  The function must
+ * return, and must not block.
+ *
+ * @param pvParameters Passed to pxTaskCode each time it is called.
+ *
+ * \defgroup vBasicTaskInit vBasicTaskInit
+ * \ingroup BasicTasks
+ */
+void vBasicTaskInit( xBasicTask *pxBasicTask, xBasicTaskLevelHandle xLevel, pdBASIC_TASK_CODE pxTaskCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * basic_task.h
+ *
+ * <pre>
+ portBASE_TYPE xBasicTaskActivate( xBasicTask *pxBasicTask );
+ </pre>
+ *
+ * Activates a basic task, so its function is called once more by its level.
+ * Activations are counted, so a basic task that is activated again before an
+ * earlier activation has started, or while it is running, runs once for each
+ * activation.  Each time the basic task returns with activations still
+ * pending it goes behind the other basic tasks already waiting at its level,
+ * so one basic task that is activated repeatedly does not hold up the others.
+ *
+ * The basic task is run straight away if its level has a higher priority than
+ * the calling task.
+ *
+ * @param pxBasicTask The basic task to activate.
+ *
+ * @return pdPASS if the activation was recorded, or pdFAIL if the count of
+ * pending activations is already at its maximum value.
+ *
+ * \defgroup xBasicTaskActivate xBasicTaskActivate
+ * \ingroup BasicTasks
+ */
+portBASE_TYPE xBasicTaskActivate( xBasicTask *pxBasicTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * basic_task.h
+ *
+ * <pre>
+ portBASE_TYPE xBasicTaskActivateFromISR( xBasicTask *pxBasicTask, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xBasicTaskActivate() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the activation unblocked
+ * a level with a priority above that of the interrupted task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup xBasicTaskActivateFromISR xBasicTaskActivateFromISR
+ * \ingroup BasicTasks
+ */
+portBASE_TYPE xBasicTaskActivateFromISR( xBasicTask *pxBasicTask, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * basic_task.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxBasicTaskGetPendingActivations( xBasicTask *pxBasicTask );
+ </pre>
+ *
+ * @param pxBasicTask The basic task being queried.
+ *
+ * @return The number of activations of the basic task that have not yet
+ * started.  An activation that is running is not included.
+ *
+ * \defgroup uxBasicTaskGetPendingActivations uxBasicTaskGetPendingActivations
+ * \ingroup BasicTasks
+ */
+unsigned portBASE_TYPE uxBasicTaskGetPendingActivations( xBasicTask *pxBasicTask ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASIC_TASK_H */
@@ -0,0 +1,280 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A broadcast channel delivers every item written to it to every subscriber.
+ * The writer copies each item into the channel once, into a ring of the most
+ * recent items, and each subscriber reads from the ring at its own pace
+ * through a cursor of its own.  Writing an item unblocks every subscriber
+ * that is waiting for one, in a single pass.
+ *
+ * The writer never blocks.  When the ring is full the oldest item is
+ * overwritten, so a subscriber that falls more than the length of the ring
+ * behind skips the items it has missed, and the number it skipped is added
+ * to its overrun count.  Any number of tasks can subscribe, and items can be
+ * written from interrupts.
+ *
+ * Each subscriber is described by an xBroadcastSubscriber variable, which is
+ * owned by the subscribing task and only used by it.  The channel does not
+ * keep a record of its subscribers, so subscribing and unsubscribing cost
+ * nothing - a subscriber that is no longer needed is simply not used again.
+ */
+
+#ifndef BROADCAST_CHANNEL_H
+#define BROADCAST_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include broadcast_channel.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which broadcast channels are referenced.  For example, a call to
+ * xBroadcastChannelCreate() returns an xBroadcastChannelHandle variable that
+ * can then be used as a parameter to xBroadcastChannelSend(),
+ * xBroadcastChannelReceive(), etc.
+ */
+typedef void * xBroadcastChannelHandle;
+
+/**
+ * The read cursor of a subscriber.  Set by vBroadcastChannelSubscribe(), and
+ * not to be accessed directly by the application.
+ */
+typedef struct xBROADCAST_SUBSCRIBER
+{
+	unsigned long ulNextItem;				/*< The sequence number of the next item the subscriber will receive. */
+	unsigned long ulOverruns;				/*< The number of items the subscriber missed because it fell behind. */
+} xBroadcastSubscriber;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ xBroadcastChannelHandle xBroadcastChannelCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize );
+ </pre>
+ *
+ * Creates a new broadcast channel, obtaining the memory for it from the
+ * FreeRTOS heap.
+ *
+ * @param uxLength The number of items the ring holds, which must be a power
+ * of two.  A subscriber can fall this many items behind the writer before it
+ * misses any.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return If NULL is returned then the channel could not be created because
+ * there was insufficient heap memory available or uxLength is not a power of
+ * two.  Any other value is the handle of the created channel.
+ *
+ * \defgroup xBroadcastChannelCreate xBroadcastChannelCreate
+ * \ingroup BroadcastChannels
+ */
+xBroadcastChannelHandle xBroadcastChannelCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ xBroadcastChannelHandle xBroadcastChannelCreateStatic( unsigned portBASE_TYPE uxLength,
+                                                        unsigned portBASE_TYPE uxItemSize,
+                                                        unsigned char *pucChannelStorageArea,
+                                                        xStaticBroadcastChannel *pxStaticChannel );
+ </pre>
+ *
+ * Creates a new broadcast channel using memory supplied by the application
+ * instead of memory obtained from the FreeRTOS heap.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param uxLength As for xBroadcastChannelCreate().
+ *
+ * @param uxItemSize As for xBroadcastChannelCreate().
+ *
+ * @param pucChannelStorageArea Must point to an array of at least
+ * ( uxLength * uxItemSize ) bytes, into which items are copied.
+ *
+ * @param pxStaticChannel Must point to a variable of type
+ * xStaticBroadcastChannel, which will be used to hold the channel's data
+ * structure.
+ *
+ * @return The handle of the created channel, or NULL if uxLength is not a
+ * power of two or either buffer is NULL.
+ *
+ * \defgroup xBroadcastChannelCreateStatic xBroadcastChannelCreateStatic
+ * \ingroup BroadcastChannels
+ */
+xBroadcastChannelHandle xBroadcastChannelCreateStatic( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucChannelStorageArea, xStaticBroadcastChannel *pxStaticChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ void vBroadcastChannelDelete( xBroadcastChannelHandle xChannel );
+ </pre>
+ *
+ * Deletes a channel.  No task can be waiting to receive from it.  Memory
+ * supplied to xBroadcastChannelCreateStatic() is not freed.
+ *
+ * \defgroup vBroadcastChannelDelete vBroadcastChannelDelete
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastChannelDelete( xBroadcastChannelHandle xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ void vBroadcastChannelSubscribe( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber );
+ </pre>
+ *
+ * Sets the cursor pointed to by pxSubscriber to receive the items written to
+ * the channel from now on, and clears its overrun count.
+ *
+ * \defgroup vBroadcastChannelSubscribe vBroadcastChannelSubscribe
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastChannelSubscribe( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ void vBroadcastChannelSend( xBroadcastChannelHandle xChannel, const void *pvItem );
+ </pre>
+ *
+ * Writes an item to the channel, overwriting the oldest item if the ring is
+ * full, and unblocks every task waiting to receive from the channel.  Never
+ * blocks.
+ *
+ * @param xChannel The handle of the channel being written.
+ *
+ * @param pvItem A pointer to the item, which is copied into the channel.
+ *
+ * \defgroup vBroadcastChannelSend vBroadcastChannelSend
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastChannelSend( xBroadcastChannelHandle xChannel, const void *pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ void vBroadcastChannelSendFromISR( xBroadcastChannelHandle xChannel, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of vBroadcastChannelSend() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task with a priority
+ * above that of the interrupted task was unblocked, in which case a context
+ * switch should be requested before the interrupt exits.  Can be NULL.
+ *
+ * \defgroup vBroadcastChannelSendFromISR vBroadcastChannelSendFromISR
+ * \ingroup BroadcastChannels
+ */
+void vBroadcastChannelSendFromISR( xBroadcastChannelHandle xChannel, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ portBASE_TYPE xBroadcastChannelReceive( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber, void *pvBuffer, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives the next item for a subscriber.  If the subscriber has fallen
+ * more than the length of the ring behind, the oldest item still held is
+ * received and the items that were overwritten are added to its overrun
+ * count.  Receiving an item does not remove it from the channel for the
+ * other subscribers.
+ *
+ * @param xChannel The handle of the channel being read.
+ *
+ * @param pxSubscriber The cursor of the subscriber, set by
+ * vBroadcastChannelSubscribe().
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item if
+ * the subscriber has received every item written so far.  Setting
+ * xTicksToWait to 0 causes the function to return immediately.
+ *
+ * @return pdPASS if an item was received, otherwise pdFAIL.
+ *
+ * \defgroup xBroadcastChannelReceive xBroadcastChannelReceive
+ * \ingroup BroadcastChannels
+ */
+portBASE_TYPE xBroadcastChannelReceive( xBroadcastChannelHandle xChannel, xBroadcastSubscriber *pxSubscriber, void *pvBuffer, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_channel.h
+ *
+ * <pre>
+ unsigned long ulBroadcastChannelGetOverruns( xBroadcastSubscriber *pxSubscriber );
+ </pre>
+ *
+ * @return The number of items the subscriber has missed since it subscribed
+ * because it fell too far behind the writer.
+ *
+ * \defgroup ulBroadcastChannelGetOverruns ulBroadcastChannelGetOverruns
+ * \ingroup BroadcastChannels
+ */
+#define ulBroadcastChannelGetOverruns( pxSubscriber ) ( ( pxSubscriber )->ulOverruns )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BROADCAST_CHANNEL_H */
@@ -0,0 +1,350 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Header only C++ wrappers for tasks, queues, semaphores, mutexes and software
+ * timers.  Every object holds its own storage - the task stack, the queue
+ * storage area and the kernel structures - so nothing is allocated from the
+ * FreeRTOS heap, and an object declared at file scope is created by its
+ * constructor before main() runs.  The size of a queue and of a task stack
+ * are template parameters, so are fixed at compile time.
+ *
+ * Queue<T, N> only accepts trivially copyable item types, as items are copied
+ * into and out of the queue byte by byte, and the item size is always
+ * sizeof( T ), so cannot be got wrong.  Each member function compiles to a
+ * single call of the equivalent C API function, and the kernel copies byte
+ * and word sized items with a single load and store, so a typed queue costs
+ * no more than the hand written C.
+ *
+ * Requires a C++11 compiler, and configSUPPORT_STATIC_ALLOCATION to be set to
+ * 1 in FreeRTOSConfig.h.
+ *
+ * Example usage:
+ *
+ * static rtos::Queue< unsigned short, 8 > xSamples;
+ * static rtos::Task< 256 > xConsumer;
+ *
+ * static void vConsumer( void *pvParameters )
+ * {
+ * unsigned short usSample;
+ *
+ *     for( ;; )
+ *     {
+ *         if( xSamples.receive( usSample ) )
+ *         {
+ *             // Process usSample.
+ *         }
+ *     }
+ * }
+ *
+ * void vADCInterruptHandler( void )
+ * {
+ * signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *     xSamples.sendFromISR( ADC_RESULT, &xHigherPriorityTaskWoken );
+ *     portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * int main( void )
+ * {
+ *     xConsumer.create( vConsumer, "Consumer", NULL, tskIDLE_PRIORITY + 1 );
+ *     vTaskStartScheduler();
+ * }
+ */
+
+#ifndef CPP_WRAPPERS_HPP
+#define CPP_WRAPPERS_HPP
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include cpp_wrappers.hpp"
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error "configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use cpp_wrappers.hpp"
+#endif
+
+#include <type_traits>
+
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#if ( configUSE_TIMERS == 1 )
+	#include "timers.h"
+#endif
+
+namespace rtos
+{
+
+/*-----------------------------------------------------------*/
+
+/*
+ * A queue of at most N items of type T.  The member functions return true
+ * where the equivalent C function would return pdPASS.
+ */
+template< typename T, unsigned portBASE_TYPE N >
+class Queue
+{
+	static_assert( std::is_trivially_copyable< T >::value, "queue items are copied byte by byte, so must be trivially copyable" );
+	static_assert( N > 0U, "a queue must hold at least one item" );
+
+public:
+	Queue() : xHandle( xQueueCreateStatic( N, sizeof( T ), ucStorage, &xQueueBuffer ) ) {}
+	~Queue() { vQueueDelete( xHandle ); }
+
+	bool send( const T &xItem, portTickType xTicksToWait = portMAX_DELAY ) { return xQueueSendToBack( xHandle, &xItem, xTicksToWait ) == pdPASS; }
+	bool sendToFront( const T &xItem, portTickType xTicksToWait = portMAX_DELAY ) { return xQueueSendToFront( xHandle, &xItem, xTicksToWait ) == pdPASS; }
+	bool receive( T &xItem, portTickType xTicksToWait = portMAX_DELAY ) { return xQueueReceive( xHandle, &xItem, xTicksToWait ) == pdPASS; }
+	bool peek( T &xItem, portTickType xTicksToWait = portMAX_DELAY ) { return xQueuePeek( xHandle, &xItem, xTicksToWait ) == pdPASS; }
+
+	bool sendFromISR( const T &xItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xQueueSendToBackFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool sendToFrontFromISR( const T &xItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xQueueSendToFrontFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool receiveFromISR( T &xItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xQueueReceiveFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool peekFromISR( T &xItem ) { return xQueuePeekFromISR( xHandle, &xItem ) == pdPASS; }
+
+	/* Only available for a queue of length one, which is used as a mailbox. */
+	void overwrite( const T &xItem ) { static_assert( N == 1U, "only a queue of length one can be overwritten" ); ( void ) xQueueOverwrite( xHandle, &xItem ); }
+	void overwriteFromISR( const T &xItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { static_assert( N == 1U, "only a queue of length one can be overwritten" ); ( void ) xQueueOverwriteFromISR( xHandle, &xItem, pxHigherPriorityTaskWoken ); }
+
+	unsigned portBASE_TYPE messagesWaiting() const { return uxQueueMessagesWaiting( xHandle ); }
+	void reset() { ( void ) xQueueReset( xHandle ); }
+	xQueueHandle handle() const { return xHandle; }
+
+	Queue( const Queue & ) = delete;
+	Queue &operator=( const Queue & ) = delete;
+
+private:
+	alignas( T ) unsigned char ucStorage[ N * sizeof( T ) ];
+	xStaticQueue xQueueBuffer;
+	xQueueHandle xHandle;
+};
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+/*
+ * A mutex, with priority inheritance.
+ */
+class Mutex
+{
+public:
+	Mutex() : xHandle( xSemaphoreCreateMutexStatic( &xMutexBuffer ) ) {}
+	~Mutex() { vSemaphoreDelete( xHandle ); }
+
+	bool take( portTickType xTicksToWait = portMAX_DELAY ) { return xSemaphoreTake( xHandle, xTicksToWait ) == pdPASS; }
+	bool give() { return xSemaphoreGive( xHandle ) == pdPASS; }
+	xSemaphoreHandle handle() const { return xHandle; }
+
+	Mutex( const Mutex & ) = delete;
+	Mutex &operator=( const Mutex & ) = delete;
+
+private:
+	xStaticSemaphore xMutexBuffer;
+	xSemaphoreHandle xHandle;
+};
+
+#endif /* configUSE_MUTEXES */
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+/*
+ * A mutex that the task holding it can take again, and that is released
+ * when it has been given back as many times as it was taken.
+ */
+class RecursiveMutex
+{
+public:
+	RecursiveMutex() : xHandle( xSemaphoreCreateRecursiveMutexStatic( &xMutexBuffer ) ) {}
+	~RecursiveMutex() { vSemaphoreDelete( xHandle ); }
+
+	bool take( portTickType xTicksToWait = portMAX_DELAY ) { return xSemaphoreTakeRecursive( xHandle, xTicksToWait ) == pdPASS; }
+	bool give() { return xSemaphoreGiveRecursive( xHandle ) == pdPASS; }
+	xSemaphoreHandle handle() const { return xHandle; }
+
+	RecursiveMutex( const RecursiveMutex & ) = delete;
+	RecursiveMutex &operator=( const RecursiveMutex & ) = delete;
+
+private:
+	xStaticSemaphore xMutexBuffer;
+	xSemaphoreHandle xHandle;
+};
+
+#endif /* configUSE_RECURSIVE_MUTEXES */
+
+/*
+ * Holds a mutex for the lifetime of the object, for example:
+ *
+ * {
+ *     rtos::LockGuard< rtos::Mutex > xLock( xMutex );
+ *     // Access the resource guarded by xMutex.
+ * }
+ */
+template< typename M >
+class LockGuard
+{
+public:
+	explicit LockGuard( M &xMutexToHold ) : xMutex( xMutexToHold ) { ( void ) xMutex.take(); }
+	~LockGuard() { ( void ) xMutex.give(); }
+
+	LockGuard( const LockGuard & ) = delete;
+	LockGuard &operator=( const LockGuard & ) = delete;
+
+private:
+	M &xMutex;
+};
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+/*
+ * A counting semaphore that counts up to uxMaxCount, starting from
+ * uxInitialCount.  Use a uxMaxCount of one for a binary semaphore.
+ */
+class Semaphore
+{
+public:
+	Semaphore( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount ) : xHandle( xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, &xSemaphoreBuffer ) ) {}
+	~Semaphore() { vSemaphoreDelete( xHandle ); }
+
+	bool take( portTickType xTicksToWait = portMAX_DELAY ) { return xSemaphoreTake( xHandle, xTicksToWait ) == pdPASS; }
+	bool give() { return xSemaphoreGive( xHandle ) == pdPASS; }
+	bool giveFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xSemaphoreGiveFromISR( xHandle, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool takeFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xQueueReceiveFromISR( ( xQueueHandle ) xHandle, NULL, pxHigherPriorityTaskWoken ) == pdPASS; }
+	unsigned portBASE_TYPE count() const { return uxQueueMessagesWaiting( ( xQueueHandle ) xHandle ); }
+	xSemaphoreHandle handle() const { return xHandle; }
+
+	Semaphore( const Semaphore & ) = delete;
+	Semaphore &operator=( const Semaphore & ) = delete;
+
+private:
+	xStaticSemaphore xSemaphoreBuffer;
+	xSemaphoreHandle xHandle;
+};
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+/*
+ * A software timer.  The callback runs in the timer service task, and can
+ * retrieve pvTimerID with pvTimerGetTimerID() as usual.  Commands are sent to
+ * the timer service task as with the C API, and xTicksToWait is the time to
+ * wait for space on the timer command queue.
+ */
+class Timer
+{
+public:
+	Timer( const char *pcName, portTickType xPeriod, bool xAutoReload, tmrTIMER_CALLBACK pxCallback, void *pvTimerID = NULL ) :
+		xHandle( xTimerCreateStatic( ( const signed char * ) pcName, xPeriod, xAutoReload ? pdTRUE : pdFALSE, pvTimerID, pxCallback, &xTimerBuffer ) ) {}
+	~Timer() { ( void ) xTimerDelete( xHandle, portMAX_DELAY ); }
+
+	bool start( portTickType xTicksToWait = 0 ) { return xTimerStart( xHandle, xTicksToWait ) == pdPASS; }
+	bool stop( portTickType xTicksToWait = 0 ) { return xTimerStop( xHandle, xTicksToWait ) == pdPASS; }
+	bool reset( portTickType xTicksToWait = 0 ) { return xTimerReset( xHandle, xTicksToWait ) == pdPASS; }
+	bool changePeriod( portTickType xNewPeriod, portTickType xTicksToWait = 0 ) { return xTimerChangePeriod( xHandle, xNewPeriod, xTicksToWait ) == pdPASS; }
+
+	bool startFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xTimerStartFromISR( xHandle, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool stopFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xTimerStopFromISR( xHandle, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool resetFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xTimerResetFromISR( xHandle, pxHigherPriorityTaskWoken ) == pdPASS; }
+	bool changePeriodFromISR( portTickType xNewPeriod, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) { return xTimerChangePeriodFromISR( xHandle, xNewPeriod, pxHigherPriorityTaskWoken ) == pdPASS; }
+
+	bool isActive() const { return xTimerIsTimerActive( xHandle ) != pdFALSE; }
+	xTimerHandle handle() const { return xHandle; }
+
+	Timer( const Timer & ) = delete;
+	Timer &operator=( const Timer & ) = delete;
+
+private:
+	xStaticTimer xTimerBuffer;
+	xTimerHandle xHandle;
+};
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+/*
+ * The stack and TCB of a task with a stack of StackWords portSTACK_TYPE
+ * variables.  The task is created by create() rather than by the
+ * constructor, so the priority and parameter can be chosen at run time, and
+ * is not deleted when the object is destroyed - objects are expected to
+ * persist for the lifetime of the application.
+ */
+template< unsigned short StackWords >
+class Task
+{
+	static_assert( StackWords >= configMINIMAL_STACK_SIZE, "the stack must be at least configMINIMAL_STACK_SIZE words" );
+
+public:
+	Task() : xHandle( NULL ) {}
+
+	bool create( pdTASK_CODE pxTaskCode, const char *pcName, void *pvParameters, unsigned portBASE_TYPE uxPriority )
+	{
+		return xTaskCreateStatic( pxTaskCode, ( const signed char * ) pcName, StackWords, pvParameters, uxPriority, &xHandle, xStack, &xTaskBuffer ) == pdPASS;
+	}
+
+	xTaskHandle handle() const { return xHandle; }
+
+	Task( const Task & ) = delete;
+	Task &operator=( const Task & ) = delete;
+
+private:
+	portSTACK_TYPE xStack[ StackWords ];
+	xStaticTask xTaskBuffer;
+	xTaskHandle xHandle;
+};
+
+} /* namespace rtos */
+
+#endif /* CPP_WRAPPERS_HPP */
@@ -0,0 +1,189 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The CPU governor scales the core clock to the CPU load.  The application
+ * describes the operating points of its board, slowest first, and the
+ * governor measures the load over a window of ticks from the run time the
+ * idle task has used, using configGENERATE_RUN_TIME_STATS.
+ *
+ * When the load over a window is above configCPU_GOVERNOR_UP_THRESHOLD
+ * percent the governor moves straight to the fastest operating point, so a
+ * burst of work is met at full speed.  When it is below
+ * configCPU_GOVERNOR_DOWN_THRESHOLD percent it moves to the slowest operating
+ * point that would have run the same work below the up threshold.  A driver
+ * that needs a minimum clock, for example while a transfer is in progress,
+ * can hold the governor at or above an operating point.
+ *
+ * The operating point is changed by vApplicationSetCpuOperatingPoint(),
+ * which is provided by the application.  It is called from a critical
+ * section, and has to switch the PLL and reprogram the dividers of the
+ * peripherals clocked from the core clock - such as UART baud rate
+ * generators - so they keep their rates.  The governor then corrects the
+ * tick timer through portCPU_CLOCK_CHANGED(), so configUSE_CPU_CLOCK_SCALING
+ * must be set to 1.  The governor runs from a software timer, so
+ * configUSE_TIMERS must also be set to 1.
+ *
+ * The run time counter can be clocked from the core clock, as each window
+ * compares the idle run time with the run time counter over the same
+ * interval, and a new window is started whenever the clock is changed.
+ */
+
+#ifndef CPU_GOVERNOR_H
+#define CPU_GOVERNOR_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include cpu_governor.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An operating point.  The application passes an array of them, slowest
+ * first, to xCpuGovernorStart().
+ */
+typedef struct xCPU_OPERATING_POINT
+{
+	unsigned long ulCpuClockHz;			/*< The core clock frequency at this operating point. */
+	void *pvBoardSettings;				/*< Free for use by vApplicationSetCpuOperatingPoint(), for example to point to the PLL settings. */
+} xCpuOperatingPoint;
+
+/**
+ * cpu_governor.h
+ *
+ * <pre>
+ portBASE_TYPE xCpuGovernorStart( const xCpuOperatingPoint * const pxPoints, unsigned portBASE_TYPE uxNumberOfPoints, unsigned portBASE_TYPE uxCurrentPoint, portTickType xWindow );
+ </pre>
+ *
+ * Starts the governor.  Must only be called once.
+ *
+ * @param pxPoints The operating points of the board, slowest first.  The array
+ * is used in place, so it must remain valid while the governor runs.
+ *
+ * @param uxNumberOfPoints The number of entries in pxPoints.
+ *
+ * @param uxCurrentPoint The operating point the board is running at when the
+ * governor is started.  It is not set again.
+ *
+ * @param xWindow The number of ticks over which the load is measured before
+ * the operating point is reviewed.
+ *
+ * @return pdPASS if the governor was started, or pdFAIL if its timer could
+ * not be created or started.
+ *
+ * \defgroup xCpuGovernorStart xCpuGovernorStart
+ * \ingroup CpuGovernor
+ */
+portBASE_TYPE xCpuGovernorStart( const xCpuOperatingPoint * const pxPoints, unsigned portBASE_TYPE uxNumberOfPoints, unsigned portBASE_TYPE uxCurrentPoint, portTickType xWindow ) PRIVILEGED_FUNCTION;
+
+/**
+ * cpu_governor.h
+ *
+ * <pre>
+ void vCpuGovernorSetMinimumPoint( unsigned portBASE_TYPE uxPoint );
+ </pre>
+ *
+ * Stops the governor choosing an operating point slower than uxPoint.  If
+ * the current operating point is slower it is changed before the function
+ * returns.  Passing 0 lets the governor use every operating point again.
+ *
+ * \defgroup vCpuGovernorSetMinimumPoint vCpuGovernorSetMinimumPoint
+ * \ingroup CpuGovernor
+ */
+void vCpuGovernorSetMinimumPoint( unsigned portBASE_TYPE uxPoint ) PRIVILEGED_FUNCTION;
+
+/**
+ * cpu_governor.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxCpuGovernorGetPoint( void );
+ </pre>
+ *
+ * @return The index in the array passed to xCpuGovernorStart() of the
+ * operating point the board is running at.
+ *
+ * \defgroup uxCpuGovernorGetPoint uxCpuGovernorGetPoint
+ * \ingroup CpuGovernor
+ */
+unsigned portBASE_TYPE uxCpuGovernorGetPoint( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * cpu_governor.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxCpuGovernorGetLoad( void );
+ </pre>
+ *
+ * @return The CPU load measured over the last complete window, in percent.
+ *
+ * \defgroup uxCpuGovernorGetLoad uxCpuGovernorGetLoad
+ * \ingroup CpuGovernor
+ */
+unsigned portBASE_TYPE uxCpuGovernorGetLoad( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Provided by the application.  Switches the board to the operating point
+ * pxPoint, and reprograms the clock dividers of the peripherals that are
+ * clocked from the core clock so they keep their rates.  Called from a
+ * critical section, so it should be as short as the clock hardware allows.
+ */
+void vApplicationSetCpuOperatingPoint( const xCpuOperatingPoint * const pxPoint );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPU_GOVERNOR_H */
@@ -80,6 +80,10 @@ typedef struct corCoRoutineControlBlock
 	unsigned portBASE_TYPE 	uxPriority;			/*< The priority of the co-routine in relation to other co-routines. */
 	unsigned portBASE_TYPE 	uxIndex;			/*< Used to distinguish between co-routines when multiple co-routines use the same co-routine function. */
 	unsigned short 		uxState;			/*< Used internally by the co-routine implementation. */
+	#if ( configUSE_CO_ROUTINE_HOST == 1 )
+		volatile unsigned char ucNotified;		/*< Set to pdTRUE by xCoRoutineNotify() until the co-routine consumes the notification in crWAIT_NOTIFY(). */
+		volatile unsigned char ucWaitingNotify;	/*< Set to pdTRUE while the co-routine is blocked in crWAIT_NOTIFY(). */
+	#endif
 } corCRCB; /* Co-routine control block.  Note must be identical in size down to uxPriority with tskTCB. */
 
 /**
@@ -198,6 +202,90 @@ signed portBASE_TYPE xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, unsigne
  */
 void vCoRoutineSchedule( void );
 
+/**
+ * croutine. h
+ *<pre>
+ void vCoRoutineHost( void *pvParameters );</pre>
+ *
+ * Only available when configUSE_CO_ROUTINE_HOST is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * A task function that runs the co-routines, as an alternative to calling
+ * vCoRoutineSchedule() from the idle task hook.  Create a task with
+ * vCoRoutineHost() as its function, at whatever priority the co-routines as
+ * a whole are to run at, and with a stack large enough for the deepest call
+ * made by any co-routine.  The host task runs every ready co-routine in
+ * priority order, then blocks until a co-routine delay expires or an event -
+ * a queue send or receive by an interrupt or another co-routine, or a call of
+ * xCoRoutineNotify() - readies a co-routine.  Co-routines therefore run even
+ * when the processor is not otherwise idle, and cost nothing while they are
+ * all blocked.
+ *
+ * As co-routines hosted this way run in the context of a task, they can also
+ * call the task API functions that do not block - for example
+ * xQueueReceive() with a block time of zero.  Where a co-routine needs to
+ * wait for a normal queue, semaphore or software timer, the task, interrupt
+ * or timer callback at the other end calls xCoRoutineNotify() or
+ * xCoRoutineNotifyFromISR() after operating on the object, and the
+ * co-routine waits in crWAIT_NOTIFY().
+ *
+ * Only one host task can be created, and vCoRoutineSchedule() must not also
+ * be called.  Co-routines must be created before the host task starts, or by
+ * a co-routine running in the host task.
+ *
+ * Example usage:
+   <pre>
+ void main( void )
+ {
+     // Create the co-routines, then the task that runs them.
+     xCoRoutineCreate( vProtocolCoRoutine, 0, 0 );
+     xCoRoutineCreate( vProtocolCoRoutine, 0, 1 );
+     xTaskCreate( vCoRoutineHost, "CRHost", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, NULL );
+
+     vTaskStartScheduler();
+ }
+ </pre>
+ * \defgroup vCoRoutineHost vCoRoutineHost
+ * \ingroup Tasks
+ */
+void vCoRoutineHost( void *pvParameters );
+
+/**
+ * croutine. h
+ *<pre>
+ signed portBASE_TYPE xCoRoutineNotify( xCoRoutineHandle xCoRoutine );
+ signed portBASE_TYPE xCoRoutineNotifyFromISR( xCoRoutineHandle xCoRoutine, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</pre>
+ *
+ * Only available when configUSE_CO_ROUTINE_HOST is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Send a notification to a co-routine, readying it if it is blocked in
+ * crWAIT_NOTIFY().  A notification sent while the co-routine is not waiting
+ * is held until its next crWAIT_NOTIFY(), which then returns at once.
+ * Notifications do not count - sending several before the co-routine waits
+ * has the same effect as sending one.
+ *
+ * xCoRoutineNotify() can be called from a task, including from a software
+ * timer callback, and xCoRoutineNotifyFromISR() from an interrupt.  The
+ * handle of a co-routine is the xHandle parameter of its function, which the
+ * co-routine can publish for the code that notifies it.
+ *
+ * @param xCoRoutine The handle of the co-routine to notify.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the notification
+ * unblocked the host task and the host task has a priority above that of the
+ * interrupted task, in which case a context switch should be requested
+ * before the interrupt exits.
+ *
+ * @return pdTRUE if the co-routine was waiting for the notification, otherwise
+ * pdFALSE.
+ *
+ * \defgroup xCoRoutineNotify xCoRoutineNotify
+ * \ingroup Tasks
+ */
+signed portBASE_TYPE xCoRoutineNotify( xCoRoutineHandle xCoRoutine );
+signed portBASE_TYPE xCoRoutineNotifyFromISR( xCoRoutineHandle xCoRoutine, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
 /**
  * croutine. h
  * <pre>
@@ -340,6 +428,10 @@ void vCoRoutineSchedule( void );
  * from within a function called by the co-routine function.  This is because
  * co-routines do not maintain their own stack.
  *
+ * If configUSE_QUEUE_CO_ROUTINE_BRIDGE is set to 1 a task blocked on
+ * xQueueReceive() is unblocked by crQUEUE_SEND, and a co-routine blocked in
+ * crQUEUE_SEND is unblocked when a task or interrupt receives from the queue.
+ *
  * See the co-routine section of the WEB documentation for information on
  * passing data between tasks and co-routines and between ISR's and
  * co-routines.
@@ -439,6 +531,10 @@ void vCoRoutineSchedule( void );
  * from within a function called by the co-routine function.  This is because
  * co-routines do not maintain their own stack.
  *
+ * If configUSE_QUEUE_CO_ROUTINE_BRIDGE is set to 1 a co-routine blocked in
+ * crQUEUE_RECEIVE is unblocked when a task or interrupt sends to the queue,
+ * and a task blocked on xQueueSend() is unblocked by crQUEUE_RECEIVE.
+ *
  * See the co-routine section of the WEB documentation for information on
  * passing data between tasks and co-routines and between ISR's and
  * co-routines.
@@ -719,6 +815,78 @@ void vCoRoutineSchedule( void );
  */
 #define crQUEUE_RECEIVE_FROM_ISR( pxQueue, pvBuffer, pxCoRoutineWoken ) xQueueCRReceiveFromISR( ( pxQueue ), ( pvBuffer ), ( pxCoRoutineWoken ) )
 
+/**
+ * croutine. h
+ * <pre>
+  crWAIT_NOTIFY(
+                    xCoRoutineHandle xHandle,
+                    portTickType xTicksToWait,
+                    portBASE_TYPE *pxResult
+               )</pre>
+ *
+ * Only available when configUSE_CO_ROUTINE_HOST is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Block the co-routine until it is sent a notification by
+ * xCoRoutineNotify() or xCoRoutineNotifyFromISR(), or until xTicksToWait ticks
+ * have passed.  See vCoRoutineHost().
+ *
+ * crWAIT_NOTIFY can only be called from the co-routine function itself - not
+ * from within a function called by the co-routine function.  This is because
+ * co-routines do not maintain their own stack.
+ *
+ * @param xHandle The handle of the calling co-routine.  This is the xHandle
+ * parameter of the co-routine function.
+ *
+ * @param xTicksToWait The number of ticks to wait for the notification, or 0
+ * to only consume a notification that is already held.
+ *
+ * @param pxResult Set to pdPASS if a notification was received, otherwise
+ * pdFAIL.
+ *
+ * Example usage:
+   <pre>
+ // The handle of the co-routine, published for the task that feeds the queue.
+ xCoRoutineHandle xReceiverHandle;
+
+ // A co-routine that services a normal queue written by a task.  The task
+ // calls xCoRoutineNotify( xReceiverHandle ) after each xQueueSend().
+ void vReceiverCoRoutine( xCoRoutineHandle xHandle, unsigned portBASE_TYPE uxIndex )
+ {
+ static portBASE_TYPE xResult;
+ static char cMessage;
+
+     crSTART( xHandle );
+
+     xReceiverHandle = xHandle;
+
+     for( ;; )
+     {
+         // Read everything the queue holds, without blocking.
+         while( xQueueReceive( xMessageQueue, &cMessage, 0 ) == pdPASS )
+         {
+             vProcessMessage( cMessage );
+         }
+
+         // Then wait for the task to send more.
+         crWAIT_NOTIFY( xHandle, portMAX_DELAY, &xResult );
+     }
+
+     crEND();
+ }</pre>
+ * \defgroup crWAIT_NOTIFY crWAIT_NOTIFY
+ * \ingroup Tasks
+ */
+#define crWAIT_NOTIFY( xHandle, xTicksToWait, pxResult )							\
+{																					\
+	*( pxResult ) = xCoRoutineWaitNotify( ( xTicksToWait ) );						\
+	if( *( pxResult ) == errQUEUE_BLOCKED )											\
+	{																				\
+		crSET_STATE0( ( xHandle ) );												\
+		*( pxResult ) = xCoRoutineWaitNotify( 0 );									\
+	}																				\
+}
+
 /*
  * This function is intended for internal use by the co-routine macros only.
  * The macro nature of the co-routine implementation requires that the
@@ -730,6 +898,16 @@ void vCoRoutineSchedule( void );
  */
 void vCoRoutineAddToDelayedList( portTickType xTicksToDelay, xList *pxEventList );
 
+/*
+ * This function is intended for internal use by the co-routine macros only.
+ * The function should not be used by application writers.
+ *
+ * Consumes a notification held by the current co-routine, or if there is none
+ * and xTicksToWait is not zero, blocks the co-routine and returns
+ * errQUEUE_BLOCKED.
+ */
+signed portBASE_TYPE xCoRoutineWaitNotify( portTickType xTicksToWait );
+
 /*
  * This function is intended for internal use by the queue implementation only.
  * The function should not be used by application writers.
@@ -739,6 +917,16 @@ void vCoRoutineAddToDelayedList( portTickType xTicksToDelay, xList *pxEventList
  */
 signed portBASE_TYPE xCoRoutineRemoveFromEventList( const xList *pxEventList );
 
+/*
+ * This function is intended for internal use by the queue implementation only.
+ * The function should not be used by application writers.
+ *
+ * As xCoRoutineRemoveFromEventList(), but called when a task or an interrupt
+ * using the task queue API unblocks a co-routine.  Returns pdTRUE if the task
+ * that runs the co-routines now has a priority above the calling task.
+ */
+signed portBASE_TYPE xCoRoutineRemoveFromQueueEventList( const xList *pxEventList );
+
 #ifdef __cplusplus
 }
 #endif
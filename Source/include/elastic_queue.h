@@ -0,0 +1,265 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * An elastic queue passes items between tasks, and from interrupts to tasks,
+ * like a normal queue, but holds its items in fixed size segments taken from
+ * a memory pool (see memory_pool.h) only while they are needed.  A normal
+ * queue has to be created large enough for the worst burst it will ever see,
+ * and that storage is reserved even while the queue is empty.  Any number of
+ * elastic queues can instead share one pool sized for the bursts that occur
+ * together, each growing up to its own maximum length when it is busy and
+ * giving its segments back to the pool as they drain.
+ *
+ * Each segment is one block of the pool.  The first bytes of a segment link
+ * it to the next segment of the queue and the rest holds as many items as
+ * fit, so a pool with 128 byte blocks on a 32-bit target holds 31 four byte
+ * items per segment.  The segments of a queue form a singly linked list;
+ * items are written at the tail and read from the head, so sending and
+ * receiving both take O( 1 ) time.  A segment is returned to the pool as soon
+ * as its last item has been read, and the partly filled segment of a queue
+ * that becomes empty is returned too, so an idle queue holds no storage.
+ *
+ * Senders block while the queue holds its maximum number of items, and
+ * receivers block while it is empty, in task priority order, as with a
+ * normal queue.  A sender also blocks if a new segment is needed and the pool
+ * has none free.  Every elastic queue that returns a segment to a pool
+ * unblocks all the tasks waiting for a segment, each of which then tries
+ * again - so a pool used by elastic queues should not also be used directly
+ * by the application, as blocks it frees do not unblock the waiting senders
+ * before their block time expires.
+ */
+
+#ifndef ELASTIC_QUEUE_H
+#define ELASTIC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include elastic_queue.h"
+#endif
+
+#include "memory_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which elastic queues are referenced.  For example, a call to
+ * xElasticQueueCreate() returns an xElasticQueueHandle variable that can then
+ * be used as a parameter to xElasticQueueSend(), xElasticQueueReceive(), etc.
+ */
+typedef void * xElasticQueueHandle;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ xElasticQueueHandle xElasticQueueCreate( unsigned portBASE_TYPE uxMaxLength, unsigned portBASE_TYPE uxItemSize, xMemoryPoolHandle xSegmentPool );
+ </pre>
+ *
+ * Creates a new elastic queue.  The structure used to manage the queue is
+ * obtained from the FreeRTOS heap, but no storage for items is allocated
+ * until items are sent.
+ *
+ * @param uxMaxLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param xSegmentPool The memory pool from which the queue's segments are
+ * taken.  The blocks of the pool must be large enough to hold a pointer and
+ * at least one item.
+ *
+ * @return If NULL is returned then the queue could not be created, either
+ * because there was insufficient heap memory available or because the
+ * blocks of xSegmentPool are too small to hold an item.  Any other value is
+ * the handle of the created queue.
+ *
+ * \defgroup xElasticQueueCreate xElasticQueueCreate
+ * \ingroup ElasticQueues
+ */
+xElasticQueueHandle xElasticQueueCreate( unsigned portBASE_TYPE uxMaxLength, unsigned portBASE_TYPE uxItemSize, xMemoryPoolHandle xSegmentPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ void vElasticQueueDelete( xElasticQueueHandle xQueue );
+ </pre>
+ *
+ * Deletes an elastic queue, returning any segments it still holds to the
+ * pool.  No task can be waiting to send to or receive from it.
+ *
+ * \defgroup vElasticQueueDelete vElasticQueueDelete
+ * \ingroup ElasticQueues
+ */
+void vElasticQueueDelete( xElasticQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xElasticQueueSend( xElasticQueueHandle xQueue, const void *pvItem, portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends an item to the back of an elastic queue, taking a new segment from
+ * the pool if the last segment is full.  O( 1 ).
+ *
+ * @param xQueue The handle of the queue the item is sent to.
+ *
+ * @param pvItem A pointer to the item, which is copied into the queue.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait should the queue
+ * already hold its maximum number of items, or should a segment be needed
+ * and the pool be empty.  Setting xTicksToWait to 0 causes the function to
+ * return immediately.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xElasticQueueSend xElasticQueueSend
+ * \ingroup ElasticQueues
+ */
+portBASE_TYPE xElasticQueueSend( xElasticQueueHandle xQueue, const void *pvItem, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xElasticQueueSendFromISR( xElasticQueueHandle xQueue, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xElasticQueueSend() that can be called from an interrupt
+ * service routine.  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item
+ * unblocked a task with a priority above that of the interrupted task, in
+ * which case a context switch should be requested before the interrupt
+ * exits.  Can be NULL.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xElasticQueueSendFromISR xElasticQueueSendFromISR
+ * \ingroup ElasticQueues
+ */
+portBASE_TYPE xElasticQueueSendFromISR( xElasticQueueHandle xQueue, const void *pvItem, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xElasticQueueReceive( xElasticQueueHandle xQueue, void *pvBuffer, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives the item at the front of an elastic queue, returning the first
+ * segment to the pool if the item was the last one it held.  O( 1 ).
+ *
+ * @param xQueue The handle of the queue the item is received from.
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item should
+ * the queue be empty.  Setting xTicksToWait to 0 causes the function to
+ * return immediately.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xElasticQueueReceive xElasticQueueReceive
+ * \ingroup ElasticQueues
+ */
+portBASE_TYPE xElasticQueueReceive( xElasticQueueHandle xQueue, void *pvBuffer, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xElasticQueueReceiveFromISR( xElasticQueueHandle xQueue, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xElasticQueueReceive() that can be called from an interrupt
+ * service routine.  Never blocks.  Returning a segment unblocks every task
+ * that is waiting for one, so the time this takes depends on the number of
+ * such tasks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a task with a priority above that of the interrupted task, in
+ * which case a context switch should be requested before the interrupt
+ * exits.  Can be NULL.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xElasticQueueReceiveFromISR xElasticQueueReceiveFromISR
+ * \ingroup ElasticQueues
+ */
+portBASE_TYPE xElasticQueueReceiveFromISR( xElasticQueueHandle xQueue, void *pvBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxElasticQueueMessagesWaiting( xElasticQueueHandle xQueue );
+ unsigned portBASE_TYPE uxElasticQueueSegmentsHeld( xElasticQueueHandle xQueue );
+ </pre>
+ *
+ * Return the number of items held by an elastic queue, and the number of
+ * pool segments used to hold them.
+ *
+ * \defgroup uxElasticQueueMessagesWaiting uxElasticQueueMessagesWaiting
+ * \ingroup ElasticQueues
+ */
+unsigned portBASE_TYPE uxElasticQueueMessagesWaiting( xElasticQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxElasticQueueSegmentsHeld( xElasticQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ELASTIC_QUEUE_H */
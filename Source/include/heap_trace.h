@@ -0,0 +1,231 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Heap tracing records which task each block of the FreeRTOS heap was
+ * allocated by, so the heap can be broken down by task while the application
+ * runs.  For every task that has allocated memory it keeps the number of
+ * bytes the task currently holds, the most it has ever held, and how many
+ * allocations and frees it has made.  It also counts the allocations made in
+ * each of a number of size classes, so the sizes an application really asks
+ * for can be seen (to choose the block sizes of memory pools, for example).
+ *
+ * Tracing is included in the build by setting configUSE_HEAP_TRACE to 1 in
+ * FreeRTOSConfig.h and adding Source/heap_trace.c to the project.  It works
+ * with all of the memory management schemes in Source/portable/MemMang.
+ *
+ * The owner of a block is held in configHEAP_TRACE_OWNER_BITS spare bits at
+ * the top of the size member of the block header, so tracing does not make
+ * the headers any bigger (heap_3.c has no header of its own, so one is added
+ * in front of each block).  Up to ( 1 << configHEAP_TRACE_OWNER_BITS ) - 1
+ * tasks are traced individually.  Allocations made before the scheduler is
+ * started, and by tasks created once every owner entry is in use, are
+ * counted against owner entry 0.  The heap must be smaller than
+ * ( 1 << ( sizeof( size_t ) * 8 - 1 - configHEAP_TRACE_OWNER_BITS ) ) bytes
+ * for the owner bits to be spare - this is checked by configASSERT() when the
+ * heap is initialised.
+ *
+ * When a task is deleted its owner entry is kept until every block it
+ * allocated has been freed again, so memory leaked by deleted tasks remains
+ * visible.
+ *
+ * The allocation and free events themselves are recorded by the
+ * traceMALLOC() and traceFREE() macros, which are implemented by the trace
+ * recorder when configUSE_TRACE_RECORDER is 1.  They do not depend on heap
+ * tracing being enabled.
+ */
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include heap_trace.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The number of owner entries, including entry 0. */
+#define heaptraceMAX_OWNERS					( 1U << configHEAP_TRACE_OWNER_BITS )
+
+/* The owner entry used for allocations that are not counted against a task. */
+#define heaptraceNO_OWNER					( ( unsigned portBASE_TYPE ) 0U )
+
+/* Size class 0 counts blocks of up to this many bytes.  Each following class
+counts blocks up to twice the size of the class before it, and the last class
+counts every block that is larger. */
+#define heaptraceSMALLEST_SIZE_CLASS		( ( size_t ) 16U )
+
+/* Used by the memory management schemes to store the owner in, and read the
+owner from, the size member of a block header.  The owner bits are the
+configHEAP_TRACE_OWNER_BITS bits below the top bit of a size_t, the top bit
+being used by heap_4.c and heap_5.c to mark allocated blocks. */
+#define heaptraceOWNER_SHIFT				( ( sizeof( size_t ) * 8U ) - 1U - configHEAP_TRACE_OWNER_BITS )
+#define heaptraceOWNER_MASK					( ( ( size_t ) heaptraceMAX_OWNERS - 1U ) << heaptraceOWNER_SHIFT )
+#define heaptraceSET_OWNER( xSize, uxOwner )	( ( xSize ) | ( ( ( size_t ) ( uxOwner ) ) << heaptraceOWNER_SHIFT ) )
+#define heaptraceGET_OWNER( xSize )			( ( unsigned portBASE_TYPE ) ( ( ( xSize ) & heaptraceOWNER_MASK ) >> heaptraceOWNER_SHIFT ) )
+
+/**
+ * Used with uxHeapTraceGetOwnerStats() to obtain the heap usage of each task.
+ * All sizes include the block headers and alignment padding, so they add up
+ * to the memory the heap has handed out.
+ */
+typedef struct xHEAP_OWNER_STATS
+{
+	xTaskHandle xTask;						/*< The task the entry belongs to, or NULL for entry 0. */
+	unsigned portBASE_TYPE uxOwner;			/*< The number of the owner entry. */
+	size_t xBytesInUse;						/*< The bytes allocated by the task that have not been freed. */
+	size_t xPeakBytesInUse;					/*< The highest value xBytesInUse has had. */
+	unsigned long ulAllocations;			/*< The number of successful allocations made by the task. */
+	unsigned long ulFrees;					/*< The number of blocks allocated by the task that have been freed, by any task. */
+	portBASE_TYPE xTaskDeleted;				/*< pdTRUE if the task has been deleted while still holding some of the heap. */
+} xHeapOwnerStats;
+
+/**
+ * Used with vHeapTraceGetStats() to obtain the statistics that are kept for
+ * the heap as a whole.
+ */
+typedef struct xHEAP_TRACE_STATS
+{
+	unsigned long ulSizeClassCount[ configHEAP_TRACE_SIZE_CLASSES ];	/*< The number of successful allocations in each size class, see heaptraceSMALLEST_SIZE_CLASS. */
+	unsigned long ulFailedAllocations;								/*< The number of calls to pvPortMalloc() that returned NULL. */
+} xHeapTraceStats;
+
+/**
+ * heap_trace.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxHeapTraceGetOwnerStats( xHeapOwnerStats *pxStats, unsigned portBASE_TYPE uxMaxEntries );
+ </pre>
+ *
+ * Copies the statistics of owner entry 0 and of every owner entry that
+ * belongs to a task into the array pointed to by pxStats.  The scheduler is
+ * suspended while the entries are copied so they are consistent with each
+ * other.
+ *
+ * @param pxStats The array into which the statistics are copied.
+ *
+ * @param uxMaxEntries The number of entries the array can hold.  An array of
+ * heaptraceMAX_OWNERS entries is always big enough.
+ *
+ * @return The number of entries copied into the array.
+ *
+ * \defgroup uxHeapTraceGetOwnerStats uxHeapTraceGetOwnerStats
+ * \ingroup HeapTrace
+ */
+unsigned portBASE_TYPE uxHeapTraceGetOwnerStats( xHeapOwnerStats *pxStats, unsigned portBASE_TYPE uxMaxEntries ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_trace.h
+ *
+ * <pre>
+ void vHeapTraceGetStats( xHeapTraceStats *pxStats );
+ </pre>
+ *
+ * Obtains the size class histogram and the number of failed allocations.
+ * The free space remaining and the size of the largest free block are
+ * obtained from the memory management scheme itself, using
+ * xPortGetFreeHeapSize() and xPortGetLargestFreeBlockSize().
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * \defgroup vHeapTraceGetStats vHeapTraceGetStats
+ * \ingroup HeapTrace
+ */
+void vHeapTraceGetStats( xHeapTraceStats *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FUNCTIONS BELOW ARE FOR USE BY THE MEMORY MANAGEMENT SCHEMES AND THE
+ * KERNEL ONLY.  They must be called with the scheduler suspended.
+ */
+
+/*
+ * Counts a successful allocation of a block of xBlockSize bytes against the
+ * calling task, and returns the owner the block is to be tagged with.
+ */
+unsigned portBASE_TYPE uxHeapTraceMalloc( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Counts an allocation that failed.
+ */
+void vHeapTraceMallocFailed( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Counts the freeing of a block of xBlockSize bytes that was tagged with
+ * uxOwner when it was allocated.
+ */
+void vHeapTraceFree( unsigned portBASE_TYPE uxOwner, size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel the first time a task allocates memory, to give the
+ * task an owner entry of its own.  Returns heaptraceNO_OWNER if every entry
+ * is in use.
+ */
+unsigned portBASE_TYPE uxHeapTraceClaimOwner( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel when a task that has an owner entry is deleted.  Does
+ * not need to be called with the scheduler suspended.
+ */
+void vHeapTraceReleaseOwner( unsigned portBASE_TYPE uxOwner ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_TRACE_H */
+
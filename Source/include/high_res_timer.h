@@ -0,0 +1,341 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A high resolution timer runs a callback at a given count of a free running
+ * hardware counter, using a compare channel of that counter, so one shot
+ * timing is not limited to the tick period and does not need the tick rate to
+ * be raised.  The callback is normally called from the compare interrupt
+ * itself, without first switching to the timer service task as the software
+ * timers in timers.c do.  It can instead be deferred to the timer service task
+ * when it has to call API functions that are not interrupt safe.
+ *
+ * Active timers are held in a queue sorted by deadline.  The compare channel
+ * is always set to the deadline at the head of the queue.  A timer is held in
+ * an xHighResTimer structure supplied by the application, so starting a timer
+ * allocates nothing and timers can be started from tasks and interrupts alike.
+ *
+ * The port, or the application in FreeRTOSConfig.h, provides the counter:
+ *
+ * portHIGH_RES_TIMER_GET_COUNT() returns the counter as an unsigned long
+ * that counts up and wraps at 2^32.  A narrower hardware counter has to be
+ * extended to 32 bits by the port.
+ *
+ * portHIGH_RES_TIMER_SET_COMPARE( ulCount ) sets the compare channel to
+ * match when the counter reaches ulCount, clears any match that is pending and
+ * enables the compare interrupt.
+ *
+ * portHIGH_RES_TIMER_DISABLE_COMPARE() disables the compare interrupt.
+ *
+ * portHIGH_RES_TIMER_INIT() starts the counter with the compare interrupt
+ * disabled.  Optional, it is called from vHighResTimerInit().
+ *
+ * portHIGH_RES_TIMER_MIN_COMPARE_DELTA is the fewest counts ahead of the
+ * counter a compare value can be set to and still be sure to match.  Defaults
+ * to 2.
+ *
+ * configHIGH_RES_TIMER_CLOCK_HZ is the frequency of the counter.
+ *
+ * The compare interrupt handler calls vHighResTimerCompareFromISR(), then
+ * requests a context switch if the function sets its parameter to pdTRUE.
+ * The interrupt must have a priority at which FreeRTOS API calls can be made.
+ * A deadline can be at most 2^31 - 1 counts after the time it is set.
+ */
+
+#ifndef HIGH_RES_TIMER_H
+#define HIGH_RES_TIMER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include high_res_timer.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Convert between microseconds and counts of the high resolution counter.
+ * The 64 bit calculation is avoided when the counter frequency is a whole
+ * number of MHz.
+ */
+#if ( ( configHIGH_RES_TIMER_CLOCK_HZ % 1000000UL ) == 0 )
+	#define hrtimerUS_TO_COUNTS( ulMicroseconds )	( ( unsigned long ) ( ulMicroseconds ) * ( unsigned long ) ( configHIGH_RES_TIMER_CLOCK_HZ / 1000000UL ) )
+	#define hrtimerCOUNTS_TO_US( ulCounts )			( ( unsigned long ) ( ulCounts ) / ( unsigned long ) ( configHIGH_RES_TIMER_CLOCK_HZ / 1000000UL ) )
+#else
+	#define hrtimerUS_TO_COUNTS( ulMicroseconds )	( ( unsigned long ) ( ( ( unsigned long long ) ( ulMicroseconds ) * ( unsigned long long ) configHIGH_RES_TIMER_CLOCK_HZ ) / 1000000ULL ) )
+	#define hrtimerCOUNTS_TO_US( ulCounts )			( ( unsigned long ) ( ( ( unsigned long long ) ( ulCounts ) * 1000000ULL ) / ( unsigned long long ) configHIGH_RES_TIMER_CLOCK_HZ ) )
+#endif
+
+struct xHIGH_RES_TIMER;
+
+/**
+ * The function called when a high resolution timer expires.
+ *
+ * pxHigherPriorityTaskWoken is to be passed to any FromISR API function the
+ * callback calls.  It is NULL when the callback has been deferred to the timer
+ * service task, in which case the callback runs in a task.
+ */
+typedef void ( *pdHIGH_RES_TIMER_CALLBACK )( struct xHIGH_RES_TIMER *pxTimer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * A high resolution timer.  Set pxCallback, pvParameter and xDeferred using
+ * vHighResTimerInitTimer().  pvParameter can be read by the callback, the
+ * other members are used by the timer service and must not be accessed by the
+ * application.
+ */
+typedef struct xHIGH_RES_TIMER
+{
+	pdHIGH_RES_TIMER_CALLBACK pxCallback;	/*< The function called when the timer expires. */
+	void *pvParameter;						/*< Free for use by the callback. */
+	portBASE_TYPE xDeferred;				/*< pdTRUE if the callback is called from the timer service task. */
+	unsigned long ulDeadline;				/*< The count at which the timer expires. */
+	struct xHIGH_RES_TIMER *pxNext;			/*< The active timer with the next later deadline. */
+	volatile portBASE_TYPE xActive;			/*< pdTRUE while the timer is in the queue of active timers. */
+} xHighResTimer;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerInit( void );
+ </pre>
+ *
+ * Starts the counter.  Must be called once, before any other high
+ * resolution timer function.
+ *
+ * \defgroup vHighResTimerInit vHighResTimerInit
+ * \ingroup HighResTimers
+ */
+void vHighResTimerInit( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerInitTimer( xHighResTimer *pxTimer, pdHIGH_RES_TIMER_CALLBACK pxCallback, void *pvParameter, portBASE_TYPE xDeferred );
+ </pre>
+ *
+ * Prepares a timer structure for use.  The timer is not active until it is
+ * started.  Must not be called on an active timer.
+ *
+ * @param pxCallback The function to call when the timer expires.
+ *
+ * @param pvParameter Stored in the timer for use by the callback.
+ *
+ * @param xDeferred pdFALSE to call the callback from the compare interrupt,
+ * pdTRUE to pend it to the timer service task.  A deferred callback starts
+ * later by the time taken to switch to the timer service task, and needs
+ * configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall set to 1.  Each deferred
+ * callback takes a place in the timer command queue until it has run.
+ *
+ * \defgroup vHighResTimerInitTimer vHighResTimerInitTimer
+ * \ingroup HighResTimers
+ */
+void vHighResTimerInitTimer( xHighResTimer *pxTimer, pdHIGH_RES_TIMER_CALLBACK pxCallback, void *pvParameter, portBASE_TYPE xDeferred ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerStartAt( xHighResTimer *pxTimer, unsigned long ulDeadline );
+ </pre>
+ *
+ * Starts a timer that expires when the counter reaches ulDeadline.  An
+ * active timer is restarted with the new deadline.  A deadline that has
+ * already passed expires as soon as the compare interrupt can be taken.  As
+ * the counter wraps, a deadline 2^31 counts or more after the current count
+ * is taken to have passed.
+ *
+ * A timer can be restarted from its own callback.  Adding the period to the
+ * timer's previous deadline, rather than to the current count, then gives a
+ * periodic timer that does not drift.
+ *
+ * Use vHighResTimerStartAt() from a task.  Use vHighResTimerStartAtFromISR()
+ * from an interrupt service routine or a callback called from the compare
+ * interrupt.
+ *
+ * \defgroup vHighResTimerStartAt vHighResTimerStartAt
+ * \ingroup HighResTimers
+ */
+void vHighResTimerStartAt( xHighResTimer *pxTimer, unsigned long ulDeadline ) PRIVILEGED_FUNCTION;
+void vHighResTimerStartAtFromISR( xHighResTimer *pxTimer, unsigned long ulDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerStart( xHighResTimer *pxTimer, unsigned long ulMicroseconds );
+ </pre>
+ *
+ * Starts a timer that expires ulMicroseconds from now.  See
+ * vHighResTimerStartAt().
+ *
+ * \defgroup vHighResTimerStart vHighResTimerStart
+ * \ingroup HighResTimers
+ */
+#define vHighResTimerStart( pxTimer, ulMicroseconds )			vHighResTimerStartAt( ( pxTimer ), ulHighResTimerGetCount() + hrtimerUS_TO_COUNTS( ulMicroseconds ) )
+#define vHighResTimerStartFromISR( pxTimer, ulMicroseconds )	vHighResTimerStartAtFromISR( ( pxTimer ), ulHighResTimerGetCount() + hrtimerUS_TO_COUNTS( ulMicroseconds ) )
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ portBASE_TYPE xHighResTimerStop( xHighResTimer *pxTimer );
+ </pre>
+ *
+ * Stops an active timer.  A deferred callback that has already been pended
+ * to the timer service task still runs.
+ *
+ * @return pdPASS if the timer was active, otherwise pdFAIL.
+ *
+ * \defgroup xHighResTimerStop xHighResTimerStop
+ * \ingroup HighResTimers
+ */
+portBASE_TYPE xHighResTimerStop( xHighResTimer *pxTimer ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xHighResTimerStopFromISR( xHighResTimer *pxTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ portBASE_TYPE xHighResTimerIsActive( xHighResTimer *pxTimer );
+ </pre>
+ *
+ * @return pdTRUE if the timer has been started and has not yet expired or
+ * been stopped.
+ *
+ * \defgroup xHighResTimerIsActive xHighResTimerIsActive
+ * \ingroup HighResTimers
+ */
+#define xHighResTimerIsActive( pxTimer )	( ( pxTimer )->xActive )
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ unsigned long ulHighResTimerGetCount( void );
+ </pre>
+ *
+ * @return The current value of the counter.  Can be called from a task or
+ * an interrupt.
+ *
+ * \defgroup ulHighResTimerGetCount ulHighResTimerGetCount
+ * \ingroup HighResTimers
+ */
+#define ulHighResTimerGetCount()	( ( unsigned long ) portHIGH_RES_TIMER_GET_COUNT() )
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerBusyWaitUs( unsigned long ulMicroseconds );
+ </pre>
+ *
+ * Spins on the counter for ulMicroseconds.  Other tasks only run if the
+ * calling task is preempted.
+ *
+ * \defgroup vHighResTimerBusyWaitUs vHighResTimerBusyWaitUs
+ * \ingroup HighResTimers
+ */
+void vHighResTimerBusyWaitUs( unsigned long ulMicroseconds ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerDelayUs( unsigned long ulMicroseconds );
+ </pre>
+ *
+ * Delays the calling task for ulMicroseconds.  The task is blocked on a high
+ * resolution timer until configHIGH_RES_TIMER_SPIN_LIMIT_US before the end of
+ * the delay, then spins for the rest of it, so it returns close to the end of
+ * the delay however long the context switch takes.  Delays no longer than
+ * configHIGH_RES_TIMER_SPIN_LIMIT_US are spun in full.
+ *
+ * The task is woken using its task notification, so a task that calls
+ * vHighResTimerDelayUs() should not use its notification for anything else.
+ * configUSE_TASK_NOTIFICATIONS must be set to 1.
+ *
+ * \defgroup vHighResTimerDelayUs vHighResTimerDelayUs
+ * \ingroup HighResTimers
+ */
+void vHighResTimerDelayUs( unsigned long ulMicroseconds ) PRIVILEGED_FUNCTION;
+
+/**
+ * high_res_timer.h
+ *
+ * <pre>
+ void vHighResTimerCompareFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Called by the compare interrupt handler.  Calls the callbacks of the
+ * timers that have expired, in deadline order, then sets the compare channel
+ * for the next deadline.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a callback woke a task
+ * with a priority above that of the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vHighResTimerCompareFromISR vHighResTimerCompareFromISR
+ * \ingroup HighResTimers
+ */
+void vHighResTimerCompareFromISR( signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HIGH_RES_TIMER_H */
@@ -0,0 +1,354 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A job pool is a fixed set of worker tasks that run jobs submitted to it by
+ * tasks and interrupts.  A job is a function and a parameter, held in an xJob
+ * structure supplied by the application, so submitting a job copies nothing
+ * and allocates nothing.  The structure remains owned by the pool from the
+ * time it is submitted until the job has run.
+ *
+ * Jobs are submitted either to the pool, at one of configJOB_POOL_PRIORITIES
+ * job priorities, or to the local queue of one particular worker.  A worker
+ * that is ready for a job takes the oldest job from its own local queue
+ * first, then the oldest job of the highest priority from the pool, and
+ * otherwise takes (steals) a job from the local queue of another worker - so
+ * a long job does not hold up the jobs queued behind it on the same worker
+ * while other workers are free.
+ *
+ * A task can wait for a job to complete using xJobPoolWait().  The waiting
+ * task is woken using its task notification, so a task that waits for jobs
+ * should not use its notification for anything else.
+ *
+ * Each worker can be given an arena, see xJobPoolCreateArenas().  The arena
+ * is reset before every job the worker runs, so a job can allocate scratch
+ * memory from it with pvArenaAlloc() and never has to free it.
+ *
+ * The pool keeps counts of the jobs completed and stolen and the most jobs
+ * that have been queued at once, see vJobPoolGetStats().  A pool cannot be
+ * deleted once it has been created.
+ */
+
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include job_pool.h"
+#endif
+
+#include "task.h"
+#include "arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which job pools are referenced.  For example, a call to
+ * xJobPoolCreate() returns an xJobPoolHandle variable that can then be used
+ * as a parameter to xJobPoolSubmit(), vJobPoolGetStats(), etc.
+ */
+typedef void * xJobPoolHandle;
+
+/**
+ * The function run by a job.
+ */
+typedef void ( *pdJOB_CODE )( void *pvParameters );
+
+/**
+ * A job.  Set pxJobCode and pvParameters using vJobPoolInitJob(), which also
+ * initialises the other members.  The other members are used by the pool and
+ * must not be accessed by the application.
+ */
+typedef struct xJOB
+{
+	pdJOB_CODE pxJobCode;					/*< The function run for the job. */
+	void *pvParameters;						/*< Passed to pxJobCode. */
+	struct xJOB *pxNextJob;					/*< The next job in the same queue. */
+	xTaskHandle xWaitingTask;				/*< The task waiting in xJobPoolWait(), if any. */
+	volatile portBASE_TYPE xJobState;		/*< Whether the job is complete, queued or running. */
+} xJob;
+
+/**
+ * Used with vJobPoolGetStats() to obtain the usage of a job pool.
+ */
+typedef struct xJOB_POOL_STATS
+{
+	unsigned portBASE_TYPE uxNumberOfWorkers;	/*< The number of worker tasks in the pool. */
+	unsigned portBASE_TYPE uxJobsQueued;		/*< The number of jobs currently queued and not yet started. */
+	unsigned portBASE_TYPE uxMaxJobsQueued;		/*< The most jobs there have been queued at once since the pool was created. */
+	unsigned long ulJobsCompleted;				/*< The number of jobs that have run to completion. */
+	unsigned long ulJobsStolen;					/*< The number of jobs a worker took from the local queue of another worker. */
+} xJobPoolStats;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ xJobPoolHandle xJobPoolCreate( const signed char * const pcName, unsigned portBASE_TYPE uxNumberOfWorkers, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority );
+ </pre>
+ *
+ * Creates a job pool and its worker tasks.  The workers block until jobs are
+ * submitted.
+ *
+ * @param pcName The name given to each of the worker tasks.
+ *
+ * @param uxNumberOfWorkers The number of worker tasks, which is the number of
+ * jobs the pool can run at the same time.
+ *
+ * @param usStackDepth The stack depth of each worker task, in words, as for
+ * xTaskCreate().  The stack must be large enough for the deepest job.
+ *
+ * @param uxPriority The priority of the worker tasks.
+ *
+ * @return If NULL is returned then the pool could not be created because
+ * there was insufficient heap memory for the pool or its first worker task.
+ * Any other value is the handle of the created pool.  If there was only
+ * enough memory for some of the workers the pool has fewer workers than
+ * uxNumberOfWorkers - see vJobPoolGetStats().
+ *
+ * \defgroup xJobPoolCreate xJobPoolCreate
+ * \ingroup JobPools
+ */
+xJobPoolHandle xJobPoolCreate( const signed char * const pcName, unsigned portBASE_TYPE uxNumberOfWorkers, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ void vJobPoolInitJob( xJob *pxJob, pdJOB_CODE pxJobCode, void *pvParameters );
+ </pre>
+ *
+ * Prepares a job structure for use.  The job is then complete, as far as
+ * xJobPoolWait() is concerned, until it is submitted.  Must not be called on
+ * a job that is queued or running.
+ *
+ * \defgroup vJobPoolInitJob vJobPoolInitJob
+ * \ingroup JobPools
+ */
+void vJobPoolInitJob( xJob *pxJob, pdJOB_CODE pxJobCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ portBASE_TYPE xJobPoolSubmit( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority );
+ </pre>
+ *
+ * Queues a job to be run by the first free worker.  Jobs of a higher job
+ * priority are started before jobs of a lower job priority, jobs of the same
+ * priority are started in the order they were submitted.  The function never
+ * blocks.
+ *
+ * Use xJobPoolSubmit() from a task.  Use xJobPoolSubmitFromISR() from an
+ * interrupt service routine.
+ *
+ * @param xJobPool The handle of the pool to run the job.
+ *
+ * @param pxJob The job, initialised by vJobPoolInitJob().  The job can be
+ * submitted again once it has completed.
+ *
+ * @param uxJobPriority The job priority, from 0 (lowest) to
+ * configJOB_POOL_PRIORITIES - 1.  Values above that are capped.
+ *
+ * @return pdPASS if the job was queued, or pdFAIL if the job was already
+ * queued or running.
+ *
+ * \defgroup xJobPoolSubmit xJobPoolSubmit
+ * \ingroup JobPools
+ */
+portBASE_TYPE xJobPoolSubmit( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ portBASE_TYPE xJobPoolSubmitFromISR( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xJobPoolSubmit() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if submitting the job woke a
+ * worker with a priority above that of the interrupted task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup xJobPoolSubmitFromISR xJobPoolSubmitFromISR
+ * \ingroup JobPools
+ */
+portBASE_TYPE xJobPoolSubmitFromISR( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ portBASE_TYPE xJobPoolSubmitToWorker( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxWorker );
+ </pre>
+ *
+ * Queues a job on the local queue of one worker - for example to keep jobs
+ * that work on the same data on one worker.  The worker runs its local jobs
+ * in the order they were submitted, before any job submitted to the pool.
+ * If another worker is free while uxWorker is busy, the free worker takes the
+ * job instead, so the jobs on a local queue are not guaranteed to run on
+ * uxWorker, or one at a time.
+ *
+ * @param uxWorker The worker, from 0 to the number of workers - 1.
+ *
+ * @return pdPASS if the job was queued, or pdFAIL if the job was already
+ * queued or running.
+ *
+ * \defgroup xJobPoolSubmitToWorker xJobPoolSubmitToWorker
+ * \ingroup JobPools
+ */
+portBASE_TYPE xJobPoolSubmitToWorker( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxWorker ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ portBASE_TYPE xJobPoolWait( xJob *pxJob, portTickType xTicksToWait );
+ </pre>
+ *
+ * Waits for a submitted job to complete.  Only one task can wait for any one
+ * job.  The job structure can be reused or freed as soon as this function
+ * returns pdPASS.  Must not be called from a job run by the same pool if every
+ * other worker could be waiting too, as the pool would then deadlock.
+ *
+ * @param pxJob The job being waited for.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait.  Setting
+ * xTicksToWait to 0 just checks whether the job has completed.
+ *
+ * @return pdPASS if the job has completed, or pdFAIL if it was still queued
+ * or running when xTicksToWait expired.
+ *
+ * \defgroup xJobPoolWait xJobPoolWait
+ * \ingroup JobPools
+ */
+portBASE_TYPE xJobPoolWait( xJob *pxJob, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ void vJobPoolGetStats( xJobPoolHandle xJobPool, xJobPoolStats *pxStats );
+ </pre>
+ *
+ * Obtains the number of workers, the number of jobs currently queued and the
+ * most that have ever been queued at once, and the number of jobs completed
+ * and stolen.  Can be called from a task or an interrupt.
+ *
+ * @param xJobPool The handle of the pool being queried.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vJobPoolGetStats vJobPoolGetStats
+ * \ingroup JobPools
+ */
+void vJobPoolGetStats( xJobPoolHandle xJobPool, xJobPoolStats *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ portBASE_TYPE xJobPoolCreateArenas( xJobPoolHandle xJobPool, size_t xArenaSizeBytes );
+ </pre>
+ *
+ * Gives each worker of the pool an arena of xArenaSizeBytes bytes, allocated
+ * from the FreeRTOS heap.  A worker resets its arena before running each job,
+ * so everything a job allocates from the arena is freed when the job ends.
+ * Call the function before submitting jobs that use xJobPoolGetArena().  The
+ * arenas, like the pool, are never freed.
+ *
+ * @param xJobPool The handle of the pool whose workers are given arenas.
+ *
+ * @param xArenaSizeBytes The size of each arena, including the structure used
+ * to manage it.
+ *
+ * @return pdPASS if every worker has an arena.  pdFAIL if the heap ran out -
+ * the workers that were given an arena keep it, and calling the function
+ * again only creates the arenas that are missing.
+ *
+ * \defgroup xJobPoolCreateArenas xJobPoolCreateArenas
+ * \ingroup JobPools
+ */
+portBASE_TYPE xJobPoolCreateArenas( xJobPoolHandle xJobPool, size_t xArenaSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ *
+ * <pre>
+ xArenaHandle xJobPoolGetArena( xJobPoolHandle xJobPool );
+ </pre>
+ *
+ * Returns the arena of the worker running the calling job.  Memory allocated
+ * from the arena with pvArenaAlloc() remains valid until the job returns.
+ * The arena must only be used by the job, not passed to another task.
+ *
+ * @param xJobPool The handle of the pool running the calling job.
+ *
+ * @return The arena of the calling worker, or NULL if the calling task is
+ * not a worker of xJobPool or xJobPoolCreateArenas() has not given it an
+ * arena.
+ *
+ * \defgroup xJobPoolGetArena xJobPoolGetArena
+ * \ingroup JobPools
+ */
+xArenaHandle xJobPoolGetArena( xJobPoolHandle xJobPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JOB_POOL_H */
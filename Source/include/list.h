@@ -91,7 +91,7 @@ extern "C" {
  */
 struct xLIST_ITEM
 {
-	portTickType xItemValue;				/*< The value being listed.  In most cases this is used to sort the list in descending order. */
+	portTickCountType xItemValue;			/*< The value being listed.  In most cases this is used to sort the list in descending order. */
 	volatile struct xLIST_ITEM * pxNext;	/*< Pointer to the next xListItem in the list. */
 	volatile struct xLIST_ITEM * pxPrevious;/*< Pointer to the previous xListItem in the list. */
 	void * pvOwner;							/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
@@ -101,7 +101,7 @@ typedef struct xLIST_ITEM xListItem;		/* For some reason lint wants this as two
 
 struct xMINI_LIST_ITEM
 {
-	portTickType xItemValue;
+	portTickCountType xItemValue;
 	volatile struct xLIST_ITEM *pxNext;
 	volatile struct xLIST_ITEM *pxPrevious;
 };
@@ -117,6 +117,20 @@ typedef struct xLIST
 	volatile xMiniListItem xListEnd;		/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
 } xList;
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+	/*
+	 * A list split into a FIFO list per priority.  xBuckets must remain the
+	 * first member, as the structure is found from one of its buckets.
+	 */
+	typedef struct xPRIORITY_LIST
+	{
+		xList xBuckets[ configMAX_PRIORITIES ];
+		volatile unsigned portBASE_TYPE uxPriorities;	/*< Either the highest priority that may have items, or a bitmap of such priorities when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1. */
+	} xPriorityList;
+
+#endif
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -126,6 +140,15 @@ typedef struct xLIST
  */
 #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )		( pxListItem )->pvOwner = ( void * ) ( pxOwner )
 
+/*
+ * Access macro to get the owner of a list item.  The owner of a list item
+ * is the object (usually a TCB) that contains the list item.
+ *
+ * \page listGET_LIST_ITEM_OWNER listGET_LIST_ITEM_OWNER
+ * \ingroup LinkedList
+ */
+#define listGET_LIST_ITEM_OWNER( pxListItem )				( ( pxListItem )->pvOwner )
+
 /*
  * Access macro to set the value of the list item.  In most cases the value is
  * used to sort the list in descending order.
@@ -265,7 +288,7 @@ void vListInitialiseItem( xListItem *pxItem );
  * \page vListInsert vListInsert
  * \ingroup LinkedList
  */
-void vListInsert( xList *pxList, xListItem *pxNewListItem );
+void vListInsert( xList *pxList, xListItem *pxNewListItem ) KERNEL_FAST_FUNCTION;
 
 /*
  * Insert a list item into a list.  The item will be inserted in a position
@@ -286,19 +309,77 @@ void vListInsert( xList *pxList, xListItem *pxNewListItem );
  * \page vListInsertEnd vListInsertEnd
  * \ingroup LinkedList
  */
-void vListInsertEnd( xList *pxList, xListItem *pxNewListItem );
+void vListInsertEnd( xList *pxList, xListItem *pxNewListItem ) KERNEL_FAST_FUNCTION;
 
 /*
  * Remove an item from a list.  The list item has a pointer to the list that
  * it is in, so only the list item need be passed into the function.
  *
- * @param vListRemove The item to be removed.  The item will remove itself from
+ * @param uxListRemove The item to be removed.  The item will remove itself from
  * the list pointed to by it's pxContainer parameter.
  *
- * \page vListRemove vListRemove
+ * @return The number of items that remain in the list after the list item has
+ * been removed.
+ *
+ * \page uxListRemove uxListRemove
  * \ingroup LinkedList
  */
-void vListRemove( xListItem *pxItemToRemove );
+unsigned portBASE_TYPE uxListRemove( xListItem *pxItemToRemove ) KERNEL_FAST_FUNCTION;
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+	/*
+	 * Must be called before a priority list is used.  The list end marker of
+	 * each bucket holds the priority of the bucket, in place of the maximum
+	 * item value, so vListInsert() must never be used on a bucket.
+	 *
+	 * @param pxList Pointer to the priority list being initialised.
+	 *
+	 * \page vListInitialisePriorityList vListInitialisePriorityList
+	 * \ingroup LinkedList
+	 */
+	void vListInitialisePriorityList( xPriorityList *pxList );
+
+	/*
+	 * Insert a list item at the end of the bucket for uxPriority, so it is the
+	 * last of the items with that priority to be returned by
+	 * pxListGetHighestPriorityBucket().  This takes the same time however many
+	 * items the list holds.  The item can later be removed with
+	 * uxListRemove() in the normal way.
+	 *
+	 * @param pxList The priority list into which the item is to be inserted.
+	 *
+	 * @param pxNewListItem The list item to be inserted into the list.
+	 *
+	 * @param uxPriority The priority of the item.
+	 *
+	 * \page vListInsertPriority vListInsertPriority
+	 * \ingroup LinkedList
+	 */
+	void vListInsertPriority( xPriorityList *pxList, xListItem *pxNewListItem, unsigned portBASE_TYPE uxPriority ) KERNEL_FAST_FUNCTION;
+
+	/*
+	 * Move an item that is in a priority list to the end of the bucket for
+	 * uxNewPriority within the same priority list.
+	 *
+	 * \page vListMovePriority vListMovePriority
+	 * \ingroup LinkedList
+	 */
+	void vListMovePriority( xListItem *pxListItem, unsigned portBASE_TYPE uxNewPriority );
+
+	/*
+	 * Returns the bucket of the highest priority that holds items, or NULL if
+	 * the priority list is empty.  The item at the head of the returned bucket
+	 * is the one that has been in the list the longest at that priority.
+	 * Priorities found to be empty are forgotten, which is why the list
+	 * cannot be const.
+	 *
+	 * \page pxListGetHighestPriorityBucket pxListGetHighestPriorityBucket
+	 * \ingroup LinkedList
+	 */
+	xList *pxListGetHighestPriorityBucket( xPriorityList *pxList ) KERNEL_FAST_FUNCTION;
+
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,227 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A memory pool manages a caller supplied region of memory that is divided
+ * into a number of equally sized blocks.  Unused blocks are held in a singly
+ * linked free list that is threaded through the blocks themselves, so
+ * allocating and freeing a block is a constant time operation that does not
+ * depend on the number of blocks in the pool, does not fragment, and never
+ * touches the FreeRTOS heap.  Separate interrupt safe versions of the
+ * allocation and free functions are provided so blocks can be passed between
+ * tasks and interrupts - for example to implement a pool of DMA buffers.
+ *
+ * Only the small structure used to manage the pool is obtained from the
+ * FreeRTOS heap, when the pool is created.  The region that is divided into
+ * blocks is supplied by the application, so it can be placed in any memory
+ * (a dedicated peripheral RAM bank, for example).
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include memory_pool.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemoryPoolCreate() returns an xMemoryPoolHandle variable that can then be
+ * used as a parameter to pvMemoryPoolAlloc(), vMemoryPoolFree(), etc.
+ */
+typedef void * xMemoryPoolHandle;
+
+/**
+ * Used with vMemoryPoolGetStats() to obtain the usage of a memory pool.
+ */
+typedef struct xMEMORY_POOL_STATS
+{
+	size_t xBlockSize;								/*< The size of each block in bytes, after rounding up to the port's byte alignment. */
+	unsigned portBASE_TYPE uxNumberOfBlocks;		/*< The total number of blocks the pool region was divided into. */
+	unsigned portBASE_TYPE uxNumberOfFreeBlocks;	/*< The number of blocks that are currently free. */
+	unsigned portBASE_TYPE uxMinimumEverFreeBlocks;	/*< The lowest number of free blocks there has been since the pool was created - the high water mark of the pool. */
+} xMemoryPoolStats;
+
+/**
+ * memory_pool.h
+ *
+ * <pre>
+ xMemoryPoolHandle xMemoryPoolCreate( void *pvPoolBuffer, size_t xPoolBufferSizeBytes, size_t xBlockSizeBytes );
+ </pre>
+ *
+ * Creates a new memory pool by dividing the region of memory pointed to by
+ * pvPoolBuffer into as many blocks of xBlockSizeBytes bytes as will fit.
+ *
+ * @param pvPoolBuffer The start of the region to divide into blocks.  The
+ * region must remain valid for as long as the pool is in use and must not be
+ * accessed directly by the application.  If pvPoolBuffer is not aligned to
+ * portBYTE_ALIGNMENT then the first few bytes of the region are not used.
+ *
+ * @param xPoolBufferSizeBytes The size of the region pointed to by
+ * pvPoolBuffer in bytes.
+ *
+ * @param xBlockSizeBytes The size of each block.  The size is rounded up so
+ * every block is aligned to portBYTE_ALIGNMENT and can hold a pointer.
+ *
+ * @return If NULL is returned then the pool could not be created, either
+ * because there was insufficient heap memory to allocate the structure used
+ * to manage the pool or because the region is too small to hold even a single
+ * block.  Any other value is the handle of the created pool.
+ *
+ * \defgroup xMemoryPoolCreate xMemoryPoolCreate
+ * \ingroup MemoryPoolManagement
+ */
+xMemoryPoolHandle xMemoryPoolCreate( void *pvPoolBuffer, size_t xPoolBufferSizeBytes, size_t xBlockSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *
+ * <pre>
+ void *pvMemoryPoolAlloc( xMemoryPoolHandle xMemoryPool );
+ </pre>
+ *
+ * Removes a block from the memory pool's free list.  The function never
+ * blocks - if the pool is empty it returns NULL immediately.
+ *
+ * Use pvMemoryPoolAlloc() from a task.  Use pvMemoryPoolAllocFromISR() from an
+ * interrupt service routine.
+ *
+ * @param xMemoryPool The handle of the pool from which a block is allocated.
+ *
+ * @return A pointer to the allocated block, or NULL if every block in the pool
+ * is already in use.
+ *
+ * \defgroup pvMemoryPoolAlloc pvMemoryPoolAlloc
+ * \ingroup MemoryPoolManagement
+ */
+void *pvMemoryPoolAlloc( xMemoryPoolHandle xMemoryPool ) PRIVILEGED_FUNCTION;
+void *pvMemoryPoolAllocFromISR( xMemoryPoolHandle xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *
+ * <pre>
+ void vMemoryPoolFree( xMemoryPoolHandle xMemoryPool, void *pvBlock );
+ </pre>
+ *
+ * Returns a block to the memory pool from which it was allocated.  A block
+ * allocated from a task can be freed from an interrupt, and vice versa.
+ *
+ * Use vMemoryPoolFree() from a task.  Use vMemoryPoolFreeFromISR() from an
+ * interrupt service routine.
+ *
+ * @param xMemoryPool The handle of the pool to which the block is returned.
+ *
+ * @param pvBlock The block being freed, as returned by pvMemoryPoolAlloc() or
+ * pvMemoryPoolAllocFromISR().  Passing NULL has no effect.  Freeing a block
+ * that was not allocated from xMemoryPool, or freeing the same block twice,
+ * will corrupt the pool - configASSERT() catches these errors where it can.
+ *
+ * \defgroup vMemoryPoolFree vMemoryPoolFree
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolFree( xMemoryPoolHandle xMemoryPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+void vMemoryPoolFreeFromISR( xMemoryPoolHandle xMemoryPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *
+ * <pre>
+ void vMemoryPoolGetStats( xMemoryPoolHandle xMemoryPool, xMemoryPoolStats *pxStats );
+ </pre>
+ *
+ * Obtains the block size, the number of blocks, the number of blocks that are
+ * currently free, and the lowest number of blocks that have ever been free.
+ * The last value can be used to size the pool - a pool that never drops below
+ * a few free blocks has more blocks than the application needs.  Can be
+ * called from a task or an interrupt.
+ *
+ * @param xMemoryPool The handle of the pool being queried.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vMemoryPoolGetStats vMemoryPoolGetStats
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolGetStats( xMemoryPoolHandle xMemoryPool, xMemoryPoolStats *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *
+ * <pre>
+ void vMemoryPoolDelete( xMemoryPoolHandle xMemoryPool );
+ </pre>
+ *
+ * Frees the structure used to manage the pool.  The region of memory that was
+ * divided into blocks belongs to the application and is not freed.  Blocks
+ * that are still allocated must not be used after the pool has been deleted.
+ *
+ * @param xMemoryPool The handle of the pool being deleted.
+ *
+ * \defgroup vMemoryPoolDelete vMemoryPoolDelete
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolDelete( xMemoryPoolHandle xMemoryPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMORY_POOL_H */
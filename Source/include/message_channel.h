@@ -0,0 +1,233 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A message channel passes requests from client tasks to server tasks
+ * synchronously, in the style of send/receive/reply message passing.  A client
+ * sends a message and blocks until a server has replied to it.  The server
+ * receives the message by reference - nothing is copied - and replies
+ * directly to the client that sent it, which is unblocked by the reply.  A
+ * request and its reply take one kernel call each for the client and the
+ * server, and no more than two context switches.
+ *
+ * A server runs each message at the priority of the client that sent it.
+ * While a server holds a message it inherits the priority of the sending
+ * client, and if higher priority clients are waiting for a busy server then
+ * the server is raised to their priority too, exactly as a mutex holder is
+ * raised by the tasks waiting for the mutex.  The inherited priority is
+ * dropped when the server replies.  Pending messages are received in priority
+ * order, then in the order they were sent.
+ *
+ * Any number of clients and servers can use the same channel.
+ * configUSE_MUTEXES and INCLUDE_uxTaskPriorityGet must be set to 1 in
+ * FreeRTOSConfig.h to use message channels, and Source/message_channel.c
+ * added to the build.  Message channels cannot be used from interrupts.
+ */
+
+#ifndef MESSAGE_CHANNEL_H
+#define MESSAGE_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include message_channel.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which message channels are referenced.  For example, a call to
+ * xMessageChannelCreate() returns an xMessageChannelHandle variable that can
+ * then be used as a parameter to xMessageChannelSend(),
+ * xMessageChannelReceive(), etc.
+ */
+typedef void * xMessageChannelHandle;
+
+/**
+ * Type by which a received message is referenced.  xMessageChannelReceive()
+ * returns one for each message it receives, which is then passed to
+ * xMessageChannelReply() to reply to the client that sent the message.
+ */
+typedef void * xMessageHandle;
+
+/**
+ * message_channel.h
+ *
+ * <pre>
+ xMessageChannelHandle xMessageChannelCreate( void );
+ </pre>
+ *
+ * Creates a new message channel.
+ *
+ * @return If NULL is returned then the channel could not be created because
+ * there was insufficient heap memory available.  Any other value is the
+ * handle of the created channel.
+ *
+ * \defgroup xMessageChannelCreate xMessageChannelCreate
+ * \ingroup MessageChannels
+ */
+xMessageChannelHandle xMessageChannelCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_channel.h
+ *
+ * <pre>
+ portBASE_TYPE xMessageChannelSend( xMessageChannelHandle xChannel, void *pvMessage, void **ppvReply, portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends a message to a server and waits for the reply.  The server is passed
+ * pvMessage itself, so it can read the request from, and write a result
+ * into, the memory pvMessage points to.
+ *
+ * The block time only applies until a server receives the message.  Once a
+ * server holds the message the calling task waits for the reply however long
+ * it takes, as the server is using memory that belongs to the calling task.
+ * Setting xTicksToWait to 0 causes the function to fail straight away unless a
+ * server is already waiting in xMessageChannelReceive(), in which case the
+ * calling task waits for the reply.
+ *
+ * @param xChannel The handle of the channel to send on.
+ *
+ * @param pvMessage The message passed to the server.
+ *
+ * @param ppvReply Set to the value the server passed to
+ * xMessageChannelReply().  Can be NULL if the reply value is not needed.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for a server to
+ * receive the message.
+ *
+ * @return pdPASS if the server replied, or pdFAIL if no server received the
+ * message within the block time.
+ *
+ * \defgroup xMessageChannelSend xMessageChannelSend
+ * \ingroup MessageChannels
+ */
+portBASE_TYPE xMessageChannelSend( xMessageChannelHandle xChannel, void *pvMessage, void **ppvReply, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_channel.h
+ *
+ * <pre>
+ portBASE_TYPE xMessageChannelReceive( xMessageChannelHandle xChannel, xMessageHandle *pxMessage, void **ppvMessage, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives the highest priority pending message, waiting for one to be sent
+ * if there are none.  The calling task inherits the priority of the client
+ * that sent the message, and must reply to it with xMessageChannelReply().
+ * A server can hold more than one message at a time, but keeps the highest
+ * priority it has inherited until it has replied to all of them.
+ *
+ * @param xChannel The handle of the channel to receive from.
+ *
+ * @param pxMessage Set to the handle of the received message, needed to reply
+ * to it.
+ *
+ * @param ppvMessage Set to the pvMessage parameter the client passed to
+ * xMessageChannelSend().
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for a message.
+ * Setting xTicksToWait to 0 causes the function to return immediately if no
+ * message is pending.
+ *
+ * @return pdPASS if a message was received, otherwise pdFAIL.
+ *
+ * \defgroup xMessageChannelReceive xMessageChannelReceive
+ * \ingroup MessageChannels
+ */
+portBASE_TYPE xMessageChannelReceive( xMessageChannelHandle xChannel, xMessageHandle *pxMessage, void **ppvMessage, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_channel.h
+ *
+ * <pre>
+ void vMessageChannelReply( xMessageHandle xMessage, void *pvReply );
+ </pre>
+ *
+ * Replies to a received message, unblocking the client that sent it and
+ * dropping any priority the calling task inherited through the message.  The
+ * server must not access the message after replying to it.  Only the task
+ * that received the message can reply to it.
+ *
+ * @param xMessage The handle returned by xMessageChannelReceive().
+ *
+ * @param pvReply The value returned to the client through the ppvReply
+ * parameter of xMessageChannelSend().
+ *
+ * \defgroup vMessageChannelReply vMessageChannelReply
+ * \ingroup MessageChannels
+ */
+void vMessageChannelReply( xMessageHandle xMessage, void *pvReply ) PRIVILEGED_FUNCTION;
+
+/**
+ * message_channel.h
+ *
+ * <pre>
+ void vMessageChannelDelete( xMessageChannelHandle xChannel );
+ </pre>
+ *
+ * Deletes a message channel.  No message may be pending or held by a server,
+ * and no server may be waiting to receive, when the channel is deleted.
+ *
+ * @param xChannel The handle of the channel being deleted.
+ *
+ * \defgroup vMessageChannelDelete vMessageChannelDelete
+ * \ingroup MessageChannels
+ */
+void vMessageChannelDelete( xMessageChannelHandle xChannel ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MESSAGE_CHANNEL_H */
+
@@ -67,6 +67,10 @@ only for ports that are using the MPU. */
 		#define vTaskAllocateMPURegions			MPU_vTaskAllocateMPURegions
 		#define vTaskDelete						MPU_vTaskDelete
 		#define vTaskDelayUntil					MPU_vTaskDelayUntil
+		#define vTaskSetDeadline				MPU_vTaskSetDeadline
+		#define vTaskSetBudget					MPU_vTaskSetBudget
+		#define vTaskPreemptionThresholdSet		MPU_vTaskPreemptionThresholdSet
+		#define uxTaskPreemptionThresholdGet	MPU_uxTaskPreemptionThresholdGet
 		#define vTaskDelay						MPU_vTaskDelay
 		#define uxTaskPriorityGet				MPU_uxTaskPriorityGet
 		#define vTaskPrioritySet				MPU_vTaskPrioritySet
@@ -76,29 +80,58 @@ only for ports that are using the MPU. */
 		#define vTaskSuspendAll					MPU_vTaskSuspendAll
 		#define xTaskResumeAll					MPU_xTaskResumeAll
 		#define xTaskGetTickCount				MPU_xTaskGetTickCount
+		#define xTaskGetTickCount64				MPU_xTaskGetTickCount64
 		#define uxTaskGetNumberOfTasks			MPU_uxTaskGetNumberOfTasks
 		#define vTaskList						MPU_vTaskList
 		#define vTaskGetRunTimeStats			MPU_vTaskGetRunTimeStats
+		#define uxTaskGetSystemState			MPU_uxTaskGetSystemState
 		#define vTaskStartTrace					MPU_vTaskStartTrace
 		#define ulTaskEndTrace					MPU_ulTaskEndTrace
 		#define vTaskSetApplicationTaskTag		MPU_vTaskSetApplicationTaskTag
 		#define xTaskGetApplicationTaskTag		MPU_xTaskGetApplicationTaskTag
+		#define vTaskSetThreadLocalStoragePointer	MPU_vTaskSetThreadLocalStoragePointer
+		#define pvTaskGetThreadLocalStoragePointer	MPU_pvTaskGetThreadLocalStoragePointer
 		#define xTaskCallApplicationTaskHook	MPU_xTaskCallApplicationTaskHook
 		#define uxTaskGetStackHighWaterMark		MPU_uxTaskGetStackHighWaterMark
+		#define uxTaskGetSampledStackHighWaterMark	MPU_uxTaskGetSampledStackHighWaterMark
+		#define ulTaskGetMaxCriticalSectionTime	MPU_ulTaskGetMaxCriticalSectionTime
+		#define vTaskResetMaxCriticalSectionTime	MPU_vTaskResetMaxCriticalSectionTime
 		#define xTaskGetCurrentTaskHandle		MPU_xTaskGetCurrentTaskHandle
 		#define xTaskGetSchedulerState			MPU_xTaskGetSchedulerState
+		#define xTaskGenericNotify				MPU_xTaskGenericNotify
+		#define xTaskNotifyWait					MPU_xTaskNotifyWait
+		#define ulTaskNotifyTake				MPU_ulTaskNotifyTake
+		#define xTaskNotifyStateClear			MPU_xTaskNotifyStateClear
 
 		#define xQueueGenericCreate				MPU_xQueueGenericCreate
 		#define xQueueCreateMutex				MPU_xQueueCreateMutex
 		#define xQueueGiveMutexRecursive		MPU_xQueueGiveMutexRecursive
 		#define xQueueTakeMutexRecursive		MPU_xQueueTakeMutexRecursive
 		#define xQueueCreateCountingSemaphore	MPU_xQueueCreateCountingSemaphore
+		#define xQueueSemaphoreGiveMultiple		MPU_xQueueSemaphoreGiveMultiple
+		#define xQueueSemaphoreTakeMultiple		MPU_xQueueSemaphoreTakeMultiple
 		#define xQueueGenericSend				MPU_xQueueGenericSend
 		#define xQueueAltGenericSend			MPU_xQueueAltGenericSend
 		#define xQueueAltGenericReceive			MPU_xQueueAltGenericReceive
 		#define xQueueGenericReceive			MPU_xQueueGenericReceive
+		#define xQueueGenericSendUntil			MPU_xQueueGenericSendUntil
+		#define xQueueGenericReceiveUntil		MPU_xQueueGenericReceiveUntil
+		#define xQueueTakeMutexRecursiveUntil	MPU_xQueueTakeMutexRecursiveUntil
+		#define uxQueueSendMultiple				MPU_uxQueueSendMultiple
+		#define uxQueueReceiveMultiple			MPU_uxQueueReceiveMultiple
+		#define pvQueueReserveSlot				MPU_pvQueueReserveSlot
+		#define vQueueCommitSlot				MPU_vQueueCommitSlot
+		#define pvQueueBorrowSlot				MPU_pvQueueBorrowSlot
+		#define vQueueReleaseSlot				MPU_vQueueReleaseSlot
 		#define uxQueueMessagesWaiting			MPU_uxQueueMessagesWaiting
+		#define uxQueueSpacesAvailable			MPU_uxQueueSpacesAvailable
+		#define vQueueGetInfo					MPU_vQueueGetInfo
 		#define vQueueDelete					MPU_vQueueDelete
+		#define vQueueCacheFlush				MPU_vQueueCacheFlush
+		#define xQueueCreateSet					MPU_xQueueCreateSet
+		#define xQueueAddToSet					MPU_xQueueAddToSet
+		#define xQueueRemoveFromSet				MPU_xQueueRemoveFromSet
+		#define xQueueSelectFromSet				MPU_xQueueSelectFromSet
 
 		#define pvPortMalloc					MPU_pvPortMalloc
 		#define vPortFree						MPU_vPortFree
@@ -108,6 +141,14 @@ only for ports that are using the MPU. */
 		#if configQUEUE_REGISTRY_SIZE > 0
 			#define vQueueAddToRegistry				MPU_vQueueAddToRegistry
 			#define vQueueUnregisterQueue			MPU_vQueueUnregisterQueue
+			#define uxQueueGetSystemState			MPU_uxQueueGetSystemState
+		#elif configUSE_NAME_REGISTRY == 1
+			#define vQueueAddToRegistry				MPU_vQueueAddToRegistry
+		#endif
+
+		#if configUSE_NAME_REGISTRY == 1
+			#define pvNameRegistryFind				MPU_pvNameRegistryFind
+			#define uxNameRegistryGetFailedAdds		MPU_uxNameRegistryGetFailedAdds
 		#endif
 
 		/* Remove the privileged function macro. */
@@ -0,0 +1,218 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The name registry finds tasks, queues (including semaphores and mutexes)
+ * and software timers by name, so command line interfaces, diagnostic agents
+ * and remote procedure call layers can resolve the names they are given
+ * without walking the kernel's lists.  Names are held in a hash table of
+ * configNAME_REGISTRY_SIZE entries, so a lookup takes the same time however
+ * many objects exist, and lookups neither suspend the scheduler nor mask
+ * interrupts.
+ *
+ * The registry is included in the build by setting configUSE_NAME_REGISTRY to
+ * 1 in FreeRTOSConfig.h and adding Source/name_registry.c to the project.
+ * Objects are then added and removed by the kernel itself:
+ *
+ * + Tasks are added when they are created and removed when vTaskDelete() is
+ *   called, under the name given to xTaskCreate().  Tasks can only be added
+ *   when configUSE_TASK_NAMES is 1.
+ * + Timers are added when they are created and removed when xTimerDelete()
+ *   is called, unless they were created with a NULL name.
+ * + Queues, semaphores and mutexes have no name when they are created, so are
+ *   added when vQueueAddToRegistry() is called and removed when they are
+ *   deleted.  vQueueAddToRegistry() is available whenever the name registry
+ *   is included, even if configQUEUE_REGISTRY_SIZE is 0.
+ *
+ * Names are compared up to their first ( configMAX_TASK_NAME_LEN - 1 )
+ * characters, the length a task name is truncated to, so longer names must
+ * differ within that length to be told apart.  Tasks, queues and timers have
+ * separate names, so a task and a queue can share a name.  If two objects of
+ * the same kind share a name then a lookup returns one of them.  The registry
+ * holds a pointer to each name rather than a copy, so the names of queues
+ * and timers must remain valid while they are registered (task names are
+ * copied into the TCB when the task is created).
+ *
+ * configNAME_REGISTRY_SIZE must be a power of 2, and should be comfortably
+ * larger than the number of objects registered - lookups slow down as the
+ * table fills.  An object that is created once the table is full is simply
+ * not registered, which is counted by uxNameRegistryGetFailedAdds().
+ *
+ * Adding and removing names suspends the scheduler.  Lookups are lock free:
+ * they read the table directly and check a sequence count that is changed
+ * around every update, repeating the lookup if the table changed while it
+ * was being read.  As a handle obtained by name is not protected against the
+ * object being deleted, the application must ensure an object it looks up is
+ * not deleted while it is still being used, as with any other handle.
+ */
+
+#ifndef NAME_REGISTRY_H
+#define NAME_REGISTRY_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include name_registry.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The kinds of object held in the registry. */
+#define nameregTYPE_TASK				( ( unsigned char ) 1U )
+#define nameregTYPE_QUEUE				( ( unsigned char ) 2U )
+#define nameregTYPE_TIMER				( ( unsigned char ) 3U )
+
+/**
+ * name_registry.h
+ *
+ * <pre>
+ void *pvNameRegistryFind( const signed char *pcName, unsigned char ucType );
+ </pre>
+ *
+ * Finds an object by name.  Must not be called from an interrupt - use
+ * pvNameRegistryFindFromISR() instead.
+ *
+ * @param pcName The name of the object to find.
+ *
+ * @param ucType The kind of object to find, nameregTYPE_TASK,
+ * nameregTYPE_QUEUE or nameregTYPE_TIMER.
+ *
+ * @return The handle of the object, or NULL if no object of that kind is
+ * registered under the name.  xNameRegistryFindTask(), xNameRegistryFindQueue()
+ * and xNameRegistryFindTimer() return the handle with the right type.
+ *
+ * Example usage:
+   <pre>
+ // Called by a command line interface to suspend a task given its name.
+ portBASE_TYPE xSuspendByName( const signed char *pcName )
+ {
+ xTaskHandle xTask;
+
+	xTask = xNameRegistryFindTask( pcName );
+	if( xTask != NULL )
+	{
+		vTaskSuspend( xTask );
+		return pdPASS;
+	}
+
+	return pdFAIL;
+ }
+   </pre>
+ *
+ * \defgroup pvNameRegistryFind pvNameRegistryFind
+ * \ingroup NameRegistry
+ */
+void *pvNameRegistryFind( const signed char *pcName, unsigned char ucType ) PRIVILEGED_FUNCTION;
+
+#define xNameRegistryFindTask( pcName )		( ( xTaskHandle ) pvNameRegistryFind( ( pcName ), nameregTYPE_TASK ) )
+#define xNameRegistryFindQueue( pcName )	( ( xQueueHandle ) pvNameRegistryFind( ( pcName ), nameregTYPE_QUEUE ) )
+#define xNameRegistryFindTimer( pcName )	( ( xTimerHandle ) pvNameRegistryFind( ( pcName ), nameregTYPE_TIMER ) )
+
+/**
+ * name_registry.h
+ *
+ * <pre>
+ void *pvNameRegistryFindFromISR( const signed char *pcName, unsigned char ucType );
+ </pre>
+ *
+ * A version of pvNameRegistryFind() that can be called from an interrupt.
+ * The interrupt may have interrupted an update of the registry, which cannot
+ * complete until the interrupt returns, so rather than repeating the lookup
+ * NULL is returned if the table changed while it was being read.
+ *
+ * \defgroup pvNameRegistryFindFromISR pvNameRegistryFindFromISR
+ * \ingroup NameRegistry
+ */
+void *pvNameRegistryFindFromISR( const signed char *pcName, unsigned char ucType ) PRIVILEGED_FUNCTION;
+
+/**
+ * name_registry.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxNameRegistryGetFailedAdds( void );
+ </pre>
+ *
+ * @return The number of objects that were not registered because the table
+ * was full.  If this is not zero configNAME_REGISTRY_SIZE should be
+ * increased.
+ *
+ * \defgroup uxNameRegistryGetFailedAdds uxNameRegistryGetFailedAdds
+ * \ingroup NameRegistry
+ */
+unsigned portBASE_TYPE uxNameRegistryGetFailedAdds( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FUNCTIONS BELOW ARE FOR USE BY THE KERNEL ONLY.  They must not be
+ * called from an interrupt.
+ */
+
+/*
+ * Registers the object pvHandle under the name pcName.  Returns pdFAIL if the
+ * table is full.
+ */
+portBASE_TYPE xNameRegistryAdd( const signed char *pcName, void *pvHandle, unsigned char ucType ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes every entry for the object pvHandle.  If pcName is not NULL it is
+ * the name the object was registered under, which saves searching the whole
+ * table.
+ */
+void vNameRegistryRemove( const signed char *pcName, void *pvHandle ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NAME_REGISTRY_H */
+
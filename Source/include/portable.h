@@ -349,6 +349,28 @@ extern "C" {
 	portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters );
 #endif
 
+/* Used by heap_5.c to describe one block of memory that forms part of the
+heap.  The array passed to vPortDefineHeapRegions() is terminated by an entry
+that has a NULL start address and a size of zero. */
+typedef struct HeapRegion
+{
+	unsigned char *pucStartAddress;
+	size_t xSizeInBytes;
+} xHeapRegion;
+
+/*
+ * Used to define multiple heap regions for use by heap_5.c.  This function
+ * must be called before any calls to pvPortMalloc() - noting that creating a task,
+ * queue, semaphore, mutex, software timer, event group, etc. will result in
+ * pvPortMalloc being called.
+ *
+ * pxHeapRegions passes in an array of xHeapRegion structures - each of which
+ * defines a region of memory that can be used as the heap.  The array is
+ * terminated by an xHeapRegion structure that has a size of 0.  The region
+ * with the lowest start address must appear first in the array.
+ */
+void vPortDefineHeapRegions( const xHeapRegion * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -357,6 +379,37 @@ void vPortFree( void *pv ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * The lowest value xPortGetFreeHeapSize() has returned since the heap was
+ * initialised.  Only implemented by the memory management schemes that track
+ * it (heap_4.c and heap_5.c).
+ */
+size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The size of the largest free block, including the space its block header
+ * will take up, so the largest single allocation that can succeed is a little
+ * smaller.  Comparing the value with xPortGetFreeHeapSize() shows how
+ * fragmented the heap is.  Not implemented by heap_3.c, which cannot see into
+ * the C library heap.
+ */
+size_t xPortGetLargestFreeBlockSize( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel when a task is deleted to return the blocks held in the
+ * task's allocation cache to the C library.  Only implemented by heap_3.c, and
+ * only when configUSE_HEAP_TASK_CACHES is set to 1.
+ */
+void vPortFreeTaskHeapCache( void *pvCache ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates the TCB or stack of a task from the heap region reserved by
+ * configTASK_MEMORY_HEAP_REGION.  Memory it returns is freed with vPortFree().
+ * Only implemented by heap_5.c, and only used when
+ * configTASK_MEMORY_HEAP_REGION is not negative.
+ */
+void *pvPortMallocTaskMemory( size_t xSize ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -0,0 +1,315 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * A priority queue passes items between tasks, and from interrupts to tasks,
+ * like a normal queue, but every item is sent with a priority and the
+ * receiver always gets the highest priority item held.  Items sent with the
+ * same priority are received in the order they were sent.  Urgent messages
+ * therefore overtake bulk messages that are already waiting, without the
+ * cost of a second queue and a queue set.
+ *
+ * The queue is an in-place binary heap.  Each item is copied into the queue
+ * once when it is sent and once when it is received, and only the small
+ * entry that records its priority, its position in the send order and the
+ * slot holding it is moved while the heap is reordered.  Sending and
+ * receiving both take O( log n ) time, where n is the number of items held,
+ * and reading the priority of the next item takes O( 1 ) time.
+ *
+ * Senders block while the queue is full, and receivers block while it is
+ * empty, in task priority order, as with a normal queue.
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include priority_queue.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which priority queues are referenced.  For example, a call to
+ * xPriorityQueueCreate() returns an xPriorityQueueHandle variable that can
+ * then be used as a parameter to xPriorityQueueSend(),
+ * xPriorityQueueReceive(), etc.
+ */
+typedef void * xPriorityQueueHandle;
+
+/**
+ * The heap entry kept for each slot of a priority queue.  Only used to size
+ * the entry array given to xPriorityQueueCreateStatic(), and not to be
+ * accessed directly by the application.
+ */
+typedef struct xPRIORITY_QUEUE_ENTRY
+{
+	unsigned long ulSequence;				/*< The position of the item in the send order. */
+	unsigned portBASE_TYPE uxPriority;		/*< The priority the item was sent with. */
+	unsigned portBASE_TYPE uxSlot;			/*< The index of the slot holding the item. */
+} xPriorityQueueEntry;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ xPriorityQueueHandle xPriorityQueueCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize );
+ </pre>
+ *
+ * Creates a new priority queue, obtaining the memory for it from the
+ * FreeRTOS heap.
+ *
+ * @param uxLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return If NULL is returned then the queue could not be created because
+ * there was insufficient heap memory available.  Any other value is the
+ * handle of the created queue.
+ *
+ * \defgroup xPriorityQueueCreate xPriorityQueueCreate
+ * \ingroup PriorityQueues
+ */
+xPriorityQueueHandle xPriorityQueueCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ xPriorityQueueHandle xPriorityQueueCreateStatic( unsigned portBASE_TYPE uxLength,
+                                                  unsigned portBASE_TYPE uxItemSize,
+                                                  unsigned char *pucItemStorageArea,
+                                                  xPriorityQueueEntry *pxEntryStorageArea,
+                                                  xStaticPriorityQueue *pxStaticQueue );
+ </pre>
+ *
+ * Creates a new priority queue using memory supplied by the application
+ * instead of memory obtained from the FreeRTOS heap.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param uxLength As for xPriorityQueueCreate().
+ *
+ * @param uxItemSize As for xPriorityQueueCreate().
+ *
+ * @param pucItemStorageArea Must point to an array of at least
+ * ( uxLength * uxItemSize ) bytes, into which items are copied.
+ *
+ * @param pxEntryStorageArea Must point to an array of uxLength
+ * xPriorityQueueEntry variables, which will be used to hold the heap.
+ *
+ * @param pxStaticQueue Must point to a variable of type xStaticPriorityQueue,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return The handle of the created queue, or NULL if uxLength is zero or
+ * any of the buffers is NULL.
+ *
+ * \defgroup xPriorityQueueCreateStatic xPriorityQueueCreateStatic
+ * \ingroup PriorityQueues
+ */
+xPriorityQueueHandle xPriorityQueueCreateStatic( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucItemStorageArea, xPriorityQueueEntry *pxEntryStorageArea, xStaticPriorityQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ void vPriorityQueueDelete( xPriorityQueueHandle xQueue );
+ </pre>
+ *
+ * Deletes a priority queue.  No task can be waiting to send to or receive
+ * from it.  Memory supplied to xPriorityQueueCreateStatic() is not freed.
+ *
+ * \defgroup vPriorityQueueDelete vPriorityQueueDelete
+ * \ingroup PriorityQueues
+ */
+void vPriorityQueueDelete( xPriorityQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xPriorityQueueSend( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends an item to a priority queue.  The item is received after every item
+ * held with a higher priority, and after every item held with the same
+ * priority that was sent before it.  O( log n ).
+ *
+ * @param xQueue The handle of the queue the item is sent to.
+ *
+ * @param pvItem A pointer to the item, which is copied into the queue.
+ *
+ * @param uxPriority The priority of the item.  Larger values are received
+ * first.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for space should
+ * the queue be full.  Setting xTicksToWait to 0 causes the function to
+ * return immediately.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xPriorityQueueSend xPriorityQueueSend
+ * \ingroup PriorityQueues
+ */
+portBASE_TYPE xPriorityQueueSend( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xPriorityQueueSendFromISR( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xPriorityQueueSend() that can be called from an interrupt
+ * service routine.  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item
+ * unblocked a task with a priority above that of the interrupted task, in
+ * which case a context switch should be requested before the interrupt
+ * exits.  Can be NULL.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xPriorityQueueSendFromISR xPriorityQueueSendFromISR
+ * \ingroup PriorityQueues
+ */
+portBASE_TYPE xPriorityQueueSendFromISR( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xPriorityQueueReceive( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives the highest priority item from a priority queue.  O( log n ).
+ *
+ * @param xQueue The handle of the queue the item is received from.
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @param puxPriority Set to the priority the item was sent with.  Can be
+ * NULL.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item should
+ * the queue be empty.  Setting xTicksToWait to 0 causes the function to
+ * return immediately.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xPriorityQueueReceive xPriorityQueueReceive
+ * \ingroup PriorityQueues
+ */
+portBASE_TYPE xPriorityQueueReceive( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xPriorityQueueReceiveFromISR( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xPriorityQueueReceive() that can be called from an interrupt
+ * service routine.  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a task with a priority above that of the interrupted task, in
+ * which case a context switch should be requested before the interrupt
+ * exits.  Can be NULL.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xPriorityQueueReceiveFromISR xPriorityQueueReceiveFromISR
+ * \ingroup PriorityQueues
+ */
+portBASE_TYPE xPriorityQueueReceiveFromISR( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ portBASE_TYPE xPriorityQueuePeekPriority( xPriorityQueueHandle xQueue, unsigned portBASE_TYPE *puxPriority );
+ </pre>
+ *
+ * Reads the priority of the item xPriorityQueueReceive() would receive next,
+ * without removing the item.  Can be called from an interrupt.  O( 1 ).
+ *
+ * @return pdPASS if the queue holds an item, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xPriorityQueuePeekPriority xPriorityQueuePeekPriority
+ * \ingroup PriorityQueues
+ */
+portBASE_TYPE xPriorityQueuePeekPriority( xPriorityQueueHandle xQueue, unsigned portBASE_TYPE *puxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * priority_queue.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxPriorityQueueMessagesWaiting( xPriorityQueueHandle xQueue );
+ </pre>
+ *
+ * @return The number of items held in the queue.
+ *
+ * \defgroup uxPriorityQueueMessagesWaiting uxPriorityQueueMessagesWaiting
+ * \ingroup PriorityQueues
+ */
+unsigned portBASE_TYPE uxPriorityQueueMessagesWaiting( xPriorityQueueHandle xQueue ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIORITY_QUEUE_H */
@@ -0,0 +1,283 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The profiler builds a histogram of the program counter values at which
+ * the processor is interrupted, so the functions in which the most time is
+ * spent can be found on production hardware without a trace probe.  Each
+ * sample increments the bucket that covers the interrupted address, along
+ * with a count for the task that was running.  Taking a sample does not call
+ * any API function or mask interrupts, so samples can be taken from an
+ * interrupt of any priority - including one above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, which lets time spent inside critical
+ * sections be sampled too.
+ *
+ * The profiler is included in the build by setting configUSE_PROFILER to 1
+ * in FreeRTOSConfig.h and adding Source/profiler.c to the project.
+ * INCLUDE_xTaskGetCurrentTaskHandle and INCLUDE_pcTaskGetTaskName must also
+ * be set to 1.  The address range covered by the histogram is set by
+ * configPROFILER_LOW_ADDRESS and configPROFILER_HIGH_ADDRESS (normally the
+ * start and end of the code in flash), and the size of each bucket by
+ * configPROFILER_BUCKET_SHIFT - each bucket covers
+ * ( 1 << configPROFILER_BUCKET_SHIFT ) bytes.  Each bucket is two bytes of
+ * RAM, so 256K bytes of code in 16 byte buckets needs 32K bytes.  Samples
+ * from outside the range are counted but not placed in a bucket.  The number
+ * of tasks that are counted individually is set by
+ * configPROFILER_TASK_TABLE_LENGTH.
+ *
+ * With configPROFILER_SAMPLE_FROM_TICK set to 1 (the default) a sample is
+ * taken on every tick interrupt through traceTASK_INCREMENT_TICK().  That
+ * needs the port to provide portPROFILER_GET_INTERRUPTED_PC(), which the GCC
+ * Cortex-M3 and the GCC and Renesas RX600 ports do.  As tasks that block on
+ * time run just after a tick, sampling from the tick can under-report them.
+ * Setting configPROFILER_SAMPLE_FROM_TICK to 0 and calling
+ * vProfilerSampleFromISR() from a separate timer interrupt, running at a rate
+ * that is not a multiple of the tick rate, gives a more even picture.  The
+ * GCC Cortex-M3 port provides vPortProfilerTimerHandler() for the purpose,
+ * and the Renesas RX600 port provides portPROFILER_GET_FAST_INTERRUPT_PC()
+ * for a fast interrupt handler to pass.
+ *
+ * The histogram is held in the single xProfilerData structure xProfiler.
+ * Like the trace recorder buffer it describes its own layout, so a binary
+ * image of it read from the target can be turned into a list of functions by
+ * the profdecode utility found in Demo/Common/Profiler, given the symbol
+ * table of the program.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include profiler.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The version of the layout of xProfilerData.  This must be incremented if
+the layout is changed, and the decoder updated to match. */
+#define profPROFILER_VERSION				1
+
+/* The number of buckets needed to cover the profiled address range. */
+#define profBUCKET_COUNT	( ( ( unsigned long ) ( configPROFILER_HIGH_ADDRESS ) - ( unsigned long ) ( configPROFILER_LOW_ADDRESS ) + ( 1UL << configPROFILER_BUCKET_SHIFT ) - 1UL ) >> configPROFILER_BUCKET_SHIFT )
+
+/*
+ * An entry in the task table.  The decoder assumes the members are naturally
+ * aligned, so ulSamples follows uxTask and the name follows ulSamples.
+ */
+typedef struct xPROFILER_TASK
+{
+	portPOINTER_SIZE_TYPE uxTask;							/*< The handle of the task, or 0 if the entry is unused. */
+	unsigned long ulSamples;								/*< The number of samples taken while the task was running. */
+	signed char pcName[ configMAX_TASK_NAME_LEN ];			/*< The name of the task when it was first sampled. */
+} xProfilerTask;
+
+/*
+ * The histogram.  The header members describe the rest of the structure so
+ * the decoder does not need to be built with the same configuration as the
+ * target.
+ */
+typedef struct xPROFILER
+{
+	unsigned char ucSignature[ 4 ];							/*< Always "FRPF", used by the decoder to find the structure. */
+	unsigned char ucVersion;								/*< profPROFILER_VERSION. */
+	unsigned char ucLongSize;								/*< sizeof( unsigned long ) on the target. */
+	unsigned char ucPointerSize;							/*< sizeof( portPOINTER_SIZE_TYPE ) on the target. */
+	unsigned char ucBucketShift;							/*< configPROFILER_BUCKET_SHIFT. */
+	unsigned long ulEndianness;								/*< Always 0x01020304, used by the decoder to determine the byte order of the target. */
+	unsigned long ulLowAddress;								/*< configPROFILER_LOW_ADDRESS, the address covered by the first bucket. */
+	unsigned long ulHighAddress;							/*< configPROFILER_HIGH_ADDRESS. */
+	unsigned long ulTaskTableOffset;						/*< The offset of xTasks from the start of the structure. */
+	unsigned long ulTaskTableLength;						/*< The number of entries in xTasks. */
+	unsigned long ulTaskSize;								/*< sizeof( xProfilerTask ). */
+	unsigned long ulNameLength;								/*< configMAX_TASK_NAME_LEN. */
+	unsigned long ulBucketOffset;							/*< The offset of usBuckets from the start of the structure. */
+	unsigned long ulBucketCount;							/*< The number of entries in usBuckets. */
+	volatile unsigned long ulSamples;						/*< The number of samples taken since the histogram was last reset. */
+	volatile unsigned long ulOutOfRange;					/*< Samples that were counted against a task but fell outside the address range. */
+	volatile unsigned long ulTasksNotRecorded;				/*< Samples taken while a task that did not fit in xTasks was running. */
+	volatile unsigned long ulFilterTask;					/*< One more than the index in xTasks of the only task placed in the histogram, or 0 if samples from every task are placed in it. */
+	volatile unsigned long ulRunning;						/*< pdTRUE while samples are being taken.  Cleared automatically when a bucket becomes full. */
+	xProfilerTask xTasks[ configPROFILER_TASK_TABLE_LENGTH ];
+	volatile unsigned short usBuckets[ profBUCKET_COUNT ];
+} xProfilerData;
+
+/**
+ * profiler.h
+ *
+ * <pre>
+ void vProfilerSampleFromISR( unsigned long ulPC );
+ </pre>
+ *
+ * Records one sample.  ulPC is the address at which the interrupt that is
+ * taking the sample interrupted the program, which the interrupt must obtain
+ * from the frame stacked on entry - portPROFILER_GET_INTERRUPTED_PC() does
+ * this where the port supports it.  The task that is counted is the task
+ * that was running when the interrupt occurred.  Samples must only be taken
+ * from one interrupt, as the histogram is updated without masking
+ * interrupts.
+ *
+ * Sampling stops by itself if a bucket reaches 0xffff, so the counts in the
+ * histogram always stay in proportion.
+ *
+ * @param ulPC The interrupted program counter.
+ *
+ * \defgroup vProfilerSampleFromISR vProfilerSampleFromISR
+ * \ingroup Profiler
+ */
+void vProfilerSampleFromISR( unsigned long ulPC ) PRIVILEGED_FUNCTION;
+
+/**
+ * profiler.h
+ *
+ * <pre>
+ void vProfilerStart( void );
+ void vProfilerStop( void );
+ </pre>
+ *
+ * Start and stop taking samples.  Sampling is started by default.
+ *
+ * \defgroup vProfilerStart vProfilerStart
+ * \ingroup Profiler
+ */
+void vProfilerStart( void ) PRIVILEGED_FUNCTION;
+void vProfilerStop( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * profiler.h
+ *
+ * <pre>
+ void vProfilerReset( void );
+ </pre>
+ *
+ * Clears the histogram, the task table and the sample counts, then starts
+ * sampling.  The task table has to be cleared as the memory used by a task
+ * that has been deleted may since have been reused for a new task.
+ *
+ * \defgroup vProfilerReset vProfilerReset
+ * \ingroup Profiler
+ */
+void vProfilerReset( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * profiler.h
+ *
+ * <pre>
+ portBASE_TYPE xProfilerSetTaskFilter( void *pvTask );
+ </pre>
+ *
+ * Restricts the histogram to the samples taken while one task is running, to
+ * find where that task spends its time.  The samples of every task are still
+ * counted in the task table.  The histogram is not cleared, so
+ * vProfilerReset() should be called first if it already holds samples from
+ * other tasks.
+ *
+ * @param pvTask The handle of the task to profile, or NULL to place samples
+ * from every task in the histogram again.
+ *
+ * @return pdPASS if the filter was set, or pdFAIL if the task table is full
+ * and does not already include the task.
+ *
+ * \defgroup xProfilerSetTaskFilter xProfilerSetTaskFilter
+ * \ingroup Profiler
+ */
+portBASE_TYPE xProfilerSetTaskFilter( void *pvTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * profiler.h
+ *
+ * <pre>
+ const void *pvProfilerGetData( size_t *pxSize );
+ </pre>
+ *
+ * Obtains the address and size of the histogram, so it can be sent to the
+ * host for decoding.  Sampling should be stopped first, otherwise the
+ * histogram may change while it is being sent.
+ *
+ * @param pxSize Set to the size of the histogram in bytes.
+ *
+ * @return A pointer to the start of the histogram.
+ *
+ * \defgroup pvProfilerGetData pvProfilerGetData
+ * \ingroup Profiler
+ */
+const void *pvProfilerGetData( size_t *pxSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* Sample from the tick interrupt.  traceTASK_INCREMENT_TICK() is only
+expanded in vTaskIncrementTick(), which is only called from the tick
+interrupt.  If FreeRTOSConfig.h already defines traceTASK_INCREMENT_TICK() -
+or it is used by the trace recorder - then that definition has to call
+vProfilerSampleFromISR( portPROFILER_GET_INTERRUPTED_PC() ) itself. */
+#if ( configPROFILER_SAMPLE_FROM_TICK == 1 )
+
+	#ifndef portPROFILER_GET_INTERRUPTED_PC
+		#error This port does not provide portPROFILER_GET_INTERRUPTED_PC(), so configPROFILER_SAMPLE_FROM_TICK must be 0 and samples taken from an application interrupt.
+	#endif
+
+	#ifndef traceTASK_INCREMENT_TICK
+		#define traceTASK_INCREMENT_TICK( xTickCount ) vProfilerSampleFromISR( portPROFILER_GET_INTERRUPTED_PC() )
+	#endif
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROFILER_H */
@@ -73,10 +73,25 @@ extern "C" {
  */
 typedef void * xQueueHandle;
 
+/**
+ * Type by which queue sets are referenced.  For example, a call to
+ * xQueueCreateSet() returns an xQueueSetHandle variable that can then be used
+ * as a parameter to xQueueSelectFromSet(), xQueueAddToSet(), etc.
+ */
+typedef void * xQueueSetHandle;
+
+/**
+ * Queue sets can contain both queues and semaphores, so the
+ * xQueueSetMemberHandle is defined as a type to be used where a parameter or
+ * return value can be either an xQueueHandle or an xSemaphoreHandle.
+ */
+typedef void * xQueueSetMemberHandle;
+
 
 /* For internal use only. */
 #define	queueSEND_TO_BACK	( 0 )
 #define	queueSEND_TO_FRONT	( 1 )
+#define	queueOVERWRITE		( 2 )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE				( 0U )
@@ -84,6 +99,7 @@ typedef void * xQueueHandle;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( 4U )
+#define queueQUEUE_TYPE_SET					( 0U )
 
 /**
  * queue. h
@@ -143,6 +159,64 @@ typedef void * xQueueHandle;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorageBuffer,
+							  xStaticQueue *pxQueueBuffer
+						  );
+   </pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Creates a new queue instance using memory supplied by the caller for both
+ * the queue's storage area and the structure used to hold the queue's state,
+ * so nothing is allocated from the FreeRTOS heap.  The memory must remain
+ * valid for the lifetime of the queue and is not freed by vQueueDelete().
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorageBuffer If uxItemSize is not zero then
+ * pucQueueStorageBuffer must point to an array of at least
+ * ( uxQueueLength * uxItemSize ) bytes, which is used to hold the items that
+ * are in the queue.  If uxItemSize is zero then pucQueueStorageBuffer must be
+ * NULL.
+ *
+ * @param pxQueueBuffer Must point to a variable of type xStaticQueue, which is
+ * used to hold the queue's state.
+ *
+ * @return A handle to the created queue, or NULL if a parameter was invalid.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH 10
+ #define ITEM_SIZE sizeof( unsigned long )
+
+ // The queue's state and storage area, which must persist for the lifetime of
+ // the queue.
+ static xStaticQueue xQueueBuffer;
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * ITEM_SIZE ];
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, ITEM_SIZE, ucQueueStorage, &xQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorageBuffer, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorageBuffer ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+
 /**
  * queue. h
  * <pre>
@@ -391,6 +465,59 @@ typedef void * xQueueHandle;
  */
 #define xQueueSend( xQueue, pvItemToQueue, xTicksToWait ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_TO_BACK )
 
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueOverwrite(
+							  xQueueHandle xQueue,
+							  const void * pvItemToQueue
+						 );
+ * </pre>
+ *
+ * This is a macro that calls xQueueGenericSend().
+ *
+ * Only for use with queues that have a length of one, which then act as a
+ * mailbox holding the latest value written.  The item is written to the
+ * queue even if the queue is full, in which case the item it held is
+ * replaced, so the call never blocks.  A task waiting to receive from the
+ * queue is unblocked as when posting with xQueueSend().  Readers that need
+ * to leave the value in place for other readers can use xQueuePeek().
+ *
+ * This function must not be called from an interrupt service routine.  See
+ * xQueueOverwriteFromISR() for an alternative which may be used in an ISR.
+ *
+ * @param xQueue The handle of the queue to which the item is to be written.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed in the
+ * queue.
+ *
+ * @return pdPASS, as the item is always written.
+ *
+ * Example usage:
+   <pre>
+ void vSetpointTask( void *pvParameters )
+ {
+ xQueueHandle xSetpoint;
+ long lValue;
+
+	// Create a mailbox holding a single long.
+	xSetpoint = xQueueCreate( 1, sizeof( long ) );
+
+	for( ;; )
+	{
+		lValue = lReadSetpoint();
+
+		// Replace whatever value the mailbox holds.  A slow reader only ever
+		// sees the latest one.
+		xQueueOverwrite( xSetpoint, &lValue );
+	}
+ }
+ </pre>
+ * \defgroup xQueueOverwrite xQueueOverwrite
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwrite( xQueue, pvItemToQueue ) xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
+
 
 /**
  * queue. h
@@ -765,6 +892,63 @@ signed portBASE_TYPE xQueueGenericSend( xQueueHandle pxQueue, const void * const
  */
 signed portBASE_TYPE xQueueGenericReceive( xQueueHandle xQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeek );
 
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueSendUntil( xQueueHandle xQueue, const void * pvItemToQueue, portTickType xWakeTime );
+ portBASE_TYPE xQueueSendToFrontUntil( xQueueHandle xQueue, const void * pvItemToQueue, portTickType xWakeTime );
+ portBASE_TYPE xQueueSendToBackUntil( xQueueHandle xQueue, const void * pvItemToQueue, portTickType xWakeTime );
+ portBASE_TYPE xQueueReceiveUntil( xQueueHandle xQueue, void *pvBuffer, portTickType xWakeTime );
+ portBASE_TYPE xQueuePeekUntil( xQueueHandle xQueue, void *pvBuffer, portTickType xWakeTime );
+ </pre>
+ *
+ * Versions of xQueueSend(), xQueueSendToFront(), xQueueSendToBack(),
+ * xQueueReceive() and xQueuePeek() that block until the tick count reaches
+ * xWakeTime at the latest, rather than for a number of ticks.  A task that
+ * has to finish a series of queue operations by a deadline can pass the same
+ * wake time to each of them, instead of working out how much of the time is
+ * left before each call.  However often the task is woken and has to block
+ * again, it times out at xWakeTime exactly.
+ *
+ * A wake time that has already been reached, or that is more than
+ * portMAX_DELAY / 2 ticks ahead of the tick count, makes the call behave as
+ * if a block time of 0 had been given.  There is no way of blocking
+ * indefinitely with these functions.
+ *
+ * configUSE_ABSOLUTE_TIMEOUTS must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( xQueueHandle xQueue )
+ {
+ portTickType xDeadline;
+ unsigned char ucByte;
+
+	// Collect bytes for at most 20ms.
+	xDeadline = xTaskGetTickCount() + ( 20 / portTICK_RATE_MS );
+	while( xQueueReceiveUntil( xQueue, &ucByte, xDeadline ) == pdPASS )
+	{
+		// Process ucByte.
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveUntil xQueueReceiveUntil
+ * \ingroup QueueManagement
+ */
+#define xQueueSendUntil( xQueue, pvItemToQueue, xWakeTime ) xQueueGenericSendUntil( ( xQueue ), ( pvItemToQueue ), ( xWakeTime ), queueSEND_TO_BACK )
+#define xQueueSendToFrontUntil( xQueue, pvItemToQueue, xWakeTime ) xQueueGenericSendUntil( ( xQueue ), ( pvItemToQueue ), ( xWakeTime ), queueSEND_TO_FRONT )
+#define xQueueSendToBackUntil( xQueue, pvItemToQueue, xWakeTime ) xQueueGenericSendUntil( ( xQueue ), ( pvItemToQueue ), ( xWakeTime ), queueSEND_TO_BACK )
+#define xQueueReceiveUntil( xQueue, pvBuffer, xWakeTime ) xQueueGenericReceiveUntil( ( xQueue ), ( pvBuffer ), ( xWakeTime ), pdFALSE )
+#define xQueuePeekUntil( xQueue, pvBuffer, xWakeTime ) xQueueGenericReceiveUntil( ( xQueue ), ( pvBuffer ), ( xWakeTime ), pdTRUE )
+
+/*
+ * For internal use only.  Use the macros above instead of calling these
+ * functions directly.
+ */
+signed portBASE_TYPE xQueueGenericSendUntil( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xWakeTime, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE xQueueGenericReceiveUntil( xQueueHandle xQueue, void * const pvBuffer, portTickType xWakeTime, portBASE_TYPE xJustPeek );
+
 /**
  * queue. h
  * <pre>unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue );</pre>
@@ -780,6 +964,23 @@ signed portBASE_TYPE xQueueGenericReceive( xQueueHandle xQueue, void * const pvB
  */
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue );
 
+/**
+ * queue. h
+ * <pre>unsigned portBASE_TYPE uxQueueSpacesAvailable( const xQueueHandle xQueue );</pre>
+ *
+ * Return the number of free spaces in a queue.  For an empty queue this is
+ * the length the queue was created with.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The number of items that can be sent to the queue before it is
+ * full.
+ *
+ * \page uxQueueSpacesAvailable uxQueueSpacesAvailable
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueSpacesAvailable( const xQueueHandle xQueue );
+
 /**
  * queue. h
  * <pre>void vQueueDelete( xQueueHandle xQueue );</pre>
@@ -794,6 +995,27 @@ unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle xQueue );
  */
 void vQueueDelete( xQueueHandle pxQueue );
 
+/**
+ * queue. h
+ * <pre>void vQueueCacheFlush( void );</pre>
+ *
+ * When configUSE_QUEUE_CACHE is set to 1 in FreeRTOSConfig.h, vQueueDelete()
+ * does not free a dynamically allocated queue, semaphore or mutex straight
+ * away but keeps up to configQUEUE_CACHE_DEPTH of them for each size of
+ * storage area, and the next queue created with a storage area of the same
+ * size class (or the next mutex) reuses one instead of allocating memory.
+ * Storage areas are rounded up to one of configQUEUE_CACHE_CLASSES sizes,
+ * starting at 16 bytes and doubling, so that they can be reused; larger
+ * storage areas are not cached.
+ *
+ * vQueueCacheFlush() frees every queue held by the cache, returning the
+ * memory to the FreeRTOS heap.
+ *
+ * \page vQueueCacheFlush vQueueCacheFlush
+ * \ingroup QueueManagement
+ */
+void vQueueCacheFlush( void );
+
 /**
  * queue. h
  * <pre>
@@ -1009,6 +1231,38 @@ void vQueueDelete( xQueueHandle pxQueue );
  */
 #define xQueueSendFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( pxQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
 
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueueOverwriteFromISR(
+									   xQueueHandle pxQueue,
+									   const void *pvItemToQueue,
+									   portBASE_TYPE *pxHigherPriorityTaskWoken
+								  );
+ * </pre>
+ *
+ * This is a macro that calls xQueueGenericSendFromISR().
+ *
+ * A version of xQueueOverwrite() that can be used in an interrupt service
+ * routine.  Only for use with queues that have a length of one.
+ *
+ * @param pxQueue The handle of the queue to which the item is to be written.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed in the
+ * queue.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueOverwriteFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if writing the item unblocked a task
+ * with a priority higher than the currently running task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS, as the item is always written.
+ *
+ * \defgroup xQueueOverwriteFromISR xQueueOverwriteFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwriteFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) xQueueGenericSendFromISR( ( pxQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE )
+
 /**
  * queue. h
  * <pre>
@@ -1176,6 +1430,258 @@ signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void
  */
 signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken );
 
+/**
+ * queue. h
+ * <pre>
+ portBASE_TYPE xQueuePeekFromISR(
+									xQueueHandle pxQueue,
+									void *pvBuffer
+								);
+ * </pre>
+ *
+ * A version of xQueuePeek() that can be used from an interrupt service
+ * routine.  The item at the front of the queue is copied into pvBuffer but
+ * is not removed from the queue, so no task can be unblocked by the call.
+ * Cannot be used with semaphores.
+ *
+ * @param pxQueue The handle of the queue from which the item is to be
+ * copied.
+ *
+ * @param pvBuffer Pointer to the buffer into which the item will be copied.
+ *
+ * @return pdPASS if an item was copied from the queue, otherwise pdFAIL.
+ *
+ * \defgroup xQueuePeekFromISR xQueuePeekFromISR
+ * \ingroup QueueManagement
+ */
+signed portBASE_TYPE xQueuePeekFromISR( xQueueHandle pxQueue, void * const pvBuffer );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueSendMultiple(
+										   xQueueHandle xQueue,
+										   const void * pvItemsToQueue,
+										   unsigned portBASE_TYPE uxItemCount,
+										   portTickType xTicksToWait
+									   );
+ * </pre>
+ *
+ * Post uxItemCount items, held one after another in pvItemsToQueue, to the
+ * back of a queue.  The items are copied in as few blocks as the queue space
+ * allows, each block using a single critical section, and at most one task
+ * is unblocked per item posted.  This is much cheaper than calling
+ * xQueueSend() for each item.
+ *
+ * If there is not enough space for all the items then as many as fit are
+ * posted, and the calling task blocks for up to xTicksToWait ticks in total
+ * waiting for space for the remainder.
+ *
+ * This function must not be called from an interrupt service routine, or
+ * used with a mutex.  See uxQueueSendMultipleFromISR() for an alternative
+ * that can be used from an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.  Each
+ * item has the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return The number of items actually posted.  This is uxItemCount unless
+ * the block time expired first.
+ *
+ * Example usage:
+   <pre>
+ void vSamplingTask( void *pvParameters )
+ {
+ unsigned short usSamples[ 64 ];
+
+	for( ;; )
+	{
+		vReadSamples( usSamples, 64 );
+
+		// Post all 64 samples, waiting up to 10 ticks for space.
+		if( uxQueueSendMultiple( xSampleQueue, usSamples, 64, 10 ) != 64 )
+		{
+			// Some samples were dropped.
+		}
+	}
+ }
+   </pre>
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueSendMultipleFromISR(
+												  xQueueHandle xQueue,
+												  const void * pvItemsToQueue,
+												  unsigned portBASE_TYPE uxItemCount,
+												  portBASE_TYPE *pxHigherPriorityTaskWoken
+											  );
+ * </pre>
+ *
+ * A version of uxQueueSendMultiple() that can be used from an interrupt
+ * service routine.  The function never blocks - as many of the items as
+ * there is space for are posted.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueReceiveMultiple(
+											  xQueueHandle xQueue,
+											  void *pvBuffer,
+											  unsigned portBASE_TYPE uxMaxItems,
+											  portTickType xTicksToWait
+										  );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from a queue in a single operation.  If the
+ * queue is empty the calling task blocks for up to xTicksToWait ticks waiting
+ * for data.  As soon as any data is available all the items that are in the
+ * queue, up to uxMaxItems, are copied into pvBuffer in one go, and at most one
+ * task that is waiting for space is unblocked per item removed.
+ *
+ * This function must not be called from an interrupt service routine, or
+ * used with a mutex.  See uxQueueReceiveMultipleFromISR() for an alternative
+ * that can be used from an ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * before any data arrived.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait );
+
+/**
+ * queue. h
+ * <pre>
+ unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR(
+													 xQueueHandle xQueue,
+													 void *pvBuffer,
+													 unsigned portBASE_TYPE uxMaxItems,
+													 portBASE_TYPE *pxTaskWoken
+												 );
+ * </pre>
+ *
+ * A version of uxQueueReceiveMultiple() that can be used from an interrupt
+ * service routine.  The function never blocks.
+ *
+ * @param pxTaskWoken Set to pdTRUE if removing the items unblocked a task
+ * with a priority higher than the currently running task, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken );
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserveSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+ void vQueueCommitSlot( xQueueHandle xQueue );
+ void *pvQueueBorrowSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+ void vQueueReleaseSlot( xQueueHandle xQueue );
+ * </pre>
+ *
+ * Pass large items through a queue without copying them.  These functions are
+ * only available when configUSE_ZERO_COPY_QUEUES is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * pvQueueReserveSlot() returns a pointer to the free slot at the back of the
+ * queue storage area, blocking for up to xTicksToWait ticks if the queue is
+ * full.  The caller writes the item directly into the slot, then calls
+ * vQueueCommitSlot() to post it.  The item has not been posted, and cannot be
+ * received, until it is committed.
+ *
+ * pvQueueBorrowSlot() removes the item at the front of the queue and returns
+ * a pointer to it in the queue storage area, blocking for up to xTicksToWait
+ * ticks if the queue is empty.  The caller uses the item in place, then calls
+ * vQueueReleaseSlot() to allow its slot to be written again.  The slot
+ * continues to occupy space in the queue until it is released.
+ *
+ * Both pvQueueReserveSlot() and pvQueueBorrowSlot() return NULL if their
+ * block time expires.
+ *
+ * At most one slot can be reserved, and one slot borrowed, at any one time.
+ * A task that tries to reserve or borrow while another task holds a slot of
+ * the same kind blocks until that slot is committed or released, so any
+ * number of tasks can use the same queue.  A queue that is used with these
+ * functions must not also be written with xQueueSend() or read with
+ * xQueueReceive(), must not be a semaphore or mutex, and these functions must
+ * not be called from an interrupt.
+ *
+ * Example usage:
+   <pre>
+ // A queue of Ethernet frames.
+ xFrameQueue = xQueueCreate( 4, sizeof( xEthernetFrame ) );
+
+ void vRxTask( void *pvParameters )
+ {
+ xEthernetFrame *pxFrame;
+
+	for( ;; )
+	{
+		pxFrame = ( xEthernetFrame * ) pvQueueReserveSlot( xFrameQueue, portMAX_DELAY );
+		vReadFrameFromMAC( pxFrame );
+		vQueueCommitSlot( xFrameQueue );
+	}
+ }
+
+ void vProtocolTask( void *pvParameters )
+ {
+ xEthernetFrame *pxFrame;
+
+	for( ;; )
+	{
+		pxFrame = ( xEthernetFrame * ) pvQueueBorrowSlot( xFrameQueue, portMAX_DELAY );
+		vProcessFrame( pxFrame );
+		vQueueReleaseSlot( xFrameQueue );
+	}
+ }
+   </pre>
+ * \defgroup pvQueueReserveSlot pvQueueReserveSlot
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserveSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+void vQueueCommitSlot( xQueueHandle xQueue );
+void *pvQueueBorrowSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+void vQueueReleaseSlot( xQueueHandle xQueue );
+
 /*
  * Utilities to query queue that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1227,6 +1733,8 @@ signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, port
  */
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType );
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
+xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue );
+xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue );
 void* xQueueGetMutexHolder( xQueueHandle xSemaphore );
 
 /*
@@ -1234,8 +1742,19 @@ void* xQueueGetMutexHolder( xQueueHandle xSemaphore );
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
  */
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle pxMutex, portTickType xBlockTime );
+portBASE_TYPE xQueueTakeMutexRecursiveUntil( xQueueHandle pxMutex, portTickType xWakeTime );
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
 
+/*
+ * For internal use only.  Use xSemaphoreGiveMultiple(),
+ * xSemaphoreTakeMultiple() and their FromISR versions instead of calling
+ * these functions directly.
+ */
+signed portBASE_TYPE xQueueSemaphoreGiveMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount );
+signed portBASE_TYPE xQueueSemaphoreGiveMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+signed portBASE_TYPE xQueueSemaphoreTakeMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, portTickType xTicksToWait );
+signed portBASE_TYPE xQueueSemaphoreTakeMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
 /*
  * Reset a queue back to its original empty state.  pdPASS is returned if the
  * queue is successfully reset.  pdFAIL is returned if the queue could not be
@@ -1257,6 +1776,11 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
  * does not effect the number of queues, semaphores and mutexes that can be
  * created - just the number that the registry can hold.
  *
+ * When configUSE_NAME_REGISTRY is 1 the handle is also added to the name
+ * registry, so it can be found with xNameRegistryFindQueue(), and this
+ * function is available even if configQUEUE_REGISTRY_SIZE is 0.  See
+ * name_registry.h.
+ *
  * @param xQueue The handle of the queue being added to the registry.  This
  * is the handle returned by a call to xQueueCreate().  Semaphore and mutex
  * handles can also be passed in here.
@@ -1264,16 +1788,200 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex );
  * @param pcName The name to be associated with the handle.  This is the
  * name that the kernel aware debugger will display.
  */
-#if configQUEUE_REGISTRY_SIZE > 0U
+#if ( configQUEUE_REGISTRY_SIZE > 0U ) || ( configUSE_NAME_REGISTRY == 1 )
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcName );
 #endif
 
+/* The information reported by vQueueGetInfo() and uxQueueGetSystemState(). */
+typedef struct xQUEUE_STATUS
+{
+	xQueueHandle xHandle;							/* The queue the rest of the structure describes. */
+	const signed char *pcQueueName;					/* The name the queue was registered with, or NULL if it is not in the queue registry. */
+	unsigned char ucQueueNumber;					/* The number set by vQueueSetQueueNumber(). */
+	unsigned char ucQueueType;						/* Whether the queue is a queue, semaphore or mutex. */
+	unsigned portBASE_TYPE uxLength;				/* The maximum number of items the queue can hold. */
+	unsigned portBASE_TYPE uxMessagesWaiting;		/* The number of items in the queue when the snapshot was taken. */
+	unsigned portBASE_TYPE uxPeakMessagesWaiting;	/* The largest number of items the queue has held at once. */
+	unsigned long ulSendCount;						/* The number of items sent to the queue. */
+	unsigned long ulReceiveCount;					/* The number of items received from the queue, not counting peeks. */
+	unsigned long ulSendFailCount;					/* The number of sends that failed because no space became available in time. */
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		/* The following are only maintained for mutexes, and are in run time
+		counter units.  ulMutexWaitHistogram[ 0 ] counts the waits less than
+		configMUTEX_CONTENTION_RESOLUTION long, and each later bucket those
+		less than twice the limit of the one before.  The last bucket counts
+		the rest.  ulMutexHoldHistogram is the same for the hold times. */
+		void *pvLastMutexHolder;					/* The task that most recently took the mutex, which may still hold it. */
+		unsigned long ulMutexTakeCount;				/* The number of times the mutex has been taken, not counting recursive takes by its holder. */
+		unsigned long ulMutexContendedCount;		/* The number of takes that found the mutex already held, including those that then timed out. */
+		portRUN_TIME_COUNTER_TYPE ulTotalMutexWait;	/* The total time tasks have spent waiting for the mutex. */
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexWait;	/* The longest single wait for the mutex, whether or not it ended with the mutex being taken. */
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexHold;	/* The longest time the mutex has been held, from being taken to being given back. */
+		unsigned long ulMutexWaitHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+		unsigned long ulMutexHoldHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+	#endif
+} xQueueStatusType;
+
+/*
+ * Fills *pxQueueStatus with the usage statistics the kernel keeps for the
+ * queue, semaphore or mutex xQueue.  The counts start from zero when the
+ * queue is created, are not cleared by xQueueReset(), and wrap on overflow.
+ * A send that writes only some of its items, such as a partial
+ * uxQueueSendMultiple(), counts as one failure as well as the items sent.
+ *
+ * configUSE_TRACE_FACILITY must be set to 1 within FreeRTOSConfig.h for the
+ * statistics to be maintained and for this function to be available.
+ *
+ * If configRECORD_MUTEX_CONTENTION is also set to 1 the status of a mutex
+ * includes how often it was found already held, how long tasks waited to take
+ * it and how long it was held, timed with the run time counter.  A wait is
+ * timed from the take first finding the mutex held until it either takes the
+ * mutex or gives up.  Recursive takes by the task that already holds a
+ * recursive mutex are not counted, and its hold time runs from the outermost
+ * take to the matching give.
+ */
+#if configUSE_TRACE_FACILITY == 1
+	void vQueueGetInfo( xQueueHandle xQueue, xQueueStatusType *pxQueueStatus );
+#endif
+
+/*
+ * Fills an xQueueStatusType structure, as vQueueGetInfo() does, for each
+ * queue in the queue registry.  The snapshot is binary, so can be passed
+ * straight to a telemetry link without any string formatting.  Queues that
+ * have not been added to the registry are not reported.
+ *
+ * @param pxQueueStatusArray The array of structures to fill.
+ *
+ * @param uxArraySize The number of structures in pxQueueStatusArray.  Once
+ * the array is full no further queues are reported.
+ *
+ * @return The number of structures filled.
+ *
+ * configUSE_TRACE_FACILITY must be set to 1, and configQUEUE_REGISTRY_SIZE
+ * must be greater than 0, within FreeRTOSConfig.h for this function to be
+ * available.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0U )
+	unsigned portBASE_TYPE uxQueueGetSystemState( xQueueStatusType *pxQueueStatusArray, unsigned portBASE_TYPE uxArraySize );
+#endif
+
+/*
+ * Queue sets provide a mechanism to allow a task to block (pend) on a read
+ * operation from multiple queues or semaphores simultaneously.
+ *
+ * A queue set must be explicitly created using a call to xQueueCreateSet()
+ * before it can be used.  Once created, standard FreeRTOS queues and semaphores
+ * can be added to the set using calls to xQueueAddToSet().
+ * xQueueSelectFromSet() is then used to determine which, if any, of the queues
+ * or semaphores contained in the set is in a state where a queue read or
+ * semaphore take operation would be successful.
+ *
+ * Note 1:  A receive (in the case of a queue) or take (in the case of a
+ * semaphore) operation must not be performed on a member of a queue set unless
+ * a call to xQueueSelectFromSet() has first returned a handle to that set
+ * member.
+ *
+ * Note 2:  Tasks must not block directly on a member of a queue set.  When a
+ * queue or semaphore is a member of a set, a send to it posts its handle to
+ * the set instead of unblocking tasks waiting on the member itself.
+ *
+ * Note 3:  Mutexes cannot be added to a queue set.
+ *
+ * configUSE_QUEUE_SETS must be set to 1 in FreeRTOSConfig.h for the queue set
+ * functions to be available.
+ *
+ * @param uxEventQueueLength Queue sets store events that occur on the queues
+ * and semaphores contained in the set.  uxEventQueueLength specifies the
+ * maximum number of events that can be queued at once.  To be absolutely
+ * certain that events are not lost uxEventQueueLength should be set to the
+ * total sum of the length of the queues added to the set, where binary
+ * semaphores have a length of 1 and counting semaphores have a length set by
+ * their maximum count value.
+ *
+ * @return If the queue set is created successfully then a handle to the
+ * created queue set is returned.  Otherwise NULL is returned.
+ */
+xQueueSetHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+
+/*
+ * Adds a queue or semaphore to a queue set that was previously created by a
+ * call to xQueueCreateSet().  A queue or semaphore can only be added to a set
+ * while it is empty.
+ *
+ * See xQueueCreateSet() for a full description.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
+ * the queue set (cast to an xQueueSetMemberHandle type).
+ *
+ * @param xQueueSet The handle of the queue set to which the queue or semaphore
+ * is being added.
+ *
+ * @return If the queue or semaphore was successfully added to the queue set
+ * then pdPASS is returned.  If the queue could not be successfully added to the
+ * queue set because it is already a member of a different queue set, or it
+ * is not empty, then pdFAIL is returned.
+ */
+portBASE_TYPE xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/*
+ * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
+ * be removed from a set if the queue or semaphore is empty.
+ *
+ * See xQueueCreateSet() for a full description.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being removed
+ * from the queue set (cast to an xQueueSetMemberHandle type).
+ *
+ * @param xQueueSet The handle of the queue set in which the queue or semaphore
+ * is included.
+ *
+ * @return If the queue or semaphore was successfully removed from the queue set
+ * then pdPASS is returned.  If the queue was not in the queue set, or the
+ * queue (or semaphore) was not empty, then pdFAIL is returned.
+ */
+portBASE_TYPE xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+
+/*
+ * xQueueSelectFromSet() selects from the members of a queue set a queue or
+ * semaphore that either contains data (in the case of a queue) or is available
+ * to take (in the case of a semaphore).  xQueueSelectFromSet() effectively
+ * allows a task to block (pend) on a read operation on all the queues and
+ * semaphores in a queue set simultaneously.
+ *
+ * See xQueueCreateSet() for a full description.
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param xBlockTimeTicks The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state (with other tasks executing) to wait for a member
+ * of the queue set to be ready for a successful queue read or semaphore take
+ * operation.
+ *
+ * @return xQueueSelectFromSet() will return the handle of a queue (cast to
+ * an xQueueSetMemberHandle type) contained in the queue set that contains data,
+ * or the handle of a semaphore (cast to an xQueueSetMemberHandle type)
+ * contained in the queue set that is available, or NULL if no such queue or
+ * semaphore exists before the specified block time expires.
+ */
+xQueueSetMemberHandle xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks );
+
+/*
+ * A version of xQueueSelectFromSet() that can be used from an ISR.
+ */
+xQueueSetMemberHandle xQueueSelectFromSetFromISR( xQueueSetHandle xQueueSet );
+
 /*
  * Generic version of the queue creation function, which is in turn called by 
  * any queue, semaphore or mutex creation function or macro.
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType );
 
+/*
+ * Generic version of the static queue creation function, which is in turn
+ * called by any static queue or semaphore creation macro.
+ */
+xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType );
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( xQueueHandle pxQueue, portTickType xTicksToWait );
 portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue );
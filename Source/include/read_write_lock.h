@@ -0,0 +1,279 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A read/write lock protects data that is read much more often than it is
+ * written.  Any number of tasks can hold the lock for reading at the same
+ * time, but a task that holds the lock for writing holds it exclusively.
+ *
+ * Writers are given preference.  Once a writer is waiting for the lock, no
+ * further readers are admitted until every waiting writer has obtained and
+ * released the lock (or stopped waiting), so a steady stream of readers
+ * cannot starve a writer.  Waiting writers are granted the lock in priority
+ * order.  When the last writer releases the lock, all the waiting readers are
+ * released together.
+ *
+ * Priority inheritance is applied to writers.  A task that blocks on a lock
+ * held for writing raises the priority of the writer to its own priority, and
+ * the writer's priority is lowered again when it releases the lock or when
+ * the waiting task's block time expires, in the same way as for a mutex.
+ * Readers do not inherit priority, as the lock does not record which tasks
+ * are reading.  configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h to use
+ * read/write locks.
+ *
+ * An interrupt can try to take the lock for reading, without blocking, using
+ * xReadWriteLockTakeReadFromISR(), and must then release it using
+ * xReadWriteLockGiveReadFromISR().  Interrupts cannot take the lock for
+ * writing.
+ */
+
+#ifndef READ_WRITE_LOCK_H
+#define READ_WRITE_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include read_write_lock.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which read/write locks are referenced.  For example, a call to
+ * xReadWriteLockCreate() returns an xReadWriteLockHandle variable that can
+ * then be used as a parameter to xReadWriteLockTakeRead(),
+ * xReadWriteLockTakeWrite(), etc.
+ */
+typedef void * xReadWriteLockHandle;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ xReadWriteLockHandle xReadWriteLockCreate( void );
+ </pre>
+ *
+ * Creates a new read/write lock.  The lock is initially not held.
+ *
+ * @return If NULL is returned then the lock could not be created because
+ * there was insufficient heap memory available.  Any other value is the
+ * handle of the created lock.
+ *
+ * \defgroup xReadWriteLockCreate xReadWriteLockCreate
+ * \ingroup ReadWriteLocks
+ */
+xReadWriteLockHandle xReadWriteLockCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockTakeRead( xReadWriteLockHandle xLock, portTickType xTicksToWait );
+ </pre>
+ *
+ * Takes the lock for reading.  The lock can be taken for reading provided it
+ * is not held for writing and no writer is waiting for it.  A task that
+ * already holds the lock for reading must not take it again, as a writer that
+ * starts waiting in between would deadlock the two.
+ *
+ * @param xLock The handle of the lock being taken.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for the lock to
+ * become available for reading.  Setting xTicksToWait to 0 causes the
+ * function to return immediately if the lock is not available.
+ *
+ * @return pdPASS if the lock was taken for reading, otherwise pdFAIL.
+ *
+ * \defgroup xReadWriteLockTakeRead xReadWriteLockTakeRead
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockTakeRead( xReadWriteLockHandle xLock, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockGiveRead( xReadWriteLockHandle xLock );
+ </pre>
+ *
+ * Releases a lock that was taken for reading by xReadWriteLockTakeRead().
+ * When the last reader releases the lock the highest priority waiting writer
+ * is unblocked.
+ *
+ * @param xLock The handle of the lock being released.
+ *
+ * @return pdPASS if the lock was released, or pdFAIL if the lock was not held
+ * for reading.
+ *
+ * \defgroup xReadWriteLockGiveRead xReadWriteLockGiveRead
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockGiveRead( xReadWriteLockHandle xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockTakeWrite( xReadWriteLockHandle xLock, portTickType xTicksToWait );
+ </pre>
+ *
+ * Takes the lock for writing.  The lock can only be taken for writing when it
+ * is held by neither readers nor another writer.  While the calling task
+ * waits, new readers are kept out, and if the lock is held for writing the
+ * writer inherits the priority of the calling task.
+ *
+ * @param xLock The handle of the lock being taken.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for the lock to
+ * become available for writing.  Setting xTicksToWait to 0 causes the
+ * function to return immediately if the lock is not available.
+ *
+ * @return pdPASS if the lock was taken for writing, otherwise pdFAIL.
+ *
+ * \defgroup xReadWriteLockTakeWrite xReadWriteLockTakeWrite
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockTakeWrite( xReadWriteLockHandle xLock, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockGiveWrite( xReadWriteLockHandle xLock );
+ </pre>
+ *
+ * Releases a lock that was taken for writing by xReadWriteLockTakeWrite(),
+ * disinheriting any priority the calling task inherited while it held the
+ * lock.  The highest priority waiting writer is unblocked if there is one,
+ * otherwise all the waiting readers are unblocked.
+ *
+ * @param xLock The handle of the lock being released.
+ *
+ * @return pdPASS if the lock was released, or pdFAIL if the calling task does
+ * not hold the lock for writing.
+ *
+ * \defgroup xReadWriteLockGiveWrite xReadWriteLockGiveWrite
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockGiveWrite( xReadWriteLockHandle xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockTakeReadFromISR( xReadWriteLockHandle xLock );
+ </pre>
+ *
+ * A version of xReadWriteLockTakeRead() that can be called from an interrupt
+ * service routine.  The function never blocks.  A lock taken for reading from
+ * an interrupt must be released using xReadWriteLockGiveReadFromISR() before
+ * the interrupt returns.
+ *
+ * @param xLock The handle of the lock being taken.
+ *
+ * @return pdPASS if the lock was taken for reading, or pdFAIL if the lock is
+ * held for writing or a writer is waiting for it.
+ *
+ * \defgroup xReadWriteLockTakeReadFromISR xReadWriteLockTakeReadFromISR
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockTakeReadFromISR( xReadWriteLockHandle xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xReadWriteLockGiveReadFromISR( xReadWriteLockHandle xLock, portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xReadWriteLockGiveRead() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xLock The handle of the lock being released.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the lock
+ * unblocked a writer that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt exits.  Can
+ * be NULL.
+ *
+ * @return pdPASS if the lock was released, or pdFAIL if the lock was not held
+ * for reading.
+ *
+ * \defgroup xReadWriteLockGiveReadFromISR xReadWriteLockGiveReadFromISR
+ * \ingroup ReadWriteLocks
+ */
+portBASE_TYPE xReadWriteLockGiveReadFromISR( xReadWriteLockHandle xLock, portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * read_write_lock.h
+ *
+ * <pre>
+ void vReadWriteLockDelete( xReadWriteLockHandle xLock );
+ </pre>
+ *
+ * Deletes a read/write lock.  The lock must not be held, and no task may be
+ * waiting for it, when it is deleted.
+ *
+ * @param xLock The handle of the lock being deleted.
+ *
+ * \defgroup vReadWriteLockDelete vReadWriteLockDelete
+ * \ingroup ReadWriteLocks
+ */
+void vReadWriteLockDelete( xReadWriteLockHandle xLock ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* READ_WRITE_LOCK_H */
+
@@ -0,0 +1,253 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A ring buffer passes fixed size items from a single producer to a single
+ * consumer - typically from an interrupt service routine to a task.  The
+ * number of slots is a power of two, and the head and tail counts are each
+ * only ever written by one side, so sending and receiving an item never masks
+ * interrupts or enters a critical section.  The consumer is only notified when
+ * the ring goes from empty to not empty, and only if it is actually blocked
+ * waiting, so a producer that keeps the ring from running empty does nothing
+ * more than copy the item and update its count.
+ *
+ * Shared data is ordered using portMEMORY_BARRIER().  On a single core part a
+ * compiler barrier is sufficient.  If the producer and consumer run on
+ * different cores then portMEMORY_BARRIER() must be a full hardware memory
+ * barrier.
+ *
+ * IMPORTANT NOTE:  Ring buffers assume there is only one producer and only
+ * one consumer.  If there are multiple producers (or multiple consumers) then
+ * calls to the sending (or receiving) API functions must be serialised by the
+ * application, or a queue used instead.
+ *
+ * Only the consumer can block.  The producer is told the ring is full by the
+ * send functions returning pdFAIL.  Ring buffers use direct to task
+ * notifications to unblock the consumer, so configUSE_TASK_NOTIFICATIONS must
+ * not be set to 0 in FreeRTOSConfig.h when ring buffers are used.  A task that
+ * is blocked on a ring buffer must not also be blocked in a call to
+ * xTaskNotifyWait() or ulTaskNotifyTake().
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include ring_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which ring buffers are referenced.  For example, a call to
+ * xRingBufferCreate() returns an xRingBufferHandle variable that can then be
+ * used as a parameter to xRingBufferSendFromISR(), xRingBufferReceive(), etc.
+ */
+typedef void * xRingBufferHandle;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ xRingBufferHandle xRingBufferCreate( unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize );
+ </pre>
+ *
+ * Creates a new ring buffer.
+ *
+ * @param uxNumberOfSlots The maximum number of items the ring buffer can hold.
+ * Must be a power of two.
+ *
+ * @param uxSlotSize The size, in bytes, of each item.
+ *
+ * @return If NULL is returned then the ring buffer could not be created,
+ * either because there was insufficient heap memory available or because
+ * uxNumberOfSlots is not a power of two.  Any other value is the handle of
+ * the created ring buffer.
+ *
+ * \defgroup xRingBufferCreate xRingBufferCreate
+ * \ingroup RingBufferManagement
+ */
+xRingBufferHandle xRingBufferCreate( unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ xRingBufferHandle xRingBufferCreateStatic( unsigned portBASE_TYPE uxNumberOfSlots,
+                                            unsigned portBASE_TYPE uxSlotSize,
+                                            unsigned char *pucRingBufferStorageArea,
+                                            xStaticRingBuffer *pxStaticRingBuffer );
+ </pre>
+ *
+ * Creates a new ring buffer using memory supplied by the application instead
+ * of memory obtained from the FreeRTOS heap.  configSUPPORT_STATIC_ALLOCATION
+ * must be set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param uxNumberOfSlots As for xRingBufferCreate().
+ *
+ * @param uxSlotSize As for xRingBufferCreate().
+ *
+ * @param pucRingBufferStorageArea Must point to an array of at least
+ * ( uxNumberOfSlots * uxSlotSize ) bytes, into which items are copied.
+ *
+ * @param pxStaticRingBuffer Must point to a variable of type
+ * xStaticRingBuffer, which will be used to hold the ring buffer's data
+ * structure.
+ *
+ * @return The handle of the created ring buffer, or NULL if uxNumberOfSlots
+ * is not a power of two or either buffer is NULL.
+ *
+ * \defgroup xRingBufferCreateStatic xRingBufferCreateStatic
+ * \ingroup RingBufferManagement
+ */
+xRingBufferHandle xRingBufferCreateStatic( unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize, unsigned char *pucRingBufferStorageArea, xStaticRingBuffer *pxStaticRingBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ portBASE_TYPE xRingBufferSendFromISR( xRingBufferHandle xRingBuffer, const void *pvItem, signed portBASE_TYPE * const pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Copies an item into the ring buffer.  The function never blocks, and only
+ * interacts with the scheduler if the ring buffer was empty and the consumer
+ * is blocked waiting for an item.
+ *
+ * Use xRingBufferSendFromISR() from an interrupt service routine.  Use
+ * xRingBufferSend() from a task.
+ *
+ * @param xRingBuffer The handle of the ring buffer to which the item is sent.
+ *
+ * @param pvItem A pointer to the item to copy into the ring buffer.  The
+ * number of bytes copied is the slot size passed to xRingBufferCreate().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a consumer that has a priority above the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was sent, or pdFAIL if the ring buffer was full.
+ *
+ * \defgroup xRingBufferSendFromISR xRingBufferSendFromISR
+ * \ingroup RingBufferManagement
+ */
+portBASE_TYPE xRingBufferSendFromISR( xRingBufferHandle xRingBuffer, const void *pvItem, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xRingBufferSend( xRingBufferHandle xRingBuffer, const void *pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ portBASE_TYPE xRingBufferReceive( xRingBufferHandle xRingBuffer, void *pvBuffer, portTickType xTicksToWait );
+ </pre>
+ *
+ * Copies the oldest item out of the ring buffer, optionally blocking to wait
+ * for an item if the ring buffer is empty.
+ *
+ * Use xRingBufferReceive() from a task.  Use xRingBufferReceiveFromISR() from
+ * an interrupt service routine - the interrupt version never blocks.
+ *
+ * @param xRingBuffer The handle of the ring buffer from which the item is
+ * received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item if the
+ * ring buffer is empty.
+ *
+ * @return pdPASS if an item was received, or pdFAIL if the ring buffer was
+ * empty and remained empty for the block time.
+ *
+ * \defgroup xRingBufferReceive xRingBufferReceive
+ * \ingroup RingBufferManagement
+ */
+portBASE_TYPE xRingBufferReceive( xRingBufferHandle xRingBuffer, void *pvBuffer, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xRingBufferReceiveFromISR( xRingBufferHandle xRingBuffer, void *pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxRingBufferItemsWaiting( xRingBufferHandle xRingBuffer );
+ </pre>
+ *
+ * Returns the number of items in the ring buffer.  Can be called by either
+ * side, from a task or an interrupt.
+ *
+ * \defgroup uxRingBufferItemsWaiting uxRingBufferItemsWaiting
+ * \ingroup RingBufferManagement
+ */
+unsigned portBASE_TYPE uxRingBufferItemsWaiting( xRingBufferHandle xRingBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_buffer.h
+ *
+ * <pre>
+ void vRingBufferDelete( xRingBufferHandle xRingBuffer );
+ </pre>
+ *
+ * Deletes a ring buffer.  No task may be blocked on the ring buffer when it is
+ * deleted.  Memory supplied to xRingBufferCreateStatic() is not freed.
+ *
+ * \defgroup vRingBufferDelete vRingBufferDelete
+ * \ingroup RingBufferManagement
+ */
+void vRingBufferDelete( xRingBufferHandle xRingBuffer ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RING_BUFFER_H */
+
@@ -62,6 +62,10 @@
 
 typedef xQueueHandle xSemaphoreHandle;
 
+/* The static semaphore creation macros take a pointer to a variable of this
+type, which is used to hold the semaphore's state. */
+typedef xStaticQueue xStaticSemaphore;
+
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1U )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0U )
 #define semGIVE_BLOCK_TIME					( ( portTickType ) 0U )
@@ -114,6 +118,30 @@ typedef xQueueHandle xSemaphoreHandle;
 		}																																		\
 	}
 
+/**
+ * semphr. h
+ * <pre>vSemaphoreCreateBinaryStatic( xSemaphoreHandle xSemaphore, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * As vSemaphoreCreateBinary(), but the semaphore's state is held in the
+ * variable pointed to by pxSemaphoreBuffer rather than in memory allocated
+ * from the FreeRTOS heap.  The variable must remain valid for the lifetime of
+ * the semaphore.
+ *
+ * \defgroup vSemaphoreCreateBinaryStatic vSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#define vSemaphoreCreateBinaryStatic( xSemaphore, pxSemaphoreBuffer )																			\
+	{																																			\
+		( xSemaphore ) = xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE );	\
+		if( ( xSemaphore ) != NULL )																											\
+		{																																		\
+			xSemaphoreGive( ( xSemaphore ) );																									\
+		}																																		\
+	}
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
@@ -181,6 +209,29 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreTake( xSemaphore, xBlockTime )		xQueueGenericReceive( ( xQueueHandle ) ( xSemaphore ), NULL, ( xBlockTime ), pdFALSE )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreTakeUntil(
+ *                   xSemaphoreHandle xSemaphore,
+ *                   portTickType xWakeTime
+ *               )</pre>
+ *
+ * <i>Macro</i> to obtain a semaphore or mutex, blocking until the tick count
+ * reaches xWakeTime at the latest.  See xQueueReceiveUntil() for how the wake
+ * time is interpreted.  Requires configUSE_ABSOLUTE_TIMEOUTS to be set to 1.
+ *
+ * @param xSemaphore A handle to the semaphore being taken.
+ *
+ * @param xWakeTime The tick count at which to stop waiting for the semaphore.
+ *
+ * @return pdTRUE if the semaphore was obtained.  pdFALSE if xWakeTime was
+ * reached without the semaphore becoming available.
+ *
+ * \defgroup xSemaphoreTakeUntil xSemaphoreTakeUntil
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeUntil( xSemaphore, xWakeTime )	xQueueGenericReceiveUntil( ( xQueueHandle ) ( xSemaphore ), NULL, ( xWakeTime ), pdFALSE )
+
 /**
  * semphr. h
  * xSemaphoreTakeRecursive( 
@@ -274,6 +325,23 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreTakeRecursive( xMutex, xBlockTime )	xQueueTakeMutexRecursive( ( xMutex ), ( xBlockTime ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreTakeRecursiveUntil(
+ *                          xSemaphoreHandle xMutex,
+ *                          portTickType xWakeTime
+ *                        )</pre>
+ *
+ * <i>Macro</i> to recursively obtain a mutex, blocking until the tick count
+ * reaches xWakeTime at the latest.  See xQueueReceiveUntil() for how the wake
+ * time is interpreted.  Requires configUSE_RECURSIVE_MUTEXES and
+ * configUSE_ABSOLUTE_TIMEOUTS to be set to 1.
+ *
+ * \defgroup xSemaphoreTakeRecursiveUntil xSemaphoreTakeRecursiveUntil
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeRecursiveUntil( xMutex, xWakeTime )	xQueueTakeMutexRecursiveUntil( ( xMutex ), ( xWakeTime ) )
+
 
 /* 
  * xSemaphoreAltTake() is an alternative version of xSemaphoreTake().
@@ -588,6 +656,23 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * As xSemaphoreCreateMutex(), but the mutex's state is held in the variable
+ * pointed to by pxMutexBuffer rather than in memory allocated from the
+ * FreeRTOS heap.  The variable must remain valid for the lifetime of the
+ * mutex.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+
 
 /**
  * semphr. h
@@ -643,6 +728,22 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * As xSemaphoreCreateRecursiveMutex(), but the mutex's state is held in the
+ * variable pointed to by pxMutexBuffer rather than in memory allocated from
+ * the FreeRTOS heap.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxMutexBuffer ) )
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
@@ -706,6 +807,155 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * As xSemaphoreCreateCounting(), but the semaphore's state is held in the
+ * variable pointed to by pxSemaphoreBuffer rather than in memory allocated
+ * from the FreeRTOS heap.
+ *
+ * \defgroup xSemaphoreCreateCountingStatic xSemaphoreCreateCountingStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreGiveMultiple( xSemaphoreHandle xSemaphore, unsigned portBASE_TYPE uxCount )</pre>
+ *
+ * <i>Macro</i> to give uxCount units of a counting semaphore in one
+ * operation.  Either all uxCount units are given or, if that would take the
+ * count above the maximum the semaphore was created with, none are.
+ *
+ * The count is raised in a single critical section, and up to one waiting
+ * task is unblocked per unit given.  This is much cheaper than calling
+ * xSemaphoreGive() uxCount times when, for example, a batch of buffers is
+ * returned to a pool.
+ *
+ * Must not be used with a mutex or a binary semaphore.
+ *
+ * @param xSemaphore A handle to the counting semaphore being given.
+ *
+ * @param uxCount The number of units to give.
+ *
+ * @return pdTRUE if the units were given, otherwise pdFALSE.
+ *
+ * Example usage:
+ <pre>
+ #define POOL_SIZE 32
+
+ // Counts the free DMA descriptors in a pool.
+ xSemaphoreHandle xFreeDescriptors;
+
+ void vDMACompleteTask( void * pvParameters )
+ {
+ unsigned portBASE_TYPE uxDone;
+
+    for( ;; )
+    {
+        uxDone = uxWaitForCompletedDescriptors();
+
+        // Return every descriptor the transfer used in one call.
+        xSemaphoreGiveMultiple( xFreeDescriptors, uxDone );
+    }
+ }
+ </pre>
+ * \defgroup xSemaphoreGiveMultiple xSemaphoreGiveMultiple
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveMultiple( xSemaphore, uxCount )		xQueueSemaphoreGiveMultiple( ( xQueueHandle ) ( xSemaphore ), ( uxCount ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreGiveMultipleFromISR( xSemaphoreHandle xSemaphore, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )</pre>
+ *
+ * A version of xSemaphoreGiveMultiple() that can be used from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the units
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdTRUE if the units were given, otherwise pdFALSE.
+ *
+ * \defgroup xSemaphoreGiveMultipleFromISR xSemaphoreGiveMultipleFromISR
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveMultipleFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )	xQueueSemaphoreGiveMultipleFromISR( ( xQueueHandle ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreTakeMultiple( xSemaphoreHandle xSemaphore, unsigned portBASE_TYPE uxCount, portTickType xBlockTime )</pre>
+ *
+ * <i>Macro</i> to take uxCount units of a counting semaphore in one
+ * operation.  The calling task either obtains all uxCount units or none: if
+ * fewer are available it blocks, for at most xBlockTime ticks, until they all
+ * are.
+ *
+ * While a task waits here, units given to the semaphore are kept for it
+ * rather than used to unblock lower priority tasks waiting on the semaphore,
+ * so a request for many units is not starved by requests for few.  Units
+ * still available when the task leaves are passed on to the tasks that are
+ * waiting.
+ *
+ * uxCount must not be larger than the maximum count of the semaphore.  Must
+ * not be used with a mutex or a binary semaphore.
+ *
+ * @param xSemaphore A handle to the counting semaphore being taken.
+ *
+ * @param uxCount The number of units to take.
+ *
+ * @param xBlockTime The time in ticks to wait for the units to become
+ * available.  The macro portTICK_RATE_MS can be used to convert this to a
+ * real time.  A block time of zero can be used to poll the semaphore.
+ *
+ * @return pdTRUE if all uxCount units were obtained, pdFALSE if xBlockTime
+ * expired first, in which case none were.
+ *
+ * Example usage:
+ <pre>
+ void vTransmitTask( void * pvParameters )
+ {
+    for( ;; )
+    {
+        // A frame needs 16 descriptors, wait up to 10 ticks for them all.
+        if( xSemaphoreTakeMultiple( xFreeDescriptors, 16, 10 ) == pdTRUE )
+        {
+            vStartTransfer();
+        }
+    }
+ }
+ </pre>
+ * \defgroup xSemaphoreTakeMultiple xSemaphoreTakeMultiple
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeMultiple( xSemaphore, uxCount, xBlockTime )		xQueueSemaphoreTakeMultiple( ( xQueueHandle ) ( xSemaphore ), ( uxCount ), ( xBlockTime ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreTakeMultipleFromISR( xSemaphoreHandle xSemaphore, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )</pre>
+ *
+ * A version of xSemaphoreTakeMultiple() that can be used from an interrupt
+ * service routine.  It never blocks: either all uxCount units are available
+ * and taken, or none are.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if taking the units
+ * unblocked a task with a priority higher than the currently running task,
+ * in which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdTRUE if all uxCount units were obtained, otherwise pdFALSE.
+ *
+ * \defgroup xSemaphoreTakeMultipleFromISR xSemaphoreTakeMultipleFromISR
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeMultipleFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )	xQueueSemaphoreTakeMultipleFromISR( ( xQueueHandle ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+
 /**
  * semphr. h
  * <pre>void vSemaphoreDelete( xSemaphoreHandle xSemaphore );</pre>
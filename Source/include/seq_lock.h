@@ -0,0 +1,249 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*
+ * A sequence lock protects data that is read far more often than it is
+ * written, such as a multi-word sensor reading that an interrupt updates and
+ * many tasks read.  The writer increments a sequence count before and after
+ * each update, so the count is odd while an update is in progress.  A reader
+ * notes the count, copies the data, then checks the count again - if it is
+ * odd or has changed then the copy may be inconsistent and the reader tries
+ * again.  Readers do not mask interrupts, block or write to the lock, so any
+ * number of tasks can read the data without adding to interrupt latency.
+ *
+ * Writers are serialised with each other by masking interrupts for the
+ * duration of the update - vSeqLockWriteBegin() enters a critical section and
+ * vSeqLockWriteEnd() leaves it, and the FromISR() versions do the same from an
+ * interrupt.  Updates should therefore be kept short.  A consequence is that a
+ * task or an interrupt at or below configMAX_SYSCALL_INTERRUPT_PRIORITY can
+ * never interrupt an update on the same core, so on a single core part such a
+ * reader only ever has to retry if an update happened between its two checks.
+ * An interrupt above configMAX_SYSCALL_INTERRUPT_PRIORITY must not write, and
+ * if it reads it must not retry in a loop, as the update it interrupted cannot
+ * complete until it exits - it should treat a failed read as "no data".
+ *
+ * The count is ordered with the data using portMEMORY_BARRIER().  On a single
+ * core part a compiler barrier is sufficient.  If readers and writers run on
+ * different cores then portMEMORY_BARRIER() must be a full hardware memory
+ * barrier.
+ *
+ * A sequence lock is a structure of type xSeqLock that is declared by the
+ * application.  It must be initialised using vSeqLockInitialise() before it is
+ * used, unless it is a global or static variable and so starts as zero.  The
+ * kernel does not need to be configured to use sequence locks, but
+ * Source/seq_lock.c must be added to the project.
+ *
+ * Example use, where xReading is written by an interrupt and read by tasks:
+ <pre>
+ static xSeqLock xReadingLock;
+ static xSensorReading xReading;
+
+ void vSensorISR( void )
+ {
+ unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = uxSeqLockWriteBeginFromISR( &xReadingLock );
+	{
+		xReading.lX = lReadX();
+		xReading.lY = lReadY();
+		xReading.lZ = lReadZ();
+	}
+	vSeqLockWriteEndFromISR( &xReadingLock, uxSavedInterruptStatus );
+ }
+
+ void vGetReading( xSensorReading *pxCopy )
+ {
+ unsigned portBASE_TYPE uxSequence;
+
+	do
+	{
+		uxSequence = uxSeqLockReadBegin( &xReadingLock );
+		*pxCopy = xReading;
+	} while( xSeqLockReadRetry( &xReadingLock, uxSequence ) != pdFALSE );
+ }
+ </pre>
+ */
+
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include seq_lock.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The sequence lock itself.  The application should not access the member
+ * directly.
+ */
+typedef struct xSEQ_LOCK
+{
+	volatile unsigned portBASE_TYPE uxSequence;		/*< Incremented before and after every update, so odd while an update is in progress. */
+} xSeqLock;
+
+/**
+ * seq_lock.h
+ *
+ * <pre>
+ void vSeqLockInitialise( xSeqLock *pxSeqLock );
+ </pre>
+ *
+ * Initialises a sequence lock.  Must not be called while the lock is in use.
+ *
+ * @param pxSeqLock The lock being initialised.
+ *
+ * \defgroup vSeqLockInitialise vSeqLockInitialise
+ * \ingroup SeqLocks
+ */
+void vSeqLockInitialise( xSeqLock *pxSeqLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * seq_lock.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxSeqLockReadBegin( const xSeqLock *pxSeqLock );
+ </pre>
+ *
+ * Starts reading the data protected by a sequence lock.  The value returned
+ * must be passed to xSeqLockReadRetry() once the data has been read.  The
+ * data must only be copied between the two calls - nothing read can be relied
+ * upon, or acted on, until xSeqLockReadRetry() has returned pdFALSE.  Can be
+ * called from a task or an interrupt of any priority.
+ *
+ * @param pxSeqLock The lock that protects the data.
+ *
+ * @return The sequence count at the start of the read.
+ *
+ * \defgroup uxSeqLockReadBegin uxSeqLockReadBegin
+ * \ingroup SeqLocks
+ */
+unsigned portBASE_TYPE uxSeqLockReadBegin( const xSeqLock *pxSeqLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * seq_lock.h
+ *
+ * <pre>
+ portBASE_TYPE xSeqLockReadRetry( const xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSequence );
+ </pre>
+ *
+ * Finishes reading the data protected by a sequence lock.
+ *
+ * @param pxSeqLock The lock that protects the data.
+ *
+ * @param uxSequence The value returned by the uxSeqLockReadBegin() call that
+ * started the read.
+ *
+ * @return pdFALSE if the data was not updated while it was being read, so the
+ * copy is consistent.  pdTRUE if the data could have changed, in which case
+ * the copy must be discarded and the read started again.
+ *
+ * \defgroup xSeqLockReadRetry xSeqLockReadRetry
+ * \ingroup SeqLocks
+ */
+portBASE_TYPE xSeqLockReadRetry( const xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSequence ) PRIVILEGED_FUNCTION;
+
+/**
+ * seq_lock.h
+ *
+ * <pre>
+ void vSeqLockWriteBegin( xSeqLock *pxSeqLock );
+ void vSeqLockWriteEnd( xSeqLock *pxSeqLock );
+ </pre>
+ *
+ * Bracket an update of the data protected by a sequence lock from a task.
+ * vSeqLockWriteBegin() enters a critical section that vSeqLockWriteEnd()
+ * leaves, so the update must not call any API function that could block.
+ *
+ * @param pxSeqLock The lock that protects the data.
+ *
+ * \defgroup vSeqLockWriteBegin vSeqLockWriteBegin
+ * \ingroup SeqLocks
+ */
+void vSeqLockWriteBegin( xSeqLock *pxSeqLock ) PRIVILEGED_FUNCTION;
+void vSeqLockWriteEnd( xSeqLock *pxSeqLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * seq_lock.h
+ *
+ * <pre>
+ unsigned portBASE_TYPE uxSeqLockWriteBeginFromISR( xSeqLock *pxSeqLock );
+ void vSeqLockWriteEndFromISR( xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSavedInterruptStatus );
+ </pre>
+ *
+ * Versions of vSeqLockWriteBegin() and vSeqLockWriteEnd() that can be used
+ * from an interrupt at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * @param pxSeqLock The lock that protects the data.
+ *
+ * @param uxSavedInterruptStatus The value returned by the
+ * uxSeqLockWriteBeginFromISR() call that started the update.
+ *
+ * @return uxSeqLockWriteBeginFromISR() returns the interrupt mask that was in
+ * effect before the update started, which must be passed to
+ * vSeqLockWriteEndFromISR().
+ *
+ * \defgroup uxSeqLockWriteBeginFromISR uxSeqLockWriteBeginFromISR
+ * \ingroup SeqLocks
+ */
+unsigned portBASE_TYPE uxSeqLockWriteBeginFromISR( xSeqLock *pxSeqLock ) PRIVILEGED_FUNCTION;
+void vSeqLockWriteEndFromISR( xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQ_LOCK_H */
+
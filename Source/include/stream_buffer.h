@@ -0,0 +1,544 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+
+/*
+ * Stream buffers are used to send a continuous stream of bytes from a single
+ * writer to a single reader - for example from an interrupt service routine to
+ * a task, or from one task to another.  Unlike a queue, which copies items one
+ * at a time inside a critical section, a stream buffer copies any number of
+ * bytes per call and the read and write indexes are each only ever updated by
+ * one side, so no critical section is needed to move data.
+ *
+ * IMPORTANT NOTE:  Stream buffers assume there is only one writer and only one
+ * reader.  If there are multiple writers (or multiple readers) then calls to
+ * the writing (or reading) API functions must be serialised by the
+ * application, for example by placing them inside a critical section.
+ *
+ * Stream buffers use direct to task notifications to block and unblock the
+ * reader and writer, so configUSE_TASK_NOTIFICATIONS must not be set to 0 in
+ * FreeRTOSConfig.h when stream buffers are used.  A task that is blocked on a
+ * stream buffer must not also be blocked in a call to xTaskNotifyWait() or
+ * ulTaskNotifyTake().
+ */
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns an xStreamBufferHandle variable that can
+ * then be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(),
+ * etc.
+ */
+typedef void * xStreamBufferHandle;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ </pre>
+ *
+ * Creates a new stream buffer.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task that is blocked on the stream buffer to wait for data is
+ * moved out of the blocked state.  For example, if a task is blocked on a read
+ * of an empty stream buffer that has a trigger level of 1 then the task will be
+ * unblocked when a single byte is written to the buffer or the task's block
+ * time expires.  As another example, if a task is blocked on a read of an empty
+ * stream buffer that has a trigger level of 10 then the task will not be
+ * unblocked until the stream buffer contains at least 10 bytes or the task's
+ * block time expires.  If a reading task's block time expires before the
+ * trigger level is reached then the task will still receive however many bytes
+ * are actually available.  Setting a trigger level of 0 will result in a
+ * trigger level of 1 being used.  It is not valid to specify a trigger level
+ * that is greater than the buffer size.
+ *
+ * @return If NULL is returned, then the stream buffer cannot be created
+ * because there is insufficient heap memory available for FreeRTOS to allocate
+ * the stream buffer data structures and storage area.  A non-NULL value being
+ * returned indicates that the stream buffer has been created successfully -
+ * the returned value should be stored as the handle to the created stream
+ * buffer.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes,
+                                                size_t xTriggerLevelBytes,
+                                                unsigned char *pucStreamBufferStorageArea,
+                                                xStaticStreamBuffer *pxStaticStreamBuffer );
+ </pre>
+ *
+ * Creates a new stream buffer using memory supplied by the application
+ * instead of memory obtained from the FreeRTOS heap.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Placing both buffers in memory that is shared between the cores of an
+ * asymmetric multicore part, such as the LPC43xx, allows a task on one core
+ * to stream data to a task on the other core, each core running its own
+ * copy of FreeRTOS.  One core creates the stream buffer and passes the handle
+ * to the other through an agreed shared memory location.  To allow the tasks
+ * to block, define sbSEND_COMPLETED() and sbRECEIVE_COMPLETED() (and their
+ * _FROM_ISR versions) in FreeRTOSConfig.h to generate an inter-processor
+ * interrupt, and have the handler of that interrupt call
+ * xStreamBufferSendCompletedFromISR() or xStreamBufferReceiveCompletedFromISR().
+ * xStreamBufferWriteReserve() and xStreamBufferReadAcquire() let large
+ * payloads be produced and consumed in the shared memory without copying.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes See xStreamBufferCreate().
+ *
+ * @param pucStreamBufferStorageArea Must point to an array of at least
+ * xBufferSizeBytes + 1 bytes.  The extra byte allows a full buffer to be
+ * distinguished from an empty one.
+ *
+ * @param pxStaticStreamBuffer Must point to a variable of type
+ * xStaticStreamBuffer, which will be used to hold the stream buffer's data
+ * structure.
+ *
+ * @return The handle of the created stream buffer, or NULL if
+ * pucStreamBufferStorageArea or pxStaticStreamBuffer are NULL.
+ *
+ * Example usage:
+   <pre>
+ // Used on the M4 to send to the M0.  The M0 application reads the handle
+ // from ucSharedHandleLocation.
+ #define BUFFER_SIZE 400
+
+ static unsigned char ucStorage[ BUFFER_SIZE + 1 ] __attribute__( ( section( ".shared" ) ) );
+ static xStaticStreamBuffer xStreamBufferStruct __attribute__( ( section( ".shared" ) ) );
+
+ void vCreateChannel( void )
+ {
+	xM4ToM0 = xStreamBufferCreateStatic( BUFFER_SIZE, 1, ucStorage, &xStreamBufferStruct );
+ }
+
+ // FreeRTOSConfig.h on both cores.
+ #define sbSEND_COMPLETED( pxStreamBuffer ) vGenerateCrossCoreInterrupt()
+ #define sbSEND_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) vGenerateCrossCoreInterrupt()
+
+ // Inter-processor interrupt handler on the M0.
+ void vCrossCoreInterruptHandler( void )
+ {
+ signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	vClearCrossCoreInterrupt();
+	xStreamBufferSendCompletedFromISR( xM4ToM0, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ }
+   </pre>
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBufferManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char *pucStreamBufferStorageArea, xStaticStreamBuffer *pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer,
+						  const void *pvTxData,
+						  size_t xDataLengthBytes,
+						  portTickType xTicksToWait );
+ </pre>
+ *
+ * Sends bytes to a stream buffer.  The bytes are copied into the stream buffer.
+ *
+ * Use xStreamBufferSend() to write to a stream buffer from a task.  Use
+ * xStreamBufferSendFromISR() to write to a stream buffer from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which a stream is
+ * being sent.
+ *
+ * @param pvTxData A pointer to the buffer that holds the bytes to be copied
+ * into the stream buffer.
+ *
+ * @param xDataLengthBytes   The maximum number of bytes to copy from pvTxData
+ * into the stream buffer.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space to become available in the stream
+ * buffer, should the stream buffer contain too little space to hold
+ * another xDataLengthBytes bytes.  If a task times out before it can write all
+ * xDataLengthBytes into the buffer it will still write as many bytes as
+ * possible.  If xTicksToWait is 0 the call will not block.
+ *
+ * @return The number of bytes written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer,
+								 const void *pvTxData,
+								 size_t xDataLengthBytes,
+								 signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xStreamBufferSend().  As many of the
+ * xDataLengthBytes bytes as will fit are written - the function never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken  It is possible that a stream buffer will
+ * have a task blocked on it waiting for data.  Calling
+ * xStreamBufferSendFromISR() can make data available, and so cause a task that
+ * was waiting for data to leave the Blocked state.  If calling
+ * xStreamBufferSendFromISR() causes a task to leave the Blocked state, and the
+ * unblocked task has a priority higher than the currently executing task (the
+ * task that was interrupted), then, internally, xStreamBufferSendFromISR()
+ * will set *pxHigherPriorityTaskWoken to pdTRUE.  If
+ * xStreamBufferSendFromISR() sets this value to pdTRUE, then normally a
+ * context switch should be performed before the interrupt is exited.
+ *
+ * @return The number of bytes actually written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer,
+							 void *pvRxData,
+							 size_t xBufferLengthBytes,
+							 portTickType xTicksToWait );
+ </pre>
+ *
+ * Receives bytes from a stream buffer.
+ *
+ * Use xStreamBufferReceive() to read from a stream buffer from a task.  Use
+ * xStreamBufferReceiveFromISR() to read from a stream buffer from an
+ * interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which bytes are to
+ * be received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received bytes will be
+ * copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by the
+ * pvRxData parameter.  This sets the maximum number of bytes to receive in one
+ * call.  xStreamBufferReceive will return as many bytes as possible up to a
+ * maximum set by xBufferLengthBytes.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data to become available if the stream buffer is
+ * empty.  xStreamBufferReceive() will return immediately if xTicksToWait is
+ * zero.  A task does not use any CPU time when it is in the Blocked state.
+ *
+ * @return The number of bytes actually read from the stream buffer, which will
+ * be less than xBufferLengthBytes if the call to xStreamBufferReceive() timed
+ * out before xBufferLengthBytes were available.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer,
+									void *pvRxData,
+									size_t xBufferLengthBytes,
+									signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * An interrupt safe version of the API function that receives bytes from a
+ * stream buffer.  *pxHigherPriorityTaskWoken is set to pdTRUE if reading from
+ * the buffer unblocked a writer that has a priority above the interrupted task.
+ *
+ * @return The number of bytes read from the stream buffer, if any.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferWriteReserve( xStreamBufferHandle xStreamBuffer, void **ppvWriteRegion );
+ </pre>
+ *
+ * Obtain a pointer into the stream buffer's own storage area to which the
+ * writer can write directly, so bytes produced by, for example, a peripheral
+ * FIFO or DMA transfer do not have to pass through an intermediate buffer.
+ * The bytes written become visible to the reader only when
+ * xStreamBufferWriteCommit() or xStreamBufferWriteCommitFromISR() is called.
+ *
+ * This function does not block and can be used from a task or an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param ppvWriteRegion Set to point to the start of the free region.
+ *
+ * @return The number of contiguous bytes that can be written starting at
+ * *ppvWriteRegion.  This can be less than the total free space when the free
+ * space wraps around the end of the storage area - in which case a second
+ * reserve after the commit returns the remainder.
+ *
+ * Example usage:
+   <pre>
+ void vAnInterruptHandler( void )
+ {
+ signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+ unsigned char *pucDestination;
+ size_t xSpace, xBytes = 0;
+
+	// Move all the bytes held in the peripheral FIFO straight into the
+	// stream buffer.
+	xSpace = xStreamBufferWriteReserve( xRxStream, ( void ** ) &pucDestination );
+	while( ( xBytes < xSpace ) && ( prvFIFONotEmpty() != pdFALSE ) )
+	{
+		pucDestination[ xBytes ] = prvReadFIFO();
+		xBytes++;
+	}
+
+	// Publish all the bytes with a single index update.
+	xStreamBufferWriteCommitFromISR( xRxStream, xBytes, &xHigherPriorityTaskWoken );
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ }
+   </pre>
+ * \defgroup xStreamBufferWriteReserve xStreamBufferWriteReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferWriteReserve( xStreamBufferHandle xStreamBuffer, void **ppvWriteRegion ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ void vStreamBufferWriteCommit( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten );
+ void vStreamBufferWriteCommitFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Make xBytesWritten bytes written to the region returned by
+ * xStreamBufferWriteReserve() available to the reader, unblocking the reader
+ * if the trigger level has been reached.  xBytesWritten must not be greater
+ * than the value returned by the matching xStreamBufferWriteReserve() call.
+ *
+ * \defgroup vStreamBufferWriteCommit vStreamBufferWriteCommit
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferWriteCommit( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+void vStreamBufferWriteCommitFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ size_t xStreamBufferReadAcquire( xStreamBufferHandle xStreamBuffer, const void **ppvReadRegion );
+ </pre>
+ *
+ * The reading equivalent of xStreamBufferWriteReserve().  Obtain a pointer to
+ * the bytes held in the stream buffer so they can be consumed in place, for
+ * example by feeding them directly into a UART transmit FIFO.  The bytes are
+ * not removed from the buffer until vStreamBufferReadRelease() or
+ * vStreamBufferReadReleaseFromISR() is called.
+ *
+ * This function does not block and can be used from a task or an interrupt.
+ *
+ * @return The number of contiguous bytes available starting at
+ * *ppvReadRegion.
+ *
+ * \defgroup xStreamBufferReadAcquire xStreamBufferReadAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReadAcquire( xStreamBufferHandle xStreamBuffer, const void **ppvReadRegion ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ void vStreamBufferReadRelease( xStreamBufferHandle xStreamBuffer, size_t xBytesRead );
+ void vStreamBufferReadReleaseFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesRead, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Remove xBytesRead bytes previously obtained with xStreamBufferReadAcquire()
+ * from the stream buffer, unblocking a writer that is waiting for space.
+ *
+ * \defgroup vStreamBufferReadRelease vStreamBufferReadRelease
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReadRelease( xStreamBufferHandle xStreamBuffer, size_t xBytesRead ) PRIVILEGED_FUNCTION;
+void vStreamBufferReadReleaseFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesRead, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * Query functions.  xStreamBufferBytesAvailable() returns the number of bytes
+ * that can be read, xStreamBufferSpacesAvailable() the number of bytes that
+ * can be written.  xStreamBufferIsEmpty() and xStreamBufferIsFull() return
+ * pdTRUE or pdFALSE accordingly.  All four can be called from a task or an
+ * interrupt.
+ */
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xStreamBufferIsEmpty( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xStreamBufferIsFull( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel );
+ </pre>
+ *
+ * Change the trigger level of a stream buffer - see xStreamBufferCreate().
+ *
+ * @return pdPASS if the trigger level was set, or pdFAIL if xTriggerLevel is
+ * greater than the size of the stream buffer.
+ */
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer );
+ </pre>
+ *
+ * Resets a stream buffer to its initial, empty, state.  Any data that was in
+ * the stream buffer is discarded.  A stream buffer can only be reset if there
+ * are no tasks blocked waiting to either send to or receive from the stream
+ * buffer.
+ *
+ * @return pdPASS if the stream buffer was reset, otherwise pdFAIL.
+ */
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer );
+ </pre>
+ *
+ * Deletes a stream buffer that was previously created using a call to
+ * xStreamBufferCreate() or xStreamBufferCreateStatic().  Memory is only freed
+ * if it was allocated by xStreamBufferCreate().  A stream buffer must not be
+ * deleted while a task is blocked on it.
+ */
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ portBASE_TYPE xStreamBufferSendCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ portBASE_TYPE xStreamBufferReceiveCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * For use when the reader and writer of a stream buffer run on different
+ * cores - see xStreamBufferCreateStatic().  Called from the inter-processor
+ * interrupt raised by sbSEND_COMPLETED() or sbRECEIVE_COMPLETED() on the
+ * other core.  xStreamBufferSendCompletedFromISR() unblocks a task that is
+ * waiting to receive from the stream buffer, and
+ * xStreamBufferReceiveCompletedFromISR() unblocks a task that is waiting to
+ * send to it.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the unblocked task has a
+ * priority above that of the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return pdTRUE if a task was unblocked, otherwise pdFALSE.
+ */
+portBASE_TYPE xStreamBufferSendCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xStreamBufferReceiveCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
@@ -89,8 +89,12 @@ typedef void * xTaskHandle;
  */
 typedef struct xTIME_OUT
 {
-	portBASE_TYPE xOverflowCount;
-	portTickType  xTimeOnEntering;
+	#if ( configUSE_64_BIT_TICKS == 1 )
+		portTickCountType xTimeOnEntering;
+	#else
+		portBASE_TYPE xOverflowCount;
+		portTickType  xTimeOnEntering;
+	#endif
 } xTimeOutType;
 
 /*
@@ -117,6 +121,114 @@ typedef struct xTASK_PARAMTERS
 	xMemoryRegion xRegions[ portNUM_CONFIGURABLE_REGIONS ];
 } xTaskParameters;
 
+/*
+ * A job run by the idle task.  Returns pdTRUE if it has more work to do, or
+ * pdFALSE to be removed from the idle work registry.  See
+ * xTaskRegisterIdleWork().
+ */
+typedef portBASE_TYPE ( *pdIDLE_WORK_FUNCTION )( void *pvParameter, portTickType xBudget );
+
+/*
+ * A job registered with xTaskRegisterIdleWork().  The structure is owned by
+ * the kernel while the job is registered.
+ */
+typedef struct xIDLE_WORK
+{
+	pdIDLE_WORK_FUNCTION pxFunction;	/*< The job itself. */
+	void *pvParameter;					/*< Passed to the job. */
+	portTickType xBudget;				/*< The most ticks one call of the job may take. */
+	struct xIDLE_WORK *pxNext;			/*< The next job in the registry. */
+	unsigned long ulRuns;				/*< The number of times the job has been called since it was registered. */
+	unsigned long ulOverruns;			/*< The number of those calls that took longer than xBudget. */
+} xIdleWork;
+
+/*
+ * An entry of the schedule table passed to vTaskSetTimeTriggeredSchedule().
+ * The table is normally const, with each entry naming the variable the handle
+ * of the task will be stored in when it is created.
+ */
+typedef struct xTIME_TRIGGERED_ENTRY
+{
+	portTickType xOffset;				/*< The tick within the major frame at which the task is released. */
+	xTaskHandle *pxTask;				/*< The variable that holds the handle of the task released. */
+} xTimeTriggeredEntry;
+
+/* Actions that can be performed when xTaskNotify() is called. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without updating its notify value. */
+	eSetBits,					/* Set bits in the task's notification value. */
+	eIncrement,					/* Increment the task's notification value. */
+	eSetValueWithOverwrite,		/* Set the task's notification value to a specific value even if the previous value has not yet been read by the task. */
+	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
+} eNotifyAction;
+
+/* Possible return values for eTaskConfirmSleepModeStatus(). */
+typedef enum
+{
+	eAbortSleep = 0,		/* A task has been made ready or a context switch pended since portSUPPRESS_TICKS_AND_SLEEP() was called - abort entering a sleep mode. */
+	eStandardSleep,			/* Enter a sleep mode that will not last any longer than the expected idle time. */
+	eNoTasksWaitingTimeout	/* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
+} eSleepModeStatus;
+
+/* Task states reported by uxTaskGetSystemState(). */
+typedef enum
+{
+	eRunning = 0,	/* The task is the one that is executing. */
+	eReady,			/* The task is in a ready list waiting to execute. */
+	eBlocked,		/* The task is waiting for an event or a timeout. */
+	eSuspended,		/* The task has been suspended, or is waiting for an event with no timeout. */
+	eDeleted		/* The task has been deleted but the idle task has not yet freed its memory. */
+} eTaskState;
+
+/* The lateness of the releases of a task by vTaskDelayUntil(), reported by
+uxTaskGetSystemState() when configRECORD_RELEASE_JITTER is 1.  The lateness of
+a release is the time from the tick interrupt at which the task was due to
+wake to it next being switched in, in run time counter units. */
+typedef struct xRELEASE_JITTER
+{
+	unsigned long ulReleases;							/* The number of releases timed. */
+	unsigned long ulOverruns;							/* The number of calls to vTaskDelayUntil() made after the next wake time had already passed, so the task did not block. */
+	portRUN_TIME_COUNTER_TYPE ulMinLateness;			/* The least lateness of a release.  Zero if ulReleases is 0. */
+	portRUN_TIME_COUNTER_TYPE ulMaxLateness;			/* The greatest lateness of a release. */
+	portRUN_TIME_COUNTER_TYPE ulMeanLateness;			/* The mean lateness of the releases. */
+	unsigned long ulHistogram[ configRELEASE_JITTER_BUCKETS ];	/* ulHistogram[ 0 ] counts the releases less than configRELEASE_JITTER_RESOLUTION late, and each later bucket those less than twice the limit of the one before.  The last bucket counts the rest. */
+} xReleaseJitterType;
+
+/* The time taken for a task to run once made ready, reported by
+uxTaskGetSystemState() when configRECORD_WAKE_LATENCY is 1.  A wake up is
+timed from a task that has left the Ready state - by blocking or being
+suspended - being moved back to the Ready state, by an API call or an
+interrupt, to the task next being switched in, in run time counter units. */
+typedef struct xWAKE_LATENCY
+{
+	unsigned long ulWakeUps;							/* The number of wake ups timed. */
+	portRUN_TIME_COUNTER_TYPE ulMaxLatency;				/* The longest time a woken task waited to run. */
+	portRUN_TIME_COUNTER_TYPE ulMeanLatency;			/* The mean time a woken task waited to run.  Zero if ulWakeUps is 0. */
+	unsigned long ulHistogram[ configWAKE_LATENCY_BUCKETS ];	/* ulHistogram[ 0 ] counts the wake ups followed by less than configWAKE_LATENCY_RESOLUTION before the task ran, and each later bucket those less than twice the limit of the one before.  The last bucket counts the rest. */
+} xWakeLatencyType;
+
+/* The information uxTaskGetSystemState() reports for each task. */
+typedef struct xTASK_STATUS
+{
+	xTaskHandle xHandle;						/* The handle of the task the rest of the structure describes. */
+	const signed char *pcTaskName;				/* The name given to the task when it was created. */
+	unsigned portBASE_TYPE uxTaskNumber;		/* A number unique to the task, as reported by vTaskList(). */
+	eTaskState eCurrentState;					/* The state of the task when the snapshot was taken. */
+	unsigned portBASE_TYPE uxCurrentPriority;	/* The priority the task is running at, which may be inherited. */
+	unsigned portBASE_TYPE uxBasePriority;		/* The priority the task returns to once it disinherits any mutex priority.  The same as uxCurrentPriority if configUSE_MUTEXES is 0. */
+	portRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The CPU time used by the task, in run time counter units.  Zero if configGENERATE_RUN_TIME_STATS is 0. */
+	unsigned long ulSwitchInCount;				/* The number of times the task has been switched in. */
+	portTickType xMaxBlockTime;					/* The longest time, in ticks, the task has waited between leaving the Ready state and next running. */
+	unsigned short usStackHighWaterMark;		/* The minimum amount of stack, in words, that has remained unused since the task was created. */
+	#if ( configRECORD_RELEASE_JITTER == 1 )
+		xReleaseJitterType xReleaseJitter;		/* The lateness of the releases of the task by vTaskDelayUntil(). */
+	#endif
+	#if ( configRECORD_WAKE_LATENCY == 1 )
+		xWakeLatencyType xWakeLatency;			/* The time the task took to run each time it was made ready. */
+	#endif
+} xTaskStatusType;
+
 /*
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -124,6 +236,23 @@ typedef struct xTASK_PARAMTERS
  */
 #define tskIDLE_PRIORITY			( ( unsigned portBASE_TYPE ) 0U )
 
+/*
+ * Core affinity mask that allows a task to run on any core.  Tasks are created
+ * with this affinity when configNUMBER_OF_CORES is greater than 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY				( ( unsigned portBASE_TYPE ) ~( ( unsigned portBASE_TYPE ) 0U ) )
+
+/*
+ * The averages kept by the CPU load meter, for use with usTaskGetCpuLoad().
+ *
+ * \ingroup TaskUtils
+ */
+#define tskCPU_LOAD_1_SECOND		( ( unsigned portBASE_TYPE ) 0U )
+#define tskCPU_LOAD_10_SECONDS		( ( unsigned portBASE_TYPE ) 1U )
+#define tskCPU_LOAD_60_SECONDS		( ( unsigned portBASE_TYPE ) 2U )
+
 /**
  * task. h
  *
@@ -143,10 +272,17 @@ typedef struct xTASK_PARAMTERS
  * NOTE: This may alter the stack (depending on the portable implementation)
  * so must be used with care!
  *
+ * When configNUMBER_OF_CORES is greater than 1 the kernel spinlocks are also
+ * taken, so the critical region excludes tasks and interrupts on every core.
+ *
  * \page taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+#if ( configNUMBER_OF_CORES > 1 )
+	#define taskENTER_CRITICAL()	vTaskEnterCritical()
+#else
+	#define taskENTER_CRITICAL()	portENTER_CRITICAL()
+#endif
 
 /**
  * task. h
@@ -160,7 +296,45 @@ typedef struct xTASK_PARAMTERS
  * \page taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
+#if ( configNUMBER_OF_CORES > 1 )
+	#define taskEXIT_CRITICAL()		vTaskExitCritical()
+#else
+	#define taskEXIT_CRITICAL()		portEXIT_CRITICAL()
+#endif
+
+/**
+ * task. h
+ *
+ * Macros to mark the start and end of a critical code region from within an
+ * interrupt service routine.  taskENTER_CRITICAL_FROM_ISR() returns the
+ * previous interrupt mask, which must be passed to the matching
+ * taskEXIT_CRITICAL_FROM_ISR().  When configNUMBER_OF_CORES is greater than 1
+ * the kernel ISR spinlock is also taken.
+ *
+ * \page taskENTER_CRITICAL_FROM_ISR taskENTER_CRITICAL_FROM_ISR
+ * \ingroup SchedulerControl
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+	#define taskENTER_CRITICAL_FROM_ISR()		uxTaskEnterCriticalFromISR()
+	#define taskEXIT_CRITICAL_FROM_ISR( x )		vTaskExitCriticalFromISR( x )
+#else
+	#define taskENTER_CRITICAL_FROM_ISR()		portSET_INTERRUPT_MASK_FROM_ISR()
+	#define taskEXIT_CRITICAL_FROM_ISR( x )		portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#endif
+
+/*
+ * Called by the port (or kernel) critical section code when the outermost
+ * critical section is entered, after interrupts have been masked, and when it
+ * is exited, before interrupts are unmasked.  They compile away unless
+ * configRECORD_CRITICAL_SECTION_TIME is 1.
+ */
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
+	#define taskCRITICAL_SECTION_ENTERED()		vTaskCriticalSectionEntered()
+	#define taskCRITICAL_SECTION_EXITED()		vTaskCriticalSectionExited()
+#else
+	#define taskCRITICAL_SECTION_ENTERED()
+	#define taskCRITICAL_SECTION_EXITED()
+#endif
 
 /**
  * task. h
@@ -210,6 +384,16 @@ typedef struct xTASK_PARAMTERS
  * support can alternatively create an MPU constrained task using
  * xTaskCreateRestricted().
  *
+ * When many tasks are created by a running task, create them between calls
+ * to vTaskSuspendAll() and xTaskResumeAll().  A created task of higher
+ * priority than the calling task then does not run until xTaskResumeAll() is
+ * called, so there is at most one context switch for the whole batch.
+ *
+ * The new stack is filled with a known value so its high water mark can be
+ * found later.  When configDEFER_STACK_FILL is set to 1 in FreeRTOSConfig.h
+ * only the end of the stack is filled here and the idle task fills the rest,
+ * see uxTaskGetSampledStackHighWaterMark().
+ *
  * @param pvTaskCode Pointer to the task entry function.  Tasks
  * must be implemented to never return (i.e. continuous loop).
  *
@@ -269,6 +453,64 @@ typedef struct xTASK_PARAMTERS
  */
 #define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
 
+/**
+ * task. h
+ *<pre>
+ portBASE_TYPE xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  xTaskHandle *pvCreatedTask,
+							  portSTACK_TYPE *puxStackBuffer,
+							  xStaticTask *pxTaskBuffer
+						  );</pre>
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Create a new task and add it to the list of tasks that are ready to run,
+ * using memory supplied by the caller for both the task's stack and its task
+ * control block (TCB).  Unlike xTaskCreate() nothing is allocated from the
+ * FreeRTOS heap, so the call cannot fail through lack of memory and can be
+ * used in applications that do not include a heap at all.  The memory must
+ * remain valid for the lifetime of the task - normally it is declared at
+ * file scope - and is not freed if the task is deleted.
+ *
+ * @param pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+ * pvCreatedTask As per the equivalent xTaskCreate() parameters.
+ *
+ * @param puxStackBuffer Must point to an array of at least usStackDepth
+ * portSTACK_TYPE variables, which is used as the task's stack.
+ *
+ * @param pxTaskBuffer Must point to a variable of type xStaticTask, which is
+ * used to hold the task's TCB.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file errors. h
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ // The task's stack and TCB, which must persist for the lifetime of the task.
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ // Function that creates a task.
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  *<pre>
@@ -403,6 +645,11 @@ void vTaskAllocateMPURegions( xTaskHandle xTask, const xMemoryRegion * const pxR
  * task code is not automatically freed, and should be freed before the task
  * is deleted.
  *
+ * When configTASK_RECYCLE_CACHE_SIZE is set above 0 in FreeRTOSConfig.h the
+ * idle task keeps the TCBs and stacks of up to that many deleted tasks instead
+ * of freeing them, and the next xTaskCreate() with the same stack depth uses
+ * one of them without calling pvPortMalloc().
+ *
  * See the demo application file death.c for sample code that utilises
  * vTaskDelete ().
  *
@@ -506,6 +753,11 @@ void vTaskDelay( portTickType xTicksToDelay ) PRIVILEGED_FUNCTION;
  * The constant portTICK_RATE_MS can be used to calculate real time from the tick
  * rate - with the resolution of one tick period.
  *
+ * When configRECORD_RELEASE_JITTER is 1 the time from each wake time to the
+ * task next running, and the number of calls made after the next wake time
+ * had already passed, are recorded and reported in the xReleaseJitter member
+ * of the structures filled by uxTaskGetSystemState().
+ *
  * @param pxPreviousWakeTime Pointer to a variable that holds the time at which the
  * task was last unblocked.  The variable must be initialised with the current time
  * prior to its first use (see the example below).  Following this the variable is
@@ -540,6 +792,254 @@ void vTaskDelay( portTickType xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetDeadline( xTaskHandle xTask, portTickType xRelativeDeadline );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be set to 1 in FreeRTOSConfig.h, and
+ * configEDF_PRIORITY set to a task priority, for this function to be
+ * available.
+ *
+ * Tasks at priority configEDF_PRIORITY are scheduled earliest deadline first
+ * rather than in turn.  Each call to vTaskDelayUntil() by such a task ends
+ * its current job and sets the deadline of its next job to the wake time
+ * plus xRelativeDeadline - or plus the period passed to vTaskDelayUntil() if
+ * xRelativeDeadline is 0, which is the default.  Ready tasks at that
+ * priority that have not called vTaskDelayUntil() yet run only when no task
+ * with a deadline is ready.  Tasks at other priorities are scheduled as
+ * normal, so configEDF_PRIORITY can be set between the priorities of the
+ * urgent tasks and those of the background tasks.
+ *
+ * traceTASK_DEADLINE_MISSED() is called when a task calls vTaskDelayUntil()
+ * after the deadline of the job it has just finished.
+ *
+ * Deadlines must be less than half the range of portTickType in the future.
+ *
+ * @param xTask Handle of the task.  Passing a NULL handle results in the
+ * deadline of the calling task being set.
+ *
+ * @param xRelativeDeadline The time from the release of each job of the task
+ * to its deadline, in ticks, or 0 to use the period of the task.  Takes
+ * effect from the next call to vTaskDelayUntil().
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+void vTaskSetDeadline( xTaskHandle xTask, portTickType xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetBudget( xTaskHandle xTask, portTickType xBudget, portTickType xPeriod );</pre>
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Limits the processing time a task can take at its own priority to xBudget
+ * ticks in every xPeriod ticks.  Each tick is charged to the task that was
+ * running when it occurred.  Once the budget for the current period has been
+ * used up the task is dropped to priority configBUDGET_EXHAUSTED_PRIORITY
+ * (the idle priority by default) until the start of the next period, where
+ * it gets its whole budget back and returns to its base priority.  So a busy
+ * high priority task can no longer keep lower priority tasks from running
+ * for longer than its budget allows, but it can still use time no other
+ * task wants.
+ *
+ * A task dropped while it holds a mutex can still inherit the priority of a
+ * task waiting for the mutex, and a task running at an inherited priority is
+ * not dropped until it gives the mutex back.
+ *
+ * traceTASK_BUDGET_EXHAUSTED() is called when a task is dropped and
+ * traceTASK_BUDGET_REPLENISHED() when its budget is renewed.
+ *
+ * Budgets are counted in whole ticks, so a task that runs for part of each
+ * tick period is charged for the ticks that occur while it runs.
+ *
+ * @param xTask Handle of the task.  Passing a NULL handle results in the
+ * budget of the calling task being set.
+ *
+ * @param xBudget The ticks the task may run for in each period, or 0 to
+ * remove the budget of the task.
+ *
+ * @param xPeriod The budget period in ticks, starting from the call.  Must
+ * not be less than xBudget.
+ *
+ * \defgroup vTaskSetBudget vTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+void vTaskSetBudget( xTaskHandle xTask, portTickType xBudget, portTickType xPeriod ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskSetTimeTriggeredSchedule( const xTimeTriggeredEntry *pxTable, unsigned portBASE_TYPE uxEntries, portTickType xFrameLength );</pre>
+ *
+ * configUSE_TIME_TRIGGERED_SCHEDULE must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Installs a static schedule table, which makes the tasks it names time
+ * triggered.  The schedule repeats every xFrameLength ticks (the major frame),
+ * and each entry releases a task at a fixed tick within the frame.  A time
+ * triggered task runs to completion on each release then calls
+ * vTaskWaitForActivation(), so its activations are fixed by the table rather
+ * than by events.  On each tick only the next entry of the table is looked at,
+ * so releasing a task takes the same short time however many tasks are
+ * delayed.
+ *
+ * If a task is released while it is still running its previous activation the
+ * new activation is dropped and counted as an overrun, see
+ * ulTaskGetActivationOverruns(), so one late task does not make the rest of
+ * the frame late.
+ *
+ * Ticks that pass while the scheduler is suspended are stepped through the
+ * table when xTaskResumeAll() is called, so the position within the frame
+ * always follows the tick count.  Entries passed over in that time are
+ * released late rather than skipped.
+ *
+ * Time triggered tasks should be given priorities above every event driven
+ * task, and different priorities from each other, so each release runs at a
+ * time set by the table alone.  Event driven tasks then run in the slack that
+ * remains, and are preempted by each release.
+ *
+ * The first tick after this function is called is tick 0 of the frame.  A
+ * different table can be installed at any time, for example to change mode,
+ * and passing NULL stops the releases.  A time triggered task must not be
+ * deleted while the table is installed.
+ *
+ * @param pxTable The schedule table, in order of offset.  The table is used in
+ * place, not copied.
+ *
+ * @param uxEntries The number of entries in pxTable.
+ *
+ * @param xFrameLength The length of the major frame, in ticks.  Every offset
+ * in the table must be less than this.
+ *
+ * Example usage:
+   <pre>
+ xTaskHandle xSampleTask = NULL, xControlTask = NULL;
+
+ // Sample on ticks 0 and 5, and run the control law on tick 2, of a 10 tick
+ // frame.
+ static const xTimeTriggeredEntry xSchedule[] =
+ {
+	{ 0, &xSampleTask },
+	{ 2, &xControlTask },
+	{ 5, &xSampleTask }
+ };
+
+ void vSampleTask( void *pvParameters )
+ {
+	for( ;; )
+	{
+		vTaskWaitForActivation();
+		vSampleInputs();
+	}
+ }
+
+ void main( void )
+ {
+	xTaskCreate( vSampleTask, "Sample", STACK_SIZE, NULL, 4, &xSampleTask );
+	xTaskCreate( vControlTask, "Control", STACK_SIZE, NULL, 3, &xControlTask );
+	vTaskSetTimeTriggeredSchedule( xSchedule, 3, 10 );
+	vTaskStartScheduler();
+ }
+   </pre>
+ * \defgroup vTaskSetTimeTriggeredSchedule vTaskSetTimeTriggeredSchedule
+ * \ingroup TaskCtrl
+ */
+void vTaskSetTimeTriggeredSchedule( const xTimeTriggeredEntry *pxTable, unsigned portBASE_TYPE uxEntries, portTickType xFrameLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForActivation( void );</pre>
+ *
+ * configUSE_TIME_TRIGGERED_SCHEDULE must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Called by a time triggered task when it has completed an activation, to
+ * block until the schedule table next releases it.  See
+ * vTaskSetTimeTriggeredSchedule().
+ *
+ * \defgroup vTaskWaitForActivation vTaskWaitForActivation
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForActivation( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned long ulTaskGetActivationOverruns( xTaskHandle xTask );</pre>
+ *
+ * configUSE_TIME_TRIGGERED_SCHEDULE must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xTask The task to query, or NULL for the calling task.
+ *
+ * @return The number of times the schedule table has released the task while
+ * it was still running its previous activation.
+ *
+ * \defgroup ulTaskGetActivationOverruns ulTaskGetActivationOverruns
+ * \ingroup TaskCtrl
+ */
+unsigned long ulTaskGetActivationOverruns( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskPreemptionThresholdSet( xTaskHandle xTask, unsigned portBASE_TYPE uxNewThreshold );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Sets the preemption threshold of a task.  While the task is running it can
+ * only be preempted by a task of higher priority than its threshold.  Tasks
+ * with a priority between that of the task and its threshold wait until the
+ * task blocks, suspends itself or lowers its threshold, even though they are
+ * of higher priority.  Tasks of equal priority are not time sliced with it
+ * either, and taskYIELD() only yields to a task above the threshold.  When a
+ * task above the threshold does preempt the task, the task carries on from
+ * where it was preempted as soon as no task above its threshold is ready,
+ * before any task at or below its threshold runs.  It loses that place if it
+ * leaves the Ready state while it is preempted.
+ *
+ * A group of tasks that share data can be given a threshold equal to the
+ * highest priority in the group, so no task of the group preempts another
+ * and the shared data needs no mutex.  Tasks above the threshold are not
+ * delayed, so the response times of the higher priority tasks still follow
+ * from fixed priority analysis, with the time a task of the group runs at its
+ * threshold counted as blocking.
+ *
+ * The threshold of a new task equals its priority.  A threshold that is not
+ * above the priority of the task has no effect, so a task that inherits a
+ * priority above its threshold is scheduled as normal.  A task that has used
+ * up its budget (see vTaskSetBudget()) loses its threshold until the budget
+ * is replenished.
+ *
+ * @param xTask Handle of the task.  Passing a NULL handle results in the
+ * threshold of the calling task being set.
+ *
+ * @param uxNewThreshold The new threshold, which must be less than
+ * configMAX_PRIORITIES.
+ *
+ * \defgroup vTaskPreemptionThresholdSet vTaskPreemptionThresholdSet
+ * \ingroup TaskCtrl
+ */
+void vTaskPreemptionThresholdSet( xTaskHandle xTask, unsigned portBASE_TYPE uxNewThreshold ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskPreemptionThresholdGet( xTaskHandle xTask );</pre>
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the threshold of the calling task being returned.
+ *
+ * @return The preemption threshold last set for the task, or the priority it
+ * was created with if its threshold has never been set.
+ *
+ * \defgroup uxTaskPreemptionThresholdGet uxTaskPreemptionThresholdGet
+ * \ingroup TaskCtrl
+ */
+unsigned portBASE_TYPE uxTaskPreemptionThresholdGet( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle pxTask );</pre>
@@ -749,6 +1249,61 @@ void vTaskResume( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
  */
 portBASE_TYPE xTaskResumeFromISR( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskCoreAffinitySet( xTaskHandle xTask, unsigned portBASE_TYPE uxCoreAffinityMask );</pre>
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * Sets the cores on which a task is allowed to run.  Bit n of
+ * uxCoreAffinityMask is set if the task may run on core n.  Tasks are created
+ * with the affinity tskNO_AFFINITY, so may run on any core.  If the task is
+ * running on a core that is not in the new mask then that core is made to
+ * yield.
+ *
+ * @param xTask Handle of the task whose affinity is being set.  Passing a
+ * NULL handle sets the affinity of the calling task.
+ *
+ * @param uxCoreAffinityMask The cores on which the task may run.  At least one
+ * bit must be set.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 // Create a task, storing the handle.
+	 xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+
+	 // Only allow the created task to run on core 1.
+	 vTaskCoreAffinitySet( xHandle, ( 1 << 1 ) );
+ }
+   </pre>
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+void vTaskCoreAffinitySet( xTaskHandle xTask, unsigned portBASE_TYPE uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskCoreAffinityGet( xTaskHandle xTask );</pre>
+ *
+ * configNUMBER_OF_CORES must be greater than 1 and configUSE_CORE_AFFINITY
+ * must be defined as 1 for this function to be available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * queries the calling task.
+ *
+ * @return The core affinity mask of the task, as set by
+ * vTaskCoreAffinitySet().
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+unsigned portBASE_TYPE uxTaskCoreAffinityGet( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER CONTROL
  *----------------------------------------------------------*/
@@ -787,6 +1342,28 @@ portBASE_TYPE xTaskResumeFromISR( xTaskHandle pxTaskToResume ) PRIVILEGED_FUNCTI
  */
 void vTaskStartScheduler( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskSetInitialTickCount( portTickType xStartTickCount );</pre>
+ *
+ * INCLUDE_vTaskSetInitialTickCount must be defined as 1 for this function to
+ * be available.  See the configuration section for more information.
+ *
+ * Sets the tick count, which the scheduler then starts from in place of 0.
+ * This lets an application that is resuming after its processor was powered
+ * down carry on with the tick count it would have reached had it kept
+ * running, so intervals measured across the power down remain correct.  It
+ * must only be called before the scheduler is started, and should be called
+ * before any timers are started so their expiry times are measured from the
+ * new count.
+ *
+ * @param xStartTickCount The tick count at which the scheduler will start.
+ *
+ * \defgroup vTaskSetInitialTickCount vTaskSetInitialTickCount
+ * \ingroup SchedulerControl
+ */
+void vTaskSetInitialTickCount( portTickType xStartTickCount ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskEndScheduler( void );</pre>
@@ -889,7 +1466,7 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  * \defgroup vTaskSuspendAll vTaskSuspendAll
  * \ingroup SchedulerControl
  */
-void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
+void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /**
  * task. h
@@ -941,7 +1518,7 @@ void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskResumeAll xTaskResumeAll
  * \ingroup SchedulerControl
  */
-signed portBASE_TYPE xTaskResumeAll( void ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskResumeAll( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /**
  * task. h
@@ -985,6 +1562,71 @@ portTickType xTaskGetTickCount( void ) PRIVILEGED_FUNCTION;
  */
 portTickType xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_64_BIT_TICKS == 1 )
+
+/**
+ * task. h
+ * <PRE>portTickCountType xTaskGetTickCount64( void );</PRE>
+ *
+ * configUSE_64_BIT_TICKS must be set to 1 for this function to be available.
+ *
+ * @return The full 64 bit count of ticks since vTaskStartScheduler was
+ * called.  xTaskGetTickCount() returns the low portTickType part of it.
+ *
+ * \page xTaskGetTickCount64 xTaskGetTickCount64
+ * \ingroup TaskUtils
+ */
+portTickCountType xTaskGetTickCount64( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskSetTickRate( portTickType xTickRateHz );</PRE>
+ *
+ * configUSE_DYNAMIC_TICK_RATE must be set to 1 for this function to be
+ * available, and the port must provide portSET_TICK_INTERRUPT_PERIOD().
+ *
+ * Changes the frequency of the tick interrupt, for example to take fewer tick
+ * interrupts while the application is in a standby mode.  The tick count
+ * still counts at configTICK_RATE_HZ, so delays, block times and timer
+ * periods keep their length: each tick interrupt at the lower rate advances
+ * it by configTICK_RATE_HZ / xTickRateHz ticks.  Tasks and timers that
+ * become due between two tick interrupts are released by the second of them,
+ * so the lower the rate the later they can be.
+ *
+ * The tick period that is running when the function is called ends at its
+ * normal time.  The new rate applies from then on.
+ *
+ * @param xTickRateHz The new tick interrupt frequency.  It has to divide
+ * configTICK_RATE_HZ exactly.  Passing configTICK_RATE_HZ restores the
+ * normal rate.
+ *
+ * @return pdPASS if the rate was changed.  pdFAIL if xTickRateHz does not
+ * divide configTICK_RATE_HZ, or the port cannot make the tick period that
+ * long.
+ *
+ * \page xTaskSetTickRate xTaskSetTickRate
+ * \ingroup TaskUtils
+ */
+portBASE_TYPE xTaskSetTickRate( portTickType xTickRateHz ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portTickType xTaskGetTickRate( void );</PRE>
+ *
+ * @return The tick interrupt frequency last set with xTaskSetTickRate(), or
+ * configTICK_RATE_HZ if it has not been changed.
+ *
+ * \page xTaskGetTickRate xTaskGetTickRate
+ * \ingroup TaskUtils
+ */
+portTickType xTaskGetTickRate( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /**
  * task. h
  * <PRE>unsigned short uxTaskGetNumberOfTasks( void );</PRE>
@@ -1061,6 +1703,32 @@ void vTaskList( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
  * task into a buffer, both as an absolute count value and as a percentage
  * of the total system execution time.
  *
+ * By default the accumulated times are held in unsigned longs, which
+ * overflow after about an hour if the counter increments every
+ * microsecond.  For long running systems set
+ * configUSE_64_BIT_RUN_TIME_COUNTER to 1 to hold them in 64 bits.  The
+ * counter value must then be 64 bits wide too, which a 32 bit timer can
+ * provide by counting its own overflows, for example:
+   <pre>
+ // Incremented by the timer's overflow interrupt.
+ volatile unsigned long ulTimerOverflows = 0;
+
+ #define portALT_GET_RUN_TIME_COUNTER_VALUE( ullTime )								\
+ {																				\
+ unsigned long ulHigh, ulLow;													\
+																				\
+	do																			\
+	{																			\
+		ulHigh = ulTimerOverflows;												\
+		ulLow = TIMER_COUNT_REGISTER;											\
+	} while( ulHigh != ulTimerOverflows );										\
+																				\
+	( ullTime ) = ( ( unsigned long long ) ulHigh << 32 ) | ulLow;				\
+ }
+   </pre>
+ * The printf() library used by vTaskGetRunTimeStats() must then support the
+ * %llu format specifier.
+ *
  * @param pcWriteBuffer A buffer into which the execution times will be
  * written, in ascii form.  This buffer is assumed to be large enough to
  * contain the generated report.  Approximately 40 bytes per task should
@@ -1073,18 +1741,186 @@ void vTaskGetRunTimeStats( signed char *pcWriteBuffer ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
- * <PRE>void vTaskStartTrace( char * pcBuffer, unsigned portBASE_TYPE uxBufferSize );</PRE>
+ * <PRE>portRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void );</PRE>
  *
- * Starts a real time kernel activity trace.  The trace logs the identity of
- * which task is running when.
- *
- * The trace file is stored in binary format.  A separate DOS utility called
- * convtrce.exe is used to convert this into a tab delimited text file which
- * can be viewed and plotted in a spread sheet.
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
  *
- * @param pcBuffer The buffer into which the trace will be written.
+ * @return The run time the idle task has used, in the units of
+ * portGET_RUN_TIME_COUNTER_VALUE(), up to the last time it was switched out.
+ * When configNUMBER_OF_CORES is greater than 1 it is the total for all the
+ * idle tasks.  Comparing how much it and the run time counter have advanced
+ * over an interval gives the CPU load during the interval.
  *
- * @param ulBufferSize The size of pcBuffer in bytes.  The trace will continue
+ * \page ulTaskGetIdleRunTimeCounter ulTaskGetIdleRunTimeCounter
+ * \ingroup TaskUtils
+ */
+portRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned short usTaskGetCpuLoad( unsigned portBASE_TYPE uxAverage );</PRE>
+ *
+ * configUSE_CPU_LOAD_METER must be defined as 1 for this function to be
+ * available.
+ *
+ * The load meter samples the time the idle task has run every 100ms, and
+ * keeps exponentially weighted averages of the CPU load with time constants
+ * of 1, 10 and 60 seconds.  Unlike vTaskGetRunTimeStats() reading an average
+ * takes constant time and does not suspend the scheduler, so it can be
+ * called as often as required.  configTICK_RATE_HZ must be at least 10.
+ *
+ * @param uxAverage The average to return - tskCPU_LOAD_1_SECOND,
+ * tskCPU_LOAD_10_SECONDS or tskCPU_LOAD_60_SECONDS.
+ *
+ * @return The CPU load in tenths of a percent, from 0 (always idle) to 1000
+ * (never idle).  When configNUMBER_OF_CORES is greater than 1 it is the load
+ * averaged over all the cores.
+ *
+ * \page usTaskGetCpuLoad usTaskGetCpuLoad
+ * \ingroup TaskUtils
+ */
+unsigned short usTaskGetCpuLoad( unsigned portBASE_TYPE uxAverage ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portRUN_TIME_COUNTER_TYPE ulTaskGetIdleTime( void );</PRE>
+ *
+ * configUSE_CPU_LOAD_METER must be defined as 1 for this function to be
+ * available.
+ *
+ * @return The time the idle task has run since the scheduler was started, up
+ * to the last time it was switched out or the load was last sampled.  The
+ * time is in the units of the run time counter if
+ * configGENERATE_RUN_TIME_STATS is 1, and in ticks otherwise.  When
+ * configNUMBER_OF_CORES is greater than 1 it is the total for all the idle
+ * tasks.
+ *
+ * \page ulTaskGetIdleTime ulTaskGetIdleTime
+ * \ingroup TaskUtils
+ */
+portRUN_TIME_COUNTER_TYPE ulTaskGetIdleTime( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime );</PRE>
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Fills an xTaskStatusType structure for every task in the system.  This
+ * reports the same information as vTaskList() and vTaskGetRunTimeStats(),
+ * along with the number of times each task has been switched in and the
+ * longest it has waited to run after blocking, but as binary data so no
+ * string formatting is needed.
+ *
+ * NOTE: This function suspends the scheduler while it walks the task lists.
+ * It is intended for occasional telemetry, not for use in time critical
+ * code.
+ *
+ * @param pxTaskStatusArray An array of xTaskStatusType structures, one of
+ * which is filled for each task.
+ *
+ * @param uxArraySize The number of structures in pxTaskStatusArray.  This
+ * must be at least uxTaskGetNumberOfTasks(), otherwise nothing is written.
+ *
+ * @param pulTotalRunTime If not NULL, set to the current value of the run
+ * time counter, against which each ulRunTimeCounter can be compared.  Set
+ * to zero if configGENERATE_RUN_TIME_STATS is 0.
+ *
+ * @return The number of structures that were filled, which is zero if
+ * uxArraySize was too small.
+ *
+ * Example usage:
+   <pre>
+ // Send the state of every task to a telemetry channel.
+ void vSendTaskTelemetry( void )
+ {
+ xTaskStatusType *pxStatus;
+ unsigned portBASE_TYPE uxTasks;
+ portRUN_TIME_COUNTER_TYPE ulTotalTime;
+
+	// Allow for tasks being created between the two calls.
+	uxTasks = uxTaskGetNumberOfTasks() + 2;
+	pxStatus = pvPortMalloc( uxTasks * sizeof( xTaskStatusType ) );
+
+	if( pxStatus != NULL )
+	{
+		uxTasks = uxTaskGetSystemState( pxStatus, uxTasks, &ulTotalTime );
+
+		// vSendToTelemetryLink() is not part of the kernel.
+		vSendToTelemetryLink( pxStatus, uxTasks * sizeof( xTaskStatusType ) );
+		vPortFree( pxStatus );
+	}
+ }
+   </pre>
+ *
+ * \page uxTaskGetSystemState uxTaskGetSystemState
+ * \ingroup TaskUtils
+ */
+unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>signed portBASE_TYPE xTaskGetNextTaskStatus( unsigned portBASE_TYPE *puxCursor, xTaskStatusType *pxTaskStatus, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime );</PRE>
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * Incremental form of uxTaskGetSystemState().  Each call fills the
+ * xTaskStatusType structure of one task, so the caller needs no array large
+ * enough for every task and can format or send each task before asking for
+ * the next.  The scheduler is suspended for one pass over the task lists per
+ * call, never for the whole walk.
+ *
+ * Tasks are returned in order of uxTaskNumber.  A task created part way
+ * through a walk may or may not be reported, and a task deleted part way
+ * through is simply not reported, but no task is reported twice.
+ *
+ * @param puxCursor Position of the walk.  Set the variable to zero before
+ * the first call, then pass it back unchanged to get the next task.
+ *
+ * @param pxTaskStatus Filled with the state of the next task.
+ *
+ * @param pulTotalRunTime If not NULL, set as by uxTaskGetSystemState().
+ *
+ * @return pdTRUE if pxTaskStatus was filled, or pdFALSE if every task has
+ * already been reported.
+ *
+ * Example usage:
+   <pre>
+ void vPrintTaskStates( void )
+ {
+ xTaskStatusType xStatus;
+ unsigned portBASE_TYPE uxCursor = 0;
+
+	while( xTaskGetNextTaskStatus( &uxCursor, &xStatus, NULL ) == pdTRUE )
+	{
+		// vPrintLine() is not part of the kernel.
+		vPrintLine( xStatus.pcTaskName, xStatus.uxCurrentPriority, xStatus.usStackHighWaterMark );
+	}
+ }
+   </pre>
+ *
+ * \page xTaskGetNextTaskStatus xTaskGetNextTaskStatus
+ * \ingroup TaskUtils
+ */
+signed portBASE_TYPE xTaskGetNextTaskStatus( unsigned portBASE_TYPE *puxCursor, xTaskStatusType *pxTaskStatus, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>void vTaskStartTrace( char * pcBuffer, unsigned portBASE_TYPE uxBufferSize );</PRE>
+ *
+ * Starts a real time kernel activity trace.  The trace logs the identity of
+ * which task is running when.
+ *
+ * The trace file is stored in binary format.  A separate DOS utility called
+ * convtrce.exe is used to convert this into a tab delimited text file which
+ * can be viewed and plotted in a spread sheet.
+ *
+ * @param pcBuffer The buffer into which the trace will be written.
+ *
+ * @param ulBufferSize The size of pcBuffer in bytes.  The trace will continue
  * until either the buffer in full, or ulTaskEndTrace () is called.
  *
  * \page vTaskStartTrace vTaskStartTrace
@@ -1125,6 +1961,113 @@ unsigned long ulTaskEndTrace( void ) PRIVILEGED_FUNCTION;
  */
 unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * <PRE>unsigned portBASE_TYPE uxTaskGetSampledStackHighWaterMark( xTaskHandle xTask );</PRE>
+ *
+ * configSTACK_SAMPLE_WORDS must be set to a value greater than 0 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * The idle task then checks up to configSTACK_SAMPLE_WORDS words of the task
+ * stacks on each iteration, sweeping through the stacks of all the tasks in
+ * turn, and keeps the high water mark of each stack in its TCB.  This function
+ * returns that kept value, so takes the same short time however large the
+ * stack, where uxTaskGetStackHighWaterMark() scans the stack on each call.
+ *
+ * The value lags the real high water mark by up to one sweep of all the
+ * stacks, and is the full stack depth until the sampler has been through the
+ * stack of the task once.  If the idle task never runs the value is never
+ * updated.
+ *
+ * If configDEFER_STACK_FILL is also set to 1 the sampler fills each new stack,
+ * configSTACK_SAMPLE_WORDS words at a time, before it samples it.  Stack used
+ * before the fill is complete is not counted, and uxTaskGetStackHighWaterMark()
+ * reports too little free space until then.
+ *
+ * @param xTask Handle of the task associated with the stack to be checked.
+ * Set xTask to NULL to check the stack of the calling task.
+ *
+ * @return The smallest amount of free stack space found so far (in words)
+ * since the task referenced by xTask was created.
+ */
+unsigned portBASE_TYPE uxTaskGetSampledStackHighWaterMark( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>portBASE_TYPE xTaskRegisterIdleWork( xIdleWork *pxWork, pdIDLE_WORK_FUNCTION pxFunction, void *pvParameter, portTickType xBudget );</PRE>
+ *
+ * configUSE_IDLE_WORK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Registers a background job, such as erasing flash, scanning memory or
+ * warming a cache, to be run by the idle task.  The idle task calls one
+ * registered job on each iteration, taking the jobs in turn, so every job
+ * gets a share of the idle time however long the others take.
+ *
+ * Each call of the job must do no more than xBudget ticks of work, and the
+ * job is passed its budget so it can size the work to suit.  A job is only
+ * called when the next task to unblock is not due for more than xBudget
+ * ticks, so background work does not delay a task that is about to wake, even
+ * where the work cannot be preempted - as when code is fetched from flash
+ * that is being erased.  A job whose budget does not fit is passed over until
+ * it does, and while no job can be called the idle task behaves as normal,
+ * entering the tickless low power mode if that is enabled.  Calls that take
+ * longer than the budget are counted in ulOverruns.
+ *
+ * The idle task does not enter the low power mode on an iteration in which it
+ * has called a job, so a job should return pdFALSE when it has no more work,
+ * and be registered again when more work arrives.  A job that returns pdFALSE
+ * is removed from the registry after it returns, after which pxWork can be
+ * reused.  Jobs run in the idle task so, like the idle hook, they must never
+ * block.
+ *
+ * @param pxWork The structure that holds the job while it is registered.  It
+ * must not be on the stack of a task that could return before the job is
+ * removed.
+ *
+ * @param pxFunction The job.
+ *
+ * @param pvParameter Passed to the job on each call.
+ *
+ * @param xBudget The most ticks one call of the job takes.  0 is for a job
+ * whose calls take much less than a tick, and lets it be called until the
+ * tick on which the next task is due.
+ *
+ * @return pdPASS if the job was registered, or pdFAIL if pxWork is already
+ * registered.
+ */
+portBASE_TYPE xTaskRegisterIdleWork( xIdleWork *pxWork, pdIDLE_WORK_FUNCTION pxFunction, void *pvParameter, portTickType xBudget ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>portRUN_TIME_COUNTER_TYPE ulTaskGetMaxCriticalSectionTime( void );</PRE>
+ *
+ * configRECORD_CRITICAL_SECTION_TIME must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Returns the longest time, in run time counter units, that interrupts up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY (or all interrupts on ports that do not
+ * implement interrupt priorities) have been held off by a task level critical
+ * section since the scheduler started or vTaskResetMaxCriticalSectionTime()
+ * was last called.  Together with the interrupt entry latency of the hardware
+ * this bounds the latency of every interrupt that is masked by the kernel.
+ * Interrupts masked by portSET_INTERRUPT_MASK_FROM_ISR() are not timed.
+ *
+ * The time is only recorded by ports that call taskCRITICAL_SECTION_ENTERED()
+ * and taskCRITICAL_SECTION_EXITED(), and by ports that set
+ * portCRITICAL_NESTING_IN_TCB to 1.
+ */
+portRUN_TIME_COUNTER_TYPE ulTaskGetMaxCriticalSectionTime( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * <PRE>void vTaskResetMaxCriticalSectionTime( void );</PRE>
+ *
+ * Clears the time returned by ulTaskGetMaxCriticalSectionTime() so the longest
+ * critical section of a new test period can be measured.
+ */
+void vTaskResetMaxCriticalSectionTime( void ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include tasks.h before
 FreeRTOS.h.  When this is done pdTASK_HOOK_CODE will not yet have been defined,
 so the following two prototypes will cause a compilation error.  This can be
@@ -1153,6 +2096,57 @@ constant. */
 	#endif /* configUSE_APPLICATION_TASK_TAG ==1 */
 #endif /* ifdef configUSE_APPLICATION_TASK_TAG */
 
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+
+	/**
+	 * task.h
+	 * <pre>void vTaskSetThreadLocalStoragePointer( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue );</pre>
+	 *
+	 * Only available when configNUM_THREAD_LOCAL_STORAGE_POINTERS is greater
+	 * than 0 in FreeRTOSConfig.h.
+	 *
+	 * Each task has configNUM_THREAD_LOCAL_STORAGE_POINTERS pointers that the
+	 * application and libraries can use to hold per task context - an errno
+	 * value, an allocator arena, and so on - without searching a table keyed
+	 * by task handle.  The pointers are NULL when a task is created.
+	 *
+	 * Sets pointer xIndex of the task xTaskToSet to pvValue.  Passing
+	 * xTaskToSet as NULL sets a pointer of the calling task.
+	 */
+	void vTaskSetThreadLocalStoragePointer( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * task.h
+	 * <pre>void *pvTaskGetThreadLocalStoragePointer( xTaskHandle xTaskToQuery, portBASE_TYPE xIndex );</pre>
+	 *
+	 * Returns pointer xIndex of the task xTaskToQuery, or of the calling task
+	 * if xTaskToQuery is NULL.  The pointer is read directly from the task's
+	 * TCB, so this is cheap enough for hot paths.
+	 */
+	void *pvTaskGetThreadLocalStoragePointer( xTaskHandle xTaskToQuery, portBASE_TYPE xIndex ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+
+		/**
+		 * task.h
+		 * <pre>void vTaskSetThreadLocalStoragePointerAndDelCallback( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue, pdTLS_DELETE_CALLBACK pxDeleteCallback );</pre>
+		 *
+		 * Only available when configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS
+		 * is set to 1 in FreeRTOSConfig.h.
+		 *
+		 * As vTaskSetThreadLocalStoragePointer(), but pxDeleteCallback is
+		 * also recorded.  When the task is deleted pxDeleteCallback is called
+		 * with xIndex and the pointer's value at that time, so whatever the
+		 * pointer refers to can be freed.  The callback is made by the task
+		 * that cleans up deleted tasks, normally the idle task, so it must not
+		 * block.  Pass pxDeleteCallback as NULL to remove a callback.
+		 */
+		void vTaskSetThreadLocalStoragePointerAndDelCallback( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue, pdTLS_DELETE_CALLBACK pxDeleteCallback ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+
 /**
  * task.h
  * <pre>portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction );</pre>
@@ -1174,6 +2168,197 @@ portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter
  */
 xTaskHandle xTaskGetIdleTaskHandle( void );
 
+/*-----------------------------------------------------------
+ * TASK NOTIFICATION API
+ *----------------------------------------------------------*/
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );</PRE>
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * Each task has a 32-bit notification value and a notification state that are
+ * held in the task's TCB, so a notification needs no separate queue or
+ * semaphore object and no event list.  Sending a notification to a task that
+ * is blocked waiting for one (in ulTaskNotifyTake() or xTaskNotifyWait())
+ * unblocks the task directly.  A notification sent to a task that is not
+ * waiting remains pending until the task next calls one of the wait
+ * functions.
+ *
+ * A notification can only be received by the task it is sent to, and only
+ * one task can wait on it, so notifications can replace a binary or counting
+ * semaphore, an event group or a single item mailbox when there is exactly
+ * one receiving task.
+ *
+ * @param xTaskToNotify The handle of the task being notified.
+ *
+ * @param ulValue Data that can be sent with the notification.  How the data
+ * is used depends on the value of the eAction parameter.
+ *
+ * @param eAction How the notification updates the receiving task's
+ * notification value:
+ *
+ * eSetBits - the notification value is bitwise ORed with ulValue.
+ *
+ * eIncrement - the notification value is incremented, ulValue is not used.
+ *
+ * eSetValueWithOverwrite - the notification value is set to ulValue.
+ *
+ * eSetValueWithoutOverwrite - if the task already has a notification pending
+ * then its value is not changed and xTaskNotify() returns pdFAIL, otherwise
+ * the notification value is set to ulValue.
+ *
+ * eNoAction - the task is notified without its notification value changing.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the notification
+ * value could not be updated, otherwise pdPASS.
+ *
+ * \defgroup xTaskNotify xTaskNotify
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyAndQuery( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotifyValue );</PRE>
+ *
+ * As xTaskNotify(), but the task's notification value from before it was
+ * updated is written to *pulPreviousNotifyValue.
+ *
+ * \defgroup xTaskNotifyAndQuery xTaskNotifyAndQuery
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotify() that can be used from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the notification
+ * caused the task to which the notification was sent to leave the Blocked
+ * state, and the unblocked task has a priority higher than the currently
+ * running task.  If xTaskNotifyFromISR() sets this value to pdTRUE then a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup xTaskNotifyFromISR xTaskNotifyFromISR
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );</PRE>
+ *
+ * Waits, with an optional timeout, for the calling task to receive a
+ * notification.
+ *
+ * @param ulBitsToClearOnEntry Bits that are set in ulBitsToClearOnEntry will
+ * be cleared in the calling task's notification value before the task checks
+ * to see if a notification is pending, but only if no notification is already
+ * pending.
+ *
+ * @param ulBitsToClearOnExit If a notification is pending or received before
+ * the calling task exits the xTaskNotifyWait() function then the task's
+ * notification value (see the xTaskNotify() API function) is passed out using
+ * the pulNotificationValue parameter.  Then any bits that are set in
+ * ulBitsToClearOnExit will be cleared in the task's notification value.
+ *
+ * @param pulNotificationValue Used to pass the task's notification value out
+ * of the function.  Set to NULL if the value is not required.
+ *
+ * @param xTicksToWait The maximum amount of time that the task should wait in
+ * the Blocked state for a notification to be received.
+ *
+ * @return pdTRUE if a notification was received (including notifications that
+ * were already pending when xTaskNotifyWait was called), or pdFALSE if the
+ * call timed out.
+ *
+ * \defgroup xTaskNotifyWait xTaskNotifyWait
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyGive( xTaskHandle xTaskToNotify );</PRE>
+ *
+ * Increments the notification value of xTaskToNotify.  Used together with
+ * ulTaskNotifyTake() this provides a faster and lighter weight alternative
+ * to a binary or counting semaphore given with xSemaphoreGive().
+ *
+ * @return xTaskNotifyGive() always returns pdPASS.
+ *
+ * \defgroup xTaskNotifyGive xTaskNotifyGive
+ * \ingroup TaskNotifications
+ */
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+
+/**
+ * task. h
+ * <PRE>void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken );</PRE>
+ *
+ * A version of xTaskNotifyGive() that can be called from an interrupt service
+ * routine.  This is the ISR to task equivalent of xSemaphoreGiveFromISR(), but
+ * no queue is accessed and no event list is searched.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the notification
+ * unblocked a task that has a priority higher than the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup vTaskNotifyGiveFromISR vTaskNotifyGiveFromISR
+ * \ingroup TaskNotifications
+ */
+void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );</PRE>
+ *
+ * Waits, with an optional timeout, for the calling task's notification value
+ * to become non-zero.  This is the notification equivalent of xSemaphoreTake().
+ *
+ * @param xClearCountOnExit If xClearCountOnExit is pdFALSE then the task's
+ * notification value is decremented when the function exits, so the
+ * notification value acts like a counting semaphore.  If xClearCountOnExit is
+ * not pdFALSE then the notification value is cleared to zero when the
+ * function exits, so the notification value acts like a binary semaphore.
+ *
+ * @param xTicksToWait The maximum amount of time that the task should wait in
+ * the Blocked state for the task's notification value to be greater than zero.
+ *
+ * @return The task's notification count before it is either cleared to zero or
+ * decremented (see the xClearCountOnExit parameter).  Zero is returned if the
+ * call timed out.
+ *
+ * \defgroup ulTaskNotifyTake ulTaskNotifyTake
+ * \ingroup TaskNotifications
+ */
+unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask );</PRE>
+ *
+ * If a notification is pending for xTask then clear it without changing the
+ * task's notification value.  Set xTask to NULL to clear the notification
+ * state of the calling task.
+ *
+ * @return pdTRUE if a pending notification was cleared, otherwise pdFALSE.
+ *
+ * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
+ * \ingroup TaskNotifications
+ */
+portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
  *----------------------------------------------------------*/
@@ -1188,7 +2373,7 @@ xTaskHandle xTaskGetIdleTaskHandle( void );
  * for a finite period required removing from a blocked list and placing on
  * a ready list.
  */
-void vTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
+void vTaskIncrementTick( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -1211,7 +2396,7 @@ void vTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * portTICK_RATE_MS can be used to convert kernel ticks into a real time
  * period.
  */
-void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -1226,7 +2411,7 @@ void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicks
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
-void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -1243,7 +2428,61 @@ void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickT
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
-signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * The same as vTaskPlaceOnEventList() and vTaskPlaceOnEventListRestricted(),
+ * but the calling task is placed on a priority event list, as used by queues
+ * when configUSE_PRIORITY_EVENT_LISTS is 1.  Placing the task takes the same
+ * time however many tasks are already waiting.  The task is unblocked by
+ * passing the bucket returned by pxListGetHighestPriorityBucket() to
+ * xTaskRemoveFromEventList().
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+	void vTaskPlaceOnPriorityEventList( xPriorityList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+	void vTaskPlaceOnPriorityEventListRestricted( xPriorityList * const pxEventList, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Used by the event groups implementation.  Places the calling task in an
+ * event list without ordering it by priority, and stores xItemValue in the
+ * task's event list item so the task that sets bits can see what is being
+ * waited for.
+ */
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.
+ *
+ * Removes the task that owns pxEventListItem from its unordered event list
+ * and from the list of blocked tasks, placing it in a ready queue.  xItemValue
+ * is written back into the event list item so the unblocked task can retrieve
+ * it with uxTaskResetEventItemValue().
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Returns the value stored in the calling task's event list item, then
+ * restores the item value to its normal priority ordering value.
+ */
+portTickType uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
@@ -1252,8 +2491,13 @@ signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList )
  *
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
+ *
+ * When configNUMBER_OF_CORES is greater than 1 the port calls this function on
+ * the core that is switching context, with interrupts masked.  The task is
+ * then selected for that core only, and is written to pxCurrentTCBs[] at the
+ * index returned by portGET_CORE_ID().
  */
-void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Return the handle of the calling task.
@@ -1263,19 +2507,37 @@ xTaskHandle xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 /*
  * Capture the current time status for future reference.
  */
-void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut ) PRIVILEGED_FUNCTION;
+void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Compare the time status now with that previously captured to see if the
  * timeout has expired.
  */
-portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * Capture the current time status, as vTaskSetTimeOutState() does, and set
+ * *pxTicksToWait to the number of ticks from then until the tick count
+ * reaches xWakeTime.  Both are taken from the same tick count, so a timeout
+ * later checked with xTaskCheckForTimeOut() expires exactly at xWakeTime.  A
+ * wake time that is more than portMAX_DELAY / 2 ticks ahead is taken to have
+ * passed already, and gives a time to wait of 0.
+ */
+void vTaskSetTimeOutStateUntil( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait, portTickType xWakeTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of ticks from now until the tick count reaches xWakeTime, as
+ * calculated by vTaskSetTimeOutStateUntil().  Must be called with the
+ * scheduler suspended or from a critical section, so the tick count cannot
+ * change before the result is used.
+ */
+portTickType xTaskGetTicksUntil( portTickType xWakeTime ) PRIVILEGED_FUNCTION;
 
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
  */
-void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
+void vTaskMissedYield( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Returns the scheduler state as taskSCHEDULER_RUNNING,
@@ -1285,15 +2547,66 @@ portBASE_TYPE xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * the mutex holder have a priority less than the calling task.  Returns pdTRUE
+ * if the priority of the mutex holder was raised, otherwise pdFALSE.
  */
-void vTaskPriorityInherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xTaskPriorityInherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * As xTaskPriorityInherit(), but the holder inherits uxPriority rather than
+ * the priority of the calling task.  Used where the task the holder is acting
+ * for is not the calling task, such as a server that receives a message from
+ * a blocked client.  The holder may be the calling task.
+ */
+portBASE_TYPE xTaskPriorityRaise( xTaskHandle * const pxMutexHolder, unsigned portBASE_TYPE uxPriority ) PRIVILEGED_FUNCTION;
 
 /*
  * Set the priority of a task back to its proper priority in the case that it
- * inherited a higher priority while it was holding a semaphore.
+ * inherited a higher priority while it was holding a semaphore.  The priority
+ * is only restored once the task has given back every mutex it holds.
+ */
+void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * Called when a task that caused a mutex holder to inherit a priority stops
+ * waiting for the mutex because its block time expired.  Lowers the priority
+ * of the mutex holder to uxHighestPriorityWaitingTask, the priority of the
+ * highest priority task still waiting for the mutex, or to its base priority
+ * if that is higher.  The priority is left unchanged if the holder holds more
+ * than one mutex.  Returns pdTRUE if the priority was lowered.
+ */
+portBASE_TYPE xTaskPriorityDisinheritAfterTimeout( xTaskHandle * const pxMutexHolder, unsigned portBASE_TYPE uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the queue implementation when the calling task obtains a mutex.
+ * Returns the handle of the calling task.
+ */
+void *pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record the mutex the calling task is about to block on, or NULL once it
+ * is no longer waiting, and obtain the mutex a task is blocked on.  Used by
+ * the queue implementation to pass an inherited priority along a chain of
+ * mutex holders that are themselves blocked on mutexes.
+ */
+void vTaskSetMutexBlockedOn( void *pvMutex ) PRIVILEGED_FUNCTION;
+void *pvTaskGetMutexBlockedOn( xTaskHandle * const pxTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by heap_trace.c, with the scheduler suspended, to obtain the owner
+ * entry that memory allocated by the calling task is counted against.  The
+ * task is given an entry of its own the first time it allocates memory.
+ * Returns heaptraceNO_OWNER if the scheduler has not been started.
+ */
+unsigned portBASE_TYPE uxTaskGetHeapOwner( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by heap_3.c to obtain the location of the allocation cache pointer of
+ * the calling task.  Only the calling task uses the pointer, so it can be read
+ * and written without a critical section.  Returns NULL if the scheduler has
+ * not been started.
  */
-void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+void **ppvTaskGetHeapCache( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Generic version of the task creation function which is in turn called by the
@@ -1301,6 +2614,19 @@ void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder ) PRIVILEGED_FUN
  */
 signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is set to 1 the idle task is created
+ * with xTaskCreateStatic(), and the application must provide this function to
+ * supply the memory for the idle task's TCB and stack.  *pusIdleTaskStackSize
+ * is set to configMINIMAL_STACK_SIZE before the call, and can be changed to
+ * the number of portSTACK_TYPE variables the stack buffer actually holds.
+ *
+ * When configNUMBER_OF_CORES is greater than 1 one idle task is created for
+ * each core, and this function is called once for each of them.  It must
+ * supply different buffers on each call.
+ */
+void vApplicationGetIdleTaskMemory( xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize );
+
 /*
  * Get the uxTCBNumber assigned to the task referenced by the xTask parameter.
  */
@@ -1312,6 +2638,82 @@ unsigned portBASE_TYPE uxTaskGetTaskNumber( xTaskHandle xTask );
  */
 void vTaskSetTaskNumber( xTaskHandle xTask, unsigned portBASE_TYPE uxHandle );
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+ * AVAILABLE WHEN configNUMBER_OF_CORES IS GREATER THAN 1, AND ARE USED
+ * THROUGH THE taskENTER_CRITICAL(), taskEXIT_CRITICAL(),
+ * taskENTER_CRITICAL_FROM_ISR(), taskEXIT_CRITICAL_FROM_ISR() AND
+ * portYIELD_WITHIN_API() MACROS.
+ *
+ * A task level critical section masks interrupts on the calling core and takes
+ * both the task and the ISR spinlocks, so no other core can enter a critical
+ * section or suspend the scheduler until it is exited.  An interrupt level
+ * critical section takes only the ISR spinlock.  The port spinlocks must be
+ * recursive, as the task lock is also held while the scheduler is suspended.
+ */
+void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+void vTaskExitCriticalFromISR( unsigned portBASE_TYPE uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE PORTABLE LAYER AND KERNEL,
+ * AND ARE USED THROUGH THE taskCRITICAL_SECTION_ENTERED() AND
+ * taskCRITICAL_SECTION_EXITED() MACROS.
+ *
+ * Time the outermost task level critical section with the run time counter.
+ * Must be called with interrupts masked.
+ */
+void vTaskCriticalSectionEntered( void ) PRIVILEGED_FUNCTION;
+void vTaskCriticalSectionExited( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * If tickless mode is being used, or a low power mode is implemented, then
+ * the tick interrupt will not execute during idle periods.  When this is the
+ * case, the tick count value maintained by the scheduler needs to be kept up
+ * to date with the actual execution time by being skipped forward by the time
+ * spent sleeping.  xTicksToJump must not move the tick count past the time at
+ * which the next task is due to leave the Blocked state.
+ */
+void vTaskStepTick( portTickType xTicksToJump ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Only available when configUSE_DYNAMIC_TICK_RATE is 1.  Returns the number of
+ * ticks the next tick interrupt will advance the tick count by, which is the
+ * length of the tick period that is running.  It is 1 for the tick period
+ * that ends the tick cut short by a call to vTaskStepTick(), as the port
+ * starts that tick period part way through a tick.
+ */
+portTickType xTaskGetTicksForNextTickInterrupt( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Provided for use within portSUPPRESS_TICKS_AND_SLEEP() to allow the port
+ * specific sleep function to determine if it is ok to proceed with the sleep,
+ * and if it is ok to proceed, if it is ok to sleep indefinitely.
+ *
+ * This function is necessary because portSUPPRESS_TICKS_AND_SLEEP() is only
+ * called with the scheduler suspended, not from within a critical section.  It
+ * is therefore possible for an interrupt to request a context switch between
+ * portSUPPRESS_TICKS_AND_SLEEP() and the low power mode actually being
+ * entered.  eTaskConfirmSleepModeStatus() should be called from a short
+ * critical section between the timer being stopped and the sleep mode being
+ * entered to ensure it is ok to proceed into the sleep mode.
+ */
+eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
 
 #ifdef __cplusplus
 }
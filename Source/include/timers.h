@@ -75,6 +75,10 @@ as defined below. */
 #define tmrCOMMAND_CHANGE_PERIOD			2
 #define tmrCOMMAND_DELETE					3
 
+/* Commands with negative IDs are sent to the timer service task itself rather
+than to an individual timer. */
+#define tmrCOMMAND_EXECUTE_CALLBACK			( -1 )
+
 /*-----------------------------------------------------------
  * MACROS AND DEFINITIONS
  *----------------------------------------------------------*/
@@ -90,6 +94,11 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/* Define the prototype to which functions used with the
+xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR() functions must
+conform. */
+typedef void (*tmrPENDED_FUNCTION)( void *pvParameter1, unsigned long ulParameter2 );
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriodInTicks,
@@ -219,6 +228,52 @@ typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
  */
 xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTimerHandle xTimerCreateStatic( 	const signed char *pcTimerName,
+ * 										portTickType xTimerPeriodInTicks,
+ * 										unsigned portBASE_TYPE uxAutoReload,
+ * 										void * pvTimerID,
+ * 										tmrTIMER_CALLBACK pxCallbackFunction,
+ * 										xStaticTimer *pxTimerBuffer );
+ *
+ * Only available when configSUPPORT_STATIC_ALLOCATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * As xTimerCreate(), but the timer's state is held in the variable pointed to
+ * by pxTimerBuffer rather than in memory allocated from the FreeRTOS heap.
+ * The variable must remain valid for the lifetime of the timer, and is not
+ * freed if the timer is deleted.
+ *
+ * @param pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID,
+ * pxCallbackFunction As per the equivalent xTimerCreate() parameters.
+ *
+ * @param pxTimerBuffer Must point to a variable of type xStaticTimer, which is
+ * used to hold the timer's state.
+ *
+ * @return If a parameter was invalid then NULL is returned, otherwise a
+ * handle to the newly created timer is returned.
+ *
+ * Example usage:
+ *
+ * // The timer's state, which must persist for the lifetime of the timer.
+ * static xStaticTimer xTimerBuffer;
+ *
+ * void main( void )
+ * {
+ * xTimerHandle xTimer;
+ *
+ *     xTimer = xTimerCreateStatic( "Timer", 100, pdTRUE, NULL, vTimerCallback, &xTimerBuffer );
+ *
+ *     if( xTimer != NULL )
+ *     {
+ *         xTimerStart( xTimer, 0 );
+ *     }
+ *
+ *     vTaskStartScheduler();
+ * }
+ */
+xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+
 /**
  * void *pvTimerGetTimerID( xTimerHandle xTimer );
  *
@@ -524,6 +579,14 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  * started, and the timers expiry time will be relative to when the scheduler is
  * started, not relative to when xTimerReset() was called.
  *
+ * If configUSE_TIMER_COMMAND_COALESCING is set to 1 in FreeRTOSConfig.h the
+ * command is recorded in the timer itself, replacing any earlier command the
+ * timer service task has not yet processed, instead of being sent to the timer
+ * command queue.  Resetting a timer then never blocks and never fails because
+ * the queue is full, xBlockTime is not used, and a timer reset many times
+ * before the timer service task runs is only restarted once.  This applies to
+ * every command sent to a timer, from tasks and from interrupts.
+ *
  * The configUSE_TIMERS configuration constant must be set to 1 for xTimerReset()
  * to be available.
  *
@@ -923,11 +986,190 @@ xTaskHandle xTimerGetTimerDaemonTaskHandle( void );
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_START, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                              void *pvParameter1,
+ *                                              unsigned long ulParameter2,
+ *                                              signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+ *
+ * Used from application interrupt service routines to defer the execution of a
+ * function to the timer service task (hence the 'daemon' task).  The function
+ * is executed in the context of the timer service task, so it can make API
+ * calls that are not permitted from an interrupt, and it executes with the
+ * interrupt re-enabled.
+ *
+ * This allows the lengthy part of an interrupt (processing a received
+ * Ethernet frame or USB packet, for example) to be moved out of the interrupt
+ * without creating a dedicated task, with its own stack, for each peripheral.
+ * Pended functions are executed in the order they were posted, interleaved
+ * with timer commands, so:
+ *
+ * + The priority of the timer service task, set by configTIMER_TASK_PRIORITY,
+ *   determines how soon the function executes after the interrupt.
+ *
+ * + The stack of the timer service task, set by configTIMER_TASK_STACK_DEPTH,
+ *   must be large enough for the deepest pended function.
+ *
+ * + configTIMER_QUEUE_LENGTH must be large enough to hold every function that
+ *   can be pended before the timer service task gets to run, in addition to
+ *   the timer commands.
+ *
+ * + A pended function should not block, as timer callbacks and other pended
+ *   functions cannot execute until it returns.
+ *
+ * INCLUDE_xTimerPendFunctionCall and configUSE_TIMERS must both be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xFunctionToPend The function to execute from the timer service task.
+ * The function must conform to the tmrPENDED_FUNCTION prototype.
+ *
+ * @param pvParameter1 The value passed as the function's first parameter.
+ *
+ * @param ulParameter2 The value passed as the function's second parameter.
+ *
+ * @param pxHigherPriorityTaskWoken As with xQueueSendFromISR(), the pended
+ * function is posted to the timer command queue.  *pxHigherPriorityTaskWoken
+ * is set to pdTRUE if the timer service task was unblocked by the post and has
+ * a priority above that of the interrupted task, in which case a context
+ * switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the function was posted to the timer command queue,
+ * otherwise pdFAIL because the queue was already full.
+ *
+ * Example usage:
+ * <pre>
+ *
+ *	// The callback function that will execute in the context of the daemon
+ *	// task.  Callback functions must all use this same prototype.
+ *	void vProcessInterface( void *pvParameter1, unsigned long ulParameter2 )
+ *	{
+ *	portBASE_TYPE xInterfaceToService;
+ *
+ *		// The interface that requires servicing is passed in the second
+ *		// parameter.  The first parameter is not used in this case.
+ *		xInterfaceToService = ( portBASE_TYPE ) ulParameter2;
+ *
+ *		// ...Perform the processing here...
+ *	}
+ *
+ *	// An ISR that receives data packets from multiple interfaces
+ *	void vAnISR( void )
+ *	{
+ *	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+ *	portBASE_TYPE xInterfaceToService;
+ *
+ *		// Query the hardware to determine which interface needs processing.
+ *		xInterfaceToService = prvCheckInterfaces();
+ *
+ *		// The actual processing is to be deferred to a task.  Request the
+ *		// vProcessInterface() callback function is executed, passing in the
+ *		// number of the interface that needs processing.
+ *		xTimerPendFunctionCallFromISR( vProcessInterface, NULL, ( unsigned long ) xInterfaceToService, &xHigherPriorityTaskWoken );
+ *
+ *		// If xHigherPriorityTaskWoken is now set to pdTRUE then a context
+ *		// switch should be requested.  The macro used is port specific.
+ *		portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ *	}
+ * </pre>
+ */
+portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend,
+ *                                       void *pvParameter1,
+ *                                       unsigned long ulParameter2,
+ *                                       portTickType xTicksToWait );
+ *
+ * Used to defer the execution of a function to the timer service task from
+ * another task.  As xTimerPendFunctionCallFromISR(), except xTicksToWait is
+ * the maximum time the calling task should remain in the Blocked state waiting
+ * for space to become available on the timer command queue.
+ *
+ * INCLUDE_xTimerPendFunctionCall and configUSE_TIMERS must both be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ */
+portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerRunCallbackInTick( xTimerHandle xTimer );
+ *
+ * Makes the callback of a timer run directly in the tick interrupt, instead of
+ * in the timer service task.  This removes the context switch to and from the
+ * timer service task, and the latency of waiting for it to run, from tiny
+ * periodic jobs such as toggling an output or sampling an input.  It must be
+ * called after xTimerCreate() and before the timer is started or sent any
+ * other command.
+ *
+ * Commands sent to such a timer are applied immediately by the function that
+ * sends them, without using the timer command queue, so never block and never
+ * fail.  A timer started or reset expires xTimerPeriod ticks after the
+ * command is sent.
+ *
+ * The callback runs in interrupt context, at the priority of the tick
+ * interrupt, so:
+ *
+ * + It must be short - the tick interrupt, and every interrupt at or below its
+ *   priority, is held off while it runs.
+ *
+ * + It must not block, and can only call API functions that end in "FromISR".
+ *   Stopping, resetting or changing the period of the timer itself from its
+ *   own callback is permitted.
+ *
+ * + It runs even when the scheduler is suspended.
+ *
+ * + When configUSE_DYNAMIC_TICK_RATE is 1 it runs on the first tick interrupt
+ *   at or after the expiry time, so can run up to one tick interrupt period
+ *   late.  Likewise a tick timer started from an interrupt while the kernel is
+ *   preparing to enter tickless idle can run late, when the sleep ends.
+ *
+ * Active tick timers are held in a list sorted by expiry time, and starting
+ * one takes a time proportional to the number of active tick timers in a
+ * critical section.  The facility is therefore intended for a handful of
+ * timers.
+ *
+ * configUSE_TIMERS and configUSE_TIMER_TICK_CALLBACKS must both be set to 1
+ * in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xTimer The handle of the timer whose callback is to run in the tick
+ * interrupt.
+ *
+ * Example usage:
+ *
+ * void vInitialiseStrobe( void )
+ * {
+ * xTimerHandle xStrobeTimer;
+ *
+ *     xStrobeTimer = xTimerCreate( ( const signed char * ) "Strobe", 5, pdTRUE, NULL, vStrobeCallback );
+ *     vTimerRunCallbackInTick( xStrobeTimer );
+ *     xTimerStart( xStrobeTimer, 0 );
+ * }
+ */
+void vTimerRunCallbackInTick( xTimerHandle xTimer ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 portBASE_TYPE xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt, when configUSE_TIMER_TICK_CALLBACKS is 1, to
+ * account for xTicks ticks and run the callbacks of the tick timers that have
+ * expired.  xTimerGetTicksToNextTickCallback() returns the number of ticks
+ * until the next tick timer expires, or portMAX_DELAY if none are active.
+ */
+void vTimerProcessTickCallbacks( portTickType xTicks ) PRIVILEGED_FUNCTION;
+portTickType xTimerGetTicksToNextTickCallback( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is set to 1 the timer service task is
+ * created with xTaskCreateStatic(), and the application must provide this
+ * function to supply the memory for the timer task's TCB and stack.
+ * *pusTimerTaskStackSize is set to configTIMER_TASK_STACK_DEPTH before the
+ * call, and can be changed to the number of portSTACK_TYPE variables the
+ * stack buffer actually holds.
+ */
+void vApplicationGetTimerTaskMemory( xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize );
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
 
 #ifdef __cplusplus
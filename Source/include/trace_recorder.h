@@ -0,0 +1,744 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * The trace recorder implements the trace macros that are embedded in the
+ * kernel source (traceTASK_SWITCHED_IN(), traceQUEUE_SEND(), etc.) by writing
+ * a small, fixed size, timestamped record for each event into a ring buffer
+ * held in RAM.  When the buffer is full the oldest records are overwritten, so
+ * the buffer always holds the most recent history of the system.  Writing a
+ * record does not format any text, call any other API function or allocate
+ * any memory - it only masks interrupts, stores five values and moves the
+ * write index on.
+ *
+ * The recorder is included in the build by setting configUSE_TRACE_RECORDER
+ * to 1 in FreeRTOSConfig.h and adding Source/trace_recorder.c to the project.
+ * The size of the ring buffer is set by configTRACE_RECORDER_BUFFER_LENGTH
+ * (in events), and the number of task, timer and queue names that are
+ * remembered is set by configTRACE_RECORDER_NAME_TABLE_LENGTH.  Tick
+ * interrupts are not recorded unless configTRACE_RECORDER_INCLUDE_TICKS is set
+ * to 1, as they would otherwise quickly fill the buffer.
+ *
+ * Any trace macro that is already defined in FreeRTOSConfig.h is left as it
+ * is, so the recorder can be combined with application specific trace code.
+ *
+ * The buffer is held in the single xTraceRecorderData structure
+ * xTraceRecorder.  The structure is self describing - it records the size of
+ * the types used and the offset of each table - so a binary image of it can be
+ * read from the target by a debugger (or obtained using
+ * pvTraceRecorderGetData() and sent over a communication link) and then
+ * decoded on the host using the tracedecode utility found in
+ * Demo/Common/TraceDecoder.
+ *
+ * Timestamps are taken from the run time stats counter when
+ * configGENERATE_RUN_TIME_STATS is 1, or from the tick count otherwise.  A
+ * different source can be used by defining traceRECORDER_GET_TIMESTAMP() in
+ * FreeRTOSConfig.h (to read a free running hardware timer, for example).
+ *
+ * Records are written with interrupts masked using
+ * taskENTER_CRITICAL_FROM_ISR().  A port on which
+ * portSET_INTERRUPT_MASK_FROM_ISR() does not mask interrupts (because
+ * interrupts do not nest) must instead define traceRECORDER_ENTER_CRITICAL()
+ * and traceRECORDER_EXIT_CRITICAL( x ) to disable and re-enable interrupts.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The version of the layout of xTraceRecorderData.  This must be incremented
+if the layout is changed, and the decoder updated to match. */
+#define trcRECORDER_VERSION					1
+
+/* Values written to ulTimestampSource to tell the decoder what the timestamps
+are measured in. */
+#define trcTIMESTAMP_TICKS					0
+#define trcTIMESTAMP_RUN_TIME_COUNTER		1
+#define trcTIMESTAMP_USER_DEFINED			2
+
+/*
+ * The event codes written to the ucEventCode member of each record.  The
+ * codes are grouped by object type.  THE NAMES IN Demo/Common/TraceDecoder
+ * MUST BE KEPT IN STEP WITH THESE CODES.
+ *
+ * The uxObject and ulParameter members of a record hold the object (task,
+ * queue, timer, etc.) the event relates to, and a value that depends on the
+ * event - for example the new priority of a task, or the number of items in a
+ * queue after the event.
+ */
+#define trcEVENT_NONE								0x00
+
+/* Task events.  The object is the task handle. */
+#define trcEVENT_TASK_SWITCHED_IN					0x01	/* Parameter is the priority of the task. */
+#define trcEVENT_TASK_SWITCHED_OUT					0x02
+#define trcEVENT_TASK_MOVED_TO_READY				0x03	/* Parameter is the priority of the task. */
+#define trcEVENT_TASK_CREATE						0x04	/* Parameter is the priority of the task. */
+#define trcEVENT_TASK_CREATE_FAILED					0x05
+#define trcEVENT_TASK_DELETE						0x06
+#define trcEVENT_TASK_DELAY							0x07	/* Parameter is the number of ticks to delay. */
+#define trcEVENT_TASK_DELAY_UNTIL					0x08	/* Parameter is the time at which the task will wake. */
+#define trcEVENT_TASK_PRIORITY_SET					0x09	/* Parameter is the new priority. */
+#define trcEVENT_TASK_PRIORITY_INHERIT				0x0a	/* Parameter is the inherited priority. */
+#define trcEVENT_TASK_PRIORITY_DISINHERIT			0x0b	/* Parameter is the original priority. */
+#define trcEVENT_TASK_SUSPEND						0x0c
+#define trcEVENT_TASK_RESUME						0x0d
+#define trcEVENT_TASK_RESUME_FROM_ISR				0x0e
+#define trcEVENT_TASK_INCREMENT_TICK				0x0f	/* Parameter is the tick count.  There is no object. */
+#define trcEVENT_TASK_INCREASE_TICK_COUNT			0x10	/* Parameter is the number of ticks jumped.  There is no object. */
+#define trcEVENT_LOW_POWER_IDLE_BEGIN				0x11	/* Parameter is the expected idle time. */
+#define trcEVENT_LOW_POWER_IDLE_END					0x12
+#define trcEVENT_TASK_NOTIFY						0x13	/* Parameter is the notification value after the event. */
+#define trcEVENT_TASK_NOTIFY_FROM_ISR				0x14	/* Parameter is the notification value after the event. */
+#define trcEVENT_TASK_NOTIFY_GIVE_FROM_ISR			0x15	/* Parameter is the notification value after the event. */
+#define trcEVENT_TASK_NOTIFY_TAKE					0x16	/* Parameter is the notification value before it is cleared or decremented. */
+#define trcEVENT_TASK_NOTIFY_TAKE_BLOCK				0x17
+#define trcEVENT_TASK_NOTIFY_WAIT					0x18	/* Parameter is the notification value before any bits are cleared. */
+#define trcEVENT_TASK_NOTIFY_WAIT_BLOCK				0x19
+
+/* Queue, semaphore and mutex events.  The object is the queue handle, and
+unless stated otherwise the parameter is the number of items that were in the
+queue when the event occurred. */
+#define trcEVENT_QUEUE_CREATE						0x20	/* Parameter is the length of the queue. */
+#define trcEVENT_QUEUE_CREATE_FAILED				0x21	/* Parameter is the queue type.  There is no object. */
+#define trcEVENT_QUEUE_DELETE						0x22
+#define trcEVENT_QUEUE_SEND							0x23
+#define trcEVENT_QUEUE_SEND_FAILED					0x24
+#define trcEVENT_QUEUE_SEND_FROM_ISR				0x25
+#define trcEVENT_QUEUE_SEND_FROM_ISR_FAILED			0x26
+#define trcEVENT_QUEUE_RECEIVE						0x27
+#define trcEVENT_QUEUE_RECEIVE_FAILED				0x28
+#define trcEVENT_QUEUE_RECEIVE_FROM_ISR				0x29
+#define trcEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED		0x2a
+#define trcEVENT_QUEUE_PEEK							0x2b
+#define trcEVENT_BLOCKING_ON_QUEUE_SEND				0x2c
+#define trcEVENT_BLOCKING_ON_QUEUE_RECEIVE			0x2d
+#define trcEVENT_CREATE_MUTEX						0x2e
+#define trcEVENT_CREATE_MUTEX_FAILED				0x2f
+#define trcEVENT_GIVE_MUTEX_RECURSIVE				0x30
+#define trcEVENT_GIVE_MUTEX_RECURSIVE_FAILED		0x31
+#define trcEVENT_TAKE_MUTEX_RECURSIVE				0x32
+#define trcEVENT_TAKE_MUTEX_RECURSIVE_FAILED		0x33
+#define trcEVENT_CREATE_COUNTING_SEMAPHORE			0x34
+#define trcEVENT_CREATE_COUNTING_SEMAPHORE_FAILED	0x35
+
+/* Timer and pended function call events.  The object is the timer handle, or
+the address of the pended function. */
+#define trcEVENT_TIMER_CREATE						0x40	/* Parameter is the period of the timer. */
+#define trcEVENT_TIMER_CREATE_FAILED				0x41
+#define trcEVENT_TIMER_COMMAND_SEND					0x42	/* Parameter is the command. */
+#define trcEVENT_TIMER_COMMAND_SEND_FAILED			0x43	/* Parameter is the command. */
+#define trcEVENT_TIMER_COMMAND_RECEIVED				0x44	/* Parameter is the command. */
+#define trcEVENT_TIMER_EXPIRED						0x45
+#define trcEVENT_PEND_FUNC_CALL						0x46	/* Parameter is the ulParameter2 value passed to the function. */
+#define trcEVENT_PEND_FUNC_CALL_FAILED				0x47
+#define trcEVENT_PEND_FUNC_CALL_FROM_ISR			0x48
+#define trcEVENT_PEND_FUNC_CALL_FROM_ISR_FAILED		0x49
+
+/* Event group events.  The object is the event group handle and the
+parameter is the bits being set, cleared or waited for. */
+#define trcEVENT_EVENT_GROUP_CREATE					0x50
+#define trcEVENT_EVENT_GROUP_CREATE_FAILED			0x51
+#define trcEVENT_EVENT_GROUP_DELETE					0x52
+#define trcEVENT_EVENT_GROUP_WAIT_BITS_BLOCK		0x53
+#define trcEVENT_EVENT_GROUP_WAIT_BITS_END			0x54
+#define trcEVENT_EVENT_GROUP_WAIT_BITS_TIMEOUT		0x55
+#define trcEVENT_EVENT_GROUP_CLEAR_BITS				0x56
+#define trcEVENT_EVENT_GROUP_CLEAR_BITS_FROM_ISR	0x57
+#define trcEVENT_EVENT_GROUP_SET_BITS				0x58
+#define trcEVENT_EVENT_GROUP_SET_BITS_FROM_ISR		0x59
+
+/* Stream buffer events.  The object is the stream buffer handle and the
+parameter is the number of bytes sent or received. */
+#define trcEVENT_STREAM_BUFFER_CREATE				0x60
+#define trcEVENT_STREAM_BUFFER_CREATE_FAILED		0x61
+#define trcEVENT_STREAM_BUFFER_DELETE				0x62
+#define trcEVENT_STREAM_BUFFER_RESET				0x63
+#define trcEVENT_STREAM_BUFFER_SEND					0x64
+#define trcEVENT_STREAM_BUFFER_SEND_FROM_ISR		0x65
+#define trcEVENT_BLOCKING_ON_STREAM_BUFFER_SEND		0x66
+#define trcEVENT_STREAM_BUFFER_RECEIVE				0x67
+#define trcEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR		0x68
+#define trcEVENT_BLOCKING_ON_STREAM_BUFFER_RECEIVE	0x69
+
+/* Memory pool events.  The object is the memory pool handle and the
+parameter is the address of the block. */
+#define trcEVENT_MEMORY_POOL_CREATE					0x70
+#define trcEVENT_MEMORY_POOL_CREATE_FAILED			0x71
+#define trcEVENT_MEMORY_POOL_DELETE					0x72
+#define trcEVENT_MEMORY_POOL_ALLOC					0x73
+#define trcEVENT_MEMORY_POOL_ALLOC_FAILED			0x74
+#define trcEVENT_MEMORY_POOL_FREE					0x75
+
+/* Heap events.  The object is the address of the block and the parameter is
+the number of bytes taken from, or returned to, the heap. */
+#define trcEVENT_MALLOC								0x80
+#define trcEVENT_MALLOC_FAILED						0x81	/* There is no object. */
+#define trcEVENT_FREE								0x82
+
+/* Events written by the application using vTraceRecorderEvent().  Codes
+from trcEVENT_USER up to 0xff are free for application use. */
+#define trcEVENT_USER								0xf0
+
+/*
+ * A single event record.  The decoder assumes the members are naturally
+ * aligned, so ulParameter follows ulTimestamp, uxObject follows ulParameter,
+ * and the two single byte members follow uxObject.
+ */
+typedef struct xTRACE_EVENT
+{
+	unsigned long ulTimestamp;				/*< The time at which the event occurred. */
+	unsigned long ulParameter;				/*< A value that depends on the event. */
+	portPOINTER_SIZE_TYPE uxObject;			/*< The task, queue, timer, etc. the event relates to. */
+	unsigned char ucEventCode;				/*< One of the trcEVENT_ codes. */
+	unsigned char ucCoreID;					/*< The core on which the event occurred, always 0 on a single core system. */
+} xTraceEvent;
+
+/*
+ * An entry in the name table, used by the decoder to print the names of tasks,
+ * timers and registered queues in place of their handles.
+ */
+typedef struct xTRACE_NAME
+{
+	portPOINTER_SIZE_TYPE uxObject;							/*< The object being named, or 0 if the entry is unused. */
+	signed char pcName[ configMAX_TASK_NAME_LEN ];			/*< The name of the object, truncated to configMAX_TASK_NAME_LEN characters. */
+} xTraceName;
+
+/*
+ * The buffer into which events are recorded.  The header members describe the
+ * rest of the structure so the decoder does not need to be built with the
+ * same configuration as the target.
+ */
+typedef struct xTRACE_RECORDER
+{
+	unsigned char ucSignature[ 4 ];							/*< Always "FRTR", used by the decoder to find the structure. */
+	unsigned char ucVersion;								/*< trcRECORDER_VERSION. */
+	unsigned char ucLongSize;								/*< sizeof( unsigned long ) on the target. */
+	unsigned char ucPointerSize;							/*< sizeof( portPOINTER_SIZE_TYPE ) on the target. */
+	unsigned char ucNumberOfCores;							/*< configNUMBER_OF_CORES. */
+	unsigned long ulEndianness;								/*< Always 0x01020304, used by the decoder to determine the byte order of the target. */
+	unsigned long ulTimestampSource;						/*< One of the trcTIMESTAMP_ values. */
+	unsigned long ulNameTableOffset;						/*< The offset of xNames from the start of the structure. */
+	unsigned long ulNameTableLength;						/*< The number of entries in xNames. */
+	unsigned long ulNameSize;								/*< sizeof( xTraceName ). */
+	unsigned long ulNameLength;								/*< configMAX_TASK_NAME_LEN. */
+	unsigned long ulEventBufferOffset;						/*< The offset of xEvents from the start of the structure. */
+	unsigned long ulEventBufferLength;						/*< The number of entries in xEvents. */
+	unsigned long ulEventSize;								/*< sizeof( xTraceEvent ). */
+	unsigned long ulNextName;								/*< The index of the name table entry that will be written next. */
+	volatile unsigned long ulNextEvent;						/*< The index of the event record that will be written next. */
+	volatile unsigned long ulEventsWritten;					/*< The total number of events written since the buffer was last cleared.  Events are lost once this exceeds ulEventBufferLength. */
+	volatile unsigned long ulRecording;						/*< pdTRUE if events are being recorded, otherwise pdFALSE. */
+	xTraceName xNames[ configTRACE_RECORDER_NAME_TABLE_LENGTH ];
+	xTraceEvent xEvents[ configTRACE_RECORDER_BUFFER_LENGTH ];
+} xTraceRecorderData;
+
+/**
+ * trace_recorder.h
+ *
+ * <pre>
+ void vTraceRecorderEvent( unsigned char ucEventCode, portPOINTER_SIZE_TYPE uxObject, unsigned long ulParameter );
+ </pre>
+ *
+ * Writes a record to the trace buffer.  The trace macros call this function
+ * with one of the trcEVENT_ codes.  The application can also call it, from a
+ * task or an interrupt, using an event code between trcEVENT_USER and 0xff to
+ * mark points of interest - for example the start and end of a time critical
+ * sequence.  Nothing is written while recording is stopped.
+ *
+ * @param ucEventCode The code that identifies the event.
+ *
+ * @param uxObject The handle of the object the event relates to, or any value
+ * that is meaningful to the application.
+ *
+ * @param ulParameter A value to record with the event.
+ *
+ * \defgroup vTraceRecorderEvent vTraceRecorderEvent
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderEvent( unsigned char ucEventCode, portPOINTER_SIZE_TYPE uxObject, unsigned long ulParameter ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * <pre>
+ void vTraceRecorderSetName( portPOINTER_SIZE_TYPE uxObject, const signed char *pcName );
+ </pre>
+ *
+ * Records a name for an object so the decoder can print the name in place of
+ * the handle.  Task and timer names are recorded automatically when the task
+ * or timer is created, and queue names are recorded when the queue is added
+ * to the queue registry.  Once the name table is full the oldest names are
+ * overwritten.
+ *
+ * @param uxObject The handle of the object being named.
+ *
+ * @param pcName The name.  The name is copied, so does not need to remain
+ * valid after the call.
+ *
+ * \defgroup vTraceRecorderSetName vTraceRecorderSetName
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderSetName( portPOINTER_SIZE_TYPE uxObject, const signed char *pcName ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * <pre>
+ void vTraceRecorderStart( void );
+ void vTraceRecorderStop( void );
+ </pre>
+ *
+ * Start and stop recording events.  Recording is started by default, so
+ * events are recorded from the first call to a kernel API function.
+ * Stopping the recorder as soon as a fault is detected preserves the history
+ * that led up to the fault.
+ *
+ * \defgroup vTraceRecorderStart vTraceRecorderStart
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * <pre>
+ void vTraceRecorderClear( void );
+ </pre>
+ *
+ * Discards all the recorded events.  The name table is not cleared, as the
+ * tasks and queues it names may still exist.
+ *
+ * \defgroup vTraceRecorderClear vTraceRecorderClear
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderClear( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * <pre>
+ const void *pvTraceRecorderGetData( size_t *pxSize );
+ </pre>
+ *
+ * Obtains the address and size of the trace buffer, so it can be sent to the
+ * host for decoding.  Recording should be stopped first, otherwise the buffer
+ * may change while it is being sent.
+ *
+ * @param pxSize Set to the size of the buffer in bytes.
+ *
+ * @return A pointer to the start of the buffer.
+ *
+ * \defgroup pvTraceRecorderGetData pvTraceRecorderGetData
+ * \ingroup TraceRecorder
+ */
+const void *pvTraceRecorderGetData( size_t *pxSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The trace macros.  Each is defined only if FreeRTOSConfig.h has not already
+ * defined it.  The macros are only expanded inside the kernel source files,
+ * where the variables they reference are in scope.
+ */
+
+#define trcOBJECT( x )		( ( portPOINTER_SIZE_TYPE ) ( x ) )
+
+#ifndef traceTASK_SWITCHED_IN
+	#define traceTASK_SWITCHED_IN() vTraceRecorderEvent( trcEVENT_TASK_SWITCHED_IN, trcOBJECT( pxCurrentTCB ), ( unsigned long ) pxCurrentTCB->uxPriority )
+#endif
+
+#ifndef traceTASK_SWITCHED_OUT
+	#define traceTASK_SWITCHED_OUT() vTraceRecorderEvent( trcEVENT_TASK_SWITCHED_OUT, trcOBJECT( pxCurrentTCB ), 0UL )
+#endif
+
+#ifndef traceTASK_PRIORITY_INHERIT
+	#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority ) vTraceRecorderEvent( trcEVENT_TASK_PRIORITY_INHERIT, trcOBJECT( pxTCBOfMutexHolder ), ( unsigned long ) ( uxInheritedPriority ) )
+#endif
+
+#ifndef traceTASK_PRIORITY_DISINHERIT
+	#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority ) vTraceRecorderEvent( trcEVENT_TASK_PRIORITY_DISINHERIT, trcOBJECT( pxTCBOfMutexHolder ), ( unsigned long ) ( uxOriginalPriority ) )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+	#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) vTraceRecorderEvent( trcEVENT_BLOCKING_ON_QUEUE_RECEIVE, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue ) vTraceRecorderEvent( trcEVENT_BLOCKING_ON_QUEUE_SEND, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+/* traceMOVED_TASK_TO_READY_STATE() is expanded within the
+prvAddTaskToReadyQueue() macro, so must include its own semicolon. */
+#ifndef traceMOVED_TASK_TO_READY_STATE
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB ) vTraceRecorderEvent( trcEVENT_TASK_MOVED_TO_READY, trcOBJECT( pxTCB ), ( unsigned long ) ( pxTCB )->uxPriority );
+#endif
+
+#ifndef traceQUEUE_CREATE
+	#define traceQUEUE_CREATE( pxNewQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_CREATE, trcOBJECT( pxNewQueue ), ( unsigned long ) ( pxNewQueue )->uxLength )
+#endif
+
+#ifndef traceQUEUE_CREATE_FAILED
+	#define traceQUEUE_CREATE_FAILED( ucQueueType ) vTraceRecorderEvent( trcEVENT_QUEUE_CREATE_FAILED, 0, ( unsigned long ) ( ucQueueType ) )
+#endif
+
+#ifndef traceCREATE_MUTEX
+	#define traceCREATE_MUTEX( pxNewQueue ) vTraceRecorderEvent( trcEVENT_CREATE_MUTEX, trcOBJECT( pxNewQueue ), 0UL )
+#endif
+
+#ifndef traceCREATE_MUTEX_FAILED
+	#define traceCREATE_MUTEX_FAILED() vTraceRecorderEvent( trcEVENT_CREATE_MUTEX_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceGIVE_MUTEX_RECURSIVE
+	#define traceGIVE_MUTEX_RECURSIVE( pxMutex ) vTraceRecorderEvent( trcEVENT_GIVE_MUTEX_RECURSIVE, trcOBJECT( pxMutex ), 0UL )
+#endif
+
+#ifndef traceGIVE_MUTEX_RECURSIVE_FAILED
+	#define traceGIVE_MUTEX_RECURSIVE_FAILED( pxMutex ) vTraceRecorderEvent( trcEVENT_GIVE_MUTEX_RECURSIVE_FAILED, trcOBJECT( pxMutex ), 0UL )
+#endif
+
+#ifndef traceTAKE_MUTEX_RECURSIVE
+	#define traceTAKE_MUTEX_RECURSIVE( pxMutex ) vTraceRecorderEvent( trcEVENT_TAKE_MUTEX_RECURSIVE, trcOBJECT( pxMutex ), 0UL )
+#endif
+
+#ifndef traceTAKE_MUTEX_RECURSIVE_FAILED
+	#define traceTAKE_MUTEX_RECURSIVE_FAILED( pxMutex ) vTraceRecorderEvent( trcEVENT_TAKE_MUTEX_RECURSIVE_FAILED, trcOBJECT( pxMutex ), 0UL )
+#endif
+
+#ifndef traceCREATE_COUNTING_SEMAPHORE
+	#define traceCREATE_COUNTING_SEMAPHORE() vTraceRecorderEvent( trcEVENT_CREATE_COUNTING_SEMAPHORE, 0, 0UL )
+#endif
+
+#ifndef traceCREATE_COUNTING_SEMAPHORE_FAILED
+	#define traceCREATE_COUNTING_SEMAPHORE_FAILED() vTraceRecorderEvent( trcEVENT_CREATE_COUNTING_SEMAPHORE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceQUEUE_SEND
+	#define traceQUEUE_SEND( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_SEND, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_SEND_FAILED
+	#define traceQUEUE_SEND_FAILED( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_SEND_FAILED, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE
+	#define traceQUEUE_RECEIVE( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_RECEIVE, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_PEEK
+	#define traceQUEUE_PEEK( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_PEEK, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FAILED
+	#define traceQUEUE_RECEIVE_FAILED( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_RECEIVE_FAILED, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR
+	#define traceQUEUE_SEND_FROM_ISR( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_SEND_FROM_ISR, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR_FAILED
+	#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_SEND_FROM_ISR_FAILED, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+	#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_RECEIVE_FROM_ISR, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR_FAILED
+	#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, trcOBJECT( pxQueue ), ( unsigned long ) ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_DELETE
+	#define traceQUEUE_DELETE( pxQueue ) vTraceRecorderEvent( trcEVENT_QUEUE_DELETE, trcOBJECT( pxQueue ), 0UL )
+#endif
+
+/* The name of a task is recorded when the task is created. */
+#ifndef traceTASK_CREATE
+	#define traceTASK_CREATE( pxNewTCB ) vTraceRecorderSetName( trcOBJECT( pxNewTCB ), taskGET_TCB_NAME( pxNewTCB ) ); vTraceRecorderEvent( trcEVENT_TASK_CREATE, trcOBJECT( pxNewTCB ), ( unsigned long ) ( pxNewTCB )->uxPriority )
+#endif
+
+#ifndef traceTASK_CREATE_FAILED
+	#define traceTASK_CREATE_FAILED() vTraceRecorderEvent( trcEVENT_TASK_CREATE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceTASK_DELETE
+	#define traceTASK_DELETE( pxTaskToDelete ) vTraceRecorderEvent( trcEVENT_TASK_DELETE, trcOBJECT( pxTaskToDelete ), 0UL )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+	#define traceTASK_DELAY_UNTIL() vTraceRecorderEvent( trcEVENT_TASK_DELAY_UNTIL, trcOBJECT( pxCurrentTCB ), ( unsigned long ) xTimeToWake )
+#endif
+
+#ifndef traceTASK_DELAY
+	#define traceTASK_DELAY() vTraceRecorderEvent( trcEVENT_TASK_DELAY, trcOBJECT( pxCurrentTCB ), ( unsigned long ) xTicksToDelay )
+#endif
+
+#ifndef traceTASK_PRIORITY_SET
+	#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority ) vTraceRecorderEvent( trcEVENT_TASK_PRIORITY_SET, trcOBJECT( pxTask ), ( unsigned long ) ( uxNewPriority ) )
+#endif
+
+#ifndef traceTASK_SUSPEND
+	#define traceTASK_SUSPEND( pxTaskToSuspend ) vTraceRecorderEvent( trcEVENT_TASK_SUSPEND, trcOBJECT( pxTaskToSuspend ), 0UL )
+#endif
+
+#ifndef traceTASK_RESUME
+	#define traceTASK_RESUME( pxTaskToResume ) vTraceRecorderEvent( trcEVENT_TASK_RESUME, trcOBJECT( pxTaskToResume ), 0UL )
+#endif
+
+#ifndef traceTASK_RESUME_FROM_ISR
+	#define traceTASK_RESUME_FROM_ISR( pxTaskToResume ) vTraceRecorderEvent( trcEVENT_TASK_RESUME_FROM_ISR, trcOBJECT( pxTaskToResume ), 0UL )
+#endif
+
+#ifndef traceTASK_INCREMENT_TICK
+	#if ( configTRACE_RECORDER_INCLUDE_TICKS == 1 )
+		#define traceTASK_INCREMENT_TICK( xTickCount ) vTraceRecorderEvent( trcEVENT_TASK_INCREMENT_TICK, 0, ( unsigned long ) ( xTickCount ) )
+	#endif
+#endif
+
+#ifndef traceLOW_POWER_IDLE_BEGIN
+	#define traceLOW_POWER_IDLE_BEGIN() vTraceRecorderEvent( trcEVENT_LOW_POWER_IDLE_BEGIN, trcOBJECT( pxCurrentTCB ), ( unsigned long ) xExpectedIdleTime )
+#endif
+
+#ifndef traceLOW_POWER_IDLE_END
+	#define traceLOW_POWER_IDLE_END() vTraceRecorderEvent( trcEVENT_LOW_POWER_IDLE_END, trcOBJECT( pxCurrentTCB ), 0UL )
+#endif
+
+#ifndef traceINCREASE_TICK_COUNT
+	#define traceINCREASE_TICK_COUNT( xTicksToJump ) vTraceRecorderEvent( trcEVENT_TASK_INCREASE_TICK_COUNT, 0, ( unsigned long ) ( xTicksToJump ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+	#define traceTASK_NOTIFY_TAKE_BLOCK() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_TAKE_BLOCK, trcOBJECT( pxCurrentTCB ), 0UL )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+	#define traceTASK_NOTIFY_TAKE() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_TAKE, trcOBJECT( pxCurrentTCB ), ( unsigned long ) pxCurrentTCB->ulNotifiedValue )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+	#define traceTASK_NOTIFY_WAIT_BLOCK() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_WAIT_BLOCK, trcOBJECT( pxCurrentTCB ), 0UL )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+	#define traceTASK_NOTIFY_WAIT() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_WAIT, trcOBJECT( pxCurrentTCB ), ( unsigned long ) pxCurrentTCB->ulNotifiedValue )
+#endif
+
+#ifndef traceTASK_NOTIFY
+	#define traceTASK_NOTIFY() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY, trcOBJECT( pxTCB ), ( unsigned long ) pxTCB->ulNotifiedValue )
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+	#define traceTASK_NOTIFY_FROM_ISR() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_FROM_ISR, trcOBJECT( pxTCB ), ( unsigned long ) pxTCB->ulNotifiedValue )
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR() vTraceRecorderEvent( trcEVENT_TASK_NOTIFY_GIVE_FROM_ISR, trcOBJECT( pxTCB ), ( unsigned long ) pxTCB->ulNotifiedValue )
+#endif
+
+/* The name of a timer is recorded when the timer is created. */
+#ifndef traceTIMER_CREATE
+	#define traceTIMER_CREATE( pxNewTimer ) vTraceRecorderSetName( trcOBJECT( pxNewTimer ), ( pxNewTimer )->pcTimerName ); vTraceRecorderEvent( trcEVENT_TIMER_CREATE, trcOBJECT( pxNewTimer ), ( unsigned long ) ( pxNewTimer )->xTimerPeriodInTicks )
+#endif
+
+#ifndef traceTIMER_CREATE_FAILED
+	#define traceTIMER_CREATE_FAILED() vTraceRecorderEvent( trcEVENT_TIMER_CREATE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceTIMER_COMMAND_SEND
+	#define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn ) vTraceRecorderEvent( ( ( xReturn ) == pdPASS ) ? trcEVENT_TIMER_COMMAND_SEND : trcEVENT_TIMER_COMMAND_SEND_FAILED, trcOBJECT( xTimer ), ( unsigned long ) ( xMessageID ) )
+#endif
+
+#ifndef traceTIMER_EXPIRED
+	#define traceTIMER_EXPIRED( pxTimer ) vTraceRecorderEvent( trcEVENT_TIMER_EXPIRED, trcOBJECT( pxTimer ), 0UL )
+#endif
+
+#ifndef traceTIMER_COMMAND_RECEIVED
+	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue ) vTraceRecorderEvent( trcEVENT_TIMER_COMMAND_RECEIVED, trcOBJECT( pxTimer ), ( unsigned long ) ( xMessageID ) )
+#endif
+
+#ifndef tracePEND_FUNC_CALL
+	#define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, ret ) vTraceRecorderEvent( ( ( ret ) == pdPASS ) ? trcEVENT_PEND_FUNC_CALL : trcEVENT_PEND_FUNC_CALL_FAILED, trcOBJECT( xFunctionToPend ), ( unsigned long ) ( ulParameter2 ) )
+#endif
+
+#ifndef tracePEND_FUNC_CALL_FROM_ISR
+	#define tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, ret ) vTraceRecorderEvent( ( ( ret ) == pdPASS ) ? trcEVENT_PEND_FUNC_CALL_FROM_ISR : trcEVENT_PEND_FUNC_CALL_FROM_ISR_FAILED, trcOBJECT( xFunctionToPend ), ( unsigned long ) ( ulParameter2 ) )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+	#define traceEVENT_GROUP_CREATE( xEventGroup ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_CREATE, trcOBJECT( xEventGroup ), 0UL )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE_FAILED
+	#define traceEVENT_GROUP_CREATE_FAILED() vTraceRecorderEvent( trcEVENT_EVENT_GROUP_CREATE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_WAIT_BITS_BLOCK, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToWaitFor ) )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_END
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred ) vTraceRecorderEvent( ( ( xTimeoutOccurred ) != pdFALSE ) ? trcEVENT_EVENT_GROUP_WAIT_BITS_TIMEOUT : trcEVENT_EVENT_GROUP_WAIT_BITS_END, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToWaitFor ) )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_CLEAR_BITS, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToClear ) )
+#endif
+
+#ifndef traceEVENT_GROUP_CLEAR_BITS_FROM_ISR
+	#define traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_CLEAR_BITS_FROM_ISR, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToClear ) )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_SET_BITS, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToSet ) )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+	#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_SET_BITS_FROM_ISR, trcOBJECT( xEventGroup ), ( unsigned long ) ( uxBitsToSet ) )
+#endif
+
+#ifndef traceEVENT_GROUP_DELETE
+	#define traceEVENT_GROUP_DELETE( xEventGroup ) vTraceRecorderEvent( trcEVENT_EVENT_GROUP_DELETE, trcOBJECT( xEventGroup ), 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_CREATE, trcOBJECT( pxStreamBuffer ), 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED() vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_CREATE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_DELETE, trcOBJECT( xStreamBuffer ), 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( xStreamBuffer ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_RESET, trcOBJECT( xStreamBuffer ), 0UL )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer ) vTraceRecorderEvent( trcEVENT_BLOCKING_ON_STREAM_BUFFER_SEND, trcOBJECT( xStreamBuffer ), 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_SEND, trcOBJECT( xStreamBuffer ), ( unsigned long ) ( xBytesSent ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_SEND_FROM_ISR, trcOBJECT( xStreamBuffer ), ( unsigned long ) ( xBytesSent ) )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer ) vTraceRecorderEvent( trcEVENT_BLOCKING_ON_STREAM_BUFFER_RECEIVE, trcOBJECT( xStreamBuffer ), 0UL )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_RECEIVE, trcOBJECT( xStreamBuffer ), ( unsigned long ) ( xReceivedLength ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength ) vTraceRecorderEvent( trcEVENT_STREAM_BUFFER_RECEIVE_FROM_ISR, trcOBJECT( xStreamBuffer ), ( unsigned long ) ( xReceivedLength ) )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE
+	#define traceMEMORY_POOL_CREATE( xMemoryPool ) vTraceRecorderEvent( trcEVENT_MEMORY_POOL_CREATE, trcOBJECT( xMemoryPool ), 0UL )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+	#define traceMEMORY_POOL_CREATE_FAILED() vTraceRecorderEvent( trcEVENT_MEMORY_POOL_CREATE_FAILED, 0, 0UL )
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+	#define traceMEMORY_POOL_DELETE( xMemoryPool ) vTraceRecorderEvent( trcEVENT_MEMORY_POOL_DELETE, trcOBJECT( xMemoryPool ), 0UL )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOC
+	#define traceMEMORY_POOL_ALLOC( xMemoryPool, pvBlock ) vTraceRecorderEvent( ( ( pvBlock ) != NULL ) ? trcEVENT_MEMORY_POOL_ALLOC : trcEVENT_MEMORY_POOL_ALLOC_FAILED, trcOBJECT( xMemoryPool ), ( unsigned long ) trcOBJECT( pvBlock ) )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+	#define traceMEMORY_POOL_FREE( xMemoryPool, pvBlock ) vTraceRecorderEvent( trcEVENT_MEMORY_POOL_FREE, trcOBJECT( xMemoryPool ), ( unsigned long ) trcOBJECT( pvBlock ) )
+#endif
+
+#ifndef traceMALLOC
+	#define traceMALLOC( pvAddress, uiSize ) vTraceRecorderEvent( ( ( pvAddress ) != NULL ) ? trcEVENT_MALLOC : trcEVENT_MALLOC_FAILED, trcOBJECT( pvAddress ), ( unsigned long ) ( uiSize ) )
+#endif
+
+#ifndef traceFREE
+	#define traceFREE( pvAddress, uiSize ) vTraceRecorderEvent( trcEVENT_FREE, trcOBJECT( pvAddress ), ( unsigned long ) ( uiSize ) )
+#endif
+
+/* The name of a queue is recorded when the queue is added to the queue
+registry. */
+#ifndef traceQUEUE_REGISTRY_ADD
+	#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName ) vTraceRecorderSetName( trcOBJECT( xQueue ), ( pcQueueName ) )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
+
@@ -0,0 +1,630 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "arena.h"
+#include "job_pool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if configUSE_TASK_NOTIFICATIONS != 1
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 in FreeRTOSConfig.h to use job pools.
+#endif
+
+#if configUSE_COUNTING_SEMAPHORES != 1
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h to use job pools.
+#endif
+
+/* Values of the xJobState member of a job. */
+#define jobSTATE_COMPLETE	( ( portBASE_TYPE ) 0 )
+#define jobSTATE_QUEUED		( ( portBASE_TYPE ) 1 )
+#define jobSTATE_RUNNING	( ( portBASE_TYPE ) 2 )
+
+/* A queue of jobs, linked through their pxNextJob members.  Jobs are added at
+the tail and removed from the head. */
+typedef struct JobQueue
+{
+	xJob *pxHead;
+	xJob *pxTail;
+} xJOB_QUEUE;
+
+/* The definition of a worker.  Each worker task is passed a pointer to its
+own worker structure. */
+typedef struct JobPoolWorker
+{
+	struct JobPoolDefinition *pxPool;	/*< The pool the worker belongs to. */
+	xJOB_QUEUE xLocalJobs;				/*< Jobs submitted to this worker by xJobPoolSubmitToWorker(). */
+	xTaskHandle xTask;					/*< The worker task, used to find the worker of the calling task. */
+	xArenaHandle xArena;				/*< The arena reset before each job, or NULL if the pool has no arenas. */
+} xJOB_WORKER;
+
+/* The definition of a job pool.  The queues and counts are only accessed from
+within a critical section (or with interrupts masked) so jobs can be submitted
+from both tasks and interrupts.  xJobsQueued is given once for each job
+queued, so a worker that takes it is sure to find a job. */
+typedef struct JobPoolDefinition
+{
+	xJOB_QUEUE xPoolJobs[ configJOB_POOL_PRIORITIES ];	/*< Jobs submitted to the pool, one queue for each job priority. */
+	xSemaphoreHandle xJobsQueued;						/*< Counts the jobs in all the queues. */
+	xJOB_WORKER *pxWorkers;								/*< The array of workers, allocated with the pool. */
+	unsigned portBASE_TYPE uxNumberOfWorkers;			/*< The number of entries in pxWorkers. */
+	unsigned portBASE_TYPE uxJobsQueued;				/*< The number of jobs in all the queues. */
+	unsigned portBASE_TYPE uxMaxJobsQueued;				/*< The highest value uxJobsQueued has had. */
+	unsigned long ulJobsCompleted;						/*< The number of jobs that have run to completion. */
+	unsigned long ulJobsStolen;							/*< The number of jobs taken from the local queue of another worker. */
+} xJOB_POOL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker task.  Waits for a job to be queued, then takes and runs the job
+ * prvTakeJob() selects.
+ */
+static void prvJobPoolWorker( void *pvParameters );
+
+/*
+ * Marks a job as queued and adds it to the tail of pxQueue.  Returns pdFAIL
+ * without queueing the job if it is already queued or running.  Must be
+ * called with the queues protected from concurrent access.
+ */
+static portBASE_TYPE prvQueueJob( xJOB_POOL * const pxPool, xJOB_QUEUE * const pxQueue, xJob * const pxJob );
+
+/*
+ * Removes the job at the head of pxQueue, returning NULL if the queue is
+ * empty.  Must be called with the queues protected from concurrent access.
+ */
+static xJob *prvRemoveJob( xJOB_QUEUE * const pxQueue );
+
+/*
+ * Removes the job that pxWorker is to run next - from its own local queue,
+ * then from the pool queues in priority order, then from the local queue of
+ * another worker.  Must be called from a critical section.
+ */
+static xJob *prvTakeJob( xJOB_POOL * const pxPool, xJOB_WORKER * const pxWorker );
+
+/*-----------------------------------------------------------*/
+
+xJobPoolHandle xJobPoolCreate( const signed char * const pcName, unsigned portBASE_TYPE uxNumberOfWorkers, unsigned short usStackDepth, unsigned portBASE_TYPE uxPriority )
+{
+xJOB_POOL *pxPool = NULL;
+unsigned portBASE_TYPE ux;
+portBASE_TYPE xResult = pdPASS;
+
+	configASSERT( uxNumberOfWorkers );
+
+	if( uxNumberOfWorkers > 0U )
+	{
+		/* The workers are allocated in the same block as the pool. */
+		pxPool = ( xJOB_POOL * ) pvPortMalloc( sizeof( xJOB_POOL ) + ( uxNumberOfWorkers * sizeof( xJOB_WORKER ) ) );
+	}
+
+	if( pxPool != NULL )
+	{
+		for( ux = 0U; ux < ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES; ux++ )
+		{
+			pxPool->xPoolJobs[ ux ].pxHead = NULL;
+			pxPool->xPoolJobs[ ux ].pxTail = NULL;
+		}
+
+		pxPool->pxWorkers = ( xJOB_WORKER * ) ( pxPool + 1 );
+		pxPool->uxNumberOfWorkers = uxNumberOfWorkers;
+		pxPool->uxJobsQueued = 0U;
+		pxPool->uxMaxJobsQueued = 0U;
+		pxPool->ulJobsCompleted = 0UL;
+		pxPool->ulJobsStolen = 0UL;
+
+		/* There is no limit to the number of jobs that can be queued other
+		than the range of the count. */
+		pxPool->xJobsQueued = xSemaphoreCreateCounting( ( unsigned portBASE_TYPE ) ~( ( unsigned portBASE_TYPE ) 0U ), 0U );
+
+		if( pxPool->xJobsQueued == NULL )
+		{
+			vPortFree( pxPool );
+			pxPool = NULL;
+		}
+	}
+
+	if( pxPool != NULL )
+	{
+		for( ux = 0U; ( ux < uxNumberOfWorkers ) && ( xResult == pdPASS ); ux++ )
+		{
+			pxPool->pxWorkers[ ux ].pxPool = pxPool;
+			pxPool->pxWorkers[ ux ].xLocalJobs.pxHead = NULL;
+			pxPool->pxWorkers[ ux ].xLocalJobs.pxTail = NULL;
+			pxPool->pxWorkers[ ux ].xArena = NULL;
+
+			xResult = xTaskCreate( prvJobPoolWorker, pcName, usStackDepth, ( void * ) &( pxPool->pxWorkers[ ux ] ), uxPriority, &( pxPool->pxWorkers[ ux ].xTask ) );
+		}
+
+		if( xResult != pdPASS )
+		{
+			/* Workers that were created cannot be removed again, as
+			vTaskDelete() might not be available, so the pool keeps just the
+			workers that were created. */
+			pxPool->uxNumberOfWorkers = ux - 1U;
+
+			if( pxPool->uxNumberOfWorkers == 0U )
+			{
+				vQueueDelete( pxPool->xJobsQueued );
+				vPortFree( pxPool );
+				pxPool = NULL;
+			}
+		}
+	}
+
+	if( pxPool != NULL )
+	{
+		traceJOB_POOL_CREATE( pxPool );
+	}
+	else
+	{
+		traceJOB_POOL_CREATE_FAILED();
+	}
+
+	return ( xJobPoolHandle ) pxPool;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xJobPoolCreateArenas( xJobPoolHandle xJobPool, size_t xArenaSizeBytes )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+unsigned portBASE_TYPE ux;
+void *pvBuffer;
+xArenaHandle xArena;
+portBASE_TYPE xReturn = pdPASS;
+
+	configASSERT( pxPool );
+
+	for( ux = 0U; ( ux < pxPool->uxNumberOfWorkers ) && ( xReturn == pdPASS ); ux++ )
+	{
+		/* Workers that already have an arena keep it, so the function can be
+		called again after it failed part way through. */
+		if( pxPool->pxWorkers[ ux ].xArena == NULL )
+		{
+			pvBuffer = pvPortMalloc( xArenaSizeBytes );
+			xArena = NULL;
+
+			if( pvBuffer != NULL )
+			{
+				xArena = xArenaCreate( pvBuffer, xArenaSizeBytes );
+
+				if( xArena == NULL )
+				{
+					vPortFree( pvBuffer );
+				}
+			}
+
+			if( xArena != NULL )
+			{
+				taskENTER_CRITICAL();
+				{
+					pxPool->pxWorkers[ ux ].xArena = xArena;
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+xArenaHandle xJobPoolGetArena( xJobPoolHandle xJobPool )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+xTaskHandle xCurrentTask;
+unsigned portBASE_TYPE ux;
+xArenaHandle xReturn = NULL;
+
+	configASSERT( pxPool );
+
+	xCurrentTask = xTaskGetCurrentTaskHandle();
+
+	/* A worker only ever reads its own entry, and the entry only changes from
+	NULL to an arena, so no critical section is needed. */
+	for( ux = 0U; ux < pxPool->uxNumberOfWorkers; ux++ )
+	{
+		if( pxPool->pxWorkers[ ux ].xTask == xCurrentTask )
+		{
+			xReturn = pxPool->pxWorkers[ ux ].xArena;
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vJobPoolInitJob( xJob *pxJob, pdJOB_CODE pxJobCode, void *pvParameters )
+{
+	configASSERT( pxJob );
+	configASSERT( pxJobCode );
+
+	pxJob->pxJobCode = pxJobCode;
+	pxJob->pvParameters = pvParameters;
+	pxJob->pxNextJob = NULL;
+	pxJob->xWaitingTask = NULL;
+	pxJob->xJobState = jobSTATE_COMPLETE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xJobPoolSubmit( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxPool );
+	configASSERT( pxJob );
+
+	if( uxJobPriority >= ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES )
+	{
+		uxJobPriority = ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES - 1U;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvQueueJob( pxPool, &( pxPool->xPoolJobs[ uxJobPriority ] ), pxJob );
+	}
+	taskEXIT_CRITICAL();
+
+	if( xReturn == pdPASS )
+	{
+		traceJOB_POOL_SUBMIT( xJobPool, pxJob );
+		xSemaphoreGive( pxPool->xJobsQueued );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xJobPoolSubmitFromISR( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxJobPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+	configASSERT( pxJob );
+
+	if( uxJobPriority >= ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES )
+	{
+		uxJobPriority = ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES - 1U;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xReturn = prvQueueJob( pxPool, &( pxPool->xPoolJobs[ uxJobPriority ] ), pxJob );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	if( xReturn == pdPASS )
+	{
+		traceJOB_POOL_SUBMIT( xJobPool, pxJob );
+		xSemaphoreGiveFromISR( pxPool->xJobsQueued, pxHigherPriorityTaskWoken );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xJobPoolSubmitToWorker( xJobPoolHandle xJobPool, xJob *pxJob, unsigned portBASE_TYPE uxWorker )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxPool );
+	configASSERT( pxJob );
+	configASSERT( uxWorker < pxPool->uxNumberOfWorkers );
+
+	if( uxWorker < pxPool->uxNumberOfWorkers )
+	{
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvQueueJob( pxPool, &( pxPool->pxWorkers[ uxWorker ].xLocalJobs ), pxJob );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn == pdPASS )
+		{
+			traceJOB_POOL_SUBMIT( xJobPool, pxJob );
+			xSemaphoreGive( pxPool->xJobsQueued );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xJobPoolWait( xJob *pxJob, portTickType xTicksToWait )
+{
+xTimeOutType xTimeOut;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxJob );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxJob->xJobState == jobSTATE_COMPLETE )
+			{
+				xReturn = pdPASS;
+			}
+			else
+			{
+				/* The worker notifies this task when the job completes. */
+				pxJob->xWaitingTask = xTaskGetCurrentTaskHandle();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn == pdPASS )
+		{
+			break;
+		}
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			/* Do not leave the job pointing at this task. */
+			taskENTER_CRITICAL();
+			{
+				if( pxJob->xJobState == jobSTATE_COMPLETE )
+				{
+					xReturn = pdPASS;
+				}
+				else
+				{
+					pxJob->xWaitingTask = NULL;
+				}
+			}
+			taskEXIT_CRITICAL();
+			break;
+		}
+
+		/* A notification can also be left over from an earlier job that
+		completed after its wait timed out, so the state is checked again. */
+		( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vJobPoolGetStats( xJobPoolHandle xJobPool, xJobPoolStats *pxStats )
+{
+xJOB_POOL * const pxPool = ( xJOB_POOL * ) xJobPool;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+	configASSERT( pxStats );
+
+	/* This form of critical section can be used from both tasks and
+	interrupts. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pxStats->uxNumberOfWorkers = pxPool->uxNumberOfWorkers;
+		pxStats->uxJobsQueued = pxPool->uxJobsQueued;
+		pxStats->uxMaxJobsQueued = pxPool->uxMaxJobsQueued;
+		pxStats->ulJobsCompleted = pxPool->ulJobsCompleted;
+		pxStats->ulJobsStolen = pxPool->ulJobsStolen;
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void prvJobPoolWorker( void *pvParameters )
+{
+xJOB_WORKER * const pxWorker = ( xJOB_WORKER * ) pvParameters;
+xJOB_POOL * const pxPool = pxWorker->pxPool;
+xJob *pxJob;
+xTaskHandle xWaitingTask;
+xArenaHandle xArena;
+
+	for( ;; )
+	{
+		if( xSemaphoreTake( pxPool->xJobsQueued, portMAX_DELAY ) == pdPASS )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxJob = prvTakeJob( pxPool, pxWorker );
+				xArena = pxWorker->xArena;
+			}
+			taskEXIT_CRITICAL();
+
+			/* The semaphore is given once for each job queued. */
+			configASSERT( pxJob );
+
+			if( pxJob != NULL )
+			{
+				/* Nothing allocated by an earlier job survives into this
+				one. */
+				if( xArena != NULL )
+				{
+					vArenaReset( xArena );
+				}
+
+				traceJOB_POOL_JOB_START( pxPool, pxJob );
+				pxJob->pxJobCode( pxJob->pvParameters );
+				traceJOB_POOL_JOB_END( pxPool, pxJob );
+
+				/* The job must not be accessed once it is marked complete, as
+				the application can then reuse it. */
+				taskENTER_CRITICAL();
+				{
+					xWaitingTask = pxJob->xWaitingTask;
+					pxJob->xWaitingTask = NULL;
+					pxJob->xJobState = jobSTATE_COMPLETE;
+					( pxPool->ulJobsCompleted )++;
+				}
+				taskEXIT_CRITICAL();
+
+				if( xWaitingTask != NULL )
+				{
+					( void ) xTaskNotifyGive( xWaitingTask );
+				}
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvQueueJob( xJOB_POOL * const pxPool, xJOB_QUEUE * const pxQueue, xJob * const pxJob )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	if( pxJob->xJobState == jobSTATE_COMPLETE )
+	{
+		pxJob->xJobState = jobSTATE_QUEUED;
+		pxJob->pxNextJob = NULL;
+
+		if( pxQueue->pxTail == NULL )
+		{
+			pxQueue->pxHead = pxJob;
+		}
+		else
+		{
+			pxQueue->pxTail->pxNextJob = pxJob;
+		}
+		pxQueue->pxTail = pxJob;
+
+		( pxPool->uxJobsQueued )++;
+		if( pxPool->uxJobsQueued > pxPool->uxMaxJobsQueued )
+		{
+			pxPool->uxMaxJobsQueued = pxPool->uxJobsQueued;
+		}
+
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static xJob *prvRemoveJob( xJOB_QUEUE * const pxQueue )
+{
+xJob *pxJob;
+
+	pxJob = pxQueue->pxHead;
+
+	if( pxJob != NULL )
+	{
+		pxQueue->pxHead = pxJob->pxNextJob;
+
+		if( pxQueue->pxHead == NULL )
+		{
+			pxQueue->pxTail = NULL;
+		}
+	}
+
+	return pxJob;
+}
+/*-----------------------------------------------------------*/
+
+static xJob *prvTakeJob( xJOB_POOL * const pxPool, xJOB_WORKER * const pxWorker )
+{
+xJob *pxJob;
+unsigned portBASE_TYPE ux;
+xJOB_WORKER *pxVictim;
+
+	/* Jobs submitted to this worker come first. */
+	pxJob = prvRemoveJob( &( pxWorker->xLocalJobs ) );
+
+	/* Then jobs submitted to the pool, highest priority first. */
+	for( ux = ( unsigned portBASE_TYPE ) configJOB_POOL_PRIORITIES; ( ux > 0U ) && ( pxJob == NULL ); ux-- )
+	{
+		pxJob = prvRemoveJob( &( pxPool->xPoolJobs[ ux - 1U ] ) );
+	}
+
+	/* Otherwise another worker is busy and has jobs waiting behind it.
+	Start looking at the next worker so the workers do not all steal from
+	the first. */
+	pxVictim = pxWorker;
+	for( ux = 1U; ( ux < pxPool->uxNumberOfWorkers ) && ( pxJob == NULL ); ux++ )
+	{
+		pxVictim++;
+		if( pxVictim >= &( pxPool->pxWorkers[ pxPool->uxNumberOfWorkers ] ) )
+		{
+			pxVictim = pxPool->pxWorkers;
+		}
+
+		pxJob = prvRemoveJob( &( pxVictim->xLocalJobs ) );
+
+		if( pxJob != NULL )
+		{
+			( pxPool->ulJobsStolen )++;
+		}
+	}
+
+	if( pxJob != NULL )
+	{
+		pxJob->xJobState = jobSTATE_RUNNING;
+		( pxPool->uxJobsQueued )--;
+	}
+
+	return pxJob;
+}
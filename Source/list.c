@@ -69,7 +69,7 @@ void vListInitialise( xList *pxList )
 
 	/* The list end value is the highest possible value in the list to
 	ensure it remains at the end of the list. */
-	pxList->xListEnd.xItemValue = portMAX_DELAY;
+	pxList->xListEnd.xItemValue = portMAX_TICK_COUNT;
 
 	/* The list end next and previous pointers point to itself so we know
 	when the list is empty. */
@@ -113,7 +113,7 @@ volatile xListItem * pxIndex;
 void vListInsert( xList *pxList, xListItem *pxNewListItem )
 {
 volatile xListItem *pxIterator;
-portTickType xValueOfInsertion;
+portTickCountType xValueOfInsertion;
 
 	/* Insert the new list item into the list, sorted in ulListItem order. */
 	xValueOfInsertion = pxNewListItem->xItemValue;
@@ -125,7 +125,7 @@ portTickType xValueOfInsertion;
 	the back marker the iteration loop below will not end.  This means we need
 	to guard against this by checking the value first and modifying the
 	algorithm slightly if necessary. */
-	if( xValueOfInsertion == portMAX_DELAY )
+	if( xValueOfInsertion == portMAX_TICK_COUNT )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
 	}
@@ -167,7 +167,7 @@ portTickType xValueOfInsertion;
 }
 /*-----------------------------------------------------------*/
 
-void vListRemove( xListItem *pxItemToRemove )
+unsigned portBASE_TYPE uxListRemove( xListItem *pxItemToRemove )
 {
 xList * pxList;
 
@@ -186,6 +186,116 @@ xList * pxList;
 
 	pxItemToRemove->pvContainer = NULL;
 	( pxList->uxNumberOfItems )--;
+
+	return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+	/* The priorities of a priority list that may hold items are recorded in
+	the same way as the priorities of the ready lists. */
+	#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		#define listRECORD_PRIORITY( pxList, uxPriority )	portRECORD_READY_PRIORITY( ( uxPriority ), ( pxList )->uxPriorities )
+	#else
+		#define listRECORD_PRIORITY( pxList, uxPriority )	\
+		{													\
+			if( ( uxPriority ) > ( pxList )->uxPriorities )	\
+			{												\
+				( pxList )->uxPriorities = ( uxPriority );	\
+			}												\
+		}
+	#endif
+
+	void vListInitialisePriorityList( xPriorityList *pxList )
+	{
+	unsigned portBASE_TYPE uxPriority;
+
+		for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < ( unsigned portBASE_TYPE ) configMAX_PRIORITIES; uxPriority++ )
+		{
+			vListInitialise( &( pxList->xBuckets[ uxPriority ] ) );
+
+			/* Items are only ever added to the end of a bucket, so the value
+			of the end marker is not needed to keep the bucket in order.  It
+			is used instead to find the priority list from the bucket. */
+			pxList->xBuckets[ uxPriority ].xListEnd.xItemValue = ( portTickCountType ) uxPriority;
+		}
+
+		pxList->uxPriorities = ( unsigned portBASE_TYPE ) 0U;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vListInsertPriority( xPriorityList *pxList, xListItem *pxNewListItem, unsigned portBASE_TYPE uxPriority )
+	{
+		configASSERT( uxPriority < ( unsigned portBASE_TYPE ) configMAX_PRIORITIES );
+
+		/* The bucket is never walked, so the index always points to the last
+		item and vListInsertEnd() keeps the bucket in FIFO order. */
+		vListInsertEnd( &( pxList->xBuckets[ uxPriority ] ), pxNewListItem );
+		listRECORD_PRIORITY( pxList, uxPriority );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vListMovePriority( xListItem *pxListItem, unsigned portBASE_TYPE uxNewPriority )
+	{
+	xList *pxBucket;
+	xPriorityList *pxList;
+
+		/* The end marker of the bucket holds the index of the bucket, which
+		leads back to the first bucket and so the priority list itself. */
+		pxBucket = ( xList * ) pxListItem->pvContainer;
+		pxList = ( xPriorityList * ) ( pxBucket - ( unsigned portBASE_TYPE ) pxBucket->xListEnd.xItemValue );
+
+		( void ) uxListRemove( pxListItem );
+		vListInsertPriority( pxList, pxListItem, uxNewPriority );
+	}
+	/*-----------------------------------------------------------*/
+
+	xList *pxListGetHighestPriorityBucket( xPriorityList *pxList )
+	{
+	xList *pxBucket = NULL;
+	unsigned portBASE_TYPE uxPriority;
+
+		/* Items are removed with uxListRemove(), which does not know about the
+		priority list, so a recorded priority may have since become empty.
+		Such priorities are skipped and forgotten here. */
+		#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+		{
+			while( ( pxBucket == NULL ) && ( pxList->uxPriorities != ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				portGET_HIGHEST_PRIORITY( uxPriority, pxList->uxPriorities );
+
+				if( listLIST_IS_EMPTY( &( pxList->xBuckets[ uxPriority ] ) ) == pdFALSE )
+				{
+					pxBucket = &( pxList->xBuckets[ uxPriority ] );
+				}
+				else
+				{
+					portRESET_READY_PRIORITY( uxPriority, pxList->uxPriorities );
+				}
+			}
+		}
+		#else
+		{
+			uxPriority = pxList->uxPriorities;
+
+			while( ( listLIST_IS_EMPTY( &( pxList->xBuckets[ uxPriority ] ) ) != pdFALSE ) && ( uxPriority > ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				--uxPriority;
+			}
+
+			pxList->uxPriorities = uxPriority;
+
+			if( listLIST_IS_EMPTY( &( pxList->xBuckets[ uxPriority ] ) ) == pdFALSE )
+			{
+				pxBucket = &( pxList->xBuckets[ uxPriority ] );
+			}
+		}
+		#endif
+
+		return pxBucket;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
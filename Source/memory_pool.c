@@ -0,0 +1,305 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "memory_pool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* A free block holds a pointer to the next free block in its first bytes, so
+the free list needs no storage other than the blocks themselves. */
+typedef struct MemoryPoolBlock
+{
+	struct MemoryPoolBlock *pxNextFreeBlock;	/*< The next free block in the list, or NULL if this is the last free block. */
+} xPOOL_BLOCK;
+
+/* The definition of a memory pool.  The free list is accessed in a critical
+section (or with interrupts masked) so blocks can be allocated and freed from
+both tasks and interrupts. */
+typedef struct MemoryPoolDefinition
+{
+	xPOOL_BLOCK *pxFreeList;						/*< Points to the first free block, or NULL if all blocks are allocated. */
+	unsigned char *pucFirstBlock;					/*< The first block in the region, used to check freed blocks belong to the pool. */
+	size_t xBlockSize;								/*< The size of each block after alignment. */
+	unsigned portBASE_TYPE uxNumberOfBlocks;		/*< The number of blocks the region was divided into. */
+	unsigned portBASE_TYPE uxNumberOfFreeBlocks;	/*< The number of blocks currently in the free list. */
+	unsigned portBASE_TYPE uxMinimumEverFreeBlocks;	/*< The lowest value uxNumberOfFreeBlocks has had. */
+} xMEMORY_POOL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove the first block from the free list, or add a block to the front of
+ * the free list.  Both must be called with the free list protected from
+ * concurrent access.
+ */
+static void *prvRemoveBlock( xMEMORY_POOL * const pxMemoryPool );
+static void prvInsertBlock( xMEMORY_POOL * const pxMemoryPool, void *pvBlock );
+
+/*-----------------------------------------------------------*/
+
+xMemoryPoolHandle xMemoryPoolCreate( void *pvPoolBuffer, size_t xPoolBufferSizeBytes, size_t xBlockSizeBytes )
+{
+xMEMORY_POOL *pxMemoryPool = NULL;
+unsigned char *pucAlignedBuffer;
+size_t xAlignmentBytes;
+unsigned portBASE_TYPE uxBlock;
+
+	configASSERT( pvPoolBuffer );
+
+	/* Each block must be able to hold the free list pointer, and must be a
+	multiple of the alignment so every block in the region is aligned. */
+	if( xBlockSizeBytes < sizeof( xPOOL_BLOCK ) )
+	{
+		xBlockSizeBytes = sizeof( xPOOL_BLOCK );
+	}
+
+	if( ( xBlockSizeBytes & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+	{
+		xBlockSizeBytes += ( portBYTE_ALIGNMENT - ( xBlockSizeBytes & portBYTE_ALIGNMENT_MASK ) );
+	}
+
+	/* Skip any bytes at the start of the region that are not aligned. */
+	xAlignmentBytes = ( size_t ) ( ( portBYTE_ALIGNMENT - ( ( ( portPOINTER_SIZE_TYPE ) pvPoolBuffer ) & portBYTE_ALIGNMENT_MASK ) ) & portBYTE_ALIGNMENT_MASK );
+	pucAlignedBuffer = ( ( unsigned char * ) pvPoolBuffer ) + xAlignmentBytes;
+
+	if( xPoolBufferSizeBytes >= ( xAlignmentBytes + xBlockSizeBytes ) )
+	{
+		pxMemoryPool = ( xMEMORY_POOL * ) pvPortMalloc( sizeof( xMEMORY_POOL ) );
+	}
+
+	if( pxMemoryPool != NULL )
+	{
+		pxMemoryPool->pucFirstBlock = pucAlignedBuffer;
+		pxMemoryPool->xBlockSize = xBlockSizeBytes;
+		pxMemoryPool->uxNumberOfBlocks = ( unsigned portBASE_TYPE ) ( ( xPoolBufferSizeBytes - xAlignmentBytes ) / xBlockSizeBytes );
+		pxMemoryPool->uxNumberOfFreeBlocks = 0U;
+		pxMemoryPool->pxFreeList = NULL;
+
+		/* Thread the free list through the region.  The blocks are inserted
+		from the last to the first so the first allocation returns the block
+		at the start of the region. */
+		for( uxBlock = pxMemoryPool->uxNumberOfBlocks; uxBlock > 0U; uxBlock-- )
+		{
+			prvInsertBlock( pxMemoryPool, pucAlignedBuffer + ( ( uxBlock - 1U ) * xBlockSizeBytes ) );
+		}
+
+		pxMemoryPool->uxMinimumEverFreeBlocks = pxMemoryPool->uxNumberOfFreeBlocks;
+
+		traceMEMORY_POOL_CREATE( pxMemoryPool );
+	}
+	else
+	{
+		traceMEMORY_POOL_CREATE_FAILED();
+	}
+
+	return ( xMemoryPoolHandle ) pxMemoryPool;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAlloc( xMemoryPoolHandle xMemoryPool )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+void *pvReturn;
+
+	configASSERT( pxMemoryPool );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = prvRemoveBlock( pxMemoryPool );
+	}
+	taskEXIT_CRITICAL();
+
+	traceMEMORY_POOL_ALLOC( xMemoryPool, pvReturn );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAllocFromISR( xMemoryPoolHandle xMemoryPool )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+void *pvReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxMemoryPool );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pvReturn = prvRemoveBlock( pxMemoryPool );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	traceMEMORY_POOL_ALLOC( xMemoryPool, pvReturn );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFree( xMemoryPoolHandle xMemoryPool, void *pvBlock )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+
+	configASSERT( pxMemoryPool );
+
+	if( pvBlock != NULL )
+	{
+		traceMEMORY_POOL_FREE( xMemoryPool, pvBlock );
+
+		taskENTER_CRITICAL();
+		{
+			prvInsertBlock( pxMemoryPool, pvBlock );
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFreeFromISR( xMemoryPoolHandle xMemoryPool, void *pvBlock )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxMemoryPool );
+
+	if( pvBlock != NULL )
+	{
+		traceMEMORY_POOL_FREE( xMemoryPool, pvBlock );
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			prvInsertBlock( pxMemoryPool, pvBlock );
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolGetStats( xMemoryPoolHandle xMemoryPool, xMemoryPoolStats *pxStats )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxMemoryPool );
+	configASSERT( pxStats );
+
+	/* Mask interrupts so the free and minimum ever free counts are read as a
+	consistent pair.  This form of critical section can be used from both
+	tasks and interrupts. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		pxStats->xBlockSize = pxMemoryPool->xBlockSize;
+		pxStats->uxNumberOfBlocks = pxMemoryPool->uxNumberOfBlocks;
+		pxStats->uxNumberOfFreeBlocks = pxMemoryPool->uxNumberOfFreeBlocks;
+		pxStats->uxMinimumEverFreeBlocks = pxMemoryPool->uxMinimumEverFreeBlocks;
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolDelete( xMemoryPoolHandle xMemoryPool )
+{
+xMEMORY_POOL * const pxMemoryPool = ( xMEMORY_POOL * ) xMemoryPool;
+
+	configASSERT( pxMemoryPool );
+
+	traceMEMORY_POOL_DELETE( xMemoryPool );
+	vPortFree( pxMemoryPool );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvRemoveBlock( xMEMORY_POOL * const pxMemoryPool )
+{
+xPOOL_BLOCK *pxBlock;
+
+	pxBlock = pxMemoryPool->pxFreeList;
+
+	if( pxBlock != NULL )
+	{
+		pxMemoryPool->pxFreeList = pxBlock->pxNextFreeBlock;
+		( pxMemoryPool->uxNumberOfFreeBlocks )--;
+
+		if( pxMemoryPool->uxNumberOfFreeBlocks < pxMemoryPool->uxMinimumEverFreeBlocks )
+		{
+			pxMemoryPool->uxMinimumEverFreeBlocks = pxMemoryPool->uxNumberOfFreeBlocks;
+		}
+	}
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlock( xMEMORY_POOL * const pxMemoryPool, void *pvBlock )
+{
+xPOOL_BLOCK *pxBlock = ( xPOOL_BLOCK * ) pvBlock;
+
+	/* The block must lie on a block boundary within the pool's region, and
+	the pool cannot already hold every block (which would indicate a block
+	being freed twice). */
+	configASSERT( ( unsigned char * ) pvBlock >= pxMemoryPool->pucFirstBlock );
+	configASSERT( ( unsigned char * ) pvBlock < ( pxMemoryPool->pucFirstBlock + ( pxMemoryPool->uxNumberOfBlocks * pxMemoryPool->xBlockSize ) ) );
+	configASSERT( ( ( size_t ) ( ( unsigned char * ) pvBlock - pxMemoryPool->pucFirstBlock ) % pxMemoryPool->xBlockSize ) == ( size_t ) 0 );
+	configASSERT( pxMemoryPool->uxNumberOfFreeBlocks < pxMemoryPool->uxNumberOfBlocks );
+
+	pxBlock->pxNextFreeBlock = pxMemoryPool->pxFreeList;
+	pxMemoryPool->pxFreeList = pxBlock;
+	( pxMemoryPool->uxNumberOfFreeBlocks )++;
+}
@@ -0,0 +1,439 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_channel.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if configUSE_MUTEXES != 1
+	#error configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h to use message channels.
+#endif
+
+#if INCLUDE_uxTaskPriorityGet != 1
+	#error INCLUDE_uxTaskPriorityGet must be set to 1 in FreeRTOSConfig.h to use message channels.
+#endif
+
+/* The states of a message. */
+#define msgPENDING						( ( portBASE_TYPE ) 0 )
+#define msgRECEIVED						( ( portBASE_TYPE ) 1 )
+#define msgREPLIED						( ( portBASE_TYPE ) 2 )
+
+/* A message.  Messages are held on the stack of the sending client, which
+cannot return from xMessageChannelSend() until the message has been replied
+to or withdrawn.  The members are only accessed from within a critical
+section. */
+typedef struct MessageDefinition
+{
+	void *pvMessage;							/*< The message passed to the server. */
+	void *pvReply;								/*< The value passed to vMessageChannelReply(). */
+	void *pvServer;								/*< The server holding the message, recorded in the same way as a mutex holder. */
+	portBASE_TYPE xState;						/*< msgPENDING, msgRECEIVED or msgREPLIED. */
+	unsigned portBASE_TYPE uxPriority;			/*< The priority of the client when it sent the message. */
+	xListItem xMessageListItem;					/*< Places the message in the pending or active list of the channel. */
+	xList xClientWaitingForReply;				/*< The event list the client blocks on. */
+} xMESSAGE;
+
+/* The definition of a message channel. */
+typedef struct MessageChannelDefinition
+{
+	xList xPendingMessages;						/*< Messages waiting to be received.  Stored in priority order. */
+	xList xActiveMessages;						/*< Messages that have been received but not replied to. */
+	xList xTasksWaitingToReceive;				/*< List of servers waiting for a message.  Stored in priority order. */
+} xMESSAGE_CHANNEL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Raises every server that holds a message from the channel to the priority
+ * of the calling task, as the calling task has to wait for one of them.
+ * Returns pdTRUE if a priority was raised.  Must be called from a critical
+ * section.
+ */
+static portBASE_TYPE prvInheritActiveServers( xMESSAGE_CHANNEL * const pxChannel );
+
+/*
+ * Called when a client stops waiting for its message to be received because
+ * its block time expired.  Lowers each server that holds a message from the
+ * channel to the highest priority it still has a reason to run at.  Must be
+ * called from a critical section.
+ */
+static void prvDisinheritActiveServers( xMESSAGE_CHANNEL * const pxChannel );
+
+/*-----------------------------------------------------------*/
+
+xMessageChannelHandle xMessageChannelCreate( void )
+{
+xMESSAGE_CHANNEL *pxChannel;
+
+	pxChannel = ( xMESSAGE_CHANNEL * ) pvPortMalloc( sizeof( xMESSAGE_CHANNEL ) );
+	if( pxChannel != NULL )
+	{
+		vListInitialise( &( pxChannel->xPendingMessages ) );
+		vListInitialise( &( pxChannel->xActiveMessages ) );
+		vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+		traceMESSAGE_CHANNEL_CREATE( pxChannel );
+	}
+	else
+	{
+		traceMESSAGE_CHANNEL_CREATE_FAILED();
+	}
+
+	return ( xMessageChannelHandle ) pxChannel;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xMessageChannelSend( xMessageChannelHandle xChannel, void *pvMessage, void **ppvReply, portTickType xTicksToWait )
+{
+xMESSAGE_CHANNEL * const pxChannel = ( xMESSAGE_CHANNEL * ) xChannel;
+xMESSAGE xMessage;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+
+	configASSERT( xChannel );
+
+	xMessage.pvMessage = pvMessage;
+	xMessage.pvReply = NULL;
+	xMessage.pvServer = NULL;
+	xMessage.xState = msgPENDING;
+	xMessage.uxPriority = uxTaskPriorityGet( NULL );
+	vListInitialise( &( xMessage.xClientWaitingForReply ) );
+	vListInitialiseItem( &( xMessage.xMessageListItem ) );
+	listSET_LIST_ITEM_OWNER( &( xMessage.xMessageListItem ), &xMessage );
+	listSET_LIST_ITEM_VALUE( &( xMessage.xMessageListItem ), ( portTickType ) configMAX_PRIORITIES - ( portTickType ) xMessage.uxPriority );
+
+	taskENTER_CRITICAL();
+	{
+		if( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) == pdFALSE )
+		{
+			traceMESSAGE_CHANNEL_SEND( pxChannel );
+
+			/* A server is waiting, so the message will be received without
+			the calling task having to wait for a server to finish with
+			another message. */
+			vListInsert( &( pxChannel->xPendingMessages ), &( xMessage.xMessageListItem ) );
+			xTicksToWait = portMAX_DELAY;
+
+			if( xTaskRemoveFromEventList( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+		}
+		else if( xTicksToWait == ( portTickType ) 0 )
+		{
+			taskEXIT_CRITICAL();
+			traceMESSAGE_CHANNEL_SEND_FAILED( pxChannel );
+			return pdFAIL;
+		}
+		else
+		{
+			traceMESSAGE_CHANNEL_SEND( pxChannel );
+
+			/* vListInsert() places the message after any of the same
+			priority, so messages of the same priority are received in the
+			order they were sent. */
+			vListInsert( &( pxChannel->xPendingMessages ), &( xMessage.xMessageListItem ) );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency.
+
+	The server unblocks the calling task directly when it replies, so the
+	calling task only has to wait on the event list held in its own message.
+	The message state says whether it was woken by the reply, or by its block
+	time expiring. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( xMessage.xState == msgREPLIED )
+			{
+				taskEXIT_CRITICAL();
+
+				if( ppvReply != NULL )
+				{
+					*ppvReply = xMessage.pvReply;
+				}
+
+				return pdPASS;
+			}
+			else if( xMessage.xState == msgRECEIVED )
+			{
+				/* A server holds the message, so the block time no longer
+				applies. */
+				xTicksToWait = portMAX_DELAY;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* No server received the message within the block time, so
+				withdraw it. */
+				( void ) uxListRemove( &( xMessage.xMessageListItem ) );
+
+				/* If this task raised the priority of the servers then they
+				no longer need to run at that priority on its behalf. */
+				if( xInheritanceOccurred != pdFALSE )
+				{
+					prvDisinheritActiveServers( pxChannel );
+				}
+
+				taskEXIT_CRITICAL();
+				traceMESSAGE_CHANNEL_SEND_FAILED( pxChannel );
+				return pdFAIL;
+			}
+
+			if( xMessage.xState == msgPENDING )
+			{
+				/* The servers that stand between this task and its reply run
+				at the priority of this task until the message is received. */
+				if( prvInheritActiveServers( pxChannel ) != pdFALSE )
+				{
+					xInheritanceOccurred = pdTRUE;
+				}
+			}
+
+			traceBLOCKING_ON_MESSAGE_CHANNEL_SEND( pxChannel );
+			vTaskPlaceOnEventList( &( xMessage.xClientWaitingForReply ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xMessageChannelReceive( xMessageChannelHandle xChannel, xMessageHandle *pxMessage, void **ppvMessage, portTickType xTicksToWait )
+{
+xMESSAGE_CHANNEL * const pxChannel = ( xMESSAGE_CHANNEL * ) xChannel;
+xMESSAGE *pxReceived;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+
+	configASSERT( xChannel );
+	configASSERT( pxMessage );
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( listLIST_IS_EMPTY( &( pxChannel->xPendingMessages ) ) == pdFALSE )
+			{
+				traceMESSAGE_CHANNEL_RECEIVE( pxChannel );
+
+				/* The pending list is ordered by priority, so the first
+				message is the highest priority message. */
+				pxReceived = ( xMESSAGE * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxChannel->xPendingMessages ) );
+				( void ) uxListRemove( &( pxReceived->xMessageListItem ) );
+				vListInsertEnd( &( pxChannel->xActiveMessages ), &( pxReceived->xMessageListItem ) );
+				pxReceived->xState = msgRECEIVED;
+
+				/* The message is held in the same way as a mutex, so the
+				priority inherited through it is only dropped once every
+				message and mutex the calling task holds is given back. */
+				pxReceived->pvServer = pvTaskIncrementMutexHeldCount();
+				( void ) xTaskPriorityRaise( pxReceived->pvServer, pxReceived->uxPriority );
+
+				taskEXIT_CRITICAL();
+
+				*pxMessage = ( xMessageHandle ) pxReceived;
+				if( ppvMessage != NULL )
+				{
+					*ppvMessage = pxReceived->pvMessage;
+				}
+
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				taskEXIT_CRITICAL();
+				traceMESSAGE_CHANNEL_RECEIVE_FAILED( pxChannel );
+				return pdFAIL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				taskEXIT_CRITICAL();
+				traceMESSAGE_CHANNEL_RECEIVE_FAILED( pxChannel );
+				return pdFAIL;
+			}
+
+			traceBLOCKING_ON_MESSAGE_CHANNEL_RECEIVE( pxChannel );
+			vTaskPlaceOnEventList( &( pxChannel->xTasksWaitingToReceive ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMessageChannelReply( xMessageHandle xMessage, void *pvReply )
+{
+xMESSAGE * const pxReplied = ( xMESSAGE * ) xMessage;
+
+	configASSERT( xMessage );
+
+	taskENTER_CRITICAL();
+	{
+		configASSERT( pxReplied->xState == msgRECEIVED );
+		configASSERT( pxReplied->pvServer == xTaskGetCurrentTaskHandle() );
+
+		traceMESSAGE_CHANNEL_REPLY( pxReplied );
+
+		( void ) uxListRemove( &( pxReplied->xMessageListItem ) );
+		pxReplied->pvReply = pvReply;
+		pxReplied->xState = msgREPLIED;
+
+		vTaskPriorityDisinherit( pxReplied->pvServer );
+
+		/* The client is normally blocked waiting for the reply.  If it is not
+		then it has been woken but not yet run, and may now have a higher
+		priority than the calling task, which has just disinherited. */
+		if( listLIST_IS_EMPTY( &( pxReplied->xClientWaitingForReply ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxReplied->xClientWaitingForReply ) ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+		}
+		else
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMessageChannelDelete( xMessageChannelHandle xChannel )
+{
+xMESSAGE_CHANNEL * const pxChannel = ( xMESSAGE_CHANNEL * ) xChannel;
+
+	configASSERT( xChannel );
+	configASSERT( listLIST_IS_EMPTY( &( pxChannel->xPendingMessages ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxChannel->xActiveMessages ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	traceMESSAGE_CHANNEL_DELETE( pxChannel );
+	vPortFree( pxChannel );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvInheritActiveServers( xMESSAGE_CHANNEL * const pxChannel )
+{
+xListItem *pxItem;
+portBASE_TYPE xInheritanceOccurred = pdFALSE;
+
+	pxItem = ( xListItem * ) pxChannel->xActiveMessages.xListEnd.pxNext;
+
+	while( pxItem != ( xListItem * ) &( pxChannel->xActiveMessages.xListEnd ) )
+	{
+		if( xTaskPriorityInherit( ( ( xMESSAGE * ) listGET_LIST_ITEM_OWNER( pxItem ) )->pvServer ) != pdFALSE )
+		{
+			xInheritanceOccurred = pdTRUE;
+		}
+
+		pxItem = ( xListItem * ) pxItem->pxNext;
+	}
+
+	return xInheritanceOccurred;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDisinheritActiveServers( xMESSAGE_CHANNEL * const pxChannel )
+{
+xListItem *pxItem;
+xMESSAGE *pxActive;
+unsigned portBASE_TYPE uxHighestPending = tskIDLE_PRIORITY, uxPriority;
+
+	/* The pending list is ordered by priority, so the first message is from
+	the highest priority client still waiting. */
+	if( listLIST_IS_EMPTY( &( pxChannel->xPendingMessages ) ) == pdFALSE )
+	{
+		uxHighestPending = ( unsigned portBASE_TYPE ) configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxChannel->xPendingMessages ) );
+	}
+
+	pxItem = ( xListItem * ) pxChannel->xActiveMessages.xListEnd.pxNext;
+
+	while( pxItem != ( xListItem * ) &( pxChannel->xActiveMessages.xListEnd ) )
+	{
+		/* A server keeps the priority of the client whose message it
+		holds. */
+		pxActive = ( xMESSAGE * ) listGET_LIST_ITEM_OWNER( pxItem );
+		uxPriority = ( pxActive->uxPriority > uxHighestPending ) ? pxActive->uxPriority : uxHighestPending;
+
+		( void ) xTaskPriorityDisinheritAfterTimeout( pxActive->pvServer, uxPriority );
+
+		pxItem = ( xListItem * ) pxItem->pxNext;
+	}
+}
+/*-----------------------------------------------------------*/
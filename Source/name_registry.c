@@ -0,0 +1,358 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "name_registry.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include the name registry.  This #if is closed at the very bottom of this
+file.  If you want to include the name registry then ensure
+configUSE_NAME_REGISTRY is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_NAME_REGISTRY == 1 )
+
+/* The types of entry that are not objects.  An entry that has never been used
+ends a search, whereas an entry that held an object that has since been
+removed does not, as other names may have been placed beyond it. */
+#define nameregTYPE_EMPTY				( ( unsigned char ) 0U )
+#define nameregTYPE_REMOVED				( ( unsigned char ) 0xffU )
+
+/* Names are compared to the length a task name is truncated to. */
+#define nameregMAX_NAME_LENGTH			( ( unsigned portBASE_TYPE ) configMAX_TASK_NAME_LEN - ( unsigned portBASE_TYPE ) 1U )
+
+#define nameregINDEX_MASK				( ( unsigned portBASE_TYPE ) configNAME_REGISTRY_SIZE - ( unsigned portBASE_TYPE ) 1U )
+
+/* FNV-1a parameters. */
+#define nameregHASH_OFFSET				( 2166136261UL )
+#define nameregHASH_PRIME				( 16777619UL )
+
+typedef struct xNAME_REGISTRY_ENTRY
+{
+	const signed char *pcName;				/*< The name the object was registered under. */
+	void *pvHandle;							/*< The handle of the object. */
+	unsigned char ucType;					/*< The nameregTYPE_ of the object, nameregTYPE_EMPTY or nameregTYPE_REMOVED. */
+} xNameRegistryEntry;
+
+/* The hash table.  Names that hash to a used entry are placed in the next
+unused entry, wrapping at the end of the table. */
+PRIVILEGED_DATA static volatile xNameRegistryEntry xNameRegistry[ configNAME_REGISTRY_SIZE ];
+
+/* Incremented before and after every update of the table, so it is odd while
+the table is being updated.  Lookups that see it change, or see it odd, have
+to be repeated. */
+PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxNameRegistrySequence = ( unsigned portBASE_TYPE ) 0U;
+
+PRIVILEGED_DATA static unsigned portBASE_TYPE uxFailedAdds = ( unsigned portBASE_TYPE ) 0U;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the table index at which a search for pcName starts.
+ */
+static unsigned portBASE_TYPE prvHashName( const signed char *pcName ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if two names are the same up to nameregMAX_NAME_LENGTH
+ * characters.
+ */
+static portBASE_TYPE prvNamesMatch( const signed char *pcName1, const signed char *pcName2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * Searches the table without reference to the sequence count.
+ */
+static void *prvFind( const signed char *pcName, unsigned char ucType ) PRIVILEGED_FUNCTION;
+
+/*
+ * Marks an entry as removed, and turns it and any removed entries before it
+ * back into unused entries if the entry after it is unused, so the searches
+ * that pass through them can stop sooner.  Must be called between updates of
+ * the sequence count.
+ */
+static void prvRemoveEntry( unsigned portBASE_TYPE uxIndex ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvHashName( const signed char *pcName )
+{
+unsigned long ulHash = nameregHASH_OFFSET;
+unsigned portBASE_TYPE ux;
+
+	for( ux = ( unsigned portBASE_TYPE ) 0U; ( ux < nameregMAX_NAME_LENGTH ) && ( pcName[ ux ] != ( signed char ) '\0' ); ux++ )
+	{
+		ulHash ^= ( unsigned long ) ( unsigned char ) pcName[ ux ];
+		ulHash *= nameregHASH_PRIME;
+	}
+
+	/* The low bits of FNV-1a are not as well mixed as the high bits. */
+	ulHash ^= ( ulHash >> 16 );
+
+	return ( unsigned portBASE_TYPE ) ulHash & nameregINDEX_MASK;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvNamesMatch( const signed char *pcName1, const signed char *pcName2 )
+{
+unsigned portBASE_TYPE ux;
+
+	for( ux = ( unsigned portBASE_TYPE ) 0U; ux < nameregMAX_NAME_LENGTH; ux++ )
+	{
+		if( pcName1[ ux ] != pcName2[ ux ] )
+		{
+			return pdFALSE;
+		}
+
+		if( pcName1[ ux ] == ( signed char ) '\0' )
+		{
+			break;
+		}
+	}
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvFind( const signed char *pcName, unsigned char ucType )
+{
+unsigned portBASE_TYPE uxIndex, uxSearched;
+unsigned char ucEntryType;
+
+	uxIndex = prvHashName( pcName );
+
+	for( uxSearched = ( unsigned portBASE_TYPE ) 0U; uxSearched < ( unsigned portBASE_TYPE ) configNAME_REGISTRY_SIZE; uxSearched++ )
+	{
+		ucEntryType = xNameRegistry[ uxIndex ].ucType;
+
+		if( ucEntryType == nameregTYPE_EMPTY )
+		{
+			break;
+		}
+
+		/* If the table is being updated the name may belong to an object that
+		has just been deleted.  The comparison is bounded, and the result is
+		discarded by the caller when the sequence count shows the update. */
+		if( ( ucEntryType == ucType ) && ( prvNamesMatch( xNameRegistry[ uxIndex ].pcName, pcName ) != pdFALSE ) )
+		{
+			return xNameRegistry[ uxIndex ].pvHandle;
+		}
+
+		uxIndex = ( uxIndex + ( unsigned portBASE_TYPE ) 1U ) & nameregINDEX_MASK;
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveEntry( unsigned portBASE_TYPE uxIndex )
+{
+	xNameRegistry[ uxIndex ].ucType = nameregTYPE_REMOVED;
+
+	while( ( xNameRegistry[ uxIndex ].ucType == nameregTYPE_REMOVED ) && ( xNameRegistry[ ( uxIndex + ( unsigned portBASE_TYPE ) 1U ) & nameregINDEX_MASK ].ucType == nameregTYPE_EMPTY ) )
+	{
+		xNameRegistry[ uxIndex ].ucType = nameregTYPE_EMPTY;
+		uxIndex = ( uxIndex - ( unsigned portBASE_TYPE ) 1U ) & nameregINDEX_MASK;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvNameRegistryFind( const signed char *pcName, unsigned char ucType )
+{
+unsigned portBASE_TYPE uxSequence;
+void *pvHandle;
+
+	/* On a single core the table cannot be seen part way through an update,
+	as the scheduler is suspended while it is updated, but another core can
+	update it at any time. */
+	do
+	{
+		uxSequence = uxNameRegistrySequence;
+		portMEMORY_BARRIER();
+
+		pvHandle = prvFind( pcName, ucType );
+
+		portMEMORY_BARRIER();
+	} while( ( ( uxSequence & ( unsigned portBASE_TYPE ) 1U ) != ( unsigned portBASE_TYPE ) 0U ) || ( uxSequence != uxNameRegistrySequence ) );
+
+	return pvHandle;
+}
+/*-----------------------------------------------------------*/
+
+void *pvNameRegistryFindFromISR( const signed char *pcName, unsigned char ucType )
+{
+unsigned portBASE_TYPE uxSequence;
+void *pvHandle = NULL;
+
+	uxSequence = uxNameRegistrySequence;
+	portMEMORY_BARRIER();
+
+	if( ( uxSequence & ( unsigned portBASE_TYPE ) 1U ) == ( unsigned portBASE_TYPE ) 0U )
+	{
+		pvHandle = prvFind( pcName, ucType );
+
+		portMEMORY_BARRIER();
+		if( uxSequence != uxNameRegistrySequence )
+		{
+			pvHandle = NULL;
+		}
+	}
+
+	return pvHandle;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxNameRegistryGetFailedAdds( void )
+{
+	return uxFailedAdds;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xNameRegistryAdd( const signed char *pcName, void *pvHandle, unsigned char ucType )
+{
+unsigned portBASE_TYPE uxIndex, uxSearched;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pcName );
+	configASSERT( pvHandle );
+
+	vTaskSuspendAll();
+	{
+		uxIndex = prvHashName( pcName );
+
+		/* Use the first entry that does not hold an object. */
+		for( uxSearched = ( unsigned portBASE_TYPE ) 0U; uxSearched < ( unsigned portBASE_TYPE ) configNAME_REGISTRY_SIZE; uxSearched++ )
+		{
+			if( ( xNameRegistry[ uxIndex ].ucType == nameregTYPE_EMPTY ) || ( xNameRegistry[ uxIndex ].ucType == nameregTYPE_REMOVED ) )
+			{
+				uxNameRegistrySequence++;
+				portMEMORY_BARRIER();
+
+				xNameRegistry[ uxIndex ].pcName = pcName;
+				xNameRegistry[ uxIndex ].pvHandle = pvHandle;
+				xNameRegistry[ uxIndex ].ucType = ucType;
+
+				portMEMORY_BARRIER();
+				uxNameRegistrySequence++;
+
+				xReturn = pdPASS;
+				break;
+			}
+
+			uxIndex = ( uxIndex + ( unsigned portBASE_TYPE ) 1U ) & nameregINDEX_MASK;
+		}
+
+		if( xReturn == pdFAIL )
+		{
+			uxFailedAdds++;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vNameRegistryRemove( const signed char *pcName, void *pvHandle )
+{
+unsigned portBASE_TYPE uxIndex, uxSearched;
+unsigned char ucEntryType;
+
+	vTaskSuspendAll();
+	{
+		/* Without a name every entry has to be checked. */
+		if( pcName != NULL )
+		{
+			uxIndex = prvHashName( pcName );
+		}
+		else
+		{
+			uxIndex = ( unsigned portBASE_TYPE ) 0U;
+		}
+
+		for( uxSearched = ( unsigned portBASE_TYPE ) 0U; uxSearched < ( unsigned portBASE_TYPE ) configNAME_REGISTRY_SIZE; uxSearched++ )
+		{
+			ucEntryType = xNameRegistry[ uxIndex ].ucType;
+
+			if( ( ucEntryType == nameregTYPE_EMPTY ) && ( pcName != NULL ) )
+			{
+				break;
+			}
+
+			if( ( ucEntryType != nameregTYPE_EMPTY ) && ( ucEntryType != nameregTYPE_REMOVED ) && ( xNameRegistry[ uxIndex ].pvHandle == pvHandle ) )
+			{
+				uxNameRegistrySequence++;
+				portMEMORY_BARRIER();
+
+				prvRemoveEntry( uxIndex );
+
+				portMEMORY_BARRIER();
+				uxNameRegistrySequence++;
+			}
+
+			uxIndex = ( uxIndex + ( unsigned portBASE_TYPE ) 1U ) & nameregINDEX_MASK;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the name registry.  If you want to include the name registry then
+ensure configUSE_NAME_REGISTRY is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_NAME_REGISTRY == 1 */
+
@@ -146,6 +146,11 @@ void vPortEnterCritical( void )
 		} while( 1 );
 	}
 	ulCriticalNesting++;
+
+	if( ulCriticalNesting == 1UL )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
 }
 /*-----------------------------------------------------------*/
 
@@ -154,6 +159,7 @@ void vPortExitCritical( void )
 	ulCriticalNesting--;
 	if( ulCriticalNesting == 0 )
 	{
+		taskCRITICAL_SECTION_EXITED();
 		portENABLE_INTERRUPTS();
 	}
 }
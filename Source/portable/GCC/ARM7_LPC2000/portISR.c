@@ -79,6 +79,7 @@
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
+#include "task.h"
 
 /* Constants required to handle interrupts. */
 #define portTIMER_MATCH_ISR_BIT		( ( unsigned char ) 0x01 )
@@ -134,9 +135,143 @@ void vPortYieldProcessor( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_NESTED_IRQ == 1
+
+/* Set by portYIELD_FROM_ISR(), the context switch is performed when the
+outermost interrupt exits. */
+volatile unsigned long ulPortYieldRequired = pdFALSE;
+
+/* The number of interrupts being serviced. */
+volatile unsigned long ulPortInterruptNesting = 0UL;
+
+/*
+ * The IRQ handler used when interrupts nest.  See portmacro.h.
+ */
+void vPortNestedIRQHandler( void ) __attribute__((naked));
+void vPortNestedIRQHandler( void )
+{
+	__asm volatile (
+		/* Save the return address and the SPSR on the IRQ stack, which then
+		only needs two words per nesting level.  LR is not corrected here so
+		the stack matches that expected by portSAVE_CONTEXT() on the way out. */
+		"STMDB	SP!, {LR}					\n\t"
+		"MRS	LR, SPSR					\n\t"
+		"STMDB	SP!, {LR}					\n\t"
+
+		/* Continue in System mode, with IRQs still disabled, saving the
+		registers the handler may corrupt on the stack of the interrupted
+		task. */
+		"MSR	CPSR_c, #0x9F				\n\t"
+		"STMDB	SP!, {R0-R3, R12, LR}		\n\t"
+
+		"LDR	R0, =ulPortInterruptNesting	\n\t"
+		"LDR	R1, [R0]					\n\t"
+		"ADD	R1, R1, #1					\n\t"
+		"STR	R1, [R0]					\n\t"
+
+		/* Reading VICVectAddr obtains the address of the handler and tells the
+		VIC the interrupt is being serviced, it then only signals interrupts
+		of a higher priority until VICVectAddr is written. */
+		"LDR	R0, =0xFFFFF030				\n\t"
+		"LDR	R0, [R0]					\n\t"
+
+		/* Call the handler with IRQs enabled. */
+		"MSR	CPSR_c, #0x1F				\n\t"
+		"MOV	LR, PC						\n\t"
+		"BX		R0							\n\t"
+		"MSR	CPSR_c, #0x9F				\n\t"
+
+		/* End the interrupt in the VIC. */
+		"LDR	R0, =0xFFFFF030				\n\t"
+		"MOV	R1, #0						\n\t"
+		"STR	R1, [R0]					\n\t"
+
+		"LDR	R0, =ulPortInterruptNesting	\n\t"
+		"LDR	R1, [R0]					\n\t"
+		"SUB	R1, R1, #1					\n\t"
+		"STR	R1, [R0]					\n\t"
+
+		/* A context switch can only be performed by the outermost interrupt.
+		Leave Z clear if one is to be performed, and clear the request. */
+		"CMP	R1, #0						\n\t"
+		"LDREQ	R0, =ulPortYieldRequired	\n\t"
+		"LDREQ	R2, [R0]					\n\t"
+		"MOVNE	R2, #0						\n\t"
+		"CMP	R2, #0						\n\t"
+		"MOVNE	R2, #0						\n\t"
+		"STRNE	R2, [R0]					\n\t"
+
+		/* Put every register back as it was when the interrupt was taken,
+		none of these instructions alter the flags. */
+		"LDMIA	SP!, {R0-R3, R12, LR}		\n\t"
+		"MSR	CPSR_c, #0x92				\n\t"
+		"LDMIA	SP!, {LR}					\n\t"
+		"MSR	SPSR_cxsf, LR				\n\t"
+		"LDMIA	SP!, {LR}					\n\t"
+
+		/* Return to the interrupted code if no context switch is needed. */
+		"SUBEQS	PC, LR, #4					\n\t"
+	);
+
+	/* Otherwise the IRQ mode state is now as it is on entry to any other
+	ISR that switches context. */
+	portSAVE_CONTEXT();
+	__asm volatile ( "bl vTaskSwitchContext" );
+	portRESTORE_CONTEXT();
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortSetInterruptMaskFromISR( void )
+{
+	__asm volatile (
+		"MRS	R0, CPSR		\n\t"	/* Get CPSR.							*/
+		"ORR	R1, R0, #0x80	\n\t"	/* Disable IRQ.							*/
+		"MSR	CPSR_c, R1		\n\t"	/* Write back modified value.			*/
+		"AND	R0, R0, #0x80	\n\t"	/* Return the previous IRQ mask bit.	*/
+		"BX		R14" );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMaskFromISR( unsigned long ulNewMask )
+{
+	__asm volatile (
+		"MRS	R1, CPSR		\n\t"	/* Get CPSR.							*/
+		"BIC	R1, R1, #0x80	\n\t"	/* Clear the IRQ mask bit...			*/
+		"ORR	R1, R1, R0		\n\t"	/* ...then restore the saved value.		*/
+		"MSR	CPSR_c, R1		\n\t"	/* Write back modified value.			*/
+		"BX		R14" );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_NESTED_IRQ */
+
 /* 
  * The ISR used for the scheduler tick.
  */
+#if configUSE_NESTED_IRQ == 1
+
+void vTickISR( void )
+{
+unsigned long ulSavedInterruptMask;
+
+	/* Called from vPortNestedIRQHandler(), which saves the context and ends
+	the interrupt in the VIC. */
+	ulSavedInterruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		vTaskIncrementTick();
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( ulSavedInterruptMask );
+
+	#if configUSE_PREEMPTION == 1
+		portYIELD_FROM_ISR();
+	#endif
+
+	/* Ready for the next interrupt. */
+	T0_IR = portTIMER_MATCH_ISR_BIT;
+}
+
+#else
+
 void vTickISR( void ) __attribute__((naked));
 void vTickISR( void )
 {
@@ -158,6 +293,8 @@ void vTickISR( void )
 	/* Restore the context of the new task. */
 	portRESTORE_CONTEXT();
 }
+
+#endif /* configUSE_NESTED_IRQ */
 /*-----------------------------------------------------------*/
 
 /*
@@ -187,7 +187,44 @@ extern volatile unsigned portLONG ulCriticalNesting;					\
 }
 
 extern void vTaskSwitchContext( void );
-#define portYIELD_FROM_ISR()		vTaskSwitchContext()
+
+/*
+ * With configUSE_NESTED_IRQ set to 1 the IRQ exception vector must branch to
+ * vPortNestedIRQHandler() rather than jump straight to the address held by the
+ * VIC.  The handler reads the VIC vector, which raises the VIC priority mask,
+ * then calls the vector in System mode with IRQs enabled, so the interrupt can
+ * be preempted by any interrupt the VIC gives a higher priority.  Interrupt
+ * handlers are then plain C functions, neither naked nor declared with the
+ * interrupt attribute, and they do not use portSAVE_CONTEXT() or
+ * portRESTORE_CONTEXT() or end the interrupt in the VIC themselves.
+ * portYIELD_FROM_ISR() only records that a context switch is wanted, the
+ * switch is performed once the outermost interrupt has finished.
+ *
+ * Handlers run on the stack of the interrupted task, so each task stack needs
+ * room for the 24 bytes saved per nesting level plus the handlers' own use.
+ */
+#ifndef configUSE_NESTED_IRQ
+	#define configUSE_NESTED_IRQ	0
+#endif
+
+#if configUSE_NESTED_IRQ == 1
+
+	extern volatile unsigned portLONG ulPortYieldRequired;
+	extern unsigned portLONG ulPortSetInterruptMaskFromISR( void ) __attribute__ ((naked));
+	extern void vPortClearInterruptMaskFromISR( unsigned portLONG ulNewMask ) __attribute__ ((naked));
+
+	/* Interrupts nest, so the kernel structures have to be protected from
+	other interrupts while an API function is called from an ISR.  Only IRQ is
+	masked, FIQ cannot use the API. */
+	#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSetInterruptMaskFromISR()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	vPortClearInterruptMaskFromISR( x )
+	#define portYIELD_FROM_ISR()					( ulPortYieldRequired = pdTRUE )
+
+#else
+
+	#define portYIELD_FROM_ISR()		vTaskSwitchContext()
+
+#endif /* configUSE_NESTED_IRQ */
 #define portYIELD()					__asm volatile ( "SWI 0" )
 /*-----------------------------------------------------------*/
 
@@ -87,10 +87,18 @@ static void prvSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__ (( naked ));
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__ (( naked )) KERNEL_FAST_FUNCTION;
+void xPortSysTickHandler( void ) KERNEL_FAST_FUNCTION;
 void vPortSVCHandler( void ) __attribute__ (( naked ));
 
+/*
+ * Used on every context switch and critical section, so placed with the rest
+ * of the kernel fast path if configKERNEL_FAST_CODE_SECTION is defined.
+ */
+void vPortYieldFromISR( void ) KERNEL_FAST_FUNCTION;
+void vPortEnterCritical( void ) KERNEL_FAST_FUNCTION;
+void vPortExitCritical( void ) KERNEL_FAST_FUNCTION;
+
 /*
  * Start first task is a separate function so it can be tested in isolation.
  */
@@ -200,6 +208,11 @@ void vPortEnterCritical( void )
 {
     portDISABLE_INTERRUPTS();
     uxCriticalNesting++;
+
+    if( uxCriticalNesting == 1 )
+    {
+        taskCRITICAL_SECTION_ENTERED();
+    }
 }
 /*-----------------------------------------------------------*/
 
@@ -208,6 +221,7 @@ void vPortExitCritical( void )
     uxCriticalNesting--;
     if( uxCriticalNesting == 0 )
     {
+        taskCRITICAL_SECTION_EXITED();
         portENABLE_INTERRUPTS();
     }
 }
@@ -225,7 +239,18 @@ void xPortPendSVHandler( void )
 	"	ldr	r2, [r3]						\n"
 	"										\n"
 	"	sub r0, r0, #32						\n" /* Make space for the remaining low registers. */
-	"	str r0, [r2]						\n" /* Save the new top of stack. */
+	"	str r0, [r2]						\n" /* Save the new top of stack, which the stack overflow checks use. */
+	"										\n"
+	"	push {r0, r2, r3, r14}				\n" /* r4 to r11 are preserved by vTaskSwitchContext() so are not saved until it is known they need to be. */
+	"	cpsid i								\n"
+	"	bl vTaskSwitchContext				\n"
+	"	cpsie i								\n"
+	"	pop {r0, r1, r2, r3}				\n" /* lr goes in r3. r2 now holds the location of the current TCB, r1 the TCB that was switched out. */
+	"										\n"
+	"	ldr r2, [r2]						\n"
+	"	cmp r1, r2							\n" /* Was the same task selected to run again?  If so its registers are still in place. */
+	"	beq pxSameTaskSelected				\n"
+	"										\n"
 	"	stmia r0!, {r4-r7}					\n" /* Store the low registers that are not saved automatically. */
 	" 	mov r4, r8							\n" /* Store the high registers. */
 	" 	mov r5, r9							\n"
@@ -233,14 +258,7 @@ void xPortPendSVHandler( void )
 	" 	mov r7, r11							\n"
 	" 	stmia r0!, {r4-r7}              	\n"
 	"										\n"
-	"	push {r3, r14}						\n"
-	"	cpsid i								\n"
-	"	bl vTaskSwitchContext				\n"
-	"	cpsie i								\n"
-	"	pop {r2, r3}						\n" /* lr goes in r3. r2 now holds tcb pointer. */
-	"										\n"
-	"	ldr r1, [r2]						\n"
-	"	ldr r0, [r1]						\n" /* The first item in pxCurrentTCB is the task top of stack. */
+	"	ldr r0, [r2]						\n" /* The first item in pxCurrentTCB is the task top of stack. */
 	"	add r0, r0, #16						\n" /* Move to the high registers. */
 	"	ldmia r0!, {r4-r7}					\n" /* Pop the high registers. */
 	" 	mov r8, r4							\n"
@@ -253,6 +271,7 @@ void xPortPendSVHandler( void )
 	"	sub r0, r0, #32						\n" /* Go back for the low registers that are not automatically restored. */
 	" 	ldmia r0!, {r4-r7}              	\n" /* Pop low registers.  */
 	"										\n"
+	"pxSameTaskSelected:					\n"
 	"	bx r3								\n"
 	"										\n"
 	"	.align 2							\n"
@@ -121,6 +121,10 @@ extern void vPortExitCritical( void );
 
 #define portNOP()
 
+/* Places a function in the named section, see configKERNEL_FAST_CODE_SECTION
+in FreeRTOS.h. */
+#define portPLACE_IN_SECTION( pcSection ) __attribute__( ( section( pcSection ) ) )
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,18 +69,37 @@ FreeRTOS.org versions prior to V4.4.0 did not include this definition. */
 /* Constants required to manipulate the NVIC. */
 #define portNVIC_SYSTICK_CTRL		( ( volatile unsigned long *) 0xe000e010 )
 #define portNVIC_SYSTICK_LOAD		( ( volatile unsigned long *) 0xe000e014 )
+#define portNVIC_SYSTICK_CURRENT_VALUE	( ( volatile unsigned long *) 0xe000e018 )
 #define portNVIC_INT_CTRL			( ( volatile unsigned long *) 0xe000ed04 )
 #define portNVIC_SYSPRI2			( ( volatile unsigned long *) 0xe000ed20 )
 #define portNVIC_SYSTICK_CLK		0x00000004
 #define portNVIC_SYSTICK_INT		0x00000002
 #define portNVIC_SYSTICK_ENABLE		0x00000001
+#define portNVIC_SYSTICK_COUNT_FLAG	( 1UL << 16UL )
+
+/* Constants required to implement tickless idle.  The maximum number of
+counts a 24 bit SysTick can be reloaded with, and a small correction for
+the SysTick counts that are lost while the timer is stopped in
+vPortSuppressTicksAndSleep(). */
+#define portMAX_24_BIT_NUMBER		( 0xffffffUL )
+#define portMISSED_COUNTS_FACTOR	( 45UL )
 #define portNVIC_PENDSVSET			0x10000000
+#define portNVIC_PENDSTSET			0x04000000
 #define portNVIC_PENDSV_PRI			( ( ( unsigned long ) configKERNEL_INTERRUPT_PRIORITY ) << 16 )
 #define portNVIC_SYSTICK_PRI		( ( ( unsigned long ) configKERNEL_INTERRUPT_PRIORITY ) << 24 )
 
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR			( 0x01000000 )
 
+/* The index of the PC in the frame stacked on exception entry. */
+#define portSTACKED_PC_INDEX		( 6 )
+
+/* A timer interrupt that takes profiler samples through
+vPortProfilerTimerHandler() has to clear its interrupt request. */
+#ifndef configPROFILER_CLEAR_TIMER_INTERRUPT
+	#define configPROFILER_CLEAR_TIMER_INTERRUPT()
+#endif
+
 /* The priority used by the kernel is assigned to a variable to make access
 from inline assembler easier. */
 const unsigned long ulKernelPriority = configKERNEL_INTERRUPT_PRIORITY;
@@ -89,6 +108,37 @@ const unsigned long ulKernelPriority = configKERNEL_INTERRUPT_PRIORITY;
 variable. */
 static unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
 
+/*
+ * The number of SysTick increments that make up one tick period, the maximum
+ * number of tick periods that can be suppressed without overflowing the 24 bit
+ * SysTick counter, and the compensation applied for the time the SysTick is
+ * stopped while it is being reprogrammed.
+ */
+#if configUSE_TICKLESS_IDLE == 1
+	static unsigned long ulTimerCountsForOneTick = 0;
+	static unsigned long xMaximumPossibleSuppressedTicks = 0;
+	static unsigned long ulStoppedTimerCompensation = 0;
+#endif /* configUSE_TICKLESS_IDLE */
+
+/*
+ * The number of SysTick increments in the tick period set by
+ * xPortSetTickInterruptPeriod().
+ */
+#if configUSE_DYNAMIC_TICK_RATE == 1
+	static unsigned long ulTimerCountsForTickInterrupt = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ );
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+
+/*
+ * The core clock frequency, which also clocks the SysTick.  It only differs
+ * from configCPU_CLOCK_HZ once vPortCpuClockChanged() has been called.
+ */
+#if configUSE_CPU_CLOCK_SCALING == 1
+	static unsigned long ulCpuClockHz = configCPU_CLOCK_HZ;
+	#define portCPU_CLOCK_HZ	ulCpuClockHz
+#else
+	#define portCPU_CLOCK_HZ	configCPU_CLOCK_HZ
+#endif /* configUSE_CPU_CLOCK_SCALING */
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -97,10 +147,25 @@ static void prvSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__ (( naked ));
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__ (( naked )) KERNEL_FAST_FUNCTION;
+void xPortSysTickHandler( void ) KERNEL_FAST_FUNCTION;
 void vPortSVCHandler( void ) __attribute__ (( naked ));
 
+/*
+ * Used on every context switch and critical section, so placed with the rest
+ * of the kernel fast path if configKERNEL_FAST_CODE_SECTION is defined.
+ */
+void vPortYieldFromISR( void ) KERNEL_FAST_FUNCTION;
+void vPortEnterCritical( void ) KERNEL_FAST_FUNCTION;
+void vPortExitCritical( void ) KERNEL_FAST_FUNCTION;
+
+#if configUSE_PROFILER == 1
+	/* Entry point of a timer interrupt used to take profiler samples, and the
+	function it passes the interrupted PC to. */
+	void vPortProfilerTimerHandler( void ) __attribute__ (( naked ));
+	void vPortProfilerTimerSample( unsigned long ulPC );
+#endif
+
 /*
  * Start first task is a separate function so it can be tested in isolation.
  */
@@ -204,6 +269,11 @@ void vPortEnterCritical( void )
 {
 	portDISABLE_INTERRUPTS();
 	uxCriticalNesting++;
+
+	if( uxCriticalNesting == 1 )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
 }
 /*-----------------------------------------------------------*/
 
@@ -212,6 +282,7 @@ void vPortExitCritical( void )
 	uxCriticalNesting--;
 	if( uxCriticalNesting == 0 )
 	{
+		taskCRITICAL_SECTION_EXITED();
 		portENABLE_INTERRUPTS();
 	}
 }
@@ -269,14 +340,380 @@ unsigned long ulDummy;
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_PORT_OPTIMISED_QUEUE_COPY == 1
+
+	void vPortQueueCopy( void *pvDestination, const void *pvSource, unsigned long ulBytes )
+	{
+	unsigned char *pucDestination = ( unsigned char * ) pvDestination;
+	const unsigned char *pucSource = ( const unsigned char * ) pvSource;
+
+		/* ldm and stm fault on an unaligned address, so the burst copy is only
+		used if both ends are word aligned.  Otherwise, and for the tail, the
+		remaining bytes are copied one at a time. */
+		if( ( ( ( unsigned long ) pucDestination | ( unsigned long ) pucSource ) & 0x03UL ) == 0UL )
+		{
+			while( ulBytes >= 16UL )
+			{
+				__asm volatile
+				(
+				"	ldmia %0!, {r2-r5}				\n"
+				"	stmia %1!, {r2-r5}				\n"
+				: "+r" ( pucSource ), "+r" ( pucDestination )
+				:
+				: "r2", "r3", "r4", "r5", "memory"
+				);
+				ulBytes -= 16UL;
+			}
+
+			while( ulBytes >= 4UL )
+			{
+				*( ( unsigned long * ) pucDestination ) = *( ( const unsigned long * ) pucSource );
+				pucDestination += 4;
+				pucSource += 4;
+				ulBytes -= 4UL;
+			}
+		}
+
+		while( ulBytes > 0UL )
+		{
+			*pucDestination = *pucSource;
+			pucDestination++;
+			pucSource++;
+			ulBytes--;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_PORT_OPTIMISED_QUEUE_COPY */
+
+#if configUSE_PROFILER == 1
+
+	unsigned long ulPortGetInterruptedPC( void )
+	{
+	unsigned long *pulFrame;
+
+		/* Only valid in the SysTick handler.  SysTick runs at the lowest
+		priority so only ever interrupts a task, and the frame stacked on
+		entry - R0-R3, R12, LR, PC then xPSR - is on the process stack. */
+		__asm volatile( "mrs %0, psp" : "=r" ( pulFrame ) );
+
+		return pulFrame[ portSTACKED_PC_INDEX ];
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortProfilerTimerHandler( void )
+	{
+		/* This is a naked function, so nothing has been pushed since the
+		exception was taken.  Bit 2 of the EXC_RETURN value in LR says whether
+		the interrupted code was using the process stack (a task) or the main
+		stack (another interrupt).  The branch leaves LR as it is, so
+		vPortProfilerTimerSample() returns from the exception. */
+		__asm volatile
+		(
+		"	tst lr, #4						\n"
+		"	ite eq							\n"
+		"	mrseq r0, msp					\n"
+		"	mrsne r0, psp					\n"
+		"	ldr r0, [r0, #24]				\n" /* The stacked PC. */
+		"	b vPortProfilerTimerSample		\n"
+		);
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortProfilerTimerSample( unsigned long ulPC )
+	{
+		configPROFILER_CLEAR_TIMER_INTERRUPT();
+		vProfilerSampleFromISR( ulPC );
+	}
+
+#endif /* configUSE_PROFILER */
+/*-----------------------------------------------------------*/
+
+#if configUSE_TICKLESS_IDLE == 1
+
+	__attribute__((weak)) void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+	{
+	unsigned long ulReloadValue, ulCompleteTickPeriods, ulCompletedSysTickDecrements, ulSysTickCTRL;
+	portTickType xModifiableIdleTime;
+
+		/* Make sure the SysTick reload value does not overflow the counter. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
+
+		/* Stop the SysTick momentarily.  The time the SysTick is stopped for
+		is accounted for as best it can be, but using the tickless mode will
+		inevitably result in some tiny drift of the time maintained by the
+		kernel with respect to calendar time. */
+		*(portNVIC_SYSTICK_CTRL) &= ~portNVIC_SYSTICK_ENABLE;
+
+		/* Calculate the reload value required to wait xExpectedIdleTime
+		tick periods.  -1 is used because this code will execute part way
+		through one of the tick periods. */
+		ulReloadValue = *(portNVIC_SYSTICK_CURRENT_VALUE) + ( ulTimerCountsForOneTick * ( xExpectedIdleTime - 1UL ) );
+
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			/* The tick period that is running can be more than one tick long.
+			The kernel only asks to sleep past its end, so the ticks it has
+			left after the one the SysTick count is part way through come off
+			the time to wait. */
+			ulReloadValue -= ulTimerCountsForOneTick * ( ( unsigned long ) xTaskGetTicksForNextTickInterrupt() - 1UL );
+		}
+		#endif /* configUSE_DYNAMIC_TICK_RATE */
+
+		if( ulReloadValue > ulStoppedTimerCompensation )
+		{
+			ulReloadValue -= ulStoppedTimerCompensation;
+		}
+
+		/* Enter a critical section but don't use the taskENTER_CRITICAL()
+		method as that will mask interrupts that should exit sleep mode. */
+		__asm volatile( "cpsid i" );
+
+		/* If a context switch is pending or a task is waiting for the scheduler
+		to be unsuspended then abandon the low power entry. */
+		if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+		{
+			/* Restart SysTick from where it was stopped. */
+			*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+
+			/* Re-enable interrupts - see comments above the cpsid instruction
+			above. */
+			__asm volatile( "cpsie i" );
+		}
+		else
+		{
+			/* Set the new reload value. */
+			*(portNVIC_SYSTICK_LOAD) = ulReloadValue;
+
+			/* Clear the SysTick count flag and set the count value back to
+			zero. */
+			*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+
+			/* Restart SysTick. */
+			*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+
+			/* Sleep until something happens.  configPRE_SLEEP_PROCESSING() can
+			set its parameter to 0 to indicate that its implementation contains
+			its own wait for interrupt or wait for event instruction, and so wfi
+			should not be executed again.  However, the original expected idle
+			time variable must remain unmodified, so a copy is taken. */
+			xModifiableIdleTime = xExpectedIdleTime;
+			configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+			if( xModifiableIdleTime > 0 )
+			{
+				__asm volatile( "dsb" );
+				__asm volatile( "wfi" );
+				__asm volatile( "isb" );
+			}
+			configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+			/* Stop SysTick.  Again, the time the SysTick is stopped for is
+			accounted for as best it can be, but using the tickless mode will
+			inevitably result in some tiny drift of the time maintained by the
+			kernel with respect to calendar time. */
+			ulSysTickCTRL = *(portNVIC_SYSTICK_CTRL);
+			*(portNVIC_SYSTICK_CTRL) = ( ulSysTickCTRL & ~portNVIC_SYSTICK_ENABLE );
+
+			/* Re-enable interrupts - see comments above the cpsid instruction
+			above. */
+			__asm volatile( "cpsie i" );
+
+			if( ( ulSysTickCTRL & portNVIC_SYSTICK_COUNT_FLAG ) != 0 )
+			{
+			unsigned long ulCalculatedLoadValue;
+
+				/* The tick interrupt has already executed, and the SysTick
+				count reloaded with ulReloadValue.  Reset the
+				portNVIC_SYSTICK_LOAD with whatever remains of this tick
+				period. */
+				ulCalculatedLoadValue = ( ulTimerCountsForOneTick - 1UL ) - ( ulReloadValue - *(portNVIC_SYSTICK_CURRENT_VALUE) );
+
+				/* Don't allow a tiny value, or values that have somehow
+				underflowed because the post sleep hook did something
+				that took too long. */
+				if( ( ulCalculatedLoadValue < ulStoppedTimerCompensation ) || ( ulCalculatedLoadValue > ulTimerCountsForOneTick ) )
+				{
+					ulCalculatedLoadValue = ( ulTimerCountsForOneTick - 1UL );
+				}
+
+				*(portNVIC_SYSTICK_LOAD) = ulCalculatedLoadValue;
+
+				/* The tick interrupt handler will already have pended the tick
+				processing in the kernel.  As the pending tick will be
+				processed as soon as this function exits, the tick value
+				maintained by the kernel is stepped forward by one less than
+				the time spent waiting. */
+				ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+			}
+			else
+			{
+				/* Something other than the tick interrupt ended the sleep.
+				Work out how long the sleep lasted rounded to complete tick
+				periods (not the ulReload value which accounted for part
+				ticks). */
+				ulCompletedSysTickDecrements = ( xExpectedIdleTime * ulTimerCountsForOneTick ) - *(portNVIC_SYSTICK_CURRENT_VALUE);
+
+				/* How many complete tick periods passed while the processor
+				was waiting? */
+				ulCompleteTickPeriods = ulCompletedSysTickDecrements / ulTimerCountsForOneTick;
+
+				/* The reload value is set to whatever fraction of a single tick
+				period remains. */
+				*(portNVIC_SYSTICK_LOAD) = ( ( ulCompleteTickPeriods + 1UL ) * ulTimerCountsForOneTick ) - ulCompletedSysTickDecrements;
+			}
+
+			/* Restart SysTick so it runs from portNVIC_SYSTICK_LOAD again,
+			then set portNVIC_SYSTICK_LOAD back to its standard value.  The
+			critical section is used to ensure the tick interrupt can only
+			execute once in the case that the reload register is near zero.
+			The tick count is corrected in a single step rather than by
+			processing each suppressed tick individually. */
+			*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+			portENTER_CRITICAL();
+			{
+				*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+				vTaskStepTick( ulCompleteTickPeriods );
+				#if configUSE_DYNAMIC_TICK_RATE == 1
+					*(portNVIC_SYSTICK_LOAD) = ulTimerCountsForTickInterrupt - 1UL;
+				#else
+					*(portNVIC_SYSTICK_LOAD) = ulTimerCountsForOneTick - 1UL;
+				#endif
+			}
+			portEXIT_CRITICAL();
+		}
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if configUSE_DYNAMIC_TICK_RATE == 1
+
+	portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks )
+	{
+	unsigned long ulCounts, ulElapsed;
+
+		/* Make sure the SysTick reload value does not overflow the counter. */
+		if( ( unsigned long ) xTicks > ( portMAX_24_BIT_NUMBER / ( portCPU_CLOCK_HZ / configTICK_RATE_HZ ) ) )
+		{
+			return pdFAIL;
+		}
+
+		ulCounts = ( unsigned long ) xTicks * ( portCPU_CLOCK_HZ / configTICK_RATE_HZ );
+
+		/* Called from a critical section.  The SysTick loads the new value
+		when it next reaches zero, so the tick period that is running keeps
+		its length and no time is lost. */
+		*(portNVIC_SYSTICK_LOAD) = ulCounts - 1UL;
+
+		if( ( *(portNVIC_INT_CTRL) & portNVIC_PENDSTSET ) != 0UL )
+		{
+			/* The SysTick reached zero after the critical section was entered,
+			so the tick period now running was loaded with the old value while
+			the kernel, when it processes the pending tick, takes it to be the
+			new length.  Restart it with the new length less the time it has
+			already run. */
+			*(portNVIC_SYSTICK_CTRL) &= ~portNVIC_SYSTICK_ENABLE;
+			ulElapsed = ( ulTimerCountsForTickInterrupt - 1UL ) - *(portNVIC_SYSTICK_CURRENT_VALUE);
+
+			if( ulElapsed < ( ulCounts - 1UL ) )
+			{
+				*(portNVIC_SYSTICK_LOAD) = ( ulCounts - 1UL ) - ulElapsed;
+			}
+			else
+			{
+				*(portNVIC_SYSTICK_LOAD) = 1UL;
+			}
+
+			*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+			*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+			*(portNVIC_SYSTICK_LOAD) = ulCounts - 1UL;
+		}
+
+		ulTimerCountsForTickInterrupt = ulCounts;
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
+#if configUSE_CPU_CLOCK_SCALING == 1
+
+	void vPortCpuClockChanged( unsigned long ulNewCpuClockHz )
+	{
+	unsigned long ulOldCountsForOneTick, ulNewCountsForOneTick, ulCountsForTickInterrupt, ulCountsLeft;
+
+		/* Called from a critical section straight after the core clock, and
+		with it the SysTick clock, has been changed. */
+		ulOldCountsForOneTick = ulCpuClockHz / configTICK_RATE_HZ;
+		ulNewCountsForOneTick = ulNewCpuClockHz / configTICK_RATE_HZ;
+		ulCpuClockHz = ulNewCpuClockHz;
+
+		#if configUSE_TICKLESS_IDLE == 1
+		{
+			ulTimerCountsForOneTick = ulNewCountsForOneTick;
+			xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			/* The tick period set by xTaskSetTickRate() must still fit the
+			SysTick at the new clock. */
+			ulTimerCountsForTickInterrupt = ( ulTimerCountsForTickInterrupt / ulOldCountsForOneTick ) * ulNewCountsForOneTick;
+			configASSERT( ulTimerCountsForTickInterrupt <= portMAX_24_BIT_NUMBER );
+			ulCountsForTickInterrupt = ulTimerCountsForTickInterrupt;
+		}
+		#else
+		{
+			ulCountsForTickInterrupt = ulNewCountsForOneTick;
+		}
+		#endif /* configUSE_DYNAMIC_TICK_RATE */
+
+		/* Scale what is left of the tick period that is running to the new
+		clock, so the period still ends on time, then put the standard
+		reload value back in the same way vPortSuppressTicksAndSleep() does. */
+		*(portNVIC_SYSTICK_CTRL) &= ~portNVIC_SYSTICK_ENABLE;
+		ulCountsLeft = ( unsigned long ) ( ( ( unsigned long long ) *(portNVIC_SYSTICK_CURRENT_VALUE) * ulNewCountsForOneTick ) / ulOldCountsForOneTick );
+
+		if( ulCountsLeft == 0UL )
+		{
+			ulCountsLeft = 1UL;
+		}
+
+		*(portNVIC_SYSTICK_LOAD) = ulCountsLeft;
+		*(portNVIC_SYSTICK_CURRENT_VALUE) = 0UL;
+		*(portNVIC_SYSTICK_CTRL) |= portNVIC_SYSTICK_ENABLE;
+		*(portNVIC_SYSTICK_LOAD) = ulCountsForTickInterrupt - 1UL;
+	}
+
+#endif /* configUSE_CPU_CLOCK_SCALING */
+/*-----------------------------------------------------------*/
+
 /*
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
  */
 void prvSetupTimerInterrupt( void )
 {
+	/* Calculate the constants required to configure the tick interrupt. */
+	#if configUSE_TICKLESS_IDLE == 1
+	{
+		ulTimerCountsForOneTick = ( portCPU_CLOCK_HZ / configTICK_RATE_HZ );
+		xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+		ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR;
+	}
+	#endif /* configUSE_TICKLESS_IDLE */
+
 	/* Configure SysTick to interrupt at the requested rate. */
-	*(portNVIC_SYSTICK_LOAD) = ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
+	#if configUSE_DYNAMIC_TICK_RATE == 1
+		*(portNVIC_SYSTICK_LOAD) = ulTimerCountsForTickInterrupt - 1UL;
+	#else
+		*(portNVIC_SYSTICK_LOAD) = ( portCPU_CLOCK_HZ / configTICK_RATE_HZ ) - 1UL;
+	#endif
 	*(portNVIC_SYSTICK_CTRL) = portNVIC_SYSTICK_CLK | portNVIC_SYSTICK_INT | portNVIC_SYSTICK_ENABLE;
 }
 /*-----------------------------------------------------------*/
@@ -142,12 +142,117 @@ extern void vPortExitCritical( void );
 #define portEXIT_CRITICAL()			vPortExitCritical()
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Generic helper function. */
+	__attribute__( ( always_inline ) ) static inline unsigned char ucPortCountLeadingZeros( unsigned long ulBitmap )
+	{
+	unsigned char ucReturn;
+
+		__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) );
+		return ucReturn;
+	}
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Tick rate switching. */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+
+/* Core clock scaling. */
+#ifndef portCPU_CLOCK_CHANGED
+	extern void vPortCpuClockChanged( unsigned long ulCpuClockHz );
+	#define portCPU_CLOCK_CHANGED( ulCpuClockHz ) vPortCpuClockChanged( ulCpuClockHz )
+#endif
+
+/* Statistical profiler.  Reads the PC stacked when the SysTick interrupt was
+taken. */
+#ifndef portPROFILER_GET_INTERRUPTED_PC
+	extern unsigned long ulPortGetInterruptedPC( void );
+	#define portPROFILER_GET_INTERRUPTED_PC() ulPortGetInterruptedPC()
+#endif
+
+/* Queue item copy.  Copies word aligned data 16 bytes at a time using ldm and
+stm. */
+#if configUSE_PORT_OPTIMISED_QUEUE_COPY == 1
+	extern void vPortQueueCopy( void *pvDestination, const void *pvSource, unsigned long ulBytes );
+	#define portQUEUE_COPY( pvDestination, pvSource, xBytes ) vPortQueueCopy( ( pvDestination ), ( pvSource ), ( unsigned long ) ( xBytes ) )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 
 #define portNOP()
 
+/* Places a function in the named section, see configKERNEL_FAST_CODE_SECTION
+in FreeRTOS.h. */
+#define portPLACE_IN_SECTION( pcSection ) __attribute__( ( section( pcSection ) ) )
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* Exclusive access and bit-banding, used by the atomic operations in
+Source/atomic.c.  A store exclusive fails if the processor took an exception
+since the load, so no interrupt masking is needed.  The SRAM and peripheral
+bit-band regions are the 1MB at 0x20000000 and at 0x40000000, aliased at
+0x22000000 and 0x42000000 with one word per bit. */
+__attribute__( ( always_inline ) ) static inline unsigned long ulPortLoadExclusive( volatile unsigned long *pulAddress )
+{
+unsigned long ulValue;
+
+	__asm volatile ( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+	return ulValue;
+}
+
+__attribute__( ( always_inline ) ) static inline unsigned long ulPortStoreExclusive( volatile unsigned long *pulAddress, unsigned long ulValue )
+{
+unsigned long ulFailed;
+
+	__asm volatile ( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+	return ulFailed;
+}
+
+__attribute__( ( always_inline ) ) static inline volatile unsigned long *pulPortBitBandAlias( volatile unsigned long *pulAddress, unsigned long ulBit )
+{
+unsigned long ulAddress = ( unsigned long ) pulAddress;
+unsigned long ulRegion = ulAddress & 0xfff00000UL;
+
+	if( ( ulRegion != 0x20000000UL ) && ( ulRegion != 0x40000000UL ) )
+	{
+		return NULL;
+	}
+
+	return ( volatile unsigned long * ) ( ulRegion + 0x02000000UL + ( ( ulAddress & 0x000fffffUL ) << 5UL ) + ( ulBit << 2UL ) );
+}
+
+#define portLOAD_EXCLUSIVE( pulAddress ) ulPortLoadExclusive( pulAddress )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue ) ( ( ulPortStoreExclusive( ( pulAddress ), ( ulValue ) ) == 0UL ) ? pdTRUE : pdFALSE )
+#define portCLEAR_EXCLUSIVE() __asm volatile ( "clrex" ::: "memory" )
+#define portBIT_BAND_ALIAS( pulAddress, uxBit ) pulPortBitBandAlias( ( pulAddress ), ( unsigned long ) ( uxBit ) )
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_NAME_REGISTRY == 1 )
+	#include "name_registry.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /* Constants required to access and manipulate the NVIC. */
@@ -108,11 +112,50 @@ task.h is included from an application file. */
 /* Set the privilege level to user mode if xRunningPrivileged is false. */
 #define portRESET_PRIVILEGE( xRunningPrivileged ) if( xRunningPrivileged != pdTRUE ) __asm volatile ( " mrs r0, control \n orr r0, #1 \n msr control, r0" :::"r0" )
 
+/* Non zero if a wrapper can make its call with a single SVC - that is the call
+cannot block and the calling task is unprivileged.  A privileged task calls the
+API function directly, as before, as it might be inside a critical section,
+where an SVC would fault. */
+#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+	#define portUSE_SYSTEM_CALL( xCannotBlock ) ( ( xCannotBlock ) && ( prvRunningUnprivileged() != pdFALSE ) )
+#else
+	#define portUSE_SYSTEM_CALL( xCannotBlock ) ( pdFALSE )
+#endif
+
+/* Execute SVC ucSVCNumber with the four parameters in r0 to r3, and set xResult
+to the value the SVC handler leaves in r0.  r1 to r3 are restored from the
+exception frame, so are not changed. */
+#define portSYSTEM_CALL( ucSVCNumber, xResult, ulParameter1, ulParameter2, ulParameter3, ulParameter4 )	\
+{																										\
+register unsigned long ulR0 __asm( "r0" ) = ( unsigned long ) ( ulParameter1 );						\
+register unsigned long ulR1 __asm( "r1" ) = ( unsigned long ) ( ulParameter2 );						\
+register unsigned long ulR2 __asm( "r2" ) = ( unsigned long ) ( ulParameter3 );						\
+register unsigned long ulR3 __asm( "r3" ) = ( unsigned long ) ( ulParameter4 );						\
+																										\
+	__asm volatile ( "	svc %4	\n" : "+r" ( ulR0 ) : "r" ( ulR1 ), "r" ( ulR2 ), "r" ( ulR3 ), "i" ( ucSVCNumber ) : "memory" );	\
+	( xResult ) = ulR0;																					\
+}
+
+/* A system call runs in the SVC handler with the privilege bit of the thread
+mode cleared, so the prvRaisePrivilege() calls made by vPortEnterCritical()
+and vPortExitCritical() within the API function do not execute a nested SVC.
+The bit is set again before the handler returns to the task. */
+#define portENTER_SYSTEM_CALL( ulControl ) __asm volatile ( " mrs %0, control \n bic r1, %0, #1 \n msr control, r1" : "=r" ( ulControl ) :: "r1" )
+#define portEXIT_SYSTEM_CALL( ulControl ) __asm volatile ( " msr control, %0" :: "r" ( ulControl ) )
+
 /* Each task maintains its own interrupt status in the critical nesting
 variable.  Note this is not saved as part of the task context as context
 switches can only occur when uxCriticalNesting is zero. */
 static unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
 
+/* The MPU settings that were last written to the MPU.  If the task being
+switched in is the one whose settings are already loaded, and they have not
+been changed since, the MPU does not need to be reprogrammed - as happens at
+every tick when no other task is ready.  Any call to vPortStoreTaskMPUSettings()
+clears this so the next context switch always reloads.  Not static as it is
+accessed from the inline assembler. */
+xMPU_SETTINGS *pxLoadedMPUSettings PRIVILEGED_DATA = NULL;
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -130,6 +173,13 @@ static void prvSetupMPU( void ) PRIVILEGED_FUNCTION;
  */
 static unsigned long prvGetMPURegionSizeSetting( unsigned long ulActualSizeInBytes ) PRIVILEGED_FUNCTION;
 
+/*
+ * Fill in the stack guard region of a task from the start of its stack.
+ */
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	static void prvSetStackGuardRegion( xMPU_SETTINGS *xMPUSettings, portSTACK_TYPE *pxBottomOfStack ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Checks to see if being called from the context of an unprivileged task, and
  * if so raises the privilege level and returns false - otherwise does nothing
@@ -137,6 +187,28 @@ static unsigned long prvGetMPURegionSizeSetting( unsigned long ulActualSizeInByt
  */
 static portBASE_TYPE prvRaisePrivilege( void ) __attribute__(( naked ));
 
+#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+
+	/*
+	 * Returns pdTRUE if called from an unprivileged task, otherwise pdFALSE.
+	 */
+	static inline portBASE_TYPE prvRunningUnprivileged( void ) __attribute__(( always_inline ));
+
+	/*
+	 * Called from the SVC handler to make system call ulCall with the
+	 * parameters in pulParameters[ 0 ] to pulParameters[ 3 ].  Returns pdFAIL
+	 * if ulCall is not valid, otherwise sets *pulResult and returns pdPASS.
+	 */
+	static portBASE_TYPE prvSystemCall( unsigned long ulCall, const unsigned long * const pulParameters, unsigned long *pulResult ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from the SVC handler to make the calls passed to
+	 * uxPortSystemCallBatch(), returning the number made.
+	 */
+	static unsigned long prvSystemCallBatch( xPortSystemCall * const pxCalls, unsigned long ulNumberOfCalls ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Standard FreeRTOS exception handlers.
  */
@@ -162,6 +234,10 @@ signed portBASE_TYPE MPU_xTaskGenericCreate( pdTASK_CODE pvTaskCode, const signe
 void MPU_vTaskAllocateMPURegions( xTaskHandle xTask, const xMemoryRegion * const xRegions );
 void MPU_vTaskDelete( xTaskHandle pxTaskToDelete );
 void MPU_vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement );
+void MPU_vTaskSetDeadline( xTaskHandle xTask, portTickType xRelativeDeadline );
+void MPU_vTaskSetBudget( xTaskHandle xTask, portTickType xBudget, portTickType xPeriod );
+void MPU_vTaskPreemptionThresholdSet( xTaskHandle xTask, unsigned portBASE_TYPE uxNewThreshold );
+unsigned portBASE_TYPE MPU_uxTaskPreemptionThresholdGet( xTaskHandle xTask );
 void MPU_vTaskDelay( portTickType xTicksToDelay );
 unsigned portBASE_TYPE MPU_uxTaskPriorityGet( xTaskHandle pxTask );
 void MPU_vTaskPrioritySet( xTaskHandle pxTask, unsigned portBASE_TYPE uxNewPriority );
@@ -171,28 +247,58 @@ void MPU_vTaskResume( xTaskHandle pxTaskToResume );
 void MPU_vTaskSuspendAll( void );
 signed portBASE_TYPE MPU_xTaskResumeAll( void );
 portTickType MPU_xTaskGetTickCount( void );
+portTickCountType MPU_xTaskGetTickCount64( void );
 unsigned portBASE_TYPE MPU_uxTaskGetNumberOfTasks( void );
 void MPU_vTaskList( signed char *pcWriteBuffer );
 void MPU_vTaskGetRunTimeStats( signed char *pcWriteBuffer );
+unsigned portBASE_TYPE MPU_uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime );
 void MPU_vTaskStartTrace( signed char * pcBuffer, unsigned long ulBufferSize );
 unsigned long MPU_ulTaskEndTrace( void );
 void MPU_vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxTagValue );
 pdTASK_HOOK_CODE MPU_xTaskGetApplicationTaskTag( xTaskHandle xTask );
+void MPU_vTaskSetThreadLocalStoragePointer( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue );
+void *MPU_pvTaskGetThreadLocalStoragePointer( xTaskHandle xTaskToQuery, portBASE_TYPE xIndex );
 portBASE_TYPE MPU_xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter );
 unsigned portBASE_TYPE MPU_uxTaskGetStackHighWaterMark( xTaskHandle xTask );
+unsigned portBASE_TYPE MPU_uxTaskGetSampledStackHighWaterMark( xTaskHandle xTask );
+portRUN_TIME_COUNTER_TYPE MPU_ulTaskGetMaxCriticalSectionTime( void );
+void MPU_vTaskResetMaxCriticalSectionTime( void );
 xTaskHandle MPU_xTaskGetCurrentTaskHandle( void );
 portBASE_TYPE MPU_xTaskGetSchedulerState( void );
+portBASE_TYPE MPU_xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue );
+portBASE_TYPE MPU_xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );
+unsigned long MPU_ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );
+portBASE_TYPE MPU_xTaskNotifyStateClear( xTaskHandle xTask );
 xQueueHandle MPU_xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType );
 signed portBASE_TYPE MPU_xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition );
 unsigned portBASE_TYPE MPU_uxQueueMessagesWaiting( const xQueueHandle pxQueue );
+unsigned portBASE_TYPE MPU_uxQueueSpacesAvailable( const xQueueHandle pxQueue );
 signed portBASE_TYPE MPU_xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking );
+unsigned portBASE_TYPE MPU_uxQueueSendMultiple( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait );
+unsigned portBASE_TYPE MPU_uxQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait );
+void *MPU_pvQueueReserveSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+void MPU_vQueueCommitSlot( xQueueHandle xQueue );
+void *MPU_pvQueueBorrowSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+void MPU_vQueueReleaseSlot( xQueueHandle xQueue );
 xQueueHandle MPU_xQueueCreateMutex( void );
 xQueueHandle MPU_xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount );
+signed portBASE_TYPE MPU_xQueueSemaphoreGiveMultiple( xQueueHandle xQueue, unsigned portBASE_TYPE uxCount );
+signed portBASE_TYPE MPU_xQueueSemaphoreTakeMultiple( xQueueHandle xQueue, unsigned portBASE_TYPE uxCount, portTickType xTicksToWait );
 portBASE_TYPE MPU_xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime );
+signed portBASE_TYPE MPU_xQueueGenericSendUntil( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xWakeTime, portBASE_TYPE xCopyPosition );
+signed portBASE_TYPE MPU_xQueueGenericReceiveUntil( xQueueHandle pxQueue, void * const pvBuffer, portTickType xWakeTime, portBASE_TYPE xJustPeeking );
+portBASE_TYPE MPU_xQueueTakeMutexRecursiveUntil( xQueueHandle xMutex, portTickType xWakeTime );
 portBASE_TYPE MPU_xQueueGiveMutexRecursive( xQueueHandle xMutex );
 signed portBASE_TYPE MPU_xQueueAltGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition );
 signed portBASE_TYPE MPU_xQueueAltGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking );
 void MPU_vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcName );
+void MPU_vQueueGetInfo( xQueueHandle xQueue, xQueueStatusType *pxQueueStatus );
+unsigned portBASE_TYPE MPU_uxQueueGetSystemState( xQueueStatusType *pxQueueStatusArray, unsigned portBASE_TYPE uxArraySize );
+xQueueSetHandle MPU_xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength );
+portBASE_TYPE MPU_xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+portBASE_TYPE MPU_xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet );
+xQueueSetMemberHandle MPU_xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks );
+void MPU_vQueueCacheFlush( void );
 void *MPU_pvPortMalloc( size_t xSize );
 void MPU_vPortFree( void *pv );
 void MPU_vPortInitialiseBlocks( void );
@@ -256,6 +362,9 @@ void vPortSVCHandler( void )
 static void prvSVCHandler(	unsigned long *pulParam )
 {
 unsigned char ucSVCNumber;
+#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+	unsigned long ulControl;
+#endif
 
 	/* The stack contains: r0, r1, r2, r3, r12, r14, the return address and
 	xPSR.  The first argument (r0) is pulParam[ 0 ]. */
@@ -278,7 +387,24 @@ unsigned char ucSVCNumber;
 											);
 											break;
 
-		default							:	/* Unknown SVC call. */
+		#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+			case portSVC_SYSTEM_CALL_BATCH	:	pulParam[ 0 ] = prvSystemCallBatch( ( xPortSystemCall * ) pulParam[ 0 ], pulParam[ 1 ] );
+												break;
+		#endif
+
+		default							:	/* A system call, or an unknown SVC call. */
+											#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+											{
+												/* The result replaces r0 in the
+												exception frame. */
+												if( ucSVCNumber >= portSVC_FIRST_SYSTEM_CALL )
+												{
+													portENTER_SYSTEM_CALL( ulControl );
+													( void ) prvSystemCall( ( unsigned long ) ucSVCNumber - portSVC_FIRST_SYSTEM_CALL, pulParam, &( pulParam[ 0 ] ) );
+													portEXIT_SYSTEM_CALL( ulControl );
+												}
+											}
+											#endif
 											break;
 	}
 }
@@ -296,6 +422,8 @@ static void prvRestoreContextOfFirstTask( void )
 		"	ldr r1, [r3]					\n"
 		"	ldr r0, [r1]					\n" /* The first item in the TCB is the task top of stack. */
 		"	add r1, r1, #4					\n" /* Move onto the second item in the TCB... */
+		"	ldr r2, pxLoadedMPUSettingsConst2	\n" /* Note whose MPU settings are loaded. */
+		"	str r1, [r2]					\n"
 		"	ldr r2, =0xe000ed9c				\n" /* Region Base Address register. */
 		"	ldmia r1!, {r4-r11}				\n" /* Read 4 sets of MPU registers. */
 		"	stmia r2!, {r4-r11}				\n" /* Write 4 sets of MPU registers. */
@@ -309,6 +437,7 @@ static void prvRestoreContextOfFirstTask( void )
 		"									\n"
 		"	.align 2						\n"
 		"pxCurrentTCBConst2: .word pxCurrentTCB	\n"
+		"pxLoadedMPUSettingsConst2: .word pxLoadedMPUSettings	\n"
 	);
 }
 /*-----------------------------------------------------------*/
@@ -355,6 +484,11 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 	portDISABLE_INTERRUPTS();
 	uxCriticalNesting++;
 
+	if( uxCriticalNesting == 1 )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
+
 	portRESET_PRIVILEGE( xRunningPrivileged );
 }
 /*-----------------------------------------------------------*/
@@ -366,6 +500,7 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 	uxCriticalNesting--;
 	if( uxCriticalNesting == 0 )
 	{
+		taskCRITICAL_SECTION_EXITED();
 		portENABLE_INTERRUPTS();
 	}
 	portRESET_PRIVILEGE( xRunningPrivileged );
@@ -398,9 +533,15 @@ void xPortPendSVHandler( void )
 		"	ldr r1, [r3]						\n"
 		"	ldr r0, [r1]						\n" /* The first item in the TCB is the task top of stack. */
 		"	add r1, r1, #4						\n" /* Move onto the second item in the TCB... */
+		"	ldr r2, pxLoadedMPUSettingsConst	\n" /* Are these MPU settings already loaded? */
+		"	ldr r3, [r2]						\n"
+		"	cmp r1, r3							\n"
+		"	beq 1f								\n" /* If so skip reprogramming the MPU. */
+		"	str r1, [r2]						\n"
 		"	ldr r2, =0xe000ed9c					\n" /* Region Base Address register. */
 		"	ldmia r1!, {r4-r11}					\n" /* Read 4 sets of MPU registers. */
-		"	stmia r2!, {r4-r11}					\n" /* Write 4 sets of MPU registers. */
+		"	stmia r2!, {r4-r11}					\n" /* Write 4 sets of MPU registers through the RBAR/RASR alias registers. */
+		"1:										\n"
 		"	ldmia r0!, {r3, r4-r11}				\n" /* Pop the registers that are not automatically saved on exception entry. */
 		"	msr control, r3						\n"
 		"										\n"
@@ -409,6 +550,7 @@ void xPortPendSVHandler( void )
 		"										\n"
 		"	.align 2							\n"
 		"pxCurrentTCBConst: .word pxCurrentTCB	\n"
+		"pxLoadedMPUSettingsConst: .word pxLoadedMPUSettings	\n"
 		::"i"(configMAX_SYSCALL_INTERRUPT_PRIORITY)
 	);
 }
@@ -530,6 +672,33 @@ unsigned long ulRegionSize, ulReturnValue = 4;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	static void prvSetStackGuardRegion( xMPU_SETTINGS *xMPUSettings, portSTACK_TYPE *pxBottomOfStack )
+	{
+	unsigned long ulGuardAddress;
+
+		/* The guard is read only rather than no access so the stack high
+		water mark can still be read.  Regions must be aligned to their size,
+		so round the start of the stack up to the guard size. */
+		ulGuardAddress = ( ( unsigned long ) pxBottomOfStack + ( portSTACK_GUARD_SIZE - 1UL ) ) & ~( portSTACK_GUARD_SIZE - 1UL );
+
+		xMPUSettings->xRegion[ portTOTAL_NUM_REGIONS - 1 ].ulRegionBaseAddress =
+				( ulGuardAddress ) |
+				( portMPU_REGION_VALID ) |
+				( portSTACK_GUARD_REGION );
+
+		xMPUSettings->xRegion[ portTOTAL_NUM_REGIONS - 1 ].ulRegionAttribute =
+				( portMPU_REGION_READ_ONLY ) |
+				( portMPU_REGION_EXECUTE_NEVER ) |
+				( portMPU_REGION_CACHEABLE_BUFFERABLE ) |
+				( prvGetMPURegionSizeSetting( portSTACK_GUARD_SIZE ) ) |
+				( portMPU_REGION_ENABLE );
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
 static portBASE_TYPE prvRaisePrivilege( void )
 {
 	__asm volatile
@@ -548,6 +717,188 @@ static portBASE_TYPE prvRaisePrivilege( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MPU_SYSTEM_CALLS == 1 )
+
+	/* The functions in the system call table all take the four parameter
+	registers and return r0, converting to and from the parameters of the API
+	function they call. */
+	typedef unsigned long ( *pdSYSTEM_CALL_FUNCTION )( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 );
+
+	static unsigned long prvQueueSendSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+	static unsigned long prvQueueReceiveSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+	static unsigned long prvQueueMessagesWaitingSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+	static unsigned long prvTaskGetTickCountSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+
+	#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+		static unsigned long prvMutexGiveRecursiveSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		static unsigned long prvTaskNotifySystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+		static unsigned long prvTaskNotifyTakeSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 ) PRIVILEGED_FUNCTION;
+	#endif
+
+	/* Indexed by the portSYSTEM_CALL_ numbers.  NULL entries are for API
+	functions excluded from the build. */
+	static const pdSYSTEM_CALL_FUNCTION pxSystemCallTable[ portNUM_SYSTEM_CALLS ] =
+	{
+		prvQueueSendSystemCall,
+		prvQueueReceiveSystemCall,
+		prvQueueMessagesWaitingSystemCall,
+		#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+			prvMutexGiveRecursiveSystemCall,
+		#else
+			NULL,
+		#endif
+		#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+			prvTaskNotifySystemCall,
+			prvTaskNotifyTakeSystemCall,
+		#else
+			NULL,
+			NULL,
+		#endif
+		prvTaskGetTickCountSystemCall
+	};
+
+	/*-----------------------------------------------------------*/
+
+	static inline portBASE_TYPE prvRunningUnprivileged( void )
+	{
+	unsigned long ulControl;
+
+		__asm volatile ( " mrs %0, control" : "=r" ( ulControl ) );
+		return ( portBASE_TYPE ) ( ulControl & 1UL );
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvSystemCall( unsigned long ulCall, const unsigned long * const pulParameters, unsigned long *pulResult )
+	{
+	portBASE_TYPE xReturn = pdFAIL;
+
+		if( ulCall < ( unsigned long ) portNUM_SYSTEM_CALLS )
+		{
+			if( pxSystemCallTable[ ulCall ] != NULL )
+			{
+				*pulResult = pxSystemCallTable[ ulCall ]( pulParameters[ 0 ], pulParameters[ 1 ], pulParameters[ 2 ], pulParameters[ 3 ] );
+				xReturn = pdPASS;
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvSystemCallBatch( xPortSystemCall * const pxCalls, unsigned long ulNumberOfCalls )
+	{
+	unsigned long ulCallsMade, ulControl;
+
+		portENTER_SYSTEM_CALL( ulControl );
+
+		for( ulCallsMade = 0UL; ulCallsMade < ulNumberOfCalls; ulCallsMade++ )
+		{
+			if( prvSystemCall( pxCalls[ ulCallsMade ].ulCall, pxCalls[ ulCallsMade ].ulParameters, &( pxCalls[ ulCallsMade ].ulResult ) ) != pdPASS )
+			{
+				break;
+			}
+		}
+
+		portEXIT_SYSTEM_CALL( ulControl );
+
+		return ulCallsMade;
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxPortSystemCallBatch( xPortSystemCall * const pxCalls, unsigned portBASE_TYPE uxNumberOfCalls )
+	{
+	unsigned portBASE_TYPE uxReturn;
+
+		if( prvRunningUnprivileged() != pdFALSE )
+		{
+			portSYSTEM_CALL( portSVC_SYSTEM_CALL_BATCH, uxReturn, pxCalls, uxNumberOfCalls, 0, 0 );
+		}
+		else
+		{
+			/* A privileged task makes the calls itself.  Suspending the
+			scheduler gives the same result as the SVC handler, which no other
+			task can preempt. */
+			vTaskSuspendAll();
+			{
+				uxReturn = ( unsigned portBASE_TYPE ) prvSystemCallBatch( pxCalls, ( unsigned long ) uxNumberOfCalls );
+			}
+			( void ) xTaskResumeAll();
+		}
+
+		return uxReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvQueueSendSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+	{
+		( void ) ulParameter4;
+		return ( unsigned long ) xQueueGenericSend( ( xQueueHandle ) ulParameter1, ( const void * ) ulParameter2, ( portTickType ) 0U, ( portBASE_TYPE ) ulParameter3 );
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvQueueReceiveSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+	{
+		( void ) ulParameter4;
+		return ( unsigned long ) xQueueGenericReceive( ( xQueueHandle ) ulParameter1, ( void * ) ulParameter2, ( portTickType ) 0U, ( portBASE_TYPE ) ulParameter3 );
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvQueueMessagesWaitingSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+	{
+		( void ) ulParameter2;
+		( void ) ulParameter3;
+		( void ) ulParameter4;
+		return ( unsigned long ) uxQueueMessagesWaiting( ( xQueueHandle ) ulParameter1 );
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvTaskGetTickCountSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+	{
+		( void ) ulParameter1;
+		( void ) ulParameter2;
+		( void ) ulParameter3;
+		( void ) ulParameter4;
+		return ( unsigned long ) xTaskGetTickCount();
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+		static unsigned long prvMutexGiveRecursiveSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+		{
+			( void ) ulParameter2;
+			( void ) ulParameter3;
+			( void ) ulParameter4;
+			return ( unsigned long ) xQueueGiveMutexRecursive( ( xQueueHandle ) ulParameter1 );
+		}
+
+	#endif
+	/*-----------------------------------------------------------*/
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+		static unsigned long prvTaskNotifySystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+		{
+			return ( unsigned long ) xTaskGenericNotify( ( xTaskHandle ) ulParameter1, ulParameter2, ( eNotifyAction ) ulParameter3, ( unsigned long * ) ulParameter4 );
+		}
+		/*-----------------------------------------------------------*/
+
+		static unsigned long prvTaskNotifyTakeSystemCall( unsigned long ulParameter1, unsigned long ulParameter2, unsigned long ulParameter3, unsigned long ulParameter4 )
+		{
+			( void ) ulParameter2;
+			( void ) ulParameter3;
+			( void ) ulParameter4;
+			return ulTaskNotifyTake( ( portBASE_TYPE ) ulParameter1, ( portTickType ) 0U );
+		}
+
+	#endif
+
+#endif /* configUSE_MPU_SYSTEM_CALLS */
+/*-----------------------------------------------------------*/
+
 void vPortStoreTaskMPUSettings( xMPU_SETTINGS *xMPUSettings, const struct xMEMORY_REGION * const xRegions, portSTACK_TYPE *pxBottomOfStack, unsigned short usStackDepth )
 {
 extern unsigned long __SRAM_segment_start__[];
@@ -590,6 +941,17 @@ unsigned long ul;
 			xMPUSettings->xRegion[ ul ].ulRegionBaseAddress = ( portSTACK_REGION + ul ) | portMPU_REGION_VALID;
 			xMPUSettings->xRegion[ ul ].ulRegionAttribute = 0UL;
 		}
+
+		#if( configUSE_MPU_STACK_GUARD == 1 )
+		{
+			/* The stack is only known when the task is being created, at
+			other times the guard region is left as it is. */
+			if( usStackDepth > 0 )
+			{
+				prvSetStackGuardRegion( xMPUSettings, pxBottomOfStack );
+			}
+		}
+		#endif
 	}
 	else
 	{
@@ -610,6 +972,12 @@ unsigned long ul;
 					( prvGetMPURegionSizeSetting( ( unsigned long ) usStackDepth * ( unsigned long ) sizeof( portSTACK_TYPE ) ) ) |
 					( portMPU_REGION_CACHEABLE_BUFFERABLE ) |
 					( portMPU_REGION_ENABLE );
+
+			#if( configUSE_MPU_STACK_GUARD == 1 )
+			{
+				prvSetStackGuardRegion( xMPUSettings, pxBottomOfStack );
+			}
+			#endif
 		}
 
 		lIndex = 0;
@@ -641,6 +1009,10 @@ unsigned long ul;
 			lIndex++;
 		}
 	}
+
+	/* Force the MPU to be reprogrammed at the next context switch in case
+	these are the settings that are currently loaded. */
+	pxLoadedMPUSettings = NULL;
 }
 /*-----------------------------------------------------------*/
 
@@ -686,6 +1058,52 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	void MPU_vTaskSetDeadline( xTaskHandle xTask, portTickType xRelativeDeadline )
+	{
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vTaskSetDeadline( xTask, xRelativeDeadline );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+	void MPU_vTaskSetBudget( xTaskHandle xTask, portTickType xBudget, portTickType xPeriod )
+	{
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vTaskSetBudget( xTask, xBudget, xPeriod );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	void MPU_vTaskPreemptionThresholdSet( xTaskHandle xTask, unsigned portBASE_TYPE uxNewThreshold )
+	{
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vTaskPreemptionThresholdSet( xTask, uxNewThreshold );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	unsigned portBASE_TYPE MPU_uxTaskPreemptionThresholdGet( xTaskHandle xTask )
+	{
+	unsigned portBASE_TYPE uxReturn;
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		uxReturn = uxTaskPreemptionThresholdGet( xTask );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 	void MPU_vTaskDelay( portTickType xTicksToDelay )
 	{
@@ -779,14 +1197,36 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 portTickType MPU_xTaskGetTickCount( void )
 {
 portTickType xReturn;
-portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+portBASE_TYPE xRunningPrivileged;
+
+	if( portUSE_SYSTEM_CALL( pdTRUE ) )
+	{
+		portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_TASK_GET_TICK_COUNT, xReturn, 0, 0, 0, 0 );
+	}
+	else
+	{
+		xRunningPrivileged = prvRaisePrivilege();
+		xReturn = xTaskGetTickCount();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
 
-	xReturn = xTaskGetTickCount();
-    portRESET_PRIVILEGE( xRunningPrivileged );
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_64_BIT_TICKS == 1 )
+	portTickCountType MPU_xTaskGetTickCount64( void )
+	{
+	portTickCountType xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xTaskGetTickCount64();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 unsigned portBASE_TYPE MPU_uxTaskGetNumberOfTasks( void )
 {
 unsigned portBASE_TYPE uxReturn;
@@ -809,6 +1249,19 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+	unsigned portBASE_TYPE MPU_uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+	{
+	unsigned portBASE_TYPE uxReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		uxReturn = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 	void MPU_vTaskGetRunTimeStats( signed char *pcWriteBuffer )
 	{
@@ -868,6 +1321,30 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+	void MPU_vTaskSetThreadLocalStoragePointer( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vTaskSetThreadLocalStoragePointer( xTaskToSet, xIndex, pvValue );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+	void *MPU_pvTaskGetThreadLocalStoragePointer( xTaskHandle xTaskToQuery, portBASE_TYPE xIndex )
+	{
+	void *pvReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		pvReturn = pvTaskGetThreadLocalStoragePointer( xTaskToQuery, xIndex );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_APPLICATION_TASK_TAG == 1 )
 	portBASE_TYPE MPU_xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter )
 	{
@@ -894,6 +1371,43 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configSTACK_SAMPLE_WORDS > 0 )
+	unsigned portBASE_TYPE MPU_uxTaskGetSampledStackHighWaterMark( xTaskHandle xTask )
+	{
+	unsigned portBASE_TYPE uxReturn;
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		uxReturn = uxTaskGetSampledStackHighWaterMark( xTask );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
+	portRUN_TIME_COUNTER_TYPE MPU_ulTaskGetMaxCriticalSectionTime( void )
+	{
+	portRUN_TIME_COUNTER_TYPE ulReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		ulReturn = ulTaskGetMaxCriticalSectionTime();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return ulReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
+	void MPU_vTaskResetMaxCriticalSectionTime( void )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vTaskResetMaxCriticalSectionTime();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetCurrentTaskHandle == 1 )
 	xTaskHandle MPU_xTaskGetCurrentTaskHandle( void )
 	{
@@ -920,6 +1434,76 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	portBASE_TYPE MPU_xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged;
+
+		if( portUSE_SYSTEM_CALL( pdTRUE ) )
+		{
+			portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_TASK_NOTIFY, xReturn, xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue );
+		}
+		else
+		{
+			xRunningPrivileged = prvRaisePrivilege();
+			xReturn = xTaskGenericNotify( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue );
+			portRESET_PRIVILEGE( xRunningPrivileged );
+		}
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	portBASE_TYPE MPU_xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xReturn;
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	unsigned long MPU_ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
+	{
+	unsigned long ulReturn;
+	portBASE_TYPE xRunningPrivileged;
+
+		if( portUSE_SYSTEM_CALL( xTicksToWait == ( portTickType ) 0U ) )
+		{
+			portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_TASK_NOTIFY_TAKE, ulReturn, xClearCountOnExit, 0, 0, 0 );
+		}
+		else
+		{
+			xRunningPrivileged = prvRaisePrivilege();
+			ulReturn = ulTaskNotifyTake( xClearCountOnExit, xTicksToWait );
+			portRESET_PRIVILEGE( xRunningPrivileged );
+		}
+
+		return ulReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	portBASE_TYPE MPU_xTaskNotifyStateClear( xTaskHandle xTask )
+	{
+	portBASE_TYPE xReturn;
+    portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xTaskNotifyStateClear( xTask );
+        portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 xQueueHandle MPU_xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
 {
 xQueueHandle xReturn;
@@ -934,20 +1518,49 @@ portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 signed portBASE_TYPE MPU_xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
 {
 signed portBASE_TYPE xReturn;
-portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+portBASE_TYPE xRunningPrivileged;
+
+	if( portUSE_SYSTEM_CALL( xTicksToWait == ( portTickType ) 0U ) )
+	{
+		portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_QUEUE_SEND, xReturn, xQueue, pvItemToQueue, xCopyPosition, 0 );
+	}
+	else
+	{
+		xRunningPrivileged = prvRaisePrivilege();
+		xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
 
-	xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
-	portRESET_PRIVILEGE( xRunningPrivileged );
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
 unsigned portBASE_TYPE MPU_uxQueueMessagesWaiting( const xQueueHandle pxQueue )
 {
+portBASE_TYPE xRunningPrivileged;
+unsigned portBASE_TYPE uxReturn;
+
+	if( portUSE_SYSTEM_CALL( pdTRUE ) )
+	{
+		portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_QUEUE_MESSAGES_WAITING, uxReturn, pxQueue, 0, 0, 0 );
+	}
+	else
+	{
+		xRunningPrivileged = prvRaisePrivilege();
+		uxReturn = uxQueueMessagesWaiting( pxQueue );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE MPU_uxQueueSpacesAvailable( const xQueueHandle pxQueue )
+{
 portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 unsigned portBASE_TYPE uxReturn;
 
-	uxReturn = uxQueueMessagesWaiting( pxQueue );
+	uxReturn = uxQueueSpacesAvailable( pxQueue );
 	portRESET_PRIVILEGE( xRunningPrivileged );
 	return uxReturn;
 }
@@ -955,15 +1568,120 @@ unsigned portBASE_TYPE uxReturn;
 
 signed portBASE_TYPE MPU_xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking )
 {
-portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+portBASE_TYPE xRunningPrivileged;
 signed portBASE_TYPE xReturn;
 
-	xReturn = xQueueGenericReceive( pxQueue, pvBuffer, xTicksToWait, xJustPeeking );
-	portRESET_PRIVILEGE( xRunningPrivileged );
+	if( portUSE_SYSTEM_CALL( xTicksToWait == ( portTickType ) 0U ) )
+	{
+		portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_QUEUE_RECEIVE, xReturn, pxQueue, pvBuffer, xJustPeeking, 0 );
+	}
+	else
+	{
+		xRunningPrivileged = prvRaisePrivilege();
+		xReturn = xQueueGenericReceive( pxQueue, pvBuffer, xTicksToWait, xJustPeeking );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+	signed portBASE_TYPE MPU_xQueueGenericSendUntil( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xWakeTime, portBASE_TYPE xCopyPosition )
+	{
+	signed portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueGenericSendUntil( xQueue, pvItemToQueue, xWakeTime, xCopyPosition );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+	signed portBASE_TYPE MPU_xQueueGenericReceiveUntil( xQueueHandle pxQueue, void * const pvBuffer, portTickType xWakeTime, portBASE_TYPE xJustPeeking )
+	{
+	signed portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueGenericReceiveUntil( pxQueue, pvBuffer, xWakeTime, xJustPeeking );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE MPU_uxQueueSendMultiple( xQueueHandle xQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait )
+{
+portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+unsigned portBASE_TYPE uxReturn;
+
+	uxReturn = uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+	portRESET_PRIVILEGE( xRunningPrivileged );
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE MPU_uxQueueReceiveMultiple( xQueueHandle xQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait )
+{
+portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+unsigned portBASE_TYPE uxReturn;
+
+	uxReturn = uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+	portRESET_PRIVILEGE( xRunningPrivileged );
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void *MPU_pvQueueReserveSlot( xQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+	void *pvReturn;
+
+		pvReturn = pvQueueReserveSlot( xQueue, xTicksToWait );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void MPU_vQueueCommitSlot( xQueueHandle xQueue )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vQueueCommitSlot( xQueue );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void *MPU_pvQueueBorrowSlot( xQueueHandle xQueue, portTickType xTicksToWait )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+	void *pvReturn;
+
+		pvReturn = pvQueueBorrowSlot( xQueue, xTicksToWait );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void MPU_vQueueReleaseSlot( xQueueHandle xQueue )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vQueueReleaseSlot( xQueue );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 	xQueueHandle MPU_xQueueCreateMutex( void )
 	{
@@ -990,6 +1708,32 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if configUSE_COUNTING_SEMAPHORES == 1
+	signed portBASE_TYPE MPU_xQueueSemaphoreGiveMultiple( xQueueHandle xQueue, unsigned portBASE_TYPE uxCount )
+	{
+	signed portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueSemaphoreGiveMultiple( xQueue, uxCount );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if configUSE_COUNTING_SEMAPHORES == 1
+	signed portBASE_TYPE MPU_xQueueSemaphoreTakeMultiple( xQueueHandle xQueue, unsigned portBASE_TYPE uxCount, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueSemaphoreTakeMultiple( xQueue, uxCount, xTicksToWait );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 	portBASE_TYPE MPU_xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime )
 	{
@@ -1003,19 +1747,41 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
-	portBASE_TYPE MPU_xQueueGiveMutexRecursive( xQueueHandle xMutex )
+#if ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+	portBASE_TYPE MPU_xQueueTakeMutexRecursiveUntil( xQueueHandle xMutex, portTickType xWakeTime )
 	{
 	portBASE_TYPE xReturn;
 	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
 
-		xReturn = xQueueGiveMutexRecursive( xMutex );
+		xReturn = xQueueTakeMutexRecursiveUntil( xMutex, xWakeTime );
 		portRESET_PRIVILEGE( xRunningPrivileged );
 		return xReturn;
 	}
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+	portBASE_TYPE MPU_xQueueGiveMutexRecursive( xQueueHandle xMutex )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged;
+
+		if( portUSE_SYSTEM_CALL( pdTRUE ) )
+		{
+			portSYSTEM_CALL( portSVC_FIRST_SYSTEM_CALL + portSYSTEM_CALL_MUTEX_GIVE_RECURSIVE, xReturn, xMutex, 0, 0, 0 );
+		}
+		else
+		{
+			xRunningPrivileged = prvRaisePrivilege();
+			xReturn = xQueueGiveMutexRecursive( xMutex );
+			portRESET_PRIVILEGE( xRunningPrivileged );
+		}
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if configUSE_ALTERNATIVE_API == 1
 	signed portBASE_TYPE MPU_xQueueAltGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
 	{
@@ -1042,7 +1808,7 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
-#if configQUEUE_REGISTRY_SIZE > 0
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_NAME_REGISTRY == 1 )
 	void MPU_vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcName )
 	{
 	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
@@ -1054,6 +1820,119 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_NAME_REGISTRY == 1 )
+	void *MPU_pvNameRegistryFind( const signed char *pcName, unsigned char ucType )
+	{
+	void *pvReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		pvReturn = pvNameRegistryFind( pcName, ucType );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_NAME_REGISTRY == 1 )
+	unsigned portBASE_TYPE MPU_uxNameRegistryGetFailedAdds( void )
+	{
+	unsigned portBASE_TYPE uxReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		uxReturn = uxNameRegistryGetFailedAdds();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+	void MPU_vQueueGetInfo( xQueueHandle xQueue, xQueueStatusType *pxQueueStatus )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vQueueGetInfo( xQueue, pxQueueStatus );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 )
+	unsigned portBASE_TYPE MPU_uxQueueGetSystemState( xQueueStatusType *pxQueueStatusArray, unsigned portBASE_TYPE uxArraySize )
+	{
+	unsigned portBASE_TYPE uxReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		uxReturn = uxQueueGetSystemState( pxQueueStatusArray, uxArraySize );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueSetHandle MPU_xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+	xQueueSetHandle xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueCreateSet( uxEventQueueLength );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	portBASE_TYPE MPU_xQueueAddToSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	portBASE_TYPE MPU_xQueueRemoveFromSet( xQueueSetMemberHandle xQueueOrSemaphore, xQueueSetHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	xQueueSetMemberHandle MPU_xQueueSelectFromSet( xQueueSetHandle xQueueSet, portTickType xBlockTimeTicks )
+	{
+	xQueueSetMemberHandle xReturn;
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		xReturn = xQueueSelectFromSet( xQueueSet, xBlockTimeTicks );
+		portRESET_PRIVILEGE( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+	void MPU_vQueueCacheFlush( void )
+	{
+	portBASE_TYPE xRunningPrivileged = prvRaisePrivilege();
+
+		vQueueCacheFlush();
+		portRESET_PRIVILEGE( xRunningPrivileged );
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 void *MPU_pvPortMalloc( size_t xSize )
 {
 void *pvReturn;
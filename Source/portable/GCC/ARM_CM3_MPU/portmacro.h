@@ -104,9 +104,29 @@ extern "C" {
 #define portGENERAL_PERIPHERALS_REGION		( 3UL )
 #define portSTACK_REGION					( 4UL )
 #define portFIRST_CONFIGURABLE_REGION	    ( 5UL )
-#define portLAST_CONFIGURABLE_REGION		( 7UL )
-#define portNUM_CONFIGURABLE_REGIONS		( ( portLAST_CONFIGURABLE_REGION - portFIRST_CONFIGURABLE_REGION ) + 1 )
-#define portTOTAL_NUM_REGIONS				( portNUM_CONFIGURABLE_REGIONS + 1 ) /* Plus one to make space for the stack region. */
+
+/* When configUSE_MPU_STACK_GUARD is 1 the highest numbered region is taken
+from the configurable regions and used to make the bottom portSTACK_GUARD_SIZE
+bytes of the task stack read only.  A stack overflow then raises a MemManage
+fault at the offending write, rather than being caught by the fill byte check
+at the next context switch.  Tasks can only define two regions of their own in
+this case. */
+#ifndef configUSE_MPU_STACK_GUARD
+	#define configUSE_MPU_STACK_GUARD 0
+#endif
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	#define portLAST_CONFIGURABLE_REGION	( 6UL )
+	#define portSTACK_GUARD_REGION			( 7UL )
+	#define portSTACK_GUARD_SIZE			( 32UL )
+	#define portNUM_CONFIGURABLE_REGIONS	( ( portLAST_CONFIGURABLE_REGION - portFIRST_CONFIGURABLE_REGION ) + 1 )
+	#define portTOTAL_NUM_REGIONS			( portNUM_CONFIGURABLE_REGIONS + 2 ) /* Plus the stack and stack guard regions. */
+	#define portHAS_STACK_GUARD				1
+#else
+	#define portLAST_CONFIGURABLE_REGION	( 7UL )
+	#define portNUM_CONFIGURABLE_REGIONS	( ( portLAST_CONFIGURABLE_REGION - portFIRST_CONFIGURABLE_REGION ) + 1 )
+	#define portTOTAL_NUM_REGIONS			( portNUM_CONFIGURABLE_REGIONS + 1 ) /* Plus one to make space for the stack region. */
+#endif
 
 #define portSWITCH_TO_USER_MODE() __asm volatile ( " mrs r0, control \n orr r0, #1 \n msr control, r0 " :::"r0" )
 
@@ -116,7 +136,9 @@ typedef struct MPU_REGION_REGISTERS
 	unsigned portLONG ulRegionAttribute;
 } xMPU_REGION_REGISTERS;
 
-/* Plus 1 to create space for the stack region. */
+/* Plus 1 to create space for the stack region (and 1 more for the stack guard
+region when configUSE_MPU_STACK_GUARD is 1).  The context switch code loads
+exactly four regions from here. */
 typedef struct MPU_SETTINGS
 {
 	xMPU_REGION_REGISTERS xRegion[ portTOTAL_NUM_REGIONS ];
@@ -132,6 +154,50 @@ typedef struct MPU_SETTINGS
 #define portSVC_START_SCHEDULER				0
 #define portSVC_YIELD						1
 #define portSVC_RAISE_PRIVILEGE				2
+#define portSVC_SYSTEM_CALL_BATCH			3
+#define portSVC_FIRST_SYSTEM_CALL			16	/* SVC portSVC_FIRST_SYSTEM_CALL + n makes system call n. */
+
+/* When configUSE_MPU_SYSTEM_CALLS is 1 the MPU wrappers of the most used API
+functions do not raise the privilege of an unprivileged task and then lower it
+again.  If the call cannot block, the wrapper instead executes a single SVC
+that selects the API function from a table by the SVC number, with the
+parameters passed in r0 to r3, and the function runs within the SVC handler.
+uxPortSystemCallBatch() executes a sequence of such calls for the cost of one
+SVC. */
+#ifndef configUSE_MPU_SYSTEM_CALLS
+	#define configUSE_MPU_SYSTEM_CALLS 0
+#endif
+
+/* System call numbers, as used in the ulCall member of xPortSystemCall.  The
+parameters are those of the API function, in order, without the block time -
+the queue calls behave as if the block time was zero. */
+#define portSYSTEM_CALL_QUEUE_SEND				0	/* xQueueGenericSend( xQueue, pvItemToQueue, 0, xCopyPosition ). */
+#define portSYSTEM_CALL_QUEUE_RECEIVE			1	/* xQueueGenericReceive( xQueue, pvBuffer, 0, xJustPeeking ). */
+#define portSYSTEM_CALL_QUEUE_MESSAGES_WAITING	2	/* uxQueueMessagesWaiting( xQueue ). */
+#define portSYSTEM_CALL_MUTEX_GIVE_RECURSIVE	3	/* xQueueGiveMutexRecursive( xMutex ). */
+#define portSYSTEM_CALL_TASK_NOTIFY				4	/* xTaskGenericNotify( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue ). */
+#define portSYSTEM_CALL_TASK_NOTIFY_TAKE		5	/* ulTaskNotifyTake( xClearCountOnExit, 0 ). */
+#define portSYSTEM_CALL_TASK_GET_TICK_COUNT		6	/* xTaskGetTickCount(). */
+#define portNUM_SYSTEM_CALLS					7
+
+/* One entry of the array passed to uxPortSystemCallBatch(). */
+typedef struct PORT_SYSTEM_CALL
+{
+	unsigned portLONG ulCall;				/*< One of the portSYSTEM_CALL_ numbers. */
+	unsigned portLONG ulParameters[ 4 ];	/*< The parameters of the call, unused parameters are ignored. */
+	unsigned portLONG ulResult;				/*< Set to the value returned by the call. */
+} xPortSystemCall;
+
+/*
+ * Makes each of the system calls in pxCalls in turn, storing the value
+ * returned by each in its ulResult member, and returns the number of calls
+ * made - which is less than uxNumberOfCalls only if a call number is not
+ * valid, or the API function is excluded from the build.  No other task runs
+ * until the whole batch has been made, so a task woken by one of the calls
+ * does not run until after the last.  Available when
+ * configUSE_MPU_SYSTEM_CALLS is 1.
+ */
+unsigned portBASE_TYPE uxPortSystemCallBatch( xPortSystemCall * const pxCalls, unsigned portBASE_TYPE uxNumberOfCalls );
 
 /* Scheduler utilities. */
 
@@ -183,11 +249,40 @@ extern void vPortExitCritical( void );
 #define portEXIT_CRITICAL()			vPortExitCritical()
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Generic helper function. */
+	__attribute__( ( always_inline ) ) static inline unsigned char ucPortCountLeadingZeros( unsigned long ulBitmap )
+	{
+	unsigned char ucReturn;
+
+		__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) );
+		return ucReturn;
+	}
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 
 #define portNOP()
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
 
 
@@ -93,6 +93,46 @@ extern "C" {
 #define portBYTE_ALIGNMENT			8
 /*-----------------------------------------------------------*/	
 
+/* Stack guard.  When configUSE_MPU_STACK_GUARD is set to 1 the scheduler
+enables the MPU, with the default memory map as the background region, and
+the bottom portSTACK_GUARD_SIZE bytes of the stack of the running task are
+made read only through MPU region portSTACK_GUARD_REGION.  The region is moved
+to the stack of the next task on each context switch.  A stack overflow then
+raises a MemManage fault at the offending write - vApplicationStackOverflowHook()
+is only called by the stack pointer check of configCHECK_FOR_STACK_OVERFLOW,
+the fill byte check is not performed. */
+#ifndef configUSE_MPU_STACK_GUARD
+	#define configUSE_MPU_STACK_GUARD 0
+#endif
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	#define portSTACK_GUARD_REGION		( 7UL )
+	#define portSTACK_GUARD_SIZE		( 32UL )
+	#define portMPU_REGION_BASE_ADDRESS	( ( volatile unsigned long * ) 0xe000ed9c )
+	#define portMPU_REGION_ATTRIBUTE	( ( volatile unsigned long * ) 0xe000eda0 )
+
+	/* Valid bit of the base address register, then read only, execute never,
+	normal memory, a size of 2 ^ ( 4 + 1 ) = 32 bytes and the enable bit of the
+	attribute register. */
+	#define portMPU_REGION_VALID		( 0x10UL )
+	#define portSTACK_GUARD_ATTRIBUTE	( ( 0x06UL << 24UL ) | ( 0x01UL << 28UL ) | ( 0x07UL << 16UL ) | ( 4UL << 1UL ) | 0x01UL )
+
+	#define portHAS_STACK_GUARD			1
+
+	/* Regions must be aligned to their size, so the start of the stack is
+	rounded up to the guard size. */
+	#define portSET_STACK_GUARD( pxStack )																						\
+	{																															\
+		*( portMPU_REGION_BASE_ADDRESS ) = ( ( ( unsigned long ) ( pxStack ) + ( portSTACK_GUARD_SIZE - 1UL ) ) & ~( portSTACK_GUARD_SIZE - 1UL ) ) |	\
+											portMPU_REGION_VALID | portSTACK_GUARD_REGION;										\
+		*( portMPU_REGION_ATTRIBUTE ) = portSTACK_GUARD_ATTRIBUTE;																\
+		__asm volatile( "dsb" ::: "memory" );																					\
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
 
 /* Scheduler utilities. */
 extern void vPortYieldFromISR( void );
@@ -142,12 +182,103 @@ extern void vPortExitCritical( void );
 #define portEXIT_CRITICAL()			vPortExitCritical()
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Generic helper function. */
+	__attribute__( ( always_inline ) ) static inline unsigned char ucPortCountLeadingZeros( unsigned long ulBitmap )
+	{
+	unsigned char ucReturn;
+
+		__asm volatile ( "clz %0, %1" : "=r" ( ucReturn ) : "r" ( ulBitmap ) );
+		return ucReturn;
+	}
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - ucPortCountLeadingZeros( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Tick rate switching. */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+
+/* Core clock scaling. */
+#ifndef portCPU_CLOCK_CHANGED
+	extern void vPortCpuClockChanged( unsigned long ulCpuClockHz );
+	#define portCPU_CLOCK_CHANGED( ulCpuClockHz ) vPortCpuClockChanged( ulCpuClockHz )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 
 #define portNOP()
 
+/* Places a function in the named section, see configKERNEL_FAST_CODE_SECTION
+in FreeRTOS.h. */
+#define portPLACE_IN_SECTION( pcSection ) __attribute__( ( section( pcSection ) ) )
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* Exclusive access and bit-banding, used by the atomic operations in
+Source/atomic.c.  A store exclusive fails if the processor took an exception
+since the load, so no interrupt masking is needed.  The SRAM and peripheral
+bit-band regions are the 1MB at 0x20000000 and at 0x40000000, aliased at
+0x22000000 and 0x42000000 with one word per bit. */
+__attribute__( ( always_inline ) ) static inline unsigned long ulPortLoadExclusive( volatile unsigned long *pulAddress )
+{
+unsigned long ulValue;
+
+	__asm volatile ( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+	return ulValue;
+}
+
+__attribute__( ( always_inline ) ) static inline unsigned long ulPortStoreExclusive( volatile unsigned long *pulAddress, unsigned long ulValue )
+{
+unsigned long ulFailed;
+
+	__asm volatile ( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+	return ulFailed;
+}
+
+__attribute__( ( always_inline ) ) static inline volatile unsigned long *pulPortBitBandAlias( volatile unsigned long *pulAddress, unsigned long ulBit )
+{
+unsigned long ulAddress = ( unsigned long ) pulAddress;
+unsigned long ulRegion = ulAddress & 0xfff00000UL;
+
+	if( ( ulRegion != 0x20000000UL ) && ( ulRegion != 0x40000000UL ) )
+	{
+		return NULL;
+	}
+
+	return ( volatile unsigned long * ) ( ulRegion + 0x02000000UL + ( ( ulAddress & 0x000fffffUL ) << 5UL ) + ( ulBit << 2UL ) );
+}
+
+#define portLOAD_EXCLUSIVE( pulAddress ) ulPortLoadExclusive( pulAddress )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue ) ( ( ulPortStoreExclusive( ( pulAddress ), ( ulValue ) ) == 0UL ) ? pdTRUE : pdFALSE )
+#define portCLEAR_EXCLUSIVE() __asm volatile ( "clrex" ::: "memory" )
+#define portBIT_BAND_ALIAS( pulAddress, uxBit ) pulPortBitBandAlias( ( pulAddress ), ( unsigned long ) ( uxBit ) )
+
 #ifdef __cplusplus
 }
 #endif
@@ -86,6 +86,18 @@ any details of its type. */
 typedef void tskTCB;
 extern volatile tskTCB * volatile pxCurrentTCB;
 
+/* If configISR_STACK_SIZE is defined then the tick interrupt and portYIELD()
+run the kernel on this stack, once the context of the task has been saved,
+rather than on the stack of the task.  Task stacks then only need room for the
+context and for any application interrupt.  Interrupts must not be enabled by
+code run on this stack, which includes the tick hook. */
+#ifdef configISR_STACK_SIZE
+	portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] = { 0 };
+
+	/* The AVR decrements the stack pointer after each push. */
+	portSTACK_TYPE * const xISRStackTop = &( xISRStack[ configISR_STACK_SIZE - 1 ] );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* 
@@ -197,6 +209,23 @@ extern volatile tskTCB * volatile pxCurrentTCB;
 					"pop	r0						\n\t"	\
 				);
 
+/*
+ * Moves the stack pointer to the top of the interrupt stack.  Only used once
+ * portSAVE_CONTEXT() has saved the stack pointer of the task, which
+ * portRESTORE_CONTEXT() then loads again.  r28 and r29 have been saved with
+ * the context so can be used.
+ */
+#ifdef configISR_STACK_SIZE
+	#define portSWITCH_TO_ISR_STACK()								\
+		asm volatile (	"lds	r28, xISRStackTop		\n\t"	\
+						"lds	r29, xISRStackTop + 1	\n\t"	\
+						"out	__SP_L__, r28			\n\t"	\
+						"out	__SP_H__, r29			\n\t"	\
+					);
+#else
+	#define portSWITCH_TO_ISR_STACK()
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -355,6 +384,7 @@ void vPortYield( void ) __attribute__ ( ( naked ) );
 void vPortYield( void )
 {
 	portSAVE_CONTEXT();
+	portSWITCH_TO_ISR_STACK();
 	vTaskSwitchContext();
 	portRESTORE_CONTEXT();
 
@@ -366,14 +396,18 @@ void vPortYield( void )
  * Context switch function used by the tick.  This must be identical to 
  * vPortYield() from the call to vTaskSwitchContext() onwards.  The only
  * difference from vPortYield() is the tick count is incremented as the
- * call comes from the tick ISR.
+ * call comes from the tick ISR.  The cooperative scheduler only uses it when
+ * the interrupt stack is used, and the same task is then restored.
  */
 void vPortYieldFromTick( void ) __attribute__ ( ( naked ) );
 void vPortYieldFromTick( void )
 {
 	portSAVE_CONTEXT();
+	portSWITCH_TO_ISR_STACK();
 	vTaskIncrementTick();
-	vTaskSwitchContext();
+	#if configUSE_PREEMPTION == 1
+		vTaskSwitchContext();
+	#endif
 	portRESTORE_CONTEXT();
 
 	asm volatile ( "ret" );
@@ -419,12 +453,13 @@ unsigned char ucHighByte, ucLowByte;
 }
 /*-----------------------------------------------------------*/
 
-#if configUSE_PREEMPTION == 1
+#if ( configUSE_PREEMPTION == 1 ) || defined( configISR_STACK_SIZE )
 
 	/*
-	 * Tick ISR for preemptive scheduler.  We can use a naked attribute as
-	 * the context is saved at the start of vPortYieldFromTick().  The tick
-	 * count is incremented after the context is saved.
+	 * Tick ISR for preemptive scheduler, or for the cooperative scheduler when
+	 * the interrupt stack is used.  We can use a naked attribute as the
+	 * context is saved at the start of vPortYieldFromTick().  The tick count
+	 * is incremented after the context is saved.
 	 */
 	void SIG_OUTPUT_COMPARE1A( void ) __attribute__ ( ( signal, naked ) );
 	void SIG_OUTPUT_COMPARE1A( void )
@@ -129,6 +129,11 @@ void vPortEnterCritical( void )
 		} while( 1 );
 	}
 	ulCriticalNesting++;
+
+	if( ulCriticalNesting == 1UL )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
 }
 /*-----------------------------------------------------------*/
 
@@ -137,6 +142,7 @@ void vPortExitCritical( void )
 	ulCriticalNesting--;
 	if( ulCriticalNesting == 0 )
 	{
+		taskCRITICAL_SECTION_EXITED();
 		portENABLE_INTERRUPTS();
 	}
 }
@@ -74,6 +74,14 @@
 #define portTIMER_CHANNEL				( ( unsigned char ) 0x02 )
 #define portMSTP13						( ( unsigned short ) 0x2000 )
 
+/* The interrupt stack described in portmacro.h.  ER7 must stay even. */
+#ifdef configISR_STACK_SIZE
+	portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] __attribute__ ( ( aligned ( 2 ) ) ) = { 0 };
+
+	/* The H8S decrements the stack pointer before each push. */
+	portSTACK_TYPE * const xISRStackTop = &( xISRStack[ configISR_STACK_SIZE & ~1 ] );
+#endif
+
 /*
  * Setup TPU channel one for the RTOS tick at the requested frequency.
  */
@@ -251,6 +259,7 @@ void vPortEndScheduler( void )
 void vPortYield( void )
 {
 	portSAVE_STACK_POINTER();
+	portSWITCH_TO_ISR_STACK();
 		vTaskSwitchContext();
 	portRESTORE_STACK_POINTER();
 }
@@ -271,6 +280,7 @@ void vPortYield( void )
 	void vTickISR( void )
 	{
 		portSAVE_STACK_POINTER();
+		portSWITCH_TO_ISR_STACK();
 		
 		vTaskIncrementTick();
 		vTaskSwitchContext();
@@ -281,6 +291,27 @@ void vPortYield( void )
 		portRESTORE_STACK_POINTER();
 	}
 
+#elif defined( configISR_STACK_SIZE )
+
+	/*
+	 * The cooperative scheduler is being used with the interrupt stack.  The
+	 * context is saved so the tick count can be incremented on the interrupt
+	 * stack, then the same task is restored.
+	 */
+	void vTickISR( void ) __attribute__ ( ( saveall, interrupt_handler ) );
+	void vTickISR( void )
+	{
+		portSAVE_STACK_POINTER();
+		portSWITCH_TO_ISR_STACK();
+
+		vTaskIncrementTick();
+
+		/* Clear the interrupt. */
+		TSR1 &= ~0x01;
+
+		portRESTORE_STACK_POINTER();
+	}
+
 #else
 
 	/*
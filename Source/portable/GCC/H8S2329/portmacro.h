@@ -133,11 +133,33 @@ extern void* pxCurrentTCB;										\
 				);												\
 	( void ) pxCurrentTCB;
 
+/* If configISR_STACK_SIZE is defined then, once the stack pointer of the task
+has been saved, the tick interrupt, portYIELD() and the switching ISRs below
+run on an interrupt stack of that many bytes rather than on the stack of the
+task.  Task stacks then only need room for the context and for any other
+interrupt.  Interrupts must not be enabled by code run on this stack, which
+includes the tick hook. */
+#ifdef configISR_STACK_SIZE
+
+	#define portSWITCH_TO_ISR_STACK()								\
+	extern portSTACK_TYPE * const xISRStackTop;						\
+																	\
+		asm volatile(												\
+						"MOV.L	@_xISRStackTop, ER7			\n\t"	\
+					);												\
+		( void ) xISRStackTop;
+
+#else
+
+	#define portSWITCH_TO_ISR_STACK()
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Macros to allow a context switch from within an application ISR. */
 
-#define portENTER_SWITCHING_ISR() portSAVE_STACK_POINTER(); {
+#define portENTER_SWITCHING_ISR() portSAVE_STACK_POINTER(); portSWITCH_TO_ISR_STACK(); {
 
 #define portEXIT_SWITCHING_ISR( x )							\
 	if( x )													\
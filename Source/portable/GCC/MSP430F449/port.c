@@ -93,6 +93,18 @@ usCriticalNesting will get set to zero when the scheduler starts, but must
 not be initialised to zero as this will cause problems during the startup
 sequence. */
 volatile unsigned short usCriticalNesting = portINITIAL_CRITICAL_NESTING;
+
+/* If configISR_STACK_SIZE is defined then the tick interrupt and portYIELD()
+run the kernel on this stack, once the context of the task has been saved,
+rather than on the stack of the task.  Task stacks then only need room for the
+context and for any application interrupt.  Interrupts must not be enabled by
+code run on this stack, which includes the tick hook. */
+#ifdef configISR_STACK_SIZE
+	portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] = { 0 };
+
+	/* The msp430 decrements the stack pointer before each push. */
+	portSTACK_TYPE * const xISRStackTop = &( xISRStack[ configISR_STACK_SIZE ] );
+#endif
 /*-----------------------------------------------------------*/
 
 /* 
@@ -151,6 +163,19 @@ volatile unsigned short usCriticalNesting = portINITIAL_CRITICAL_NESTING;
 					"bic	#(0xf0),0(r1)			\n\t"	\
 					"reti							\n\t"	\
 				);
+
+/*
+ * Macro to move the stack pointer to the top of the interrupt stack.  Only
+ * used once portSAVE_CONTEXT() has saved the stack pointer of the task, which
+ * portRESTORE_CONTEXT() then loads again.
+ */
+#ifdef configISR_STACK_SIZE
+	#define portSWITCH_TO_ISR_STACK()								\
+		asm volatile (	"mov.w	xISRStackTop, r1		\n\t"	\
+					);
+#else
+	#define portSWITCH_TO_ISR_STACK()
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -269,6 +294,7 @@ void vPortYield( void )
 
 	/* Save the context of the current task. */
 	portSAVE_CONTEXT();
+	portSWITCH_TO_ISR_STACK();
 
 	/* Switch to the highest priority task that is ready to run. */
 	vTaskSwitchContext();
@@ -324,6 +350,7 @@ static void prvSetupTimerInterrupt( void )
 	{
 		/* Save the context of the interrupted task. */
 		portSAVE_CONTEXT();
+		portSWITCH_TO_ISR_STACK();
 
 		/* Increment the tick count then switch to the highest priority task
 		that is ready to run. */
@@ -334,6 +361,24 @@ static void prvSetupTimerInterrupt( void )
 		portRESTORE_CONTEXT();
 	}
 
+#elif defined( configISR_STACK_SIZE )
+
+	/*
+	 * Tick ISR for the cooperative scheduler when the interrupt stack is
+	 * used.  The context is saved so the tick count can be incremented on the
+	 * interrupt stack, then the same task is restored.
+	 */
+	interrupt (TIMERA0_VECTOR) prvTickISR( void ) __attribute__ ( ( naked ) );
+	interrupt (TIMERA0_VECTOR) prvTickISR( void )
+	{
+		portSAVE_CONTEXT();
+		portSWITCH_TO_ISR_STACK();
+
+		vTaskIncrementTick();
+
+		portRESTORE_CONTEXT();
+	}
+
 #else
 
 	/*
@@ -81,6 +81,14 @@ FSR register is saved as part of the task context.  portINITIAL_FSR is the value
 given to the FSR register when the initial context is set up for a task being
 created. */
 #define portINITIAL_FSR				( 0U )
+
+/* Set configUSE_FAST_INTERRUPT_DISPATCH to 1 in FreeRTOSConfig.h to have
+interrupts dispatched by vPortInterruptDispatch() instead of by the Xilinx
+XIntc_DeviceInterruptHandler() function.  This requires the interrupt
+controller to be built with the interrupt vector register (IVR). */
+#ifndef configUSE_FAST_INTERRUPT_DISPATCH
+	#define configUSE_FAST_INTERRUPT_DISPATCH 0
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -93,6 +101,12 @@ static long prvInitialiseInterruptController( void );
  */
 static long prvEnsureInterruptControllerIsInitialised( void );
 
+/*
+ * Called from _interrupt_handler in portasm.S to service every pending
+ * interrupt when configUSE_FAST_INTERRUPT_DISPATCH is 1.
+ */
+void vPortInterruptDispatch( void );
+
 /*-----------------------------------------------------------*/
 
 /* Counts the nesting depth of calls to portENTER_CRITICAL().  Each task 
@@ -467,4 +481,51 @@ long lStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_FAST_INTERRUPT_DISPATCH == 1
+
+	void vPortInterruptDispatch( void )
+	{
+	const unsigned long ulBaseAddress = ( unsigned long ) xInterruptControllerInstance.BaseAddress;
+	const XIntc_Config * const pxConfig = xInterruptControllerInstance.CfgPtr;
+	const XIntc_VectorTableEntry *pxEntry;
+	unsigned long ulID, ulMask;
+
+		/* XIntc_DeviceInterruptHandler() reads the pending interrupts and then
+		tests each bit in turn.  The interrupt vector register instead holds
+		the number of the highest priority interrupt that is both pending and
+		enabled, or all ones when there is none, so the handler for each
+		interrupt is found by a single read and is called directly from the
+		handler table that XIntc_Connect() fills.  The register is read again
+		after each interrupt is serviced, so every pending interrupt is
+		serviced before returning, as with XIN_SVC_ALL_ISRS_OPTION.  Any
+		context switch requested by a handler is still performed once, by
+		_interrupt_handler, when this function returns. */
+		ulID = XIntc_In32( ulBaseAddress + XIN_IVR_OFFSET );
+
+		while( ulID < ( unsigned long ) XPAR_INTC_MAX_NUM_INTR_INPUTS )
+		{
+			ulMask = 1UL << ulID;
+			pxEntry = &( pxConfig->HandlerTable[ ulID ] );
+
+			/* Edge triggered interrupts are acknowledged before they are
+			serviced, so an edge that occurs while the handler is running is
+			not lost.  Level triggered interrupts are acknowledged after, once
+			the handler has cleared the source. */
+			if( ( pxConfig->AckBeforeService & ulMask ) != 0UL )
+			{
+				XIntc_Out32( ulBaseAddress + XIN_IAR_OFFSET, ulMask );
+				pxEntry->Handler( pxEntry->CallBackRef );
+			}
+			else
+			{
+				pxEntry->Handler( pxEntry->CallBackRef );
+				XIntc_Out32( ulBaseAddress + XIN_IAR_OFFSET, ulMask );
+			}
+
+			ulID = XIntc_In32( ulBaseAddress + XIN_IVR_OFFSET );
+		}
+	}
+
+#endif /* configUSE_FAST_INTERRUPT_DISPATCH */
+/*-----------------------------------------------------------*/
 
@@ -51,6 +51,14 @@
     licensing and training services.
 */
 
+/* Set configUSE_LAZY_FPU_CONTEXT to 1 in FreeRTOSConfig.h to only save and
+restore the flop context when it has to change hands - see below. */
+#ifndef configUSE_LAZY_FPU_CONTEXT
+	#define configUSE_LAZY_FPU_CONTEXT 0
+#endif
+
+#if configUSE_LAZY_FPU_CONTEXT == 0
+
 /* When switching out a task, if the task tag contains a buffer address then
 save the flop context into the buffer. */
 #define traceTASK_SWITCHED_OUT()											\
@@ -69,3 +77,42 @@ load the flop context from the buffer. */
 		vPortRestoreFPURegisters( ( void * ) ( pxCurrentTCB->pxTaskTag ) );	\
 	}
 
+#else /* configUSE_LAZY_FPU_CONTEXT */
+
+/* The flop registers are left holding the context of the last task that had
+a buffer and ran.  pvPortFPUOwner points to that task's buffer.  The context
+is only saved and restored when a different task that has a buffer is switched
+in, so switching to tasks that do not use the flop registers, and back again,
+does not touch the flop registers at all.  Note this means a task's buffer only
+holds its latest flop context once another task with a buffer has run, so the
+flop register test in the demo applications requires this option to be 0.  A
+buffer must not be freed or replaced while its task owns the flop context,
+other than by deleting the task. */
+extern void *pvPortFPUOwner;
+
+#define traceTASK_SWITCHED_OUT()
+
+#define traceTASK_SWITCHED_IN()												\
+	if( ( pxCurrentTCB->pxTaskTag != NULL ) && ( ( void * ) ( pxCurrentTCB->pxTaskTag ) != pvPortFPUOwner ) )	\
+	{																		\
+		extern void vPortSaveFPURegisters( void * );						\
+		extern void vPortRestoreFPURegisters( void * );						\
+																			\
+		if( pvPortFPUOwner != NULL )										\
+		{																	\
+			vPortSaveFPURegisters( pvPortFPUOwner );						\
+		}																	\
+		vPortRestoreFPURegisters( ( void * ) ( pxCurrentTCB->pxTaskTag ) );	\
+		pvPortFPUOwner = ( void * ) ( pxCurrentTCB->pxTaskTag );			\
+	}
+
+/* A deleted task no longer owns the flop context, so there is nothing to
+save the next time a task that has a buffer is switched in. */
+#define traceTASK_DELETE( pxTaskToDelete )									\
+	if( ( void * ) ( ( pxTaskToDelete )->pxTaskTag ) == pvPortFPUOwner )	\
+	{																		\
+		pvPortFPUOwner = NULL;												\
+	}
+
+#endif /* configUSE_LAZY_FPU_CONTEXT */
+
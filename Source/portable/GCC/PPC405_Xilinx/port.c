@@ -114,6 +114,16 @@ extern void vPortStartFirstTask( void );
 /* Structure used to hold the state of the interrupt controller. */
 static XIntc xInterruptController;
 
+#if configUSE_FPU == 1
+	#if configUSE_LAZY_FPU_CONTEXT == 1
+
+		/* The buffer of the task whose flop context is currently held in the
+		flop registers.  See FPU_Macros.h. */
+		void *pvPortFPUOwner = NULL;
+
+	#endif
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* 
@@ -0,0 +1,669 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX simulator.
+ *
+ * The whole application runs in a single host thread.  Each task executes
+ * within its own host context (see getcontext()/makecontext()) and a context
+ * switch is a swapcontext() between them, so only one task can ever be
+ * executing and the behaviour of the scheduler is the same as on a single core
+ * target.
+ *
+ * Interrupts are simulated in the same way as the Win32 simulator - each is
+ * represented by a bit in ulPendingInterrupts, and handlers are installed
+ * using vPortSetInterruptHandler().  Pending interrupts are processed in the
+ * context of the running task whenever simulated interrupts are enabled.
+ *
+ * When configSIMULATOR_VIRTUAL_TIME is 0 the tick interrupt is generated by a
+ * SIGALRM from the host interval timer, which is blocked while simulated
+ * interrupts are disabled.  When configSIMULATOR_VIRTUAL_TIME is 1 no signals
+ * are used - a tick is generated each time the idle task runs, and after
+ * every configSIMULATOR_CRITICAL_SECTIONS_PER_TICK critical sections so tasks
+ * that poll the kernel without blocking are still time sliced.  The execution
+ * therefore only depends on the application, and time advances as fast as the
+ * host can execute it.  Tasks that execute continuously without calling the
+ * kernel at all (the flop and integer math demo tasks for example) are not
+ * time sliced with other tasks of equal priority in this mode.
+ *----------------------------------------------------------*/
+
+/* Required for the ucontext, signal and timer functions when building with
+strict compiler settings. */
+#define _XOPEN_SOURCE 600
+
+#include <ucontext.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define portMAX_INTERRUPTS				( ( unsigned long ) sizeof( unsigned long ) * 8UL ) /* The number of bits in an unsigned long. */
+#define portNO_CRITICAL_NESTING 		( ( unsigned long ) 0 )
+
+/* The host signal used to generate the tick when configSIMULATOR_VIRTUAL_TIME
+is 0. */
+#define portTICK_SIGNAL					SIGALRM
+
+/* The size of the host stack allocated to each task.  Host library functions
+(printf() in particular) use a lot more stack than tasks on an embedded target,
+so this is independent of the stack size passed into xTaskCreate(). */
+#ifndef configSIMULATOR_STACK_SIZE
+	#define configSIMULATOR_STACK_SIZE	( 64UL * 1024UL )
+#endif
+
+/* The number of critical sections that are treated as taking one tick period
+when configSIMULATOR_VIRTUAL_TIME is 1.  Set to 0 to only advance virtual time
+while the idle task is running. */
+#ifndef configSIMULATOR_CRITICAL_SECTIONS_PER_TICK
+	#define configSIMULATOR_CRITICAL_SECTIONS_PER_TICK	( 1000UL )
+#endif
+
+#if configSIMULATOR_VIRTUAL_TIME == 0
+	#define portBLOCK_TICK_SIGNAL()		prvSetTickSignalMask( SIG_BLOCK )
+	#define portUNBLOCK_TICK_SIGNAL()	prvSetTickSignalMask( SIG_UNBLOCK )
+#else
+	#define portBLOCK_TICK_SIGNAL()
+	#define portUNBLOCK_TICK_SIGNAL()
+#endif
+
+/*
+ * The function each task's host context starts in.  It calls the task
+ * function of the task referenced by pxCurrentTCB.
+ */
+static void prvTaskEntryPoint( void );
+
+/*
+ * Process all the simulated interrupts - each represented by a bit in
+ * ulPendingInterrupts variable - and perform a context switch if any of the
+ * handlers require one.  Must be called with simulated interrupts enabled and
+ * the tick signal blocked.
+ */
+static void prvProcessSimulatedInterrupts( void );
+
+/*
+ * Interrupt handlers used by the kernel itself.
+ */
+static unsigned long prvProcessYieldInterrupt( void );
+static unsigned long prvProcessTickInterrupt( void );
+
+#if configSIMULATOR_VIRTUAL_TIME == 0
+
+	/*
+	 * Block or unblock the tick signal, depending on xHow.
+	 */
+	static void prvSetTickSignalMask( int xHow );
+
+	/*
+	 * Start the host interval timer that generates the tick signal, or stop
+	 * it if xRun is pdFALSE.
+	 */
+	static void prvSetTickTimer( portBASE_TYPE xRun );
+
+	/*
+	 * The host signal handler for the tick signal.
+	 */
+	static void prvTickSignalHandler( int iSignal );
+
+#endif /* configSIMULATOR_VIRTUAL_TIME */
+
+/*-----------------------------------------------------------*/
+
+/* The state held for each task.  It is allocated from the host heap as a
+ucontext_t is larger than the stack of many tasks, and a pointer to it is the
+only thing held on the stack allocated by the kernel. */
+typedef struct
+{
+	/* The host context in which the task executes. */
+	ucontext_t xContext;
+
+	/* The host stack used by xContext. */
+	void *pvHostStack;
+
+	/* The function implementing the task, and its parameter. */
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+
+} xThreadState;
+
+/* Simulated interrupts waiting to be processed.  This is a bit mask where each
+bit represents one interrupt. */
+static volatile unsigned long ulPendingInterrupts = 0UL;
+
+/* The critical nesting count.  No context switch can occur from within a
+critical section so a single count is shared by all the tasks.  It is
+initialised to a non-zero value so interrupts do not become enabled during the
+initialisation phase, and is set to zero when the first task starts. */
+static volatile unsigned long ulCriticalNesting = 9999UL;
+
+/* pdTRUE when simulated interrupts are enabled, and pdTRUE while simulated
+interrupts are being processed.  Interrupts are only processed when the first
+is pdTRUE and the second pdFALSE. */
+static volatile portBASE_TYPE xInterruptsEnabled = pdFALSE;
+static volatile portBASE_TYPE xInsideInterrupt = pdFALSE;
+
+#if ( configSIMULATOR_VIRTUAL_TIME == 1 ) && ( configSIMULATOR_CRITICAL_SECTIONS_PER_TICK > 0 )
+	/* The number of critical sections exited by tasks since the last tick. */
+	static unsigned long ulCriticalSectionsThisTick = 0UL;
+#endif
+
+/* Handlers for all the simulated software interrupts.  The first two positions
+are used for the Yield and Tick interrupts, all the other interrupts can be user
+defined. */
+static unsigned long (*ulIsrHandler[ portMAX_INTERRUPTS ])( void ) = { 0 };
+
+/* The host context that called vTaskStartScheduler(), returned to by
+vPortEndScheduler(). */
+static ucontext_t xSchedulerContext;
+
+/* Pointer to the TCB of the currently executing task. */
+extern void *pxCurrentTCB;
+
+/* The thread state of a task is referenced from the top of its stack, which is
+the first member of its TCB. */
+#define portTHREAD_STATE( pvTCB )	( ( xThreadState * ) *( *( portSTACK_TYPE ** ) ( pvTCB ) ) )
+
+/*-----------------------------------------------------------*/
+
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState;
+
+	/* The host heap must not be entered by two tasks at once, so the tick
+	signal is blocked while it is being used. */
+	portBLOCK_TICK_SIGNAL();
+	{
+		pxThreadState = ( xThreadState * ) malloc( sizeof( xThreadState ) );
+		configASSERT( pxThreadState );
+		pxThreadState->pvHostStack = malloc( configSIMULATOR_STACK_SIZE );
+		configASSERT( pxThreadState->pvHostStack );
+	}
+	if( ( xInterruptsEnabled != pdFALSE ) && ( xInsideInterrupt == pdFALSE ) )
+	{
+		portUNBLOCK_TICK_SIGNAL();
+	}
+
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+
+	/* Create the context in which the task will start.  The tick signal is
+	blocked in the new context, as context switches only occur with it
+	blocked. */
+	getcontext( &( pxThreadState->xContext ) );
+	pxThreadState->xContext.uc_stack.ss_sp = pxThreadState->pvHostStack;
+	pxThreadState->xContext.uc_stack.ss_size = configSIMULATOR_STACK_SIZE;
+	pxThreadState->xContext.uc_link = NULL;
+	#if configSIMULATOR_VIRTUAL_TIME == 0
+	{
+		sigaddset( &( pxThreadState->xContext.uc_sigmask ), portTICK_SIGNAL );
+	}
+	#endif
+	makecontext( &( pxThreadState->xContext ), prvTaskEntryPoint, 0 );
+
+	/* The stack allocated by the kernel holds only a pointer to the thread
+	state. */
+	pxTopOfStack--;
+	*pxTopOfStack = ( portSTACK_TYPE ) pxThreadState;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntryPoint( void )
+{
+xThreadState *pxThreadState = portTHREAD_STATE( pxCurrentTCB );
+
+	/* This task was started by a context switch from within
+	prvProcessSimulatedInterrupts(), or by xPortStartScheduler().  Either way
+	the task starts with interrupts enabled and no critical nesting. */
+	ulCriticalNesting = portNO_CRITICAL_NESTING;
+	xInsideInterrupt = pdFALSE;
+	vPortEnableInterrupts();
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not return from their implementing function. */
+	#if( INCLUDE_vTaskDelete == 1 )
+	{
+		vTaskDelete( NULL );
+	}
+	#endif
+
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+#if configSIMULATOR_VIRTUAL_TIME == 0
+	struct sigaction xAction;
+#endif
+
+	/* Install the interrupt handlers used by the scheduler itself. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	#if configSIMULATOR_VIRTUAL_TIME == 0
+	{
+		/* Interrupts are already disabled, so the signal remains blocked until
+		the first task enables them. */
+		xAction.sa_handler = prvTickSignalHandler;
+		xAction.sa_flags = SA_RESTART;
+		sigfillset( &( xAction.sa_mask ) );
+		sigaction( portTICK_SIGNAL, &xAction, NULL );
+
+		prvSetTickTimer( pdTRUE );
+	}
+	#endif
+
+	/* Start the highest priority task. */
+	ulCriticalNesting = portNO_CRITICAL_NESTING;
+	swapcontext( &xSchedulerContext, &( portTHREAD_STATE( pxCurrentTCB )->xContext ) );
+
+	/* Only reached if vPortEndScheduler() is called. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	vPortDisableInterrupts();
+
+	#if configSIMULATOR_VIRTUAL_TIME == 0
+	{
+		prvSetTickTimer( pdFALSE );
+	}
+	#endif
+
+	/* Return to the context that started the scheduler.  The tasks are not
+	deleted. */
+	xInsideInterrupt = pdFALSE;
+	setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvProcessTickInterrupt( void )
+{
+unsigned long ulSwitchRequired;
+
+	#if ( configSIMULATOR_VIRTUAL_TIME == 1 ) && ( configSIMULATOR_CRITICAL_SECTIONS_PER_TICK > 0 )
+	{
+		/* A new tick period starts now. */
+		ulCriticalSectionsThisTick = 0UL;
+	}
+	#endif
+
+	/* Process the tick itself. */
+	vTaskIncrementTick();
+	#if( configUSE_PREEMPTION != 0 )
+	{
+		/* A context switch is only automatically performed from the tick
+		interrupt if the pre-emptive scheduler is being used. */
+		ulSwitchRequired = pdTRUE;
+	}
+	#else
+	{
+		ulSwitchRequired = pdFALSE;
+	}
+	#endif
+
+	return ulSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSimulatedInterrupts( void )
+{
+unsigned long ulSwitchRequired, i;
+void *pvOldCurrentTCB;
+
+	while( ulPendingInterrupts != 0UL )
+	{
+		/* Set on each iteration as the flag is cleared by other tasks while
+		this task is switched out. */
+		xInsideInterrupt = pdTRUE;
+
+		/* Used to indicate whether the simulated interrupt processing has
+		necessitated a context switch to another task. */
+		ulSwitchRequired = pdFALSE;
+
+		/* For each interrupt we are interested in processing, each of which is
+		represented by a bit in the ulPendingInterrupts variable. */
+		for( i = 0; i < portMAX_INTERRUPTS; i++ )
+		{
+			/* Is the simulated interrupt pending? */
+			if( ( ulPendingInterrupts & ( 1UL << i ) ) != 0UL )
+			{
+				/* Clear the interrupt pending bit before running the handler
+				so the handler can raise the interrupt again. */
+				ulPendingInterrupts &= ~( 1UL << i );
+
+				/* Is a handler installed? */
+				if( ulIsrHandler[ i ] != NULL )
+				{
+					/* Run the actual handler. */
+					if( ulIsrHandler[ i ]() != pdFALSE )
+					{
+						ulSwitchRequired = pdTRUE;
+					}
+				}
+			}
+		}
+
+		if( ulSwitchRequired != pdFALSE )
+		{
+			pvOldCurrentTCB = pxCurrentTCB;
+
+			/* Select the next task to run. */
+			vTaskSwitchContext();
+
+			/* If the task selected to enter the running state is not the task
+			that is already in the running state. */
+			if( pvOldCurrentTCB != pxCurrentTCB )
+			{
+				/* Execution continues here when the old task is next selected,
+				still inside this function, so any interrupts raised in the
+				mean time are processed before the task continues. */
+				swapcontext( &( portTHREAD_STATE( pvOldCurrentTCB )->xContext ), &( portTHREAD_STATE( pxCurrentTCB )->xContext ) );
+			}
+		}
+	}
+
+	xInsideInterrupt = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( unsigned long ulInterruptNumber )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		portBLOCK_TICK_SIGNAL();
+		ulPendingInterrupts |= ( 1UL << ulInterruptNumber );
+
+		/* The simulated interrupt is now held pending, but don't actually
+		process it yet if this call is within a critical section or a simulated
+		interrupt handler. */
+		if( ( xInterruptsEnabled != pdFALSE ) && ( xInsideInterrupt == pdFALSE ) )
+		{
+			prvProcessSimulatedInterrupts();
+			portUNBLOCK_TICK_SIGNAL();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( unsigned long ulInterruptNumber, unsigned long (*pvHandler)( void ) )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		portBLOCK_TICK_SIGNAL();
+		ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+
+		if( ( xInterruptsEnabled != pdFALSE ) && ( xInsideInterrupt == pdFALSE ) )
+		{
+			portUNBLOCK_TICK_SIGNAL();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	portBLOCK_TICK_SIGNAL();
+	xInterruptsEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsEnabled = pdTRUE;
+
+	if( xInsideInterrupt == pdFALSE )
+	{
+		/* Were any interrupts set to pending while interrupts were
+		(simulated) disabled? */
+		if( ulPendingInterrupts != 0UL )
+		{
+			prvProcessSimulatedInterrupts();
+		}
+
+		portUNBLOCK_TICK_SIGNAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortDisableInterrupts();
+	ulCriticalNesting++;
+
+	if( ulCriticalNesting == 1 )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		ulCriticalNesting--;
+
+		if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			taskCRITICAL_SECTION_EXITED();
+
+			#if ( configSIMULATOR_VIRTUAL_TIME == 1 ) && ( configSIMULATOR_CRITICAL_SECTIONS_PER_TICK > 0 )
+			{
+				/* Charge virtual time for the use of the kernel.  The tick is
+				processed as interrupts are enabled below. */
+				if( xInsideInterrupt == pdFALSE )
+				{
+					ulCriticalSectionsThisTick++;
+
+					if( ulCriticalSectionsThisTick >= configSIMULATOR_CRITICAL_SECTIONS_PER_TICK )
+					{
+						ulPendingInterrupts |= ( 1UL << portINTERRUPT_TICK );
+					}
+				}
+			}
+			#endif
+
+			vPortEnableInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pvTCB )
+{
+xThreadState *pxThreadState = portTHREAD_STATE( pvTCB );
+
+	/* This is called by the idle task after the task has been deleted, so the
+	host stack is no longer in use. */
+	portBLOCK_TICK_SIGNAL();
+	{
+		free( pxThreadState->pvHostStack );
+		free( pxThreadState );
+	}
+	if( ( xInterruptsEnabled != pdFALSE ) && ( xInsideInterrupt == pdFALSE ) )
+	{
+		portUNBLOCK_TICK_SIGNAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTimeCounterValue( void )
+{
+struct timespec xTime;
+
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &xTime );
+	return ( ( unsigned long ) xTime.tv_sec * 1000000UL ) + ( ( unsigned long ) xTime.tv_nsec / 1000UL );
+}
+/*-----------------------------------------------------------*/
+
+#if configSIMULATOR_VIRTUAL_TIME == 1
+
+	void vPortIdleTaskHook( void )
+	{
+		/* Nothing is ready to run other than the idle task, so move time on to
+		the next tick straight away. */
+		vPortGenerateSimulatedInterrupt( portINTERRUPT_TICK );
+	}
+
+#endif /* configSIMULATOR_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+#if configUSE_TICKLESS_IDLE != 0
+
+	void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime )
+	{
+	#if configSIMULATOR_VIRTUAL_TIME == 0
+		struct timespec xSleepTime;
+	#endif
+
+		/* Enter a critical section but don't use the taskENTER_CRITICAL()
+		method as that would also update the critical nesting count. */
+		vPortDisableInterrupts();
+
+		/* If a context switch is pending or a task is waiting for the scheduler
+		to be unsuspended then abandon the low power entry. */
+		if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+		{
+			vPortEnableInterrupts();
+			return;
+		}
+
+		#if configSIMULATOR_VIRTUAL_TIME == 0
+		{
+			/* Stop the tick and sleep for the expected idle time, less the
+			tick period that is already partly complete. */
+			prvSetTickTimer( pdFALSE );
+			xSleepTime.tv_sec = ( time_t ) ( ( xExpectedIdleTime - 1UL ) / configTICK_RATE_HZ );
+			xSleepTime.tv_nsec = ( long ) ( ( ( xExpectedIdleTime - 1UL ) % configTICK_RATE_HZ ) * ( 1000000000UL / configTICK_RATE_HZ ) );
+			nanosleep( &xSleepTime, NULL );
+			prvSetTickTimer( pdTRUE );
+		}
+		#endif
+
+		/* Account for the ticks that were skipped.  The tick that ends the
+		idle period is generated as normal, and wakes the task that was due to
+		unblock. */
+		vTaskStepTick( xExpectedIdleTime - 1UL );
+
+		#if configSIMULATOR_VIRTUAL_TIME == 1
+		{
+			ulPendingInterrupts |= ( 1UL << portINTERRUPT_TICK );
+		}
+		#endif
+
+		vPortEnableInterrupts();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if configSIMULATOR_VIRTUAL_TIME == 0
+
+	static void prvSetTickSignalMask( int xHow )
+	{
+	sigset_t xSignals;
+
+		sigemptyset( &xSignals );
+		sigaddset( &xSignals, portTICK_SIGNAL );
+		sigprocmask( xHow, &xSignals, NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSetTickTimer( portBASE_TYPE xRun )
+	{
+	struct itimerval xTimer;
+
+		xTimer.it_interval.tv_sec = 0;
+		xTimer.it_interval.tv_usec = 0;
+
+		if( xRun != pdFALSE )
+		{
+			/* The interval timer reloads itself, so the tick period does not
+			drift with the time taken to process each tick. */
+			xTimer.it_interval.tv_usec = ( long ) ( 1000000UL / configTICK_RATE_HZ );
+		}
+
+		xTimer.it_value = xTimer.it_interval;
+		setitimer( ITIMER_REAL, &xTimer, NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTickSignalHandler( int iSignal )
+	{
+		/* Just to prevent compiler warnings. */
+		( void ) iSignal;
+
+		/* The signal is only unblocked while simulated interrupts are enabled,
+		so the tick can be processed straight away.  If a context switch
+		results the handler returns when this task next runs. */
+		ulPendingInterrupts |= ( 1UL << portINTERRUPT_TICK );
+		prvProcessSimulatedInterrupts();
+	}
+
+#endif /* configSIMULATOR_VIRTUAL_TIME */
+
@@ -0,0 +1,187 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/******************************************************************************
+	Defines
+******************************************************************************/
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	unsigned portLONG
+#define portBASE_TYPE	portLONG
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef unsigned portSHORT portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffff
+#else
+	/* portLONG is 64 bits on LP64 hosts, but the kernel expects the tick count
+	to wrap at portMAX_DELAY, so the tick type is kept at 32 bits. */
+	typedef unsigned int portTickType;
+	#define portMAX_DELAY ( portTickType ) 0xffffffff
+#endif
+
+/* Hardware specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_RATE_MS			( ( portTickType ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+
+/* Set configSIMULATOR_VIRTUAL_TIME to 1 in FreeRTOSConfig.h to decouple the
+tick from the host clock.  The tick is then generated each time the idle task
+runs, so simulated time advances as fast as the host can execute the
+application, and the execution is deterministic because no host signals are
+used.  When set to 0 the tick is generated from the host's interval timer at
+configTICK_RATE_HZ. */
+#ifndef configSIMULATOR_VIRTUAL_TIME
+	#define configSIMULATOR_VIRTUAL_TIME 0
+#endif
+
+#define portYIELD()					vPortGenerateSimulatedInterrupt( portINTERRUPT_YIELD )
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( ( xSwitchRequired ) != pdFALSE ) vPortGenerateSimulatedInterrupt( portINTERRUPT_YIELD )
+#define portYIELD_FROM_ISR( xSwitchRequired ) portEND_SWITCHING_ISR( xSwitchRequired )
+
+/* Simulated interrupt (tick signal) masking. */
+void vPortDisableInterrupts( void );
+void vPortEnableInterrupts( void );
+#define portDISABLE_INTERRUPTS()	vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()		vPortEnableInterrupts()
+
+/* Critical section handling. */
+void vPortEnterCritical( void );
+void vPortExitCritical( void );
+
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+
+/* Each task runs on a stack allocated from the host, which is freed when the
+kernel frees the task's TCB. */
+void vPortCleanUpTCB( void *pvTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+
+#if( configSIMULATOR_VIRTUAL_TIME == 1 )
+	/* Virtual time advances by one tick each time the idle task runs. */
+	void vPortIdleTaskHook( void );
+	#define portIDLE_TASK_HOOK()	vPortIdleTaskHook()
+#endif
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void * pvParameters )
+
+#define portNOP()
+
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Store/clear the ready priorities in a bit map.  configMAX_PRIORITIES
+	must not exceed the number of bits in an unsigned long. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( ( sizeof( unsigned long ) * 8UL ) - 1UL - __builtin_clzl( ( unsigned long ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle functionality. */
+#if configUSE_TICKLESS_IDLE != 0
+	#ifndef portSUPPRESS_TICKS_AND_SLEEP
+		extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+		#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+	#endif
+#endif
+/*-----------------------------------------------------------*/
+
+#define portINTERRUPT_YIELD				( 0UL )
+#define portINTERRUPT_TICK				( 1UL )
+
+/*
+ * Raise the simulated interrupt ulInterruptNumber.  The interrupt is processed
+ * immediately if simulated interrupts are enabled, otherwise it is held pending
+ * until they are.  It can be called from tasks and from simulated interrupt
+ * handlers, but not from other host threads.
+ */
+void vPortGenerateSimulatedInterrupt( unsigned long ulInterruptNumber );
+
+/*
+ * Install an interrupt handler to be called when the simulated interrupt
+ * ulInterruptNumber is processed.  The interrupt number must be above any used
+ * by the kernel itself (at the time of writing the kernel was using interrupt
+ * numbers 0 and 1 as defined above).  The number must also be lower than the
+ * number of bits in an unsigned long.
+ *
+ * Interrupt handler functions must return a non-zero value if executing the
+ * handler resulted in a task switch being required.
+ */
+void vPortSetInterruptHandler( unsigned long ulInterruptNumber, unsigned long (*pvHandler)( void ) );
+
+/*
+ * Returns the CPU time consumed by the host process in microseconds.  Unlike
+ * the tick, this measures the cost of the code being executed even when
+ * configSIMULATOR_VIRTUAL_TIME is 1, so it can be used as the run time stats
+ * counter by defining portGET_RUN_TIME_COUNTER_VALUE() as
+ * ulPortGetRunTimeCounterValue() in FreeRTOSConfig.h.
+ */
+unsigned long ulPortGetRunTimeCounterValue( void );
+
+#endif
+
@@ -104,6 +104,23 @@ void vTickISR( void ) __attribute__((interrupt));
 
 extern void *pxCurrentTCB;
 
+#if configUSE_PROFILER == 1
+	/* The interrupt stack pointer while tasks are running.  Written when the
+	first task is started. */
+	unsigned long ulPortInterruptStackBase = 0UL;
+#endif
+
+#if configUSE_DYNAMIC_TICK_RATE == 1
+	/* Supplied by the application, as vApplicationSetupTimerInterrupt() is.
+	Called from the tick interrupt to make the tick timer interrupt every
+	xTicks ticks. */
+	extern void vApplicationSetTickInterruptPeriod( portTickType xTicks );
+
+	/* A tick period passed to xPortSetTickInterruptPeriod() that the tick
+	timer has not been given yet, or 0. */
+	static volatile portTickType xPendingTickPeriod = 0;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* 
@@ -184,6 +201,17 @@ extern void vApplicationSetupTimerInterrupt( void );
 		use.  A demo application is provided to show a suitable example. */
 		vApplicationSetupTimerInterrupt();
 
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			/* xTaskSetTickRate() was called before the scheduler started. */
+			if( xPendingTickPeriod != 0 )
+			{
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		/* Enable the software interrupt. */		
 		_IEN( _ICU_SWINT ) = 1;
 		
@@ -212,6 +240,14 @@ static void prvStartFirstTask( void )
 {
 	__asm volatile
 	(	
+		#if configUSE_PROFILER == 1
+			/* Record where the interrupt stack is left, for
+			ulPortGetInterruptedPC(). */
+			"MVFC		ISP, R15				\n"
+			"MOV.L		#_ulPortInterruptStackBase, R14	\n"
+			"MOV.L		R15, [R14]				\n"
+		#endif
+
 		/* When starting the scheduler there is nothing that needs moving to the
 		interrupt stack because the function is not called from an interrupt.
 		Just ensure the current stack is the user stack. */
@@ -343,6 +379,19 @@ void vTickISR( void )
 	necessitates.  Ensure IPL is at the max syscall value first. */
 	portDISABLE_INTERRUPTS_FROM_KERNEL_ISR();
 	{
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			if( xPendingTickPeriod != 0 )
+			{
+				/* The compare match that caused this interrupt has just
+				restarted the tick timer, so the period it is now counting is
+				the first one the kernel takes to be the new length. */
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		vTaskIncrementTick(); 
 	}
 	portENABLE_INTERRUPTS_FROM_KERNEL_ISR();
@@ -354,6 +403,35 @@ void vTickISR( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_DYNAMIC_TICK_RATE == 1
+
+	portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks )
+	{
+		/* Called from a critical section.  The tick timer is reprogrammed from
+		the next tick interrupt, so the tick period that is running keeps its
+		length. */
+		xPendingTickPeriod = xTicks;
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
+#if configUSE_PROFILER == 1
+
+	unsigned long ulPortGetInterruptedPC( void )
+	{
+		/* Only valid in the tick interrupt.  Tasks run on the user stack, and
+		the tick runs at the lowest priority so only ever interrupts a task.
+		The interrupt stack is therefore as it was when the first task started
+		with just the PC, then the PSW, of the interrupted task below it. */
+		return *( ( volatile unsigned long * ) ( ulPortInterruptStackBase - 8UL ) );
+	}
+
+#endif /* configUSE_PROFILER */
+/*-----------------------------------------------------------*/
+
 unsigned long ulPortGetIPL( void )
 {
 	__asm volatile
@@ -124,6 +124,21 @@ void vPortSetIPL( unsigned long ulNewIPL ) __attribute__((naked));
 
 /*-----------------------------------------------------------*/
 
+/* Tick rate switching.  vApplicationSetTickInterruptPeriod() has to be
+provided to reprogram the timer set up by vApplicationSetupTimerInterrupt(). */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+
+/* Statistical profiler.  Reads the PC saved when the tick interrupt was
+taken. */
+#ifndef portPROFILER_GET_INTERRUPTED_PC
+	extern unsigned long ulPortGetInterruptedPC( void );
+	#define portPROFILER_GET_INTERRUPTED_PC() ulPortGetInterruptedPC()
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
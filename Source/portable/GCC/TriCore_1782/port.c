@@ -111,6 +111,22 @@ static void prvTrapYield( int iTrapIdentification );
  */
 static void prvInterruptYield( int iTrapIdentification );
 
+/*
+ * The context switch shared by the tick, the yield trap and the yield
+ * interrupt.  See the description in prvSwitchContext() itself.
+ */
+static inline void prvSwitchContext( void ) __attribute__( ( always_inline ) );
+
+#if configCSA_LOW_WATERMARK > 0
+
+	/*
+	 * Moves LCX so the free context list depletion trap is taken when
+	 * configCSA_LOW_WATERMARK CSAs remain.
+	 */
+	static void prvSetCSALowWaterMark( void );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* This reference is required by the save/restore context macros. */
@@ -237,6 +253,12 @@ unsigned long *pulLowerCSA = NULL;
 
 	_disable();
 
+	#if configCSA_LOW_WATERMARK > 0
+	{
+		prvSetCSALowWaterMark();
+	}
+	#endif
+
 	/* Load the initial SYSCON. */
 	_mtcr( $SYSCON, portINITIAL_SYSCON );
 	_isync();
@@ -311,9 +333,6 @@ static void prvSetupTimerInterrupt( void )
 static void prvSystemTickHandler( int iArg )
 {
 unsigned long ulSavedInterruptMask;
-unsigned long *pxUpperCSA = NULL;
-unsigned long xUpperCSA = 0UL;
-extern volatile unsigned long *pxCurrentTCB;
 
 	/* Just to avoid compiler warnings about unused parameters. */
 	( void ) iArg;
@@ -350,34 +369,7 @@ extern volatile unsigned long *pxCurrentTCB;
 
 	#if configUSE_PREEMPTION == 1
 	{
-		/* Save the context of a task.
-		The upper context is automatically saved when entering a trap or interrupt.
-		Need to save the lower context as well and copy the PCXI CSA ID into
-		pxCurrentTCB->pxTopOfStack. Only Lower Context CSA IDs may be saved to the
-		TCB of a task.
-
-		Call vTaskSwitchContext to select the next task, note that this changes the
-		value of pxCurrentTCB so that it needs to be reloaded.
-
-		Call vPortSetMPURegisterSetOne to change the MPU mapping for the task
-		that has just been switched in.
-
-		Load the context of the task.
-		Need to restore the lower context by loading the CSA from
-		pxCurrentTCB->pxTopOfStack into PCXI (effectively changing the call stack).
-		In the Interrupt handler post-amble, RSLCX will restore the lower context
-		of the task. RFE will restore the upper context of the task, jump to the
-		return address and restore the previous state of interrupts being
-		enabled/disabled. */
-		_disable();
-		_dsync();
-		xUpperCSA = _mfcr( $PCXI );
-		pxUpperCSA = portCSA_TO_ADDRESS( xUpperCSA );
-		*pxCurrentTCB = pxUpperCSA[ 0 ];
-		vTaskSwitchContext();
-		pxUpperCSA[ 0 ] = *pxCurrentTCB;
-		CPU_SRC0.bits.SETR = 0;
-		_isync();
+		prvSwitchContext();
 	}
 	#endif
 }
@@ -464,41 +456,11 @@ void vPortEndScheduler( void )
 
 static void prvTrapYield( int iTrapIdentification )
 {
-unsigned long *pxUpperCSA = NULL;
-unsigned long xUpperCSA = 0UL;
-extern volatile unsigned long *pxCurrentTCB;
 
 	switch( iTrapIdentification )
 	{
 		case portSYSCALL_TASK_YIELD:
-			/* Save the context of a task.
-			The upper context is automatically saved when entering a trap or interrupt.
-			Need to save the lower context as well and copy the PCXI CSA ID into
-			pxCurrentTCB->pxTopOfStack. Only Lower Context CSA IDs may be saved to the
-			TCB of a task.
-
-			Call vTaskSwitchContext to select the next task, note that this changes the
-			value of pxCurrentTCB so that it needs to be reloaded.
-
-			Call vPortSetMPURegisterSetOne to change the MPU mapping for the task
-			that has just been switched in.
-
-			Load the context of the task.
-			Need to restore the lower context by loading the CSA from
-			pxCurrentTCB->pxTopOfStack into PCXI (effectively changing the call stack).
-			In the Interrupt handler post-amble, RSLCX will restore the lower context
-			of the task. RFE will restore the upper context of the task, jump to the
-			return address and restore the previous state of interrupts being
-			enabled/disabled. */
-			_disable();
-			_dsync();
-			xUpperCSA = _mfcr( $PCXI );
-			pxUpperCSA = portCSA_TO_ADDRESS( xUpperCSA );
-			*pxCurrentTCB = pxUpperCSA[ 0 ];
-			vTaskSwitchContext();
-			pxUpperCSA[ 0 ] = *pxCurrentTCB;
-			CPU_SRC0.bits.SETR = 0;
-			_isync();
+			prvSwitchContext();
 			break;
 
 		default:
@@ -511,44 +473,112 @@ extern volatile unsigned long *pxCurrentTCB;
 
 static void prvInterruptYield( int iId )
 {
-unsigned long *pxUpperCSA = NULL;
-unsigned long xUpperCSA = 0UL;
-extern volatile unsigned long *pxCurrentTCB;
-
 	/* Just to remove compiler warnings. */
 	( void ) iId;
 
-	/* Save the context of a task.
-	The upper context is automatically saved when entering a trap or interrupt.
-	Need to save the lower context as well and copy the PCXI CSA ID into
-	pxCurrentTCB->pxTopOfStack. Only Lower Context CSA IDs may be saved to the
-	TCB of a task.
-
-	Call vTaskSwitchContext to select the next task, note that this changes the
-	value of pxCurrentTCB so that it needs to be reloaded.
-
-	Call vPortSetMPURegisterSetOne to change the MPU mapping for the task
-	that has just been switched in.
-
-	Load the context of the task.
-	Need to restore the lower context by loading the CSA from
-	pxCurrentTCB->pxTopOfStack into PCXI (effectively changing the call stack).
-	In the Interrupt handler post-amble, RSLCX will restore the lower context
-	of the task. RFE will restore the upper context of the task, jump to the
-	return address and restore the previous state of interrupts being
-	enabled/disabled. */
+	prvSwitchContext();
+}
+/*-----------------------------------------------------------*/
+
+static inline void prvSwitchContext( void )
+{
+unsigned long *pulUpperCSA;
+volatile unsigned long *pxPreviousTCB;
+
+	/* The upper context is automatically saved when entering a trap or
+	interrupt, and the lower context by the handler wrapper, so the whole
+	context of the task is already in the CSA chain that PCXI links to.  The
+	first word of the upper CSA links to the lower CSA, which is the head of
+	the call chain of the task.  Switching task is therefore nothing more than
+	storing that head in pxCurrentTCB->pxTopOfStack and replacing it with the
+	head of the chain of the task being switched in.  In the handler post-amble
+	RSLCX restores the lower context of that task, and RFE the upper context,
+	its return address and its interrupt state.
+
+	If vTaskSwitchContext() selects the task that was already running, its
+	chain head is still in place, so neither TCB is touched. */
 	_disable();
 	_dsync();
-	xUpperCSA = _mfcr( $PCXI );
-	pxUpperCSA = portCSA_TO_ADDRESS( xUpperCSA );
-	*pxCurrentTCB = pxUpperCSA[ 0 ];
+	pulUpperCSA = portCSA_TO_ADDRESS( _mfcr( $PCXI ) );
+	pxPreviousTCB = pxCurrentTCB;
+
 	vTaskSwitchContext();
-	pxUpperCSA[ 0 ] = *pxCurrentTCB;
+
+	if( pxCurrentTCB != pxPreviousTCB )
+	{
+		*pxPreviousTCB = pulUpperCSA[ 0 ];
+		pulUpperCSA[ 0 ] = *pxCurrentTCB;
+	}
+
+	/* A yield pended from an interrupt has been served by this switch. */
 	CPU_SRC0.bits.SETR = 0;
 	_isync();
 }
 /*-----------------------------------------------------------*/
 
+#if configCSA_LOW_WATERMARK > 0
+
+	static void prvSetCSALowWaterMark( void )
+	{
+	unsigned long ulLead, ulTrail, ulCount;
+
+		/* The free list is used last in, first out, so the CSAs at its tail
+		are only reached once the list is nearly exhausted, and the number of
+		CSAs after a given CSA does not change.  Run a trailing link
+		configCSA_LOW_WATERMARK links behind a leading link until the leading
+		link reaches the last CSA - the trailing link is then the CSA that has
+		configCSA_LOW_WATERMARK CSAs after it.  Interrupts are disabled. */
+		ulLead = _mfcr( $FCX ) & portCSA_FCX_MASK;
+		ulTrail = ulLead;
+
+		for( ulCount = 0UL; ( ulCount < ( unsigned long ) configCSA_LOW_WATERMARK ) && ( 0UL != ulLead ); ulCount++ )
+		{
+			ulLead = portCSA_TO_ADDRESS( ulLead )[ 0 ] & portCSA_FCX_MASK;
+		}
+
+		/* There must be more free CSAs than the watermark. */
+		configASSERT( 0UL != ulLead );
+
+		if( 0UL != ulLead )
+		{
+			while( 0UL != ( portCSA_TO_ADDRESS( ulLead )[ 0 ] & portCSA_FCX_MASK ) )
+			{
+				ulLead = portCSA_TO_ADDRESS( ulLead )[ 0 ] & portCSA_FCX_MASK;
+				ulTrail = portCSA_TO_ADDRESS( ulTrail )[ 0 ] & portCSA_FCX_MASK;
+			}
+
+			_dsync();
+			_mtcr( $LCX, ulTrail );
+			_isync();
+		}
+	}
+
+#endif /* configCSA_LOW_WATERMARK */
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetFreeCSACount( void )
+{
+unsigned long ulCSA, ulCount = 0UL;
+
+	/* CSAs are taken from and returned to the head of the list by every call
+	and interrupt, so nothing can run while the list is followed. */
+	_disable();
+	{
+		_dsync();
+		ulCSA = _mfcr( $FCX ) & portCSA_FCX_MASK;
+
+		while( 0UL != ulCSA )
+		{
+			ulCount++;
+			ulCSA = portCSA_TO_ADDRESS( ulCSA )[ 0 ] & portCSA_FCX_MASK;
+		}
+	}
+	_enable();
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
 unsigned long uxPortSetInterruptMaskFromISR( void )
 {
 unsigned long uxReturn = 0UL;
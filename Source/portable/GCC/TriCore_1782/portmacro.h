@@ -188,6 +188,25 @@ pxTopOfStack alignment is removed. */
 void vPortReclaimCSA( unsigned long *pxTCB );
 #define portCLEAN_UP_TCB( pxTCB )		vPortReclaimCSA( ( unsigned long * ) ( pxTCB ) )
 
+/*
+ * CSA pool monitoring.  If configCSA_LOW_WATERMARK is greater than 0 then,
+ * when the scheduler starts, LCX is moved so that the free context list
+ * depletion trap is taken when only configCSA_LOW_WATERMARK CSAs remain, and
+ * the trap calls vApplicationCSALowWaterMarkHook().  The hook runs in the
+ * trap on the remaining CSAs, so it must only record the event - it must not
+ * call the kernel API - and configCSA_LOW_WATERMARK must leave enough CSAs for
+ * the trap, the hook and any interrupts that nest on top of them.
+ *
+ * ulPortGetFreeCSACount() counts the CSAs in the free list, with interrupts
+ * disabled for the duration, so it is intended for test and tuning only.
+ */
+#ifndef configCSA_LOW_WATERMARK
+	#define configCSA_LOW_WATERMARK		0
+#endif
+
+void vApplicationCSALowWaterMarkHook( void );
+unsigned long ulPortGetFreeCSACount( void );
+
 #ifdef __cplusplus
 }
 #endif
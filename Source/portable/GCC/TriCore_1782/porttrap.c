@@ -248,6 +248,16 @@ void vContextManagementTrap( int iTrapIdentification )
 	switch( iTrapIdentification )
 	{
 		case portTIN_CM_FREE_CONTEXT_LIST_DEPLETION:
+			#if configCSA_LOW_WATERMARK > 0
+			{
+				/* The CSA at LCX has been used, so only
+				configCSA_LOW_WATERMARK CSAs remain.  LCX is left where it is,
+				so the hook is called again each time the pool is drawn down
+				to the watermark. */
+				vApplicationCSALowWaterMarkHook();
+				break;
+			}
+			#endif
 		case portTIN_CM_CALL_DEPTH_OVERFLOW:
 		case portTIN_CM_CALL_DEPTH_UNDEFLOW:
 		case portTIN_CM_FREE_CONTEXT_LIST_UNDERFLOW:
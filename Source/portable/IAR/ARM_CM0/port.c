@@ -92,9 +92,18 @@ static unsigned portBASE_TYPE uxCriticalNesting = 0xaaaaaaaa;
 static void prvSetupTimerInterrupt( void );
 
 /*
- * Exception handlers.
+ * Exception handlers.  xPortPendSVHandler() is in portasm.s, so is placed by
+ * the linker configuration file.
  */
-void xPortSysTickHandler( void );
+void xPortSysTickHandler( void ) KERNEL_FAST_FUNCTION;
+
+/*
+ * Used on every context switch and critical section, so placed with the rest
+ * of the kernel fast path if configKERNEL_FAST_CODE_SECTION is defined.
+ */
+void vPortYieldFromISR( void ) KERNEL_FAST_FUNCTION;
+void vPortEnterCritical( void ) KERNEL_FAST_FUNCTION;
+void vPortExitCritical( void ) KERNEL_FAST_FUNCTION;
 
 /*
  * Start first task is a separate function so it can be tested in isolation.
@@ -164,6 +173,11 @@ void vPortEnterCritical( void )
 {
 	portDISABLE_INTERRUPTS();
 	uxCriticalNesting++;
+
+	if( uxCriticalNesting == 1 )
+	{
+		taskCRITICAL_SECTION_ENTERED();
+	}
 }
 /*-----------------------------------------------------------*/
 
@@ -172,6 +186,7 @@ void vPortExitCritical( void )
 	uxCriticalNesting--;
 	if( uxCriticalNesting == 0 )
 	{
+		taskCRITICAL_SECTION_EXITED();
 		portENABLE_INTERRUPTS();
 	}
 }
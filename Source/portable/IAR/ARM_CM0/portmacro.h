@@ -123,6 +123,10 @@ extern void vPortExitCritical( void );
 
 #define portNOP()
 
+/* Places a function in the named section, see configKERNEL_FAST_CODE_SECTION
+in FreeRTOS.h. */
+#define portPLACE_IN_SECTION( pcSection ) @ pcSection
+
 #ifdef __cplusplus
 }
 #endif
@@ -119,12 +119,56 @@ extern void vPortClearInterruptMask( void );
 
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. */
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	#include <intrinsics.h>
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31 - __CLZ( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( portTickType xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* Tick rate switching. */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+
+/* Core clock scaling. */
+#ifndef portCPU_CLOCK_CHANGED
+	extern void vPortCpuClockChanged( unsigned long ulCpuClockHz );
+	#define portCPU_CLOCK_CHANGED( ulCpuClockHz ) vPortCpuClockChanged( ulCpuClockHz )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 
 #define portNOP()
 
+/* Places a function in the named section, see configKERNEL_FAST_CODE_SECTION
+in FreeRTOS.h. */
+#define portPLACE_IN_SECTION( pcSection ) @ pcSection
+
 #ifdef __cplusplus
 }
 #endif
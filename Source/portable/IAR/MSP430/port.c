@@ -197,3 +197,33 @@ void vPortSetupTimerInterrupt( void )
 
 
 	
+
+#if configUSE_PORT_OPTIMISED_QUEUE_COPY == 1
+
+	void vPortQueueCopy( void *pvDestination, const void *pvSource, unsigned short usBytes )
+	{
+	unsigned char *pucDestination = ( unsigned char * ) pvDestination;
+	const unsigned char *pucSource = ( const unsigned char * ) pvSource;
+
+		if( ( ( ( unsigned short ) pucDestination | ( unsigned short ) pucSource ) & 0x01U ) == 0U )
+		{
+			while( usBytes >= 2U )
+			{
+				*( ( unsigned short * ) pucDestination ) = *( ( const unsigned short * ) pucSource );
+				pucDestination += 2;
+				pucSource += 2;
+				usBytes -= 2U;
+			}
+		}
+
+		while( usBytes > 0U )
+		{
+			*pucDestination = *pucSource;
+			pucDestination++;
+			pucSource++;
+			usBytes--;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_PORT_OPTIMISED_QUEUE_COPY */
@@ -138,6 +138,14 @@ extern void vPortYield( void );
 #define portNOP()	
 /*-----------------------------------------------------------*/
 
+/* Queue item copy.  The library memcpy() moves a byte at a time, so data that
+is aligned to a word at both ends is copied a word at a time instead. */
+#if configUSE_PORT_OPTIMISED_QUEUE_COPY == 1
+	extern void vPortQueueCopy( void *pvDestination, const void *pvSource, unsigned portSHORT usBytes );
+	#define portQUEUE_COPY( pvDestination, pvSource, xBytes ) vPortQueueCopy( ( pvDestination ), ( pvSource ), ( unsigned portSHORT ) ( xBytes ) )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
@@ -79,6 +79,19 @@ usCriticalNesting will get set to zero when the scheduler starts, but must
 not be initialised to zero as this will cause problems during the startup
 sequence. */
 volatile unsigned short usCriticalNesting = portINITIAL_CRITICAL_NESTING;
+
+/* If configISR_STACK_SIZE is defined then the tick interrupt and portYIELD()
+run the kernel on this stack, once the context of the task has been saved,
+rather than on the stack of the task.  Task stacks then only need room for the
+context and for any application interrupt.  Interrupts must not be enabled by
+code run on this stack, which includes the tick hook.  The stack is switched
+in portext.s43. */
+#ifdef configISR_STACK_SIZE
+	portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] = { 0 };
+
+	/* The MSP430X decrements the stack pointer before each push. */
+	portSTACK_TYPE * const xISRStackTop = &( xISRStack[ configISR_STACK_SIZE ] );
+#endif
 /*-----------------------------------------------------------*/
 
 
@@ -72,6 +72,19 @@ PSW is set with U and I set, and PM and IPL clear. */
 #define portINITIAL_PSW	 ( ( portSTACK_TYPE ) 0x00030000 )
 #define portINITIAL_FPSW	( ( portSTACK_TYPE ) 0x00000100 )
 
+/* The FIEN bit of the fast interrupt register. */
+#define portFIR_FIEN		( ( unsigned short ) 0x8000 )
+
+#if configFAST_INTERRUPT_RESERVED_REGISTERS > 4
+	#error configFAST_INTERRUPT_RESERVED_REGISTERS must be between 0 and 4.
+#endif
+
+/* The fast interrupt is taken at priority 15 and must be above every interrupt
+that can use the kernel, as it cannot itself call any API function. */
+#if defined( configFAST_INTERRUPT_HANDLER ) && ( configMAX_SYSCALL_INTERRUPT_PRIORITY >= 15 )
+	#error configMAX_SYSCALL_INTERRUPT_PRIORITY must be below 15 when a fast interrupt is used.
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -90,6 +103,23 @@ __interrupt void vTickISR( void );
 
 extern void *pxCurrentTCB;
 
+#if configUSE_DYNAMIC_TICK_RATE == 1
+	/* Supplied by the application, as vApplicationSetupTimerInterrupt() is.
+	Called from the tick interrupt to make the tick timer interrupt every
+	xTicks ticks. */
+	extern void vApplicationSetTickInterruptPeriod( portTickType xTicks );
+
+	/* A tick period passed to xPortSetTickInterruptPeriod() that the tick
+	timer has not been given yet, or 0. */
+	static volatile portTickType xPendingTickPeriod = 0;
+#endif
+
+#if configDSP_CONTEXT_PER_TASK == 1
+	/* Set to pdTRUE while the Running state task has the accumulator in its
+	context.  Saved in and restored from the context of each task. */
+	unsigned long ulPortTaskHasDSPContext = pdFALSE;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -150,9 +180,19 @@ portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE
 	pxTopOfStack--;				
 	*pxTopOfStack = portINITIAL_FPSW;
 	pxTopOfStack--;
-	*pxTopOfStack = 0x12345678; /* Accumulator. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x87654321; /* Accumulator. */
+
+	#if configDSP_CONTEXT_PER_TASK == 1
+	{
+		/* Tasks start without the accumulator in their context. */
+		*pxTopOfStack = pdFALSE;
+	}
+	#else
+	{
+		*pxTopOfStack = 0x12345678; /* Accumulator. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x87654321; /* Accumulator. */
+	}
+	#endif
 
 	return pxTopOfStack;
 }
@@ -170,6 +210,17 @@ extern void vApplicationSetupTimerInterrupt( void );
 		use.  A demo application is provided to show a suitable example. */
 		vApplicationSetupTimerInterrupt();
 
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			/* xTaskSetTickRate() was called before the scheduler started. */
+			if( xPendingTickPeriod != 0 )
+			{
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		/* Enable the software interrupt. */		
 		_IEN( _ICU_SWINT ) = 1;
 		
@@ -179,6 +230,22 @@ extern void vApplicationSetupTimerInterrupt( void );
 		/* Ensure the software interrupt is set to the kernel priority. */
 		_IPR( _ICU_SWINT ) = configKERNEL_INTERRUPT_PRIORITY;
 
+		/* Make the interrupt with vector configFAST_INTERRUPT_VECTOR the fast
+		interrupt.  Its PC and PSW are saved in the backup registers rather
+		than on the stack, and its handler, configFAST_INTERRUPT_HANDLER,
+		returns with RTFI - so is defined using the __fast_interrupt keyword.
+		The handler can work in the registers reserved through
+		configFAST_INTERRUPT_RESERVED_REGISTERS without saving them.  The
+		application still sets up and enables the peripheral interrupt. */
+		#ifdef configFAST_INTERRUPT_HANDLER
+		{
+		extern __fast_interrupt void configFAST_INTERRUPT_HANDLER( void );
+
+			__set_FINTV_register( configFAST_INTERRUPT_HANDLER );
+			ICU.FIR.WORD = portFIR_FIEN | ( unsigned short ) configFAST_INTERRUPT_VECTOR;
+		}
+		#endif
+
 		/* Start the first task. */
 		prvStartFirstTask();
 	}
@@ -198,6 +265,19 @@ __interrupt void vTickISR( void )
 	necessitates. */
 	__set_interrupt_level( configMAX_SYSCALL_INTERRUPT_PRIORITY );
 	{
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			if( xPendingTickPeriod != 0 )
+			{
+				/* The compare match that caused this interrupt has just
+				restarted the tick timer, so the period it is now counting is
+				the first one the kernel takes to be the new length. */
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		vTaskIncrementTick();
 	}
 	__set_interrupt_level( configKERNEL_INTERRUPT_PRIORITY );
@@ -209,6 +289,33 @@ __interrupt void vTickISR( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_DYNAMIC_TICK_RATE == 1
+
+	portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks )
+	{
+		/* Called from a critical section.  The tick timer is reprogrammed from
+		the next tick interrupt, so the tick period that is running keeps its
+		length. */
+		xPendingTickPeriod = xTicks;
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
+#if configDSP_CONTEXT_PER_TASK == 1
+
+	void vPortTaskUsesDSP( void )
+	{
+		/* The accumulator is saved from the next context switch on.  The flag
+		belongs to the calling task as it is part of its context. */
+		ulPortTaskHasDSPContext = pdTRUE;
+	}
+
+#endif /* configDSP_CONTEXT_PER_TASK */
+/*-----------------------------------------------------------*/
+
 void vPortEndScheduler( void )
 {
 	/* Not implemented as there is nothing to return to. */
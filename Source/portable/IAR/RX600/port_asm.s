@@ -53,11 +53,24 @@
 
 #include "PriorityDefinitions.h"
 
+/* The context options are described in portmacro.h.  The assembler only sees
+PriorityDefinitions.h, so they must be defined there when they are used. */
+#ifndef configDSP_CONTEXT_PER_TASK
+	#define configDSP_CONTEXT_PER_TASK	0
+#endif
+
+#ifndef configFAST_INTERRUPT_RESERVED_REGISTERS
+	#define configFAST_INTERRUPT_RESERVED_REGISTERS	0
+#endif
+
 	PUBLIC _prvStartFirstTask
 	PUBLIC ___interrupt_27
 
 	EXTERN _pxCurrentTCB
 	EXTERN _vTaskSwitchContext
+#if configDSP_CONTEXT_PER_TASK == 1
+	EXTERN _ulPortTaskHasDSPContext
+#endif
 
 	RSEG CODE:CODE(4)
 
@@ -76,6 +89,14 @@ _prvStartFirstTask:
 
 		/* Restore the registers from the stack of the task pointed to by
 		pxCurrentTCB. */
+#if configDSP_CONTEXT_PER_TASK == 1
+		/* The flag word says whether the accumulator is in the context. */
+		POP			R15
+		MOV.L		#_ulPortTaskHasDSPContext, R14
+		MOV.L		R15, [ R14 ]
+		CMP			#0, R15
+		BEQ			prvStartNoDSPContext
+#endif
 		POP			R15
 
 		/* Accumulator low 32 bits. */
@@ -84,13 +105,35 @@ _prvStartFirstTask:
 
 		/* Accumulator high 32 bits. */
 		MVTACHI		R15
+#if configDSP_CONTEXT_PER_TASK == 1
+prvStartNoDSPContext:
+#endif
 		POP			R15
 
 		/* Floating point status word. */
 		MVTC		R15, FPSW
 
+#if configFAST_INTERRUPT_RESERVED_REGISTERS == 0
 		/* R1 to R15 - R0 is not included as it is the SP. */
 		POPM		R1-R15
+#else
+		/* R1 to R15 - R0 is not included as it is the SP.  The registers
+		reserved for the fast interrupt are left as they are. */
+	#if configFAST_INTERRUPT_RESERVED_REGISTERS == 1
+		POPM		R1-R12
+		ADD			#4, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 2
+		POPM		R1-R11
+		ADD			#8, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 3
+		POPM		R1-R10
+		ADD			#12, R0
+	#else
+		POPM		R1-R9
+		ADD			#16, R0
+	#endif
+		POPM		R14-R15
+#endif
 
 		/* This pops the remaining registers. */
 		RTE
@@ -135,6 +178,15 @@ ___interrupt_27:
 		/* Save the FPSW and accumulator. */
 		MVFC		FPSW, R15
 		PUSH.L		R15
+
+#if configDSP_CONTEXT_PER_TASK == 1
+		/* Only tasks that use the DSP instructions have the accumulator saved.
+		R14 has been saved so can hold the flag. */
+		MOV.L		#_ulPortTaskHasDSPContext, R14
+		MOV.L		[ R14 ], R14
+		CMP			#0, R14
+		BEQ			prvSaveNoDSPContext
+#endif
 		MVFACHI 	R15
 		PUSH.L		R15
 
@@ -144,6 +196,10 @@ ___interrupt_27:
 		/* Shifted left as it is restored to the low order word. */
 		SHLL		#16, R15
 		PUSH.L		R15
+#if configDSP_CONTEXT_PER_TASK == 1
+prvSaveNoDSPContext:
+		PUSH.L		R14
+#endif
 
 		/* Save the stack pointer to the TCB. */
 		MOV.L		#_pxCurrentTCB, R15
@@ -168,13 +224,44 @@ ___interrupt_27:
 
 		/* Restore the context of the new task.  The PSW (Program Status Word) and
 		PC will be popped by the RTE instruction. */
+#if configDSP_CONTEXT_PER_TASK == 1
+		/* The flag word says whether the accumulator is in the context. */
+		POP			R15
+		MOV.L		#_ulPortTaskHasDSPContext, R14
+		MOV.L		R15, [ R14 ]
+		CMP			#0, R15
+		BEQ			prvRestoreNoDSPContext
+#endif
 		POP			R15
 		MVTACLO 	R15
 		POP			R15
 		MVTACHI 	R15
+#if configDSP_CONTEXT_PER_TASK == 1
+prvRestoreNoDSPContext:
+#endif
 		POP			R15
 		MVTC		R15, FPSW
+#if configFAST_INTERRUPT_RESERVED_REGISTERS == 0
+		/* R1 to R15 - R0 is not included as it is the SP. */
 		POPM		R1-R15
+#else
+		/* R1 to R15 - R0 is not included as it is the SP.  The registers
+		reserved for the fast interrupt are left as they are. */
+	#if configFAST_INTERRUPT_RESERVED_REGISTERS == 1
+		POPM		R1-R12
+		ADD			#4, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 2
+		POPM		R1-R11
+		ADD			#8, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 3
+		POPM		R1-R10
+		ADD			#12, R0
+	#else
+		POPM		R1-R9
+		ADD			#16, R0
+	#endif
+		POPM		R14-R15
+#endif
 		RTE
 		NOP
 		NOP
@@ -126,6 +126,39 @@ void vPortSetIPL( unsigned long ulNewIPL );
 
 /*-----------------------------------------------------------*/
 
+/* With configDSP_CONTEXT_PER_TASK set to 1 the accumulator is only saved and
+restored for tasks that have called portTASK_USES_DSP(), which a task must do
+before it executes any of the MUL/MAC/RACW/MVTAC instructions that use the
+accumulator.  The context of every other task leaves the accumulator out. */
+#ifndef configDSP_CONTEXT_PER_TASK
+	#define configDSP_CONTEXT_PER_TASK	0
+#endif
+
+#if configDSP_CONTEXT_PER_TASK == 1
+	void vPortTaskUsesDSP( void );
+	#define portTASK_USES_DSP()	vPortTaskUsesDSP()
+#else
+	#define portTASK_USES_DSP()
+#endif
+
+/* The number of registers, counting down from R13, that the compiler has been
+told to keep free for the fast interrupt (the --lock_regs compiler option).
+The context switch does not restore these registers so the values the fast
+interrupt keeps in them survive.  Between 0 and 4.  As the options are also
+used by port_asm.s they have to be defined in PriorityDefinitions.h. */
+#ifndef configFAST_INTERRUPT_RESERVED_REGISTERS
+	#define configFAST_INTERRUPT_RESERVED_REGISTERS	0
+#endif
+/*-----------------------------------------------------------*/
+
+/* Tick rate switching.  vApplicationSetTickInterruptPeriod() has to be
+provided to reprogram the timer set up by vApplicationSetupTimerInterrupt(). */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
@@ -57,6 +57,18 @@
 #define portEPC_STACK_LOCATION	124
 #define portSTATUS_STACK_LOCATION 128
 
+/* The SRSCtl register is saved in the otherwise unused word at offset 4 when
+the shadow register set is in use.  See portSAVE_CONTEXT_SRS below. */
+#define portSRSCTL_STACK_LOCATION 4
+
+/* The frame used by portSAVE_CONTEXT_SRS.  The first 16 bytes are the
+argument area of the handler it calls. */
+#define portSRS_CONTEXT_SIZE 32
+#define portSRS_EPC_STACK_LOCATION 16
+#define portSRS_STATUS_STACK_LOCATION 20
+#define portSRS_SRSCTL_STACK_LOCATION 24
+#define portSRS_HI_STACK_LOCATION 28
+
 /******************************************************************/ 	
 .macro	portSAVE_CONTEXT
 
@@ -102,6 +114,13 @@
 	/* s6 holds the EPC value, this is saved after interrupts are re-enabled. */
 	mfc0 		s6, _CP0_EPC
 
+	#ifdef configSHADOW_REGISTER_SET_PRIORITY
+		/* An interrupt that nests within this one overwrites the previous
+		shadow set field, which this interrupt returns through. */
+		mfc0		k0, _CP0_SRSCTL
+		sw			k0, portSRSCTL_STACK_LOCATION(s5)
+	#endif
+
 	/* Re-enable interrupts. */
 	mtc0		k1, _CP0_STATUS
 
@@ -192,6 +211,11 @@
 	/* Protect access to the k registers, and others. */
 	di
 
+	#ifdef configSHADOW_REGISTER_SET_PRIORITY
+		lw			k0, portSRSCTL_STACK_LOCATION(s5)
+		mtc0		k0, _CP0_SRSCTL
+	#endif
+
 	/* Decrement the nesting count. */
 	la			k0, uxInterruptNesting
 	lw			k1, (k0)
@@ -215,3 +239,80 @@
 
 	.endm
 
+/******************************************************************/
+/*
+ * Context save and restore for interrupts at priority
+ * configSHADOW_REGISTER_SET_PRIORITY, which the DEVCFG3 FSRSSEL configuration
+ * bits must assign to shadow register set 1.  The core switches to the shadow
+ * set on entry, and nothing else uses it, so no general purpose register has
+ * to be saved.  The stack pointer of the shadow set was pointed at its own
+ * stack by xPortStartScheduler() and is back at the top of that stack each
+ * time an interrupt at this priority is entered, as these interrupts cannot
+ * nest within each other.  Only EPC, Status, SRSCtl and hi/lo are saved
+ * before interrupts of higher priority are enabled again.
+ *
+ * The handler can use the FromISR API functions, provided
+ * configSHADOW_REGISTER_SET_PRIORITY is not above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  A context switch it requests is
+ * performed by the yield interrupt once this and any other interrupt have
+ * returned, as for the other interrupts of this port.  Use as:
+ *
+ *	vFastInterruptWrapper:
+ *		portSAVE_CONTEXT_SRS
+ *		jal vFastInterruptHandler
+ *		nop
+ *		portRESTORE_CONTEXT_SRS
+ */
+.macro	portSAVE_CONTEXT_SRS
+
+	mfc0		k0, _CP0_CAUSE
+	addiu		sp, sp, -portSRS_CONTEXT_SIZE
+	mfc0		k1, _CP0_STATUS
+
+	/* EPC, Status and SRSCtl are overwritten by an interrupt that nests
+	within this one, so are saved before interrupts are enabled. */
+	sw			k1, portSRS_STATUS_STACK_LOCATION(sp)
+	mfc0		t0, _CP0_EPC
+	sw			t0, portSRS_EPC_STACK_LOCATION(sp)
+	mfc0		t0, _CP0_SRSCTL
+	sw			t0, portSRS_SRSCTL_STACK_LOCATION(sp)
+
+	/* Enable interrupts above the current priority. */
+	srl			k0, k0, 0xa
+	ins 		k1, k0, 10, 6
+	ins			k1, zero, 1, 4
+	mtc0		k1, _CP0_STATUS
+
+	/* hi and lo are not part of the shadow set. */
+	mfhi		t0
+	sw			t0, portSRS_HI_STACK_LOCATION(sp)
+	mflo		t1
+	sw			t1, portSRS_HI_STACK_LOCATION + 4(sp)
+
+	.endm
+
+/******************************************************************/
+.macro	portRESTORE_CONTEXT_SRS
+
+	lw			t0, portSRS_HI_STACK_LOCATION(sp)
+	mthi		t0
+	lw			t1, portSRS_HI_STACK_LOCATION + 4(sp)
+	mtlo		t1
+
+	/* Protect access to the k registers. */
+	di
+	ehb
+
+	lw			k0, portSRS_SRSCTL_STACK_LOCATION(sp)
+	mtc0		k0, _CP0_SRSCTL
+	lw			k0, portSRS_STATUS_STACK_LOCATION(sp)
+	lw			k1, portSRS_EPC_STACK_LOCATION(sp)
+	addiu		sp, sp, portSRS_CONTEXT_SIZE
+
+	mtc0		k0, _CP0_STATUS
+	mtc0 		k1, _CP0_EPC
+	ehb
+	eret
+	nop
+
+	.endm
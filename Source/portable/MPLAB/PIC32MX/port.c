@@ -84,6 +84,29 @@ portSTACK_TYPE xISRStack[ configISR_STACK_SIZE ] = { 0 };
 the callers stack, as some functions seem to want to do this. */
 const portSTACK_TYPE * const xISRStackTop = &( xISRStack[ configISR_STACK_SIZE - 7 ] );
 
+/* If configSHADOW_REGISTER_SET_PRIORITY is defined then interrupts at that
+priority can be written with portSAVE_CONTEXT_SRS and portRESTORE_CONTEXT_SRS
+(see ISR_Support.h) to run on shadow register set 1.  The DEVCFG3 FSRSSEL
+configuration bits must assign the set to the same priority.  The stack
+pointer of the shadow set points to its own stack, as these interrupts can
+nest within interrupts that are using xISRStack. */
+#ifdef configSHADOW_REGISTER_SET_PRIORITY
+
+	#if ( configSHADOW_REGISTER_SET_PRIORITY > configMAX_SYSCALL_INTERRUPT_PRIORITY ) || ( configSHADOW_REGISTER_SET_PRIORITY <= configKERNEL_INTERRUPT_PRIORITY )
+		#error configSHADOW_REGISTER_SET_PRIORITY must be above configKERNEL_INTERRUPT_PRIORITY and not above configMAX_SYSCALL_INTERRUPT_PRIORITY.
+	#endif
+
+	#ifndef configSHADOW_REGISTER_SET_STACK_SIZE
+		#define configSHADOW_REGISTER_SET_STACK_SIZE configISR_STACK_SIZE
+	#endif
+
+	static portSTACK_TYPE xShadowRegisterSetStack[ configSHADOW_REGISTER_SET_STACK_SIZE ] __attribute__ ( ( aligned ( 8 ) ) ) = { 0 };
+
+	/* Sets the stack pointer and global pointer of the shadow set. */
+	extern void vPortInitialiseShadowRegisterSet( portSTACK_TYPE *pxStackTop );
+
+#endif
+
 /* 
  * Place the prototype here to ensure the interrupt vector is correctly installed. 
  * Note that because the interrupt is written in assembly, the IPL setting in the
@@ -171,6 +194,12 @@ extern void *pxCurrentTCB;
 	disabled by the time we get here. */
 	prvSetupTimerInterrupt();
 
+	#ifdef configSHADOW_REGISTER_SET_PRIORITY
+	{
+		vPortInitialiseShadowRegisterSet( &( xShadowRegisterSetStack[ configSHADOW_REGISTER_SET_STACK_SIZE ] ) );
+	}
+	#endif
+
 	/* Kick off the highest priority task that has been created so far. 
 	Its stack location is loaded into uxSavedTaskStackPointer. */
 	uxSavedTaskStackPointer = *( unsigned portBASE_TYPE * ) pxCurrentTCB;
@@ -155,6 +155,27 @@ unsigned long ulStatus;							\
 
 #define portNOP()	asm volatile ( 	"nop" )
 
+/* Load-linked and store-conditional, used by the atomic operations in
+Source/atomic.c.  The store fails if an eret was executed since the load, so
+no interrupt masking is needed. */
+static inline unsigned long ulPortLoadLinked( volatile unsigned long *pulAddress )
+{
+unsigned long ulValue;
+
+	asm volatile ( "ll %0, 0(%1)" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+	return ulValue;
+}
+
+static inline unsigned long ulPortStoreConditional( volatile unsigned long *pulAddress, unsigned long ulValue )
+{
+	/* sc replaces the value with 1 if the store was made, 0 if not. */
+	asm volatile ( "sc %0, 0(%1)" : "+r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+	return ulValue;
+}
+
+#define portLOAD_EXCLUSIVE( pulAddress ) ulPortLoadLinked( pulAddress )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue ) ( ( ulPortStoreConditional( ( pulAddress ), ( ulValue ) ) != 0UL ) ? pdTRUE : pdFALSE )
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site. */
@@ -59,6 +59,15 @@
 #define portMAX_INTERRUPTS				( ( unsigned long ) sizeof( unsigned long ) * 8UL ) /* The number of bits in an unsigned long. */
 #define portNO_CRITICAL_NESTING 		( ( unsigned long ) 0 )
 
+/* Set configWIN32_USE_YIELD_EVENTS to 1 in FreeRTOSConfig.h to have a task
+that yields wait on an event belonging to its own thread, which the simulated
+interrupt handler thread sets when the task is next selected to run.  This
+replaces the SuspendThread()/ResumeThread() pair otherwise performed on every
+yield.  Threads preempted by the tick are still suspended. */
+#ifndef configWIN32_USE_YIELD_EVENTS
+	#define configWIN32_USE_YIELD_EVENTS	0
+#endif
+
 /*
  * Created as a high priority thread, this function uses a timer to simulate
  * a tick interrupt being generated on an embedded target.  In this Windows
@@ -81,6 +90,23 @@ static unsigned long prvProcessDeleteThreadInterrupt( void );
 static unsigned long prvProcessYieldInterrupt( void );
 static unsigned long prvProcessTickInterrupt( void );
 
+/*
+ * Allow the thread referenced by pvThreadState to run, whether it was stopped
+ * by being suspended or by waiting on its yield event.
+ */
+static void prvResumeThread( void *pvThreadState );
+
+#if( configWIN32_USE_YIELD_EVENTS == 1 )
+
+	/*
+	 * Called by a task's thread after it has requested a yield with the
+	 * interrupt event mutex held.  Releases the mutex then waits until the
+	 * task is selected to run again.
+	 */
+	static void prvWaitForYield( void *pvThreadState );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The WIN32 simulator runs each task in a thread.  The context switching is
@@ -93,6 +119,18 @@ typedef struct
 	/* Handle of the thread that executes the task. */
 	void *pvThread;
 
+	#if( configWIN32_USE_YIELD_EVENTS == 1 )
+		/* The ID of the thread, so a yield can tell whether it is being
+		requested by the thread that executes the task. */
+		DWORD dwThreadId;
+
+		/* The event the thread waits on after it has yielded, and pdTRUE
+		while it is, or is about to start, waiting on the event rather than
+		being suspended. */
+		void *pvYieldEvent;
+		volatile long lWaitingForYield;
+	#endif
+
 } xThreadState;
 
 /* Simulated interrupts waiting to be processed.  This is a bit mask where each
@@ -186,7 +224,17 @@ xThreadState *pxThreadState = NULL;
 	pxThreadState = ( xThreadState * ) ( pxTopOfStack - sizeof( xThreadState ) );
 
 	/* Create the thread itself. */
-	pxThreadState->pvThread = CreateThread( NULL, 0, ( LPTHREAD_START_ROUTINE ) pxCode, pvParameters, CREATE_SUSPENDED, NULL );
+	#if( configWIN32_USE_YIELD_EVENTS == 1 )
+	{
+		pxThreadState->pvYieldEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+		pxThreadState->lWaitingForYield = pdFALSE;
+		pxThreadState->pvThread = CreateThread( NULL, 0, ( LPTHREAD_START_ROUTINE ) pxCode, pvParameters, CREATE_SUSPENDED, &( pxThreadState->dwThreadId ) );
+	}
+	#else
+	{
+		pxThreadState->pvThread = CreateThread( NULL, 0, ( LPTHREAD_START_ROUTINE ) pxCode, pvParameters, CREATE_SUSPENDED, NULL );
+	}
+	#endif
 	SetThreadAffinityMask( pxThreadState->pvThread, 0x01 );
 	SetThreadPriorityBoost( pxThreadState->pvThread, TRUE );
 	SetThreadPriority( pxThreadState->pvThread, THREAD_PRIORITY_IDLE );
@@ -365,18 +413,51 @@ void *pvObjectList[ 2 ];
 				if( ( ulSwitchRequired & ( 1 << portINTERRUPT_DELETE_THREAD ) ) != pdFALSE )
 				{
 					TerminateThread( pxThreadState->pvThread, 0 );
+
+					#if( configWIN32_USE_YIELD_EVENTS == 1 )
+					{
+						CloseHandle( pxThreadState->pvYieldEvent );
+					}
+					#endif
 				}
 				else
 				{
-					SuspendThread( pxThreadState->pvThread );
+					#if( configWIN32_USE_YIELD_EVENTS == 1 )
+					{
+						/* A thread that yielded is already waiting on its
+						yield event, so only needs suspending if it was
+						preempted. */
+						if( pxThreadState->lWaitingForYield == pdFALSE )
+						{
+							SuspendThread( pxThreadState->pvThread );
+						}
+					}
+					#else
+					{
+						SuspendThread( pxThreadState->pvThread );
+					}
+					#endif
 				}							
 
 				/* Obtain the state of the task now selected to enter the 
 				Running state. */
 				pxThreadState = ( xThreadState * ) ( *( unsigned long *) pxCurrentTCB );
-				ResumeThread( pxThreadState->pvThread );
+				prvResumeThread( pxThreadState );
+			}
+		}
+
+		#if( configWIN32_USE_YIELD_EVENTS == 1 )
+		{
+			/* If the task that yielded was selected to run again then it is
+			still waiting on its yield event. */
+			pxThreadState = ( xThreadState * ) ( *( unsigned long *) pxCurrentTCB );
+
+			if( pxThreadState->lWaitingForYield != pdFALSE )
+			{
+				prvResumeThread( pxThreadState );
 			}
 		}
+		#endif
 
 		ReleaseMutex( pvInterruptEventMutex );
 	}
@@ -402,6 +483,12 @@ xThreadState *pxThreadState;
 		pxThreadState = ( xThreadState * ) ( *( unsigned long *) pvTaskToDelete );
 		TerminateThread( pxThreadState->pvThread, 0 );
 
+		#if( configWIN32_USE_YIELD_EVENTS == 1 )
+		{
+			CloseHandle( pxThreadState->pvYieldEvent );
+		}
+		#endif
+
 		ReleaseMutex( pvInterruptEventMutex );
 	}
 }
@@ -433,6 +520,18 @@ xThreadState *pxThreadState;
 			the next time this task runs. */
 			pxThreadState = ( xThreadState * ) *( ( unsigned long * ) pxCurrentTCB );
 			SetEvent( pvInterruptEvent );			
+
+			#if( configWIN32_USE_YIELD_EVENTS == 1 )
+			{
+				/* A task yielding from its own thread waits to be selected
+				again rather than running on until it is suspended. */
+				if( ( ulInterruptNumber == portINTERRUPT_YIELD ) && ( pxThreadState->dwThreadId == GetCurrentThreadId() ) )
+				{
+					prvWaitForYield( pxThreadState );
+					return;
+				}
+			}
+			#endif
 		}
 
 		ReleaseMutex( pvInterruptEventMutex );
@@ -503,7 +602,25 @@ long lMutexNeedsReleasing;
 				/* Mutex will be released now, so does not require releasing
 				on function exit. */
 				lMutexNeedsReleasing = pdFALSE;
-				ReleaseMutex( pvInterruptEventMutex );
+
+				#if( configWIN32_USE_YIELD_EVENTS == 1 )
+				{
+					/* A yield requested from within the critical section is
+					handled in the same way as one requested outside it. */
+					if( ( ( ulPendingInterrupts & ( 1UL << portINTERRUPT_YIELD ) ) != 0UL ) && ( pxThreadState->dwThreadId == GetCurrentThreadId() ) )
+					{
+						prvWaitForYield( pxThreadState );
+					}
+					else
+					{
+						ReleaseMutex( pvInterruptEventMutex );
+					}
+				}
+				#else
+				{
+					ReleaseMutex( pvInterruptEventMutex );
+				}
+				#endif
 			}
 		}
 		else
@@ -521,3 +638,42 @@ long lMutexNeedsReleasing;
 }
 /*-----------------------------------------------------------*/
 
+
+static void prvResumeThread( void *pvThreadState )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvThreadState;
+
+	#if( configWIN32_USE_YIELD_EVENTS == 1 )
+	{
+		if( pxThreadState->lWaitingForYield != pdFALSE )
+		{
+			/* The thread stopped itself by waiting on its yield event.  The
+			event is auto reset so it does not matter if the thread has not
+			reached the wait yet. */
+			pxThreadState->lWaitingForYield = pdFALSE;
+			SetEvent( pxThreadState->pvYieldEvent );
+			return;
+		}
+	}
+	#endif
+
+	ResumeThread( pxThreadState->pvThread );
+}
+/*-----------------------------------------------------------*/
+
+#if( configWIN32_USE_YIELD_EVENTS == 1 )
+
+	static void prvWaitForYield( void *pvThreadState )
+	{
+	xThreadState *pxThreadState = ( xThreadState * ) pvThreadState;
+
+		/* Set while the interrupt event mutex is still held, so the simulated
+		interrupt handler thread knows not to suspend this thread. */
+		pxThreadState->lWaitingForYield = pdTRUE;
+		ReleaseMutex( pvInterruptEventMutex );
+
+		WaitForSingleObject( pxThreadState->pvYieldEvent, INFINITE );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
@@ -69,6 +69,10 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	#include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /* Allocate the memory for the heap.  The struct is used to force byte
@@ -109,7 +113,26 @@ void *pvReturn = NULL;
 			block. */
 			pvReturn = &( xHeap.ucHeap[ xNextFreeByte ] );
 			xNextFreeByte += xWantedSize;			
+
+			#if ( configUSE_HEAP_TRACE == 1 )
+			{
+				/* The blocks are never freed, so the owner does not need to
+				be remembered. */
+				( void ) uxHeapTraceMalloc( xWantedSize );
+			}
+			#endif
 		}	
+
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			if( pvReturn == NULL )
+			{
+				vHeapTraceMallocFailed();
+			}
+		}
+		#endif
+
+		traceMALLOC( pvReturn, xWantedSize );
 	}
 	xTaskResumeAll();
 	
@@ -147,6 +170,13 @@ size_t xPortGetFreeHeapSize( void )
 {
 	return ( configTOTAL_HEAP_SIZE - xNextFreeByte );
 }
+/*-----------------------------------------------------------*/
+
+size_t xPortGetLargestFreeBlockSize( void )
+{
+	/* The free space is always a single block at the end of the heap. */
+	return ( configTOTAL_HEAP_SIZE - xNextFreeByte );
+}
 
 
 
@@ -69,6 +69,10 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	#include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /* Allocate the memory for the heap.  The struct is used to force byte
@@ -165,6 +169,14 @@ void *pvReturn = NULL;
 		{
 			prvHeapInit();
 			xHeapHasBeenInitialised = pdTRUE;
+
+			#if ( configUSE_HEAP_TRACE == 1 )
+			{
+				/* The owner of each allocated block is held in the top bits
+				of its size, so no block can be that large. */
+				configASSERT( ( ( ( size_t ) configTOTAL_HEAP_SIZE ) & heaptraceOWNER_MASK ) == 0 );
+			}
+			#endif
 		}
 
 		/* The wanted size is increased so it can contain a xBlockLink
@@ -222,8 +234,25 @@ void *pvReturn = NULL;
 				}
 				
 				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				#if ( configUSE_HEAP_TRACE == 1 )
+				{
+					pxBlock->xBlockSize = heaptraceSET_OWNER( pxBlock->xBlockSize, uxHeapTraceMalloc( pxBlock->xBlockSize ) );
+				}
+				#endif
+			}
+		}
+
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			if( pvReturn == NULL )
+			{
+				vHeapTraceMallocFailed();
 			}
 		}
+		#endif
+
+		traceMALLOC( pvReturn, xWantedSize );
 	}
 	xTaskResumeAll();
 
@@ -257,6 +286,17 @@ xBlockLink *pxLink;
 
 		vTaskSuspendAll();
 		{
+			#if ( configUSE_HEAP_TRACE == 1 )
+			{
+				/* Remove the owner from the size before the block goes back
+				into the size ordered list. */
+				vHeapTraceFree( heaptraceGET_OWNER( pxLink->xBlockSize ), pxLink->xBlockSize & ~heaptraceOWNER_MASK );
+				pxLink->xBlockSize &= ~heaptraceOWNER_MASK;
+			}
+			#endif
+
+			traceFREE( pv, pxLink->xBlockSize );
+
 			/* Add this block to the list of free blocks. */
 			prvInsertBlockIntoFreeList( ( ( xBlockLink * ) pxLink ) );
 			xFreeBytesRemaining += pxLink->xBlockSize;
@@ -272,6 +312,31 @@ size_t xPortGetFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetLargestFreeBlockSize( void )
+{
+xBlockLink *pxBlock;
+size_t xLargest = xFreeBytesRemaining;
+
+	vTaskSuspendAll();
+	{
+		/* The free list is ordered by size, so the largest block is the last
+		one before xEnd.  xStart is not set up until the first allocation. */
+		if( xStart.pxNextFreeBlock != NULL )
+		{
+			xLargest = 0;
+
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != &xEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				xLargest = pxBlock->xBlockSize;
+			}
+		}
+	}
+	xTaskResumeAll();
+
+	return xLargest;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -59,6 +59,19 @@
  * This file can only be used if the linker is configured to to generate
  * a heap memory area.
  *
+ * When configUSE_HEAP_TASK_CACHES is set to 1 each task keeps a small cache
+ * of freed blocks in each of configHEAP_TASK_CACHE_CLASSES size classes (16,
+ * 32, 64... bytes).  Small allocations are served from, and small blocks
+ * freed to, the cache of the calling task.  The cache is only ever used by the
+ * task that owns it, so this is done without suspending the scheduler.  Only
+ * when a cache is empty, or already holds configHEAP_TASK_CACHE_DEPTH blocks
+ * of a class, is the scheduler suspended to call malloc() or free() - and then
+ * for half the cache depth at once.  Blocks freed by a task other than the one
+ * that allocated them go into the cache of the task freeing them.  The blocks
+ * held in the cache of a task are returned to the C library when the task is
+ * deleted.  Allocations larger than the largest class, and any made before the
+ * scheduler is started, always go to the C library.
+ *
  * See heap_2.c and heap_1.c for alternative implementations, and the memory
  * management pages of http://www.FreeRTOS.org for more information.
  */
@@ -73,19 +86,192 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	#include "heap_trace.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if ( configUSE_HEAP_TRACE == 1 ) || ( configUSE_HEAP_TASK_CACHES == 1 )
+
+	/* The C library does not say how big a block is, or who it belongs to, so
+	when heap tracing or the task caches are used a header holding the size of
+	the block (including the header) is placed in front of each block.  When
+	heap tracing is used the top bits of the size also hold the owner of the
+	block.  The header size is rounded up so the memory returned stays
+	aligned. */
+	#define heapUSE_BLOCK_HEADER	1
+	#define heapHEADER_SIZE			( ( sizeof( size_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+	#if ( configUSE_HEAP_TRACE == 1 )
+		#define heapBLOCK_SIZE( xHeader )	( ( xHeader ) & ~heaptraceOWNER_MASK )
+	#else
+		#define heapBLOCK_SIZE( xHeader )	( xHeader )
+	#endif
+
+#else
+
+	#define heapUSE_BLOCK_HEADER	0
+
+#endif
+
+#if ( configUSE_HEAP_TASK_CACHES == 1 )
+
+	/* The bytes that can be requested from the smallest size class.  Each
+	following class holds twice as many. */
+	#define heapSMALLEST_CLASS_SIZE		( ( size_t ) 16U )
+
+	/* Returned by prvCacheClass() for a block that is not cached. */
+	#define heapNO_CLASS				( ( unsigned portBASE_TYPE ) configHEAP_TASK_CACHE_CLASSES )
+
+	/* The number of blocks obtained from, or given back to, the C library at
+	once when a cache is empty or full. */
+	#define heapCACHE_BATCH				( ( configHEAP_TASK_CACHE_DEPTH + 1 ) / 2 )
+
+	/* The cache of a task.  The free blocks of each class are linked through
+	the first word after their header. */
+	typedef struct HEAP_TASK_CACHE
+	{
+		size_t *pxFreeBlocks[ configHEAP_TASK_CACHE_CLASSES ];
+		unsigned portBASE_TYPE uxFreeBlocks[ configHEAP_TASK_CACHE_CLASSES ];
+	} xHeapTaskCache;
+
+	#define heapNEXT_FREE_BLOCK( pxHeader )	( *( ( size_t ** ) ( ( ( unsigned char * ) ( pxHeader ) ) + heapHEADER_SIZE ) ) )
+
+	/*
+	 * Returns the class of a block of xBlockSize bytes, or heapNO_CLASS if
+	 * blocks of that size are not cached.
+	 */
+	static unsigned portBASE_TYPE prvCacheClass( size_t xBlockSize );
+
+	/*
+	 * Takes a block of xBlockSize bytes from the cache of the calling task.
+	 * Returns NULL if the cache has no such block.
+	 */
+	static size_t *prvCacheTake( size_t xBlockSize );
+
+	/*
+	 * Places a block in the cache of the calling task.  Returns pdFALSE if
+	 * the block cannot be cached.
+	 */
+	static portBASE_TYPE prvCachePut( size_t *pxHeader );
+
+	/*
+	 * Called with the scheduler suspended when a block has been obtained from
+	 * the C library for the calling task, to fill the cache with more blocks of
+	 * the same size.
+	 */
+	static void prvCacheRefill( size_t xBlockSize );
+
+	/*
+	 * Called with the scheduler suspended to free a block the cache of the
+	 * calling task had no room for, together with half the blocks of its class
+	 * already in the cache.
+	 */
+	static void prvCacheTrim( size_t *pxHeader );
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
-void *pvReturn;
+void *pvReturn = NULL;
 
-	vTaskSuspendAll();
+	#if ( heapUSE_BLOCK_HEADER == 1 )
 	{
-		pvReturn = malloc( xWantedSize );
+	size_t *pxHeader = NULL;
+	size_t xBlockSize = xWantedSize + heapHEADER_SIZE;
+
+		#if ( configUSE_HEAP_TASK_CACHES == 1 )
+		{
+		unsigned portBASE_TYPE uxClass;
+
+			/* Small requests are rounded up to the size of their class, so
+			every small block can be cached when it is freed. */
+			for( uxClass = 0U; uxClass < heapNO_CLASS; uxClass++ )
+			{
+				if( xWantedSize <= ( heapSMALLEST_CLASS_SIZE << uxClass ) )
+				{
+					xBlockSize = ( heapSMALLEST_CLASS_SIZE << uxClass ) + heapHEADER_SIZE;
+					break;
+				}
+			}
+
+			pxHeader = prvCacheTake( xBlockSize );
+		}
+		#endif
+
+		/* The top bits of the size hold the owner when heap tracing is used,
+		so must be clear. */
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			if( ( xBlockSize & heaptraceOWNER_MASK ) != 0 )
+			{
+				xBlockSize = 0;
+			}
+		}
+		#endif
+
+		if( ( pxHeader == NULL ) && ( xBlockSize > xWantedSize ) )
+		{
+			vTaskSuspendAll();
+			{
+				pxHeader = ( size_t * ) malloc( xBlockSize );
+
+				#if ( configUSE_HEAP_TASK_CACHES == 1 )
+				{
+					if( pxHeader != NULL )
+					{
+						prvCacheRefill( xBlockSize );
+					}
+				}
+				#endif
+			}
+			xTaskResumeAll();
+		}
+
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			vTaskSuspendAll();
+			{
+				if( pxHeader != NULL )
+				{
+					*pxHeader = heaptraceSET_OWNER( xBlockSize, uxHeapTraceMalloc( xBlockSize ) );
+				}
+				else
+				{
+					vHeapTraceMallocFailed();
+				}
+			}
+			xTaskResumeAll();
+		}
+		#else
+		{
+			if( pxHeader != NULL )
+			{
+				*pxHeader = xBlockSize;
+			}
+		}
+		#endif
+
+		if( pxHeader != NULL )
+		{
+			pvReturn = ( void * ) ( ( ( unsigned char * ) pxHeader ) + heapHEADER_SIZE );
+		}
+
+		traceMALLOC( pvReturn, xBlockSize );
+	}
+	#else
+	{
+		vTaskSuspendAll();
+		{
+			pvReturn = malloc( xWantedSize );
+			traceMALLOC( pvReturn, xWantedSize );
+		}
+		xTaskResumeAll();
 	}
-	xTaskResumeAll();
+	#endif
 
 	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
 	{
@@ -105,13 +291,239 @@ void vPortFree( void *pv )
 {
 	if( pv )
 	{
+		#if ( heapUSE_BLOCK_HEADER == 1 )
+		{
+		size_t *pxHeader = ( size_t * ) ( ( ( unsigned char * ) pv ) - heapHEADER_SIZE );
+
+			traceFREE( pv, heapBLOCK_SIZE( *pxHeader ) );
+
+			#if ( configUSE_HEAP_TRACE == 1 )
+			{
+				vTaskSuspendAll();
+				{
+					vHeapTraceFree( heaptraceGET_OWNER( *pxHeader ), heapBLOCK_SIZE( *pxHeader ) );
+					*pxHeader = heapBLOCK_SIZE( *pxHeader );
+				}
+				xTaskResumeAll();
+			}
+			#endif
+
+			#if ( configUSE_HEAP_TASK_CACHES == 1 )
+			{
+				if( prvCachePut( pxHeader ) == pdFALSE )
+				{
+					vTaskSuspendAll();
+					{
+						prvCacheTrim( pxHeader );
+					}
+					xTaskResumeAll();
+				}
+			}
+			#else
+			{
+				vTaskSuspendAll();
+				{
+					free( pxHeader );
+				}
+				xTaskResumeAll();
+			}
+			#endif
+		}
+		#else
+		{
+			vTaskSuspendAll();
+			{
+				traceFREE( pv, 0 );
+				free( pv );
+			}
+			xTaskResumeAll();
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TASK_CACHES == 1 )
+
+	void vPortFreeTaskHeapCache( void *pvCache )
+	{
+	xHeapTaskCache *pxCache = ( xHeapTaskCache * ) pvCache;
+	unsigned portBASE_TYPE uxClass;
+	size_t *pxHeader;
+
+		/* The task the cache belonged to has been deleted, so nothing else
+		can be using the cache. */
 		vTaskSuspendAll();
 		{
-			free( pv );
+			for( uxClass = 0U; uxClass < heapNO_CLASS; uxClass++ )
+			{
+				while( pxCache->pxFreeBlocks[ uxClass ] != NULL )
+				{
+					pxHeader = pxCache->pxFreeBlocks[ uxClass ];
+					pxCache->pxFreeBlocks[ uxClass ] = heapNEXT_FREE_BLOCK( pxHeader );
+					free( pxHeader );
+				}
+			}
+
+			free( pxCache );
 		}
 		xTaskResumeAll();
 	}
-}
 
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TASK_CACHES == 1 )
+
+	static unsigned portBASE_TYPE prvCacheClass( size_t xBlockSize )
+	{
+	unsigned portBASE_TYPE uxClass;
+
+		for( uxClass = 0U; uxClass < heapNO_CLASS; uxClass++ )
+		{
+			if( xBlockSize == ( ( heapSMALLEST_CLASS_SIZE << uxClass ) + heapHEADER_SIZE ) )
+			{
+				break;
+			}
+		}
+
+		return uxClass;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t *prvCacheTake( size_t xBlockSize )
+	{
+	void **ppvCache;
+	xHeapTaskCache *pxCache;
+	unsigned portBASE_TYPE uxClass;
+	size_t *pxHeader = NULL;
+
+		uxClass = prvCacheClass( xBlockSize );
+		ppvCache = ppvTaskGetHeapCache();
+
+		if( ( uxClass != heapNO_CLASS ) && ( ppvCache != NULL ) && ( *ppvCache != NULL ) )
+		{
+			pxCache = ( xHeapTaskCache * ) *ppvCache;
+			pxHeader = pxCache->pxFreeBlocks[ uxClass ];
+
+			if( pxHeader != NULL )
+			{
+				pxCache->pxFreeBlocks[ uxClass ] = heapNEXT_FREE_BLOCK( pxHeader );
+				( pxCache->uxFreeBlocks[ uxClass ] )--;
+			}
+		}
+
+		return pxHeader;
+	}
+	/*-----------------------------------------------------------*/
+
+	static portBASE_TYPE prvCachePut( size_t *pxHeader )
+	{
+	void **ppvCache;
+	xHeapTaskCache *pxCache;
+	unsigned portBASE_TYPE uxClass;
+
+		uxClass = prvCacheClass( *pxHeader );
+		ppvCache = ppvTaskGetHeapCache();
+
+		if( ( uxClass == heapNO_CLASS ) || ( ppvCache == NULL ) || ( *ppvCache == NULL ) )
+		{
+			return pdFALSE;
+		}
+
+		pxCache = ( xHeapTaskCache * ) *ppvCache;
+		if( pxCache->uxFreeBlocks[ uxClass ] >= ( unsigned portBASE_TYPE ) configHEAP_TASK_CACHE_DEPTH )
+		{
+			return pdFALSE;
+		}
+
+		heapNEXT_FREE_BLOCK( pxHeader ) = pxCache->pxFreeBlocks[ uxClass ];
+		pxCache->pxFreeBlocks[ uxClass ] = pxHeader;
+		( pxCache->uxFreeBlocks[ uxClass ] )++;
+
+		return pdTRUE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCacheRefill( size_t xBlockSize )
+	{
+	void **ppvCache;
+	xHeapTaskCache *pxCache;
+	unsigned portBASE_TYPE uxClass, uxBlock;
+	size_t *pxHeader;
+
+		uxClass = prvCacheClass( xBlockSize );
+		ppvCache = ppvTaskGetHeapCache();
+
+		if( ( uxClass == heapNO_CLASS ) || ( ppvCache == NULL ) )
+		{
+			return;
+		}
+
+		/* The cache of a task is created the first time it is needed. */
+		if( *ppvCache == NULL )
+		{
+			pxCache = ( xHeapTaskCache * ) malloc( sizeof( xHeapTaskCache ) );
+			if( pxCache == NULL )
+			{
+				return;
+			}
+
+			for( uxBlock = 0U; uxBlock < heapNO_CLASS; uxBlock++ )
+			{
+				pxCache->pxFreeBlocks[ uxBlock ] = NULL;
+				pxCache->uxFreeBlocks[ uxBlock ] = 0U;
+			}
+
+			*ppvCache = ( void * ) pxCache;
+		}
+
+		pxCache = ( xHeapTaskCache * ) *ppvCache;
+
+		/* The block being allocated is one of the batch, so one fewer is
+		cached. */
+		for( uxBlock = 1U; ( uxBlock < ( unsigned portBASE_TYPE ) heapCACHE_BATCH ) && ( pxCache->uxFreeBlocks[ uxClass ] < ( unsigned portBASE_TYPE ) configHEAP_TASK_CACHE_DEPTH ); uxBlock++ )
+		{
+			pxHeader = ( size_t * ) malloc( xBlockSize );
+			if( pxHeader == NULL )
+			{
+				break;
+			}
+
+			*pxHeader = xBlockSize;
+			heapNEXT_FREE_BLOCK( pxHeader ) = pxCache->pxFreeBlocks[ uxClass ];
+			pxCache->pxFreeBlocks[ uxClass ] = pxHeader;
+			( pxCache->uxFreeBlocks[ uxClass ] )++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCacheTrim( size_t *pxHeader )
+	{
+	void **ppvCache;
+	xHeapTaskCache *pxCache;
+	unsigned portBASE_TYPE uxClass, uxBlock;
+	size_t *pxCached;
+
+		uxClass = prvCacheClass( *pxHeader );
+		ppvCache = ppvTaskGetHeapCache();
+
+		free( pxHeader );
+
+		/* Only a full cache is trimmed - the block may just not be cacheable. */
+		if( ( uxClass != heapNO_CLASS ) && ( ppvCache != NULL ) && ( *ppvCache != NULL ) )
+		{
+			pxCache = ( xHeapTaskCache * ) *ppvCache;
+
+			for( uxBlock = 1U; ( uxBlock < ( unsigned portBASE_TYPE ) heapCACHE_BATCH ) && ( pxCache->pxFreeBlocks[ uxClass ] != NULL ); uxBlock++ )
+			{
+				pxCached = pxCache->pxFreeBlocks[ uxClass ];
+				pxCache->pxFreeBlocks[ uxClass ] = heapNEXT_FREE_BLOCK( pxCached );
+				( pxCache->uxFreeBlocks[ uxClass ] )--;
+				free( pxCached );
+			}
+		}
+	}
 
+#endif /* configUSE_HEAP_TASK_CACHES */
 
@@ -72,6 +72,19 @@ PSW is set with U and I set, and PM and IPL clear. */
 #define portINITIAL_PSW     ( ( portSTACK_TYPE ) 0x00030000 )
 #define portINITIAL_FPSW    ( ( portSTACK_TYPE ) 0x00000100 )
 
+/* The FIEN bit of the fast interrupt register. */
+#define portFIR_FIEN		( ( unsigned short ) 0x8000 )
+
+#if configFAST_INTERRUPT_RESERVED_REGISTERS > 4
+	#error configFAST_INTERRUPT_RESERVED_REGISTERS must be between 0 and 4.
+#endif
+
+/* The fast interrupt is taken at priority 15 and must be above every interrupt
+that can use the kernel, as it cannot itself call any API function. */
+#if defined( configFAST_INTERRUPT_HANDLER ) && ( configMAX_SYSCALL_INTERRUPT_PRIORITY >= 15 )
+	#error configMAX_SYSCALL_INTERRUPT_PRIORITY must be below 15 when a fast interrupt is used.
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The following lines are to ensure vSoftwareInterruptEntry can be referenced,
@@ -110,6 +123,29 @@ convenience. */
 extern void *pxCurrentTCB;
 extern void vTaskSwitchContext( void );
 
+#if configUSE_PROFILER == 1
+	/* The interrupt stack pointer while tasks are running.  Written when the
+	first task is started. */
+	unsigned long ulPortInterruptStackBase = 0UL;
+#endif
+
+#if configUSE_DYNAMIC_TICK_RATE == 1
+	/* Supplied by the application, as vApplicationSetupTimerInterrupt() is.
+	Called from the tick interrupt to make the tick timer interrupt every
+	xTicks ticks. */
+	extern void vApplicationSetTickInterruptPeriod( portTickType xTicks );
+
+	/* A tick period passed to xPortSetTickInterruptPeriod() that the tick
+	timer has not been given yet, or 0. */
+	static volatile portTickType xPendingTickPeriod = 0;
+#endif
+
+#if configDSP_CONTEXT_PER_TASK == 1
+	/* Set to pdTRUE while the Running state task has the accumulator in its
+	context.  Saved in and restored from the context of each task. */
+	unsigned long ulPortTaskHasDSPContext = pdFALSE;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* 
@@ -170,9 +206,19 @@ portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE
 	pxTopOfStack--;				
 	*pxTopOfStack = portINITIAL_FPSW;
 	pxTopOfStack--;
-	*pxTopOfStack = 0x12345678; /* Accumulator. */
-	pxTopOfStack--;
-	*pxTopOfStack = 0x87654321; /* Accumulator. */
+
+	#if configDSP_CONTEXT_PER_TASK == 1
+	{
+		/* Tasks start without the accumulator in their context. */
+		*pxTopOfStack = pdFALSE;
+	}
+	#else
+	{
+		*pxTopOfStack = 0x12345678; /* Accumulator. */
+		pxTopOfStack--;
+		*pxTopOfStack = 0x87654321; /* Accumulator. */
+	}
+	#endif
 
 	return pxTopOfStack;
 }
@@ -190,6 +236,17 @@ extern void vApplicationSetupTimerInterrupt( void );
 		use.  A demo application is provided to show a suitable example. */
 		vApplicationSetupTimerInterrupt();
 
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			/* xTaskSetTickRate() was called before the scheduler started. */
+			if( xPendingTickPeriod != 0 )
+			{
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		/* Enable the software interrupt. */		
 		_IEN( _ICU_SWINT ) = 1;
 		
@@ -198,6 +255,22 @@ extern void vApplicationSetupTimerInterrupt( void );
 		
 		/* Ensure the software interrupt is set to the kernel priority. */
 		_IPR( _ICU_SWINT ) = configKERNEL_INTERRUPT_PRIORITY;
+
+		/* Make the interrupt with vector configFAST_INTERRUPT_VECTOR the fast
+		interrupt.  Its PC and PSW are saved in the backup registers rather
+		than on the stack, and its handler, configFAST_INTERRUPT_HANDLER,
+		returns with RTFI - so is defined using #pragma interrupt ( name( fint ) ).
+		The handler can work in the registers reserved through
+		configFAST_INTERRUPT_RESERVED_REGISTERS without saving them.  The
+		application still sets up and enables the peripheral interrupt. */
+		#ifdef configFAST_INTERRUPT_HANDLER
+		{
+		extern void configFAST_INTERRUPT_HANDLER( void );
+
+			set_fintv( ( void * ) configFAST_INTERRUPT_HANDLER );
+			ICU.FIR.WORD = portFIR_FIEN | ( unsigned short ) configFAST_INTERRUPT_VECTOR;
+		}
+		#endif
 	
 		/* Start the first task. */
 		prvStartFirstTask();
@@ -214,6 +287,14 @@ extern void vApplicationSetupTimerInterrupt( void );
 #pragma inline_asm prvStartFirstTask
 static void prvStartFirstTask( void )
 {
+#if configUSE_PROFILER == 1
+	/* Record where the interrupt stack is left, for
+	ulPortGetInterruptedPC(). */
+	MVFC	ISP, R15
+	MOV.L	#_ulPortInterruptStackBase, R14
+	MOV.L	R15, [ R14 ]
+#endif
+
 	/* When starting the scheduler there is nothing that needs moving to the
 	interrupt stack because the function is not called from an interrupt.
 	Just ensure the current stack is the user stack. */
@@ -227,13 +308,42 @@ static void prvStartFirstTask( void )
 
 	/* Restore the registers from the stack of the task pointed to by 
 	pxCurrentTCB. */
+#if configDSP_CONTEXT_PER_TASK == 1
+    /* The flag word says whether the accumulator is in the context. */
+    POP		R15
+    MOV.L	#_ulPortTaskHasDSPContext, R14
+    MOV.L	R15, [ R14 ]
+    CMP		#0, R15
+    BEQ		?+
+#endif
     POP		R15
     MVTACLO	R15 		/* Accumulator low 32 bits. */
     POP		R15
     MVTACHI	R15 		/* Accumulator high 32 bits. */
+#if configDSP_CONTEXT_PER_TASK == 1
+?:
+#endif
     POP		R15
     MVTC	R15,FPSW 	/* Floating point status word. */
+#if configFAST_INTERRUPT_RESERVED_REGISTERS == 0
     POPM	R1-R15 		/* R1 to R15 - R0 is not included as it is the SP. */
+#else
+    /* The registers reserved for the fast interrupt are left as they are. */
+	#if configFAST_INTERRUPT_RESERVED_REGISTERS == 1
+    POPM	R1-R12
+    ADD	#4, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 2
+    POPM	R1-R11
+    ADD	#8, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 3
+    POPM	R1-R10
+    ADD	#12, R0
+	#else
+    POPM	R1-R9
+    ADD	#16, R0
+	#endif
+    POPM	R14-R15
+#endif
     RTE					/* This pops the remaining registers. */
     NOP
     NOP
@@ -247,6 +357,19 @@ void vTickISR( void )
 	necessitates. */
 	set_ipl( configMAX_SYSCALL_INTERRUPT_PRIORITY );
 	{
+		#if configUSE_DYNAMIC_TICK_RATE == 1
+		{
+			if( xPendingTickPeriod != 0 )
+			{
+				/* The compare match that caused this interrupt has just
+				restarted the tick timer, so the period it is now counting is
+				the first one the kernel takes to be the new length. */
+				vApplicationSetTickInterruptPeriod( xPendingTickPeriod );
+				xPendingTickPeriod = 0;
+			}
+		}
+		#endif
+
 		vTaskIncrementTick();
 	}
 	set_ipl( configKERNEL_INTERRUPT_PRIORITY );
@@ -258,6 +381,35 @@ void vTickISR( void )
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_PROFILER == 1
+
+	unsigned long ulPortGetInterruptedPC( void )
+	{
+		/* Only valid in the tick interrupt.  Tasks run on the user stack, and
+		the tick runs at the lowest priority so only ever interrupts a task.
+		The interrupt stack is therefore as it was when the first task started
+		with just the PC, then the PSW, of the interrupted task below it. */
+		return *( ( volatile unsigned long * ) ( ulPortInterruptStackBase - 8UL ) );
+	}
+
+#endif /* configUSE_PROFILER */
+/*-----------------------------------------------------------*/
+
+#if configUSE_DYNAMIC_TICK_RATE == 1
+
+	portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks )
+	{
+		/* Called from a critical section.  The tick timer is reprogrammed from
+		the next tick interrupt, so the tick period that is running keeps its
+		length. */
+		xPendingTickPeriod = xTicks;
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
 void vSoftwareInterruptISR( void )
 {
 	prvYieldHandler();
@@ -300,11 +452,23 @@ static void prvYieldHandler( void )
 	/* Save the FPSW and accumulator. */
 	MVFC	FPSW, R15
 	PUSH.L	R15
+#if configDSP_CONTEXT_PER_TASK == 1
+	/* Only tasks that use the DSP instructions have the accumulator saved.
+	R14 has been saved so can hold the flag. */
+	MOV.L	#_ulPortTaskHasDSPContext, R14
+	MOV.L	[ R14 ], R14
+	CMP		#0, R14
+	BEQ		?+
+#endif
 	MVFACHI	R15
 	PUSH.L	R15
 	MVFACMI	R15	; Middle order word.
 	SHLL	#16, R15 ; Shifted left as it is restored to the low order word.
 	PUSH.L	R15
+#if configDSP_CONTEXT_PER_TASK == 1
+?:
+	PUSH.L	R14
+#endif
 
 	/* Save the stack pointer to the TCB. */
 	MOV.L	#_pxCurrentTCB, R15
@@ -329,19 +493,60 @@ static void prvYieldHandler( void )
 
 	/* Restore the context of the new task.  The PSW (Program Status Word) and
 	PC will be popped by the RTE instruction. */
+#if configDSP_CONTEXT_PER_TASK == 1
+	/* The flag word says whether the accumulator is in the context. */
+	POP		R15
+	MOV.L	#_ulPortTaskHasDSPContext, R14
+	MOV.L	R15, [ R14 ]
+	CMP		#0, R15
+	BEQ		?+
+#endif
 	POP		R15
 	MVTACLO	R15
 	POP		R15
 	MVTACHI	R15
+#if configDSP_CONTEXT_PER_TASK == 1
+?:
+#endif
 	POP		R15
 	MVTC	R15,FPSW
+#if configFAST_INTERRUPT_RESERVED_REGISTERS == 0
 	POPM	R1-R15
+#else
+	/* The registers reserved for the fast interrupt are left as they are. */
+	#if configFAST_INTERRUPT_RESERVED_REGISTERS == 1
+	POPM	R1-R12
+	ADD	#4, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 2
+	POPM	R1-R11
+	ADD	#8, R0
+	#elif configFAST_INTERRUPT_RESERVED_REGISTERS == 3
+	POPM	R1-R10
+	ADD	#12, R0
+	#else
+	POPM	R1-R9
+	ADD	#16, R0
+	#endif
+	POPM	R14-R15
+#endif
 	RTE
 	NOP
 	NOP
 }
 /*-----------------------------------------------------------*/
 
+#if configDSP_CONTEXT_PER_TASK == 1
+
+	void vPortTaskUsesDSP( void )
+	{
+		/* The accumulator is saved from the next context switch on.  The flag
+		belongs to the calling task as it is part of its context. */
+		ulPortTaskHasDSPContext = pdTRUE;
+	}
+
+#endif /* configDSP_CONTEXT_PER_TASK */
+/*-----------------------------------------------------------*/
+
 void vPortEndScheduler( void )
 {
 	/* Not implemented as there is nothing to return to. */
@@ -125,6 +125,51 @@ extern void vTaskExitCritical( void );
 
 /*-----------------------------------------------------------*/
 
+/* With configDSP_CONTEXT_PER_TASK set to 1 the accumulator is only saved and
+restored for tasks that have called portTASK_USES_DSP(), which a task must do
+before it executes any of the MUL/MAC/RACW/MVTAC instructions that use the
+accumulator.  The context of every other task leaves the accumulator out. */
+#ifndef configDSP_CONTEXT_PER_TASK
+	#define configDSP_CONTEXT_PER_TASK	0
+#endif
+
+#if configDSP_CONTEXT_PER_TASK == 1
+	void vPortTaskUsesDSP( void );
+	#define portTASK_USES_DSP()	vPortTaskUsesDSP()
+#else
+	#define portTASK_USES_DSP()
+#endif
+
+/* The number of registers, counting down from R13, that the compiler has been
+told to keep free for the fast interrupt (the fint_register compiler option).
+The context switch does not restore these registers so the values the fast
+interrupt keeps in them survive.  Between 0 and 4. */
+#ifndef configFAST_INTERRUPT_RESERVED_REGISTERS
+	#define configFAST_INTERRUPT_RESERVED_REGISTERS	0
+#endif
+/*-----------------------------------------------------------*/
+
+/* Tick rate switching.  vApplicationSetTickInterruptPeriod() has to be
+provided to reprogram the timer set up by vApplicationSetupTimerInterrupt(). */
+#ifndef portSET_TICK_INTERRUPT_PERIOD
+	extern portBASE_TYPE xPortSetTickInterruptPeriod( portTickType xTicks );
+	#define portSET_TICK_INTERRUPT_PERIOD( xTicks ) xPortSetTickInterruptPeriod( xTicks )
+#endif
+
+/* Statistical profiler.  Reads the PC saved when the tick interrupt was
+taken. */
+#ifndef portPROFILER_GET_INTERRUPTED_PC
+	extern unsigned long ulPortGetInterruptedPC( void );
+	#define portPROFILER_GET_INTERRUPTED_PC() ulPortGetInterruptedPC()
+#endif
+
+/* The fast interrupt saves the PC in BPC rather than on the stack, so a fast
+interrupt handler that takes profiler samples passes this instead.  The fast
+interrupt is above every other interrupt, so samples interrupt handlers and
+critical sections as well as tasks. */
+#define portPROFILER_GET_FAST_INTERRUPT_PC() ( ( unsigned long ) get_bpc() )
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
@@ -0,0 +1,616 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "priority_queue.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The definition of a priority queue.  pxEntries is a binary heap of
+uxLength entries, the first uxMessagesWaiting of which describe the items
+held, ordered so that no entry comes before its parent.  Each entry names the
+slot of pucItems that holds its item, and the entries past the end of the heap
+name the free slots, so an item never has to move once it has been copied in.
+The members are only accessed from within a critical section (or with
+interrupts masked), including when tasks are added to or removed from the
+event lists, so items can be sent and received from interrupts. */
+typedef struct PriorityQueueDefinition
+{
+	unsigned long ulNextSequence;			/*< The sequence number given to the next item sent, which keeps items of equal priority in the order they were sent. */
+	unsigned portBASE_TYPE uxMessagesWaiting;	/*< The number of items held. */
+	unsigned portBASE_TYPE uxLength;		/*< The number of items the queue can hold. */
+	unsigned portBASE_TYPE uxItemSize;		/*< The size of each item in bytes. */
+	xList xTasksWaitingToSend;				/*< List of tasks waiting for space.  Stored in priority order. */
+	xList xTasksWaitingToReceive;			/*< List of tasks waiting for an item.  Stored in priority order. */
+	xPriorityQueueEntry *pxEntries;			/*< Points to the heap, which follows the structure in memory unless the queue was created statically. */
+	unsigned char *pucItems;				/*< Points to the item storage area, which follows the heap in memory unless the queue was created statically. */
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the structure and storage areas were supplied by the application, so must not be freed when the queue is deleted. */
+	#endif
+} xPRIORITY_QUEUE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if the item described by pxEntry is to be received before
+ * the item described by pxOther.
+ */
+static portBASE_TYPE prvIsBefore( const xPriorityQueueEntry * const pxEntry, const xPriorityQueueEntry * const pxOther );
+
+/*
+ * Copy an item into a free slot, sift its entry up the heap and unblock the
+ * highest priority task waiting to receive.  The queue must not be full.
+ * Must be called from a critical section.  Returns pdTRUE if a task with a
+ * priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvInsertItem( xPRIORITY_QUEUE * const pxQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority );
+
+/*
+ * Copy out the item at the top of the heap, sift the last entry down in its
+ * place and unblock the highest priority task waiting to send.  The queue
+ * must not be empty.  Must be called from a critical section.  Returns pdTRUE
+ * if a task with a priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvRemoveItem( xPRIORITY_QUEUE * const pxQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority );
+
+/*
+ * Called by both xPriorityQueueCreate() and xPriorityQueueCreateStatic()
+ * once the memory for the queue has been obtained.
+ */
+static void prvInitialiseNewQueue( xPRIORITY_QUEUE * const pxQueue, xPriorityQueueEntry * const pxEntries, unsigned char * const pucItems, unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize );
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xPriorityQueueHandle xPriorityQueueCreate( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize )
+	{
+	xPRIORITY_QUEUE *pxQueue = NULL;
+	xPriorityQueueEntry *pxEntries;
+
+		configASSERT( uxLength > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0U );
+
+		if( uxLength > ( unsigned portBASE_TYPE ) 0U )
+		{
+			/* Allocate the structure, the heap and the item storage area in a
+			single block.  The heap follows the structure, which is at least
+			as strictly aligned as a heap entry. */
+			pxQueue = ( xPRIORITY_QUEUE * ) pvPortMalloc( sizeof( xPRIORITY_QUEUE ) + ( ( size_t ) uxLength * ( sizeof( xPriorityQueueEntry ) + ( size_t ) uxItemSize ) ) );
+		}
+
+		if( pxQueue != NULL )
+		{
+			pxEntries = ( xPriorityQueueEntry * ) ( ( ( unsigned char * ) pxQueue ) + sizeof( xPRIORITY_QUEUE ) );
+			prvInitialiseNewQueue( pxQueue, pxEntries, ( unsigned char * ) &( pxEntries[ uxLength ] ), uxLength, uxItemSize );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxQueue->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			tracePRIORITY_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_CREATE_FAILED();
+		}
+
+		return ( xPriorityQueueHandle ) pxQueue;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xPriorityQueueHandle xPriorityQueueCreateStatic( unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucItemStorageArea, xPriorityQueueEntry *pxEntryStorageArea, xStaticPriorityQueue *pxStaticQueue )
+	{
+	xPRIORITY_QUEUE *pxQueue = NULL;
+
+		configASSERT( uxLength > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( uxItemSize > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pucItemStorageArea );
+		configASSERT( pxEntryStorageArea );
+		configASSERT( pxStaticQueue );
+
+		/* The xStaticPriorityQueue structure must be the same size as the
+		queue structure it is used in place of. */
+		configASSERT( sizeof( xStaticPriorityQueue ) == sizeof( xPRIORITY_QUEUE ) );
+
+		if( ( uxLength > ( unsigned portBASE_TYPE ) 0U ) && ( pucItemStorageArea != NULL ) && ( pxEntryStorageArea != NULL ) && ( pxStaticQueue != NULL ) )
+		{
+			pxQueue = ( xPRIORITY_QUEUE * ) pxStaticQueue;
+			prvInitialiseNewQueue( pxQueue, pxEntryStorageArea, pucItemStorageArea, uxLength, uxItemSize );
+
+			/* The memory was supplied by the application so must not be freed
+			if the queue is deleted. */
+			pxQueue->ucStaticallyAllocated = pdTRUE;
+
+			tracePRIORITY_QUEUE_CREATE( pxQueue );
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_CREATE_FAILED();
+		}
+
+		return ( xPriorityQueueHandle ) pxQueue;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vPriorityQueueDelete( xPriorityQueueHandle xQueue )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE );
+
+	tracePRIORITY_QUEUE_DELETE( xQueue );
+
+	/* Memory supplied by the application to xPriorityQueueCreateStatic() is
+	not freed. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		vPortFree( pxQueue );
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+	}
+	#else
+	{
+		/* Just to remove compiler warning when configASSERT() is not
+		defined. */
+		( void ) pxQueue;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPriorityQueueSend( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, portTickType xTicksToWait )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency.
+
+	Like the alternative queue API, all the work is done from within a
+	critical section, including placing the calling task in the event list,
+	so items can be received from interrupts. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			{
+				tracePRIORITY_QUEUE_SEND( xQueue, uxPriority );
+				if( prvInsertItem( pxQueue, pvItem, uxPriority ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The queue is full and no block time is specified, so leave
+				now. */
+				taskEXIT_CRITICAL();
+				tracePRIORITY_QUEUE_SEND_FAILED( xQueue );
+				return errQUEUE_FULL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* The queue is full and a block time was specified, so
+				configure the timeout structure. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				taskEXIT_CRITICAL();
+				tracePRIORITY_QUEUE_SEND_FAILED( xQueue );
+				return errQUEUE_FULL;
+			}
+
+			traceBLOCKING_ON_PRIORITY_QUEUE_SEND( xQueue );
+			vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPriorityQueueSendFromISR( xPriorityQueueHandle xQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxQueue );
+	configASSERT( pvItem );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+		{
+			tracePRIORITY_QUEUE_SEND_FROM_ISR( xQueue, uxPriority );
+
+			/* Tasks only access the event lists from within a critical
+			section, so they can be accessed here directly.  If the scheduler
+			is suspended the unblocked task is placed in the pending ready
+			list. */
+			if( prvInsertItem( pxQueue, pvItem, uxPriority ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_SEND_FROM_ISR_FAILED( xQueue );
+			xReturn = errQUEUE_FULL;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPriorityQueueReceive( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, portTickType xTicksToWait )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	/* As for xPriorityQueueSend(). */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+			{
+				tracePRIORITY_QUEUE_RECEIVE( xQueue, pxQueue->pxEntries[ 0 ].uxPriority );
+				if( prvRemoveItem( pxQueue, pvBuffer, puxPriority ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The queue is empty and no block time is specified, so leave
+				now. */
+				taskEXIT_CRITICAL();
+				tracePRIORITY_QUEUE_RECEIVE_FAILED( xQueue );
+				return errQUEUE_EMPTY;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* The queue is empty and a block time was specified, so
+				configure the timeout structure. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				taskEXIT_CRITICAL();
+				tracePRIORITY_QUEUE_RECEIVE_FAILED( xQueue );
+				return errQUEUE_EMPTY;
+			}
+
+			traceBLOCKING_ON_PRIORITY_QUEUE_RECEIVE( xQueue );
+			vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPriorityQueueReceiveFromISR( xPriorityQueueHandle xQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+		{
+			tracePRIORITY_QUEUE_RECEIVE_FROM_ISR( xQueue, pxQueue->pxEntries[ 0 ].uxPriority );
+
+			if( prvRemoveItem( pxQueue, pvBuffer, puxPriority ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			tracePRIORITY_QUEUE_RECEIVE_FROM_ISR_FAILED( xQueue );
+			xReturn = errQUEUE_EMPTY;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPriorityQueuePeekPriority( xPriorityQueueHandle xQueue, unsigned portBASE_TYPE *puxPriority )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn = errQUEUE_EMPTY;
+
+	configASSERT( pxQueue );
+	configASSERT( puxPriority );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		/* The item to be received next is always at the top of the heap. */
+		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+		{
+			*puxPriority = pxQueue->pxEntries[ 0 ].uxPriority;
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPriorityQueueMessagesWaiting( xPriorityQueueHandle xQueue )
+{
+xPRIORITY_QUEUE * const pxQueue = ( xPRIORITY_QUEUE * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	return pxQueue->uxMessagesWaiting;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsBefore( const xPriorityQueueEntry * const pxEntry, const xPriorityQueueEntry * const pxOther )
+{
+portBASE_TYPE xReturn;
+
+	if( pxEntry->uxPriority != pxOther->uxPriority )
+	{
+		xReturn = ( pxEntry->uxPriority > pxOther->uxPriority ) ? pdTRUE : pdFALSE;
+	}
+	else
+	{
+		/* Equal priorities are received in the order they were sent.  The
+		difference is taken so the comparison still holds when the sequence
+		number wraps, as far fewer items than half its range are ever held. */
+		xReturn = ( ( signed long ) ( pxEntry->ulSequence - pxOther->ulSequence ) < 0L ) ? pdTRUE : pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvInsertItem( xPRIORITY_QUEUE * const pxQueue, const void *pvItem, unsigned portBASE_TYPE uxPriority )
+{
+xPriorityQueueEntry * const pxEntries = pxQueue->pxEntries;
+xPriorityQueueEntry xNewEntry;
+unsigned portBASE_TYPE uxIndex, uxParent;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	/* The entry just past the end of the heap names a free slot. */
+	uxIndex = pxQueue->uxMessagesWaiting;
+	xNewEntry = pxEntries[ uxIndex ];
+	memcpy( ( void * ) &( pxQueue->pucItems[ xNewEntry.uxSlot * pxQueue->uxItemSize ] ), pvItem, ( size_t ) pxQueue->uxItemSize );
+	xNewEntry.uxPriority = uxPriority;
+	xNewEntry.ulSequence = pxQueue->ulNextSequence;
+	( pxQueue->ulNextSequence )++;
+
+	/* Move the parents that are to be received after the new item down until
+	the new entry's place is found. */
+	while( uxIndex > ( unsigned portBASE_TYPE ) 0U )
+	{
+		uxParent = ( uxIndex - ( unsigned portBASE_TYPE ) 1U ) / ( unsigned portBASE_TYPE ) 2U;
+		if( prvIsBefore( &xNewEntry, &( pxEntries[ uxParent ] ) ) == pdFALSE )
+		{
+			break;
+		}
+
+		pxEntries[ uxIndex ] = pxEntries[ uxParent ];
+		uxIndex = uxParent;
+	}
+
+	pxEntries[ uxIndex ] = xNewEntry;
+	( pxQueue->uxMessagesWaiting )++;
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvRemoveItem( xPRIORITY_QUEUE * const pxQueue, void *pvBuffer, unsigned portBASE_TYPE *puxPriority )
+{
+xPriorityQueueEntry * const pxEntries = pxQueue->pxEntries;
+xPriorityQueueEntry xTopEntry, xLastEntry;
+unsigned portBASE_TYPE uxIndex, uxChild, uxCount;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	xTopEntry = pxEntries[ 0 ];
+	memcpy( pvBuffer, ( const void * ) &( pxQueue->pucItems[ xTopEntry.uxSlot * pxQueue->uxItemSize ] ), ( size_t ) pxQueue->uxItemSize );
+	if( puxPriority != NULL )
+	{
+		*puxPriority = xTopEntry.uxPriority;
+	}
+
+	( pxQueue->uxMessagesWaiting )--;
+	uxCount = pxQueue->uxMessagesWaiting;
+	xLastEntry = pxEntries[ uxCount ];
+
+	/* Sift the last entry down from the top, moving up the children that are
+	to be received before it. */
+	uxIndex = 0U;
+	for( ;; )
+	{
+		uxChild = ( uxIndex * ( unsigned portBASE_TYPE ) 2U ) + ( unsigned portBASE_TYPE ) 1U;
+		if( uxChild >= uxCount )
+		{
+			break;
+		}
+
+		if( ( ( uxChild + ( unsigned portBASE_TYPE ) 1U ) < uxCount ) && ( prvIsBefore( &( pxEntries[ uxChild + 1U ] ), &( pxEntries[ uxChild ] ) ) != pdFALSE ) )
+		{
+			uxChild++;
+		}
+
+		if( prvIsBefore( &( pxEntries[ uxChild ] ), &xLastEntry ) == pdFALSE )
+		{
+			break;
+		}
+
+		pxEntries[ uxIndex ] = pxEntries[ uxChild ];
+		uxIndex = uxChild;
+	}
+
+	pxEntries[ uxIndex ] = xLastEntry;
+
+	/* The slot that held the received item is now free, so its entry is
+	parked just past the end of the heap. */
+	pxEntries[ uxCount ] = xTopEntry;
+
+	if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewQueue( xPRIORITY_QUEUE * const pxQueue, xPriorityQueueEntry * const pxEntries, unsigned char * const pucItems, unsigned portBASE_TYPE uxLength, unsigned portBASE_TYPE uxItemSize )
+{
+unsigned portBASE_TYPE uxSlot;
+
+	pxQueue->ulNextSequence = 0UL;
+	pxQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+	pxQueue->uxLength = uxLength;
+	pxQueue->uxItemSize = uxItemSize;
+	pxQueue->pxEntries = pxEntries;
+	pxQueue->pucItems = pucItems;
+	vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
+	vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+	/* The heap is empty, so every entry names a free slot. */
+	for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < uxLength; uxSlot++ )
+	{
+		pxEntries[ uxSlot ].uxSlot = uxSlot;
+		pxEntries[ uxSlot ].uxPriority = ( unsigned portBASE_TYPE ) 0U;
+		pxEntries[ uxSlot ].ulSequence = 0UL;
+	}
+}
@@ -0,0 +1,305 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include the profiler.  This #if is closed at the very bottom of this file.
+If you want to include the profiler then ensure configUSE_PROFILER is set to 1
+in FreeRTOSConfig.h. */
+#if ( configUSE_PROFILER == 1 )
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) || ( INCLUDE_pcTaskGetTaskName != 1 )
+	#error INCLUDE_xTaskGetCurrentTaskHandle and INCLUDE_pcTaskGetTaskName must be set to 1 in FreeRTOSConfig.h to use the profiler.
+#endif
+
+/* The count at which a bucket is full. */
+#define profBUCKET_FULL		( ( unsigned short ) 0xffffU )
+
+/* The histogram.  The header is initialised statically so an image read from
+the target is decodable even if the scheduler was never started. */
+PRIVILEGED_DATA xProfilerData xProfiler =
+{
+	{ 'F', 'R', 'P', 'F' },
+	( unsigned char ) profPROFILER_VERSION,
+	( unsigned char ) sizeof( unsigned long ),
+	( unsigned char ) sizeof( portPOINTER_SIZE_TYPE ),
+	( unsigned char ) configPROFILER_BUCKET_SHIFT,
+	0x01020304UL,
+	( unsigned long ) ( configPROFILER_LOW_ADDRESS ),
+	( unsigned long ) ( configPROFILER_HIGH_ADDRESS ),
+	( unsigned long ) offsetof( xProfilerData, xTasks ),
+	( unsigned long ) configPROFILER_TASK_TABLE_LENGTH,
+	( unsigned long ) sizeof( xProfilerTask ),
+	( unsigned long ) configMAX_TASK_NAME_LEN,
+	( unsigned long ) offsetof( xProfilerData, usBuckets ),
+	( unsigned long ) profBUCKET_COUNT,
+	0UL,
+	0UL,
+	0UL,
+	0UL,
+	( unsigned long ) pdTRUE,
+	{ { 0, 0UL, { 0 } } },
+	{ 0 }
+};
+
+/* The task table entry used by the last sample.  The same task is usually
+running for many samples in a row, so this saves searching the table. */
+PRIVILEGED_DATA static unsigned long ulLastTask = 0UL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the task table entry for uxTask, claiming a free entry if the task
+ * does not have one yet.  Returns NULL if the table is full.
+ */
+static xProfilerTask *prvGetTaskEntry( portPOINTER_SIZE_TYPE uxTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static xProfilerTask *prvGetTaskEntry( portPOINTER_SIZE_TYPE uxTask )
+{
+xProfilerTask *pxEntry;
+unsigned long ulIndex;
+
+	if( xProfiler.xTasks[ ulLastTask ].uxTask == uxTask )
+	{
+		return &( xProfiler.xTasks[ ulLastTask ] );
+	}
+
+	/* Entries are claimed in order and only released all together, so the
+	first unused entry ends the search. */
+	for( ulIndex = 0UL; ulIndex < ( unsigned long ) configPROFILER_TASK_TABLE_LENGTH; ulIndex++ )
+	{
+		pxEntry = &( xProfiler.xTasks[ ulIndex ] );
+
+		if( pxEntry->uxTask == uxTask )
+		{
+			ulLastTask = ulIndex;
+			return pxEntry;
+		}
+
+		if( pxEntry->uxTask == ( portPOINTER_SIZE_TYPE ) 0 )
+		{
+			strncpy( ( char * ) pxEntry->pcName, ( const char * ) pcTaskGetTaskName( ( xTaskHandle ) uxTask ), ( size_t ) configMAX_TASK_NAME_LEN );
+			pxEntry->pcName[ configMAX_TASK_NAME_LEN - 1 ] = ( signed char ) '\0';
+			pxEntry->ulSamples = 0UL;
+			pxEntry->uxTask = uxTask;
+
+			ulLastTask = ulIndex;
+			return pxEntry;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vProfilerSampleFromISR( unsigned long ulPC )
+{
+portPOINTER_SIZE_TYPE uxTask;
+xProfilerTask *pxEntry = NULL;
+unsigned long ulBucket;
+
+	if( xProfiler.ulRunning != ( unsigned long ) pdFALSE )
+	{
+		xProfiler.ulSamples++;
+
+		/* There is no running task before the scheduler has started. */
+		uxTask = ( portPOINTER_SIZE_TYPE ) xTaskGetCurrentTaskHandle();
+		if( uxTask != ( portPOINTER_SIZE_TYPE ) 0 )
+		{
+			pxEntry = prvGetTaskEntry( uxTask );
+		}
+
+		if( pxEntry != NULL )
+		{
+			pxEntry->ulSamples++;
+		}
+		else
+		{
+			xProfiler.ulTasksNotRecorded++;
+		}
+
+		if( ( xProfiler.ulFilterTask == 0UL ) || ( pxEntry == &( xProfiler.xTasks[ xProfiler.ulFilterTask - 1UL ] ) ) )
+		{
+			/* The subtraction wraps for addresses below the range, so one
+			compare covers both ends. */
+			ulPC -= ( unsigned long ) ( configPROFILER_LOW_ADDRESS );
+			if( ulPC < ( ( unsigned long ) ( configPROFILER_HIGH_ADDRESS ) - ( unsigned long ) ( configPROFILER_LOW_ADDRESS ) ) )
+			{
+				/* A full bucket is never incremented, in case sampling was
+				restarted without the histogram being reset. */
+				ulBucket = ulPC >> configPROFILER_BUCKET_SHIFT;
+				if( xProfiler.usBuckets[ ulBucket ] != profBUCKET_FULL )
+				{
+					xProfiler.usBuckets[ ulBucket ]++;
+				}
+
+				if( xProfiler.usBuckets[ ulBucket ] == profBUCKET_FULL )
+				{
+					xProfiler.ulRunning = ( unsigned long ) pdFALSE;
+				}
+			}
+			else
+			{
+				xProfiler.ulOutOfRange++;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vProfilerStart( void )
+{
+	xProfiler.ulRunning = ( unsigned long ) pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vProfilerStop( void )
+{
+	xProfiler.ulRunning = ( unsigned long ) pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vProfilerReset( void )
+{
+unsigned long ulIndex;
+
+	/* Samples can be taken from an interrupt that is never masked, so
+	sampling is stopped rather than interrupts disabled while the counts are
+	cleared.  Once ulRunning is clear an interrupt that starts to take a sample
+	does nothing. */
+	xProfiler.ulRunning = ( unsigned long ) pdFALSE;
+	portMEMORY_BARRIER();
+
+	for( ulIndex = 0UL; ulIndex < ( unsigned long ) profBUCKET_COUNT; ulIndex++ )
+	{
+		xProfiler.usBuckets[ ulIndex ] = 0U;
+	}
+
+	memset( ( void * ) xProfiler.xTasks, 0x00, sizeof( xProfiler.xTasks ) );
+	ulLastTask = 0UL;
+
+	xProfiler.ulSamples = 0UL;
+	xProfiler.ulOutOfRange = 0UL;
+	xProfiler.ulTasksNotRecorded = 0UL;
+	xProfiler.ulFilterTask = 0UL;
+
+	portMEMORY_BARRIER();
+	xProfiler.ulRunning = ( unsigned long ) pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xProfilerSetTaskFilter( void *pvTask )
+{
+xProfilerTask *pxEntry;
+unsigned long ulRunning;
+portBASE_TYPE xReturn = pdPASS;
+
+	if( pvTask == NULL )
+	{
+		xProfiler.ulFilterTask = 0UL;
+	}
+	else
+	{
+		/* The task table is only otherwise written by the sampling interrupt,
+		so sampling is stopped while the entry is found or claimed. */
+		ulRunning = xProfiler.ulRunning;
+		xProfiler.ulRunning = ( unsigned long ) pdFALSE;
+		portMEMORY_BARRIER();
+
+		pxEntry = prvGetTaskEntry( ( portPOINTER_SIZE_TYPE ) pvTask );
+		if( pxEntry != NULL )
+		{
+			xProfiler.ulFilterTask = ( unsigned long ) ( pxEntry - &( xProfiler.xTasks[ 0 ] ) ) + 1UL;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		portMEMORY_BARRIER();
+		xProfiler.ulRunning = ulRunning;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+const void *pvProfilerGetData( size_t *pxSize )
+{
+	if( pxSize != NULL )
+	{
+		*pxSize = sizeof( xProfiler );
+	}
+
+	return ( const void * ) &xProfiler;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the profiler.  If you want to include the profiler then ensure
+configUSE_PROFILER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_PROFILER == 1 */
@@ -66,6 +66,10 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if ( configUSE_NAME_REGISTRY == 1 )
+	#include "name_registry.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /*-----------------------------------------------------------
@@ -81,6 +85,7 @@ task.h is included from an application file. */
 /* For internal use only. */
 #define	queueSEND_TO_BACK				( 0 )
 #define	queueSEND_TO_FRONT				( 1 )
+#define	queueOVERWRITE					( 2 )
 
 /* Effectively make a union out of the xQUEUE structure. */
 #define pxMutexHolder					pcTail
@@ -88,6 +93,14 @@ task.h is included from an application file. */
 #define uxRecursiveCallCount			pcReadFrom
 #define queueQUEUE_IS_MUTEX				NULL
 
+/* The recursive call count is held in a pointer, so is counted as an integer.
+If the pointer itself were incremented and decremented the compiler could
+assume the result is never NULL, and remove the test for the count reaching
+zero. */
+#define queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex )	( pxMutex )->uxRecursiveCallCount = ( signed char * ) ( ( portPOINTER_SIZE_TYPE ) ( pxMutex )->uxRecursiveCallCount + ( portPOINTER_SIZE_TYPE ) 1 )
+#define queueDECREMENT_RECURSIVE_CALL_COUNT( pxMutex )	( pxMutex )->uxRecursiveCallCount = ( signed char * ) ( ( portPOINTER_SIZE_TYPE ) ( pxMutex )->uxRecursiveCallCount - ( portPOINTER_SIZE_TYPE ) 1 )
+#define queueRECURSIVE_CALL_COUNT_IS_ZERO( pxMutex )	( ( portPOINTER_SIZE_TYPE ) ( pxMutex )->uxRecursiveCallCount == ( portPOINTER_SIZE_TYPE ) 0 )
+
 /* Semaphores do not actually store or copy data, so have an items size of
 zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( unsigned portBASE_TYPE ) 0 )
@@ -100,6 +113,35 @@ zero. */
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( 4U )
+#define queueQUEUE_TYPE_SET					( 0U )
+
+/*
+ * The lists of tasks waiting to send to and receive from a queue.  With
+ * configUSE_PRIORITY_EVENT_LISTS set to 1 each is held as a FIFO list per
+ * priority, so blocking on and unblocking from the list take the same time
+ * however many tasks are waiting.  Otherwise each is a single list sorted by
+ * priority.  The empty test and the remove macros must only be used on lists
+ * of tasks.
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+	#define queueEVENT_LIST_TYPE										xPriorityList
+	#define queueINITIALISE_EVENT_LIST( pxList )						vListInitialisePriorityList( pxList )
+	#define queueEVENT_LIST_IS_EMPTY( pxList )							( pxListGetHighestPriorityBucket( ( xPriorityList * ) ( pxList ) ) == NULL )
+	#define queueREMOVE_FROM_EVENT_LIST( pxList )						xTaskRemoveFromEventList( pxListGetHighestPriorityBucket( ( xPriorityList * ) ( pxList ) ) )
+	#define queuePLACE_ON_EVENT_LIST( pxList, xTicksToWait )			vTaskPlaceOnPriorityEventList( ( pxList ), ( xTicksToWait ) )
+	#define queuePLACE_ON_EVENT_LIST_RESTRICTED( pxList, xTicksToWait )	vTaskPlaceOnPriorityEventListRestricted( ( pxList ), ( xTicksToWait ) )
+
+#else
+
+	#define queueEVENT_LIST_TYPE										xList
+	#define queueINITIALISE_EVENT_LIST( pxList )						vListInitialise( pxList )
+	#define queueEVENT_LIST_IS_EMPTY( pxList )							listLIST_IS_EMPTY( pxList )
+	#define queueREMOVE_FROM_EVENT_LIST( pxList )						xTaskRemoveFromEventList( pxList )
+	#define queuePLACE_ON_EVENT_LIST( pxList, xTicksToWait )			vTaskPlaceOnEventList( ( pxList ), ( xTicksToWait ) )
+	#define queuePLACE_ON_EVENT_LIST_RESTRICTED( pxList, xTicksToWait )	vTaskPlaceOnEventListRestricted( ( pxList ), ( xTicksToWait ) )
+
+#endif
 
 /*
  * Definition of the queue used by the scheduler.
@@ -113,8 +155,8 @@ typedef struct QueueDefinition
 	signed char *pcWriteTo;				/*< Points to the free next place in the storage area. */
 	signed char *pcReadFrom;			/*< Points to the last place that a queued item was read from. */
 
-	xList xTasksWaitingToSend;				/*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
-	xList xTasksWaitingToReceive;			/*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
+	queueEVENT_LIST_TYPE xTasksWaitingToSend;		/*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
+	queueEVENT_LIST_TYPE xTasksWaitingToReceive;	/*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
 	volatile unsigned portBASE_TYPE uxMessagesWaiting;/*< The number of items currently in the queue. */
 	unsigned portBASE_TYPE uxLength;		/*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
@@ -128,7 +170,48 @@ typedef struct QueueDefinition
 		unsigned char ucQueueType;
 	#endif
 
+	#if ( configUSE_QUEUE_SETS == 1 )
+		struct QueueDefinition *pxQueueSetContainer;	/*< The queue set this queue or semaphore is a member of, if any. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the queue structure and storage area were supplied by the application, so must not be freed when the queue is deleted. */
+	#endif
+
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		signed char *pcReservedSlot;		/*< The slot handed out by pvQueueReserveSlot() that has not yet been committed, or NULL. */
+		signed char *pcBorrowedSlot;		/*< The slot handed out by pvQueueBorrowSlot() that has not yet been released, or NULL. */
+	#endif
+
+	#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		xList xCoRoutinesWaitingToSend;		/*< List of co-routines that are blocked waiting to post onto this queue, kept apart from the tasks as the two are unblocked differently. */
+		xList xCoRoutinesWaitingToReceive;	/*< List of co-routines that are blocked waiting to read from this queue. */
+	#endif
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned long ulSendCount;			/*< The number of items that have been sent to the queue. */
+		unsigned long ulReceiveCount;		/*< The number of items that have been received from the queue, not counting peeks. */
+		unsigned long ulSendFailCount;		/*< The number of sends that failed because the queue remained full. */
+		unsigned portBASE_TYPE uxPeakMessagesWaiting;	/*< The largest number of items the queue has held at once. */
+	#endif
+
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		void *pvLastMutexHolder;						/*< The task that most recently took the mutex. */
+		portRUN_TIME_COUNTER_TYPE ulMutexTakenTime;	/*< The run time counter value when the mutex was last taken. */
+		portRUN_TIME_COUNTER_TYPE ulTotalMutexWait;
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexWait;
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexHold;
+		unsigned long ulMutexTakeCount;
+		unsigned long ulMutexContendedCount;
+		unsigned long ulMutexWaitHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+		unsigned long ulMutexHoldHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+	#endif
+
 } xQUEUE;
+
+/* The size of the queue structure rounded up so the storage area that follows
+it in the same block is aligned, as it would be if allocated separately. */
+#define queueSTRUCT_SIZE	( ( sizeof( xQUEUE ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
 /*-----------------------------------------------------------*/
 
 /*
@@ -138,22 +221,69 @@ typedef struct QueueDefinition
  */
 typedef xQUEUE * xQueueHandle;
 
+/* The statistics reported for a queue.  This definition *must* match that in
+queue.h, other than the type of xHandle. */
+typedef struct xQUEUE_STATUS
+{
+	xQueueHandle xHandle;
+	const signed char *pcQueueName;
+	unsigned char ucQueueNumber;
+	unsigned char ucQueueType;
+	unsigned portBASE_TYPE uxLength;
+	unsigned portBASE_TYPE uxMessagesWaiting;
+	unsigned portBASE_TYPE uxPeakMessagesWaiting;
+	unsigned long ulSendCount;
+	unsigned long ulReceiveCount;
+	unsigned long ulSendFailCount;
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		void *pvLastMutexHolder;
+		unsigned long ulMutexTakeCount;
+		unsigned long ulMutexContendedCount;
+		portRUN_TIME_COUNTER_TYPE ulTotalMutexWait;
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexWait;
+		portRUN_TIME_COUNTER_TYPE ulMaxMutexHold;
+		unsigned long ulMutexWaitHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+		unsigned long ulMutexHoldHistogram[ configMUTEX_CONTENTION_BUCKETS ];
+	#endif
+} xQueueStatusType;
+
 /*
  * Prototypes for public functions are included here so we don't have to
  * include the API header file (as it defines xQueueHandle differently).  These
  * functions are documented in the API header file.
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
-signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueGenericSend( xQueueHandle xQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueSpacesAvailable( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 void vQueueDelete( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
-signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
-signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION;
-signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+signed portBASE_TYPE xQueueGenericSendUntil( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xWakeTime, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueGenericReceiveUntil( xQueueHandle pxQueue, void * const pvBuffer, portTickType xWakeTime, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueReceiveFromISR( xQueueHandle pxQueue, void * const pvBuffer, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+signed portBASE_TYPE xQueuePeekFromISR( xQueueHandle pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken ) PRIVILEGED_FUNCTION;
+void *pvQueueReserveSlot( xQueueHandle pxQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+void vQueueCommitSlot( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+void *pvQueueBorrowSlot( xQueueHandle pxQueue, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+void vQueueReleaseSlot( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+void vQueueCacheFlush( void ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueTakeMutexRecursive( xQueueHandle xMutex, portTickType xBlockTime ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueTakeMutexRecursiveUntil( xQueueHandle xMutex, portTickType xWakeTime ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle xMutex ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSemaphoreGiveMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSemaphoreGiveMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSemaphoreTakeMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+signed portBASE_TYPE xQueueSemaphoreTakeMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueAltGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueAltGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking ) PRIVILEGED_FUNCTION;
 signed portBASE_TYPE xQueueIsQueueEmptyFromISR( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
@@ -165,6 +295,11 @@ void vQueueSetQueueNumber( xQueueHandle pxQueue, unsigned char ucQueueNumber ) P
 unsigned char ucQueueGetQueueType( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
 portBASE_TYPE xQueueGenericReset( xQueueHandle pxQueue, portBASE_TYPE xNewQueue ) PRIVILEGED_FUNCTION;
 xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xBlockTimeTicks ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet ) PRIVILEGED_FUNCTION;
 
 /*
  * Co-routine queue functions differ from task queue functions.  Co-routines are
@@ -196,13 +331,23 @@ xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
 	The pcQueueName member of a structure being NULL is indicative of the
 	array position being vacant. */
 	xQueueRegistryItem xQueueRegistry[ configQUEUE_REGISTRY_SIZE ];
+#endif
 
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_NAME_REGISTRY == 1 )
 	/* Removes a queue from the registry by simply setting the pcQueueName
 	member to NULL. */
 	static void vQueueUnregisterQueue( xQueueHandle xQueue ) PRIVILEGED_FUNCTION;
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcQueueName ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+	void vQueueGetInfo( xQueueHandle pxQueue, xQueueStatusType *pxQueueStatus ) PRIVILEGED_FUNCTION;
+
+		#if ( configQUEUE_REGISTRY_SIZE > 0 )
+			unsigned portBASE_TYPE uxQueueGetSystemState( xQueueStatusType *pxQueueStatusArray, unsigned portBASE_TYPE uxArraySize ) PRIVILEGED_FUNCTION;
+		#endif
+#endif
+
 /*
  * Unlocks a queue locked by a call to prvLockQueue.  Locking a queue does not
  * prevent an ISR from adding or removing items to the queue, but does prevent
@@ -211,32 +356,282 @@ xTaskHandle xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
  * to indicate that a task may require unblocking.  When the queue in unlocked
  * these lock counts are inspected, and the appropriate action taken.
  */
-static void prvUnlockQueue( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+static void prvUnlockQueue( xQueueHandle pxQueue ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * The implementation of xQueueGenericSend() and xQueueGenericReceive().  If
+ * pxTimeOut is not NULL the wait is one until an absolute tick count, and
+ * pxTimeOut holds the time status that xTicksToWait was calculated from by
+ * vTaskSetTimeOutStateUntil().  Otherwise the timeout is captured when the
+ * task first has to block, as usual.
+ */
+static signed portBASE_TYPE prvQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition, const xTimeOutType * const pxTimeOut ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+static signed portBASE_TYPE prvQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking, const xTimeOutType * const pxTimeOut ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
  * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
  */
-static signed portBASE_TYPE prvIsQueueEmpty( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvIsQueueEmpty( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Uses a critical section to determine if there is any space in a queue.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static signed portBASE_TYPE prvIsQueueFull( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvIsQueueFull( const xQueueHandle pxQueue ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
  */
-static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition ) PRIVILEGED_FUNCTION;
+static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
 
 /*
  * Copies an item out of a queue.
  */
-static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer ) PRIVILEGED_FUNCTION;
+static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * Copies a single item of uxItemSize bytes.  Byte sized items, and word sized
+ * items that are word aligned at both ends - which covers pointers, handles
+ * and most scalar types - are copied directly rather than by calling
+ * portQUEUE_COPY(), as the call costs more than the copy itself.
+ */
+static void prvCopyItem( void *pvDestination, const void *pvSource, unsigned portBASE_TYPE uxItemSize ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * Copy uxCount items to the back of, or from the front of, a queue.  The
+ * caller must already have checked that there is space for, or that the queue
+ * holds, uxCount items, and uxCount must not be zero.  At most two
+ * portQUEUE_COPY() calls are made, one each side of the point at which the storage area wraps.
+ */
+static void prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from within a critical section after uxCount items have been added
+ * to (prvUnblockReceivers()) or removed from (prvUnblockSenders()) a queue
+ * that is not locked.  Removes up to one waiting task per item from the
+ * relevant event list.  Returns pdTRUE if a task with a priority higher than
+ * the calling task was unblocked.
+ */
+static portBASE_TYPE prvUnblockReceivers( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+static portBASE_TYPE prvUnblockSenders( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+	/*
+	 * Called from within a critical section when a task leaves
+	 * xQueueSemaphoreTakeMultiple() with units still available.  A task
+	 * waiting for more units than are available does not take the units that
+	 * woke it, so they are passed on to the tasks queued behind it, one task
+	 * per unit.  Returns pdTRUE if a task with a priority higher than the
+	 * calling task was unblocked.
+	 */
+	static portBASE_TYPE prvPassOnSemaphoreUnits( xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Used by the task and interrupt API to test for, and unblock, whatever is
+ * waiting to receive from (or send to) a queue.  The wake functions must only
+ * be called after the matching test has returned pdTRUE, and return pdTRUE if
+ * the context switch they caused should be requested by the caller.
+ */
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+
+	#define queueHAS_WAITING_RECEIVERS( pxQueue )	( ( queueEVENT_LIST_IS_EMPTY( &( ( pxQueue )->xTasksWaitingToReceive ) ) == pdFALSE ) || ( listLIST_IS_EMPTY( &( ( pxQueue )->xCoRoutinesWaitingToReceive ) ) == pdFALSE ) )
+	#define queueHAS_WAITING_SENDERS( pxQueue )		( ( queueEVENT_LIST_IS_EMPTY( &( ( pxQueue )->xTasksWaitingToSend ) ) == pdFALSE ) || ( listLIST_IS_EMPTY( &( ( pxQueue )->xCoRoutinesWaitingToSend ) ) == pdFALSE ) )
+
+	/*
+	 * Waiting tasks are unblocked in preference to waiting co-routines.  A
+	 * co-routine is moved to the pending ready list, exactly as when it is
+	 * unblocked from an interrupt.
+	 */
+	static signed portBASE_TYPE prvWakeReceiver( const xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+	static signed portBASE_TYPE prvWakeSender( const xQUEUE * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the co-routine interrupt API to unblock a task waiting on
+	 * pxEventList.  If a task has the queue locked the event is counted in
+	 * pxLock and the unblocking left to prvUnlockQueue(), as with the task
+	 * interrupt API.  The co-routine API
+	 * cannot return a context switch request, so the task runs when the
+	 * interrupt is next followed by a context switch.
+	 */
+	static void prvWakeTaskFromCoRoutineISR( const xList * const pxEventList, signed portBASE_TYPE * const pxLock ) PRIVILEGED_FUNCTION;
+
+	/* The lists co-routines block on. */
+	#define queueCO_ROUTINES_WAITING_TO_SEND( pxQueue )		( &( ( pxQueue )->xCoRoutinesWaitingToSend ) )
+	#define queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue )	( &( ( pxQueue )->xCoRoutinesWaitingToReceive ) )
+
+#else
+
+	#define queueHAS_WAITING_RECEIVERS( pxQueue )	( queueEVENT_LIST_IS_EMPTY( &( ( pxQueue )->xTasksWaitingToReceive ) ) == pdFALSE )
+	#define queueHAS_WAITING_SENDERS( pxQueue )		( queueEVENT_LIST_IS_EMPTY( &( ( pxQueue )->xTasksWaitingToSend ) ) == pdFALSE )
+	#define prvWakeReceiver( pxQueue )				queueREMOVE_FROM_EVENT_LIST( &( ( pxQueue )->xTasksWaitingToReceive ) )
+	#define prvWakeSender( pxQueue )				queueREMOVE_FROM_EVENT_LIST( &( ( pxQueue )->xTasksWaitingToSend ) )
+
+	/* Co-routines share the task event lists, and only wake each other. */
+	#define queueCO_ROUTINES_WAITING_TO_SEND( pxQueue )		( &( ( pxQueue )->xTasksWaitingToSend ) )
+	#define queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue )	( &( ( pxQueue )->xTasksWaitingToReceive ) )
+
+#endif
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	/*
+	 * Returns pdTRUE if a slot can be reserved (xForWriting is pdTRUE) or
+	 * borrowed (xForWriting is pdFALSE) now.  Only one slot of each kind can
+	 * be outstanding at a time, and a borrowed slot still occupies space in
+	 * the queue.  Must be called from a critical section.
+	 */
+	static portBASE_TYPE prvIsSlotAvailable( const xQUEUE * const pxQueue, portBASE_TYPE xForWriting ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The blocking part of pvQueueReserveSlot() and pvQueueBorrowSlot().
+	 */
+	static void *prvAcquireSlot( xQUEUE * const pxQueue, portBASE_TYPE xForWriting, portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called by the dynamic and static queue creation functions once the memory
+ * for the queue structure and storage area has been obtained.
+ */
+static void prvInitialiseNewQueue( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType, xQUEUE *pxNewQueue ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+
+	/* The size of the storage areas held by the smallest size class of the
+	cache.  Each class holds storage areas twice the size of those held by the
+	class before it. */
+	#define queueCACHE_SMALLEST_STORAGE		( ( size_t ) 16 )
+	#define queueCACHE_CLASS_STORAGE( uxClass )	( queueCACHE_SMALLEST_STORAGE << ( uxClass ) )
+
+	/* The class holding mutexes, which have no storage area, and the value
+	used for storage areas too large to be held by any class. */
+	#define queueCACHE_NO_STORAGE			( ( unsigned portBASE_TYPE ) configQUEUE_CACHE_CLASSES )
+	#define queueCACHE_NOT_CACHED			( ( unsigned portBASE_TYPE ) configQUEUE_CACHE_CLASSES + 1U )
+
+	/* Deleted queues whose structure and storage area are kept for reuse, one
+	list for each size class plus one for mutexes.  A cached queue is not
+	otherwise in use, so the lists are linked through the pcWriteTo member of
+	the cached queues. */
+	static xQUEUE *pxQueueCache[ configQUEUE_CACHE_CLASSES + 1 ] = { NULL };
+	static unsigned portBASE_TYPE uxQueueCacheCount[ configQUEUE_CACHE_CLASSES + 1 ] = { 0U };
+
+	/*
+	 * Returns the size class of a storage area of xStorageSize bytes, or
+	 * queueCACHE_NOT_CACHED if the storage area is too large to be cached.
+	 */
+	static unsigned portBASE_TYPE prvQueueCacheClass( size_t xStorageSize ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Removes a queue from the uxClass list of the cache, returning NULL if the
+	 * list is empty.  The queue still points to its storage area.
+	 */
+	static xQUEUE *prvQueueCacheTake( unsigned portBASE_TYPE uxClass ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Adds a deleted queue to the cache.  Returns pdFAIL without caching the
+	 * queue if its storage area is too large or its list is already holding
+	 * configQUEUE_CACHE_DEPTH queues, in which case the caller frees it.
+	 */
+	static portBASE_TYPE prvQueueCachePut( xQUEUE *pxQueue ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MUTEXES == 1 )
+	/*
+	 * Called by the dynamic and static mutex creation functions once the
+	 * memory for the queue structure has been obtained.
+	 */
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The mutex paths of xQueueGenericReceive() and xQueueGenericSend().
+	 * prvTakeMutex() obtains the mutex if it is free and returns pdPASS, or
+	 * returns pdFAIL without blocking if it is not, in which case the caller
+	 * falls back to the generic blocking code.  prvGiveMutex() returns the
+	 * mutex, and only touches the event list if a task is waiting for it.
+	 * Neither copies data or checks xTasksWaitingToSend, as a task can never
+	 * block giving a mutex.
+	 */
+	static portBASE_TYPE prvTakeMutex( xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+	static signed portBASE_TYPE prvGiveMutex( xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from within a critical section by a task that is about to block
+	 * on a mutex.  Raises the priority of the mutex holder to that of the
+	 * calling task and, if the holder is itself blocked on a mutex, the
+	 * priority of that mutex's holder, and so on along the chain.  Returns
+	 * pdTRUE if any priority was raised.
+	 */
+	static portBASE_TYPE prvInheritPriority( xQUEUE *pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called from within a critical section by a task that caused priority
+	 * inheritance but stopped waiting for the mutex because its block time
+	 * expired.  Lowers the priority of the mutex holder to that of the highest
+	 * priority task still waiting, and passes the change along the chain of
+	 * holders in the same way as prvInheritPriority().
+	 */
+	static void prvDisinheritPriorityAfterTimeout( xQUEUE *pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the priority of the highest priority task waiting for a mutex,
+	 * or tskIDLE_PRIORITY if there are none.
+	 */
+	static unsigned portBASE_TYPE prvGetDisinheritPriorityAfterTimeout( const xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configRECORD_MUTEX_CONTENTION == 1 )
+	/*
+	 * Maintain the contention statistics reported by vQueueGetInfo() for a
+	 * mutex, from within a critical section.  prvRecordMutexTaken() is called
+	 * once pxMutexHolder has been set to the task taking the mutex, and
+	 * prvRecordMutexGiven() before pxMutexHolder is cleared.  A take that
+	 * found the mutex held and then blocked calls prvRecordMutexWait() when it
+	 * stops waiting, whether or not it got the mutex, passing the time at
+	 * which it started waiting.
+	 */
+	static void prvRecordMutexTaken( xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+	static void prvRecordMutexGiven( xQUEUE * const pxMutex ) PRIVILEGED_FUNCTION;
+	static void prvRecordMutexWait( xQUEUE * const pxMutex, portRUN_TIME_COUNTER_TYPE ulWaitStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Adds ulTime to the histogram pulHistogram, which has
+	 * configMUTEX_CONTENTION_BUCKETS buckets.
+	 */
+	static void prvAddToMutexHistogram( unsigned long *pulHistogram, portRUN_TIME_COUNTER_TYPE ulTime ) PRIVILEGED_FUNCTION;
+
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define queueGET_MUTEX_TIME( ulTime )	portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+	#else
+		#define queueGET_MUTEX_TIME( ulTime )	( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+
+	#define prvRecordMutexContended( pxMutex )	( ( pxMutex )->ulMutexContendedCount )++
+
+#else
+
+	#define prvRecordMutexTaken( pxMutex )
+	#define prvRecordMutexGiven( pxMutex )
+	#define prvRecordMutexContended( pxMutex )
+
+#endif
+
+#if ( configUSE_QUEUE_SETS == 1 )
+	/*
+	 * Checks to see if a queue is a member of a queue set, and if so, notifies
+	 * the queue set that the queue contains data.  Must be called from within
+	 * the critical section (or interrupt mask) already held by the caller
+	 * that wrote to the queue.
+	 *
+	 * @return pdTRUE if posting to the queue set unblocked a task that has a
+	 * priority above the task that performed the send, otherwise pdFALSE.
+	 */
+	static portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -258,6 +653,34 @@ static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer )
 	taskEXIT_CRITICAL()
 /*-----------------------------------------------------------*/
 
+/*
+ * Macros that maintain the statistics reported by vQueueGetInfo().  They must
+ * be called with the queue's critical section (or interrupt mask) held, the
+ * send macro after uxMessagesWaiting has been updated.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	#define prvRecordItemsSent( pxQueue, uxCount )										\
+	{																					\
+		( pxQueue )->ulSendCount += ( unsigned long ) ( uxCount );						\
+		if( ( pxQueue )->uxMessagesWaiting > ( pxQueue )->uxPeakMessagesWaiting )		\
+		{																				\
+			( pxQueue )->uxPeakMessagesWaiting = ( pxQueue )->uxMessagesWaiting;		\
+		}																				\
+	}
+
+	#define prvRecordItemsReceived( pxQueue, uxCount )	( pxQueue )->ulReceiveCount += ( unsigned long ) ( uxCount )
+	#define prvRecordSendFailed( pxQueue )				( ( pxQueue )->ulSendFailCount )++
+
+#else
+
+	#define prvRecordItemsSent( pxQueue, uxCount )
+	#define prvRecordItemsReceived( pxQueue, uxCount )
+	#define prvRecordSendFailed( pxQueue )
+
+#endif
+/*-----------------------------------------------------------*/
+
 
 /*-----------------------------------------------------------
  * PUBLIC QUEUE MANAGEMENT API documented in queue.h
@@ -273,12 +696,12 @@ portBASE_TYPE xReturn = pdPASS;
 	created), then only reset the queue if its event lists are empty. */
 	if( xNewQueue != pdTRUE )
 	{
-		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+		if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
 		{
 			xReturn = pdFAIL;
 		}
 
-		if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+		if( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE )
 		{
 			xReturn = pdFAIL;
 		}
@@ -293,122 +716,350 @@ portBASE_TYPE xReturn = pdPASS;
 		pxQueue->xRxLock = queueUNLOCKED;
 		pxQueue->xTxLock = queueUNLOCKED;
 
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		{
+			/* Any slots that were reserved or borrowed are discarded. */
+			pxQueue->pcReservedSlot = NULL;
+			pxQueue->pcBorrowedSlot = NULL;
+		}
+		#endif
+
 		/* Ensure the event queues start with the correct state. */
-		vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
-		vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+		queueINITIALISE_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) );
+		queueINITIALISE_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) );
+
+		#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		{
+			vListInitialise( &( pxQueue->xCoRoutinesWaitingToSend ) );
+			vListInitialise( &( pxQueue->xCoRoutinesWaitingToReceive ) );
+		}
+		#endif
 	}
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
-{
-xQUEUE *pxNewQueue;
-size_t xQueueSizeInBytes;
-xQueueHandle xReturn = NULL;
-
-	/* Remove compiler warnings about unused parameters should
-	configUSE_TRACE_FACILITY not be set to 1. */
-	( void ) ucQueueType;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	/* Allocate the new queue structure. */
-	if( uxQueueLength > ( unsigned portBASE_TYPE ) 0 )
+	xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType )
 	{
-		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
-		if( pxNewQueue != NULL )
+	xQUEUE *pxNewQueue;
+	size_t xQueueSizeInBytes;
+	signed char *pcQueueStorage;
+	xQueueHandle xReturn = NULL;
+	#if ( configUSE_QUEUE_CACHE == 1 )
+		unsigned portBASE_TYPE uxCacheClass;
+	#endif
+
+		if( uxQueueLength > ( unsigned portBASE_TYPE ) 0 )
 		{
-			/* Create the list of pointers to queue items.  The queue is one byte
-			longer than asked for to make wrap checking easier/faster. */
+			/* The queue is one byte longer than asked for to make wrap
+			checking easier/faster. */
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ) + ( size_t ) 1;
 
-			pxNewQueue->pcHead = ( signed char * ) pvPortMalloc( xQueueSizeInBytes );
-			if( pxNewQueue->pcHead != NULL )
+			#if ( configUSE_QUEUE_CACHE == 1 )
 			{
-				/* Initialise the queue members as described above where the
-				queue type is defined. */
-				pxNewQueue->uxLength = uxQueueLength;
-				pxNewQueue->uxItemSize = uxItemSize;
-				xQueueGenericReset( pxNewQueue, pdTRUE );
-				#if ( configUSE_TRACE_FACILITY == 1 )
+				/* Reuse a deleted queue with a storage area of the same size
+				class if there is one.  Otherwise the storage area is allocated
+				at the size of its class, so this queue can in turn be reused
+				once it is deleted. */
+				uxCacheClass = prvQueueCacheClass( xQueueSizeInBytes );
+				xReturn = prvQueueCacheTake( uxCacheClass );
+
+				if( xReturn != NULL )
+				{
+					prvInitialiseNewQueue( uxQueueLength, uxItemSize, xReturn->pcHead, ucQueueType, xReturn );
+				}
+				else if( uxCacheClass != queueCACHE_NOT_CACHED )
+				{
+					xQueueSizeInBytes = queueCACHE_CLASS_STORAGE( uxCacheClass );
+				}
+			}
+			#endif
+
+			if( xReturn == NULL )
+			{
+				/* Allocate the queue structure and the storage area as one
+				block, the storage area following the structure, so creating
+				the queue costs one allocation and the two are next to each
+				other in memory. */
+				pxNewQueue = ( xQUEUE * ) pvPortMalloc( queueSTRUCT_SIZE + xQueueSizeInBytes );
+				if( pxNewQueue != NULL )
+				{
+					pcQueueStorage = ( ( signed char * ) pxNewQueue ) + queueSTRUCT_SIZE;
+
+					#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+					{
+						/* The memory must be freed if the queue is deleted. */
+						pxNewQueue->ucStaticallyAllocated = pdFALSE;
+					}
+					#endif
+
+					prvInitialiseNewQueue( uxQueueLength, uxItemSize, pcQueueStorage, ucQueueType, pxNewQueue );
+					xReturn = pxNewQueue;
+				}
+				else
 				{
-					pxNewQueue->ucQueueType = ucQueueType;
+					traceQUEUE_CREATE_FAILED( ucQueueType );
 				}
-				#endif /* configUSE_TRACE_FACILITY */
+			}
+		}
+
+		configASSERT( xReturn );
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType )
+	{
+	xQUEUE *pxNewQueue = NULL;
+
+		configASSERT( uxQueueLength > ( unsigned portBASE_TYPE ) 0 );
+		configASSERT( pxStaticQueue );
+
+		/* A storage area is required if, and only if, the items have a size. */
+		configASSERT( ( pucQueueStorage != NULL ) || ( uxItemSize == ( unsigned portBASE_TYPE ) 0 ) );
+		configASSERT( ( pucQueueStorage == NULL ) || ( uxItemSize != ( unsigned portBASE_TYPE ) 0 ) );
+
+		/* The xStaticQueue structure must be the same size as the queue
+		structure it is used in place of. */
+		configASSERT( sizeof( xStaticQueue ) == sizeof( xQUEUE ) );
 
-				traceQUEUE_CREATE( pxNewQueue );
-				xReturn = pxNewQueue;
+		if( ( uxQueueLength > ( unsigned portBASE_TYPE ) 0 ) && ( pxStaticQueue != NULL ) && ( ( pucQueueStorage != NULL ) || ( uxItemSize == ( unsigned portBASE_TYPE ) 0 ) ) )
+		{
+			pxNewQueue = ( xQUEUE * ) pxStaticQueue;
+
+			/* The memory was supplied by the application so must not be
+			freed if the queue is deleted. */
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+
+			if( pucQueueStorage == NULL )
+			{
+				/* Nothing is ever copied into a queue that has an item size of
+				zero, but pcHead cannot be set to NULL as that is used to
+				indicate the queue is a mutex.  Point pcHead at the queue
+				structure itself as a known non-NULL value. */
+				prvInitialiseNewQueue( uxQueueLength, uxItemSize, ( signed char * ) pxNewQueue, ucQueueType, pxNewQueue );
 			}
 			else
 			{
-				traceQUEUE_CREATE_FAILED( ucQueueType );
-				vPortFree( pxNewQueue );
+				prvInitialiseNewQueue( uxQueueLength, uxItemSize, ( signed char * ) pucQueueStorage, ucQueueType, pxNewQueue );
 			}
 		}
+		else
+		{
+			traceQUEUE_CREATE_FAILED( ucQueueType );
+		}
+
+		return pxNewQueue;
 	}
 
-	configASSERT( xReturn );
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-	return xReturn;
+static void prvInitialiseNewQueue( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, signed char *pcQueueStorage, unsigned char ucQueueType, xQUEUE *pxNewQueue )
+{
+	/* Remove compiler warnings about unused parameters should
+	configUSE_TRACE_FACILITY not be set to 1. */
+	( void ) ucQueueType;
+
+	/* Initialise the queue members as described above where the queue type
+	is defined. */
+	pxNewQueue->pcHead = pcQueueStorage;
+	pxNewQueue->uxLength = uxQueueLength;
+	pxNewQueue->uxItemSize = uxItemSize;
+	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxNewQueue->ucQueueType = ucQueueType;
+		pxNewQueue->ulSendCount = 0UL;
+		pxNewQueue->ulReceiveCount = 0UL;
+		pxNewQueue->ulSendFailCount = 0UL;
+		pxNewQueue->uxPeakMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+	}
+	#endif /* configUSE_TRACE_FACILITY */
+
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+	{
+		/* Only used if the queue is a mutex, but cleared anyway so the values
+		reported by vQueueGetInfo() are defined. */
+		pxNewQueue->pvLastMutexHolder = NULL;
+		pxNewQueue->ulMutexTakenTime = ( portRUN_TIME_COUNTER_TYPE ) 0;
+		pxNewQueue->ulTotalMutexWait = ( portRUN_TIME_COUNTER_TYPE ) 0;
+		pxNewQueue->ulMaxMutexWait = ( portRUN_TIME_COUNTER_TYPE ) 0;
+		pxNewQueue->ulMaxMutexHold = ( portRUN_TIME_COUNTER_TYPE ) 0;
+		pxNewQueue->ulMutexTakeCount = 0UL;
+		pxNewQueue->ulMutexContendedCount = 0UL;
+		memset( ( void * ) pxNewQueue->ulMutexWaitHistogram, 0x00, sizeof( pxNewQueue->ulMutexWaitHistogram ) );
+		memset( ( void * ) pxNewQueue->ulMutexHoldHistogram, 0x00, sizeof( pxNewQueue->ulMutexHoldHistogram ) );
+	}
+	#endif
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		pxNewQueue->pxQueueSetContainer = NULL;
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
 	xQueueHandle xQueueCreateMutex( unsigned char ucQueueType )
 	{
-	xQUEUE *pxNewQueue;
-
-		/* Prevent compiler warnings about unused parameters if
-		configUSE_TRACE_FACILITY does not equal 1. */
-		( void ) ucQueueType;
+	xQUEUE *pxNewQueue = NULL;
 
-		/* Allocate the new queue structure. */
-		pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
-		if( pxNewQueue != NULL )
+		#if ( configUSE_QUEUE_CACHE == 1 )
 		{
-			/* Information required for priority inheritance. */
-			pxNewQueue->pxMutexHolder = NULL;
-			pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
-
-			/* Queues used as a mutex no data is actually copied into or out
-			of the queue. */
-			pxNewQueue->pcWriteTo = NULL;
-			pxNewQueue->pcReadFrom = NULL;
+			/* Reuse the structure of a deleted mutex if there is one. */
+			pxNewQueue = prvQueueCacheTake( queueCACHE_NO_STORAGE );
+		}
+		#endif
 
-			/* Each mutex has a length of 1 (like a binary semaphore) and
-			an item size of 0 as nothing is actually copied into or out
-			of the mutex. */
-			pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
-			pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
-			pxNewQueue->xRxLock = queueUNLOCKED;
-			pxNewQueue->xTxLock = queueUNLOCKED;
+		if( pxNewQueue == NULL )
+		{
+			/* Allocate the new queue structure. */
+			pxNewQueue = ( xQUEUE * ) pvPortMalloc( sizeof( xQUEUE ) );
 
-			#if ( configUSE_TRACE_FACILITY == 1 )
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
-				pxNewQueue->ucQueueType = ucQueueType;
+				if( pxNewQueue != NULL )
+				{
+					/* The memory must be freed if the mutex is deleted. */
+					pxNewQueue->ucStaticallyAllocated = pdFALSE;
+				}
 			}
 			#endif
+		}
+
+		if( pxNewQueue != NULL )
+		{
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
+		}
+		else
+		{
+			traceCREATE_MUTEX_FAILED();
+		}
+
+		configASSERT( pxNewQueue );
+		return pxNewQueue;
+	}
+
+#endif /* configUSE_MUTEXES && configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue )
+	{
+	xQUEUE *pxNewQueue = ( xQUEUE * ) pxStaticQueue;
 
-			/* Ensure the event queues start with the correct state. */
-			vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
-			vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+		configASSERT( pxStaticQueue );
 
-			traceCREATE_MUTEX( pxNewQueue );
+		/* The xStaticQueue structure must be the same size as the queue
+		structure it is used in place of. */
+		configASSERT( sizeof( xStaticQueue ) == sizeof( xQUEUE ) );
 
-			/* Start with the semaphore in the expected state. */
-			xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+		if( pxNewQueue != NULL )
+		{
+			/* The memory was supplied by the application so must not be
+			freed if the mutex is deleted. */
+			pxNewQueue->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseMutex( pxNewQueue, ucQueueType );
 		}
 		else
 		{
 			traceCREATE_MUTEX_FAILED();
 		}
 
-		configASSERT( pxNewQueue );
 		return pxNewQueue;
 	}
 
+#endif /* configUSE_MUTEXES && configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvInitialiseMutex( xQUEUE *pxNewQueue, unsigned char ucQueueType )
+	{
+		/* Prevent compiler warnings about unused parameters if
+		configUSE_TRACE_FACILITY does not equal 1. */
+		( void ) ucQueueType;
+
+		/* Information required for priority inheritance. */
+		pxNewQueue->pxMutexHolder = NULL;
+		pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+
+		/* Queues used as a mutex no data is actually copied into or out
+		of the queue. */
+		pxNewQueue->pcWriteTo = NULL;
+		pxNewQueue->pcReadFrom = NULL;
+
+		/* Each mutex has a length of 1 (like a binary semaphore) and
+		an item size of 0 as nothing is actually copied into or out
+		of the mutex. */
+		pxNewQueue->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->uxLength = ( unsigned portBASE_TYPE ) 1U;
+		pxNewQueue->uxItemSize = ( unsigned portBASE_TYPE ) 0U;
+		pxNewQueue->xRxLock = queueUNLOCKED;
+		pxNewQueue->xTxLock = queueUNLOCKED;
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxNewQueue->ucQueueType = ucQueueType;
+			pxNewQueue->ulSendCount = 0UL;
+			pxNewQueue->ulReceiveCount = 0UL;
+			pxNewQueue->ulSendFailCount = 0UL;
+			pxNewQueue->uxPeakMessagesWaiting = ( unsigned portBASE_TYPE ) 0U;
+		}
+		#endif
+
+		#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		{
+			pxNewQueue->pvLastMutexHolder = NULL;
+			pxNewQueue->ulMutexTakenTime = ( portRUN_TIME_COUNTER_TYPE ) 0;
+			pxNewQueue->ulTotalMutexWait = ( portRUN_TIME_COUNTER_TYPE ) 0;
+			pxNewQueue->ulMaxMutexWait = ( portRUN_TIME_COUNTER_TYPE ) 0;
+			pxNewQueue->ulMaxMutexHold = ( portRUN_TIME_COUNTER_TYPE ) 0;
+			pxNewQueue->ulMutexTakeCount = 0UL;
+			pxNewQueue->ulMutexContendedCount = 0UL;
+			memset( ( void * ) pxNewQueue->ulMutexWaitHistogram, 0x00, sizeof( pxNewQueue->ulMutexWaitHistogram ) );
+			memset( ( void * ) pxNewQueue->ulMutexHoldHistogram, 0x00, sizeof( pxNewQueue->ulMutexHoldHistogram ) );
+		}
+		#endif
+
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			pxNewQueue->pxQueueSetContainer = NULL;
+		}
+		#endif
+
+		/* Ensure the event queues start with the correct state. */
+		queueINITIALISE_EVENT_LIST( &( pxNewQueue->xTasksWaitingToSend ) );
+		queueINITIALISE_EVENT_LIST( &( pxNewQueue->xTasksWaitingToReceive ) );
+
+		#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		{
+			vListInitialise( &( pxNewQueue->xCoRoutinesWaitingToSend ) );
+			vListInitialise( &( pxNewQueue->xCoRoutinesWaitingToReceive ) );
+		}
+		#endif
+
+		traceCREATE_MUTEX( pxNewQueue );
+
+		/* Start with the semaphore in the expected state. */
+		xQueueGenericSend( pxNewQueue, NULL, ( portTickType ) 0U, queueSEND_TO_BACK );
+	}
+
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
@@ -442,43 +1093,315 @@ xQueueHandle xReturn = NULL;
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-	portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex )
+	static portBASE_TYPE prvTakeMutex( xQUEUE * const pxMutex )
 	{
 	portBASE_TYPE xReturn;
 
-		configASSERT( pxMutex );
-
-		/* If this is the task that holds the mutex then pxMutexHolder will not
-		change outside of this task.  If this task does not hold the mutex then
-		pxMutexHolder can never coincidentally equal the tasks handle, and as
-		this is the only condition we are interested in it does not matter if
-		pxMutexHolder is accessed simultaneously by another task.  Therefore no
-		mutual exclusion is required to test the pxMutexHolder variable. */
-		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
+		taskENTER_CRITICAL();
 		{
-			traceGIVE_MUTEX_RECURSIVE( pxMutex );
-
-			/* uxRecursiveCallCount cannot be zero if pxMutexHolder is equal to
-			the task handle, therefore no underflow check is required.  Also,
-			uxRecursiveCallCount is only modified by the mutex holder, and as
-			there can only be one, no mutual exclusion is required to modify the
-			uxRecursiveCallCount member. */
-			( pxMutex->uxRecursiveCallCount )--;
+			/* A mutex holds one item when it is free and none when it is
+			held.  Nothing is copied out of a mutex, and no task can be
+			waiting to give it, so taking a free mutex is just a matter of
+			recording the new holder. */
+			if( pxMutex->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_RECEIVE( pxMutex );
 
-			/* Have we unwound the call count? */
-			if( pxMutex->uxRecursiveCallCount == 0 )
+				pxMutex->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 0;
+				prvRecordItemsReceived( pxMutex, 1U );
+				pxMutex->pxMutexHolder = pvTaskIncrementMutexHeldCount();
+				prvRecordMutexTaken( pxMutex );
+				xReturn = pdPASS;
+			}
+			else
 			{
-				/* Return the mutex.  This will automatically unblock any other
-				task that might be waiting to access the mutex. */
-				xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
+				prvRecordMutexContended( pxMutex );
+				xReturn = pdFAIL;
 			}
-
-			xReturn = pdPASS;
 		}
-		else
-		{
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static signed portBASE_TYPE prvGiveMutex( xQUEUE * const pxMutex )
+	{
+	signed portBASE_TYPE xReturn;
+
+		taskENTER_CRITICAL();
+		{
+			if( pxMutex->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_SEND( pxMutex );
+
+				/* The mutex is no longer being held. */
+				prvRecordMutexGiven( pxMutex );
+				vTaskPriorityDisinherit( ( void * ) pxMutex->pxMutexHolder );
+				pxMutex->pxMutexHolder = NULL;
+				pxMutex->uxMessagesWaiting = ( unsigned portBASE_TYPE ) 1;
+				prvRecordItemsSent( pxMutex, 1U );
+
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxMutex->pxQueueSetContainer != NULL )
+					{
+						if( prvNotifyQueueSetContainer( pxMutex, queueSEND_TO_BACK ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+					else if( queueEVENT_LIST_IS_EMPTY( &( pxMutex->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( queueREMOVE_FROM_EVENT_LIST( &( pxMutex->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					/* The event list is only touched if the mutex is
+					contended. */
+					if( queueEVENT_LIST_IS_EMPTY( &( pxMutex->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						if( queueREMOVE_FROM_EVENT_LIST( &( pxMutex->xTasksWaitingToReceive ) ) == pdTRUE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				/* The mutex is not held so cannot be given.  It will only
+				become full again once given by whichever task takes it next,
+				so there is no point in blocking here. */
+				prvRecordSendFailed( pxMutex );
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn != pdPASS )
+		{
+			traceQUEUE_SEND_FAILED( pxMutex );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configRECORD_MUTEX_CONTENTION == 1 )
+
+	static void prvRecordMutexTaken( xQUEUE * const pxMutex )
+	{
+		queueGET_MUTEX_TIME( pxMutex->ulMutexTakenTime );
+		pxMutex->pvLastMutexHolder = ( void * ) pxMutex->pxMutexHolder;
+		( pxMutex->ulMutexTakeCount )++;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordMutexGiven( xQUEUE * const pxMutex )
+	{
+	portRUN_TIME_COUNTER_TYPE ulHoldTime;
+
+		/* No task holds the mutex when it is first given as it is created. */
+		if( pxMutex->pxMutexHolder != NULL )
+		{
+			queueGET_MUTEX_TIME( ulHoldTime );
+			ulHoldTime -= pxMutex->ulMutexTakenTime;
+
+			if( ulHoldTime > pxMutex->ulMaxMutexHold )
+			{
+				pxMutex->ulMaxMutexHold = ulHoldTime;
+			}
+
+			prvAddToMutexHistogram( pxMutex->ulMutexHoldHistogram, ulHoldTime );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordMutexWait( xQUEUE * const pxMutex, portRUN_TIME_COUNTER_TYPE ulWaitStart )
+	{
+	portRUN_TIME_COUNTER_TYPE ulWaitTime;
+
+		queueGET_MUTEX_TIME( ulWaitTime );
+		ulWaitTime -= ulWaitStart;
+
+		pxMutex->ulTotalMutexWait += ulWaitTime;
+		if( ulWaitTime > pxMutex->ulMaxMutexWait )
+		{
+			pxMutex->ulMaxMutexWait = ulWaitTime;
+		}
+
+		prvAddToMutexHistogram( pxMutex->ulMutexWaitHistogram, ulWaitTime );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvAddToMutexHistogram( unsigned long *pulHistogram, portRUN_TIME_COUNTER_TYPE ulTime )
+	{
+	portRUN_TIME_COUNTER_TYPE ulBucketLimit = ( portRUN_TIME_COUNTER_TYPE ) configMUTEX_CONTENTION_RESOLUTION;
+	unsigned portBASE_TYPE uxBucket;
+
+		/* Each bucket ends at twice the limit of the one before. */
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) ( configMUTEX_CONTENTION_BUCKETS - 1 ); uxBucket++ )
+		{
+			if( ulTime < ulBucketLimit )
+			{
+				break;
+			}
+			ulBucketLimit <<= 1;
+		}
+
+		( pulHistogram[ uxBucket ] )++;
+	}
+
+#endif /* configRECORD_MUTEX_CONTENTION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static portBASE_TYPE prvInheritPriority( xQUEUE *pxMutex )
+	{
+	void *pvHolder = ( void * ) pxMutex->pxMutexHolder;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		/* Each holder along the chain is raised to the priority of the
+		calling task.  The walk stops at the first holder that already has at
+		least that priority, as any holder further along the chain will then
+		have inherited at least that priority already.  This also ensures the
+		walk terminates should the chain contain a deadlock. */
+		while( ( pvHolder != NULL ) && ( xTaskPriorityInherit( pvHolder ) != pdFALSE ) )
+		{
+			xReturn = pdTRUE;
+
+			pxMutex = ( xQUEUE * ) pvTaskGetMutexBlockedOn( pvHolder );
+			if( pxMutex != NULL )
+			{
+				pvHolder = ( void * ) pxMutex->pxMutexHolder;
+			}
+			else
+			{
+				pvHolder = NULL;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvDisinheritPriorityAfterTimeout( xQUEUE *pxMutex )
+	{
+	void *pvHolder = ( void * ) pxMutex->pxMutexHolder;
+
+		/* As prvInheritPriority(), but each holder is lowered to the priority
+		of the highest priority task still waiting for the mutex it holds.
+		Each step lowers a priority, so the walk must terminate. */
+		while( ( pvHolder != NULL ) && ( xTaskPriorityDisinheritAfterTimeout( pvHolder, prvGetDisinheritPriorityAfterTimeout( pxMutex ) ) != pdFALSE ) )
+		{
+			pxMutex = ( xQUEUE * ) pvTaskGetMutexBlockedOn( pvHolder );
+			if( pxMutex != NULL )
+			{
+				pvHolder = ( void * ) pxMutex->pxMutexHolder;
+			}
+			else
+			{
+				pvHolder = NULL;
+			}
+		}
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static unsigned portBASE_TYPE prvGetDisinheritPriorityAfterTimeout( const xQUEUE * const pxMutex )
+	{
+	unsigned portBASE_TYPE uxHighestPriorityOfWaitingTasks;
+	const xList *pxWaitingTasks;
+
+		/* The event list is ordered by priority, so the first task in the
+		list (or in the highest priority bucket of a priority event list) is
+		the highest priority task waiting for the mutex. */
+		#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+		{
+			pxWaitingTasks = pxListGetHighestPriorityBucket( ( xPriorityList * ) &( pxMutex->xTasksWaitingToReceive ) );
+		}
+		#else
+		{
+			pxWaitingTasks = &( pxMutex->xTasksWaitingToReceive );
+		}
+		#endif
+
+		if( ( pxWaitingTasks != NULL ) && ( listCURRENT_LIST_LENGTH( pxWaitingTasks ) > ( unsigned portBASE_TYPE ) 0U ) )
+		{
+			uxHighestPriorityOfWaitingTasks = ( unsigned portBASE_TYPE ) configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWaitingTasks );
+		}
+		else
+		{
+			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+	portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( pxMutex );
+
+		/* If this is the task that holds the mutex then pxMutexHolder will not
+		change outside of this task.  If this task does not hold the mutex then
+		pxMutexHolder can never coincidentally equal the tasks handle, and as
+		this is the only condition we are interested in it does not matter if
+		pxMutexHolder is accessed simultaneously by another task.  Therefore no
+		mutual exclusion is required to test the pxMutexHolder variable. */
+		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
+		{
+			traceGIVE_MUTEX_RECURSIVE( pxMutex );
+
+			/* uxRecursiveCallCount cannot be zero if pxMutexHolder is equal to
+			the task handle, therefore no underflow check is required.  Also,
+			uxRecursiveCallCount is only modified by the mutex holder, and as
+			there can only be one, no mutual exclusion is required to modify the
+			uxRecursiveCallCount member. */
+			queueDECREMENT_RECURSIVE_CALL_COUNT( pxMutex );
+
+			/* Have we unwound the call count? */
+			if( queueRECURSIVE_CALL_COUNT_IS_ZERO( pxMutex ) )
+			{
+				/* Return the mutex.  This will automatically unblock any other
+				task that might be waiting to access the mutex. */
+				xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
 			/* We cannot give the mutex because we are not the holder. */
 			xReturn = pdFAIL;
 
@@ -506,7 +1429,7 @@ xQueueHandle xReturn = NULL;
 
 		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
 		{
-			( pxMutex->uxRecursiveCallCount )++;
+			queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
 			xReturn = pdPASS;
 		}
 		else
@@ -517,7 +1440,7 @@ xQueueHandle xReturn = NULL;
 			we may have blocked to reach here. */
 			if( xReturn == pdPASS )
 			{
-				( pxMutex->uxRecursiveCallCount )++;
+				queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
 			}
 			else
 			{
@@ -531,7 +1454,45 @@ xQueueHandle xReturn = NULL;
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if configUSE_COUNTING_SEMAPHORES == 1
+#if ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+
+	portBASE_TYPE xQueueTakeMutexRecursiveUntil( xQueueHandle pxMutex, portTickType xWakeTime )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( pxMutex );
+
+		/* Comments regarding mutual exclusion as per those within
+		xQueueGiveMutexRecursive(). */
+
+		traceTAKE_MUTEX_RECURSIVE( pxMutex );
+
+		if( pxMutex->pxMutexHolder == xTaskGetCurrentTaskHandle() )
+		{
+			queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = xQueueGenericReceiveUntil( pxMutex, NULL, xWakeTime, pdFALSE );
+
+			if( xReturn == pdPASS )
+			{
+				queueINCREMENT_RECURSIVE_CALL_COUNT( pxMutex );
+			}
+			else
+			{
+				traceTAKE_MUTEX_RECURSIVE_FAILED( pxMutex );
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_ABSOLUTE_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
 	xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount )
 	{
@@ -554,49 +1515,431 @@ xQueueHandle xReturn = NULL;
 		return pxHandle;
 	}
 
-#endif /* configUSE_COUNTING_SEMAPHORES */
+#endif /* configUSE_COUNTING_SEMAPHORES && configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
-{
-signed portBASE_TYPE xEntryTimeSet = pdFALSE;
-xTimeOutType xTimeOut;
+#if ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
-	configASSERT( pxQueue );
-	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+	xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue )
+	{
+	xQueueHandle pxHandle;
 
-	/* This function relaxes the coding standard somewhat to allow return
-	statements within the function itself.  This is done in the interest
-	of execution time efficiency. */
-	for( ;; )
+		configASSERT( uxInitialCount <= uxCountValue );
+
+		pxHandle = xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) uxCountValue, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+		if( pxHandle != NULL )
+		{
+			pxHandle->uxMessagesWaiting = uxInitialCount;
+
+			traceCREATE_COUNTING_SEMAPHORE();
+		}
+		else
+		{
+			traceCREATE_COUNTING_SEMAPHORE_FAILED();
+		}
+
+		return pxHandle;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES && configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	signed portBASE_TYPE xQueueSemaphoreGiveMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount )
 	{
+	signed portBASE_TYPE xReturn;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		/* The count is raised in one step, and up to one task is unblocked
+		per unit given during the same walk of the event list. */
 		taskENTER_CRITICAL();
 		{
-			/* Is there room on the queue now?  To be running we must be
-			the highest priority task wanting to access the queue. */
-			if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+			if( ( pxQueue->uxLength - pxQueue->uxMessagesWaiting ) >= uxCount )
 			{
 				traceQUEUE_SEND( pxQueue );
-				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+				prvCopyItemsToQueue( pxQueue, NULL, uxCount );
 
-				/* If there was a task waiting for data to arrive on the
-				queue then unblock it now. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				if( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
-					{
-						/* The unblocked task has a priority higher than
-						our own so yield immediately.  Yes it is ok to do
-						this from within the critical section - the kernel
-						takes care of that. */
-						portYIELD_WITHIN_API();
-					}
+					portYIELD_WITHIN_API();
 				}
 
-				taskEXIT_CRITICAL();
-
-				/* Return to the original privilege level before exiting the
-				function. */
+				xReturn = pdPASS;
+			}
+			else
+			{
+				prvRecordSendFailed( pxQueue );
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn != pdPASS )
+		{
+			traceQUEUE_SEND_FAILED( pxQueue );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	signed portBASE_TYPE xQueueSemaphoreGiveMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	signed portBASE_TYPE xReturn;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( pxQueue );
+		configASSERT( pxHigherPriorityTaskWoken );
+		configASSERT( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( ( pxQueue->uxLength - pxQueue->uxMessagesWaiting ) >= uxCount )
+			{
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+				prvCopyItemsToQueue( pxQueue, NULL, uxCount );
+
+				/* As uxQueueSendMultipleFromISR(), a locked queue has its
+				lock count raised by the number of units instead. */
+				if( pxQueue->xTxLock == queueUNLOCKED )
+				{
+					if( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+				else
+				{
+					pxQueue->xTxLock += ( signed portBASE_TYPE ) uxCount;
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+				prvRecordSendFailed( pxQueue );
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	signed portBASE_TYPE xQueueSemaphoreTakeMultiple( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE, xTooFew;
+	xTimeOutType xTimeOut;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		/* More units than the semaphore can hold would never be available. */
+		configASSERT( uxCount <= pxQueue->uxLength );
+
+		/* As xQueueGenericReceive(), but the task only leaves with all uxCount
+		units or none.  A waiting task is woken by gives and goes back to
+		waiting while too few units are available.  The units that woke it are
+		kept for it rather than handed to the tasks queued behind it, so a
+		large take is not starved by a stream of smaller ones. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxQueue->uxMessagesWaiting >= uxCount )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+					prvCopyItemsFromQueue( pxQueue, NULL, uxCount );
+
+					if( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					if( prvPassOnSemaphoreUnits( pxQueue ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+				else if( xTicksToWait == ( portTickType ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return errQUEUE_EMPTY;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					xTooFew = ( pxQueue->uxMessagesWaiting < uxCount );
+				}
+				taskEXIT_CRITICAL();
+
+				if( xTooFew != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				/* Hand on any units this task was woken for but could not
+				use. */
+				taskENTER_CRITICAL();
+				{
+					if( prvPassOnSemaphoreUnits( pxQueue ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return errQUEUE_EMPTY;
+			}
+		}
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	signed portBASE_TYPE xQueueSemaphoreTakeMultipleFromISR( xQueueHandle pxQueue, unsigned portBASE_TYPE uxCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	signed portBASE_TYPE xReturn;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		configASSERT( pxQueue );
+		configASSERT( pxHigherPriorityTaskWoken );
+		configASSERT( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( pxQueue->uxMessagesWaiting >= uxCount )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				prvCopyItemsFromQueue( pxQueue, NULL, uxCount );
+
+				if( pxQueue->xRxLock == queueUNLOCKED )
+				{
+					if( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+				else
+				{
+					pxQueue->xRxLock += ( signed portBASE_TYPE ) uxCount;
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+				xReturn = errQUEUE_EMPTY;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition )
+{
+	return prvQueueGenericSend( pxQueue, pvItemToQueue, xTicksToWait, xCopyPosition, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+
+	signed portBASE_TYPE xQueueGenericSendUntil( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xWakeTime, portBASE_TYPE xCopyPosition )
+	{
+	xTimeOutType xTimeOut;
+	portTickType xTicksToWait;
+
+		vTaskSetTimeOutStateUntil( &xTimeOut, &xTicksToWait, xWakeTime );
+		return prvQueueGenericSend( pxQueue, pvItemToQueue, xTicksToWait, xCopyPosition, &xTimeOut );
+	}
+
+#endif /* configUSE_ABSOLUTE_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvQueueGenericSend( xQueueHandle pxQueue, const void * const pvItemToQueue, portTickType xTicksToWait, portBASE_TYPE xCopyPosition, const xTimeOutType * const pxTimeOut )
+{
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+#if ( configUSE_QUEUE_SETS == 1 )
+	unsigned portBASE_TYPE uxPreviousMessagesWaiting;
+#endif
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != ( unsigned portBASE_TYPE ) 1U ) ) );
+
+	#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+	{
+		/* A wait until an absolute tick count starts with the time status
+		its xTicksToWait was calculated from, so it ends at that tick count
+		however long the code before the first block takes. */
+		if( pxTimeOut != NULL )
+		{
+			xTimeOut = *pxTimeOut;
+			xEntryTimeSet = pdTRUE;
+		}
+	}
+	#else
+	{
+		( void ) pxTimeOut;
+	}
+	#endif
+
+	#if ( configUSE_MUTEXES == 1 )
+	{
+		/* A mutex can only be given by its holder, so giving it never needs
+		to block. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			return prvGiveMutex( pxQueue );
+		}
+	}
+	#endif
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Is there room on the queue now?  To be running we must be
+			the highest priority task wanting to access the queue.  An
+			overwrite always succeeds, as it replaces the item in a full
+			queue of length one. */
+			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+				}
+				#endif
+
+				prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						/* The queue is a member of a queue set.  Post its
+						handle to the set, within this same critical section,
+						in place of unblocking a task waiting on the queue.
+						Overwriting an item that was already in the queue
+						does not change the number of items, so the set
+						already holds the handle. */
+						if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( unsigned portBASE_TYPE ) 0U ) )
+						{
+							/* Nothing to post. */
+						}
+						else if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
+						{
+							/* The queue is a member of a queue set, and posting
+							to the queue set caused a higher priority task to
+							unblock.  A context switch is required. */
+							portYIELD_WITHIN_API();
+						}
+					}
+					else
+					{
+						/* If there was a task waiting for data to arrive on the
+						queue then unblock it now. */
+						if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+						{
+							if( prvWakeReceiver( pxQueue ) == pdTRUE )
+							{
+								/* The unblocked task has a priority higher than
+								our own so yield immediately.  Yes it is ok to
+								do this from within the critical section - the
+								kernel takes care of that. */
+								portYIELD_WITHIN_API();
+							}
+						}
+					}
+				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					/* If there was a task waiting for data to arrive on the
+					queue then unblock it now. */
+					if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+					{
+						if( prvWakeReceiver( pxQueue ) == pdTRUE )
+						{
+							/* The unblocked task has a priority higher than
+							our own so yield immediately.  Yes it is ok to do
+							this from within the critical section - the kernel
+							takes care of that. */
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
+
+				taskEXIT_CRITICAL();
+
+				/* Return to the original privilege level before exiting the
+				function. */
 				return pdPASS;
 			}
 			else
@@ -605,6 +1948,7 @@ xTimeOutType xTimeOut;
 				{
 					/* The queue was full and no block time is specified (or
 					the block time has expired) so leave now. */
+					prvRecordSendFailed( pxQueue );
 					taskEXIT_CRITICAL();
 
 					/* Return to the original privilege level before exiting
@@ -635,7 +1979,7 @@ xTimeOutType xTimeOut;
 			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
 				/* Unlocking the queue means queue events can effect the
 				event list.  It is possible	that interrupts occurring now
@@ -667,6 +2011,16 @@ xTimeOutType xTimeOut;
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
+			#if ( configUSE_TRACE_FACILITY == 1 )
+			{
+				taskENTER_CRITICAL();
+				{
+					prvRecordSendFailed( pxQueue );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif
+
 			/* Return to the original privilege level before exiting the
 			function. */
 			traceQUEUE_SEND_FAILED( pxQueue );
@@ -685,23 +2039,25 @@ xTimeOutType xTimeOut;
 
 		configASSERT( pxQueue );
 		configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+		configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != ( unsigned portBASE_TYPE ) 1U ) ) );
 
 		for( ;; )
 		{
 			taskENTER_CRITICAL();
 			{
 				/* Is there room on the queue now?  To be running we must be
-				the highest priority task wanting to access the queue. */
-				if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+				the highest priority task wanting to access the queue.  An
+				overwrite always succeeds. */
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 				{
 					traceQUEUE_SEND( pxQueue );
 					prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
 					/* If there was a task waiting for data to arrive on the
 					queue then unblock it now. */
-					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) == pdTRUE )
+						if( prvWakeReceiver( pxQueue ) == pdTRUE )
 						{
 							/* The unblocked task has a priority higher than
 							our own so yield immediately. */
@@ -716,6 +2072,7 @@ xTimeOutType xTimeOut;
 				{
 					if( xTicksToWait == ( portTickType ) 0 )
 					{
+						prvRecordSendFailed( pxQueue );
 						taskEXIT_CRITICAL();
 						return errQUEUE_FULL;
 					}
@@ -735,12 +2092,13 @@ xTimeOutType xTimeOut;
 					if( prvIsQueueFull( pxQueue ) != pdFALSE )
 					{
 						traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+						queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 						portYIELD_WITHIN_API();
 					}
 				}
 				else
 				{
+					prvRecordSendFailed( pxQueue );
 					taskEXIT_CRITICAL();
 					traceQUEUE_SEND_FAILED( pxQueue );
 					return errQUEUE_FULL;
@@ -760,6 +2118,13 @@ xTimeOutType xTimeOut;
 	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
 	xTimeOutType xTimeOut;
 	signed char *pcOriginalReadPosition;
+	#if ( configUSE_MUTEXES == 1 )
+		portBASE_TYPE xInheritanceOccurred = pdFALSE;
+	#endif
+	#if ( configRECORD_MUTEX_CONTENTION == 1 )
+		portBASE_TYPE xMutexWaitStarted = pdFALSE;
+		portRUN_TIME_COUNTER_TYPE ulMutexWaitStart = ( portRUN_TIME_COUNTER_TYPE ) 0;
+	#endif
 
 		configASSERT( pxQueue );
 		configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
@@ -781,6 +2146,7 @@ xTimeOutType xTimeOut;
 
 						/* We are actually removing data. */
 						--( pxQueue->uxMessagesWaiting );
+						prvRecordItemsReceived( pxQueue, 1U );
 
 						#if ( configUSE_MUTEXES == 1 )
 						{
@@ -788,14 +2154,24 @@ xTimeOutType xTimeOut;
 							{
 								/* Record the information required to implement
 								priority inheritance should it become necessary. */
-								pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+								pxQueue->pxMutexHolder = pvTaskIncrementMutexHeldCount();
+								prvRecordMutexTaken( pxQueue );
+							}
+						}
+						#endif
+
+						#if ( configRECORD_MUTEX_CONTENTION == 1 )
+						{
+							if( xMutexWaitStarted != pdFALSE )
+							{
+								prvRecordMutexWait( pxQueue, ulMutexWaitStart );
 							}
 						}
 						#endif
 
-						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+						if( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE )
 						{
-							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) == pdTRUE )
+							if( prvWakeSender( pxQueue ) == pdTRUE )
 							{
 								portYIELD_WITHIN_API();
 							}
@@ -811,11 +2187,11 @@ xTimeOutType xTimeOut;
 
 						/* The data is being left in the queue, so see if there are
 						any other tasks waiting for the data. */
-						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
 						{
 							/* Tasks that are removed from the event list will get added to
 							the pending ready list as the scheduler is still suspended. */
-							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							if( prvWakeReceiver( pxQueue ) != pdFALSE )
 							{
 								/* The task waiting has a higher priority than this task. */
 								portYIELD_WITHIN_API();
@@ -829,15 +2205,38 @@ xTimeOutType xTimeOut;
 				}
 				else
 				{
-					if( xTicksToWait == ( portTickType ) 0 )
-					{
-						taskEXIT_CRITICAL();
-						traceQUEUE_RECEIVE_FAILED( pxQueue );
-						return errQUEUE_EMPTY;
-					}
-					else if( xEntryTimeSet == pdFALSE )
+					#if ( configRECORD_MUTEX_CONTENTION == 1 )
 					{
-						vTaskSetTimeOutState( &xTimeOut );
+						/* There is no fast path for a mutex here, so the take
+						is counted as contended the first time round. */
+						if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xJustPeeking == pdFALSE ) )
+						{
+							if( xMutexWaitStarted != pdFALSE )
+							{
+								if( xTicksToWait == ( portTickType ) 0 )
+								{
+									prvRecordMutexWait( pxQueue, ulMutexWaitStart );
+								}
+							}
+							else
+							{
+								prvRecordMutexContended( pxQueue );
+								queueGET_MUTEX_TIME( ulMutexWaitStart );
+								xMutexWaitStarted = pdTRUE;
+							}
+						}
+					}
+					#endif
+
+					if( xTicksToWait == ( portTickType ) 0 )
+					{
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return errQUEUE_EMPTY;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
 						xEntryTimeSet = pdTRUE;
 					}
 				}
@@ -856,19 +2255,55 @@ xTimeOutType xTimeOut;
 						{
 							if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 							{
-								portENTER_CRITICAL();
-									vTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
-								portEXIT_CRITICAL();
+								taskENTER_CRITICAL();
+								{
+									if( prvInheritPriority( pxQueue ) != pdFALSE )
+									{
+										xInheritanceOccurred = pdTRUE;
+									}
+									vTaskSetMutexBlockedOn( ( void * ) pxQueue );
+								}
+								taskEXIT_CRITICAL();
 							}
 						}
 						#endif
 
-						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+						queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 						portYIELD_WITHIN_API();
+
+						#if ( configUSE_MUTEXES == 1 )
+						{
+							if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+							{
+								vTaskSetMutexBlockedOn( NULL );
+							}
+						}
+						#endif
 					}
 				}
 				else
 				{
+					#if ( configUSE_MUTEXES == 1 )
+					{
+						/* If this task raised the priority of the mutex
+						holder then the holder no longer needs to run at that
+						priority on its behalf. */
+						if( ( xInheritanceOccurred != pdFALSE ) && ( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 ) )
+						{
+							prvDisinheritPriorityAfterTimeout( pxQueue );
+						}
+					}
+					#endif
+
+					#if ( configRECORD_MUTEX_CONTENTION == 1 )
+					{
+						if( xMutexWaitStarted != pdFALSE )
+						{
+							prvRecordMutexWait( pxQueue, ulMutexWaitStart );
+						}
+					}
+					#endif
+
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -885,38 +2320,75 @@ xTimeOutType xTimeOut;
 signed portBASE_TYPE xQueueGenericSendFromISR( xQueueHandle pxQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portBASE_TYPE xCopyPosition )
 {
 signed portBASE_TYPE xReturn;
-unsigned portBASE_TYPE uxSavedInterruptStatus;
+unsigned portBASE_TYPE uxSavedInterruptStatus, uxPreviousMessagesWaiting;
 
 	configASSERT( pxQueue );
 	configASSERT( pxHigherPriorityTaskWoken );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != ( unsigned portBASE_TYPE ) 1U ) ) );
 
 	/* Similar to xQueueGenericSend, except we don't block if there is no room
 	in the queue.  Also we don't directly wake a task that was blocked on a
 	queue read, instead we return a flag to say whether a context switch is
 	required or not (i.e. has a task with a higher priority than us been woken
 	by this	post). */
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
-		if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
 			traceQUEUE_SEND_FROM_ISR( pxQueue );
 
+			uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
 			prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
 			/* If the queue is locked we do not alter the event list.  This will
-			be done when the queue is unlocked later. */
-			if( pxQueue->xTxLock == queueUNLOCKED )
+			be done when the queue is unlocked later.  Overwriting an item that
+			was already in the queue makes no new item available, so there is
+			nothing to do. */
+			if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				/* The item was replaced in place. */
+			}
+			else if( pxQueue->xTxLock == queueUNLOCKED )
 			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				#if ( configUSE_QUEUE_SETS == 1 )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					if( pxQueue->pxQueueSetContainer != NULL )
 					{
-						/* The task waiting has a higher priority so record that a
-						context	switch is required. */
-						*pxHigherPriorityTaskWoken = pdTRUE;
+						if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
+						{
+							/* The queue is a member of a queue set, and posting
+							to the queue set caused a higher priority task to
+							unblock.  A context switch is required. */
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+					else
+					{
+						if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+						{
+							if( prvWakeReceiver( pxQueue ) != pdFALSE )
+							{
+								/* The task waiting has a higher priority so
+								record that a context switch is required. */
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+						}
 					}
 				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+					{
+						if( prvWakeReceiver( pxQueue ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record that a
+							context	switch is required. */
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
 			}
 			else
 			{
@@ -930,28 +2402,105 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 		else
 		{
 			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			prvRecordSendFailed( pxQueue );
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
 signed portBASE_TYPE xQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking )
+{
+	return prvQueueGenericReceive( pxQueue, pvBuffer, xTicksToWait, xJustPeeking, NULL );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+
+	signed portBASE_TYPE xQueueGenericReceiveUntil( xQueueHandle pxQueue, void * const pvBuffer, portTickType xWakeTime, portBASE_TYPE xJustPeeking )
+	{
+	xTimeOutType xTimeOut;
+	portTickType xTicksToWait;
+
+		vTaskSetTimeOutStateUntil( &xTimeOut, &xTicksToWait, xWakeTime );
+		return prvQueueGenericReceive( pxQueue, pvBuffer, xTicksToWait, xJustPeeking, &xTimeOut );
+	}
+
+#endif /* configUSE_ABSOLUTE_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvQueueGenericReceive( xQueueHandle pxQueue, void * const pvBuffer, portTickType xTicksToWait, portBASE_TYPE xJustPeeking, const xTimeOutType * const pxTimeOut )
 {
 signed portBASE_TYPE xEntryTimeSet = pdFALSE;
 xTimeOutType xTimeOut;
 signed char *pcOriginalReadPosition;
+#if ( configUSE_MUTEXES == 1 )
+	portBASE_TYPE xInheritanceOccurred = pdFALSE;
+#endif
+#if ( configRECORD_MUTEX_CONTENTION == 1 )
+	portBASE_TYPE xMutexWaitStarted = pdFALSE;
+	portRUN_TIME_COUNTER_TYPE ulMutexWaitStart = ( portRUN_TIME_COUNTER_TYPE ) 0;
+#endif
 
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
 
+	#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+	{
+		/* A wait until an absolute tick count starts with the time status
+		its xTicksToWait was calculated from, so it ends at that tick count
+		however long the code before the first block takes. */
+		if( pxTimeOut != NULL )
+		{
+			xTimeOut = *pxTimeOut;
+			xEntryTimeSet = pdTRUE;
+		}
+	}
+	#else
+	{
+		( void ) pxTimeOut;
+	}
+	#endif
+
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
 	of execution time efficiency. */
 
+	#if ( configUSE_MUTEXES == 1 )
+	{
+		/* Try the mutex fast path first.  The generic code below is only
+		needed if the mutex is already held and the caller is prepared to
+		block, as that is when the holder might need to inherit a priority
+		and the event list must be used. */
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xJustPeeking == pdFALSE ) )
+		{
+			if( prvTakeMutex( pxQueue ) != pdFAIL )
+			{
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return errQUEUE_EMPTY;
+			}
+			else
+			{
+				#if ( configRECORD_MUTEX_CONTENTION == 1 )
+				{
+					/* The wait is timed from here, so includes the time spent
+					in the generic code below as well as the time blocked. */
+					queueGET_MUTEX_TIME( ulMutexWaitStart );
+					xMutexWaitStarted = pdTRUE;
+				}
+				#endif
+			}
+		}
+	}
+	#endif
+
 	for( ;; )
 	{
 		taskENTER_CRITICAL();
@@ -971,6 +2520,7 @@ signed char *pcOriginalReadPosition;
 
 					/* We are actually removing data. */
 					--( pxQueue->uxMessagesWaiting );
+					prvRecordItemsReceived( pxQueue, 1U );
 
 					#if ( configUSE_MUTEXES == 1 )
 					{
@@ -978,14 +2528,24 @@ signed char *pcOriginalReadPosition;
 						{
 							/* Record the information required to implement
 							priority inheritance should it become necessary. */
-							pxQueue->pxMutexHolder = xTaskGetCurrentTaskHandle();
+							pxQueue->pxMutexHolder = pvTaskIncrementMutexHeldCount();
+							prvRecordMutexTaken( pxQueue );
+						}
+					}
+					#endif
+
+					#if ( configRECORD_MUTEX_CONTENTION == 1 )
+					{
+						if( xMutexWaitStarted != pdFALSE )
+						{
+							prvRecordMutexWait( pxQueue, ulMutexWaitStart );
 						}
 					}
 					#endif
 
-					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+					if( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) == pdTRUE )
+						if( prvWakeSender( pxQueue ) == pdTRUE )
 						{
 							portYIELD_WITHIN_API();
 						}
@@ -1001,11 +2561,11 @@ signed char *pcOriginalReadPosition;
 
 					/* The data is being left in the queue, so see if there are
 					any other tasks waiting for the data. */
-					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
 					{
 						/* Tasks that are removed from the event list will get added to
 						the pending ready list as the scheduler is still suspended. */
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						if( prvWakeReceiver( pxQueue ) != pdFALSE )
 						{
 							/* The task waiting has a higher priority than this task. */
 							portYIELD_WITHIN_API();
@@ -1023,6 +2583,15 @@ signed char *pcOriginalReadPosition;
 				{
 					/* The queue was empty and no block time is specified (or
 					the block time has expired) so leave now. */
+					#if ( configRECORD_MUTEX_CONTENTION == 1 )
+					{
+						if( xMutexWaitStarted != pdFALSE )
+						{
+							prvRecordMutexWait( pxQueue, ulMutexWaitStart );
+						}
+					}
+					#endif
+
 					taskEXIT_CRITICAL();
 					traceQUEUE_RECEIVE_FAILED( pxQueue );
 					return errQUEUE_EMPTY;
@@ -1055,21 +2624,34 @@ signed char *pcOriginalReadPosition;
 				{
 					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 					{
-						portENTER_CRITICAL();
+						taskENTER_CRITICAL();
 						{
-							vTaskPriorityInherit( ( void * ) pxQueue->pxMutexHolder );
+							if( prvInheritPriority( pxQueue ) != pdFALSE )
+							{
+								xInheritanceOccurred = pdTRUE;
+							}
+							vTaskSetMutexBlockedOn( ( void * ) pxQueue );
 						}
-						portEXIT_CRITICAL();
+						taskEXIT_CRITICAL();
 					}
 				}
 				#endif
 
-				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
 				{
 					portYIELD_WITHIN_API();
 				}
+
+				#if ( configUSE_MUTEXES == 1 )
+				{
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						vTaskSetMutexBlockedOn( NULL );
+					}
+				}
+				#endif
 			}
 			else
 			{
@@ -1082,6 +2664,39 @@ signed char *pcOriginalReadPosition;
 		{
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
+
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				/* If this task raised the priority of the mutex holder then
+				the holder no longer needs to run at that priority on its
+				behalf. */
+				if( xInheritanceOccurred != pdFALSE )
+				{
+					taskENTER_CRITICAL();
+					{
+						if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0 )
+						{
+							prvDisinheritPriorityAfterTimeout( pxQueue );
+						}
+					}
+					taskEXIT_CRITICAL();
+				}
+			}
+			#endif
+
+			#if ( configRECORD_MUTEX_CONTENTION == 1 )
+			{
+				if( xMutexWaitStarted != pdFALSE )
+				{
+					taskENTER_CRITICAL();
+					{
+						prvRecordMutexWait( pxQueue, ulMutexWaitStart );
+					}
+					taskEXIT_CRITICAL();
+				}
+			}
+			#endif
+
 			traceQUEUE_RECEIVE_FAILED( pxQueue );
 			return errQUEUE_EMPTY;
 		}
@@ -1098,7 +2713,7 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 	configASSERT( pxTaskWoken );
 	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		/* We cannot block from an ISR, so check there is data available. */
 		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
@@ -1107,15 +2722,16 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 
 			prvCopyDataFromQueue( pxQueue, pvBuffer );
 			--( pxQueue->uxMessagesWaiting );
+			prvRecordItemsReceived( pxQueue, 1U );
 
 			/* If the queue is locked we will not modify the event list.  Instead
 			we update the lock count so the task that unlocks the queue will know
 			that an ISR has removed data while the queue was locked. */
 			if( pxQueue->xRxLock == queueUNLOCKED )
 			{
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				if( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					if( prvWakeSender( pxQueue ) != pdFALSE )
 					{
 						/* The task waiting has a higher priority than us so
 						force a context switch. */
@@ -1138,129 +2754,1209 @@ unsigned portBASE_TYPE uxSavedInterruptStatus;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue )
+signed portBASE_TYPE xQueuePeekFromISR( xQueueHandle pxQueue, void * const pvBuffer )
 {
-unsigned portBASE_TYPE uxReturn;
+signed portBASE_TYPE xReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+signed char *pcOriginalReadPosition;
 
 	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
 
-	taskENTER_CRITICAL();
-		uxReturn = pxQueue->uxMessagesWaiting;
-	taskEXIT_CRITICAL();
+	/* Semaphores hold no data to peek. */
+	configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
 
-	return uxReturn;
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+		{
+			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+			/* The item is not removed, so remember the read position and
+			restore it once the data has been copied.  No task can be waiting
+			to send as a result, so the event lists are left alone. */
+			pcOriginalReadPosition = pxQueue->pcReadFrom;
+			prvCopyDataFromQueue( pxQueue, pvBuffer );
+			pxQueue->pcReadFrom = pcOriginalReadPosition;
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue )
+unsigned portBASE_TYPE uxQueueSendMultiple( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, portTickType xTicksToWait )
 {
-unsigned portBASE_TYPE uxReturn;
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxSent = 0U, uxCount;
 
 	configASSERT( pxQueue );
+	configASSERT( !( ( pvItemsToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
 
-	uxReturn = pxQueue->uxMessagesWaiting;
+	/* Giving a mutex requires the priority disinheritance performed by
+	xQueueGenericSend(). */
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
 
-	return uxReturn;
-}
-/*-----------------------------------------------------------*/
+	/* As xQueueGenericSend(), but each pass through the loop writes as many
+	items as there is space for, so a batch costs one critical section and one
+	walk of the event list for however many items fit. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			if( uxCount > ( uxItemCount - uxSent ) )
+			{
+				uxCount = uxItemCount - uxSent;
+			}
 
-void vQueueDelete( xQueueHandle pxQueue )
-{
-	configASSERT( pxQueue );
+			if( uxCount > ( unsigned portBASE_TYPE ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvCopyItemsToQueue( pxQueue, &( ( ( const signed char * ) pvItemsToQueue )[ uxSent * pxQueue->uxItemSize ] ), uxCount );
+				uxSent += uxCount;
 
-	traceQUEUE_DELETE( pxQueue );
-	vQueueUnregisterQueue( pxQueue );
-	vPortFree( pxQueue->pcHead );
-	vPortFree( pxQueue );
-}
-/*-----------------------------------------------------------*/
+				if( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE )
+				{
+					/* Yes it is ok to do this from within the critical section
+					- the kernel takes care of that. */
+					portYIELD_WITHIN_API();
+				}
+			}
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+			if( ( uxSent == uxItemCount ) || ( xTicksToWait == ( portTickType ) 0 ) )
+			{
+				/* Either all the items have been sent, or the queue is full
+				and no block time is specified (or the block time has
+				expired). */
+				if( uxSent < uxItemCount )
+				{
+					prvRecordSendFailed( pxQueue );
+				}
 
-	unsigned char ucQueueGetQueueNumber( xQueueHandle pxQueue )
-	{
-		return pxQueue->ucQueueNumber;
-	}
+				taskEXIT_CRITICAL();
 
-#endif
-/*-----------------------------------------------------------*/
+				if( uxSent < uxItemCount )
+				{
+					traceQUEUE_SEND_FAILED( pxQueue );
+				}
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+				return uxSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
 
-	void vQueueSetQueueNumber( xQueueHandle pxQueue, unsigned char ucQueueNumber )
-	{
-		pxQueue->ucQueueNumber = ucQueueNumber;
-	}
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-#endif
-/*-----------------------------------------------------------*/
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired.  Return the number of items that were
+			sent before it did. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
 
-	unsigned char ucQueueGetQueueType( xQueueHandle pxQueue )
-	{
-		return pxQueue->ucQueueType;
-	}
+			#if ( configUSE_TRACE_FACILITY == 1 )
+			{
+				taskENTER_CRITICAL();
+				{
+					prvRecordSendFailed( pxQueue );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return uxSent;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueSendMultipleFromISR( xQueueHandle pxQueue, const void * const pvItemsToQueue, unsigned portBASE_TYPE uxItemCount, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxCount, uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pxHigherPriorityTaskWoken );
+	configASSERT( !( ( pvItemsToQueue == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		if( uxCount > uxItemCount )
+		{
+			uxCount = uxItemCount;
+		}
+
+		if( uxCount > ( unsigned portBASE_TYPE ) 0 )
+		{
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyItemsToQueue( pxQueue, ( const signed char * ) pvItemsToQueue, uxCount );
+
+			/* If the queue is locked the event list is not altered.  The lock
+			count is increased by the number of items instead, so the task that
+			unlocks the queue can unblock a task for each. */
+			if( pxQueue->xTxLock == queueUNLOCKED )
+			{
+				if( prvUnblockReceivers( pxQueue, uxCount ) != pdFALSE )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+			}
+			else
+			{
+				pxQueue->xTxLock += ( signed portBASE_TYPE ) uxCount;
+			}
+		}
+
+		if( uxCount < uxItemCount )
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+			prvRecordSendFailed( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueReceiveMultiple( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, portTickType xTicksToWait )
+{
+signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+xTimeOutType xTimeOut;
+unsigned portBASE_TYPE uxCount;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+
+	/* Taking a mutex requires the priority inheritance performed by
+	xQueueGenericReceive(). */
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+	if( uxMaxItems == ( unsigned portBASE_TYPE ) 0 )
+	{
+		return 0U;
+	}
+
+	/* As xQueueGenericReceive(), but as soon as any items are available as
+	many as will fit in pvBuffer are removed in one go. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxCount = pxQueue->uxMessagesWaiting;
+
+			if( uxCount > ( unsigned portBASE_TYPE ) 0 )
+			{
+				if( uxCount > uxMaxItems )
+				{
+					uxCount = uxMaxItems;
+				}
+
+				traceQUEUE_RECEIVE( pxQueue );
+				prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxCount );
+
+				if( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxCount;
+			}
+			else
+			{
+				if( xTicksToWait == ( portTickType ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0U;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+			traceQUEUE_RECEIVE_FAILED( pxQueue );
+			return 0U;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueReceiveMultipleFromISR( xQueueHandle pxQueue, void * const pvBuffer, unsigned portBASE_TYPE uxMaxItems, signed portBASE_TYPE *pxTaskWoken )
+{
+unsigned portBASE_TYPE uxCount, uxSavedInterruptStatus;
+
+	configASSERT( pxQueue );
+	configASSERT( pxTaskWoken );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxCount = pxQueue->uxMessagesWaiting;
+		if( uxCount > uxMaxItems )
+		{
+			uxCount = uxMaxItems;
+		}
+
+		if( uxCount > ( unsigned portBASE_TYPE ) 0 )
+		{
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyItemsFromQueue( pxQueue, ( signed char * ) pvBuffer, uxCount );
+
+			if( pxQueue->xRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockSenders( pxQueue, uxCount ) != pdFALSE )
+				{
+					*pxTaskWoken = pdTRUE;
+				}
+			}
+			else
+			{
+				pxQueue->xRxLock += ( signed portBASE_TYPE ) uxCount;
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueReserveSlot( xQueueHandle pxQueue, portTickType xTicksToWait )
+	{
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		return prvAcquireSlot( pxQueue, pdTRUE, xTicksToWait );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void vQueueCommitSlot( xQueueHandle pxQueue )
+	{
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			/* The item is already in place, so committing it only has to
+			publish it. */
+			configASSERT( pxQueue->pcReservedSlot == pxQueue->pcWriteTo );
+			pxQueue->pcReservedSlot = NULL;
+
+			traceQUEUE_SEND( pxQueue );
+
+			pxQueue->pcWriteTo += pxQueue->uxItemSize;
+			if( pxQueue->pcWriteTo >= pxQueue->pcTail )
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+			++( pxQueue->uxMessagesWaiting );
+			prvRecordItemsSent( pxQueue, 1U );
+
+			if( prvUnblockReceivers( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+
+			/* Another task may be waiting to reserve a slot, which it can do
+			now if there is still space. */
+			if( prvIsSlotAvailable( pxQueue, pdTRUE ) != pdFALSE )
+			{
+				if( prvUnblockSenders( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueBorrowSlot( xQueueHandle pxQueue, portTickType xTicksToWait )
+	{
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0U );
+
+		return prvAcquireSlot( pxQueue, pdFALSE, xTicksToWait );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void vQueueReleaseSlot( xQueueHandle pxQueue )
+	{
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxQueue->pcBorrowedSlot != NULL );
+			pxQueue->pcBorrowedSlot = NULL;
+
+			/* The slot can now be written to again. */
+			if( prvUnblockSenders( pxQueue, ( unsigned portBASE_TYPE ) 1U ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+
+			/* If more items are waiting then another task can borrow the next
+			one.  The items have already been posted to the queue set, if
+			any, when they were committed. */
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 )
+			{
+				if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+				{
+					if( prvWakeReceiver( pxQueue ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueMessagesWaiting( const xQueueHandle pxQueue )
+{
+unsigned portBASE_TYPE uxReturn;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+		uxReturn = pxQueue->uxMessagesWaiting;
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueSpacesAvailable( const xQueueHandle pxQueue )
+{
+unsigned portBASE_TYPE uxReturn;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxQueueMessagesWaitingFromISR( const xQueueHandle pxQueue )
+{
+unsigned portBASE_TYPE uxReturn;
+
+	configASSERT( pxQueue );
+
+	uxReturn = pxQueue->uxMessagesWaiting;
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( xQueueHandle pxQueue )
+{
+	configASSERT( pxQueue );
+
+	traceQUEUE_DELETE( pxQueue );
+	vQueueUnregisterQueue( pxQueue );
+
+	/* Memory supplied by the application to one of the static creation
+	functions is not freed.  The storage area of a dynamically allocated queue
+	is part of the same block as the queue structure. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		#if ( configUSE_QUEUE_CACHE == 1 )
+			if( prvQueueCachePut( pxQueue ) == pdFAIL )
+		#endif
+		{
+			vPortFree( pxQueue );
+		}
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxQueue->ucStaticallyAllocated == pdFALSE )
+		{
+			#if ( configUSE_QUEUE_CACHE == 1 )
+				if( prvQueueCachePut( pxQueue ) == pdFAIL )
+			#endif
+			{
+				vPortFree( pxQueue );
+			}
+		}
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+
+	static unsigned portBASE_TYPE prvQueueCacheClass( size_t xStorageSize )
+	{
+	unsigned portBASE_TYPE uxClass = 0U;
+
+		while( ( uxClass < queueCACHE_NO_STORAGE ) && ( xStorageSize > queueCACHE_CLASS_STORAGE( uxClass ) ) )
+		{
+			uxClass++;
+		}
+
+		if( uxClass == queueCACHE_NO_STORAGE )
+		{
+			uxClass = queueCACHE_NOT_CACHED;
+		}
+
+		return uxClass;
+	}
+
+#endif /* configUSE_QUEUE_CACHE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+
+	static xQUEUE *prvQueueCacheTake( unsigned portBASE_TYPE uxClass )
+	{
+	xQUEUE *pxQueue = NULL;
+
+		if( uxClass != queueCACHE_NOT_CACHED )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue = pxQueueCache[ uxClass ];
+
+				if( pxQueue != NULL )
+				{
+					pxQueueCache[ uxClass ] = ( xQUEUE * ) pxQueue->pcWriteTo;
+					( uxQueueCacheCount[ uxClass ] )--;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return pxQueue;
+	}
+
+#endif /* configUSE_QUEUE_CACHE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+
+	static portBASE_TYPE prvQueueCachePut( xQUEUE *pxQueue )
+	{
+	unsigned portBASE_TYPE uxClass;
+	portBASE_TYPE xReturn = pdFAIL;
+
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			uxClass = queueCACHE_NO_STORAGE;
+		}
+		else
+		{
+			uxClass = prvQueueCacheClass( ( size_t ) ( pxQueue->uxLength * pxQueue->uxItemSize ) + ( size_t ) 1 );
+		}
+
+		if( uxClass != queueCACHE_NOT_CACHED )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( uxQueueCacheCount[ uxClass ] < ( unsigned portBASE_TYPE ) configQUEUE_CACHE_DEPTH )
+				{
+					pxQueue->pcWriteTo = ( signed char * ) pxQueueCache[ uxClass ];
+					pxQueueCache[ uxClass ] = pxQueue;
+					( uxQueueCacheCount[ uxClass ] )++;
+					xReturn = pdPASS;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_CACHE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CACHE == 1 )
+
+	void vQueueCacheFlush( void )
+	{
+	unsigned portBASE_TYPE uxClass;
+	xQUEUE *pxQueue;
+
+		for( uxClass = 0U; uxClass <= queueCACHE_NO_STORAGE; uxClass++ )
+		{
+			/* The queues are freed one at a time so the critical section is
+			kept short. */
+			do
+			{
+				pxQueue = prvQueueCacheTake( uxClass );
+
+				if( pxQueue != NULL )
+				{
+					vPortFree( pxQueue );
+				}
+			} while( pxQueue != NULL );
+		}
+	}
+
+#endif /* configUSE_QUEUE_CACHE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	unsigned char ucQueueGetQueueNumber( xQueueHandle pxQueue )
+	{
+		return pxQueue->ucQueueNumber;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueSetQueueNumber( xQueueHandle pxQueue, unsigned char ucQueueNumber )
+	{
+		pxQueue->ucQueueNumber = ucQueueNumber;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	unsigned char ucQueueGetQueueType( xQueueHandle pxQueue )
+	{
+		return pxQueue->ucQueueType;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueGetInfo( xQueueHandle pxQueue, xQueueStatusType *pxQueueStatus )
+	{
+		configASSERT( pxQueue );
+		configASSERT( pxQueueStatus );
+
+		pxQueueStatus->xHandle = pxQueue;
+		pxQueueStatus->pcQueueName = NULL;
+		pxQueueStatus->ucQueueNumber = pxQueue->ucQueueNumber;
+		pxQueueStatus->ucQueueType = pxQueue->ucQueueType;
+		pxQueueStatus->uxLength = pxQueue->uxLength;
+
+		/* Take a consistent copy of the counters, which are updated from
+		interrupts as well as tasks. */
+		taskENTER_CRITICAL();
+		{
+			pxQueueStatus->uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+			pxQueueStatus->uxPeakMessagesWaiting = pxQueue->uxPeakMessagesWaiting;
+			pxQueueStatus->ulSendCount = pxQueue->ulSendCount;
+			pxQueueStatus->ulReceiveCount = pxQueue->ulReceiveCount;
+			pxQueueStatus->ulSendFailCount = pxQueue->ulSendFailCount;
+
+			#if ( configRECORD_MUTEX_CONTENTION == 1 )
+			{
+				pxQueueStatus->pvLastMutexHolder = pxQueue->pvLastMutexHolder;
+				pxQueueStatus->ulMutexTakeCount = pxQueue->ulMutexTakeCount;
+				pxQueueStatus->ulMutexContendedCount = pxQueue->ulMutexContendedCount;
+				pxQueueStatus->ulTotalMutexWait = pxQueue->ulTotalMutexWait;
+				pxQueueStatus->ulMaxMutexWait = pxQueue->ulMaxMutexWait;
+				pxQueueStatus->ulMaxMutexHold = pxQueue->ulMaxMutexHold;
+				memcpy( ( void * ) pxQueueStatus->ulMutexWaitHistogram, ( const void * ) pxQueue->ulMutexWaitHistogram, sizeof( pxQueueStatus->ulMutexWaitHistogram ) );
+				memcpy( ( void * ) pxQueueStatus->ulMutexHoldHistogram, ( const void * ) pxQueue->ulMutexHoldHistogram, sizeof( pxQueueStatus->ulMutexHoldHistogram ) );
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
+{
+	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
+	{
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				/* The mutex is no longer being held. */
+				prvRecordMutexGiven( pxQueue );
+				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
+				pxQueue->pxMutexHolder = NULL;
+			}
+		}
+		#endif
+	}
+	else if( xPosition == queueSEND_TO_BACK )
+	{
+		prvCopyItem( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, pxQueue->uxItemSize );
+		pxQueue->pcWriteTo += pxQueue->uxItemSize;
+		if( pxQueue->pcWriteTo >= pxQueue->pcTail )
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+	}
+	else
+	{
+		prvCopyItem( ( void * ) pxQueue->pcReadFrom, pvItemToQueue, pxQueue->uxItemSize );
+		pxQueue->pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->pcReadFrom < pxQueue->pcHead )
+		{
+			pxQueue->pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			/* The queue has a length of one, so writing to the front of it
+			has replaced the item it held, if any.  The count is incremented
+			below, so it ends up as one either way. */
+			if( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0U )
+			{
+				--( pxQueue->uxMessagesWaiting );
+			}
+		}
+	}
+
+	++( pxQueue->uxMessagesWaiting );
+	prvRecordItemsSent( pxQueue, 1U );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer )
+{
+	if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+	{
+		pxQueue->pcReadFrom += pxQueue->uxItemSize;
+		if( pxQueue->pcReadFrom >= pxQueue->pcTail )
+		{
+			pxQueue->pcReadFrom = pxQueue->pcHead;
+		}
+		prvCopyItem( ( void * ) pvBuffer, ( void * ) pxQueue->pcReadFrom, pxQueue->uxItemSize );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItem( void *pvDestination, const void *pvSource, unsigned portBASE_TYPE uxItemSize )
+{
+	if( uxItemSize == ( unsigned portBASE_TYPE ) sizeof( unsigned portBASE_TYPE ) )
+	{
+		if( ( ( ( size_t ) pvDestination | ( size_t ) pvSource ) & ( sizeof( unsigned portBASE_TYPE ) - 1U ) ) == 0U )
+		{
+			*( ( unsigned portBASE_TYPE * ) pvDestination ) = *( ( const unsigned portBASE_TYPE * ) pvSource );
+		}
+		else
+		{
+			portQUEUE_COPY( pvDestination, pvSource, uxItemSize );
+		}
+	}
+	else if( uxItemSize == ( unsigned portBASE_TYPE ) 1U )
+	{
+		*( ( unsigned char * ) pvDestination ) = *( ( const unsigned char * ) pvSource );
+	}
+	else
+	{
+		portQUEUE_COPY( pvDestination, pvSource, uxItemSize );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsToQueue( xQUEUE * const pxQueue, const signed char *pcItems, unsigned portBASE_TYPE uxCount )
+{
+size_t xBytes, xFirstBytes;
+
+	if( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0 )
+	{
+		xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+		/* Copy up to the end of the storage area first... */
+		xFirstBytes = ( size_t ) ( pxQueue->pcTail - pxQueue->pcWriteTo );
+		if( xBytes < xFirstBytes )
+		{
+			xFirstBytes = xBytes;
+		}
+		portQUEUE_COPY( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirstBytes );
+
+		if( xBytes > xFirstBytes )
+		{
+			/* ...then the remainder to the start of the storage area. */
+			portQUEUE_COPY( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xFirstBytes ] ), xBytes - xFirstBytes );
+			pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstBytes );
+		}
+		else
+		{
+			pxQueue->pcWriteTo += xFirstBytes;
+			if( pxQueue->pcWriteTo >= pxQueue->pcTail )
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+		}
+	}
+
+	pxQueue->uxMessagesWaiting += uxCount;
+	prvRecordItemsSent( pxQueue, uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( xQUEUE * const pxQueue, signed char *pcBuffer, unsigned portBASE_TYPE uxCount )
+{
+size_t xBytes, xFirstBytes;
+signed char *pcReadFrom;
+
+	if( pxQueue->uxItemSize != ( unsigned portBASE_TYPE ) 0 )
+	{
+		xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+		/* pcReadFrom points to the last item read, so the first item to copy
+		is the one after it. */
+		pcReadFrom = pxQueue->pcReadFrom + pxQueue->uxItemSize;
+		if( pcReadFrom >= pxQueue->pcTail )
+		{
+			pcReadFrom = pxQueue->pcHead;
+		}
+
+		xFirstBytes = ( size_t ) ( pxQueue->pcTail - pcReadFrom );
+		if( xBytes < xFirstBytes )
+		{
+			xFirstBytes = xBytes;
+		}
+		portQUEUE_COPY( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xFirstBytes );
+
+		if( xBytes > xFirstBytes )
+		{
+			portQUEUE_COPY( ( void * ) &( pcBuffer[ xFirstBytes ] ), ( const void * ) pxQueue->pcHead, xBytes - xFirstBytes );
+			pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstBytes );
+		}
+		else
+		{
+			pcReadFrom += xFirstBytes;
+		}
+
+		/* Leave pcReadFrom pointing at the last item copied out. */
+		pxQueue->pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+	}
+
+	pxQueue->uxMessagesWaiting -= uxCount;
+	prvRecordItemsReceived( pxQueue, uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUnblockReceivers( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The set holds one entry per item in its member queues, so post
+			the queue's handle once for each item.  No tasks wait on the queue
+			itself. */
+			while( uxCount > ( unsigned portBASE_TYPE ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+
+				--uxCount;
+			}
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	while( ( uxCount > ( unsigned portBASE_TYPE ) 0 ) && ( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE ) )
+	{
+		if( prvWakeReceiver( pxQueue ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+
+		--uxCount;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUnblockSenders( xQUEUE * const pxQueue, unsigned portBASE_TYPE uxCount )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	while( ( uxCount > ( unsigned portBASE_TYPE ) 0 ) && ( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE ) )
+	{
+		if( prvWakeSender( pxQueue ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+
+		--uxCount;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	static portBASE_TYPE prvPassOnSemaphoreUnits( xQUEUE * const pxQueue )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxCount = pxQueue->uxMessagesWaiting;
+
+		/* Only the event list is walked.  Had the semaphore been in a queue
+		set the units would already have been posted to the set, and no task
+		would be waiting on the semaphore itself. */
+		while( ( uxCount > ( unsigned portBASE_TYPE ) 0 ) && ( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE ) )
+		{
+			if( prvWakeReceiver( pxQueue ) != pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+
+			--uxCount;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+
+	static signed portBASE_TYPE prvWakeReceiver( const xQUEUE * const pxQueue )
+	{
+	signed portBASE_TYPE xReturn;
+
+		if( queueEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+		{
+			xReturn = queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			xReturn = xCoRoutineRemoveFromQueueEventList( &( pxQueue->xCoRoutinesWaitingToReceive ) );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_CO_ROUTINE_BRIDGE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+
+	static signed portBASE_TYPE prvWakeSender( const xQUEUE * const pxQueue )
+	{
+	signed portBASE_TYPE xReturn;
+
+		if( queueEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			xReturn = queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) );
+		}
+		else
+		{
+			xReturn = xCoRoutineRemoveFromQueueEventList( &( pxQueue->xCoRoutinesWaitingToSend ) );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_CO_ROUTINE_BRIDGE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+
+	static void prvWakeTaskFromCoRoutineISR( const xList * const pxEventList, signed portBASE_TYPE * const pxLock )
+	{
+		if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+		{
+			if( *pxLock == queueUNLOCKED )
+			{
+				( void ) xTaskRemoveFromEventList( pxEventList );
+			}
+			else
+			{
+				++( *pxLock );
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_CO_ROUTINE_BRIDGE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static portBASE_TYPE prvIsSlotAvailable( const xQUEUE * const pxQueue, portBASE_TYPE xForWriting )
+	{
+	portBASE_TYPE xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxSlotsInUse;
+
+		if( xForWriting != pdFALSE )
+		{
+			/* The borrowed slot has been removed from uxMessagesWaiting but
+			must not be written to until it has been released. */
+			uxSlotsInUse = pxQueue->uxMessagesWaiting;
+			if( pxQueue->pcBorrowedSlot != NULL )
+			{
+				++uxSlotsInUse;
+			}
+
+			if( ( pxQueue->pcReservedSlot == NULL ) && ( uxSlotsInUse < pxQueue->uxLength ) )
+			{
+				xReturn = pdTRUE;
+			}
+		}
+		else
+		{
+			if( ( pxQueue->pcBorrowedSlot == NULL ) && ( pxQueue->uxMessagesWaiting > ( unsigned portBASE_TYPE ) 0 ) )
+			{
+				xReturn = pdTRUE;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static void *prvAcquireSlot( xQUEUE * const pxQueue, portBASE_TYPE xForWriting, portTickType xTicksToWait )
+	{
+	signed portBASE_TYPE xEntryTimeSet = pdFALSE;
+	xTimeOutType xTimeOut;
+	signed char *pcSlot;
+	portBASE_TYPE xAvailable;
+
+		/* The same structure as xQueueGenericSend() and
+		xQueueGenericReceive(), but a pointer into the storage area is
+		returned in place of copying an item in or out. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( prvIsSlotAvailable( pxQueue, xForWriting ) != pdFALSE )
+				{
+					if( xForWriting != pdFALSE )
+					{
+						/* The slot is not visible to readers until it is
+						committed. */
+						pcSlot = pxQueue->pcWriteTo;
+						pxQueue->pcReservedSlot = pcSlot;
+					}
+					else
+					{
+						/* The item is removed from the queue now so the next
+						item can be received, but its slot is not freed until
+						the item is released. */
+						traceQUEUE_RECEIVE( pxQueue );
+
+						pcSlot = pxQueue->pcReadFrom + pxQueue->uxItemSize;
+						if( pcSlot >= pxQueue->pcTail )
+						{
+							pcSlot = pxQueue->pcHead;
+						}
+						pxQueue->pcReadFrom = pcSlot;
+						pxQueue->pcBorrowedSlot = pcSlot;
+						--( pxQueue->uxMessagesWaiting );
+						prvRecordItemsReceived( pxQueue, 1U );
+					}
+
+					taskEXIT_CRITICAL();
+					return ( void * ) pcSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( portTickType ) 0 )
+					{
+						if( xForWriting != pdFALSE )
+						{
+							prvRecordSendFailed( pxQueue );
+						}
+
+						taskEXIT_CRITICAL();
+
+						if( xForWriting != pdFALSE )
+						{
+							traceQUEUE_SEND_FAILED( pxQueue );
+						}
+						else
+						{
+							traceQUEUE_RECEIVE_FAILED( pxQueue );
+						}
+
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					xAvailable = prvIsSlotAvailable( pxQueue, xForWriting );
+				}
+				taskEXIT_CRITICAL();
+
+				if( xAvailable == pdFALSE )
+				{
+					if( xForWriting != pdFALSE )
+					{
+						traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+						queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					}
+					else
+					{
+						traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+						queuePLACE_ON_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					}
+
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
 
-#endif
-/*-----------------------------------------------------------*/
+				#if ( configUSE_TRACE_FACILITY == 1 )
+				{
+					if( xForWriting != pdFALSE )
+					{
+						taskENTER_CRITICAL();
+						{
+							prvRecordSendFailed( pxQueue );
+						}
+						taskEXIT_CRITICAL();
+					}
+				}
+				#endif
 
-static void prvCopyDataToQueue( xQUEUE *pxQueue, const void *pvItemToQueue, portBASE_TYPE xPosition )
-{
-	if( pxQueue->uxItemSize == ( unsigned portBASE_TYPE ) 0 )
-	{
-		#if ( configUSE_MUTEXES == 1 )
-		{
-			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-			{
-				/* The mutex is no longer being held. */
-				vTaskPriorityDisinherit( ( void * ) pxQueue->pxMutexHolder );
-				pxQueue->pxMutexHolder = NULL;
+				return NULL;
 			}
 		}
-		#endif
-	}
-	else if( xPosition == queueSEND_TO_BACK )
-	{
-		memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( unsigned ) pxQueue->uxItemSize );
-		pxQueue->pcWriteTo += pxQueue->uxItemSize;
-		if( pxQueue->pcWriteTo >= pxQueue->pcTail )
-		{
-			pxQueue->pcWriteTo = pxQueue->pcHead;
-		}
-	}
-	else
-	{
-		memcpy( ( void * ) pxQueue->pcReadFrom, pvItemToQueue, ( unsigned ) pxQueue->uxItemSize );
-		pxQueue->pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->pcReadFrom < pxQueue->pcHead )
-		{
-			pxQueue->pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
-		}
 	}
 
-	++( pxQueue->uxMessagesWaiting );
-}
-/*-----------------------------------------------------------*/
-
-static void prvCopyDataFromQueue( xQUEUE * const pxQueue, const void *pvBuffer )
-{
-	if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
-	{
-		pxQueue->pcReadFrom += pxQueue->uxItemSize;
-		if( pxQueue->pcReadFrom >= pxQueue->pcTail )
-		{
-			pxQueue->pcReadFrom = pxQueue->pcHead;
-		}
-		memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
-	}
-}
+#endif /* configUSE_ZERO_COPY_QUEUES */
 /*-----------------------------------------------------------*/
 
 static void prvUnlockQueue( xQueueHandle pxQueue )
@@ -1278,23 +3974,59 @@ static void prvUnlockQueue( xQueueHandle pxQueue )
 		{
 			/* Data was posted while the queue was locked.  Are any tasks
 			blocked waiting for data to become available? */
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			#if ( configUSE_QUEUE_SETS == 1 )
 			{
-				/* Tasks that are removed from the event list will get added to
-				the pending ready list as the scheduler is still suspended. */
-				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				if( pxQueue->pxQueueSetContainer != NULL )
 				{
-					/* The task waiting has a higher priority so record that a
-					context	switch is required. */
-					vTaskMissedYield();
+					if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) == pdTRUE )
+					{
+						/* The queue is a member of a queue set, and posting to
+						the queue set caused a higher priority task to unblock.
+						A context switch is required. */
+						vTaskMissedYield();
+					}
+				}
+				else
+				{
+					/* Tasks that are removed from the event list will get added
+					to the pending ready list as the scheduler is still
+					suspended. */
+					if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+					{
+						if( prvWakeReceiver( pxQueue ) != pdFALSE )
+						{
+							/* The task waiting has a higher priority so record
+							that a context switch is required. */
+							vTaskMissedYield();
+						}
+					}
+					else
+					{
+						break;
+					}
 				}
-
-				--( pxQueue->xTxLock );
 			}
-			else
+			#else /* configUSE_QUEUE_SETS */
 			{
-				break;
+				/* Tasks that are removed from the event list will get added to
+				the pending ready list as the scheduler is still suspended. */
+				if( queueHAS_WAITING_RECEIVERS( pxQueue ) != pdFALSE )
+				{
+					if( prvWakeReceiver( pxQueue ) != pdFALSE )
+					{
+						/* The task waiting has a higher priority so record that a
+						context	switch is required. */
+						vTaskMissedYield();
+					}
+				}
+				else
+				{
+					break;
+				}
 			}
+			#endif /* configUSE_QUEUE_SETS */
+
+			--( pxQueue->xTxLock );
 		}
 
 		pxQueue->xTxLock = queueUNLOCKED;
@@ -1306,9 +4038,9 @@ static void prvUnlockQueue( xQueueHandle pxQueue )
 	{
 		while( pxQueue->xRxLock > queueLOCKED_UNMODIFIED )
 		{
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			if( queueHAS_WAITING_SENDERS( pxQueue ) != pdFALSE )
 			{
-				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				if( prvWakeSender( pxQueue ) != pdFALSE )
 				{
 					vTaskMissedYield();
 				}
@@ -1377,6 +4109,9 @@ signed portBASE_TYPE xReturn;
 signed portBASE_TYPE xQueueCRSend( xQueueHandle pxQueue, const void *pvItemToQueue, portTickType xTicksToWait )
 {
 signed portBASE_TYPE xReturn;
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+	signed portBASE_TYPE xYieldRequired = pdFALSE;
+#endif
 
 	/* If the queue is already full we may have to block.  A critical section
 	is required to prevent an interrupt removing something from the queue
@@ -1391,12 +4126,13 @@ signed portBASE_TYPE xReturn;
 			{
 				/* As this is called from a coroutine we cannot block directly, but
 				return indicating that we need to block. */
-				vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
+				vCoRoutineAddToDelayedList( xTicksToWait, queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) );
 				portENABLE_INTERRUPTS();
 				return errQUEUE_BLOCKED;
 			}
 			else
 			{
+				prvRecordSendFailed( pxQueue );
 				portENABLE_INTERRUPTS();
 				return errQUEUE_FULL;
 			}
@@ -1415,27 +4151,48 @@ signed portBASE_TYPE xReturn;
 			xReturn = pdPASS;
 
 			/* Were any co-routines waiting for data to become available? */
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) ) == pdFALSE )
 			{
 				/* In this instance the co-routine could be placed directly
 				into the ready list as we are within a critical section.
 				Instead the same pending ready list mechanism is used as if
 				the event were caused from within an interrupt. */
-				if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				if( xCoRoutineRemoveFromEventList( queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) ) != pdFALSE )
 				{
 					/* The co-routine waiting has a higher priority so record
 					that a yield might be appropriate. */
 					xReturn = errQUEUE_YIELD;
 				}
 			}
+			#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+				else if( queueEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					/* A task is waiting instead.  Co-routines only run while
+					the scheduler is running, so the event list can be
+					accessed directly. */
+					xYieldRequired = queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToReceive ) );
+				}
+			#endif
 		}
 		else
 		{
+			prvRecordSendFailed( pxQueue );
 			xReturn = errQUEUE_FULL;
 		}
 	}
 	portENABLE_INTERRUPTS();
 
+	#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+	{
+		/* The task that runs the co-routines can be preempted now that
+		interrupts are enabled again. */
+		if( xYieldRequired != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+	#endif
+
 	return xReturn;
 }
 #endif
@@ -1445,6 +4202,9 @@ signed portBASE_TYPE xReturn;
 signed portBASE_TYPE xQueueCRReceive( xQueueHandle pxQueue, void *pvBuffer, portTickType xTicksToWait )
 {
 signed portBASE_TYPE xReturn;
+#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+	signed portBASE_TYPE xYieldRequired = pdFALSE;
+#endif
 
 	/* If the queue is already empty we may have to block.  A critical section
 	is required to prevent an interrupt adding something to the queue
@@ -1459,7 +4219,7 @@ signed portBASE_TYPE xReturn;
 			{
 				/* As this is a co-routine we cannot block directly, but return
 				indicating that we need to block. */
-				vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
+				vCoRoutineAddToDelayedList( xTicksToWait, queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) );
 				portENABLE_INTERRUPTS();
 				return errQUEUE_BLOCKED;
 			}
@@ -1485,22 +4245,29 @@ signed portBASE_TYPE xReturn;
 				pxQueue->pcReadFrom = pxQueue->pcHead;
 			}
 			--( pxQueue->uxMessagesWaiting );
-			memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+			prvRecordItemsReceived( pxQueue, 1U );
+			prvCopyItem( pvBuffer, ( void * ) pxQueue->pcReadFrom, pxQueue->uxItemSize );
 
 			xReturn = pdPASS;
 
 			/* Were any co-routines waiting for space to become available? */
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) ) == pdFALSE )
 			{
 				/* In this instance the co-routine could be placed directly
 				into the ready list as we are within a critical section.
 				Instead the same pending ready list mechanism is used as if
 				the event were caused from within an interrupt. */
-				if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				if( xCoRoutineRemoveFromEventList( queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) ) != pdFALSE )
 				{
 					xReturn = errQUEUE_YIELD;
 				}
 			}
+			#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+				else if( queueEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					xYieldRequired = queueREMOVE_FROM_EVENT_LIST( &( pxQueue->xTasksWaitingToSend ) );
+				}
+			#endif
 		}
 		else
 		{
@@ -1509,6 +4276,15 @@ signed portBASE_TYPE xReturn;
 	}
 	portENABLE_INTERRUPTS();
 
+	#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+	{
+		if( xYieldRequired != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+	#endif
+
 	return xReturn;
 }
 #endif
@@ -1525,19 +4301,32 @@ signed portBASE_TYPE xQueueCRSendFromISR( xQueueHandle pxQueue, const void *pvIt
 	{
 		prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
 
+		#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		{
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) ) != pdFALSE )
+			{
+				prvWakeTaskFromCoRoutineISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->xTxLock ) );
+			}
+		}
+		#endif
+
 		/* We only want to wake one co-routine per ISR, so check that a
 		co-routine has not already been woken. */
 		if( xCoRoutinePreviouslyWoken == pdFALSE )
 		{
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) ) == pdFALSE )
 			{
-				if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				if( xCoRoutineRemoveFromEventList( queueCO_ROUTINES_WAITING_TO_RECEIVE( pxQueue ) ) != pdFALSE )
 				{
 					return pdTRUE;
 				}
 			}
 		}
 	}
+	else
+	{
+		prvRecordSendFailed( pxQueue );
+	}
 
 	return xCoRoutinePreviouslyWoken;
 }
@@ -1560,13 +4349,23 @@ signed portBASE_TYPE xReturn;
 			pxQueue->pcReadFrom = pxQueue->pcHead;
 		}
 		--( pxQueue->uxMessagesWaiting );
-		memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+		prvRecordItemsReceived( pxQueue, 1U );
+		prvCopyItem( pvBuffer, ( void * ) pxQueue->pcReadFrom, pxQueue->uxItemSize );
+
+		#if ( configUSE_QUEUE_CO_ROUTINE_BRIDGE == 1 )
+		{
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) ) != pdFALSE )
+			{
+				prvWakeTaskFromCoRoutineISR( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->xRxLock ) );
+			}
+		}
+		#endif
 
 		if( ( *pxCoRoutineWoken ) == pdFALSE )
 		{
-			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+			if( listLIST_IS_EMPTY( queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) ) == pdFALSE )
 			{
-				if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+				if( xCoRoutineRemoveFromEventList( queueCO_ROUTINES_WAITING_TO_SEND( pxQueue ) ) != pdFALSE )
 				{
 					*pxCoRoutineWoken = pdTRUE;
 				}
@@ -1585,47 +4384,100 @@ signed portBASE_TYPE xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
-#if configQUEUE_REGISTRY_SIZE > 0
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_NAME_REGISTRY == 1 )
 
 	void vQueueAddToRegistry( xQueueHandle xQueue, signed char *pcQueueName )
 	{
-	unsigned portBASE_TYPE ux;
-
-		/* See if there is an empty space in the registry.  A NULL name denotes
-		a free slot. */
-		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		#if ( configQUEUE_REGISTRY_SIZE > 0 )
 		{
-			if( xQueueRegistry[ ux ].pcQueueName == NULL )
+		unsigned portBASE_TYPE ux;
+
+			/* See if there is an empty space in the registry.  A NULL name denotes
+			a free slot. */
+			for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
 			{
-				/* Store the information on this queue. */
-				xQueueRegistry[ ux ].pcQueueName = pcQueueName;
-				xQueueRegistry[ ux ].xHandle = xQueue;
-				break;
+				if( xQueueRegistry[ ux ].pcQueueName == NULL )
+				{
+					/* Store the information on this queue. */
+					xQueueRegistry[ ux ].pcQueueName = pcQueueName;
+					xQueueRegistry[ ux ].xHandle = xQueue;
+
+					traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+					break;
+				}
 			}
 		}
+		#endif
+
+		#if ( configUSE_NAME_REGISTRY == 1 )
+		{
+			( void ) xNameRegistryAdd( pcQueueName, ( void * ) xQueue, nameregTYPE_QUEUE );
+		}
+		#endif
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if configQUEUE_REGISTRY_SIZE > 0
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) || ( configUSE_NAME_REGISTRY == 1 )
 
 	static void vQueueUnregisterQueue( xQueueHandle xQueue )
 	{
-	unsigned portBASE_TYPE ux;
+		#if ( configQUEUE_REGISTRY_SIZE > 0 )
+		{
+		unsigned portBASE_TYPE ux;
+
+			/* See if the handle of the queue being unregistered in actually in the
+			registry. */
+			for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+			{
+				if( xQueueRegistry[ ux ].xHandle == xQueue )
+				{
+					/* Set the name to NULL to show that this slot if free again. */
+					xQueueRegistry[ ux ].pcQueueName = NULL;
+					break;
+				}
+			}
+		}
+		#endif
+
+		#if ( configUSE_NAME_REGISTRY == 1 )
+		{
+			/* The queue may have been registered under more than one name, so
+			no name is given and every entry for it is removed. */
+			vNameRegistryRemove( NULL, ( void * ) xQueue );
+		}
+		#endif
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 )
+
+	unsigned portBASE_TYPE uxQueueGetSystemState( xQueueStatusType *pxQueueStatusArray, unsigned portBASE_TYPE uxArraySize )
+	{
+	unsigned portBASE_TYPE ux, uxQueues = 0U;
 
-		/* See if the handle of the queue being unregistered in actually in the
-		registry. */
-		for( ux = ( unsigned portBASE_TYPE ) 0U; ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE; ux++ )
+		configASSERT( pxQueueStatusArray );
+
+		/* The scheduler is suspended so no task can add a queue to, or
+		delete a queue from, the registry while it is being walked. */
+		vTaskSuspendAll();
 		{
-			if( xQueueRegistry[ ux ].xHandle == xQueue )
+			for( ux = ( unsigned portBASE_TYPE ) 0U; ( ux < ( unsigned portBASE_TYPE ) configQUEUE_REGISTRY_SIZE ) && ( uxQueues < uxArraySize ); ux++ )
 			{
-				/* Set the name to NULL to show that this slot if free again. */
-				xQueueRegistry[ ux ].pcQueueName = NULL;
-				break;
+				if( xQueueRegistry[ ux ].pcQueueName != NULL )
+				{
+					vQueueGetInfo( xQueueRegistry[ ux ].xHandle, &( pxQueueStatusArray[ uxQueues ] ) );
+					pxQueueStatusArray[ uxQueues ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+					uxQueues++;
+				}
 			}
 		}
+		( void ) xTaskResumeAll();
 
+		return uxQueues;
 	}
 
 #endif
@@ -1653,10 +4505,179 @@ signed portBASE_TYPE xReturn;
 		if( pxQueue->uxMessagesWaiting == ( unsigned portBASE_TYPE ) 0U )
 		{
 			/* There is nothing in the queue, block for the specified period. */
-			vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+			queuePLACE_ON_EVENT_LIST_RESTRICTED( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
 		}
 		prvUnlockQueue( pxQueue );
 	}
 
 #endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xQueueHandle xQueueCreateSet( unsigned portBASE_TYPE uxEventQueueLength )
+	{
+	xQueueHandle pxQueue;
+
+		/* A queue set is a queue that holds the handles of the member queues
+		and semaphores that contain data. */
+		pxQueue = xQueueGenericCreate( uxEventQueueLength, sizeof( xQUEUE * ), queueQUEUE_TYPE_SET );
+
+		return pxQueue;
+	}
+
+#endif /* configUSE_QUEUE_SETS && configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueAddToSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( xQueueOrSemaphore );
+		configASSERT( xQueueSet );
+
+		taskENTER_CRITICAL();
+		{
+			if( xQueueOrSemaphore->pxQueueSetContainer != NULL )
+			{
+				/* Cannot add a queue/semaphore to more than one queue set. */
+				xReturn = pdFAIL;
+			}
+			else if( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0U )
+			{
+				/* Cannot add a queue/semaphore to a queue set if there are
+				already items in the queue/semaphore, as the set would never
+				be told about them. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				xQueueOrSemaphore->pxQueueSetContainer = xQueueSet;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	portBASE_TYPE xQueueRemoveFromSet( xQueueHandle xQueueOrSemaphore, xQueueHandle xQueueSet )
+	{
+	portBASE_TYPE xReturn;
+
+		configASSERT( xQueueOrSemaphore );
+
+		taskENTER_CRITICAL();
+		{
+			if( xQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
+			{
+				/* The queue was not a member of the set. */
+				xReturn = pdFAIL;
+			}
+			else if( xQueueOrSemaphore->uxMessagesWaiting != ( unsigned portBASE_TYPE ) 0U )
+			{
+				/* It is dangerous to remove a queue from a set when the queue
+				is not empty because the queue set will still hold pending
+				events for the queue. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				/* The queue is no longer contained in the set. */
+				xQueueOrSemaphore->pxQueueSetContainer = NULL;
+				xReturn = pdPASS;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSet( xQueueHandle xQueueSet, portTickType xBlockTimeTicks )
+	{
+	xQueueHandle xReturn = NULL;
+
+		( void ) xQueueGenericReceive( xQueueSet, &xReturn, xBlockTimeTicks, pdFALSE );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	xQueueHandle xQueueSelectFromSetFromISR( xQueueHandle xQueueSet )
+	{
+	xQueueHandle xReturn = NULL;
+	signed portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Tasks do not block to send to a queue set, so reading from the set
+		cannot unblock a task and xHigherPriorityTaskWoken can be ignored. */
+		( void ) xQueueReceiveFromISR( xQueueSet, &xReturn, &xHigherPriorityTaskWoken );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	static portBASE_TYPE prvNotifyQueueSetContainer( const xQUEUE * const pxQueue, portBASE_TYPE xCopyPosition )
+	{
+	xQUEUE *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		/* This function must be called from a critical section, or with
+		interrupts masked when called from an ISR. */
+
+		configASSERT( pxQueueSetContainer );
+
+		/* The set should always be long enough to hold one entry per item in
+		its member queues.  If it is not then the event is lost. */
+		configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+
+		if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+		{
+			traceQUEUE_SEND( pxQueueSetContainer );
+
+			/* The data copied is the handle of the queue that contains data. */
+			prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, xCopyPosition );
+
+			if( pxQueueSetContainer->xTxLock == queueUNLOCKED )
+			{
+				if( queueEVENT_LIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+				{
+					if( queueREMOVE_FROM_EVENT_LIST( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						/* The task waiting has a higher priority */
+						xReturn = pdTRUE;
+					}
+				}
+			}
+			else
+			{
+				/* The set is locked by a task that is part way through
+				blocking on it.  Increment the lock count so the task that
+				unlocks the set knows that data was posted while it was
+				locked. */
+				++( pxQueueSetContainer->xTxLock );
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
 
@@ -0,0 +1,503 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "read_write_lock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if configUSE_MUTEXES != 1
+	#error configUSE_MUTEXES must be set to 1 in FreeRTOSConfig.h to use read/write locks.
+#endif
+
+/* The definition of a read/write lock.  The members are only accessed from
+within a critical section (or with interrupts masked), including when tasks
+are added to or removed from the event lists, so the lock can be taken for
+reading and released from interrupts. */
+typedef struct ReadWriteLockDefinition
+{
+	unsigned portBASE_TYPE uxReaders;			/*< The number of tasks and interrupts holding the lock for reading. */
+	void *pvWriter;								/*< The task holding the lock for writing, or NULL if the lock is not held for writing. */
+	unsigned portBASE_TYPE uxWritersWaiting;	/*< The number of writers waiting for the lock, including any that have been unblocked but have not run yet.  Readers are kept out while this is not zero. */
+	xList xTasksWaitingToRead;					/*< List of readers waiting for the lock.  Stored in priority order. */
+	xList xTasksWaitingToWrite;					/*< List of writers waiting for the lock.  Stored in priority order. */
+} xREAD_WRITE_LOCK;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The blocking part of xReadWriteLockTakeRead() and xReadWriteLockTakeWrite().
+ */
+static portBASE_TYPE prvTakeLock( xREAD_WRITE_LOCK * const pxLock, const portBASE_TYPE xForWriting, portTickType xTicksToWait );
+
+/*
+ * Returns pdTRUE if the lock can be taken for reading or for writing now.
+ * Must be called from a critical section.
+ */
+static portBASE_TYPE prvIsLockAvailable( const xREAD_WRITE_LOCK * const pxLock, const portBASE_TYPE xForWriting );
+
+/*
+ * Called from a critical section when the lock is no longer held.  Unblocks
+ * the highest priority waiting writer if there is one, otherwise unblocks all
+ * the waiting readers, provided no unblocked writer is yet to run.  Returns
+ * pdTRUE if a task with a priority above the calling task was unblocked.
+ */
+static portBASE_TYPE prvUnblockWaitingTasks( xREAD_WRITE_LOCK * const pxLock );
+
+/*
+ * Returns the priority of the highest priority task waiting for the lock,
+ * either to read or to write, or tskIDLE_PRIORITY if there are none.
+ */
+static unsigned portBASE_TYPE prvGetHighestWaitingPriority( const xREAD_WRITE_LOCK * const pxLock );
+
+/*-----------------------------------------------------------*/
+
+xReadWriteLockHandle xReadWriteLockCreate( void )
+{
+xREAD_WRITE_LOCK *pxLock;
+
+	pxLock = ( xREAD_WRITE_LOCK * ) pvPortMalloc( sizeof( xREAD_WRITE_LOCK ) );
+	if( pxLock != NULL )
+	{
+		pxLock->uxReaders = ( unsigned portBASE_TYPE ) 0U;
+		pxLock->pvWriter = NULL;
+		pxLock->uxWritersWaiting = ( unsigned portBASE_TYPE ) 0U;
+		vListInitialise( &( pxLock->xTasksWaitingToRead ) );
+		vListInitialise( &( pxLock->xTasksWaitingToWrite ) );
+		traceREAD_WRITE_LOCK_CREATE( pxLock );
+	}
+	else
+	{
+		traceREAD_WRITE_LOCK_CREATE_FAILED();
+	}
+
+	return ( xReadWriteLockHandle ) pxLock;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockTakeRead( xReadWriteLockHandle xLock, portTickType xTicksToWait )
+{
+	configASSERT( xLock );
+
+	return prvTakeLock( ( xREAD_WRITE_LOCK * ) xLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockTakeWrite( xReadWriteLockHandle xLock, portTickType xTicksToWait )
+{
+	configASSERT( xLock );
+
+	return prvTakeLock( ( xREAD_WRITE_LOCK * ) xLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockGiveRead( xReadWriteLockHandle xLock )
+{
+xREAD_WRITE_LOCK * const pxLock = ( xREAD_WRITE_LOCK * ) xLock;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( xLock );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxLock->uxReaders > ( unsigned portBASE_TYPE ) 0U )
+		{
+			traceREAD_WRITE_LOCK_GIVE( pxLock, pdFALSE );
+
+			( pxLock->uxReaders )--;
+
+			if( pxLock->uxReaders == ( unsigned portBASE_TYPE ) 0U )
+			{
+				if( prvUnblockWaitingTasks( pxLock ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockGiveWrite( xReadWriteLockHandle xLock )
+{
+xREAD_WRITE_LOCK * const pxLock = ( xREAD_WRITE_LOCK * ) xLock;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( xLock );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxLock->pvWriter == xTaskGetCurrentTaskHandle() )
+		{
+			traceREAD_WRITE_LOCK_GIVE( pxLock, pdTRUE );
+
+			/* The lock is no longer held for writing. */
+			vTaskPriorityDisinherit( pxLock->pvWriter );
+			pxLock->pvWriter = NULL;
+
+			if( prvUnblockWaitingTasks( pxLock ) != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockTakeReadFromISR( xReadWriteLockHandle xLock )
+{
+xREAD_WRITE_LOCK * const pxLock = ( xREAD_WRITE_LOCK * ) xLock;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn;
+
+	configASSERT( xLock );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( prvIsLockAvailable( pxLock, pdFALSE ) != pdFALSE )
+		{
+			traceREAD_WRITE_LOCK_TAKE( pxLock, pdFALSE );
+			( pxLock->uxReaders )++;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			traceREAD_WRITE_LOCK_TAKE_FAILED( pxLock, pdFALSE );
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xReadWriteLockGiveReadFromISR( xReadWriteLockHandle xLock, portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xREAD_WRITE_LOCK * const pxLock = ( xREAD_WRITE_LOCK * ) xLock;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( xLock );
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( pxLock->uxReaders > ( unsigned portBASE_TYPE ) 0U )
+		{
+			traceREAD_WRITE_LOCK_GIVE( pxLock, pdFALSE );
+
+			( pxLock->uxReaders )--;
+
+			/* Tasks only access the event lists from within a critical
+			section, so they can be accessed here directly.  If the scheduler
+			is suspended an unblocked writer is placed in the pending ready
+			list. */
+			if( pxLock->uxReaders == ( unsigned portBASE_TYPE ) 0U )
+			{
+				if( prvUnblockWaitingTasks( pxLock ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
+
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vReadWriteLockDelete( xReadWriteLockHandle xLock )
+{
+xREAD_WRITE_LOCK * const pxLock = ( xREAD_WRITE_LOCK * ) xLock;
+
+	configASSERT( xLock );
+	configASSERT( pxLock->uxReaders == ( unsigned portBASE_TYPE ) 0U );
+	configASSERT( pxLock->pvWriter == NULL );
+	configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+	traceREAD_WRITE_LOCK_DELETE( pxLock );
+	vPortFree( pxLock );
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTakeLock( xREAD_WRITE_LOCK * const pxLock, const portBASE_TYPE xForWriting, portTickType xTicksToWait )
+{
+xTimeOutType xTimeOut;
+portBASE_TYPE xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+xList *pxEventList;
+
+	if( xForWriting != pdFALSE )
+	{
+		pxEventList = &( pxLock->xTasksWaitingToWrite );
+	}
+	else
+	{
+		pxEventList = &( pxLock->xTasksWaitingToRead );
+	}
+
+	/* This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency.
+
+	Like the alternative queue API, all the work is done from within a
+	critical section, including placing the calling task in the event list,
+	so interrupts can release the lock and unblock a waiting writer. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( prvIsLockAvailable( pxLock, xForWriting ) != pdFALSE )
+			{
+				traceREAD_WRITE_LOCK_TAKE( pxLock, xForWriting );
+
+				if( xForWriting != pdFALSE )
+				{
+					/* The writer is recorded in the same way as a mutex
+					holder, so it can inherit priority. */
+					pxLock->pvWriter = pvTaskIncrementMutexHeldCount();
+
+					if( xEntryTimeSet != pdFALSE )
+					{
+						/* This task is no longer waiting. */
+						( pxLock->uxWritersWaiting )--;
+					}
+				}
+				else
+				{
+					( pxLock->uxReaders )++;
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else if( xTicksToWait == ( portTickType ) 0 )
+			{
+				/* The lock is not available and no block time is specified,
+				so leave now. */
+				taskEXIT_CRITICAL();
+				traceREAD_WRITE_LOCK_TAKE_FAILED( pxLock, xForWriting );
+				return pdFAIL;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				/* The lock is not available and a block time was specified,
+				so configure the timeout structure.  A writer keeps new
+				readers out from now until it obtains the lock or gives up. */
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+
+				if( xForWriting != pdFALSE )
+				{
+					( pxLock->uxWritersWaiting )++;
+				}
+			}
+			else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				/* The block time has expired. */
+				if( xForWriting != pdFALSE )
+				{
+					( pxLock->uxWritersWaiting )--;
+
+					/* Readers may have been waiting only because this task
+					was waiting. */
+					if( ( pxLock->uxWritersWaiting == ( unsigned portBASE_TYPE ) 0U ) && ( pxLock->pvWriter == NULL ) )
+					{
+						if( prvUnblockWaitingTasks( pxLock ) != pdFALSE )
+						{
+							portYIELD_WITHIN_API();
+						}
+					}
+				}
+
+				/* If this task raised the priority of the writer then the
+				writer no longer needs to run at that priority on its behalf. */
+				if( ( xInheritanceOccurred != pdFALSE ) && ( pxLock->pvWriter != NULL ) )
+				{
+					( void ) xTaskPriorityDisinheritAfterTimeout( pxLock->pvWriter, prvGetHighestWaitingPriority( pxLock ) );
+				}
+
+				taskEXIT_CRITICAL();
+				traceREAD_WRITE_LOCK_TAKE_FAILED( pxLock, xForWriting );
+				return pdFAIL;
+			}
+
+			traceBLOCKING_ON_READ_WRITE_LOCK( pxLock, xForWriting );
+
+			/* The writer, if there is one, inherits the priority of the
+			calling task.  When the lock is held by readers there is no single
+			holder to raise. */
+			if( pxLock->pvWriter != NULL )
+			{
+				if( xTaskPriorityInherit( pxLock->pvWriter ) != pdFALSE )
+				{
+					xInheritanceOccurred = pdTRUE;
+				}
+			}
+
+			vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsLockAvailable( const xREAD_WRITE_LOCK * const pxLock, const portBASE_TYPE xForWriting )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( pxLock->pvWriter == NULL )
+	{
+		if( xForWriting != pdFALSE )
+		{
+			if( pxLock->uxReaders == ( unsigned portBASE_TYPE ) 0U )
+			{
+				xReturn = pdTRUE;
+			}
+		}
+		else
+		{
+			/* Writers take preference over readers. */
+			if( pxLock->uxWritersWaiting == ( unsigned portBASE_TYPE ) 0U )
+			{
+				xReturn = pdTRUE;
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvUnblockWaitingTasks( xREAD_WRITE_LOCK * const pxLock )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+	{
+		/* Only one writer can obtain the lock, so only the highest priority
+		writer is unblocked. */
+		xHigherPriorityTaskWoken = xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToWrite ) );
+	}
+	else if( pxLock->uxWritersWaiting == ( unsigned portBASE_TYPE ) 0U )
+	{
+		/* Every waiting reader can obtain the lock, so unblock them all. */
+		while( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE )
+			{
+				xHigherPriorityTaskWoken = pdTRUE;
+			}
+		}
+	}
+	else
+	{
+		/* A writer has already been unblocked but has not yet run.  It will
+		obtain the lock when it does, so the readers must continue to
+		wait. */
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvGetHighestWaitingPriority( const xREAD_WRITE_LOCK * const pxLock )
+{
+unsigned portBASE_TYPE uxHighestPriority = tskIDLE_PRIORITY, uxPriority;
+
+	/* The event lists are ordered by priority, so the first task in each
+	list is the highest priority task waiting in that list. */
+	if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE )
+	{
+		uxHighestPriority = ( unsigned portBASE_TYPE ) configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToRead ) );
+	}
+
+	if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+	{
+		uxPriority = ( unsigned portBASE_TYPE ) configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) );
+
+		if( uxPriority > uxHighestPriority )
+		{
+			uxHighestPriority = uxPriority;
+		}
+	}
+
+	return uxHighestPriority;
+}
@@ -0,0 +1,476 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ring_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build ring_buffer.c
+#endif
+
+/* The definition of a ring buffer.  uxHead and uxTail count the items that
+have ever been written and read, and are allowed to wrap.  The number of items
+in the ring is always uxHead - uxTail, so all the slots can be used, and as
+the number of slots is a power of two the slot an item occupies is found by
+masking its count.  uxHead and uxTail are only ever written by the producer
+and the consumer respectively, and xTaskWaitingToReceive is only ever written
+by the consumer. */
+typedef struct RingBufferDefinition
+{
+	volatile unsigned portBASE_TYPE uxHead;			/*< The number of items written. */
+	volatile unsigned portBASE_TYPE uxTail;			/*< The number of items read. */
+	unsigned portBASE_TYPE uxMask;					/*< The number of slots minus one. */
+	unsigned portBASE_TYPE uxSlotSize;				/*< The size of each item in bytes. */
+	volatile xTaskHandle xTaskWaitingToReceive;		/*< Holds the handle of the consumer while it is waiting for an item, otherwise NULL. */
+	unsigned char *pucSlots;						/*< Points to the storage area, which follows the structure in memory unless the ring buffer was created statically. */
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;		/*< Set to pdTRUE if the structure and storage area were supplied by the application, so must not be freed when the ring buffer is deleted. */
+	#endif
+} xRING_BUFFER;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy an item into the slot at the head and publish it.  Returns the number
+ * of items in the ring once the item has been published, or 0 if the ring was
+ * full.  A result of 1 means the ring was empty, so the consumer might be
+ * waiting.
+ */
+static unsigned portBASE_TYPE prvWriteItem( xRING_BUFFER * const pxRingBuffer, const void *pvItem );
+
+/*
+ * Copy the item at the tail out of the ring and free its slot.  Returns pdFAIL
+ * if the ring was empty.
+ */
+static portBASE_TYPE prvReadItem( xRING_BUFFER * const pxRingBuffer, void *pvBuffer );
+
+/*
+ * Called by both xRingBufferCreate() and xRingBufferCreateStatic() once the
+ * memory for the ring buffer has been obtained.
+ */
+static void prvInitialiseNewRingBuffer( xRING_BUFFER * const pxRingBuffer, unsigned char * const pucSlots, unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize );
+
+/*
+ * Returns pdTRUE if uxNumberOfSlots is a non-zero power of two.
+ */
+static portBASE_TYPE prvIsValidNumberOfSlots( unsigned portBASE_TYPE uxNumberOfSlots );
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xRingBufferHandle xRingBufferCreate( unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize )
+	{
+	xRING_BUFFER *pxRingBuffer = NULL;
+
+		configASSERT( prvIsValidNumberOfSlots( uxNumberOfSlots ) );
+		configASSERT( uxSlotSize > ( unsigned portBASE_TYPE ) 0U );
+
+		if( prvIsValidNumberOfSlots( uxNumberOfSlots ) != pdFALSE )
+		{
+			/* Allocate the structure and the storage area in a single
+			block. */
+			pxRingBuffer = ( xRING_BUFFER * ) pvPortMalloc( sizeof( xRING_BUFFER ) + ( ( size_t ) uxNumberOfSlots * ( size_t ) uxSlotSize ) );
+		}
+
+		if( pxRingBuffer != NULL )
+		{
+			prvInitialiseNewRingBuffer( pxRingBuffer, ( ( unsigned char * ) pxRingBuffer ) + sizeof( xRING_BUFFER ), uxNumberOfSlots, uxSlotSize );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxRingBuffer->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			traceRING_BUFFER_CREATE( pxRingBuffer );
+		}
+		else
+		{
+			traceRING_BUFFER_CREATE_FAILED();
+		}
+
+		return ( xRingBufferHandle ) pxRingBuffer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xRingBufferHandle xRingBufferCreateStatic( unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize, unsigned char *pucRingBufferStorageArea, xStaticRingBuffer *pxStaticRingBuffer )
+	{
+	xRING_BUFFER *pxRingBuffer = NULL;
+
+		configASSERT( prvIsValidNumberOfSlots( uxNumberOfSlots ) );
+		configASSERT( uxSlotSize > ( unsigned portBASE_TYPE ) 0U );
+		configASSERT( pucRingBufferStorageArea );
+		configASSERT( pxStaticRingBuffer );
+
+		/* The xStaticRingBuffer structure must be the same size as the ring
+		buffer structure it is used in place of. */
+		configASSERT( sizeof( xStaticRingBuffer ) == sizeof( xRING_BUFFER ) );
+
+		if( ( prvIsValidNumberOfSlots( uxNumberOfSlots ) != pdFALSE ) && ( pucRingBufferStorageArea != NULL ) && ( pxStaticRingBuffer != NULL ) )
+		{
+			pxRingBuffer = ( xRING_BUFFER * ) pxStaticRingBuffer;
+			prvInitialiseNewRingBuffer( pxRingBuffer, pucRingBufferStorageArea, uxNumberOfSlots, uxSlotSize );
+
+			/* The memory was supplied by the application so must not be freed
+			if the ring buffer is deleted. */
+			pxRingBuffer->ucStaticallyAllocated = pdTRUE;
+
+			traceRING_BUFFER_CREATE( pxRingBuffer );
+		}
+		else
+		{
+			traceRING_BUFFER_CREATE_FAILED();
+		}
+
+		return ( xRingBufferHandle ) pxRingBuffer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vRingBufferDelete( xRingBufferHandle xRingBuffer )
+{
+xRING_BUFFER * const pxRingBuffer = ( xRING_BUFFER * ) xRingBuffer;
+
+	configASSERT( pxRingBuffer );
+	configASSERT( pxRingBuffer->xTaskWaitingToReceive == NULL );
+
+	traceRING_BUFFER_DELETE( xRingBuffer );
+
+	/* Memory supplied by the application to xRingBufferCreateStatic() is not
+	freed. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		vPortFree( pxRingBuffer );
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxRingBuffer->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxRingBuffer );
+		}
+	}
+	#else
+	{
+		/* Just to remove compiler warning when configASSERT() is not
+		defined. */
+		( void ) pxRingBuffer;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xRingBufferSendFromISR( xRingBufferHandle xRingBuffer, const void *pvItem, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xRING_BUFFER * const pxRingBuffer = ( xRING_BUFFER * ) xRingBuffer;
+unsigned portBASE_TYPE uxItems;
+xTaskHandle xConsumer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxRingBuffer );
+	configASSERT( pvItem );
+
+	uxItems = prvWriteItem( pxRingBuffer, pvItem );
+
+	if( uxItems != ( unsigned portBASE_TYPE ) 0U )
+	{
+		traceRING_BUFFER_SEND_FROM_ISR( xRingBuffer );
+
+		/* The consumer only blocks once it has seen the ring empty, so only
+		the item that makes the ring not empty can need to unblock it.  The
+		consumer cannot run while this interrupt is executing, so it cannot
+		clear its handle between the test and the notification. */
+		if( uxItems == ( unsigned portBASE_TYPE ) 1U )
+		{
+			xConsumer = pxRingBuffer->xTaskWaitingToReceive;
+
+			if( xConsumer != NULL )
+			{
+				( void ) xTaskNotifyFromISR( xConsumer, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+			}
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		traceRING_BUFFER_SEND_FAILED( xRingBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xRingBufferSend( xRingBufferHandle xRingBuffer, const void *pvItem )
+{
+xRING_BUFFER * const pxRingBuffer = ( xRING_BUFFER * ) xRingBuffer;
+unsigned portBASE_TYPE uxItems;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxRingBuffer );
+	configASSERT( pvItem );
+
+	uxItems = prvWriteItem( pxRingBuffer, pvItem );
+
+	if( uxItems != ( unsigned portBASE_TYPE ) 0U )
+	{
+		traceRING_BUFFER_SEND( xRingBuffer );
+
+		if( ( uxItems == ( unsigned portBASE_TYPE ) 1U ) && ( pxRingBuffer->xTaskWaitingToReceive != NULL ) )
+		{
+			/* Suspending the scheduler, rather than entering a critical
+			section, prevents the consumer from running and clearing its own
+			handle between the test and the notification. */
+			vTaskSuspendAll();
+			{
+				if( pxRingBuffer->xTaskWaitingToReceive != NULL )
+				{
+					( void ) xTaskNotify( pxRingBuffer->xTaskWaitingToReceive, 0UL, eNoAction );
+				}
+			}
+			( void ) xTaskResumeAll();
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		traceRING_BUFFER_SEND_FAILED( xRingBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xRingBufferReceive( xRingBufferHandle xRingBuffer, void *pvBuffer, portTickType xTicksToWait )
+{
+xRING_BUFFER * const pxRingBuffer = ( xRING_BUFFER * ) xRingBuffer;
+xTimeOutType xTimeOut;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxRingBuffer );
+	configASSERT( pvBuffer );
+
+	xReturn = prvReadItem( pxRingBuffer, pvBuffer );
+
+	if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( portTickType ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Clear any notification state left over from a previous event
+			so the wait below really does wait, then tell the producer this
+			task is waiting before looking at the ring again.  An item sent
+			after the handle is visible will notify this task, and an item
+			sent before it will be found by the second look, so no critical
+			section is needed. */
+			( void ) xTaskNotifyStateClear( NULL );
+			pxRingBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			portMEMORY_BARRIER();
+
+			if( pxRingBuffer->uxHead == pxRingBuffer->uxTail )
+			{
+				traceBLOCKING_ON_RING_BUFFER_RECEIVE( xRingBuffer );
+				( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			}
+
+			pxRingBuffer->xTaskWaitingToReceive = NULL;
+			xReturn = prvReadItem( pxRingBuffer, pvBuffer );
+
+		} while( ( xReturn == pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+	}
+
+	if( xReturn != pdFAIL )
+	{
+		traceRING_BUFFER_RECEIVE( xRingBuffer );
+	}
+	else
+	{
+		traceRING_BUFFER_RECEIVE_FAILED( xRingBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xRingBufferReceiveFromISR( xRingBufferHandle xRingBuffer, void *pvBuffer )
+{
+xRING_BUFFER * const pxRingBuffer = ( xRING_BUFFER * ) xRingBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxRingBuffer );
+	configASSERT( pvBuffer );
+
+	xReturn = prvReadItem( pxRingBuffer, pvBuffer );
+
+	if( xReturn != pdFAIL )
+	{
+		traceRING_BUFFER_RECEIVE_FROM_ISR( xRingBuffer );
+	}
+	else
+	{
+		traceRING_BUFFER_RECEIVE_FAILED( xRingBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxRingBufferItemsWaiting( xRingBufferHandle xRingBuffer )
+{
+const xRING_BUFFER * const pxRingBuffer = ( const xRING_BUFFER * ) xRingBuffer;
+unsigned portBASE_TYPE uxTail;
+
+	configASSERT( pxRingBuffer );
+
+	/* Read the tail first - the head can only move further ahead of it. */
+	uxTail = pxRingBuffer->uxTail;
+	return pxRingBuffer->uxHead - uxTail;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned portBASE_TYPE prvWriteItem( xRING_BUFFER * const pxRingBuffer, const void *pvItem )
+{
+unsigned portBASE_TYPE uxHead, uxItems;
+
+	/* The producer owns uxHead, so it cannot change while it is used here. */
+	uxHead = pxRingBuffer->uxHead;
+
+	if( ( uxHead - pxRingBuffer->uxTail ) <= pxRingBuffer->uxMask )
+	{
+		memcpy( ( void * ) &( pxRingBuffer->pucSlots[ ( uxHead & pxRingBuffer->uxMask ) * pxRingBuffer->uxSlotSize ] ), pvItem, ( size_t ) pxRingBuffer->uxSlotSize );
+
+		/* Only publish the new head once the item is in its slot. */
+		portMEMORY_BARRIER();
+		uxHead++;
+		pxRingBuffer->uxHead = uxHead;
+
+		/* Look at the tail again, after the item has been published, so an
+		item the consumer read in the meantime is not counted. */
+		portMEMORY_BARRIER();
+		uxItems = uxHead - pxRingBuffer->uxTail;
+	}
+	else
+	{
+		uxItems = ( unsigned portBASE_TYPE ) 0U;
+	}
+
+	return uxItems;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvReadItem( xRING_BUFFER * const pxRingBuffer, void *pvBuffer )
+{
+unsigned portBASE_TYPE uxTail;
+portBASE_TYPE xReturn = pdFAIL;
+
+	/* The consumer owns uxTail, so it cannot change while it is used here. */
+	uxTail = pxRingBuffer->uxTail;
+
+	if( pxRingBuffer->uxHead != uxTail )
+	{
+		/* Don't read the item before the head count that published it. */
+		portMEMORY_BARRIER();
+		memcpy( pvBuffer, ( const void * ) &( pxRingBuffer->pucSlots[ ( uxTail & pxRingBuffer->uxMask ) * pxRingBuffer->uxSlotSize ] ), ( size_t ) pxRingBuffer->uxSlotSize );
+
+		/* Only free the slot once the item has been copied out. */
+		portMEMORY_BARRIER();
+		pxRingBuffer->uxTail = uxTail + ( unsigned portBASE_TYPE ) 1U;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewRingBuffer( xRING_BUFFER * const pxRingBuffer, unsigned char * const pucSlots, unsigned portBASE_TYPE uxNumberOfSlots, unsigned portBASE_TYPE uxSlotSize )
+{
+	pxRingBuffer->pucSlots = pucSlots;
+	pxRingBuffer->uxMask = uxNumberOfSlots - ( unsigned portBASE_TYPE ) 1U;
+	pxRingBuffer->uxSlotSize = uxSlotSize;
+	pxRingBuffer->uxHead = ( unsigned portBASE_TYPE ) 0U;
+	pxRingBuffer->uxTail = ( unsigned portBASE_TYPE ) 0U;
+	pxRingBuffer->xTaskWaitingToReceive = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvIsValidNumberOfSlots( unsigned portBASE_TYPE uxNumberOfSlots )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( ( uxNumberOfSlots != ( unsigned portBASE_TYPE ) 0U ) && ( ( uxNumberOfSlots & ( uxNumberOfSlots - ( unsigned portBASE_TYPE ) 1U ) ) == ( unsigned portBASE_TYPE ) 0U ) )
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
@@ -0,0 +1,148 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "seq_lock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/*-----------------------------------------------------------*/
+
+void vSeqLockInitialise( xSeqLock *pxSeqLock )
+{
+	configASSERT( pxSeqLock );
+	pxSeqLock->uxSequence = ( unsigned portBASE_TYPE ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxSeqLockReadBegin( const xSeqLock *pxSeqLock )
+{
+unsigned portBASE_TYPE uxSequence;
+
+	uxSequence = pxSeqLock->uxSequence;
+
+	/* The count must be read before any of the data. */
+	portMEMORY_BARRIER();
+
+	return uxSequence;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xSeqLockReadRetry( const xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSequence )
+{
+portBASE_TYPE xReturn;
+
+	/* The data must all have been read before the count is read again. */
+	portMEMORY_BARRIER();
+
+	/* An odd count means the read started part way through an update. */
+	if( ( ( uxSequence & ( unsigned portBASE_TYPE ) 1U ) != ( unsigned portBASE_TYPE ) 0U ) || ( pxSeqLock->uxSequence != uxSequence ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vSeqLockWriteBegin( xSeqLock *pxSeqLock )
+{
+	taskENTER_CRITICAL();
+	pxSeqLock->uxSequence++;
+
+	/* The count must be odd before any of the data is written. */
+	portMEMORY_BARRIER();
+}
+/*-----------------------------------------------------------*/
+
+void vSeqLockWriteEnd( xSeqLock *pxSeqLock )
+{
+	/* The data must all have been written before the count is even again. */
+	portMEMORY_BARRIER();
+
+	pxSeqLock->uxSequence++;
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxSeqLockWriteBeginFromISR( xSeqLock *pxSeqLock )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = ( unsigned portBASE_TYPE ) taskENTER_CRITICAL_FROM_ISR();
+	pxSeqLock->uxSequence++;
+	portMEMORY_BARRIER();
+
+	return uxSavedInterruptStatus;
+}
+/*-----------------------------------------------------------*/
+
+void vSeqLockWriteEndFromISR( xSeqLock *pxSeqLock, unsigned portBASE_TYPE uxSavedInterruptStatus )
+{
+	portMEMORY_BARRIER();
+	pxSeqLock->uxSequence++;
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
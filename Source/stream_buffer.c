@@ -0,0 +1,877 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
+#endif
+
+/* The definition of a stream buffer.  xHead is only ever written by the
+writer and xTail is only ever written by the reader, so neither side needs a
+critical section to move data.  The storage area holds one byte more than the
+requested size so a full buffer can be distinguished from an empty one. */
+typedef struct StreamBufferDefinition
+{
+	volatile size_t xTail;							/*< Index of the next byte to read. */
+	volatile size_t xHead;							/*< Index of the next byte to write. */
+	size_t xLength;									/*< The length of the storage area pointed to by pucBuffer. */
+	size_t xTriggerLevelBytes;						/*< The number of bytes that must be in the buffer before a blocked reader is unblocked. */
+	volatile xTaskHandle xTaskWaitingToReceive;		/*< Holds the handle of a task waiting for data, or NULL if no task is waiting. */
+	volatile xTaskHandle xTaskWaitingToSend;		/*< Holds the handle of a task waiting to send data, or NULL if no task is waiting. */
+	unsigned char *pucBuffer;						/*< Points to the storage area, which follows the structure in memory unless the buffer was created statically. */
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;		/*< Set to pdTRUE if the structure and storage area were supplied by the application, so must not be freed when the stream buffer is deleted. */
+	#endif
+} xSTREAM_BUFFER;
+
+/* The reader and the writer are told when the other side has moved data by
+the following macros.  By default they unblock a task on the same core.  When
+the reader and writer run on different cores of an asymmetric multicore part,
+each core running its own copy of the kernel, FreeRTOSConfig.h can instead
+define them to generate an inter-processor interrupt.  The handler of that
+interrupt on the other core then calls xStreamBufferSendCompletedFromISR() or
+xStreamBufferReceiveCompletedFromISR(), so a task is only ever unblocked by
+the kernel that owns it.  The macros are passed the stream buffer so a
+definition can tell cross-core buffers from local ones. */
+#ifndef sbSEND_COMPLETED
+	#define sbSEND_COMPLETED( pxStreamBuffer ) prvNotifyWaitingTask( &( ( pxStreamBuffer )->xTaskWaitingToReceive ) )
+#endif
+
+#ifndef sbSEND_COMPLETED_FROM_ISR
+	#define sbSEND_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) ( void ) prvNotifyWaitingTaskFromISR( &( ( pxStreamBuffer )->xTaskWaitingToReceive ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
+#ifndef sbRECEIVE_COMPLETED
+	#define sbRECEIVE_COMPLETED( pxStreamBuffer ) prvNotifyWaitingTask( &( ( pxStreamBuffer )->xTaskWaitingToSend ) )
+#endif
+
+#ifndef sbRECEIVE_COMPLETED_FROM_ISR
+	#define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) ( void ) prvNotifyWaitingTaskFromISR( &( ( pxStreamBuffer )->xTaskWaitingToSend ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The number of bytes that can be read from, or written to, the buffer.  Both
+ * can be called by either side as each index is read only once.
+ */
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer );
+static size_t prvSpacesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer );
+
+/*
+ * Copy xCount bytes into the buffer at the head (prvWriteBytes()) or out of the
+ * buffer from the tail (prvReadBytes()), wrapping around the end of the
+ * storage area as necessary.  The index is only updated after the copy has
+ * completed.  The caller must already have checked that xCount bytes of space
+ * (or data) are available.
+ */
+static void prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount );
+static void prvReadBytes( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount );
+
+/*
+ * Advance an index by xCount bytes, wrapping at the end of the storage area.
+ */
+static size_t prvAdvanceIndex( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, size_t xCount );
+
+/*
+ * Unblock the task referenced by *pxWaitingTask, if any, and clear the
+ * reference.  The FromISR version must be used from interrupts, and returns
+ * pdTRUE if a task was unblocked.
+ */
+static void prvNotifyWaitingTask( xTaskHandle volatile *pxWaitingTask );
+static portBASE_TYPE prvNotifyWaitingTaskFromISR( xTaskHandle volatile *pxWaitingTask, signed portBASE_TYPE * const pxHigherPriorityTaskWoken );
+
+/*
+ * Called by both xStreamBufferCreate() and xStreamBufferCreateStatic() once
+ * the memory for the stream buffer has been obtained.
+ */
+static void prvInitialiseNewStreamBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xStreamBufferHandle xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes )
+	{
+	xSTREAM_BUFFER *pxStreamBuffer;
+
+		configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		/* Allocate the structure and the storage area in a single block.  One
+		extra byte is allocated as the buffer is never allowed to be completely
+		full - see the definition of xSTREAM_BUFFER. */
+		pxStreamBuffer = ( xSTREAM_BUFFER * ) pvPortMalloc( sizeof( xSTREAM_BUFFER ) + xBufferSizeBytes + ( size_t ) 1 );
+
+		if( pxStreamBuffer != NULL )
+		{
+			prvInitialiseNewStreamBuffer( pxStreamBuffer, ( ( unsigned char * ) pxStreamBuffer ) + sizeof( xSTREAM_BUFFER ), xBufferSizeBytes, xTriggerLevelBytes );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				pxStreamBuffer->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif
+
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED();
+		}
+
+		return ( xStreamBufferHandle ) pxStreamBuffer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xStreamBufferHandle xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, unsigned char *pucStreamBufferStorageArea, xStaticStreamBuffer *pxStaticStreamBuffer )
+	{
+	xSTREAM_BUFFER *pxStreamBuffer = NULL;
+
+		configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+		configASSERT( pucStreamBufferStorageArea );
+		configASSERT( pxStaticStreamBuffer );
+
+		/* The xStaticStreamBuffer structure must be the same size as the
+		stream buffer structure it is used in place of. */
+		configASSERT( sizeof( xStaticStreamBuffer ) == sizeof( xSTREAM_BUFFER ) );
+
+		if( ( xBufferSizeBytes > ( size_t ) 0 ) && ( pucStreamBufferStorageArea != NULL ) && ( pxStaticStreamBuffer != NULL ) )
+		{
+			pxStreamBuffer = ( xSTREAM_BUFFER * ) pxStaticStreamBuffer;
+			prvInitialiseNewStreamBuffer( pxStreamBuffer, pucStreamBufferStorageArea, xBufferSizeBytes, xTriggerLevelBytes );
+
+			/* The memory was supplied by the application so must not be freed
+			if the stream buffer is deleted. */
+			pxStreamBuffer->ucStaticallyAllocated = pdTRUE;
+
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED();
+		}
+
+		return ( xStreamBufferHandle ) pxStreamBuffer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+	configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+
+	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
+
+	/* Memory supplied by the application to xStreamBufferCreateStatic() is
+	not freed. */
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		vPortFree( pxStreamBuffer );
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxStreamBuffer->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxStreamBuffer );
+		}
+	}
+	#else
+	{
+		/* Just to remove compiler warning when configASSERT() is not
+		defined. */
+		( void ) pxStreamBuffer;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReset( xStreamBufferHandle xStreamBuffer )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	/* Both indexes are written, so a critical section is used to prevent an
+	interrupt using the buffer part way through the reset. */
+	taskENTER_CRITICAL();
+	{
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			xReturn = pdPASS;
+
+			traceSTREAM_BUFFER_RESET( xStreamBuffer );
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSetTriggerLevel( xStreamBufferHandle xStreamBuffer, size_t xTriggerLevel )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	/* It is not valid for the trigger level to be 0. */
+	if( xTriggerLevel == ( size_t ) 0 )
+	{
+		xTriggerLevel = ( size_t ) 1;
+	}
+
+	/* The trigger level is the number of bytes that must be in the stream
+	buffer before a task that is waiting for data is unblocked, so it cannot
+	be greater than the buffer size. */
+	if( xTriggerLevel < pxStreamBuffer->xLength )
+	{
+		pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xSpace = 0, xRequiredSpace, xReturn;
+xTimeOutType xTimeOut;
+portBASE_TYPE xWaiting;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	/* A write that is longer than the buffer can never fit in one go, so in
+	that case wait for the buffer to be completely empty. */
+	xRequiredSpace = xDataLengthBytes;
+	if( xRequiredSpace > ( pxStreamBuffer->xLength - ( size_t ) 1 ) )
+	{
+		xRequiredSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+	}
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until the required number of bytes are free in the buffer.
+			The check and the recording of the waiting task must be atomic with
+			respect to the reader, otherwise the reader could free space and
+			look for a waiting task in between the two. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = prvSpacesInBuffer( pxStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Clear any notification state left over from a previous
+					event so the wait below really does wait. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Only one writer is allowed to block at a time. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					xWaiting = pdTRUE;
+				}
+				else
+				{
+					xWaiting = pdFALSE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xWaiting != pdFALSE )
+			{
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+			}
+
+		} while( ( xWaiting != pdFALSE ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+	}
+
+	if( xSpace < xRequiredSpace )
+	{
+		/* Either no block time was specified, or the block time expired.  In
+		both cases write as many bytes as will fit. */
+		xSpace = prvSpacesInBuffer( pxStreamBuffer );
+	}
+
+	xReturn = ( xDataLengthBytes < xSpace ) ? xDataLengthBytes : xSpace;
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xReturn );
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( xStreamBufferHandle xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xSpace, xReturn;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	xSpace = prvSpacesInBuffer( pxStreamBuffer );
+	xReturn = ( xDataLengthBytes < xSpace ) ? xDataLengthBytes : xSpace;
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		prvWriteBytes( pxStreamBuffer, ( const unsigned char * ) pvTxData, xReturn );
+
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, portTickType xTicksToWait )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xBytesAvailable, xReturn = 0;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	if( xTicksToWait != ( portTickType ) 0 )
+	{
+		/* As in xStreamBufferSend(), checking for data and recording the
+		waiting task must be atomic with respect to the writer. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			if( xBytesAvailable == ( size_t ) 0 )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Only one reader is allowed to block at a time. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable == ( size_t ) 0 )
+		{
+			/* Wait for data to be available.  The writer only unblocks this
+			task once the trigger level has been reached, but if the block time
+			expires first then whatever has arrived is returned. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( 0UL, 0UL, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	if( xBytesAvailable > ( size_t ) 0 )
+	{
+		xReturn = ( xBufferLengthBytes < xBytesAvailable ) ? xBufferLengthBytes : xBytesAvailable;
+		prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xReturn );
+
+		/* Space has been freed, so unblock a waiting writer, if any. */
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+
+	traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( xStreamBufferHandle xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xBytesAvailable, xReturn = 0;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( xBytesAvailable > ( size_t ) 0 )
+	{
+		xReturn = ( xBufferLengthBytes < xBytesAvailable ) ? xBufferLengthBytes : xBytesAvailable;
+		prvReadBytes( pxStreamBuffer, ( unsigned char * ) pvRxData, xReturn );
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferWriteReserve( xStreamBufferHandle xStreamBuffer, void **ppvWriteRegion )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xHead, xSpace, xContiguous;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( ppvWriteRegion );
+
+	/* The writer owns xHead, so it cannot change while it is used here. */
+	xHead = pxStreamBuffer->xHead;
+	xSpace = prvSpacesInBuffer( pxStreamBuffer );
+
+	/* The free space might wrap around the end of the storage area, in which
+	case only the part up to the end can be returned. */
+	xContiguous = pxStreamBuffer->xLength - xHead;
+	if( xSpace < xContiguous )
+	{
+		xContiguous = xSpace;
+	}
+
+	*ppvWriteRegion = ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] );
+
+	return xContiguous;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferWriteCommit( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( xBytesWritten <= prvSpacesInBuffer( pxStreamBuffer ) );
+
+	if( xBytesWritten > ( size_t ) 0 )
+	{
+		/* Ensure the data written through the reserved region is in memory
+		before the reader can see the new head. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferWriteCommitFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesWritten, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( xBytesWritten <= prvSpacesInBuffer( pxStreamBuffer ) );
+
+	if( xBytesWritten > ( size_t ) 0 )
+	{
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReadAcquire( xStreamBufferHandle xStreamBuffer, const void **ppvReadRegion )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+size_t xTail, xAvailable, xContiguous;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( ppvReadRegion );
+
+	/* The reader owns xTail, so it cannot change while it is used here. */
+	xTail = pxStreamBuffer->xTail;
+	xAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	xContiguous = pxStreamBuffer->xLength - xTail;
+	if( xAvailable < xContiguous )
+	{
+		xContiguous = xAvailable;
+	}
+
+	/* Don't read the data before the head index that published it. */
+	portMEMORY_BARRIER();
+	*ppvReadRegion = ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+
+	return xContiguous;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReadRelease( xStreamBufferHandle xStreamBuffer, size_t xBytesRead )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+	if( xBytesRead > ( size_t ) 0 )
+	{
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReadReleaseFromISR( xStreamBufferHandle xStreamBuffer, size_t xBytesRead, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+	if( xBytesRead > ( size_t ) 0 )
+	{
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvBytesInBuffer( ( const xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( xStreamBufferHandle xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvSpacesInBuffer( ( const xSTREAM_BUFFER * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferIsEmpty( xStreamBufferHandle xStreamBuffer )
+{
+const xSTREAM_BUFFER * const pxStreamBuffer = ( const xSTREAM_BUFFER * ) xStreamBuffer;
+portBASE_TYPE xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferIsFull( xStreamBufferHandle xStreamBuffer )
+{
+portBASE_TYPE xReturn;
+
+	configASSERT( xStreamBuffer );
+
+	if( prvSpacesInBuffer( ( const xSTREAM_BUFFER * ) xStreamBuffer ) == ( size_t ) 0 )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferSendCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	/* The writer on the other core only raises the interrupt once the trigger
+	level has been reached, so the reader can be unblocked unconditionally. */
+	return prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xStreamBufferReceiveCompletedFromISR( xStreamBufferHandle xStreamBuffer, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+xSTREAM_BUFFER * const pxStreamBuffer = ( xSTREAM_BUFFER * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	return prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToSend ), pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes )
+{
+	/* A trigger level of 0 would unblock the reader before any data had been
+	written, so treat it as 1. */
+	if( xTriggerLevelBytes == ( size_t ) 0 )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	pxStreamBuffer->xHead = ( size_t ) 0;
+	pxStreamBuffer->xTail = ( size_t ) 0;
+	pxStreamBuffer->xTaskWaitingToReceive = NULL;
+	pxStreamBuffer->xTaskWaitingToSend = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xCount;
+
+	/* Each index is read once - the other side may change its own index at
+	any time, which can only increase the result from the caller's point of
+	view. */
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpacesInBuffer( const xSTREAM_BUFFER * const pxStreamBuffer )
+{
+size_t xSpace;
+
+	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= ( size_t ) 1;
+	if( xSpace >= pxStreamBuffer->xLength )
+	{
+		xSpace -= pxStreamBuffer->xLength;
+	}
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAdvanceIndex( const xSTREAM_BUFFER * const pxStreamBuffer, size_t xIndex, size_t xCount )
+{
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteBytes( xSTREAM_BUFFER * const pxStreamBuffer, const unsigned char *pucData, size_t xCount )
+{
+size_t xHead, xFirstLength;
+
+	xHead = pxStreamBuffer->xHead;
+
+	/* Write as many bytes as can be written in the first write - up to the
+	end of the storage area. */
+	xFirstLength = pxStreamBuffer->xLength - xHead;
+	if( xCount < xFirstLength )
+	{
+		xFirstLength = xCount;
+	}
+	memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] ), ( const void * ) pucData, xFirstLength );
+
+	/* If the number of bytes written was less than the number that could be
+	written in the first write... */
+	if( xCount > xFirstLength )
+	{
+		/* ...then write the remaining bytes to the start of the buffer. */
+		memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength );
+	}
+
+	/* Only publish the new head once the data is in the buffer. */
+	portMEMORY_BARRIER();
+	pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, xHead, xCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadBytes( xSTREAM_BUFFER * const pxStreamBuffer, unsigned char *pucData, size_t xCount )
+{
+size_t xTail, xFirstLength;
+
+	xTail = pxStreamBuffer->xTail;
+
+	/* Don't read the data before the head index that published it. */
+	portMEMORY_BARRIER();
+
+	xFirstLength = pxStreamBuffer->xLength - xTail;
+	if( xCount < xFirstLength )
+	{
+		xFirstLength = xCount;
+	}
+	memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength );
+
+	if( xCount > xFirstLength )
+	{
+		memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirstLength );
+	}
+
+	/* Only free the space once the data has been copied out. */
+	portMEMORY_BARRIER();
+	pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, xTail, xCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTask( xTaskHandle volatile *pxWaitingTask )
+{
+	/* Suspending the scheduler, rather than entering a critical section,
+	prevents the waiting task from running and clearing its own reference
+	between the test and the notification. */
+	vTaskSuspendAll();
+	{
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotify( *pxWaitingTask, 0UL, eNoAction );
+			*pxWaitingTask = NULL;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvNotifyWaitingTaskFromISR( xTaskHandle volatile *pxWaitingTask, signed portBASE_TYPE * const pxHigherPriorityTaskWoken )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+portBASE_TYPE xReturn = pdFALSE;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if( *pxWaitingTask != NULL )
+		{
+			( void ) xTaskNotifyFromISR( *pxWaitingTask, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+			*pxWaitingTask = NULL;
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
@@ -66,6 +66,14 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "StackMacros.h"
 
+#if ( configUSE_HEAP_TRACE == 1 )
+	#include "heap_trace.h"
+#endif
+
+#if ( configUSE_NAME_REGISTRY == 1 )
+	#include "name_registry.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /*
@@ -73,6 +81,27 @@ task.h is included from an application file. */
  */
 #define tskIDLE_STACK_SIZE	configMINIMAL_STACK_SIZE
 
+/*
+ * Bit set in a task's event list item value while the item is being used to
+ * hold event group bits rather than the task's priority.  The scheduler must
+ * not overwrite the value while this bit is set.
+ */
+#if( configUSE_16_BIT_TICKS == 1 )
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	( ( portTickType ) 0x8000U )
+#else
+	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	( ( portTickType ) 0x80000000UL )
+#endif
+
+/*
+ * Values that can be assigned to the ucNotifyState member of the TCB.
+ */
+typedef enum
+{
+	eNotWaitingNotification = 0,
+	eWaitingNotification,
+	eNotified
+} eNotifyValue;
+
 /*
  * Task control block.  A task control block (TCB) is allocated to each task,
  * and stores the context of the task.
@@ -89,7 +118,9 @@ typedef struct tskTaskControlBlock
 	xListItem				xEventListItem;		/*< List item used to place the TCB in event lists. */
 	unsigned portBASE_TYPE	uxPriority;			/*< The priority of the task where 0 is the lowest priority. */
 	portSTACK_TYPE			*pxStack;			/*< Points to the start of the stack. */
-	signed char				pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */
+	#if ( configUSE_TASK_NAMES == 1 )
+		signed char			pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */
+	#endif
 
 	#if ( portSTACK_GROWTH > 0 )
 		portSTACK_TYPE *pxEndOfStack;			/*< Used for stack overflow checking on architectures where the stack grows up from low memory. */
@@ -102,22 +133,122 @@ typedef struct tskTaskControlBlock
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		unsigned portBASE_TYPE	uxTCBNumber;	/*< This stores a number that increments each time a TCB is created.  It allows debuggers to determine when a task has been deleted and then recreated. */
 		unsigned portBASE_TYPE  uxTaskNumber;	/*< This stores a number specifically for use by third party trace code. */
+		unsigned long			ulSwitchInCount;	/*< The number of times the task has been switched in. */
+		portTickType			xTimeLeftReady;		/*< The tick count when the task was last switched out because it blocked or was suspended. */
+		portTickType			xMaxBlockTime;		/*< The longest time between the task leaving the Ready state and it next running. */
+		unsigned char			ucLeftReady;		/*< Set to pdTRUE while xTimeLeftReady is valid. */
 	#endif
 
 	#if ( configUSE_MUTEXES == 1 )
 		unsigned portBASE_TYPE uxBasePriority;	/*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+		unsigned portBASE_TYPE uxMutexesHeld;	/*< The number of mutexes the task holds.  An inherited priority is only fully disinherited when this reaches zero. */
+		void *pvMutexBlockedOn;					/*< The mutex the task is blocked waiting for, if any - used to follow chains of mutex holders. */
 	#endif
 
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		pdTASK_HOOK_CODE pxTaskTag;
 	#endif
 
+	#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+		void *pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];	/*< Per task pointers for use by the application and libraries. */
+		#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			pdTLS_DELETE_CALLBACK pxThreadLocalStorageDeleteCallbacks[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];	/*< Called with each pointer that is set when the task is deleted, or NULL. */
+		#endif
+	#endif
+
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		unsigned long ulRunTimeCounter;		/*< Used for calculating how much CPU time each task is utilising. */
+		portRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/*< Used for calculating how much CPU time each task is utilising. */
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+		volatile unsigned long ulNotifiedValue;	/*< The value sent to the task by the task notification API. */
+		volatile unsigned char ucNotifyState;	/*< Whether the task is waiting for, or has received, a notification - one of the eNotifyValue values. */
+	#endif
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the TCB and stack were supplied by the application, so must not be freed when the task is deleted. */
+	#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+		volatile portBASE_TYPE xTaskRunState;	/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+		#if ( configUSE_CORE_AFFINITY == 1 )
+			unsigned portBASE_TYPE uxCoreAffinityMask;	/*< Bit n is set if the task is allowed to run on core n. */
+		#endif
+	#endif
+
+	#if ( configSTACK_SAMPLE_WORDS > 0 )
+		struct tskTaskControlBlock *pxNextSampled;	/*< Links every task for the stack sampler run by the idle task. */
+		volatile unsigned short usStackWatermark;	/*< The least free stack, in words, the sampler has found. */
+	#endif
+
+	#if ( configDEFER_STACK_FILL == 1 )
+		portSTACK_TYPE *pxFillNext;	/*< The next stack word the idle task is to fill, or NULL once the stack has been filled. */
+	#endif
+
+	#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+		unsigned short usRecycleDepth;	/*< The depth of the stack if it was allocated by the kernel, so the TCB and stack can be reused, otherwise 0. */
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		portTickType xDeadline;				/*< The absolute deadline of the current job of the task, set by vTaskDelayUntil(). */
+		portTickType xRelativeDeadline;		/*< Set by vTaskSetDeadline().  0 to use the period passed to vTaskDelayUntil(). */
+		unsigned char ucHasDeadline;		/*< pdTRUE once xDeadline has been set. */
+	#endif
+
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		struct tskTaskControlBlock *pxNextBudgeted;	/*< Links the tasks that have a budget. */
+		portTickType xBudget;						/*< The ticks the task may run for in each budget period, or 0 if the task has no budget. */
+		portTickType xBudgetPeriod;					/*< The budget replenishment period, in ticks. */
+		portTickType xBudgetLeft;					/*< The ticks left of the budget in the current period. */
+		portTickType xNextReplenish;				/*< The tick count at which the budget is next replenished. */
+	#endif
+
+	#if ( configRECORD_RELEASE_JITTER == 1 )
+		portRUN_TIME_COUNTER_TYPE ulMinLateness;	/*< The least lateness of a release by vTaskDelayUntil(), in run time counter units. */
+		portRUN_TIME_COUNTER_TYPE ulMaxLateness;	/*< The greatest lateness of a release. */
+		portRUN_TIME_COUNTER_TYPE ulTotalLateness;	/*< The sum of the lateness of every release, from which the mean is reported. */
+		unsigned long ulReleases;					/*< The number of releases timed. */
+		unsigned long ulOverruns;					/*< The number of calls to vTaskDelayUntil() made after the next wake time had passed. */
+		unsigned long ulLatenessHistogram[ configRELEASE_JITTER_BUCKETS ];	/*< The releases counted by lateness, see xReleaseJitterType. */
+		portTickType xReleaseTime;					/*< The wake time passed to vTaskDelayUntil(), valid while ucReleasePending is pdTRUE. */
+		unsigned char ucReleasePending;				/*< pdTRUE from the task blocking in vTaskDelayUntil() to it next running. */
+	#endif
+
+	#if ( configUSE_HEAP_TRACE == 1 )
+		unsigned char ucHeapOwner;				/*< The heap trace owner entry the memory allocated by the task is counted against, or heaptraceNO_OWNER until the task first allocates memory. */
+	#endif
+
+	#if ( configUSE_HEAP_TASK_CACHES == 1 )
+		void *pvHeapCache;						/*< The cache of freed blocks heap_3.c keeps for the task, or NULL until the task first needs one. */
+	#endif
+
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+		unsigned portBASE_TYPE uxPreemptionThreshold;	/*< While the task is running only tasks of higher priority than this can preempt it.  No effect if not above the priority of the task. */
+		struct tskTaskControlBlock *pxNextPreempted;	/*< Links the tasks that were preempted while their threshold was in force. */
+	#endif
+
+	#if ( configRECORD_WAKE_LATENCY == 1 )
+		portRUN_TIME_COUNTER_TYPE ulReadyTime;			/*< The run time counter value when the task was made ready, valid while ucWakePending is pdTRUE. */
+		portRUN_TIME_COUNTER_TYPE ulMaxWakeLatency;		/*< The longest time from the task being made ready to it running. */
+		portRUN_TIME_COUNTER_TYPE ulTotalWakeLatency;	/*< The sum of the times from the task being made ready to it running, from which the mean is reported. */
+		unsigned long ulWakeUps;						/*< The number of wake ups timed. */
+		unsigned long ulWakeLatencyHistogram[ configWAKE_LATENCY_BUCKETS ];	/*< The wake ups counted by latency, see xWakeLatencyType. */
+		unsigned char ucWakePending;					/*< pdTRUE from the task being made ready after leaving the Ready state to it next running. */
+	#endif
+
+	#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+		unsigned long ulActivationOverruns;				/*< The number of releases by the schedule table that found the task still running its previous activation. */
 	#endif
 
 } tskTCB;
 
+/* The name of a task, which is empty if task names are not stored. */
+#if ( configUSE_TASK_NAMES == 1 )
+	#define taskGET_TCB_NAME( pxTCB )	( &( ( pxTCB )->pcTaskName[ 0 ] ) )
+#else
+	#define taskGET_TCB_NAME( pxTCB )	( &( pcNoTaskName[ 0 ] ) )
+#endif
+
 
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
@@ -128,15 +259,52 @@ typedef struct tskTaskControlBlock
 #endif
 
 /*lint -e956 */
-PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+
+	PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
+
+#else
+
+	/* The task running on each core, indexed by core number.  Ports read
+	this array in place of pxCurrentTCB.  Within this file pxCurrentTCB
+	refers to the task running on the calling core. */
+	PRIVILEGED_DATA tskTCB * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+	#define pxCurrentTCB	prvGetCurrentTCB()
+
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList ;			/*< Points to the delayed task list currently being used. */
+
+	#if ( configUSE_64_BIT_TICKS == 0 )
+
+		PRIVILEGED_DATA static xList xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+		PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+	#endif
+
+#else
+
+	/* Delayed tasks are held in a wheel of unsorted lists.  A task is placed
+	in the list indexed by the low bits of its wake time, so adding a task to
+	the Blocked state takes the same time however many tasks are delayed.
+	Each tick only the list indexed by the new tick count has to be checked,
+	and then only when xNextTaskUnblockTime has been reached.  The full wake
+	time is held in the list item, so a task that is not due until a later
+	turn of the wheel is passed over, and the tick count overflowing needs
+	no special handling. */
+	PRIVILEGED_DATA static xList xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SLOTS ];	/*< Delayed tasks. */
+
+	#define taskDELAYED_WHEEL_SLOT( xTime )	( &( xDelayedTaskWheel[ ( xTime ) & ( portTickType ) ( configDELAYED_TASK_WHEEL_SLOTS - 1 ) ] ) )
+
+#endif
+
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready queue when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -162,23 +330,208 @@ PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been r
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxCurrentNumberOfTasks 	= ( unsigned portBASE_TYPE ) 0U;
 PRIVILEGED_DATA static volatile portTickType xTickCount 						= ( portTickType ) 0U;
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTopUsedPriority	 				= tskIDLE_PRIORITY;
-PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxTopReadyPriority 		= tskIDLE_PRIORITY;
+PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxTopReadyPriority 		= tskIDLE_PRIORITY; /*< Either the highest ready priority, or a bitmap of ready priorities when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1. */
 PRIVILEGED_DATA static volatile signed portBASE_TYPE xSchedulerRunning 			= pdFALSE;
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxSchedulerSuspended	 	= ( unsigned portBASE_TYPE ) pdFALSE;
 PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxMissedTicks 			= ( unsigned portBASE_TYPE ) 0U;
-PRIVILEGED_DATA static volatile portBASE_TYPE xMissedYield 						= ( portBASE_TYPE ) pdFALSE;
-PRIVILEGED_DATA static volatile portBASE_TYPE xNumOfOverflows 					= ( portBASE_TYPE ) 0;
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned portBASE_TYPE ) 0U;
-PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType ) portMAX_DELAY;
+PRIVILEGED_DATA static portTickCountType xNextTaskUnblockTime					= portMAX_TICK_COUNT;
+
+#if ( configUSE_TASK_NAMES == 0 )
+
+	/* The name reported for every task when names are not stored. */
+	PRIVILEGED_DATA static signed char pcNoTaskName[ 1 ] = { ( signed char ) '\0' };
+
+#endif
+
+#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+
+	/* The number of ticks the next tick interrupt advances the tick count by,
+	and the number each tick interrupt after it does. */
+	PRIVILEGED_DATA static volatile portTickType xTicksForNextTickInterrupt	= ( portTickType ) 1U;
+	PRIVILEGED_DATA static volatile portTickType xTicksPerTickInterrupt		= ( portTickType ) 1U;
+
+#endif
+
+#if ( configUSE_64_BIT_TICKS == 1 )
+
+	/* The 64 bit tick count is xTickEpoch + xTickCount, where xTickEpoch is
+	the count at which xTickCount last overflowed.  xTickCount stays the
+	portTickType count the rest of the kernel and the API use. */
+	PRIVILEGED_DATA static volatile portTickCountType xTickEpoch				= ( portTickCountType ) 0U;
+
+	#define taskFULL_TICK_COUNT()	( xTickEpoch + ( portTickCountType ) xTickCount )
+
+	/* Called when xTickCount has overflowed. */
+	#define taskTICK_COUNT_OVERFLOWED()	xTickEpoch += ( portTickCountType ) portMAX_DELAY + ( portTickCountType ) 1U
+
+#else
+
+	PRIVILEGED_DATA static volatile portBASE_TYPE xNumOfOverflows 				= ( portBASE_TYPE ) 0;
+
+	#define taskFULL_TICK_COUNT()	xTickCount
+
+	#define taskTICK_COUNT_OVERFLOWED()	xNumOfOverflows++
+
+#endif
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+	PRIVILEGED_DATA static volatile portBASE_TYPE xMissedYield 					= ( portBASE_TYPE ) pdFALSE;
+
+#else
+
+	/* A yield that could not be performed immediately is held pending for
+	each core separately.  xMissedYield refers to the entry of the calling
+	core, so must only be used where the calling task cannot move to another
+	core - that is with interrupts masked or the scheduler suspended. */
+	PRIVILEGED_DATA static volatile portBASE_TYPE xYieldPendings[ configNUMBER_OF_CORES ];
+	#define xMissedYield	xYieldPendings[ portGET_CORE_ID() ]
+
+	/* The critical section nesting depth of each core. */
+	PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxCriticalNestings[ configNUMBER_OF_CORES ];
+
+#endif
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	PRIVILEGED_DATA static char pcStatsString[ 50 ] ;
-	PRIVILEGED_DATA static unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime ) PRIVILEGED_FUNCTION;
+	#if ( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ];	/*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+	#endif
+	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, portRUN_TIME_COUNTER_TYPE ulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) || ( configUSE_CPU_LOAD_METER == 1 )
+
+	PRIVILEGED_DATA static tskTCB * volatile pxIdleTCBs[ configNUMBER_OF_CORES ];				/*< The idle tasks that have started running, for ulTaskGetIdleRunTimeCounter() and the load meter. */
+	PRIVILEGED_DATA static volatile unsigned portBASE_TYPE uxIdleTasksStarted = ( unsigned portBASE_TYPE ) 0U;
+
+#endif
+
+#if ( configUSE_CPU_LOAD_METER == 1 )
+
+	/* The load is sampled every 100ms.  The averages are held as fractions
+	of tskCPU_LOAD_ONE, and decay by the factors tskCPU_LOAD_DECAY_1S,
+	_10S and _60S - exp( -0.1 / T ) for time constants T of 1, 10 and 60
+	seconds, as fractions of tskCPU_LOAD_DECAY_ONE - at each sample. */
+	#define tskLOAD_SAMPLE_TICKS		( ( ( configTICK_RATE_HZ / 10 ) > 0 ) ? ( portTickType ) ( configTICK_RATE_HZ / 10 ) : ( portTickType ) 1U )
+	#define tskCPU_LOAD_AVERAGES		3
+	#define tskCPU_LOAD_SHIFT			20
+	#define tskCPU_LOAD_ONE				( 1UL << tskCPU_LOAD_SHIFT )
+	#define tskCPU_LOAD_DECAY_SHIFT		12
+	#define tskCPU_LOAD_DECAY_ONE		( 1UL << tskCPU_LOAD_DECAY_SHIFT )
+	#define tskCPU_LOAD_DECAY_1S		3706UL
+	#define tskCPU_LOAD_DECAY_10S		4055UL
+	#define tskCPU_LOAD_DECAY_60S		4089UL
+
+	/* Reads the time base used by the load meter into ulTime. */
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			#define taskGET_LOAD_METER_TIME( ulTime )	portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+		#else
+			#define taskGET_LOAD_METER_TIME( ulTime )	( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+		#endif
+	#else
+		#define taskGET_LOAD_METER_TIME( ulTime )	( ulTime ) = ( portRUN_TIME_COUNTER_TYPE ) xTickCount
+	#endif
+
+	#if ( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulIdleSwitchedInTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;	/*< The time the idle task was last switched in. */
+	#else
+		/* The time an idle task was last switched in on each core.
+		ulIdleSwitchedInTime refers to the entry of the calling core. */
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulIdleSwitchedInTimes[ configNUMBER_OF_CORES ];
+		#define ulIdleSwitchedInTime	ulIdleSwitchedInTimes[ portGET_CORE_ID() ]
+	#endif
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulIdleTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;			/*< The time the idle task(s) have run, up to the last switch out or load sample. */
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulLoadSampleTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;		/*< The time the load was last sampled. */
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulLoadSampleIdleTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;	/*< The value of ulIdleTime when the load was last sampled. */
+	PRIVILEGED_DATA static portTickType xLoadSampleTick = ( portTickType ) 0U;								/*< The tick count at which the load was last sampled. */
+	PRIVILEGED_DATA static unsigned long ulCpuLoadAverages[ tskCPU_LOAD_AVERAGES ] = { 0UL };				/*< The load averages, as fractions of tskCPU_LOAD_ONE. */
+
+#endif
+
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
+
+	#if ( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulCriticalSectionEnteredTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;	/*< Holds the value of the run time counter when the outermost critical section was entered. */
+	#else
+		PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulCriticalSectionEnteredTime[ configNUMBER_OF_CORES ];			/*< As above, for each core. */
+	#endif
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulMaxCriticalSectionTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;		/*< The longest critical section so far, in run time counter units. */
+
+#endif
+
+#if ( configSTACK_SAMPLE_WORDS > 0 )
+
+	PRIVILEGED_DATA static tskTCB * volatile pxSampledTasks = NULL;		/*< Every task, most recently created first, linked through pxNextSampled. */
+	PRIVILEGED_DATA static tskTCB *pxSampleTCB = NULL;					/*< The task whose stack the sampler is part way through. */
+	PRIVILEGED_DATA static unsigned short usSampleWords = 0U;			/*< The number of words at the end of that stack found still filled so far. */
+
+#endif
+
+#if ( configUSE_IDLE_WORK == 1 )
+
+	PRIVILEGED_DATA static xIdleWork *pxIdleWorkHead = NULL;			/*< The registered idle jobs, in the order they were registered. */
+	PRIVILEGED_DATA static xIdleWork *pxIdleWorkTail = NULL;			/*< The last registered idle job. */
+	PRIVILEGED_DATA static xIdleWork *pxNextIdleWork = NULL;			/*< The job to try first on the next iteration of the idle task, or NULL to start again from the head. */
+
+#endif
+
+#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+
+	PRIVILEGED_DATA static xList xTimeTriggeredTaskList;							/*< Tasks waiting in vTaskWaitForActivation() to be released by the schedule table. */
+	PRIVILEGED_DATA static const xTimeTriggeredEntry *pxSchedule = NULL;			/*< The schedule table, or NULL if there is none. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxScheduleEntries = 0U;			/*< The number of entries in the schedule table. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxNextScheduleEntry = 0U;			/*< The next entry of the table to be released. */
+	PRIVILEGED_DATA static portTickType xMajorFrame = ( portTickType ) 0U;			/*< The length of the major frame, in ticks. */
+	PRIVILEGED_DATA static portTickType xFrameTick = ( portTickType ) 0U;			/*< The tick within the major frame that the next tick is. */
+	PRIVILEGED_DATA static portTickType xFrameStartTick = ( portTickType ) 0U;		/*< The tick count at the start of the current major frame, used to check the frame stays locked to the tick count. */
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static tskTCB *pxBudgetedTasks = NULL;		/*< The tasks that have a budget, linked through pxNextBudgeted. */
 
 #endif
 
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	PRIVILEGED_DATA static tskTCB *pxPreemptedTasks = NULL;	/*< The tasks preempted while their threshold was in force, most recently preempted first, linked through pxNextPreempted. */
+
+#endif
+
+#if ( configRECORD_RELEASE_JITTER == 1 )
+
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulTickRunTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;		/*< The value of the run time counter at the last tick interrupt. */
+	PRIVILEGED_DATA static portRUN_TIME_COUNTER_TYPE ulTickPeriodRunTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;	/*< The run time counter units between the last two tick interrupts. */
+
+#endif
+
+#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+
+	PRIVILEGED_DATA static tskTCB *pxRecycledTCBs[ configTASK_RECYCLE_CACHE_SIZE ];	/*< TCBs of deleted tasks, each with its stack still attached, kept for reuse.  NULL where unused. */
+
+#endif
+
+/*
+ * The TCBs and stacks of tasks created by xTaskCreate() come from the heap
+ * region reserved by configTASK_MEMORY_HEAP_REGION, if there is one.  Either
+ * way they are returned with vPortFree().
+ */
+#if ( configTASK_MEMORY_HEAP_REGION >= 0 )
+	#define tskMALLOC_TCB( xSize )						pvPortMallocTaskMemory( xSize )
+	#define tskMALLOC_STACK( xSize, puxStackBuffer )	( ( ( puxStackBuffer ) == NULL ) ? pvPortMallocTaskMemory( xSize ) : ( void * ) ( puxStackBuffer ) )
+#else
+	#define tskMALLOC_TCB( xSize )						pvPortMalloc( xSize )
+	#define tskMALLOC_STACK( xSize, puxStackBuffer )	pvPortMallocAligned( ( xSize ), ( puxStackBuffer ) )
+#endif
+
 /* Debugging and trace facilities private variables and macros. ------------*/
 
 /*
@@ -187,6 +540,13 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  */
 #define tskSTACK_FILL_BYTE	( 0xa5U )
 
+/*
+ * When configDEFER_STACK_FILL is 1 only this many words at the end of a new
+ * stack are filled when the task is created - enough for the stack overflow
+ * check method 2 to work from the start.
+ */
+#define tskSTACK_GUARD_WORDS	( ( 20U + sizeof( portSTACK_TYPE ) - 1U ) / sizeof( portSTACK_TYPE ) )
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -195,8 +555,139 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
 #define tskDELETED_CHAR		( ( signed char ) 'D' )
 #define tskSUSPENDED_CHAR	( ( signed char ) 'S' )
 
+/*
+ * Value held in the xTaskRunState member of the TCB while the task is not
+ * running on any core.
+ */
+#define taskTASK_NOT_RUNNING	( ( portBASE_TYPE ) -1 )
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
+	performed in a generic way that is not optimised to any particular
+	microcontroller architecture.  uxTopReadyPriority holds the priority of the
+	highest priority task that may be in the Ready state, and the ready lists
+	are searched downwards from that priority. */
+
+	/* uxTopReadyPriority holds the priority of the highest priority ready
+	state task. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )															\
+	{																										\
+		if( ( uxPriority ) > uxTopReadyPriority )															\
+		{																									\
+			uxTopReadyPriority = ( uxPriority );															\
+		}																									\
+	} /* taskRECORD_READY_PRIORITY */
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()																\
+	{																										\
+		/* Find the highest priority queue that contains ready tasks. */									\
+		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )							\
+		{																									\
+			configASSERT( uxTopReadyPriority );																\
+			--uxTopReadyPriority;																			\
+		}																									\
+																											\
+		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of								\
+		the	same priority get an equal share of the processor time. */										\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );			\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+	/*-----------------------------------------------------------*/
+
+	/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
+	they are not required in this configuration - uxTopReadyPriority is lowered
+	lazily by taskSELECT_HIGHEST_PRIORITY_TASK() instead. */
+	#define taskRESET_READY_PRIORITY( uxPriority )
+	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+
+#else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
+	performed in a way that is tailored to the particular microcontroller
+	architecture being used.  uxTopReadyPriority is used as a bitmap in which
+	bit n is set if there may be a Ready state task of priority n, and the port
+	locates the most significant set bit (normally using a count leading zeros
+	instruction) so the time taken to select a task does not depend on
+	configMAX_PRIORITIES. */
+
+	/* A port optimised version is provided.  Call the port defined macros. */
+	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+
+	/*-----------------------------------------------------------*/
+
+	#define taskSELECT_HIGHEST_PRIORITY_TASK()														\
+	{																								\
+	unsigned portBASE_TYPE uxTopPriority;															\
+																									\
+		/* Find the highest priority queue that contains ready tasks. */							\
+		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
+		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+	/*-----------------------------------------------------------*/
+
+	/* A port optimised version is provided, call it only if the TCB being reset
+	is being referenced from a ready list.  If it is referenced from a delayed
+	or suspended list then it won't be in a ready list. */
+	#define taskRESET_READY_PRIORITY( uxPriority )													\
+	{																								\
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == 0 )				\
+		{																							\
+			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );						\
+		}																							\
+	}
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 ) || ( configUSE_TASK_BUDGETS == 1 ) || ( configRECORD_RELEASE_JITTER == 1 )
+
+	/* pdTRUE if tick count xA is earlier than tick count xB, allowing for the
+	tick count overflowing, provided the two are less than half the range of
+	portTickType apart. */
+	#define taskTICK_IS_BEFORE( xA, xB )	( ( portTickType ) ( ( xB ) - ( xA ) - ( portTickType ) 1U ) < ( portMAX_DELAY >> 1 ) )
+
+#endif
+
 /*-----------------------------------------------------------*/
 
+/*
+ * Notes the time at which a task that has left the Ready state is made ready
+ * again, so the time until it next runs can be measured.  A task that blocked
+ * but was made ready before being switched out never left the Ready state, and
+ * a woken task that is moved between the ready lists before it runs, because
+ * its priority changed, keeps the time at which it was first made ready.
+ */
+#if ( configRECORD_WAKE_LATENCY == 1 )
+
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define taskGET_WAKE_TIME( ulTime )	portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+	#else
+		#define taskGET_WAKE_TIME( ulTime )	( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+
+	#define taskRECORD_WAKE_TIME( pxTCB )																					\
+	{																														\
+		if( ( ( pxTCB )->ucLeftReady != ( unsigned char ) pdFALSE ) && ( ( pxTCB )->ucWakePending == ( unsigned char ) pdFALSE ) )	\
+		{																													\
+			taskGET_WAKE_TIME( ( pxTCB )->ulReadyTime );																	\
+			( pxTCB )->ucWakePending = ( unsigned char ) pdTRUE;															\
+		}																													\
+	}
+
+#else
+
+	#define taskRECORD_WAKE_TIME( pxTCB )
+
+#endif
+
 /*
  * Place the task represented by pxTCB into the appropriate ready queue for
  * the task.  It is inserted at the end of the list.  One quirk of this is
@@ -206,10 +697,8 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  */
 #define prvAddTaskToReadyQueue( pxTCB )																					\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB )																				\
-	if( ( pxTCB )->uxPriority > uxTopReadyPriority )																	\
-	{																													\
-		uxTopReadyPriority = ( pxTCB )->uxPriority;																		\
-	}																													\
+	taskRECORD_WAKE_TIME( pxTCB )																						\
+	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																	\
 	vListInsertEnd( ( xList * ) &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
 /*-----------------------------------------------------------*/
 
@@ -220,14 +709,63 @@ PRIVILEGED_DATA static portTickType xNextTaskUnblockTime						= ( portTickType )
  * Tasks are stored in the queue in the order of their wake time - meaning
  * once one tasks has been found whose timer has not expired we need not look
  * any further down the list.
+ *
+ * When configDELAYED_TASK_WHEEL_SLOTS is not 0 xNextTaskUnblockTime is never
+ * later than the earliest wake time, and the tick count moves on one tick at a
+ * time, so the wheel list indexed by the tick count only has to be checked on
+ * the tick at which xNextTaskUnblockTime is reached.
+ *
+ * When configUSE_64_BIT_TICKS is 1 wake times are held as 64 bit values that
+ * never wrap, so a single delayed list is used and there is nothing to switch
+ * when xTickCount overflows.
  */
+#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+
+#if ( configUSE_64_BIT_TICKS == 0 )
+
+/*
+ * Called when the tick count overflows.  The overflow delayed task list
+ * becomes the current delayed task list.  If there are any items in
+ * pxDelayedTaskList here then there is an error!
+ */
+#define taskSWITCH_DELAYED_LISTS()														\
+{																						\
+xList *pxTemp;																			\
+																						\
+	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );							\
+																						\
+	pxTemp = pxDelayedTaskList;															\
+	pxDelayedTaskList = pxOverflowDelayedTaskList;										\
+	pxOverflowDelayedTaskList = pxTemp;													\
+	xNumOfOverflows++;																	\
+																						\
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )								\
+	{																					\
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to		\
+		the maximum possible value so it is extremely unlikely that the				\
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until there is		\
+		an item in the delayed list. */												\
+		xNextTaskUnblockTime = portMAX_DELAY;											\
+	}																					\
+	else																				\
+	{																					\
+		/* The new current delayed list is not empty, get the value of the item	\
+		at the head of the delayed list.  This is the time at which the task at	\
+		the head of the delayed list should be removed from the Blocked state. */	\
+		pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );			\
+		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );	\
+	}																					\
+}
+
+#endif /* configUSE_64_BIT_TICKS */
+
 #define prvCheckDelayedTasks()															\
 {																						\
-portTickType xItemValue;																\
+portTickCountType xItemValue;															\
 																						\
 	/* Is the tick count greater than or equal to the wake time of the first			\
 	task referenced from the delayed tasks list? */										\
-	if( xTickCount >= xNextTaskUnblockTime )											\
+	if( taskFULL_TICK_COUNT() >= xNextTaskUnblockTime )									\
 	{																					\
 		for( ;; )																		\
 		{																				\
@@ -237,7 +775,7 @@ portTickType xItemValue;																\
 				maximum possible value so it is extremely unlikely that the				\
 				if( xTickCount >= xNextTaskUnblockTime ) test will pass next			\
 				time through. */														\
-				xNextTaskUnblockTime = portMAX_DELAY;									\
+				xNextTaskUnblockTime = portMAX_TICK_COUNT;								\
 				break;																	\
 			}																			\
 			else																		\
@@ -249,7 +787,7 @@ portTickType xItemValue;																\
 				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );	\
 				xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );	\
 																						\
-				if( xTickCount < xItemValue )											\
+				if( taskFULL_TICK_COUNT() < xItemValue )								\
 				{																		\
 					/* It is not time to unblock this item yet, but the item			\
 					value is the time at which the task at the head of the				\
@@ -260,18 +798,60 @@ portTickType xItemValue;																\
 				}																		\
 																						\
 				/* It is time to remove the item from the Blocked state. */				\
-				vListRemove( &( pxTCB->xGenericListItem ) );							\
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );					\
+																						\
+				/* Is the task waiting on an event also? */								\
+				if( pxTCB->xEventListItem.pvContainer != NULL )							\
+				{																		\
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );				\
+				}																		\
+				prvAddTaskToReadyQueue( pxTCB );										\
+				taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB );								\
+			}																			\
+		}																				\
+	}																					\
+}
+
+#else /* configDELAYED_TASK_WHEEL_SLOTS */
+
+#define prvCheckDelayedTasks()															\
+{																						\
+xList *pxSlot;																			\
+xListItem *pxItem, *pxNextItem;															\
+																						\
+	if( xTickCount == xNextTaskUnblockTime )											\
+	{																					\
+		/* Unblock every task in the list for this tick that is due on this		\
+		turn of the wheel. */															\
+		pxSlot = taskDELAYED_WHEEL_SLOT( xTickCount );									\
+		pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;								\
+																						\
+		while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )						\
+		{																				\
+			pxNextItem = ( xListItem * ) pxItem->pxNext;								\
+																						\
+			if( listGET_LIST_ITEM_VALUE( pxItem ) == xTickCount )						\
+			{																			\
+				pxTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem );					\
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );					\
 																						\
 				/* Is the task waiting on an event also? */								\
 				if( pxTCB->xEventListItem.pvContainer != NULL )							\
 				{																		\
-					vListRemove( &( pxTCB->xEventListItem ) );							\
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );				\
 				}																		\
 				prvAddTaskToReadyQueue( pxTCB );										\
+				taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB );								\
 			}																			\
+																						\
+			pxItem = pxNextItem;														\
 		}																				\
+																						\
+		prvResetNextTaskUnblockTime();													\
 	}																					\
 }
+
+#endif /* configDELAYED_TASK_WHEEL_SLOTS */
 /*-----------------------------------------------------------*/
 
 /*
@@ -282,30 +862,97 @@ portTickType xItemValue;																\
  */
 #define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( tskTCB * ) pxCurrentTCB : ( tskTCB * ) ( pxHandle ) )
 
-/* Callback function prototypes. --------------------------*/
-extern void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed char *pcTaskName );
-extern void vApplicationTickHook( void );
-		
-/* File private functions. --------------------------------*/
-
 /*
- * Utility to ready a TCB for a given task.  Mainly just copies the parameters
- * into the TCB structure.
+ * The threshold below which a task of higher priority than the running task
+ * still cannot preempt it, see vTaskPreemptionThresholdSet().  A task that has
+ * used up its budget runs below its base priority, and loses its threshold
+ * until the budget is replenished.
  */
-static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth ) PRIVILEGED_FUNCTION;
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
 
-/*
- * Utility to ready all the lists used by the scheduler.  This is called
- * automatically upon the creation of the first task.
- */
-static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
+	#if ( configUSE_TASK_BUDGETS == 1 )
+		#define taskPREEMPTION_THRESHOLD( pxTCB )	( ( ( pxTCB )->uxPriority < ( pxTCB )->uxBasePriority ) ? ( pxTCB )->uxPriority : ( pxTCB )->uxPreemptionThreshold )
+	#else
+		#define taskPREEMPTION_THRESHOLD( pxTCB )	( ( pxTCB )->uxPreemptionThreshold )
+	#endif
+
+	/* pdTRUE unless the threshold of the running task is above its priority
+	and at or above uxReadyPriority. */
+	#define taskTHRESHOLD_ALLOWS_PREEMPTION( uxReadyPriority )	( ( taskPREEMPTION_THRESHOLD( pxCurrentTCB ) <= pxCurrentTCB->uxPriority ) || ( ( uxReadyPriority ) > taskPREEMPTION_THRESHOLD( pxCurrentTCB ) ) )
+
+	/* Non zero if pxTCB is in the Ready state with a threshold above its
+	priority. */
+	#define taskHOLDS_PREEMPTION_THRESHOLD( pxTCB )	( ( taskPREEMPTION_THRESHOLD( pxTCB ) > ( pxTCB )->uxPriority ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) ) != pdFALSE ) )
+
+#else
+
+	#define taskTHRESHOLD_ALLOWS_PREEMPTION( uxReadyPriority )	pdTRUE
+
+#endif
 
 /*
- * The idle task, which as all tasks is implemented as a never ending loop.
- * The idle task is automatically created and added to the ready lists upon
- * creation of the first user task.
+ * Used when pxTCB has just been made ready, or had its priority raised, to
+ * determine whether the task running on the calling core should yield to it.
+ * taskYIELD_REQUIRED_FOR() also yields for a task of equal priority.  Neither
+ * yields for a task the preemption threshold of the running task holds off.
  *
- * The portTASK_FUNCTION_PROTO() macro is used to allow port/compiler specific
+ * When configNUMBER_OF_CORES is greater than 1 the task may instead be
+ * better placed on another core, in which case prvYieldForTask() interrupts
+ * that core and the macros evaluate to pdFALSE.  The task unblocked by a tick
+ * does not need a yield on the calling core, as the port switches context on
+ * each tick anyway, but may need one on another core.
+ */
+#if ( configNUMBER_OF_CORES == 1 )
+
+	#define taskYIELD_REQUIRED_FOR( pxTCB )				( ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) && taskTHRESHOLD_ALLOWS_PREEMPTION( ( pxTCB )->uxPriority ) )
+	#define taskYIELD_REQUIRED_FOR_HIGHER( pxTCB )		( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) && taskTHRESHOLD_ALLOWS_PREEMPTION( ( pxTCB )->uxPriority ) )
+	#define taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB )
+
+#else
+
+	#define taskYIELD_REQUIRED_FOR( pxTCB )				prvYieldForTask( pxTCB )
+	#define taskYIELD_REQUIRED_FOR_HIGHER( pxTCB )		prvYieldForTask( pxTCB )
+
+	#if ( configUSE_PREEMPTION == 1 )
+		#define taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB )	( void ) prvYieldForTask( pxTCB )
+	#else
+		#define taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB )
+	#endif
+
+	/* Evaluates to pdTRUE if the affinity of pxTCB allows it to run on core
+	xCoreID. */
+	#if ( configUSE_CORE_AFFINITY == 1 )
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )	( ( ( pxTCB )->uxCoreAffinityMask & ( ( unsigned portBASE_TYPE ) 1U << ( unsigned portBASE_TYPE ) ( xCoreID ) ) ) != 0U )
+	#else
+		#define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )	pdTRUE
+	#endif
+
+#endif
+
+/* Callback function prototypes. --------------------------*/
+extern void vApplicationStackOverflowHook( xTaskHandle *pxTask, signed char *pcTaskName );
+extern void vApplicationTickHook( void );
+		
+/* File private functions. --------------------------------*/
+
+/*
+ * Utility to ready a TCB for a given task.  Mainly just copies the parameters
+ * into the TCB structure.
+ */
+static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth ) PRIVILEGED_FUNCTION;
+
+/*
+ * Utility to ready all the lists used by the scheduler.  This is called
+ * automatically upon the creation of the first task.
+ */
+static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The idle task, which as all tasks is implemented as a never ending loop.
+ * The idle task is automatically created and added to the ready lists upon
+ * creation of the first user task.
+ *
+ * The portTASK_FUNCTION_PROTO() macro is used to allow port/compiler specific
  * language extensions.  The equivalent prototype for this function is:
  *
  * void prvIdleTask( void *pvParameters );
@@ -326,6 +973,18 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 
 #endif
 
+/*
+ * Frees a TCB and stack allocated by prvAllocateTCBAndStack().  When
+ * configTASK_RECYCLE_CACHE_SIZE is not 0 and there is room in the cache they
+ * are kept instead, for prvAllocateTCBAndStack() to hand out again to a task
+ * created with the same stack depth.
+ */
+#if ( ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	static void prvFreeTCBAndStack( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -333,17 +992,257 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used only by the idle task when configSTACK_SAMPLE_WORDS is not 0.  Checks
+ * up to configSTACK_SAMPLE_WORDS more words at the end of the stack of one
+ * task, as part of a sweep through the stacks of all the tasks, and updates
+ * the high water mark held in the TCB when the end of the unused part of that
+ * stack is found.  Words are compared whole, so this is cheaper per word than
+ * usTaskCheckFreeStackSpace().
+ */
+#if ( configSTACK_SAMPLE_WORDS > 0 )
+
+	static void prvSampleTaskStacks( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used only by the idle task when configUSE_IDLE_WORK is 1.  Calls the next
+ * registered idle job, in turn, whose budget ends before the next task is due
+ * to unblock.  Returns pdTRUE if a job was called.
+ */
+#if ( configUSE_IDLE_WORK == 1 )
+
+	static portBASE_TYPE prvRunIdleWork( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by vTaskSwitchContext() when the highest priority ready task has the
+ * priority configEDF_PRIORITY.  Of the ready tasks at that priority, selects
+ * the one with the earliest deadline - except that a task running at that
+ * priority because it has inherited it, by holding a mutex, is selected
+ * first, and tasks that have no deadline yet are only selected when no task
+ * with a deadline is ready.  Tasks with the same deadline are selected in
+ * turn.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvSelectEarliestDeadlineTask( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+#endif
+
+/*
+ * Called when a task that blocked in vTaskDelayUntil() is switched in.  Adds
+ * the time from the tick interrupt at which it was due to wake to the moment
+ * it was switched in to its release statistics, unless it was woken before
+ * its wake time.
+ */
+#if ( configRECORD_RELEASE_JITTER == 1 )
+
+	static void prvRecordReleaseLateness( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when a task that was made ready after leaving the Ready state is
+ * switched in.  Adds the time from it being made ready to the moment it was
+ * switched in to its wake up statistics.
+ */
+#if ( configRECORD_WAKE_LATENCY == 1 )
+
+	static void prvRecordWakeLatency( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Changes the priority a task runs at without changing its base priority,
+ * moving it within the ready or event list it is in.
+ */
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvSetInheritedPriority( tskTCB * const pxTCB, unsigned portBASE_TYPE uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called each time the tick count has moved on.  Replenishes the budgets that
+ * are due, returning tasks that had used up their budget to their base
+ * priority, and drops tasks that have used up their budget to priority
+ * configBUDGET_EXHAUSTED_PRIORITY.  Called with interrupts masked and the
+ * scheduler not suspended.
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvCheckTaskBudgets( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Takes a task out of the list of tasks that have a budget.  Called from a
+ * critical section.
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvRemoveBudgetedTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from vTaskIncrementTick() on each tick when a schedule table is in
+ * use, and from xTaskResumeAll() for the ticks that were missed while the
+ * scheduler was suspended, once xTickCount has been advanced by xTicks.
+ * Releases the tasks the table activates on the xTicks ticks of the major
+ * frame being passed over, counting an overrun for any that is still running
+ * its previous activation, then moves on to the tick of the frame after them.
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+
+	static void prvReleaseTimeTriggeredTasks( portTickType xTicks ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the priority of the highest priority Ready state task.
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	static unsigned portBASE_TYPE prvGetHighestReadyPriority( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+#endif
+
+/*
+ * Called from vTaskSwitchContext().  Records the running task as preempted if
+ * its threshold is in force, then selects the most recently preempted task if
+ * no Ready state task has a priority above its threshold.  Returns pdTRUE if
+ * pxCurrentTCB was set, otherwise the caller selects the next task as normal.
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	static portBASE_TYPE prvSelectPreemptedTask( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+	static void prvRemovePreemptedTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills the stack of a newly created task with tskSTACK_FILL_BYTE.  When
+ * configDEFER_STACK_FILL is 1 only a guard band at the end of the stack is
+ * filled, and prvFillTaskStack() fills the rest later.
+ */
+static void prvFillNewStack( tskTCB *pxTCB, unsigned short usStackDepth ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills up to uxMaxWords more words of the unused part of the stack of a task
+ * that is not running, stopping short of the stack pointer saved in its TCB.
+ * pxFillNext is set to NULL once the stack has been filled.  Must be called
+ * with the scheduler suspended so the task cannot run meanwhile.
+ */
+#if ( configDEFER_STACK_FILL == 1 )
+
+	static void prvFillTaskStack( tskTCB *pxTCB, unsigned portBASE_TYPE uxMaxWords ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
- * either the current or the overflow delayed task list.
+ * either the current or the overflow delayed task list, or to the delayed task
+ * wheel if configDELAYED_TASK_WHEEL_SLOTS is not 0.
+ */
+static void prvAddCurrentTaskToDelayedList( portTickCountType xTimeToWake ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+/*
+ * Move the tick count forward by xTicks, unblocking every task whose wake time
+ * is passed on the way, as xTicks calls to vTaskIncrementTick() would but
+ * without calling the tick hook.  The delayed lists are switched at most once
+ * and the delayed tasks are visited at most once, so the time taken does not
+ * depend on xTicks.  Called from a critical section with the scheduler not
+ * suspended.
+ */
+static void prvAdvanceTickCount( portTickType xTicks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Search the delayed task wheel for the earliest wake time and store it in
+ * xNextTaskUnblockTime.  Called each time xNextTaskUnblockTime is reached.
+ */
+#if ( configDELAYED_TASK_WHEEL_SLOTS > 0 )
+
+	static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+#endif
+
+/*
+ * The currently executing task is going to wait for a notification.  Remove
+ * it from the ready list and place it in the Blocked state, either on a
+ * delayed list or, if it is to wait indefinitely, on the suspended list.  No
+ * event list is involved as only the task itself can receive its
+ * notification.  Must be called from within a critical section.
  */
-static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	static void prvAddCurrentTaskToNotificationWait( portTickType xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
  * allocation was successful.
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by xTaskGenericCreate() and xTaskCreateStatic() once the memory for
+ * the TCB and stack has been obtained, to initialise the task and place it in
+ * the ready list.  pxNewTCB being NULL indicates the memory could not be
+ * obtained.
+ */
+static signed portBASE_TYPE prvAddNewTask( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, tskTCB *pxNewTCB, const xMemoryRegion * const xRegions ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the amount of time, in ticks, that will pass before the kernel will
+ * next move a task from the Blocked state to the Running state.
+ *
+ * This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure portSUPPRESS_TICKS_AND_SLEEP() can be called when user
+ * defined low power mode implementations require configUSE_TICKLESS_IDLE to be
+ * set to a value other than 1.
+ */
+#if ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_IDLE_WORK == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_CPU_LOAD_METER == 1 )
+
+	/*
+	 * Called from vTaskIncrementTick() once at least tskLOAD_SAMPLE_TICKS have
+	 * passed since the load was last sampled.  Measures the load since then
+	 * and applies it to the averages once for each sample period that has
+	 * passed.
+	 */
+	static void prvSampleCpuLoad( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the factor by which an average with the decay ulDecay decays
+	 * over xSamples sample periods.
+	 */
+	static unsigned long prvCpuLoadDecay( unsigned long ulDecay, portTickType xSamples ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if pxTCB is an idle task.  Must be called with interrupts
+	 * masked.
+	 */
+	#if ( configNUMBER_OF_CORES == 1 )
+		#define prvIsIdleTask( pxTCB )	( ( pxTCB ) == pxIdleTCBs[ 0 ] )
+	#else
+		static portBASE_TYPE prvIsIdleTask( const tskTCB * const pxTCB ) PRIVILEGED_FUNCTION;
+	#endif
+
+#endif
 
 /*
  * Called from vTaskList.  vListTasks details all the tasks currently under
@@ -360,6 +1259,50 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
+/*
+ * Called from uxTaskGetSystemState.  Fills an xTaskStatusType structure for
+ * each task in pxList, reporting eState as the state of every task other than
+ * the running task(s).  Returns the number of structures filled.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static unsigned portBASE_TYPE prvListTaskStatusWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Fills *pxTaskStatus from the TCB pxTCB, reporting eState as the state of
+ * the task unless it is running.  Used by both uxTaskGetSystemState() and
+ * xTaskGetNextTaskStatus().
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvGetTaskStatus( xTaskStatusType *pxTaskStatus, volatile tskTCB *pxTCB, eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from xTaskGetNextTaskStatus.  If pxList holds a task whose TCB
+ * number is at least uxCursor and lower than that of *ppxNextTCB (or
+ * *ppxNextTCB is NULL) then *ppxNextTCB is set to that task and *peNextState
+ * to eState.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvFindNextTaskWithinSingleList( xList *pxList, eTaskState eState, unsigned portBASE_TYPE uxCursor, tskTCB **ppxNextTCB, eTaskState *peNextState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Sets *pulTotalRunTime, if it is not NULL, to the current value of the run
+ * time counter, or to zero if run time stats are not being gathered.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvGetTotalRunTime( portRUN_TIME_COUNTER_TYPE *pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
@@ -371,6 +1314,36 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Return the TCB of the task running on the calling core.  Interrupts are
+	 * masked while the core number is read and used, so a task cannot be moved
+	 * to another core in between.
+	 */
+	static tskTCB *prvGetCurrentTCB( void ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+	/*
+	 * Select the task that core xCoreID should run next - the highest priority
+	 * ready task that is not running on another core and whose affinity allows
+	 * it to run on xCoreID.  Tasks of equal priority are selected in turn.
+	 * Must be called with both kernel spinlocks held, or before the scheduler
+	 * is started.
+	 */
+	static void prvSelectHighestPriorityTask( portBASE_TYPE xCoreID ) PRIVILEGED_FUNCTION KERNEL_FAST_FUNCTION;
+
+	/*
+	 * pxTCB has just been made ready, or had its priority raised.  Find the
+	 * core, from those pxTCB is allowed to run on, that is running the lowest
+	 * priority task - provided that task has a lower priority than pxTCB.  If
+	 * that is the calling core pdTRUE is returned, so the caller can yield.  If
+	 * it is another core then that core is interrupted and pdFALSE is
+	 * returned.  Must be called with at least one kernel spinlock held.
+	 */
+	static portBASE_TYPE prvYieldForTask( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 
 /*lint +e956 */
 
@@ -380,17 +1353,71 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
  * TASK CREATION API documented in task.h
  *----------------------------------------------------------*/
 
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
-{
-signed portBASE_TYPE xReturn;
-tskTCB * pxNewTCB;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+	{
+	tskTCB * pxNewTCB;
+
+		configASSERT( pxTaskCode );
+		configASSERT( ( uxPriority < configMAX_PRIORITIES ) );
+
+		/* Allocate the memory required by the TCB and stack for the new task,
+		checking that the allocation was successful. */
+		pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			if( pxNewTCB != NULL )
+			{
+				/* The memory must be freed if the task is deleted. */
+				pxNewTCB->ucStaticallyAllocated = pdFALSE;
+			}
+		}
+		#endif
+
+		return prvAddNewTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, xRegions );
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
+	{
+	tskTCB *pxNewTCB = NULL;
+
+		configASSERT( pxTaskCode );
+		configASSERT( ( uxPriority < configMAX_PRIORITIES ) );
+		configASSERT( puxStackBuffer );
+		configASSERT( pxTaskBuffer );
+
+		/* The xStaticTask structure must be the same size as the TCB it is
+		used in place of. */
+		configASSERT( sizeof( xStaticTask ) == sizeof( tskTCB ) );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			/* The TCB and stack use the memory supplied by the caller, and
+			must not be freed if the task is deleted. */
+			pxNewTCB = ( tskTCB * ) pxTaskBuffer;
+			pxNewTCB->pxStack = puxStackBuffer;
+			pxNewTCB->ucStaticallyAllocated = pdTRUE;
+
+			/* Just to help debugging. */
+			prvFillNewStack( pxNewTCB, usStackDepth );
+		}
+
+		return prvAddNewTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+	}
 
-	configASSERT( pxTaskCode );
-	configASSERT( ( uxPriority < configMAX_PRIORITIES ) );
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-	/* Allocate the memory required by the TCB and stack for the new task,
-	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+static signed portBASE_TYPE prvAddNewTask( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, tskTCB *pxNewTCB, const xMemoryRegion * const xRegions )
+{
+signed portBASE_TYPE xReturn;
 
 	if( pxNewTCB != NULL )
 	{
@@ -469,33 +1496,54 @@ tskTCB * pxNewTCB;
 		taskENTER_CRITICAL();
 		{
 			uxCurrentNumberOfTasks++;
-			if( pxCurrentTCB == NULL )
+
+			#if ( configSTACK_SAMPLE_WORDS > 0 )
 			{
-				/* There are no other tasks, or all the other tasks are in
-				the suspended state - make this the current task. */
-				pxCurrentTCB =  pxNewTCB;
+				pxNewTCB->pxNextSampled = pxSampledTasks;
+				pxSampledTasks = pxNewTCB;
+			}
+			#endif
 
-				if( uxCurrentNumberOfTasks == ( unsigned portBASE_TYPE ) 1 )
+			#if ( configNUMBER_OF_CORES == 1 )
+			{
+				if( pxCurrentTCB == NULL )
 				{
-					/* This is the first task to be created so do the preliminary
-					initialisation required.  We will not recover if this call
-					fails, but we will report the failure. */
-					prvInitialiseTaskLists();
+					/* There are no other tasks, or all the other tasks are in
+					the suspended state - make this the current task. */
+					pxCurrentTCB =  pxNewTCB;
+
+					if( uxCurrentNumberOfTasks == ( unsigned portBASE_TYPE ) 1 )
+					{
+						/* This is the first task to be created so do the preliminary
+						initialisation required.  We will not recover if this call
+						fails, but we will report the failure. */
+						prvInitialiseTaskLists();
+					}
 				}
-			}
-			else
-			{
-				/* If the scheduler is not already running, make this task the
-				current task if it is the highest priority task to be created
-				so far. */
-				if( xSchedulerRunning == pdFALSE )
+				else
 				{
-					if( pxCurrentTCB->uxPriority <= uxPriority )
+					/* If the scheduler is not already running, make this task the
+					current task if it is the highest priority task to be created
+					so far. */
+					if( xSchedulerRunning == pdFALSE )
 					{
-						pxCurrentTCB = pxNewTCB;
+						if( pxCurrentTCB->uxPriority <= uxPriority )
+						{
+							pxCurrentTCB = pxNewTCB;
+						}
 					}
 				}
 			}
+			#else
+			{
+				/* Tasks are not assigned to cores until the scheduler is
+				started, so there is no current task to update here. */
+				if( uxCurrentNumberOfTasks == ( unsigned portBASE_TYPE ) 1 )
+				{
+					prvInitialiseTaskLists();
+				}
+			}
+			#endif
 
 			/* Remember the top priority to make context switching faster.  Use
 			the priority in pxNewTCB as this has been capped to a valid value. */
@@ -517,8 +1565,30 @@ tskTCB * pxNewTCB;
 			xReturn = pdPASS;
 			portSETUP_TCB( pxNewTCB );
 			traceTASK_CREATE( pxNewTCB );
+
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* The core that should run the new task, if any, must be
+				chosen while the spinlocks are held.  A yield on this core is
+				held pending until the critical section is exited. */
+				if( xSchedulerRunning != pdFALSE )
+				{
+					if( prvYieldForTask( pxNewTCB ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+			}
+			#endif
 		}
 		taskEXIT_CRITICAL();
+
+		/* A task without a stored name cannot be found by name. */
+		#if ( configUSE_NAME_REGISTRY == 1 ) && ( configUSE_TASK_NAMES == 1 )
+		{
+			( void ) xNameRegistryAdd( pxNewTCB->pcTaskName, ( void * ) pxNewTCB, nameregTYPE_TASK );
+		}
+		#endif
 	}
 	else
 	{
@@ -526,18 +1596,32 @@ tskTCB * pxNewTCB;
 		traceTASK_CREATE_FAILED();
 	}
 
-	if( xReturn == pdPASS )
+	#if ( configNUMBER_OF_CORES == 1 )
 	{
-		if( xSchedulerRunning != pdFALSE )
+		if( xReturn == pdPASS )
 		{
-			/* If the created task is of a higher priority than the current task
-			then it should run now. */
-			if( pxCurrentTCB->uxPriority < uxPriority )
+			if( xSchedulerRunning != pdFALSE )
 			{
-				portYIELD_WITHIN_API();
-			}
+				/* If the created task is of a higher priority than the current task
+				then it should run now. */
+				if( ( pxCurrentTCB->uxPriority < uxPriority ) && taskTHRESHOLD_ALLOWS_PREEMPTION( uxPriority ) )
+				{
+					if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						/* Tasks created while the scheduler is suspended
+						cause one context switch when it is resumed,
+						however many of them there are. */
+						xMissedYield = pdTRUE;
+					}
+				}
+			}
 		}
 	}
+	#endif
 
 	return xReturn;
 }
@@ -549,6 +1633,15 @@ tskTCB * pxNewTCB;
 	{
 	tskTCB *pxTCB;
 
+		/* The registry is updated with the scheduler suspended, so cannot be
+		updated from within the critical section below. */
+		#if ( configUSE_NAME_REGISTRY == 1 ) && ( configUSE_TASK_NAMES == 1 )
+		{
+			pxTCB = prvGetTCBFromHandle( pxTaskToDelete );
+			vNameRegistryRemove( pxTCB->pcTaskName, ( void * ) pxTCB );
+		}
+		#endif
+
 		taskENTER_CRITICAL();
 		{
 			/* Ensure a yield is performed if the current task is being
@@ -565,16 +1658,34 @@ tskTCB * pxNewTCB;
 			This will stop the task from be scheduled.  The idle task will check
 			the termination list and free up any memory allocated by the
 			scheduler for the TCB and stack. */
-			vListRemove( &( pxTCB->xGenericListItem ) );
+			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer != NULL )
 			{
-				vListRemove( &( pxTCB->xEventListItem ) );
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 			}
 
 			vListInsertEnd( ( xList * ) &xTasksWaitingTermination, &( pxTCB->xGenericListItem ) );
 
+			#if ( configUSE_TASK_BUDGETS == 1 )
+			{
+				if( pxTCB->xBudget != ( portTickType ) 0U )
+				{
+					prvRemoveBudgetedTask( pxTCB );
+				}
+			}
+			#endif
+
+			#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+			{
+				prvRemovePreemptedTask( pxTCB );
+			}
+			#endif
+
 			/* Increment the ucTasksDeleted variable so the idle task knows
 			there is a task that has been deleted and that it should therefore
 			check the xTasksWaitingTermination list. */
@@ -584,6 +1695,18 @@ tskTCB * pxNewTCB;
 			can detect that the task lists need re-generating. */
 			uxTaskNumber++;
 
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* If the task is running on another core then that core must
+				stop running it.  The idle task will not free the TCB until it
+				has been switched out. */
+				if( ( pxTaskToDelete != NULL ) && ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) )
+				{
+					portYIELD_CORE( pxTCB->xTaskRunState );
+				}
+			}
+			#endif
+
 			traceTASK_DELETE( pxTCB );
 		}
 		taskEXIT_CRITICAL();
@@ -650,6 +1773,43 @@ tskTCB * pxNewTCB;
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
+			#if ( configUSE_EDF_SCHEDULING == 1 )
+			{
+				/* The task has finished its current job.  The next job is
+				released at xTimeToWake and is due one period (or the
+				relative deadline, if one was set) later. */
+				if( ( pxCurrentTCB->ucHasDeadline != ( unsigned char ) pdFALSE ) && ( taskTICK_IS_BEFORE( pxCurrentTCB->xDeadline, xTickCount ) != pdFALSE ) )
+				{
+					traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+				}
+
+				if( pxCurrentTCB->xRelativeDeadline != ( portTickType ) 0U )
+				{
+					pxCurrentTCB->xDeadline = xTimeToWake + pxCurrentTCB->xRelativeDeadline;
+				}
+				else
+				{
+					pxCurrentTCB->xDeadline = xTimeToWake + xTimeIncrement;
+				}
+				pxCurrentTCB->ucHasDeadline = ( unsigned char ) pdTRUE;
+			}
+			#endif
+
+			#if ( configRECORD_RELEASE_JITTER == 1 )
+			{
+				/* The release is timed when the task next runs. */
+				if( xShouldDelay != pdFALSE )
+				{
+					pxCurrentTCB->xReleaseTime = xTimeToWake;
+					pxCurrentTCB->ucReleasePending = ( unsigned char ) pdTRUE;
+				}
+				else
+				{
+					( pxCurrentTCB->ulOverruns )++;
+				}
+			}
+			#endif
+
 			if( xShouldDelay != pdFALSE )
 			{
 				traceTASK_DELAY_UNTIL();
@@ -657,8 +1817,16 @@ tskTCB * pxNewTCB;
 				/* We must remove ourselves from the ready list before adding
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
-				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-				prvAddCurrentTaskToDelayedList( xTimeToWake );
+				if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+				{
+					/* The current task must be in a ready list, so there is
+					no need to check, and the port reset macro can be called
+					directly. */
+					portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+				}
+				/* xTimeToWake is known to be after the tick count, so the
+				wake time relative to it is also right for a 64 bit count. */
+				prvAddCurrentTaskToDelayedList( taskFULL_TICK_COUNT() + ( portTickType ) ( xTimeToWake - xTickCount ) );
 			}
 		}
 		xAlreadyYielded = xTaskResumeAll();
@@ -674,11 +1842,136 @@ tskTCB * pxNewTCB;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetDeadline( xTaskHandle xTask, portTickType xRelativeDeadline )
+	{
+	tskTCB *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->xRelativeDeadline = xRelativeDeadline;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	void vTaskSetBudget( xTaskHandle xTask, portTickType xBudget, portTickType xPeriod )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+
+		configASSERT( ( xBudget == ( portTickType ) 0U ) || ( ( xPeriod >= xBudget ) && ( xPeriod < ( portMAX_DELAY >> 1 ) ) ) );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( xBudget == ( portTickType ) 0U )
+			{
+				if( pxTCB->xBudget != ( portTickType ) 0U )
+				{
+					prvRemoveBudgetedTask( pxTCB );
+				}
+			}
+			else if( pxTCB->xBudget == ( portTickType ) 0U )
+			{
+				pxTCB->pxNextBudgeted = pxBudgetedTasks;
+				pxBudgetedTasks = pxTCB;
+			}
+
+			/* The first period starts now, with the whole budget. */
+			pxTCB->xBudget = xBudget;
+			pxTCB->xBudgetPeriod = xPeriod;
+			pxTCB->xBudgetLeft = xBudget;
+			pxTCB->xNextReplenish = xTickCount + xPeriod;
+
+			/* A task that had used up its budget goes back to its base
+			priority straight away. */
+			if( pxTCB->uxPriority < pxTCB->uxBasePriority )
+			{
+				traceTASK_BUDGET_REPLENISHED( pxTCB );
+				prvSetInheritedPriority( pxTCB, pxTCB->uxBasePriority );
+
+				if( taskYIELD_REQUIRED_FOR_HIGHER( pxTCB ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xYieldRequired != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+	void vTaskPreemptionThresholdSet( xTaskHandle xTask, unsigned portBASE_TYPE uxNewThreshold )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xYieldRequired = pdFALSE;
+	unsigned portBASE_TYPE uxTopPriority;
+
+		configASSERT( uxNewThreshold < configMAX_PRIORITIES );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxPreemptionThreshold = uxNewThreshold;
+
+			/* Lowering the threshold of the running task may let a task that
+			it was holding off preempt it straight away.  The threshold of
+			any other task only matters once that task runs. */
+			if( ( pxTCB == pxCurrentTCB ) && ( xSchedulerRunning != pdFALSE ) )
+			{
+				uxTopPriority = prvGetHighestReadyPriority();
+				if( ( uxTopPriority > pxCurrentTCB->uxPriority ) && taskTHRESHOLD_ALLOWS_PREEMPTION( uxTopPriority ) )
+				{
+					xYieldRequired = pdTRUE;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xYieldRequired != pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxTaskPreemptionThresholdGet( xTaskHandle xTask )
+	{
+	unsigned portBASE_TYPE uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			uxReturn = prvGetTCBFromHandle( xTask )->uxPreemptionThreshold;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( portTickType xTicksToDelay )
 	{
-	portTickType xTimeToWake;
+	portTickCountType xTimeToWake;
 	signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 
 		/* A delay time of zero just forces a reschedule. */
@@ -698,12 +1991,18 @@ tskTCB * pxNewTCB;
 
 				/* Calculate the time to wake - this may overflow but this is
 				not a problem. */
-				xTimeToWake = xTickCount + xTicksToDelay;
+				xTimeToWake = taskFULL_TICK_COUNT() + xTicksToDelay;
 
 				/* We must remove ourselves from the ready list before adding
 				ourselves to the blocked list as the same list item is used for
 				both lists. */
-				vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+				if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+				{
+					/* The current task must be in a ready list, so there is
+					no need to check, and the port reset macro can be called
+					directly. */
+					portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+				}
 				prvAddCurrentTaskToDelayedList( xTimeToWake );
 			}
 			xAlreadyYielded = xTaskResumeAll();
@@ -783,25 +2082,29 @@ tskTCB * pxNewTCB;
 
 			if( uxCurrentPriority != uxNewPriority )
 			{
-				/* The priority change may have readied a task of higher
-				priority than the calling task. */
-				if( uxNewPriority > uxCurrentPriority )
+				#if ( configNUMBER_OF_CORES == 1 )
 				{
-					if( pxTask != NULL )
+					/* The priority change may have readied a task of higher
+					priority than the calling task. */
+					if( uxNewPriority > uxCurrentPriority )
+					{
+						if( pxTask != NULL )
+						{
+							/* The priority of another task is being raised.  If we
+							were raising the priority of the currently running task
+							there would be no need to switch as it must have already
+							been the highest priority task. */
+							xYieldRequired = pdTRUE;
+						}
+					}
+					else if( pxTask == NULL )
 					{
-						/* The priority of another task is being raised.  If we
-						were raising the priority of the currently running task
-						there would be no need to switch as it must have already
-						been the highest priority task. */
+						/* Setting our own priority down means there may now be another
+						task of higher priority that is ready to execute. */
 						xYieldRequired = pdTRUE;
 					}
 				}
-				else if( pxTask == NULL )
-				{
-					/* Setting our own priority down means there may now be another
-					task of higher priority that is ready to execute. */
-					xYieldRequired = pdTRUE;
-				}
+				#endif
 
 
 
@@ -823,7 +2126,12 @@ tskTCB * pxNewTCB;
 				}
 				#endif
 
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				/* Only reset the event list item value if the value is not
+				being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( configMAX_PRIORITIES - ( portTickType ) uxNewPriority ) );
+				}
 
 				/* If the task is in the blocked or suspended list we need do
 				nothing more than change it's priority variable. However, if
@@ -834,10 +2142,47 @@ tskTCB * pxNewTCB;
 					/* The task is currently in its ready list - remove before adding
 					it to it's new ready list.  As we are in a critical section we
 					can do this even if the scheduler is suspended. */
-					vListRemove( &( pxTCB->xGenericListItem ) );
+					if( uxListRemove( &( pxTCB->xGenericListItem ) ) == 0 )
+					{
+						/* It is known that the task is in its ready list so
+						there is no need to check again and the port level
+						reset macro can be called directly. */
+						portRESET_READY_PRIORITY( uxCurrentPriority, uxTopReadyPriority );
+					}
 					prvAddTaskToReadyQueue( pxTCB );
 				}
 
+				#if ( configNUMBER_OF_CORES > 1 )
+				{
+					if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+					{
+						/* Lowering the priority of a running task means a
+						higher priority task may now be ready to run in its
+						place - on whichever core it is running. */
+						if( uxNewPriority < uxCurrentPriority )
+						{
+							if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								portYIELD_CORE( pxTCB->xTaskRunState );
+							}
+						}
+					}
+					else if( uxNewPriority > uxCurrentPriority )
+					{
+						/* Raising the priority of a task that is not running
+						may mean it should now preempt one of the cores. */
+						if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+						{
+							xYieldRequired = prvYieldForTask( pxTCB );
+						}
+					}
+				}
+				#endif
+
 				if( xYieldRequired == pdTRUE )
 				{
 					portYIELD_WITHIN_API();
@@ -871,15 +2216,37 @@ tskTCB * pxNewTCB;
 			traceTASK_SUSPEND( pxTCB );
 
 			/* Remove task from the ready/delayed list and place in the	suspended list. */
-			vListRemove( &( pxTCB->xGenericListItem ) );
+			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
 
 			/* Is the task waiting on an event also? */
 			if( pxTCB->xEventListItem.pvContainer != NULL )
 			{
-				vListRemove( &( pxTCB->xEventListItem ) );
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 			}
 
 			vListInsertEnd( ( xList * ) &xSuspendedTaskList, &( pxTCB->xGenericListItem ) );
+
+			#if ( configRECORD_WAKE_LATENCY == 1 )
+			{
+				/* A task suspended after being made ready is timed from when
+				it is resumed. */
+				pxTCB->ucWakePending = ( unsigned char ) pdFALSE;
+			}
+			#endif
+
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* If the task is running on another core then that core must
+				stop running it. */
+				if( ( pxTaskToSuspend != NULL ) && ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) )
+				{
+					portYIELD_CORE( pxTCB->xTaskRunState );
+				}
+			}
+			#endif
 		}
 		taskEXIT_CRITICAL();
 
@@ -890,6 +2257,7 @@ tskTCB * pxNewTCB;
 				/* We have just suspended the current task. */
 				portYIELD_WITHIN_API();
 			}
+			#if ( configNUMBER_OF_CORES == 1 )
 			else
 			{
 				/* The scheduler is not running, but the task that was pointed
@@ -908,6 +2276,7 @@ tskTCB * pxNewTCB;
 					vTaskSwitchContext();
 				}
 			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 	}
 
@@ -973,11 +2342,11 @@ tskTCB * pxNewTCB;
 
 					/* As we are in a critical section we can access the ready
 					lists even if the scheduler is suspended. */
-					vListRemove(  &( pxTCB->xGenericListItem ) );
+					( void ) uxListRemove(  &( pxTCB->xGenericListItem ) );
 					prvAddTaskToReadyQueue( pxTCB );
 
 					/* We may have just resumed a higher priority task. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB ) != pdFALSE )
 					{
 						/* This yield may not cause the task just resumed to run, but
 						will leave the lists in the correct state for the next yield. */
@@ -1005,7 +2374,7 @@ tskTCB * pxNewTCB;
 
 		pxTCB = ( tskTCB * ) pxTaskToResume;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( xTaskIsTaskSuspended( pxTCB ) == pdTRUE )
 			{
@@ -1013,8 +2382,8 @@ tskTCB * pxNewTCB;
 
 				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 				{
-					xYieldRequired = ( pxTCB->uxPriority >= pxCurrentTCB->uxPriority );
-					vListRemove(  &( pxTCB->xGenericListItem ) );
+					xYieldRequired = taskYIELD_REQUIRED_FOR( pxTCB );
+					( void ) uxListRemove(  &( pxTCB->xGenericListItem ) );
 					prvAddTaskToReadyQueue( pxTCB );
 				}
 				else
@@ -1022,16 +2391,84 @@ tskTCB * pxNewTCB;
 					/* We cannot access the delayed or ready lists, so will hold this
 					task pending until the scheduler is resumed, at which point a
 					yield will be performed if necessary. */
+					taskRECORD_WAKE_TIME( pxTCB );
 					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
 
 #endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+
+	void vTaskCoreAffinitySet( xTaskHandle xTask, unsigned portBASE_TYPE uxCoreAffinityMask )
+	{
+	tskTCB *pxTCB;
+	portBASE_TYPE xCoreID;
+
+		/* A task must be allowed to run on at least one core. */
+		configASSERT( uxCoreAffinityMask != 0U );
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then we are changing the affinity of
+			the calling task. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+			{
+				/* A running task that is no longer allowed to run on its core
+				must be switched out of it. */
+				xCoreID = pxTCB->xTaskRunState;
+
+				if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) == pdFALSE )
+				{
+					if( xCoreID == portGET_CORE_ID() )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						portYIELD_CORE( xCoreID );
+					}
+				}
+			}
+			else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+			{
+				/* A ready task may now be allowed to run on a core that is
+				running a lower priority task. */
+				if( prvYieldForTask( pxTCB ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxTaskCoreAffinityGet( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	unsigned portBASE_TYPE uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif
 
 
 
@@ -1043,21 +2480,59 @@ tskTCB * pxNewTCB;
 
 void vTaskStartScheduler( void )
 {
-portBASE_TYPE xReturn;
+portBASE_TYPE xReturn = pdPASS;
+portBASE_TYPE xCoreID;
 
-	/* Add the idle task at the lowest priority. */
-	#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
-	{
-		/* Create the idle task, storing its handle in xIdleTaskHandle so it can
-		be returned by the xTaskGetIdleTaskHandle() function. */
-		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle );
-	}
-	#else
+	/* Add the idle task at the lowest priority.  When configNUMBER_OF_CORES
+	is greater than 1 there is one idle task for each core, so every core
+	always has a task to run. */
+	for( xCoreID = 0; ( xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
 	{
-		/* Create the idle task without storing its handle. */
-		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL );
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTask *pxIdleTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxIdleTaskStackBuffer = NULL;
+		unsigned short usIdleTaskStackSize = tskIDLE_STACK_SIZE;
+		xTaskHandle *pxIdleTaskHandle = NULL;
+
+			#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+			{
+				/* Store the handle in xIdleTaskHandle so it can be returned by the
+				xTaskGetIdleTaskHandle() function. */
+				pxIdleTaskHandle = &xIdleTaskHandle;
+			}
+			#endif
+
+			/* The idle task is created using memory supplied by the application,
+			so the scheduler can be started without a heap. */
+			vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &usIdleTaskStackSize );
+			xReturn = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), pxIdleTaskHandle, pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer );
+		}
+		#elif ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+		{
+			/* Create the idle task, storing its handle in xIdleTaskHandle so it can
+			be returned by the xTaskGetIdleTaskHandle() function. */
+			xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), &xIdleTaskHandle );
+		}
+		#else
+		{
+			/* Create the idle task without storing its handle. */
+			xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL );
+		}
+		#endif
+
+		#if ( configDEFER_STACK_FILL == 1 )
+		{
+			/* The idle task is always running when stacks are filled, so it
+			cannot fill its own.  It has just been added to the head of the
+			list of tasks and has not run yet, so fill its stack now. */
+			if( xReturn == pdPASS )
+			{
+				prvFillTaskStack( pxSampledTasks, ( unsigned portBASE_TYPE ) tskIDLE_STACK_SIZE );
+			}
+		}
+		#endif
 	}
-	#endif
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -1080,13 +2555,41 @@ portBASE_TYPE xReturn;
 		DEBUGGER ALLOWS INTERRUPTS TO BE PROCESSED. */
 		portDISABLE_INTERRUPTS();
 
-		xSchedulerRunning = pdTRUE;
-		xTickCount = ( portTickType ) 0U;
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Choose the first task to run on each core.  The port starts each
+			core running the task held in its entry in pxCurrentTCBs[]. */
+			for( xCoreID = 0; xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif
 
-		/* If configGENERATE_RUN_TIME_STATS is defined then the following
+		xSchedulerRunning = pdTRUE;
+		#if ( INCLUDE_vTaskSetInitialTickCount != 1 )
+		{
+			/* Otherwise the tick count is left as vTaskSetInitialTickCount()
+			set it, so it reads the same before and after this point. */
+			xTickCount = ( portTickType ) 0U;
+		}
+		#endif
+
+		/* Guard the stack of the first task to run.  From now on the guard
+		is moved in vTaskSwitchContext(). */
+		portSET_STACK_GUARD( pxCurrentTCB->pxStack );
+
+		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+		#if ( configUSE_CPU_LOAD_METER == 1 )
+		{
+			/* The first load sample is measured from here. */
+			taskGET_LOAD_METER_TIME( ulLoadSampleTime );
+		}
+		#endif
 		
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
@@ -1106,6 +2609,27 @@ portBASE_TYPE xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskSetInitialTickCount == 1 )
+
+	void vTaskSetInitialTickCount( portTickType xStartTickCount )
+	{
+		/* No task can be blocked with a wake time yet, and the tick interrupt
+		is not running, so the count can be set directly.  Anything that reads
+		it from here on, such as a timer started from main(), sees the same
+		count the scheduler starts from. */
+		configASSERT( xSchedulerRunning == pdFALSE );
+		xTickCount = xStartTickCount;
+
+		#if ( configUSE_64_BIT_TICKS == 1 )
+		{
+			xTickEpoch = ( portTickCountType ) 0U;
+		}
+		#endif
+	}
+
+#endif /* INCLUDE_vTaskSetInitialTickCount */
+/*-----------------------------------------------------------*/
+
 void vTaskEndScheduler( void )
 {
 	/* Stop the scheduler interrupts and call the portable scheduler end
@@ -1119,9 +2643,37 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	portBASE_TYPE. */
-	++uxSchedulerSuspended;
+	#if ( configNUMBER_OF_CORES == 1 )
+	{
+		/* A critical section is not required as the variable is of type
+		portBASE_TYPE. */
+		++uxSchedulerSuspended;
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The task lock is held until xTaskResumeAll() is called, so tasks
+			on other cores cannot suspend the scheduler or enter a critical
+			section until then.  The ISR lock is only needed while the count is
+			changed, as interrupts on other cores test it. */
+			portGET_TASK_LOCK();
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			portGET_ISR_LOCK();
+			{
+				++uxSchedulerSuspended;
+			}
+			portRELEASE_ISR_LOCK();
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			++uxSchedulerSuspended;
+		}
+	}
+	#endif
 }
 /*----------------------------------------------------------*/
 
@@ -1143,6 +2695,18 @@ signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Release the task lock taken by vTaskSuspendAll().  It is still
+			held by the critical section, and is released fully before any
+			yield requested below is performed. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				portRELEASE_TASK_LOCK();
+			}
+		}
+		#endif
+
 		if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( unsigned portBASE_TYPE ) 0U )
@@ -1154,13 +2718,13 @@ signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 				while( listLIST_IS_EMPTY( ( xList * ) &xPendingReadyList ) == pdFALSE )
 				{
 					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY(  ( ( xList * ) &xPendingReadyList ) );
-					vListRemove( &( pxTCB->xEventListItem ) );
-					vListRemove( &( pxTCB->xGenericListItem ) );
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
 					prvAddTaskToReadyQueue( pxTCB );
 
 					/* If we have moved a task that has a priority higher than
 					the current task then we should yield. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB ) != pdFALSE )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1171,11 +2735,31 @@ signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 				slip, and that any delayed tasks are resumed at the correct time. */
 				if( uxMissedTicks > ( unsigned portBASE_TYPE ) 0U )
 				{
-					while( uxMissedTicks > ( unsigned portBASE_TYPE ) 0U )
+					/* The missed ticks are processed in one step, so the time
+					taken does not grow with the time spent suspended.  The
+					tick hook was called by each missed tick already. */
+					prvAdvanceTickCount( ( portTickType ) uxMissedTicks );
+					traceINCREASE_TICK_COUNT( uxMissedTicks );
+
+					/* The schedule table is stepped over the same ticks, so
+					the frame does not slip against the tick count. */
+					#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+					{
+						if( pxSchedule != NULL )
+						{
+							prvReleaseTimeTriggeredTasks( ( portTickType ) uxMissedTicks );
+						}
+					}
+					#endif
+
+					/* Budgets used up while the scheduler was suspended are
+					also only acted on now. */
+					#if ( configUSE_TASK_BUDGETS == 1 )
 					{
-						vTaskIncrementTick();
-						--uxMissedTicks;
+						prvCheckTaskBudgets();
 					}
+					#endif
+					uxMissedTicks = ( unsigned portBASE_TYPE ) 0U;
 
 					/* As we have processed some ticks it is appropriate to yield
 					to ensure the highest priority task that is ready to run is
@@ -1187,6 +2771,22 @@ signed portBASE_TYPE xAlreadyYielded = pdFALSE;
 					#endif
 				}
 
+				#if ( configNUMBER_OF_CORES > 1 )
+				{
+				portBASE_TYPE xCoreID;
+
+					/* Other cores that tried to switch context while the
+					scheduler was suspended must now do so. */
+					for( xCoreID = 0; xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xCoreID++ )
+					{
+						if( ( xCoreID != portGET_CORE_ID() ) && ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+						{
+							portYIELD_CORE( xCoreID );
+						}
+					}
+				}
+				#endif
+
 				if( ( xYieldRequired == pdTRUE ) || ( xMissedYield == pdTRUE ) )
 				{
 					xAlreadyYielded = pdTRUE;
@@ -1232,14 +2832,85 @@ portTickType xTaskGetTickCountFromISR( void )
 portTickType xReturn;
 unsigned portBASE_TYPE uxSavedInterruptStatus;
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	xReturn = xTickCount;
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_64_BIT_TICKS == 1 )
+
+	portTickCountType xTaskGetTickCount64( void )
+	{
+	portTickCountType xTicks;
+
+		/* Both parts of the count change in the tick interrupt. */
+		taskENTER_CRITICAL();
+		{
+			xTicks = taskFULL_TICK_COUNT();
+		}
+		taskEXIT_CRITICAL();
+
+		return xTicks;
+	}
+
+#endif /* configUSE_64_BIT_TICKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+
+	portBASE_TYPE xTaskSetTickRate( portTickType xTickRateHz )
+	{
+	portBASE_TYPE xReturn = pdFAIL;
+	portTickType xTicks;
+
+		if( ( xTickRateHz > ( portTickType ) 0U ) && ( ( configTICK_RATE_HZ % xTickRateHz ) == ( portTickType ) 0U ) )
+		{
+			xTicks = ( portTickType ) ( configTICK_RATE_HZ / xTickRateHz );
+
+			taskENTER_CRITICAL();
+			{
+				/* The port makes the tick period after the one that is
+				running xTicks ticks long, unless that is more than its timer
+				can count. */
+				if( portSET_TICK_INTERRUPT_PERIOD( xTicks ) != pdFAIL )
+				{
+					xTicksPerTickInterrupt = xTicks;
+
+					if( xSchedulerRunning == pdFALSE )
+					{
+						/* The tick interrupt starts at the new rate. */
+						xTicksForNextTickInterrupt = xTicks;
+					}
+
+					xReturn = pdPASS;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	portTickType xTaskGetTickRate( void )
+	{
+		/* A critical section is not required as xTicksPerTickInterrupt is only
+		written by xTaskSetTickRate(). */
+		return ( portTickType ) ( configTICK_RATE_HZ / xTicksPerTickInterrupt );
+	}
+	/*-----------------------------------------------------------*/
+
+	portTickType xTaskGetTicksForNextTickInterrupt( void )
+	{
+		return xTicksForNextTickInterrupt;
+	}
+
+#endif /* configUSE_DYNAMIC_TICK_RATE */
+/*-----------------------------------------------------------*/
+
 unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 {
 	/* A critical section is not required because the variables are of type
@@ -1257,7 +2928,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 		/* If null is passed in here then the name of the calling task is being queried. */
 		pxTCB = prvGetTCBFromHandle( xTaskToQuery );
 		configASSERT( pxTCB );
-		return &( pxTCB->pcTaskName[ 0 ] );
+		return taskGET_TCB_NAME( pxTCB );
 	}
 
 #endif
@@ -1292,15 +2963,33 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
-			}
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, tskBLOCKED_CHAR );
+				}
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				#if ( configUSE_64_BIT_TICKS == 0 )
+				{
+					if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+					{
+						prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+					}
+				}
+				#endif
+			}
+			#else
 			{
-				prvListTaskWithinSingleList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, tskBLOCKED_CHAR );
+				for( uxQueue = ( unsigned portBASE_TYPE ) 0U; uxQueue < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxQueue++ )
+				{
+					if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxQueue ] ) ) == pdFALSE )
+					{
+						prvListTaskWithinSingleList( pcWriteBuffer, &( xDelayedTaskWheel[ uxQueue ] ), tskBLOCKED_CHAR );
+					}
+				}
 			}
+			#endif
 
 			#if( INCLUDE_vTaskDelete == 1 )
 			{
@@ -1331,7 +3020,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 	void vTaskGetRunTimeStats( signed char *pcWriteBuffer )
 	{
 	unsigned portBASE_TYPE uxQueue;
-	unsigned long ulTotalRunTime;
+	portRUN_TIME_COUNTER_TYPE ulTotalRunTime;
 
 		/* This is a VERY costly function that should be used for debug only.
 		It leaves interrupts disabled for a LONG time. */
@@ -1346,7 +3035,7 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 			/* Divide ulTotalRunTime by 100 to make the percentage caluclations
 			simpler in the prvGenerateRunTimeStatsForTasksInList() function. */
-			ulTotalRunTime /= 100UL;
+			ulTotalRunTime /= ( portRUN_TIME_COUNTER_TYPE ) 100U;
 			
 			/* Run through all the lists that could potentially contain a TCB,
 			generating a table of run timer percentages in the provided
@@ -1367,15 +3056,33 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 				}
 			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
 
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+			#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
-			}
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxDelayedTaskList, ulTotalRunTime );
+				}
 
-			if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+				#if ( configUSE_64_BIT_TICKS == 0 )
+				{
+					if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+					{
+						prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+					}
+				}
+				#endif
+			}
+			#else
 			{
-				prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, ( xList * ) pxOverflowDelayedTaskList, ulTotalRunTime );
+				for( uxQueue = ( unsigned portBASE_TYPE ) 0U; uxQueue < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxQueue++ )
+				{
+					if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxQueue ] ) ) == pdFALSE )
+					{
+						prvGenerateRunTimeStatsForTasksInList( pcWriteBuffer, &( xDelayedTaskWheel[ uxQueue ] ), ulTotalRunTime );
+					}
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskDelete == 1 )
 			{
@@ -1401,1067 +3108,4822 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 #endif
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	xTaskHandle xTaskGetIdleTaskHandle( void )
+	portRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
 	{
-		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
-	}
-	
-#endif
-
-/*-----------------------------------------------------------
- * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
- * documented in task.h
- *----------------------------------------------------------*/
-
-void vTaskIncrementTick( void )
-{
-tskTCB * pxTCB;
+	portRUN_TIME_COUNTER_TYPE ulIdleRunTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+	unsigned portBASE_TYPE uxIdleTask;
 
-	/* Called by the portable layer each time a tick interrupt occurs.
-	Increments the tick then checks to see if the new tick value will cause any
-	tasks to be unblocked. */
-	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
-	{
-		++xTickCount;
-		if( xTickCount == ( portTickType ) 0U )
+		taskENTER_CRITICAL();
 		{
-			xList *pxTemp;
-
-			/* Tick count has overflowed so we need to swap the delay lists.
-			If there are any items in pxDelayedTaskList here then there is
-			an error! */
-			configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );
-			
-			pxTemp = pxDelayedTaskList;
-			pxDelayedTaskList = pxOverflowDelayedTaskList;
-			pxOverflowDelayedTaskList = pxTemp;
-			xNumOfOverflows++;
-	
-			if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+			for( uxIdleTask = ( unsigned portBASE_TYPE ) 0U; uxIdleTask < uxIdleTasksStarted; uxIdleTask++ )
 			{
-				/* The new current delayed list is empty.  Set
-				xNextTaskUnblockTime to the maximum possible value so it is
-				extremely unlikely that the	
-				if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-				there is an item in the delayed list. */
-				xNextTaskUnblockTime = portMAX_DELAY;
-			}
-			else
-			{
-				/* The new current delayed list is not empty, get the value of
-				the item at the head of the delayed list.  This is the time at
-				which the task at the head of the delayed list should be removed
-				from the Blocked state. */
-				pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-				xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xGenericListItem ) );
+				ulIdleRunTime += pxIdleTCBs[ uxIdleTask ]->ulRunTimeCounter;
 			}
 		}
+		taskEXIT_CRITICAL();
 
-		/* See if this tick has made a timeout expire. */
-		prvCheckDelayedTasks();
+		return ulIdleRunTime;
 	}
-	else
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configUSE_CPU_LOAD_METER == 1 )
+
+	unsigned short usTaskGetCpuLoad( unsigned portBASE_TYPE uxAverage )
 	{
-		++uxMissedTicks;
+	unsigned long ulLoad;
 
-		/* The tick hook gets called at regular intervals, even if the
-		scheduler is locked. */
-		#if ( configUSE_TICK_HOOK == 1 )
+		configASSERT( uxAverage < ( unsigned portBASE_TYPE ) tskCPU_LOAD_AVERAGES );
+
+		/* The average may be wider than the native word of the
+		microcontroller. */
+		taskENTER_CRITICAL();
 		{
-			vApplicationTickHook();
+			ulLoad = ulCpuLoadAverages[ uxAverage ];
 		}
-		#endif
+		taskEXIT_CRITICAL();
+
+		/* Convert to tenths of a percent, rounding to nearest. */
+		return ( unsigned short ) ( ( ( ulLoad * 1000UL ) + ( tskCPU_LOAD_ONE >> 1 ) ) >> tskCPU_LOAD_SHIFT );
 	}
+	/*-----------------------------------------------------------*/
 
-	#if ( configUSE_TICK_HOOK == 1 )
+	portRUN_TIME_COUNTER_TYPE ulTaskGetIdleTime( void )
 	{
-		/* Guard against the tick hook being called when the missed tick
-		count is being unwound (when the scheduler is being unlocked. */
-		if( uxMissedTicks == ( unsigned portBASE_TYPE ) 0U )
+	portRUN_TIME_COUNTER_TYPE ulReturn;
+
+		taskENTER_CRITICAL();
 		{
-			vApplicationTickHook();
+			ulReturn = ulIdleTime;
 		}
-	}
-	#endif
-
-	traceTASK_INCREMENT_TICK( xTickCount );
-}
-/*-----------------------------------------------------------*/
+		taskEXIT_CRITICAL();
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
 
-	void vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction )
+	static void prvSampleCpuLoad( void )
 	{
-	tskTCB *xTCB;
+	static const unsigned long ulDecays[ tskCPU_LOAD_AVERAGES ] = { tskCPU_LOAD_DECAY_1S, tskCPU_LOAD_DECAY_10S, tskCPU_LOAD_DECAY_60S };
+	portRUN_TIME_COUNTER_TYPE ulTimeNow, ulElapsed, ulBusy;
+	unsigned long ulSample, ulDecay;
+	portTickType xSamples;
+	unsigned portBASE_TYPE uxAverage;
 
-		/* If xTask is NULL then we are setting our own task hook. */
-		if( xTask == NULL )
+		taskGET_LOAD_METER_TIME( ulTimeNow );
+
+		/* Bring the idle time up to date with any idle task that is running
+		now. */
+		#if ( configNUMBER_OF_CORES == 1 )
 		{
-			xTCB = ( tskTCB * ) pxCurrentTCB;
+			if( prvIsIdleTask( pxCurrentTCB ) )
+			{
+				ulIdleTime += ulTimeNow - ulIdleSwitchedInTime;
+				ulIdleSwitchedInTime = ulTimeNow;
+			}
 		}
-		else
+		#else
 		{
-			xTCB = ( tskTCB * ) xTask;
+		portBASE_TYPE xCoreID;
+
+			for( xCoreID = 0; xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				if( prvIsIdleTask( pxCurrentTCBs[ xCoreID ] ) )
+				{
+					ulIdleTime += ulTimeNow - ulIdleSwitchedInTimes[ xCoreID ];
+					ulIdleSwitchedInTimes[ xCoreID ] = ulTimeNow;
+				}
+			}
 		}
+		#endif
 
-		/* Save the hook function in the TCB.  A critical section is required as
-		the value can be accessed from an interrupt. */
-		taskENTER_CRITICAL();
-			xTCB->pxTaskTag = pxHookFunction;
-		taskEXIT_CRITICAL();
-	}
+		/* Every core could have been busy for the whole interval. */
+		ulElapsed = ( ulTimeNow - ulLoadSampleTime ) * ( portRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+		ulBusy = ulIdleTime - ulLoadSampleIdleTime;
+		ulBusy = ( ulBusy < ulElapsed ) ? ( ulElapsed - ulBusy ) : ( portRUN_TIME_COUNTER_TYPE ) 0U;
 
-#endif
-/*-----------------------------------------------------------*/
+		/* More than one sample period has passed if the tick was suppressed or
+		the scheduler was suspended.  The load measured over the whole interval
+		is applied for each of them. */
+		xSamples = ( xTickCount - xLoadSampleTick ) / tskLOAD_SAMPLE_TICKS;
+		xLoadSampleTick += xSamples * tskLOAD_SAMPLE_TICKS;
+		ulLoadSampleTime = ulTimeNow;
+		ulLoadSampleIdleTime = ulIdleTime;
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		if( ulElapsed > ( portRUN_TIME_COUNTER_TYPE ) 0U )
+		{
+			/* Reduce the interval to 11 bits so the busy time can be scaled
+			to a fraction of tskCPU_LOAD_ONE without overflowing. */
+			while( ulElapsed > ( portRUN_TIME_COUNTER_TYPE ) 0x7ffU )
+			{
+				ulElapsed >>= 1;
+				ulBusy >>= 1;
+			}
 
-	pdTASK_HOOK_CODE xTaskGetApplicationTaskTag( xTaskHandle xTask )
+			if( ulElapsed > ( portRUN_TIME_COUNTER_TYPE ) 0U )
+			{
+				ulSample = ( ( ( unsigned long ) ulBusy ) << tskCPU_LOAD_SHIFT ) / ( unsigned long ) ulElapsed;
+
+				for( uxAverage = ( unsigned portBASE_TYPE ) 0U; uxAverage < ( unsigned portBASE_TYPE ) tskCPU_LOAD_AVERAGES; uxAverage++ )
+				{
+					/* Move the average towards the sample by the fraction the
+					average decays over the samples that have passed. */
+					ulDecay = prvCpuLoadDecay( ulDecays[ uxAverage ], xSamples );
+					if( ulCpuLoadAverages[ uxAverage ] > ulSample )
+					{
+						ulCpuLoadAverages[ uxAverage ] = ulSample + ( ( ( ulCpuLoadAverages[ uxAverage ] - ulSample ) * ulDecay ) >> tskCPU_LOAD_DECAY_SHIFT );
+					}
+					else
+					{
+						ulCpuLoadAverages[ uxAverage ] = ulSample - ( ( ( ulSample - ulCpuLoadAverages[ uxAverage ] ) * ulDecay ) >> tskCPU_LOAD_DECAY_SHIFT );
+					}
+				}
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static unsigned long prvCpuLoadDecay( unsigned long ulDecay, portTickType xSamples )
 	{
-	tskTCB *xTCB;
-	pdTASK_HOOK_CODE xReturn;
+	unsigned long ulReturn = tskCPU_LOAD_DECAY_ONE;
 
-		/* If xTask is NULL then we are setting our own task hook. */
-		if( xTask == NULL )
+		/* Raise ulDecay to the power xSamples by repeated squaring, so a long
+		interval without ticks costs no more than a few multiplications. */
+		while( ( xSamples > ( portTickType ) 0U ) && ( ulReturn > 0UL ) )
 		{
-			xTCB = ( tskTCB * ) pxCurrentTCB;
+			if( ( xSamples & ( portTickType ) 1U ) != ( portTickType ) 0U )
+			{
+				ulReturn = ( ulReturn * ulDecay ) >> tskCPU_LOAD_DECAY_SHIFT;
+			}
+
+			ulDecay = ( ulDecay * ulDecay ) >> tskCPU_LOAD_DECAY_SHIFT;
+			xSamples >>= 1;
 		}
-		else
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if ( configNUMBER_OF_CORES > 1 )
+
+		static portBASE_TYPE prvIsIdleTask( const tskTCB * const pxTCB )
 		{
-			xTCB = ( tskTCB * ) xTask;
-		}
+		unsigned portBASE_TYPE uxIdleTask;
+		portBASE_TYPE xReturn = pdFALSE;
 
-		/* Save the hook function in the TCB.  A critical section is required as
+			for( uxIdleTask = ( unsigned portBASE_TYPE ) 0U; uxIdleTask < uxIdleTasksStarted; uxIdleTask++ )
+			{
+				if( pxIdleTCBs[ uxIdleTask ] == pxTCB )
+				{
+					xReturn = pdTRUE;
+					break;
+				}
+			}
+
+			return xReturn;
+		}
+
+	#endif
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetSystemState( xTaskStatusType *pxTaskStatusArray, unsigned portBASE_TYPE uxArraySize, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+	{
+	unsigned portBASE_TYPE uxTask = 0U, uxQueue;
+
+		configASSERT( pxTaskStatusArray );
+
+		vTaskSuspendAll();
+		{
+			/* Is there space in the array for each task in the system? */
+			if( uxArraySize >= uxCurrentNumberOfTasks )
+			{
+				/* Run through all the lists that could potentially contain a
+				TCB, as vTaskList() does. */
+				uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+
+				do
+				{
+					uxQueue--;
+
+					if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+					{
+						uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), eReady );
+					}
+				}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+				#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+					{
+						uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
+					}
+
+					#if ( configUSE_64_BIT_TICKS == 0 )
+					{
+						if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+						{
+							uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+						}
+					}
+					#endif
+				}
+				#else
+				{
+					for( uxQueue = ( unsigned portBASE_TYPE ) 0U; uxQueue < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxQueue++ )
+					{
+						if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxQueue ] ) ) == pdFALSE )
+						{
+							uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue ] ), eBlocked );
+						}
+					}
+				}
+				#endif
+
+				#if( INCLUDE_vTaskDelete == 1 )
+				{
+					if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+					{
+						uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+					}
+				}
+				#endif
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+					{
+						uxTask += prvListTaskStatusWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+					}
+				}
+				#endif
+			}
+
+			prvGetTotalRunTime( pulTotalRunTime );
+		}
+		( void ) xTaskResumeAll();
+
+		return uxTask;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	signed portBASE_TYPE xTaskGetNextTaskStatus( unsigned portBASE_TYPE *puxCursor, xTaskStatusType *pxTaskStatus, portRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+	{
+	tskTCB *pxNextTCB = NULL;
+	eTaskState eNextState = eReady;
+	unsigned portBASE_TYPE uxQueue;
+	signed portBASE_TYPE xReturn = pdFALSE;
+
+		configASSERT( puxCursor );
+		configASSERT( pxTaskStatus );
+
+		/* Only one task is reported per call, so the scheduler is suspended
+		for a single pass over the lists rather than for the whole walk.  Tasks
+		are visited in order of TCB number, which is fixed for the life of a
+		task, so a task that changes list between calls is neither missed nor
+		reported twice. */
+		vTaskSuspendAll();
+		{
+			uxQueue = uxTopUsedPriority + ( unsigned portBASE_TYPE ) 1U;
+
+			do
+			{
+				uxQueue--;
+
+				if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxQueue ] ) ) == pdFALSE )
+				{
+					prvFindNextTaskWithinSingleList( ( xList * ) &( pxReadyTasksLists[ uxQueue ] ), eReady, *puxCursor, &pxNextTCB, &eNextState );
+				}
+			}while( uxQueue > ( unsigned short ) tskIDLE_PRIORITY );
+
+			#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) == pdFALSE )
+				{
+					prvFindNextTaskWithinSingleList( ( xList * ) pxDelayedTaskList, eBlocked, *puxCursor, &pxNextTCB, &eNextState );
+				}
+
+				#if ( configUSE_64_BIT_TICKS == 0 )
+				{
+					if( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )
+					{
+						prvFindNextTaskWithinSingleList( ( xList * ) pxOverflowDelayedTaskList, eBlocked, *puxCursor, &pxNextTCB, &eNextState );
+					}
+				}
+				#endif
+			}
+			#else
+			{
+				for( uxQueue = ( unsigned portBASE_TYPE ) 0U; uxQueue < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxQueue++ )
+				{
+					if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxQueue ] ) ) == pdFALSE )
+					{
+						prvFindNextTaskWithinSingleList( &( xDelayedTaskWheel[ uxQueue ] ), eBlocked, *puxCursor, &pxNextTCB, &eNextState );
+					}
+				}
+			}
+			#endif
+
+			#if( INCLUDE_vTaskDelete == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+				{
+					prvFindNextTaskWithinSingleList( &xTasksWaitingTermination, eDeleted, *puxCursor, &pxNextTCB, &eNextState );
+				}
+			}
+			#endif
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( listLIST_IS_EMPTY( &xSuspendedTaskList ) == pdFALSE )
+				{
+					prvFindNextTaskWithinSingleList( &xSuspendedTaskList, eSuspended, *puxCursor, &pxNextTCB, &eNextState );
+				}
+			}
+			#endif
+
+			if( pxNextTCB != NULL )
+			{
+				prvGetTaskStatus( pxTaskStatus, pxNextTCB, eNextState );
+				*puxCursor = pxNextTCB->uxTCBNumber + ( unsigned portBASE_TYPE ) 1U;
+				xReturn = pdTRUE;
+			}
+
+			prvGetTotalRunTime( pulTotalRunTime );
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvGetTotalRunTime( portRUN_TIME_COUNTER_TYPE *pulTotalRunTime )
+	{
+		if( pulTotalRunTime != NULL )
+		{
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+				#else
+					*pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+			}
+			#else
+			{
+				*pulTotalRunTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+			}
+			#endif
+		}
+	}
+
+#endif
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+	xTaskHandle xTaskGetIdleTaskHandle( void )
+	{
+		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+		started, then xIdleTaskHandle will be NULL. */
+		configASSERT( ( xIdleTaskHandle != NULL ) );
+		return xIdleTaskHandle;
+	}
+	
+#endif
+
+/*-----------------------------------------------------------
+ * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+ * documented in task.h
+ *----------------------------------------------------------*/
+
+void vTaskIncrementTick( void )
+{
+tskTCB * pxTCB;
+#if ( configNUMBER_OF_CORES > 1 )
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+#endif
+#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+	portTickType xTicksThisInterrupt;
+#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		/* The tick is processed by a single core, but the lists it accesses
+		are shared with every other core. */
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	}
+	#endif
+
+	#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+	{
+		/* The tick period that has just ended was started at the rate in
+		force when the one before it ended.  The port has already started the
+		next one at the rate set last. */
+		xTicksThisInterrupt = xTicksForNextTickInterrupt;
+		xTicksForNextTickInterrupt = xTicksPerTickInterrupt;
+	}
+	#endif
+
+	#if ( configRECORD_RELEASE_JITTER == 1 )
+	{
+	portRUN_TIME_COUNTER_TYPE ulTimeNow;
+
+		/* Note when the tick occurred, as the releases it causes are timed
+		from it. */
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+		#else
+			ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+		ulTickPeriodRunTime = ulTimeNow - ulTickRunTime;
+		ulTickRunTime = ulTimeNow;
+	}
+	#endif
+
+	#if ( configUSE_TASK_BUDGETS == 1 )
+	{
+		/* Charge the tick to the task that was running, even if it has the
+		scheduler suspended.  xBudgetLeft is always 0 for a task that has no
+		budget. */
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			if( pxCurrentTCB->xBudgetLeft > xTicksThisInterrupt )
+			{
+				pxCurrentTCB->xBudgetLeft -= xTicksThisInterrupt;
+			}
+			else
+			{
+				pxCurrentTCB->xBudgetLeft = ( portTickType ) 0U;
+			}
+		}
+		#else
+		{
+			if( pxCurrentTCB->xBudgetLeft > ( portTickType ) 0U )
+			{
+				--( pxCurrentTCB->xBudgetLeft );
+			}
+		}
+		#endif
+	}
+	#endif
+
+	/* Called by the portable layer each time a tick interrupt occurs.
+	Increments the tick then checks to see if the new tick value will cause any
+	tasks to be unblocked. */
+	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+	{
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		if( xTicksThisInterrupt > ( portTickType ) 1U )
+		{
+			/* A tick period longer than one tick has ended.  Every task whose
+			wake time is in the ticks it covered is unblocked now. */
+			prvAdvanceTickCount( xTicksThisInterrupt );
+		}
+		else
+		#endif /* configUSE_DYNAMIC_TICK_RATE */
+		{
+			++xTickCount;
+
+			#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 ) && ( configUSE_64_BIT_TICKS == 0 )
+			if( xTickCount == ( portTickType ) 0U )
+			{
+				/* Tick count has overflowed so we need to swap the delay lists. */
+				taskSWITCH_DELAYED_LISTS();
+			}
+			#else
+			if( xTickCount == ( portTickType ) 0U )
+			{
+				/* Neither the delayed task wheel nor the single delayed list
+				used with a 64 bit tick count needs anything done when the tick
+				count overflows. */
+				taskTICK_COUNT_OVERFLOWED();
+			}
+			#endif /* configDELAYED_TASK_WHEEL_SLOTS */
+
+			/* See if this tick has made a timeout expire. */
+			prvCheckDelayedTasks();
+		}
+
+		#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+		{
+			if( pxSchedule != NULL )
+			{
+				prvReleaseTimeTriggeredTasks( ( portTickType ) 1U );
+			}
+		}
+		#endif
+
+		#if ( configUSE_CPU_LOAD_METER == 1 )
+		{
+			if( ( xTickCount - xLoadSampleTick ) >= tskLOAD_SAMPLE_TICKS )
+			{
+				prvSampleCpuLoad();
+			}
+		}
+		#endif
+
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			prvCheckTaskBudgets();
+		}
+		#endif
+
+		#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+		{
+		portBASE_TYPE xCoreID, xOtherCoreID;
+		unsigned portBASE_TYPE uxPriority, uxTasksRunningAtPriority;
+
+			/* The port switches context on the core that processes the tick.
+			Any other core is made to yield if there are more ready tasks at
+			the priority of the task it is running than there are cores running
+			tasks of that priority, so tasks of equal priority share all the
+			cores.  Cores running at the idle priority are skipped, as the
+			ready list at that priority always holds an idle task for every
+			core, and the idle tasks yield to other idle priority tasks
+			themselves. */
+			for( xCoreID = 0; xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+
+				if( ( xCoreID != portGET_CORE_ID() ) && ( uxPriority > tskIDLE_PRIORITY ) )
+				{
+					uxTasksRunningAtPriority = ( unsigned portBASE_TYPE ) 0U;
+
+					for( xOtherCoreID = 0; xOtherCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xOtherCoreID++ )
+					{
+						if( pxCurrentTCBs[ xOtherCoreID ]->uxPriority == uxPriority )
+						{
+							uxTasksRunningAtPriority++;
+						}
+					}
+
+					if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) ) > uxTasksRunningAtPriority )
+					{
+						portYIELD_CORE( xCoreID );
+					}
+				}
+			}
+		}
+		#endif
+	}
+	else
+	{
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			uxMissedTicks += ( unsigned portBASE_TYPE ) xTicksThisInterrupt;
+		}
+		#else
+		{
+			++uxMissedTicks;
+		}
+		#endif
+
+		/* The tick hook gets called at regular intervals, even if the
+		scheduler is locked. */
+		#if ( configUSE_TICK_HOOK == 1 )
+		{
+			vApplicationTickHook();
+		}
+		#endif
+	}
+
+	#if ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+	{
+		/* Timer callbacks that run in the tick interrupt are called on time
+		even if the scheduler is suspended, as the tick hook is. */
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			vTimerProcessTickCallbacks( xTicksThisInterrupt );
+		}
+		#else
+		{
+			vTimerProcessTickCallbacks( ( portTickType ) 1U );
+		}
+		#endif
+	}
+	#endif
+
+	#if ( configUSE_TICK_HOOK == 1 )
+	{
+		/* The hook has already been called above if the scheduler is
+		suspended. */
+		if( uxMissedTicks == ( unsigned portBASE_TYPE ) 0U )
+		{
+			vApplicationTickHook();
+		}
+	}
+	#endif
+
+	traceTASK_INCREMENT_TICK( xTickCount );
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+
+static void prvAdvanceTickCount( portTickType xTicks )
+{
+tskTCB * pxTCB;
+#if ( configUSE_64_BIT_TICKS != 1 )
+	portTickType xTicksToOverflow;
+#endif
+
+	#if ( configUSE_64_BIT_TICKS == 1 )
+	{
+		if( xTicks > ( portMAX_DELAY - xTickCount ) )
+		{
+			/* Wake times do not wrap, so there are no lists to switch. */
+			taskTICK_COUNT_OVERFLOWED();
+		}
+	}
+	#else
+	{
+		/* Held in a portTickType so the comparison is not made after integer
+		promotion when the tick type is narrower than an int. */
+		xTicksToOverflow = portMAX_DELAY - xTickCount;
+
+		if( xTicks > xTicksToOverflow )
+		{
+			/* The tick count overflows on the way.  Every task in the current
+			delayed list is due before it does, so they are all unblocked with
+			the tick count at its maximum value before the lists are
+			switched. */
+			xTicks -= xTicksToOverflow + ( portTickType ) 1U;
+			xTickCount = portMAX_DELAY;
+			prvCheckDelayedTasks();
+
+			xTickCount = ( portTickType ) 0U;
+			taskSWITCH_DELAYED_LISTS();
+		}
+	}
+	#endif
+
+	/* The delayed list is in wake time order, so a single pass from its head
+	unblocks every task that has become due. */
+	xTickCount += xTicks;
+	prvCheckDelayedTasks();
+}
+
+#else /* configDELAYED_TASK_WHEEL_SLOTS */
+
+static void prvAdvanceTickCount( portTickType xTicks )
+{
+tskTCB * pxTCB;
+xList *pxSlot;
+xListItem *pxItem, *pxNextItem;
+portTickType xTick, xSlotsToCheck;
+portBASE_TYPE xTasksDue;
+
+	/* xNextTaskUnblockTime is never later than the earliest wake time, so
+	if it is not reached no task can be due. */
+	xTasksDue = ( ( portTickType ) ( xNextTaskUnblockTime - xTickCount ) <= xTicks );
+
+	if( xTasksDue != pdFALSE )
+	{
+		/* Check the lists for the ticks being passed over, each at most once
+		however many turns of the wheel xTicks spans.  A task is due if its
+		wake time is in the xTicks ticks after the current tick count. */
+		xSlotsToCheck = ( xTicks < ( portTickType ) configDELAYED_TASK_WHEEL_SLOTS ) ? xTicks : ( portTickType ) configDELAYED_TASK_WHEEL_SLOTS;
+
+		for( xTick = ( portTickType ) 1U; xTick <= xSlotsToCheck; xTick++ )
+		{
+			pxSlot = taskDELAYED_WHEEL_SLOT( xTickCount + xTick );
+			pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+
+			while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+			{
+				pxNextItem = ( xListItem * ) pxItem->pxNext;
+
+				if( ( portTickType ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xTickCount - ( portTickType ) 1U ) < xTicks )
+				{
+					pxTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem );
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+
+					/* Is the task waiting on an event also? */
+					if( pxTCB->xEventListItem.pvContainer != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					}
+					prvAddTaskToReadyQueue( pxTCB );
+					taskYIELD_CORE_FOR_UNBLOCKED_TASK( pxTCB );
+				}
+
+				pxItem = pxNextItem;
+			}
+		}
+	}
+
+	/* The delayed task wheel does not need to do anything when the tick
+	count overflows. */
+	if( ( portTickType ) ( xTickCount + xTicks ) < xTickCount )
+	{
+		taskTICK_COUNT_OVERFLOWED();
+	}
+	xTickCount += xTicks;
+
+	if( xTasksDue != pdFALSE )
+	{
+		prvResetNextTaskUnblockTime();
+	}
+}
+
+#endif /* configDELAYED_TASK_WHEEL_SLOTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	void vTaskStepTick( portTickType xTicksToJump )
+	{
+		/* Correct the tick count value after a period during which the tick
+		was suppressed.  Note this does *not* call the tick hook function for
+		each stepped tick.  The port layer ensures the tick interrupt that
+		unblocks the next task is not included in xTicksToJump, so stepping
+		the tick count can never skip over a task's wake time. */
+		#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+		{
+			configASSERT( ( taskFULL_TICK_COUNT() + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#else
+		{
+			configASSERT( xTicksToJump < ( portTickType ) ( xNextTaskUnblockTime - xTickCount ) );
+		}
+		#endif
+
+		#if ( configUSE_64_BIT_TICKS == 1 )
+		{
+		portTickType xTicksToOverflow;
+
+			/* Held in a portTickType so the comparison is not made after
+			integer promotion when the tick type is narrower than an int. */
+			xTicksToOverflow = portMAX_DELAY - xTickCount;
+
+			if( xTicksToJump > xTicksToOverflow )
+			{
+				taskTICK_COUNT_OVERFLOWED();
+			}
+		}
+		#endif
+		xTickCount += xTicksToJump;
+
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		{
+			/* The port restarts the tick interrupt to end the tick that is
+			part way through, after which it runs at the rate set last. */
+			xTicksForNextTickInterrupt = ( portTickType ) 1U;
+		}
+		#endif
+
+		#if ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+		{
+			/* prvGetExpectedIdleTime() does not let the sleep reach the
+			expiry of a tick timer, so no callback is due here. */
+			vTimerProcessTickCallbacks( xTicksToJump );
+		}
+		#endif
+
+		#if ( configRECORD_RELEASE_JITTER == 1 )
+		{
+			/* The tick interrupt was not running, so the time of the last
+			tick is taken to be now. */
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTickRunTime );
+			#else
+				ulTickRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
+		}
+		#endif
+
+		traceINCREASE_TICK_COUNT( xTicksToJump );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	void vTaskSetApplicationTaskTag( xTaskHandle xTask, pdTASK_HOOK_CODE pxHookFunction )
+	{
+	tskTCB *xTCB;
+
+		/* If xTask is NULL then we are setting our own task hook. */
+		if( xTask == NULL )
+		{
+			xTCB = ( tskTCB * ) pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = ( tskTCB * ) xTask;
+		}
+
+		/* Save the hook function in the TCB.  A critical section is required as
+		the value can be accessed from an interrupt. */
+		taskENTER_CRITICAL();
+			xTCB->pxTaskTag = pxHookFunction;
+		taskEXIT_CRITICAL();
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	pdTASK_HOOK_CODE xTaskGetApplicationTaskTag( xTaskHandle xTask )
+	{
+	tskTCB *xTCB;
+	pdTASK_HOOK_CODE xReturn;
+
+		/* If xTask is NULL then we are setting our own task hook. */
+		if( xTask == NULL )
+		{
+			xTCB = ( tskTCB * ) pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = ( tskTCB * ) xTask;
+		}
+
+		/* Save the hook function in the TCB.  A critical section is required as
 		the value can be accessed from an interrupt. */
 		taskENTER_CRITICAL();
-			xReturn = xTCB->pxTaskTag;
+			xReturn = xTCB->pxTaskTag;
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+
+	void vTaskSetThreadLocalStoragePointer( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue )
+	{
+	tskTCB *pxTCB;
+
+		configASSERT( ( xIndex >= 0 ) && ( xIndex < ( portBASE_TYPE ) configNUM_THREAD_LOCAL_STORAGE_POINTERS ) );
+
+		/* A single pointer sized write, so no critical section is needed. */
+		pxTCB = prvGetTCBFromHandle( xTaskToSet );
+		pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+
+	void vTaskSetThreadLocalStoragePointerAndDelCallback( xTaskHandle xTaskToSet, portBASE_TYPE xIndex, void *pvValue, pdTLS_DELETE_CALLBACK pxDeleteCallback )
+	{
+	tskTCB *pxTCB;
+
+		configASSERT( ( xIndex >= 0 ) && ( xIndex < ( portBASE_TYPE ) configNUM_THREAD_LOCAL_STORAGE_POINTERS ) );
+
+		pxTCB = prvGetTCBFromHandle( xTaskToSet );
+
+		/* prvDeleteTCB() reads the pointer and its callback as a pair, so
+		they are written together. */
+		taskENTER_CRITICAL();
+		{
+			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+			pxTCB->pxThreadLocalStorageDeleteCallbacks[ xIndex ] = pxDeleteCallback;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+
+	void *pvTaskGetThreadLocalStoragePointer( xTaskHandle xTaskToQuery, portBASE_TYPE xIndex )
+	{
+	tskTCB *pxTCB;
+
+		configASSERT( ( xIndex >= 0 ) && ( xIndex < ( portBASE_TYPE ) configNUM_THREAD_LOCAL_STORAGE_POINTERS ) );
+
+		pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+		return pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+	}
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+	portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter )
+	{
+	tskTCB *xTCB;
+	portBASE_TYPE xReturn;
+
+		/* If xTask is NULL then we are calling our own task hook. */
+		if( xTask == NULL )
+		{
+			xTCB = ( tskTCB * ) pxCurrentTCB;
+		}
+		else
+		{
+			xTCB = ( tskTCB * ) xTask;
+		}
+
+		if( xTCB->pxTaskTag != NULL )
+		{
+			xReturn = xTCB->pxTaskTag( pvParameter );
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+#if ( configUSE_TRACE_FACILITY == 1 )
+	tskTCB *pxPreviousTCB;
+	portTickType xTimeBlocked;
+#endif
+#if ( configNUMBER_OF_CORES == 1 )
+	portBASE_TYPE xThresholdTaskSelected = pdFALSE;
+#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		/* The port calls this function with interrupts masked.  Both locks
+		are taken as the ready lists, and the tasks running on the other
+		cores, are examined when selecting the next task. */
+		portGET_TASK_LOCK();
+		portGET_ISR_LOCK();
+	}
+	#endif
+
+	if( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE )
+	{
+		/* The scheduler is currently suspended - do not allow a context
+		switch. */
+		xMissedYield = pdTRUE;
+	}
+	else
+	{
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Any yield held pending for this core is performed now. */
+			xMissedYield = pdFALSE;
+		}
+		#endif
+
+		traceTASK_SWITCHED_OUT();
+	
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			portRUN_TIME_COUNTER_TYPE ulTempCounter;
+			
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTempCounter );
+				#else
+					ulTempCounter = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+	
+				/* Add the amount of time the task has been running to the accumulated
+				time so far.  The time the task started running was stored in
+				ulTaskSwitchedInTime.  Note that there is no overflow protection here
+				so, unless configUSE_64_BIT_RUN_TIME_COUNTER is set to 1, count values
+				are only valid until the timer overflows.  Generally this will be
+				about 1 hour assuming a 1uS timer increment. */
+				#if ( configNUMBER_OF_CORES == 1 )
+				{
+					pxCurrentTCB->ulRunTimeCounter += ( ulTempCounter - ulTaskSwitchedInTime );
+					ulTaskSwitchedInTime = ulTempCounter;
+				}
+				#else
+				{
+					pxCurrentTCB->ulRunTimeCounter += ( ulTempCounter - ulTaskSwitchedInTime[ portGET_CORE_ID() ] );
+					ulTaskSwitchedInTime[ portGET_CORE_ID() ] = ulTempCounter;
+				}
+				#endif
+		}
+		#endif
+
+		#if ( configUSE_CPU_LOAD_METER == 1 )
+		{
+			/* Only switches into and out of the idle task are timed. */
+			if( prvIsIdleTask( pxCurrentTCB ) )
+			{
+			portRUN_TIME_COUNTER_TYPE ulTimeNow;
+
+				taskGET_LOAD_METER_TIME( ulTimeNow );
+				ulIdleTime += ulTimeNow - ulIdleSwitchedInTime;
+			}
+		}
+		#endif
+	
+		taskFIRST_CHECK_FOR_STACK_OVERFLOW();
+		taskSECOND_CHECK_FOR_STACK_OVERFLOW();
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			pxPreviousTCB = pxCurrentTCB;
+
+			/* If the task is being switched out because it has left the
+			Ready state, note when so the time until it next runs can be
+			measured. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xGenericListItem ) ) == pdFALSE )
+			{
+				pxPreviousTCB->xTimeLeftReady = xTickCount;
+				pxPreviousTCB->ucLeftReady = ( unsigned char ) pdTRUE;
+			}
+		}
+		#endif
+	
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+			{
+				xThresholdTaskSelected = prvSelectPreemptedTask();
+			}
+			#endif
+
+			if( xThresholdTaskSelected == pdFALSE )
+			{
+				taskSELECT_HIGHEST_PRIORITY_TASK();
+
+				#if ( configUSE_EDF_SCHEDULING == 1 )
+				{
+					/* Tasks at configEDF_PRIORITY are run in deadline order
+					rather than in turn. */
+					if( pxCurrentTCB->uxPriority == ( unsigned portBASE_TYPE ) configEDF_PRIORITY )
+					{
+						prvSelectEarliestDeadlineTask();
+					}
+				}
+				#endif
+			}
+		}
+		#else
+		{
+			prvSelectHighestPriorityTask( portGET_CORE_ID() );
+		}
+		#endif
+
+		/* Move the MPU stack guard, if the port has one, to the stack of the
+		task being switched in. */
+		portSET_STACK_GUARD( pxCurrentTCB->pxStack );
+
+		#if ( configUSE_CPU_LOAD_METER == 1 )
+		{
+			if( prvIsIdleTask( pxCurrentTCB ) )
+			{
+				taskGET_LOAD_METER_TIME( ulIdleSwitchedInTime );
+			}
+		}
+		#endif
+
+		#if ( configUSE_TRACE_FACILITY == 1 )
+		{
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				( pxCurrentTCB->ulSwitchInCount )++;
+			}
+
+			if( pxCurrentTCB->ucLeftReady != ( unsigned char ) pdFALSE )
+			{
+				xTimeBlocked = xTickCount - pxCurrentTCB->xTimeLeftReady;
+				if( xTimeBlocked > pxCurrentTCB->xMaxBlockTime )
+				{
+					pxCurrentTCB->xMaxBlockTime = xTimeBlocked;
+				}
+				pxCurrentTCB->ucLeftReady = ( unsigned char ) pdFALSE;
+			}
+		}
+		#endif
+
+		#if ( configRECORD_RELEASE_JITTER == 1 )
+		{
+			if( pxCurrentTCB->ucReleasePending != ( unsigned char ) pdFALSE )
+			{
+				prvRecordReleaseLateness( pxCurrentTCB );
+			}
+		}
+		#endif
+
+		#if ( configRECORD_WAKE_LATENCY == 1 )
+		{
+			if( pxCurrentTCB->ucWakePending != ( unsigned char ) pdFALSE )
+			{
+				prvRecordWakeLatency( pxCurrentTCB );
+			}
+		}
+		#endif
+	
+		traceTASK_SWITCHED_IN();
+	}
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		portRELEASE_ISR_LOCK();
+		portRELEASE_TASK_LOCK();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicksToWait )
+{
+portTickCountType xTimeToWake;
+
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
+	SCHEDULER SUSPENDED. */
+
+	/* Place the event list item of the TCB in the appropriate event list.
+	This is placed in the list in priority order so the highest priority task
+	is the first to be woken by the event. */
+	vListInsert( ( xList * ) pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+
+	/* We must remove ourselves from the ready list before adding ourselves
+	to the blocked list as the same list item is used for both lists.  We have
+	exclusive access to the ready lists as the scheduler is locked. */
+	if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+	{
+		/* The current task must be in a ready list, so there is no need to
+		check, and the port reset macro can be called directly. */
+		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+	}
+
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		if( xTicksToWait == portMAX_DELAY )
+		{
+			/* Add ourselves to the suspended task list instead of a delayed task
+			list to ensure we are not woken by a timing event.  We will block
+			indefinitely. */
+			vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+	}
+	#else
+	{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if configUSE_TIMERS == 1
+
+	void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickType xTicksToWait )
+	{
+	portTickCountType xTimeToWake;
+
+		configASSERT( pxEventList );
+
+		/* This function should not be called by application code hence the
+		'Restricted' in its name.  It is not part of the public API.  It is
+		designed for use by kernel code, and has special calling requirements -
+		it should be called from a critical section. */
+
+	
+		/* Place the event list item of the TCB in the appropriate event list.
+		In this case it is assume that this is the only task that is going to
+		be waiting on this event list, so the faster vListInsertEnd() function
+		can be used in place of vListInsert. */
+		vListInsertEnd( ( xList * ) pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+
+		/* We must remove this task from the ready list before adding it to the
+		blocked list as the same list item is used for both lists.  This
+		function is called form a critical section. */
+		if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+		{
+			/* The current task must be in a ready list, so there is no need to
+			check, and the port reset macro can be called directly. */
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+
+		/* Calculate the time at which the task should be woken if the event does
+		not occur.  This may overflow but this doesn't matter. */
+		xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+		prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+	void vTaskPlaceOnPriorityEventList( xPriorityList * const pxEventList, portTickType xTicksToWait )
+	{
+	portTickCountType xTimeToWake;
+
+		configASSERT( pxEventList );
+
+		/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
+		SCHEDULER SUSPENDED. */
+
+		/* Place the event list item of the TCB at the end of the bucket for its
+		priority, which takes the same time however many tasks are already
+		waiting.  xTaskRemoveFromEventList() is passed the highest priority
+		bucket that holds tasks, so the highest priority task is still the
+		first to be woken by the event. */
+		vListInsertPriority( pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ), pxCurrentTCB->uxPriority );
+
+		/* We must remove ourselves from the ready list before adding ourselves
+		to the blocked list as the same list item is used for both lists.  We have
+		exclusive access to the ready lists as the scheduler is locked. */
+		if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+		{
+			/* The current task must be in a ready list, so there is no need to
+			check, and the port reset macro can be called directly. */
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Add ourselves to the suspended task list instead of a delayed
+				task list to ensure we are not woken by a timing event.  We will
+				block indefinitely. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				/* Calculate the time at which the task should be woken if the
+				event does not occur.  This may overflow but this doesn't
+				matter. */
+				xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
+		}
+		#else
+		{
+				/* Calculate the time at which the task should be woken if the
+				event does not occur.  This may overflow but this doesn't
+				matter. */
+				xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+		#endif
+	}
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 ) && ( configUSE_TIMERS == 1 )
+
+	void vTaskPlaceOnPriorityEventListRestricted( xPriorityList * const pxEventList, portTickType xTicksToWait )
+	{
+	portTickCountType xTimeToWake;
+
+		configASSERT( pxEventList );
+
+		/* As vTaskPlaceOnEventListRestricted(), but for a priority event list.
+		It is for use by kernel code only, and must be called from a critical
+		section. */
+		vListInsertPriority( pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ), pxCurrentTCB->uxPriority );
+
+		if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+		{
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
+
+		xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+		prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS && configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList )
+{
+tskTCB *pxUnblockedTCB;
+portBASE_TYPE xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
+	SCHEDULER SUSPENDED.  It can also be called from within an ISR. */
+
+	/* The event list is sorted in priority order, so we can remove the
+	first in the list, remove the TCB from the delayed list, and add
+	it to the ready list.
+
+	If an event is for a queue that is locked then this function will never
+	get called - the lock count on the queue will get modified instead.  This
+	means we can always expect exclusive access to the event list here.
+	
+	This function assumes that a check has already been made to ensure that
+	pxEventList is not empty. */
+	pxUnblockedTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+
+	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+		prvAddTaskToReadyQueue( pxUnblockedTCB );
+	}
+	else
+	{
+		/* We cannot access the delayed or ready lists, so will hold this
+		task pending until the scheduler is resumed. */
+		taskRECORD_WAKE_TIME( pxUnblockedTCB );
+		vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+	}
+
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB ) != pdFALSE )
+	{
+		/* Return true if the task removed from the event list has
+		a higher priority than the calling task.  This allows
+		the calling task to know if it should force a context
+		switch now. */
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( xList * pxEventList, portTickType xItemValue, portTickType xTicksToWait )
+{
+portTickCountType xTimeToWake;
+
+	configASSERT( pxEventList );
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE );
+
+	/* Store the item value in the event list item.  It is safe to access the
+	event list item here as interrupts won't access the event list item of a
+	task that is not in the Blocked state. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Place the event list item of the TCB at the end of the appropriate event
+	list.  It is safe to access the event list here because it is part of an
+	event group implementation - and interrupts don't access event groups
+	directly (instead they access them indirectly by pending function calls to
+	the timer task). */
+	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+	/* The task must be removed from the ready list before it is added to the
+	blocked list.  Exclusive access can be assured to the ready list as the
+	scheduler is locked. */
+	if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+	{
+		/* The current task must be in a ready list, so there is no need to
+		check, and the port reset macro can be called directly. */
+		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+	}
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		if( xTicksToWait == portMAX_DELAY )
+		{
+			/* Add the task to the suspended task list instead of a delayed task
+			list to ensure it is not woken by a timing event.  It will block
+			indefinitely. */
+			vListInsertEnd( ( xList * ) &xSuspendedTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		}
+		else
+		{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+		}
+	}
+	#else
+	{
+			/* Calculate the time at which the task should be woken if the event does
+			not occur.  This may overflow but this doesn't matter. */
+			xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem * pxEventListItem, portTickType xItemValue )
+{
+tskTCB *pxUnblockedTCB;
+portBASE_TYPE xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+	the event groups implementation. */
+	configASSERT( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE );
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	/* Remove the event list item from the event group.  Interrupts do not
+	access event groups directly. */
+	pxUnblockedTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	/* Remove the task from the delayed list and add it to the ready list.  The
+	scheduler is suspended so interrupts will not be accessing the ready
+	lists. */
+	( void ) uxListRemove( &( pxUnblockedTCB->xGenericListItem ) );
+	prvAddTaskToReadyQueue( pxUnblockedTCB );
+
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB ) != pdFALSE )
+	{
+		/* Return true if the task removed from the event list has
+		a higher priority than the calling task.  This allows
+		the calling task to know if it should force a context
+		switch now.  The task was placed directly in the ready list so
+		xTaskResumeAll() will not see it - mark the yield as missed so it
+		is performed when the scheduler is resumed. */
+		xReturn = pdTRUE;
+		xMissedYield = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portTickType uxTaskResetEventItemValue( void )
+{
+portTickType uxReturn;
+
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+
+	/* Reset the event list item to its normal value - so it can be used with
+	queues and semaphores. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( portTickType ) configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority ) );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
+{
+	configASSERT( pxTimeOut );
+	#if ( configUSE_64_BIT_TICKS == 1 )
+	{
+		pxTimeOut->xTimeOnEntering = taskFULL_TICK_COUNT();
+	}
+	#else
+	{
+		pxTimeOut->xOverflowCount = xNumOfOverflows;
+		pxTimeOut->xTimeOnEntering = xTickCount;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait )
+{
+portBASE_TYPE xReturn;
+#if ( configUSE_64_BIT_TICKS == 1 )
+	portTickCountType xElapsed;
+#endif
+
+	configASSERT( pxTimeOut );
+	configASSERT( pxTicksToWait );
+
+	taskENTER_CRITICAL();
+	{
+		#if ( INCLUDE_vTaskSuspend == 1 )
+			/* If INCLUDE_vTaskSuspend is set to 1 and the block time specified is
+			the maximum block time then the task should block indefinitely, and
+			therefore never time out. */
+			if( *pxTicksToWait == portMAX_DELAY )
+			{
+				xReturn = pdFALSE;
+			}
+			else /* We are not blocking indefinitely, perform the checks below. */
+		#endif
+
+		#if ( configUSE_64_BIT_TICKS == 1 )
+		{
+			/* The time on entering cannot have been wrapped past. */
+			xElapsed = taskFULL_TICK_COUNT() - pxTimeOut->xTimeOnEntering;
+
+			if( xElapsed < ( portTickCountType ) *pxTicksToWait )
+			{
+				/* Not a genuine timeout. Adjust parameters for time remaining. */
+				*pxTicksToWait -= ( portTickType ) xElapsed;
+				vTaskSetTimeOutState( pxTimeOut );
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				xReturn = pdTRUE;
+			}
+		}
+		#else
+		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( ( portTickType ) xTickCount >= ( portTickType ) pxTimeOut->xTimeOnEntering ) )
+		{
+			/* The tick count is greater than the time at which vTaskSetTimeout()
+			was called, but has also overflowed since vTaskSetTimeOut() was called.
+			It must have wrapped all the way around and gone past us again. This
+			passed since vTaskSetTimeout() was called. */
+			xReturn = pdTRUE;
+		}
+		else if( ( ( portTickType ) ( ( portTickType ) xTickCount - ( portTickType ) pxTimeOut->xTimeOnEntering ) ) < ( portTickType ) *pxTicksToWait )
+		{
+			/* Not a genuine timeout. Adjust parameters for time remaining. */
+			*pxTicksToWait -= ( ( portTickType ) xTickCount - ( portTickType ) pxTimeOut->xTimeOnEntering );
+			vTaskSetTimeOutState( pxTimeOut );
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			xReturn = pdTRUE;
+		}
+		#endif /* configUSE_64_BIT_TICKS */
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ABSOLUTE_TIMEOUTS == 1 )
+
+	portTickType xTaskGetTicksUntil( portTickType xWakeTime )
+	{
+	portTickType xTicksToWait;
+
+		/* Wake times are relative to the current tick count, so a wake time
+		just behind it is one that has passed rather than one that is almost a
+		full tick count overflow away. */
+		xTicksToWait = ( portTickType ) ( xWakeTime - ( portTickType ) xTickCount );
+		if( xTicksToWait > ( portTickType ) ( portMAX_DELAY >> 1 ) )
+		{
+			xTicksToWait = ( portTickType ) 0;
+		}
+
+		return xTicksToWait;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskSetTimeOutStateUntil( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait, portTickType xWakeTime )
+	{
+		configASSERT( pxTicksToWait );
+
+		taskENTER_CRITICAL();
+		{
+			vTaskSetTimeOutState( pxTimeOut );
+			*pxTicksToWait = xTaskGetTicksUntil( xWakeTime );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ABSOLUTE_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+	xMissedYield = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+	unsigned portBASE_TYPE uxTaskGetTaskNumber( xTaskHandle xTask )
+	{
+	unsigned portBASE_TYPE uxReturn;
+	tskTCB *pxTCB;
+	
+		if( xTask != NULL )
+		{
+			pxTCB = ( tskTCB * ) xTask;
+			uxReturn = pxTCB->uxTaskNumber;
+		}
+		else
+		{
+			uxReturn = 0U;
+		}
+		
+		return uxReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+	void vTaskSetTaskNumber( xTaskHandle xTask, unsigned portBASE_TYPE uxHandle )
+	{
+	tskTCB *pxTCB;
+	
+		if( xTask != NULL )
+		{
+			pxTCB = ( tskTCB * ) xTask;
+			pxTCB->uxTaskNumber = uxHandle;
+		}
+	}
+#endif
+
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+	/* Stop warnings. */
+	( void ) pvParameters;
+
+	#if ( configGENERATE_RUN_TIME_STATS == 1 ) || ( configUSE_CPU_LOAD_METER == 1 )
+	{
+		/* An idle task has no run time until it first runs, so it is soon
+		enough to note it for ulTaskGetIdleRunTimeCounter() and the load
+		meter now. */
+		taskENTER_CRITICAL();
+		{
+			if( uxIdleTasksStarted < ( unsigned portBASE_TYPE ) configNUMBER_OF_CORES )
+			{
+				pxIdleTCBs[ uxIdleTasksStarted ] = pxCurrentTCB;
+				uxIdleTasksStarted++;
+
+				#if ( configUSE_CPU_LOAD_METER == 1 )
+				{
+					/* The switch in was not timed as the task was not known
+					to be an idle task yet. */
+					taskGET_LOAD_METER_TIME( ulIdleSwitchedInTime );
+				}
+				#endif
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	#endif
+
+	for( ;; )
+	{
+		/* See if any tasks have been deleted. */
+		prvCheckTasksWaitingTermination();
+
+		#if ( configSTACK_SAMPLE_WORDS > 0 )
+		{
+			/* Move the stack high water marks on a little. */
+			prvSampleTaskStacks();
+		}
+		#endif
+
+		#if ( configUSE_PREEMPTION == 0 )
+		{
+			/* If we are not using preemption we keep forcing a task switch to
+			see if any other task has become available.  If we are using
+			preemption we don't need to do this as any task becoming available
+			will automatically get the processor anyway. */
+			taskYIELD();
+		}
+		#endif
+
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		{
+			/* When using preemption tasks of equal priority will be
+			timesliced.  If a task that is sharing the idle priority is ready
+			to run then the idle task should yield before the end of the
+			timeslice.
+
+			A critical region is not required here as we are just reading from
+			the list, and an occasional incorrect value will not matter.  There
+			is one idle task per core, so if the ready list at the idle
+			priority contains more than configNUMBER_OF_CORES tasks then a task
+			other than an idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( unsigned portBASE_TYPE ) configNUMBER_OF_CORES )
+			{
+				taskYIELD();
+			}
+		}
+		#endif
+
+		#if ( configUSE_IDLE_HOOK == 1 )
+		{
+			extern void vApplicationIdleHook( void );
+
+			/* Call the user defined function from within the idle task.  This
+			allows the application designer to add background functionality
+			without the overhead of a separate task.
+			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+			CALL A FUNCTION THAT MIGHT BLOCK. */
+			vApplicationIdleHook();
+		}
+		#endif
+
+		/* Allow the port to perform processing on each iteration of the idle
+		task.  This is used by simulator ports that advance virtual time while
+		the system is idle. */
+		portIDLE_TASK_HOOK();
+
+		#if ( configUSE_IDLE_WORK == 1 )
+		{
+			/* Give the spare time to a registered background job, if one fits
+			before the next task is due.  If a job ran, the idle time left has
+			changed, so the low power mode is not entered on this iteration. */
+			if( prvRunIdleWork() != pdFALSE )
+			{
+				continue;
+			}
+		}
+		#endif
+
+		/* This conditional compilation should use inequality to 0, not equality
+		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+		user defined low power mode implementations require
+		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+		#if ( configUSE_TICKLESS_IDLE != 0 )
+		{
+		portTickType xExpectedIdleTime;
+
+			/* It is not desirable to suspend then resume the scheduler on
+			each iteration of the idle task.  Therefore, a preliminary test of
+			the expected idle time is performed without the scheduler
+			suspended.  The result here is not necessarily valid. */
+			xExpectedIdleTime = prvGetExpectedIdleTime();
+
+			if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+			{
+				vTaskSuspendAll();
+				{
+					/* Now the scheduler is suspended, the expected idle
+					time can be sampled again, and this time its value can
+					be used. */
+					#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+					{
+						configASSERT( xNextTaskUnblockTime >= taskFULL_TICK_COUNT() );
+					}
+					#endif
+					xExpectedIdleTime = prvGetExpectedIdleTime();
+
+					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+					{
+						traceLOW_POWER_IDLE_BEGIN();
+						portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+						traceLOW_POWER_IDLE_END();
+					}
+				}
+				xTaskResumeAll();
+			}
+		}
+		#endif /* configUSE_TICKLESS_IDLE */
+	}
+} /*lint !e715 pvParameters is not accessed but all task functions require the same prototype. */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_IDLE_WORK == 1 )
+
+	static portTickType prvGetExpectedIdleTime( void )
+	{
+	portTickType xReturn;
+
+		if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+		{
+			/* A task other than the idle task is running. */
+			xReturn = 0;
+		}
+		else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( unsigned portBASE_TYPE ) 1 )
+		{
+			/* There are other idle priority tasks in the ready state.  If
+			time slicing is used then the very next tick interrupt must be
+			processed. */
+			xReturn = 0;
+		}
+		#if ( configUSE_DYNAMIC_TICK_RATE == 1 )
+		else if( ( xNextTaskUnblockTime - taskFULL_TICK_COUNT() ) <= ( portTickCountType ) xTicksForNextTickInterrupt )
+		{
+			/* The next task is due before or when the tick period that is
+			running ends, so there is no tick interrupt to suppress. */
+			xReturn = 0;
+		}
+		#endif
+		else
+		{
+			#if ( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* The next wake time can be further away than a portTickType
+				can hold, or portMAX_TICK_COUNT if no task is delayed. */
+				if( ( xNextTaskUnblockTime - taskFULL_TICK_COUNT() ) > ( portTickCountType ) portMAX_DELAY )
+				{
+					xReturn = portMAX_DELAY;
+				}
+				else
+				{
+					xReturn = ( portTickType ) ( xNextTaskUnblockTime - taskFULL_TICK_COUNT() );
+				}
+			}
+			#else
+			{
+				xReturn = xNextTaskUnblockTime - xTickCount;
+			}
+			#endif
+
+			#if ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+			{
+				/* The tick interrupt is also needed to run the next timer
+				callback that runs in the tick interrupt. */
+				if( xTimerGetTicksToNextTickCallback() < xReturn )
+				{
+					xReturn = xTimerGetTicksToNextTickCallback();
+				}
+			}
+			#endif
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE || configUSE_IDLE_WORK */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+	{
+	eSleepModeStatus eReturn = eStandardSleep;
+
+		if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != ( unsigned portBASE_TYPE ) 0U )
+		{
+			/* A task was made ready while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else if( xMissedYield != pdFALSE )
+		{
+			/* A yield was pended while the scheduler was suspended. */
+			eReturn = eAbortSleep;
+		}
+		else
+		{
+			#if ( configUSE_TIMERS == 0 ) && ( INCLUDE_vTaskSuspend == 1 )
+			{
+				/* The idle task exists in addition to the application tasks. */
+				const unsigned portBASE_TYPE uxNonApplicationTasks = 1;
+
+				/* If timers are not being used and all the tasks are in the
+				suspended list (which might mean they have an infinite block
+				time rather than actually being suspended) then it is safe to
+				turn all clocks off and just wait for external interrupts. */
+				if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+				{
+					eReturn = eNoTasksWaitingTimeout;
+				}
+			}
+			#endif /* configUSE_TIMERS */
+		}
+
+		return eReturn;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+
+
+
+
+
+
+/*-----------------------------------------------------------
+ * File private functions documented at the top of the file.
+ *----------------------------------------------------------*/
+
+
+
+static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
+{
+	/* Store the function name in the TCB. */
+	#if ( configUSE_TASK_NAMES == 1 )
+	{
+		#if configMAX_TASK_NAME_LEN > 1
+		{
+			/* Don't bring strncpy into the build unnecessarily. */
+			strncpy( ( char * ) pxTCB->pcTaskName, ( const char * ) pcName, ( unsigned short ) configMAX_TASK_NAME_LEN );
+		}
+		#endif
+		pxTCB->pcTaskName[ ( unsigned short ) configMAX_TASK_NAME_LEN - ( unsigned short ) 1 ] = ( signed char ) '\0';
+	}
+	#else
+	{
+		( void ) pcName;
+	}
+	#endif
+
+	/* This is used as an array index so must ensure it's not too large.  First
+	remove the privilege bit if one is present. */
+	if( uxPriority >= configMAX_PRIORITIES )
+	{
+		uxPriority = configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) 1U;
+	}
+
+	pxTCB->uxPriority = uxPriority;
+	#if ( configUSE_MUTEXES == 1 )
+	{
+		pxTCB->uxBasePriority = uxPriority;
+		pxTCB->uxMutexesHeld = ( unsigned portBASE_TYPE ) 0U;
+		pxTCB->pvMutexBlockedOn = NULL;
+	}
+	#endif
+
+	#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+	{
+		/* A threshold equal to the priority of the task has no effect. */
+		pxTCB->uxPreemptionThreshold = uxPriority;
+		pxTCB->pxNextPreempted = NULL;
+	}
+	#endif
+
+	vListInitialiseItem( &( pxTCB->xGenericListItem ) );
+	vListInitialiseItem( &( pxTCB->xEventListItem ) );
+
+	/* Set the pxTCB as a link back from the xListItem.  This is so we can get
+	back to	the containing TCB from a generic item in a list. */
+	listSET_LIST_ITEM_OWNER( &( pxTCB->xGenericListItem ), pxTCB );
+
+	/* Event lists are always in priority order. */
+	listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
+	listSET_LIST_ITEM_OWNER( &( pxTCB->xEventListItem ), pxTCB );
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+	{
+		pxTCB->uxCriticalNesting = ( unsigned portBASE_TYPE ) 0U;
+	}
+	#endif
+
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+	{
+		pxTCB->pxTaskTag = NULL;
+	}
+	#endif
+
+	#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+	{
+	portBASE_TYPE xIndex;
+
+		for( xIndex = 0; xIndex < ( portBASE_TYPE ) configNUM_THREAD_LOCAL_STORAGE_POINTERS; xIndex++ )
+		{
+			pxTCB->pvThreadLocalStoragePointers[ xIndex ] = NULL;
+
+			#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+			{
+				pxTCB->pxThreadLocalStorageDeleteCallbacks[ xIndex ] = NULL;
+			}
+			#endif
+		}
+	}
+	#endif
+
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+		pxTCB->ulRunTimeCounter = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+	}
+	#endif
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+	{
+		pxTCB->ulSwitchInCount = 0UL;
+		pxTCB->xTimeLeftReady = ( portTickType ) 0U;
+		pxTCB->xMaxBlockTime = ( portTickType ) 0U;
+		pxTCB->ucLeftReady = ( unsigned char ) pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxTCB->ulNotifiedValue = 0UL;
+		pxTCB->ucNotifyState = eNotWaitingNotification;
+	}
+	#endif
+
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxTCB->xDeadline = ( portTickType ) 0U;
+		pxTCB->xRelativeDeadline = ( portTickType ) 0U;
+		pxTCB->ucHasDeadline = ( unsigned char ) pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_TASK_BUDGETS == 1 )
+	{
+		pxTCB->pxNextBudgeted = NULL;
+		pxTCB->xBudget = ( portTickType ) 0U;
+		pxTCB->xBudgetPeriod = ( portTickType ) 0U;
+		pxTCB->xBudgetLeft = ( portTickType ) 0U;
+		pxTCB->xNextReplenish = ( portTickType ) 0U;
+	}
+	#endif
+
+	#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+	{
+		pxTCB->ulActivationOverruns = 0UL;
+	}
+	#endif
+
+	#if ( configRECORD_RELEASE_JITTER == 1 )
+	{
+	unsigned portBASE_TYPE uxBucket;
+
+		pxTCB->ulMinLateness = ~( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulMaxLateness = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulTotalLateness = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulReleases = 0UL;
+		pxTCB->ulOverruns = 0UL;
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configRELEASE_JITTER_BUCKETS; uxBucket++ )
+		{
+			pxTCB->ulLatenessHistogram[ uxBucket ] = 0UL;
+		}
+		pxTCB->xReleaseTime = ( portTickType ) 0U;
+		pxTCB->ucReleasePending = ( unsigned char ) pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_HEAP_TRACE == 1 )
+	{
+		pxTCB->ucHeapOwner = ( unsigned char ) heaptraceNO_OWNER;
+	}
+	#endif
+
+	#if ( configUSE_HEAP_TASK_CACHES == 1 )
+	{
+		pxTCB->pvHeapCache = NULL;
+	}
+	#endif
+
+	#if ( configRECORD_WAKE_LATENCY == 1 )
+	{
+	unsigned portBASE_TYPE uxBucket;
+
+		pxTCB->ulReadyTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulMaxWakeLatency = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulTotalWakeLatency = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		pxTCB->ulWakeUps = 0UL;
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configWAKE_LATENCY_BUCKETS; uxBucket++ )
+		{
+			pxTCB->ulWakeLatencyHistogram[ uxBucket ] = 0UL;
+		}
+		pxTCB->ucWakePending = ( unsigned char ) pdFALSE;
+	}
+	#endif
+
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		pxTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+		#if ( configUSE_CORE_AFFINITY == 1 )
+		{
+			pxTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+		}
+		#endif
+	}
+	#endif
+
+	#if ( configSTACK_SAMPLE_WORDS > 0 )
+	{
+		/* Nothing is known about the stack until the sampler has been
+		through it. */
+		pxTCB->pxNextSampled = NULL;
+		pxTCB->usStackWatermark = usStackDepth;
+	}
+	#endif
+
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+	{
+		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
+	}
+	#else
+	{
+		( void ) xRegions;
+		( void ) usStackDepth;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+	void vTaskAllocateMPURegions( xTaskHandle xTaskToModify, const xMemoryRegion * const xRegions )
+	{
+	tskTCB *pxTCB;
+	
+		if( xTaskToModify == pxCurrentTCB )
+		{
+			xTaskToModify = NULL;
+		}
+
+		/* If null is passed in here then we are deleting ourselves. */
+		pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+	}
+	/*-----------------------------------------------------------*/
+#endif
+
+static void prvInitialiseTaskLists( void )
+{
+unsigned portBASE_TYPE uxPriority;
+
+	for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < configMAX_PRIORITIES; uxPriority++ )
+	{
+		vListInitialise( ( xList * ) &( pxReadyTasksLists[ uxPriority ] ) );
+	}
+
+	#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+	{
+		vListInitialise( ( xList * ) &xDelayedTaskList1 );
+		pxDelayedTaskList = &xDelayedTaskList1;
+
+		#if ( configUSE_64_BIT_TICKS == 0 )
+		{
+			vListInitialise( ( xList * ) &xDelayedTaskList2 );
+
+			/* Start with pxDelayedTaskList using list1 and the
+			pxOverflowDelayedTaskList using list2. */
+			pxOverflowDelayedTaskList = &xDelayedTaskList2;
+		}
+		#endif
+	}
+	#else
+	{
+		for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxPriority++ )
+		{
+			vListInitialise( ( xList * ) &( xDelayedTaskWheel[ uxPriority ] ) );
+		}
+	}
+	#endif
+
+	vListInitialise( ( xList * ) &xPendingReadyList );
+
+	#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+	{
+		vListInitialise( ( xList * ) &xTimeTriggeredTaskList );
+	}
+	#endif
+
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		vListInitialise( ( xList * ) &xTasksWaitingTermination );
+	}
+	#endif
+
+	#if ( INCLUDE_vTaskSuspend == 1 )
+	{
+		vListInitialise( ( xList * ) &xSuspendedTaskList );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+	#if ( INCLUDE_vTaskDelete == 1 )
+	{
+		portBASE_TYPE xListIsEmpty;
+
+		/* ucTasksDeleted is used to prevent vTaskSuspendAll() being called
+		too often in the idle task. */
+		if( uxTasksDeleted > ( unsigned portBASE_TYPE ) 0U )
+		{
+			vTaskSuspendAll();
+				xListIsEmpty = listLIST_IS_EMPTY( &xTasksWaitingTermination );
+			xTaskResumeAll();
+
+			if( xListIsEmpty == pdFALSE )
+			{
+				tskTCB *pxTCB;
+
+				taskENTER_CRITICAL();
+				{
+					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( ( ( xList * ) &xTasksWaitingTermination ) );
+
+					#if ( configNUMBER_OF_CORES > 1 )
+					{
+						/* A task deleted from another core may not have been
+						switched out yet, in which case it is freed on a later
+						pass. */
+						if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+						{
+							pxTCB = NULL;
+						}
+					}
+					#endif
+
+					if( pxTCB != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+						--uxCurrentNumberOfTasks;
+						--uxTasksDeleted;
+
+						#if ( configSTACK_SAMPLE_WORDS > 0 )
+						{
+						tskTCB **ppxLink;
+
+							/* Take the task out of the sampler's list, and move
+							the sampler on if it was part way through the stack
+							that is about to be freed. */
+							for( ppxLink = ( tskTCB ** ) &pxSampledTasks; *ppxLink != pxTCB; ppxLink = &( ( *ppxLink )->pxNextSampled ) )
+							{
+							}
+							*ppxLink = pxTCB->pxNextSampled;
+
+							if( pxSampleTCB == pxTCB )
+							{
+								pxSampleTCB = pxTCB->pxNextSampled;
+								usSampleWords = 0U;
+							}
+						}
+						#endif
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxTCB != NULL )
+				{
+					prvDeleteTCB( pxTCB );
+				}
+			}
+		}
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configDELAYED_TASK_WHEEL_SLOTS == 0 )
+
+static void prvAddCurrentTaskToDelayedList( portTickCountType xTimeToWake )
+{
+	/* The list item will be inserted in wake time order. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+
+	#if ( configUSE_64_BIT_TICKS == 0 )
+	if( xTimeToWake < xTickCount )
+	{
+		/* Wake time has overflowed.  Place this item in the overflow list. */
+		vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	}
+	else
+	#endif
+	{
+		/* The wake time has not overflowed, so we can use the current block list. */
+		vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+
+		/* If the task entering the blocked state was placed at the head of the
+		list of blocked tasks then xNextTaskUnblockTime needs to be updated
+		too. */
+		if( xTimeToWake < xNextTaskUnblockTime )
+		{
+			xNextTaskUnblockTime = xTimeToWake;
+		}
+	}
+}
+
+#else /* configDELAYED_TASK_WHEEL_SLOTS */
+
+static void prvAddCurrentTaskToDelayedList( portTickCountType xTimeToWake )
+{
+	/* A block time of zero gives a wake time equal to the tick count.  The
+	sorted lists unblock such a task on the next tick, so the wheel does the
+	same rather than leaving it until the tick count next comes round. */
+	if( xTimeToWake == xTickCount )
+	{
+		xTimeToWake++;
+	}
+
+	/* The order of the tasks within a wheel list does not matter. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+	vListInsertEnd( ( xList * ) taskDELAYED_WHEEL_SLOT( xTimeToWake ), ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+
+	/* Wake times are compared relative to the tick count so the comparison
+	is still valid if either has overflowed. */
+	if( ( portTickType ) ( xTimeToWake - xTickCount ) < ( portTickType ) ( xNextTaskUnblockTime - xTickCount ) )
+	{
+		xNextTaskUnblockTime = xTimeToWake;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+xList *pxSlot;
+xListItem *pxItem;
+portTickType xTick, xOffset, xNearestOffset = portMAX_DELAY;
+
+	/* Check the lists in the order their ticks come round.  A task found in
+	the list for the tick xTick after the tick count that is due on this turn
+	of the wheel cannot be beaten by a task in a later list, so the search can
+	stop.  If the wheel is empty xNextTaskUnblockTime is set as far from the
+	tick count as possible. */
+	for( xTick = ( portTickType ) 1U; xTick <= ( portTickType ) configDELAYED_TASK_WHEEL_SLOTS; xTick++ )
+	{
+		pxSlot = taskDELAYED_WHEEL_SLOT( xTickCount + xTick );
+		pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+
+		while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+		{
+			xOffset = ( portTickType ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xTickCount );
+
+			if( xOffset < xNearestOffset )
+			{
+				xNearestOffset = xOffset;
+			}
+
+			pxItem = ( xListItem * ) pxItem->pxNext;
+		}
+
+		if( xNearestOffset <= xTick )
+		{
+			break;
+		}
+	}
+
+	xNextTaskUnblockTime = xTickCount + xNearestOffset;
+}
+
+#endif /* configDELAYED_TASK_WHEEL_SLOTS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static tskTCB *prvGetCurrentTCB( void )
+	{
+	tskTCB *pxTCB;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		/* Interrupts are masked so the task cannot be moved to another core
+		between reading the core ID and indexing the array with it. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pxTCB;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( portBASE_TYPE xCoreID )
+	{
+	unsigned portBASE_TYPE uxPriority = uxTopReadyPriority, uxTasksToCheck;
+	portBASE_TYPE xLowerTopReadyPriority = pdTRUE;
+	tskTCB *pxTCB = NULL;
+	xList *pxReadyList;
+
+		/* The task this core was running can be selected again, but is not
+		running while the selection is made. */
+		if( pxCurrentTCBs[ xCoreID ] != NULL )
+		{
+			pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+		}
+
+		for( ;; )
+		{
+			pxReadyList = &( pxReadyTasksLists[ uxPriority ] );
+
+			if( listLIST_IS_EMPTY( pxReadyList ) != pdFALSE )
+			{
+				/* uxTopReadyPriority is only lowered past empty lists.  A list
+				whose tasks are all running on other cores is not empty. */
+				if( xLowerTopReadyPriority != pdFALSE )
+				{
+					configASSERT( uxTopReadyPriority );
+					--uxTopReadyPriority;
+				}
+			}
+			else
+			{
+				xLowerTopReadyPriority = pdFALSE;
+
+				/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so tasks
+				of the same priority share the processor time.  Tasks already
+				running on another core, and tasks not allowed to run on this
+				core, are passed over. */
+				for( uxTasksToCheck = listCURRENT_LIST_LENGTH( pxReadyList ); uxTasksToCheck > 0U; uxTasksToCheck-- )
+				{
+					listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxReadyList );
+
+					if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) && ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) )
+					{
+						break;
+					}
+
+					pxTCB = NULL;
+				}
+
+				if( pxTCB != NULL )
+				{
+					break;
+				}
+			}
+
+			/* Each core has its own idle task so a task is always found before
+			the idle priority has been passed. */
+			configASSERT( uxPriority );
+			--uxPriority;
+		}
+
+		pxTCB->xTaskRunState = xCoreID;
+		pxCurrentTCBs[ xCoreID ] = pxTCB;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static portBASE_TYPE prvYieldForTask( tskTCB *pxTCB )
+	{
+	portBASE_TYPE xCoreID, xLowestPriorityCore = taskTASK_NOT_RUNNING, xReturn = pdFALSE;
+	unsigned portBASE_TYPE uxLowestPriority = pxTCB->uxPriority;
+
+		if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) )
+		{
+			/* Find the core, of those the task is allowed to run on, that is
+			running the lowest priority task below that of pxTCB. */
+			for( xCoreID = 0; xCoreID < ( portBASE_TYPE ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE )
+				{
+					if( pxCurrentTCBs[ xCoreID ]->uxPriority < uxLowestPriority )
+					{
+						uxLowestPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+						xLowestPriorityCore = xCoreID;
+					}
+				}
+			}
+
+			if( xLowestPriorityCore == portGET_CORE_ID() )
+			{
+				/* The calling core should switch to pxTCB. */
+				xReturn = pdTRUE;
+			}
+			else if( xLowestPriorityCore != taskTASK_NOT_RUNNING )
+			{
+				portYIELD_CORE( xLowestPriorityCore );
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+	{
+	tskTCB *pxNewTCB = NULL;
+
+		#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+		{
+		unsigned portBASE_TYPE ux;
+
+			/* Tasks that are created and deleted all the time can reuse the
+			memory of a deleted task with the same stack depth, without going
+			to the allocator. */
+			if( puxStackBuffer == NULL )
+			{
+				taskENTER_CRITICAL();
+				{
+					for( ux = 0U; ux < ( unsigned portBASE_TYPE ) configTASK_RECYCLE_CACHE_SIZE; ux++ )
+					{
+						if( ( pxRecycledTCBs[ ux ] != NULL ) && ( pxRecycledTCBs[ ux ]->usRecycleDepth == usStackDepth ) )
+						{
+							pxNewTCB = pxRecycledTCBs[ ux ];
+							pxRecycledTCBs[ ux ] = NULL;
+							break;
+						}
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		#endif
+
+		if( pxNewTCB == NULL )
+		{
+			/* Allocate space for the TCB.  Where the memory comes from depends on
+			the implementation of the port malloc function. */
+			pxNewTCB = ( tskTCB * ) tskMALLOC_TCB( sizeof( tskTCB ) );
+
+			if( pxNewTCB != NULL )
+			{
+				/* Allocate space for the stack used by the task being created.
+				The base of the stack memory stored in the TCB so the task can
+				be deleted later if required. */
+				pxNewTCB->pxStack = ( portSTACK_TYPE * ) tskMALLOC_STACK( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
+
+				if( pxNewTCB->pxStack == NULL )
+				{
+					/* Could not allocate the stack.  Delete the allocated TCB. */
+					vPortFree( pxNewTCB );
+					pxNewTCB = NULL;
+				}
+			}
+		}
+
+		if( pxNewTCB != NULL )
+		{
+			#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+			{
+				/* A stack supplied by the application must not be given to
+				another task. */
+				pxNewTCB->usRecycleDepth = ( puxStackBuffer == NULL ) ? usStackDepth : ( unsigned short ) 0U;
+			}
+			#endif
+
+			/* Just to help debugging. */
+			prvFillNewStack( pxNewTCB, usStackDepth );
+		}
+
+		return pxNewTCB;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvFillNewStack( tskTCB *pxTCB, unsigned short usStackDepth )
+{
+	#if ( configDEFER_STACK_FILL == 1 )
+	{
+		/* Filling every stack can be a large part of the boot time when many
+		tasks are created.  Fill only the end of the stack now, the idle task
+		fills the rest. */
+		if( usStackDepth > ( unsigned short ) tskSTACK_GUARD_WORDS )
+		{
+			#if portSTACK_GROWTH < 0
+			{
+				memset( pxTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) tskSTACK_GUARD_WORDS * sizeof( portSTACK_TYPE ) );
+				pxTCB->pxFillNext = pxTCB->pxStack + tskSTACK_GUARD_WORDS;
+			}
+			#else
+			{
+				memset( pxTCB->pxStack + ( usStackDepth - tskSTACK_GUARD_WORDS ), ( int ) tskSTACK_FILL_BYTE, ( size_t ) tskSTACK_GUARD_WORDS * sizeof( portSTACK_TYPE ) );
+				pxTCB->pxFillNext = pxTCB->pxStack + ( usStackDepth - tskSTACK_GUARD_WORDS - 1U );
+			}
+			#endif
+		}
+		else
+		{
+			memset( pxTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			pxTCB->pxFillNext = NULL;
+		}
+	}
+	#else
+	{
+		memset( pxTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvListTaskWithinSingleList( const signed char *pcWriteBuffer, xList *pxList, signed char cStatus )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned short usStackRemaining;
+	PRIVILEGED_DATA static char pcStatusString[ 50 ];
+
+		/* Write the details of all the TCB's in pxList into the buffer. */
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
+			}
+			#else
+			{
+				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
+			}
+			#endif			
+			
+			sprintf( pcStatusString, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", taskGET_TCB_NAME( pxNextTCB ), cStatus, ( unsigned int ) pxNextTCB->uxPriority, usStackRemaining, ( unsigned int ) pxNextTCB->uxTCBNumber );
+			strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatusString );
+
+		} while( pxNextTCB != pxFirstTCB );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static unsigned portBASE_TYPE prvListTaskStatusWithinSingleList( xTaskStatusType *pxTaskStatusArray, xList *pxList, eTaskState eState )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned portBASE_TYPE uxTask = 0U;
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+			prvGetTaskStatus( &( pxTaskStatusArray[ uxTask ] ), pxNextTCB, eState );
+			uxTask++;
+
+		} while( pxNextTCB != pxFirstTCB );
+
+		return uxTask;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvGetTaskStatus( xTaskStatusType *pxTaskStatus, volatile tskTCB *pxTCB, eTaskState eState )
+	{
+		pxTaskStatus->xHandle = ( xTaskHandle ) pxTCB;
+		pxTaskStatus->pcTaskName = ( const signed char * ) taskGET_TCB_NAME( pxTCB );
+		pxTaskStatus->uxTaskNumber = pxTCB->uxTCBNumber;
+		pxTaskStatus->eCurrentState = eState;
+		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+		pxTaskStatus->ulSwitchInCount = pxTCB->ulSwitchInCount;
+		pxTaskStatus->xMaxBlockTime = pxTCB->xMaxBlockTime;
+
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			if( pxTCB == pxCurrentTCB )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+		}
+		#else
+		{
+			if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+		}
+		#endif
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			/* A task waiting for an event with no timeout is held in the
+			suspended list, but is blocked rather than suspended. */
+			if( ( eState == eSuspended ) && ( pxTCB->xEventListItem.pvContainer != NULL ) )
+			{
+				pxTaskStatus->eCurrentState = eBlocked;
+			}
+		}
+		#endif
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxPriority;
+		}
+		#endif
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+		}
+		#else
+		{
+			pxTaskStatus->ulRunTimeCounter = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		}
+		#endif
+
+		#if ( portSTACK_GROWTH > 0 )
+		{
+			pxTaskStatus->usStackHighWaterMark = usTaskCheckFreeStackSpace( ( unsigned char * ) pxTCB->pxEndOfStack );
+		}
+		#else
+		{
+			pxTaskStatus->usStackHighWaterMark = usTaskCheckFreeStackSpace( ( unsigned char * ) pxTCB->pxStack );
+		}
+		#endif
+
+		#if ( configRECORD_RELEASE_JITTER == 1 )
+		{
+		unsigned portBASE_TYPE uxBucket;
+		xReleaseJitterType * const pxJitter = &( pxTaskStatus->xReleaseJitter );
+
+			pxJitter->ulReleases = pxTCB->ulReleases;
+			pxJitter->ulOverruns = pxTCB->ulOverruns;
+
+			if( pxTCB->ulReleases != 0UL )
+			{
+				pxJitter->ulMinLateness = pxTCB->ulMinLateness;
+				pxJitter->ulMeanLateness = pxTCB->ulTotalLateness / ( portRUN_TIME_COUNTER_TYPE ) pxTCB->ulReleases;
+			}
+			else
+			{
+				pxJitter->ulMinLateness = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+				pxJitter->ulMeanLateness = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+			}
+			pxJitter->ulMaxLateness = pxTCB->ulMaxLateness;
+
+			for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configRELEASE_JITTER_BUCKETS; uxBucket++ )
+			{
+				pxJitter->ulHistogram[ uxBucket ] = pxTCB->ulLatenessHistogram[ uxBucket ];
+			}
+		}
+		#endif
+
+		#if ( configRECORD_WAKE_LATENCY == 1 )
+		{
+		unsigned portBASE_TYPE uxBucket;
+		xWakeLatencyType * const pxLatency = &( pxTaskStatus->xWakeLatency );
+
+			pxLatency->ulWakeUps = pxTCB->ulWakeUps;
+			pxLatency->ulMaxLatency = pxTCB->ulMaxWakeLatency;
+
+			if( pxTCB->ulWakeUps != 0UL )
+			{
+				pxLatency->ulMeanLatency = pxTCB->ulTotalWakeLatency / ( portRUN_TIME_COUNTER_TYPE ) pxTCB->ulWakeUps;
+			}
+			else
+			{
+				pxLatency->ulMeanLatency = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+			}
+
+			for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) configWAKE_LATENCY_BUCKETS; uxBucket++ )
+			{
+				pxLatency->ulHistogram[ uxBucket ] = pxTCB->ulWakeLatencyHistogram[ uxBucket ];
+			}
+		}
+		#endif
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static void prvFindNextTaskWithinSingleList( xList *pxList, eTaskState eState, unsigned portBASE_TYPE uxCursor, tskTCB **ppxNextTCB, eTaskState *peNextState )
+	{
+	volatile tskTCB *pxTCB, *pxFirstTCB;
+
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxTCB, pxList );
+
+			if( ( pxTCB->uxTCBNumber >= uxCursor ) && ( ( *ppxNextTCB == NULL ) || ( pxTCB->uxTCBNumber < ( *ppxNextTCB )->uxTCBNumber ) ) )
+			{
+				*ppxNextTCB = ( tskTCB * ) pxTCB;
+				*peNextState = eState;
+			}
+
+		} while( pxTCB != pxFirstTCB );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, portRUN_TIME_COUNTER_TYPE ulTotalRunTime )
+	{
+	volatile tskTCB *pxNextTCB, *pxFirstTCB;
+	unsigned long ulStatsAsPercentage;
+
+		/* Write the run time stats of all the TCB's in pxList into the buffer. */
+		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+		do
+		{
+			/* Get next TCB in from the list. */
+			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+
+			/* Divide by zero check. */
+			if( ulTotalRunTime > 0UL )
+			{
+				/* Has the task run at all? */
+				if( pxNextTCB->ulRunTimeCounter == 0UL )
+				{
+					/* The task has used no CPU time at all. */
+					sprintf( pcStatsString, ( char * ) "%s\t\t0\t\t0%%\r\n", taskGET_TCB_NAME( pxNextTCB ) );
+				}
+				else
+				{
+					/* What percentage of the total run time has the task used?
+					This will always be rounded down to the nearest integer.
+					ulTotalRunTime has already been divided by 100. */
+					ulStatsAsPercentage = ( unsigned long ) ( pxNextTCB->ulRunTimeCounter / ulTotalRunTime );
+
+					if( ulStatsAsPercentage > 0UL )
+					{
+						#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+						{
+							/* The counter is wider than a long, so the
+							printf() library must support %llu. */
+							sprintf( pcStatsString, ( char * ) "%s\t\t%llu\t\t%lu%%\r\n", taskGET_TCB_NAME( pxNextTCB ), ( unsigned long long ) pxNextTCB->ulRunTimeCounter, ulStatsAsPercentage );
+						}
+						#elif defined( portLU_PRINTF_SPECIFIER_REQUIRED )
+						{
+							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t%lu%%\r\n", taskGET_TCB_NAME( pxNextTCB ), pxNextTCB->ulRunTimeCounter, ulStatsAsPercentage );							
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t%u%%\r\n", taskGET_TCB_NAME( pxNextTCB ), ( unsigned int ) pxNextTCB->ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage );
+						}
+						#endif
+					}
+					else
+					{
+						/* If the percentage is zero here then the task has
+						consumed less than 1% of the total run time. */
+						#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+						{
+							sprintf( pcStatsString, ( char * ) "%s\t\t%llu\t\t<1%%\r\n", taskGET_TCB_NAME( pxNextTCB ), ( unsigned long long ) pxNextTCB->ulRunTimeCounter );
+						}
+						#elif defined( portLU_PRINTF_SPECIFIER_REQUIRED )
+						{
+							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t<1%%\r\n", taskGET_TCB_NAME( pxNextTCB ), pxNextTCB->ulRunTimeCounter );							
+						}
+						#else
+						{
+							/* sizeof( int ) == sizeof( long ) so a smaller
+							printf() library can be used. */
+							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t<1%%\r\n", taskGET_TCB_NAME( pxNextTCB ), ( unsigned int ) pxNextTCB->ulRunTimeCounter );
+						}
+						#endif
+					}
+				}
+
+				strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatsString );
+			}
+
+		} while( pxNextTCB != pxFirstTCB );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+
+	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
+	{
+	register unsigned short usCount = 0U;
+
+		while( *pucStackByte == tskSTACK_FILL_BYTE )
+		{
+			pucStackByte -= portSTACK_GROWTH;
+			usCount++;
+		}
+
+		usCount /= sizeof( portSTACK_TYPE );
+
+		return usCount;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+	unsigned char *pcEndOfStack;
+	unsigned portBASE_TYPE uxReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pcEndOfStack = ( unsigned char * ) pxTCB->pxStack;
+		}
+		#else
+		{
+			pcEndOfStack = ( unsigned char * ) pxTCB->pxEndOfStack;
+		}
+		#endif
+
+		uxReturn = ( unsigned portBASE_TYPE ) usTaskCheckFreeStackSpace( pcEndOfStack );
+
+		return uxReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configSTACK_SAMPLE_WORDS > 0 )
+
+	static void prvSampleTaskStacks( void )
+	{
+	portSTACK_TYPE xFillWord;
+	portSTACK_TYPE *pxWord;
+	unsigned short usLimit;
+	unsigned portBASE_TYPE uxWordsLeft = ( unsigned portBASE_TYPE ) configSTACK_SAMPLE_WORDS;
+
+		/* Only the idle task frees TCBs, and it takes them out of the list
+		first, so the list can be walked here without a critical section.  A
+		task created meanwhile is added at the head, so is picked up by the
+		next sweep. */
+		if( pxSampleTCB == NULL )
+		{
+			pxSampleTCB = pxSampledTasks;
+			usSampleWords = 0U;
+
+			if( pxSampleTCB == NULL )
+			{
+				return;
+			}
+		}
+
+		#if ( configDEFER_STACK_FILL == 1 )
+		{
+			if( pxSampleTCB->pxFillNext != NULL )
+			{
+				/* The stack has not been filled yet, so cannot be sampled.
+				Fill some more of it instead. */
+				vTaskSuspendAll();
+				{
+					prvFillTaskStack( pxSampleTCB, ( unsigned portBASE_TYPE ) configSTACK_SAMPLE_WORDS );
+				}
+				( void ) xTaskResumeAll();
+				return;
+			}
+		}
+		#endif
+
+		memset( ( void * ) &xFillWord, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillWord ) );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pxWord = pxSampleTCB->pxStack + usSampleWords;
+		}
+		#else
+		{
+			pxWord = pxSampleTCB->pxEndOfStack - usSampleWords;
+		}
+		#endif
+
+		/* Fill words are only ever overwritten, so the free space can only
+		shrink and the scan need not go past the last high water mark. */
+		usLimit = pxSampleTCB->usStackWatermark;
+
+		while( ( uxWordsLeft > 0U ) && ( usSampleWords < usLimit ) && ( *pxWord == xFillWord ) )
+		{
+			pxWord -= portSTACK_GROWTH;
+			usSampleWords++;
+			uxWordsLeft--;
+		}
+
+		if( uxWordsLeft > 0U )
+		{
+			/* The end of the unused part of the stack has been found, or the
+			previous high water mark has been reached.  Record the result and
+			go on to the next task.  The stack may have been used further
+			while it was being scanned - the next sweep will see that. */
+			pxSampleTCB->usStackWatermark = usSampleWords;
+			pxSampleTCB = pxSampleTCB->pxNextSampled;
+			usSampleWords = 0U;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxTaskGetSampledStackHighWaterMark( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return ( unsigned portBASE_TYPE ) pxTCB->usStackWatermark;
+	}
+
+#endif /* configSTACK_SAMPLE_WORDS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_IDLE_WORK == 1 )
+
+	portBASE_TYPE xTaskRegisterIdleWork( xIdleWork *pxWork, pdIDLE_WORK_FUNCTION pxFunction, void *pvParameter, portTickType xBudget )
+	{
+	xIdleWork *pxListed;
+	portBASE_TYPE xReturn = pdPASS;
+
+		configASSERT( pxWork );
+		configASSERT( pxFunction );
+
+		taskENTER_CRITICAL();
+		{
+			/* The registry is expected to be short, so it is searched rather
+			than a flag being kept in the structure, which would have to be
+			initialised before the first registration. */
+			for( pxListed = pxIdleWorkHead; pxListed != NULL; pxListed = pxListed->pxNext )
+			{
+				if( pxListed == pxWork )
+				{
+					xReturn = pdFAIL;
+					break;
+				}
+			}
+
+			if( xReturn == pdPASS )
+			{
+				pxWork->pxFunction = pxFunction;
+				pxWork->pvParameter = pvParameter;
+				pxWork->xBudget = xBudget;
+				pxWork->pxNext = NULL;
+				pxWork->ulRuns = 0UL;
+				pxWork->ulOverruns = 0UL;
+
+				/* Jobs are added at the end so a new job waits for its turn
+				behind the jobs already registered. */
+				if( pxIdleWorkTail == NULL )
+				{
+					pxIdleWorkHead = pxWork;
+				}
+				else
+				{
+					pxIdleWorkTail->pxNext = pxWork;
+				}
+				pxIdleWorkTail = pxWork;
+			}
+		}
 		taskEXIT_CRITICAL();
 
 		return xReturn;
 	}
 
-#endif
+#endif /* configUSE_IDLE_WORK */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_IDLE_WORK == 1 )
 
-	portBASE_TYPE xTaskCallApplicationTaskHook( xTaskHandle xTask, void *pvParameter )
+	static portBASE_TYPE prvRunIdleWork( void )
 	{
-	tskTCB *xTCB;
-	portBASE_TYPE xReturn;
+	xIdleWork *pxWork, *pxFirst, *pxPrevious;
+	portTickType xAvailable, xStartTime, xTimeTaken;
+	portBASE_TYPE xMoreWork;
 
-		/* If xTask is NULL then we are calling our own task hook. */
-		if( xTask == NULL )
+		/* Jobs are only added by other tasks and only removed by this task, so
+		an empty registry can be seen without a critical section. */
+		if( pxIdleWorkHead == NULL )
 		{
-			xTCB = ( tskTCB * ) pxCurrentTCB;
+			return pdFALSE;
 		}
-		else
+
+		/* The estimate is taken without the scheduler suspended, so may be
+		out of date by the time the job runs - but then only because a task
+		has already been unblocked and has preempted the idle task. */
+		xAvailable = prvGetExpectedIdleTime();
+
+		taskENTER_CRITICAL();
 		{
-			xTCB = ( tskTCB * ) xTask;
+			/* Starting from the job after the one called last, find the first
+			job whose budget fits in the time available. */
+			pxFirst = ( pxNextIdleWork != NULL ) ? pxNextIdleWork : pxIdleWorkHead;
+			pxWork = pxFirst;
+
+			while( pxWork->xBudget >= xAvailable )
+			{
+				pxWork = ( pxWork->pxNext != NULL ) ? pxWork->pxNext : pxIdleWorkHead;
+
+				if( pxWork == pxFirst )
+				{
+					pxWork = NULL;
+					break;
+				}
+			}
+
+			if( pxWork != NULL )
+			{
+				pxNextIdleWork = pxWork->pxNext;
+			}
 		}
+		taskEXIT_CRITICAL();
 
-		if( xTCB->pxTaskTag != NULL )
+		if( pxWork == NULL )
 		{
-			xReturn = xTCB->pxTaskTag( pvParameter );
+			return pdFALSE;
 		}
-		else
+
+		/* The job runs with interrupts enabled, and is preempted by any task
+		that unblocks, like any other idle processing. */
+		xStartTime = xTaskGetTickCount();
+		xMoreWork = pxWork->pxFunction( pxWork->pvParameter, pxWork->xBudget );
+		xTimeTaken = xTaskGetTickCount() - xStartTime;
+
+		/* Only this task writes the counts while the job is registered. */
+		( pxWork->ulRuns )++;
+		if( xTimeTaken > pxWork->xBudget )
 		{
-			xReturn = pdFAIL;
+			( pxWork->ulOverruns )++;
 		}
 
-		return xReturn;
+		if( xMoreWork == pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxIdleWorkHead == pxWork )
+				{
+					pxPrevious = NULL;
+					pxIdleWorkHead = pxWork->pxNext;
+				}
+				else
+				{
+					for( pxPrevious = pxIdleWorkHead; pxPrevious->pxNext != pxWork; pxPrevious = pxPrevious->pxNext )
+					{
+						/* Find the job before pxWork. */
+					}
+					pxPrevious->pxNext = pxWork->pxNext;
+				}
+
+				if( pxIdleWorkTail == pxWork )
+				{
+					pxIdleWorkTail = pxPrevious;
+				}
+
+				if( pxNextIdleWork == pxWork )
+				{
+					pxNextIdleWork = pxWork->pxNext;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		return pdTRUE;
 	}
 
-#endif
+#endif /* configUSE_IDLE_WORK */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-	if( uxSchedulerSuspended != ( unsigned portBASE_TYPE ) pdFALSE )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvSelectEarliestDeadlineTask( void )
 	{
-		/* The scheduler is currently suspended - do not allow a context
-		switch. */
-		xMissedYield = pdTRUE;
+	xList * const pxList = ( xList * ) &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	volatile xListItem *pxItem;
+	tskTCB *pxTCB, *pxSelectedTCB;
+
+		/* Start from the task taskSELECT_HIGHEST_PRIORITY_TASK() chose, so
+		tasks with equal deadlines still take turns. */
+		pxSelectedTCB = pxCurrentTCB;
+
+		for( pxItem = pxList->xListEnd.pxNext; pxItem != ( xListItem * ) &( pxList->xListEnd ); pxItem = pxItem->pxNext )
+		{
+			pxTCB = ( tskTCB * ) pxItem->pvOwner;
+
+			#if ( configUSE_MUTEXES == 1 )
+			{
+				if( pxTCB->uxBasePriority != pxTCB->uxPriority )
+				{
+					/* The task holds a mutex wanted by a task at this
+					priority, so must run first whatever its deadline. */
+					pxSelectedTCB = pxTCB;
+					break;
+				}
+			}
+			#endif
+
+			if( pxTCB->ucHasDeadline != ( unsigned char ) pdFALSE )
+			{
+				if( ( pxSelectedTCB->ucHasDeadline == ( unsigned char ) pdFALSE ) || ( taskTICK_IS_BEFORE( pxTCB->xDeadline, pxSelectedTCB->xDeadline ) != pdFALSE ) )
+				{
+					pxSelectedTCB = pxTCB;
+				}
+			}
+		}
+
+		pxCurrentTCB = pxSelectedTCB;
 	}
-	else
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvCheckTaskBudgets( void )
 	{
-		traceTASK_SWITCHED_OUT();
-	
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	tskTCB *pxTCB;
+
+		for( pxTCB = pxBudgetedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextBudgeted )
 		{
-			unsigned long ulTempCounter;
-			
-				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTempCounter );
-				#else
-					ulTempCounter = portGET_RUN_TIME_COUNTER_VALUE();
-				#endif
-	
-				/* Add the amount of time the task has been running to the accumulated
-				time so far.  The time the task started running was stored in
-				ulTaskSwitchedInTime.  Note that there is no overflow protection here
-				so count values are only valid until the timer overflows.  Generally
-				this will be about 1 hour assuming a 1uS timer increment. */
-				pxCurrentTCB->ulRunTimeCounter += ( ulTempCounter - ulTaskSwitchedInTime );
-				ulTaskSwitchedInTime = ulTempCounter;
+			if( taskTICK_IS_BEFORE( xTickCount, pxTCB->xNextReplenish ) == pdFALSE )
+			{
+				pxTCB->xBudgetLeft = pxTCB->xBudget;
+				pxTCB->xNextReplenish += pxTCB->xBudgetPeriod;
+
+				if( taskTICK_IS_BEFORE( xTickCount, pxTCB->xNextReplenish ) == pdFALSE )
+				{
+					/* More than a whole period has been missed, as can happen
+					when the tick is suppressed, so start again from now. */
+					pxTCB->xNextReplenish = xTickCount + pxTCB->xBudgetPeriod;
+				}
+
+				traceTASK_BUDGET_REPLENISHED( pxTCB );
+
+				/* A task is only ever below its base priority because it used
+				up its budget.  If it is above it, because it holds a mutex a
+				higher priority task is waiting for, it is left there. */
+				if( pxTCB->uxPriority < pxTCB->uxBasePriority )
+				{
+					prvSetInheritedPriority( pxTCB, pxTCB->uxBasePriority );
+				}
+			}
+			else if( ( pxTCB->xBudgetLeft == ( portTickType ) 0U ) && ( pxTCB->uxPriority == pxTCB->uxBasePriority ) && ( pxTCB->uxPriority > ( unsigned portBASE_TYPE ) configBUDGET_EXHAUSTED_PRIORITY ) )
+			{
+				/* Only a task running at its base priority is dropped, so one
+				that has inherited a priority keeps it until it gives the mutex
+				back, and is then dropped on the next tick. */
+				traceTASK_BUDGET_EXHAUSTED( pxTCB );
+				prvSetInheritedPriority( pxTCB, ( unsigned portBASE_TYPE ) configBUDGET_EXHAUSTED_PRIORITY );
+			}
 		}
-		#endif
-	
-		taskFIRST_CHECK_FOR_STACK_OVERFLOW();
-		taskSECOND_CHECK_FOR_STACK_OVERFLOW();
-	
-		/* Find the highest priority queue that contains ready tasks. */
-		while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRemoveBudgetedTask( tskTCB *pxTCB )
+	{
+	tskTCB **ppxLink;
+
+		for( ppxLink = &pxBudgetedTasks; *ppxLink != pxTCB; ppxLink = &( ( *ppxLink )->pxNextBudgeted ) )
 		{
-			configASSERT( uxTopReadyPriority );
-			--uxTopReadyPriority;
 		}
-	
-		/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the tasks of the
-		same priority get an equal share of the processor time. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );
-	
-		traceTASK_SWITCHED_IN();
+		*ppxLink = pxTCB->pxNextBudgeted;
+		pxTCB->pxNextBudgeted = NULL;
 	}
-}
+
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( const xList * const pxEventList, portTickType xTicksToWait )
-{
-portTickType xTimeToWake;
+#if ( configUSE_TIME_TRIGGERED_SCHEDULE == 1 )
+
+	void vTaskSetTimeTriggeredSchedule( const xTimeTriggeredEntry *pxTable, unsigned portBASE_TYPE uxEntries, portTickType xFrameLength )
+	{
+	unsigned portBASE_TYPE uxEntry;
+
+		/* The table must be in order of offset, and every offset must be
+		within the frame, as the tick only ever looks at the next entry. */
+		if( pxTable != NULL )
+		{
+			configASSERT( xFrameLength > ( portTickType ) 0U );
+
+			for( uxEntry = ( unsigned portBASE_TYPE ) 0U; uxEntry < uxEntries; uxEntry++ )
+			{
+				configASSERT( pxTable[ uxEntry ].xOffset < xFrameLength );
+				configASSERT( pxTable[ uxEntry ].pxTask != NULL );
+				configASSERT( ( uxEntry == ( unsigned portBASE_TYPE ) 0U ) || ( pxTable[ uxEntry ].xOffset >= pxTable[ uxEntry - 1U ].xOffset ) );
+			}
+		}
+
+		taskENTER_CRITICAL();
+		{
+			/* The next tick is the first of a new frame. */
+			pxSchedule = pxTable;
+			uxScheduleEntries = uxEntries;
+			xMajorFrame = xFrameLength;
+			uxNextScheduleEntry = ( unsigned portBASE_TYPE ) 0U;
+			xFrameTick = ( portTickType ) 0U;
+			xFrameStartTick = xTickCount + ( portTickType ) 1U;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskWaitForActivation( void )
+	{
+		/* The task must be able to leave the Running state. */
+		configASSERT( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE );
+
+		taskENTER_CRITICAL();
+		{
+			if( uxListRemove( &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+			{
+				taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+			}
+
+			vListInsertEnd( ( xList * ) &xTimeTriggeredTaskList, &( pxCurrentTCB->xGenericListItem ) );
+		}
+		taskEXIT_CRITICAL();
+
+		/* If the release comes before the yield the task is already back in
+		the Ready state, and the yield just returns. */
+		portYIELD_WITHIN_API();
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned long ulTaskGetActivationOverruns( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->ulActivationOverruns;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseTimeTriggeredTasks( portTickType xTicks )
+	{
+	tskTCB *pxTCB;
+	portTickType xFrameEnd;
+
+		while( xTicks > ( portTickType ) 0U )
+		{
+			/* The ticks passed over in this frame end at xFrameEnd. */
+			if( xTicks < ( portTickType ) ( xMajorFrame - xFrameTick ) )
+			{
+				xFrameEnd = xFrameTick + xTicks;
+			}
+			else
+			{
+				xFrameEnd = xMajorFrame;
+			}
+
+			/* The entries are in order of offset, and those before xFrameTick
+			have been released already, so only the next entry has to be
+			looked at to know whether anything is released in these ticks. */
+			while( ( uxNextScheduleEntry < uxScheduleEntries ) && ( pxSchedule[ uxNextScheduleEntry ].xOffset < xFrameEnd ) )
+			{
+				pxTCB = ( tskTCB * ) *( pxSchedule[ uxNextScheduleEntry ].pxTask );
+
+				/* A NULL handle is a task that has not been created yet. */
+				if( pxTCB != NULL )
+				{
+					if( listIS_CONTAINED_WITHIN( &xTimeTriggeredTaskList, &( pxTCB->xGenericListItem ) ) != pdFALSE )
+					{
+						( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+						prvAddTaskToReadyQueue( pxTCB );
+					}
+					else
+					{
+						/* The task has not finished its last activation, so
+						this one is dropped rather than queued - a task that
+						overruns must not push the rest of the frame late.
+						This includes a task released earlier in the same
+						batch of missed ticks that has not run since. */
+						( pxTCB->ulActivationOverruns )++;
+						traceTASK_ACTIVATION_OVERRUN( pxTCB );
+					}
+				}
+
+				uxNextScheduleEntry++;
+			}
+
+			xTicks -= xFrameEnd - xFrameTick;
+			xFrameTick = xFrameEnd;
+			if( xFrameTick >= xMajorFrame )
+			{
+				xFrameTick = ( portTickType ) 0U;
+				uxNextScheduleEntry = ( unsigned portBASE_TYPE ) 0U;
+				xFrameStartTick += xMajorFrame;
+			}
+		}
+
+		/* The tick after xTickCount must be at xFrameTick in the frame,
+		however the ticks reached this function. */
+		configASSERT( ( portTickType ) ( xTickCount + ( portTickType ) 1U - xFrameStartTick ) == xFrameTick );
+	}
 
-	configASSERT( pxEventList );
+#endif /* configUSE_TIME_TRIGGERED_SCHEDULE */
+/*-----------------------------------------------------------*/
 
-	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
-	SCHEDULER SUSPENDED. */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
 
-	/* Place the event list item of the TCB in the appropriate event list.
-	This is placed in the list in priority order so the highest priority task
-	is the first to be woken by the event. */
-	vListInsert( ( xList * ) pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+	static unsigned portBASE_TYPE prvGetHighestReadyPriority( void )
+	{
+	unsigned portBASE_TYPE uxTopPriority;
 
-	/* We must remove ourselves from the ready list before adding ourselves
-	to the blocked list as the same list item is used for both lists.  We have
-	exclusive access to the ready lists as the scheduler is locked. */
-	vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+		#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			/* uxTopReadyPriority is only lowered lazily, so may be above the
+			highest priority that has a Ready state task.  The idle task is
+			always ready, so the search stops. */
+			uxTopPriority = uxTopReadyPriority;
+			while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )
+			{
+				configASSERT( uxTopPriority );
+				--uxTopPriority;
+			}
+		}
+		#else
+		{
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+		}
+		#endif
 
+		return uxTopPriority;
+	}
+	/*-----------------------------------------------------------*/
 
-	#if ( INCLUDE_vTaskSuspend == 1 )
+	static portBASE_TYPE prvSelectPreemptedTask( void )
 	{
-		if( xTicksToWait == portMAX_DELAY )
+	unsigned portBASE_TYPE uxTopPriority;
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		/* A task that is switched out while it is still ready and its
+		threshold is in force has been preempted, the other ways it can be
+		switched out all remove it from its ready list.  Each task on the list
+		was preempted by one whose threshold is higher, so the most recently
+		preempted task always has the highest threshold. */
+		if( taskHOLDS_PREEMPTION_THRESHOLD( pxCurrentTCB ) )
 		{
-			/* Add ourselves to the suspended task list instead of a delayed task
-			list to ensure we are not woken by a timing event.  We will block
-			indefinitely. */
-			vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			pxCurrentTCB->pxNextPreempted = pxPreemptedTasks;
+			pxPreemptedTasks = pxCurrentTCB;
 		}
-		else
+
+		uxTopPriority = prvGetHighestReadyPriority();
+
+		while( pxPreemptedTasks != NULL )
 		{
-			/* Calculate the time at which the task should be woken if the event does
-			not occur.  This may overflow but this doesn't matter. */
-			xTimeToWake = xTickCount + xTicksToWait;
-			prvAddCurrentTaskToDelayedList( xTimeToWake );
+			pxTCB = pxPreemptedTasks;
+
+			if( taskHOLDS_PREEMPTION_THRESHOLD( pxTCB ) )
+			{
+				/* The preempted task continues before any task at or below
+				its threshold, including tasks of its own priority. */
+				if( uxTopPriority <= taskPREEMPTION_THRESHOLD( pxTCB ) )
+				{
+					pxPreemptedTasks = pxTCB->pxNextPreempted;
+					pxTCB->pxNextPreempted = NULL;
+					pxCurrentTCB = pxTCB;
+					xReturn = pdTRUE;
+				}
+
+				break;
+			}
+
+			/* The task has left the Ready state, or its threshold was lowered,
+			since it was preempted, so it is scheduled as normal. */
+			pxPreemptedTasks = pxTCB->pxNextPreempted;
+			pxTCB->pxNextPreempted = NULL;
 		}
+
+		return xReturn;
 	}
-	#else
+	/*-----------------------------------------------------------*/
+
+	static void prvRemovePreemptedTask( tskTCB *pxTCB )
 	{
-			/* Calculate the time at which the task should be woken if the event does
-			not occur.  This may overflow but this doesn't matter. */
-			xTimeToWake = xTickCount + xTicksToWait;
-			prvAddCurrentTaskToDelayedList( xTimeToWake );
+	tskTCB **ppxLink;
+
+		/* Unlike the budgeted list the task is not necessarily on the list. */
+		for( ppxLink = &pxPreemptedTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextPreempted ) )
+		{
+			if( *ppxLink == pxTCB )
+			{
+				*ppxLink = pxTCB->pxNextPreempted;
+				pxTCB->pxNextPreempted = NULL;
+				break;
+			}
+		}
 	}
-	#endif
-}
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
 /*-----------------------------------------------------------*/
 
-#if configUSE_TIMERS == 1
+#if ( configRECORD_RELEASE_JITTER == 1 )
 
-	void vTaskPlaceOnEventListRestricted( const xList * const pxEventList, portTickType xTicksToWait )
+	static void prvRecordReleaseLateness( tskTCB *pxTCB )
 	{
-	portTickType xTimeToWake;
+	portRUN_TIME_COUNTER_TYPE ulLateness, ulBucketLimit;
+	unsigned portBASE_TYPE uxBucket;
 
-		configASSERT( pxEventList );
+		pxTCB->ucReleasePending = ( unsigned char ) pdFALSE;
 
-		/* This function should not be called by application code hence the
-		'Restricted' in its name.  It is not part of the public API.  It is
-		designed for use by kernel code, and has special calling requirements -
-		it should be called from a critical section. */
+		if( taskTICK_IS_BEFORE( xTickCount, pxTCB->xReleaseTime ) == pdFALSE )
+		{
+			/* The time since the last tick, plus a tick period for each tick
+			since the wake time. */
+			#if ( configNUMBER_OF_CORES == 1 )
+			{
+				ulLateness = ulTaskSwitchedInTime - ulTickRunTime;
+			}
+			#else
+			{
+				ulLateness = ulTaskSwitchedInTime[ portGET_CORE_ID() ] - ulTickRunTime;
+			}
+			#endif
+			ulLateness += ( portRUN_TIME_COUNTER_TYPE ) ( xTickCount - pxTCB->xReleaseTime ) * ulTickPeriodRunTime;
 
-	
-		/* Place the event list item of the TCB in the appropriate event list.
-		In this case it is assume that this is the only task that is going to
-		be waiting on this event list, so the faster vListInsertEnd() function
-		can be used in place of vListInsert. */
-		vListInsertEnd( ( xList * ) pxEventList, ( xListItem * ) &( pxCurrentTCB->xEventListItem ) );
+			if( ulLateness < pxTCB->ulMinLateness )
+			{
+				pxTCB->ulMinLateness = ulLateness;
+			}
 
-		/* We must remove this task from the ready list before adding it to the
-		blocked list as the same list item is used for both lists.  This
-		function is called form a critical section. */
-		vListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			if( ulLateness > pxTCB->ulMaxLateness )
+			{
+				pxTCB->ulMaxLateness = ulLateness;
+			}
 
-		/* Calculate the time at which the task should be woken if the event does
-		not occur.  This may overflow but this doesn't matter. */
-		xTimeToWake = xTickCount + xTicksToWait;
-		prvAddCurrentTaskToDelayedList( xTimeToWake );
+			pxTCB->ulTotalLateness += ulLateness;
+			( pxTCB->ulReleases )++;
+
+			/* Each bucket ends at twice the limit of the one before. */
+			ulBucketLimit = ( portRUN_TIME_COUNTER_TYPE ) configRELEASE_JITTER_RESOLUTION;
+			for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) ( configRELEASE_JITTER_BUCKETS - 1 ); uxBucket++ )
+			{
+				if( ulLateness < ulBucketLimit )
+				{
+					break;
+				}
+				ulBucketLimit <<= 1;
+			}
+			( pxTCB->ulLatenessHistogram[ uxBucket ] )++;
+		}
 	}
-	
-#endif /* configUSE_TIMERS */
+
+#endif /* configRECORD_RELEASE_JITTER */
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE xTaskRemoveFromEventList( const xList * const pxEventList )
-{
-tskTCB *pxUnblockedTCB;
-portBASE_TYPE xReturn;
+#if ( configRECORD_WAKE_LATENCY == 1 )
 
-	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS DISABLED OR THE
-	SCHEDULER SUSPENDED.  It can also be called from within an ISR. */
+	static void prvRecordWakeLatency( tskTCB *pxTCB )
+	{
+	portRUN_TIME_COUNTER_TYPE ulLatency, ulBucketLimit;
+	unsigned portBASE_TYPE uxBucket;
 
-	/* The event list is sorted in priority order, so we can remove the
-	first in the list, remove the TCB from the delayed list, and add
-	it to the ready list.
+		pxTCB->ucWakePending = ( unsigned char ) pdFALSE;
 
-	If an event is for a queue that is locked then this function will never
-	get called - the lock count on the queue will get modified instead.  This
-	means we can always expect exclusive access to the event list here.
-	
-	This function assumes that a check has already been made to ensure that
-	pxEventList is not empty. */
-	pxUnblockedTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
-	configASSERT( pxUnblockedTCB );
-	vListRemove( &( pxUnblockedTCB->xEventListItem ) );
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			ulLatency = ulTaskSwitchedInTime - pxTCB->ulReadyTime;
+		}
+		#else
+		{
+			ulLatency = ulTaskSwitchedInTime[ portGET_CORE_ID() ] - pxTCB->ulReadyTime;
+		}
+		#endif
 
-	if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
-	{
-		vListRemove( &( pxUnblockedTCB->xGenericListItem ) );
-		prvAddTaskToReadyQueue( pxUnblockedTCB );
-	}
-	else
-	{
-		/* We cannot access the delayed or ready lists, so will hold this
-		task pending until the scheduler is resumed. */
-		vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-	}
+		if( ulLatency > pxTCB->ulMaxWakeLatency )
+		{
+			pxTCB->ulMaxWakeLatency = ulLatency;
+		}
 
-	if( pxUnblockedTCB->uxPriority >= pxCurrentTCB->uxPriority )
-	{
-		/* Return true if the task removed from the event list has
-		a higher priority than the calling task.  This allows
-		the calling task to know if it should force a context
-		switch now. */
-		xReturn = pdTRUE;
+		pxTCB->ulTotalWakeLatency += ulLatency;
+		( pxTCB->ulWakeUps )++;
+
+		/* Each bucket ends at twice the limit of the one before. */
+		ulBucketLimit = ( portRUN_TIME_COUNTER_TYPE ) configWAKE_LATENCY_RESOLUTION;
+		for( uxBucket = 0U; uxBucket < ( unsigned portBASE_TYPE ) ( configWAKE_LATENCY_BUCKETS - 1 ); uxBucket++ )
+		{
+			if( ulLatency < ulBucketLimit )
+			{
+				break;
+			}
+			ulBucketLimit <<= 1;
+		}
+		( pxTCB->ulWakeLatencyHistogram[ uxBucket ] )++;
 	}
-	else
+
+#endif /* configRECORD_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configDEFER_STACK_FILL == 1 )
+
+	static void prvFillTaskStack( tskTCB *pxTCB, unsigned portBASE_TYPE uxMaxWords )
 	{
-		xReturn = pdFALSE;
+	portSTACK_TYPE xFillWord;
+	portSTACK_TYPE *pxWord = pxTCB->pxFillNext;
+
+		memset( ( void * ) &xFillWord, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillWord ) );
+
+		/* The task is not running, so nothing beyond the stack pointer saved
+		in its TCB is in use.  Words the task used before being filled are
+		overwritten too, so the high water mark only counts from the time the
+		fill is complete. */
+		#if portSTACK_GROWTH < 0
+		{
+			while( ( pxWord < pxTCB->pxTopOfStack ) && ( uxMaxWords > 0U ) )
+			{
+				*pxWord = xFillWord;
+				pxWord++;
+				uxMaxWords--;
+			}
+
+			if( pxWord >= pxTCB->pxTopOfStack )
+			{
+				pxWord = NULL;
+			}
+		}
+		#else
+		{
+			while( ( pxWord > pxTCB->pxTopOfStack ) && ( uxMaxWords > 0U ) )
+			{
+				*pxWord = xFillWord;
+				pxWord--;
+				uxMaxWords--;
+			}
+
+			if( pxWord <= pxTCB->pxTopOfStack )
+			{
+				pxWord = NULL;
+			}
+		}
+		#endif
+
+		pxTCB->pxFillNext = pxWord;
 	}
 
-	return xReturn;
-}
+#endif /* configDEFER_STACK_FILL */
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( xTimeOutType * const pxTimeOut )
-{
-	configASSERT( pxTimeOut );
-	pxTimeOut->xOverflowCount = xNumOfOverflows;
-	pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+#if ( INCLUDE_vTaskDelete == 1 )
 
-portBASE_TYPE xTaskCheckForTimeOut( xTimeOutType * const pxTimeOut, portTickType * const pxTicksToWait )
-{
-portBASE_TYPE xReturn;
+	static void prvDeleteTCB( tskTCB *pxTCB )
+	{
+		#if ( configUSE_THREAD_LOCAL_STORAGE_DELETE_CALLBACKS == 1 )
+		{
+		portBASE_TYPE xIndex;
 
-	configASSERT( pxTimeOut );
-	configASSERT( pxTicksToWait );
+			/* Let the owners of the thread local storage pointers release
+			what they point to.  This runs in the context of the task that
+			cleans up deleted tasks, normally the idle task. */
+			for( xIndex = 0; xIndex < ( portBASE_TYPE ) configNUM_THREAD_LOCAL_STORAGE_POINTERS; xIndex++ )
+			{
+				if( pxTCB->pxThreadLocalStorageDeleteCallbacks[ xIndex ] != NULL )
+				{
+					pxTCB->pxThreadLocalStorageDeleteCallbacks[ xIndex ]( xIndex, pxTCB->pvThreadLocalStoragePointers[ xIndex ] );
+				}
+			}
+		}
+		#endif
 
-	taskENTER_CRITICAL();
-	{
-		#if ( INCLUDE_vTaskSuspend == 1 )
-			/* If INCLUDE_vTaskSuspend is set to 1 and the block time specified is
-			the maximum block time then the task should block indefinitely, and
-			therefore never time out. */
-			if( *pxTicksToWait == portMAX_DELAY )
+		#if ( configUSE_HEAP_TRACE == 1 )
+		{
+			/* The entry is kept by heap_trace.c while blocks allocated by the
+			task remain allocated. */
+			if( pxTCB->ucHeapOwner != ( unsigned char ) heaptraceNO_OWNER )
 			{
-				xReturn = pdFALSE;
+				vHeapTraceReleaseOwner( ( unsigned portBASE_TYPE ) pxTCB->ucHeapOwner );
 			}
-			else /* We are not blocking indefinitely, perform the checks below. */
+		}
 		#endif
 
-		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( ( portTickType ) xTickCount >= ( portTickType ) pxTimeOut->xTimeOnEntering ) )
+		#if ( configUSE_HEAP_TASK_CACHES == 1 )
 		{
-			/* The tick count is greater than the time at which vTaskSetTimeout()
-			was called, but has also overflowed since vTaskSetTimeOut() was called.
-			It must have wrapped all the way around and gone past us again. This
-			passed since vTaskSetTimeout() was called. */
-			xReturn = pdTRUE;
+			if( pxTCB->pvHeapCache != NULL )
+			{
+				vPortFreeTaskHeapCache( pxTCB->pvHeapCache );
+				pxTCB->pvHeapCache = NULL;
+			}
 		}
-		else if( ( ( portTickType ) ( ( portTickType ) xTickCount - ( portTickType ) pxTimeOut->xTimeOnEntering ) ) < ( portTickType ) *pxTicksToWait )
+		#endif
+
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
+
+		/* Free up the memory allocated by the scheduler for the task.  It is up to
+		the task to free any memory allocated at the application level.  Memory
+		supplied by the application to xTaskCreateStatic() is not freed. */
+		#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
 		{
-			/* Not a genuine timeout. Adjust parameters for time remaining. */
-			*pxTicksToWait -= ( ( portTickType ) xTickCount - ( portTickType ) pxTimeOut->xTimeOnEntering );
-			vTaskSetTimeOutState( pxTimeOut );
-			xReturn = pdFALSE;
+			prvFreeTCBAndStack( pxTCB );
 		}
-		else
+		#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			if( pxTCB->ucStaticallyAllocated == pdFALSE )
+			{
+				prvFreeTCBAndStack( pxTCB );
+			}
+		}
+		#endif
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	static void prvFreeTCBAndStack( tskTCB *pxTCB )
+	{
+		#if ( configTASK_RECYCLE_CACHE_SIZE > 0 )
+		{
+		unsigned portBASE_TYPE ux;
+
+			if( pxTCB->usRecycleDepth != ( unsigned short ) 0U )
+			{
+				taskENTER_CRITICAL();
+				{
+					for( ux = 0U; ux < ( unsigned portBASE_TYPE ) configTASK_RECYCLE_CACHE_SIZE; ux++ )
+					{
+						if( pxRecycledTCBs[ ux ] == NULL )
+						{
+							pxRecycledTCBs[ ux ] = pxTCB;
+							pxTCB = NULL;
+							break;
+						}
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		#endif
+
+		/* The cache is full, or not used. */
+		if( pxTCB != NULL )
 		{
-			xReturn = pdTRUE;
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
 		}
 	}
-	taskEXIT_CRITICAL();
 
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+#endif
+
 
-void vTaskMissedYield( void )
-{
-	xMissedYield = pdTRUE;
-}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-	unsigned portBASE_TYPE uxTaskGetTaskNumber( xTaskHandle xTask )
+#if ( configUSE_HEAP_TRACE == 1 )
+
+	unsigned portBASE_TYPE uxTaskGetHeapOwner( void )
 	{
-	unsigned portBASE_TYPE uxReturn;
 	tskTCB *pxTCB;
-	
-		if( xTask != NULL )
+
+		/* Memory allocated before the scheduler is started is not counted
+		against the task pxCurrentTCB happens to point to. */
+		if( xSchedulerRunning == pdFALSE )
 		{
-			pxTCB = ( tskTCB * ) xTask;
-			uxReturn = pxTCB->uxTaskNumber;
+			return heaptraceNO_OWNER;
 		}
-		else
+
+		pxTCB = pxCurrentTCB;
+		if( pxTCB->ucHeapOwner == ( unsigned char ) heaptraceNO_OWNER )
 		{
-			uxReturn = 0U;
+			/* Left at heaptraceNO_OWNER if every entry is in use, in which
+			case an entry is looked for again on the next allocation. */
+			pxTCB->ucHeapOwner = ( unsigned char ) uxHeapTraceClaimOwner( ( xTaskHandle ) pxTCB );
 		}
-		
-		return uxReturn;
+
+		return ( unsigned portBASE_TYPE ) pxTCB->ucHeapOwner;
 	}
+
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-	void vTaskSetTaskNumber( xTaskHandle xTask, unsigned portBASE_TYPE uxHandle )
+#if ( configUSE_HEAP_TASK_CACHES == 1 )
+
+	void **ppvTaskGetHeapCache( void )
 	{
-	tskTCB *pxTCB;
-	
-		if( xTask != NULL )
+		/* Before the scheduler is started pxCurrentTCB is not the caller. */
+		if( xSchedulerRunning == pdFALSE )
 		{
-			pxTCB = ( tskTCB * ) xTask;
-			pxTCB->uxTaskNumber = uxHandle;
+			return NULL;
 		}
+
+		return &( pxCurrentTCB->pvHeapCache );
 	}
+
 #endif
+/*-----------------------------------------------------------*/
 
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configUSE_TASK_NOTIFICATIONS == 1 ) )
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-	/* Stop warnings. */
-	( void ) pvParameters;
+	xTaskHandle xTaskGetCurrentTaskHandle( void )
+	{
+	xTaskHandle xReturn;
 
-	for( ;; )
+		/* A critical section is not required as this is not called from
+		an interrupt and the current TCB will always be the same for any
+		individual execution thread. */
+		xReturn = pxCurrentTCB;
+
+		return xReturn;
+	}
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+	portBASE_TYPE xTaskGetSchedulerState( void )
 	{
-		/* See if any tasks have been deleted. */
-		prvCheckTasksWaitingTermination();
+	portBASE_TYPE xReturn;
 
-		#if ( configUSE_PREEMPTION == 0 )
+		if( xSchedulerRunning == pdFALSE )
 		{
-			/* If we are not using preemption we keep forcing a task switch to
-			see if any other task has become available.  If we are using
-			preemption we don't need to do this as any task becoming available
-			will automatically get the processor anyway. */
-			taskYIELD();
+			xReturn = taskSCHEDULER_NOT_STARTED;
+		}
+		else
+		{
+			if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+			{
+				xReturn = taskSCHEDULER_RUNNING;
+			}
+			else
+			{
+				xReturn = taskSCHEDULER_SUSPENDED;
+			}
 		}
-		#endif
 
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static void prvSetInheritedPriority( tskTCB * const pxTCB, unsigned portBASE_TYPE uxNewPriority )
+	{
+	unsigned portBASE_TYPE uxOldPriority = pxTCB->uxPriority;
+	#if ( configUSE_PRIORITY_EVENT_LISTS == 0 )
+		xList *pxEventList;
+	#endif
+
+		/* Adjust the task state to account for its new priority, unless the
+		event list item value is in use by an event group. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
 		{
-			/* When using preemption tasks of equal priority will be
-			timesliced.  If a task that is sharing the idle priority is ready
-			to run then the idle task should yield before the end of the
-			timeslice.
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxNewPriority );
 
-			A critical region is not required here as we are just reading from
-			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( unsigned portBASE_TYPE ) 1 )
+			/* If the task is itself blocked on a mutex then move it to the
+			position in the mutex event list appropriate to its new priority,
+			so it is the first to obtain the mutex if it is now the highest
+			priority waiter. */
+			if( pxTCB->pvMutexBlockedOn != NULL )
 			{
-				taskYIELD();
+				#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+				{
+					/* Mutex event lists are then priority lists, so the task
+					moves to the bucket for its new priority. */
+					if( ( pxTCB->xEventListItem.pvContainer != NULL ) && ( pxTCB->xEventListItem.pvContainer != ( void * ) &xPendingReadyList ) )
+					{
+						vListMovePriority( &( pxTCB->xEventListItem ), uxNewPriority );
+					}
+				}
+				#else
+				{
+					pxEventList = ( xList * ) pxTCB->xEventListItem.pvContainer;
+
+					if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+					}
+				}
+				#endif
 			}
 		}
-		#endif
 
-		#if ( configUSE_IDLE_HOOK == 1 )
+		/* If the task being modified is in the ready state it will need to
+		be moved in to a new list. */
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxOldPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
 		{
-			extern void vApplicationIdleHook( void );
+			if( uxListRemove( &( pxTCB->xGenericListItem ) ) == 0 )
+			{
+				taskRESET_READY_PRIORITY( uxOldPriority );
+			}
 
-			/* Call the user defined function from within the idle task.  This
-			allows the application designer to add background functionality
-			without the overhead of a separate task.
-			NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-			CALL A FUNCTION THAT MIGHT BLOCK. */
-			vApplicationIdleHook();
+			/* Change the priority before being moved into the new list. */
+			pxTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyQueue( pxTCB );
+
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				/* A raised task may now preempt another core.  The calling
+				task is about to block, so does not need to yield here
+				itself. */
+				if( ( uxNewPriority > uxOldPriority ) && ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) )
+				{
+					( void ) prvYieldForTask( pxTCB );
+				}
+			}
+			#endif
+		}
+		else
+		{
+			/* Just change the priority. */
+			pxTCB->uxPriority = uxNewPriority;
+		}
+
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* A task running on another core that has had its priority
+			lowered may no longer be the task that core should run. */
+			if( ( uxNewPriority < uxOldPriority ) && ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+			{
+				portYIELD_CORE( pxTCB->xTaskRunState );
+			}
 		}
 		#endif
 	}
-} /*lint !e715 pvParameters is not accessed but all task functions require the same prototype. */
-
 
+#endif
+/*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
 
+	portBASE_TYPE xTaskPriorityInherit( xTaskHandle * const pxMutexHolder )
+	{
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	portBASE_TYPE xReturn = pdFALSE;
 
+		configASSERT( pxMutexHolder );
 
+		if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
+		{
+			prvSetInheritedPriority( pxTCB, pxCurrentTCB->uxPriority );
+			traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+			xReturn = pdTRUE;
+		}
 
-/*-----------------------------------------------------------
- * File private functions documented at the top of the file.
- *----------------------------------------------------------*/
+		return xReturn;
+	}
 
+#endif
+/*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
 
-static void prvInitialiseTCBVariables( tskTCB *pxTCB, const signed char * const pcName, unsigned portBASE_TYPE uxPriority, const xMemoryRegion * const xRegions, unsigned short usStackDepth )
-{
-	/* Store the function name in the TCB. */
-	#if configMAX_TASK_NAME_LEN > 1
+	portBASE_TYPE xTaskPriorityRaise( xTaskHandle * const pxMutexHolder, unsigned portBASE_TYPE uxPriority )
 	{
-		/* Don't bring strncpy into the build unnecessarily. */
-		strncpy( ( char * ) pxTCB->pcTaskName, ( const char * ) pcName, ( unsigned short ) configMAX_TASK_NAME_LEN );
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	portBASE_TYPE xReturn = pdFALSE;
+
+		configASSERT( pxMutexHolder );
+
+		if( uxPriority >= ( unsigned portBASE_TYPE ) configMAX_PRIORITIES )
+		{
+			uxPriority = ( unsigned portBASE_TYPE ) configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) 1U;
+		}
+
+		if( pxTCB->uxPriority < uxPriority )
+		{
+			prvSetInheritedPriority( pxTCB, uxPriority );
+			traceTASK_PRIORITY_INHERIT( pxTCB, uxPriority );
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
 	}
-	#endif
-	pxTCB->pcTaskName[ ( unsigned short ) configMAX_TASK_NAME_LEN - ( unsigned short ) 1 ] = ( signed char ) '\0';
 
-	/* This is used as an array index so must ensure it's not too large.  First
-	remove the privilege bit if one is present. */
-	if( uxPriority >= configMAX_PRIORITIES )
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder )
 	{
-		uxPriority = configMAX_PRIORITIES - ( unsigned portBASE_TYPE ) 1U;
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+
+		if( pxMutexHolder != NULL )
+		{
+			configASSERT( pxTCB->uxMutexesHeld );
+			( pxTCB->uxMutexesHeld )--;
+
+			/* Only disinherit once no other mutex is held, as the inherited
+			priority may have come from a task waiting for one of them. */
+			if( ( pxTCB->uxPriority != pxTCB->uxBasePriority ) && ( pxTCB->uxMutexesHeld == ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				/* We must be the running task to be able to give the mutex back.
+				Remove ourselves from the ready list we currently appear in. */
+				if( uxListRemove( &( pxTCB->xGenericListItem ) ) == 0 )
+				{
+					taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+				}
+
+				/* Disinherit the priority before adding the task into the new
+				ready list. */
+				traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+				pxTCB->uxPriority = pxTCB->uxBasePriority;
+				if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0 )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority );
+				}
+				prvAddTaskToReadyQueue( pxTCB );
+			}
+		}
 	}
 
-	pxTCB->uxPriority = uxPriority;
-	#if ( configUSE_MUTEXES == 1 )
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	portBASE_TYPE xTaskPriorityDisinheritAfterTimeout( xTaskHandle * const pxMutexHolder, unsigned portBASE_TYPE uxHighestPriorityWaitingTask )
 	{
-		pxTCB->uxBasePriority = uxPriority;
-	}
-	#endif
+	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	unsigned portBASE_TYPE uxPriorityToUse;
+	portBASE_TYPE xReturn = pdFALSE;
 
-	vListInitialiseItem( &( pxTCB->xGenericListItem ) );
-	vListInitialiseItem( &( pxTCB->xEventListItem ) );
+		configASSERT( pxMutexHolder );
 
-	/* Set the pxTCB as a link back from the xListItem.  This is so we can get
-	back to	the containing TCB from a generic item in a list. */
-	listSET_LIST_ITEM_OWNER( &( pxTCB->xGenericListItem ), pxTCB );
+		/* The holder must not drop below the priority of any task still
+		waiting for the mutex. */
+		if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+		{
+			uxPriorityToUse = uxHighestPriorityWaitingTask;
+		}
+		else
+		{
+			uxPriorityToUse = pxTCB->uxBasePriority;
+		}
 
-	/* Event lists are always in priority order. */
-	listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) uxPriority );
-	listSET_LIST_ITEM_OWNER( &( pxTCB->xEventListItem ), pxTCB );
+		/* If the holder holds more than one mutex then it cannot be known
+		which priority was inherited through which mutex, so the priority is
+		left alone until the holder gives its mutexes back. */
+		if( ( pxTCB->uxPriority > uxPriorityToUse ) && ( pxTCB->uxMutexesHeld == ( unsigned portBASE_TYPE ) 1U ) )
+		{
+			traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+			prvSetInheritedPriority( pxTCB, uxPriorityToUse );
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
 
-	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+	void *pvTaskIncrementMutexHeldCount( void )
 	{
-		pxTCB->uxCriticalNesting = ( unsigned portBASE_TYPE ) 0U;
-	}
-	#endif
+		/* Called from within a critical section by the task that has just
+		obtained a mutex. */
+		( pxCurrentTCB->uxMutexesHeld )++;
 
-	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-	{
-		pxTCB->pxTaskTag = NULL;
+		return pxCurrentTCB;
 	}
-	#endif
 
-	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-	{
-		pxTCB->ulRunTimeCounter = 0UL;
-	}
-	#endif
+#endif
+/*-----------------------------------------------------------*/
 
-	#if ( portUSING_MPU_WRAPPERS == 1 )
-	{
-		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
-	}
-	#else
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskSetMutexBlockedOn( void *pvMutex )
 	{
-		( void ) xRegions;
-		( void ) usStackDepth;
+		pxCurrentTCB->pvMutexBlockedOn = pvMutex;
 	}
-	#endif
-}
+
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-	void vTaskAllocateMPURegions( xTaskHandle xTaskToModify, const xMemoryRegion * const xRegions )
+	void *pvTaskGetMutexBlockedOn( xTaskHandle * const pxTask )
 	{
-	tskTCB *pxTCB;
-	
-		if( xTaskToModify == pxCurrentTCB )
+	tskTCB * const pxTCB = ( tskTCB * ) pxTask;
+	void *pvReturn = NULL;
+
+		/* A task that has been unblocked might not have run yet to clear its
+		record of the mutex it was waiting for, so only report the mutex if
+		the task is still in an event list. */
+		if( ( pxTCB->xEventListItem.pvContainer != NULL ) && ( pxTCB->xEventListItem.pvContainer != ( void * ) &xPendingReadyList ) )
 		{
-			xTaskToModify = NULL;
+			pvReturn = pxTCB->pvMutexBlockedOn;
 		}
 
-		/* If null is passed in here then we are deleting ourselves. */
-		pxTCB = prvGetTCBFromHandle( xTaskToModify );
-
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+		return pvReturn;
 	}
-	/*-----------------------------------------------------------*/
+
 #endif
+/*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-unsigned portBASE_TYPE uxPriority;
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
-	for( uxPriority = ( unsigned portBASE_TYPE ) 0U; uxPriority < configMAX_PRIORITIES; uxPriority++ )
+	void vTaskEnterCritical( void )
 	{
-		vListInitialise( ( xList * ) &( pxReadyTasksLists[ uxPriority ] ) );
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			( pxCurrentTCB->uxCriticalNesting )++;
+
+			if( pxCurrentTCB->uxCriticalNesting == 1U )
+			{
+				taskCRITICAL_SECTION_ENTERED();
+			}
+		}
 	}
 
-	vListInitialise( ( xList * ) &xDelayedTaskList1 );
-	vListInitialise( ( xList * ) &xDelayedTaskList2 );
-	vListInitialise( ( xList * ) &xPendingReadyList );
+#endif
+/*-----------------------------------------------------------*/
 
-	#if ( INCLUDE_vTaskDelete == 1 )
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+void vTaskExitCritical( void )
+{
+	if( xSchedulerRunning != pdFALSE )
 	{
-		vListInitialise( ( xList * ) &xTasksWaitingTermination );
+		if( pxCurrentTCB->uxCriticalNesting > 0U )
+		{
+			( pxCurrentTCB->uxCriticalNesting )--;
+
+			if( pxCurrentTCB->uxCriticalNesting == 0U )
+			{
+				taskCRITICAL_SECTION_EXITED();
+				portENABLE_INTERRUPTS();
+			}
+		}
 	}
-	#endif
+}
 
-	#if ( INCLUDE_vTaskSuspend == 1 )
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	void vTaskEnterCritical( void )
 	{
-		vListInitialise( ( xList * ) &xSuspendedTaskList );
+	portBASE_TYPE xCoreID;
+
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			xCoreID = portGET_CORE_ID();
+
+			if( uxCriticalNestings[ xCoreID ] == 0U )
+			{
+				/* The task lock keeps tasks on the other cores out, the ISR
+				lock keeps interrupts on the other cores out.  They are always
+				taken in this order. */
+				portGET_TASK_LOCK();
+				portGET_ISR_LOCK();
+				taskCRITICAL_SECTION_ENTERED();
+			}
+
+			( uxCriticalNestings[ xCoreID ] )++;
+		}
 	}
-	#endif
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+#endif
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
-{
-	#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
+
+	void vTaskExitCritical( void )
 	{
-		portBASE_TYPE xListIsEmpty;
+	portBASE_TYPE xCoreID, xYieldRequired = pdFALSE;
 
-		/* ucTasksDeleted is used to prevent vTaskSuspendAll() being called
-		too often in the idle task. */
-		if( uxTasksDeleted > ( unsigned portBASE_TYPE ) 0U )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			vTaskSuspendAll();
-				xListIsEmpty = listLIST_IS_EMPTY( &xTasksWaitingTermination );
-			xTaskResumeAll();
+			xCoreID = portGET_CORE_ID();
 
-			if( xListIsEmpty == pdFALSE )
+			if( uxCriticalNestings[ xCoreID ] > 0U )
 			{
-				tskTCB *pxTCB;
+				( uxCriticalNestings[ xCoreID ] )--;
 
-				taskENTER_CRITICAL();
+				if( uxCriticalNestings[ xCoreID ] == 0U )
 				{
-					pxTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( ( ( xList * ) &xTasksWaitingTermination ) );
-					vListRemove( &( pxTCB->xGenericListItem ) );
-					--uxCurrentNumberOfTasks;
-					--uxTasksDeleted;
-				}
-				taskEXIT_CRITICAL();
+					/* A yield requested from within the critical section is
+					performed now.  If this core has the scheduler suspended
+					then xTaskResumeAll() performs it instead. */
+					if( ( xYieldPendings[ xCoreID ] != pdFALSE ) && ( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE ) )
+					{
+						xYieldRequired = pdTRUE;
+					}
+
+					taskCRITICAL_SECTION_EXITED();
+					portRELEASE_ISR_LOCK();
+					portRELEASE_TASK_LOCK();
+					portENABLE_INTERRUPTS();
 
-				prvDeleteTCB( pxTCB );
+					if( xYieldRequired != pdFALSE )
+					{
+						portYIELD();
+					}
+				}
 			}
 		}
 	}
-	#endif
-}
+
+#endif
 /*-----------------------------------------------------------*/
 
-static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
-{
-	/* The list item will be inserted in wake time order. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+#if ( configNUMBER_OF_CORES > 1 )
 
-	if( xTimeToWake < xTickCount )
-	{
-		/* Wake time has overflowed.  Place this item in the overflow list. */
-		vListInsert( ( xList * ) pxOverflowDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
-	}
-	else
+	unsigned portBASE_TYPE uxTaskEnterCriticalFromISR( void )
 	{
-		/* The wake time has not overflowed, so we can use the current block list. */
-		vListInsert( ( xList * ) pxDelayedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
 
-		/* If the task entering the blocked state was placed at the head of the
-		list of blocked tasks then xNextTaskUnblockTime needs to be updated
-		too. */
-		if( xTimeToWake < xNextTaskUnblockTime )
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+		if( xSchedulerRunning != pdFALSE )
 		{
-			xNextTaskUnblockTime = xTimeToWake;
+			portGET_ISR_LOCK();
 		}
+
+		return uxSavedInterruptStatus;
 	}
-}
+
+#endif
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
-{
-tskTCB *pxNewTCB;
+#if ( configNUMBER_OF_CORES > 1 )
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	void vTaskExitCriticalFromISR( unsigned portBASE_TYPE uxSavedInterruptStatus )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			portRELEASE_ISR_LOCK();
+		}
 
-	if( pxNewTCB != NULL )
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
+
+	void vTaskCriticalSectionEntered( void )
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t )usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer );
+	portRUN_TIME_COUNTER_TYPE ulTimeNow;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+		#else
+			ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
 
-		if( pxNewTCB->pxStack == NULL )
+		#if ( configNUMBER_OF_CORES == 1 )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
-			pxNewTCB = NULL;
+			ulCriticalSectionEnteredTime = ulTimeNow;
 		}
-		else
+		#else
 		{
-			/* Just to help debugging. */
-			memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			ulCriticalSectionEnteredTime[ portGET_CORE_ID() ] = ulTimeNow;
 		}
+		#endif
 	}
 
-	return pxNewTCB;
-}
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
 
-	static void prvListTaskWithinSingleList( const signed char *pcWriteBuffer, xList *pxList, signed char cStatus )
+	void vTaskCriticalSectionExited( void )
 	{
-	volatile tskTCB *pxNextTCB, *pxFirstTCB;
-	unsigned short usStackRemaining;
-	PRIVILEGED_DATA static char pcStatusString[ 50 ];
+	portRUN_TIME_COUNTER_TYPE ulTimeNow, ulDuration;
 
-		/* Write the details of all the TCB's in pxList into the buffer. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
-		do
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+		#else
+			ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		/* As with the task run times there is no overflow protection other
+		than the unsigned subtraction, so a 32 bit counter must not wrap more
+		than once during a critical section. */
+		#if ( configNUMBER_OF_CORES == 1 )
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
-			#if ( portSTACK_GROWTH > 0 )
-			{
-				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxEndOfStack );
-			}
-			#else
-			{
-				usStackRemaining = usTaskCheckFreeStackSpace( ( unsigned char * ) pxNextTCB->pxStack );
-			}
-			#endif			
-			
-			sprintf( pcStatusString, ( char * ) "%s\t\t%c\t%u\t%u\t%u\r\n", pxNextTCB->pcTaskName, cStatus, ( unsigned int ) pxNextTCB->uxPriority, usStackRemaining, ( unsigned int ) pxNextTCB->uxTCBNumber );
-			strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatusString );
+			ulDuration = ulTimeNow - ulCriticalSectionEnteredTime;
+		}
+		#else
+		{
+			ulDuration = ulTimeNow - ulCriticalSectionEnteredTime[ portGET_CORE_ID() ];
+		}
+		#endif
 
-		} while( pxNextTCB != pxFirstTCB );
+		if( ulDuration > ulMaxCriticalSectionTime )
+		{
+			ulMaxCriticalSectionTime = ulDuration;
+		}
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
 
-	static void prvGenerateRunTimeStatsForTasksInList( const signed char *pcWriteBuffer, xList *pxList, unsigned long ulTotalRunTime )
+	portRUN_TIME_COUNTER_TYPE ulTaskGetMaxCriticalSectionTime( void )
 	{
-	volatile tskTCB *pxNextTCB, *pxFirstTCB;
-	unsigned long ulStatsAsPercentage;
+	portRUN_TIME_COUNTER_TYPE ulReturn;
 
-		/* Write the run time stats of all the TCB's in pxList into the buffer. */
-		listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
-		do
+		/* A 64 bit value cannot be read atomically on all architectures. */
+		taskENTER_CRITICAL();
 		{
-			/* Get next TCB in from the list. */
-			listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+			ulReturn = ulMaxCriticalSectionTime;
+		}
+		taskEXIT_CRITICAL();
 
-			/* Divide by zero check. */
-			if( ulTotalRunTime > 0UL )
-			{
-				/* Has the task run at all? */
-				if( pxNextTCB->ulRunTimeCounter == 0UL )
-				{
-					/* The task has used no CPU time at all. */
-					sprintf( pcStatsString, ( char * ) "%s\t\t0\t\t0%%\r\n", pxNextTCB->pcTaskName );
-				}
-				else
-				{
-					/* What percentage of the total run time has the task used?
-					This will always be rounded down to the nearest integer.
-					ulTotalRunTime has already been divided by 100. */
-					ulStatsAsPercentage = pxNextTCB->ulRunTimeCounter / ulTotalRunTime;
+		return ulReturn;
+	}
 
-					if( ulStatsAsPercentage > 0UL )
-					{
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t%lu%%\r\n", pxNextTCB->pcTaskName, pxNextTCB->ulRunTimeCounter, ulStatsAsPercentage );							
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t%u%%\r\n", pxNextTCB->pcTaskName, ( unsigned int ) pxNextTCB->ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage );
-						}
-						#endif
-					}
-					else
-					{
-						/* If the percentage is zero here then the task has
-						consumed less than 1% of the total run time. */
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcStatsString, ( char * ) "%s\t\t%lu\t\t<1%%\r\n", pxNextTCB->pcTaskName, pxNextTCB->ulRunTimeCounter );							
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcStatsString, ( char * ) "%s\t\t%u\t\t<1%%\r\n", pxNextTCB->pcTaskName, ( unsigned int ) pxNextTCB->ulRunTimeCounter );
-						}
-						#endif
-					}
-				}
+#endif
+/*-----------------------------------------------------------*/
 
-				strcat( ( char * ) pcWriteBuffer, ( char * ) pcStatsString );
-			}
+#if ( configRECORD_CRITICAL_SECTION_TIME == 1 )
 
-		} while( pxNextTCB != pxFirstTCB );
+	void vTaskResetMaxCriticalSectionTime( void )
+	{
+		taskENTER_CRITICAL();
+		{
+			ulMaxCriticalSectionTime = ( portRUN_TIME_COUNTER_TYPE ) 0U;
+		}
+		taskEXIT_CRITICAL();
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( configNUMBER_OF_CORES > 1 )
 
-	static unsigned short usTaskCheckFreeStackSpace( const unsigned char * pucStackByte )
+	void vTaskYieldWithinAPI( void )
 	{
-	register unsigned short usCount = 0U;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+	portBASE_TYPE xYieldNow = pdFALSE;
 
-		while( *pucStackByte == tskSTACK_FILL_BYTE )
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			usCount++;
+			/* A core cannot switch context while it holds the kernel locks, so
+			inside a critical section the yield is held pending until
+			vTaskExitCritical() releases them. */
+			if( uxCriticalNestings[ portGET_CORE_ID() ] == 0U )
+			{
+				xYieldNow = pdTRUE;
+			}
+			else
+			{
+				xMissedYield = pdTRUE;
+			}
 		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-		usCount /= sizeof( portSTACK_TYPE );
-
-		return usCount;
+		if( xYieldNow != pdFALSE )
+		{
+			portYIELD();
+		}
 	}
 
 #endif
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	unsigned portBASE_TYPE uxTaskGetStackHighWaterMark( xTaskHandle xTask )
+	static void prvAddCurrentTaskToNotificationWait( portTickType xTicksToWait )
 	{
-	tskTCB *pxTCB;
-	unsigned char *pcEndOfStack;
-	unsigned portBASE_TYPE uxReturn;
+	portTickCountType xTimeToWake;
 
-		pxTCB = prvGetTCBFromHandle( xTask );
+		/* We must remove ourselves from the ready list before adding
+		ourselves to the blocked list as the same list item is used for both
+		lists. */
+		if( uxListRemove( ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) ) == 0 )
+		{
+			/* The current task must be in a ready list, so there is no need
+			to check, and the port reset macro can be called directly. */
+			portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		}
 
-		#if portSTACK_GROWTH < 0
+		#if ( INCLUDE_vTaskSuspend == 1 )
 		{
-			pcEndOfStack = ( unsigned char * ) pxTCB->pxStack;
+			if( xTicksToWait == portMAX_DELAY )
+			{
+				/* Add the task to the suspended task list instead of a delayed
+				task list to ensure it is not woken by a timing event.  It will
+				block indefinitely. */
+				vListInsertEnd( ( xList * ) &xSuspendedTaskList, ( xListItem * ) &( pxCurrentTCB->xGenericListItem ) );
+			}
+			else
+			{
+				/* Calculate the time at which the task should be woken if no
+				notification is received.  This may overflow but this doesn't
+				matter. */
+				xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+				prvAddCurrentTaskToDelayedList( xTimeToWake );
+			}
 		}
 		#else
 		{
-			pcEndOfStack = ( unsigned char * ) pxTCB->pxEndOfStack;
+			/* Calculate the time at which the task should be woken if no
+			notification is received.  This may overflow but this doesn't
+			matter. */
+			xTimeToWake = taskFULL_TICK_COUNT() + xTicksToWait;
+			prvAddCurrentTaskToDelayedList( xTimeToWake );
 		}
 		#endif
-
-		uxReturn = ( unsigned portBASE_TYPE ) usTaskCheckFreeStackSpace( pcEndOfStack );
-
-		return uxReturn;
 	}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	static void prvDeleteTCB( tskTCB *pxTCB )
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait )
 	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
-
-		/* Free up the memory allocated by the scheduler for the task.  It is up to
-		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
-	}
+	unsigned long ulReturn;
 
-#endif
+		taskENTER_CRITICAL();
+		{
+			/* Only block if the notification count is not already non-zero. */
+			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			{
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = eWaitingNotification;
 
+				if( xTicksToWait > ( portTickType ) 0U )
+				{
+					prvAddCurrentTaskToNotificationWait( xTicksToWait );
+					traceTASK_NOTIFY_TAKE_BLOCK();
 
-/*-----------------------------------------------------------*/
+					/* All ports are written to allow a yield in a critical
+					section (some will yield immediately, others wait until the
+					critical section exits) - but it is not something that
+					application code should ever do. */
+					portYIELD_WITHIN_API();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+		taskENTER_CRITICAL();
+		{
+			traceTASK_NOTIFY_TAKE();
+			ulReturn = pxCurrentTCB->ulNotifiedValue;
 
-	xTaskHandle xTaskGetCurrentTaskHandle( void )
-	{
-	xTaskHandle xReturn;
+			if( ulReturn != 0UL )
+			{
+				if( xClearCountOnExit != pdFALSE )
+				{
+					pxCurrentTCB->ulNotifiedValue = 0UL;
+				}
+				else
+				{
+					( pxCurrentTCB->ulNotifiedValue )--;
+				}
+			}
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+			pxCurrentTCB->ucNotifyState = eNotWaitingNotification;
+		}
+		taskEXIT_CRITICAL();
 
-		return xReturn;
+		return ulReturn;
 	}
 
-#endif
-
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	portBASE_TYPE xTaskGetSchedulerState( void )
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait )
 	{
 	portBASE_TYPE xReturn;
 
-		if( xSchedulerRunning == pdFALSE )
+		taskENTER_CRITICAL();
 		{
-			xReturn = taskSCHEDULER_NOT_STARTED;
+			/* Only block if a notification is not already pending. */
+			if( pxCurrentTCB->ucNotifyState != eNotified )
+			{
+				/* Clear bits in the task's notification value as bits may get
+				set by the notifying task or interrupt.  This can be used to
+				clear the value to zero. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+
+				/* Mark this task as waiting for a notification. */
+				pxCurrentTCB->ucNotifyState = eWaitingNotification;
+
+				if( xTicksToWait > ( portTickType ) 0U )
+				{
+					prvAddCurrentTaskToNotificationWait( xTicksToWait );
+					traceTASK_NOTIFY_WAIT_BLOCK();
+
+					/* See the comment in ulTaskNotifyTake() about yielding
+					within a critical section. */
+					portYIELD_WITHIN_API();
+				}
+			}
 		}
-		else
+		taskEXIT_CRITICAL();
+
+		taskENTER_CRITICAL();
 		{
-			if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+			traceTASK_NOTIFY_WAIT();
+
+			if( pulNotificationValue != NULL )
 			{
-				xReturn = taskSCHEDULER_RUNNING;
+				/* Output the current notification value, which may or may not
+				have changed. */
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+			}
+
+			/* If ucNotifyState is still eWaitingNotification then either the
+			task never entered the blocked state (because a notification was
+			already pending) or the task unblocked because of a timeout. */
+			if( pxCurrentTCB->ucNotifyState == eWaitingNotification )
+			{
+				/* A notification was not received. */
+				xReturn = pdFALSE;
 			}
 			else
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				/* A notification was already pending or a notification was
+				received while the task was waiting. */
+				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				xReturn = pdTRUE;
 			}
+
+			pxCurrentTCB->ucNotifyState = eNotWaitingNotification;
 		}
+		taskEXIT_CRITICAL();
 
 		return xReturn;
 	}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskPriorityInherit( xTaskHandle * const pxMutexHolder )
+	portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue )
 	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	portBASE_TYPE xReturn = pdPASS;
 
-		configASSERT( pxMutexHolder );
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
 
-		if( pxTCB->uxPriority < pxCurrentTCB->uxPriority )
+		taskENTER_CRITICAL();
 		{
-			/* Adjust the mutex holder state to account for its new priority. */
-			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxCurrentTCB->uxPriority );
+			if( pulPreviousNotificationValue != NULL )
+			{
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
 
-			/* If the task being modified is in the ready state it will need to
-			be moved in to a new list. */
-			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xGenericListItem ) ) != pdFALSE )
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = eNotified;
+
+			switch( eAction )
 			{
-				vListRemove( &( pxTCB->xGenericListItem ) );
+				case eSetBits	:
+					pxTCB->ulNotifiedValue |= ulValue;
+					break;
 
-				/* Inherit the priority before being moved into the new list. */
-				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
-				prvAddTaskToReadyQueue( pxTCB );
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != eNotified )
+					{
+						pxTCB->ulNotifiedValue = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction:
+				default:
+					/* The task is being notified without its notify value being
+					updated. */
+					break;
 			}
-			else
+
+			traceTASK_NOTIFY();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == eWaitingNotification )
 			{
-				/* Just inherit the priority. */
-				pxTCB->uxPriority = pxCurrentTCB->uxPriority;
-			}
+				/* The task should not have been on an event list. */
+				configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) );
 
-			traceTASK_PRIORITY_INHERIT( pxTCB, pxCurrentTCB->uxPriority );
+				( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+				prvAddTaskToReadyQueue( pxTCB );
+
+				if( taskYIELD_REQUIRED_FOR_HIGHER( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					portYIELD_WITHIN_API();
+				}
+			}
 		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
 	}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskPriorityDisinherit( xTaskHandle * const pxMutexHolder )
+	portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, unsigned long *pulPreviousNotificationValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
 	{
-	tskTCB * const pxTCB = ( tskTCB * ) pxMutexHolder;
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	portBASE_TYPE xReturn = pdPASS;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
 
-		if( pxMutexHolder != NULL )
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
-			if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+			if( pulPreviousNotificationValue != NULL )
 			{
-				/* We must be the running task to be able to give the mutex back.
-				Remove ourselves from the ready list we currently appear in. */
-				vListRemove( &( pxTCB->xGenericListItem ) );
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+			}
 
-				/* Disinherit the priority before adding the task into the new
-				ready list. */
-				traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-				pxTCB->uxPriority = pxTCB->uxBasePriority;
-				listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), configMAX_PRIORITIES - ( portTickType ) pxTCB->uxPriority );
-				prvAddTaskToReadyQueue( pxTCB );
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = eNotified;
+
+			switch( eAction )
+			{
+				case eSetBits	:
+					pxTCB->ulNotifiedValue |= ulValue;
+					break;
+
+				case eIncrement	:
+					( pxTCB->ulNotifiedValue )++;
+					break;
+
+				case eSetValueWithOverwrite	:
+					pxTCB->ulNotifiedValue = ulValue;
+					break;
+
+				case eSetValueWithoutOverwrite :
+					if( ucOriginalNotifyState != eNotified )
+					{
+						pxTCB->ulNotifiedValue = ulValue;
+					}
+					else
+					{
+						/* The value could not be written to the task. */
+						xReturn = pdFAIL;
+					}
+					break;
+
+				case eNoAction:
+				default:
+					/* The task is being notified without its notify value being
+					updated. */
+					break;
+			}
+
+			traceTASK_NOTIFY_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == eWaitingNotification )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) );
+
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyQueue( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					taskRECORD_WAKE_TIME( pxTCB );
+					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( taskYIELD_REQUIRED_FOR_HIGHER( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
 			}
 		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
 	}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskEnterCritical( void )
+	void vTaskNotifyGiveFromISR( xTaskHandle xTaskToNotify, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
 	{
-		portDISABLE_INTERRUPTS();
+	tskTCB *pxTCB;
+	unsigned char ucOriginalNotifyState;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
 
-		if( xSchedulerRunning != pdFALSE )
+		configASSERT( xTaskToNotify );
+		pxTCB = ( tskTCB * ) xTaskToNotify;
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
-			( pxCurrentTCB->uxCriticalNesting )++;
+			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			pxTCB->ucNotifyState = eNotified;
+
+			/* 'Giving' is equivalent to incrementing a count in a counting
+			semaphore. */
+			( pxTCB->ulNotifiedValue )++;
+
+			traceTASK_NOTIFY_GIVE_FROM_ISR();
+
+			/* If the task is in the blocked state specifically to wait for a
+			notification then unblock it now. */
+			if( ucOriginalNotifyState == eWaitingNotification )
+			{
+				/* The task should not have been on an event list. */
+				configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) );
+
+				if( uxSchedulerSuspended == ( unsigned portBASE_TYPE ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+					prvAddTaskToReadyQueue( pxTCB );
+				}
+				else
+				{
+					/* The delayed and ready lists cannot be accessed, so hold
+					this task pending until the scheduler is resumed. */
+					taskRECORD_WAKE_TIME( pxTCB );
+					vListInsertEnd( ( xList * ) &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+
+				if( taskYIELD_REQUIRED_FOR_HIGHER( pxTCB ) != pdFALSE )
+				{
+					/* The notified task has a priority above the currently
+					executing task so a yield is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+				}
+			}
 		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-void vTaskExitCritical( void )
-{
-	if( xSchedulerRunning != pdFALSE )
+	portBASE_TYPE xTaskNotifyStateClear( xTaskHandle xTask )
 	{
-		if( pxCurrentTCB->uxCriticalNesting > 0U )
-		{
-			( pxCurrentTCB->uxCriticalNesting )--;
+	tskTCB *pxTCB;
+	portBASE_TYPE xReturn;
 
-			if( pxCurrentTCB->uxCriticalNesting == 0U )
+		/* If null is passed in here then it is the calling task that is
+		having its notification state cleared. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxTCB->ucNotifyState == eNotified )
 			{
-				portENABLE_INTERRUPTS();
+				pxTCB->ucNotifyState = eNotWaitingNotification;
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
 			}
 		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
 	}
-}
 
-#endif
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
 
-
-
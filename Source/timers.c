@@ -61,6 +61,10 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_NAME_REGISTRY == 1 )
+	#include "name_registry.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
 /* This entire source file will be skipped if the application is not configured
@@ -81,29 +85,166 @@ typedef struct tmrTimerControl
 	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
 	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
 	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+		struct tmrTimerControl	*pxNextPending;		/*<< The next timer in the list of timers with a pending command. */
+		portTickType		xPendingValue;		/*<< The value sent with the pending command. */
+		portTickType		xPendingPeriod;		/*<< The period set by a pending tmrCOMMAND_CHANGE_PERIOD command, valid if ucPendingPeriod is pdTRUE. */
+		portBASE_TYPE		xPendingCommand;	/*<< The last command sent to the timer that the timer service task has not yet processed, or tmrNO_PENDING_COMMAND. */
+		unsigned char		ucPendingPeriod;	/*<< Set to pdTRUE if a period change is pending, even if a later command has replaced it as the pending command. */
+	#endif
+	#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+		struct tmrTimerControl	*pxNextTick;		/*<< The next timer in the list of active tick timers. */
+		portTickType		xTicksAfterPrevious;/*<< The number of ticks between the expiry of the previous timer in the list of active tick timers, or now, and the expiry of this timer. */
+		unsigned char		ucRunInTick;		/*<< Set to pdTRUE if the callback runs in the tick interrupt rather than in the timer service task. */
+		unsigned char		ucInTickList;		/*<< Set to pdTRUE if the timer is in the list of active tick timers. */
+	#endif
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		unsigned char		ucStaticallyAllocated;	/*<< Set to pdTRUE if the timer structure was supplied by the application, so must not be freed when the timer is deleted. */
+	#endif
 } xTIMER;
 
 /* The definition of messages that can be sent and received on the timer
-queue. */
-typedef struct tmrTimerQueueMessage
+queue.  Two types of message can be queued - messages that manipulate a
+software timer, and messages that request the execution of a non-timer related
+callback.  The two message types are defined in two separate structures,
+xTIMER_PARAMETERS and xCALLBACK_PARAMETERS respectively. */
+typedef struct tmrTimerParameters
 {
-	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
 	portTickType			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
 	xTIMER *				pxTimer;			/*<< The timer to which the command will be applied. */
+} xTIMER_PARAMETERS;
+
+typedef struct tmrCallbackParameters
+{
+	tmrPENDED_FUNCTION		pxCallbackFunction;	/*<< The callback function to execute. */
+	void					*pvParameter1;		/*<< The value that will be used as the callback functions first parameter. */
+	unsigned long			ulParameter2;		/*<< The value that will be used as the callback functions second parameter. */
+} xCALLBACK_PARAMETERS;
+
+/* The structure that contains the two message types, along with an identifier
+that is used to determine which message type is valid.  Negative message IDs
+are callback requests, non-negative IDs are timer commands. */
+typedef struct tmrTimerQueueMessage
+{
+	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
+	union
+	{
+		xTIMER_PARAMETERS xTimerParameters;
+
+		/* Don't include xCallbackParameters if it is not going to be used as
+		it makes the structure (and therefore the timer queue) larger. */
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+			xCALLBACK_PARAMETERS xCallbackParameters;
+		#endif
+	} u;
 } xTIMER_MESSAGE;
 
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access xActiveTimerList. */
-PRIVILEGED_DATA static xList xActiveTimerList1;
-PRIVILEGED_DATA static xList xActiveTimerList2;
-PRIVILEGED_DATA static xList *pxCurrentTimerList;
-PRIVILEGED_DATA static xList *pxOverflowTimerList;
+#if ( configTIMER_WHEEL_SLOTS > 0 )
+
+	/* When configTIMER_WHEEL_SLOTS is not 0 active timers are stored in a
+	timer wheel - an array of unsorted lists, where a timer is held in the
+	list selected by the low bits of its expiry time.  Starting a timer is then
+	a constant time operation no matter how many timers are active.
+	xTimerWheelTime is the time up to which expired timers have been
+	processed.  Every timer in the wheel expires after xTimerWheelTime, and
+	expiry times are only ever compared relative to it, so tick count
+	overflows need no special handling.  Only the timer service task is allowed
+	to access the wheel. */
+	PRIVILEGED_DATA static xList xTimerWheel[ configTIMER_WHEEL_SLOTS ];
+	PRIVILEGED_DATA static portTickType xTimerWheelTime = ( portTickType ) 0U;
+
+	#define tmrWHEEL_SLOT( xTime )	( &( xTimerWheel[ ( xTime ) & ( portTickType ) ( configTIMER_WHEEL_SLOTS - 1 ) ] ) )
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+
+	#if ( configUSE_64_BIT_TICKS == 0 )
+
+		/* Timers that expire after the tick count next overflows. */
+		PRIVILEGED_DATA static xList xActiveTimerList2;
+		PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+	#endif
+
+#endif
+
+#if ( configUSE_64_BIT_TICKS == 1 )
+
+	/* The timer service task works with the 64 bit tick count, so expiry
+	times do not wrap and a single list of active timers is used.  Command
+	times are sent as portTickType values.  A command is never processed before
+	it was sent, so its time is extended to 64 bits relative to the time at
+	which it is processed. */
+	#define tmrCOMMAND_TIME( xCommandTime, xTimeNow )	( ( xTimeNow ) - ( portTickType ) ( ( portTickType ) ( xTimeNow ) - ( xCommandTime ) ) )
+
+#else
+
+	#define tmrCOMMAND_TIME( xCommandTime, xTimeNow )	( xCommandTime )
+
+#endif
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
 
+#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	/* When configUSE_TIMER_COMMAND_COALESCING is 1 a timer command is not
+	sent on xTimerQueue.  Instead it is written into the timer it is for,
+	replacing any command the timer service task has not yet processed, and
+	the timer is pushed onto a list of timers with pending commands unless it
+	is already in it.  A message is only sent on xTimerQueue when the list was
+	empty, to wake the timer service task.  Sending a command therefore takes
+	constant time, never blocks and never fails because the queue is full, and
+	a timer that is reset many times before the timer service task runs is
+	only removed from and inserted into the active timers once.  The list is
+	accessed from within critical sections as commands can be sent from
+	interrupts.
+
+	Applying only the last command gives the same result as processing each
+	in turn, provided a period change is not lost when a later command
+	replaces it - so that is recorded separately.  A pending delete is never
+	replaced, as the timer must not be used once it has been deleted. */
+	PRIVILEGED_DATA static xTIMER * volatile pxPendingTimers = NULL;
+
+	#define tmrNO_PENDING_COMMAND			( ( portBASE_TYPE ) -1 )
+
+	/* Sent on xTimerQueue, with a NULL timer, to wake the timer service task
+	when a command is pended.  Applications never send it, so it is not
+	defined in timers.h. */
+	#define tmrCOMMAND_PROCESS_PENDING		( ( portBASE_TYPE ) 4 )
+
+#endif
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	/* Timers whose callbacks run in the tick interrupt are never seen by the
+	timer service task.  Commands to them are applied by the caller, and the
+	active ones are held in a delta list in expiry order - each timer records
+	the number of ticks between the expiry of the timer in front of it and
+	its own - so a tick only ever has to look at the timer at the front of the
+	list, and tick count overflows need no special handling.  Starting a
+	timer takes time proportional to the number of active tick timers, which
+	is expected to be small.  The list is accessed from within critical
+	sections. */
+	PRIVILEGED_DATA static xTIMER *pxTickTimers = NULL;
+
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* When static allocation is supported the timer command queue is always
+	created statically, so the timer service does not need a heap. */
+	PRIVILEGED_DATA static xStaticQueue xStaticTimerQueue;
+	PRIVILEGED_DATA static unsigned char ucStaticTimerQueueStorage[ configTIMER_QUEUE_LENGTH * sizeof( xTIMER_MESSAGE ) ];
+
+#endif
+
 #if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 	
 	PRIVILEGED_DATA static xTaskHandle xTimerTaskHandle = NULL;
@@ -131,29 +272,81 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
  */
 static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Apply a single command to a timer, which can be NULL if the command is to
+ * the task rather than to a timer.
+ */
+static void prvProcessCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xCommandValue ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	/*
+	 * Record a command in the timer it is for, and wake the timer service task
+	 * if no other timer has a command pending.
+	 */
+	static portBASE_TYPE prvPendCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the timer service task to apply the pending command of every
+	 * timer in the list of timers with pending commands.
+	 */
+	static void prvProcessPendingCommands( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	/*
+	 * Apply a command to a timer whose callback runs in the tick interrupt.
+	 */
+	static portBASE_TYPE prvTickTimerCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Insert a timer into the list of active tick timers to expire xTicks
+	 * ticks from now, or remove it from the list if it is in it.  Must be
+	 * called from a critical section.
+	 */
+	static void prvInsertTickTimer( xTIMER *pxTimer, portTickType xTicks ) PRIVILEGED_FUNCTION;
+	static void prvRemoveTickTimer( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow - or into
+ * the timer wheel slot for its expire time if configTIMER_WHEEL_SLOTS is not
+ * 0, in which case expired timers must already have been processed up to
+ * xTimeNow.
  */
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickCountType xNextExpiryTime, portTickCountType xTimeNow, portTickCountType xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * Process every active timer that has reached its expire time by xTimeNow in
+ * a single pass, in expire time order.  Each timer is reloaded if it is an
+ * auto reload timer before its callback is called.
  */
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimers( portTickCountType xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * An active timer that has reached its expire time has been removed from the
+ * list of active timers.  Reload the timer if it is an auto reload timer, then
+ * call its callback.
  */
-static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimer( xTIMER *pxTimer, portTickCountType xExpireTime, portTickCountType xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if ( configTIMER_WHEEL_SLOTS == 0 ) && ( configUSE_64_BIT_TICKS == 0 )
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
  */
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+static portTickCountType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
 /*
  * If the timer list contains any active timers then return the expire time of
@@ -161,13 +354,19 @@ static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
  * to pdTRUE.
  */
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
+static portTickCountType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvProcessTimerOrBlockTask( portTickCountType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xTimerCreate() and xTimerCreateStatic() once the memory for the
+ * timer structure has been obtained.
+ */
+static void prvInitialiseNewTimer( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xTIMER *pxNewTimer ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------*/
 
@@ -183,7 +382,27 @@ portBASE_TYPE xReturn = pdFAIL;
 
 	if( xTimerQueue != NULL )
 	{
-		#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTask *pxTimerTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxTimerTaskStackBuffer = NULL;
+		unsigned short usTimerTaskStackSize = ( unsigned short ) configTIMER_TASK_STACK_DEPTH;
+		xTaskHandle *pxTimerTaskHandle = NULL;
+
+			#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+			{
+				/* Store the handle in xTimerTaskHandle so it can be returned by
+				the xTimerGetTimerDaemonTaskHandle() function. */
+				pxTimerTaskHandle = &xTimerTaskHandle;
+			}
+			#endif
+
+			/* The timer task is created using memory supplied by the
+			application, so the scheduler can be started without a heap. */
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &usTimerTaskStackSize );
+			xReturn = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY, pxTimerTaskHandle, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+		}
+		#elif ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
 		{
 			/* Create the timer task, storing its handle in xTimerTaskHandle so
 			it can be returned by the xTimerGetTimerDaemonTaskHandle() function. */
@@ -202,75 +421,196 @@ portBASE_TYPE xReturn = pdFAIL;
 }
 /*-----------------------------------------------------------*/
 
-xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
-{
-xTIMER *pxNewTimer;
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	/* Allocate the timer structure. */
-	if( xTimerPeriodInTicks == ( portTickType ) 0U )
+	xTimerHandle xTimerCreate( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
 	{
-		pxNewTimer = NULL;
-		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+	xTIMER *pxNewTimer;
+
+		/* Allocate the timer structure. */
+		if( xTimerPeriodInTicks == ( portTickType ) 0U )
+		{
+			pxNewTimer = NULL;
+			configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		}
+		else
+		{
+			pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
+			if( pxNewTimer != NULL )
+			{
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					/* The memory must be freed if the timer is deleted. */
+					pxNewTimer->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif
+
+				prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+			}
+			else
+			{
+				traceTIMER_CREATE_FAILED();
+			}
+		}
+
+		return ( xTimerHandle ) pxNewTimer;
 	}
-	else
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreateStatic( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer )
 	{
-		pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
-		if( pxNewTimer != NULL )
+	xTIMER *pxNewTimer = NULL;
+
+		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		configASSERT( pxTimerBuffer );
+
+		/* The xStaticTimer structure must be the same size as the timer
+		structure it is used in place of. */
+		configASSERT( sizeof( xStaticTimer ) == sizeof( xTIMER ) );
+
+		if( ( xTimerPeriodInTicks != ( portTickType ) 0U ) && ( pxTimerBuffer != NULL ) )
 		{
-			/* Ensure the infrastructure used by the timer service task has been
-			created/initialised. */
-			prvCheckForValidListAndQueue();
-	
-			/* Initialise the timer structure members using the function parameters. */
-			pxNewTimer->pcTimerName = pcTimerName;
-			pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
-			pxNewTimer->uxAutoReload = uxAutoReload;
-			pxNewTimer->pvTimerID = pvTimerID;
-			pxNewTimer->pxCallbackFunction = pxCallbackFunction;
-			vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
-			
-			traceTIMER_CREATE( pxNewTimer );
+			pxNewTimer = ( xTIMER * ) pxTimerBuffer;
+
+			/* The memory was supplied by the application so must not be
+			freed if the timer is deleted. */
+			pxNewTimer->ucStaticallyAllocated = pdTRUE;
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
 		}
 		else
 		{
 			traceTIMER_CREATE_FAILED();
 		}
+
+		return ( xTimerHandle ) pxNewTimer;
 	}
-	
-	return ( xTimerHandle ) pxNewTimer;
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer( const signed char *pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xTIMER *pxNewTimer )
+{
+	/* Ensure the infrastructure used by the timer service task has been
+	created/initialised. */
+	prvCheckForValidListAndQueue();
+
+	/* Initialise the timer structure members using the function parameters. */
+	pxNewTimer->pcTimerName = pcTimerName;
+	pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+	pxNewTimer->uxAutoReload = uxAutoReload;
+	pxNewTimer->pvTimerID = pvTimerID;
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	{
+		pxNewTimer->pxNextPending = NULL;
+		pxNewTimer->xPendingValue = ( portTickType ) 0U;
+		pxNewTimer->xPendingPeriod = ( portTickType ) 0U;
+		pxNewTimer->xPendingCommand = tmrNO_PENDING_COMMAND;
+		pxNewTimer->ucPendingPeriod = pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+	{
+		pxNewTimer->pxNextTick = NULL;
+		pxNewTimer->xTicksAfterPrevious = ( portTickType ) 0U;
+		pxNewTimer->ucRunInTick = pdFALSE;
+		pxNewTimer->ucInTickList = pdFALSE;
+	}
+	#endif
+
+	#if ( configUSE_NAME_REGISTRY == 1 )
+	{
+		if( pcTimerName != NULL )
+		{
+			( void ) xNameRegistryAdd( pcTimerName, ( void * ) pxNewTimer, nameregTYPE_TIMER );
+		}
+	}
+	#endif
+
+	traceTIMER_CREATE( pxNewTimer );
 }
 /*-----------------------------------------------------------*/
 
 portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime )
 {
 portBASE_TYPE xReturn = pdFAIL;
-xTIMER_MESSAGE xMessage;
 
 	/* Send a message to the timer service task to perform a particular action
 	on a particular timer definition. */
 	if( xTimerQueue != NULL )
 	{
-		/* Send a command to the timer service task to start the xTimer timer. */
-		xMessage.xMessageID = xCommandID;
-		xMessage.xMessageValue = xOptionalValue;
-		xMessage.pxTimer = ( xTIMER * ) xTimer;
+		/* A timer that is being deleted can no longer be found by name.  Timers
+		can only be deleted from a task, as the registry cannot be updated from
+		an interrupt. */
+		#if ( configUSE_NAME_REGISTRY == 1 )
+		{
+			if( ( xCommandID == tmrCOMMAND_DELETE ) && ( pxHigherPriorityTaskWoken == NULL ) )
+			{
+				vNameRegistryRemove( ( ( xTIMER * ) xTimer )->pcTimerName, ( void * ) xTimer );
+			}
+		}
+		#endif
 
-		if( pxHigherPriorityTaskWoken == NULL )
+		#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+		if( ( ( xTIMER * ) xTimer )->ucRunInTick != pdFALSE )
+		{
+			/* The timer service task is not involved. */
+			( void ) xBlockTime;
+			xReturn = prvTickTimerCommand( ( xTIMER * ) xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken );
+		}
+		else
+		#endif /* configUSE_TIMER_TICK_CALLBACKS */
+
+		#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			/* The command is recorded in the timer, so never blocks. */
+			( void ) xBlockTime;
+			xReturn = prvPendCommand( ( xTIMER * ) xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken );
+		}
+		#else
+		{
+		xTIMER_MESSAGE xMessage;
+
+			/* Send a command to the timer service task to start the xTimer timer. */
+			xMessage.xMessageID = xCommandID;
+			xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+			xMessage.u.xTimerParameters.pxTimer = ( xTIMER * ) xTimer;
+
+			if( pxHigherPriorityTaskWoken == NULL )
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xBlockTime );
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xBlockTime );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
 			}
 			else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 			}
 		}
-		else
+		#endif
+
+		#if ( configUSE_NAME_REGISTRY == 1 )
 		{
-			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			/* The timer still exists if the delete command was not sent. */
+			if( ( xCommandID == tmrCOMMAND_DELETE ) && ( pxHigherPriorityTaskWoken == NULL ) && ( xReturn == pdFAIL ) && ( ( ( xTIMER * ) xTimer )->pcTimerName != NULL ) )
+			{
+				( void ) xNameRegistryAdd( ( ( xTIMER * ) xTimer )->pcTimerName, ( void * ) xTimer, nameregTYPE_TIMER );
+			}
 		}
-		
+		#endif
+
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
 	
@@ -291,15 +631,8 @@ xTIMER_MESSAGE xMessage;
 #endif
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+static void prvProcessExpiredTimer( xTIMER *pxTimer, portTickCountType xExpireTime, portTickCountType xTimeNow )
 {
-xTIMER *pxTimer;
-portBASE_TYPE xResult;
-
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-	vListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
 	/* If the timer is an auto reload timer then calculate the next
@@ -312,13 +645,14 @@ portBASE_TYPE xResult;
 		the time this task thinks it is now, even if a command to
 		switch lists due to a tick count overflow is already waiting in
 		the timer queue. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+		while( prvInsertTimerInActiveList( pxTimer, ( xExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpireTime ) == pdTRUE )
 		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
+			/* The next expiry time has passed too, as this task has fallen
+			more than a period behind.  Process that expiry here rather than
+			by posting a command to this task, which could not be sent if
+			the timer queue were full. */
+			xExpireTime += pxTimer->xTimerPeriodInTicks;
+			pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
 		}
 	}
 
@@ -327,9 +661,126 @@ portBASE_TYPE xResult;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configTIMER_WHEEL_SLOTS == 0 )
+
+	static void prvProcessExpiredTimers( portTickCountType xTimeNow )
+	{
+	xTIMER *pxTimer;
+	portTickCountType xExpireTime;
+
+		/* Every timer at the front of the current list that has an expire
+		time that is not later than xTimeNow has expired.  An auto reload
+		timer is always re-inserted with a later expire time (or into the
+		overflow list, or not at all when its period has already elapsed
+		again), so the loop ends once all the timers that expired by xTimeNow
+		have been processed - without first returning to the timer task to
+		sample the time and check the command queue for each one. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+			if( xExpireTime > xTimeNow )
+			{
+				break;
+			}
+
+			/* Remove the timer from the list of active timers. */
+			pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+			prvProcessExpiredTimer( pxTimer, xExpireTime, xTimeNow );
+		}
+	}
+
+#else /* configTIMER_WHEEL_SLOTS */
+
+	static void prvProcessExpiredTimers( portTickCountType xTimeNow )
+	{
+	xList xExpiredTimers;
+	xList *pxSlot;
+	xListItem *pxItem, *pxNextItem;
+	xTIMER *pxTimer;
+	portTickType xElapsed, xSlotsToCheck, xTick, xOffset, xPreviousTime;
+
+		xElapsed = ( portTickType ) ( xTimeNow - xTimerWheelTime );
+
+		if( xElapsed != ( portTickType ) 0U )
+		{
+			vListInitialise( &xExpiredTimers );
+
+			/* Timers that expire in the xElapsed ticks after xTimerWheelTime
+			can only be in the slots for those ticks, so no more than every
+			slot need be checked. */
+			if( xElapsed < ( portTickType ) configTIMER_WHEEL_SLOTS )
+			{
+				xSlotsToCheck = xElapsed;
+			}
+			else
+			{
+				xSlotsToCheck = ( portTickType ) configTIMER_WHEEL_SLOTS;
+			}
+
+			/* Move every timer that has expired onto xExpiredTimers, with its
+			list item value set to its expire time relative to
+			xTimerWheelTime.  Slots hold timers that expire on later turns of
+			the wheel too, so each timer in a slot is tested. */
+			for( xTick = ( portTickType ) 1U; xTick <= xSlotsToCheck; xTick++ )
+			{
+				pxSlot = tmrWHEEL_SLOT( xTimerWheelTime + xTick );
+				pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+
+				while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+				{
+					pxNextItem = ( xListItem * ) pxItem->pxNext;
+					xOffset = ( portTickType ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xTimerWheelTime );
+
+					/* xOffset is never 0, so the subtraction makes this a
+					single test for 1 <= xOffset <= xElapsed. */
+					if( ( portTickType ) ( xOffset - ( portTickType ) 1U ) < xElapsed )
+					{
+						( void ) uxListRemove( pxItem );
+						listSET_LIST_ITEM_VALUE( pxItem, xOffset );
+
+						if( xElapsed <= ( portTickType ) configTIMER_WHEEL_SLOTS )
+						{
+							/* Each slot only holds timers that expired on
+							its own tick, and the slots are checked in tick
+							order, so the list remains sorted without
+							searching it. */
+							vListInsertEnd( &xExpiredTimers, pxItem );
+						}
+						else
+						{
+							vListInsert( &xExpiredTimers, pxItem );
+						}
+					}
+
+					pxItem = pxNextItem;
+				}
+			}
+
+			/* The wheel is now up to date, so auto reload timers can be
+			re-inserted into it. */
+			xPreviousTime = xTimerWheelTime;
+			xTimerWheelTime = xTimeNow;
+
+			while( listLIST_IS_EMPTY( &xExpiredTimers ) == pdFALSE )
+			{
+				pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimers );
+				xOffset = listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xExpiredTimers );
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+				prvProcessExpiredTimer( pxTimer, ( portTickType ) ( xPreviousTime + xOffset ), xTimeNow );
+			}
+		}
+	}
+
+#endif /* configTIMER_WHEEL_SLOTS */
+/*-----------------------------------------------------------*/
+
 static void prvTimerTask( void *pvParameters )
 {
-portTickType xNextExpireTime;
+portTickCountType xNextExpireTime;
 portBASE_TYPE xListWasEmpty;
 
 	/* Just to avoid compiler warnings. */
@@ -351,10 +802,11 @@ portBASE_TYPE xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
+static void prvProcessTimerOrBlockTask( portTickCountType xNextExpireTime, portBASE_TYPE xListWasEmpty )
 {
-portTickType xTimeNow;
-portBASE_TYPE xTimerListsWereSwitched;
+portTickCountType xTimeNow;
+portTickType xTicksToWait;
+portBASE_TYPE xTimerListsWereSwitched, xTimerHasExpired;
 
 	vTaskSuspendAll();
 	{
@@ -367,10 +819,51 @@ portBASE_TYPE xTimerListsWereSwitched;
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#if ( configTIMER_WHEEL_SLOTS == 0 )
+			{
+				xTimerHasExpired = ( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) );
+
+				#if ( configUSE_64_BIT_TICKS == 1 )
+				{
+					/* There is no list switch to wake for when the list is
+					empty. */
+					if( xListWasEmpty == pdFALSE )
+					{
+						xTicksToWait = ( portTickType ) ( xNextExpireTime - xTimeNow );
+					}
+					else
+					{
+						xTicksToWait = portMAX_DELAY;
+					}
+				}
+				#else
+				{
+					xTicksToWait = xNextExpireTime - xTimeNow;
+				}
+				#endif
+			}
+			#else
+			{
+				/* Times in the wheel are compared relative to the time up to
+				which the wheel has been processed.  There is no list switch
+				to wake for when the wheel is empty. */
+				xTimerHasExpired = ( ( xListWasEmpty == pdFALSE ) && ( ( portTickType ) ( xNextExpireTime - xTimerWheelTime ) <= ( portTickType ) ( xTimeNow - xTimerWheelTime ) ) );
+
+				if( xListWasEmpty == pdFALSE )
+				{
+					xTicksToWait = xNextExpireTime - xTimeNow;
+				}
+				else
+				{
+					xTicksToWait = portMAX_DELAY;
+				}
+			}
+			#endif
+
+			if( xTimerHasExpired != pdFALSE )
 			{
 				xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimers( xTimeNow );
 			}
 			else
 			{
@@ -380,7 +873,7 @@ portBASE_TYPE xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+				vQueueWaitForMessageRestricted( xTimerQueue, xTicksToWait );
 
 				if( xTaskResumeAll() == pdFALSE )
 				{
@@ -400,9 +893,11 @@ portBASE_TYPE xTimerListsWereSwitched;
 }
 /*-----------------------------------------------------------*/
 
-static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+#if ( configTIMER_WHEEL_SLOTS == 0 )
+
+static portTickCountType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
 {
-portTickType xNextExpireTime;
+portTickCountType xNextExpireTime;
 
 	/* Timers are listed in expiry time order, with the head of the list
 	referencing the task that will expire first.  Obtain the time at which
@@ -424,9 +919,55 @@ portTickType xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#else /* configTIMER_WHEEL_SLOTS */
+
+static portTickCountType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+{
+xList *pxSlot;
+xListItem *pxItem;
+portTickType xTick, xOffset, xNearestOffset = portMAX_DELAY;
+
+	*pxListWasEmpty = pdTRUE;
+
+	/* Check the slots in the order their ticks come round.  A timer found in
+	the slot for the tick xTick after xTimerWheelTime that expires on this turn
+	of the wheel cannot be beaten by a timer in a later slot, so the search can
+	stop.  Otherwise the nearest timer due on a later turn is remembered.
+	Timers in the same slot are unsorted, so each is tested. */
+	for( xTick = ( portTickType ) 1U; xTick <= ( portTickType ) configTIMER_WHEEL_SLOTS; xTick++ )
+	{
+		pxSlot = tmrWHEEL_SLOT( xTimerWheelTime + xTick );
+		pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+
+		while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+		{
+			xOffset = ( portTickType ) ( listGET_LIST_ITEM_VALUE( pxItem ) - xTimerWheelTime );
+
+			if( ( *pxListWasEmpty != pdFALSE ) || ( xOffset < xNearestOffset ) )
+			{
+				xNearestOffset = xOffset;
+				*pxListWasEmpty = pdFALSE;
+			}
+
+			pxItem = ( xListItem * ) pxItem->pxNext;
+		}
+
+		if( ( *pxListWasEmpty == pdFALSE ) && ( xNearestOffset <= xTick ) )
+		{
+			break;
+		}
+	}
+
+	return ( portTickCountType ) ( xTimerWheelTime + xNearestOffset );
+}
+
+#endif /* configTIMER_WHEEL_SLOTS */
 /*-----------------------------------------------------------*/
 
-static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+#if ( configTIMER_WHEEL_SLOTS == 0 ) && ( configUSE_64_BIT_TICKS == 0 )
+
+static portTickCountType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
 {
 portTickType xTimeNow;
 static portTickType xLastTime = ( portTickType ) 0U;
@@ -447,15 +988,55 @@ static portTickType xLastTime = ( portTickType ) 0U;
 	
 	return xTimeNow;
 }
+
+#else /* configTIMER_WHEEL_SLOTS, configUSE_64_BIT_TICKS */
+
+static portTickCountType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+{
+	/* Neither the timer wheel nor the single list used with a 64 bit tick
+	count needs anything done when the tick count overflows. */
+	*pxTimerListsWereSwitched = pdFALSE;
+
+	#if ( configUSE_64_BIT_TICKS == 1 )
+	{
+		return xTaskGetTickCount64();
+	}
+	#else
+	{
+		return xTaskGetTickCount();
+	}
+	#endif
+}
+
+#endif /* configTIMER_WHEEL_SLOTS, configUSE_64_BIT_TICKS */
 /*-----------------------------------------------------------*/
 
-static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
+#if ( configTIMER_WHEEL_SLOTS == 0 )
+
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickCountType xNextExpiryTime, portTickCountType xTimeNow, portTickCountType xCommandTime )
 {
 portBASE_TYPE xProcessTimerNow = pdFALSE;
 
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 	
+	#if ( configUSE_64_BIT_TICKS == 1 )
+	{
+		/* The expiry time cannot have wrapped, so it has only passed if the
+		time between the command being issued and being processed exceeds the
+		timer's period. */
+		if( xNextExpiryTime <= xTimeNow )
+		{
+			xProcessTimerNow = pdTRUE;
+		}
+		else
+		{
+			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+		}
+
+		( void ) xCommandTime;
+	}
+	#else
 	if( xNextExpiryTime <= xTimeNow )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
@@ -485,84 +1066,319 @@ portBASE_TYPE xProcessTimerNow = pdFALSE;
 			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 		}
 	}
+	#endif /* configUSE_64_BIT_TICKS */
 
 	return xProcessTimerNow;
 }
-/*-----------------------------------------------------------*/
 
-static void	prvProcessReceivedCommands( void )
+#else /* configTIMER_WHEEL_SLOTS */
+
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickCountType xNextExpiryTime, portTickCountType xTimeNow, portTickCountType xCommandTime )
 {
-xTIMER_MESSAGE xMessage;
-xTIMER *pxTimer;
-portBASE_TYPE xTimerListsWereSwitched, xResult;
-portTickType xTimeNow;
+portBASE_TYPE xProcessTimerNow = pdFALSE;
 
-	/* In this case the xTimerListsWereSwitched parameter is not used, but it
-	must be present in the function call. */
-	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+	/* The wheel has been processed up to xTimeNow, so the expiry time has
+	either passed because the time between the command being issued and being
+	processed exceeds the timer's period, or is after xTimeNow and therefore
+	after xTimerWheelTime.  The subtraction gives the right answer even if the
+	tick count has overflowed since the command was issued. */
+	if( ( ( portTickType ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks )
 	{
-		pxTimer = xMessage.pxTimer;
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		vListInsertEnd( tmrWHEEL_SLOT( xNextExpiryTime ), &( pxTimer->xTimerListItem ) );
+	}
+
+	return xProcessTimerNow;
+}
+
+#endif /* configTIMER_WHEEL_SLOTS */
+/*-----------------------------------------------------------*/
 
-		/* Is the timer already in a list of active timers?  When the command
-		is trmCOMMAND_PROCESS_TIMER_OVERFLOW, the timer will be NULL as the
-		command is to the task rather than to an individual timer. */
-		if( pxTimer != NULL )
+static void	prvProcessReceivedCommands( void )
+{
+xTIMER_MESSAGE xMessage;
+
+	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+	{
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+			/* Negative commands are pended function calls rather than timer
+			commands. */
+			if( xMessage.xMessageID < ( portBASE_TYPE ) 0 )
 			{
-				/* The timer is in a list, remove it. */
-				vListRemove( &( pxTimer->xTimerListItem ) );
+				const xCALLBACK_PARAMETERS * const pxCallback = &( xMessage.u.xCallbackParameters );
+
+				/* The timer uses the xCallbackParameters member to request a
+				callback be executed.  Check the callback is not NULL. */
+				configASSERT( pxCallback->pxCallbackFunction );
+
+				/* Call the function. */
+				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
 			}
 		}
+		#endif /* INCLUDE_xTimerPendFunctionCall */
 
-		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
-		
-		switch( xMessage.xMessageID )
+		/* Commands that are zero or positive are timer commands rather than
+		pended function calls. */
+		if( xMessage.xMessageID >= ( portBASE_TYPE ) 0 )
+		{
+			prvProcessCommand( xMessage.u.xTimerParameters.pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+		}
+	}
+
+	#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+	{
+		/* The pending commands are processed once the queue is empty, rather
+		than when the tmrCOMMAND_PROCESS_PENDING message is received, in case
+		the queue was full when the message was sent. */
+		prvProcessPendingCommands();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xCommandValue )
+{
+portBASE_TYPE xTimerListsWereSwitched, xResult;
+portTickCountType xTimeNow, xCommandTime;
+
+	/* Is the timer already in a list of active timers?  When the command
+	is trmCOMMAND_PROCESS_TIMER_OVERFLOW, the timer will be NULL as the
+	command is to the task rather than to an individual timer. */
+	if( pxTimer != NULL )
+	{
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+		{
+			/* The timer is in a list, remove it. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		}
+	}
+
+	traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xCommandValue );
+
+	/* The time is sampled for each command, rather than once for all the
+	commands, as a pended function called from an earlier message may
+	have run for several ticks.  It is sampled after the timer has been
+	removed from its list in case sampling the time switches the lists.
+	In this case the xTimerListsWereSwitched parameter is not used, but
+	it must be present in the function call. */
+	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+	#if ( configTIMER_WHEEL_SLOTS > 0 )
+	{
+		/* Timers can only be inserted into the wheel once it has been
+		processed up to the current time.  This may call the
+		callbacks of timers that expired while this task was
+		blocked. */
+		prvProcessExpiredTimers( xTimeNow );
+	}
+	#endif
+
+	switch( xCommandID )
+	{
+		case tmrCOMMAND_START :	
+			/* Start or restart a timer. */
+			xCommandTime = tmrCOMMAND_TIME( xCommandValue, xTimeNow );
+			if( prvInsertTimerInActiveList( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime ) == pdTRUE )
+			{
+				/* The timer expired before it was added to the active timer
+				list.  Process it now. */
+				pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+				if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xCommandValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+			}
+			break;
+
+		case tmrCOMMAND_STOP :	
+			/* The timer has already been removed from the active list.
+			There is nothing to do here. */
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+			pxTimer->xTimerPeriodInTicks = xCommandValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+			prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			/* The timer has already been removed from the active list,
+			just free up the memory - unless it was supplied by the
+			application to xTimerCreateStatic(). */
+			#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+			{
+				vPortFree( pxTimer );
+			}
+			#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				if( pxTimer->ucStaticallyAllocated == pdFALSE )
+				{
+					vPortFree( pxTimer );
+				}
+			}
+			#endif
+			break;
+
+		default	:			
+			/* Don't expect to get here.  tmrCOMMAND_PROCESS_PENDING is only
+			sent to wake this task, so also arrives here. */
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	static portBASE_TYPE prvPendCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	xTIMER_MESSAGE xMessage;
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0U;
+	portBASE_TYPE xReturn = pdPASS, xWakeTimerTask = pdFALSE;
+
+		configASSERT( pxTimer );
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			taskENTER_CRITICAL();
+		}
+		else
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		}
+
+		if( pxTimer->xPendingCommand == tmrCOMMAND_DELETE )
+		{
+			/* The timer is about to be deleted. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			if( pxTimer->xPendingCommand == tmrNO_PENDING_COMMAND )
+			{
+				/* The timer is not yet in the list of timers with pending
+				commands.  The timer service task only needs waking if the
+				list was empty, otherwise it has already been woken. */
+				xWakeTimerTask = ( pxPendingTimers == NULL ) ? pdTRUE : pdFALSE;
+				pxTimer->pxNextPending = pxPendingTimers;
+				pxPendingTimers = pxTimer;
+			}
+
+			pxTimer->xPendingCommand = xCommandID;
+
+			if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
+			{
+				pxTimer->xPendingPeriod = xOptionalValue;
+				pxTimer->ucPendingPeriod = pdTRUE;
+			}
+			else
+			{
+				pxTimer->xPendingValue = xOptionalValue;
+			}
+		}
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+
+		if( xWakeTimerTask != pdFALSE )
+		{
+			/* If the queue is full the timer service task has messages to
+			process anyway, and processes the pending commands once it has
+			emptied the queue, so the result is not checked. */
+			xMessage.xMessageID = tmrCOMMAND_PROCESS_PENDING;
+			xMessage.u.xTimerParameters.xMessageValue = ( portTickType ) 0U;
+			xMessage.u.xTimerParameters.pxTimer = NULL;
+
+			if( pxHigherPriorityTaskWoken == NULL )
+			{
+				( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+			}
+			else
+			{
+				( void ) xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_COMMAND_COALESCING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_COMMAND_COALESCING == 1 )
+
+	static void prvProcessPendingCommands( void )
+	{
+	xTIMER *pxTimer;
+	portBASE_TYPE xCommandID;
+	portTickType xCommandValue;
+
+		for( ;; )
 		{
-			case tmrCOMMAND_START :	
-				/* Start or restart a timer. */
-				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
+			/* Take the next timer off the list, and its command out of the
+			timer.  A command sent to the timer from now on pends it again. */
+			taskENTER_CRITICAL();
+			{
+				pxTimer = pxPendingTimers;
+
+				if( pxTimer != NULL )
 				{
-					/* The timer expired before it was added to the active timer
-					list.  Process it now. */
-					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+					pxPendingTimers = pxTimer->pxNextPending;
+					pxTimer->pxNextPending = NULL;
+
+					xCommandID = pxTimer->xPendingCommand;
+					pxTimer->xPendingCommand = tmrNO_PENDING_COMMAND;
 
-					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+					if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
 					{
-						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-						configASSERT( xResult );
-						( void ) xResult;
+						xCommandValue = pxTimer->xPendingPeriod;
+					}
+					else
+					{
+						/* A period change that was replaced by a later
+						command still takes effect. */
+						if( pxTimer->ucPendingPeriod != pdFALSE )
+						{
+							pxTimer->xTimerPeriodInTicks = pxTimer->xPendingPeriod;
+						}
+
+						xCommandValue = pxTimer->xPendingValue;
 					}
-				}
-				break;
-
-			case tmrCOMMAND_STOP :	
-				/* The timer has already been removed from the active list.
-				There is nothing to do here. */
-				break;
 
-			case tmrCOMMAND_CHANGE_PERIOD :
-				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
-				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-				prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-				break;
+					pxTimer->ucPendingPeriod = pdFALSE;
+				}
+			}
+			taskEXIT_CRITICAL();
 
-			case tmrCOMMAND_DELETE :
-				/* The timer has already been removed from the active list,
-				just free up the memory. */
-				vPortFree( pxTimer );
+			if( pxTimer == NULL )
+			{
 				break;
+			}
 
-			default	:			
-				/* Don't expect to get here. */
-				break;
+			prvProcessCommand( pxTimer, xCommandID, xCommandValue );
 		}
 	}
-}
+
+#endif /* configUSE_TIMER_COMMAND_COALESCING */
 /*-----------------------------------------------------------*/
 
+#if ( configTIMER_WHEEL_SLOTS == 0 ) && ( configUSE_64_BIT_TICKS == 0 )
+
 static void prvSwitchTimerLists( portTickType xLastTime )
 {
 portTickType xNextExpireTime, xReloadTime;
@@ -583,7 +1399,7 @@ portBASE_TYPE xResult;
 
 		/* Remove the timer from the list. */
 		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-		vListRemove( &( pxTimer->xTimerListItem ) );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 
 		/* Execute its callback, then send a command to restart the timer if
 		it is an auto-reload timer.  It cannot be restarted here as the lists
@@ -618,6 +1434,8 @@ portBASE_TYPE xResult;
 	pxCurrentTimerList = pxOverflowTimerList;
 	pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configTIMER_WHEEL_SLOTS */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -629,11 +1447,49 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-			xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			#if ( configTIMER_WHEEL_SLOTS > 0 )
+			{
+			unsigned portBASE_TYPE uxSlot;
+
+				for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+				{
+					vListInitialise( &( xTimerWheel[ uxSlot ] ) );
+				}
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				pxCurrentTimerList = &xActiveTimerList1;
+
+				#if ( configUSE_64_BIT_TICKS == 0 )
+				{
+					vListInitialise( &xActiveTimerList2 );
+					pxOverflowTimerList = &xActiveTimerList2;
+				}
+				#endif
+			}
+			#endif
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				xTimerQueue = xQueueCreateStatic( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ), ucStaticTimerQueueStorage, &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			}
+			#endif
+
+			/* Registered so kernel aware debuggers, and uxQueueGetSystemState(),
+			can report how full the command queue gets. */
+			#if ( configQUEUE_REGISTRY_SIZE > 0 )
+			{
+				if( xTimerQueue != NULL )
+				{
+					vQueueAddToRegistry( xTimerQueue, ( signed char * ) "TmrQ" );
+				}
+			}
+			#endif
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -652,6 +1508,15 @@ xTIMER *pxTimer = ( xTIMER * ) xTimer;
 		it is referenced from either the current or the overflow timer lists in
 		one go, but the logic has to be reversed, hence the '!'. */
 		xTimerIsInActiveList = !( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) );
+
+		#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+		{
+			if( pxTimer->ucRunInTick != pdFALSE )
+			{
+				xTimerIsInActiveList = ( portBASE_TYPE ) pxTimer->ucInTickList;
+			}
+		}
+		#endif
 	}
 	taskEXIT_CRITICAL();
 
@@ -667,6 +1532,282 @@ xTIMER *pxTimer = ( xTIMER * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	void vTimerRunCallbackInTick( xTimerHandle xTimer )
+	{
+	xTIMER *pxTimer = ( xTIMER * ) xTimer;
+
+		/* The timer must not have been started or sent any other command. */
+		configASSERT( pxTimer );
+		configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) != pdFALSE );
+
+		pxTimer->ucRunInTick = pdTRUE;
+	}
+
+#endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	void vTimerProcessTickCallbacks( portTickType xTicks )
+	{
+	xTIMER *pxTimer;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		/* Called from the tick interrupt, with xTicks set to the number of
+		ticks it accounts for.  Each timer at the front of the list that has
+		expired is taken off it and, if it is an auto reload timer, put back
+		one period after it expired, before its callback is called - so the
+		callback can stop or reset the timer - and the remaining ticks are
+		then counted against the timers that follow it. */
+		for( ;; )
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+			{
+				pxTimer = pxTickTimers;
+
+				if( pxTimer != NULL )
+				{
+					if( pxTimer->xTicksAfterPrevious <= xTicks )
+					{
+						xTicks -= pxTimer->xTicksAfterPrevious;
+						pxTickTimers = pxTimer->pxNextTick;
+						pxTimer->ucInTickList = pdFALSE;
+
+						if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+						{
+							prvInsertTickTimer( pxTimer, pxTimer->xTimerPeriodInTicks );
+						}
+					}
+					else
+					{
+						pxTimer->xTicksAfterPrevious -= xTicks;
+						pxTimer = NULL;
+					}
+				}
+			}
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+			if( pxTimer == NULL )
+			{
+				break;
+			}
+
+			traceTIMER_EXPIRED( pxTimer );
+			pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+		}
+	}
+
+#endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	portTickType xTimerGetTicksToNextTickCallback( void )
+	{
+	portTickType xReturn = portMAX_DELAY;
+	unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		{
+			if( pxTickTimers != NULL )
+			{
+				xReturn = pxTickTimers->xTicksAfterPrevious;
+			}
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	static portBASE_TYPE prvTickTimerCommand( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	unsigned portBASE_TYPE uxSavedInterruptStatus = 0U;
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			taskENTER_CRITICAL();
+		}
+		else
+		{
+			uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		}
+
+		/* Every command starts by stopping the timer. */
+		prvRemoveTickTimer( pxTimer );
+
+		switch( xCommandID )
+		{
+			case tmrCOMMAND_START :
+				/* The command is applied when it is sent, so the time it was
+				sent is now. */
+				prvInsertTickTimer( pxTimer, pxTimer->xTimerPeriodInTicks );
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+				pxTimer->xTimerPeriodInTicks = xOptionalValue;
+				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+				prvInsertTickTimer( pxTimer, pxTimer->xTimerPeriodInTicks );
+				break;
+
+			default :
+				/* tmrCOMMAND_STOP and tmrCOMMAND_DELETE.  The timer has already
+				been removed from the list. */
+				break;
+		}
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+		}
+
+		if( xCommandID == tmrCOMMAND_DELETE )
+		{
+			/* xTimerDelete() has no interrupt safe version, so the memory can
+			be freed here - unless it was supplied by the application to
+			xTimerCreateStatic(). */
+			configASSERT( pxHigherPriorityTaskWoken == NULL );
+
+			#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+			{
+				vPortFree( pxTimer );
+			}
+			#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				if( pxTimer->ucStaticallyAllocated == pdFALSE )
+				{
+					vPortFree( pxTimer );
+				}
+			}
+			#endif
+		}
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+	static void prvInsertTickTimer( xTIMER *pxTimer, portTickType xTicks )
+	{
+	xTIMER **ppxNext = &pxTickTimers;
+
+		/* Timers that expire at the same time as this one stay in front of
+		it, so their callbacks are called in the order they were started. */
+		while( ( *ppxNext != NULL ) && ( ( *ppxNext )->xTicksAfterPrevious <= xTicks ) )
+		{
+			xTicks -= ( *ppxNext )->xTicksAfterPrevious;
+			ppxNext = &( ( *ppxNext )->pxNextTick );
+		}
+
+		pxTimer->xTicksAfterPrevious = xTicks;
+		pxTimer->pxNextTick = *ppxNext;
+
+		if( *ppxNext != NULL )
+		{
+			( *ppxNext )->xTicksAfterPrevious -= xTicks;
+		}
+
+		*ppxNext = pxTimer;
+		pxTimer->ucInTickList = pdTRUE;
+	}
+
+	static void prvRemoveTickTimer( xTIMER *pxTimer )
+	{
+	xTIMER **ppxNext = &pxTickTimers;
+
+		if( pxTimer->ucInTickList != pdFALSE )
+		{
+			while( *ppxNext != pxTimer )
+			{
+				ppxNext = &( ( *ppxNext )->pxNextTick );
+			}
+
+			/* The timer behind this one now expires relative to the timer in
+			front of it. */
+			if( pxTimer->pxNextTick != NULL )
+			{
+				pxTimer->pxNextTick->xTicksAfterPrevious += pxTimer->xTicksAfterPrevious;
+			}
+
+			*ppxNext = pxTimer->pxNextTick;
+			pxTimer->ucInTickList = pdFALSE;
+		}
+	}
+
+#endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	portBASE_TYPE xTimerPendFunctionCallFromISR( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+	{
+	xTIMER_MESSAGE xMessage;
+	portBASE_TYPE xReturn;
+
+		/* As xTimerPendFunctionCall(), the timer queue must already exist.
+		An interrupt that is enabled before the scheduler is started must not
+		use this function until at least one timer has been created. */
+		configASSERT( xTimerQueue );
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	portBASE_TYPE xTimerPendFunctionCall( tmrPENDED_FUNCTION xFunctionToPend, void *pvParameter1, unsigned long ulParameter2, portTickType xTicksToWait )
+	{
+	xTIMER_MESSAGE xMessage;
+	portBASE_TYPE xReturn;
+
+		/* This function can only be called after a timer has been created or
+		after the scheduler has been started because, until then, the timer
+		queue does not exist. */
+		configASSERT( xTimerQueue );
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+
+		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
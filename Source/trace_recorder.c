@@ -0,0 +1,279 @@
+/*
+    FreeRTOS V7.1.0 - Copyright (C) 2011 Real Time Engineers Ltd.
+
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS tutorial books are available in pdf and paperback.        *
+     *    Complete, revised, and edited pdf reference manuals are also       *
+     *    available.                                                         *
+     *                                                                       *
+     *    Purchasing FreeRTOS documentation will not only help you, by       *
+     *    ensuring you get running as quickly as possible and with an        *
+     *    in-depth knowledge of how to use FreeRTOS, it will also help       *
+     *    the FreeRTOS project to continue with its mission of providing     *
+     *    professional grade, cross platform, de facto standard solutions    *
+     *    for microcontrollers - completely free of charge!                  *
+     *                                                                       *
+     *    >>> See http://www.FreeRTOS.org/Documentation for details. <<<     *
+     *                                                                       *
+     *    Thank you for using FreeRTOS, and thank you for your support!      *
+     *                                                                       *
+    ***************************************************************************
+
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation AND MODIFIED BY the FreeRTOS exception.
+    >>>NOTE<<< The modification to the GPL is included to allow you to
+    distribute a combined work that includes FreeRTOS without being obliged to
+    provide the source code for proprietary components outside of the FreeRTOS
+    kernel.  FreeRTOS is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details. You should have received a copy of the GNU General Public
+    License and the FreeRTOS license exception along with FreeRTOS; if not it
+    can be viewed here: http://www.freertos.org/a00114.html and also obtained
+    by writing to Richard Barry, contact details for whom are available on the
+    FreeRTOS WEB site.
+
+    1 tab == 4 spaces!
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  This #if is closed at the very bottom of this
+file.  If you want to include the trace recorder then ensure
+configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* Records are written with interrupts masked so an interrupt cannot write a
+record part way through a record being written by a task.  When there is more
+than one core the ISR spinlock is also taken, so records from different cores
+are written in timestamp order. */
+#ifndef traceRECORDER_ENTER_CRITICAL
+	#define traceRECORDER_ENTER_CRITICAL()		taskENTER_CRITICAL_FROM_ISR()
+	#define traceRECORDER_EXIT_CRITICAL( x )	taskEXIT_CRITICAL_FROM_ISR( x )
+#endif
+
+/* The source of the timestamps, recorded in the header so the decoder can say
+what units the times are in. */
+#ifdef traceRECORDER_GET_TIMESTAMP
+	#define trcTIMESTAMP_SOURCE		trcTIMESTAMP_USER_DEFINED
+#elif ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define trcTIMESTAMP_SOURCE		trcTIMESTAMP_RUN_TIME_COUNTER
+#else
+	#define trcTIMESTAMP_SOURCE		trcTIMESTAMP_TICKS
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+	#define trcGET_CORE_ID()		( ( unsigned char ) portGET_CORE_ID() )
+#else
+	#define trcGET_CORE_ID()		( ( unsigned char ) 0U )
+#endif
+
+/* The trace buffer.  The header is initialised statically so a buffer read
+from the target is decodable even if the scheduler was never started. */
+PRIVILEGED_DATA xTraceRecorderData xTraceRecorder =
+{
+	{ 'F', 'R', 'T', 'R' },
+	( unsigned char ) trcRECORDER_VERSION,
+	( unsigned char ) sizeof( unsigned long ),
+	( unsigned char ) sizeof( portPOINTER_SIZE_TYPE ),
+	( unsigned char ) configNUMBER_OF_CORES,
+	0x01020304UL,
+	( unsigned long ) trcTIMESTAMP_SOURCE,
+	( unsigned long ) offsetof( xTraceRecorderData, xNames ),
+	( unsigned long ) configTRACE_RECORDER_NAME_TABLE_LENGTH,
+	( unsigned long ) sizeof( xTraceName ),
+	( unsigned long ) configMAX_TASK_NAME_LEN,
+	( unsigned long ) offsetof( xTraceRecorderData, xEvents ),
+	( unsigned long ) configTRACE_RECORDER_BUFFER_LENGTH,
+	( unsigned long ) sizeof( xTraceEvent ),
+	0UL,
+	0UL,
+	0UL,
+	( unsigned long ) pdTRUE,
+	{ { 0, { 0 } } },
+	{ { 0UL, 0UL, 0, 0U, 0U } }
+};
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the time to be recorded with an event.
+ */
+static unsigned long prvGetTimestamp( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static unsigned long prvGetTimestamp( void )
+{
+	#if defined( traceRECORDER_GET_TIMESTAMP )
+	{
+		return ( unsigned long ) traceRECORDER_GET_TIMESTAMP();
+	}
+	#elif ( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+	portRUN_TIME_COUNTER_TYPE ulCounter;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounter );
+		#else
+			ulCounter = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		return ( unsigned long ) ulCounter;
+	}
+	#else
+	{
+		return ( unsigned long ) xTaskGetTickCountFromISR();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderEvent( unsigned char ucEventCode, portPOINTER_SIZE_TYPE uxObject, unsigned long ulParameter )
+{
+xTraceEvent *pxEvent;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	/* Test outside of the critical section first so as little time as
+	possible is spent when recording has been stopped. */
+	if( xTraceRecorder.ulRecording != ( unsigned long ) pdFALSE )
+	{
+		uxSavedInterruptStatus = traceRECORDER_ENTER_CRITICAL();
+		{
+			pxEvent = &( xTraceRecorder.xEvents[ xTraceRecorder.ulNextEvent ] );
+
+			/* A compare is cheaper than a modulo on most targets. */
+			xTraceRecorder.ulNextEvent++;
+			if( xTraceRecorder.ulNextEvent >= ( unsigned long ) configTRACE_RECORDER_BUFFER_LENGTH )
+			{
+				xTraceRecorder.ulNextEvent = 0UL;
+			}
+			xTraceRecorder.ulEventsWritten++;
+
+			pxEvent->ulTimestamp = prvGetTimestamp();
+			pxEvent->ulParameter = ulParameter;
+			pxEvent->uxObject = uxObject;
+			pxEvent->ucEventCode = ucEventCode;
+			pxEvent->ucCoreID = trcGET_CORE_ID();
+		}
+		traceRECORDER_EXIT_CRITICAL( uxSavedInterruptStatus );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderSetName( portPOINTER_SIZE_TYPE uxObject, const signed char *pcName )
+{
+xTraceName *pxName = NULL;
+unsigned long ulIndex;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = traceRECORDER_ENTER_CRITICAL();
+	{
+		/* Reuse the entry if the object has been named before - the memory
+		used by a deleted task may since have been reused by a new task, for
+		example. */
+		for( ulIndex = 0UL; ulIndex < ( unsigned long ) configTRACE_RECORDER_NAME_TABLE_LENGTH; ulIndex++ )
+		{
+			if( xTraceRecorder.xNames[ ulIndex ].uxObject == uxObject )
+			{
+				pxName = &( xTraceRecorder.xNames[ ulIndex ] );
+				break;
+			}
+		}
+
+		if( pxName == NULL )
+		{
+			/* Otherwise overwrite the oldest entry. */
+			pxName = &( xTraceRecorder.xNames[ xTraceRecorder.ulNextName ] );
+
+			xTraceRecorder.ulNextName++;
+			if( xTraceRecorder.ulNextName >= ( unsigned long ) configTRACE_RECORDER_NAME_TABLE_LENGTH )
+			{
+				xTraceRecorder.ulNextName = 0UL;
+			}
+		}
+
+		pxName->uxObject = uxObject;
+
+		if( pcName != NULL )
+		{
+			strncpy( ( char * ) pxName->pcName, ( const char * ) pcName, ( size_t ) configMAX_TASK_NAME_LEN );
+			pxName->pcName[ configMAX_TASK_NAME_LEN - 1 ] = ( signed char ) '\0';
+		}
+		else
+		{
+			pxName->pcName[ 0 ] = ( signed char ) '\0';
+		}
+	}
+	traceRECORDER_EXIT_CRITICAL( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( void )
+{
+	xTraceRecorder.ulRecording = ( unsigned long ) pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+	xTraceRecorder.ulRecording = ( unsigned long ) pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderClear( void )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = traceRECORDER_ENTER_CRITICAL();
+	{
+		xTraceRecorder.ulNextEvent = 0UL;
+		xTraceRecorder.ulEventsWritten = 0UL;
+	}
+	traceRECORDER_EXIT_CRITICAL( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+const void *pvTraceRecorderGetData( size_t *pxSize )
+{
+	if( pxSize != NULL )
+	{
+		*pxSize = sizeof( xTraceRecorder );
+	}
+
+	return ( const void * ) &xTraceRecorder;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include the trace recorder.  If you want to include the trace recorder then
+ensure configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TRACE_RECORDER == 1 */
+